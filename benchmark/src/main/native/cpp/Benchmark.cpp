@@ -0,0 +1,326 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "bench/Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/StringExtras.h>
+#include <wpi/json.h>
+#include <wpi/raw_istream.h>
+#include <wpi/raw_ostream.h>
+
+using namespace bench;
+
+namespace {
+
+struct Benchmark {
+  std::string name;
+  Function func;
+  std::vector<int64_t> args;
+};
+
+struct Options {
+  std::string filter;
+  double minTime = 0.1;
+  int repetitions = 5;
+  std::string out;
+  std::string baseline;
+  std::string label;
+  bool list = false;
+};
+
+struct Statistics {
+  double median;
+  double mean;
+  double min;
+  double stddev;
+};
+
+}  // namespace
+
+static std::vector<Benchmark>& GetBenchmarks() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+void detail::UseCharPointer(const volatile char*) {}
+
+void bench::Register(std::string_view name, Function func,
+                     std::initializer_list<int64_t> args) {
+  GetBenchmarks().push_back({std::string{name}, std::move(func), args});
+  if (GetBenchmarks().back().args.empty()) {
+    GetBenchmarks().back().args.push_back(0);
+  }
+}
+
+static std::string GetFullName(const Benchmark& benchmark, int64_t arg) {
+  if (benchmark.args.size() == 1 && arg == 0) {
+    return benchmark.name;
+  }
+  return fmt::format("{}/{}", benchmark.name, arg);
+}
+
+static bool ParseOptions(int argc, char* argv[], Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "--list") {
+      options->list = true;
+      continue;
+    }
+    auto [key, value] = wpi::split(arg, '=');
+    if (key == "--filter") {
+      options->filter = value;
+    } else if (key == "--min-time") {
+      options->minTime = std::strtod(std::string{value}.c_str(), nullptr);
+      if (!(options->minTime > 0)) {
+        fmt::print(stderr, "invalid minimum time '{}'\n", value);
+        return false;
+      }
+    } else if (key == "--repetitions") {
+      auto repetitions = wpi::parse_integer<int>(value, 10);
+      if (!repetitions || *repetitions < 1) {
+        fmt::print(stderr, "invalid repetitions '{}'\n", value);
+        return false;
+      }
+      options->repetitions = *repetitions;
+    } else if (key == "--out") {
+      options->out = value;
+    } else if (key == "--baseline") {
+      options->baseline = value;
+    } else if (key == "--label") {
+      options->label = value;
+    } else {
+      fmt::print(stderr, "unknown option '{}'\n", arg);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Finds the number of iterations that takes at least minTime, growing it from
+// a single iteration.
+static int64_t Calibrate(const Benchmark& benchmark, int64_t arg,
+                         double minTime) {
+  int64_t iterations = 1;
+  for (;;) {
+    State state{arg, iterations};
+    benchmark.func(state);
+    double elapsed = state.GetElapsed();
+    if (elapsed >= minTime || iterations >= 1000000000) {
+      return iterations;
+    }
+    // aim 40% past the target, growing by at least 2x and at most 10x
+    double multiplier = elapsed > 0 ? 1.4 * minTime / elapsed : 10;
+    multiplier = std::clamp(multiplier, 2.0, 10.0);
+    iterations = static_cast<int64_t>(iterations * multiplier);
+  }
+}
+
+static Statistics GetStatistics(std::vector<double> values) {
+  Statistics stats;
+  std::sort(values.begin(), values.end());
+  size_t n = values.size();
+  stats.median = n % 2 == 1 ? values[n / 2]
+                            : (values[n / 2 - 1] + values[n / 2]) / 2;
+  stats.min = values.front();
+  double sum = 0;
+  for (double value : values) {
+    sum += value;
+  }
+  stats.mean = sum / n;
+  double sumSq = 0;
+  for (double value : values) {
+    sumSq += (value - stats.mean) * (value - stats.mean);
+  }
+  stats.stddev = n > 1 ? std::sqrt(sumSq / (n - 1)) : 0;
+  return stats;
+}
+
+static wpi::json RunBenchmark(const Benchmark& benchmark, int64_t arg,
+                              const Options& options) {
+  int64_t iterations = Calibrate(benchmark, arg, options.minTime);
+
+  std::vector<double> nsPerIter;
+  std::vector<double> itemsPerSecond;
+  for (int i = 0; i < options.repetitions; ++i) {
+    State state{arg, iterations};
+    benchmark.func(state);
+    double elapsed = state.GetElapsed();
+    nsPerIter.push_back(elapsed * 1e9 / iterations);
+    if (state.GetItemsProcessed() > 0 && elapsed > 0) {
+      itemsPerSecond.push_back(state.GetItemsProcessed() / elapsed);
+    }
+  }
+
+  auto stats = GetStatistics(nsPerIter);
+  wpi::json result = {{"name", GetFullName(benchmark, arg)},
+                      {"arg", arg},
+                      {"iterations", iterations},
+                      {"repetitions", options.repetitions},
+                      {"ns_per_iter",
+                       {{"median", stats.median},
+                        {"mean", stats.mean},
+                        {"min", stats.min},
+                        {"stddev", stats.stddev}}}};
+  if (!itemsPerSecond.empty()) {
+    result["items_per_second"] = GetStatistics(itemsPerSecond).median;
+  }
+  return result;
+}
+
+static wpi::json GetContext(const Options& options) {
+  char date[32];
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#if defined(__FRC_ROBORIO__)
+  const char* platform = "roborio";
+#elif defined(_WIN32)
+  const char* platform = "windows";
+#elif defined(__APPLE__)
+  const char* platform = "osx";
+#else
+  const char* platform = "linux";
+#endif
+
+#if defined(_MSC_VER)
+  std::string compiler = fmt::format("msvc {}", _MSC_VER);
+#elif defined(__clang__)
+  std::string compiler = fmt::format("clang {}", __clang_version__);
+#elif defined(__GNUC__)
+  std::string compiler = fmt::format("gcc {}", __VERSION__);
+#else
+  std::string compiler = "unknown";
+#endif
+
+#ifdef NDEBUG
+  const char* buildType = "release";
+#else
+  const char* buildType = "debug";
+#endif
+
+  return {{"date", date},
+          {"label", options.label},
+          {"platform", platform},
+          {"compiler", compiler},
+          {"build_type", buildType},
+          {"min_time", options.minTime},
+          {"repetitions", options.repetitions}};
+}
+
+// Adds the baseline median time and the relative change to each result that
+// has a baseline result of the same name.
+static bool CompareToBaseline(const std::string& filename,
+                              wpi::json& results) {
+  std::error_code ec;
+  wpi::raw_fd_istream is{filename, ec};
+  if (ec) {
+    fmt::print(stderr, "could not open baseline '{}': {}\n", filename,
+               ec.message());
+    return false;
+  }
+
+  wpi::json baseline;
+  try {
+    baseline = wpi::json::parse(is);
+  } catch (const wpi::json::exception& e) {
+    fmt::print(stderr, "could not parse baseline '{}': {}\n", filename,
+               e.what());
+    return false;
+  }
+
+  auto baselineBenchmarks = baseline.find("benchmarks");
+  if (baselineBenchmarks == baseline.end() ||
+      !baselineBenchmarks->is_array()) {
+    fmt::print(stderr, "baseline '{}' has no benchmarks\n", filename);
+    return false;
+  }
+
+  for (auto& result : results) {
+    for (auto& old : *baselineBenchmarks) {
+      if (old.value("name", "") != result["name"].get_ref<std::string&>()) {
+        continue;
+      }
+      auto oldNs = old.find("ns_per_iter");
+      if (oldNs == old.end() || !oldNs->is_object()) {
+        break;
+      }
+      double oldMedian = oldNs->value("median", 0.0);
+      if (oldMedian > 0) {
+        double median = result["ns_per_iter"]["median"];
+        result["baseline_ns_per_iter"] = oldMedian;
+        result["change"] = median / oldMedian - 1;
+      }
+      break;
+    }
+  }
+  return true;
+}
+
+int bench::RunBenchmarks(int argc, char* argv[]) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    return 1;
+  }
+
+  auto& benchmarks = GetBenchmarks();
+  std::stable_sort(benchmarks.begin(), benchmarks.end(),
+                   [](const auto& lhs, const auto& rhs) {
+                     return lhs.name < rhs.name;
+                   });
+
+  wpi::json results = wpi::json::array();
+  for (auto&& benchmark : benchmarks) {
+    for (int64_t arg : benchmark.args) {
+      auto name = GetFullName(benchmark, arg);
+      if (name.find(options.filter) == std::string::npos) {
+        continue;
+      }
+      if (options.list) {
+        fmt::print("{}\n", name);
+        continue;
+      }
+      // progress goes to stderr so stdout is only the results
+      fmt::print(stderr, "{}\n", name);
+      results.push_back(RunBenchmark(benchmark, arg, options));
+    }
+  }
+  if (options.list) {
+    return 0;
+  }
+
+  if (!options.baseline.empty() &&
+      !CompareToBaseline(options.baseline, results)) {
+    return 1;
+  }
+
+  wpi::json output = {{"context", GetContext(options)},
+                      {"benchmarks", std::move(results)}};
+  if (options.out.empty()) {
+    output.dump(wpi::outs(), 2);
+    wpi::outs() << '\n';
+    wpi::outs().flush();
+    return 0;
+  }
+
+  std::error_code ec;
+  wpi::raw_fd_ostream os{options.out, ec};
+  if (ec) {
+    fmt::print(stderr, "could not open '{}': {}\n", options.out,
+               ec.message());
+    return 1;
+  }
+  output.dump(os, 2);
+  os << '\n';
+  return 0;
+}
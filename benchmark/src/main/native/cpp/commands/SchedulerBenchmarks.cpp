@@ -0,0 +1,97 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include <frc2/command/CommandBase.h>
+#include <frc2/command/CommandHelper.h>
+#include <frc2/command/CommandScheduler.h>
+#include <frc2/command/SubsystemBase.h>
+#include <hal/HALBase.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+class CountingSubsystem : public frc2::SubsystemBase {
+ public:
+  void Periodic() override { ++count; }
+
+  int64_t count = 0;
+};
+
+// Runs when disabled, so the results don't depend on the robot being enabled
+class CountingCommand
+    : public frc2::CommandHelper<frc2::CommandBase, CountingCommand> {
+ public:
+  explicit CountingCommand(int64_t* count) : m_count{count} {}
+
+  void Execute() override { ++*m_count; }
+
+  bool RunsWhenDisabled() const override { return true; }
+
+ private:
+  int64_t* m_count;
+};
+
+void ResetScheduler() {
+  HAL_Initialize(500, 0);
+  auto& scheduler = frc2::CommandScheduler::GetInstance();
+  scheduler.CancelAll();
+  scheduler.Enable();
+}
+
+// One Run() with the argument number of commands scheduled; the commands have
+// no requirements
+void Run(bench::State& state) {
+  ResetScheduler();
+  auto& scheduler = frc2::CommandScheduler::GetInstance();
+  int64_t count = 0;
+  std::vector<std::unique_ptr<CountingCommand>> commands;
+  for (int64_t i = 0; i < state.GetArg(); ++i) {
+    commands.emplace_back(std::make_unique<CountingCommand>(&count));
+    scheduler.Schedule(commands.back().get());
+  }
+  while (state.KeepRunning()) {
+    scheduler.Run();
+  }
+  bench::DoNotOptimize(count);
+  scheduler.CancelAll();
+  state.SetItemsProcessed(state.GetIterations() * commands.size());
+}
+
+// One Run() with the argument number of subsystems, each with a command
+// requiring it
+void RunWithSubsystems(bench::State& state) {
+  ResetScheduler();
+  auto& scheduler = frc2::CommandScheduler::GetInstance();
+  int64_t count = 0;
+  std::vector<std::unique_ptr<CountingSubsystem>> subsystems;
+  std::vector<std::unique_ptr<CountingCommand>> commands;
+  for (int64_t i = 0; i < state.GetArg(); ++i) {
+    auto subsystem =
+        subsystems.emplace_back(std::make_unique<CountingSubsystem>()).get();
+    auto command =
+        commands.emplace_back(std::make_unique<CountingCommand>(&count)).get();
+    command->AddRequirements({subsystem});
+    scheduler.Schedule(command);
+  }
+  while (state.KeepRunning()) {
+    scheduler.Run();
+  }
+  bench::DoNotOptimize(count);
+  scheduler.CancelAll();
+  state.SetItemsProcessed(state.GetIterations() * commands.size());
+}
+
+}  // namespace
+
+static bench::Registration gRun{"commands/CommandScheduler/Run", Run,
+                                {1, 16, 256}};
+static bench::Registration gRunWithSubsystems{
+    "commands/CommandScheduler/RunWithSubsystems", RunWithSubsystems,
+    {1, 16, 256}};
@@ -0,0 +1,120 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <hal/DIO.h>
+#include <hal/HALBase.h>
+#include <hal/PWM.h>
+#include <hal/Ports.h>
+#include <hal/simulation/PWMData.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+void CountCallback(const char*, void* param, const HAL_Value*) {
+  ++*static_cast<int64_t*>(param);
+}
+
+// An initialized PWM port with a motor controller config, freed on
+// destruction
+class PWMPort {
+ public:
+  explicit PWMPort(int32_t channel) {
+    HAL_Initialize(500, 0);
+    int32_t status = 0;
+    m_handle = HAL_InitializePWMPort(HAL_GetPort(channel), nullptr, &status);
+    HAL_SetPWMConfig(m_handle, 2.004, 1.52, 1.50, 1.48, 0.997, &status);
+  }
+  ~PWMPort() {
+    int32_t status = 0;
+    HAL_FreePWMPort(m_handle, &status);
+  }
+  PWMPort(const PWMPort&) = delete;
+  PWMPort& operator=(const PWMPort&) = delete;
+
+  HAL_DigitalHandle GetHandle() const { return m_handle; }
+
+ private:
+  HAL_DigitalHandle m_handle;
+};
+
+void RegisterCancelCallback(bench::State& state) {
+  HAL_Initialize(500, 0);
+  int64_t count = 0;
+  while (state.KeepRunning()) {
+    int32_t uid = HALSIM_RegisterPWMSpeedCallback(0, CountCallback, &count,
+                                                  false);
+    HALSIM_CancelPWMSpeedCallback(0, uid);
+  }
+}
+
+// Sets a value through the handle, with the argument number of sim callbacks
+// registered for it
+void SetPWMSpeed(bench::State& state) {
+  PWMPort port{0};
+  int64_t count = 0;
+  std::vector<int32_t> uids;
+  for (int64_t i = 0; i < state.GetArg(); ++i) {
+    uids.push_back(
+        HALSIM_RegisterPWMSpeedCallback(0, CountCallback, &count, false));
+  }
+  int32_t status = 0;
+  double speed = 0;
+  while (state.KeepRunning()) {
+    // alternate values, as setting the same value doesn't call callbacks
+    speed = speed == 0 ? 0.5 : 0;
+    HAL_SetPWMSpeed(port.GetHandle(), speed, &status);
+  }
+  bench::DoNotOptimize(count);
+  for (int32_t uid : uids) {
+    HALSIM_CancelPWMSpeedCallback(0, uid);
+  }
+}
+
+void GetPWMSpeed(bench::State& state) {
+  PWMPort port{0};
+  int32_t status = 0;
+  while (state.KeepRunning()) {
+    bench::DoNotOptimize(HAL_GetPWMSpeed(port.GetHandle(), &status));
+  }
+}
+
+// Reads through each of the argument number of DIO handles in turn
+void GetDIO(bench::State& state) {
+  HAL_Initialize(500, 0);
+  std::vector<HAL_DigitalHandle> handles;
+  for (int32_t i = 0; i < state.GetArg() && i < HAL_GetNumDigitalChannels();
+       ++i) {
+    int32_t status = 0;
+    handles.push_back(
+        HAL_InitializeDIOPort(HAL_GetPort(i), true, nullptr, &status));
+  }
+  while (state.KeepRunning()) {
+    for (auto handle : handles) {
+      int32_t status = 0;
+      bench::DoNotOptimize(HAL_GetDIO(handle, &status));
+    }
+  }
+  state.SetItemsProcessed(state.GetIterations() * handles.size());
+  for (auto handle : handles) {
+    HAL_FreeDIOPort(handle);
+  }
+}
+
+}  // namespace
+
+// These would drive real outputs on a robot
+#ifndef __FRC_ROBORIO__
+static bench::Registration gRegisterCancelCallback{
+    "hal/sim/RegisterCancelCallback", RegisterCancelCallback};
+static bench::Registration gSetPWMSpeed{"hal/sim/SetPWMSpeed", SetPWMSpeed,
+                                        {0, 1, 8}};
+static bench::Registration gGetPWMSpeed{"hal/HandleLookup/GetPWMSpeed",
+                                        GetPWMSpeed};
+#endif
+static bench::Registration gGetDIO{"hal/HandleLookup/GetDIO", GetDIO, {10}};
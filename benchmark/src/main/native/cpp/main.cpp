@@ -0,0 +1,9 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "bench/Benchmark.h"
+
+int main(int argc, char* argv[]) {
+  return bench::RunBenchmarks(argc, argv);
+}
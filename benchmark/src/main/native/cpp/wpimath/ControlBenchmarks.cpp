@@ -0,0 +1,40 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <Eigen/Core>
+#include <frc/controller/LinearQuadraticRegulator.h>
+#include <frc/estimator/KalmanFilter.h>
+#include <frc/system/LinearSystemLoop.h>
+#include <frc/system/plant/DCMotor.h>
+#include <frc/system/plant/LinearSystemId.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+constexpr auto kDt = 0.005_s;
+
+// The elevator loop of the state-space tests
+void LinearSystemLoopStep(bench::State& state) {
+  auto plant = frc::LinearSystemId::ElevatorSystem(frc::DCMotor::Vex775Pro(2),
+                                                   5_kg, 0.0181864_m, 1.0);
+  frc::LinearQuadraticRegulator<2, 1> controller{
+      plant, {0.02, 0.4}, {12.0}, kDt};
+  frc::KalmanFilter<2, 1, 1> observer{plant, {0.05, 1.0}, {0.0001}, kDt};
+  frc::LinearSystemLoop<2, 1, 1> loop{plant, controller, observer, 12_V, kDt};
+
+  Eigen::Matrix<double, 2, 1> r;
+  r << 2.0, 0.0;
+  loop.SetNextR(r);
+  while (state.KeepRunning()) {
+    loop.Correct(plant.CalculateY(loop.Xhat(), loop.U()));
+    loop.Predict(kDt);
+  }
+  bench::DoNotOptimize(loop.Xhat());
+}
+
+}  // namespace
+
+static bench::Registration gLinearSystemLoopStep{
+    "wpimath/LinearSystemLoop/CorrectPredict", LinearSystemLoopStep};
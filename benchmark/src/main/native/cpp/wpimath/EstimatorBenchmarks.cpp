@@ -0,0 +1,110 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cmath>
+
+#include <Eigen/Core>
+#include <frc/estimator/DifferentialDrivePoseEstimator.h>
+#include <frc/estimator/MecanumDrivePoseEstimator.h>
+#include <frc/estimator/SwerveDrivePoseEstimator.h>
+#include <frc/estimator/UnscentedKalmanFilter.h>
+#include <frc/kinematics/MecanumDriveKinematics.h>
+#include <frc/kinematics/SwerveDriveKinematics.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+constexpr auto kDt = 0.02_s;
+
+// A differential drive with velocity states; the same model as the UKF tests
+// use, reduced to a fixed gain
+Eigen::Matrix<double, 5, 1> DriveDynamics(
+    const Eigen::Matrix<double, 5, 1>& x,
+    const Eigen::Matrix<double, 2, 1>& u) {
+  double v = (x(3) + x(4)) / 2;
+  Eigen::Matrix<double, 5, 1> xdot;
+  xdot << v * std::cos(x(2)), v * std::sin(x(2)), (x(4) - x(3)) / 0.8,
+      -2 * x(3) + 0.5 * u(0), -2 * x(4) + 0.5 * u(1);
+  return xdot;
+}
+
+Eigen::Matrix<double, 3, 1> DriveMeasurement(
+    const Eigen::Matrix<double, 5, 1>& x, const Eigen::Matrix<double, 2, 1>&) {
+  Eigen::Matrix<double, 3, 1> y;
+  y << x(2), x(3), x(4);
+  return y;
+}
+
+void UnscentedKalmanFilterStep(bench::State& state) {
+  frc::UnscentedKalmanFilter<5, 2, 3> observer{DriveDynamics,
+                                               DriveMeasurement,
+                                               {0.5, 0.5, 10.0, 1.0, 1.0},
+                                               {0.0001, 0.01, 0.01},
+                                               kDt};
+  Eigen::Matrix<double, 2, 1> u;
+  u << 6.0, 7.0;
+  while (state.KeepRunning()) {
+    observer.Predict(u, kDt);
+    observer.Correct(u, DriveMeasurement(observer.Xhat(), u));
+  }
+  bench::DoNotOptimize(observer.Xhat());
+}
+
+void DifferentialDriveUpdate(bench::State& state) {
+  frc::DifferentialDrivePoseEstimator estimator{
+      frc::Rotation2d{}, frc::Pose2d{}, {0.02, 0.02, 0.01, 0.02, 0.02},
+      {0.01, 0.01, 0.001}, {0.1, 0.1, 0.01}};
+  units::second_t t = 0_s;
+  units::meter_t distance = 0_m;
+  while (state.KeepRunning()) {
+    t += kDt;
+    distance += 0.02_m;
+    bench::DoNotOptimize(estimator.UpdateWithTime(
+        t, frc::Rotation2d{}, {1_mps, 1_mps}, distance, distance));
+  }
+}
+
+void MecanumDriveUpdate(bench::State& state) {
+  frc::MecanumDriveKinematics kinematics{
+      frc::Translation2d{0.3_m, 0.3_m}, frc::Translation2d{0.3_m, -0.3_m},
+      frc::Translation2d{-0.3_m, 0.3_m}, frc::Translation2d{-0.3_m, -0.3_m}};
+  frc::MecanumDrivePoseEstimator estimator{
+      frc::Rotation2d{}, frc::Pose2d{},  kinematics,
+      {0.1, 0.1, 0.1},   {0.05},         {0.1, 0.1, 0.1}};
+  units::second_t t = 0_s;
+  while (state.KeepRunning()) {
+    t += kDt;
+    bench::DoNotOptimize(estimator.UpdateWithTime(
+        t, frc::Rotation2d{}, {1_mps, 1_mps, 1_mps, 1_mps}));
+  }
+}
+
+void SwerveDriveUpdate(bench::State& state) {
+  frc::SwerveDriveKinematics<4> kinematics{
+      frc::Translation2d{0.3_m, 0.3_m}, frc::Translation2d{0.3_m, -0.3_m},
+      frc::Translation2d{-0.3_m, 0.3_m}, frc::Translation2d{-0.3_m, -0.3_m}};
+  frc::SwerveDrivePoseEstimator<4> estimator{
+      frc::Rotation2d{}, frc::Pose2d{},  kinematics,
+      {0.1, 0.1, 0.1},   {0.05},         {0.1, 0.1, 0.1}};
+  frc::SwerveModuleState moduleState{1_mps, frc::Rotation2d{}};
+  units::second_t t = 0_s;
+  while (state.KeepRunning()) {
+    t += kDt;
+    bench::DoNotOptimize(estimator.UpdateWithTime(
+        t, frc::Rotation2d{}, moduleState, moduleState, moduleState,
+        moduleState));
+  }
+}
+
+}  // namespace
+
+static bench::Registration gUnscentedKalmanFilterStep{
+    "wpimath/UnscentedKalmanFilter/PredictCorrect", UnscentedKalmanFilterStep};
+static bench::Registration gDifferentialDriveUpdate{
+    "wpimath/DifferentialDrivePoseEstimator/Update", DifferentialDriveUpdate};
+static bench::Registration gMecanumDriveUpdate{
+    "wpimath/MecanumDrivePoseEstimator/Update", MecanumDriveUpdate};
+static bench::Registration gSwerveDriveUpdate{
+    "wpimath/SwerveDrivePoseEstimator/Update", SwerveDriveUpdate};
@@ -0,0 +1,61 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <frc/kinematics/SwerveDriveKinematics.h>
+#include <wpi/array.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+frc::SwerveDriveKinematics<4> MakeKinematics() {
+  return frc::SwerveDriveKinematics<4>{
+      frc::Translation2d{0.3_m, 0.3_m}, frc::Translation2d{0.3_m, -0.3_m},
+      frc::Translation2d{-0.3_m, 0.3_m}, frc::Translation2d{-0.3_m, -0.3_m}};
+}
+
+void SwerveToModuleStates(bench::State& state) {
+  auto kinematics = MakeKinematics();
+  frc::ChassisSpeeds speeds{1.5_mps, 0.5_mps, 1_rad_per_s};
+  while (state.KeepRunning()) {
+    bench::DoNotOptimize(kinematics.ToSwerveModuleStates(speeds));
+  }
+}
+
+void SwerveToModuleStatesBatch(bench::State& state) {
+  auto kinematics = MakeKinematics();
+  std::vector<frc::ChassisSpeeds> speeds;
+  for (int64_t i = 0; i < state.GetArg(); ++i) {
+    speeds.push_back({1_mps * (i % 7), 0.5_mps, 0.1_rad_per_s * (i % 5)});
+  }
+  std::vector<wpi::array<frc::SwerveModuleState, 4>> moduleStates(
+      speeds.size(), wpi::array<frc::SwerveModuleState, 4>{wpi::empty_array});
+  while (state.KeepRunning()) {
+    kinematics.ToSwerveModuleStates(speeds, moduleStates);
+    bench::DoNotOptimize(moduleStates.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * speeds.size());
+}
+
+void SwerveToChassisSpeeds(bench::State& state) {
+  auto kinematics = MakeKinematics();
+  auto moduleStates = kinematics.ToSwerveModuleStates(
+      frc::ChassisSpeeds{1.5_mps, 0.5_mps, 1_rad_per_s});
+  while (state.KeepRunning()) {
+    bench::DoNotOptimize(kinematics.ToChassisSpeeds(moduleStates));
+  }
+}
+
+}  // namespace
+
+static bench::Registration gSwerveToModuleStates{
+    "wpimath/SwerveDriveKinematics/ToSwerveModuleStates",
+    SwerveToModuleStates};
+static bench::Registration gSwerveToModuleStatesBatch{
+    "wpimath/SwerveDriveKinematics/ToSwerveModuleStatesBatch",
+    SwerveToModuleStatesBatch, {256}};
+static bench::Registration gSwerveToChassisSpeeds{
+    "wpimath/SwerveDriveKinematics/ToChassisSpeeds", SwerveToChassisSpeeds};
@@ -0,0 +1,51 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <frc/trajectory/TrajectoryGenerator.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+// A path weaving across the field through the given number of points
+std::vector<frc::Translation2d> MakeInteriorWaypoints(int64_t count) {
+  std::vector<frc::Translation2d> waypoints;
+  for (int64_t i = 0; i < count; ++i) {
+    waypoints.emplace_back(1_m * (i + 1), i % 2 == 0 ? 1_m : -1_m);
+  }
+  return waypoints;
+}
+
+void GenerateCubic(bench::State& state) {
+  auto interior = MakeInteriorWaypoints(state.GetArg());
+  frc::Pose2d start{0_m, 0_m, 0_deg};
+  frc::Pose2d end{1_m * (interior.size() + 1), 0_m, 0_deg};
+  frc::TrajectoryConfig config{3_mps, 2_mps_sq};
+  while (state.KeepRunning()) {
+    bench::DoNotOptimize(frc::TrajectoryGenerator::GenerateTrajectory(
+        start, interior, end, config));
+  }
+}
+
+void GenerateQuintic(bench::State& state) {
+  std::vector<frc::Pose2d> waypoints{{0_m, 0_m, 0_deg}};
+  for (auto&& point : MakeInteriorWaypoints(state.GetArg())) {
+    waypoints.emplace_back(point, 0_deg);
+  }
+  waypoints.emplace_back(1_m * waypoints.size(), 0_m, 0_deg);
+  frc::TrajectoryConfig config{3_mps, 2_mps_sq};
+  while (state.KeepRunning()) {
+    bench::DoNotOptimize(
+        frc::TrajectoryGenerator::GenerateTrajectory(waypoints, config));
+  }
+}
+
+}  // namespace
+
+static bench::Registration gGenerateCubic{
+    "wpimath/TrajectoryGenerator/Cubic", GenerateCubic, {1, 8}};
+static bench::Registration gGenerateQuintic{
+    "wpimath/TrajectoryGenerator/Quintic", GenerateQuintic, {1, 8}};
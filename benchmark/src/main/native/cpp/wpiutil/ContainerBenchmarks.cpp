@@ -0,0 +1,110 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/DenseMap.h>
+#include <wpi/SmallVector.h>
+#include <wpi/StringMap.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+// Keys shaped like NetworkTables entry names
+std::vector<std::string> MakeKeys(int64_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (int64_t i = 0; i < count; ++i) {
+    keys.emplace_back(fmt::format("/SmartDashboard/Subsystem{}/Value{}",
+                                  i % 16, i));
+  }
+  return keys;
+}
+
+void StringMapInsert(bench::State& state) {
+  auto keys = MakeKeys(state.GetArg());
+  while (state.KeepRunning()) {
+    wpi::StringMap<int> map;
+    int value = 0;
+    for (auto&& key : keys) {
+      map[key] = value++;
+    }
+    bench::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.GetIterations() * keys.size());
+}
+
+void StringMapFind(bench::State& state) {
+  auto keys = MakeKeys(state.GetArg());
+  wpi::StringMap<int> map;
+  int value = 0;
+  for (auto&& key : keys) {
+    map[key] = value++;
+  }
+  while (state.KeepRunning()) {
+    for (auto&& key : keys) {
+      bench::DoNotOptimize(map.find(key));
+    }
+  }
+  state.SetItemsProcessed(state.GetIterations() * keys.size());
+}
+
+void DenseMapInsert(bench::State& state) {
+  int64_t count = state.GetArg();
+  while (state.KeepRunning()) {
+    wpi::DenseMap<unsigned int, int> map;
+    for (int64_t i = 0; i < count; ++i) {
+      // spread the keys like HAL handles
+      map[static_cast<unsigned int>(i * 2654435761u)] = i;
+    }
+    bench::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.GetIterations() * count);
+}
+
+void DenseMapFind(bench::State& state) {
+  int64_t count = state.GetArg();
+  wpi::DenseMap<unsigned int, int> map;
+  for (int64_t i = 0; i < count; ++i) {
+    map[static_cast<unsigned int>(i * 2654435761u)] = i;
+  }
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < count; ++i) {
+      bench::DoNotOptimize(
+          map.find(static_cast<unsigned int>(i * 2654435761u)));
+    }
+  }
+  state.SetItemsProcessed(state.GetIterations() * count);
+}
+
+void SmallVectorPushBack(bench::State& state) {
+  int64_t count = state.GetArg();
+  while (state.KeepRunning()) {
+    wpi::SmallVector<int, 16> vec;
+    for (int64_t i = 0; i < count; ++i) {
+      vec.push_back(i);
+    }
+    bench::DoNotOptimize(vec.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * count);
+}
+
+}  // namespace
+
+static bench::Registration gStringMapInsert{"wpiutil/StringMap/Insert",
+                                            StringMapInsert, {16, 1024}};
+static bench::Registration gStringMapFind{"wpiutil/StringMap/Find",
+                                          StringMapFind, {16, 1024}};
+static bench::Registration gDenseMapInsert{"wpiutil/DenseMap/Insert",
+                                           DenseMapInsert, {16, 1024}};
+static bench::Registration gDenseMapFind{"wpiutil/DenseMap/Find", DenseMapFind,
+                                         {16, 1024}};
+// 16 fits in the inline storage; 1024 grows onto the heap
+static bench::Registration gSmallVectorPushBack{
+    "wpiutil/SmallVector/PushBack", SmallVectorPushBack, {16, 1024}};
@@ -0,0 +1,46 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <wpi/DataLog.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+// The cost to the caller of appending; the writer discards the data so the
+// numbers don't depend on the disk
+void AppendDouble(bench::State& state) {
+  wpi::log::DataLog log{[](wpi::span<const uint8_t> data) {
+    bench::DoNotOptimize(data.data());
+  }};
+  wpi::log::DoubleLogEntry entry{log, "value"};
+  double value = 0;
+  while (state.KeepRunning()) {
+    entry.Append(value);
+    value += 0.5;
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+void AppendDoubleArray(bench::State& state) {
+  wpi::log::DataLog log{[](wpi::span<const uint8_t> data) {
+    bench::DoNotOptimize(data.data());
+  }};
+  wpi::log::DoubleArrayLogEntry entry{log, "values"};
+  double values[12] = {};
+  while (state.KeepRunning()) {
+    entry.Append(values);
+    values[0] += 0.5;
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+}  // namespace
+
+static bench::Registration gAppendDouble{"wpiutil/DataLog/AppendDouble",
+                                         AppendDouble};
+static bench::Registration gAppendDoubleArray{
+    "wpiutil/DataLog/AppendDoubleArray", AppendDoubleArray};
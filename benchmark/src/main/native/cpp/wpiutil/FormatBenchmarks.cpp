@@ -0,0 +1,92 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <wpi/SmallString.h>
+#include <wpi/fmt/raw_ostream.h>
+#include <wpi/json.h>
+#include <wpi/raw_ostream.h>
+
+#include "bench/Benchmark.h"
+
+namespace {
+
+// A document shaped like a saved layout: an array of objects with strings,
+// numbers, and small arrays
+wpi::json MakeDocument(int64_t count) {
+  wpi::json doc = wpi::json::array();
+  for (int64_t i = 0; i < count; ++i) {
+    doc.push_back({{"name", fmt::format("/SmartDashboard/Value{}", i)},
+                   {"type", "double"},
+                   {"value", i * 0.25},
+                   {"persistent", i % 2 == 0},
+                   {"position", {i, i + 1, i + 2}}});
+  }
+  return doc;
+}
+
+void JsonParse(bench::State& state) {
+  std::string text = MakeDocument(state.GetArg()).dump();
+  while (state.KeepRunning()) {
+    bench::DoNotOptimize(wpi::json::parse(text));
+  }
+  state.SetItemsProcessed(state.GetIterations() * text.size());
+}
+
+void JsonSerialize(bench::State& state) {
+  auto doc = MakeDocument(state.GetArg());
+  wpi::SmallString<4096> buf;
+  while (state.KeepRunning()) {
+    buf.clear();
+    wpi::raw_svector_ostream os{buf};
+    doc.dump(os);
+    bench::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * buf.size());
+}
+
+void RawOstreamWrite(bench::State& state) {
+  int64_t count = state.GetArg();
+  std::string_view name = "/SmartDashboard/Value";
+  wpi::SmallString<4096> buf;
+  while (state.KeepRunning()) {
+    buf.clear();
+    wpi::raw_svector_ostream os{buf};
+    for (int64_t i = 0; i < count; ++i) {
+      os << name << ' ' << "double" << '\n';
+    }
+    bench::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * count);
+}
+
+void RawOstreamPrint(bench::State& state) {
+  int64_t count = state.GetArg();
+  wpi::SmallString<4096> buf;
+  while (state.KeepRunning()) {
+    buf.clear();
+    wpi::raw_svector_ostream os{buf};
+    for (int64_t i = 0; i < count; ++i) {
+      fmt::print(os, "value{} {} {}\n", i, i * 7, i * 0.25);
+    }
+    bench::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * count);
+}
+
+}  // namespace
+
+static bench::Registration gJsonParse{"wpiutil/json/Parse", JsonParse,
+                                      {16, 1024}};
+static bench::Registration gJsonSerialize{"wpiutil/json/Serialize",
+                                          JsonSerialize, {16, 1024}};
+static bench::Registration gRawOstreamWrite{"wpiutil/raw_ostream/Write",
+                                            RawOstreamWrite, {256}};
+static bench::Registration gRawOstreamPrint{"wpiutil/raw_ostream/Print",
+                                            RawOstreamPrint, {256}};
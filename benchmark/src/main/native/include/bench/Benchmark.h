@@ -0,0 +1,166 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <functional>
+#include <initializer_list>
+#include <string_view>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace bench {
+
+/**
+ * The state of one run of a benchmark function.  The function does its setup,
+ * then runs the code being measured in a loop:
+ *
+ * <pre>
+ * while (state.KeepRunning()) {
+ *   ...
+ * }
+ * </pre>
+ *
+ * Only the time spent in the loop is measured.
+ */
+class State {
+ public:
+  State(int64_t arg, int64_t iterations)
+      : m_arg{arg}, m_remaining{iterations}, m_iterations{iterations} {}
+
+  /**
+   * Returns true while the loop body should run again.  The first call starts
+   * the clock and the last call stops it.
+   */
+  bool KeepRunning() {
+    if (m_remaining-- > 0) {
+      if (!m_started) {
+        m_started = true;
+        m_start = Clock::now();
+      }
+      return true;
+    }
+    if (!m_stopped) {
+      m_stopped = true;
+      PauseTiming();
+    }
+    return false;
+  }
+
+  /**
+   * Stops the clock, for per-iteration setup that shouldn't be measured.
+   */
+  void PauseTiming() { m_elapsed += Clock::now() - m_start; }
+
+  /**
+   * Restarts the clock after PauseTiming().
+   */
+  void ResumeTiming() { m_start = Clock::now(); }
+
+  /**
+   * Gets the argument the benchmark was registered with, e.g. a problem size;
+   * 0 if it was registered without arguments.
+   */
+  int64_t GetArg() const { return m_arg; }
+
+  /**
+   * Gets the number of loop iterations of this run.
+   */
+  int64_t GetIterations() const { return m_iterations; }
+
+  /**
+   * Sets the number of items (entries, commands, bytes...) processed in total
+   * by the run, to report a rate along with the time per iteration.
+   */
+  void SetItemsProcessed(int64_t items) { m_items = items; }
+
+  int64_t GetItemsProcessed() const { return m_items; }
+
+  /**
+   * Gets the time measured by the run, in seconds.
+   */
+  double GetElapsed() const {
+    return std::chrono::duration<double>(m_elapsed).count();
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  int64_t m_arg;
+  int64_t m_remaining;
+  int64_t m_iterations;
+  int64_t m_items = 0;
+  bool m_started = false;
+  bool m_stopped = false;
+  Clock::time_point m_start;
+  Clock::duration m_elapsed{0};
+};
+
+namespace detail {
+void UseCharPointer(const volatile char*);
+}  // namespace detail
+
+/**
+ * Keeps the compiler from optimizing away the computation of a value.
+ */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+  detail::UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+using Function = std::function<void(State&)>;
+
+/**
+ * Registers a benchmark.  Names are paths, starting with the library, e.g.
+ * "wpiutil/StringMap/Find".  The function is run once per argument, and the
+ * argument is appended to the name in the results.
+ *
+ * @param name Name
+ * @param func Benchmark function
+ * @param args Arguments, e.g. problem sizes; if empty, the function is run
+ *             once with an argument of 0
+ */
+void Register(std::string_view name, Function func,
+              std::initializer_list<int64_t> args = {});
+
+/**
+ * Registers a benchmark at static initialization time, so that a benchmark
+ * source file only needs to be linked into the executable to be run.
+ */
+struct Registration {
+  Registration(std::string_view name, Function func,
+               std::initializer_list<int64_t> args = {}) {
+    Register(name, std::move(func), args);
+  }
+};
+
+/**
+ * Runs the registered benchmarks and writes the results as JSON.
+ *
+ * Options:
+ * - --filter=&lt;text&gt;: only run benchmarks with names containing text
+ * - --min-time=&lt;seconds&gt;: minimum measured time of each repetition
+ *   (default 0.1)
+ * - --repetitions=&lt;n&gt;: repetitions of each benchmark (default 5)
+ * - --out=&lt;file&gt;: write the results to file instead of stdout
+ * - --baseline=&lt;file&gt;: results of an earlier run to compare against
+ * - --label=&lt;text&gt;: recorded in the results, e.g. the release being run
+ * - --list: print the benchmark names and exit
+ *
+ * @return Exit code for main()
+ */
+int RunBenchmarks(int argc, char* argv[]);
+
+}  // namespace bench
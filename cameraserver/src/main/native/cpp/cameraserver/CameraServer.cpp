@@ -4,13 +4,18 @@
 
 #include "cameraserver/CameraServer.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
 #include <wpi/DenseMap.h>
+#include <wpi/SafeThread.h>
 #include <wpi/SmallString.h>
 #include <wpi/StringExtras.h>
 #include <wpi/StringMap.h>
@@ -23,13 +28,42 @@ using namespace frc;
 
 static constexpr char const* kPublishName = "/CameraPublisher";
 
+// How long network interfaces must be unchanged before the stream values are
+// updated for them
+static constexpr auto kInterfaceSettleTime = std::chrono::seconds(1);
+
 namespace {
+// Updates the stream values once network interfaces have settled, so an
+// address that flaps is republished once rather than on every change
+class StreamUpdateThread : public wpi::SafeThread {
+ public:
+  void Main() override;
+
+  bool m_pending = false;
+  std::chrono::steady_clock::time_point m_updateTime;
+};
+
 struct Instance {
+  // Entry values to publish together; see Publish()
+  struct Values {
+    void Add(const nt::NetworkTableEntry& entry,
+             std::shared_ptr<nt::Value> value);
+
+    std::vector<NT_Entry> entries;
+    std::vector<std::shared_ptr<nt::Value>> values;
+  };
+
   Instance();
   std::shared_ptr<nt::NetworkTable> GetSourceTable(CS_Source source);
   std::vector<std::string> GetSinkStreamValues(CS_Sink sink);
   std::vector<std::string> GetSourceStreamValues(CS_Source source);
   void UpdateStreamValues();
+  void ScheduleStreamUpdate();
+  void PublishTelemetry();
+
+  // Sets the values that have changed since they were last published, all
+  // at once
+  void Publish(const Values& values);
 
   wpi::mutex m_mutex;
   std::atomic<int> m_defaultUsbDevice{0};
@@ -40,10 +74,15 @@ struct Instance {
   wpi::DenseMap<CS_Source, std::shared_ptr<nt::NetworkTable>> m_tables;
   std::shared_ptr<nt::NetworkTable> m_publishTable{
       nt::NetworkTableInstance::GetDefault().GetTable(kPublishName)};
+  wpi::SafeThreadOwner<StreamUpdateThread> m_streamUpdateThread;
   cs::VideoListener m_videoListener;
   int m_tableListener;
   int m_nextPort{CameraServer::kBasePort};
   std::vector<std::string> m_addresses;
+
+  // The values last set by Publish()
+  wpi::mutex m_publishMutex;
+  wpi::DenseMap<NT_Entry, std::shared_ptr<nt::Value>> m_published;
 };
 }  // namespace
 
@@ -52,6 +91,57 @@ static Instance& GetInstance() {
   return instance;
 }
 
+void StreamUpdateThread::Main() {
+  std::unique_lock lock(m_mutex);
+  while (m_active) {
+    m_cond.wait(lock, [&] { return !m_active || m_pending; });
+    if (!m_active) {
+      break;
+    }
+    // each change pushes the update back
+    if (std::chrono::steady_clock::now() < m_updateTime) {
+      m_cond.wait_until(lock, m_updateTime);
+      continue;
+    }
+    m_pending = false;
+    lock.unlock();
+    ::GetInstance().UpdateStreamValues();
+    lock.lock();
+  }
+}
+
+void Instance::Values::Add(const nt::NetworkTableEntry& entry,
+                           std::shared_ptr<nt::Value> value) {
+  // a later value for the same entry replaces an earlier one
+  auto it = std::find(entries.begin(), entries.end(), entry.GetHandle());
+  if (it != entries.end()) {
+    values[it - entries.begin()] = std::move(value);
+    return;
+  }
+  entries.emplace_back(entry.GetHandle());
+  values.emplace_back(std::move(value));
+}
+
+void Instance::Publish(const Values& values) {
+  std::vector<NT_Entry> changedEntries;
+  std::vector<std::shared_ptr<nt::Value>> changedValues;
+  // held while setting, so values published concurrently land in the same
+  // order as in m_published
+  std::scoped_lock lock(m_publishMutex);
+  for (size_t i = 0; i < values.entries.size(); ++i) {
+    auto& published = m_published[values.entries[i]];
+    if (published && *published == *values.values[i]) {
+      continue;
+    }
+    published = values.values[i];
+    changedEntries.emplace_back(values.entries[i]);
+    changedValues.emplace_back(values.values[i]);
+  }
+  if (!changedEntries.empty()) {
+    nt::SetEntryValues(changedEntries, changedValues);
+  }
+}
+
 CameraServer* CameraServer::GetInstance() {
   ::GetInstance();
   static CameraServer instance;
@@ -164,7 +254,10 @@ std::vector<std::string> Instance::GetSourceStreamValues(CS_Source source) {
 }
 
 void Instance::UpdateStreamValues() {
+  Values values;
   std::scoped_lock lock(m_mutex);
+  m_addresses = cs::GetNetworkInterfaces();
+
   // Over all the sinks...
   for (const auto& i : m_sinks) {
     CS_Status status = 0;
@@ -186,9 +279,10 @@ void Instance::UpdateStreamValues() {
       }
 
       // Set table value
-      auto values = GetSinkStreamValues(sink);
-      if (!values.empty()) {
-        table->GetEntry("streams").SetStringArray(values);
+      auto streams = GetSinkStreamValues(sink);
+      if (!streams.empty()) {
+        values.Add(table->GetEntry("streams"),
+                   nt::Value::MakeStringArray(std::move(streams)));
       }
     }
   }
@@ -201,12 +295,22 @@ void Instance::UpdateStreamValues() {
     auto table = m_tables.lookup(source);
     if (table) {
       // Set table value
-      auto values = GetSourceStreamValues(source);
-      if (!values.empty()) {
-        table->GetEntry("streams").SetStringArray(values);
+      auto streams = GetSourceStreamValues(source);
+      if (!streams.empty()) {
+        values.Add(table->GetEntry("streams"),
+                   nt::Value::MakeStringArray(std::move(streams)));
       }
     }
   }
+  Publish(values);
+}
+
+void Instance::ScheduleStreamUpdate() {
+  if (auto thr = m_streamUpdateThread.GetThread()) {
+    thr->m_pending = true;
+    thr->m_updateTime = std::chrono::steady_clock::now() + kInterfaceSettleTime;
+    thr->m_cond.notify_one();
+  }
 }
 
 static std::string PixelFormatToString(int pixelFormat) {
@@ -231,6 +335,80 @@ static std::string VideoModeToString(const cs::VideoMode& mode) {
                      PixelFormatToString(mode.pixelFormat), mode.fps);
 }
 
+// Latency telemetry kinds (each followed by its P99 kind), and their
+// "Telemetry/" names
+static constexpr std::pair<CS_TelemetryKind, const char*> kSourceLatencies[] =
+    {{CS_SOURCE_CAPTURE_LATENCY_P50, "capture"},
+     {CS_SOURCE_CONVERT_LATENCY_P50, "convert"},
+     {CS_SOURCE_ENCODE_LATENCY_P50, "encode"}};
+static constexpr std::pair<CS_TelemetryKind, const char*> kSinkLatencies[] = {
+    {CS_SINK_SEND_LATENCY_P50, "send"}, {CS_SINK_FRAME_LATENCY_P50, "frame"}};
+
+static void PutLatencyTelemetry(nt::NetworkTable* table,
+                                std::string_view prefix, CS_Handle handle,
+                                CS_TelemetryKind kind, const char* name,
+                                Instance::Values* values) {
+  CS_Status status = 0;
+  int64_t p50 = cs::GetTelemetryValue(handle, kind, &status);
+  int64_t p99 = cs::GetTelemetryValue(
+      handle, static_cast<CS_TelemetryKind>(kind + 1), &status);
+  if (status == 0) {
+    values->Add(table->GetEntry(fmt::format("{}{}LatencyP50", prefix, name)),
+                nt::Value::MakeDouble(p50 / 1000.0));
+    values->Add(table->GetEntry(fmt::format("{}{}LatencyP99", prefix, name)),
+                nt::Value::MakeDouble(p99 / 1000.0));
+  }
+}
+
+void Instance::PublishTelemetry() {
+  std::vector<std::pair<CS_Source, std::shared_ptr<nt::NetworkTable>>> tables;
+  std::vector<cs::VideoSink> sinks;
+  {
+    std::scoped_lock lock(m_mutex);
+    for (auto&& table : m_tables) {
+      tables.emplace_back(table.first, table.second);
+    }
+    for (auto&& sink : m_sinks) {
+      sinks.emplace_back(sink.second);
+    }
+  }
+
+  Values values;
+  for (auto&& [source, table] : tables) {
+    for (auto&& [kind, name] : kSourceLatencies) {
+      PutLatencyTelemetry(table.get(), "Telemetry/", source, kind, name,
+                          &values);
+    }
+    CS_Status status = 0;
+    for (auto&& count : cs::GetTelemetryConversionCounts(source, &status)) {
+      values.Add(
+          table->GetEntry(fmt::format(
+              "Telemetry/Conversions/{}-{}",
+              PixelFormatToString(count.fromPixelFormat),
+              PixelFormatToString(count.toPixelFormat))),
+          nt::Value::MakeDouble(count.count));
+    }
+  }
+
+  for (auto&& sink : sinks) {
+    CS_Status status = 0;
+    auto table = GetSourceTable(cs::GetSinkSource(sink.GetHandle(), &status));
+    if (!table) {
+      continue;
+    }
+    auto prefix = fmt::format("Telemetry/Sinks/{}/", sink.GetName());
+    for (auto&& [kind, name] : kSinkLatencies) {
+      PutLatencyTelemetry(table.get(), prefix, sink.GetHandle(), kind, name,
+                          &values);
+    }
+    int64_t dropped = cs::GetTelemetryValue(sink.GetHandle(),
+                                            CS_SINK_FRAMES_DROPPED, &status);
+    values.Add(table->GetEntry(prefix + "framesDropped"),
+               nt::Value::MakeDouble(status == 0 ? dropped : 0));
+  }
+  Publish(values);
+}
+
 static std::vector<std::string> GetSourceModeValues(int source) {
   std::vector<std::string> rv;
   CS_Status status = 0;
@@ -240,8 +418,11 @@ static std::vector<std::string> GetSourceModeValues(int source) {
   return rv;
 }
 
+// New property values are set as defaults directly; everything else is added
+// to values
 static void PutSourcePropertyValue(nt::NetworkTable* table,
-                                   const cs::VideoEvent& event, bool isNew) {
+                                   const cs::VideoEvent& event, bool isNew,
+                                   Instance::Values* values) {
   std::string_view namePrefix;
   std::string_view infoPrefix;
   if (wpi::starts_with(event.name, "raw_")) {
@@ -261,30 +442,38 @@ static void PutSourcePropertyValue(nt::NetworkTable* table,
       if (isNew) {
         entry.SetDefaultBoolean(event.value != 0);
       } else {
-        entry.SetBoolean(event.value != 0);
+        values->Add(entry, nt::Value::MakeBoolean(event.value != 0));
       }
       break;
     case CS_PROP_INTEGER:
     case CS_PROP_ENUM:
       if (isNew) {
         entry.SetDefaultDouble(event.value);
-        table->GetEntry(fmt::format("{}/{}/min", infoPrefix, event.name))
-            .SetDouble(cs::GetPropertyMin(event.propertyHandle, &status));
-        table->GetEntry(fmt::format("{}/{}/max", infoPrefix, event.name))
-            .SetDouble(cs::GetPropertyMax(event.propertyHandle, &status));
-        table->GetEntry(fmt::format("{}/{}/step", infoPrefix, event.name))
-            .SetDouble(cs::GetPropertyStep(event.propertyHandle, &status));
-        table->GetEntry(fmt::format("{}/{}/default", infoPrefix, event.name))
-            .SetDouble(cs::GetPropertyDefault(event.propertyHandle, &status));
+        values->Add(
+            table->GetEntry(fmt::format("{}/{}/min", infoPrefix, event.name)),
+            nt::Value::MakeDouble(
+                cs::GetPropertyMin(event.propertyHandle, &status)));
+        values->Add(
+            table->GetEntry(fmt::format("{}/{}/max", infoPrefix, event.name)),
+            nt::Value::MakeDouble(
+                cs::GetPropertyMax(event.propertyHandle, &status)));
+        values->Add(
+            table->GetEntry(fmt::format("{}/{}/step", infoPrefix, event.name)),
+            nt::Value::MakeDouble(
+                cs::GetPropertyStep(event.propertyHandle, &status)));
+        values->Add(table->GetEntry(
+                        fmt::format("{}/{}/default", infoPrefix, event.name)),
+                    nt::Value::MakeDouble(
+                        cs::GetPropertyDefault(event.propertyHandle, &status)));
       } else {
-        entry.SetDouble(event.value);
+        values->Add(entry, nt::Value::MakeDouble(event.value));
       }
       break;
     case CS_PROP_STRING:
       if (isNew) {
         entry.SetDefaultString(event.valueStr);
       } else {
-        entry.SetString(event.valueStr);
+        values->Add(entry, nt::Value::MakeString(event.valueStr));
       }
       break;
     default:
@@ -303,11 +492,24 @@ Instance::Instance() {
   // - "modes" (string array): Available video modes
   // - "Property/{Property}" - Property values
   // - "PropertyInfo/{Property}" - Property supporting information
-
-  // Listener for video events
+  // - "Telemetry/" - Only if telemetry is enabled with SetTelemetryPeriod().
+  //   Latencies are p50/p99 over the last period, in milliseconds:
+  //   - "{stage}LatencyP50", "{stage}LatencyP99" (double): for the
+  //     capture, convert, and encode stages
+  //   - "Conversions/{from}-{to}" (double): pixel format conversions (the
+  //     same format for a resize)
+  //   - "Sinks/{Sink.Name}/" - for sinks connected to the source:
+  //     "sendLatencyP50/P99" and "frameLatencyP50/P99" (capture to sent),
+  //     and "framesDropped" (double)
+
+  m_streamUpdateThread.Start();
+
+  // Listener for video events.  The values for each event are published
+  // together, and only if they've changed.
   m_videoListener = cs::VideoListener{
       [=](const cs::VideoEvent& event) {
         CS_Status status = 0;
+        Values values;
         switch (event.kind) {
           case cs::VideoEvent::kSourceCreated: {
             // Create subtable for the camera
@@ -317,30 +519,34 @@ Instance::Instance() {
               m_tables.insert(std::make_pair(event.sourceHandle, table));
             }
             wpi::SmallString<64> buf;
-            table->GetEntry("source").SetString(
-                MakeSourceValue(event.sourceHandle, buf));
+            values.Add(table->GetEntry("source"),
+                       nt::Value::MakeString(
+                           MakeSourceValue(event.sourceHandle, buf)));
             wpi::SmallString<64> descBuf;
-            table->GetEntry("description")
-                .SetString(cs::GetSourceDescription(event.sourceHandle, descBuf,
-                                                    &status));
-            table->GetEntry("connected")
-                .SetBoolean(cs::IsSourceConnected(event.sourceHandle, &status));
-            table->GetEntry("streams").SetStringArray(
-                GetSourceStreamValues(event.sourceHandle));
+            values.Add(table->GetEntry("description"),
+                       nt::Value::MakeString(cs::GetSourceDescription(
+                           event.sourceHandle, descBuf, &status)));
+            values.Add(table->GetEntry("connected"),
+                       nt::Value::MakeBoolean(
+                           cs::IsSourceConnected(event.sourceHandle, &status)));
+            values.Add(table->GetEntry("streams"),
+                       nt::Value::MakeStringArray(
+                           GetSourceStreamValues(event.sourceHandle)));
             auto mode = cs::GetSourceVideoMode(event.sourceHandle, &status);
             table->GetEntry("mode").SetDefaultString(VideoModeToString(mode));
-            table->GetEntry("modes").SetStringArray(
-                GetSourceModeValues(event.sourceHandle));
+            values.Add(table->GetEntry("modes"),
+                       nt::Value::MakeStringArray(
+                           GetSourceModeValues(event.sourceHandle)));
             break;
           }
           case cs::VideoEvent::kSourceDestroyed: {
             auto table = GetSourceTable(event.sourceHandle);
             if (table) {
-              table->GetEntry("source").SetString("");
-              table->GetEntry("streams").SetStringArray(
-                  std::vector<std::string>{});
-              table->GetEntry("modes").SetStringArray(
-                  std::vector<std::string>{});
+              auto empty =
+                  nt::Value::MakeStringArray(std::vector<std::string>{});
+              values.Add(table->GetEntry("source"), nt::Value::MakeString(""));
+              values.Add(table->GetEntry("streams"), empty);
+              values.Add(table->GetEntry("modes"), empty);
             }
             break;
           }
@@ -349,46 +555,50 @@ Instance::Instance() {
             if (table) {
               // update the description too (as it may have changed)
               wpi::SmallString<64> descBuf;
-              table->GetEntry("description")
-                  .SetString(cs::GetSourceDescription(event.sourceHandle,
-                                                      descBuf, &status));
-              table->GetEntry("connected").SetBoolean(true);
+              values.Add(table->GetEntry("description"),
+                         nt::Value::MakeString(cs::GetSourceDescription(
+                             event.sourceHandle, descBuf, &status)));
+              values.Add(table->GetEntry("connected"),
+                         nt::Value::MakeBoolean(true));
             }
             break;
           }
           case cs::VideoEvent::kSourceDisconnected: {
             auto table = GetSourceTable(event.sourceHandle);
             if (table) {
-              table->GetEntry("connected").SetBoolean(false);
+              values.Add(table->GetEntry("connected"),
+                         nt::Value::MakeBoolean(false));
             }
             break;
           }
           case cs::VideoEvent::kSourceVideoModesUpdated: {
             auto table = GetSourceTable(event.sourceHandle);
             if (table) {
-              table->GetEntry("modes").SetStringArray(
-                  GetSourceModeValues(event.sourceHandle));
+              values.Add(table->GetEntry("modes"),
+                         nt::Value::MakeStringArray(
+                             GetSourceModeValues(event.sourceHandle)));
             }
             break;
           }
           case cs::VideoEvent::kSourceVideoModeChanged: {
             auto table = GetSourceTable(event.sourceHandle);
             if (table) {
-              table->GetEntry("mode").SetString(VideoModeToString(event.mode));
+              values.Add(table->GetEntry("mode"),
+                         nt::Value::MakeString(VideoModeToString(event.mode)));
             }
             break;
           }
           case cs::VideoEvent::kSourcePropertyCreated: {
             auto table = GetSourceTable(event.sourceHandle);
             if (table) {
-              PutSourcePropertyValue(table.get(), event, true);
+              PutSourcePropertyValue(table.get(), event, true, &values);
             }
             break;
           }
           case cs::VideoEvent::kSourcePropertyValueUpdated: {
             auto table = GetSourceTable(event.sourceHandle);
             if (table) {
-              PutSourcePropertyValue(table.get(), event, false);
+              PutSourcePropertyValue(table.get(), event, false, &values);
             }
             break;
           }
@@ -397,25 +607,30 @@ Instance::Instance() {
             if (table) {
               auto choices =
                   cs::GetEnumPropertyChoices(event.propertyHandle, &status);
-              table
-                  ->GetEntry(fmt::format("PropertyInfo/{}/choices", event.name))
-                  .SetStringArray(choices);
+              values.Add(
+                  table->GetEntry(
+                      fmt::format("PropertyInfo/{}/choices", event.name)),
+                  nt::Value::MakeStringArray(std::move(choices)));
             }
             break;
           }
           case cs::VideoEvent::kSinkSourceChanged:
           case cs::VideoEvent::kSinkCreated:
           case cs::VideoEvent::kSinkDestroyed:
-          case cs::VideoEvent::kNetworkInterfacesChanged: {
-            m_addresses = cs::GetNetworkInterfaces();
             UpdateStreamValues();
             break;
-          }
+          case cs::VideoEvent::kNetworkInterfacesChanged:
+            ScheduleStreamUpdate();
+            break;
+          case cs::VideoEvent::kTelemetryUpdated:
+            PublishTelemetry();
+            break;
           default:
             break;
         }
+        Publish(values);
       },
-      0x4fff, true};
+      0xcfff, true};
 
   // Listener for NetworkTable events
   // We don't currently support changing settings via NT due to
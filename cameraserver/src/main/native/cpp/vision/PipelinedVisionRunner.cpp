@@ -0,0 +1,155 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "vision/PipelinedVisionRunner.h"
+
+#include <opencv2/core/mat.hpp>
+#include <wpi/timestamp.h>
+
+#include "cameraserver/CameraServerShared.h"
+
+using namespace frc;
+
+// Weight of each new sample in the latency averages
+static constexpr double kLatencyAlpha = 0.1;
+
+static void UpdateLatency(double& average, uint64_t start, uint64_t end) {
+  double sample = end > start ? (end - start) / 1000000.0 : 0.0;
+  if (average == 0) {
+    average = sample;
+  } else {
+    average += kLatencyAlpha * (sample - average);
+  }
+}
+
+struct PipelinedVisionRunnerBase::Slot {
+  cv::Mat image;
+  uint64_t frameTime = 0;
+  uint64_t grabbedTime = 0;
+};
+
+PipelinedVisionRunnerBase::PipelinedVisionRunnerBase(
+    cs::VideoSource videoSource, int numWorkers)
+    : m_cvSink("PipelinedVisionRunner CvSink"), m_numWorkers(numWorkers) {
+  m_cvSink.SetSource(videoSource);
+}
+
+// Located here and not in header due to cv::Mat forward declaration.
+PipelinedVisionRunnerBase::~PipelinedVisionRunnerBase() {
+  Stop();
+}
+
+void PipelinedVisionRunnerBase::Start() {
+  if (m_enabled.exchange(true)) {
+    return;  // already running
+  }
+  m_grabThread = std::thread(&PipelinedVisionRunnerBase::GrabThreadMain, this);
+  for (int i = 0; i < m_numWorkers; ++i) {
+    m_workerThreads.emplace_back(&PipelinedVisionRunnerBase::WorkerThreadMain,
+                                 this, i);
+  }
+}
+
+void PipelinedVisionRunnerBase::Stop() {
+  {
+    std::scoped_lock lock(m_mutex);
+    m_enabled = false;
+  }
+  m_frameCv.notify_all();
+  if (m_grabThread.joinable()) {
+    m_grabThread.join();
+  }
+  for (auto&& thr : m_workerThreads) {
+    if (thr.joinable()) {
+      thr.join();
+    }
+  }
+  m_workerThreads.clear();
+}
+
+PipelinedVisionRunnerBase::Stats PipelinedVisionRunnerBase::GetStats() const {
+  std::scoped_lock lock(m_mutex);
+  return m_stats;
+}
+
+void PipelinedVisionRunnerBase::GrabThreadMain() {
+  auto csShared = frc::GetCameraServerShared();
+  while (m_enabled) {
+    // Reuse the image of a frame that's been processed (or dropped) so the
+    // sink can grab into it without allocating
+    std::unique_ptr<Slot> slot;
+    {
+      std::scoped_lock lock(m_mutex);
+      if (!m_free.empty()) {
+        slot = std::move(m_free.back());
+        m_free.pop_back();
+      }
+    }
+    if (!slot) {
+      slot = std::make_unique<Slot>();
+    }
+
+    slot->frameTime = m_cvSink.GrabFrame(slot->image);
+    if (slot->frameTime == 0) {
+      if (m_enabled) {
+        auto error = m_cvSink.GetError();
+        csShared->ReportDriverStationError(error.c_str());
+      }
+      std::scoped_lock lock(m_mutex);
+      m_free.emplace_back(std::move(slot));
+      continue;
+    }
+    slot->grabbedTime = wpi::Now();
+
+    // Replace any frame no worker has taken yet; it's stale now
+    std::scoped_lock lock(m_mutex);
+    UpdateLatency(m_stats.grabLatency, slot->frameTime, slot->grabbedTime);
+    if (m_pending) {
+      ++m_stats.framesDropped;
+      m_free.emplace_back(std::move(m_pending));
+    }
+    m_pending = std::move(slot);
+    m_frameCv.notify_one();
+  }
+}
+
+void PipelinedVisionRunnerBase::WorkerThreadMain(int worker) {
+  std::unique_lock lock(m_mutex);
+  while (m_enabled) {
+    m_frameCv.wait(lock, [&] { return !m_enabled || m_pending; });
+    if (!m_enabled) {
+      break;
+    }
+    auto slot = std::move(m_pending);
+    uint64_t start = wpi::Now();
+    UpdateLatency(m_stats.queueLatency, slot->grabbedTime, start);
+    lock.unlock();
+
+    DoProcess(worker, slot->image);
+    uint64_t processed = wpi::Now();
+
+    // Drop the result if a newer frame's result has already been published
+    bool published = false;
+    {
+      std::scoped_lock publishLock(m_publishMutex);
+      if (slot->frameTime > m_lastPublished) {
+        m_lastPublished = slot->frameTime;
+        DoPublish(worker);
+        published = true;
+      }
+    }
+    uint64_t end = wpi::Now();
+
+    lock.lock();
+    UpdateLatency(m_stats.processLatency, start, processed);
+    if (published) {
+      UpdateLatency(m_stats.publishLatency, processed, end);
+      UpdateLatency(m_stats.captureToPublishLatency, slot->frameTime, end);
+      ++m_stats.framesProcessed;
+    } else {
+      ++m_stats.resultsDropped;
+    }
+    m_free.emplace_back(std::move(slot));
+  }
+}
@@ -0,0 +1,148 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "cscore.h"
+#include "cscore_cv.h"
+#include "vision/VisionPipeline.h"
+
+namespace frc {
+
+/**
+ * Non-template base class for PipelinedVisionRunner.
+ */
+class PipelinedVisionRunnerBase {
+ public:
+  /**
+   * Per-stage latencies (exponential moving averages, in seconds) and frame
+   * counts.
+   */
+  struct Stats {
+    /** From the frame's capture time to the end of grabbing (decoding) it. */
+    double grabLatency = 0;
+    /** From the end of grabbing a frame to a worker starting on it. */
+    double queueLatency = 0;
+    /** Time spent in the pipeline's Process(). */
+    double processLatency = 0;
+    /** Time spent in the listener. */
+    double publishLatency = 0;
+    /** From the frame's capture time to the end of publishing its result. */
+    double captureToPublishLatency = 0;
+    /** Frames processed and published. */
+    uint64_t framesProcessed = 0;
+    /** Frames replaced by a newer one before any worker was free. */
+    uint64_t framesDropped = 0;
+    /** Results not published because a newer frame's already had been. */
+    uint64_t resultsDropped = 0;
+  };
+
+  /**
+   * Creates a new pipelined vision runner. It will take images from the
+   * {@code videoSource} and call the virtual DoProcess() method on up to
+   * {@code numWorkers} of them at once.
+   *
+   * @param videoSource the video source to use to supply images for the
+   *                    pipelines
+   * @param numWorkers  the number of worker threads
+   */
+  PipelinedVisionRunnerBase(cs::VideoSource videoSource, int numWorkers);
+
+  virtual ~PipelinedVisionRunnerBase();
+
+  PipelinedVisionRunnerBase(const PipelinedVisionRunnerBase&) = delete;
+  PipelinedVisionRunnerBase& operator=(const PipelinedVisionRunnerBase&) =
+      delete;
+
+  /**
+   * Starts the grab thread and the worker threads.  Unlike
+   * VisionRunner::RunForever(), this returns immediately, so it may be called
+   * from the main robot thread.
+   */
+  void Start();
+
+  /**
+   * Stops the threads, waiting for any frames being processed to finish.
+   * Derived classes must call this in their destructor, as the workers call
+   * into them.
+   */
+  void Stop();
+
+  /**
+   * Gets the latency and frame count statistics.
+   */
+  Stats GetStats() const;
+
+ protected:
+  virtual void DoProcess(int worker, cv::Mat& image) = 0;
+  virtual void DoPublish(int worker) = 0;
+
+ private:
+  struct Slot;
+
+  void GrabThreadMain();
+  void WorkerThreadMain(int worker);
+
+  cs::CvSink m_cvSink;
+  int m_numWorkers;
+  std::atomic_bool m_enabled{false};
+
+  std::thread m_grabThread;
+  std::vector<std::thread> m_workerThreads;
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_frameCv;
+  // The newest frame not yet taken by a worker, and images ready for reuse
+  std::unique_ptr<Slot> m_pending;
+  std::vector<std::unique_ptr<Slot>> m_free;
+  Stats m_stats;
+
+  // Serializes the listener, and so orders the published results
+  wpi::mutex m_publishMutex;
+  uint64_t m_lastPublished = 0;
+};
+
+/**
+ * A vision runner that overlaps grabbing and decoding the next frame with
+ * processing the current ones, spreading the processing across a pool of
+ * workers.  Each worker has its own pipeline, as pipelines hold their
+ * outputs.
+ *
+ * <p>Frames are never queued: if every worker is busy when a new frame
+ * arrives, the older waiting frame is dropped, so the results are always of
+ * the newest frames possible.  Results are also published in frame order;
+ * one that finishes after a newer frame's result has been published is
+ * dropped.  The listener is never called concurrently.
+ *
+ * @see VisionRunner
+ */
+template <typename T>
+class PipelinedVisionRunner : public PipelinedVisionRunnerBase {
+ public:
+  PipelinedVisionRunner(cs::VideoSource videoSource, std::vector<T*> pipelines,
+                        std::function<void(T&)> listener);
+  ~PipelinedVisionRunner() override;
+
+ protected:
+  void DoProcess(int worker, cv::Mat& image) override;
+  void DoPublish(int worker) override;
+
+ private:
+  std::vector<T*> m_pipelines;
+  std::function<void(T&)> m_listener;
+};
+}  // namespace frc
+
+#include "PipelinedVisionRunner.inc"
@@ -2,9 +2,11 @@
 FILE(READ ${input} fileHex HEX)
 STRING(LENGTH "${fileHex}" fileHexSize)
 MATH(EXPR fileSize "${fileHexSize} / 2")
+FILE(SHA1 ${input} fileHash)
 
 GET_FILENAME_COMPONENT(inputBase ${input} NAME)
 STRING(REGEX REPLACE "[^a-zA-Z0-9]" "_" funcName "${inputBase}")
+SET(etagFuncName "GetResourceETag_${funcName}")
 SET(funcName "GetResource_${funcName}")
 
 FILE(WRITE "${output}" "#include <stddef.h>\n#include <string_view>\nextern \"C\" {\nstatic const unsigned char contents[] = {")
@@ -18,6 +20,7 @@ IF(NOT namespace STREQUAL "")
   FILE(APPEND "${output}" "namespace ${namespace} {\n")
 ENDIF()
 FILE(APPEND "${output}" "std::string_view ${funcName}() {\n  return std::string_view(reinterpret_cast<const char*>(contents), ${fileSize});\n}\n")
+FILE(APPEND "${output}" "std::string_view ${etagFuncName}() {\n  return \"\\\"${fileHash}\\\"\";\n}\n")
 IF(NOT namespace STREQUAL "")
   FILE(APPEND "${output}" "}\n")
 ENDIF()
@@ -0,0 +1,382 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// Benchmarks of frame conversions, cached image lookup, the image pool, and
+// MJPEG streaming to loopback clients, for comparing conversion backends
+// and catching performance regressions on each target.  Run with no
+// arguments; results are printed to stdout.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+#include <wpi/Logger.h>
+#include <wpi/NetworkStream.h>
+#include <wpi/TCPConnector.h>
+#include <wpi/timestamp.h>
+
+#include "CvSourceImpl.h"
+#include "Frame.h"
+#include "Image.h"
+#include "Instance.h"
+#include "JpegCodec.h"
+#include "cscore_cv.h"
+
+using Clock = std::chrono::steady_clock;
+
+static std::atomic<uint64_t> gAllocations{0};
+
+void* operator new(std::size_t size) {
+  ++gAllocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+constexpr int kResolutions[][2] = {
+    {320, 240}, {640, 480}, {1280, 720}, {1920, 1080}};
+
+int gNextPort = 10300;
+
+double Elapsed(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// An image to convert, in its source format
+struct Input {
+  cs::VideoMode::PixelFormat pixelFormat;
+  int width;
+  int height;
+  std::string data;
+};
+
+// A test pattern: gradients with some noise, so JPEG compression has
+// realistic work to do
+std::string MakeBGR(int width, int height) {
+  std::string data(width * height * 3, '\0');
+  uint32_t noise = 1;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      noise = noise * 1103515245 + 12345;
+      int n = (noise >> 16) & 0x0f;
+      char* px = &data[(y * width + x) * 3];
+      px[0] = static_cast<char>((x * 255 / width + n) & 0xff);
+      px[1] = static_cast<char>((y * 255 / height + n) & 0xff);
+      px[2] = static_cast<char>(((x + y) & 0xff) ^ n);
+    }
+  }
+  return data;
+}
+
+std::string MakeYUYV(int width, int height) {
+  std::string data(width * height * 2, '\0');
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; x += 2) {
+      char* px = &data[(y * width + x) * 2];
+      px[0] = static_cast<char>(x * 255 / width);
+      px[1] = static_cast<char>(y * 255 / height);
+      px[2] = static_cast<char>((x + 1) * 255 / width);
+      px[3] = static_cast<char>(255 - y * 255 / height);
+    }
+  }
+  return data;
+}
+
+std::unique_ptr<cs::Image> MakeImage(cs::SourceImpl& source,
+                                     const Input& input) {
+  auto image = source.AllocImage(input.pixelFormat, input.width, input.height,
+                                 input.data.size());
+  std::memcpy(image->data(), input.data.data(), input.data.size());
+  return image;
+}
+
+// Converts input into the given format once, for use as another input
+Input ConvertInput(cs::SourceImpl& source, const Input& input,
+                   const std::function<cs::Image*(cs::Frame&, cs::Image*)>&
+                       convert) {
+  cs::Frame frame{source, MakeImage(source, input), wpi::Now()};
+  cs::Image* out = convert(frame, frame.GetExistingImage(0));
+  return {out->pixelFormat, out->width, out->height, std::string{out->str()}};
+}
+
+// Times a conversion of a fresh frame (frames cache their conversions) for
+// at least half a second
+void BenchConvert(const char* name, cs::SourceImpl& source,
+                  const Input& input,
+                  const std::function<cs::Image*(cs::Frame&, cs::Image*)>&
+                      convert) {
+  double total = 0;
+  double best = 1e9;
+  int count = 0;
+  auto start = Clock::now();
+  while (count < 5 || Elapsed(start) < 0.5) {
+    cs::Frame frame{source, MakeImage(source, input), wpi::Now()};
+    auto convertStart = Clock::now();
+    cs::Image* out = convert(frame, frame.GetExistingImage(0));
+    double t = Elapsed(convertStart);
+    if (!out) {
+      std::printf("convert: %-16s %4dx%-4d  failed\n", name, input.width,
+                  input.height);
+      return;
+    }
+    total += t;
+    best = (std::min)(best, t);
+    ++count;
+  }
+  double mean = total / count;
+  std::printf(
+      "convert: %-16s %4dx%-4d  mean %8.3f ms  min %8.3f ms  %8.1f Mpix/s\n",
+      name, input.width, input.height, mean * 1e3, best * 1e3,
+      input.width * input.height / mean / 1e6);
+}
+
+void BenchConversions(cs::SourceImpl& source, int width, int height) {
+  using PF = cs::VideoMode;
+  Input bgr{PF::kBGR, width, height, MakeBGR(width, height)};
+  Input yuyv{PF::kYUYV, width, height, MakeYUYV(width, height)};
+  Input gray = ConvertInput(source, bgr, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertBGRToGray(i);
+  });
+  Input rgb565 = ConvertInput(source, bgr, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertBGRToRGB565(i);
+  });
+  Input mjpeg = ConvertInput(source, bgr, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertBGRToMJPEG(i, 80);
+  });
+
+  BenchConvert("YUYV->BGR", source, yuyv, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertYUYVToBGR(i);
+  });
+  BenchConvert("YUYV->BGR/2", source, yuyv, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertYUYVToBGRHalf(i);
+  });
+  BenchConvert("YUYV->Gray", source, yuyv, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertYUYVToGray(i);
+  });
+  BenchConvert("BGR->Gray", source, bgr, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertBGRToGray(i);
+  });
+  BenchConvert("BGR->RGB565", source, bgr, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertBGRToRGB565(i);
+  });
+  BenchConvert("RGB565->BGR", source, rgb565, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertRGB565ToBGR(i);
+  });
+  BenchConvert("Gray->BGR", source, gray, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertGrayToBGR(i);
+  });
+  BenchConvert("Gray->RGB565", source, gray, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertGrayToRGB565(i);
+  });
+  BenchConvert("BGR->MJPEG", source, bgr, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertBGRToMJPEG(i, 80);
+  });
+  BenchConvert("Gray->MJPEG", source, gray, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertGrayToMJPEG(i, 80);
+  });
+  BenchConvert("MJPEG->BGR", source, mjpeg, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertMJPEGToBGR(i);
+  });
+  BenchConvert("MJPEG->BGR/2", source, mjpeg, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertMJPEGToBGR(i, 2);
+  });
+  BenchConvert("MJPEG->Gray", source, mjpeg, [](cs::Frame& f, cs::Image* i) {
+    return f.ConvertMJPEGToGray(i);
+  });
+  BenchConvert("BGR resize/2", source, bgr, [](cs::Frame& f, cs::Image* i) {
+    return f.GetImage(i->width / 2, i->height / 2, cs::VideoMode::kBGR);
+  });
+}
+
+// Lookups among a frame's cached images, as each sink does per frame
+void BenchNearestImage(cs::SourceImpl& source) {
+  Input bgr{cs::VideoMode::kBGR, 1280, 720, MakeBGR(1280, 720)};
+  cs::Frame frame{source, MakeImage(source, bgr), wpi::Now()};
+  frame.GetImage(640, 480, cs::VideoMode::kBGR);
+  frame.GetImage(320, 240, cs::VideoMode::kGray);
+  frame.GetImageMJPEG(640, 480, 80);
+  frame.GetImageMJPEG(1280, 720, 50);
+
+  constexpr int kLookups = 1000000;
+  constexpr int kSizes[][2] = {{1280, 720}, {640, 480}, {320, 240}, {160, 120}};
+  int found = 0;
+  auto start = Clock::now();
+  for (int i = 0; i < kLookups; ++i) {
+    auto& size = kSizes[i % 4];
+    found += frame.GetNearestImage(size[0], size[1]) != nullptr;
+  }
+  double any = Elapsed(start);
+
+  start = Clock::now();
+  for (int i = 0; i < kLookups; ++i) {
+    auto& size = kSizes[i % 4];
+    found += frame.GetNearestImage(size[0], size[1], cs::VideoMode::kMJPEG,
+                                   i % 2 == 0 ? 80 : -1) != nullptr;
+  }
+  double format = Elapsed(start);
+
+  std::printf(
+      "nearest: 5 images  any format %6.1f ns  MJPEG %6.1f ns  (%d found)\n",
+      any / kLookups * 1e9, format / kLookups * 1e9, found);
+}
+
+// Frame allocation and release through the source's image pool.  The heap
+// allocations per frame show whether the pool is being reused.
+void BenchPool(const char* name, cs::SourceImpl& source,
+               const std::vector<Input>& inputs, size_t held) {
+  constexpr int kFrames = 20000;
+  std::deque<cs::Frame> frames;
+  auto allocs = gAllocations.load();
+  auto start = Clock::now();
+  for (int i = 0; i < kFrames; ++i) {
+    auto& input = inputs[i % inputs.size()];
+    auto image = source.AllocImage(input.pixelFormat, input.width,
+                                   input.height, input.data.size());
+    frames.emplace_back(source, std::move(image), wpi::Now());
+    if (frames.size() > held) {
+      frames.pop_front();
+    }
+  }
+  double t = Elapsed(start);
+  frames.clear();
+  std::printf("pool: %-24s %8.1f ns/frame  %6.3f heap allocations/frame\n",
+              name, t / kFrames * 1e9,
+              static_cast<double>(gAllocations - allocs) / kFrames);
+}
+
+// Streams frames from a CvSource through an MjpegServer to loopback clients
+// for a few seconds
+void BenchMjpegServer(int numClients, int width, int height) {
+  int port = gNextPort++;
+  cs::CvSource source{"bench", cs::VideoMode::kBGR, width, height, 30};
+  cs::MjpegServer server{"bench", port};
+  server.SetSource(source);
+
+  std::atomic_bool done{false};
+  std::vector<std::thread> clients;
+  std::vector<uint64_t> received(numClients);
+  std::vector<int> framesReceived(numClients);
+  wpi::Logger logger;
+  for (int i = 0; i < numClients; ++i) {
+    clients.emplace_back([&, i] {
+      auto stream = wpi::TCPConnector::connect("127.0.0.1", port, logger, 1);
+      if (!stream) {
+        return;
+      }
+      std::string_view request = "GET /?action=stream HTTP/1.0\r\n\r\n";
+      wpi::NetworkStream::Error err;
+      stream->send(request.data(), request.size(), &err);
+      // count parts by their headers; keep the tail of each read in case a
+      // header spans two reads
+      constexpr std::string_view kPartHeader = "Content-Type: image/jpeg";
+      std::string buf;
+      std::vector<char> data(65536);
+      while (!done) {
+        size_t count = stream->receive(data.data(), data.size(), &err, 1);
+        if (count == 0) {
+          if (err == wpi::NetworkStream::kConnectionTimedOut) {
+            continue;
+          }
+          break;
+        }
+        received[i] += count;
+        buf.append(data.data(), count);
+        size_t pos = 0;
+        while ((pos = buf.find(kPartHeader, pos)) != std::string::npos) {
+          ++framesReceived[i];
+          pos += kPartHeader.size();
+        }
+        buf.erase(0, buf.size() - (std::min)(buf.size(), kPartHeader.size()));
+      }
+    });
+  }
+
+  // capture rate of a fast camera
+  constexpr double kDuration = 3.0;
+  cv::Mat image{height, width, CV_8UC3};
+  std::string bgr = MakeBGR(width, height);
+  std::memcpy(image.data, bgr.data(), bgr.size());
+  int sent = 0;
+  auto start = Clock::now();
+  while (Elapsed(start) < kDuration) {
+    source.PutFrame(image);
+    ++sent;
+    std::this_thread::sleep_for(std::chrono::milliseconds(8));
+  }
+  double t = Elapsed(start);
+  done = true;
+  for (auto&& client : clients) {
+    client.join();
+  }
+
+  uint64_t totalBytes = 0;
+  int minFrames = sent;
+  for (int i = 0; i < numClients; ++i) {
+    totalBytes += received[i];
+    minFrames = (std::min)(minFrames, framesReceived[i]);
+  }
+  std::printf(
+      "mjpeg: %2d clients %4dx%-4d  sent %6.1f fps  slowest client %6.1f fps"
+      "  total %7.1f MB/s\n",
+      numClients, width, height, sent / t, minFrames / t,
+      totalBytes / t / 1e6);
+}
+
+}  // namespace
+
+int main() {
+  // a logger that ignores everything replaces the default stderr logger
+  cs::SetLogger([](unsigned int, const char*, unsigned int, const char*) {},
+                UINT_MAX);
+
+  auto& inst = cs::Instance::GetInstance();
+  cs::CvSourceImpl source{"bench", inst.logger, inst.notifier, inst.telemetry,
+                          cs::VideoMode{cs::VideoMode::kBGR, 640, 480, 30}};
+
+  for (auto&& codecName : cs::GetJpegCodecNames()) {
+    std::printf("JPEG backend: %s\n", codecName.c_str());
+    source.SetJpegCodec(cs::GetJpegCodec(codecName));
+    for (auto&& resolution : kResolutions) {
+      BenchConversions(source, resolution[0], resolution[1]);
+    }
+  }
+  source.SetJpegCodec(cs::GetJpegCodec(""));
+
+  BenchNearestImage(source);
+
+  Input small{cs::VideoMode::kBGR, 640, 480, MakeBGR(640, 480)};
+  Input large{cs::VideoMode::kBGR, 1280, 720, MakeBGR(1280, 720)};
+  BenchPool("640x480", source, {small}, 1);
+  BenchPool("640x480, 4 held", source, {small}, 4);
+  BenchPool("640x480/1280x720 mixed", source, {small, large}, 2);
+
+  for (int numClients : {1, 4, 8}) {
+    BenchMjpegServer(numClients, 640, 480);
+  }
+  return 0;
+}
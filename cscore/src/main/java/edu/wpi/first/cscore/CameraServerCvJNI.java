@@ -71,4 +71,10 @@ public class CameraServerCvJNI {
   public static native long grabSinkFrame(int sink, long imageNativeObj);
 
   public static native long grabSinkFrameTimeout(int sink, long imageNativeObj, double timeout);
+
+  public static native void setCvSinkRegion(int sink, int x, int y, int width, int height);
+
+  public static native void setCvSinkScale(int sink, int scale);
+
+  public static native void setCvSinkPixelFormat(int sink, int pixelFormat);
 }
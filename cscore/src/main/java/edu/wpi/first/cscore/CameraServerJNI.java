@@ -5,6 +5,7 @@
 package edu.wpi.first.cscore;
 
 import edu.wpi.first.cscore.raw.RawFrame;
+import edu.wpi.first.cscore.raw.SharedRawFrame;
 import edu.wpi.first.util.RuntimeLoader;
 import java.io.IOException;
 import java.nio.ByteBuffer;
@@ -98,6 +99,8 @@ public class CameraServerJNI {
   public static native int createRawSource(
       String name, int pixelFormat, int width, int height, int fps);
 
+  public static native int createSharedMemorySource(String name, String shmName);
+
   //
   // Source Functions
   //
@@ -188,6 +191,31 @@ public class CameraServerJNI {
   public static native void putRawSourceFrame(
       int source, long data, int width, int height, int pixelFormat, int totalData);
 
+  private static native void allocRawSourceFrameImpl(
+      int source, SharedRawFrame frame, int width, int height, int pixelFormat, int totalData);
+
+  /**
+   * Get an image from the source's pool to fill in place. The frame's width, height, and pixel
+   * format select the image to allocate. Any image the frame already holds is released first.
+   *
+   * @param source Source handle
+   * @param frame Frame to set to the image
+   * @param totalData Image size in bytes, or 0 to compute it for uncompressed formats
+   */
+  public static void allocRawSourceFrame(int source, SharedRawFrame frame, int totalData) {
+    frame.release();
+    allocRawSourceFrameImpl(
+        source, frame, frame.getWidth(), frame.getHeight(), frame.getPixelFormat(), totalData);
+  }
+
+  /**
+   * Put an image allocated by allocRawSourceFrame() without copying it.
+   *
+   * @param source Source handle
+   * @param frameRef Native frame reference; it is consumed by this call
+   */
+  public static native void putRawSourceFrameShared(int source, long frameRef);
+
   public static void putRawSourceFrame(int source, RawFrame raw) {
     putRawSourceFrame(
         source,
@@ -222,6 +250,10 @@ public class CameraServerJNI {
   //
   public static native int createMjpegServer(String name, String listenAddress, int port);
 
+  public static native int createH264Server(String name, String listenAddress, int port);
+
+  public static native int createSharedMemorySink(String name, String shmName);
+
   public static native int createRawSink(String name);
 
   //
@@ -258,6 +290,13 @@ public class CameraServerJNI {
 
   public static native int getMjpegServerPort(int sink);
 
+  //
+  // H264Server Sink Functions
+  //
+  public static native String getH264ServerListenAddress(int sink);
+
+  public static native int getH264ServerPort(int sink);
+
   //
   // Image Sink Functions
   //
@@ -305,6 +344,26 @@ public class CameraServerJNI {
         timeout);
   }
 
+  private static native long grabRawSinkFrameSharedImpl(
+      int sink, SharedRawFrame frame, int width, int height, int pixelFormat, double timeout);
+
+  /**
+   * Wait for the next frame and get the image without copying it. The frame's width, height, and
+   * pixel format select the image to get. Any image the frame already holds is released first.
+   *
+   * @param sink Sink handle
+   * @param frame Frame to set to the image
+   * @param timeout Timeout in seconds
+   * @return Frame time, or 0 on error or timeout
+   */
+  public static long grabSinkFrameShared(int sink, SharedRawFrame frame, double timeout) {
+    frame.release();
+    return grabRawSinkFrameSharedImpl(
+        sink, frame, frame.getWidth(), frame.getHeight(), frame.getPixelFormat(), timeout);
+  }
+
+  public static native void releaseSharedRawFrame(long frameRef);
+
   public static native String getSinkError(int sink);
 
   public static native void setSinkEnabled(int sink, boolean enabled);
@@ -335,7 +394,21 @@ public class CameraServerJNI {
   //
   public enum TelemetryKind {
     kSourceBytesReceived(1),
-    kSourceFramesReceived(2);
+    kSourceFramesReceived(2),
+    kSourcePoolHits(3),
+    kSourcePoolMisses(4),
+    kSourceCaptureLatencyP50(5),
+    kSourceCaptureLatencyP99(6),
+    kSourceConvertLatencyP50(7),
+    kSourceConvertLatencyP99(8),
+    kSourceEncodeLatencyP50(9),
+    kSourceEncodeLatencyP99(10),
+    kSourceConversions(11),
+    kSinkSendLatencyP50(12),
+    kSinkSendLatencyP99(13),
+    kSinkFrameLatencyP50(14),
+    kSinkFrameLatencyP99(15),
+    kSinkFramesDropped(16);
 
     private final int value;
 
@@ -9,6 +9,11 @@ import org.opencv.core.Mat;
 /**
  * A sink for user code to accept video frames as OpenCV images. These sinks require the WPILib
  * OpenCV builds. For an alternate OpenCV, see the documentation how to build your own with RawSink.
+ *
+ * <p>The frame times returned are capture times where the source provides them (e.g. USB
+ * cameras on Linux use the driver's buffer timestamps), in the WPIUtilJNI.now() time base. On
+ * the roboRIO this is the FPGA time base, so a frame time divided by 1e6 can be passed directly
+ * to a pose estimator's addVisionMeasurement().
  */
 public class CvSink extends ImageSink {
   /**
@@ -69,4 +74,38 @@ public class CvSink extends ImageSink {
   public long grabFrameNoTimeout(Mat image) {
     return CameraServerCvJNI.grabSinkFrame(m_handle, image.nativeObj);
   }
+
+  /**
+   * Set the region of the frame to grab, in original frame coordinates. Only the region is
+   * converted when the source image is uncompressed.
+   *
+   * @param x Left edge of the region.
+   * @param y Top edge of the region.
+   * @param width Width of the region, or 0 for the whole frame.
+   * @param height Height of the region, or 0 for the whole frame.
+   */
+  public void setRegion(int x, int y, int width, int height) {
+    CameraServerCvJNI.setCvSinkRegion(m_handle, x, y, width, height);
+  }
+
+  /**
+   * Set the factor to shrink grabbed images by. JPEG sources are decoded at the reduced size where
+   * possible, which is much faster than a full decode.
+   *
+   * @param scale Scale divisor (1 for full size, 2 for half size, etc.)
+   */
+  public void setScale(int scale) {
+    CameraServerCvJNI.setCvSinkScale(m_handle, scale);
+  }
+
+  /**
+   * Set the pixel format of grabbed images: kBGR (the default) for three 8-bit channels in BGR
+   * order, or kGray for a single 8-bit channel, which comes directly from the Y channel of YUYV
+   * sources.
+   *
+   * @param pixelFormat Pixel format.
+   */
+  public void setPixelFormat(VideoMode.PixelFormat pixelFormat) {
+    CameraServerCvJNI.setCvSinkPixelFormat(m_handle, pixelFormat.getValue());
+  }
 }
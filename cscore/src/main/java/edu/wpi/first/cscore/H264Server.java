@@ -0,0 +1,94 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+package edu.wpi.first.cscore;
+
+/**
+ * A sink that acts as an H.264-over-HTTP network server. The stream is a raw H.264 (Annex B)
+ * elementary stream served at /stream.h264, which players such as ffplay, VLC, and GStreamer can
+ * open directly.
+ *
+ * <p>Encoding requires a hardware encoder (a V4L2 memory-to-memory device on Linux); if none is
+ * available, an error is logged and nothing is streamed.
+ */
+public class H264Server extends VideoSink {
+  /**
+   * Create an H.264-over-HTTP server sink.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   * @param listenAddress TCP listen address (empty string for all addresses)
+   * @param port TCP port number
+   */
+  public H264Server(String name, String listenAddress, int port) {
+    super(CameraServerJNI.createH264Server(name, listenAddress, port));
+  }
+
+  /**
+   * Create an H.264-over-HTTP server sink.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   * @param port TCP port number
+   */
+  public H264Server(String name, int port) {
+    this(name, "", port);
+  }
+
+  /**
+   * Get the listen address of the server.
+   *
+   * @return The listen address.
+   */
+  public String getListenAddress() {
+    return CameraServerJNI.getH264ServerListenAddress(m_handle);
+  }
+
+  /**
+   * Get the port number of the server.
+   *
+   * @return The port number.
+   */
+  public int getPort() {
+    return CameraServerJNI.getH264ServerPort(m_handle);
+  }
+
+  /**
+   * Set the encoded resolution.
+   *
+   * @param width width, 0 for the source resolution
+   * @param height height, 0 for the source resolution
+   */
+  public void setResolution(int width, int height) {
+    CameraServerJNI.setProperty(CameraServerJNI.getSinkProperty(m_handle, "width"), width);
+    CameraServerJNI.setProperty(CameraServerJNI.getSinkProperty(m_handle, "height"), height);
+  }
+
+  /**
+   * Set the maximum encoded frames per second (FPS).
+   *
+   * @param fps FPS, 0 for the source FPS
+   */
+  public void setFPS(int fps) {
+    CameraServerJNI.setProperty(CameraServerJNI.getSinkProperty(m_handle, "fps"), fps);
+  }
+
+  /**
+   * Set the target bitrate of the encoder. If not set, 2000 kbit/s is used.
+   *
+   * @param kbps bitrate in kilobits per second
+   */
+  public void setBitrate(int kbps) {
+    CameraServerJNI.setProperty(CameraServerJNI.getSinkProperty(m_handle, "bitrate"), kbps);
+  }
+
+  /**
+   * Set the interval between keyframes. Clients can only start (or resume after falling behind)
+   * at a keyframe, but keyframes are much larger than other frames. If not set, 30 is used.
+   *
+   * @param frames keyframe interval in frames
+   */
+  public void setKeyframeInterval(int frames) {
+    CameraServerJNI.setProperty(
+        CameraServerJNI.getSinkProperty(m_handle, "keyframe_interval"), frames);
+  }
+}
@@ -96,4 +96,15 @@ public class MjpegServer extends VideoSink {
     CameraServerJNI.setProperty(
         CameraServerJNI.getSinkProperty(m_handle, "default_compression"), quality);
   }
+
+  /**
+   * Set the bandwidth budget for each client that doesn't specify it. To stay within it (and
+   * within what the client's connection can actually take), the server lowers the JPEG quality and
+   * drops frames as needed.
+   *
+   * @param kbps bandwidth in kilobits per second, 0 for unlimited
+   */
+  public void setBandwidth(int kbps) {
+    CameraServerJNI.setProperty(CameraServerJNI.getSinkProperty(m_handle, "bandwidth"), kbps);
+  }
 }
@@ -0,0 +1,25 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+package edu.wpi.first.cscore;
+
+/**
+ * A sink that publishes the frames of its source to other processes on the same machine through
+ * shared memory, where SharedMemorySources read them. Frames are published as captured, so any
+ * decoding or conversion happens in the readers, and they are never slowed by a slow reader.
+ *
+ * <p>Shared memory is only supported on Linux; elsewhere an error is logged and nothing is
+ * published.
+ */
+public class SharedMemorySink extends VideoSink {
+  /**
+   * Create a shared memory sink. Any existing publisher of the same name is replaced.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   * @param shmName Name for readers to open (letters, digits, '_', '-', and '.')
+   */
+  public SharedMemorySink(String name, String shmName) {
+    super(CameraServerJNI.createSharedMemorySink(name, shmName));
+  }
+}
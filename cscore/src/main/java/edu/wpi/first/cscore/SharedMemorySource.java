@@ -0,0 +1,25 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+package edu.wpi.first.cscore;
+
+/**
+ * A source that receives the frames a SharedMemorySink in another process on the same machine
+ * publishes. Frames arrive in the publisher's format and video mode, without being encoded or sent
+ * over the network.
+ *
+ * <p>Shared memory is only supported on Linux.
+ */
+public class SharedMemorySource extends VideoSource {
+  /**
+   * Create a shared memory source. The source connects once the publisher has started, and
+   * reconnects if the publisher restarts.
+   *
+   * @param name Source name (arbitrary unique identifier)
+   * @param shmName Name the publisher was created with (letters, digits, '_', '-', and '.')
+   */
+  public SharedMemorySource(String name, String shmName) {
+    super(CameraServerJNI.createSharedMemorySource(name, shmName));
+  }
+}
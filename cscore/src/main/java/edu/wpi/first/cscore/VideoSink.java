@@ -13,7 +13,9 @@ public class VideoSink implements AutoCloseable {
     kUnknown(0),
     kMjpeg(2),
     kCv(4),
-    kRaw(8);
+    kRaw(8),
+    kH264(16),
+    kSharedMemory(32);
 
     private final int value;
 
@@ -38,6 +40,10 @@ public class VideoSink implements AutoCloseable {
         return Kind.kMjpeg;
       case 4:
         return Kind.kCv;
+      case 16:
+        return Kind.kH264;
+      case 32:
+        return Kind.kSharedMemory;
       default:
         return Kind.kUnknown;
     }
@@ -14,7 +14,8 @@ public class VideoSource implements AutoCloseable {
     kUsb(1),
     kHttp(2),
     kCv(4),
-    kRaw(8);
+    kRaw(8),
+    kSharedMemory(16);
 
     private final int value;
 
@@ -68,6 +69,8 @@ public class VideoSource implements AutoCloseable {
         return Kind.kHttp;
       case 4:
         return Kind.kCv;
+      case 16:
+        return Kind.kSharedMemory;
       default:
         return Kind.kUnknown;
     }
@@ -60,4 +60,20 @@ public class RawSink extends ImageSink {
   protected long grabFrameNoTimeout(RawFrame frame) {
     return CameraServerJNI.grabSinkFrame(m_handle, frame);
   }
+
+  /**
+   * Wait for the next frame and get the image without copying it. Times out (returning 0) after
+   * timeout seconds. The frame's width, height, and pixel format select the image to get.
+   *
+   * <p>The image memory is shared with every other sink on the same source, so it must not be
+   * written, and it is held until the frame is released or reused.
+   *
+   * @param frame The frame object to set to the image.
+   * @param timeout The frame timeout in seconds.
+   * @return Frame time, or 0 on error (call getError() to obtain the error message); the frame time
+   *     is in the same time base as wpi::Now(), and is in 1 us increments.
+   */
+  protected long grabFrameShared(SharedRawFrame frame, double timeout) {
+    return CameraServerJNI.grabSinkFrameShared(m_handle, frame, timeout);
+  }
 }
@@ -48,6 +48,27 @@ public class RawSource extends ImageSource {
     CameraServerJNI.putRawSourceFrame(m_handle, image);
   }
 
+  /**
+   * Get an image from the source's pool to fill in place, so it can be put without copying. The
+   * frame's width, height, and pixel format select the image to allocate.
+   *
+   * @param frame frame to set to the image
+   * @param totalData image size in bytes, or 0 to compute it for uncompressed formats
+   */
+  protected void allocFrame(SharedRawFrame frame, int totalData) {
+    CameraServerJNI.allocRawSourceFrame(m_handle, frame, totalData);
+  }
+
+  /**
+   * Put an image obtained from allocFrame() and notify sinks, without copying it. The frame no
+   * longer holds the image afterwards.
+   *
+   * @param frame frame holding the image
+   */
+  protected void putFrame(SharedRawFrame frame) {
+    CameraServerJNI.putRawSourceFrameShared(m_handle, frame.takeFrameRef());
+  }
+
   /**
    * Put a raw image and notify sinks.
    *
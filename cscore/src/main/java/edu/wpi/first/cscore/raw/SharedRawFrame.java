@@ -0,0 +1,168 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+package edu.wpi.first.cscore.raw;
+
+import edu.wpi.first.cscore.CameraServerJNI;
+import java.nio.ByteBuffer;
+
+/**
+ * A raw frame whose data is the native image memory itself, rather than a copy of it.
+ *
+ * <p>The memory comes from the source's image pool and is held until {@link #release()} (or
+ * {@link #close()}) is called, or the frame is reused, so release frames as soon as they are no
+ * longer needed; a held image can't be reused for new frames. The data buffer must not be used
+ * after the frame is released.
+ */
+public class SharedRawFrame implements AutoCloseable {
+  private long m_frameRef;
+  private ByteBuffer m_dataByteBuffer;
+  private long m_dataPtr;
+  private int m_totalData;
+  private int m_width;
+  private int m_height;
+  private int m_pixelFormat;
+
+  /** Release the image memory back to the source. */
+  @Override
+  public void close() {
+    release();
+  }
+
+  /** Release the image memory back to the source. The frame can be reused afterwards. */
+  public void release() {
+    if (m_frameRef != 0) {
+      CameraServerJNI.releaseSharedRawFrame(m_frameRef);
+    }
+    clearData();
+  }
+
+  /**
+   * Called from JNI to set data in class. Releases any image memory already held.
+   *
+   * @param dataByteBuffer A ByteBuffer pointing to the image memory.
+   * @param frameRef The native reference holding the image memory.
+   * @param dataPtr A long (a char* in native code) pointing to the image memory.
+   * @param totalData The total length of the data stored in the frame.
+   * @param width The width of the frame.
+   * @param height The height of the frame.
+   * @param pixelFormat The PixelFormat of the frame.
+   */
+  public void setData(
+      ByteBuffer dataByteBuffer,
+      long frameRef,
+      long dataPtr,
+      int totalData,
+      int width,
+      int height,
+      int pixelFormat) {
+    release();
+    m_dataByteBuffer = dataByteBuffer;
+    m_frameRef = frameRef;
+    m_dataPtr = dataPtr;
+    m_totalData = totalData;
+    m_width = width;
+    m_height = height;
+    m_pixelFormat = pixelFormat;
+  }
+
+  /**
+   * Take the native reference holding the image memory, leaving the frame empty.
+   *
+   * @return The native reference, or 0 if the frame holds no image.
+   */
+  long takeFrameRef() {
+    long frameRef = m_frameRef;
+    clearData();
+    return frameRef;
+  }
+
+  private void clearData() {
+    m_frameRef = 0;
+    m_dataByteBuffer = null;
+    m_dataPtr = 0;
+  }
+
+  /**
+   * Get a ByteBuffer pointing to the image memory. For frames from a sink, this memory is shared
+   * with other sinks and must not be written.
+   *
+   * @return A ByteBuffer pointing to the image memory, or null if the frame holds no image.
+   */
+  public ByteBuffer getDataByteBuffer() {
+    return m_dataByteBuffer;
+  }
+
+  /**
+   * Get a long (is a char* in native code) pointing to the image memory.
+   *
+   * @return A long pointing to the image memory, or 0 if the frame holds no image.
+   */
+  public long getDataPtr() {
+    return m_dataPtr;
+  }
+
+  /**
+   * Get the total length of the data stored in the frame.
+   *
+   * @return The total length of the data stored in the frame.
+   */
+  public int getTotalData() {
+    return m_totalData;
+  }
+
+  /**
+   * Get the width of the frame.
+   *
+   * @return The width of the frame.
+   */
+  public int getWidth() {
+    return m_width;
+  }
+
+  /**
+   * Set the width of the frame to get or allocate.
+   *
+   * @param width The width of the frame.
+   */
+  public void setWidth(int width) {
+    this.m_width = width;
+  }
+
+  /**
+   * Get the height of the frame.
+   *
+   * @return The height of the frame.
+   */
+  public int getHeight() {
+    return m_height;
+  }
+
+  /**
+   * Set the height of the frame to get or allocate.
+   *
+   * @param height The height of the frame.
+   */
+  public void setHeight(int height) {
+    this.m_height = height;
+  }
+
+  /**
+   * Get the PixelFormat of the frame.
+   *
+   * @return The PixelFormat of the frame.
+   */
+  public int getPixelFormat() {
+    return m_pixelFormat;
+  }
+
+  /**
+   * Set the PixelFormat of the frame to get or allocate.
+   *
+   * @param pixelFormat The PixelFormat of the frame.
+   */
+  public void setPixelFormat(int pixelFormat) {
+    this.m_pixelFormat = pixelFormat;
+  }
+}
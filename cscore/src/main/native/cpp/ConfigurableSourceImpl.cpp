@@ -10,6 +10,7 @@
 #include "Instance.h"
 #include "Log.h"
 #include "Notifier.h"
+#include "cscore_raw.h"
 
 using namespace cs;
 
@@ -104,3 +105,55 @@ void ConfigurableSourceImpl::SetEnumPropertyChoices(
                                   prop->name, property, CS_PROP_ENUM,
                                   prop->value, {});
 }
+
+void ConfigurableSourceImpl::PutFrame(std::unique_ptr<Image> image) {
+  SourceImpl::PutFrame(std::move(image), wpi::Now());
+}
+
+void ConfigurableSourceImpl::DiscardFrame(std::unique_ptr<Image> image) {
+  ReleaseImage(std::move(image));
+}
+
+namespace {
+// A pooled image of a raw or OpenCV source handed out to be filled in place;
+// it goes back to the pool if it is dropped without being put
+struct SourceFrameRef {
+  ~SourceFrameRef() {
+    if (image) {
+      static_cast<ConfigurableSourceImpl&>(*source).DiscardFrame(
+          std::move(image));
+    }
+  }
+
+  std::shared_ptr<SourceImpl> source;
+  std::unique_ptr<Image> image;
+};
+}  // namespace
+
+namespace cs {
+std::shared_ptr<void> MakeSourceFrameRef(std::shared_ptr<SourceImpl> source,
+                                         std::unique_ptr<Image> image) {
+  auto ref = std::make_shared<SourceFrameRef>();
+  ref->source = std::move(source);
+  ref->image = std::move(image);
+  return ref;
+}
+
+void PutSourceFrameShared(CS_Source source,
+                          const std::shared_ptr<void>& frameRef,
+                          CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data || (data->kind & (CS_SOURCE_RAW | CS_SOURCE_CV)) == 0) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  auto ref = static_cast<SourceFrameRef*>(frameRef.get());
+  // each allocated image can only be put once, to the source it came from
+  if (!ref || !ref->image || ref->source != data->source) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  static_cast<ConfigurableSourceImpl&>(*data->source)
+      .PutFrame(std::move(ref->image));
+}
+}  // namespace cs
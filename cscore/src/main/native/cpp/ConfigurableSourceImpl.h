@@ -45,10 +45,23 @@ class ConfigurableSourceImpl : public SourceImpl {
                               wpi::span<const std::string> choices,
                               CS_Status* status);
 
+  // Puts an image from AllocImage(), filled in place by the caller, without
+  // copying it
+  void PutFrame(std::unique_ptr<Image> image);
+
+  // Returns an image from AllocImage() that won't be put
+  void DiscardFrame(std::unique_ptr<Image> image);
+
  private:
   std::atomic_bool m_connected{true};
 };
 
+// Wraps an image allocated from source for the caller to fill in place in a
+// reference for PutSourceFrameShared(); dropping the reference instead
+// returns the image to the pool.
+std::shared_ptr<void> MakeSourceFrameRef(
+    std::shared_ptr<SourceImpl> source, std::unique_ptr<Image> image);
+
 }  // namespace cs
 
 #endif  // CSCORE_CONFIGURABLESOURCEIMPL_H_
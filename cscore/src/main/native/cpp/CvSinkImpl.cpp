@@ -4,10 +4,13 @@
 
 #include "CvSinkImpl.h"
 
+#include <algorithm>
+
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 #include <wpi/SmallString.h>
+#include <wpi/trace.h>
 
 #include "Handle.h"
 #include "Instance.h"
@@ -48,6 +51,34 @@ void CvSinkImpl::Stop() {
   }
 }
 
+void CvSinkImpl::SetRegion(const cv::Rect& region) {
+  std::scoped_lock lock(m_mutex);
+  m_region = region;
+}
+
+void CvSinkImpl::SetScale(int scale) {
+  std::scoped_lock lock(m_mutex);
+  m_scale = scale;
+}
+
+void CvSinkImpl::SetPixelFormat(VideoMode::PixelFormat pixelFormat) {
+  std::scoped_lock lock(m_mutex);
+  m_pixelFormat = pixelFormat;
+}
+
+bool CvSinkImpl::GetImage(Frame& frame, cv::Mat& image) {
+  cv::Rect region;
+  int scale;
+  VideoMode::PixelFormat pixelFormat;
+  {
+    std::scoped_lock lock(m_mutex);
+    region = m_region;
+    scale = m_scale;
+    pixelFormat = m_pixelFormat;
+  }
+  return frame.GetCv(image, region, scale, pixelFormat);
+}
+
 uint64_t CvSinkImpl::GrabFrame(cv::Mat& image) {
   SetEnabled(true);
 
@@ -65,12 +96,14 @@ uint64_t CvSinkImpl::GrabFrame(cv::Mat& image) {
     return 0;  // signal error
   }
 
-  if (!frame.GetCv(image)) {
+  WPI_TRACE_SCOPE("cscore.sink.cv.convert");
+  if (!GetImage(frame, image)) {
     // Shouldn't happen, but just in case...
     std::this_thread::sleep_for(std::chrono::milliseconds(20));
     return 0;
   }
 
+  RecordFrameLatency(frame.GetTime());
   return frame.GetTime();
 }
 
@@ -91,12 +124,77 @@ uint64_t CvSinkImpl::GrabFrame(cv::Mat& image, double timeout) {
     return 0;  // signal error
   }
 
-  if (!frame.GetCv(image)) {
+  WPI_TRACE_SCOPE("cscore.sink.cv.convert");
+  if (!GetImage(frame, image)) {
     // Shouldn't happen, but just in case...
     std::this_thread::sleep_for(std::chrono::milliseconds(20));
     return 0;
   }
 
+  RecordFrameLatency(frame.GetTime());
+  return frame.GetTime();
+}
+
+uint64_t CvSinkImpl::GrabFrameShared(cv::Mat& image,
+                                     std::shared_ptr<void>& frameRef,
+                                     double timeout) {
+  SetEnabled(true);
+
+  auto source = GetSource();
+  if (!source) {
+    // Source disconnected; sleep for one second
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    return 0;
+  }
+
+  auto frame = source->GetNextFrame(timeout);  // blocks
+  if (!frame) {
+    // Bad frame; sleep for 20 ms so we don't consume all processor time.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return 0;  // signal error
+  }
+
+  // The frame caches the conversion, so every sink on this source gets the
+  // same image (a BGR source's own image needs no conversion at all).  A
+  // region is a view of the scaled whole frame.
+  cv::Rect region;
+  int scale;
+  VideoMode::PixelFormat pixelFormat;
+  {
+    std::scoped_lock lock(m_mutex);
+    region = m_region;
+    scale = m_scale;
+    pixelFormat = m_pixelFormat;
+  }
+  Image* converted =
+      frame.GetImage(frame.GetOriginalWidth() / scale,
+                     frame.GetOriginalHeight() / scale, pixelFormat);
+  cv::Rect full;
+  if (converted) {
+    full = cv::Rect{0, 0, converted->width, converted->height};
+  }
+  cv::Rect scaledRegion =
+      region.area() > 0
+          ? cv::Rect{region.x / scale, region.y / scale,
+                     (std::max)(region.width / scale, 1),
+                     (std::max)(region.height / scale, 1)} &
+                full
+          : full;
+  if (!converted || scaledRegion.empty()) {
+    // Shouldn't happen, but just in case...
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return 0;
+  }
+
+  // The image memory belongs to the frame, which returns it to the source's
+  // pool; keep both alive for as long as the caller holds the reference
+  struct FrameRef {
+    std::shared_ptr<SourceImpl> source;
+    Frame frame;
+  };
+  image = converted->AsMat()(scaledRegion);
+  frameRef = std::make_shared<FrameRef>(FrameRef{std::move(source), frame});
+  RecordFrameLatency(frame.GetTime());
   return frame.GetTime();
 }
 
@@ -174,6 +272,56 @@ uint64_t GrabSinkFrameTimeout(CS_Sink sink, cv::Mat& image, double timeout,
   return static_cast<CvSinkImpl&>(*data->sink).GrabFrame(image, timeout);
 }
 
+uint64_t GrabSinkFrameShared(CS_Sink sink, cv::Mat& image,
+                             std::shared_ptr<void>& frameRef, double timeout,
+                             CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_CV) {
+    *status = CS_INVALID_HANDLE;
+    return 0;
+  }
+  return static_cast<CvSinkImpl&>(*data->sink)
+      .GrabFrameShared(image, frameRef, timeout);
+}
+
+void SetCvSinkRegion(CS_Sink sink, int x, int y, int width, int height,
+                     CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_CV) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  static_cast<CvSinkImpl&>(*data->sink)
+      .SetRegion(cv::Rect{x, y, width, height});
+}
+
+void SetCvSinkScale(CS_Sink sink, int scale, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_CV) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  if (scale < 1) {
+    *status = CS_UNSUPPORTED_MODE;
+    return;
+  }
+  static_cast<CvSinkImpl&>(*data->sink).SetScale(scale);
+}
+
+void SetCvSinkPixelFormat(CS_Sink sink, VideoMode::PixelFormat pixelFormat,
+                          CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_CV) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  if (pixelFormat != VideoMode::kBGR && pixelFormat != VideoMode::kGray) {
+    *status = CS_UNSUPPORTED_MODE;
+    return;
+  }
+  static_cast<CvSinkImpl&>(*data->sink).SetPixelFormat(pixelFormat);
+}
+
 std::string GetSinkError(CS_Sink sink, CS_Status* status) {
   auto data = Instance::GetInstance().GetSink(sink);
   if (!data || (data->kind & SinkMask) == 0) {
@@ -222,6 +370,21 @@ void CS_SetSinkDescription(CS_Sink sink, const char* description,
   return cs::SetSinkDescription(sink, description, status);
 }
 
+void CS_SetCvSinkRegion(CS_Sink sink, int x, int y, int width, int height,
+                        CS_Status* status) {
+  return cs::SetCvSinkRegion(sink, x, y, width, height, status);
+}
+
+void CS_SetCvSinkScale(CS_Sink sink, int scale, CS_Status* status) {
+  return cs::SetCvSinkScale(sink, scale, status);
+}
+
+void CS_SetCvSinkPixelFormat(CS_Sink sink, enum CS_PixelFormat pixelFormat,
+                             CS_Status* status) {
+  return cs::SetCvSinkPixelFormat(
+      sink, static_cast<cs::VideoMode::PixelFormat>(pixelFormat), status);
+}
+
 #if CV_VERSION_MAJOR < 4
 uint64_t CS_GrabSinkFrame(CS_Sink sink, struct CvMat* image,
                           CS_Status* status) {
@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <string_view>
 #include <thread>
 
@@ -35,13 +36,25 @@ class CvSinkImpl : public SinkImpl {
 
   uint64_t GrabFrame(cv::Mat& image);
   uint64_t GrabFrame(cv::Mat& image, double timeout);
+  uint64_t GrabFrameShared(cv::Mat& image, std::shared_ptr<void>& frameRef,
+                           double timeout);
+
+  void SetRegion(const cv::Rect& region);
+  void SetScale(int scale);
+  void SetPixelFormat(VideoMode::PixelFormat pixelFormat);
 
  private:
   void ThreadMain();
+  bool GetImage(Frame& frame, cv::Mat& image);
 
   std::atomic_bool m_active;  // set to false to terminate threads
   std::thread m_thread;
   std::function<void(uint64_t time)> m_processFrame;
+
+  // Output configuration; protected by m_mutex
+  cv::Rect m_region;
+  int m_scale = 1;
+  VideoMode::PixelFormat m_pixelFormat = VideoMode::kBGR;
 };
 
 }  // namespace cs
@@ -58,6 +58,30 @@ void CvSourceImpl::PutFrame(cv::Mat& image) {
   SourceImpl::PutFrame(std::move(dest), wpi::Now());
 }
 
+std::unique_ptr<Image> CvSourceImpl::AllocFrame(
+    cv::Mat& image, int width, int height, VideoMode::PixelFormat pixelFormat) {
+  int pixelSize;
+  switch (pixelFormat) {
+    case VideoMode::kGray:
+      pixelSize = 1;
+      break;
+    case VideoMode::kYUYV:
+    case VideoMode::kRGB565:
+      pixelSize = 2;
+      break;
+    case VideoMode::kBGR:
+      pixelSize = 3;
+      break;
+    default:
+      return nullptr;
+  }
+  auto dest =
+      AllocImage(pixelFormat, width, height, width * height * pixelSize);
+  // the Mat header shares the pooled image's data
+  image = dest->AsMat();
+  return dest;
+}
+
 namespace cs {
 
 CS_Source CreateCvSource(std::string_view name, const VideoMode& mode,
@@ -77,6 +101,24 @@ void PutSourceFrame(CS_Source source, cv::Mat& image, CS_Status* status) {
   static_cast<CvSourceImpl&>(*data->source).PutFrame(image);
 }
 
+std::shared_ptr<void> AllocSourceFrame(CS_Source source, cv::Mat& image,
+                                       int width, int height,
+                                       VideoMode::PixelFormat pixelFormat,
+                                       CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data || data->kind != CS_SOURCE_CV) {
+    *status = CS_INVALID_HANDLE;
+    return nullptr;
+  }
+  auto dest = static_cast<CvSourceImpl&>(*data->source)
+                  .AllocFrame(image, width, height, pixelFormat);
+  if (!dest) {
+    *status = CS_UNSUPPORTED_MODE;
+    return nullptr;
+  }
+  return MakeSourceFrameRef(data->source, std::move(dest));
+}
+
 static constexpr unsigned SourceMask = CS_SINK_CV | CS_SINK_RAW;
 
 void NotifySourceError(CS_Source source, std::string_view msg,
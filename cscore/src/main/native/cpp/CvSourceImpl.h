@@ -28,6 +28,11 @@ class CvSourceImpl : public ConfigurableSourceImpl {
   // OpenCV-specific functions
   void PutFrame(cv::Mat& image);
 
+  // Gets a pooled image for the caller to render into in place; see
+  // cs::CvSource::AllocFrame().  Returns nullptr for compressed formats.
+  std::unique_ptr<Image> AllocFrame(cv::Mat& image, int width, int height,
+                                    VideoMode::PixelFormat pixelFormat);
+
  private:
   std::atomic_bool m_connected{true};
 };
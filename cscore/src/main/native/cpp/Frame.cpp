@@ -4,18 +4,51 @@
 
 #include "Frame.h"
 
+#include <algorithm>
 #include <cstdlib>
 
 #include <opencv2/core/core.hpp>
-#include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <wpi/ThreadPool.h>
+#include <wpi/timestamp.h>
 
 #include "Instance.h"
+#include "JpegCodec.h"
+#include "JpegUtil.h"
 #include "Log.h"
 #include "SourceImpl.h"
 
 using namespace cs;
 
+namespace {
+
+// Records the time from construction to destruction as a conversion in the
+// source's telemetry
+class ConversionTimer {
+ public:
+  ConversionTimer(SourceImpl& source, VideoMode::PixelFormat fromPixelFormat,
+                  VideoMode::PixelFormat toPixelFormat)
+      : m_source{source},
+        m_fromPixelFormat{fromPixelFormat},
+        m_toPixelFormat{toPixelFormat},
+        m_start{wpi::Now()} {}
+  ~ConversionTimer() {
+    m_source.RecordConversion(m_fromPixelFormat, m_toPixelFormat,
+                              wpi::Now() - m_start);
+  }
+
+  ConversionTimer(const ConversionTimer&) = delete;
+  ConversionTimer& operator=(const ConversionTimer&) = delete;
+
+ private:
+  SourceImpl& m_source;
+  VideoMode::PixelFormat m_fromPixelFormat;
+  VideoMode::PixelFormat m_toPixelFormat;
+  uint64_t m_start;
+};
+
+}  // namespace
+
 Frame::Frame(SourceImpl& source, std::string_view error, Time time)
     : m_impl{source.AllocFrameImpl().release()} {
   m_impl->refcount = 1;
@@ -227,25 +260,21 @@ Image* Frame::ConvertImpl(Image* image, VideoMode::PixelFormat pixelFormat,
           cur = ConvertYUYVToBGR(cur);
         }
       } else if (cur->pixelFormat == VideoMode::kGray) {
-        // Check to see if BGR version already exists...
+        // Use the BGR version if it already exists, otherwise convert
+        // directly
         if (Image* newImage =
                 GetExistingImage(cur->width, cur->height, VideoMode::kBGR)) {
           cur = newImage;
         } else {
-          cur = ConvertGrayToBGR(cur);
+          return ConvertGrayToRGB565(cur);
         }
       }
       return ConvertBGRToRGB565(cur);
     case VideoMode::kGray:
-      // If source is YUYV or RGB565, need to convert to BGR first
+      // If source is RGB565, need to convert to BGR first; YUYV converts
+      // directly (it's just the Y channel)
       if (cur->pixelFormat == VideoMode::kYUYV) {
-        // Check to see if BGR version already exists...
-        if (Image* newImage =
-                GetExistingImage(cur->width, cur->height, VideoMode::kBGR)) {
-          cur = newImage;
-        } else {
-          cur = ConvertYUYVToBGR(cur);
-        }
+        return ConvertYUYVToGray(cur);
       } else if (cur->pixelFormat == VideoMode::kRGB565) {
         // Check to see if BGR version already exists...
         if (Image* newImage =
@@ -283,19 +312,47 @@ Image* Frame::ConvertImpl(Image* image, VideoMode::PixelFormat pixelFormat,
   return cur;
 }
 
-Image* Frame::ConvertMJPEGToBGR(Image* image) {
+// Uses the source's JPEG backend, falling back to OpenCV if it fails (e.g. a
+// hardware decoder that doesn't support the stream's subsampling).
+static bool DecodeJpeg(SourceImpl& source, Image& src, Image& dst) {
+  JpegCodec* codec = source.GetJpegCodec();
+  if (codec->Decode(src, dst)) {
+    return true;
+  }
+  JpegCodec& fallback = GetOpenCvJpegCodec();
+  return codec != &fallback && fallback.Decode(src, dst);
+}
+
+static void EncodeJpeg(SourceImpl& source, Image& src, int quality,
+                       Image& dst) {
+  JpegCodec* codec = source.GetJpegCodec();
+  if (codec->Encode(src, quality, dst)) {
+    return;
+  }
+  JpegCodec& fallback = GetOpenCvJpegCodec();
+  if (codec != &fallback) {
+    fallback.Encode(src, quality, dst);
+  }
+}
+
+Image* Frame::ConvertMJPEGToBGR(Image* image, int scale) {
   if (!image || image->pixelFormat != VideoMode::kMJPEG) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kMJPEG, VideoMode::kBGR};
 
   // Allocate an BGR image
-  auto newImage =
-      m_impl->source.AllocImage(VideoMode::kBGR, image->width, image->height,
-                                image->width * image->height * 3);
-
-  // Decode
-  cv::Mat newMat = newImage->AsMat();
-  cv::imdecode(image->AsInputArray(), cv::IMREAD_COLOR, &newMat);
+  int width = (image->width + scale - 1) / scale;
+  int height = (image->height + scale - 1) / scale;
+  auto newImage = m_impl->source.AllocImage(VideoMode::kBGR, width, height,
+                                            width * height * 3);
+
+  // Decode.  A failed full size decode still returns the image, as before,
+  // but a failed scaled decode lets the caller fall back to a full one.
+  if (!DecodeJpeg(m_impl->source, *image, *newImage) && scale != 1) {
+    m_impl->source.ReleaseImage(std::move(newImage));
+    return nullptr;
+  }
 
   // Save the result
   Image* rv = newImage.release();
@@ -310,6 +367,7 @@ Image* Frame::ConvertMJPEGToGray(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kMJPEG) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kMJPEG, VideoMode::kGray};
 
   // Allocate an grayscale image
   auto newImage =
@@ -317,8 +375,7 @@ Image* Frame::ConvertMJPEGToGray(Image* image) {
                                 image->width * image->height);
 
   // Decode
-  cv::Mat newMat = newImage->AsMat();
-  cv::imdecode(image->AsInputArray(), cv::IMREAD_GRAYSCALE, &newMat);
+  DecodeJpeg(m_impl->source, *image, *newImage);
 
   // Save the result
   Image* rv = newImage.release();
@@ -333,6 +390,7 @@ Image* Frame::ConvertYUYVToBGR(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kYUYV) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kYUYV, VideoMode::kBGR};
 
   // Allocate a BGR image
   auto newImage =
@@ -351,10 +409,79 @@ Image* Frame::ConvertYUYVToBGR(Image* image) {
   return rv;
 }
 
+Image* Frame::ConvertYUYVToGray(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kYUYV) {
+    return nullptr;
+  }
+  ConversionTimer timer{m_impl->source, VideoMode::kYUYV, VideoMode::kGray};
+
+  // Allocate a grayscale image
+  auto newImage =
+      m_impl->source.AllocImage(VideoMode::kGray, image->width, image->height,
+                                image->width * image->height);
+
+  // Convert
+  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_YUV2GRAY_YUYV);
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
+static inline uchar Clamp(int v) {
+  return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+Image* Frame::ConvertYUYVToBGRHalf(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kYUYV) {
+    return nullptr;
+  }
+  ConversionTimer timer{m_impl->source, VideoMode::kYUYV, VideoMode::kBGR};
+
+  // Allocate a half size BGR image
+  int width = image->width / 2;
+  int height = image->height / 2;
+  auto newImage = m_impl->source.AllocImage(VideoMode::kBGR, width, height,
+                                            width * height * 3);
+
+  // Convert.  Each output pixel is one YUYV macropixel (two pixels sharing
+  // U and V) averaged with the one below it, so this is a 2x2 box filter
+  // and color conversion in a single pass.  The integer BT.601 (limited
+  // range) coefficients match cv::COLOR_YUV2BGR_YUYV.
+  size_t stride = image->width * 2;
+  auto src = reinterpret_cast<const uchar*>(image->data());
+  auto dst = reinterpret_cast<uchar*>(newImage->data());
+  for (int j = 0; j < height; ++j) {
+    const uchar* row0 = src + 2 * j * stride;
+    const uchar* row1 = row0 + stride;
+    for (int i = 0; i < width; ++i, row0 += 4, row1 += 4, dst += 3) {
+      int c = ((row0[0] + row0[2] + row1[0] + row1[2] + 2) >> 2) - 16;
+      int d = ((row0[1] + row1[1] + 1) >> 1) - 128;
+      int e = ((row0[3] + row1[3] + 1) >> 1) - 128;
+      dst[0] = Clamp((298 * c + 516 * d + 128) >> 8);
+      dst[1] = Clamp((298 * c - 100 * d - 208 * e + 128) >> 8);
+      dst[2] = Clamp((298 * c + 409 * e + 128) >> 8);
+    }
+  }
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
 Image* Frame::ConvertBGRToRGB565(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kBGR) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kBGR, VideoMode::kRGB565};
 
   // Allocate a RGB565 image
   auto newImage =
@@ -377,6 +504,7 @@ Image* Frame::ConvertRGB565ToBGR(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kRGB565) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kRGB565, VideoMode::kBGR};
 
   // Allocate a BGR image
   auto newImage =
@@ -399,6 +527,7 @@ Image* Frame::ConvertBGRToGray(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kBGR) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kBGR, VideoMode::kGray};
 
   // Allocate a Grayscale image
   auto newImage =
@@ -417,10 +546,34 @@ Image* Frame::ConvertBGRToGray(Image* image) {
   return rv;
 }
 
+Image* Frame::ConvertGrayToRGB565(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kGray) {
+    return nullptr;
+  }
+  ConversionTimer timer{m_impl->source, VideoMode::kGray, VideoMode::kRGB565};
+
+  // Allocate a RGB565 image
+  auto newImage =
+      m_impl->source.AllocImage(VideoMode::kRGB565, image->width, image->height,
+                                image->width * image->height * 2);
+
+  // Convert
+  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_GRAY2BGR565);
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
 Image* Frame::ConvertGrayToBGR(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kGray) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kGray, VideoMode::kBGR};
 
   // Allocate a BGR image
   auto newImage =
@@ -443,10 +596,10 @@ Image* Frame::ConvertBGRToMJPEG(Image* image, int quality) {
   if (!image || image->pixelFormat != VideoMode::kBGR) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kBGR, VideoMode::kMJPEG};
   if (!m_impl) {
     return nullptr;
   }
-  std::scoped_lock lock(m_impl->mutex);
 
   // Allocate a JPEG image.  We don't actually know what the resulting size
   // will be; while the destination will automatically grow, doing so will
@@ -458,18 +611,15 @@ Image* Frame::ConvertBGRToMJPEG(Image* image, int quality) {
       m_impl->source.AllocImage(VideoMode::kMJPEG, image->width, image->height,
                                 image->width * image->height * 1.5);
 
-  // Compress
-  if (m_impl->compressionParams.empty()) {
-    m_impl->compressionParams.push_back(cv::IMWRITE_JPEG_QUALITY);
-    m_impl->compressionParams.push_back(quality);
-  } else {
-    m_impl->compressionParams[1] = quality;
-  }
-  cv::imencode(".jpg", image->AsMat(), newImage->vec(),
-               m_impl->compressionParams);
+  // Compress.  Recording the quality lets later requests for the same size
+  // and quality (e.g. other stream clients) reuse this image.
+  EncodeJpeg(m_impl->source, *image, quality, *newImage);
+  newImage->jpegQuality = quality;
 
-  // Save the result
+  // Save the result.  Only this is locked, so different sizes and qualities
+  // can be compressed in parallel (see GetImagesMJPEG()).
   Image* rv = newImage.release();
+  std::scoped_lock lock(m_impl->mutex);
   m_impl->images.push_back(rv);
   return rv;
 }
@@ -478,10 +628,10 @@ Image* Frame::ConvertGrayToMJPEG(Image* image, int quality) {
   if (!image || image->pixelFormat != VideoMode::kGray) {
     return nullptr;
   }
+  ConversionTimer timer{m_impl->source, VideoMode::kGray, VideoMode::kMJPEG};
   if (!m_impl) {
     return nullptr;
   }
-  std::scoped_lock lock(m_impl->mutex);
 
   // Allocate a JPEG image.  We don't actually know what the resulting size
   // will be; while the destination will automatically grow, doing so will
@@ -493,22 +643,87 @@ Image* Frame::ConvertGrayToMJPEG(Image* image, int quality) {
       m_impl->source.AllocImage(VideoMode::kMJPEG, image->width, image->height,
                                 image->width * image->height * 0.75);
 
-  // Compress
-  if (m_impl->compressionParams.empty()) {
-    m_impl->compressionParams.push_back(cv::IMWRITE_JPEG_QUALITY);
-    m_impl->compressionParams.push_back(quality);
-  } else {
-    m_impl->compressionParams[1] = quality;
-  }
-  cv::imencode(".jpg", image->AsMat(), newImage->vec(),
-               m_impl->compressionParams);
+  // Compress.  Recording the quality lets later requests for the same size
+  // and quality (e.g. other stream clients) reuse this image.
+  EncodeJpeg(m_impl->source, *image, quality, *newImage);
+  newImage->jpegQuality = quality;
 
-  // Save the result
+  // Save the result.  Only this is locked, so different sizes and qualities
+  // can be compressed in parallel (see GetImagesMJPEG()).
   Image* rv = newImage.release();
+  std::scoped_lock lock(m_impl->mutex);
   m_impl->images.push_back(rv);
   return rv;
 }
 
+void Frame::GetImagesMJPEG(wpi::span<MJPEGRequest> requests,
+                           wpi::ThreadPool& pool) {
+  if (!m_impl) {
+    return;
+  }
+
+  // The distinct compressions to do, and which one each request is waiting
+  // on (none if its image already exists)
+  struct Compression {
+    Image* image;
+    int quality;
+    Image* result = nullptr;
+  };
+  wpi::SmallVector<Compression, 4> compressions;
+  wpi::SmallVector<int, 8> compressionOf;
+  {
+    std::scoped_lock lock(m_impl->mutex);
+    if (m_impl->images.empty()) {
+      return;
+    }
+    // As in ConvertImpl(), only grayscale is compressed from as is
+    auto pixelFormat = m_impl->images[0]->pixelFormat == VideoMode::kGray
+                           ? VideoMode::kGray
+                           : VideoMode::kBGR;
+    for (auto&& request : requests) {
+      compressionOf.push_back(-1);
+      request.image = GetExistingImage(request.width, request.height,
+                                       VideoMode::kMJPEG,
+                                       request.requiredQuality);
+      if (request.image) {
+        continue;
+      }
+      Image* image =
+          GetImageImpl(request.width, request.height, pixelFormat, -1, 80);
+      if (!image) {
+        continue;
+      }
+      int quality = request.requiredQuality != -1 ? request.requiredQuality
+                                                  : request.defaultQuality;
+      auto it = std::find_if(
+          compressions.begin(), compressions.end(), [&](const auto& c) {
+            return c.image == image && c.quality == quality;
+          });
+      if (it == compressions.end()) {
+        compressions.push_back({image, quality});
+        it = std::prev(compressions.end());
+      }
+      compressionOf.back() = it - compressions.begin();
+    }
+  }
+
+  pool.ParallelFor(
+      0, compressions.size(),
+      [&](size_t i) {
+        auto& c = compressions[i];
+        c.result = c.image->pixelFormat == VideoMode::kGray
+                       ? ConvertGrayToMJPEG(c.image, c.quality)
+                       : ConvertBGRToMJPEG(c.image, c.quality);
+      },
+      1);
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (compressionOf[i] != -1) {
+      requests[i].image = compressions[compressionOf[i]].result;
+    }
+  }
+}
+
 Image* Frame::GetImageImpl(int width, int height,
                            VideoMode::PixelFormat pixelFormat,
                            int requiredJpegQuality, int defaultJpegQuality) {
@@ -528,13 +743,34 @@ Image* Frame::GetImageImpl(int width, int height,
   // If the source image is a JPEG, we need to decode it before we can do
   // anything else with it.  Note that if the destination format is JPEG, we
   // still need to do this (unless the width/height/compression were the same,
-  // in which case we already returned the existing JPEG above).
+  // in which case we already returned the existing JPEG above).  When
+  // shrinking, downscale in the DCT domain as far as possible, which is much
+  // cheaper than a full decode followed by a resize.
   if (cur->pixelFormat == VideoMode::kMJPEG) {
-    cur = ConvertMJPEGToBGR(cur);
+    Image* decoded = nullptr;
+    int scale = ChooseJpegScale(cur->width, cur->height, width, height);
+    if (scale > 1) {
+      decoded = ConvertMJPEGToBGR(cur, scale);
+    }
+    cur = decoded ? decoded : ConvertMJPEGToBGR(cur);
+  } else if (cur->pixelFormat == VideoMode::kYUYV &&
+             pixelFormat != VideoMode::kGray &&
+             pixelFormat != VideoMode::kYUYV && width <= cur->width / 2 &&
+             height <= cur->height / 2) {
+    // Likewise, halve YUYV while converting it to BGR (grayscale output is
+    // cheaper to get from the Y channel at full size)
+    cur = ConvertYUYVToBGRHalf(cur);
+  } else if (cur->pixelFormat == VideoMode::kYUYV &&
+             pixelFormat == VideoMode::kGray && !cur->Is(width, height)) {
+    // Extract the Y channel before resizing, so there's half as much to
+    // resize
+    cur = ConvertYUYVToGray(cur);
   }
 
   // Resize
   if (!cur->Is(width, height)) {
+    ConversionTimer timer{m_impl->source, cur->pixelFormat, cur->pixelFormat};
+
     // Allocate an image.
     auto newImage = m_impl->source.AllocImage(
         cur->pixelFormat, width, height,
@@ -553,8 +789,22 @@ Image* Frame::GetImageImpl(int width, int height,
   return ConvertImpl(cur, pixelFormat, requiredJpegQuality, defaultJpegQuality);
 }
 
-bool Frame::GetCv(cv::Mat& image, int width, int height) {
-  Image* rawImage = GetImage(width, height, VideoMode::kBGR);
+bool Frame::JpegNeedsDHT(Image* image, size_t* size, size_t* locSOF) {
+  std::scoped_lock lock(m_impl->mutex);
+  if (image->jpegNeedsDHT == -1) {
+    size_t newSize = image->size();
+    size_t newLocSOF = newSize;
+    image->jpegNeedsDHT = cs::JpegNeedsDHT(image->data(), &newSize, &newLocSOF);
+    image->jpegLocSOF = newLocSOF;
+  }
+  *size = image->size() + (image->jpegNeedsDHT ? JpegGetDHT().size() : 0);
+  *locSOF = image->jpegLocSOF;
+  return image->jpegNeedsDHT == 1;
+}
+
+bool Frame::GetCv(cv::Mat& image, int width, int height,
+                  VideoMode::PixelFormat pixelFormat) {
+  Image* rawImage = GetImage(width, height, pixelFormat);
   if (!rawImage) {
     return false;
   }
@@ -562,6 +812,94 @@ bool Frame::GetCv(cv::Mat& image, int width, int height) {
   return true;
 }
 
+// Color conversion code for converting a region of an image to BGR or
+// grayscale, or -1 if this isn't supported (or no conversion is needed)
+static int GetRegionConversion(VideoMode::PixelFormat from,
+                               VideoMode::PixelFormat to) {
+  switch (from) {
+    case VideoMode::kYUYV:
+      return to == VideoMode::kGray ? cv::COLOR_YUV2GRAY_YUYV
+                                    : cv::COLOR_YUV2BGR_YUYV;
+    case VideoMode::kBGR:
+      return to == VideoMode::kGray ? cv::COLOR_BGR2GRAY : -1;
+    case VideoMode::kGray:
+      return to == VideoMode::kBGR ? cv::COLOR_GRAY2BGR : -1;
+    default:
+      return -1;
+  }
+}
+
+bool Frame::GetCv(cv::Mat& image, const cv::Rect& region, int scale,
+                  VideoMode::PixelFormat pixelFormat) {
+  if (!m_impl) {
+    return false;
+  }
+  int width = GetOriginalWidth();
+  int height = GetOriginalHeight();
+  cv::Rect full{0, 0, width, height};
+  cv::Rect roi = region.area() > 0 ? (region & full) : full;
+  if (roi.empty()) {
+    return false;
+  }
+
+  // The whole frame goes through GetImage(), so the scaled image is cached
+  // for other sinks
+  if (roi.width == width && roi.height == height) {
+    return GetCv(image, width / scale, height / scale, pixelFormat);
+  }
+
+  // Convert (and scale) just the region of an uncompressed image
+  Image* src = GetExistingImage(width, height, pixelFormat);
+  if (!src) {
+    src = GetExistingImage(width, height);
+  }
+  int code = src ? GetRegionConversion(src->pixelFormat, pixelFormat) : -1;
+  if (src && (code != -1 || src->pixelFormat == pixelFormat)) {
+    if (src->pixelFormat == VideoMode::kYUYV) {
+      // U and V are shared by pairs of pixels, so align to them
+      int right = (std::min)((roi.x + roi.width + 1) & ~1, width & ~1);
+      roi.x &= ~1;
+      roi.width = right - roi.x;
+      if (roi.width <= 0) {
+        return false;
+      }
+    }
+    cv::Size size{(std::max)(roi.width / scale, 1),
+                  (std::max)(roi.height / scale, 1)};
+    ConversionTimer timer{m_impl->source, src->pixelFormat, pixelFormat};
+    cv::Mat srcRegion = src->AsMat()(roi);
+    if (code == -1) {
+      if (size == roi.size()) {
+        srcRegion.copyTo(image);
+      } else {
+        cv::resize(srcRegion, image, size, 0, 0, cv::INTER_AREA);
+      }
+    } else if (size == roi.size()) {
+      cv::cvtColor(srcRegion, image, code);
+    } else {
+      cv::Mat converted;
+      cv::cvtColor(srcRegion, converted, code);
+      cv::resize(converted, image, size, 0, 0, cv::INTER_AREA);
+    }
+    return true;
+  }
+
+  // Otherwise crop the (cached) scaled whole frame
+  Image* scaled = GetImage(width / scale, height / scale, pixelFormat);
+  if (!scaled) {
+    return false;
+  }
+  cv::Rect scaledRoi = cv::Rect{roi.x / scale, roi.y / scale,
+                                (std::max)(roi.width / scale, 1),
+                                (std::max)(roi.height / scale, 1)} &
+                       cv::Rect{0, 0, scaled->width, scaled->height};
+  if (scaledRoi.empty()) {
+    return false;
+  }
+  scaled->AsMat()(scaledRoi).copyTo(image);
+  return true;
+}
+
 void Frame::ReleaseFrame() {
   for (auto image : m_impl->images) {
     m_impl->source.ReleaseImage(std::unique_ptr<Image>(image));
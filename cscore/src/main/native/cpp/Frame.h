@@ -14,10 +14,15 @@
 
 #include <wpi/SmallVector.h>
 #include <wpi/mutex.h>
+#include <wpi/span.h>
 
 #include "Image.h"
 #include "cscore_cpp.h"
 
+namespace wpi {
+class ThreadPool;
+}  // namespace wpi
+
 namespace cs {
 
 class SourceImpl;
@@ -38,7 +43,6 @@ class Frame {
     SourceImpl& source;
     std::string error;
     wpi::SmallVector<Image*, 4> images;
-    std::vector<int> compressionParams;
   };
 
  public:
@@ -192,13 +196,16 @@ class Frame {
     return ConvertImpl(image, VideoMode::kMJPEG, requiredQuality,
                        defaultQuality);
   }
-  Image* ConvertMJPEGToBGR(Image* image);
+  Image* ConvertMJPEGToBGR(Image* image, int scale = 1);
   Image* ConvertMJPEGToGray(Image* image);
   Image* ConvertYUYVToBGR(Image* image);
+  Image* ConvertYUYVToGray(Image* image);
+  Image* ConvertYUYVToBGRHalf(Image* image);
   Image* ConvertBGRToRGB565(Image* image);
   Image* ConvertRGB565ToBGR(Image* image);
   Image* ConvertBGRToGray(Image* image);
   Image* ConvertGrayToBGR(Image* image);
+  Image* ConvertGrayToRGB565(Image* image);
   Image* ConvertBGRToMJPEG(Image* image, int quality);
   Image* ConvertGrayToMJPEG(Image* image, int quality);
 
@@ -214,10 +221,38 @@ class Frame {
                         defaultQuality);
   }
 
+  // A request for an MJPEG image; see GetImagesMJPEG()
+  struct MJPEGRequest {
+    int width;
+    int height;
+    int requiredQuality;
+    int defaultQuality;
+    Image* image = nullptr;  // the result
+  };
+
+  // Gets the MJPEG images for several requests at once, as GetImageMJPEG()
+  // would one at a time.  The uncompressed images are prepared in turn, then
+  // the distinct compressions that don't exist yet are each done once, in
+  // parallel on pool.
+  void GetImagesMJPEG(wpi::span<MJPEGRequest> requests, wpi::ThreadPool& pool);
+
+  // Returns whether an MJPEG image of this frame needs the default DHT
+  // inserted before its SOF, along with its size including the DHT.  The
+  // scan is done once per image and shared by all sinks sending it.
+  bool JpegNeedsDHT(Image* image, size_t* size, size_t* locSOF);
+
   bool GetCv(cv::Mat& image) {
     return GetCv(image, GetOriginalWidth(), GetOriginalHeight());
   }
-  bool GetCv(cv::Mat& image, int width, int height);
+  bool GetCv(cv::Mat& image, int width, int height,
+             VideoMode::PixelFormat pixelFormat = VideoMode::kBGR);
+
+  // Gets a region of the frame (in original frame coordinates; an empty
+  // region is the whole frame), shrunk by an integer scale factor, as BGR or
+  // grayscale.  Only the region of an uncompressed image is converted;
+  // JPEG images are decoded at the reduced scale where possible.
+  bool GetCv(cv::Mat& image, const cv::Rect& region, int scale,
+             VideoMode::PixelFormat pixelFormat);
 
  private:
   Image* ConvertImpl(Image* image, VideoMode::PixelFormat pixelFormat,
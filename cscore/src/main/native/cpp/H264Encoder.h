@@ -0,0 +1,52 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_H264ENCODER_H_
+#define CSCORE_H264ENCODER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+namespace wpi {
+class Logger;
+}  // namespace wpi
+
+namespace cs {
+
+class Image;
+
+// An H.264 encoder for a fixed image size.  Encoders are not thread safe;
+// each is only used by the thread that created it.
+class H264Encoder {
+ public:
+  struct Settings {
+    int width = 0;
+    int height = 0;
+    int fps = 30;
+    int bitrate = 2000;         // kbit/s
+    int keyframeInterval = 30;  // frames
+  };
+
+  virtual ~H264Encoder() = default;
+
+  virtual const char* GetName() const = 0;
+
+  // Encodes a BGR image of the configured size.  The output is Annex B, and
+  // every keyframe is preceded by the SPS and PPS so a client can start
+  // decoding at any keyframe.  An encoder that buffers frames may return an
+  // empty packet.  Returns false on errors.
+  virtual bool Encode(Image& image, bool forceKeyframe,
+                      std::vector<uint8_t>& out, bool* keyframe) = 0;
+
+  // Creates the best encoder available on this platform for the settings,
+  // or returns nullptr if there is none.  Implemented per platform.
+  static std::unique_ptr<H264Encoder> Create(const Settings& settings,
+                                             wpi::Logger& logger);
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_H264ENCODER_H_
@@ -0,0 +1,438 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "H264ServerImpl.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <fmt/format.h>
+#include <wpi/StringExtras.h>
+#include <wpi/uv/Tcp.h>
+
+#include "H264Encoder.h"
+#include "Handle.h"
+#include "Instance.h"
+#include "Log.h"
+#include "SourceImpl.h"
+#include "Telemetry.h"
+#include "c_util.h"
+#include "cscore_cpp.h"
+
+using namespace cs;
+
+static const char* kStreamHeader =
+    "HTTP/1.0 200 OK\r\n"
+    "Server: CameraServer/1.0\r\n"
+    "Cache-Control: no-store, no-cache, must-revalidate, pre-check=0, "
+    "post-check=0, max-age=0\r\n"
+    "Pragma: no-cache\r\n"
+    "Connection: close\r\n"
+    "Access-Control-Allow-Origin: *\r\n"
+    "Content-Type: video/h264\r\n"
+    "\r\n";
+
+static const char* kNotFound =
+    "HTTP/1.0 404 Not Found\r\n"
+    "Server: CameraServer/1.0\r\n"
+    "Connection: close\r\n"
+    "Content-Type: text/plain\r\n"
+    "\r\n"
+    "The stream is at /stream.h264\r\n";
+
+// Requests longer than this are rejected
+static constexpr size_t kMaxRequestSize = 4096;
+
+struct H264ServerImpl::Client {
+  std::shared_ptr<wpi::uv::Tcp> tcp;
+  std::string request;
+  bool requested = false;
+  bool streaming = false;
+  // A client that falls behind skips frames until the next keyframe, as
+  // the frames in between can't be decoded without the ones it missed
+  bool writing = false;
+  bool needKeyframe = true;
+};
+
+H264ServerImpl::H264ServerImpl(std::string_view name, wpi::Logger& logger,
+                               Notifier& notifier, Telemetry& telemetry,
+                               std::string_view listenAddress, int port)
+    : SinkImpl{name, logger, notifier, telemetry},
+      m_listenAddress(listenAddress),
+      m_port(port) {
+  m_active = true;
+
+  SetDescription(fmt::format("H.264 HTTP Server on port {}", port));
+
+  // Create properties
+  m_widthProp = CreateProperty("width", [] {
+    return std::make_unique<PropertyImpl>("width", CS_PROP_INTEGER, 1, 0, 0);
+  });
+  m_heightProp = CreateProperty("height", [] {
+    return std::make_unique<PropertyImpl>("height", CS_PROP_INTEGER, 1, 0, 0);
+  });
+  m_fpsProp = CreateProperty("fps", [] {
+    return std::make_unique<PropertyImpl>("fps", CS_PROP_INTEGER, 1, 0, 0);
+  });
+  m_bitrateProp = CreateProperty("bitrate", [] {
+    return std::make_unique<PropertyImpl>("bitrate", CS_PROP_INTEGER, 100,
+                                          100000, 1, 2000, 2000);
+  });
+  m_keyframeIntervalProp = CreateProperty("keyframe_interval", [] {
+    return std::make_unique<PropertyImpl>("keyframe_interval",
+                                          CS_PROP_INTEGER, 1, 600, 1, 30, 30);
+  });
+
+  Instance::GetInstance().eventLoop.ExecSync([&](wpi::uv::Loop& loop) {
+    auto server = wpi::uv::Tcp::Create(loop);
+    if (!server) {
+      return;
+    }
+    server->error.connect([this, srv = server.get()](wpi::uv::Error err) {
+      SERROR("could not listen on port {}: {}", m_port, err.str());
+      srv->Close();
+    });
+    server->connection.connect([this, srv = server.get()] { Accept(*srv); });
+    server->Bind(m_listenAddress, m_port);
+    server->Listen();
+    if (!server->IsClosing()) {
+      m_server = std::move(server);
+    }
+  });
+
+  m_encodeThread = std::thread(&H264ServerImpl::EncodeThreadMain, this);
+}
+
+H264ServerImpl::~H264ServerImpl() {
+  Stop();
+}
+
+void H264ServerImpl::Stop() {
+  m_active = false;
+
+  // wake up the encode thread
+  if (auto source = GetSource()) {
+    source->Wakeup();
+  }
+  m_encodeCv.notify_all();
+  if (m_encodeThread.joinable()) {
+    m_encodeThread.join();
+  }
+
+  // close the listener and all connections
+  Instance::GetInstance().eventLoop.ExecSync([this](wpi::uv::Loop&) {
+    if (m_server) {
+      m_server->error.disconnect_all();
+      m_server->connection.disconnect_all();
+      m_server->Close();
+      m_server.reset();
+    }
+    std::vector<std::shared_ptr<Client>> clients;
+    {
+      std::scoped_lock lock(m_mutex);
+      clients = m_clients;
+    }
+    for (auto&& client : clients) {
+      RemoveClient(client);
+    }
+  });
+}
+
+void H264ServerImpl::Accept(wpi::uv::Tcp& server) {
+  auto tcp = server.Accept();
+  if (!tcp) {
+    return;
+  }
+  if (!m_active) {
+    tcp->Close();
+    return;
+  }
+  tcp->SetNoDelay(true);
+
+  auto client = std::make_shared<Client>();
+  client->tcp = tcp;
+  tcp->error.connect([this, client](wpi::uv::Error err) {
+    SDEBUG("client error: {}", err.str());
+    RemoveClient(client);
+  });
+  tcp->end.connect([this, client] { RemoveClient(client); });
+  tcp->data.connect([this, client](wpi::uv::Buffer& buf, size_t len) {
+    // anything after the request is ignored; reading detects the client
+    // disconnecting
+    if (client->requested || client->request.size() > kMaxRequestSize) {
+      return;
+    }
+    client->request.append(buf.base, len);
+    if (client->request.find("\r\n\r\n") != std::string::npos) {
+      ProcessRequest(client);
+    } else if (client->request.size() > kMaxRequestSize) {
+      SDEBUG("{}", "request too long");
+      RemoveClient(client);
+    }
+  });
+  tcp->StartRead();
+
+  std::scoped_lock lock(m_mutex);
+  m_clients.emplace_back(std::move(client));
+}
+
+void H264ServerImpl::ProcessRequest(const std::shared_ptr<Client>& client) {
+  client->requested = true;
+
+  // Only the request line is used: "GET /stream.h264 HTTP/1.1"
+  std::string_view line = wpi::split(client->request, '\n').first;
+  auto [method, rest] = wpi::split(wpi::trim(line), ' ');
+  std::string_view path = wpi::split(rest, ' ').first;
+  path = wpi::split(path, '?').first;
+  SDEBUG("HTTP request: '{}'", line);
+
+  if ((method != "GET" && method != "HEAD") ||
+      (path != "/" && path != "/stream.h264")) {
+    client->tcp->Write({wpi::uv::Buffer{kNotFound}},
+                       [this, client](auto, wpi::uv::Error) {
+                         // closing if the server was stopped
+                         if (!client->tcp->IsClosing()) {
+                           RemoveClient(client);
+                         }
+                       });
+    return;
+  }
+  if (method == "HEAD") {
+    client->tcp->Write({wpi::uv::Buffer{kStreamHeader}},
+                       [this, client](auto, wpi::uv::Error) {
+                         // closing if the server was stopped
+                         if (!client->tcp->IsClosing()) {
+                           RemoveClient(client);
+                         }
+                       });
+    return;
+  }
+
+  // The stream starts at the next keyframe
+  client->streaming = true;
+  client->writing = true;
+  client->tcp->Write({wpi::uv::Buffer{kStreamHeader}},
+                     [client](auto, wpi::uv::Error) {
+                       client->writing = false;
+                     });
+  Enable();
+  m_forceKeyframe = true;
+  std::scoped_lock lock(m_mutex);
+  ++m_numStreaming;
+  m_encodeCv.notify_one();
+}
+
+void H264ServerImpl::RemoveClient(const std::shared_ptr<Client>& client) {
+  {
+    std::scoped_lock lock(m_mutex);
+    auto it = std::find(m_clients.begin(), m_clients.end(), client);
+    if (it == m_clients.end()) {
+      return;  // already removed
+    }
+    m_clients.erase(it);
+    if (client->streaming) {
+      --m_numStreaming;
+    }
+  }
+  if (client->streaming) {
+    Disable();
+  }
+  client->tcp->error.disconnect_all();
+  client->tcp->end.disconnect_all();
+  client->tcp->data.disconnect_all();
+  client->tcp->Close();
+}
+
+void H264ServerImpl::SendPacket(std::shared_ptr<std::vector<uint8_t>> packet,
+                                bool keyframe) {
+  std::vector<std::shared_ptr<Client>> clients;
+  {
+    std::scoped_lock lock(m_mutex);
+    clients = m_clients;
+  }
+  wpi::uv::Buffer buf{reinterpret_cast<const char*>(packet->data()),
+                      packet->size()};
+  int dropped = 0;
+  for (auto&& client : clients) {
+    if (!client->streaming || client->tcp->IsClosing()) {
+      continue;
+    }
+    if (client->writing) {
+      client->needKeyframe = true;
+      ++dropped;
+      continue;
+    }
+    if (client->needKeyframe) {
+      if (!keyframe) {
+        m_forceKeyframe = true;
+        ++dropped;
+        continue;
+      }
+      client->needKeyframe = false;
+    }
+    client->writing = true;
+    // the callback keeps the packet alive until it's been sent
+    client->tcp->Write({buf}, [client, packet](auto, wpi::uv::Error) {
+      client->writing = false;
+    });
+  }
+  if (dropped != 0) {
+    m_telemetry.RecordSinkFramesDropped(*this, dropped);
+  }
+}
+
+void H264ServerImpl::EncodeThreadMain() {
+  auto& eventLoop = Instance::GetInstance().eventLoop;
+  std::unique_ptr<H264Encoder> encoder;
+  H264Encoder::Settings current;
+  bool reportedFailure = false;
+  uint64_t lastFrameTime = 0;
+  std::vector<uint8_t> out;
+
+  while (m_active) {
+    H264Encoder::Settings settings;
+    int width;
+    int height;
+    {
+      std::unique_lock lock(m_mutex);
+      m_encodeCv.wait(lock, [&] { return !m_active || m_numStreaming > 0; });
+      if (!m_active) {
+        break;
+      }
+      width = GetProperty(m_widthProp)->value;
+      height = GetProperty(m_heightProp)->value;
+      settings.fps = GetProperty(m_fpsProp)->value;
+      settings.bitrate = GetProperty(m_bitrateProp)->value;
+      settings.keyframeInterval = GetProperty(m_keyframeIntervalProp)->value;
+    }
+
+    auto source = GetSource();
+    Frame frame;
+    if (source) {
+      SDEBUG4("{}", "waiting for frame");
+      frame = source->GetNextFrame(0.225);  // blocks
+    }
+    if (!m_active) {
+      break;
+    }
+    if (!frame) {
+      // Source disconnected or bad frame; sleep so we don't consume all
+      // processor time
+      std::this_thread::sleep_for(std::chrono::milliseconds(source ? 20 : 200));
+      continue;
+    }
+
+    // skip frames to maintain the requested frame rate
+    auto thisFrameTime = frame.GetTime();
+    if (settings.fps > 0 && thisFrameTime != 0 &&
+        thisFrameTime - lastFrameTime < 1000000u / settings.fps) {
+      continue;
+    }
+    lastFrameTime = thisFrameTime;
+
+    // 4:2:0 chroma subsampling needs even dimensions
+    settings.width = (width != 0 ? width : frame.GetOriginalWidth()) & ~1;
+    settings.height = (height != 0 ? height : frame.GetOriginalHeight()) & ~1;
+    if (settings.width == 0 || settings.height == 0) {
+      continue;
+    }
+
+    // (re)create the encoder when the settings change
+    if (!encoder || settings.width != current.width ||
+        settings.height != current.height || settings.fps != current.fps ||
+        settings.bitrate != current.bitrate ||
+        settings.keyframeInterval != current.keyframeInterval) {
+      encoder.reset();
+      current = settings;
+      encoder = H264Encoder::Create(settings, m_logger);
+      if (!encoder) {
+        if (!reportedFailure) {
+          SERROR("no H.264 encoder available for {}x{}", settings.width,
+                 settings.height);
+          reportedFailure = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        continue;
+      }
+      SDEBUG("encoding {}x{} with {}", settings.width, settings.height,
+             encoder->GetName());
+      reportedFailure = false;
+      // a new encoder starts with a keyframe, but be certain of it
+      m_forceKeyframe = true;
+    }
+
+    Image* image =
+        frame.GetImage(settings.width, settings.height, VideoMode::kBGR);
+    if (!image) {
+      continue;
+    }
+    bool keyframe;
+    if (!encoder->Encode(*image, m_forceKeyframe.exchange(false), out,
+                         &keyframe)) {
+      // try a new encoder on the next frame
+      encoder.reset();
+      continue;
+    }
+    if (out.empty()) {
+      continue;
+    }
+
+    auto packet = std::make_shared<std::vector<uint8_t>>(std::move(out));
+    out = std::vector<uint8_t>{};
+    eventLoop.ExecAsync([this, packet = std::move(packet),
+                         keyframe](wpi::uv::Loop&) mutable {
+      SendPacket(std::move(packet), keyframe);
+    });
+  }
+
+  SDEBUG("{}", "leaving encode thread");
+}
+
+namespace cs {
+
+CS_Sink CreateH264Server(std::string_view name, std::string_view listenAddress,
+                         int port, CS_Status* status) {
+  auto& inst = Instance::GetInstance();
+  return inst.CreateSink(
+      CS_SINK_H264,
+      std::make_shared<H264ServerImpl>(name, inst.logger, inst.notifier,
+                                       inst.telemetry, listenAddress, port));
+}
+
+std::string GetH264ServerListenAddress(CS_Sink sink, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_H264) {
+    *status = CS_INVALID_HANDLE;
+    return std::string{};
+  }
+  return static_cast<H264ServerImpl&>(*data->sink).GetListenAddress();
+}
+
+int GetH264ServerPort(CS_Sink sink, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_H264) {
+    *status = CS_INVALID_HANDLE;
+    return 0;
+  }
+  return static_cast<H264ServerImpl&>(*data->sink).GetPort();
+}
+
+}  // namespace cs
+
+extern "C" {
+
+CS_Sink CS_CreateH264Server(const char* name, const char* listenAddress,
+                            int port, CS_Status* status) {
+  return cs::CreateH264Server(name, listenAddress, port, status);
+}
+
+char* CS_GetH264ServerListenAddress(CS_Sink sink, CS_Status* status) {
+  return ConvertToC(cs::GetH264ServerListenAddress(sink, status));
+}
+
+int CS_GetH264ServerPort(CS_Sink sink, CS_Status* status) {
+  return cs::GetH264ServerPort(sink, status);
+}
+
+}  // extern "C"
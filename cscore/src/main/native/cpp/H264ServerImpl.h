@@ -0,0 +1,79 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_H264SERVERIMPL_H_
+#define CSCORE_H264SERVERIMPL_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <wpi/condition_variable.h>
+
+#include "SinkImpl.h"
+
+namespace wpi::uv {
+class Tcp;
+}  // namespace wpi::uv
+
+namespace cs {
+
+class SourceImpl;
+
+// Serves an H.264 elementary stream (Annex B) over HTTP.  Connections are
+// handled on the shared event loop; a single thread encodes each frame once
+// for all of the clients.
+class H264ServerImpl : public SinkImpl {
+ public:
+  H264ServerImpl(std::string_view name, wpi::Logger& logger,
+                 Notifier& notifier, Telemetry& telemetry,
+                 std::string_view listenAddress, int port);
+  ~H264ServerImpl() override;
+
+  void Stop();
+  std::string GetListenAddress() { return m_listenAddress; }
+  int GetPort() { return m_port; }
+
+ private:
+  struct Client;
+
+  // These are only called from the event loop
+  void Accept(wpi::uv::Tcp& server);
+  void ProcessRequest(const std::shared_ptr<Client>& client);
+  void RemoveClient(const std::shared_ptr<Client>& client);
+  void SendPacket(std::shared_ptr<std::vector<uint8_t>> packet,
+                  bool keyframe);
+
+  void EncodeThreadMain();
+
+  // Never changed, so not protected by mutex
+  std::string m_listenAddress;
+  int m_port;
+
+  std::atomic_bool m_active;  // set to false to terminate threads
+  std::atomic_bool m_forceKeyframe{false};
+
+  // Only accessed from the event loop
+  std::shared_ptr<wpi::uv::Tcp> m_server;
+
+  // Protected by m_mutex
+  std::vector<std::shared_ptr<Client>> m_clients;
+  int m_numStreaming = 0;
+  wpi::condition_variable m_encodeCv;
+  std::thread m_encodeThread;
+
+  // property indices
+  int m_widthProp;
+  int m_heightProp;
+  int m_fpsProp;
+  int m_bitrateProp;
+  int m_keyframeIntervalProp;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_H264SERVERIMPL_H_
@@ -8,6 +8,7 @@
 #include <wpi/StringExtras.h>
 #include <wpi/TCPConnector.h>
 #include <wpi/timestamp.h>
+#include <wpi/trace.h>
 
 #include "Handle.h"
 #include "Instance.h"
@@ -97,6 +98,7 @@ void HttpCameraImpl::MonitorThreadMain() {
 }
 
 void HttpCameraImpl::StreamThreadMain() {
+  WPI_TRACE_THREAD_NAME("cscore HTTP camera");
   while (m_active) {
     SetConnected(false);
 
@@ -133,7 +135,8 @@ void HttpCameraImpl::StreamThreadMain() {
     SetConnected(true);
 
     // stream
-    DeviceStream(conn->is, boundary.str());
+    MjpegStreamReader is{*conn->stream, 1};
+    DeviceStream(is, boundary.str());
     {
       std::unique_lock lock(m_mutex);
       m_streamConn = nullptr;
@@ -224,10 +227,11 @@ wpi::HttpConnection* HttpCameraImpl::DeviceStreamConnect(
   return conn;
 }
 
-void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
+void HttpCameraImpl::DeviceStream(MjpegStreamReader& is,
                                   std::string_view boundary) {
-  // Stored here so we reuse it from frame to frame
-  std::string imageBuf;
+  // Size of the last image without a Content-Length, used to allocate the
+  // next one
+  size_t jpegSizeHint = 0;
 
   // keep track of number of bad images received; if we receive 3 bad images
   // in a row, we reconnect
@@ -258,7 +262,7 @@ void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
       }
     }
 
-    if (!DeviceStreamFrame(is, imageBuf)) {
+    if (!DeviceStreamFrame(is, jpegSizeHint)) {
       ++numErrors;
     } else {
       numErrors = 0;
@@ -266,8 +270,8 @@ void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
   }
 }
 
-bool HttpCameraImpl::DeviceStreamFrame(wpi::raw_istream& is,
-                                       std::string& imageBuf) {
+bool HttpCameraImpl::DeviceStreamFrame(MjpegStreamReader& is,
+                                       size_t& jpegSizeHint) {
   // Read the headers
   wpi::SmallString<64> contentTypeBuf;
   wpi::SmallString<64> contentLengthBuf;
@@ -291,15 +295,22 @@ bool HttpCameraImpl::DeviceStreamFrame(wpi::raw_istream& is,
   if (auto v = wpi::parse_integer<unsigned int>(contentLengthBuf, 10)) {
     contentLength = v.value();
   } else {
-    // Ugh, no Content-Length?  Read the blocks of the JPEG file.
+    // Ugh, no Content-Length?  Read the blocks of the JPEG file, into an
+    // image sized like the last one so it rarely needs to grow.
+    auto image =
+        AllocImage(VideoMode::PixelFormat::kMJPEG, 0, 0, jpegSizeHint);
+    image->SetSize(0);
     int width, height;
-    if (!ReadJpeg(is, imageBuf, &width, &height)) {
+    if (!is.ReadJpeg(*image) ||
+        !GetJpegSize(image->str(), &width, &height)) {
       SWARNING("{}", "did not receive a JPEG image");
       PutError("did not receive a JPEG image", wpi::Now());
       return false;
     }
-    PutFrame(VideoMode::PixelFormat::kMJPEG, width, height, imageBuf,
-             wpi::Now());
+    jpegSizeHint = image->size();
+    image->width = width;
+    image->height = height;
+    PutFrame(std::move(image), wpi::Now());
     ++m_frameCount;
     return true;
   }
@@ -21,6 +21,7 @@
 #include <wpi/raw_istream.h>
 #include <wpi/span.h>
 
+#include "MjpegStreamReader.h"
 #include "SourceImpl.h"
 #include "cscore_cpp.h"
 
@@ -102,8 +103,8 @@ class HttpCameraImpl : public SourceImpl {
   // Functions used by StreamThreadMain()
   wpi::HttpConnection* DeviceStreamConnect(
       wpi::SmallVectorImpl<char>& boundary);
-  void DeviceStream(wpi::raw_istream& is, std::string_view boundary);
-  bool DeviceStreamFrame(wpi::raw_istream& is, std::string& imageBuf);
+  void DeviceStream(MjpegStreamReader& is, std::string_view boundary);
+  bool DeviceStreamFrame(MjpegStreamReader& is, size_t& jpegSizeHint);
 
   // The camera settings thread
   void SettingsThreadMain();
@@ -5,7 +5,9 @@
 #ifndef CSCORE_IMAGE_H_
 #define CSCORE_IMAGE_H_
 
+#include <functional>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <opencv2/core/core.hpp>
@@ -30,18 +32,38 @@ class Image {
   }
 #endif
 
+  // Wraps memory owned by someone else (e.g. a driver capture buffer)
+  // without copying it.  release is called when the image is destroyed;
+  // these images are never pooled, resized, or written through vec().
+  Image(void* data, size_t size, std::function<void()> release)
+      : m_external{static_cast<uchar*>(data)},
+        m_externalSize{size},
+        m_release{std::move(release)} {}
+
+  ~Image() {
+    if (m_release) {
+      m_release();
+    }
+  }
+
   Image(const Image&) = delete;
   Image& operator=(const Image&) = delete;
 
   // Getters
   operator std::string_view() const { return str(); }  // NOLINT
   std::string_view str() const { return {data(), size()}; }
-  size_t capacity() const { return m_data.capacity(); }
+  size_t capacity() const {
+    return m_external ? m_externalSize : m_data.capacity();
+  }
   const char* data() const {
-    return reinterpret_cast<const char*>(m_data.data());
+    return reinterpret_cast<const char*>(m_external ? m_external
+                                                    : m_data.data());
   }
-  char* data() { return reinterpret_cast<char*>(m_data.data()); }
-  size_t size() const { return m_data.size(); }
+  char* data() {
+    return reinterpret_cast<char*>(m_external ? m_external : m_data.data());
+  }
+  size_t size() const { return m_external ? m_externalSize : m_data.size(); }
+  bool IsExternal() const { return m_external != nullptr; }
 
   const std::vector<uchar>& vec() const { return m_data; }
   std::vector<uchar>& vec() { return m_data; }
@@ -65,10 +87,15 @@ class Image {
         type = CV_8UC1;
         break;
     }
-    return cv::Mat{height, width, type, m_data.data()};
+    return cv::Mat{height, width, type, data()};
   }
 
-  cv::_InputArray AsInputArray() { return cv::_InputArray{m_data}; }
+  cv::_InputArray AsInputArray() {
+    if (m_external) {
+      return cv::_InputArray{m_external, static_cast<int>(m_externalSize)};
+    }
+    return cv::_InputArray{m_data};
+  }
 
   bool Is(int width_, int height_) {
     return width == width_ && height == height_;
@@ -95,12 +122,20 @@ class Image {
 
  private:
   std::vector<uchar> m_data;
+  uchar* m_external{nullptr};
+  size_t m_externalSize{0};
+  std::function<void()> m_release;
 
  public:
   VideoMode::PixelFormat pixelFormat{VideoMode::kUnknown};
   int width{0};
   int height{0};
   int jpegQuality{-1};
+
+  // Cached JpegNeedsDHT() result for MJPEG images (-1 if not yet scanned),
+  // and the SOF location the DHT is inserted before
+  int jpegNeedsDHT{-1};
+  size_t jpegLocSOF{0};
 };
 
 }  // namespace cs
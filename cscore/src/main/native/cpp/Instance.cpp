@@ -56,6 +56,14 @@ void Instance::Shutdown() {
   notifier.Stop();
 }
 
+wpi::ThreadPool& Instance::GetConvertPool() {
+  std::scoped_lock lock(m_convertPoolMutex);
+  if (!m_convertPool) {
+    m_convertPool = std::make_unique<wpi::ThreadPool>();
+  }
+  return *m_convertPool;
+}
+
 void Instance::SetDefaultLogger() {
   logger.SetLogger(def_log_func);
 }
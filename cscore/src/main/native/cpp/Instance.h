@@ -10,6 +10,8 @@
 
 #include <wpi/EventLoopRunner.h>
 #include <wpi/Logger.h>
+#include <wpi/ThreadPool.h>
+#include <wpi/mutex.h>
 
 #include "Log.h"
 #include "NetworkListener.h"
@@ -64,6 +66,9 @@ class Instance {
  public:
   wpi::EventLoopRunner eventLoop;
 
+  // Workers for sinks to convert frames on in parallel; started on first use
+  wpi::ThreadPool& GetConvertPool();
+
   std::pair<CS_Sink, std::shared_ptr<SinkData>> FindSink(const SinkImpl& sink);
   std::pair<CS_Source, std::shared_ptr<SourceData>> FindSource(
       const SourceImpl& source);
@@ -108,6 +113,9 @@ class Instance {
 
  private:
   Instance();
+
+  wpi::mutex m_convertPoolMutex;
+  std::unique_ptr<wpi::ThreadPool> m_convertPool;
 };
 
 }  // namespace cs
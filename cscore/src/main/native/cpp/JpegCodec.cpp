@@ -0,0 +1,119 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "JpegCodec.h"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+#include "Image.h"
+
+using namespace cs;
+
+namespace {
+
+class OpenCvJpegCodec : public JpegCodec {
+ public:
+  std::string_view GetName() const override { return "opencv"; }
+  bool Decode(Image& src, Image& dst) override;
+  bool Encode(Image& src, int quality, Image& dst) override;
+};
+
+}  // namespace
+
+static constexpr int kScales[] = {1, 2, 4, 8};
+
+static constexpr int Scaled(int size, int scale) {
+  return (size + scale - 1) / scale;
+}
+
+int cs::GetJpegScale(int srcWidth, int srcHeight, int dstWidth,
+                     int dstHeight) {
+  for (int scale : kScales) {
+    if (Scaled(srcWidth, scale) == dstWidth &&
+        Scaled(srcHeight, scale) == dstHeight) {
+      return scale;
+    }
+  }
+  return 0;
+}
+
+int cs::ChooseJpegScale(int srcWidth, int srcHeight, int width, int height) {
+  int rv = 1;
+  for (int scale : kScales) {
+    if (Scaled(srcWidth, scale) >= width &&
+        Scaled(srcHeight, scale) >= height) {
+      rv = scale;
+    }
+  }
+  return rv;
+}
+
+bool OpenCvJpegCodec::Decode(Image& src, Image& dst) {
+  bool gray = dst.pixelFormat == VideoMode::kGray;
+  int flags;
+  switch (GetJpegScale(src.width, src.height, dst.width, dst.height)) {
+    case 1:
+      flags = gray ? cv::IMREAD_GRAYSCALE : cv::IMREAD_COLOR;
+      break;
+    case 2:
+      flags =
+          gray ? cv::IMREAD_REDUCED_GRAYSCALE_2 : cv::IMREAD_REDUCED_COLOR_2;
+      break;
+    case 4:
+      flags =
+          gray ? cv::IMREAD_REDUCED_GRAYSCALE_4 : cv::IMREAD_REDUCED_COLOR_4;
+      break;
+    case 8:
+      flags =
+          gray ? cv::IMREAD_REDUCED_GRAYSCALE_8 : cv::IMREAD_REDUCED_COLOR_8;
+      break;
+    default:
+      return false;
+  }
+  cv::Mat newMat = dst.AsMat();
+  cv::imdecode(src.AsInputArray(), flags, &newMat);
+  // imdecode reallocates the mat rather than fail on a size mismatch
+  return newMat.data == reinterpret_cast<uchar*>(dst.data());
+}
+
+bool OpenCvJpegCodec::Encode(Image& src, int quality, Image& dst) {
+  // reused so that encoding doesn't allocate
+  thread_local std::vector<int> params{cv::IMWRITE_JPEG_QUALITY, 0};
+  params[1] = quality;
+  return cv::imencode(".jpg", src.AsMat(), dst.vec(), params);
+}
+
+JpegCodec& cs::GetOpenCvJpegCodec() {
+  static OpenCvJpegCodec codec;
+  return codec;
+}
+
+// In order of preference
+static JpegCodec* const gCodecs[] = {
+#ifdef CSCORE_HAVE_TURBOJPEG
+    &GetTurboJpegCodec(),
+#endif
+    &GetOpenCvJpegCodec(),
+};
+
+JpegCodec* cs::GetJpegCodec(std::string_view name) {
+  if (name.empty()) {
+    return gCodecs[0];
+  }
+  for (auto codec : gCodecs) {
+    if (codec->GetName() == name) {
+      return codec;
+    }
+  }
+  return nullptr;
+}
+
+std::vector<std::string> cs::GetJpegCodecNames() {
+  std::vector<std::string> names;
+  for (auto codec : gCodecs) {
+    names.emplace_back(codec->GetName());
+  }
+  return names;
+}
@@ -0,0 +1,63 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_JPEGCODEC_H_
+#define CSCORE_JPEGCODEC_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cs {
+
+class Image;
+
+// A JPEG compression backend for Frame conversions.  Each source selects one
+// (see SourceImpl::SetJpegCodec()); OpenCV is always available and is used
+// whenever the selected backend fails.  Backends are singletons and must be
+// thread safe, as a source's frames are converted by whichever sink threads
+// need them.
+class JpegCodec {
+ public:
+  virtual ~JpegCodec() = default;
+
+  virtual std::string_view GetName() const = 0;
+
+  // Decodes the MJPEG image src into dst, which is a BGR or grayscale image
+  // of the same size, or of the size scaled by 1/2, 1/4, or 1/8 (a DCT-domain
+  // downscale, see GetJpegScale()).  Returns false if it couldn't be decoded.
+  virtual bool Decode(Image& src, Image& dst) = 0;
+
+  // Encodes the BGR or grayscale image src into the MJPEG image dst,
+  // replacing its data.  Returns false if it couldn't be encoded.
+  virtual bool Encode(Image& src, int quality, Image& dst) = 0;
+};
+
+// The OpenCV (cv::imdecode / cv::imencode) backend.
+JpegCodec& GetOpenCvJpegCodec();
+
+#ifdef CSCORE_HAVE_TURBOJPEG
+// The libjpeg-turbo (TurboJPEG API) backend.
+JpegCodec& GetTurboJpegCodec();
+#endif
+
+// Gets the DCT-domain downscale factor (1, 2, 4, or 8) that decodes a JPEG
+// of size src to size dst, or 0 if there isn't one.  Scaled sizes are
+// rounded up, as libjpeg does.
+int GetJpegScale(int srcWidth, int srcHeight, int dstWidth, int dstHeight);
+
+// Gets the largest DCT-domain downscale factor for which a JPEG of size src
+// decodes to an image at least width x height in size (1 if none).
+int ChooseJpegScale(int srcWidth, int srcHeight, int width, int height);
+
+// Gets a backend by name, or nullptr if it isn't available in this build.
+// An empty name gets the default backend, the fastest one available.
+JpegCodec* GetJpegCodec(std::string_view name);
+
+// Gets the names of the available backends.
+std::vector<std::string> GetJpegCodecNames();
+
+}  // namespace cs
+
+#endif  // CSCORE_JPEGCODEC_H_
@@ -4,6 +4,11 @@
 
 #include "MjpegServerImpl.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <chrono>
 
 #include <fmt/format.h>
@@ -14,6 +19,9 @@
 #include <wpi/fmt/raw_ostream.h>
 #include <wpi/raw_socket_istream.h>
 #include <wpi/raw_socket_ostream.h>
+#include <wpi/timestamp.h>
+#include <wpi/trace.h>
+#include <wpi/uv/Tcp.h>
 
 #include "Handle.h"
 #include "Instance.h"
@@ -21,6 +29,7 @@
 #include "Log.h"
 #include "Notifier.h"
 #include "SourceImpl.h"
+#include "Telemetry.h"
 #include "c_util.h"
 #include "cscore_cpp.h"
 
@@ -90,13 +99,15 @@ class MjpegServerImpl::ConnThread : public wpi::SafeThread {
 
   std::unique_ptr<wpi::NetworkStream> m_stream;
   std::shared_ptr<SourceImpl> m_source;
-  bool m_streaming = false;
+  MjpegServerImpl* m_server = nullptr;
+  bool m_handoff = false;  // set by SendStream to pass m_stream to m_server
   bool m_noStreaming = false;
   int m_width = 0;
   int m_height = 0;
   int m_compression = -1;
   int m_defaultCompression = 80;
   int m_fps = 0;
+  int m_bandwidth = 0;
 
  private:
   std::string m_name;
@@ -108,23 +119,141 @@ class MjpegServerImpl::ConnThread : public wpi::SafeThread {
     std::scoped_lock lock(m_mutex);
     return m_source;
   }
+};
 
-  void StartStream() {
-    std::scoped_lock lock(m_mutex);
-    if (m_source) {
-      m_source->EnableSink();
+struct MjpegServerImpl::StreamClient {
+  // Returns false if the frame should be dropped to keep the client at its
+  // requested frame rate.
+  bool CheckFrameRate(Frame::Time thisFrameTime);
+
+  // Returns false if the frame should be dropped to keep the client within
+  // its bandwidth budget; also adapts quality to the budget.
+  bool CheckBandwidth(Frame::Time thisFrameTime, uint64_t now);
+
+  // Owns the accepted socket; the loop's handle is a duplicate of it
+  std::unique_ptr<wpi::NetworkStream> stream;
+  std::shared_ptr<wpi::uv::Tcp> tcp;    // only used on the loop
+  std::shared_ptr<SourceImpl> source;  // enabled for us; protected by m_mutex
+  StreamSettings settings;
+
+  // Only used by the stream thread
+  Frame::Time lastFrameTime = 0;
+  Frame::Time timePerFrame = 0;
+  Frame::Time averageFrameTime = 0;
+  Frame::Time averagePeriod = 1000000;  // 1 second window
+
+  // Bandwidth adaptation state (only used by the stream thread while
+  // settings.bandwidth is set)
+  int quality = -1;            // JPEG quality, -1 for the unadapted settings
+  double budget = 0;           // bytes/s
+  double drainRate = 0;        // bytes/s the connection has been draining
+  double frameSize = 0;        // average bytes per frame sent
+  double frameInterval = 0;    // average us between source frames
+  Frame::Time lastSourceTime = 0;
+  uint64_t nextFrameTime = 0;  // frame allowed by the budget after this
+  uint64_t lastAdjustTime = 0;
+
+  // The last completed frame write; set on the loop before writing is cleared
+  size_t writeBytes = 0;
+  uint64_t writeStart = 0;
+  uint64_t writeTime = 0;
+  // From capture to the end of the write; cleared once recorded
+  uint64_t frameLatency = 0;
+
+  // Set while a write to the client is in progress.  Frames that arrive in
+  // the meantime are dropped for this client, so a slow client gets fewer
+  // frames rather than an ever-growing backlog.
+  std::atomic_bool writing{false};
+};
+
+bool MjpegServerImpl::StreamClient::CheckFrameRate(Frame::Time thisFrameTime) {
+  if (thisFrameTime != 0 && timePerFrame != 0 && lastFrameTime != 0) {
+    Frame::Time deltaTime = thisFrameTime - lastFrameTime;
+
+    // drop frame if it is early compared to the desired frame rate AND
+    // the current average is higher than the desired average
+    if (deltaTime < timePerFrame && averageFrameTime < timePerFrame) {
+      return false;
+    }
+
+    // update average
+    if (averageFrameTime != 0) {
+      averageFrameTime =
+          averageFrameTime * (averagePeriod - timePerFrame) / averagePeriod +
+          deltaTime * timePerFrame / averagePeriod;
+    } else {
+      averageFrameTime = deltaTime;
     }
-    m_streaming = true;
   }
+  return true;
+}
 
-  void StopStream() {
-    std::scoped_lock lock(m_mutex);
-    if (m_source) {
-      m_source->DisableSink();
+bool MjpegServerImpl::StreamClient::CheckBandwidth(Frame::Time thisFrameTime,
+                                                   uint64_t now) {
+  static constexpr int kMinQuality = 20;
+  static constexpr int kQualityStep = 10;
+
+  if (settings.bandwidth <= 0) {
+    return true;
+  }
+
+  // Fold in the last frame write.  One that completed within a couple of
+  // milliseconds just went into the socket buffer, so only slower ones
+  // measure what the connection is draining; faster ones let the estimate
+  // recover.
+  if (writeBytes != 0) {
+    if (writeTime >= 2000) {
+      double rate = writeBytes * 1000000.0 / writeTime;
+      drainRate = drainRate == 0 ? rate : drainRate * 0.8 + rate * 0.2;
+    } else if (drainRate != 0) {
+      drainRate *= 1.1;
+    }
+    frameSize =
+        frameSize == 0 ? writeBytes : frameSize * 0.8 + writeBytes * 0.2;
+    writeBytes = 0;
+  }
+
+  // Stay within both the configured budget and the measured drain rate, so
+  // frames don't sit stale in kernel buffers
+  budget = settings.bandwidth * 125.0;  // kbit/s to bytes/s
+  if (drainRate != 0 && drainRate < budget) {
+    budget = drainRate;
+  }
+
+  if (thisFrameTime > lastSourceTime && lastSourceTime != 0) {
+    double interval = thisFrameTime - lastSourceTime;
+    frameInterval = frameInterval == 0 ? interval
+                                       : frameInterval * 0.9 + interval * 0.1;
+  }
+  lastSourceTime = thisFrameTime;
+
+  // Trade quality for frame rate, at most twice a second: lower quality if
+  // the desired frame rate doesn't fit in the budget, and raise it back when
+  // there's ample headroom
+  if (frameSize != 0 && now - lastAdjustTime >= 500000) {
+    double fps = settings.fps;
+    if (fps == 0 && frameInterval != 0) {
+      fps = 1000000.0 / frameInterval;
+    }
+    double needed = frameSize * fps;
+    int maxQuality = settings.compression == -1 ? settings.defaultCompression
+                                                : settings.compression;
+    if (needed > budget && quality != kMinQuality) {
+      quality = std::max(
+          quality == -1 ? maxQuality : quality - kQualityStep, kMinQuality);
+      lastAdjustTime = now;
+    } else if (needed < budget * 0.6 && quality != -1) {
+      quality += kQualityStep;
+      if (quality >= maxQuality) {
+        quality = -1;
+      }
+      lastAdjustTime = now;
     }
-    m_streaming = false;
   }
-};
+
+  // Whatever quality can't save is made up by dropping frames
+  return now >= nextFrameTime;
+}
 
 // Standard header to send along with other header information like mimetype.
 //
@@ -270,6 +399,18 @@ bool MjpegServerImpl::ConnThread::ProcessCommand(wpi::raw_ostream& os,
       continue;
     }
 
+    if (param == "bandwidth") {
+      if (auto v = wpi::parse_integer<int>(value, 10)) {
+        m_bandwidth = v.value();
+        response << param << ": \"ok\"\r\n";
+      } else {
+        response << param << ": \"invalid integer\"\r\n";
+        SWARNING("HTTP parameter \"{}\" value \"{}\" is not an integer", param,
+                 value);
+      }
+      continue;
+    }
+
     if (param == "compression") {
       if (auto v = wpi::parse_integer<int>(value, 10)) {
         m_compression = v.value();
@@ -612,8 +753,13 @@ MjpegServerImpl::MjpegServerImpl(std::string_view name, wpi::Logger& logger,
   m_fpsProp = CreateProperty("fps", [] {
     return std::make_unique<PropertyImpl>("fps", CS_PROP_INTEGER, 1, 0, 0);
   });
+  m_bandwidthProp = CreateProperty("bandwidth", [] {
+    return std::make_unique<PropertyImpl>("bandwidth", CS_PROP_INTEGER, 1, 0,
+                                          0);
+  });
 
   m_serverThread = std::thread(&MjpegServerImpl::ServerThreadMain, this);
+  m_streamThread = std::thread(&MjpegServerImpl::StreamThreadMain, this);
 }
 
 MjpegServerImpl::~MjpegServerImpl() {
@@ -641,13 +787,30 @@ void MjpegServerImpl::Stop() {
     connThread.Stop();
   }
 
-  // wake up connection threads by forcing an empty frame to be sent
+  // wake up the stream thread by forcing an empty frame to be sent
   if (auto source = GetSource()) {
     source->Wakeup();
   }
+  m_streamCv.notify_all();
+  if (m_streamThread.joinable()) {
+    m_streamThread.join();
+  }
+
+  // close stream connections
+  Instance::GetInstance().eventLoop.ExecSync([this](wpi::uv::Loop&) {
+    std::vector<std::shared_ptr<StreamClient>> clients;
+    {
+      std::scoped_lock lock(m_mutex);
+      clients = m_streamClients;
+    }
+    for (auto&& client : clients) {
+      RemoveStreamClient(client);
+    }
+  });
 }
 
-// Send HTTP response and a stream of JPG-frames
+// Send HTTP response; the stream of JPG-frames is sent by the server once
+// Main() hands the connection off to it
 void MjpegServerImpl::ConnThread::SendStream(wpi::raw_socket_ostream& os) {
   if (m_noStreaming) {
     SERROR("{}", "Too many simultaneous client streams");
@@ -662,122 +825,18 @@ void MjpegServerImpl::ConnThread::SendStream(wpi::raw_socket_ostream& os) {
 
   SendHeader(oss, 200, "OK", "multipart/x-mixed-replace;boundary=" BOUNDARY);
   os << oss.str();
-
-  SDEBUG("{}", "Headers send, sending stream now");
-
-  Frame::Time lastFrameTime = 0;
-  Frame::Time timePerFrame = 0;
-  if (m_fps != 0) {
-    timePerFrame = 1000000.0 / m_fps;
-  }
-  Frame::Time averageFrameTime = 0;
-  Frame::Time averagePeriod = 1000000;  // 1 second window
-  if (averagePeriod < timePerFrame) {
-    averagePeriod = timePerFrame * 10;
+  if (os.has_error()) {
+    return;
   }
 
-  StartStream();
-  while (m_active && !os.has_error()) {
-    auto source = GetSource();
-    if (!source) {
-      // Source disconnected; sleep so we don't consume all processor time.
-      os << "\r\n";  // Keep connection alive
-      std::this_thread::sleep_for(std::chrono::milliseconds(200));
-      continue;
-    }
-    SDEBUG4("{}", "waiting for frame");
-    Frame frame = source->GetNextFrame(0.225);  // blocks
-    if (!m_active) {
-      break;
-    }
-    if (!frame) {
-      // Bad frame; sleep for 20 ms so we don't consume all processor time.
-      os << "\r\n";  // Keep connection alive
-      std::this_thread::sleep_for(std::chrono::milliseconds(20));
-      continue;
-    }
-
-    auto thisFrameTime = frame.GetTime();
-    if (thisFrameTime != 0 && timePerFrame != 0 && lastFrameTime != 0) {
-      Frame::Time deltaTime = thisFrameTime - lastFrameTime;
-
-      // drop frame if it is early compared to the desired frame rate AND
-      // the current average is higher than the desired average
-      if (deltaTime < timePerFrame && averageFrameTime < timePerFrame) {
-        // sleep for 1 ms so we don't consume all processor time
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        continue;
-      }
-
-      // update average
-      if (averageFrameTime != 0) {
-        averageFrameTime =
-            averageFrameTime * (averagePeriod - timePerFrame) / averagePeriod +
-            deltaTime * timePerFrame / averagePeriod;
-      } else {
-        averageFrameTime = deltaTime;
-      }
-    }
-
-    int width = m_width != 0 ? m_width : frame.GetOriginalWidth();
-    int height = m_height != 0 ? m_height : frame.GetOriginalHeight();
-    Image* image = frame.GetImageMJPEG(
-        width, height, m_compression,
-        m_compression == -1 ? m_defaultCompression : m_compression);
-    if (!image) {
-      // Shouldn't happen, but just in case...
-      std::this_thread::sleep_for(std::chrono::milliseconds(20));
-      continue;
-    }
-
-    const char* data = image->data();
-    size_t size = image->size();
-    bool addDHT = false;
-    size_t locSOF = size;
-    switch (image->pixelFormat) {
-      case VideoMode::kMJPEG:
-        // Determine if we need to add DHT to it, and allocate enough space
-        // for adding it if required.
-        addDHT = JpegNeedsDHT(data, &size, &locSOF);
-        break;
-      case VideoMode::kYUYV:
-      case VideoMode::kRGB565:
-      default:
-        // Bad frame; sleep for 10 ms so we don't consume all processor time.
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        continue;
-    }
-
-    SDEBUG4("sending frame size={} addDHT={}", size, addDHT);
-
-    // print the individual mimetype and the length
-    // sending the content-length fixes random stream disruption observed
-    // with firefox
-    lastFrameTime = thisFrameTime;
-    double timestamp = lastFrameTime / 1000000.0;
-    header.clear();
-    oss << "\r\n--" BOUNDARY "\r\n"
-        << "Content-Type: image/jpeg\r\n";
-    fmt::print(oss, "Content-Length: {}\r\n", size);
-    fmt::print(oss, "X-Timestamp: {}\r\n", timestamp);
-    oss << "\r\n";
-    os << oss.str();
-    if (addDHT) {
-      // Insert DHT data immediately before SOF
-      os << std::string_view(data, locSOF);
-      os << JpegGetDHT();
-      os << std::string_view(data + locSOF, image->size() - locSOF);
-    } else {
-      os << std::string_view(data, size);
-    }
-    // os.flush();
-  }
-  StopStream();
+  SDEBUG("{}", "Headers sent, handing off stream");
+  m_handoff = true;
 }
 
 void MjpegServerImpl::ConnThread::ProcessRequest() {
+  // m_stream is closed when it's released (unless it's handed off)
   wpi::raw_socket_istream is{*m_stream};
-  wpi::raw_socket_ostream os{*m_stream, true};
+  wpi::raw_socket_ostream os{*m_stream, false};
 
   // Read the request string from the stream
   wpi::SmallString<128> reqBuf;
@@ -916,7 +975,22 @@ void MjpegServerImpl::ConnThread::Main() {
     lock.unlock();
     ProcessRequest();
     lock.lock();
-    m_stream = nullptr;
+    auto stream = std::move(m_stream);
+    if (m_handoff) {
+      m_handoff = false;
+      StreamSettings settings{m_width,
+                              m_height,
+                              m_compression,
+                              m_defaultCompression,
+                              m_fps,
+                              m_bandwidth};
+      auto server = m_server;
+      lock.unlock();
+      if (m_active) {
+        server->AddStreamClient(std::move(stream), settings);
+      }
+      lock.lock();
+    }
   }
 }
 
@@ -957,23 +1031,20 @@ void MjpegServerImpl::ServerThreadMain() {
     // Start it if not already started
     it->Start(GetName(), m_logger);
 
-    auto nstreams =
-        std::count_if(m_connThreads.begin(), m_connThreads.end(),
-                      [](const wpi::SafeThreadOwner<ConnThread>& owner) {
-                        auto thr = owner.GetThread();
-                        return thr && thr->m_streaming;
-                      });
+    auto nstreams = m_streamClients.size();
 
     // Hand off connection to it
     auto thr = it->GetThread();
     thr->m_stream = std::move(stream);
     thr->m_source = source;
+    thr->m_server = this;
     thr->m_noStreaming = nstreams >= 10;
     thr->m_width = GetProperty(m_widthProp)->value;
     thr->m_height = GetProperty(m_heightProp)->value;
     thr->m_compression = GetProperty(m_compressionProp)->value;
     thr->m_defaultCompression = GetProperty(m_defaultCompressionProp)->value;
     thr->m_fps = GetProperty(m_fpsProp)->value;
+    thr->m_bandwidth = GetProperty(m_bandwidthProp)->value;
     thr->m_cond.notify_one();
   }
 
@@ -984,18 +1055,309 @@ void MjpegServerImpl::SetSourceImpl(std::shared_ptr<SourceImpl> source) {
   std::scoped_lock lock(m_mutex);
   for (auto& connThread : m_connThreads) {
     if (auto thr = connThread.GetThread()) {
-      if (thr->m_source != source) {
-        bool streaming = thr->m_streaming;
-        if (thr->m_source && streaming) {
-          thr->m_source->DisableSink();
-        }
-        thr->m_source = source;
-        if (source && streaming) {
-          thr->m_source->EnableSink();
+      thr->m_source = source;
+    }
+  }
+  for (auto&& client : m_streamClients) {
+    if (client->source != source) {
+      if (client->source) {
+        client->source->DisableSink();
+      }
+      client->source = source;
+      if (source) {
+        source->EnableSink();
+      }
+    }
+  }
+}
+
+// The event loop needs its own handle to a client's socket: closing a loop
+// handle closes its socket, and the NetworkStream closes (and shuts down)
+// the original.
+static bool DuplicateSocket(wpi::NetworkStream& stream, uv_os_sock_t* sock) {
+#ifdef _WIN32
+  WSAPROTOCOL_INFOW info;
+  if (WSADuplicateSocketW(stream.getNativeHandle(), GetCurrentProcessId(),
+                          &info) != 0) {
+    return false;
+  }
+  *sock = WSASocketW(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO,
+                     FROM_PROTOCOL_INFO, &info, 0, WSA_FLAG_OVERLAPPED);
+  return *sock != INVALID_SOCKET;
+#else
+  *sock = dup(stream.getNativeHandle());
+  return *sock >= 0;
+#endif
+}
+
+static void CloseSocket(uv_os_sock_t sock) {
+#ifdef _WIN32
+  closesocket(sock);
+#else
+  close(sock);
+#endif
+}
+
+void MjpegServerImpl::AddStreamClient(
+    std::unique_ptr<wpi::NetworkStream> stream,
+    const StreamSettings& settings) {
+  uv_os_sock_t sock;
+  if (!DuplicateSocket(*stream, &sock)) {
+    SWARNING("{}", "could not hand off stream connection");
+    return;
+  }
+
+  auto client = std::make_shared<StreamClient>();
+  client->stream = std::move(stream);
+  client->settings = settings;
+  if (settings.fps != 0) {
+    client->timePerFrame = 1000000.0 / settings.fps;
+  }
+  if (client->averagePeriod < client->timePerFrame) {
+    client->averagePeriod = client->timePerFrame * 10;
+  }
+
+  Instance::GetInstance().eventLoop.ExecAsync([this, client,
+                                               sock](wpi::uv::Loop& loop) {
+    auto tcp = wpi::uv::Tcp::Create(loop);
+    if (!tcp) {
+      CloseSocket(sock);
+      return;
+    }
+    tcp->Open(sock);
+    if (!m_active) {
+      tcp->Close();
+      return;
+    }
+    client->tcp = tcp;
+
+    // Nothing is expected from the client; reading detects it disconnecting
+    tcp->error.connect([this, client](wpi::uv::Error err) {
+      SDEBUG("stream client error: {}", err.str());
+      RemoveStreamClient(client);
+    });
+    tcp->end.connect([this, client] { RemoveStreamClient(client); });
+    tcp->StartRead();
+
+    auto source = GetSource();
+    if (source) {
+      source->EnableSink();
+    }
+    std::scoped_lock lock(m_mutex);
+    client->source = std::move(source);
+    m_streamClients.emplace_back(std::move(client));
+    m_streamCv.notify_one();
+  });
+}
+
+void MjpegServerImpl::RemoveStreamClient(
+    const std::shared_ptr<StreamClient>& client) {
+  std::shared_ptr<SourceImpl> source;
+  {
+    std::scoped_lock lock(m_mutex);
+    auto it =
+        std::find(m_streamClients.begin(), m_streamClients.end(), client);
+    if (it == m_streamClients.end()) {
+      return;  // already removed
+    }
+    m_streamClients.erase(it);
+    source = std::move(client->source);
+  }
+  if (source) {
+    source->DisableSink();
+  }
+  client->tcp->error.disconnect_all();
+  client->tcp->end.disconnect_all();
+  client->tcp->Close();
+  client->stream->close();
+}
+
+// Waits for frames and gives them to the loop to send to every stream client
+// that's ready for one.  Frame caches each conversion, so the clients with
+// the same settings share one image and one set of buffers, and the
+// encodings for clients with different settings are made in parallel.
+void MjpegServerImpl::StreamThreadMain() {
+  WPI_TRACE_THREAD_NAME("cscore MJPEG stream");
+  static const char* kKeepAlive = "\r\n";
+
+  // A converted image and the multipart headers for sending it
+  struct StreamImage {
+    Image* image;
+    std::string header;
+    bool addDHT;
+    size_t locSOF;
+    size_t size;
+  };
+
+  auto& eventLoop = Instance::GetInstance().eventLoop;
+  std::vector<std::shared_ptr<StreamClient>> clients;
+
+  while (m_active) {
+    {
+      std::unique_lock lock(m_mutex);
+      m_streamCv.wait(lock,
+                      [&] { return !m_active || !m_streamClients.empty(); });
+      if (!m_active) {
+        break;
+      }
+      clients = m_streamClients;
+    }
+
+    auto source = GetSource();
+    Frame frame;
+    if (source) {
+      SDEBUG4("{}", "waiting for frame");
+      frame = source->GetNextFrame(0.225);  // blocks
+    }
+    if (!m_active) {
+      break;
+    }
+    if (!frame) {
+      // Source disconnected or bad frame; keep the connections alive, and
+      // sleep so we don't consume all processor time.
+      for (auto&& client : clients) {
+        if (!client->writing.exchange(true)) {
+          eventLoop.ExecAsync([client](wpi::uv::Loop&) {
+            if (client->tcp->IsClosing()) {
+              return;
+            }
+            client->tcp->Write({wpi::uv::Buffer{kKeepAlive, 2}},
+                               [client](auto, wpi::uv::Error) {
+                                 client->writing = false;
+                               });
+          });
         }
       }
+      std::this_thread::sleep_for(std::chrono::milliseconds(source ? 20 : 200));
+      continue;
     }
+    WPI_TRACE_SCOPE("cscore.sink.mjpeg.frame");
+
+    // Pick the clients to send this frame to, and what each wants of it
+    std::vector<std::shared_ptr<StreamClient>> ready;
+    std::vector<Frame::MJPEGRequest> requests;
+    auto thisFrameTime = frame.GetTime();
+    uint64_t now = wpi::Now();
+    int dropped = 0;
+    for (auto&& client : clients) {
+      // still sending an earlier frame
+      if (client->writing) {
+        ++dropped;
+        continue;
+      }
+      if (client->frameLatency != 0) {
+        m_telemetry.RecordSinkLatency(*this, CS_SINK_SEND_LATENCY_P50,
+                                      client->writeTime);
+        m_telemetry.RecordSinkLatency(*this, CS_SINK_FRAME_LATENCY_P50,
+                                      client->frameLatency);
+        client->frameLatency = 0;
+      }
+      if (!client->CheckBandwidth(thisFrameTime, now) ||
+          !client->CheckFrameRate(thisFrameTime)) {
+        continue;
+      }
+
+      auto& settings = client->settings;
+      int width =
+          settings.width != 0 ? settings.width : frame.GetOriginalWidth();
+      int height =
+          settings.height != 0 ? settings.height : frame.GetOriginalHeight();
+      int compression =
+          client->quality != -1 ? client->quality : settings.compression;
+      ready.emplace_back(client);
+      requests.push_back(
+          {width, height, compression,
+           compression == -1 ? settings.defaultCompression : compression});
+    }
+
+    // Clients with different sizes or qualities need different encodings of
+    // the frame; each is done once, and they're done in parallel
+    frame.GetImagesMJPEG(requests, Instance::GetInstance().GetConvertPool());
+
+    auto images = std::make_shared<std::vector<StreamImage>>();
+    std::vector<std::pair<std::shared_ptr<StreamClient>, size_t>> targets;
+    for (size_t i = 0; i < ready.size(); ++i) {
+      auto& client = ready[i];
+      Image* image = requests[i].image;
+      if (!image || image->pixelFormat != VideoMode::kMJPEG) {
+        continue;
+      }
+
+      auto it = std::find_if(
+          images->begin(), images->end(),
+          [&](const StreamImage& oth) { return oth.image == image; });
+      if (it == images->end()) {
+        // Determine if we need to add DHT to it
+        StreamImage& si = images->emplace_back();
+        si.image = image;
+        si.addDHT = frame.JpegNeedsDHT(image, &si.size, &si.locSOF);
+
+        // print the individual mimetype and the length
+        // sending the content-length fixes random stream disruption observed
+        // with firefox
+        double timestamp = thisFrameTime / 1000000.0;
+        wpi::raw_string_ostream oss{si.header};
+        oss << "\r\n--" BOUNDARY "\r\n"
+            << "Content-Type: image/jpeg\r\n";
+        fmt::print(oss, "Content-Length: {}\r\n", si.size);
+        fmt::print(oss, "X-Timestamp: {}\r\n", timestamp);
+        oss << "\r\n";
+        oss.flush();
+        it = std::prev(images->end());
+      }
+      SDEBUG4("sending frame size={} addDHT={}", it->size, it->addDHT);
+
+      client->lastFrameTime = thisFrameTime;
+      if (client->settings.bandwidth > 0) {
+        client->nextFrameTime = now + it->size * 1000000.0 / client->budget;
+      }
+      client->writing = true;
+      targets.emplace_back(client, it - images->begin());
+    }
+    if (dropped != 0) {
+      m_telemetry.RecordSinkFramesDropped(*this, dropped);
+    }
+    if (targets.empty()) {
+      continue;
+    }
+
+    // The write callbacks keep the frame (and so its images) alive until
+    // every client has been sent its image
+    eventLoop.ExecAsync([frame, images,
+                         targets = std::move(targets)](wpi::uv::Loop&) {
+      for (auto&& target : targets) {
+        auto& client = target.first;
+        if (client->tcp->IsClosing()) {
+          continue;
+        }
+        const StreamImage& si = (*images)[target.second];
+        const char* data = si.image->data();
+        wpi::SmallVector<wpi::uv::Buffer, 4> bufs;
+        bufs.emplace_back(si.header);
+        if (si.addDHT) {
+          // Insert DHT data immediately before SOF
+          bufs.emplace_back(data, si.locSOF);
+          bufs.emplace_back(JpegGetDHT());
+          bufs.emplace_back(data + si.locSOF, si.image->size() - si.locSOF);
+        } else {
+          bufs.emplace_back(data, si.size);
+        }
+        size_t bytes = si.header.size() + si.size;
+        client->writeStart = wpi::Now();
+        client->tcp->Write(bufs, [client, frame, images, bytes](
+                                     auto, wpi::uv::Error) {
+          uint64_t now = wpi::Now();
+          client->writeTime = now - client->writeStart;
+          client->writeBytes = bytes;
+          auto frameTime = frame.GetTime();
+          client->frameLatency = now > frameTime ? now - frameTime : 1;
+          client->writing = false;
+        });
+      }
+    });
   }
+
+  SDEBUG("{}", "leaving stream thread");
 }
 
 namespace cs {
@@ -16,6 +16,7 @@
 #include <wpi/NetworkStream.h>
 #include <wpi/SafeThread.h>
 #include <wpi/SmallVector.h>
+#include <wpi/condition_variable.h>
 #include <wpi/raw_istream.h>
 #include <wpi/raw_ostream.h>
 #include <wpi/raw_socket_ostream.h>
@@ -45,6 +46,22 @@ class MjpegServerImpl : public SinkImpl {
 
   class ConnThread;
 
+  // Streaming clients are all served from the event loop; a single thread
+  // waits for frames and hands each one to every client that's ready for it.
+  struct StreamClient;
+  struct StreamSettings {
+    int width = 0;
+    int height = 0;
+    int compression = -1;
+    int defaultCompression = 80;
+    int fps = 0;
+    int bandwidth = 0;  // kbit/s, 0 for unlimited
+  };
+  void AddStreamClient(std::unique_ptr<wpi::NetworkStream> stream,
+                       const StreamSettings& settings);
+  void RemoveStreamClient(const std::shared_ptr<StreamClient>& client);
+  void StreamThreadMain();
+
   // Never changed, so not protected by mutex
   std::string m_listenAddress;
   int m_port;
@@ -55,12 +72,18 @@ class MjpegServerImpl : public SinkImpl {
 
   std::vector<wpi::SafeThreadOwner<ConnThread>> m_connThreads;
 
+  // Protected by m_mutex
+  std::vector<std::shared_ptr<StreamClient>> m_streamClients;
+  wpi::condition_variable m_streamCv;
+  std::thread m_streamThread;
+
   // property indices
   int m_widthProp;
   int m_heightProp;
   int m_compressionProp;
   int m_defaultCompressionProp;
   int m_fpsProp;
+  int m_bandwidthProp;
 };
 
 }  // namespace cs
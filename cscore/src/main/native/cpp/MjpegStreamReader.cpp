@@ -0,0 +1,168 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "MjpegStreamReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <wpi/NetworkStream.h>
+
+#include "Image.h"
+
+using namespace cs;
+
+// Big enough to hold the largest marker segment (64 KiB) in one piece
+static constexpr size_t kBufferSize = 128 * 1024;
+
+MjpegStreamReader::MjpegStreamReader(wpi::NetworkStream& stream, int timeout)
+    : m_stream{stream}, m_timeout{timeout}, m_buf(kBufferSize) {}
+
+void MjpegStreamReader::close() {
+  m_stream.close();
+}
+
+void MjpegStreamReader::read_impl(void* data, size_t len) {
+  char* cdata = static_cast<char*>(data);
+  size_t pos = (std::min)(len, m_end - m_pos);
+  std::memcpy(cdata, m_buf.data() + m_pos, pos);
+  m_pos += pos;
+
+  // Receive large reads (e.g. images with a Content-Length) directly into
+  // the destination rather than through the buffer
+  while (pos < len && len - pos >= kBufferSize / 2) {
+    wpi::NetworkStream::Error err;
+    size_t count = m_stream.receive(&cdata[pos], len - pos, &err, m_timeout);
+    if (count == 0) {
+      error_detected();
+      set_read_count(pos);
+      return;
+    }
+    pos += count;
+  }
+
+  if (pos < len) {
+    if (!Ensure(len - pos)) {
+      set_read_count(pos);
+      return;
+    }
+    std::memcpy(&cdata[pos], m_buf.data() + m_pos, len - pos);
+    m_pos += len - pos;
+    pos = len;
+  }
+  set_read_count(pos);
+}
+
+bool MjpegStreamReader::Fill() {
+  if (m_pos == m_end) {
+    m_pos = 0;
+    m_end = 0;
+  } else if (m_end == m_buf.size()) {
+    std::memmove(m_buf.data(), m_buf.data() + m_pos, m_end - m_pos);
+    m_end -= m_pos;
+    m_pos = 0;
+  }
+  wpi::NetworkStream::Error err;
+  size_t count = m_stream.receive(m_buf.data() + m_end, m_buf.size() - m_end,
+                                  &err, m_timeout);
+  if (count == 0) {
+    error_detected();
+    return false;
+  }
+  m_end += count;
+  return true;
+}
+
+bool MjpegStreamReader::Ensure(size_t len) {
+  if (m_end - m_pos >= len) {
+    return true;
+  }
+  // Make room for the whole run at once
+  if (m_buf.size() - m_pos < len) {
+    std::memmove(m_buf.data(), m_buf.data() + m_pos, m_end - m_pos);
+    m_end -= m_pos;
+    m_pos = 0;
+  }
+  while (m_end - m_pos < len) {
+    if (!Fill()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MjpegStreamReader::Append(Image& image, size_t len) {
+  size_t oldSize = image.size();
+  image.resize(oldSize + len);
+  std::memcpy(image.data() + oldSize, m_buf.data() + m_pos, len);
+  m_pos += len;
+}
+
+bool MjpegStreamReader::ReadJpeg(Image& image) {
+  // SOI
+  if (!Ensure(2)) {
+    return false;
+  }
+  if (Peek()[0] != 0xff || Peek()[1] != 0xd8) {
+    return false;
+  }
+  Append(image, 2);
+
+  for (;;) {
+    if (!Ensure(2)) {
+      return false;
+    }
+    const unsigned char* bytes = Peek();
+    if (bytes[0] != 0xff) {
+      return false;  // not a marker
+    }
+    unsigned char marker = bytes[1];
+
+    if (marker == 0xd9) {
+      Append(image, 2);
+      return true;  // EOI, we're done
+    }
+
+    if (marker == 0xda) {
+      // SOS: copy until the next marker that isn't a stuffed 0xff, a fill
+      // byte, or a restart marker
+      Append(image, 2);
+      for (;;) {
+        if (m_pos == m_end && !Fill()) {
+          return false;
+        }
+        auto found = static_cast<const char*>(
+            std::memchr(m_buf.data() + m_pos, 0xff, m_end - m_pos));
+        if (!found) {
+          Append(image, m_end - m_pos);
+          continue;
+        }
+        Append(image, found - (m_buf.data() + m_pos));
+        if (!Ensure(2)) {
+          return false;
+        }
+        unsigned char next = Peek()[1];
+        if (next == 0xff) {
+          Append(image, 1);
+        } else if (next == 0x00 || (next >= 0xd0 && next <= 0xd7)) {
+          Append(image, 2);
+        } else {
+          break;
+        }
+      }
+      continue;
+    }
+
+    // A normal segment; the length includes itself but not the marker
+    if (!Ensure(4)) {
+      return false;
+    }
+    bytes = Peek();
+    size_t segmentLength = bytes[2] * 256 + bytes[3];
+    if (segmentLength < 2 || !Ensure(2 + segmentLength)) {
+      return false;
+    }
+    Append(image, 2 + segmentLength);
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_MJPEGSTREAMREADER_H_
+#define CSCORE_MJPEGSTREAMREADER_H_
+
+#include <vector>
+
+#include <wpi/raw_istream.h>
+
+namespace wpi {
+class NetworkStream;
+}  // namespace wpi
+
+namespace cs {
+
+class Image;
+
+// Buffered input for a multipart JPEG stream.  raw_socket_istream has to read
+// a byte at a time wherever it can't know the length ahead of time (headers,
+// boundaries, and JPEGs without a Content-Length), so as not to read past the
+// end of the part; this instead receives in large chunks and keeps whatever
+// follows the current part for the next one.
+class MjpegStreamReader : public wpi::raw_istream {
+ public:
+  explicit MjpegStreamReader(wpi::NetworkStream& stream, int timeout = 0);
+
+  void close() override;
+  size_t in_avail() const override { return m_end - m_pos; }
+
+  // Reads a JPEG image (SOI through EOI) of unknown length, appending it to
+  // image.  Marker segments are skipped by their lengths, and entropy-coded
+  // data is searched for the next marker in bulk.
+  bool ReadJpeg(Image& image);
+
+ private:
+  void read_impl(void* data, size_t len) override;
+
+  // Receives at least one more byte into the buffer
+  bool Fill();
+  // Makes at least len bytes available in the buffer
+  bool Ensure(size_t len);
+  // Moves len buffered bytes to the end of image
+  void Append(Image& image, size_t len);
+
+  const unsigned char* Peek() const {
+    return reinterpret_cast<const unsigned char*>(m_buf.data() + m_pos);
+  }
+
+  wpi::NetworkStream& m_stream;
+  int m_timeout;
+
+  // Buffered data is [m_pos, m_end)
+  std::vector<char> m_buf;
+  size_t m_pos = 0;
+  size_t m_end = 0;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_MJPEGSTREAMREADER_H_
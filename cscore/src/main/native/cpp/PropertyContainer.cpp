@@ -4,6 +4,8 @@
 
 #include "PropertyContainer.h"
 
+#include <algorithm>
+
 #include <wpi/Logger.h>
 #include <wpi/SmallString.h>
 #include <wpi/SmallVector.h>
@@ -223,6 +225,54 @@ std::vector<std::string> PropertyContainer::GetEnumPropertyChoices(
   return prop->enumChoices;
 }
 
+void PropertyContainer::SetProperties(wpi::span<const PropertyUpdate> updates,
+                                      CS_Status* status) {
+  {
+    std::scoped_lock lock(m_mutex);
+    BeginPropertyBatch();
+  }
+  for (auto&& update : updates) {
+    CS_Status updateStatus = 0;
+    if (update.setString) {
+      SetStringProperty(update.property, update.valueStr, &updateStatus);
+    } else {
+      SetProperty(update.property, update.value, &updateStatus);
+    }
+    if (updateStatus != 0 && *status == 0) {
+      *status = updateStatus;
+    }
+  }
+  std::scoped_lock lock(m_mutex);
+  EndPropertyBatch();
+}
+
+void PropertyContainer::PropertyValueUpdated(int property, PropertyImpl& prop) {
+  // Only notify updates after we've notified created
+  if (!m_properties_cached) {
+    return;
+  }
+  if (m_batchDepth > 0) {
+    if (std::find(m_batchUpdated.begin(), m_batchUpdated.end(), property) ==
+        m_batchUpdated.end()) {
+      m_batchUpdated.push_back(property);
+    }
+    return;
+  }
+  NotifyPropertyValueUpdated(property, prop);
+}
+
+void PropertyContainer::EndPropertyBatch() {
+  if (--m_batchDepth > 0) {
+    return;
+  }
+  for (int property : m_batchUpdated) {
+    if (auto prop = GetProperty(property)) {
+      NotifyPropertyValueUpdated(property, *prop);
+    }
+  }
+  m_batchUpdated.clear();
+}
+
 std::unique_ptr<PropertyImpl> PropertyContainer::CreateEmptyProperty(
     std::string_view name) const {
   return std::make_unique<PropertyImpl>(name);
@@ -238,6 +288,7 @@ bool PropertyContainer::SetPropertiesJson(const wpi::json& config,
                                           wpi::Logger& logger,
                                           std::string_view logName,
                                           CS_Status* status) {
+  std::vector<PropertyUpdate> updates;
   for (auto&& prop : config) {
     std::string name;
     try {
@@ -254,17 +305,17 @@ bool PropertyContainer::SetPropertiesJson(const wpi::json& config,
         std::string val = v.get<std::string>();
         WPI_INFO(logger, "{}: SetConfigJson: setting property '{}' to '{}'",
                  logName, name, val);
-        SetStringProperty(n, val, status);
+        updates.push_back({n, true, 0, std::move(val)});
       } else if (v.is_boolean()) {
         bool val = v.get<bool>();
         WPI_INFO(logger, "{}: SetConfigJson: setting property '{}' to {}",
                  logName, name, val);
-        SetProperty(n, val, status);
+        updates.push_back({n, false, val, {}});
       } else {
         int val = v.get<int>();
         WPI_INFO(logger, "{}: SetConfigJson: setting property '{}' to {}",
                  logName, name, val);
-        SetProperty(n, val, status);
+        updates.push_back({n, false, val, {}});
       }
     } catch (const wpi::json::exception& e) {
       WPI_WARNING(logger,
@@ -274,6 +325,8 @@ bool PropertyContainer::SetPropertiesJson(const wpi::json& config,
     }
   }
 
+  // Applied together, so a device can take them in one round trip
+  SetProperties(updates, status);
   return true;
 }
 
@@ -30,6 +30,14 @@ namespace cs {
 
 class PropertyContainer {
  public:
+  // A property value to set as part of a batch
+  struct PropertyUpdate {
+    int property;
+    bool setString;
+    int value;
+    std::string valueStr;
+  };
+
   virtual ~PropertyContainer() = default;
 
   int GetPropertyIndex(std::string_view name) const;
@@ -53,6 +61,14 @@ class PropertyContainer {
   std::vector<std::string> GetEnumPropertyChoices(int property,
                                                   CS_Status* status) const;
 
+  // Sets several properties at once.  Every update that can be applied is;
+  // status is set to the error of the first one that fails.  Value-updated
+  // notifications are held until the batch is done, and sent once for each
+  // property changed, however many times it was set.  The default
+  // implementation calls SetProperty() or SetStringProperty() for each.
+  virtual void SetProperties(wpi::span<const PropertyUpdate> updates,
+                             CS_Status* status);
+
   bool SetPropertiesJson(const wpi::json& config, wpi::Logger& logger,
                          std::string_view logName, CS_Status* status);
   wpi::json GetPropertiesJsonObject(CS_Status* status);
@@ -113,6 +129,21 @@ class PropertyContainer {
   virtual void UpdatePropertyValue(int property, bool setString, int value,
                                    std::string_view valueStr) = 0;
 
+  // Notify that a property value was updated; must be called with m_mutex
+  // held.  Implementations call PropertyValueUpdated() rather than this, so
+  // that notifications during a batch are coalesced.
+  virtual void NotifyPropertyValueUpdated(int property, PropertyImpl& prop) = 0;
+
+  // Notifies of an updated property value, or during a batch, records it to
+  // be notified when the batch ends; must be called with m_mutex held.
+  void PropertyValueUpdated(int property, PropertyImpl& prop);
+
+  // Start and end a batch of updates; must be called with m_mutex held.
+  // Batches may nest or overlap; the notifications are sent when the last
+  // one ends.
+  void BeginPropertyBatch() { ++m_batchDepth; }
+  void EndPropertyBatch();
+
   // Whether CacheProperties() has been successful at least once (and thus
   // should not be called again)
   mutable std::atomic_bool m_properties_cached{false};
@@ -122,6 +153,11 @@ class PropertyContainer {
   // Cached properties (protected with m_mutex)
   mutable std::vector<std::unique_ptr<PropertyImpl>> m_propertyData;
   mutable wpi::StringMap<int> m_properties;
+
+ private:
+  // Batch state (protected with m_mutex)
+  int m_batchDepth = 0;
+  std::vector<int> m_batchUpdated;
 };
 
 }  // namespace cs
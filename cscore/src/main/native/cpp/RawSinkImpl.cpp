@@ -80,26 +80,68 @@ uint64_t RawSinkImpl::GrabFrame(CS_RawFrame& image, double timeout) {
   return GrabFrameImpl(image, frame);
 }
 
-uint64_t RawSinkImpl::GrabFrameImpl(CS_RawFrame& rawFrame,
-                                    Frame& incomingFrame) {
-  Image* newImage = nullptr;
+uint64_t RawSinkImpl::GrabFrameShared(CS_RawFrame& image,
+                                      std::shared_ptr<void>& frameRef,
+                                      double timeout) {
+  SetEnabled(true);
+
+  auto source = GetSource();
+  if (!source) {
+    // Source disconnected; sleep for one second
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    return 0;
+  }
 
+  auto frame = source->GetNextFrame(timeout);  // blocks
+  if (!frame) {
+    // Bad frame; sleep for 20 ms so we don't consume all processor time.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return 0;  // signal error
+  }
+
+  Image* newImage = GetFrameImage(image, frame);
+  if (!newImage) {
+    // Shouldn't happen, but just in case...
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return 0;
+  }
+
+  // The image memory belongs to the frame, which returns it to the source's
+  // pool; keep both alive for as long as the caller holds the reference
+  struct FrameRef {
+    std::shared_ptr<SourceImpl> source;
+    Frame frame;
+  };
+  image.data = reinterpret_cast<char*>(newImage->data());
+  image.height = newImage->height;
+  image.width = newImage->width;
+  image.pixelFormat = newImage->pixelFormat;
+  image.totalData = newImage->size();
+  frameRef = std::make_shared<FrameRef>(FrameRef{std::move(source), frame});
+  return frame.GetTime();
+}
+
+Image* RawSinkImpl::GetFrameImage(const CS_RawFrame& rawFrame,
+                                  Frame& incomingFrame) {
   if (rawFrame.pixelFormat == CS_PixelFormat::CS_PIXFMT_UNKNOWN) {
     // Always get incoming image directly on unknown
-    newImage = incomingFrame.GetExistingImage(0);
-  } else {
-    // Format is known, ask for it
-    auto width = rawFrame.width;
-    auto height = rawFrame.height;
-    auto pixelFormat =
-        static_cast<VideoMode::PixelFormat>(rawFrame.pixelFormat);
-    if (width <= 0 || height <= 0) {
-      width = incomingFrame.GetOriginalWidth();
-      height = incomingFrame.GetOriginalHeight();
-    }
-    newImage = incomingFrame.GetImage(width, height, pixelFormat);
+    return incomingFrame.GetExistingImage(0);
   }
 
+  // Format is known, ask for it
+  auto width = rawFrame.width;
+  auto height = rawFrame.height;
+  auto pixelFormat = static_cast<VideoMode::PixelFormat>(rawFrame.pixelFormat);
+  if (width <= 0 || height <= 0) {
+    width = incomingFrame.GetOriginalWidth();
+    height = incomingFrame.GetOriginalHeight();
+  }
+  return incomingFrame.GetImage(width, height, pixelFormat);
+}
+
+uint64_t RawSinkImpl::GrabFrameImpl(CS_RawFrame& rawFrame,
+                                    Frame& incomingFrame) {
+  Image* newImage = GetFrameImage(rawFrame, incomingFrame);
   if (!newImage) {
     // Shouldn't happen, but just in case...
     std::this_thread::sleep_for(std::chrono::milliseconds(20));
@@ -177,6 +219,18 @@ uint64_t GrabSinkFrameTimeout(CS_Sink sink, CS_RawFrame& image, double timeout,
   }
   return static_cast<RawSinkImpl&>(*data->sink).GrabFrame(image, timeout);
 }
+
+uint64_t GrabSinkFrameShared(CS_Sink sink, CS_RawFrame& image,
+                             std::shared_ptr<void>& frameRef, double timeout,
+                             CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_RAW) {
+    *status = CS_INVALID_HANDLE;
+    return 0;
+  }
+  return static_cast<RawSinkImpl&>(*data->sink)
+      .GrabFrameShared(image, frameRef, timeout);
+}
 }  // namespace cs
 
 extern "C" {
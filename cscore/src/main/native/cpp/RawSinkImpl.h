@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <string_view>
 #include <thread>
 
@@ -34,11 +35,14 @@ class RawSinkImpl : public SinkImpl {
 
   uint64_t GrabFrame(CS_RawFrame& frame);
   uint64_t GrabFrame(CS_RawFrame& frame, double timeout);
+  uint64_t GrabFrameShared(CS_RawFrame& frame, std::shared_ptr<void>& frameRef,
+                           double timeout);
 
  private:
   void ThreadMain();
 
   uint64_t GrabFrameImpl(CS_RawFrame& rawFrame, Frame& incomingFrame);
+  Image* GetFrameImage(const CS_RawFrame& rawFrame, Frame& incomingFrame);
 
   std::atomic_bool m_active;  // set to false to terminate threads
   std::thread m_thread;
@@ -21,22 +21,22 @@ RawSourceImpl::RawSourceImpl(std::string_view name, wpi::Logger& logger,
 
 RawSourceImpl::~RawSourceImpl() = default;
 
-void RawSourceImpl::PutFrame(const CS_RawFrame& image) {
-  int type;
-  switch (image.pixelFormat) {
+static int GetImageType(int pixelFormat) {
+  switch (pixelFormat) {
     case VideoMode::kYUYV:
     case VideoMode::kRGB565:
-      type = CV_8UC2;
-      break;
+      return CV_8UC2;
     case VideoMode::kBGR:
-      type = CV_8UC3;
-      break;
+      return CV_8UC3;
     case VideoMode::kGray:
     case VideoMode::kMJPEG:
     default:
-      type = CV_8UC1;
-      break;
+      return CV_8UC1;
   }
+}
+
+void RawSourceImpl::PutFrame(const CS_RawFrame& image) {
+  int type = GetImageType(image.pixelFormat);
   cv::Mat finalImage{image.height, image.width, type, image.data};
   std::unique_ptr<Image> dest =
       AllocImage(static_cast<VideoMode::PixelFormat>(image.pixelFormat),
@@ -46,6 +46,20 @@ void RawSourceImpl::PutFrame(const CS_RawFrame& image) {
   SourceImpl::PutFrame(std::move(dest), wpi::Now());
 }
 
+std::unique_ptr<Image> RawSourceImpl::AllocFrame(CS_RawFrame& image) {
+  int totalData = image.totalData;
+  if (totalData <= 0) {
+    totalData = image.width * image.height *
+                CV_ELEM_SIZE(GetImageType(image.pixelFormat));
+  }
+  auto dest =
+      AllocImage(static_cast<VideoMode::PixelFormat>(image.pixelFormat),
+                 image.width, image.height, totalData);
+  image.data = reinterpret_cast<char*>(dest->data());
+  image.totalData = totalData;
+  return dest;
+}
+
 namespace cs {
 CS_Source CreateRawSource(std::string_view name, const VideoMode& mode,
                           CS_Status* status) {
@@ -64,6 +78,18 @@ void PutSourceFrame(CS_Source source, const CS_RawFrame& image,
   }
   static_cast<RawSourceImpl&>(*data->source).PutFrame(image);
 }
+
+std::shared_ptr<void> AllocSourceFrame(CS_Source source, CS_RawFrame& image,
+                                       CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data || data->kind != CS_SOURCE_RAW) {
+    *status = CS_INVALID_HANDLE;
+    return nullptr;
+  }
+  return MakeSourceFrameRef(
+      data->source,
+      static_cast<RawSourceImpl&>(*data->source).AllocFrame(image));
+}
 }  // namespace cs
 
 extern "C" {
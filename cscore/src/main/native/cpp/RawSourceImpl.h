@@ -27,6 +27,10 @@ class RawSourceImpl : public ConfigurableSourceImpl {
   // Raw-specific functions
   void PutFrame(const CS_RawFrame& image);
 
+  // Gets a pooled image for the caller to fill in place; see
+  // cs::RawSource::AllocFrame()
+  std::unique_ptr<Image> AllocFrame(CS_RawFrame& image);
+
  private:
   std::atomic_bool m_connected{true};
 };
@@ -0,0 +1,73 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_SHAREDFRAMERING_H_
+#define CSCORE_SHAREDFRAMERING_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <string_view>
+
+#include "cscore_cpp.h"
+
+namespace cs {
+
+// A ring of frame slots in named memory shared between processes.  One
+// process writes each frame into the next slot and wakes the readers; each
+// reader copies out the newest frame.  A slot is protected by a sequence
+// count rather than a lock, so a slow (or dead) reader never blocks the
+// writer, and a reader detects a slot overwritten while it copied.
+//
+// Frame times are in the wpi::Now() base of the calling process; they are
+// carried across processes as an age relative to the shared monotonic clock.
+class SharedFrameRing {
+ public:
+  struct FrameInfo {
+    VideoMode::PixelFormat pixelFormat = VideoMode::kUnknown;
+    int width = 0;
+    int height = 0;
+    size_t size = 0;
+    uint64_t time = 0;
+  };
+
+  virtual ~SharedFrameRing() = default;
+
+  // The largest frame that fits in a slot
+  virtual size_t GetSlotSize() const = 0;
+
+  // Writer: copies a frame into the next slot and wakes the readers.  The
+  // frame must fit in a slot.
+  virtual void Write(const FrameInfo& info, const char* data) = 0;
+
+  // Reader: waits up to timeout seconds for a frame newer than the last one
+  // read.  Returns false on timeout or once the ring is closed.
+  virtual bool Wait(double timeout) = 0;
+
+  // Reader: copies out the newest frame, calling alloc for a buffer of
+  // info.size bytes to copy into.  Returns false if there is no frame yet or
+  // the writer overwrote it during the copy.
+  virtual bool Read(FrameInfo* info,
+                    const std::function<char*(const FrameInfo&)>& alloc) = 0;
+
+  // Reader: true once the writer has closed or replaced the ring; the reader
+  // should open it again.
+  virtual bool IsClosed() const = 0;
+
+  // Creates a ring for writing, replacing any existing ring of the same
+  // name.  Returns nullptr on error, including on platforms without shared
+  // memory support.  Implemented per platform.
+  static std::unique_ptr<SharedFrameRing> Create(std::string_view name,
+                                                 int numSlots,
+                                                 size_t slotSize);
+
+  // Opens an existing ring for reading.  Returns nullptr if there is none.
+  // Implemented per platform.
+  static std::unique_ptr<SharedFrameRing> Open(std::string_view name);
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_SHAREDFRAMERING_H_
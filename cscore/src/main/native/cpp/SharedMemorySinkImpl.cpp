@@ -0,0 +1,134 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "SharedMemorySinkImpl.h"
+
+#include <chrono>
+
+#include <fmt/format.h>
+#include <wpi/trace.h>
+
+#include "Instance.h"
+#include "Log.h"
+#include "SharedFrameRing.h"
+#include "SourceImpl.h"
+
+using namespace cs;
+
+// Enough slots that a reader has a few frame periods to copy out the newest
+// frame before the writer comes back around to it
+static constexpr int kNumSlots = 4;
+
+SharedMemorySinkImpl::SharedMemorySinkImpl(std::string_view name,
+                                           wpi::Logger& logger,
+                                           Notifier& notifier,
+                                           Telemetry& telemetry,
+                                           std::string_view shmName)
+    : SinkImpl{name, logger, notifier, telemetry}, m_shmName{shmName} {
+  m_active = true;
+  SetDescription(fmt::format("shared memory {}", shmName));
+  m_thread = std::thread(&SharedMemorySinkImpl::ThreadMain, this);
+}
+
+SharedMemorySinkImpl::~SharedMemorySinkImpl() {
+  Stop();
+}
+
+void SharedMemorySinkImpl::Stop() {
+  m_active = false;
+
+  // wake up any waiters by forcing an empty frame to be sent
+  if (auto source = GetSource()) {
+    source->Wakeup();
+  }
+
+  // join thread
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+void SharedMemorySinkImpl::ThreadMain() {
+  WPI_TRACE_THREAD_NAME("cscore shared memory sink");
+  std::unique_ptr<SharedFrameRing> ring;
+  bool reportedFailure = false;
+
+  Enable();
+  while (m_active) {
+    auto source = GetSource();
+    Frame frame;
+    if (source) {
+      SDEBUG4("{}", "waiting for frame");
+      frame = source->GetNextFrame(0.225);  // blocks
+    }
+    if (!m_active) {
+      break;
+    }
+    if (!frame) {
+      // Source disconnected or bad frame; sleep so we don't consume all
+      // processor time
+      std::this_thread::sleep_for(std::chrono::milliseconds(source ? 20 : 200));
+      continue;
+    }
+    WPI_TRACE_SCOPE("cscore.sink.sharedMemory.frame");
+
+    // Publish the image as captured; readers convert it as they need to
+    Image* image = frame.GetExistingImage(0);
+    if (!image || image->size() == 0) {
+      continue;
+    }
+
+    // (re)create the ring when a frame doesn't fit, with room to spare so
+    // varying compressed frame sizes don't each replace it
+    if (!ring || image->size() > ring->GetSlotSize()) {
+      size_t slotSize = image->size() + image->size() / 2;
+      ring.reset();
+      ring = SharedFrameRing::Create(m_shmName, kNumSlots, slotSize);
+      if (!ring) {
+        if (!reportedFailure) {
+          SERROR("could not create shared memory '{}'", m_shmName);
+          reportedFailure = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        continue;
+      }
+      SDEBUG("publishing to shared memory '{}' ({} byte slots)", m_shmName,
+             slotSize);
+      reportedFailure = false;
+    }
+
+    SharedFrameRing::FrameInfo info;
+    info.pixelFormat = image->pixelFormat;
+    info.width = image->width;
+    info.height = image->height;
+    info.size = image->size();
+    info.time = frame.GetTime();
+    ring->Write(info, image->data());
+  }
+  Disable();
+
+  SDEBUG("{}", "leaving shared memory thread");
+}
+
+namespace cs {
+
+CS_Sink CreateSharedMemorySink(std::string_view name, std::string_view shmName,
+                               CS_Status* status) {
+  auto& inst = Instance::GetInstance();
+  return inst.CreateSink(
+      CS_SINK_SHARED_MEMORY,
+      std::make_shared<SharedMemorySinkImpl>(name, inst.logger, inst.notifier,
+                                             inst.telemetry, shmName));
+}
+
+}  // namespace cs
+
+extern "C" {
+
+CS_Sink CS_CreateSharedMemorySink(const char* name, const char* shmName,
+                                  CS_Status* status) {
+  return cs::CreateSharedMemorySink(name, shmName, status);
+}
+
+}  // extern "C"
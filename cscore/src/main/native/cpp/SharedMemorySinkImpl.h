@@ -0,0 +1,40 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_SHAREDMEMORYSINKIMPL_H_
+#define CSCORE_SHAREDMEMORYSINKIMPL_H_
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "SinkImpl.h"
+
+namespace cs {
+
+// Publishes each frame of its source, in the source's own format, to a
+// shared memory ring that SharedMemorySourceImpl in other processes reads.
+class SharedMemorySinkImpl : public SinkImpl {
+ public:
+  SharedMemorySinkImpl(std::string_view name, wpi::Logger& logger,
+                       Notifier& notifier, Telemetry& telemetry,
+                       std::string_view shmName);
+  ~SharedMemorySinkImpl() override;
+
+  void Stop();
+
+ private:
+  void ThreadMain();
+
+  // Never changed, so not protected by mutex
+  std::string m_shmName;
+
+  std::atomic_bool m_active;  // set to false to terminate thread
+  std::thread m_thread;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_SHAREDMEMORYSINKIMPL_H_
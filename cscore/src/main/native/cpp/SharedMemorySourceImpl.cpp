@@ -0,0 +1,151 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "SharedMemorySourceImpl.h"
+
+#include <chrono>
+#include <memory>
+
+#include <fmt/format.h>
+
+#include "Instance.h"
+#include "Log.h"
+#include "Notifier.h"
+#include "SharedFrameRing.h"
+
+using namespace cs;
+
+SharedMemorySourceImpl::SharedMemorySourceImpl(std::string_view name,
+                                               wpi::Logger& logger,
+                                               Notifier& notifier,
+                                               Telemetry& telemetry,
+                                               std::string_view shmName)
+    : SourceImpl{name, logger, notifier, telemetry}, m_shmName{shmName} {
+  SetDescription(fmt::format("shared memory {}", shmName));
+}
+
+SharedMemorySourceImpl::~SharedMemorySourceImpl() {
+  m_active = false;
+
+  // wake up thread
+  m_sinkEnabledCond.notify_all();
+
+  // join thread
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+void SharedMemorySourceImpl::Start() {
+  m_thread = std::thread(&SharedMemorySourceImpl::ThreadMain, this);
+}
+
+bool SharedMemorySourceImpl::SetVideoMode(const VideoMode& mode,
+                                          CS_Status* status) {
+  // The publisher decides the mode
+  *status = CS_UNSUPPORTED_MODE;
+  return false;
+}
+
+void SharedMemorySourceImpl::NumSinksChanged() {
+  // ignore
+}
+
+void SharedMemorySourceImpl::NumSinksEnabledChanged() {
+  m_sinkEnabledCond.notify_one();
+}
+
+void SharedMemorySourceImpl::UpdateMode(VideoMode::PixelFormat pixelFormat,
+                                        int width, int height) {
+  VideoMode mode;
+  {
+    std::scoped_lock lock(m_mutex);
+    if (pixelFormat == m_mode.pixelFormat && width == m_mode.width &&
+        height == m_mode.height) {
+      return;
+    }
+    m_mode = VideoMode{pixelFormat, width, height, 0};
+    m_videoModes.assign(1, m_mode);
+    mode = m_mode;
+  }
+  m_notifier.NotifySource(*this, CS_SOURCE_VIDEOMODES_UPDATED);
+  m_notifier.NotifySourceVideoMode(*this, mode);
+}
+
+void SharedMemorySourceImpl::ThreadMain() {
+  std::unique_ptr<SharedFrameRing> ring;
+
+  while (m_active) {
+    // release the ring and wait while no sinks are enabled
+    if (!IsEnabled()) {
+      if (ring) {
+        ring.reset();
+        SetConnected(false);
+      }
+      std::unique_lock lock(m_mutex);
+      m_sinkEnabledCond.wait(lock, [=] { return !m_active || IsEnabled(); });
+      continue;
+    }
+
+    // open (and keep retrying until the publisher creates) the ring
+    if (!ring) {
+      ring = SharedFrameRing::Open(m_shmName);
+      if (!ring) {
+        std::unique_lock lock(m_mutex);
+        m_sinkEnabledCond.wait_for(lock, std::chrono::milliseconds(500),
+                                   [=] { return !m_active; });
+        continue;
+      }
+      SDEBUG("opened shared memory '{}'", m_shmName);
+      SetConnected(true);
+    }
+
+    if (!ring->Wait(0.5)) {
+      if (ring->IsClosed()) {
+        // reopen, as the publisher has gone or replaced the ring
+        SDEBUG("shared memory '{}' closed", m_shmName);
+        ring.reset();
+        SetConnected(false);
+      }
+      continue;
+    }
+
+    std::unique_ptr<Image> image;
+    SharedFrameRing::FrameInfo info;
+    if (!ring->Read(&info, [&](const SharedFrameRing::FrameInfo& info) {
+          image =
+              AllocImage(info.pixelFormat, info.width, info.height, info.size);
+          return image->data();
+        })) {
+      continue;  // overwritten while copying; try the newer frame
+    }
+    UpdateMode(info.pixelFormat, info.width, info.height);
+    PutFrame(std::move(image), info.time);
+  }
+
+  SDEBUG("{}", "leaving shared memory thread");
+}
+
+namespace cs {
+
+CS_Source CreateSharedMemorySource(std::string_view name,
+                                   std::string_view shmName,
+                                   CS_Status* status) {
+  auto& inst = Instance::GetInstance();
+  return inst.CreateSource(
+      CS_SOURCE_SHARED_MEMORY,
+      std::make_shared<SharedMemorySourceImpl>(name, inst.logger, inst.notifier,
+                                               inst.telemetry, shmName));
+}
+
+}  // namespace cs
+
+extern "C" {
+
+CS_Source CS_CreateSharedMemorySource(const char* name, const char* shmName,
+                                      CS_Status* status) {
+  return cs::CreateSharedMemorySource(name, shmName, status);
+}
+
+}  // extern "C"
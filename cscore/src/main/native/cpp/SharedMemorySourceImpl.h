@@ -0,0 +1,52 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_SHAREDMEMORYSOURCEIMPL_H_
+#define CSCORE_SHAREDMEMORYSOURCEIMPL_H_
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <wpi/condition_variable.h>
+
+#include "SourceImpl.h"
+
+namespace cs {
+
+// Receives the frames a SharedMemorySinkImpl in another process publishes.
+// The video mode is whatever the publisher sends; it can't be set here.
+class SharedMemorySourceImpl : public SourceImpl {
+ public:
+  SharedMemorySourceImpl(std::string_view name, wpi::Logger& logger,
+                         Notifier& notifier, Telemetry& telemetry,
+                         std::string_view shmName);
+  ~SharedMemorySourceImpl() override;
+
+  void Start() override;
+
+  bool SetVideoMode(const VideoMode& mode, CS_Status* status) override;
+
+  void NumSinksChanged() override;
+  void NumSinksEnabledChanged() override;
+
+ private:
+  void ThreadMain();
+
+  // Updates the video mode to match a received frame
+  void UpdateMode(VideoMode::PixelFormat pixelFormat, int width, int height);
+
+  // Never changed, so not protected by mutex
+  std::string m_shmName;
+
+  std::atomic_bool m_active{true};  // set to false to terminate thread
+  std::thread m_thread;
+
+  wpi::condition_variable m_sinkEnabledCond;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_SHAREDMEMORYSOURCEIMPL_H_
@@ -5,10 +5,12 @@
 #include "SinkImpl.h"
 
 #include <wpi/json.h>
+#include <wpi/timestamp.h>
 
 #include "Instance.h"
 #include "Notifier.h"
 #include "SourceImpl.h"
+#include "Telemetry.h"
 
 using namespace cs;
 
@@ -186,12 +188,19 @@ void SinkImpl::UpdatePropertyValue(int property, bool setString, int value,
     prop->SetValue(value);
   }
 
-  // Only notify updates after we've notified created
-  if (m_properties_cached) {
-    m_notifier.NotifySinkProperty(*this, CS_SINK_PROPERTY_VALUE_UPDATED,
-                                  prop->name, property, prop->propKind,
-                                  prop->value, prop->valueStr);
-  }
+  PropertyValueUpdated(property, *prop);
+}
+
+void SinkImpl::NotifyPropertyValueUpdated(int property, PropertyImpl& prop) {
+  m_notifier.NotifySinkProperty(*this, CS_SINK_PROPERTY_VALUE_UPDATED,
+                                prop.name, property, prop.propKind, prop.value,
+                                prop.valueStr);
 }
 
 void SinkImpl::SetSourceImpl(std::shared_ptr<SourceImpl> source) {}
+
+void SinkImpl::RecordFrameLatency(uint64_t frameTime) {
+  uint64_t now = wpi::Now();
+  m_telemetry.RecordSinkLatency(*this, CS_SINK_FRAME_LATENCY_P50,
+                                now > frameTime ? now - frameTime : 0);
+}
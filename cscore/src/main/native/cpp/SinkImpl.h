@@ -61,9 +61,13 @@ class SinkImpl : public PropertyContainer {
   void NotifyPropertyCreated(int propIndex, PropertyImpl& prop) override;
   void UpdatePropertyValue(int property, bool setString, int value,
                            std::string_view valueStr) override;
+  void NotifyPropertyValueUpdated(int property, PropertyImpl& prop) override;
 
   virtual void SetSourceImpl(std::shared_ptr<SourceImpl> source);
 
+  // Records the time from a frame's capture to now for telemetry
+  void RecordFrameLatency(uint64_t frameTime);
+
  protected:
   wpi::Logger& m_logger;
   Notifier& m_notifier;
@@ -7,10 +7,13 @@
 #include <algorithm>
 #include <cstring>
 #include <memory>
+#include <utility>
 
 #include <wpi/StringExtras.h>
 #include <wpi/json.h>
+#include <wpi/lock_stats.h>
 #include <wpi/timestamp.h>
+#include <wpi/trace.h>
 
 #include "Log.h"
 #include "Notifier.h"
@@ -19,6 +22,37 @@
 using namespace cs;
 
 static constexpr size_t kMaxImagesAvail = 32;
+static constexpr size_t kMaxImagesPerPool = 8;
+
+// Image pool size classes are four steps per power of two (so at most 25%
+// of a buffer is wasted), starting at 4 KiB.
+static constexpr size_t kMinSizeClass = 4096;
+
+// Returns the smallest size class that holds size bytes.
+static size_t SizeClass(size_t size) {
+  if (size <= kMinSizeClass) {
+    return kMinSizeClass;
+  }
+  size_t base = kMinSizeClass;
+  while (base * 2 < size) {
+    base *= 2;
+  }
+  size_t step = base / 4;
+  return (size + step - 1) / step * step;
+}
+
+// Returns the largest size class that fits in capacity bytes, or 0 if none.
+static size_t SizeClassFloor(size_t capacity) {
+  if (capacity < kMinSizeClass) {
+    return 0;
+  }
+  size_t base = kMinSizeClass;
+  while (base * 2 <= capacity) {
+    base *= 2;
+  }
+  size_t step = base / 4;
+  return capacity / step * step;
+}
 
 SourceImpl::SourceImpl(std::string_view name, wpi::Logger& logger,
                        Notifier& notifier, Telemetry& telemetry)
@@ -27,6 +61,7 @@ SourceImpl::SourceImpl(std::string_view name, wpi::Logger& logger,
       m_telemetry(telemetry),
       m_name{name} {
   m_frame = Frame{*this, std::string_view{}, 0};
+  wpi::SetLockName(m_poolMutex, "cscore frame pool");
 }
 
 SourceImpl::~SourceImpl() {
@@ -402,30 +437,53 @@ std::vector<VideoMode> SourceImpl::EnumerateVideoModes(
   return m_videoModes;
 }
 
+SourceImpl::ImagePool* SourceImpl::FindImagePool(
+    VideoMode::PixelFormat pixelFormat, size_t capacity) {
+  for (auto&& pool : m_imagePools) {
+    if (pool.pixelFormat == pixelFormat && pool.capacity == capacity) {
+      return &pool;
+    }
+  }
+  return nullptr;
+}
+
+SourceImpl::ImagePool& SourceImpl::GetImagePool(
+    VideoMode::PixelFormat pixelFormat, size_t capacity) {
+  if (auto pool = FindImagePool(pixelFormat, capacity)) {
+    return *pool;
+  }
+  auto& pool = m_imagePools.emplace_back();
+  pool.pixelFormat = pixelFormat;
+  pool.capacity = capacity;
+  return pool;
+}
+
 std::unique_ptr<Image> SourceImpl::AllocImage(
     VideoMode::PixelFormat pixelFormat, int width, int height, size_t size) {
   std::unique_ptr<Image> image;
   {
     std::scoped_lock lock{m_poolMutex};
-    // find the smallest existing frame that is at least big enough.
-    int found = -1;
-    for (size_t i = 0; i < m_imagesAvail.size(); ++i) {
-      // is it big enough?
-      if (m_imagesAvail[i] && m_imagesAvail[i]->capacity() >= size) {
-        // is it smaller than the last found?
-        if (found < 0 ||
-            m_imagesAvail[i]->capacity() < m_imagesAvail[found]->capacity()) {
-          // yes, update
-          found = i;
-        }
+    // Use an image of this size class, or failing that the next larger one
+    size_t capacity = SizeClass(size);
+    ImagePool* pool = &GetImagePool(pixelFormat, capacity);
+    if (pool->avail.empty()) {
+      auto larger = FindImagePool(pixelFormat, SizeClass(capacity + 1));
+      if (larger && !larger->avail.empty()) {
+        pool = larger;
       }
     }
 
-    // if nothing found, allocate a new buffer
-    if (found < 0) {
-      image = std::make_unique<Image>(size);
+    if (pool->avail.empty()) {
+      ++m_poolMisses;
+      image = std::make_unique<Image>(capacity);
     } else {
-      image = std::move(m_imagesAvail[found]);
+      ++m_poolHits;
+      image = std::move(pool->avail.back());
+      pool->avail.pop_back();
+      --m_numImagesAvail;
+    }
+    if (++pool->inUse > pool->highWater) {
+      pool->highWater = pool->inUse;
     }
   }
 
@@ -434,10 +492,47 @@ std::unique_ptr<Image> SourceImpl::AllocImage(
   image->pixelFormat = pixelFormat;
   image->width = width;
   image->height = height;
+  image->jpegNeedsDHT = -1;
 
   return image;
 }
 
+void SourceImpl::ReserveImages(VideoMode::PixelFormat pixelFormat, int width,
+                               int height, int count) {
+  size_t size = static_cast<size_t>(width) * height;
+  switch (pixelFormat) {
+    case VideoMode::kYUYV:
+    case VideoMode::kRGB565:
+      size *= 2;
+      break;
+    case VideoMode::kBGR:
+      size *= 3;
+      break;
+    case VideoMode::kGray:
+      break;
+    default:
+      return;
+  }
+  if (size == 0) {
+    return;
+  }
+
+  size_t capacity = SizeClass(size);
+  std::scoped_lock lock{m_poolMutex};
+  if (m_destroyFrames) {
+    return;
+  }
+  auto& pool = GetImagePool(pixelFormat, capacity);
+  if (pool.highWater < count) {
+    pool.highWater = count;
+  }
+  while (pool.avail.size() < static_cast<size_t>(count) &&
+         m_numImagesAvail < kMaxImagesAvail) {
+    pool.avail.emplace_back(std::make_unique<Image>(capacity));
+    ++m_numImagesAvail;
+  }
+}
+
 void SourceImpl::PutFrame(VideoMode::PixelFormat pixelFormat, int width,
                           int height, std::string_view data, Frame::Time time) {
   auto image = AllocImage(pixelFormat, width, height, data.size());
@@ -450,10 +545,31 @@ void SourceImpl::PutFrame(VideoMode::PixelFormat pixelFormat, int width,
   PutFrame(std::move(image), time);
 }
 
+void SourceImpl::RecordConversion(VideoMode::PixelFormat fromPixelFormat,
+                                  VideoMode::PixelFormat toPixelFormat,
+                                  uint64_t time) {
+  m_telemetry.RecordSourceConversion(*this, fromPixelFormat, toPixelFormat,
+                                     time);
+}
+
 void SourceImpl::PutFrame(std::unique_ptr<Image> image, Frame::Time time) {
+  WPI_TRACE_SCOPE("cscore.source.putFrame");
   // Update telemetry
+  uint64_t now = wpi::Now();
+  m_telemetry.RecordSourceLatency(*this, CS_SOURCE_CAPTURE_LATENCY_P50,
+                                  now > time ? now - time : 0);
   m_telemetry.RecordSourceFrames(*this, 1);
   m_telemetry.RecordSourceBytes(*this, static_cast<int>(image->size()));
+  int poolHits;
+  int poolMisses;
+  {
+    std::scoped_lock lock{m_poolMutex};
+    poolHits = std::exchange(m_poolHits, 0);
+    poolMisses = std::exchange(m_poolMisses, 0);
+  }
+  if (poolHits != 0 || poolMisses != 0) {
+    m_telemetry.RecordSourcePoolUse(*this, poolHits, poolMisses);
+  }
 
   // Update frame
   {
@@ -501,37 +617,40 @@ void SourceImpl::UpdatePropertyValue(int property, bool setString, int value,
     prop->SetValue(value);
   }
 
-  // Only notify updates after we've notified created
-  if (m_properties_cached) {
-    m_notifier.NotifySourceProperty(*this, CS_SOURCE_PROPERTY_VALUE_UPDATED,
-                                    prop->name, property, prop->propKind,
-                                    prop->value, prop->valueStr);
-  }
+  PropertyValueUpdated(property, *prop);
+}
+
+void SourceImpl::NotifyPropertyValueUpdated(int property, PropertyImpl& prop) {
+  m_notifier.NotifySourceProperty(*this, CS_SOURCE_PROPERTY_VALUE_UPDATED,
+                                  prop.name, property, prop.propKind,
+                                  prop.value, prop.valueStr);
 }
 
 void SourceImpl::ReleaseImage(std::unique_ptr<Image> image) {
+  // Wrapped images aren't reusable; destroying them gives the memory back
+  if (image->IsExternal()) {
+    return;
+  }
   std::scoped_lock lock{m_poolMutex};
   if (m_destroyFrames) {
     return;
   }
-  // Return the frame to the pool.  First try to find an empty slot, otherwise
-  // add it to the end.
-  auto it = std::find(m_imagesAvail.begin(), m_imagesAvail.end(), nullptr);
-  if (it != m_imagesAvail.end()) {
-    *it = std::move(image);
-  } else if (m_imagesAvail.size() > kMaxImagesAvail) {
-    // Replace smallest buffer; don't need to check for null because the above
-    // find would have found it.
-    auto it2 = std::min_element(
-        m_imagesAvail.begin(), m_imagesAvail.end(),
-        [](const std::unique_ptr<Image>& a, const std::unique_ptr<Image>& b) {
-          return a->capacity() < b->capacity();
-        });
-    if ((*it2)->capacity() < image->capacity()) {
-      *it2 = std::move(image);
-    }
-  } else {
-    m_imagesAvail.emplace_back(std::move(image));
+  // The largest class the image can serve is usually the one it was
+  // allocated for (images grown by a conversion move up to a larger one)
+  size_t capacity = SizeClassFloor(image->capacity());
+  if (capacity == 0) {
+    return;
+  }
+  auto& pool = GetImagePool(image->pixelFormat, capacity);
+  if (pool.inUse > 0) {
+    --pool.inUse;
+  }
+  // Keep only as many as have been needed at once; free the rest
+  if (pool.avail.size() < static_cast<size_t>(pool.highWater) &&
+      pool.avail.size() < kMaxImagesPerPool &&
+      m_numImagesAvail < kMaxImagesAvail) {
+    pool.avail.emplace_back(std::move(image));
+    ++m_numImagesAvail;
   }
 }
 
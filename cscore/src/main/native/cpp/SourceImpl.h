@@ -19,6 +19,7 @@
 #include "Frame.h"
 #include "Handle.h"
 #include "Image.h"
+#include "JpegCodec.h"
 #include "PropertyContainer.h"
 #include "cscore_cpp.h"
 
@@ -56,6 +57,10 @@ class SourceImpl : public PropertyContainer {
            (m_strategy == CS_CONNECTION_AUTO_MANAGE && m_numSinksEnabled > 0);
   }
 
+  // JPEG backend used when converting this source's frames to or from MJPEG
+  void SetJpegCodec(JpegCodec* codec) { m_jpegCodec = codec; }
+  JpegCodec* GetJpegCodec() const { return m_jpegCodec; }
+
   // User-visible connection status
   void SetConnected(bool connected);
   bool IsConnected() const { return m_connected; }
@@ -136,16 +141,31 @@ class SourceImpl : public PropertyContainer {
   std::unique_ptr<Image> AllocImage(VideoMode::PixelFormat pixelFormat,
                                     int width, int height, size_t size);
 
+  // Preallocates images for frames of the given format and resolution, so
+  // the first frames after a mode change don't each allocate.  Only
+  // uncompressed formats have a known size; MJPEG hints are ignored.
+  void ReserveImages(VideoMode::PixelFormat pixelFormat, int width, int height,
+                     int count);
+
+  // Records a conversion of one of this source's images (a resize if the
+  // formats are the same) taking the given time in microseconds
+  void RecordConversion(VideoMode::PixelFormat fromPixelFormat,
+                        VideoMode::PixelFormat toPixelFormat, uint64_t time);
+
  protected:
   void NotifyPropertyCreated(int propIndex, PropertyImpl& prop) override;
   void UpdatePropertyValue(int property, bool setString, int value,
                            std::string_view valueStr) override;
+  void NotifyPropertyValueUpdated(int property, PropertyImpl& prop) override;
 
   void PutFrame(VideoMode::PixelFormat pixelFormat, int width, int height,
                 std::string_view data, Frame::Time time);
   void PutFrame(std::unique_ptr<Image> image, Frame::Time time);
   void PutError(std::string_view msg, Frame::Time time);
 
+  // Returns an image from AllocImage() that won't be put to the pool
+  void ReleaseImage(std::unique_ptr<Image> image);
+
   // Notification functions for corresponding atomics
   virtual void NumSinksChanged() = 0;
   virtual void NumSinksEnabledChanged() = 0;
@@ -163,7 +183,6 @@ class SourceImpl : public PropertyContainer {
   Telemetry& m_telemetry;
 
  private:
-  void ReleaseImage(std::unique_ptr<Image> image);
   std::unique_ptr<Frame::Impl> AllocFrameImpl();
   void ReleaseFrameImpl(std::unique_ptr<Frame::Impl> data);
 
@@ -172,16 +191,37 @@ class SourceImpl : public PropertyContainer {
 
   std::atomic_int m_strategy{CS_CONNECTION_AUTO_MANAGE};
   std::atomic_int m_numSinksEnabled{0};
+  std::atomic<JpegCodec*> m_jpegCodec{cs::GetJpegCodec({})};
 
   wpi::mutex m_frameMutex;
   wpi::condition_variable m_frameCv;
 
   bool m_destroyFrames{false};
 
+  // Pool of images of one pixel format and size class.  Keeping formats and
+  // sizes apart stops one conversion size from taking (and so forcing
+  // reallocation of) the buffers another one needs.
+  struct ImagePool {
+    VideoMode::PixelFormat pixelFormat;
+    size_t capacity;  // size class
+    int inUse = 0;
+    int highWater = 0;  // most in use at once; no more than this are kept
+    std::vector<std::unique_ptr<Image>> avail;
+  };
+  // These must be called with m_poolMutex held.  Creating a pool
+  // invalidates pointers to the others.
+  ImagePool* FindImagePool(VideoMode::PixelFormat pixelFormat,
+                           size_t capacity);
+  ImagePool& GetImagePool(VideoMode::PixelFormat pixelFormat, size_t capacity);
+
   // Pool of frames/images to reduce malloc traffic.
   wpi::mutex m_poolMutex;
   std::vector<std::unique_ptr<Frame::Impl>> m_framesAvail;
-  std::vector<std::unique_ptr<Image>> m_imagesAvail;
+  std::vector<ImagePool> m_imagePools;
+  size_t m_numImagesAvail = 0;
+  // counts since the last frame, for telemetry
+  int m_poolHits = 0;
+  int m_poolMisses = 0;
 
   std::atomic_bool m_connected{false};
 
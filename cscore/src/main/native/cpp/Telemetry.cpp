@@ -4,20 +4,85 @@
 
 #include "Telemetry.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <limits>
 
 #include <wpi/DenseMap.h>
+#include <wpi/MathExtras.h>
 #include <wpi/timestamp.h>
 
 #include "Handle.h"
 #include "Instance.h"
 #include "Notifier.h"
+#include "SinkImpl.h"
 #include "SourceImpl.h"
 #include "cscore_cpp.h"
 
 using namespace cs;
 
+namespace {
+
+// Latency histogram with logarithmic buckets, 4 per power of two, so
+// percentiles are within about 19% of the true value.  Fixed size, so
+// recording never allocates.
+class LatencyHistogram {
+ public:
+  void Add(uint64_t value) {
+    ++m_counts[Bucket(value)];
+    ++m_total;
+    m_max = (std::max)(m_max, value);
+  }
+
+  // Returns the upper bound of the bucket containing the given fraction of
+  // the samples (but never more than the largest sample).
+  uint64_t Percentile(double fraction) const {
+    uint64_t rank = static_cast<uint64_t>(fraction * m_total);
+    uint64_t seen = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+      seen += m_counts[i];
+      if (seen > rank) {
+        return (std::min)(UpperBound(i), m_max);
+      }
+    }
+    return m_max;
+  }
+
+ private:
+  static constexpr int kNumBuckets = 4 * 40;
+
+  // Buckets 0-3 hold 0-3; after that, bucket 4*n+s holds values whose top
+  // bit is n and next two bits are s
+  static int Bucket(uint64_t value) {
+    if (value < 4) {
+      return static_cast<int>(value);
+    }
+    int n = wpi::Log2_64(value);
+    int bucket = 4 * (n - 1) + static_cast<int>((value >> (n - 2)) & 3);
+    return (std::min)(bucket, kNumBuckets - 1);
+  }
+
+  static uint64_t UpperBound(int bucket) {
+    if (bucket < 4) {
+      return bucket;
+    }
+    int n = bucket / 4 + 1;
+    uint64_t s = bucket % 4;
+    return ((4 + s + 1) << (n - 2)) - 1;
+  }
+
+  std::array<uint32_t, kNumBuckets> m_counts{};
+  uint64_t m_total = 0;
+  uint64_t m_max = 0;
+};
+
+int ConversionKey(int fromPixelFormat, int toPixelFormat) {
+  return (fromPixelFormat << 16) | toPixelFormat;
+}
+
+}  // namespace
+
 class Telemetry::Thread : public wpi::SafeThread {
  public:
   explicit Thread(Notifier& notifier) : m_notifier(notifier) {}
@@ -27,6 +92,11 @@ class Telemetry::Thread : public wpi::SafeThread {
   Notifier& m_notifier;
   wpi::DenseMap<std::pair<CS_Handle, int>, int64_t> m_user;
   wpi::DenseMap<std::pair<CS_Handle, int>, int64_t> m_current;
+  // Keyed by the _P50 kind; percentiles are moved to m_user each period
+  wpi::DenseMap<std::pair<CS_Handle, int>, LatencyHistogram> m_latencies;
+  // Keyed by ConversionKey()
+  wpi::DenseMap<std::pair<CS_Handle, int>, int64_t> m_userConversions;
+  wpi::DenseMap<std::pair<CS_Handle, int>, int64_t> m_currentConversions;
   double m_period = 0.0;
   double m_elapsed = 0.0;
   bool m_updated = false;
@@ -78,6 +148,15 @@ void Telemetry::Thread::Main() {
     // move to user and clear current, as we don't keep around old values
     m_user = std::move(m_current);
     m_current.clear();
+    for (auto&& latency : m_latencies) {
+      auto [handle, kind] = latency.getFirst();
+      auto& histogram = latency.getSecond();
+      m_user[std::make_pair(handle, kind)] = histogram.Percentile(0.5);
+      m_user[std::make_pair(handle, kind + 1)] = histogram.Percentile(0.99);
+    }
+    m_latencies.clear();
+    m_userConversions = std::move(m_currentConversions);
+    m_currentConversions.clear();
     auto curTime = std::chrono::steady_clock::now();
     m_elapsed = std::chrono::duration<double>(curTime - prevTime).count();
     prevTime = curTime;
@@ -131,6 +210,24 @@ double Telemetry::GetAverageValue(CS_Handle handle, CS_TelemetryKind kind,
   return thr->GetValue(handle, kind, status) / thr->m_elapsed;
 }
 
+std::vector<CS_ConversionCount> Telemetry::GetConversionCounts(
+    CS_Source source, CS_Status* status) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    *status = CS_TELEMETRY_NOT_ENABLED;
+    return {};
+  }
+  std::vector<CS_ConversionCount> counts;
+  for (auto&& conversion : thr->m_userConversions) {
+    auto [handle, key] = conversion.getFirst();
+    if (handle == source) {
+      counts.push_back(CS_ConversionCount{key >> 16, key & 0xffff,
+                                          conversion.getSecond()});
+    }
+  }
+  return counts;
+}
+
 void Telemetry::RecordSourceBytes(const SourceImpl& source, int quantity) {
   auto thr = m_owner.GetThread();
   if (!thr) {
@@ -152,3 +249,72 @@ void Telemetry::RecordSourceFrames(const SourceImpl& source, int quantity) {
                                 static_cast<int>(CS_SOURCE_FRAMES_RECEIVED))] +=
       quantity;
 }
+
+void Telemetry::RecordSourcePoolUse(const SourceImpl& source, int hits,
+                                    int misses) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    return;
+  }
+  auto handleData = Instance::GetInstance().FindSource(source);
+  Handle handle{handleData.first, Handle::kSource};
+  thr->m_current[std::make_pair(handle,
+                                static_cast<int>(CS_SOURCE_POOL_HITS))] += hits;
+  thr->m_current[std::make_pair(
+      handle, static_cast<int>(CS_SOURCE_POOL_MISSES))] += misses;
+}
+
+void Telemetry::RecordSourceLatency(const SourceImpl& source,
+                                    CS_TelemetryKind kind, uint64_t time) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    return;
+  }
+  auto handleData = Instance::GetInstance().FindSource(source);
+  thr->m_latencies[std::make_pair(Handle{handleData.first, Handle::kSource},
+                                  static_cast<int>(kind))]
+      .Add(time);
+}
+
+void Telemetry::RecordSourceConversion(const SourceImpl& source,
+                                       int fromPixelFormat, int toPixelFormat,
+                                       uint64_t time) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    return;
+  }
+  auto handleData = Instance::GetInstance().FindSource(source);
+  Handle handle{handleData.first, Handle::kSource};
+  CS_TelemetryKind kind = toPixelFormat == VideoMode::kMJPEG &&
+                                  fromPixelFormat != VideoMode::kMJPEG
+                              ? CS_SOURCE_ENCODE_LATENCY_P50
+                              : CS_SOURCE_CONVERT_LATENCY_P50;
+  thr->m_latencies[std::make_pair(handle, static_cast<int>(kind))].Add(time);
+  thr->m_current[std::make_pair(
+      handle, static_cast<int>(CS_SOURCE_CONVERSIONS))] += 1;
+  thr->m_currentConversions[std::make_pair(
+      handle, ConversionKey(fromPixelFormat, toPixelFormat))] += 1;
+}
+
+void Telemetry::RecordSinkLatency(const SinkImpl& sink, CS_TelemetryKind kind,
+                                  uint64_t time) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    return;
+  }
+  auto handleData = Instance::GetInstance().FindSink(sink);
+  thr->m_latencies[std::make_pair(Handle{handleData.first, Handle::kSink},
+                                  static_cast<int>(kind))]
+      .Add(time);
+}
+
+void Telemetry::RecordSinkFramesDropped(const SinkImpl& sink, int quantity) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    return;
+  }
+  auto handleData = Instance::GetInstance().FindSink(sink);
+  thr->m_current[std::make_pair(Handle{handleData.first, Handle::kSink},
+                                static_cast<int>(CS_SINK_FRAMES_DROPPED))] +=
+      quantity;
+}
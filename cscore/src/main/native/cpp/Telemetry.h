@@ -5,6 +5,10 @@
 #ifndef CSCORE_TELEMETRY_H_
 #define CSCORE_TELEMETRY_H_
 
+#include <stdint.h>
+
+#include <vector>
+
 #include <wpi/SafeThread.h>
 
 #include "cscore_cpp.h"
@@ -12,6 +16,7 @@
 namespace cs {
 
 class Notifier;
+class SinkImpl;
 class SourceImpl;
 
 class Telemetry {
@@ -30,10 +35,21 @@ class Telemetry {
   int64_t GetValue(CS_Handle handle, CS_TelemetryKind kind, CS_Status* status);
   double GetAverageValue(CS_Handle handle, CS_TelemetryKind kind,
                          CS_Status* status);
+  std::vector<CS_ConversionCount> GetConversionCounts(CS_Source source,
+                                                      CS_Status* status);
 
   // Telemetry events
   void RecordSourceBytes(const SourceImpl& source, int quantity);
   void RecordSourceFrames(const SourceImpl& source, int quantity);
+  void RecordSourcePoolUse(const SourceImpl& source, int hits, int misses);
+  // kind is the _P50 kind of the stage; time is in microseconds
+  void RecordSourceLatency(const SourceImpl& source, CS_TelemetryKind kind,
+                           uint64_t time);
+  void RecordSourceConversion(const SourceImpl& source, int fromPixelFormat,
+                              int toPixelFormat, uint64_t time);
+  void RecordSinkLatency(const SinkImpl& sink, CS_TelemetryKind kind,
+                         uint64_t time);
+  void RecordSinkFramesDropped(const SinkImpl& sink, int quantity);
 
  private:
   Notifier& m_notifier;
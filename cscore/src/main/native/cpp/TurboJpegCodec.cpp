@@ -0,0 +1,102 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifdef CSCORE_HAVE_TURBOJPEG
+
+#include <turbojpeg.h>
+
+#include "Image.h"
+#include "JpegCodec.h"
+
+using namespace cs;
+
+namespace {
+
+class TurboJpegCodec : public JpegCodec {
+ public:
+  std::string_view GetName() const override { return "turbojpeg"; }
+  bool Decode(Image& src, Image& dst) override;
+  bool Encode(Image& src, int quality, Image& dst) override;
+};
+
+// TurboJPEG handles can't be shared between threads, so each converting
+// thread gets its own (created on first use).
+struct Handles {
+  ~Handles() {
+    if (decompress) {
+      tjDestroy(decompress);
+    }
+    if (compress) {
+      tjDestroy(compress);
+    }
+  }
+
+  tjhandle decompress = nullptr;
+  tjhandle compress = nullptr;
+};
+
+thread_local Handles gHandles;
+
+}  // namespace
+
+bool TurboJpegCodec::Decode(Image& src, Image& dst) {
+  if (!gHandles.decompress) {
+    gHandles.decompress = tjInitDecompress();
+    if (!gHandles.decompress) {
+      return false;
+    }
+  }
+  tjhandle handle = gHandles.decompress;
+  auto buf = reinterpret_cast<unsigned char*>(src.data());
+  int width, height, subsamp, colorspace;
+  if (tjDecompressHeader3(handle, buf, src.size(), &width, &height, &subsamp,
+                          &colorspace) != 0) {
+    return false;
+  }
+  // TurboJPEG picks the DCT scaling factor from the requested size
+  if (GetJpegScale(width, height, dst.width, dst.height) == 0) {
+    return false;
+  }
+  int pixelFormat = dst.pixelFormat == VideoMode::kGray ? TJPF_GRAY : TJPF_BGR;
+  if (tjDecompress2(handle, buf, src.size(),
+                    reinterpret_cast<unsigned char*>(dst.data()), dst.width,
+                    0, dst.height, pixelFormat, TJFLAG_FASTDCT) != 0) {
+    // camera streams often have minor corruption; only fail on errors
+    return tjGetErrorCode(handle) == TJERR_WARNING;
+  }
+  return true;
+}
+
+bool TurboJpegCodec::Encode(Image& src, int quality, Image& dst) {
+  if (!gHandles.compress) {
+    gHandles.compress = tjInitCompress();
+    if (!gHandles.compress) {
+      return false;
+    }
+  }
+  bool gray = src.pixelFormat == VideoMode::kGray;
+  // same subsampling as OpenCV
+  int subsamp = gray ? TJSAMP_GRAY : TJSAMP_420;
+
+  // compress directly into the image, sized for the worst case
+  auto& vec = dst.vec();
+  vec.resize(tjBufSize(src.width, src.height, subsamp));
+  unsigned char* out = vec.data();
+  unsigned long size = vec.size();  // NOLINT(runtime/int)
+  if (tjCompress2(gHandles.compress,
+                  reinterpret_cast<unsigned char*>(src.data()), src.width, 0,
+                  src.height, gray ? TJPF_GRAY : TJPF_BGR, &out, &size,
+                  subsamp, quality, TJFLAG_NOREALLOC | TJFLAG_FASTDCT) != 0) {
+    return false;
+  }
+  vec.resize(size);
+  return true;
+}
+
+JpegCodec& cs::GetTurboJpegCodec() {
+  static TurboJpegCodec codec;
+  return codec;
+}
+
+#endif  // CSCORE_HAVE_TURBOJPEG
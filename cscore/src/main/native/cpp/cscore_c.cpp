@@ -145,6 +145,11 @@ void CS_SetSourceConnectionStrategy(CS_Source source,
   cs::SetSourceConnectionStrategy(source, strategy, status);
 }
 
+CS_Bool CS_SetSourceJpegCodec(CS_Source source, const char* name,
+                              CS_Status* status) {
+  return cs::SetSourceJpegCodec(source, name, status);
+}
+
 CS_Bool CS_IsSourceConnected(CS_Source source, CS_Status* status) {
   return cs::IsSourceConnected(source, status);
 }
@@ -436,6 +441,21 @@ double CS_GetTelemetryAverageValue(CS_Handle handle, CS_TelemetryKind kind,
   return cs::GetTelemetryAverageValue(handle, kind, status);
 }
 
+CS_ConversionCount* CS_GetTelemetryConversionCounts(CS_Source source,
+                                                    int* count,
+                                                    CS_Status* status) {
+  auto vec = cs::GetTelemetryConversionCounts(source, status);
+  CS_ConversionCount* out = static_cast<CS_ConversionCount*>(
+      wpi::safe_malloc(vec.size() * sizeof(CS_ConversionCount)));
+  *count = vec.size();
+  std::copy(vec.begin(), vec.end(), out);
+  return out;
+}
+
+void CS_FreeTelemetryConversionCounts(CS_ConversionCount* counts, int count) {
+  std::free(counts);
+}
+
 void CS_SetLogger(CS_LogFunc func, unsigned int min_level) {
   cs::SetLogger(func, min_level);
 }
@@ -10,6 +10,7 @@
 
 #include "Handle.h"
 #include "Instance.h"
+#include "JpegCodec.h"
 #include "Log.h"
 #include "NetworkListener.h"
 #include "Notifier.h"
@@ -253,6 +254,21 @@ void SetSourceConnectionStrategy(CS_Source source,
   data->source->SetConnectionStrategy(strategy);
 }
 
+bool SetSourceJpegCodec(CS_Source source, std::string_view name,
+                        CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data) {
+    *status = CS_INVALID_HANDLE;
+    return false;
+  }
+  auto codec = GetJpegCodec(name);
+  if (!codec) {
+    return false;
+  }
+  data->source->SetJpegCodec(codec);
+  return true;
+}
+
 bool IsSourceConnected(CS_Source source, CS_Status* status) {
   auto data = Instance::GetInstance().GetSource(source);
   if (!data) {
@@ -835,6 +851,11 @@ double GetTelemetryAverageValue(CS_Handle handle, CS_TelemetryKind kind,
                                                            status);
 }
 
+std::vector<CS_ConversionCount> GetTelemetryConversionCounts(
+    CS_Source source, CS_Status* status) {
+  return Instance::GetInstance().telemetry.GetConversionCounts(source, status);
+}
+
 //
 // Logging Functions
 //
@@ -875,4 +896,8 @@ std::string GetHostname() {
   return wpi::GetHostname();
 }
 
+std::vector<std::string> GetJpegCodecs() {
+  return GetJpegCodecNames();
+}
+
 }  // namespace cs
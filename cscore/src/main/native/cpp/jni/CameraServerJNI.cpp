@@ -3,6 +3,7 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <exception>
+#include <memory>
 
 #include <fmt/format.h>
 #include <opencv2/core/core.hpp>
@@ -31,6 +32,7 @@ static JClass usbCameraInfoCls;
 static JClass videoModeCls;
 static JClass videoEventCls;
 static JClass rawFrameCls;
+static JClass sharedRawFrameCls;
 static JException videoEx;
 static JException interruptedEx;
 static JException nullPointerEx;
@@ -43,7 +45,8 @@ static const JClassInit classes[] = {
     {"edu/wpi/first/cscore/UsbCameraInfo", &usbCameraInfoCls},
     {"edu/wpi/first/cscore/VideoMode", &videoModeCls},
     {"edu/wpi/first/cscore/VideoEvent", &videoEventCls},
-    {"edu/wpi/first/cscore/raw/RawFrame", &rawFrameCls}};
+    {"edu/wpi/first/cscore/raw/RawFrame", &rawFrameCls},
+    {"edu/wpi/first/cscore/raw/SharedRawFrame", &sharedRawFrameCls}};
 
 static const JExceptionInit exceptions[] = {
     {"edu/wpi/first/cscore/VideoException", &videoEx},
@@ -640,6 +643,30 @@ Java_edu_wpi_first_cscore_CameraServerJNI_createRawSource
   return val;
 }
 
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    createSharedMemorySource
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_createSharedMemorySource
+  (JNIEnv* env, jclass, jstring name, jstring shmName)
+{
+  if (!name) {
+    nullPointerEx.Throw(env, "name cannot be null");
+    return 0;
+  }
+  if (!shmName) {
+    nullPointerEx.Throw(env, "shmName cannot be null");
+    return 0;
+  }
+  CS_Status status = 0;
+  auto val = cs::CreateSharedMemorySource(
+      JStringRef{env, name}.str(), JStringRef{env, shmName}.str(), &status);
+  CheckStatus(env, status);
+  return val;
+}
+
 /*
  * Class:     edu_wpi_first_cscore_CameraServerJNI
  * Method:    getSourceKind
@@ -1265,6 +1292,70 @@ Java_edu_wpi_first_cscore_CameraServerJNI_putRawSourceFrame
   CheckStatus(env, status);
 }
 
+// Hands the image memory to Java without copying it; the SharedRawFrame holds
+// a heap-allocated reference that keeps the memory alive until it is released
+static void SetSharedRawFrameData(JNIEnv* env, jobject frameObj,
+                                  std::shared_ptr<void> frameRef,
+                                  const CS_RawFrame& frame) {
+  static jmethodID setMethod = env->GetMethodID(
+      sharedRawFrameCls, "setData", "(Ljava/nio/ByteBuffer;JJIIII)V");
+  JLocal<jobject> byteBuffer{
+      env, env->NewDirectByteBuffer(frame.data, frame.totalData)};
+  auto ref = new std::shared_ptr<void>(std::move(frameRef));
+  env->CallVoidMethod(
+      frameObj, setMethod, byteBuffer.obj(),
+      static_cast<jlong>(reinterpret_cast<intptr_t>(ref)),
+      static_cast<jlong>(reinterpret_cast<intptr_t>(frame.data)),
+      static_cast<jint>(frame.totalData), static_cast<jint>(frame.width),
+      static_cast<jint>(frame.height), static_cast<jint>(frame.pixelFormat));
+}
+
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    allocRawSourceFrameImpl
+ * Signature: (ILjava/lang/Object;IIII)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_allocRawSourceFrameImpl
+  (JNIEnv* env, jclass, jint source, jobject frameObj, jint width,
+   jint height, jint pixelFormat, jint totalData)
+{
+  CS_RawFrame frame;
+  frame.data = nullptr;
+  frame.dataLength = 0;
+  frame.width = width;
+  frame.height = height;
+  frame.pixelFormat = pixelFormat;
+  frame.totalData = totalData;
+  CS_Status status = 0;
+  auto frameRef = cs::AllocSourceFrame(source, frame, &status);
+  if (!CheckStatus(env, status)) {
+    return;
+  }
+  SetSharedRawFrameData(env, frameObj, std::move(frameRef), frame);
+}
+
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    putRawSourceFrameShared
+ * Signature: (IJ)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_putRawSourceFrameShared
+  (JNIEnv* env, jclass, jint source, jlong frameRef)
+{
+  auto ref =
+      reinterpret_cast<std::shared_ptr<void>*>(static_cast<intptr_t>(frameRef));
+  if (!ref) {
+    nullPointerEx.Throw(env, "frame has no image to put");
+    return;
+  }
+  CS_Status status = 0;
+  cs::PutSourceFrameShared(source, *ref, &status);
+  delete ref;
+  CheckStatus(env, status);
+}
+
 /*
  * Class:     edu_wpi_first_cscore_CameraServerJNI
  * Method:    notifySourceError
@@ -1388,6 +1479,55 @@ Java_edu_wpi_first_cscore_CameraServerJNI_createMjpegServer
   return val;
 }
 
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    createH264Server
+ * Signature: (Ljava/lang/String;Ljava/lang/String;I)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_createH264Server
+  (JNIEnv* env, jclass, jstring name, jstring listenAddress, jint port)
+{
+  if (!name) {
+    nullPointerEx.Throw(env, "name cannot be null");
+    return 0;
+  }
+  if (!listenAddress) {
+    nullPointerEx.Throw(env, "listenAddress cannot be null");
+    return 0;
+  }
+  CS_Status status = 0;
+  auto val = cs::CreateH264Server(JStringRef{env, name}.str(),
+                                  JStringRef{env, listenAddress}.str(), port,
+                                  &status);
+  CheckStatus(env, status);
+  return val;
+}
+
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    createSharedMemorySink
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_createSharedMemorySink
+  (JNIEnv* env, jclass, jstring name, jstring shmName)
+{
+  if (!name) {
+    nullPointerEx.Throw(env, "name cannot be null");
+    return 0;
+  }
+  if (!shmName) {
+    nullPointerEx.Throw(env, "shmName cannot be null");
+    return 0;
+  }
+  CS_Status status = 0;
+  auto val = cs::CreateSharedMemorySink(
+      JStringRef{env, name}.str(), JStringRef{env, shmName}.str(), &status);
+  CheckStatus(env, status);
+  return val;
+}
+
 /*
  * Class:     edu_wpi_first_cscore_CameraServerCvJNI
  * Method:    createCvSink
@@ -1654,6 +1794,38 @@ Java_edu_wpi_first_cscore_CameraServerJNI_getMjpegServerPort
   return val;
 }
 
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    getH264ServerListenAddress
+ * Signature: (I)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_getH264ServerListenAddress
+  (JNIEnv* env, jclass, jint sink)
+{
+  CS_Status status = 0;
+  auto str = cs::GetH264ServerListenAddress(sink, &status);
+  if (!CheckStatus(env, status)) {
+    return nullptr;
+  }
+  return MakeJString(env, str);
+}
+
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    getH264ServerPort
+ * Signature: (I)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_getH264ServerPort
+  (JNIEnv* env, jclass, jint sink)
+{
+  CS_Status status = 0;
+  auto val = cs::GetH264ServerPort(sink, &status);
+  CheckStatus(env, status);
+  return val;
+}
+
 /*
  * Class:     edu_wpi_first_cscore_CameraServerJNI
  * Method:    setSinkDescription
@@ -1720,6 +1892,49 @@ Java_edu_wpi_first_cscore_CameraServerCvJNI_grabSinkFrameTimeout
   }
 }
 
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerCvJNI
+ * Method:    setCvSinkRegion
+ * Signature: (IIIII)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_cscore_CameraServerCvJNI_setCvSinkRegion
+  (JNIEnv* env, jclass, jint sink, jint x, jint y, jint width, jint height)
+{
+  CS_Status status = 0;
+  cs::SetCvSinkRegion(sink, x, y, width, height, &status);
+  CheckStatus(env, status);
+}
+
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerCvJNI
+ * Method:    setCvSinkScale
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_cscore_CameraServerCvJNI_setCvSinkScale
+  (JNIEnv* env, jclass, jint sink, jint scale)
+{
+  CS_Status status = 0;
+  cs::SetCvSinkScale(sink, scale, &status);
+  CheckStatus(env, status);
+}
+
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerCvJNI
+ * Method:    setCvSinkPixelFormat
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_cscore_CameraServerCvJNI_setCvSinkPixelFormat
+  (JNIEnv* env, jclass, jint sink, jint pixelFormat)
+{
+  CS_Status status = 0;
+  cs::SetCvSinkPixelFormat(
+      sink, static_cast<cs::VideoMode::PixelFormat>(pixelFormat), &status);
+  CheckStatus(env, status);
+}
+
 static void SetRawFrameData(JNIEnv* env, jobject rawFrameObj,
                             jobject byteBuffer, bool didChangeDataPtr,
                             const CS_RawFrame& frame) {
@@ -1789,6 +2004,47 @@ Java_edu_wpi_first_cscore_CameraServerJNI_grabRawSinkFrameTimeoutImpl
   return rv;
 }
 
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    grabRawSinkFrameSharedImpl
+ * Signature: (ILjava/lang/Object;IIID)J
+ */
+JNIEXPORT jlong JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_grabRawSinkFrameSharedImpl
+  (JNIEnv* env, jclass, jint sink, jobject frameObj, jint width, jint height,
+   jint pixelFormat, jdouble timeout)
+{
+  CS_RawFrame frame;
+  frame.data = nullptr;
+  frame.dataLength = 0;
+  frame.width = width;
+  frame.height = height;
+  frame.pixelFormat = pixelFormat;
+  frame.totalData = 0;
+  std::shared_ptr<void> frameRef;
+  CS_Status status = 0;
+  auto rv = cs::GrabSinkFrameShared(static_cast<CS_Sink>(sink), frame,
+                                    frameRef, timeout, &status);
+  if (!CheckStatus(env, status) || rv == 0) {
+    return rv;
+  }
+  SetSharedRawFrameData(env, frameObj, std::move(frameRef), frame);
+  return rv;
+}
+
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    releaseSharedRawFrame
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_releaseSharedRawFrame
+  (JNIEnv*, jclass, jlong frameRef)
+{
+  delete reinterpret_cast<std::shared_ptr<void>*>(
+      static_cast<intptr_t>(frameRef));
+}
+
 /*
  * Class:     edu_wpi_first_cscore_CameraServerJNI
  * Method:    getSinkError
@@ -126,6 +126,7 @@ enum CS_SourceKind {
   CS_SOURCE_HTTP = 2,
   CS_SOURCE_CV = 4,
   CS_SOURCE_RAW = 8,
+  CS_SOURCE_SHARED_MEMORY = 16
 };
 
 /**
@@ -145,7 +146,9 @@ enum CS_SinkKind {
   CS_SINK_UNKNOWN = 0,
   CS_SINK_MJPEG = 2,
   CS_SINK_CV = 4,
-  CS_SINK_RAW = 8
+  CS_SINK_RAW = 8,
+  CS_SINK_H264 = 16,
+  CS_SINK_SHARED_MEMORY = 32
 };
 
 /**
@@ -175,11 +178,33 @@ enum CS_EventKind {
 };
 
 /**
- * Telemetry kinds
+ * Telemetry kinds.  Latencies are percentiles over the last telemetry period,
+ * in microseconds.
  */
 enum CS_TelemetryKind {
   CS_SOURCE_BYTES_RECEIVED = 1,
-  CS_SOURCE_FRAMES_RECEIVED = 2
+  CS_SOURCE_FRAMES_RECEIVED = 2,
+  CS_SOURCE_POOL_HITS = 3,
+  CS_SOURCE_POOL_MISSES = 4,
+  /** From frame capture to the frame being available to sinks */
+  CS_SOURCE_CAPTURE_LATENCY_P50 = 5,
+  CS_SOURCE_CAPTURE_LATENCY_P99 = 6,
+  /** Pixel format conversions (including JPEG decoding) and resizes */
+  CS_SOURCE_CONVERT_LATENCY_P50 = 7,
+  CS_SOURCE_CONVERT_LATENCY_P99 = 8,
+  /** JPEG encoding */
+  CS_SOURCE_ENCODE_LATENCY_P50 = 9,
+  CS_SOURCE_ENCODE_LATENCY_P99 = 10,
+  /** Number of conversions, encodes, and resizes */
+  CS_SOURCE_CONVERSIONS = 11,
+  /** Writing a frame to a client */
+  CS_SINK_SEND_LATENCY_P50 = 12,
+  CS_SINK_SEND_LATENCY_P99 = 13,
+  /** From frame capture to the frame being sent or grabbed */
+  CS_SINK_FRAME_LATENCY_P50 = 14,
+  CS_SINK_FRAME_LATENCY_P99 = 15,
+  /** Frames not sent to a client because it was still busy */
+  CS_SINK_FRAMES_DROPPED = 16
 };
 
 /** Connection strategy */
@@ -242,6 +267,16 @@ typedef struct CS_UsbCameraInfo {
   int productId;
 } CS_UsbCameraInfo;
 
+/**
+ * Number of conversions from one pixel format to another (the same for a
+ * resize) during the last telemetry period
+ */
+typedef struct CS_ConversionCount {
+  int fromPixelFormat;
+  int toPixelFormat;
+  int64_t count;
+} CS_ConversionCount;
+
 /**
  * @defgroup cscore_property_cfunc Property Functions
  * @{
@@ -276,6 +311,8 @@ CS_Source CS_CreateHttpCameraMulti(const char* name, const char** urls,
                                    CS_Status* status);
 CS_Source CS_CreateCvSource(const char* name, const CS_VideoMode* mode,
                             CS_Status* status);
+CS_Source CS_CreateSharedMemorySource(const char* name, const char* shmName,
+                                      CS_Status* status);
 /** @} */
 
 /**
@@ -289,6 +326,8 @@ uint64_t CS_GetSourceLastFrameTime(CS_Source source, CS_Status* status);
 void CS_SetSourceConnectionStrategy(CS_Source source,
                                     enum CS_ConnectionStrategy strategy,
                                     CS_Status* status);
+CS_Bool CS_SetSourceJpegCodec(CS_Source source, const char* name,
+                              CS_Status* status);
 CS_Bool CS_IsSourceConnected(CS_Source source, CS_Status* status);
 CS_Bool CS_IsSourceEnabled(CS_Source source, CS_Status* status);
 CS_Property CS_GetSourceProperty(CS_Source source, const char* name,
@@ -380,6 +419,10 @@ void CS_SetSourceEnumPropertyChoices(CS_Source source, CS_Property property,
  */
 CS_Sink CS_CreateMjpegServer(const char* name, const char* listenAddress,
                              int port, CS_Status* status);
+CS_Sink CS_CreateH264Server(const char* name, const char* listenAddress,
+                            int port, CS_Status* status);
+CS_Sink CS_CreateSharedMemorySink(const char* name, const char* shmName,
+                                  CS_Status* status);
 CS_Sink CS_CreateCvSink(const char* name, CS_Status* status);
 CS_Sink CS_CreateCvSinkCallback(const char* name, void* data,
                                 void (*processFrame)(void* data, uint64_t time),
@@ -416,6 +459,14 @@ char* CS_GetMjpegServerListenAddress(CS_Sink sink, CS_Status* status);
 int CS_GetMjpegServerPort(CS_Sink sink, CS_Status* status);
 /** @} */
 
+/**
+ * @defgroup cscore_h264server_cfunc H264Server Sink Functions
+ * @{
+ */
+char* CS_GetH264ServerListenAddress(CS_Sink sink, CS_Status* status);
+int CS_GetH264ServerPort(CS_Sink sink, CS_Status* status);
+/** @} */
+
 /**
  * @defgroup cscore_opencv_sink_cfunc OpenCV Sink Functions
  * @{
@@ -424,6 +475,11 @@ void CS_SetSinkDescription(CS_Sink sink, const char* description,
                            CS_Status* status);
 char* CS_GetSinkError(CS_Sink sink, CS_Status* status);
 void CS_SetSinkEnabled(CS_Sink sink, CS_Bool enabled, CS_Status* status);
+void CS_SetCvSinkRegion(CS_Sink sink, int x, int y, int width, int height,
+                        CS_Status* status);
+void CS_SetCvSinkScale(CS_Sink sink, int scale, CS_Status* status);
+void CS_SetCvSinkPixelFormat(CS_Sink sink, enum CS_PixelFormat pixelFormat,
+                             CS_Status* status);
 /** @} */
 
 /**
@@ -461,6 +517,10 @@ int64_t CS_GetTelemetryValue(CS_Handle handle, enum CS_TelemetryKind kind,
                              CS_Status* status);
 double CS_GetTelemetryAverageValue(CS_Handle handle, enum CS_TelemetryKind kind,
                                    CS_Status* status);
+CS_ConversionCount* CS_GetTelemetryConversionCounts(CS_Source source,
+                                                    int* count,
+                                                    CS_Status* status);
+void CS_FreeTelemetryConversionCounts(CS_ConversionCount* counts, int count);
 /** @} */
 
 /**
@@ -207,6 +207,9 @@ CS_Source CreateHttpCamera(std::string_view name,
                            CS_HttpCameraKind kind, CS_Status* status);
 CS_Source CreateCvSource(std::string_view name, const VideoMode& mode,
                          CS_Status* status);
+CS_Source CreateSharedMemorySource(std::string_view name,
+                                   std::string_view shmName,
+                                   CS_Status* status);
 /** @} */
 
 /**
@@ -226,6 +229,8 @@ uint64_t GetSourceLastFrameTime(CS_Source source, CS_Status* status);
 void SetSourceConnectionStrategy(CS_Source source,
                                  CS_ConnectionStrategy strategy,
                                  CS_Status* status);
+bool SetSourceJpegCodec(CS_Source source, std::string_view name,
+                        CS_Status* status);
 bool IsSourceConnected(CS_Source source, CS_Status* status);
 bool IsSourceEnabled(CS_Source source, CS_Status* status);
 CS_Property GetSourceProperty(CS_Source source, std::string_view name,
@@ -314,6 +319,10 @@ void SetSourceEnumPropertyChoices(CS_Source source, CS_Property property,
  */
 CS_Sink CreateMjpegServer(std::string_view name, std::string_view listenAddress,
                           int port, CS_Status* status);
+CS_Sink CreateH264Server(std::string_view name, std::string_view listenAddress,
+                         int port, CS_Status* status);
+CS_Sink CreateSharedMemorySink(std::string_view name, std::string_view shmName,
+                               CS_Status* status);
 CS_Sink CreateCvSink(std::string_view name, CS_Status* status);
 CS_Sink CreateCvSinkCallback(std::string_view name,
                              std::function<void(uint64_t time)> processFrame,
@@ -359,6 +368,14 @@ std::string GetMjpegServerListenAddress(CS_Sink sink, CS_Status* status);
 int GetMjpegServerPort(CS_Sink sink, CS_Status* status);
 /** @} */
 
+/**
+ * @defgroup cscore_h264server_func H264Server Sink Functions
+ * @{
+ */
+std::string GetH264ServerListenAddress(CS_Sink sink, CS_Status* status);
+int GetH264ServerPort(CS_Sink sink, CS_Status* status);
+/** @} */
+
 /**
  * @defgroup cscore_opencv_sink_func OpenCV Sink Functions
  * @{
@@ -369,6 +386,11 @@ std::string GetSinkError(CS_Sink sink, CS_Status* status);
 std::string_view GetSinkError(CS_Sink sink, wpi::SmallVectorImpl<char>& buf,
                               CS_Status* status);
 void SetSinkEnabled(CS_Sink sink, bool enabled, CS_Status* status);
+void SetCvSinkRegion(CS_Sink sink, int x, int y, int width, int height,
+                     CS_Status* status);
+void SetCvSinkScale(CS_Sink sink, int scale, CS_Status* status);
+void SetCvSinkPixelFormat(CS_Sink sink, VideoMode::PixelFormat pixelFormat,
+                          CS_Status* status);
 /** @} */
 
 /**
@@ -405,6 +427,8 @@ int64_t GetTelemetryValue(CS_Handle handle, CS_TelemetryKind kind,
                           CS_Status* status);
 double GetTelemetryAverageValue(CS_Handle handle, CS_TelemetryKind kind,
                                 CS_Status* status);
+std::vector<CS_ConversionCount> GetTelemetryConversionCounts(
+    CS_Source source, CS_Status* status);
 /** @} */
 
 /**
@@ -438,6 +462,8 @@ wpi::span<CS_Sink> EnumerateSinkHandles(wpi::SmallVectorImpl<CS_Sink>& vec,
 std::string GetHostname();
 
 std::vector<std::string> GetNetworkInterfaces();
+
+std::vector<std::string> GetJpegCodecs();
 /** @} */
 
 /** @} */
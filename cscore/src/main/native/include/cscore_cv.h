@@ -39,6 +39,8 @@ uint64_t CS_GrabSinkFrameTimeout(CS_Sink sink, struct CvMat* image,
 
 #ifdef __cplusplus
 
+#include <memory>
+
 #include "cscore_oo.h"
 
 namespace cv {
@@ -62,9 +64,19 @@ void CS_PutSourceFrameCpp(CS_Source source, cv::Mat* image, CS_Status* status);
 /** @} */
 
 void PutSourceFrame(CS_Source source, cv::Mat& image, CS_Status* status);
+std::shared_ptr<void> AllocSourceFrame(CS_Source source, cv::Mat& image,
+                                       int width, int height,
+                                       VideoMode::PixelFormat pixelFormat,
+                                       CS_Status* status);
+void PutSourceFrameShared(CS_Source source,
+                          const std::shared_ptr<void>& frameRef,
+                          CS_Status* status);
 uint64_t GrabSinkFrame(CS_Sink sink, cv::Mat& image, CS_Status* status);
 uint64_t GrabSinkFrameTimeout(CS_Sink sink, cv::Mat& image, double timeout,
                               CS_Status* status);
+uint64_t GrabSinkFrameShared(CS_Sink sink, cv::Mat& image,
+                             std::shared_ptr<void>& frameRef, double timeout,
+                             CS_Status* status);
 
 /**
  * A source for user code to provide OpenCV images as video frames.
@@ -106,6 +118,34 @@ class CvSource : public ImageSource {
    * @param image OpenCV image
    */
   void PutFrame(cv::Mat& image);
+
+  /**
+   * Get an image from the source's pool to render into in place, so it can
+   * be put without copying.  image is set to a Mat header over the pooled
+   * memory, which is owned by the returned reference; draw into it or use it
+   * as the output of OpenCV functions, but don't let them reallocate it
+   * (the output must already have the same size and type).
+   *
+   * <p>Only uncompressed pixel formats are supported.
+   *
+   * @param image OpenCV image to set to the pooled memory
+   * @param width width
+   * @param height height
+   * @param pixelFormat pixel format
+   * @return reference to pass to PutFrame(); dropping it instead returns the
+   *         image to the pool
+   */
+  std::shared_ptr<void> AllocFrame(
+      cv::Mat& image, int width, int height,
+      VideoMode::PixelFormat pixelFormat = VideoMode::kBGR);
+
+  /**
+   * Put an image obtained from AllocFrame() and notify sinks, without
+   * copying it.
+   *
+   * @param frameRef reference returned by AllocFrame()
+   */
+  void PutFrame(const std::shared_ptr<void>& frameRef);
 };
 
 /**
@@ -113,6 +153,12 @@ class CvSource : public ImageSource {
  * These sinks require the WPILib OpenCV builds.
  * For an alternate OpenCV, include "cscore_raw_cv.h" instead, and
  * include your Mat header before that header.
+ *
+ * <p>The frame times returned are capture times where the source provides
+ * them (e.g. USB cameras on Linux use the driver's buffer timestamps), so
+ * wpi::Now() minus the frame time is the frame's latency.  On the roboRIO
+ * this is the FPGA time base, suitable for pose estimator vision
+ * measurements once converted to seconds.
  */
 class CvSink : public ImageSink {
  public:
@@ -146,7 +192,9 @@ class CvSink : public ImageSink {
   /**
    * Wait for the next frame and get the image.
    * Times out (returning 0) after timeout seconds.
-   * The provided image will have three 8-bit channels stored in BGR order.
+   * The provided image will have three 8-bit channels stored in BGR order
+   * (unless configured otherwise with SetRegion(), SetScale(), and
+   * SetPixelFormat()).
    *
    * @return Frame time, or 0 on error (call GetError() to obtain the error
    *         message); the frame time is in the same time base as wpi::Now(),
@@ -157,13 +205,68 @@ class CvSink : public ImageSink {
 
   /**
    * Wait for the next frame and get the image.  May block forever.
-   * The provided image will have three 8-bit channels stored in BGR order.
+   * The provided image will have three 8-bit channels stored in BGR order
+   * (unless configured otherwise with SetRegion(), SetScale(), and
+   * SetPixelFormat()).
    *
    * @return Frame time, or 0 on error (call GetError() to obtain the error
    *         message); the frame time is in the same time base as wpi::Now(),
    *         and is in 1 us increments.
    */
   [[nodiscard]] uint64_t GrabFrameNoTimeout(cv::Mat& image) const;
+
+  /**
+   * Wait for the next frame and get the image without copying it.
+   * Times out (returning 0) after timeout seconds.
+   * The provided image will have three 8-bit channels stored in BGR order
+   * (unless configured otherwise with SetRegion(), SetScale(), and
+   * SetPixelFormat()).
+   *
+   * <p>The image is a header referring to the frame's own memory, which is
+   * shared with every other sink on the same source, so it must be treated
+   * as read-only.  It stays valid for as long as frameRef (or a copy of it)
+   * is held; hold it only as long as needed, as a held frame's memory can't
+   * be reused for new frames.
+   *
+   * @param image image header to set
+   * @param frameRef set to a reference that keeps the image alive
+   * @param timeout timeout in seconds
+   * @return Frame time, or 0 on error (call GetError() to obtain the error
+   *         message); the frame time is in the same time base as wpi::Now(),
+   *         and is in 1 us increments.
+   */
+  [[nodiscard]] uint64_t GrabFrameShared(cv::Mat& image,
+                                         std::shared_ptr<void>& frameRef,
+                                         double timeout = 0.225) const;
+
+  /**
+   * Set the region of the frame to grab, in original frame coordinates.
+   * Only the region is converted when the source image is uncompressed.
+   *
+   * @param x left edge of the region
+   * @param y top edge of the region
+   * @param width width of the region, or 0 for the whole frame
+   * @param height height of the region, or 0 for the whole frame
+   */
+  void SetRegion(int x, int y, int width, int height);
+
+  /**
+   * Set the factor to shrink grabbed images by.  JPEG sources are decoded
+   * at the reduced size where possible, which is much faster than a full
+   * decode.
+   *
+   * @param scale scale divisor (1 for full size, 2 for half size, etc.)
+   */
+  void SetScale(int scale);
+
+  /**
+   * Set the pixel format of grabbed images: kBGR (the default) for three
+   * 8-bit channels in BGR order, or kGray for a single 8-bit channel, which
+   * comes directly from the Y channel of YUYV sources.
+   *
+   * @param pixelFormat pixel format
+   */
+  void SetPixelFormat(VideoMode::PixelFormat pixelFormat);
 };
 
 inline CvSource::CvSource(std::string_view name, const VideoMode& mode) {
@@ -181,6 +284,19 @@ inline void CvSource::PutFrame(cv::Mat& image) {
   PutSourceFrame(m_handle, image, &m_status);
 }
 
+inline std::shared_ptr<void> CvSource::AllocFrame(
+    cv::Mat& image, int width, int height,
+    VideoMode::PixelFormat pixelFormat) {
+  m_status = 0;
+  return AllocSourceFrame(m_handle, image, width, height, pixelFormat,
+                          &m_status);
+}
+
+inline void CvSource::PutFrame(const std::shared_ptr<void>& frameRef) {
+  m_status = 0;
+  PutSourceFrameShared(m_handle, frameRef, &m_status);
+}
+
 inline CvSink::CvSink(std::string_view name) {
   m_handle = CreateCvSink(name, &m_status);
 }
@@ -200,6 +316,28 @@ inline uint64_t CvSink::GrabFrameNoTimeout(cv::Mat& image) const {
   return GrabSinkFrame(m_handle, image, &m_status);
 }
 
+inline uint64_t CvSink::GrabFrameShared(cv::Mat& image,
+                                        std::shared_ptr<void>& frameRef,
+                                        double timeout) const {
+  m_status = 0;
+  return GrabSinkFrameShared(m_handle, image, frameRef, timeout, &m_status);
+}
+
+inline void CvSink::SetRegion(int x, int y, int width, int height) {
+  m_status = 0;
+  SetCvSinkRegion(m_handle, x, y, width, height, &m_status);
+}
+
+inline void CvSink::SetScale(int scale) {
+  m_status = 0;
+  SetCvSinkScale(m_handle, scale, &m_status);
+}
+
+inline void CvSink::SetPixelFormat(VideoMode::PixelFormat pixelFormat) {
+  m_status = 0;
+  SetCvSinkPixelFormat(m_handle, pixelFormat, &m_status);
+}
+
 }  // namespace cs
 
 #endif
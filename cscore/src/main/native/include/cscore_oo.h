@@ -103,7 +103,8 @@ class VideoSource {
     kUnknown = CS_SOURCE_UNKNOWN,
     kUsb = CS_SOURCE_USB,
     kHttp = CS_SOURCE_HTTP,
-    kCv = CS_SOURCE_CV
+    kCv = CS_SOURCE_CV,
+    kSharedMemory = CS_SOURCE_SHARED_MEMORY
   };
 
   /** Connection strategy.  Used for SetConnectionStrategy(). */
@@ -178,6 +179,17 @@ class VideoSource {
    */
   void SetConnectionStrategy(ConnectionStrategy strategy);
 
+  /**
+   * Sets the JPEG backend used to convert this source's frames to and from
+   * MJPEG (e.g. to serve a USB camera's MJPEG stream to an OpenCV sink).
+   * GetJpegCodecs() lists the backends available in this build; OpenCV is
+   * always available and is used as a fallback if the backend fails.
+   *
+   * @param name backend name, or empty for the default (fastest) backend
+   * @return False if the backend is not available.
+   */
+  bool SetJpegCodec(std::string_view name);
+
   /**
    * Is the source currently connected to whatever is providing the images?
    */
@@ -612,6 +624,28 @@ class AxisCamera : public HttpCamera {
   AxisCamera(std::string_view name, std::initializer_list<T> hosts);
 };
 
+/**
+ * A source that receives the frames a SharedMemorySink in another process
+ * on the same machine publishes.  Frames arrive in the publisher's format
+ * and video mode, without being encoded or sent over the network.
+ *
+ * <p>Shared memory is only supported on Linux.
+ */
+class SharedMemorySource : public VideoSource {
+ public:
+  SharedMemorySource() = default;
+
+  /**
+   * Create a shared memory source.  The source connects once the publisher
+   * has started, and reconnects if the publisher restarts.
+   *
+   * @param name Source name (arbitrary unique identifier)
+   * @param shmName Name the publisher was created with (letters, digits,
+   *                '_', '-', and '.')
+   */
+  SharedMemorySource(std::string_view name, std::string_view shmName);
+};
+
 /**
  * A base class for single image providing sources.
  */
@@ -724,7 +758,9 @@ class VideoSink {
   enum Kind {
     kUnknown = CS_SINK_UNKNOWN,
     kMjpeg = CS_SINK_MJPEG,
-    kCv = CS_SINK_CV
+    kCv = CS_SINK_CV,
+    kH264 = CS_SINK_H264,
+    kSharedMemory = CS_SINK_SHARED_MEMORY
   };
 
   VideoSink() noexcept = default;
@@ -941,6 +977,110 @@ class MjpegServer : public VideoSink {
    * @param quality JPEG compression quality (0-100)
    */
   void SetDefaultCompression(int quality);
+
+  /**
+   * Set the bandwidth budget for each client that doesn't specify it.  To
+   * stay within it (and within what the client's connection can actually
+   * take), the server lowers the JPEG quality and drops frames as needed.
+   *
+   * @param kbps bandwidth in kilobits per second, 0 for unlimited
+   */
+  void SetBandwidth(int kbps);
+};
+
+/**
+ * A sink that acts as an H.264-over-HTTP network server.  The stream is a
+ * raw H.264 (Annex B) elementary stream served at /stream.h264, which
+ * players such as ffplay, VLC, and GStreamer can open directly.
+ *
+ * <p>Encoding requires a hardware encoder (a V4L2 memory-to-memory device on
+ * Linux); if none is available, an error is logged and nothing is streamed.
+ */
+class H264Server : public VideoSink {
+ public:
+  H264Server() = default;
+
+  /**
+   * Create an H.264-over-HTTP server sink.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   * @param listenAddress TCP listen address (empty string for all addresses)
+   * @param port TCP port number
+   */
+  H264Server(std::string_view name, std::string_view listenAddress, int port);
+
+  /**
+   * Create an H.264-over-HTTP server sink.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   * @param port TCP port number
+   */
+  H264Server(std::string_view name, int port) : H264Server(name, "", port) {}
+
+  /**
+   * Get the listen address of the server.
+   */
+  std::string GetListenAddress() const;
+
+  /**
+   * Get the port number of the server.
+   */
+  int GetPort() const;
+
+  /**
+   * Set the encoded resolution.
+   *
+   * @param width width, 0 for the source resolution
+   * @param height height, 0 for the source resolution
+   */
+  void SetResolution(int width, int height);
+
+  /**
+   * Set the maximum encoded frames per second (FPS).
+   *
+   * @param fps FPS, 0 for the source FPS
+   */
+  void SetFPS(int fps);
+
+  /**
+   * Set the target bitrate of the encoder.  If not set, 2000 kbit/s is used.
+   *
+   * @param kbps bitrate in kilobits per second
+   */
+  void SetBitrate(int kbps);
+
+  /**
+   * Set the interval between keyframes.  Clients can only start (or resume
+   * after falling behind) at a keyframe, but keyframes are much larger than
+   * other frames.  If not set, 30 is used.
+   *
+   * @param frames keyframe interval in frames
+   */
+  void SetKeyframeInterval(int frames);
+};
+
+/**
+ * A sink that publishes the frames of its source to other processes on the
+ * same machine through shared memory, where SharedMemorySources read them.
+ * Frames are published as captured, so any decoding or conversion happens
+ * in the readers, and they are never slowed by a slow reader.
+ *
+ * <p>Shared memory is only supported on Linux; elsewhere an error is logged
+ * and nothing is published.
+ */
+class SharedMemorySink : public VideoSink {
+ public:
+  SharedMemorySink() = default;
+
+  /**
+   * Create a shared memory sink.  Any existing publisher of the same name is
+   * replaced.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   * @param shmName Name for readers to open (letters, digits, '_', '-', and
+   *                '.')
+   */
+  SharedMemorySink(std::string_view name, std::string_view shmName);
 };
 
 /**
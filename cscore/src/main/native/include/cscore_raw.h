@@ -58,6 +58,8 @@ CS_Source CS_CreateRawSource(const char* name, const CS_VideoMode* mode,
 #endif
 
 #ifdef __cplusplus
+#include <memory>
+
 namespace cs {
 
 struct RawFrame : public CS_RawFrame {
@@ -91,6 +93,14 @@ void PutSourceFrame(CS_Source source, const CS_RawFrame& image,
 uint64_t GrabSinkFrame(CS_Sink sink, CS_RawFrame& image, CS_Status* status);
 uint64_t GrabSinkFrameTimeout(CS_Sink sink, CS_RawFrame& image, double timeout,
                               CS_Status* status);
+uint64_t GrabSinkFrameShared(CS_Sink sink, CS_RawFrame& image,
+                             std::shared_ptr<void>& frameRef, double timeout,
+                             CS_Status* status);
+std::shared_ptr<void> AllocSourceFrame(CS_Source source, CS_RawFrame& image,
+                                       CS_Status* status);
+void PutSourceFrameShared(CS_Source source,
+                          const std::shared_ptr<void>& frameRef,
+                          CS_Status* status);
 
 /**
  * A source for user code to provide video frames as raw bytes.
@@ -128,6 +138,28 @@ class RawSource : public ImageSource {
    * @param image raw frame image
    */
   void PutFrame(RawFrame& image);
+
+  /**
+   * Get an image from the source's pool to fill in place, so it can be put
+   * without copying.  The width, height, and pixel format of image are used
+   * for the allocation, along with totalData if it is positive (it is
+   * computed for uncompressed formats otherwise); data and totalData are set
+   * to the image memory, which is owned by the returned reference (so image
+   * must not be a RawFrame, which frees its data).
+   *
+   * @param image raw frame image
+   * @return reference to pass to PutFrame(); dropping it instead returns the
+   *         image to the pool
+   */
+  std::shared_ptr<void> AllocFrame(CS_RawFrame& image);
+
+  /**
+   * Put an image obtained from AllocFrame() and notify sinks, without
+   * copying it.
+   *
+   * @param frameRef reference returned by AllocFrame()
+   */
+  void PutFrame(const std::shared_ptr<void>& frameRef);
 };
 
 /**
@@ -186,6 +218,29 @@ class RawSink : public ImageSink {
    *         and is in 1 us increments.
    */
   [[nodiscard]] uint64_t GrabFrameNoTimeout(RawFrame& image) const;
+
+  /**
+   * Wait for the next frame and get the image without copying it.
+   * Times out (returning 0) after timeout seconds.
+   * The width, height, and pixel format of image select the image to get,
+   * as for GrabFrame(); data is set to the frame's own memory (so image must
+   * not be a RawFrame, which frees its data).
+   *
+   * <p>The image memory is shared with every other sink on the same source,
+   * so it must be treated as read-only.  It stays valid for as long as
+   * frameRef (or a copy of it) is held; hold it only as long as needed, as a
+   * held frame's memory can't be reused for new frames.
+   *
+   * @param image raw frame image
+   * @param frameRef set to a reference that keeps the image alive
+   * @param timeout timeout in seconds
+   * @return Frame time, or 0 on error (call GetError() to obtain the error
+   *         message); the frame time is in the same time base as wpi::Now(),
+   *         and is in 1 us increments.
+   */
+  [[nodiscard]] uint64_t GrabFrameShared(CS_RawFrame& image,
+                                         std::shared_ptr<void>& frameRef,
+                                         double timeout = 0.225) const;
 };
 
 inline RawSource::RawSource(std::string_view name, const VideoMode& mode) {
@@ -204,6 +259,16 @@ inline void RawSource::PutFrame(RawFrame& image) {
   PutSourceFrame(m_handle, image, &m_status);
 }
 
+inline std::shared_ptr<void> RawSource::AllocFrame(CS_RawFrame& image) {
+  m_status = 0;
+  return AllocSourceFrame(m_handle, image, &m_status);
+}
+
+inline void RawSource::PutFrame(const std::shared_ptr<void>& frameRef) {
+  m_status = 0;
+  PutSourceFrameShared(m_handle, frameRef, &m_status);
+}
+
 inline RawSink::RawSink(std::string_view name) {
   m_handle = CreateRawSink(name, &m_status);
 }
@@ -223,6 +288,13 @@ inline uint64_t RawSink::GrabFrameNoTimeout(RawFrame& image) const {
   return GrabSinkFrame(m_handle, image, &m_status);
 }
 
+inline uint64_t RawSink::GrabFrameShared(CS_RawFrame& image,
+                                         std::shared_ptr<void>& frameRef,
+                                         double timeout) const {
+  m_status = 0;
+  return GrabSinkFrameShared(m_handle, image, frameRef, timeout, &m_status);
+}
+
 }  // namespace cs
 
 /** @} */
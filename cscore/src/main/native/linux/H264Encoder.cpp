@@ -0,0 +1,417 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "H264Encoder.h"
+
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <fmt/format.h>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <wpi/Logger.h>
+
+#include "Image.h"
+#include "UsbCameraBuffer.h"
+#include "UsbUtil.h"
+
+using namespace cs;
+
+namespace {
+
+// An encoder on a V4L2 memory-to-memory device (e.g. the Raspberry Pi's
+// bcm2835-codec).  Raw frames are queued on the OUTPUT queue and the
+// encoded stream is dequeued from the CAPTURE queue.
+class V4L2H264Encoder : public H264Encoder {
+ public:
+  V4L2H264Encoder(int fd, std::string path, wpi::Logger& logger)
+      : m_fd{fd}, m_path{std::move(path)}, m_logger{logger} {}
+  ~V4L2H264Encoder() override;
+
+  const char* GetName() const override { return "v4l2m2m"; }
+
+  bool Init(const Settings& settings);
+  bool Encode(Image& image, bool forceKeyframe, std::vector<uint8_t>& out,
+              bool* keyframe) override;
+
+ private:
+  static constexpr int kNumOutputBuffers = 2;
+  static constexpr int kNumCaptureBuffers = 4;
+  static constexpr int kTimeoutMs = 1000;
+
+  void SetControl(uint32_t id, int32_t value, const char* name);
+  bool Wait(short events);  // NOLINT(runtime/int)
+  void ReclaimOutputBuffers();
+
+  int m_fd;
+  std::string m_path;
+  wpi::Logger& m_logger;
+  Settings m_settings;
+
+  // OUTPUT queue format
+  unsigned int m_width = 0;
+  unsigned int m_height = 0;
+  unsigned int m_bytesPerLine = 0;
+
+  std::array<UsbCameraBuffer, kNumOutputBuffers> m_outputBuffers;
+  std::array<bool, kNumOutputBuffers> m_outputQueued{};
+  std::array<UsbCameraBuffer, kNumCaptureBuffers> m_captureBuffers;
+  bool m_streaming = false;
+
+  cv::Mat m_yuv;
+};
+
+}  // namespace
+
+V4L2H264Encoder::~V4L2H264Encoder() {
+  if (m_streaming) {
+    int type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    TryIoctl(m_fd, VIDIOC_STREAMOFF, &type);
+    type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+    TryIoctl(m_fd, VIDIOC_STREAMOFF, &type);
+  }
+  // unmap before closing
+  for (auto&& buf : m_outputBuffers) {
+    buf = UsbCameraBuffer{};
+  }
+  for (auto&& buf : m_captureBuffers) {
+    buf = UsbCameraBuffer{};
+  }
+  close(m_fd);
+}
+
+void V4L2H264Encoder::SetControl(uint32_t id, int32_t value,
+                                 const char* name) {
+  struct v4l2_control ctrl;
+  std::memset(&ctrl, 0, sizeof(ctrl));
+  ctrl.id = id;
+  ctrl.value = value;
+  // not every encoder supports every control
+  if (TryIoctl(m_fd, VIDIOC_S_CTRL, &ctrl) < 0) {
+    WPI_DEBUG(m_logger, "{}: could not set {} to {}", m_path, name, value);
+  }
+}
+
+bool V4L2H264Encoder::Init(const Settings& settings) {
+  m_settings = settings;
+
+  // Encoded stream format; the driver picks the buffer size if this is too
+  // small for it
+  struct v4l2_format fmt;
+  std::memset(&fmt, 0, sizeof(fmt));
+  fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+  fmt.fmt.pix_mp.width = settings.width;
+  fmt.fmt.pix_mp.height = settings.height;
+  fmt.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_H264;
+  fmt.fmt.pix_mp.field = V4L2_FIELD_ANY;
+  fmt.fmt.pix_mp.num_planes = 1;
+  fmt.fmt.pix_mp.plane_fmt[0].sizeimage = 512 * 1024;
+  if (DoIoctl(m_fd, VIDIOC_S_FMT, &fmt) < 0) {
+    return false;
+  }
+
+  // Raw image format
+  std::memset(&fmt, 0, sizeof(fmt));
+  fmt.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+  fmt.fmt.pix_mp.width = settings.width;
+  fmt.fmt.pix_mp.height = settings.height;
+  fmt.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_YUV420;
+  fmt.fmt.pix_mp.field = V4L2_FIELD_ANY;
+  fmt.fmt.pix_mp.num_planes = 1;
+  if (DoIoctl(m_fd, VIDIOC_S_FMT, &fmt) < 0) {
+    return false;
+  }
+  // the driver may pad the image, but it must not shrink it
+  if (fmt.fmt.pix_mp.pixelformat != V4L2_PIX_FMT_YUV420 ||
+      fmt.fmt.pix_mp.num_planes != 1 ||
+      fmt.fmt.pix_mp.width < static_cast<unsigned int>(settings.width) ||
+      fmt.fmt.pix_mp.height < static_cast<unsigned int>(settings.height) ||
+      fmt.fmt.pix_mp.plane_fmt[0].bytesperline < fmt.fmt.pix_mp.width) {
+    WPI_DEBUG(m_logger, "{}: unsupported raw format {}x{}", m_path,
+              settings.width, settings.height);
+    return false;
+  }
+  m_width = fmt.fmt.pix_mp.width;
+  m_height = fmt.fmt.pix_mp.height;
+  m_bytesPerLine = fmt.fmt.pix_mp.plane_fmt[0].bytesperline;
+
+  // Frame rate (used by the rate control)
+  if (settings.fps > 0) {
+    struct v4l2_streamparm parm;
+    std::memset(&parm, 0, sizeof(parm));
+    parm.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    parm.parm.output.timeperframe.numerator = 1;
+    parm.parm.output.timeperframe.denominator = settings.fps;
+    TryIoctl(m_fd, VIDIOC_S_PARM, &parm);
+  }
+
+  SetControl(V4L2_CID_MPEG_VIDEO_BITRATE, settings.bitrate * 1000, "bitrate");
+  SetControl(V4L2_CID_MPEG_VIDEO_H264_I_PERIOD, settings.keyframeInterval,
+             "keyframe interval");
+  SetControl(V4L2_CID_MPEG_VIDEO_GOP_SIZE, settings.keyframeInterval,
+             "GOP size");
+  SetControl(V4L2_CID_MPEG_VIDEO_REPEAT_SEQ_HEADER, 1, "repeat headers");
+
+  // Map the buffers of both queues
+  auto mapBuffers = [&](uint32_t type, auto& buffers) {
+    struct v4l2_requestbuffers rb;
+    std::memset(&rb, 0, sizeof(rb));
+    rb.count = buffers.size();
+    rb.type = type;
+    rb.memory = V4L2_MEMORY_MMAP;
+    if (DoIoctl(m_fd, VIDIOC_REQBUFS, &rb) < 0 || rb.count < buffers.size()) {
+      return false;
+    }
+    for (unsigned int i = 0; i < buffers.size(); ++i) {
+      struct v4l2_plane plane;
+      struct v4l2_buffer buf;
+      std::memset(&plane, 0, sizeof(plane));
+      std::memset(&buf, 0, sizeof(buf));
+      buf.type = type;
+      buf.memory = V4L2_MEMORY_MMAP;
+      buf.index = i;
+      buf.m.planes = &plane;
+      buf.length = 1;
+      if (DoIoctl(m_fd, VIDIOC_QUERYBUF, &buf) < 0) {
+        return false;
+      }
+      buffers[i] = UsbCameraBuffer{m_fd, plane.length, plane.m.mem_offset};
+      if (!buffers[i].m_data) {
+        return false;
+      }
+    }
+    return true;
+  };
+  if (!mapBuffers(V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, m_outputBuffers) ||
+      !mapBuffers(V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE, m_captureBuffers)) {
+    return false;
+  }
+
+  // The encoder fills all of the capture buffers it is given
+  for (unsigned int i = 0; i < m_captureBuffers.size(); ++i) {
+    struct v4l2_plane plane;
+    struct v4l2_buffer buf;
+    std::memset(&plane, 0, sizeof(plane));
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = i;
+    buf.m.planes = &plane;
+    buf.length = 1;
+    if (DoIoctl(m_fd, VIDIOC_QBUF, &buf) < 0) {
+      return false;
+    }
+  }
+
+  int type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+  if (DoIoctl(m_fd, VIDIOC_STREAMON, &type) < 0) {
+    return false;
+  }
+  type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+  if (DoIoctl(m_fd, VIDIOC_STREAMON, &type) < 0) {
+    type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    TryIoctl(m_fd, VIDIOC_STREAMOFF, &type);
+    return false;
+  }
+  m_streaming = true;
+  return true;
+}
+
+bool V4L2H264Encoder::Wait(short events) {  // NOLINT(runtime/int)
+  struct pollfd pfd;
+  pfd.fd = m_fd;
+  pfd.events = events;
+  pfd.revents = 0;
+  int rv;
+  do {
+    rv = poll(&pfd, 1, kTimeoutMs);
+  } while (rv < 0 && errno == EINTR);
+  return rv > 0 && (pfd.revents & events) != 0;
+}
+
+void V4L2H264Encoder::ReclaimOutputBuffers() {
+  for (;;) {
+    struct v4l2_plane plane;
+    struct v4l2_buffer buf;
+    std::memset(&plane, 0, sizeof(plane));
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.m.planes = &plane;
+    buf.length = 1;
+    if (TryIoctl(m_fd, VIDIOC_DQBUF, &buf) < 0) {
+      return;  // EAGAIN: the encoder still has the rest
+    }
+    if (buf.index < m_outputQueued.size()) {
+      m_outputQueued[buf.index] = false;
+    }
+  }
+}
+
+bool V4L2H264Encoder::Encode(Image& image, bool forceKeyframe,
+                             std::vector<uint8_t>& out, bool* keyframe) {
+  out.clear();
+  *keyframe = false;
+  if (image.width != m_settings.width || image.height != m_settings.height ||
+      image.pixelFormat != VideoMode::kBGR) {
+    return false;
+  }
+
+  // Find a free raw buffer, waiting for the encoder to release one
+  ReclaimOutputBuffers();
+  unsigned int index = 0;
+  while (index < m_outputQueued.size() && m_outputQueued[index]) {
+    ++index;
+  }
+  if (index == m_outputQueued.size()) {
+    if (!Wait(POLLOUT)) {
+      WPI_WARNING(m_logger, "{}: timed out waiting for encoder", m_path);
+      return false;
+    }
+    ReclaimOutputBuffers();
+    index = 0;
+    while (index < m_outputQueued.size() && m_outputQueued[index]) {
+      ++index;
+    }
+    if (index == m_outputQueued.size()) {
+      return false;
+    }
+  }
+
+  // Convert to I420, then copy the planes to the (possibly padded) buffer
+  cv::cvtColor(image.AsMat(), m_yuv, cv::COLOR_BGR2YUV_I420);
+  auto& dst = m_outputBuffers[index];
+  size_t lumaSize = static_cast<size_t>(m_bytesPerLine) * m_height;
+  size_t chromaSize = lumaSize / 4;
+  if (dst.m_length < lumaSize + 2 * chromaSize) {
+    return false;
+  }
+  uint8_t* dstData = static_cast<uint8_t*>(dst.m_data);
+  const uint8_t* src = m_yuv.data;
+  int width = m_settings.width;
+  int height = m_settings.height;
+  if (m_bytesPerLine == static_cast<unsigned int>(width) &&
+      m_height == static_cast<unsigned int>(height)) {
+    std::memcpy(dstData, src, lumaSize + 2 * chromaSize);
+  } else {
+    auto copyPlane = [&](uint8_t* d, size_t dstride, int w, int h) {
+      for (int row = 0; row < h; ++row) {
+        std::memcpy(d + row * dstride, src, w);
+        src += w;
+      }
+    };
+    copyPlane(dstData, m_bytesPerLine, width, height);
+    copyPlane(dstData + lumaSize, m_bytesPerLine / 2, width / 2, height / 2);
+    copyPlane(dstData + lumaSize + chromaSize, m_bytesPerLine / 2, width / 2,
+              height / 2);
+  }
+
+  if (forceKeyframe) {
+    SetControl(V4L2_CID_MPEG_VIDEO_FORCE_KEY_FRAME, 1, "force keyframe");
+  }
+
+  {
+    struct v4l2_plane plane;
+    struct v4l2_buffer buf;
+    std::memset(&plane, 0, sizeof(plane));
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = index;
+    buf.m.planes = &plane;
+    buf.length = 1;
+    plane.bytesused = lumaSize + 2 * chromaSize;
+    if (DoIoctl(m_fd, VIDIOC_QBUF, &buf) < 0) {
+      return false;
+    }
+    m_outputQueued[index] = true;
+  }
+
+  // Get the encoded frame; one comes out for each one that goes in
+  if (!Wait(POLLIN)) {
+    WPI_WARNING(m_logger, "{}: timed out waiting for encoded frame", m_path);
+    return false;
+  }
+  struct v4l2_plane plane;
+  struct v4l2_buffer buf;
+  std::memset(&plane, 0, sizeof(plane));
+  std::memset(&buf, 0, sizeof(buf));
+  buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+  buf.memory = V4L2_MEMORY_MMAP;
+  buf.m.planes = &plane;
+  buf.length = 1;
+  if (DoIoctl(m_fd, VIDIOC_DQBUF, &buf) < 0) {
+    return false;
+  }
+  if (buf.index < m_captureBuffers.size()) {
+    auto& cap = m_captureBuffers[buf.index];
+    size_t size = std::min<size_t>(plane.bytesused, cap.m_length);
+    size_t offset = std::min<size_t>(plane.data_offset, size);
+    const uint8_t* data = static_cast<const uint8_t*>(cap.m_data);
+    out.assign(data + offset, data + size);
+    *keyframe = (buf.flags & V4L2_BUF_FLAG_KEYFRAME) != 0;
+  }
+  // give the buffer back to the encoder
+  plane.bytesused = 0;
+  return DoIoctl(m_fd, VIDIOC_QBUF, &buf) >= 0;
+}
+
+std::unique_ptr<H264Encoder> H264Encoder::Create(const Settings& settings,
+                                                 wpi::Logger& logger) {
+  // YUV 4:2:0 needs even dimensions
+  if (settings.width <= 0 || settings.height <= 0 || settings.width % 2 != 0 ||
+      settings.height % 2 != 0) {
+    return nullptr;
+  }
+
+  for (int dev = 0; dev < 64; ++dev) {
+    auto path = fmt::format("/dev/video{}", dev);
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK);
+    if (fd < 0) {
+      continue;
+    }
+
+    // look for a memory-to-memory device that outputs H.264
+    struct v4l2_capability vcap;
+    std::memset(&vcap, 0, sizeof(vcap));
+    bool match = false;
+    if (TryIoctl(fd, VIDIOC_QUERYCAP, &vcap) >= 0) {
+      uint32_t caps = (vcap.capabilities & V4L2_CAP_DEVICE_CAPS)
+                          ? vcap.device_caps
+                          : vcap.capabilities;
+      if ((caps & V4L2_CAP_VIDEO_M2M_MPLANE) && (caps & V4L2_CAP_STREAMING)) {
+        struct v4l2_fmtdesc fmtdesc;
+        std::memset(&fmtdesc, 0, sizeof(fmtdesc));
+        fmtdesc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+        for (; TryIoctl(fd, VIDIOC_ENUM_FMT, &fmtdesc) >= 0;
+             ++fmtdesc.index) {
+          if (fmtdesc.pixelformat == V4L2_PIX_FMT_H264) {
+            match = true;
+            break;
+          }
+        }
+      }
+    }
+    if (!match) {
+      close(fd);
+      continue;
+    }
+
+    auto encoder = std::make_unique<V4L2H264Encoder>(fd, path, logger);
+    if (encoder->Init(settings)) {
+      WPI_INFO(logger, "using H.264 encoder {} ({})", path,
+               reinterpret_cast<const char*>(vcap.card));
+      return encoder;
+    }
+    WPI_DEBUG(logger, "{}: could not configure H.264 encoder", path);
+  }
+  return nullptr;
+}
@@ -0,0 +1,327 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "SharedFrameRing.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+#include <wpi/timestamp.h>
+
+using namespace cs;
+
+static constexpr uint32_t kMagic = 0x52465343;  // "CSFR"
+static constexpr uint32_t kVersion = 1;
+
+namespace {
+
+// At the start of the shared memory.  Fields shared between processes are
+// accessed with atomic builtins, as the futex needs a plain word.
+struct RingHeader {
+  uint32_t magic;  // stored last, once the rest is initialized
+  uint32_t version;
+  uint32_t numSlots;
+  uint32_t closed;  // set when the writer goes away or replaces the ring
+  uint64_t slotSize;
+  uint64_t slotStride;
+  uint32_t sequence;  // frames written; the futex word
+  uint32_t latest;    // slot of the newest frame
+};
+
+// At the start of each slot, followed by the frame data
+struct alignas(64) SlotHeader {
+  uint32_t seq;  // odd while the slot is being written, 0 if never written
+  int32_t pixelFormat;
+  int32_t width;
+  int32_t height;
+  uint64_t size;
+  int64_t time;  // monotonic clock, microseconds
+};
+
+constexpr size_t kHeaderSize = 64;
+static_assert(sizeof(RingHeader) <= kHeaderSize);
+
+class LinuxSharedFrameRing : public SharedFrameRing {
+ public:
+  LinuxSharedFrameRing(std::string path, void* mem, size_t memSize, ino_t ino,
+                       bool writer)
+      : m_path{std::move(path)},
+        m_mem{mem},
+        m_memSize{memSize},
+        m_ino{ino},
+        m_writer{writer} {}
+  ~LinuxSharedFrameRing() override;
+
+  size_t GetSlotSize() const override { return Header().slotSize; }
+  void Write(const FrameInfo& info, const char* data) override;
+  bool Wait(double timeout) override;
+  bool Read(FrameInfo* info,
+            const std::function<char*(const FrameInfo&)>& alloc) override;
+  bool IsClosed() const override;
+
+ private:
+  RingHeader& Header() const { return *static_cast<RingHeader*>(m_mem); }
+  SlotHeader& Slot(uint32_t i) const {
+    return *reinterpret_cast<SlotHeader*>(static_cast<char*>(m_mem) +
+                                          kHeaderSize +
+                                          i * Header().slotStride);
+  }
+  char* SlotData(uint32_t i) const {
+    return reinterpret_cast<char*>(&Slot(i)) + sizeof(SlotHeader);
+  }
+
+  // True if the name no longer refers to this ring
+  bool IsReplaced() const;
+
+  std::string m_path;
+  void* m_mem;
+  size_t m_memSize;
+  ino_t m_ino;
+  bool m_writer;
+
+  // Writer: the slot to write next.  Reader: the last sequence read.
+  uint32_t m_next = 0;
+  uint32_t m_lastSequence = 0;
+  bool m_replaced = false;
+};
+
+}  // namespace
+
+static int64_t MonotonicNow() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void FutexWake(uint32_t* word) {
+  syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// Only accept names that map to a single file in /dev/shm
+static bool MakePath(std::string_view name, std::string* path) {
+  if (name.empty() || name.size() > 200) {
+    return false;
+  }
+  for (char ch : name) {
+    if (!std::isalnum(static_cast<unsigned char>(ch)) && ch != '_' &&
+        ch != '-' && ch != '.') {
+      return false;
+    }
+  }
+  *path = fmt::format("/cscore.{}", name);
+  return true;
+}
+
+LinuxSharedFrameRing::~LinuxSharedFrameRing() {
+  if (m_writer) {
+    // Readers wait on the sequence, so bump it to have them see the close
+    auto& header = Header();
+    __atomic_store_n(&header.closed, 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&header.sequence, 1, __ATOMIC_RELEASE);
+    FutexWake(&header.sequence);
+    // Don't remove a ring that has already replaced this one
+    if (!IsReplaced()) {
+      shm_unlink(m_path.c_str());
+    }
+  }
+  munmap(m_mem, m_memSize);
+}
+
+void LinuxSharedFrameRing::Write(const FrameInfo& info, const char* data) {
+  auto& header = Header();
+  uint32_t i = m_next;
+  m_next = (m_next + 1) % header.numSlots;
+  auto& slot = Slot(i);
+
+  uint64_t now = wpi::Now();
+  uint64_t age = info.time < now ? now - info.time : 0;
+
+  uint32_t seq = __atomic_load_n(&slot.seq, __ATOMIC_RELAXED);
+  __atomic_store_n(&slot.seq, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  slot.pixelFormat = info.pixelFormat;
+  slot.width = info.width;
+  slot.height = info.height;
+  slot.size = info.size;
+  slot.time = MonotonicNow() - static_cast<int64_t>(age);
+  std::memcpy(SlotData(i), data, info.size);
+  __atomic_store_n(&slot.seq, seq + 2, __ATOMIC_RELEASE);
+
+  __atomic_store_n(&header.latest, i, __ATOMIC_RELEASE);
+  __atomic_fetch_add(&header.sequence, 1, __ATOMIC_RELEASE);
+  FutexWake(&header.sequence);
+}
+
+bool LinuxSharedFrameRing::Wait(double timeout) {
+  auto& header = Header();
+  int64_t deadline = MonotonicNow() + static_cast<int64_t>(timeout * 1.0e6);
+  for (;;) {
+    uint32_t seq = __atomic_load_n(&header.sequence, __ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&header.closed, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+    if (seq != m_lastSequence) {
+      return true;
+    }
+    int64_t remaining = deadline - MonotonicNow();
+    if (remaining <= 0) {
+      // A writer that died without closing leaves the ring in place until
+      // a new one replaces it, so check for that while idle
+      m_replaced = IsReplaced();
+      return false;
+    }
+    struct timespec ts;
+    ts.tv_sec = remaining / 1000000;
+    ts.tv_nsec = (remaining % 1000000) * 1000;
+    syscall(SYS_futex, &header.sequence, FUTEX_WAIT, seq, &ts, nullptr, 0);
+  }
+}
+
+bool LinuxSharedFrameRing::Read(
+    FrameInfo* info, const std::function<char*(const FrameInfo&)>& alloc) {
+  auto& header = Header();
+  uint32_t seq = __atomic_load_n(&header.sequence, __ATOMIC_ACQUIRE);
+  uint32_t i = __atomic_load_n(&header.latest, __ATOMIC_ACQUIRE);
+  if (i >= header.numSlots) {
+    return false;
+  }
+  auto& slot = Slot(i);
+
+  uint32_t slotSeq = __atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE);
+  if (slotSeq == 0 || (slotSeq & 1) != 0) {
+    return false;
+  }
+  info->pixelFormat = static_cast<VideoMode::PixelFormat>(slot.pixelFormat);
+  info->width = slot.width;
+  info->height = slot.height;
+  info->size = slot.size;
+  int64_t time = slot.time;
+  if (info->size > header.slotSize) {
+    return false;
+  }
+  char* buf = alloc(*info);
+  std::memcpy(buf, SlotData(i), info->size);
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  if (__atomic_load_n(&slot.seq, __ATOMIC_RELAXED) != slotSeq) {
+    return false;  // overwritten while copying
+  }
+
+  int64_t age = MonotonicNow() - time;
+  uint64_t now = wpi::Now();
+  info->time = age > 0 && static_cast<uint64_t>(age) < now ? now - age : now;
+  m_lastSequence = seq;
+  return true;
+}
+
+bool LinuxSharedFrameRing::IsClosed() const {
+  return m_replaced || __atomic_load_n(&Header().closed, __ATOMIC_ACQUIRE);
+}
+
+bool LinuxSharedFrameRing::IsReplaced() const {
+  int fd = shm_open(m_path.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return true;
+  }
+  struct stat st;
+  bool replaced = fstat(fd, &st) < 0 || st.st_ino != m_ino;
+  close(fd);
+  return replaced;
+}
+
+std::unique_ptr<SharedFrameRing> SharedFrameRing::Create(std::string_view name,
+                                                         int numSlots,
+                                                         size_t slotSize) {
+  std::string path;
+  if (numSlots <= 0 || !MakePath(name, &path)) {
+    return nullptr;
+  }
+  size_t stride = (sizeof(SlotHeader) + slotSize + 63) & ~size_t{63};
+  size_t memSize = kHeaderSize + numSlots * stride;
+
+  // Readers of the old ring (if any) notice it's been replaced
+  shm_unlink(path.c_str());
+  int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 || ftruncate(fd, memSize) < 0) {
+    close(fd);
+    shm_unlink(path.c_str());
+    return nullptr;
+  }
+  void* mem =
+      mmap(nullptr, memSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mem == MAP_FAILED) {
+    shm_unlink(path.c_str());
+    return nullptr;
+  }
+
+  // The memory starts zeroed
+  auto& header = *static_cast<RingHeader*>(mem);
+  header.version = kVersion;
+  header.numSlots = numSlots;
+  header.slotSize = slotSize;
+  header.slotStride = stride;
+  __atomic_store_n(&header.magic, kMagic, __ATOMIC_RELEASE);
+
+  return std::make_unique<LinuxSharedFrameRing>(std::move(path), mem, memSize,
+                                                st.st_ino, true);
+}
+
+std::unique_ptr<SharedFrameRing> SharedFrameRing::Open(std::string_view name) {
+  std::string path;
+  if (!MakePath(name, &path)) {
+    return nullptr;
+  }
+  int fd = shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 ||
+      static_cast<size_t>(st.st_size) < kHeaderSize) {
+    close(fd);
+    return nullptr;
+  }
+
+  // Map just the header to learn the size, then the whole ring
+  void* mem = mmap(nullptr, kHeaderSize, PROT_READ, MAP_SHARED, fd, 0);
+  if (mem == MAP_FAILED) {
+    close(fd);
+    return nullptr;
+  }
+  auto& header = *static_cast<RingHeader*>(mem);
+  size_t memSize = 0;
+  if (__atomic_load_n(&header.magic, __ATOMIC_ACQUIRE) == kMagic &&
+      header.version == kVersion && header.numSlots > 0) {
+    memSize = kHeaderSize + header.numSlots * header.slotStride;
+  }
+  munmap(mem, kHeaderSize);
+  if (memSize == 0 || static_cast<size_t>(st.st_size) < memSize) {
+    close(fd);
+    return nullptr;  // not initialized yet, or not a ring
+  }
+
+  mem = mmap(nullptr, memSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mem == MAP_FAILED) {
+    return nullptr;
+  }
+  return std::make_unique<LinuxSharedFrameRing>(std::move(path), mem, memSize,
+                                                st.st_ino, false);
+}
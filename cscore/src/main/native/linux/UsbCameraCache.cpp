@@ -0,0 +1,257 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "UsbCameraCache.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <utility>
+
+#include <fmt/format.h>
+#include <wpi/StringExtras.h>
+#include <wpi/fs.h>
+#include <wpi/raw_istream.h>
+#include <wpi/raw_ostream.h>
+
+#include "UsbCameraProperty.h"
+
+using namespace cs;
+
+static bool ReadSysFile(const std::string& path, std::string* contents) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  char readBuf[128];
+  ssize_t n = read(fd, readBuf, sizeof(readBuf));
+  close(fd);
+  if (n <= 0) {
+    return false;
+  }
+  *contents = wpi::trim(std::string_view{readBuf, static_cast<size_t>(n)});
+  return !contents->empty();
+}
+
+static wpi::json ModeToJson(const VideoMode& mode) {
+  return wpi::json::array(
+      {mode.pixelFormat, mode.width, mode.height, mode.fps});
+}
+
+static VideoMode ModeFromJson(const wpi::json& j) {
+  return VideoMode{
+      static_cast<VideoMode::PixelFormat>(j.at(0).get<int>()),
+      j.at(1).get<int>(), j.at(2).get<int>(), j.at(3).get<int>()};
+}
+
+UsbCameraCache& UsbCameraCache::GetInstance() {
+  static UsbCameraCache instance;
+  return instance;
+}
+
+UsbCameraCache::UsbCameraCache() {
+  if (const char* home = std::getenv("HOME")) {
+    m_filename = fmt::format("{}/.cache/cscore/usbcameras.json", home);
+    std::error_code ec;
+    wpi::raw_fd_istream is(m_filename, ec);
+    if (!ec) {
+      try {
+        m_cameras = wpi::json::parse(is);
+      } catch (const wpi::json::exception&) {
+        // start over
+      }
+    }
+  }
+  if (!m_cameras.is_object()) {
+    m_cameras = wpi::json::object();
+  }
+}
+
+std::string UsbCameraCache::GetKey(int dev) {
+  if (dev < 0) {
+    return {};
+  }
+  // the device link is to the USB interface; its parent is the USB device
+  auto usbpath = fmt::format("/sys/class/video4linux/video{}/device/..", dev);
+  std::string vendor;
+  std::string product;
+  if (!ReadSysFile(usbpath + "/idVendor", &vendor) ||
+      !ReadSysFile(usbpath + "/idProduct", &product)) {
+    return {};
+  }
+  std::string key;
+  std::string serial;
+  if (ReadSysFile(usbpath + "/serial", &serial)) {
+    key = fmt::format("{}:{}:{}", vendor, product, serial);
+  } else {
+    // identify cameras without a serial number by the port they're on
+    std::error_code ec;
+    auto port = fs::canonical(usbpath, ec);
+    if (ec) {
+      return {};
+    }
+    key = fmt::format("{}:{}@{}", vendor, product, port.filename().string());
+  }
+  // a camera may have more than one node (e.g. for metadata)
+  std::string index;
+  if (ReadSysFile(fmt::format("/sys/class/video4linux/video{}/index", dev),
+                  &index) &&
+      index != "0") {
+    key += '/';
+    key += index;
+  }
+  return key;
+}
+
+bool UsbCameraCache::GetVideoModes(std::string_view key,
+                                   std::vector<VideoMode>* modes,
+                                   VideoMode* mode) {
+  std::scoped_lock lock(m_mutex);
+  auto camera = Find(key);
+  if (!camera || camera->count("modes") == 0) {
+    return false;
+  }
+  try {
+    modes->clear();
+    for (auto&& j : camera->at("modes")) {
+      modes->emplace_back(ModeFromJson(j));
+    }
+    if (camera->count("mode") != 0) {
+      *mode = ModeFromJson(camera->at("mode"));
+    } else {
+      *mode = VideoMode{};
+    }
+  } catch (const wpi::json::exception&) {
+    return false;
+  }
+  return !modes->empty();
+}
+
+bool UsbCameraCache::GetProperties(
+    std::string_view key,
+    std::vector<std::unique_ptr<UsbCameraProperty>>* props) {
+  std::scoped_lock lock(m_mutex);
+  auto camera = Find(key);
+  if (!camera || camera->count("properties") == 0) {
+    return false;
+  }
+  try {
+    props->clear();
+    for (auto&& j : camera->at("properties")) {
+      auto prop =
+          std::make_unique<UsbCameraProperty>(j.at("name").get<std::string>());
+      prop->id = j.at("id").get<unsigned int>();
+      prop->type = j.at("type").get<int>();
+      prop->propKind = static_cast<CS_PropertyKind>(j.at("kind").get<int>());
+      if (j.count("min") != 0) {
+        prop->hasMinimum = true;
+        prop->minimum = j.at("min").get<int>();
+      }
+      if (j.count("max") != 0) {
+        prop->hasMaximum = true;
+        prop->maximum = j.at("max").get<int>();
+      }
+      prop->step = j.at("step").get<int>();
+      prop->defaultValue = j.at("default").get<int>();
+      prop->intMenu = j.at("intMenu").get<bool>();
+      if (j.count("choices") != 0) {
+        prop->enumChoices = j.at("choices").get<std::vector<std::string>>();
+      }
+      props->emplace_back(std::move(prop));
+    }
+  } catch (const wpi::json::exception&) {
+    props->clear();
+    return false;
+  }
+  return true;
+}
+
+bool UsbCameraCache::SetVideoModes(std::string_view key,
+                                   wpi::span<const VideoMode> modes) {
+  auto j = wpi::json::array();
+  for (auto&& mode : modes) {
+    j.push_back(ModeToJson(mode));
+  }
+  return Set(key, "modes", std::move(j));
+}
+
+bool UsbCameraCache::SetMode(std::string_view key, const VideoMode& mode) {
+  return Set(key, "mode", ModeToJson(mode));
+}
+
+bool UsbCameraCache::SetProperties(
+    std::string_view key,
+    wpi::span<const std::unique_ptr<UsbCameraProperty>> props) {
+  auto j = wpi::json::array();
+  for (auto&& prop : props) {
+    wpi::json p{{"name", prop->name},
+                {"id", prop->id},
+                {"type", prop->type},
+                {"kind", static_cast<int>(prop->propKind)},
+                {"step", prop->step},
+                {"default", prop->defaultValue},
+                {"intMenu", prop->intMenu}};
+    if (prop->hasMinimum) {
+      p["min"] = prop->minimum;
+    }
+    if (prop->hasMaximum) {
+      p["max"] = prop->maximum;
+    }
+    if (!prop->enumChoices.empty()) {
+      p["choices"] = prop->enumChoices;
+    }
+    j.push_back(std::move(p));
+  }
+  return Set(key, "properties", std::move(j));
+}
+
+wpi::json* UsbCameraCache::Find(std::string_view key) {
+  if (key.empty()) {
+    return nullptr;
+  }
+  auto it = m_cameras.find(key);
+  if (it == m_cameras.end() || !it->is_object()) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+bool UsbCameraCache::Set(std::string_view key, std::string_view field,
+                         wpi::json value) {
+  if (key.empty()) {
+    return false;
+  }
+  std::scoped_lock lock(m_mutex);
+  auto& camera = m_cameras[std::string{key}];
+  if (!camera.is_object()) {
+    camera = wpi::json::object();
+  }
+  auto& j = camera[std::string{field}];
+  if (j == value) {
+    return false;
+  }
+  j = std::move(value);
+  Save();
+  return true;
+}
+
+void UsbCameraCache::Save() {
+  if (m_filename.empty()) {
+    return;
+  }
+  std::error_code ec;
+  fs::create_directories(fs::path{m_filename}.parent_path(), ec);
+  auto tmp = fmt::format("{}.tmp", m_filename);
+  {
+    wpi::raw_fd_ostream os(tmp, ec);
+    if (ec) {
+      return;
+    }
+    m_cameras.dump(os);
+  }
+  std::rename(tmp.c_str(), m_filename.c_str());
+}
@@ -0,0 +1,61 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_USBCAMERACACHE_H_
+#define CSCORE_USBCAMERACACHE_H_
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wpi/json.h>
+#include <wpi/mutex.h>
+#include <wpi/span.h>
+
+#include "cscore_cpp.h"
+
+namespace cs {
+
+class UsbCameraProperty;
+
+// Capabilities of USB cameras seen before, kept in a file across runs so a
+// camera can be opened in its last used mode without first enumerating its
+// modes and controls.  Entries are keyed by USB vendor, product and serial
+// number (the USB port for cameras without one).
+class UsbCameraCache {
+ public:
+  static UsbCameraCache& GetInstance();
+
+  // Gets the key for /dev/videoN; empty if it isn't a USB device.
+  static std::string GetKey(int dev);
+
+  bool GetVideoModes(std::string_view key, std::vector<VideoMode>* modes,
+                     VideoMode* mode);
+  bool GetProperties(std::string_view key,
+                     std::vector<std::unique_ptr<UsbCameraProperty>>* props);
+
+  // These return true if the cached value changed.
+  bool SetVideoModes(std::string_view key, wpi::span<const VideoMode> modes);
+  bool SetMode(std::string_view key, const VideoMode& mode);
+  bool SetProperties(
+      std::string_view key,
+      wpi::span<const std::unique_ptr<UsbCameraProperty>> props);
+
+ private:
+  UsbCameraCache();
+
+  // Must be called with m_mutex held
+  wpi::json* Find(std::string_view key);
+  bool Set(std::string_view key, std::string_view field, wpi::json value);
+  void Save();
+
+  wpi::mutex m_mutex;
+  std::string m_filename;  // empty if there's nowhere to keep it
+  wpi::json m_cameras;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_USBCAMERACACHE_H_
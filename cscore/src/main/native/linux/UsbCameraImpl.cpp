@@ -17,6 +17,7 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -29,6 +30,7 @@
 #include <wpi/fs.h>
 #include <wpi/raw_ostream.h>
 #include <wpi/timestamp.h>
+#include <wpi/trace.h>
 
 #include "Handle.h"
 #include "Instance.h"
@@ -36,6 +38,7 @@
 #include "Log.h"
 #include "Notifier.h"
 #include "Telemetry.h"
+#include "UsbCameraCache.h"
 #include "UsbUtil.h"
 #include "cscore_cpp.h"
 
@@ -69,6 +72,32 @@ static inline struct v4l2_fract FPSToFract(int fps) {
   return timeperframe;
 }
 
+// Converts a buffer's capture timestamp to the wpi::Now() time base.  The
+// driver stamps buffers with CLOCK_MONOTONIC, but Now() may have a different
+// epoch (e.g. the FPGA clock on the roboRIO), so this subtracts the frame's
+// age from Now().  Falls back to Now() if the timestamp isn't monotonic or
+// is implausibly old.
+static Frame::Time GetFrameTime(const struct v4l2_buffer& buf) {
+  uint64_t now = wpi::Now();
+  if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) !=
+      V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+    return now;
+  }
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+    return now;
+  }
+  int64_t monotonic = ts.tv_sec * INT64_C(1000000) + ts.tv_nsec / 1000;
+  int64_t captured =
+      buf.timestamp.tv_sec * INT64_C(1000000) + buf.timestamp.tv_usec;
+  int64_t age = monotonic - captured;
+  if (captured == 0 || age < 0 || age > 1000000 ||
+      static_cast<uint64_t>(age) >= now) {
+    return now;
+  }
+  return now - age;
+}
+
 // Conversion from v4l2_format pixelformat to VideoMode::PixelFormat
 static VideoMode::PixelFormat ToPixelFormat(__u32 pixelFormat) {
   switch (pixelFormat) {
@@ -318,6 +347,7 @@ UsbCameraImpl::UsbCameraImpl(std::string_view name, wpi::Logger& logger,
       m_path{path} {
   SetDescription(GetDescriptionImpl(m_path.c_str()));
   SetQuirks();
+  m_returnedBuffers->command_fd = m_command_fd;
 
   CreateProperty(kPropConnectVerbose, [] {
     return std::make_unique<UsbCameraProperty>(kPropConnectVerbose,
@@ -340,8 +370,15 @@ UsbCameraImpl::~UsbCameraImpl() {
   if (m_cameraThread.joinable()) {
     m_cameraThread.join();
   }
+  if (m_cacheCheckThread.joinable()) {
+    m_cacheCheckThread.join();
+  }
 
   // close command fd
+  {
+    std::scoped_lock lock(m_returnedBuffers->mutex);
+    m_returnedBuffers->command_fd = -1;
+  }
   int fd = m_command_fd.exchange(-1);
   if (fd >= 0) {
     close(fd);
@@ -363,6 +400,7 @@ void UsbCameraImpl::Start() {
 }
 
 void UsbCameraImpl::CameraThreadMain() {
+  WPI_TRACE_THREAD_NAME("cscore USB camera");
   // We want to be notified on file creation and deletion events in the device
   // path.  This is used to detect disconnects and reconnects.
   std::unique_ptr<wpi::raw_fd_istream> notify_is;
@@ -422,6 +460,9 @@ void UsbCameraImpl::CameraThreadMain() {
       DeviceStreamOn();
     }
 
+    // Give buffers back to the driver as their frames are released
+    DeviceRequeueBuffers();
+
     // The select timeout can be long unless we're trying to reconnect
     struct timeval tv;
     if (fd < 0 && notified) {
@@ -508,17 +549,18 @@ void UsbCameraImpl::CameraThreadMain() {
         notified = true;  // device wasn't deleted, just error'ed
         continue;         // will reconnect
       }
+      --m_numQueued;
 
       if ((buf.flags & V4L2_BUF_FLAG_ERROR) == 0) {
         SDEBUG4("got image size={} index={}", buf.bytesused, buf.index);
 
-        if (buf.index >= kNumBuffers || !m_buffers[buf.index].m_data) {
+        if (buf.index >= kNumBuffers || !m_buffers[buf.index]) {
           SWARNING("invalid buffer {}", buf.index);
           continue;
         }
 
         std::string_view image{
-            static_cast<const char*>(m_buffers[buf.index].m_data),
+            static_cast<const char*>(m_buffers[buf.index]->m_data),
             static_cast<size_t>(buf.bytesused)};
         int width = m_mode.width;
         int height = m_mode.height;
@@ -528,9 +570,31 @@ void UsbCameraImpl::CameraThreadMain() {
           SWARNING("{}", "invalid JPEG image received from camera");
           good = false;
         }
+        if (good && m_numQueued >= kMinQueuedBuffers) {
+          // Zero copy: the frame wraps the buffer, which is requeued when
+          // the last reference to the frame is released
+          auto pixelFormat =
+              static_cast<VideoMode::PixelFormat>(m_mode.pixelFormat);
+          auto wrapped = std::make_unique<Image>(
+              m_buffers[buf.index]->m_data, image.size(),
+              [returned = m_returnedBuffers, buffer = m_buffers[buf.index],
+               generation = m_bufferGeneration, index = buf.index] {
+                std::scoped_lock lock(returned->mutex);
+                returned->buffers.emplace_back(generation, index);
+                if (returned->command_fd >= 0) {
+                  eventfd_write(returned->command_fd, 1);
+                }
+              });
+          wrapped->pixelFormat = pixelFormat;
+          wrapped->width = width;
+          wrapped->height = height;
+          m_bufferHeld[buf.index] = true;
+          PutFrame(std::move(wrapped), GetFrameTime(buf));
+          continue;
+        }
         if (good) {
           PutFrame(static_cast<VideoMode::PixelFormat>(m_mode.pixelFormat),
-                   width, height, image, wpi::Now());  // TODO: time
+                   width, height, image, GetFrameTime(buf));
         }
       }
 
@@ -543,6 +607,7 @@ void UsbCameraImpl::CameraThreadMain() {
         notified = true;  // device wasn't deleted, just error'ed
         continue;         // will reconnect
       }
+      ++m_numQueued;
     }
   }
 
@@ -557,10 +622,13 @@ void UsbCameraImpl::DeviceDisconnect() {
     return;  // already disconnected
   }
 
-  // Unmap buffers
+  // Unmap buffers (once any frames wrapping them are released); buffers
+  // returned after this are from the old mapping and are ignored
   for (int i = 0; i < kNumBuffers; ++i) {
-    m_buffers[i] = UsbCameraBuffer{};
+    m_buffers[i].reset();
+    m_bufferHeld[i] = false;
   }
+  ++m_bufferGeneration;
 
   // Close device
   close(fd);
@@ -599,11 +667,18 @@ void UsbCameraImpl::DeviceConnect() {
 
   // Get or restore video mode
   if (!m_properties_cached) {
-    SDEBUG3("{}", "caching properties");
-    DeviceCacheProperties();
-    DeviceCacheVideoModes();
+    m_cacheKey = UsbCameraCache::GetKey(GetDeviceNum(m_path.c_str()));
+    bool fromCache = DeviceLoadCache();
+    if (!fromCache) {
+      SDEBUG3("{}", "caching properties");
+      DeviceCacheProperties();
+      DeviceCacheVideoModes();
+    }
     DeviceCacheMode();
     m_properties_cached = true;
+    if (fromCache) {
+      StartCacheCheck();
+    }
   } else {
     SDEBUG3("{}", "restoring video mode");
     DeviceSetMode();
@@ -654,19 +729,20 @@ void UsbCameraImpl::DeviceConnect() {
     }
     SDEBUG4("buf {} length={} offset={}", i, buf.length, buf.m.offset);
 
-    m_buffers[i] = UsbCameraBuffer(fd, buf.length, buf.m.offset);
-    if (!m_buffers[i].m_data) {
+    m_buffers[i] =
+        std::make_shared<UsbCameraBuffer>(fd, buf.length, buf.m.offset);
+    if (!m_buffers[i]->m_data) {
       SWARNING("could not map buffer {}", i);
       // release other buffers
-      for (int j = 0; j < i; ++j) {
-        m_buffers[j] = UsbCameraBuffer{};
+      for (int j = 0; j <= i; ++j) {
+        m_buffers[j].reset();
       }
       close(fd);
       m_fd = -1;
       return;
     }
 
-    SDEBUG4("buf {} address={}", i, m_buffers[i].m_data);
+    SDEBUG4("buf {} address={}", i, m_buffers[i]->m_data);
   }
 
   // Update description (as it may have changed)
@@ -688,9 +764,13 @@ bool UsbCameraImpl::DeviceStreamOn() {
     return false;
   }
 
-  // Queue buffers
+  // Queue buffers (other than those still wrapped by frames)
   SDEBUG3("{}", "queuing buffers");
+  m_numQueued = 0;
   for (int i = 0; i < kNumBuffers; ++i) {
+    if (m_bufferHeld[i]) {
+      continue;
+    }
     struct v4l2_buffer buf;
     std::memset(&buf, 0, sizeof(buf));
     buf.index = i;
@@ -700,6 +780,7 @@ bool UsbCameraImpl::DeviceStreamOn() {
       SWARNING("could not queue buffer {}", i);
       return false;
     }
+    ++m_numQueued;
   }
 
   // Turn stream on
@@ -720,6 +801,10 @@ bool UsbCameraImpl::DeviceStreamOn() {
   }
   SDEBUG4("{}", "enabled streaming");
   m_streaming = true;
+
+  // Frames are copied when too few buffers are queued; have a buffer ready
+  ReserveImages(static_cast<VideoMode::PixelFormat>(m_mode.pixelFormat),
+                m_mode.width, m_mode.height, 1);
   return true;
 }
 
@@ -737,9 +822,42 @@ bool UsbCameraImpl::DeviceStreamOff() {
   }
   SDEBUG4("{}", "disabled streaming");
   m_streaming = false;
+  m_numQueued = 0;
   return true;
 }
 
+void UsbCameraImpl::DeviceRequeueBuffers() {
+  std::vector<std::pair<int, unsigned int>> returned;
+  {
+    std::scoped_lock lock(m_returnedBuffers->mutex);
+    if (m_returnedBuffers->buffers.empty()) {
+      return;
+    }
+    returned.swap(m_returnedBuffers->buffers);
+  }
+  int fd = m_fd.load();
+  for (auto&& [generation, index] : returned) {
+    if (generation != m_bufferGeneration || index >= kNumBuffers) {
+      continue;  // from a previous connection
+    }
+    m_bufferHeld[index] = false;
+    // if not streaming, DeviceStreamOn() will queue it
+    if (!m_streaming || fd < 0) {
+      continue;
+    }
+    struct v4l2_buffer buf;
+    std::memset(&buf, 0, sizeof(buf));
+    buf.index = index;
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    if (DoIoctl(fd, VIDIOC_QBUF, &buf) != 0) {
+      SWARNING("could not requeue buffer {}", index);
+      continue;
+    }
+    ++m_numQueued;
+  }
+}
+
 CS_StatusValue UsbCameraImpl::DeviceCmdSetMode(
     std::unique_lock<wpi::mutex>& lock, const Message& msg) {
   VideoMode newMode;
@@ -784,6 +902,7 @@ CS_StatusValue UsbCameraImpl::DeviceCmdSetMode(
       DeviceStreamOn();
     }
     m_notifier.NotifySourceVideoMode(*this, newMode);
+    UsbCameraCache::GetInstance().SetMode(m_cacheKey, newMode);
     lock.lock();
   } else if (newMode.fps != m_mode.fps) {
     m_mode = newMode;
@@ -798,19 +917,15 @@ CS_StatusValue UsbCameraImpl::DeviceCmdSetMode(
       DeviceStreamOn();
     }
     m_notifier.NotifySourceVideoMode(*this, newMode);
+    UsbCameraCache::GetInstance().SetMode(m_cacheKey, newMode);
     lock.lock();
   }
 
   return CS_OK;
 }
 
-CS_StatusValue UsbCameraImpl::DeviceCmdSetProperty(
-    std::unique_lock<wpi::mutex>& lock, const Message& msg) {
-  bool setString = (msg.kind == Message::kCmdSetPropertyStr);
-  int property = msg.data[0];
-  int value = msg.data[1];
-  std::string_view valueStr = msg.dataStr;
-
+CS_StatusValue UsbCameraImpl::ResolvePropertySet(int property, bool setString,
+                                                 int value, PropertySet* set) {
   // Look up
   auto prop = static_cast<UsbCameraProperty*>(GetProperty(property));
   if (!prop) {
@@ -846,25 +961,86 @@ CS_StatusValue UsbCameraImpl::DeviceCmdSetProperty(
     }
   }
 
+  *set = {prop, property, value, percentageProperty, percentageValue};
+  return CS_OK;
+}
+
+void UsbCameraImpl::FinishPropertySet(const PropertySet& set, bool setString,
+                                      std::string_view valueStr) {
+  if (!set.prop->device && set.prop->id == kPropConnectVerboseId) {
+    m_connectVerbose = set.value;
+  }
+
+  // Cache the set values
+  UpdatePropertyValue(set.property, setString, set.value, valueStr);
+  if (set.pairProperty != 0) {
+    UpdatePropertyValue(set.pairProperty, setString, set.pairValue, valueStr);
+  }
+}
+
+CS_StatusValue UsbCameraImpl::DeviceCmdSetProperty(
+    std::unique_lock<wpi::mutex>& lock, const Message& msg) {
+  bool setString = (msg.kind == Message::kCmdSetPropertyStr);
+  std::string_view valueStr = msg.dataStr;
+  PropertySet set;
+  CS_StatusValue status =
+      ResolvePropertySet(msg.data[0], setString, msg.data[1], &set);
+  if (status != CS_OK) {
+    return status;
+  }
+
   // Actually set the new value on the device (if possible)
-  if (!prop->device) {
-    if (prop->id == kPropConnectVerboseId) {
-      m_connectVerbose = value;
+  if (set.prop->device &&
+      !set.prop->DeviceSet(lock, m_fd, set.value, valueStr)) {
+    return CS_PROPERTY_WRITE_FAILED;
+  }
+
+  FinishPropertySet(set, setString, valueStr);
+  return CS_OK;
+}
+
+CS_StatusValue UsbCameraImpl::DeviceCmdSetProperties(
+    std::unique_lock<wpi::mutex>& lock, const Message& msg) {
+  CS_StatusValue result = CS_OK;
+  auto fail = [&](CS_StatusValue status) {
+    if (result == CS_OK) {
+      result = status;
     }
-  } else {
-    if (!prop->DeviceSet(lock, m_fd, value, valueStr)) {
-      return CS_PROPERTY_WRITE_FAILED;
+  };
+
+  std::vector<PropertySet> sets;
+  std::vector<UsbCameraProperty::DeviceValue> values;
+  std::vector<size_t> updateIndex;
+  for (size_t i = 0; i < msg.properties.size(); ++i) {
+    auto& update = msg.properties[i];
+    PropertySet set;
+    CS_StatusValue status = ResolvePropertySet(
+        update.property, update.setString, update.value, &set);
+    if (status != CS_OK) {
+      fail(status);
+      continue;
     }
+    sets.push_back(set);
+    values.push_back({set.prop, set.value, update.valueStr});
+    updateIndex.push_back(i);
   }
 
-  // Cache the set values
-  UpdatePropertyValue(property, setString, value, valueStr);
-  if (percentageProperty != 0) {
-    UpdatePropertyValue(percentageProperty, setString, percentageValue,
-                        valueStr);
+  // All of the device controls in as few ioctls as the driver allows
+  UsbCameraProperty::DeviceSetMany(lock, m_fd, values);
+
+  // Notify once for the whole batch
+  BeginPropertyBatch();
+  for (size_t i = 0; i < sets.size(); ++i) {
+    if (!values[i].ok) {
+      fail(CS_PROPERTY_WRITE_FAILED);
+      continue;
+    }
+    auto& update = msg.properties[updateIndex[i]];
+    FinishPropertySet(sets[i], update.setString, update.valueStr);
   }
+  EndPropertyBatch();
 
-  return CS_OK;
+  return result;
 }
 
 CS_StatusValue UsbCameraImpl::DeviceCmdSetPath(
@@ -897,6 +1073,8 @@ CS_StatusValue UsbCameraImpl::DeviceProcessCommand(
   } else if (msg.kind == Message::kCmdSetProperty ||
              msg.kind == Message::kCmdSetPropertyStr) {
     return DeviceCmdSetProperty(lock, msg);
+  } else if (msg.kind == Message::kCmdSetProperties) {
+    return DeviceCmdSetProperties(lock, msg);
   } else if (msg.kind == Message::kNumSinksChanged ||
              msg.kind == Message::kNumSinksEnabledChanged) {
     return CS_OK;
@@ -1023,12 +1201,28 @@ void UsbCameraImpl::DeviceCacheMode() {
   // Update format with user changes.
   bool formatChanged = false;
 
+  // Without user changes, the mode last used is preferred, so a program
+  // that sets the same mode every run doesn't have to switch to it
+  bool useCached =
+      std::any_of(m_videoModes.begin(), m_videoModes.end(),
+                  [&](const VideoMode& mode) {
+                    return mode.pixelFormat == m_cachedMode.pixelFormat &&
+                           mode.width == m_cachedMode.width &&
+                           mode.height == m_cachedMode.height;
+                  });
+
   if (m_modeSetPixelFormat) {
     // User set pixel format
     if (pixelFormat != m_mode.pixelFormat) {
       formatChanged = true;
       pixelFormat = static_cast<VideoMode::PixelFormat>(m_mode.pixelFormat);
     }
+  } else if (useCached) {
+    if (pixelFormat != m_cachedMode.pixelFormat) {
+      formatChanged = true;
+      pixelFormat =
+          static_cast<VideoMode::PixelFormat>(m_cachedMode.pixelFormat);
+    }
   } else {
     // Default to MJPEG
     if (pixelFormat != VideoMode::kMJPEG) {
@@ -1044,6 +1238,12 @@ void UsbCameraImpl::DeviceCacheMode() {
       width = m_mode.width;
       height = m_mode.height;
     }
+  } else if (useCached && pixelFormat == m_cachedMode.pixelFormat) {
+    if (width != m_cachedMode.width || height != m_cachedMode.height) {
+      formatChanged = true;
+      width = m_cachedMode.width;
+      height = m_cachedMode.height;
+    }
   } else {
     // Default to lowest known resolution (based on number of total pixels)
     int numPixels = width * height;
@@ -1063,9 +1263,17 @@ void UsbCameraImpl::DeviceCacheMode() {
 
   // Update FPS with user changes
   bool fpsChanged = false;
-  if (m_modeSetFPS && fps != m_mode.fps) {
+  if (m_modeSetFPS) {
+    if (fps != m_mode.fps) {
+      fpsChanged = true;
+      fps = m_mode.fps;
+    }
+  } else if (useCached && m_cachedMode.fps != 0 &&
+             pixelFormat == m_cachedMode.pixelFormat &&
+             width == m_cachedMode.width && height == m_cachedMode.height &&
+             fps != m_cachedMode.fps) {
     fpsChanged = true;
-    fps = m_mode.fps;
+    fps = m_cachedMode.fps;
   }
 
   // Save to global mode
@@ -1085,6 +1293,7 @@ void UsbCameraImpl::DeviceCacheMode() {
   }
 
   m_notifier.NotifySourceVideoMode(*this, m_mode);
+  UsbCameraCache::GetInstance().SetMode(m_cacheKey, m_mode);
 }
 
 void UsbCameraImpl::DeviceCacheProperty(
@@ -1194,11 +1403,9 @@ void UsbCameraImpl::DeviceCacheProperty(
   }
 }
 
-void UsbCameraImpl::DeviceCacheProperties() {
-  int fd = m_fd.load();
-  if (fd < 0) {
-    return;
-  }
+static std::vector<std::unique_ptr<UsbCameraProperty>> QueryDeviceProperties(
+    int fd) {
+  std::vector<std::unique_ptr<UsbCameraProperty>> props;
 
 #ifdef V4L2_CTRL_FLAG_NEXT_COMPOUND
   constexpr __u32 nextFlags =
@@ -1209,7 +1416,7 @@ void UsbCameraImpl::DeviceCacheProperties() {
   __u32 id = nextFlags;
 
   while (auto prop = UsbCameraProperty::DeviceQuery(fd, &id)) {
-    DeviceCacheProperty(std::move(prop));
+    props.emplace_back(std::move(prop));
     id |= nextFlags;
   }
 
@@ -1217,24 +1424,20 @@ void UsbCameraImpl::DeviceCacheProperties() {
     // try just enumerating standard...
     for (id = V4L2_CID_BASE; id < V4L2_CID_LASTP1; ++id) {
       if (auto prop = UsbCameraProperty::DeviceQuery(fd, &id)) {
-        DeviceCacheProperty(std::move(prop));
+        props.emplace_back(std::move(prop));
       }
     }
     // ... and custom controls
     std::unique_ptr<UsbCameraProperty> prop;
     for (id = V4L2_CID_PRIVATE_BASE;
          (prop = UsbCameraProperty::DeviceQuery(fd, &id)); ++id) {
-      DeviceCacheProperty(std::move(prop));
+      props.emplace_back(std::move(prop));
     }
   }
+  return props;
 }
 
-void UsbCameraImpl::DeviceCacheVideoModes() {
-  int fd = m_fd.load();
-  if (fd < 0) {
-    return;
-  }
-
+static std::vector<VideoMode> QueryDeviceVideoModes(int fd) {
   std::vector<VideoMode> modes;
 
   // Pixel formats
@@ -1277,6 +1480,31 @@ void UsbCameraImpl::DeviceCacheVideoModes() {
       }
     }
   }
+  return modes;
+}
+
+void UsbCameraImpl::DeviceCacheProperties() {
+  int fd = m_fd.load();
+  if (fd < 0) {
+    return;
+  }
+
+  auto props = QueryDeviceProperties(fd);
+  // before DeviceCacheProperty() renames percentage properties
+  UsbCameraCache::GetInstance().SetProperties(m_cacheKey, props);
+  for (auto& prop : props) {
+    DeviceCacheProperty(std::move(prop));
+  }
+}
+
+void UsbCameraImpl::DeviceCacheVideoModes() {
+  int fd = m_fd.load();
+  if (fd < 0) {
+    return;
+  }
+
+  std::vector<VideoMode> modes = QueryDeviceVideoModes(fd);
+  UsbCameraCache::GetInstance().SetVideoModes(m_cacheKey, modes);
 
   // The Pi camera reports mode ranges, which we don't currently handle, so only
   // provide a set of discrete modes; list based on
@@ -1304,6 +1532,59 @@ void UsbCameraImpl::DeviceCacheVideoModes() {
   m_notifier.NotifySource(*this, CS_SOURCE_VIDEOMODES_UPDATED);
 }
 
+bool UsbCameraImpl::DeviceLoadCache() {
+  auto& cache = UsbCameraCache::GetInstance();
+  std::vector<VideoMode> modes;
+  std::vector<std::unique_ptr<UsbCameraProperty>> props;
+  if (!cache.GetVideoModes(m_cacheKey, &modes, &m_cachedMode) ||
+      !cache.GetProperties(m_cacheKey, &props)) {
+    return false;
+  }
+
+  SDEBUG3("{}", "using cached properties");
+  for (auto& prop : props) {
+    DeviceCacheProperty(std::move(prop));
+  }
+
+  {
+    std::scoped_lock lock(m_mutex);
+    m_videoModes.swap(modes);
+  }
+  m_notifier.NotifySource(*this, CS_SOURCE_VIDEOMODES_UPDATED);
+  return true;
+}
+
+void UsbCameraImpl::StartCacheCheck() {
+  if (m_cacheCheckThread.joinable()) {
+    return;  // only checked once
+  }
+  m_cacheCheckThread = std::thread([this, path = m_path, key = m_cacheKey] {
+    WPI_TRACE_THREAD_NAME("cscore USB cache check");
+    // enumerating doesn't need the camera thread's descriptor
+    int fd = open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+      return;
+    }
+    auto modes = QueryDeviceVideoModes(fd);
+    auto props = QueryDeviceProperties(fd);
+    close(fd);
+
+    auto& cache = UsbCameraCache::GetInstance();
+    if (cache.SetProperties(key, props)) {
+      SINFO("{}", "camera properties changed since cached; will be updated "
+                  "when reopened");
+    }
+    if (!modes.empty() && cache.SetVideoModes(key, modes)) {
+      SDEBUG("{}", "camera video modes changed since cached");
+      {
+        std::scoped_lock lock(m_mutex);
+        m_videoModes.swap(modes);
+      }
+      m_notifier.NotifySource(*this, CS_SOURCE_VIDEOMODES_UPDATED);
+    }
+  });
+}
+
 CS_StatusValue UsbCameraImpl::SendAndWait(Message&& msg) const {
   int fd = m_command_fd.load();
   // exit early if not possible to signal
@@ -1411,6 +1692,17 @@ void UsbCameraImpl::SetStringProperty(int property, std::string_view value,
   *status = SendAndWait(std::move(msg));
 }
 
+void UsbCameraImpl::SetProperties(wpi::span<const PropertyUpdate> updates,
+                                  CS_Status* status) {
+  // One round trip to the camera thread for all of them
+  Message msg{Message::kCmdSetProperties};
+  msg.properties.assign(updates.begin(), updates.end());
+  CS_StatusValue rv = SendAndWait(std::move(msg));
+  if (rv != CS_OK && *status == 0) {
+    *status = rv;
+  }
+}
+
 void UsbCameraImpl::SetBrightness(int brightness, CS_Status* status) {
   if (brightness > 100) {
     brightness = 100;
@@ -42,6 +42,8 @@ class UsbCameraImpl : public SourceImpl {
   void SetProperty(int property, int value, CS_Status* status) override;
   void SetStringProperty(int property, std::string_view value,
                          CS_Status* status) override;
+  void SetProperties(wpi::span<const PropertyUpdate> updates,
+                     CS_Status* status) override;
 
   // Standard common camera properties
   void SetBrightness(int brightness, CS_Status* status) override;
@@ -76,6 +78,7 @@ class UsbCameraImpl : public SourceImpl {
       kCmdSetFPS,
       kCmdSetProperty,
       kCmdSetPropertyStr,
+      kCmdSetProperties,
       kNumSinksChanged,         // no response
       kNumSinksEnabledChanged,  // no response
       // Responses
@@ -89,6 +92,7 @@ class UsbCameraImpl : public SourceImpl {
     Kind kind;
     int data[4];
     std::string dataStr;
+    std::vector<PropertyUpdate> properties;  // for kCmdSetProperties
     std::thread::id from;
   };
 
@@ -116,12 +120,19 @@ class UsbCameraImpl : public SourceImpl {
   bool DeviceStreamOn();
   bool DeviceStreamOff();
   void DeviceProcessCommands();
+  void DeviceRequeueBuffers();
   void DeviceSetMode();
   void DeviceSetFPS();
   void DeviceCacheMode();
   void DeviceCacheProperty(std::unique_ptr<UsbCameraProperty> rawProp);
   void DeviceCacheProperties();
   void DeviceCacheVideoModes();
+  // Uses the modes and properties cached by an earlier run; returns false if
+  // there aren't any for this camera.
+  bool DeviceLoadCache();
+  // Checks the cached modes and properties against the device in the
+  // background, and updates them if they've changed.
+  void StartCacheCheck();
 
   // Command helper functions
   CS_StatusValue DeviceProcessCommand(std::unique_lock<wpi::mutex>& lock,
@@ -130,10 +141,30 @@ class UsbCameraImpl : public SourceImpl {
                                   const Message& msg);
   CS_StatusValue DeviceCmdSetProperty(std::unique_lock<wpi::mutex>& lock,
                                       const Message& msg);
+  CS_StatusValue DeviceCmdSetProperties(std::unique_lock<wpi::mutex>& lock,
+                                        const Message& msg);
   CS_StatusValue DeviceCmdSetPath(std::unique_lock<wpi::mutex>& lock,
                                   const Message& msg);
 
   // Property helper functions
+
+  // A property set resolved to the property to set on the device (the raw
+  // one, for a percentage property) and its paired property, if any
+  struct PropertySet {
+    UsbCameraProperty* prop;
+    int property;
+    int value;
+    int pairProperty;
+    int pairValue;
+  };
+  // Checks the kind and resolves a property set; must be called with m_mutex
+  // held
+  CS_StatusValue ResolvePropertySet(int property, bool setString, int value,
+                                    PropertySet* set);
+  // Caches the set values and applies software properties
+  void FinishPropertySet(const PropertySet& set, bool setString,
+                         std::string_view valueStr);
+
   int RawToPercentage(const UsbCameraProperty& rawProp, int rawValue);
   int PercentageToRaw(const UsbCameraProperty& rawProp, int percentValue);
 
@@ -148,15 +179,36 @@ class UsbCameraImpl : public SourceImpl {
   bool m_modeSetFPS{false};
   int m_connectVerbose{1};
   unsigned m_capabilities = 0;
+  std::string m_cacheKey;  // in UsbCameraCache
+  VideoMode m_cachedMode;  // mode last used, from the cache
   // Number of buffers to ask OS for
   static constexpr int kNumBuffers = 4;
-  std::array<UsbCameraBuffer, kNumBuffers> m_buffers;
+  // Frames wrap dequeued buffers (instead of copying them) only while at
+  // least this many are still queued, so slow sinks can't stall capture.
+  static constexpr int kMinQueuedBuffers = 2;
+  // Shared with the images wrapping them, so they stay mapped until the last
+  // frame using them is released, even across a reconnect.
+  std::array<std::shared_ptr<UsbCameraBuffer>, kNumBuffers> m_buffers;
+  std::array<bool, kNumBuffers> m_bufferHeld{};  // wrapped by an image
+  int m_numQueued{0};
+  int m_bufferGeneration{0};  // incremented when the buffers are unmapped
+
+  // Buffers given back by released frames, for the camera thread to requeue.
+  // Shared by the images, which may outlive the camera object.
+  struct ReturnedBuffers {
+    wpi::mutex mutex;
+    std::vector<std::pair<int, unsigned int>> buffers;  // generation, index
+    int command_fd{-1};                                 // to wake the thread
+  };
+  std::shared_ptr<ReturnedBuffers> m_returnedBuffers =
+      std::make_shared<ReturnedBuffers>();
 
   std::atomic_int m_fd;
   std::atomic_int m_command_fd;  // for command eventfd
 
   std::atomic_bool m_active;  // set to false to terminate thread
   std::thread m_cameraThread;
+  std::thread m_cacheCheckThread;
 
   // Quirks
   bool m_lifecam_exposure{false};    // Microsoft LifeCam exposure
@@ -4,6 +4,9 @@
 
 #include "UsbCameraProperty.h"
 
+#include <string>
+#include <vector>
+
 #include <fmt/format.h>
 #include <wpi/SmallString.h>
 
@@ -340,3 +343,98 @@ bool UsbCameraProperty::DeviceSet(std::unique_lock<wpi::mutex>& lock, int fd,
 
   return rv >= 0;
 }
+
+void UsbCameraProperty::DeviceSetMany(std::unique_lock<wpi::mutex>& lock,
+                                      int fd, wpi::span<DeviceValue> values) {
+  // Copy what's needed, as we're about to release the lock
+  struct Control {
+    DeviceValue* value;
+    unsigned id;
+    int type;
+    CS_PropertyKind kind;
+    std::string str;
+  };
+  std::vector<Control> controls;
+  for (auto&& value : values) {
+    auto prop = value.prop;
+    if (!prop->device || fd < 0) {
+      value.ok = true;
+      continue;
+    }
+    if ((prop->propKind & (CS_PROP_BOOLEAN | CS_PROP_INTEGER | CS_PROP_ENUM |
+                           CS_PROP_STRING)) == 0) {
+      continue;
+    }
+    controls.push_back(
+        {&value, prop->id, prop->type, prop->propKind,
+         prop->propKind == CS_PROP_STRING
+             ? std::string{value.valueStr.substr(0, prop->maximum)}
+             : std::string{}});
+  }
+  if (controls.empty()) {
+    return;
+  }
+
+  lock.unlock();
+  // Controls in one call must share a class; take the classes in the order
+  // they first appear, keeping the order of controls within each
+  std::vector<bool> done(controls.size());
+  std::vector<struct v4l2_ext_control> ctrls;
+  std::vector<size_t> batch;
+  for (size_t i = 0; i < controls.size(); ++i) {
+    if (done[i]) {
+      continue;
+    }
+    unsigned ctrlClass = V4L2_CTRL_ID2CLASS(controls[i].id);
+    ctrls.clear();
+    batch.clear();
+    for (size_t j = i; j < controls.size(); ++j) {
+      auto& control = controls[j];
+      if (done[j] || V4L2_CTRL_ID2CLASS(control.id) != ctrlClass) {
+        continue;
+      }
+      done[j] = true;
+      batch.push_back(j);
+      struct v4l2_ext_control ctrl;
+      std::memset(&ctrl, 0, sizeof(ctrl));
+      ctrl.id = control.id;
+      if (control.kind == CS_PROP_STRING) {
+        ctrl.size = control.str.size() + 1;
+        ctrl.string = control.str.data();
+      } else if (control.type == V4L2_CTRL_TYPE_INTEGER64) {
+        ctrl.value64 = control.value->value;
+      } else {
+        ctrl.value = control.value->value;
+      }
+      ctrls.push_back(ctrl);
+    }
+
+    struct v4l2_ext_controls extCtrls;
+    std::memset(&extCtrls, 0, sizeof(extCtrls));
+    extCtrls.ctrl_class = ctrlClass;
+    extCtrls.count = ctrls.size();
+    extCtrls.controls = ctrls.data();
+    if (ctrls.size() > 1 && DoIoctl(fd, VIDIOC_S_EXT_CTRLS, &extCtrls) >= 0) {
+      for (size_t j : batch) {
+        controls[j].value->ok = true;
+      }
+      continue;
+    }
+
+    // The driver doesn't take these together (or there's only one), so set
+    // each on its own, which also finds those that failed
+    for (size_t j : batch) {
+      auto& control = controls[j];
+      int rv;
+      if (control.kind == CS_PROP_STRING) {
+        rv = SetStringCtrlIoctl(fd, control.id, control.str.size(),
+                                control.str);
+      } else {
+        rv = SetIntCtrlIoctl(fd, control.id, control.type,
+                             control.value->value);
+      }
+      control.value->ok = rv >= 0;
+    }
+  }
+  lock.lock();
+}
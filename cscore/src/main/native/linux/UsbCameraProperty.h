@@ -11,6 +11,7 @@
 #include <string_view>
 
 #include <wpi/mutex.h>
+#include <wpi/span.h>
 
 #include "PropertyImpl.h"
 
@@ -58,6 +59,20 @@ class UsbCameraProperty : public PropertyImpl {
   bool DeviceSet(std::unique_lock<wpi::mutex>& lock, int fd, int newValue,
                  std::string_view newValueStr) const;
 
+  // A value to set in DeviceSetMany()
+  struct DeviceValue {
+    const UsbCameraProperty* prop;
+    int value;
+    std::string_view valueStr;
+    bool ok = false;  // set if it was set
+  };
+
+  // Sets several device properties, in order, with one VIDIOC_S_EXT_CTRLS
+  // per control class.  Where a driver rejects that, the controls are set
+  // one at a time instead.
+  static void DeviceSetMany(std::unique_lock<wpi::mutex>& lock, int fd,
+                            wpi::span<DeviceValue> values);
+
   // If this is a device (rather than software) property
   bool device{true};
 
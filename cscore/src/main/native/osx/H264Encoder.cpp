@@ -0,0 +1,12 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "H264Encoder.h"
+
+using namespace cs;
+
+std::unique_ptr<H264Encoder> H264Encoder::Create(const Settings& settings,
+                                                 wpi::Logger& logger) {
+  return nullptr;
+}
@@ -0,0 +1,17 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "SharedFrameRing.h"
+
+using namespace cs;
+
+std::unique_ptr<SharedFrameRing> SharedFrameRing::Create(std::string_view name,
+                                                         int numSlots,
+                                                         size_t slotSize) {
+  return nullptr;
+}
+
+std::unique_ptr<SharedFrameRing> SharedFrameRing::Open(std::string_view name) {
+  return nullptr;
+}
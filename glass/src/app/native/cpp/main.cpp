@@ -17,6 +17,7 @@
 #include "glass/networktables/NetworkTablesProvider.h"
 #include "glass/networktables/NetworkTablesSettings.h"
 #include "glass/other/Log.h"
+#include "glass/other/LogReplay.h"
 #include "glass/other/Plot.h"
 
 namespace gui = wpi::gui;
@@ -35,6 +36,7 @@ std::string_view GetResource_glass_512_png();
 
 static std::unique_ptr<glass::PlotProvider> gPlotProvider;
 static std::unique_ptr<glass::NetworkTablesProvider> gNtProvider;
+static std::unique_ptr<glass::LogReplayProvider> gLogReplayProvider;
 
 static std::unique_ptr<glass::NetworkTablesModel> gNetworkTablesModel;
 static std::unique_ptr<glass::NetworkTablesSettings> gNetworkTablesSettings;
@@ -139,11 +141,14 @@ int main() {
 
   gPlotProvider = std::make_unique<glass::PlotProvider>("Plot");
   gNtProvider = std::make_unique<glass::NetworkTablesProvider>("NTProvider");
+  gLogReplayProvider =
+      std::make_unique<glass::LogReplayProvider>("LogReplayWindow");
 
   gui::ConfigurePlatformSaveFile("glass.ini");
   gPlotProvider->GlobalInit();
   gui::AddInit([] { glass::ResetTime(); });
   gNtProvider->GlobalInit();
+  gLogReplayProvider->GlobalInit();
   gui::AddInit(NtInitialize);
 
   glass::AddStandardNetworkTablesViews(*gNtProvider);
@@ -180,6 +185,10 @@ int main() {
       gPlotProvider->DisplayMenu();
       ImGui::EndMenu();
     }
+    if (ImGui::BeginMenu("Log Replay")) {
+      gLogReplayProvider->DisplayMenu();
+      ImGui::EndMenu();
+    }
 
     bool about = false;
     if (ImGui::BeginMenu("Info")) {
@@ -210,6 +219,7 @@ int main() {
 
   gNetworkTablesModel.reset();
   gNetworkTablesSettings.reset();
+  gLogReplayProvider.reset();
   gNtProvider.reset();
   gPlotProvider.reset();
 
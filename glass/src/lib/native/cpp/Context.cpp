@@ -16,6 +16,7 @@
 #include <wpigui.h>
 
 #include "glass/ContextInternal.h"
+#include "glass/DataSource.h"
 
 using namespace glass;
 
@@ -177,6 +178,8 @@ static void Initialize(Context* ctx) {
 
     ctx->sources.Initialize();
   });
+
+  wpi::gui::AddEarlyExecute([] { DataSource::DeliverDeferred(); });
 }
 
 static void Shutdown(Context* ctx) {}
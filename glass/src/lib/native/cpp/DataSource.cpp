@@ -4,7 +4,11 @@
 
 #include "glass/DataSource.h"
 
+#include <algorithm>
+#include <utility>
+
 #include <fmt/format.h>
+#include <wpi/timestamp.h>
 
 #include "glass/ContextInternal.h"
 
@@ -28,10 +32,94 @@ DataSource::DataSource(std::string_view id, int index)
 DataSource::DataSource(std::string_view id, int index, int index2)
     : DataSource{fmt::format("{}[{},{}]", id, index, index2)} {}
 
+// A bounded multi-producer, single-consumer queue.  Producers claim a slot
+// with a single atomic increment and never wait; each slot has a sequence
+// number (odd while being written) so the consumer can tell when a slot is
+// complete and detect slots overwritten by producers that lapped it.
+struct DataSource::Queue {
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<double> value{0};
+    std::atomic<uint64_t> time{0};
+  };
+  Slot slots[kQueueSize];
+  std::atomic<uint64_t> writeIndex{0};
+  uint64_t readIndex = 0;  // consumer only
+};
+
+void DataSource::QueueValue(Queue* queue, double value, uint64_t time) {
+  if (time == 0) {
+    time = wpi::Now();
+  }
+  uint64_t index = queue->writeIndex.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = queue->slots[index % kQueueSize];
+  slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.value.store(value, std::memory_order_relaxed);
+  slot.time.store(time, std::memory_order_relaxed);
+  slot.seq.store(2 * index + 2, std::memory_order_release);
+}
+
+void DataSource::Deliver() {
+  auto queue = m_queueStorage.get();
+  for (;;) {
+    uint64_t index = queue->readIndex;
+    auto& slot = queue->slots[index % kQueueSize];
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq < 2 * index + 2) {
+      // not written yet (or still being written)
+      return;
+    }
+    if (seq == 2 * index + 2) {
+      double value = slot.value.load(std::memory_order_relaxed);
+      uint64_t time = slot.time.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq.load(std::memory_order_relaxed) == seq) {
+        ++queue->readIndex;
+        m_deferredValueChanged(value, time);
+        continue;
+      }
+    }
+    // overwritten; skip to the oldest value that can still be in the queue
+    uint64_t writeIndex = queue->writeIndex.load(std::memory_order_relaxed);
+    queue->readIndex =
+        (std::max)(index + 1, writeIndex > kQueueSize ? writeIndex - kQueueSize
+                                                      : uint64_t{0});
+  }
+}
+
+wpi::sig::Connection DataSource::ConnectDeferred(
+    std::function<void(double, uint64_t)> func) {
+  if (!m_queueStorage) {
+    m_queueStorage = std::make_unique<Queue>();
+    m_queue.store(m_queueStorage.get(), std::memory_order_release);
+    if (gContext) {
+      gContext->deferredSources.emplace_back(this);
+    }
+  }
+  return m_deferredValueChanged.connect_connection(std::move(func));
+}
+
+void DataSource::DeliverDeferred() {
+  if (!gContext) {
+    return;
+  }
+  // listeners may add sources
+  auto& sources = gContext->deferredSources;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    sources[i]->Deliver();
+  }
+}
+
 DataSource::~DataSource() {
   if (!gContext) {
     return;
   }
+  if (m_queueStorage) {
+    auto& sources = gContext->deferredSources;
+    sources.erase(std::remove(sources.begin(), sources.end(), this),
+                  sources.end());
+  }
   auto it = gContext->sources.find(m_id);
   if (it == gContext->sources.end()) {
     return;
@@ -155,8 +155,6 @@ class PoseFrameData {
   std::pair<int, float> IsHovered(const ImVec2& cursor) const;
   SelectedTargetInfo GetDragTarget(int corner, float dist) const;
   void HandleDrag(const ImVec2& cursor);
-  void Draw(ImDrawList* drawList, std::vector<ImVec2>* center,
-            std::vector<ImVec2>* left, std::vector<ImVec2>* right) const;
 
   // in window coordinates
   ImVec2 m_center;
@@ -178,6 +176,47 @@ class PoseFrameData {
   frc::Pose2d m_pose;
 };
 
+// Screen geometry of an object's poses, kept between frames.  Objects such as
+// trajectories can have thousands of poses, so the geometry is only rebuilt
+// when the poses, the field position or zoom, or the display options change,
+// and is thinned to what can be seen at the current zoom: lines are
+// simplified to within half a pixel, and boxes and arrows within a pixel of
+// the previous one drawn are skipped.
+class ObjectGeometry {
+ public:
+  void Update(wpi::span<const frc::Pose2d> poses, FieldObjectModel& model,
+              const FieldFrameData& ffd, const DisplayOptions& displayOptions);
+  void DrawPoses(ImDrawList* drawList,
+                 const DisplayOptions& displayOptions) const;
+
+  // in screen coordinates
+  std::vector<ImVec2> m_centerLine;
+  std::vector<ImVec2> m_leftLine;
+  std::vector<ImVec2> m_rightLine;
+
+ private:
+  bool IsCurrent(wpi::span<const frc::Pose2d> poses, const FieldFrameData& ffd,
+                 const DisplayOptions& displayOptions) const;
+
+  struct Shape {
+    ImVec2 corners[4];
+    ImVec2 arrow[3];
+  };
+  std::vector<Shape> m_shapes;
+
+  // what the geometry was built from
+  bool m_built = false;
+  std::vector<frc::Pose2d> m_poses;
+  ImVec2 m_min;
+  ImVec2 m_max;
+  float m_scale;
+  DisplayOptions::Style m_style;
+  units::meter_t m_width;
+  units::meter_t m_length;
+  bool m_arrows;
+  int m_arrowSize;
+};
+
 class ObjectInfo {
  public:
   ObjectInfo();
@@ -189,10 +228,14 @@ class ObjectInfo {
   void LoadImage();
   const gui::Texture& GetTexture() const { return m_texture; }
 
+  ObjectGeometry& GetGeometry() { return m_geometry; }
+
  private:
   void Reset();
   bool LoadImageImpl(const char* fn);
 
+  ObjectGeometry m_geometry;
+
   std::unique_ptr<pfd::open_file> m_fileOpener;
 
   // in meters
@@ -822,34 +865,164 @@ void PoseFrameData::HandleDrag(const ImVec2& cursor) {
   }
 }
 
-void PoseFrameData::Draw(ImDrawList* drawList, std::vector<ImVec2>* center,
-                         std::vector<ImVec2>* left,
-                         std::vector<ImVec2>* right) const {
-  switch (m_displayOptions.style) {
-    case DisplayOptions::kBoxImage:
-      if (m_displayOptions.texture) {
-        drawList->AddImageQuad(m_displayOptions.texture, m_corners[0],
-                               m_corners[1], m_corners[2], m_corners[3]);
-        return;
+// squared distance from p to the segment from a to b
+static float GetSegmentDistSquared(const ImVec2& p, const ImVec2& a,
+                                   const ImVec2& b) {
+  ImVec2 ab = b - a;
+  float len2 = ab.x * ab.x + ab.y * ab.y;
+  float t = 0;
+  if (len2 > 0) {
+    ImVec2 ap = p - a;
+    t = std::clamp((ap.x * ab.x + ap.y * ab.y) / len2, 0.0f, 1.0f);
+  }
+  return gui::GetDistSquared(p, a + ab * t);
+}
+
+// Ramer-Douglas-Peucker simplification
+static void SimplifyLine(std::vector<ImVec2>* line, float tolerance) {
+  auto& points = *line;
+  if (points.size() <= 2) {
+    return;
+  }
+  float tolerance2 = tolerance * tolerance;
+  std::vector<bool> keep(points.size(), false);
+  keep.front() = true;
+  keep.back() = true;
+  std::vector<std::pair<size_t, size_t>> stack{{0, points.size() - 1}};
+  while (!stack.empty()) {
+    auto [first, last] = stack.back();
+    stack.pop_back();
+    float maxDist = 0;
+    size_t farthest = first;
+    for (size_t i = first + 1; i < last; ++i) {
+      float dist =
+          GetSegmentDistSquared(points[i], points[first], points[last]);
+      if (dist > maxDist) {
+        maxDist = dist;
+        farthest = i;
       }
-      drawList->AddQuad(m_corners[0], m_corners[1], m_corners[2], m_corners[3],
-                        m_displayOptions.color, m_displayOptions.weight);
-      break;
-    case DisplayOptions::kLine:
-    case DisplayOptions::kLineClosed:
-      center->emplace_back(m_center);
-      break;
-    case DisplayOptions::kTrack:
-      center->emplace_back(m_center);
-      left->emplace_back(m_corners[4]);
-      right->emplace_back(m_corners[5]);
-      break;
+    }
+    if (maxDist > tolerance2) {
+      keep[farthest] = true;
+      stack.emplace_back(first, farthest);
+      stack.emplace_back(farthest, last);
+    }
+  }
+  size_t j = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (keep[i]) {
+      points[j++] = points[i];
+    }
+  }
+  points.resize(j);
+}
+
+// whether every point of a is within a pixel of the same point of b
+template <size_t N>
+static bool IsSameOnScreen(const ImVec2 (&a)[N], const ImVec2 (&b)[N]) {
+  for (size_t i = 0; i < N; ++i) {
+    if (gui::GetDistSquared(a[i], b[i]) > 1.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ObjectGeometry::IsCurrent(wpi::span<const frc::Pose2d> poses,
+                               const FieldFrameData& ffd,
+                               const DisplayOptions& displayOptions) const {
+  return m_built && ffd.min.x == m_min.x && ffd.min.y == m_min.y &&
+         ffd.max.x == m_max.x && ffd.max.y == m_max.y &&
+         ffd.scale == m_scale && displayOptions.style == m_style &&
+         displayOptions.width == m_width &&
+         displayOptions.length == m_length &&
+         displayOptions.arrows == m_arrows &&
+         displayOptions.arrowSize == m_arrowSize &&
+         std::equal(poses.begin(), poses.end(), m_poses.begin(),
+                    m_poses.end(),
+                    [](const frc::Pose2d& a, const frc::Pose2d& b) {
+                      return a.X().to<double>() == b.X().to<double>() &&
+                             a.Y().to<double>() == b.Y().to<double>() &&
+                             a.Rotation().Radians().to<double>() ==
+                                 b.Rotation().Radians().to<double>();
+                    });
+}
+
+void ObjectGeometry::Update(wpi::span<const frc::Pose2d> poses,
+                            FieldObjectModel& model, const FieldFrameData& ffd,
+                            const DisplayOptions& displayOptions) {
+  if (IsCurrent(poses, ffd, displayOptions)) {
+    return;
+  }
+  m_built = true;
+  m_poses.assign(poses.begin(), poses.end());
+  m_min = ffd.min;
+  m_max = ffd.max;
+  m_scale = ffd.scale;
+  m_style = displayOptions.style;
+  m_width = displayOptions.width;
+  m_length = displayOptions.length;
+  m_arrows = displayOptions.arrows;
+  m_arrowSize = displayOptions.arrowSize;
+
+  m_shapes.resize(0);
+  m_centerLine.resize(0);
+  m_leftLine.resize(0);
+  m_rightLine.resize(0);
+  bool shapes = m_style == DisplayOptions::kBoxImage || m_arrows;
+  size_t i = 0;
+  for (auto&& pose : poses) {
+    PoseFrameData pfd{pose, model, i++, ffd, displayOptions};
+    switch (m_style) {
+      case DisplayOptions::kBoxImage:
+        break;
+      case DisplayOptions::kLine:
+      case DisplayOptions::kLineClosed:
+        m_centerLine.emplace_back(pfd.m_center);
+        break;
+      case DisplayOptions::kTrack:
+        m_centerLine.emplace_back(pfd.m_center);
+        m_leftLine.emplace_back(pfd.m_corners[4]);
+        m_rightLine.emplace_back(pfd.m_corners[5]);
+        break;
+    }
+    if (shapes) {
+      Shape shape;
+      std::copy_n(pfd.m_corners, 4, shape.corners);
+      std::copy_n(pfd.m_arrow, 3, shape.arrow);
+      if (m_shapes.empty() ||
+          !IsSameOnScreen(shape.corners, m_shapes.back().corners) ||
+          !IsSameOnScreen(shape.arrow, m_shapes.back().arrow)) {
+        m_shapes.emplace_back(shape);
+      }
+    }
   }
 
-  if (m_displayOptions.arrows) {
-    drawList->AddTriangle(m_arrow[0], m_arrow[1], m_arrow[2],
-                          m_displayOptions.arrowColor,
-                          m_displayOptions.arrowWeight);
+  SimplifyLine(&m_centerLine, 0.5f);
+  SimplifyLine(&m_leftLine, 0.5f);
+  SimplifyLine(&m_rightLine, 0.5f);
+}
+
+void ObjectGeometry::DrawPoses(ImDrawList* drawList,
+                               const DisplayOptions& displayOptions) const {
+  for (auto&& shape : m_shapes) {
+    if (m_style == DisplayOptions::kBoxImage) {
+      if (displayOptions.texture) {
+        drawList->AddImageQuad(displayOptions.texture, shape.corners[0],
+                               shape.corners[1], shape.corners[2],
+                               shape.corners[3]);
+        // arrows are not drawn over images
+        continue;
+      }
+      drawList->AddQuad(shape.corners[0], shape.corners[1], shape.corners[2],
+                        shape.corners[3], displayOptions.color,
+                        displayOptions.weight);
+    }
+    if (m_arrows) {
+      drawList->AddTriangle(shape.arrow[0], shape.arrow[1], shape.arrow[2],
+                            displayOptions.arrowColor,
+                            displayOptions.arrowWeight);
+    }
   }
 }
 
@@ -919,9 +1092,6 @@ class FieldDisplay {
 
   // splitter so lines are put behind arrows
   ImDrawListSplitter m_drawSplit;
-
-  // lines; static so buffer gets reused
-  std::vector<ImVec2> m_centerLine, m_leftLine, m_rightLine;
 };
 }  // namespace
 
@@ -1032,44 +1202,47 @@ void FieldDisplay::DisplayObject(FieldObjectModel& model,
 
   auto displayOptions = obj->GetDisplayOptions();
 
-  m_centerLine.resize(0);
-  m_leftLine.resize(0);
-  m_rightLine.resize(0);
-
-  m_drawSplit.Split(m_drawList, 2);
-  m_drawSplit.SetCurrentChannel(m_drawList, 1);
   auto poses = gPopupState.GetInsertModel() == &model
                    ? gPopupState.GetInsertPoses()
                    : model.GetPoses();
-  size_t i = 0;
-  for (auto&& pose : poses) {
-    PoseFrameData pfd{pose, model, i, m_ffd, displayOptions};
-
-    // check for potential drag targets
-    if (displayOptions.selectable && m_isHovered &&
-        !gDragState.target.objModel) {
-      auto [corner, dist] = pfd.IsHovered(m_mousePos);
-      if (corner > 0) {
-        m_targets.emplace_back(pfd.GetDragTarget(corner, dist));
-        m_targets.back().name = name;
-        m_targets.back().index = i;
+
+  // hit testing and dragging look at every pose, but only while hovered
+  bool isDragged = gDragState.target.objModel == &model;
+  bool isHitTested = displayOptions.selectable && m_isHovered &&
+                     !gDragState.target.objModel;
+  if (isDragged || isHitTested) {
+    size_t i = 0;
+    for (auto&& pose : poses) {
+      PoseFrameData pfd{pose, model, i, m_ffd, displayOptions};
+
+      // check for potential drag targets
+      if (isHitTested) {
+        auto [corner, dist] = pfd.IsHovered(m_mousePos);
+        if (corner > 0) {
+          m_targets.emplace_back(pfd.GetDragTarget(corner, dist));
+          m_targets.back().name = name;
+          m_targets.back().index = i;
+        }
       }
-    }
 
-    // handle active dragging of this object
-    if (gDragState.target.objModel == &model && gDragState.target.index == i) {
-      pfd.HandleDrag(m_mousePos);
+      // handle active dragging of this object
+      if (isDragged && gDragState.target.index == i) {
+        pfd.HandleDrag(m_mousePos);
+      }
+      ++i;
     }
-
-    // draw
-    pfd.Draw(m_drawList, &m_centerLine, &m_leftLine, &m_rightLine);
-    ++i;
   }
 
+  // draw
+  auto& geometry = obj->GetGeometry();
+  geometry.Update(poses, model, m_ffd, displayOptions);
+  m_drawSplit.Split(m_drawList, 2);
+  m_drawSplit.SetCurrentChannel(m_drawList, 1);
+  geometry.DrawPoses(m_drawList, displayOptions);
   m_drawSplit.SetCurrentChannel(m_drawList, 0);
-  obj->DrawLine(m_drawList, m_centerLine);
-  obj->DrawLine(m_drawList, m_leftLine);
-  obj->DrawLine(m_drawList, m_rightLine);
+  obj->DrawLine(m_drawList, geometry.m_centerLine);
+  obj->DrawLine(m_drawList, geometry.m_leftLine);
+  obj->DrawLine(m_drawList, geometry.m_rightLine);
   m_drawSplit.Merge(m_drawList);
 
   PopID();
@@ -0,0 +1,570 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "glass/other/LogReplay.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <frc/geometry/Pose2d.h>
+#include <frc/geometry/Pose2dArrayEncoding.h>
+#include <imgui.h>
+#include <portable-file-dialogs.h>
+#include <units/angle.h>
+#include <units/length.h>
+#include <wpi/StringExtras.h>
+#include <wpi/timestamp.h>
+#include <wpigui.h>
+
+#include "glass/Context.h"
+#include "glass/DataSource.h"
+
+using namespace glass;
+using wpi::log::DataLogIndex;
+using wpi::log::DataLogRecord;
+
+namespace gui = wpi::gui;
+
+// records delivered to each data source per frame at most; at high speeds
+// only the latest are delivered, which is all a plot can show anyway
+static constexpr size_t kMaxRecordsPerFrame = DataSource::kQueueSize;
+
+namespace {
+enum EntryKind {
+  kBoolean,
+  kInteger,
+  kFloat,
+  kDouble,
+  kBooleanArray,
+  kIntegerArray,
+  kFloatArray,
+  kDoubleArray
+};
+}  // namespace
+
+static bool GetEntryKind(std::string_view type, EntryKind* kind) {
+  static constexpr std::string_view kTypes[] = {
+      "boolean",   "int64",   "float",   "double",
+      "boolean[]", "int64[]", "float[]", "double[]"};
+  auto it = std::find(std::begin(kTypes), std::end(kTypes), type);
+  if (it == std::end(kTypes)) {
+    return false;
+  }
+  *kind = static_cast<EntryKind>(it - std::begin(kTypes));
+  return true;
+}
+
+struct LogReplayModel::EntrySources {
+  EntrySources(const DataLogIndex::Entry& entry, EntryKind kind)
+      : entry{entry}, kind{kind}, id{fmt::format("log:{}", entry.name)} {}
+
+  const DataLogIndex::Entry& entry;
+  EntryKind kind;
+  std::string id;
+  // index of the next record to deliver
+  size_t next = 0;
+  // created as array elements are seen
+  std::vector<std::unique_ptr<DataSource>> sources;
+};
+
+LogReplayModel::LogReplayModel() = default;
+
+LogReplayModel::~LogReplayModel() = default;
+
+bool LogReplayModel::Open(std::string_view filename, std::string* error) {
+  std::error_code ec;
+  auto index = std::make_unique<DataLogIndex>(fs::path{filename}, ec);
+  if (ec) {
+    *error = fmt::format("could not open '{}': {}", filename, ec.message());
+    return false;
+  }
+  if (!index->IsValid()) {
+    *error = fmt::format("'{}' is not a data log", filename);
+    return false;
+  }
+
+  Close();
+  m_filename = filename;
+  m_index = std::move(index);
+  for (auto&& entry : m_index->GetEntries()) {
+    EntryKind kind;
+    if (GetEntryKind(entry.type, &kind)) {
+      m_sources.emplace_back(std::make_unique<EntrySources>(entry, kind));
+    }
+  }
+  Reset(m_index->GetStartTimestamp(), wpi::Now());
+  return true;
+}
+
+void LogReplayModel::Close() {
+  // the sources refer to the index
+  m_sources.clear();
+  m_index.reset();
+  m_filename.clear();
+  m_time = 0;
+  m_playing = false;
+}
+
+int64_t LogReplayModel::GetStartTime() const {
+  return m_index ? m_index->GetStartTimestamp() : 0;
+}
+
+int64_t LogReplayModel::GetEndTime() const {
+  return m_index ? m_index->GetEndTimestamp() : 0;
+}
+
+void LogReplayModel::Seek(int64_t time) {
+  if (m_index) {
+    Reset(std::clamp(time, GetStartTime(), GetEndTime()), wpi::Now());
+  }
+}
+
+void LogReplayModel::Play() {
+  if (!m_index) {
+    return;
+  }
+  // play from the start again once the end is reached
+  if (m_time >= GetEndTime()) {
+    Seek(GetStartTime());
+  }
+  m_playing = true;
+  m_lastUpdate = wpi::Now();
+}
+
+bool LogReplayModel::GetRecord(const DataLogIndex::Entry& entry,
+                               DataLogRecord* record) const {
+  if (!m_index) {
+    return false;
+  }
+  size_t i = m_index->Seek(entry, m_time);
+  if (i == DataLogIndex::kNone) {
+    return false;
+  }
+  *record = m_index->GetRecord(entry, i);
+  return true;
+}
+
+void LogReplayModel::ForEachSource(
+    wpi::function_ref<void(DataSource& source, std::string_view name)> func) {
+  for (auto&& sources : m_sources) {
+    for (auto&& source : sources->sources) {
+      // the ID is "log:" followed by the name
+      func(*source, std::string_view{source->GetId()}.substr(4));
+    }
+  }
+}
+
+void LogReplayModel::Update() {
+  if (!m_index || !m_playing) {
+    return;
+  }
+  uint64_t now = wpi::Now();
+  int64_t time =
+      m_time + static_cast<int64_t>((now - m_lastUpdate) * m_speed);
+  m_lastUpdate = now;
+  if (time >= GetEndTime()) {
+    time = GetEndTime();
+    m_playing = false;
+  }
+  Advance(time, now);
+}
+
+void LogReplayModel::Advance(int64_t time, uint64_t now) {
+  for (auto&& sources : m_sources) {
+    size_t end = m_index->Seek(sources->entry, time) + 1;  // kNone wraps to 0
+    if (end <= sources->next) {
+      continue;
+    }
+    if (end - sources->next > kMaxRecordsPerFrame) {
+      sources->next = end - kMaxRecordsPerFrame;
+    }
+    for (; sources->next < end; ++sources->next) {
+      auto record = m_index->GetRecord(sources->entry, sources->next);
+      // map the log time onto the wall clock, relative to now
+      int64_t ago =
+          static_cast<int64_t>((time - record.GetTimestamp()) / m_speed);
+      SetValues(*sources, record, now - ago);
+    }
+  }
+  m_time = time;
+}
+
+void LogReplayModel::Reset(int64_t time, uint64_t now) {
+  for (auto&& sources : m_sources) {
+    size_t i = m_index->Seek(sources->entry, time);
+    if (i == DataLogIndex::kNone) {
+      sources->next = 0;
+    } else {
+      SetValues(*sources, m_index->GetRecord(sources->entry, i), now);
+      sources->next = i + 1;
+    }
+  }
+  m_time = time;
+}
+
+void LogReplayModel::SetValues(EntrySources& sources,
+                               const DataLogRecord& record, uint64_t time) {
+  m_values.clear();
+  switch (sources.kind) {
+    case kBoolean: {
+      bool value;
+      if (record.GetBoolean(&value)) {
+        m_values.push_back(value ? 1 : 0);
+      }
+      break;
+    }
+    case kInteger: {
+      int64_t value;
+      if (record.GetInteger(&value)) {
+        m_values.push_back(value);
+      }
+      break;
+    }
+    case kFloat: {
+      float value;
+      if (record.GetFloat(&value)) {
+        m_values.push_back(value);
+      }
+      break;
+    }
+    case kDouble: {
+      double value;
+      if (record.GetDouble(&value)) {
+        m_values.push_back(value);
+      }
+      break;
+    }
+    case kBooleanArray: {
+      std::vector<int> arr;
+      if (record.GetBooleanArray(&arr)) {
+        m_values.assign(arr.begin(), arr.end());
+      }
+      break;
+    }
+    case kIntegerArray: {
+      std::vector<int64_t> arr;
+      if (record.GetIntegerArray(&arr)) {
+        m_values.assign(arr.begin(), arr.end());
+      }
+      break;
+    }
+    case kFloatArray: {
+      std::vector<float> arr;
+      if (record.GetFloatArray(&arr)) {
+        m_values.assign(arr.begin(), arr.end());
+      }
+      break;
+    }
+    case kDoubleArray:
+      record.GetDoubleArray(&m_values);
+      break;
+  }
+
+  bool isArray = sources.kind >= kBooleanArray;
+  bool digital = sources.kind == kBoolean || sources.kind == kBooleanArray;
+  for (size_t i = 0; i < m_values.size(); ++i) {
+    if (i >= sources.sources.size()) {
+      auto source = isArray ? std::make_unique<DataSource>(
+                                  sources.id, static_cast<int>(i))
+                            : std::make_unique<DataSource>(sources.id);
+      source->SetDigital(digital);
+      sources.sources.emplace_back(std::move(source));
+    }
+    sources.sources[i]->SetValue(m_values[i], time);
+  }
+}
+
+class LogReplayField2DModel::ObjectModel : public FieldObjectModel {
+ public:
+  // entry is nullptr for objects added by the user
+  ObjectModel(std::string_view name, const DataLogIndex::Entry* entry)
+      : m_name{name}, m_entry{entry} {}
+
+  const char* GetName() const override { return m_name.c_str(); }
+
+  void Update(const LogReplayModel& replay);
+  void Update() override {}
+  bool Exists() override { return true; }
+  bool IsReadOnly() override { return m_entry != nullptr; }
+
+  wpi::span<const frc::Pose2d> GetPoses() override { return m_poses; }
+  void SetPoses(wpi::span<const frc::Pose2d> poses) override {
+    m_poses.assign(poses.begin(), poses.end());
+  }
+  void SetPose(size_t i, frc::Pose2d pose) override {
+    if (i < m_poses.size()) {
+      m_poses[i] = pose;
+    }
+  }
+  void SetPosition(size_t i, frc::Translation2d pos) override {
+    if (i < m_poses.size()) {
+      m_poses[i] = frc::Pose2d{pos, m_poses[i].Rotation()};
+    }
+  }
+  void SetRotation(size_t i, frc::Rotation2d rot) override {
+    if (i < m_poses.size()) {
+      m_poses[i] = frc::Pose2d{m_poses[i].Translation(), rot};
+    }
+  }
+
+ private:
+  std::string m_name;
+  const DataLogIndex::Entry* m_entry;
+  // the record the poses were decoded from
+  const uint8_t* m_recordData = nullptr;
+  std::vector<frc::Pose2d> m_poses;
+};
+
+void LogReplayField2DModel::ObjectModel::Update(const LogReplayModel& replay) {
+  if (!m_entry) {
+    return;
+  }
+  DataLogRecord record;
+  if (!replay.GetRecord(*m_entry, &record)) {
+    m_recordData = nullptr;
+    m_poses.clear();
+    return;
+  }
+  // only decode when the value changes
+  if (record.GetRaw().data() == m_recordData) {
+    return;
+  }
+  m_recordData = record.GetRaw().data();
+
+  if (m_entry->type == "raw") {
+    auto raw = record.GetRaw();
+    std::string_view data{reinterpret_cast<const char*>(raw.data()),
+                          raw.size()};
+    if (auto size = frc::GetEncodedPose2dArraySize(data)) {
+      m_poses.resize(*size);
+      if (!frc::DecodePose2dArray(data, m_poses)) {
+        m_poses.clear();
+      }
+    }
+    return;
+  }
+
+  std::vector<double> arr;
+  if (!record.GetDoubleArray(&arr) || (arr.size() % 3) != 0) {
+    return;
+  }
+  m_poses.resize(arr.size() / 3);
+  for (size_t i = 0; i < arr.size() / 3; ++i) {
+    m_poses[i] = frc::Pose2d{
+        units::meter_t{arr[i * 3 + 0]}, units::meter_t{arr[i * 3 + 1]},
+        frc::Rotation2d{units::degree_t{arr[i * 3 + 2]}}};
+  }
+}
+
+LogReplayField2DModel::LogReplayField2DModel(LogReplayModel& replay,
+                                             std::string_view path)
+    : m_replay{replay}, m_path{path} {}
+
+LogReplayField2DModel::~LogReplayField2DModel() = default;
+
+void LogReplayField2DModel::SetPath(std::string_view path) {
+  if (path != m_path) {
+    m_path = path;
+    m_index = nullptr;
+  }
+}
+
+void LogReplayField2DModel::Update() {
+  // find the objects when the path or log changes
+  if (m_replay.GetIndex() != m_index) {
+    m_index = m_replay.GetIndex();
+    m_objects.clear();
+    if (m_index && !m_path.empty()) {
+      for (auto&& entry : m_index->GetEntries()) {
+        if (entry.type != "double[]" && entry.type != "raw") {
+          continue;
+        }
+        if (!wpi::starts_with(entry.name, m_path) ||
+            entry.name.size() <= m_path.size() + 1 ||
+            entry.name[m_path.size()] != '/') {
+          continue;
+        }
+        auto name = entry.name.substr(m_path.size() + 1);
+        if (name[0] == '.' || name.find('/') != std::string_view::npos) {
+          continue;
+        }
+        // an object restarted with the same name replaces the earlier one
+        auto it = std::find_if(
+            m_objects.begin(), m_objects.end(),
+            [&](const auto& object) { return object->GetName() == name; });
+        auto object = std::make_unique<ObjectModel>(name, &entry);
+        if (it == m_objects.end()) {
+          m_objects.emplace_back(std::move(object));
+        } else {
+          *it = std::move(object);
+        }
+      }
+    }
+  }
+
+  for (auto&& object : m_objects) {
+    object->Update(m_replay);
+  }
+}
+
+FieldObjectModel* LogReplayField2DModel::AddFieldObject(
+    std::string_view name) {
+  auto it = std::find_if(
+      m_objects.begin(), m_objects.end(),
+      [&](const auto& object) { return object->GetName() == name; });
+  if (it != m_objects.end()) {
+    return it->get();
+  }
+  return m_objects.emplace_back(std::make_unique<ObjectModel>(name, nullptr))
+      .get();
+}
+
+void LogReplayField2DModel::RemoveFieldObject(std::string_view name) {
+  m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(),
+                                 [&](const auto& object) {
+                                   return object->GetName() == name;
+                                 }),
+                  m_objects.end());
+}
+
+void LogReplayField2DModel::ForEachFieldObject(
+    wpi::function_ref<void(FieldObjectModel& model, std::string_view name)>
+        func) {
+  for (auto&& object : m_objects) {
+    func(*object, object->GetName());
+  }
+}
+
+namespace {
+struct ReplayUi {
+  std::unique_ptr<pfd::open_file> fileOpener;
+  std::string error;
+};
+}  // namespace
+
+void glass::DisplayLogReplay(LogReplayModel* model,
+                             LogReplayField2DModel* field) {
+  auto& storage = GetStorage();
+  auto ui = storage.GetData<ReplayUi>();
+  if (!ui) {
+    storage.SetData(std::make_shared<ReplayUi>());
+    ui = storage.GetData<ReplayUi>();
+  }
+
+  if (ImGui::Button("Open...")) {
+    ui->fileOpener = std::make_unique<pfd::open_file>(
+        "Choose data log", "",
+        std::vector<std::string>{"Data Log", "*.wpilog", "All Files", "*"});
+  }
+  if (ui->fileOpener && ui->fileOpener->ready(0)) {
+    auto result = ui->fileOpener->result();
+    if (!result.empty()) {
+      ui->error.clear();
+      model->Open(result[0], &ui->error);
+    }
+    ui->fileOpener.reset();
+  }
+  ImGui::SameLine();
+  ImGui::TextUnformatted(model->Exists() ? model->GetFilename().c_str()
+                                         : "<no log>");
+  if (!ui->error.empty()) {
+    ImGui::TextUnformatted(ui->error.c_str());
+  }
+  if (!model->Exists()) {
+    return;
+  }
+
+  if (ImGui::Button(model->IsPlaying() ? "Pause" : "Play")) {
+    if (model->IsPlaying()) {
+      model->Pause();
+    } else {
+      model->Play();
+    }
+  }
+  ImGui::SameLine();
+  float speed = model->GetSpeed();
+  ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+  if (ImGui::SliderFloat("Speed", &speed, 0.1f, 16.0f, "%.2fx",
+                         ImGuiSliderFlags_Logarithmic)) {
+    model->SetSpeed(speed);
+  }
+
+  // times relative to the start of the log, in seconds
+  int64_t start = model->GetStartTime();
+  float time = (model->GetTime() - start) * 1.0e-6f;
+  float duration = (model->GetEndTime() - start) * 1.0e-6f;
+  ImGui::SetNextItemWidth(-1);
+  if (ImGui::SliderFloat("##time", &time, 0.0f, duration, "%.3f s")) {
+    model->Seek(start + static_cast<int64_t>(time * 1.0e6));
+  }
+
+  if (field) {
+    // field tables are recognized by their ".type" entry, as logged from
+    // NetworkTables
+    std::string_view path = field->GetPath();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16);
+    if (ImGui::BeginCombo("Field", path.empty() ? "<none>" : path.data())) {
+      for (auto&& entry : model->GetIndex()->GetEntries()) {
+        if (entry.type != "string" || !wpi::ends_with(entry.name, "/.type")) {
+          continue;
+        }
+        std::string_view type;
+        if (entry.offsets.empty() ||
+            !model->GetIndex()->GetRecord(entry, 0).GetString(&type) ||
+            type != "Field2d") {
+          continue;
+        }
+        auto table = entry.name.substr(0, entry.name.size() - 6);
+        if (ImGui::Selectable(std::string{table}.c_str(), table == path)) {
+          field->SetPath(table);
+        }
+      }
+      ImGui::EndCombo();
+    }
+  }
+
+  ImGui::Separator();
+  ImGui::BeginChild("sources");
+  model->ForEachSource([](DataSource& source, std::string_view name) {
+    std::string label{name};
+    if (source.IsDigital()) {
+      source.LabelText(label.c_str(), "%s",
+                       source.GetValue() != 0 ? "true" : "false");
+    } else {
+      source.LabelText(label.c_str(), "%.6g", source.GetValue());
+    }
+  });
+  ImGui::EndChild();
+}
+
+LogReplayProvider::LogReplayProvider(std::string_view iniName)
+    : WindowManager{iniName} {}
+
+LogReplayProvider::~LogReplayProvider() = default;
+
+void LogReplayProvider::GlobalInit() {
+  WindowManager::GlobalInit();
+  gui::AddEarlyExecute([this] {
+    m_model.Update();
+    m_field.Update();
+  });
+  if (auto win = AddWindow(
+          "Log Replay", [this] { DisplayLogReplay(&m_model, &m_field); })) {
+    win->SetDefaultSize(400, 300);
+  }
+  if (auto win =
+          AddWindow("Log Field", std::make_unique<Field2DView>(&m_field))) {
+    win->SetDefaultSize(400, 200);
+  }
+}
+
+void LogReplayProvider::DisplayMenu() {
+  for (auto&& window : m_windows) {
+    window->DisplayMenuItem();
+  }
+}
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <memory>
@@ -76,6 +77,16 @@ class PlotSeries {
   }
   void AppendValue(double value, uint64_t time);
 
+  // Returns the i'th oldest stored point
+  const ImPlotPoint& At(int i) const {
+    int index = m_offset + i;
+    return m_data[index < m_size ? index : index - m_size];
+  }
+  void Push(double time, double value);
+  void SetCapacity(int capacity);
+  int LowerBound(double time) const;
+  void Decimate(double xMin, double xMax, int width);
+
   // source linkage
   DataSource* m_source = nullptr;
   wpi::sig::ScopedConnection m_sourceCreatedConn;
@@ -94,12 +105,33 @@ class PlotSeries {
   int m_digitalBitHeight = 8;
   int m_digitalBitGap = 4;
 
-  // value storage
-  static constexpr int kMaxSize = 2000;
+  // value storage: a ring of up to m_capacity points in time order, that
+  // grows as values are added
+  static constexpr int kDefaultCapacity = 20000;
+  static constexpr int kMinCapacity = 100;
+  static constexpr int kMaxCapacity = 10000000;
   static constexpr double kTimeGap = 0.05;
+  int m_capacity = kDefaultCapacity;
   std::atomic<int> m_size = 0;
   std::atomic<int> m_offset = 0;
-  ImPlotPoint m_data[kMaxSize];
+  std::vector<ImPlotPoint> m_data;
+  // incremented whenever the stored points change
+  uint64_t m_version = 0;
+
+  // the stored points in the visible range, decimated to the plot width;
+  // only recomputed when the points or the range change
+  std::vector<ImPlotPoint> m_plotData;
+  struct PlotDataKey {
+    double xMin = 0;
+    double xMax = 0;
+    int width = 0;
+    uint64_t version = 0;
+    bool operator==(const PlotDataKey& rhs) const {
+      return xMin == rhs.xMin && xMax == rhs.xMax && width == rhs.width &&
+             version == rhs.version;
+    }
+  };
+  PlotDataKey m_plotDataKey;
 };
 
 class Plot {
@@ -198,49 +230,122 @@ void PlotSeries::SetSource(DataSource* source) {
   m_source = source;
 
   // add initial value
-  m_data[m_size++] = ImPlotPoint{wpi::Now() * 1.0e-6, source->GetValue()};
+  Push(wpi::Now() * 1.0e-6, source->GetValue());
 
-  m_newValueConn = source->valueChanged.connect_connection(
+  // values are delivered on the GUI thread, so they can't change the storage
+  // while it is being plotted
+  m_newValueConn = source->ConnectDeferred(
       [this](double value, uint64_t time) { AppendValue(value, time); });
 }
 
 void PlotSeries::AppendValue(double value, uint64_t timeUs) {
   double time = (timeUs != 0 ? timeUs : wpi::Now()) * 1.0e-6;
-  if (IsDigital()) {
-    if (m_size < kMaxSize) {
-      m_data[m_size] = ImPlotPoint{time, value};
-      ++m_size;
-    } else {
-      m_data[m_offset] = ImPlotPoint{time, value};
-      m_offset = (m_offset + 1) % kMaxSize;
+  // as an analog graph draws linear lines in between each value,
+  // insert duplicate value if "long" time between updates so it
+  // looks appropriately flat
+  if (!IsDigital() && m_size > 0) {
+    const ImPlotPoint& last = At(m_size - 1);
+    if ((time - last.x) > kTimeGap) {
+      Push(time, last.y);
     }
+  }
+  Push(time, value);
+}
+
+void PlotSeries::Push(double time, double value) {
+  if (m_size < m_capacity) {
+    m_data.emplace_back(time, value);
+    ++m_size;
   } else {
-    // as an analog graph draws linear lines in between each value,
-    // insert duplicate value if "long" time between updates so it
-    // looks appropriately flat
-    if (m_size < kMaxSize) {
-      if (m_size > 0) {
-        if ((time - m_data[m_size - 1].x) > kTimeGap) {
-          m_data[m_size] = ImPlotPoint{time, m_data[m_size - 1].y};
-          ++m_size;
-        }
-      }
-      m_data[m_size] = ImPlotPoint{time, value};
-      ++m_size;
+    m_data[m_offset] = ImPlotPoint{time, value};
+    m_offset = (m_offset + 1) % m_capacity;
+  }
+  ++m_version;
+}
+
+void PlotSeries::SetCapacity(int capacity) {
+  capacity = std::clamp(capacity, kMinCapacity, kMaxCapacity);
+  if (capacity == m_capacity) {
+    return;
+  }
+
+  // keep the newest points
+  int size = m_size;
+  int keep = (std::min)(size, capacity);
+  std::vector<ImPlotPoint> data;
+  data.reserve(keep);
+  for (int i = size - keep; i < size; ++i) {
+    data.emplace_back(At(i));
+  }
+  m_data.swap(data);
+  m_size = keep;
+  m_offset = 0;
+  m_capacity = capacity;
+  ++m_version;
+}
+
+int PlotSeries::LowerBound(double time) const {
+  int lo = 0;
+  int hi = m_size;
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (At(mid).x < time) {
+      lo = mid + 1;
     } else {
-      if (m_offset == 0) {
-        if ((time - m_data[kMaxSize - 1].x) > kTimeGap) {
-          m_data[m_offset] = ImPlotPoint{time, m_data[kMaxSize - 1].y};
-          ++m_offset;
-        }
-      } else {
-        if ((time - m_data[m_offset - 1].x) > kTimeGap) {
-          m_data[m_offset] = ImPlotPoint{time, m_data[m_offset - 1].y};
-          m_offset = (m_offset + 1) % kMaxSize;
-        }
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+void PlotSeries::Decimate(double xMin, double xMax, int width) {
+  PlotDataKey key{xMin, xMax, width, m_version};
+  if (key == m_plotDataKey) {
+    return;
+  }
+  m_plotDataKey = key;
+  m_plotData.clear();
+
+  // include a point on either side of the range so lines reach its edges
+  int begin = (std::max)(LowerBound(xMin) - 1, 0);
+  int end = (std::min)(LowerBound(xMax) + 1, static_cast<int>(m_size));
+
+  // a few points per pixel look the same as all of them
+  if (width <= 0 || xMax <= xMin || (end - begin) <= 4 * width) {
+    for (int i = begin; i < end; ++i) {
+      m_plotData.emplace_back(At(i));
+    }
+    return;
+  }
+
+  // keep the first, minimum, maximum and last points in each pixel-wide
+  // bucket, in time order, so the outline of the data is preserved
+  double bucketWidth = (xMax - xMin) / width;
+  auto bucketOf = [&](double x) {
+    return static_cast<int64_t>(std::floor((x - xMin) / bucketWidth));
+  };
+  int i = begin;
+  while (i < end) {
+    int64_t bucket = bucketOf(At(i).x);
+    int first = i;
+    int minIndex = i;
+    int maxIndex = i;
+    for (++i; i < end && bucketOf(At(i).x) == bucket; ++i) {
+      if (At(i).y < At(minIndex).y) {
+        minIndex = i;
+      }
+      if (At(i).y > At(maxIndex).y) {
+        maxIndex = i;
+      }
+    }
+    int indices[4] = {first, (std::min)(minIndex, maxIndex),
+                      (std::max)(minIndex, maxIndex), i - 1};
+    int prev = -1;
+    for (int index : indices) {
+      if (index != prev) {
+        m_plotData.emplace_back(At(index));
+        prev = index;
       }
-      m_data[m_offset] = ImPlotPoint{time, value};
-      m_offset = (m_offset + 1) % kMaxSize;
     }
   }
 }
@@ -285,6 +390,11 @@ bool PlotSeries::ReadIni(std::string_view name, std::string_view value) {
       m_digitalBitGap = num.value();
     }
     return true;
+  } else if (name == "capacity") {
+    if (auto num = wpi::parse_integer<int>(value, 10)) {
+      SetCapacity(num.value());
+    }
+    return true;
   }
   return false;
 }
@@ -292,9 +402,9 @@ bool PlotSeries::ReadIni(std::string_view name, std::string_view value) {
 void PlotSeries::WriteIni(ImGuiTextBuffer* out) {
   out->appendf(
       "name=%s\nyAxis=%d\ncolor=%u\nmarker=%d\nweight=%f\ndigital=%d\n"
-      "digitalBitHeight=%d\ndigitalBitGap=%d\n",
+      "digitalBitHeight=%d\ndigitalBitGap=%d\ncapacity=%d\n",
       m_name.c_str(), m_yAxis, static_cast<ImU32>(ImColor(m_color)), m_marker,
-      m_weight, m_digital, m_digitalBitHeight, m_digitalBitGap);
+      m_weight, m_digital, m_digitalBitHeight, m_digitalBitGap, m_capacity);
 }
 
 const char* PlotSeries::GetName() const {
@@ -317,34 +427,31 @@ PlotSeries::Action PlotSeries::EmitPlot(PlotView& view, double now, size_t i,
   char label[128];
   std::snprintf(label, sizeof(label), "%s###name", GetName());
 
-  int size = m_size;
-  int offset = m_offset;
+  // only the visible range is plotted, decimated to the plot width
+  double zeroTime = GetZeroTime() * 1.0e-6;
+  ImPlotLimits limits = ImPlot::GetPlotLimits();
+  Decimate(limits.X.Min + zeroTime, limits.X.Max + zeroTime,
+           static_cast<int>(ImPlot::GetPlotSize().x));
 
   // need to have last value at current time, so need to create fake last value
-  // we handle the offset logic ourselves to avoid wrap issues with size + 1
+  int size = m_plotData.size();
   struct GetterData {
     double now;
     double zeroTime;
-    ImPlotPoint* data;
+    const ImPlotPoint* data;
     int size;
-    int offset;
+    double lastValue;
   };
-  GetterData getterData = {now, GetZeroTime() * 1.0e-6, m_data, size, offset};
+  GetterData getterData = {now, zeroTime, m_plotData.data(), size,
+                           m_size > 0 ? At(m_size - 1).y : 0.0};
   auto getter = [](void* data, int idx) {
     auto d = static_cast<GetterData*>(data);
     if (idx == d->size) {
-      return ImPlotPoint{
-          d->now - d->zeroTime,
-          d->data[d->offset == 0 ? d->size - 1 : d->offset - 1].y};
-    }
-    ImPlotPoint* point;
-    if (d->offset + idx < d->size) {
-      point = &d->data[d->offset + idx];
-    } else {
-      point = &d->data[d->offset + idx - d->size];
+      return ImPlotPoint{d->now - d->zeroTime, d->lastValue};
     }
-    return ImPlotPoint{point->x - d->zeroTime, point->y};
+    return ImPlotPoint{d->data[idx].x - d->zeroTime, d->data[idx].y};
   };
+  int count = m_size > 0 ? size + 1 : 0;
 
   if (m_color.w == IMPLOT_AUTO_COL.w) {
     m_color = ImPlot::GetColormapColor(i);
@@ -353,13 +460,13 @@ PlotSeries::Action PlotSeries::EmitPlot(PlotView& view, double now, size_t i,
   if (IsDigital()) {
     ImPlot::PushStyleVar(ImPlotStyleVar_DigitalBitHeight, m_digitalBitHeight);
     ImPlot::PushStyleVar(ImPlotStyleVar_DigitalBitGap, m_digitalBitGap);
-    ImPlot::PlotDigitalG(label, getter, &getterData, size + 1);
+    ImPlot::PlotDigitalG(label, getter, &getterData, count);
     ImPlot::PopStyleVar();
     ImPlot::PopStyleVar();
   } else {
     ImPlot::SetPlotYAxis(m_yAxis);
     ImPlot::SetNextMarkerStyle(m_marker - 1);
-    ImPlot::PlotLineG(label, getter, &getterData, size + 1);
+    ImPlot::PlotLineG(label, getter, &getterData, count);
   }
 
   // DND source for PlotSeries
@@ -426,6 +533,16 @@ void PlotSeries::EmitSettings(size_t i) {
     ImGui::InputFloat("Weight", &m_weight, 0.1f, 1.0f, "%.1f");
   }
 
+  // Capacity
+  {
+    int capacity = m_capacity;
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+    if (ImGui::InputInt("Max Points", &capacity, 0, 0,
+                        ImGuiInputTextFlags_EnterReturnsTrue)) {
+      SetCapacity(capacity);
+    }
+  }
+
   // Digital
   {
     static const char* const options[] = {"Auto", "Digital", "Analog"};
@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <vector>
 
 #include <imgui.h>
 #include <wpi/SmallString.h>
@@ -41,6 +42,8 @@ struct Context {
   wpi::StringMap<std::unique_ptr<Storage>> storage;
   wpi::StringMap<bool> deviceHidden;
   IniSaverString<DataSourceName> sources{"Data Sources"};
+  // sources with deferred listeners
+  std::vector<DataSource*> deferredSources;
   uint64_t zeroTime = 0;
 };
 
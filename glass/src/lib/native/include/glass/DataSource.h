@@ -7,6 +7,8 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
 
@@ -49,6 +51,9 @@ class DataSource {
   void SetValue(double value, uint64_t time = 0) {
     m_value = value;
     valueChanged(value, time);
+    if (auto queue = m_queue.load(std::memory_order_acquire)) {
+      QueueValue(queue, value, time);
+    }
   }
   double GetValue() const { return m_value; }
 
@@ -68,15 +73,48 @@ class DataSource {
 
   wpi::sig::SignalBase<wpi::spinlock, double, uint64_t> valueChanged;
 
+  /**
+   * Connects a listener for deferred delivery of value changes.  Unlike
+   * valueChanged listeners, which run on the thread that set the value, the
+   * listener is called on the GUI thread once per frame, in order, for each
+   * value set since the previous frame.  Setting a value only appends it to a
+   * wait-free queue, so it never waits for the listener; up to kQueueSize
+   * values are kept between frames.  Must be called from the GUI thread.
+   *
+   * @param func listener; called with the value and the time it was set, in
+   *             microseconds
+   * @return connection
+   */
+  wpi::sig::Connection ConnectDeferred(
+      std::function<void(double, uint64_t)> func);
+
+  /**
+   * Calls the deferred listeners of every data source with the values set
+   * since the last call.  Called by glass once per frame.
+   */
+  static void DeliverDeferred();
+
+  static constexpr size_t kQueueSize = 1024;
+
   static DataSource* Find(std::string_view id);
 
   static wpi::sig::Signal<const char*, DataSource*> sourceCreated;
 
  private:
+  struct Queue;
+
+  static void QueueValue(Queue* queue, double value, uint64_t time);
+  void Deliver();
+
   std::string m_id;
   NameInfo* m_name;
   bool m_digital = false;
   std::atomic<double> m_value = 0;
+
+  // created by the first ConnectDeferred()
+  std::atomic<Queue*> m_queue{nullptr};
+  std::unique_ptr<Queue> m_queueStorage;
+  wpi::sig::Signal<double, uint64_t> m_deferredValueChanged;
 };
 
 }  // namespace glass
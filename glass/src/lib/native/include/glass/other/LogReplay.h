@@ -0,0 +1,166 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wpi/DataLogIndex.h>
+#include <wpi/function_ref.h>
+
+#include "glass/Model.h"
+#include "glass/WindowManager.h"
+#include "glass/other/Field2D.h"
+
+namespace glass {
+
+class DataSource;
+
+/**
+ * Replays a data log file (see wpi::log::DataLog) as data sources.  The file
+ * is memory-mapped and indexed rather than read in, so even long logs open
+ * quickly, and playback can run at any speed or jump to any time.
+ *
+ * Each boolean and numeric entry is a data source with the ID "log:" followed
+ * by the entry name; each element of an array entry is a data source with
+ * the element index appended.  While playing, every record passed is set on
+ * its data source with its log time mapped onto the wall clock, so plots show
+ * the values as they would have appeared live; seeking sets each data source
+ * to its value at the new time.
+ */
+class LogReplayModel : public Model {
+ public:
+  LogReplayModel();
+  ~LogReplayModel() override;
+
+  /**
+   * Opens a log file, replacing any open log.  Playback is paused at the
+   * start of the log.
+   *
+   * @param filename log file
+   * @param error    set to the error message on failure
+   * @return false on failure
+   */
+  bool Open(std::string_view filename, std::string* error);
+  void Close();
+
+  const std::string& GetFilename() const { return m_filename; }
+  const wpi::log::DataLogIndex* GetIndex() const { return m_index.get(); }
+
+  // times are log timestamps, in microseconds
+  int64_t GetStartTime() const;
+  int64_t GetEndTime() const;
+  int64_t GetTime() const { return m_time; }
+  void Seek(int64_t time);
+
+  void Play();
+  void Pause() { m_playing = false; }
+  bool IsPlaying() const { return m_playing; }
+
+  void SetSpeed(double speed) { m_speed = speed; }
+  double GetSpeed() const { return m_speed; }
+
+  /**
+   * Gets the record of an entry at the current time.
+   *
+   * @param entry  entry
+   * @param record record (output)
+   * @return false if the entry has no record at or before the current time
+   */
+  bool GetRecord(const wpi::log::DataLogIndex::Entry& entry,
+                 wpi::log::DataLogRecord* record) const;
+
+  void ForEachSource(
+      wpi::function_ref<void(DataSource& source, std::string_view name)> func);
+
+  void Update() override;
+  bool Exists() override { return m_index != nullptr; }
+  bool IsReadOnly() override { return true; }
+
+ private:
+  struct EntrySources;
+
+  void Advance(int64_t time, uint64_t now);
+  void Reset(int64_t time, uint64_t now);
+  void SetValues(EntrySources& sources, const wpi::log::DataLogRecord& record,
+                 uint64_t time);
+
+  std::string m_filename;
+  std::unique_ptr<wpi::log::DataLogIndex> m_index;
+  std::vector<std::unique_ptr<EntrySources>> m_sources;
+  std::vector<double> m_values;
+  int64_t m_time = 0;
+  uint64_t m_lastUpdate = 0;
+  double m_speed = 1.0;
+  bool m_playing = false;
+};
+
+/**
+ * A Field2D backed by the logged object arrays of a field table, e.g.
+ * "NT:/SmartDashboard/Field", at the current replay time.  Objects added or
+ * poses changed by the user are kept only until the next logged value.
+ */
+class LogReplayField2DModel : public Field2DModel {
+ public:
+  // path is the entry name of the table, excluding the trailing /
+  LogReplayField2DModel(LogReplayModel& replay, std::string_view path);
+  ~LogReplayField2DModel() override;
+
+  const std::string& GetPath() const { return m_path; }
+  void SetPath(std::string_view path);
+
+  void Update() override;
+  bool Exists() override { return m_replay.Exists(); }
+  bool IsReadOnly() override { return true; }
+
+  FieldObjectModel* AddFieldObject(std::string_view name) override;
+  void RemoveFieldObject(std::string_view name) override;
+  void ForEachFieldObject(
+      wpi::function_ref<void(FieldObjectModel& model, std::string_view name)>
+          func) override;
+
+ private:
+  LogReplayModel& m_replay;
+  std::string m_path;
+  const wpi::log::DataLogIndex* m_index = nullptr;
+
+  class ObjectModel;
+  std::vector<std::unique_ptr<ObjectModel>> m_objects;
+};
+
+/**
+ * Displays the playback controls and data sources of a log replay.
+ *
+ * @param model replay
+ * @param field field to offer a choice of the logged field tables for; may be
+ *              nullptr
+ */
+void DisplayLogReplay(LogReplayModel* model,
+                      LogReplayField2DModel* field = nullptr);
+
+/**
+ * Provides a "Log Replay" window with the playback controls and a "Log
+ * Field" window showing a replayed Field2D.
+ */
+class LogReplayProvider : private WindowManager {
+ public:
+  explicit LogReplayProvider(std::string_view iniName);
+  ~LogReplayProvider() override;
+
+  void GlobalInit() override;
+  void DisplayMenu() override;
+
+  LogReplayModel& GetModel() { return m_model; }
+
+ private:
+  LogReplayModel m_model;
+  LogReplayField2DModel m_field{m_model, ""};
+};
+
+}  // namespace glass
@@ -5,9 +5,12 @@
 #include "glass/networktables/NTField2D.h"
 
 #include <algorithm>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
+#include <frc/geometry/Pose2dArrayEncoding.h>
 #include <ntcore_cpp.h>
 #include <wpi/Endian.h>
 #include <wpi/MathExtras.h>
@@ -24,11 +27,17 @@ class NTField2DModel::ObjectModel : public FieldObjectModel {
   const char* GetName() const override { return m_name.c_str(); }
   NT_Entry GetEntry() const { return m_entry; }
 
-  void NTUpdate(const nt::Value& value);
+  // Sets the latest value; the poses are parsed from it by Parse(), so
+  // several updates in one frame are only parsed once
+  void NTUpdate(std::shared_ptr<nt::Value> value) {
+    m_pending = std::move(value);
+  }
+  void Parse();
 
   void Update() override {
     if (auto value = nt::GetEntryValue(m_entry)) {
-      NTUpdate(*value);
+      NTUpdate(std::move(value));
+      Parse();
     }
   }
   bool Exists() override { return nt::GetEntryType(m_entry) != NT_UNASSIGNED; }
@@ -46,10 +55,25 @@ class NTField2DModel::ObjectModel : public FieldObjectModel {
   std::string m_name;
   NT_Entry m_entry;
 
+  // the value the poses were parsed from (or sent as), and the latest value
+  std::shared_ptr<nt::Value> m_value;
+  std::shared_ptr<nt::Value> m_pending;
+
   std::vector<frc::Pose2d> m_poses;
 };
 
-void NTField2DModel::ObjectModel::NTUpdate(const nt::Value& value) {
+void NTField2DModel::ObjectModel::Parse() {
+  if (!m_pending) {
+    return;
+  }
+  // values are immutable, so the same value need not be parsed again; this
+  // includes the local echo of poses set by UpdateNT()
+  auto valuePtr = std::move(m_pending);
+  if (valuePtr == m_value) {
+    return;
+  }
+  m_value = valuePtr;
+  auto& value = *valuePtr;
   if (value.IsDoubleArray()) {
     auto arr = value.GetDoubleArray();
     auto size = arr.size();
@@ -63,28 +87,13 @@ void NTField2DModel::ObjectModel::NTUpdate(const nt::Value& value) {
           frc::Rotation2d{units::degree_t{arr[i * 3 + 2]}}};
     }
   } else if (value.IsRaw()) {
-    // treat it simply as an array of doubles
+    // compactly encoded or big-endian doubles; decoded in place
     std::string_view data = value.GetRaw();
-
-    // must be triples of doubles
-    auto size = data.size();
-    if ((size % (3 * 8)) != 0) {
-      return;
-    }
-    m_poses.resize(size / (3 * 8));
-    const char* p = data.data();
-    for (size_t i = 0; i < size / (3 * 8); ++i) {
-      double x = wpi::BitsToDouble(
-          wpi::support::endian::readNext<uint64_t, wpi::support::big,
-                                         wpi::support::unaligned>(p));
-      double y = wpi::BitsToDouble(
-          wpi::support::endian::readNext<uint64_t, wpi::support::big,
-                                         wpi::support::unaligned>(p));
-      double rot = wpi::BitsToDouble(
-          wpi::support::endian::readNext<uint64_t, wpi::support::big,
-                                         wpi::support::unaligned>(p));
-      m_poses[i] = frc::Pose2d{units::meter_t{x}, units::meter_t{y},
-                               frc::Rotation2d{units::degree_t{rot}}};
+    if (auto size = frc::GetEncodedPose2dArraySize(data)) {
+      m_poses.resize(*size);
+      if (!frc::DecodePose2dArray(data, m_poses)) {
+        m_poses.clear();
+      }
     }
   }
 }
@@ -98,9 +107,10 @@ void NTField2DModel::ObjectModel::UpdateNT() {
       arr.push_back(translation.Y().to<double>());
       arr.push_back(pose.Rotation().Degrees().to<double>());
     }
-    nt::SetEntryTypeValue(m_entry, nt::Value::MakeDoubleArray(arr));
+    m_value = nt::Value::MakeDoubleArray(arr);
   } else {
-    // send as raw array of doubles if too big for NT array
+    // send as raw array of doubles if too big for NT array; unlike the
+    // compact encoding, robot programs in every language can read this
     std::vector<char> arr;
     arr.resize(m_poses.size() * 3 * 8);
     char* p = arr.data();
@@ -116,9 +126,9 @@ void NTField2DModel::ObjectModel::UpdateNT() {
           p, wpi::DoubleToBits(pose.Rotation().Degrees().to<double>()));
       p += 8;
     }
-    nt::SetEntryTypeValue(m_entry,
-                          nt::Value::MakeRaw({arr.data(), arr.size()}));
+    m_value = nt::Value::MakeRaw({arr.data(), arr.size()});
   }
+  nt::SetEntryTypeValue(m_entry, m_value);
 }
 
 void NTField2DModel::ObjectModel::SetPoses(wpi::span<const frc::Pose2d> poses) {
@@ -177,7 +187,7 @@ void NTField2DModel::Update() {
           m_objects.begin(), m_objects.end(),
           [&](const auto& e) { return e->GetEntry() == event.entry; });
       if (it != m_objects.end()) {
-        (*it)->NTUpdate(*event.value);
+        (*it)->NTUpdate(event.value);
         continue;
       }
     }
@@ -204,10 +214,14 @@ void NTField2DModel::Update() {
         continue;
       }
       if (event.flags & (NT_NOTIFY_NEW | NT_NOTIFY_UPDATE)) {
-        (*it)->NTUpdate(*event.value);
+        (*it)->NTUpdate(event.value);
       }
     }
   }
+
+  for (auto&& obj : m_objects) {
+    obj->Parse();
+  }
 }
 
 bool NTField2DModel::Exists() {
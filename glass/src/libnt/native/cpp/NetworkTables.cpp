@@ -6,9 +6,11 @@
 
 #include <networktables/NetworkTableValue.h>
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
 #include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <memory>
 #include <string_view>
@@ -94,6 +96,9 @@ NetworkTablesModel::Entry::Entry(nt::EntryNotification&& event)
 }
 
 void NetworkTablesModel::Entry::UpdateValue() {
+  // formatted on demand
+  valueStr.clear();
+
   switch (value->type()) {
     case NT_BOOLEAN:
       if (!source) {
@@ -109,6 +114,19 @@ void NetworkTablesModel::Entry::UpdateValue() {
       source->SetValue(value->GetDouble());
       source->SetDigital(false);
       break;
+    default:
+      break;
+  }
+}
+
+const std::string& NetworkTablesModel::Entry::GetValueString() {
+  if (!valueStr.empty() || !value) {
+    return valueStr;
+  }
+  switch (value->type()) {
+    case NT_DOUBLE:
+      valueStr = fmt::format("{:.6f}", value->GetDouble());
+      break;
     case NT_BOOLEAN_ARRAY:
       valueStr = BooleanArrayToString(value->GetBooleanArray());
       break;
@@ -121,18 +139,21 @@ void NetworkTablesModel::Entry::UpdateValue() {
     default:
       break;
   }
+  return valueStr;
 }
 
 void NetworkTablesModel::Update() {
   bool timedOut = false;
-  bool updateTree = false;
+  size_t numSorted = m_sortedEntries.size();
+  // kept alive until they are removed from m_sortedEntries
+  std::vector<std::unique_ptr<Entry>> deleted;
   for (auto&& event : nt::PollEntryListener(m_poller, 0, &timedOut)) {
     auto& entry = m_entries[event.entry];
     if (event.flags & NT_NOTIFY_NEW) {
       if (!entry) {
         entry = std::make_unique<Entry>(std::move(event));
         m_sortedEntries.emplace_back(entry.get());
-        updateTree = true;
+        AddToTree(entry.get());
         continue;
       }
     }
@@ -140,14 +161,9 @@ void NetworkTablesModel::Update() {
       continue;
     }
     if (event.flags & NT_NOTIFY_DELETE) {
-      auto it = std::find(m_sortedEntries.begin(), m_sortedEntries.end(),
-                          entry.get());
-      // will be removed completely below
-      if (it != m_sortedEntries.end()) {
-        *it = nullptr;
-      }
+      RemoveFromTree(entry.get());
+      deleted.emplace_back(std::move(entry));
       m_entries.erase(event.entry);
-      updateTree = true;
       continue;
     }
     if (event.flags & NT_NOTIFY_UPDATE) {
@@ -160,58 +176,88 @@ void NetworkTablesModel::Update() {
   }
 
   // shortcut common case (updates)
-  if (!updateTree) {
+  if (numSorted == m_sortedEntries.size() && deleted.empty()) {
     return;
   }
 
-  // remove deleted entries
-  m_sortedEntries.erase(
-      std::remove(m_sortedEntries.begin(), m_sortedEntries.end(), nullptr),
-      m_sortedEntries.end());
+  // merge new entries into the sorted list, sorted by name
+  auto byName = [](const auto& a, const auto& b) { return a->name < b->name; };
+  auto mid = m_sortedEntries.begin() + numSorted;
+  std::sort(mid, m_sortedEntries.end(), byName);
+  std::inplace_merge(m_sortedEntries.begin(), mid, m_sortedEntries.end(),
+                     byName);
 
-  // sort by name
-  std::sort(m_sortedEntries.begin(), m_sortedEntries.end(),
-            [](const auto& a, const auto& b) { return a->name < b->name; });
+  // remove deleted entries
+  if (!deleted.empty()) {
+    std::sort(deleted.begin(), deleted.end());
+    m_sortedEntries.erase(
+        std::remove_if(m_sortedEntries.begin(), m_sortedEntries.end(),
+                       [&](Entry* entry) {
+                         return std::binary_search(
+                             deleted.begin(), deleted.end(), entry,
+                             [](const auto& a, const auto& b) {
+                               return std::less<>{}(&*a, &*b);
+                             });
+                       }),
+        m_sortedEntries.end());
+  }
+}
 
-  // rebuild tree
-  m_root.clear();
+void NetworkTablesModel::AddToTree(Entry* entry) {
   wpi::SmallVector<std::string_view, 16> parts;
-  for (auto& entry : m_sortedEntries) {
-    parts.clear();
-    wpi::split(entry->name, parts, '/', -1, false);
+  wpi::split(entry->name, parts, '/', -1, false);
 
-    // ignore a raw "/" key
-    if (parts.empty()) {
-      continue;
-    }
+  // ignore a raw "/" key
+  if (parts.empty()) {
+    return;
+  }
 
-    // get to leaf
-    auto nodes = &m_root;
-    for (auto part : wpi::drop_back(wpi::span{parts.begin(), parts.end()})) {
-      auto it =
-          std::find_if(nodes->begin(), nodes->end(),
-                       [&](const auto& node) { return node.name == part; });
-      if (it == nodes->end()) {
-        nodes->emplace_back(part);
-        // path is from the beginning of the string to the end of the current
-        // part; this works because part is a reference to the internals of
-        // entry->name
-        nodes->back().path.assign(
-            entry->name.data(), part.data() + part.size() - entry->name.data());
-        it = nodes->end() - 1;
-      }
-      nodes = &it->children;
+  // get to leaf
+  auto nodes = &m_root;
+  for (auto part : wpi::drop_back(wpi::span{parts.begin(), parts.end()})) {
+    auto it = std::lower_bound(nodes->begin(), nodes->end(), part);
+    if (it == nodes->end() || it->name != part) {
+      it = nodes->emplace(it, part);
+      // path is from the beginning of the string to the end of the current
+      // part; this works because part is a reference to the internals of
+      // entry->name
+      it->path.assign(entry->name.data(),
+                      part.data() + part.size() - entry->name.data());
     }
+    nodes = &it->children;
+  }
 
-    auto it = std::find_if(nodes->begin(), nodes->end(), [&](const auto& node) {
-      return node.name == parts.back();
-    });
-    if (it == nodes->end()) {
-      nodes->emplace_back(parts.back());
-      // no need to set path, as it's identical to entry->name
-      it = nodes->end() - 1;
-    }
-    it->entry = entry;
+  auto it = std::lower_bound(nodes->begin(), nodes->end(), parts.back());
+  if (it == nodes->end() || it->name != parts.back()) {
+    // no need to set path, as it's identical to entry->name
+    it = nodes->emplace(it, parts.back());
+  }
+  it->entry = entry;
+}
+
+// Removes the entry at the path, along with any parents left empty
+static void RemoveTreeEntry(std::vector<NetworkTablesModel::TreeNode>& nodes,
+                            wpi::span<const std::string_view> parts,
+                            NetworkTablesModel::Entry* entry) {
+  auto it = std::lower_bound(nodes.begin(), nodes.end(), parts.front());
+  if (it == nodes.end() || it->name != parts.front()) {
+    return;
+  }
+  if (parts.size() > 1) {
+    RemoveTreeEntry(it->children, parts.subspan(1), entry);
+  } else if (it->entry == entry) {
+    it->entry = nullptr;
+  }
+  if (!it->entry && it->children.empty()) {
+    nodes.erase(it);
+  }
+}
+
+void NetworkTablesModel::RemoveFromTree(Entry* entry) {
+  wpi::SmallVector<std::string_view, 16> parts;
+  wpi::split(entry->name, parts, '/', -1, false);
+  if (!parts.empty()) {
+    RemoveTreeEntry(m_root, parts, entry);
   }
 }
 
@@ -378,7 +424,7 @@ static void EmitEntryValueReadonly(NetworkTablesModel::Entry& entry) {
       ImGui::LabelText("boolean", "%s", val->GetBoolean() ? "true" : "false");
       break;
     case NT_DOUBLE:
-      ImGui::LabelText("double", "%.6f", val->GetDouble());
+      ImGui::LabelText("double", "%s", entry.GetValueString().c_str());
       break;
     case NT_STRING: {
       // GetString() comes from a std::string, so it's null terminated
@@ -386,13 +432,13 @@ static void EmitEntryValueReadonly(NetworkTablesModel::Entry& entry) {
       break;
     }
     case NT_BOOLEAN_ARRAY:
-      ImGui::LabelText("boolean[]", "%s", entry.valueStr.c_str());
+      ImGui::LabelText("boolean[]", "%s", entry.GetValueString().c_str());
       break;
     case NT_DOUBLE_ARRAY:
-      ImGui::LabelText("double[]", "%s", entry.valueStr.c_str());
+      ImGui::LabelText("double[]", "%s", entry.GetValueString().c_str());
       break;
     case NT_STRING_ARRAY:
-      ImGui::LabelText("string[]", "%s", entry.valueStr.c_str());
+      ImGui::LabelText("string[]", "%s", entry.GetValueString().c_str());
       break;
     case NT_RAW:
       ImGui::LabelText("raw", "[...]");
@@ -449,7 +495,7 @@ static void EmitEntryValueEditable(NetworkTablesModel::Entry& entry) {
       break;
     }
     case NT_BOOLEAN_ARRAY: {
-      char* v = GetTextBuffer(entry.valueStr);
+      char* v = GetTextBuffer(entry.GetValueString());
       if (ImGui::InputText("boolean[]", v, kTextBufferSize,
                            ImGuiInputTextFlags_EnterReturnsTrue)) {
         if (auto outv = StringToBooleanArray(v)) {
@@ -459,7 +505,7 @@ static void EmitEntryValueEditable(NetworkTablesModel::Entry& entry) {
       break;
     }
     case NT_DOUBLE_ARRAY: {
-      char* v = GetTextBuffer(entry.valueStr);
+      char* v = GetTextBuffer(entry.GetValueString());
       if (ImGui::InputText("double[]", v, kTextBufferSize,
                            ImGuiInputTextFlags_EnterReturnsTrue)) {
         if (auto outv = StringToDoubleArray(v)) {
@@ -469,7 +515,7 @@ static void EmitEntryValueEditable(NetworkTablesModel::Entry& entry) {
       break;
     }
     case NT_STRING_ARRAY: {
-      char* v = GetTextBuffer(entry.valueStr);
+      char* v = GetTextBuffer(entry.GetValueString());
       if (ImGui::InputText("string[]", v, kTextBufferSize,
                            ImGuiInputTextFlags_EnterReturnsTrue)) {
         if (auto outv = StringToStringArray(v)) {
@@ -626,30 +672,55 @@ static void EmitEntry(NetworkTablesModel::Entry& entry, const char* name,
   ImGui::Separator();
 }
 
+// Only the rows in view are emitted; the rest are skipped over by height
+template <typename T, typename F>
+static void EmitClipped(const T& items, F&& emit) {
+  ImGuiListClipper clipper;
+  clipper.Begin(items.size());
+  while (clipper.Step()) {
+    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+      emit(items[i]);
+    }
+  }
+  clipper.End();
+}
+
 static void EmitTree(const std::vector<NetworkTablesModel::TreeNode>& tree,
                      NetworkTablesFlags flags) {
-  for (auto&& node : tree) {
+  for (auto it = tree.begin(), end = tree.end(); it != end;) {
+    // runs of leaves all have the same row height, so they can be clipped
+    auto leavesEnd = std::find_if(
+        it, end, [](const auto& node) { return !node.children.empty(); });
+    if (leavesEnd != it) {
+      EmitClipped(wpi::span{&*it, static_cast<size_t>(leavesEnd - it)},
+                  [&](const auto& node) {
+                    if (node.entry) {
+                      EmitEntry(*node.entry, node.name.c_str(), flags);
+                    }
+                  });
+      it = leavesEnd;
+      continue;
+    }
+
+    auto& node = *it++;
     if (node.entry) {
       EmitEntry(*node.entry, node.name.c_str(), flags);
     }
 
-    if (!node.children.empty()) {
-      bool open =
-          TreeNodeEx(node.name.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
-      EmitParentContextMenu(node.path, flags);
+    bool open = TreeNodeEx(node.name.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
+    EmitParentContextMenu(node.path, flags);
+    ImGui::NextColumn();
+    ImGui::NextColumn();
+    if (flags & NetworkTablesFlags_ShowFlags) {
       ImGui::NextColumn();
+    }
+    if (flags & NetworkTablesFlags_ShowTimestamp) {
       ImGui::NextColumn();
-      if (flags & NetworkTablesFlags_ShowFlags) {
-        ImGui::NextColumn();
-      }
-      if (flags & NetworkTablesFlags_ShowTimestamp) {
-        ImGui::NextColumn();
-      }
-      ImGui::Separator();
-      if (open) {
-        EmitTree(node.children, flags);
-        TreePop();
-      }
+    }
+    ImGui::Separator();
+    if (open) {
+      EmitTree(node.children, flags);
+      TreePop();
     }
   }
 }
@@ -721,9 +792,9 @@ void glass::DisplayNetworkTables(NetworkTablesModel* model,
   if (flags & NetworkTablesFlags_TreeView) {
     EmitTree(model->GetTreeRoot(), flags);
   } else {
-    for (auto entry : model->GetEntries()) {
+    EmitClipped(model->GetEntries(), [&](auto entry) {
       EmitEntry(*entry, entry->name.c_str(), flags);
-    }
+    });
   }
   ImGui::Columns();
 }
@@ -26,6 +26,13 @@ class NetworkTablesModel : public Model {
 
     void UpdateValue();
 
+    /**
+     * Gets the string representation of the value (for doubles and arrays).
+     * The value is only formatted the first time this is called after it
+     * changes.
+     */
+    const std::string& GetValueString();
+
     /** Entry handle. */
     NT_Entry entry;
 
@@ -38,7 +45,10 @@ class NetworkTablesModel : public Model {
     /** Flags. */
     unsigned int flags = 0;
 
-    /** String representation of the value (for arrays / complex values). */
+    /**
+     * String representation of the value (for doubles and arrays); empty
+     * until GetValueString() is called.
+     */
     std::string valueStr;
 
     /** Data source (for numeric values). */
@@ -62,6 +72,8 @@ class NetworkTablesModel : public Model {
 
     /** Children of node, sorted by name */
     std::vector<TreeNode> children;
+
+    bool operator<(std::string_view rhs) const { return name < rhs; }
   };
 
   NetworkTablesModel();
@@ -78,11 +90,15 @@ class NetworkTablesModel : public Model {
  private:
   NT_Inst m_inst;
   NT_EntryListenerPoller m_poller;
+  void AddToTree(Entry* entry);
+  void RemoveFromTree(Entry* entry);
+
   wpi::DenseMap<NT_Entry, std::unique_ptr<Entry>> m_entries;
 
-  // sorted by name
+  // sorted by name; new and deleted entries are merged in once per update
   std::vector<Entry*> m_sortedEntries;
 
+  // updated in place as entries are added and deleted
   std::vector<TreeNode> m_root;
 };
 
@@ -4,6 +4,8 @@
 
 package edu.wpi.first.hal;
 
+import java.nio.ByteBuffer;
+
 public class AnalogJNI extends JNIWrapper {
   /**
    * <i>native declaration : AthenaJava\target\native\include\HAL\Analog.h:58</i><br>
@@ -64,6 +66,33 @@ public class AnalogJNI extends JNIWrapper {
 
   public static native double getAnalogAverageVoltage(int analogPortHandle);
 
+  /**
+   * Reads the raw value of each handle into a direct buffer in one call, an int per handle
+   * in native byte order (use {@code buffer.order(ByteOrder.nativeOrder())}).
+   *
+   * @param handles the handles to read
+   * @param buffer the direct buffer to store the results in
+   */
+  public static native void getAnalogValueBatch(int[] handles, ByteBuffer buffer);
+
+  /**
+   * Reads the voltage of each handle into a direct buffer in one call, a double per handle
+   * in native byte order (use {@code buffer.order(ByteOrder.nativeOrder())}).
+   *
+   * @param handles the handles to read
+   * @param buffer the direct buffer to store the results in
+   */
+  public static native void getAnalogVoltageBatch(int[] handles, ByteBuffer buffer);
+
+  /**
+   * Reads the average voltage of each handle into a direct buffer in one call, a double per handle
+   * in native byte order (use {@code buffer.order(ByteOrder.nativeOrder())}).
+   *
+   * @param handles the handles to read
+   * @param buffer the direct buffer to store the results in
+   */
+  public static native void getAnalogAverageVoltageBatch(int[] handles, ByteBuffer buffer);
+
   public static native int getAnalogLSBWeight(int analogPortHandle);
 
   public static native int getAnalogOffset(int analogPortHandle);
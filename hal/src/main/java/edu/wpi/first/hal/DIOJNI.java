@@ -4,6 +4,8 @@
 
 package edu.wpi.first.hal;
 
+import java.nio.ByteBuffer;
+
 @SuppressWarnings("AbbreviationAsWordInName")
 public class DIOJNI extends JNIWrapper {
   public static native int initializeDIOPort(int halPortHandle, boolean input);
@@ -20,6 +22,23 @@ public class DIOJNI extends JNIWrapper {
 
   public static native boolean getDIO(int dioPortHandle);
 
+  /**
+   * Reads the value of each handle into a direct buffer in one call, a byte (0 or 1) per handle
+   * in native byte order (use {@code buffer.order(ByteOrder.nativeOrder())}).
+   *
+   * @param handles the handles to read
+   * @param buffer the direct buffer to store the results in
+   */
+  public static native void getDIOBatch(int[] handles, ByteBuffer buffer);
+
+  /**
+   * Sets the output value of each handle in one call.
+   *
+   * @param handles the handles to set
+   * @param values the values to set, one per handle
+   */
+  public static native void setDIOBatch(int[] handles, boolean[] values);
+
   public static native boolean getDIODirection(int dioPortHandle);
 
   public static native void pulse(int dioPortHandle, double pulseLength);
@@ -4,6 +4,8 @@
 
 package edu.wpi.first.hal;
 
+import java.nio.ByteBuffer;
+
 public class EncoderJNI extends JNIWrapper {
   public static native int initializeEncoder(
       int digitalSourceHandleA,
@@ -37,6 +39,33 @@ public class EncoderJNI extends JNIWrapper {
 
   public static native double getEncoderRate(int encoderHandle);
 
+  /**
+   * Reads the count of each handle into a direct buffer in one call, an int per handle
+   * in native byte order (use {@code buffer.order(ByteOrder.nativeOrder())}).
+   *
+   * @param handles the handles to read
+   * @param buffer the direct buffer to store the results in
+   */
+  public static native void getEncoderBatch(int[] handles, ByteBuffer buffer);
+
+  /**
+   * Reads the raw count of each handle into a direct buffer in one call, an int per handle
+   * in native byte order (use {@code buffer.order(ByteOrder.nativeOrder())}).
+   *
+   * @param handles the handles to read
+   * @param buffer the direct buffer to store the results in
+   */
+  public static native void getEncoderRawBatch(int[] handles, ByteBuffer buffer);
+
+  /**
+   * Reads the rate of each handle into a direct buffer in one call, a double per handle
+   * in native byte order (use {@code buffer.order(ByteOrder.nativeOrder())}).
+   *
+   * @param handles the handles to read
+   * @param buffer the direct buffer to store the results in
+   */
+  public static native void getEncoderRateBatch(int[] handles, ByteBuffer buffer);
+
   public static native void setEncoderMinRate(int encoderHandle, double minRate);
 
   public static native void setEncoderDistancePerPulse(int encoderHandle, double distancePerPulse);
@@ -40,6 +40,22 @@ public class PWMJNI extends DIOJNI {
 
   public static native void setPWMPosition(int pwmPortHandle, double position);
 
+  /**
+   * Sets the speed of each handle in one call.
+   *
+   * @param handles the handles to set
+   * @param values the values to set, one per handle
+   */
+  public static native void setPWMSpeedBatch(int[] handles, double[] values);
+
+  /**
+   * Sets the position of each handle in one call.
+   *
+   * @param handles the handles to set
+   * @param values the values to set, one per handle
+   */
+  public static native void setPWMPositionBatch(int[] handles, double[] values);
+
   public static native short getPWMRaw(int pwmPortHandle);
 
   public static native double getPWMSpeed(int pwmPortHandle);
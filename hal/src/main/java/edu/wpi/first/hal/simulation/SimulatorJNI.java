@@ -27,5 +27,13 @@ public class SimulatorJNI extends JNIWrapper {
 
   public static native void stepTimingAsync(long delta);
 
+  public static native void setTimingFastForward(boolean enable);
+
+  public static native boolean isTimingFastForward();
+
+  public static native void setTimingLockStep(boolean enable);
+
+  public static native boolean isTimingLockStep();
+
   public static native void resetHandles();
 }
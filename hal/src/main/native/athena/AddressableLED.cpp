@@ -197,6 +197,34 @@ void HAL_WriteAddressableLEDData(HAL_AddressableLEDHandle handle,
   led->led->strobeLoad(status);
 }
 
+void HAL_WriteAddressableLEDDataRange(HAL_AddressableLEDHandle handle,
+                                      const struct HAL_AddressableLEDData* data,
+                                      int32_t start, int32_t length,
+                                      int32_t* status) {
+  auto led = addressableLEDHandles->Get(handle);
+  if (!led) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  if (start < 0 || length < 0 || start + length > led->stringLength) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    hal::SetLastError(
+        status,
+        fmt::format("Data range must be within the length {}. {} LEDs from {} "
+                    "was requested",
+                    led->stringLength, length, start));
+    return;
+  }
+
+  std::memcpy(static_cast<HAL_AddressableLEDData*>(led->ledBuffer) + start,
+              data, length * sizeof(HAL_AddressableLEDData));
+
+  asm("dmb");
+
+  led->led->strobeLoad(status);
+}
+
 void HAL_SetAddressableLEDBitTiming(HAL_AddressableLEDHandle handle,
                                     int32_t lowTime0NanoSeconds,
                                     int32_t highTime0NanoSeconds,
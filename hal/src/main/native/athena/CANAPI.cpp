@@ -7,7 +7,9 @@
 #include <ctime>
 
 #include <wpi/DenseMap.h>
+#include <wpi/SmallVector.h>
 
+#include "CANReceiver.h"
 #include "HALInitializer.h"
 #include "hal/CAN.h"
 #include "hal/Errors.h"
@@ -29,6 +31,10 @@ struct CANStorage {
   wpi::mutex mapMutex;
   wpi::SmallDenseMap<int32_t, int32_t> periodicSends;
   wpi::SmallDenseMap<int32_t, Receives> receives;
+  // Whether messages are read from the receiver's cache instead of NetComm
+  bool cached;
+  // Sequence of the last cached message read with HAL_ReadCANPacketNew()
+  wpi::SmallDenseMap<int32_t, uint32_t> lastSequences;
 };
 }  // namespace
 
@@ -61,6 +67,13 @@ static int32_t CreateCANId(CANStorage* storage, int32_t apiId) {
   return createdId;
 }
 
+static void CopyCachedMessage(const CANReceivedMessage& message, uint8_t* data,
+                              int32_t* length, uint64_t* receivedTimestamp) {
+  std::memcpy(data, message.data, message.length);
+  *length = message.length;
+  *receivedTimestamp = message.timeStamp;
+}
+
 extern "C" {
 
 HAL_CANHandle HAL_InitializeCAN(HAL_CANManufacturer manufacturer,
@@ -79,6 +92,7 @@ HAL_CANHandle HAL_InitializeCAN(HAL_CANManufacturer manufacturer,
   can->deviceId = deviceId;
   can->deviceType = deviceType;
   can->manufacturer = manufacturer;
+  can->cached = StartCANReceiver();
 
   return handle;
 }
@@ -98,7 +112,7 @@ void HAL_CleanCAN(HAL_CANHandle handle) {
 
 void HAL_WriteCANPacket(HAL_CANHandle handle, const uint8_t* data,
                         int32_t length, int32_t apiId, int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -114,10 +128,54 @@ void HAL_WriteCANPacket(HAL_CANHandle handle, const uint8_t* data,
   can->periodicSends[apiId] = -1;
 }
 
+void HAL_WriteCANPacketBatch(const struct HAL_CANPacket* packets,
+                             int32_t count, int32_t* status) {
+  // The device each packet was sent to, or null if it failed
+  wpi::SmallVector<std::shared_ptr<CANStorage>, 16> sent;
+  sent.reserve(count);
+
+  // Send every packet before any bookkeeping so the frames go out together
+  std::shared_ptr<CANStorage> can;
+  for (int32_t i = 0; i < count; ++i) {
+    const auto& packet = packets[i];
+    if (i == 0 || packet.handle != packets[i - 1].handle) {
+      can = canHandles->Get(packet.handle);
+    }
+    if (!can) {
+      if (*status == 0) {
+        *status = HAL_HANDLE_ERROR;
+      }
+      sent.emplace_back();
+      continue;
+    }
+    auto id = CreateCANId(can.get(), packet.apiId);
+
+    int32_t sendStatus = 0;
+    HAL_CAN_SendMessage(id, packet.data, packet.length,
+                        HAL_CAN_SEND_PERIOD_NO_REPEAT, &sendStatus);
+
+    if (sendStatus != 0) {
+      if (*status == 0) {
+        *status = sendStatus;
+      }
+      sent.emplace_back();
+      continue;
+    }
+    sent.emplace_back(can);
+  }
+
+  for (int32_t i = 0; i < count; ++i) {
+    if (sent[i]) {
+      std::scoped_lock lock(sent[i]->mapMutex);
+      sent[i]->periodicSends[packets[i].apiId] = -1;
+    }
+  }
+}
+
 void HAL_WriteCANPacketRepeating(HAL_CANHandle handle, const uint8_t* data,
                                  int32_t length, int32_t apiId,
                                  int32_t repeatMs, int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -135,7 +193,7 @@ void HAL_WriteCANPacketRepeating(HAL_CANHandle handle, const uint8_t* data,
 
 void HAL_WriteCANRTRFrame(HAL_CANHandle handle, int32_t length, int32_t apiId,
                           int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -156,7 +214,7 @@ void HAL_WriteCANRTRFrame(HAL_CANHandle handle, int32_t length, int32_t apiId,
 
 void HAL_StopCANPacketRepeating(HAL_CANHandle handle, int32_t apiId,
                                 int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -176,13 +234,36 @@ void HAL_StopCANPacketRepeating(HAL_CANHandle handle, int32_t apiId,
 void HAL_ReadCANPacketNew(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
                           int32_t* length, uint64_t* receivedTimestamp,
                           int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
   }
 
   uint32_t messageId = CreateCANId(can.get(), apiId);
+
+  if (can->cached) {
+    CANReceivedMessage message;
+    if (!GetLatestCANMessage(messageId, &message)) {
+      *length = 0;
+      *receivedTimestamp = 0;
+      *status = HAL_ERR_CANSessionMux_MessageNotFound;
+      return;
+    }
+    std::scoped_lock lock(can->mapMutex);
+    auto& lastSequence = can->lastSequences[messageId];
+    if (message.sequence == lastSequence) {
+      *length = 0;
+      *receivedTimestamp = 0;
+      *status = HAL_ERR_CANSessionMux_MessageNotFound;
+      return;
+    }
+    lastSequence = message.sequence;
+    CopyCachedMessage(message, data, length, receivedTimestamp);
+    *status = 0;
+    return;
+  }
+
   uint8_t dataSize = 0;
   uint32_t ts = 0;
   HAL_CAN_ReceiveMessage(&messageId, 0x1FFFFFFF, data, &dataSize, &ts, status);
@@ -202,13 +283,25 @@ void HAL_ReadCANPacketNew(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
 void HAL_ReadCANPacketLatest(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
                              int32_t* length, uint64_t* receivedTimestamp,
                              int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
   }
 
   uint32_t messageId = CreateCANId(can.get(), apiId);
+
+  if (can->cached) {
+    CANReceivedMessage message;
+    if (!GetLatestCANMessage(messageId, &message)) {
+      *status = HAL_ERR_CANSessionMux_MessageNotFound;
+      return;
+    }
+    CopyCachedMessage(message, data, length, receivedTimestamp);
+    *status = 0;
+    return;
+  }
+
   uint8_t dataSize = 0;
   uint32_t ts = 0;
   HAL_CAN_ReceiveMessage(&messageId, 0x1FFFFFFF, data, &dataSize, &ts, status);
@@ -239,13 +332,31 @@ void HAL_ReadCANPacketTimeout(HAL_CANHandle handle, int32_t apiId,
                               uint8_t* data, int32_t* length,
                               uint64_t* receivedTimestamp, int32_t timeoutMs,
                               int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
   }
 
   uint32_t messageId = CreateCANId(can.get(), apiId);
+
+  if (can->cached) {
+    CANReceivedMessage message;
+    if (!GetLatestCANMessage(messageId, &message)) {
+      *status = HAL_ERR_CANSessionMux_MessageNotFound;
+      return;
+    }
+    uint32_t now = GetPacketBaseTime();
+    if (now - message.timeStamp > static_cast<uint32_t>(timeoutMs)) {
+      // Timeout, return bad status
+      *status = HAL_CAN_TIMEOUT;
+      return;
+    }
+    CopyCachedMessage(message, data, length, receivedTimestamp);
+    *status = 0;
+    return;
+  }
+
   uint8_t dataSize = 0;
   uint32_t ts = 0;
   HAL_CAN_ReceiveMessage(&messageId, 0x1FFFFFFF, data, &dataSize, &ts, status);
@@ -0,0 +1,165 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "CANReceiver.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>  // For std::atexit()
+#include <cstring>
+#include <thread>
+
+#include <wpi/mutex.h>
+
+#include "hal/CAN.h"
+
+using namespace hal;
+
+// Number of arbitration IDs the cache can hold; must be a power of two
+static constexpr uint32_t kNumSlots = 2048;
+static constexpr uint32_t kEmptySlot = UINT32_MAX;
+// Messages the stream session buffers between reads
+static constexpr uint32_t kStreamBufferSize = 2048;
+// Messages read from the stream session per NetComm call
+static constexpr uint32_t kReadBatchSize = 64;
+static constexpr auto kPollPeriod = std::chrono::milliseconds(1);
+
+namespace {
+// The latest message with one arbitration ID. Only the receiver thread writes
+// slots, so readers use the sequence as a seqlock: it is odd while the message
+// is being written, and readers retry if it changed while they read.
+struct Slot {
+  std::atomic<uint32_t> messageID{kEmptySlot};
+  std::atomic<uint32_t> sequence{0};
+  std::atomic<uint64_t> data{0};
+  // The timestamp in the low 32 bits and the length above it
+  std::atomic<uint64_t> info{0};
+};
+}  // namespace
+
+static Slot slots[kNumSlots];
+
+static wpi::mutex receiverMutex;
+static std::thread receiverThread;
+static std::atomic_bool receiverRunning{false};
+static bool receiverStarted = false;
+static uint32_t receiverSession = 0;
+
+static uint32_t HashMessageID(uint32_t messageID) {
+  return (messageID * 2654435761u) >> 21;  // top 11 bits for kNumSlots
+}
+
+static void StoreMessage(const HAL_CANStreamMessage& message) {
+  uint32_t messageID = message.messageID & 0x1FFFFFFF;
+  uint32_t index = HashMessageID(messageID);
+  for (uint32_t probe = 0; probe < kNumSlots; ++probe) {
+    Slot& slot = slots[(index + probe) & (kNumSlots - 1)];
+    uint32_t slotID = slot.messageID.load(std::memory_order_relaxed);
+    if (slotID != messageID && slotID != kEmptySlot) {
+      continue;
+    }
+
+    uint64_t data = 0;
+    std::memcpy(&data, message.data, sizeof(message.data));
+    uint64_t info = message.timeStamp |
+                    (static_cast<uint64_t>(message.dataSize & 0xF) << 32);
+
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.info.store(info, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    // Claim an empty slot only once its message is complete
+    if (slotID == kEmptySlot) {
+      slot.messageID.store(messageID, std::memory_order_release);
+    }
+    return;
+  }
+  // The cache is full; messages with IDs it doesn't hold are dropped
+}
+
+static void ReceiverThreadMain() {
+  HAL_CANStreamMessage messages[kReadBatchSize];
+  while (receiverRunning) {
+    uint32_t messagesRead = 0;
+    int32_t status = 0;
+    HAL_CAN_ReadStreamSession(receiverSession, messages, kReadBatchSize,
+                              &messagesRead, &status);
+    for (uint32_t i = 0; i < messagesRead; ++i) {
+      StoreMessage(messages[i]);
+    }
+    // A full batch means more are likely waiting
+    if (messagesRead < kReadBatchSize) {
+      std::this_thread::sleep_for(kPollPeriod);
+    }
+  }
+}
+
+static void CleanupReceiverAtExit() {
+  receiverRunning = false;
+  if (receiverThread.joinable()) {
+    receiverThread.join();
+  }
+  HAL_CAN_CloseStreamSession(receiverSession);
+}
+
+namespace hal {
+
+bool StartCANReceiver() {
+  std::scoped_lock lock(receiverMutex);
+  if (receiverStarted) {
+    return receiverRunning;
+  }
+  receiverStarted = true;
+
+  // Stream every message on the bus
+  int32_t status = 0;
+  HAL_CAN_OpenStreamSession(&receiverSession, 0, 0, kStreamBufferSize,
+                            &status);
+  if (status != 0) {
+    return false;
+  }
+
+  receiverRunning = true;
+  receiverThread = std::thread(ReceiverThreadMain);
+  std::atexit(CleanupReceiverAtExit);
+  return true;
+}
+
+bool GetLatestCANMessage(uint32_t messageID, CANReceivedMessage* message) {
+  uint32_t index = HashMessageID(messageID);
+  for (uint32_t probe = 0; probe < kNumSlots; ++probe) {
+    const Slot& slot = slots[(index + probe) & (kNumSlots - 1)];
+    uint32_t slotID = slot.messageID.load(std::memory_order_acquire);
+    if (slotID == kEmptySlot) {
+      return false;
+    }
+    if (slotID != messageID) {
+      continue;
+    }
+
+    uint32_t before;
+    uint32_t after;
+    uint64_t data;
+    uint64_t info;
+    do {
+      before = slot.sequence.load(std::memory_order_acquire);
+      data = slot.data.load(std::memory_order_relaxed);
+      info = slot.info.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = slot.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+
+    std::memcpy(message->data, &data, sizeof(message->data));
+    message->length = static_cast<uint8_t>(info >> 32);
+    message->timeStamp = static_cast<uint32_t>(info);
+    message->sequence = before / 2;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace hal
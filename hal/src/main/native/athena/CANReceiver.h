@@ -0,0 +1,42 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace hal {
+
+/**
+ * The latest message received with an arbitration ID.
+ */
+struct CANReceivedMessage {
+  uint8_t data[8];
+  uint8_t length;
+  uint32_t timeStamp;
+  // Number of messages received with the ID; changes whenever a new one comes
+  uint32_t sequence;
+};
+
+/**
+ * Starts the background thread that drains a CAN stream session into the
+ * latest-value cache, if it isn't running already.
+ *
+ * @return True if the cache is being filled; false if the stream session
+ *         couldn't be opened, in which case messages must be received directly
+ *         with HAL_CAN_ReceiveMessage().
+ */
+bool StartCANReceiver();
+
+/**
+ * Reads the latest message received with an arbitration ID from the cache,
+ * without locking or calling into NetComm.
+ *
+ * @param messageID The 29-bit arbitration ID.
+ * @param message   Where to store the message.
+ * @return False if no message has been received with the ID.
+ */
+bool GetLatestCANMessage(uint32_t messageID, CANReceivedMessage* message);
+
+}  // namespace hal
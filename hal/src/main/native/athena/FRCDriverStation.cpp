@@ -121,6 +121,81 @@ static int32_t HAL_GetMatchInfoInternal(HAL_MatchInfo* info) {
   return status;
 }
 
+namespace {
+// Everything the joystick and control word getters return, captured once per
+// DS packet so they don't each call into NetComm
+struct DSSnapshot {
+  HAL_ControlWord controlWord;
+  int32_t controlWordStatus;
+  HAL_JoystickAxes axes[kJoystickPorts];
+  int32_t axesStatus[kJoystickPorts];
+  HAL_JoystickPOVs povs[kJoystickPorts];
+  int32_t povsStatus[kJoystickPorts];
+  HAL_JoystickButtons buttons[kJoystickPorts];
+  int32_t buttonsStatus[kJoystickPorts];
+};
+}  // namespace
+
+static constexpr size_t kSnapshotWords =
+    (sizeof(DSSnapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+// The snapshot is stored as atomic words guarded by a seqlock: writers are
+// serialized by snapshotWriteMutex, and readers copy it out without locking and
+// retry if the sequence changed (or was odd, meaning a write was in progress)
+// while they read. A sequence of 0 means no snapshot has been captured yet.
+static wpi::mutex snapshotWriteMutex;
+static std::atomic<uint32_t> snapshotSequence{0};
+static std::atomic<uint64_t> snapshotWords[kSnapshotWords];
+
+static void CaptureSnapshot() {
+  std::scoped_lock lock(snapshotWriteMutex);
+  DSSnapshot snapshot{};
+  snapshot.controlWordStatus =
+      HAL_GetControlWordInternal(&snapshot.controlWord);
+  for (int32_t i = 0; i < kJoystickPorts; ++i) {
+    snapshot.axesStatus[i] = HAL_GetJoystickAxesInternal(i, &snapshot.axes[i]);
+    snapshot.povsStatus[i] = HAL_GetJoystickPOVsInternal(i, &snapshot.povs[i]);
+    snapshot.buttonsStatus[i] =
+        HAL_GetJoystickButtonsInternal(i, &snapshot.buttons[i]);
+  }
+
+  uint64_t words[kSnapshotWords] = {};
+  std::memcpy(words, &snapshot, sizeof(snapshot));
+
+  uint32_t sequence = snapshotSequence.load(std::memory_order_relaxed);
+  snapshotSequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < kSnapshotWords; ++i) {
+    snapshotWords[i].store(words[i], std::memory_order_relaxed);
+  }
+  snapshotSequence.store(sequence + 2, std::memory_order_release);
+}
+
+// Copies out the latest snapshot; returns false if there isn't one yet
+static bool ReadSnapshot(DSSnapshot* snapshot) {
+  uint64_t words[kSnapshotWords];
+  uint32_t before;
+  uint32_t after;
+  do {
+    before = snapshotSequence.load(std::memory_order_acquire);
+    if (before == 0) {
+      return false;
+    }
+    for (size_t i = 0; i < kSnapshotWords; ++i) {
+      words[i] = snapshotWords[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = snapshotSequence.load(std::memory_order_relaxed);
+  } while ((before & 1) != 0 || before != after);
+
+  std::memcpy(snapshot, words, sizeof(*snapshot));
+  return true;
+}
+
+static bool IsJoystickInRange(int32_t joystickNum) {
+  return joystickNum >= 0 && joystickNum < kJoystickPorts;
+}
+
 static wpi::mutex* newDSDataAvailableMutex;
 static wpi::condition_variable* newDSDataAvailableCond;
 static int newDSDataAvailableCounter{0};
@@ -243,20 +318,40 @@ int32_t HAL_SendConsoleLine(const char* line) {
 }
 
 int32_t HAL_GetControlWord(HAL_ControlWord* controlWord) {
-  return HAL_GetControlWordInternal(controlWord);
+  DSSnapshot snapshot;
+  if (!ReadSnapshot(&snapshot)) {
+    return HAL_GetControlWordInternal(controlWord);
+  }
+  *controlWord = snapshot.controlWord;
+  return snapshot.controlWordStatus;
 }
 
 int32_t HAL_GetJoystickAxes(int32_t joystickNum, HAL_JoystickAxes* axes) {
-  return HAL_GetJoystickAxesInternal(joystickNum, axes);
+  DSSnapshot snapshot;
+  if (!IsJoystickInRange(joystickNum) || !ReadSnapshot(&snapshot)) {
+    return HAL_GetJoystickAxesInternal(joystickNum, axes);
+  }
+  *axes = snapshot.axes[joystickNum];
+  return snapshot.axesStatus[joystickNum];
 }
 
 int32_t HAL_GetJoystickPOVs(int32_t joystickNum, HAL_JoystickPOVs* povs) {
-  return HAL_GetJoystickPOVsInternal(joystickNum, povs);
+  DSSnapshot snapshot;
+  if (!IsJoystickInRange(joystickNum) || !ReadSnapshot(&snapshot)) {
+    return HAL_GetJoystickPOVsInternal(joystickNum, povs);
+  }
+  *povs = snapshot.povs[joystickNum];
+  return snapshot.povsStatus[joystickNum];
 }
 
 int32_t HAL_GetJoystickButtons(int32_t joystickNum,
                                HAL_JoystickButtons* buttons) {
-  return HAL_GetJoystickButtonsInternal(joystickNum, buttons);
+  DSSnapshot snapshot;
+  if (!IsJoystickInRange(joystickNum) || !ReadSnapshot(&snapshot)) {
+    return HAL_GetJoystickButtonsInternal(joystickNum, buttons);
+  }
+  *buttons = snapshot.buttons[joystickNum];
+  return snapshot.buttonsStatus[joystickNum];
 }
 
 int32_t HAL_GetJoystickDescriptor(int32_t joystickNum,
@@ -411,6 +506,8 @@ static void newDataOccur(uint32_t refNum) {
   if (refNum != refNumber) {
     return;
   }
+  // Capture the new data before waking the threads that will read it
+  CaptureSnapshot();
   std::scoped_lock lock{*newDSDataAvailableMutex};
   // Notify all threads
   ++newDSDataAvailableCounter;
@@ -8,7 +8,9 @@
 #include <sys/prctl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -272,6 +274,72 @@ uint64_t HAL_GetFPGATime(int32_t* status) {
   return (upper2 << 32) + lower;
 }
 
+// The fast clock maps the CPU monotonic clock (a vDSO read, no syscall) to
+// FPGA time with an offset that is resynced every kFastClockResyncPeriod.
+// The two clocks come from different crystals (within ~100 ppm of each
+// other), so the drift between resyncs is at most a few microseconds.
+static constexpr int64_t kFastClockResyncPeriod = 100000;  // us
+static constexpr int kFastClockSyncSamples = 3;
+
+static std::atomic<int64_t> fastClockOffset{0};
+static std::atomic<int64_t> fastClockSyncTime{INT64_MIN};
+static std::atomic_flag fastClockSyncing = ATOMIC_FLAG_INIT;
+static std::atomic<uint64_t> fastClockLast{0};
+
+static int64_t MonotonicMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Measures the offset using the sample with the smallest read window, so the
+// error is at most half of that window (typically 1-2 us)
+static void SyncFastClock(int64_t now, int32_t* status) {
+  int64_t bestWindow = INT64_MAX;
+  int64_t bestOffset = 0;
+  for (int i = 0; i < kFastClockSyncSamples; ++i) {
+    int64_t before = MonotonicMicros();
+    uint64_t fpgaTime = HAL_GetFPGATime(status);
+    int64_t after = MonotonicMicros();
+    if (*status != 0) {
+      return;
+    }
+    if (after - before < bestWindow) {
+      bestWindow = after - before;
+      bestOffset = static_cast<int64_t>(fpgaTime) - (before + after) / 2;
+    }
+  }
+  fastClockOffset.store(bestOffset, std::memory_order_relaxed);
+  fastClockSyncTime.store(now, std::memory_order_release);
+}
+
+uint64_t HAL_GetFPGATimeFast(int32_t* status) {
+  int64_t now = MonotonicMicros();
+  int64_t syncTime = fastClockSyncTime.load(std::memory_order_acquire);
+  bool synced = syncTime != INT64_MIN;
+  if (!synced || now - syncTime >= kFastClockResyncPeriod) {
+    // One caller resyncs; others keep using the old offset meanwhile
+    if (!fastClockSyncing.test_and_set(std::memory_order_acquire)) {
+      SyncFastClock(now, status);
+      fastClockSyncing.clear(std::memory_order_release);
+      synced = *status == 0;
+    }
+    if (!synced) {
+      // Until the first sync, read the FPGA
+      return HAL_GetFPGATime(status);
+    }
+  }
+
+  uint64_t time = static_cast<uint64_t>(
+      now + fastClockOffset.load(std::memory_order_relaxed));
+  // A resync can move the offset back slightly; never go backwards
+  uint64_t last = fastClockLast.load(std::memory_order_relaxed);
+  while (time > last && !fastClockLast.compare_exchange_weak(
+                            last, time, std::memory_order_relaxed)) {
+  }
+  return (std::max)(time, last);
+}
+
 uint64_t HAL_ExpandFPGATime(uint32_t unexpanded_lower, int32_t* status) {
   // Capture the current FPGA time.  This will give us the upper half of the
   // clock.
@@ -305,6 +373,9 @@ HAL_Bool HAL_GetFPGAButton(int32_t* status) {
 }
 
 HAL_Bool HAL_GetSystemActive(int32_t* status) {
+  if (HAL_PowerStatus sample; hal::GetSampledPowerStatus(&sample)) {
+    return sample.systemActive;
+  }
   if (!watchdog) {
     *status = NiFpga_Status_ResourceNotInitialized;
     return false;
@@ -313,6 +384,9 @@ HAL_Bool HAL_GetSystemActive(int32_t* status) {
 }
 
 HAL_Bool HAL_GetBrownedOut(int32_t* status) {
+  if (HAL_PowerStatus sample; hal::GetSampledPowerStatus(&sample)) {
+    return sample.brownedOut;
+  }
   if (!watchdog) {
     *status = NiFpga_Status_ResourceNotInitialized;
     return false;
@@ -8,6 +8,10 @@
 
 #include <string_view>
 
+#include "hal/Types.h"
+
+struct HAL_PowerStatus;
+
 namespace hal {
 void ReleaseFPGAInterrupt(int32_t interruptNumber);
 void SetLastError(int32_t* status, std::string_view value);
@@ -17,4 +21,9 @@ void SetLastErrorIndexOutOfRange(int32_t* status, std::string_view message,
 void SetLastErrorPreviouslyAllocated(int32_t* status, std::string_view message,
                                      int32_t channel,
                                      std::string_view previousAllocation);
+
+// Get the latest snapshot from the power status sampler, if it is running.
+// Always false on the sampler thread.
+bool GetSampledPowerStatus(HAL_PowerStatus* powerStatus);
+bool GetSampledPDPStatus(HAL_PDPHandle handle, HAL_PowerStatus* powerStatus);
 }  // namespace hal
@@ -4,8 +4,12 @@
 
 #include "hal/Interrupts.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 
+#include <wpi/BoundedConcurrentQueue.h>
 #include <wpi/SafeThread.h>
 
 #include "DigitalInternal.h"
@@ -15,6 +19,7 @@
 #include "hal/ChipObject.h"
 #include "hal/Errors.h"
 #include "hal/HALBase.h"
+#include "hal/Threads.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/LimitedHandleResource.h"
 
@@ -27,20 +32,103 @@ struct Interrupt {
   std::unique_ptr<tInterruptManager> manager;
 };
 
+// Real-time priority of the interrupt group threads
+constexpr int32_t kGroupThreadPriority = 40;
+
+// How often the group threads check if they should exit
+constexpr int32_t kGroupWatchTimeoutMs = 100;
+
+// The interrupts in a group, by interrupt index
+struct InterruptGroupSources {
+  uint32_t mask = 0;
+  HAL_InterruptHandle handles[kNumInterrupts] = {};
+  std::shared_ptr<Interrupt> interrupts[kNumInterrupts];
+};
+
+class InterruptGroupThread : public wpi::SafeThread {
+ public:
+  InterruptGroupThread(const InterruptGroupSources& sources,
+                       int32_t queueDepth)
+      : m_sources{sources}, m_events{static_cast<size_t>(queueDepth)} {}
+
+  void Main() override;
+
+  const InterruptGroupSources m_sources;
+  wpi::BoundedConcurrentQueue<HAL_InterruptEvent> m_events;
+  std::atomic<int64_t> m_dropped{0};
+};
+
+struct InterruptGroup {
+  wpi::SafeThreadOwner<InterruptGroupThread> thread;
+};
+
 }  // namespace
 
 static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
                              HAL_HandleEnum::Interrupt>* interruptHandles;
 
+static LimitedHandleResource<HAL_InterruptGroupHandle, InterruptGroup,
+                             kNumInterrupts, HAL_HandleEnum::InterruptGroup>*
+    interruptGroupHandles;
+
 namespace hal::init {
 void InitializeInterrupts() {
   static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
                                HAL_HandleEnum::Interrupt>
       iH;
   interruptHandles = &iH;
+  static LimitedHandleResource<HAL_InterruptGroupHandle, InterruptGroup,
+                               kNumInterrupts, HAL_HandleEnum::InterruptGroup>
+      igH;
+  interruptGroupHandles = &igH;
 }
 }  // namespace hal::init
 
+void InterruptGroupThread::Main() {
+  int32_t status = 0;
+  HAL_SetCurrentThreadPriority(true, kGroupThreadPriority, &status);
+
+  tInterruptManager manager{m_sources.mask, true, &status};
+  HAL_InterruptEvent batch[kNumInterrupts * 2];
+
+  while (m_active) {
+    status = 0;
+    uint32_t fired = manager.watch(kGroupWatchTimeoutMs, false, &status);
+    if (status != 0 || fired == 0) {
+      continue;
+    }
+
+    // One watch can return edges from several sources; queue them in order
+    int32_t count = 0;
+    for (int32_t i = 0; i < kNumInterrupts; ++i) {
+      if (!m_sources.interrupts[i]) {
+        continue;
+      }
+      auto& anInterrupt = m_sources.interrupts[i]->anInterrupt;
+      HAL_InterruptHandle handle = m_sources.handles[i];
+      if (fired & (1u << i)) {
+        int64_t timestamp = HAL_ExpandFPGATime(
+            anInterrupt->readRisingTimeStamp(&status), &status);
+        batch[count++] = {handle, true, timestamp};
+      }
+      if (fired & (1u << (i + 8))) {
+        int64_t timestamp = HAL_ExpandFPGATime(
+            anInterrupt->readFallingTimeStamp(&status), &status);
+        batch[count++] = {handle, false, timestamp};
+      }
+    }
+    std::sort(batch, batch + count, [](const auto& a, const auto& b) {
+      return a.timestamp < b.timestamp;
+    });
+    for (int32_t i = 0; i < count; ++i) {
+      if (!m_events.try_push(batch[i])) {
+        m_dropped.fetch_add(count - i, std::memory_order_relaxed);
+        break;
+      }
+    }
+  }
+}
+
 extern "C" {
 
 HAL_InterruptHandle HAL_InitializeInterrupts(int32_t* status) {
@@ -165,4 +253,113 @@ void HAL_ReleaseWaitingInterrupt(HAL_InterruptHandle interruptHandle,
   hal::ReleaseFPGAInterrupt(interruptIndex + 8);
 }
 
+HAL_InterruptGroupHandle HAL_InitializeInterruptGroup(
+    const HAL_InterruptHandle* interruptHandles, int32_t numInterrupts,
+    int32_t queueDepth, int32_t* status) {
+  hal::init::CheckInit();
+  if (numInterrupts < 1 || queueDepth < 1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return HAL_kInvalidHandle;
+  }
+
+  InterruptGroupSources sources;
+  for (int32_t i = 0; i < numInterrupts; ++i) {
+    auto anInterrupt = ::interruptHandles->Get(interruptHandles[i]);
+    if (anInterrupt == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return HAL_kInvalidHandle;
+    }
+    uint32_t index = static_cast<uint32_t>(getHandleIndex(interruptHandles[i]));
+    sources.mask |= (1u << index) | (1u << (index + 8u));
+    sources.handles[index] = interruptHandles[i];
+    sources.interrupts[index] = std::move(anInterrupt);
+  }
+
+  HAL_InterruptGroupHandle handle = interruptGroupHandles->Allocate();
+  if (handle == HAL_kInvalidHandle) {
+    *status = NO_AVAILABLE_RESOURCES;
+    return HAL_kInvalidHandle;
+  }
+  auto group = interruptGroupHandles->Get(handle);
+
+  group->thread.Start(sources, queueDepth);
+  return handle;
+}
+
+void HAL_CleanInterruptGroup(HAL_InterruptGroupHandle interruptGroupHandle) {
+  auto group = interruptGroupHandles->Get(interruptGroupHandle);
+  interruptGroupHandles->Free(interruptGroupHandle);
+  if (group == nullptr) {
+    return;
+  }
+
+  // Wake the thread out of its watch so it sees it should stop
+  uint32_t mask = 0;
+  if (auto thr = group->thread.GetThreadSharedPtr()) {
+    thr->m_active = false;
+    mask = thr->m_sources.mask;
+  }
+  for (uint32_t i = 0; i < 32; ++i) {
+    if (mask & (1u << i)) {
+      hal::ReleaseFPGAInterrupt(i);
+    }
+  }
+  group->thread.Join();
+}
+
+int32_t HAL_ReadInterruptGroupEvents(
+    HAL_InterruptGroupHandle interruptGroupHandle,
+    struct HAL_InterruptEvent* events, int32_t maxEvents, double timeout,
+    int32_t* status) {
+  auto group = interruptGroupHandles->Get(interruptGroupHandle);
+  if (group == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  auto thr = group->thread.GetThreadSharedPtr();
+  if (!thr || maxEvents < 1) {
+    return 0;
+  }
+
+  // An invalid handle is a release from HAL_ReleaseWaitingInterruptGroup()
+  HAL_InterruptEvent event;
+  if (!thr->m_events.try_pop_for(event, std::chrono::duration<double>(
+                                            (std::max)(timeout, 0.0))) ||
+      event.interrupt == HAL_kInvalidHandle) {
+    return 0;
+  }
+  int32_t count = 0;
+  do {
+    if (event.interrupt == HAL_kInvalidHandle) {
+      break;
+    }
+    events[count++] = event;
+  } while (count < maxEvents && thr->m_events.try_pop(event));
+  return count;
+}
+
+void HAL_ReleaseWaitingInterruptGroup(
+    HAL_InterruptGroupHandle interruptGroupHandle, int32_t* status) {
+  auto group = interruptGroupHandles->Get(interruptGroupHandle);
+  if (group == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (auto thr = group->thread.GetThreadSharedPtr()) {
+    // If the queue is full, no one is waiting
+    thr->m_events.try_push({HAL_kInvalidHandle, false, 0});
+  }
+}
+
+int64_t HAL_GetInterruptGroupDroppedCount(
+    HAL_InterruptGroupHandle interruptGroupHandle, int32_t* status) {
+  auto group = interruptGroupHandles->Get(interruptGroupHandle);
+  if (group == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  auto thr = group->thread.GetThreadSharedPtr();
+  return thr ? thr->m_dropped.load(std::memory_order_relaxed) : 0;
+}
+
 }  // extern "C"
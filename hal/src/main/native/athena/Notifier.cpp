@@ -10,7 +10,9 @@
 #include <thread>
 
 #include <wpi/condition_variable.h>
+#include <wpi/indexed_priority_queue.h>
 #include <wpi/mutex.h>
+#include <wpi/trace.h>
 
 #include "HALInitializer.h"
 #include "HALInternal.h"
@@ -28,6 +30,10 @@ static wpi::mutex notifierMutex;
 static std::unique_ptr<tAlarm> notifierAlarm;
 static std::thread notifierThread;
 static uint64_t closestTrigger{UINT64_MAX};
+// Notifiers with a pending alarm, earliest first; protected by notifierMutex
+static wpi::indexed_priority_queue<HAL_NotifierHandle, uint64_t,
+                                   std::greater<uint64_t>>
+    notifierQueue;
 
 namespace {
 
@@ -74,24 +80,30 @@ static void alarmCallback() {
   // the hardware disables itself after each alarm
   closestTrigger = UINT64_MAX;
 
-  // process all notifiers
-  notifierHandles->ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
-    if (notifier->triggerTime == UINT64_MAX) {
-      return;
-    }
-    if (currentTime == 0) {
-      currentTime = HAL_GetFPGATime(&status);
+  // process the notifiers that are due, earliest first
+  if (!notifierQueue.empty()) {
+    currentTime = HAL_GetFPGATime(&status);
+  }
+  while (!notifierQueue.empty() && notifierQueue.top().second < currentTime) {
+    auto handle = notifierQueue.pop().first;
+    auto notifier = notifierHandles->Get(handle);
+    if (!notifier) {
+      continue;
     }
     std::unique_lock lock(notifier->mutex);
+    // the trigger time may have changed since it was queued
     if (notifier->triggerTime < currentTime) {
       notifier->triggerTime = UINT64_MAX;
       notifier->triggeredTime = currentTime;
       lock.unlock();
       notifier->cond.notify_all();
-    } else if (notifier->triggerTime < closestTrigger) {
-      closestTrigger = notifier->triggerTime;
+    } else if (notifier->triggerTime != UINT64_MAX) {
+      notifierQueue.push(handle, notifier->triggerTime);
     }
-  });
+  }
+  if (!notifierQueue.empty()) {
+    closestTrigger = notifierQueue.top().second;
+  }
 
   if (notifierAlarm && closestTrigger != UINT64_MAX) {
     // Simply truncate the hardware trigger time to 32-bit.
@@ -103,6 +115,7 @@ static void alarmCallback() {
 }
 
 static void notifierThreadMain() {
+  WPI_TRACE_THREAD_NAME("HAL notifier");
   tRioStatusCode status = 0;
   tInterruptManager manager{1 << kTimerInterruptNumber, true, &status};
   while (notifierRunning) {
@@ -112,6 +125,7 @@ static void notifierThreadMain() {
     }
     if (triggeredMask == 0)
       continue;
+    WPI_TRACE_SCOPE("hal.notifier.alarm");
     alarmCallback();
   }
 }
@@ -180,6 +194,9 @@ void HAL_StopNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
     notifier->active = false;
   }
   notifier->cond.notify_all();  // wake up any waiting threads
+
+  std::scoped_lock lock(notifierMutex);
+  notifierQueue.remove(notifierHandle);
 }
 
 void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
@@ -196,6 +213,11 @@ void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
   }
   notifier->cond.notify_all();
 
+  {
+    std::scoped_lock lock(notifierMutex);
+    notifierQueue.remove(notifierHandle);
+  }
+
   if (notifierRefCount.fetch_sub(1) == 1) {
     // if this was the last notifier, clean up alarm and thread
     // the notifier can call back into our callback, so don't hold the lock
@@ -229,6 +251,11 @@ void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
   }
 
   std::scoped_lock lock(notifierMutex);
+  if (triggerTime == UINT64_MAX) {
+    notifierQueue.remove(notifierHandle);
+    return;
+  }
+  notifierQueue.push(notifierHandle, triggerTime);
   // Update alarm time if closer than current.
   if (triggerTime < closestTrigger) {
     bool wasActive = (closestTrigger != UINT64_MAX);
@@ -252,6 +279,10 @@ void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
     std::scoped_lock lock(notifier->mutex);
     notifier->triggerTime = UINT64_MAX;
   }
+
+  // the hardware alarm is left set; it finds nothing due
+  std::scoped_lock lock(notifierMutex);
+  notifierQueue.remove(notifierHandle);
 }
 
 uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
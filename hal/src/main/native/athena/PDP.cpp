@@ -4,6 +4,9 @@
 
 #include "hal/PDP.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include <fmt/format.h>
 #include <wpi/mutex.h>
 
@@ -12,6 +15,7 @@
 #include "PortsInternal.h"
 #include "hal/CANAPI.h"
 #include "hal/Errors.h"
+#include "hal/Power.h"
 
 using namespace hal;
 
@@ -162,6 +166,9 @@ HAL_Bool HAL_CheckPDPChannel(int32_t channel) {
 }
 
 double HAL_GetPDPTemperature(HAL_PDPHandle handle, int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPDPStatus(handle, &sample)) {
+    return sample.pdpTemperature;
+  }
   PdpStatus3 pdpStatus;
   int32_t length = 0;
   uint64_t receivedTimestamp = 0;
@@ -177,6 +184,9 @@ double HAL_GetPDPTemperature(HAL_PDPHandle handle, int32_t* status) {
 }
 
 double HAL_GetPDPVoltage(HAL_PDPHandle handle, int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPDPStatus(handle, &sample)) {
+    return sample.pdpVoltage;
+  }
   PdpStatus3 pdpStatus;
   int32_t length = 0;
   uint64_t receivedTimestamp = 0;
@@ -198,6 +208,9 @@ double HAL_GetPDPChannelCurrent(HAL_PDPHandle handle, int32_t channel,
     hal::SetLastError(status, fmt::format("Invalid pdp channel {}", channel));
     return 0;
   }
+  if (HAL_PowerStatus sample; GetSampledPDPStatus(handle, &sample)) {
+    return sample.pdpChannelCurrents[channel];
+  }
 
   int32_t length = 0;
   uint64_t receivedTimestamp = 0;
@@ -303,6 +316,11 @@ double HAL_GetPDPChannelCurrent(HAL_PDPHandle handle, int32_t channel,
 
 void HAL_GetPDPAllChannelCurrents(HAL_PDPHandle handle, double* currents,
                                   int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPDPStatus(handle, &sample)) {
+    std::copy(std::begin(sample.pdpChannelCurrents),
+              std::end(sample.pdpChannelCurrents), currents);
+    return;
+  }
   int32_t length = 0;
   uint64_t receivedTimestamp = 0;
   PdpStatus1 pdpStatus;
@@ -377,6 +395,9 @@ void HAL_GetPDPAllChannelCurrents(HAL_PDPHandle handle, double* currents,
 }
 
 double HAL_GetPDPTotalCurrent(HAL_PDPHandle handle, int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPDPStatus(handle, &sample)) {
+    return sample.pdpTotalCurrent;
+  }
   PdpStatusEnergy pdpStatus;
   int32_t length = 0;
   uint64_t receivedTimestamp = 0;
@@ -395,6 +416,9 @@ double HAL_GetPDPTotalCurrent(HAL_PDPHandle handle, int32_t* status) {
 }
 
 double HAL_GetPDPTotalPower(HAL_PDPHandle handle, int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPDPStatus(handle, &sample)) {
+    return sample.pdpTotalPower;
+  }
   PdpStatusEnergy pdpStatus;
   int32_t length = 0;
   uint64_t receivedTimestamp = 0;
@@ -415,6 +439,9 @@ double HAL_GetPDPTotalPower(HAL_PDPHandle handle, int32_t* status) {
 }
 
 double HAL_GetPDPTotalEnergy(HAL_PDPHandle handle, int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPDPStatus(handle, &sample)) {
+    return sample.pdpTotalEnergy;
+  }
   PdpStatusEnergy pdpStatus;
   int32_t length = 0;
   uint64_t receivedTimestamp = 0;
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "HALInitializer.h"
+#include "HALInternal.h"
 #include "hal/ChipObject.h"
 
 using namespace hal;
@@ -31,73 +32,115 @@ void InitializePower() {}
 extern "C" {
 
 double HAL_GetVinVoltage(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.vinVoltage;
+  }
   initializePower(status);
   return power->readVinVoltage(status) / 4.096 * 0.025733 - 0.029;
 }
 
 double HAL_GetVinCurrent(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.vinCurrent;
+  }
   initializePower(status);
   return power->readVinCurrent(status) / 4.096 * 0.017042 - 0.071;
 }
 
 double HAL_GetUserVoltage6V(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userVoltage6V;
+  }
   initializePower(status);
   return power->readUserVoltage6V(status) / 4.096 * 0.007019 - 0.014;
 }
 
 double HAL_GetUserCurrent6V(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userCurrent6V;
+  }
   initializePower(status);
   return power->readUserCurrent6V(status) / 4.096 * 0.005566 - 0.009;
 }
 
 HAL_Bool HAL_GetUserActive6V(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userActive6V;
+  }
   initializePower(status);
   return power->readStatus_User6V(status) == 4;
 }
 
 int32_t HAL_GetUserCurrentFaults6V(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userCurrentFaults6V;
+  }
   initializePower(status);
   return static_cast<int32_t>(
       power->readFaultCounts_OverCurrentFaultCount6V(status));
 }
 
 double HAL_GetUserVoltage5V(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userVoltage5V;
+  }
   initializePower(status);
   return power->readUserVoltage5V(status) / 4.096 * 0.005962 - 0.013;
 }
 
 double HAL_GetUserCurrent5V(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userCurrent5V;
+  }
   initializePower(status);
   return power->readUserCurrent5V(status) / 4.096 * 0.001996 - 0.002;
 }
 
 HAL_Bool HAL_GetUserActive5V(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userActive5V;
+  }
   initializePower(status);
   return power->readStatus_User5V(status) == 4;
 }
 
 int32_t HAL_GetUserCurrentFaults5V(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userCurrentFaults5V;
+  }
   initializePower(status);
   return static_cast<int32_t>(
       power->readFaultCounts_OverCurrentFaultCount5V(status));
 }
 
 double HAL_GetUserVoltage3V3(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userVoltage3V3;
+  }
   initializePower(status);
   return power->readUserVoltage3V3(status) / 4.096 * 0.004902 - 0.01;
 }
 
 double HAL_GetUserCurrent3V3(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userCurrent3V3;
+  }
   initializePower(status);
   return power->readUserCurrent3V3(status) / 4.096 * 0.002486 - 0.003;
 }
 
 HAL_Bool HAL_GetUserActive3V3(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userActive3V3;
+  }
   initializePower(status);
   return power->readStatus_User3V3(status) == 4;
 }
 
 int32_t HAL_GetUserCurrentFaults3V3(int32_t* status) {
+  if (HAL_PowerStatus sample; GetSampledPowerStatus(&sample)) {
+    return sample.userCurrentFaults3V3;
+  }
   initializePower(status);
   return static_cast<int32_t>(
       power->readFaultCounts_OverCurrentFaultCount3V3(status));
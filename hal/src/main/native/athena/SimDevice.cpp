@@ -42,6 +42,9 @@ void HAL_SetSimValue(HAL_SimValueHandle handle, const struct HAL_Value* value) {
 
 void HAL_ResetSimValue(HAL_SimValueHandle handle) {}
 
+void HAL_SetSimValues(const HAL_SimValueHandle* handles,
+                      const struct HAL_Value* values, int32_t count) {}
+
 hal::SimDevice::SimDevice(const char* name, int index) {}
 
 hal::SimDevice::SimDevice(const char* name, int index, int channel) {}
@@ -78,6 +78,8 @@ void HALSIM_CancelDriverStationNewDataCallback(int32_t uid) {}
 
 void HALSIM_NotifyDriverStationNewData(void) {}
 
+void HALSIM_SetDriverStationState(const HALSIM_DriverStationState* state) {}
+
 void HALSIM_SetJoystickButton(int32_t stick, int32_t button, HAL_Bool state) {}
 
 void HALSIM_SetJoystickAxis(int32_t stick, int32_t axis, double value) {}
@@ -30,6 +30,18 @@ void HALSIM_StepTiming(uint64_t delta) {}
 
 void HALSIM_StepTimingAsync(uint64_t delta) {}
 
+void HALSIM_SetTimingFastForward(HAL_Bool enable) {}
+
+HAL_Bool HALSIM_IsTimingFastForward(void) {
+  return false;
+}
+
+void HALSIM_SetTimingLockStep(HAL_Bool enable) {}
+
+HAL_Bool HALSIM_IsTimingLockStep(void) {
+  return false;
+}
+
 void HALSIM_SetSendError(HALSIM_SendErrorHandler handler) {}
 
 void HALSIM_SetSendConsoleLine(HALSIM_SendConsoleLineHandler handler) {}
@@ -54,6 +54,14 @@ int32_t HALSIM_RegisterSimValueCreatedCallback(HAL_SimDeviceHandle device,
 
 void HALSIM_CancelSimValueCreatedCallback(int32_t uid) {}
 
+int32_t HALSIM_RegisterSimDeviceValuesChangedCallback(
+    HAL_SimDeviceHandle device, void* param, HALSIM_SimDeviceCallback callback,
+    HAL_Bool initialNotify) {
+  return 0;
+}
+
+void HALSIM_CancelSimDeviceValuesChangedCallback(int32_t uid) {}
+
 int32_t HALSIM_RegisterSimValueChangedCallback(HAL_SimValueHandle handle,
                                                void* param,
                                                HALSIM_SimValueCallback callback,
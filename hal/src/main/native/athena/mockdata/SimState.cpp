@@ -0,0 +1,17 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "hal/simulation/SimState.h"
+
+extern "C" {
+
+int32_t HALSIM_SaveSimState(void* buffer, int32_t size) {
+  return 0;
+}
+
+HAL_Bool HALSIM_RestoreSimState(const void* buffer, int32_t size) {
+  return false;
+}
+
+}  // extern "C"
@@ -0,0 +1,168 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <memory>
+
+#include <wpi/SafeThread.h>
+#include <wpi/mutex.h>
+
+#include "hal/Errors.h"
+#include "hal/HALBase.h"
+#include "hal/PDP.h"
+#include "hal/Power.h"
+
+namespace {
+class PowerStatusSampler : public wpi::SafeThread {
+ public:
+  PowerStatusSampler(HAL_PDPHandle pdpHandle, double period)
+      : m_pdpHandle{pdpHandle}, m_period{period} {}
+
+  void Main() override;
+
+  const HAL_PDPHandle m_pdpHandle;
+  const std::chrono::duration<double> m_period;
+
+  // Guarded by m_mutex
+  HAL_PowerStatus m_powerStatus;
+  bool m_valid = false;
+};
+}  // namespace
+
+static wpi::mutex samplerMutex;
+static wpi::SafeThreadOwner<PowerStatusSampler> sampler;
+
+// The sampler thread reads through the same getters it serves
+static thread_local bool isSamplerThread = false;
+
+static void ReadPowerStatus(HAL_PDPHandle pdpHandle,
+                            HAL_PowerStatus* powerStatus, int32_t* status) {
+  *powerStatus = {};
+  powerStatus->vinVoltage = HAL_GetVinVoltage(status);
+  powerStatus->vinCurrent = HAL_GetVinCurrent(status);
+  powerStatus->userVoltage6V = HAL_GetUserVoltage6V(status);
+  powerStatus->userCurrent6V = HAL_GetUserCurrent6V(status);
+  powerStatus->userActive6V = HAL_GetUserActive6V(status);
+  powerStatus->userCurrentFaults6V = HAL_GetUserCurrentFaults6V(status);
+  powerStatus->userVoltage5V = HAL_GetUserVoltage5V(status);
+  powerStatus->userCurrent5V = HAL_GetUserCurrent5V(status);
+  powerStatus->userActive5V = HAL_GetUserActive5V(status);
+  powerStatus->userCurrentFaults5V = HAL_GetUserCurrentFaults5V(status);
+  powerStatus->userVoltage3V3 = HAL_GetUserVoltage3V3(status);
+  powerStatus->userCurrent3V3 = HAL_GetUserCurrent3V3(status);
+  powerStatus->userActive3V3 = HAL_GetUserActive3V3(status);
+  powerStatus->userCurrentFaults3V3 = HAL_GetUserCurrentFaults3V3(status);
+  powerStatus->systemActive = HAL_GetSystemActive(status);
+  powerStatus->brownedOut = HAL_GetBrownedOut(status);
+  powerStatus->timestamp = HAL_GetFPGATime(status);
+
+  powerStatus->pdpHandle = pdpHandle;
+  if (pdpHandle == HAL_kInvalidHandle) {
+    return;
+  }
+  // A PDP that is missing from the bus shouldn't fail the whole snapshot
+  int32_t pdpStatus = 0;
+  powerStatus->pdpVoltage = HAL_GetPDPVoltage(pdpHandle, &pdpStatus);
+  powerStatus->pdpTemperature = HAL_GetPDPTemperature(pdpHandle, &pdpStatus);
+  HAL_GetPDPAllChannelCurrents(pdpHandle, powerStatus->pdpChannelCurrents,
+                               &pdpStatus);
+  powerStatus->pdpTotalCurrent = HAL_GetPDPTotalCurrent(pdpHandle, &pdpStatus);
+  powerStatus->pdpTotalPower = HAL_GetPDPTotalPower(pdpHandle, &pdpStatus);
+  powerStatus->pdpTotalEnergy = HAL_GetPDPTotalEnergy(pdpHandle, &pdpStatus);
+  powerStatus->pdpValid = pdpStatus == 0;
+  if (!powerStatus->pdpValid) {
+    powerStatus->pdpVoltage = 0;
+    powerStatus->pdpTemperature = 0;
+    for (auto& current : powerStatus->pdpChannelCurrents) {
+      current = 0;
+    }
+    powerStatus->pdpTotalCurrent = 0;
+    powerStatus->pdpTotalPower = 0;
+    powerStatus->pdpTotalEnergy = 0;
+  }
+}
+
+void PowerStatusSampler::Main() {
+  isSamplerThread = true;
+
+  auto next = std::chrono::steady_clock::now();
+  std::unique_lock lock(m_mutex);
+  while (m_active) {
+    lock.unlock();
+    HAL_PowerStatus powerStatus;
+    int32_t status = 0;
+    ReadPowerStatus(m_pdpHandle, &powerStatus, &status);
+    lock.lock();
+    if (status == 0) {
+      m_powerStatus = powerStatus;
+      m_valid = true;
+    }
+
+    next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        m_period);
+    m_cond.wait_until(lock, next, [&] { return !m_active; });
+  }
+}
+
+namespace hal {
+bool GetSampledPowerStatus(HAL_PowerStatus* powerStatus) {
+  if (isSamplerThread) {
+    return false;
+  }
+  std::shared_ptr<PowerStatusSampler> thr;
+  {
+    std::scoped_lock lock(samplerMutex);
+    thr = sampler.GetThreadSharedPtr();
+  }
+  if (!thr) {
+    return false;
+  }
+  std::scoped_lock lock(thr->m_mutex);
+  if (!thr->m_valid) {
+    return false;
+  }
+  *powerStatus = thr->m_powerStatus;
+  return true;
+}
+
+bool GetSampledPDPStatus(HAL_PDPHandle handle, HAL_PowerStatus* powerStatus) {
+  return GetSampledPowerStatus(powerStatus) &&
+         powerStatus->pdpHandle == handle && powerStatus->pdpValid;
+}
+}  // namespace hal
+
+extern "C" {
+
+void HAL_StartPowerStatusSampler(HAL_PDPHandle pdpHandle, double period,
+                                 int32_t* status) {
+  if (period <= 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  std::scoped_lock lock(samplerMutex);
+  if (sampler) {
+    *status = RESOURCE_IS_ALLOCATED;
+    return;
+  }
+  sampler.Start(pdpHandle, period);
+}
+
+void HAL_StopPowerStatusSampler(void) {
+  wpi::SafeThreadOwner<PowerStatusSampler> thr;
+  {
+    std::scoped_lock lock(samplerMutex);
+    thr = std::move(sampler);
+  }
+  thr.Join();
+}
+
+void HAL_GetPowerStatus(struct HAL_PowerStatus* powerStatus,
+                        int32_t* status) {
+  if (!hal::GetSampledPowerStatus(powerStatus)) {
+    ReadPowerStatus(HAL_kInvalidHandle, powerStatus, status);
+  }
+}
+
+}  // extern "C"
@@ -0,0 +1,191 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include <wpi/SafeThread.h>
+#include <wpi/mutex.h>
+
+#include "hal/Errors.h"
+#include "hal/SPI.h"
+#include "hal/Threads.h"
+
+namespace {
+constexpr int32_t kNumPorts = HAL_SPI_kMXP + 1;
+
+// Real-time priority of the stream threads
+constexpr int32_t kStreamThreadPriority = 45;
+
+class SPIAutoStream : public wpi::SafeThread {
+ public:
+  SPIAutoStream(HAL_SPIPort port, int32_t transferSize, int32_t depth,
+                double period, HAL_SPIAutoStreamCallback callback, void* param)
+      : m_port{port},
+        m_transferWords{transferSize + 1},  // +1 for timestamp
+        m_capacity{depth},
+        m_period{period},
+        m_callback{callback},
+        m_param{param},
+        m_ring{std::make_unique<uint32_t[]>(m_transferWords * m_capacity)} {}
+
+  void Main() override;
+
+  const HAL_SPIPort m_port;
+  const int32_t m_transferWords;
+  const int32_t m_capacity;  // in transfers
+  const std::chrono::duration<double> m_period;
+  const HAL_SPIAutoStreamCallback m_callback;
+  void* const m_param;
+  std::unique_ptr<uint32_t[]> m_ring;
+
+  // Positions in transfers since the start, guarded by m_mutex; the ring holds
+  // [m_readPos, m_writePos). m_cond is notified when either changes.
+  uint64_t m_readPos = 0;
+  uint64_t m_writePos = 0;
+};
+}  // namespace
+
+static wpi::mutex streamsMutex;
+static wpi::SafeThreadOwner<SPIAutoStream> streams[kNumPorts];
+
+void SPIAutoStream::Main() {
+  int32_t status = 0;
+  HAL_SetCurrentThreadPriority(true, kStreamThreadPriority, &status);
+
+  std::unique_lock lock(m_mutex);
+  while (m_active) {
+    int32_t used = m_writePos - m_readPos;
+    if (used == m_capacity) {
+      // wait for room in the ring
+      m_cond.wait_for(lock, m_period);
+      continue;
+    }
+    // only write up to the end of the ring so transfers stay contiguous
+    int32_t offset = m_writePos % m_capacity;
+    int32_t room = (std::min)(m_capacity - offset, m_capacity - used);
+    uint32_t* data = &m_ring[offset * m_transferWords];
+    lock.unlock();
+
+    // only get whole transfers
+    status = 0;
+    int32_t numTransfers =
+        HAL_ReadSPIAutoReceivedData(m_port, data, 0, 0, &status) /
+        m_transferWords;
+    numTransfers = (std::min)(numTransfers, room);
+    if (status == 0 && numTransfers > 0) {
+      HAL_ReadSPIAutoReceivedData(m_port, data, numTransfers * m_transferWords,
+                                  0, &status);
+    }
+    if (status != 0 || numTransfers <= 0) {
+      lock.lock();
+      m_cond.wait_for(lock, m_period);
+      continue;
+    }
+
+    if (m_callback) {
+      m_callback(m_param, data, numTransfers);
+      lock.lock();
+      m_writePos += numTransfers;
+      m_readPos += numTransfers;
+    } else {
+      lock.lock();
+      m_writePos += numTransfers;
+      m_cond.notify_all();
+    }
+  }
+}
+
+static std::shared_ptr<SPIAutoStream> GetStream(HAL_SPIPort port,
+                                                int32_t* status) {
+  if (port < 0 || port >= kNumPorts) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return nullptr;
+  }
+  std::scoped_lock lock(streamsMutex);
+  auto stream = streams[port].GetThreadSharedPtr();
+  if (!stream) {
+    *status = INCOMPATIBLE_STATE;
+  }
+  return stream;
+}
+
+extern "C" {
+
+void HAL_StartSPIAutoStream(HAL_SPIPort port, int32_t transferSize,
+                            int32_t depth, double period,
+                            HAL_SPIAutoStreamCallback callback, void* param,
+                            int32_t* status) {
+  if (port < 0 || port >= kNumPorts || transferSize < 1 || depth < 1 ||
+      period <= 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  std::scoped_lock lock(streamsMutex);
+  if (streams[port]) {
+    *status = RESOURCE_IS_ALLOCATED;
+    return;
+  }
+  streams[port].Start(port, transferSize, depth, period, callback, param);
+}
+
+void HAL_StopSPIAutoStream(HAL_SPIPort port, int32_t* status) {
+  if (port < 0 || port >= kNumPorts) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  wpi::SafeThreadOwner<SPIAutoStream> stream;
+  {
+    std::scoped_lock lock(streamsMutex);
+    stream = std::move(streams[port]);
+  }
+  stream.Join();
+}
+
+int32_t HAL_AcquireSPIAutoStream(HAL_SPIPort port, const uint32_t** data,
+                                 double timeout, int32_t* status) {
+  auto stream = GetStream(port, status);
+  if (!stream) {
+    return 0;
+  }
+  if (stream->m_callback) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+
+  std::unique_lock lock(stream->m_mutex);
+  stream->m_cond.wait_for(lock, std::chrono::duration<double>(timeout), [&] {
+    return !stream->m_active || stream->m_writePos != stream->m_readPos;
+  });
+  int32_t offset = stream->m_readPos % stream->m_capacity;
+  *data = &stream->m_ring[offset * stream->m_transferWords];
+  return (std::min)(
+      static_cast<int32_t>(stream->m_writePos - stream->m_readPos),
+      stream->m_capacity - offset);
+}
+
+void HAL_ReleaseSPIAutoStream(HAL_SPIPort port, int32_t numTransfers,
+                              int32_t* status) {
+  auto stream = GetStream(port, status);
+  if (!stream) {
+    return;
+  }
+
+  {
+    std::scoped_lock lock(stream->m_mutex);
+    if (numTransfers < 0 ||
+        static_cast<uint64_t>(numTransfers) >
+            stream->m_writePos - stream->m_readPos) {
+      *status = PARAMETER_OUT_OF_RANGE;
+      return;
+    }
+    stream->m_readPos += numTransfers;
+  }
+  stream->m_cond.notify_all();
+}
+
+}  // extern "C"
@@ -682,4 +682,46 @@ Java_edu_wpi_first_hal_AnalogJNI_getAnalogTriggerFPGAIndex
   return val;
 }
 
+/*
+ * Class:     edu_wpi_first_hal_AnalogJNI
+ * Method:    getAnalogValueBatch
+ * Signature: ([ILjava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_AnalogJNI_getAnalogValueBatch
+  (JNIEnv* env, jclass, jintArray handles, jobject buffer)
+{
+  GetBatch<int32_t>(env, handles, buffer, [](jint handle, int32_t* status) {
+    return HAL_GetAnalogValue((HAL_AnalogInputHandle)handle, status);
+  });
+}
+
+/*
+ * Class:     edu_wpi_first_hal_AnalogJNI
+ * Method:    getAnalogVoltageBatch
+ * Signature: ([ILjava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_AnalogJNI_getAnalogVoltageBatch
+  (JNIEnv* env, jclass, jintArray handles, jobject buffer)
+{
+  GetBatch<double>(env, handles, buffer, [](jint handle, int32_t* status) {
+    return HAL_GetAnalogVoltage((HAL_AnalogInputHandle)handle, status);
+  });
+}
+
+/*
+ * Class:     edu_wpi_first_hal_AnalogJNI
+ * Method:    getAnalogAverageVoltageBatch
+ * Signature: ([ILjava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_AnalogJNI_getAnalogAverageVoltageBatch
+  (JNIEnv* env, jclass, jintArray handles, jobject buffer)
+{
+  GetBatch<double>(env, handles, buffer, [](jint handle, int32_t* status) {
+    return HAL_GetAnalogAverageVoltage((HAL_AnalogInputHandle)handle, status);
+  });
+}
+
 }  // extern "C"
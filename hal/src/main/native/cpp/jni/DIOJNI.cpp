@@ -261,4 +261,33 @@ Java_edu_wpi_first_hal_DIOJNI_setDigitalPWMOutputChannel
   CheckStatus(env, status);
 }
 
+/*
+ * Class:     edu_wpi_first_hal_DIOJNI
+ * Method:    getDIOBatch
+ * Signature: ([ILjava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_DIOJNI_getDIOBatch
+  (JNIEnv* env, jclass, jintArray handles, jobject buffer)
+{
+  GetBatch<uint8_t>(env, handles, buffer, [](jint handle, int32_t* status) {
+    return static_cast<uint8_t>(HAL_GetDIO((HAL_DigitalHandle)handle, status));
+  });
+}
+
+/*
+ * Class:     edu_wpi_first_hal_DIOJNI
+ * Method:    setDIOBatch
+ * Signature: ([I[Z)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_DIOJNI_setDIOBatch
+  (JNIEnv* env, jclass, jintArray handles, jbooleanArray values)
+{
+  SetBatch<wpi::java::JBooleanArrayRef>(
+      env, handles, values, [](jint handle, auto value, int32_t* status) {
+        HAL_SetDIO((HAL_DigitalHandle)handle, value, status);
+      });
+}
+
 }  // extern "C"
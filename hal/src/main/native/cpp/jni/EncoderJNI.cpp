@@ -382,4 +382,46 @@ Java_edu_wpi_first_hal_EncoderJNI_getEncoderEncodingType
   return returnValue;
 }
 
+/*
+ * Class:     edu_wpi_first_hal_EncoderJNI
+ * Method:    getEncoderBatch
+ * Signature: ([ILjava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_EncoderJNI_getEncoderBatch
+  (JNIEnv* env, jclass, jintArray handles, jobject buffer)
+{
+  GetBatch<int32_t>(env, handles, buffer, [](jint handle, int32_t* status) {
+    return HAL_GetEncoder((HAL_EncoderHandle)handle, status);
+  });
+}
+
+/*
+ * Class:     edu_wpi_first_hal_EncoderJNI
+ * Method:    getEncoderRawBatch
+ * Signature: ([ILjava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_EncoderJNI_getEncoderRawBatch
+  (JNIEnv* env, jclass, jintArray handles, jobject buffer)
+{
+  GetBatch<int32_t>(env, handles, buffer, [](jint handle, int32_t* status) {
+    return HAL_GetEncoderRaw((HAL_EncoderHandle)handle, status);
+  });
+}
+
+/*
+ * Class:     edu_wpi_first_hal_EncoderJNI
+ * Method:    getEncoderRateBatch
+ * Signature: ([ILjava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_EncoderJNI_getEncoderRateBatch
+  (JNIEnv* env, jclass, jintArray handles, jobject buffer)
+{
+  GetBatch<double>(env, handles, buffer, [](jint handle, int32_t* status) {
+    return HAL_GetEncoderRate((HAL_EncoderHandle)handle, status);
+  });
+}
+
 }  // extern "C"
@@ -8,8 +8,11 @@
 #include <jni.h>
 #include <stdint.h>
 
+#include <cstring>
 #include <string_view>
 
+#include <wpi/jni_util.h>
+
 struct HAL_MatchInfo;
 struct HAL_Value;
 
@@ -55,6 +58,64 @@ void ThrowIllegalArgumentException(JNIEnv* env, std::string_view msg);
 void ThrowBoundaryException(JNIEnv* env, double value, double lower,
                             double upper);
 
+/**
+ * Calls get(handle, &status) for each handle in the array and stores the
+ * results in the direct buffer in native byte order, so a whole robot loop's
+ * reads cost one JNI transition.  Every handle is read even if some fail; the
+ * first failing status is reported once at the end.
+ */
+template <typename T, typename F>
+void GetBatch(JNIEnv* env, jintArray handles, jobject buffer, F&& get) {
+  wpi::java::JIntArrayRef jhandles{env, handles};
+  auto out = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
+  if (!out) {
+    ThrowIllegalArgumentException(env, "buffer must be a direct ByteBuffer");
+    return;
+  }
+  size_t size = jhandles.array().size();
+  if (static_cast<size_t>(env->GetDirectBufferCapacity(buffer)) <
+      size * sizeof(T)) {
+    ThrowIllegalArgumentException(env, "buffer is too small for the handles");
+    return;
+  }
+  int32_t firstStatus = 0;
+  for (size_t i = 0; i < size; ++i) {
+    int32_t status = 0;
+    T value = get(jhandles.array()[i], &status);
+    std::memcpy(out + i * sizeof(T), &value, sizeof(T));
+    if (firstStatus == 0) {
+      firstStatus = status;
+    }
+  }
+  CheckStatus(env, firstStatus);
+}
+
+/**
+ * Calls set(handles[i], values[i], &status) for each handle in the array.
+ * Every handle is set even if some fail; the first failing status is reported
+ * once at the end.
+ */
+template <typename ArrayRef, typename JArray, typename F>
+void SetBatch(JNIEnv* env, jintArray handles, JArray values, F&& set) {
+  wpi::java::JIntArrayRef jhandles{env, handles};
+  ArrayRef jvalues{env, values};
+  size_t size = jhandles.array().size();
+  if (jvalues.array().size() != size) {
+    ThrowIllegalArgumentException(env,
+                                  "handles and values must be the same size");
+    return;
+  }
+  int32_t firstStatus = 0;
+  for (size_t i = 0; i < size; ++i) {
+    int32_t status = 0;
+    set(jhandles.array()[i], jvalues.array()[i], &status);
+    if (firstStatus == 0) {
+      firstStatus = status;
+    }
+  }
+  CheckStatus(env, firstStatus);
+}
+
 jobject CreatePWMConfigDataResult(JNIEnv* env, int32_t maxPwm,
                                   int32_t deadbandMaxPwm, int32_t centerPwm,
                                   int32_t deadbandMinPwm, int32_t minPwm);
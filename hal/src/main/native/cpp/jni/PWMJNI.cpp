@@ -273,4 +273,34 @@ Java_edu_wpi_first_hal_PWMJNI_setPWMPeriodScale
   CheckStatus(env, status);
 }
 
+/*
+ * Class:     edu_wpi_first_hal_PWMJNI
+ * Method:    setPWMSpeedBatch
+ * Signature: ([I[D)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_PWMJNI_setPWMSpeedBatch
+  (JNIEnv* env, jclass, jintArray handles, jdoubleArray values)
+{
+  SetBatch<wpi::java::JDoubleArrayRef>(
+      env, handles, values, [](jint handle, auto value, int32_t* status) {
+        HAL_SetPWMSpeed((HAL_DigitalHandle)handle, value, status);
+      });
+}
+
+/*
+ * Class:     edu_wpi_first_hal_PWMJNI
+ * Method:    setPWMPositionBatch
+ * Signature: ([I[D)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_PWMJNI_setPWMPositionBatch
+  (JNIEnv* env, jclass, jintArray handles, jdoubleArray values)
+{
+  SetBatch<wpi::java::JDoubleArrayRef>(
+      env, handles, values, [](jint handle, auto value, int32_t* status) {
+        HAL_SetPWMPosition((HAL_DigitalHandle)handle, value, status);
+      });
+}
+
 }  // extern "C"
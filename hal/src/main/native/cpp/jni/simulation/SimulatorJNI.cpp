@@ -253,6 +253,54 @@ Java_edu_wpi_first_hal_simulation_SimulatorJNI_stepTimingAsync
   HALSIM_StepTimingAsync(delta);
 }
 
+/*
+ * Class:     edu_wpi_first_hal_simulation_SimulatorJNI
+ * Method:    setTimingFastForward
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_simulation_SimulatorJNI_setTimingFastForward
+  (JNIEnv*, jclass, jboolean enable)
+{
+  HALSIM_SetTimingFastForward(enable);
+}
+
+/*
+ * Class:     edu_wpi_first_hal_simulation_SimulatorJNI
+ * Method:    isTimingFastForward
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_edu_wpi_first_hal_simulation_SimulatorJNI_isTimingFastForward
+  (JNIEnv*, jclass)
+{
+  return HALSIM_IsTimingFastForward();
+}
+
+/*
+ * Class:     edu_wpi_first_hal_simulation_SimulatorJNI
+ * Method:    setTimingLockStep
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_simulation_SimulatorJNI_setTimingLockStep
+  (JNIEnv*, jclass, jboolean enable)
+{
+  HALSIM_SetTimingLockStep(enable);
+}
+
+/*
+ * Class:     edu_wpi_first_hal_simulation_SimulatorJNI
+ * Method:    isTimingLockStep
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_edu_wpi_first_hal_simulation_SimulatorJNI_isTimingLockStep
+  (JNIEnv*, jclass)
+{
+  return HALSIM_IsTimingLockStep();
+}
+
 /*
  * Class:     edu_wpi_first_hal_simulation_SimulatorJNI
  * Method:    resetHandles
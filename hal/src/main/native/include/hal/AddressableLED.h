@@ -35,6 +35,22 @@ void HAL_WriteAddressableLEDData(HAL_AddressableLEDHandle handle,
                                  const struct HAL_AddressableLEDData* data,
                                  int32_t length, int32_t* status);
 
+/**
+ * Writes part of the LED data, leaving the other LEDs as they were last
+ * written, and starts the next data cycle. Writing only the LEDs that
+ * changed avoids copying the whole strip for small updates.
+ *
+ * @param handle the addressable LED handle
+ * @param data   the data for the LEDs being written
+ * @param start  the index of the first LED to write
+ * @param length the number of LEDs to write (may be 0 to only start the
+ *               next data cycle)
+ */
+void HAL_WriteAddressableLEDDataRange(HAL_AddressableLEDHandle handle,
+                                      const struct HAL_AddressableLEDData* data,
+                                      int32_t start, int32_t length,
+                                      int32_t* status);
+
 void HAL_SetAddressableLEDBitTiming(HAL_AddressableLEDHandle handle,
                                     int32_t lowTime0NanoSeconds,
                                     int32_t highTime0NanoSeconds,
@@ -15,6 +15,20 @@
  * @{
  */
 
+/**
+ * A packet to write with HAL_WriteCANPacketBatch().
+ */
+struct HAL_CANPacket {
+  /** The CAN handle of the device to write to */
+  HAL_CANHandle handle;
+  /** The API ID to write (0-1023 bits) */
+  int32_t apiId;
+  /** The data to write */
+  uint8_t data[8];
+  /** The length of data (0-8) */
+  int32_t length;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -53,6 +67,20 @@ void HAL_CleanCAN(HAL_CANHandle handle);
 void HAL_WriteCANPacket(HAL_CANHandle handle, const uint8_t* data,
                         int32_t length, int32_t apiId, int32_t* status);
 
+/**
+ * Writes packets to any number of CAN devices in one call.
+ *
+ * The packets are sent back to back, in order, with each handle looked up
+ * once per run of packets to the same device. Every packet is attempted even
+ * if an earlier one fails.
+ *
+ * @param packets the packets to write
+ * @param count   the number of packets
+ * @param status  set to the error of the first packet that failed, if any
+ */
+void HAL_WriteCANPacketBatch(const struct HAL_CANPacket* packets,
+                             int32_t count, int32_t* status);
+
 /**
  * Writes a repeating packet to the CAN device with a specific ID.
  *
@@ -119,6 +119,20 @@ HAL_PortHandle HAL_GetPortWithModule(int32_t module, int32_t channel);
  */
 uint64_t HAL_GetFPGATime(int32_t* status);
 
+/**
+ * Reads the FPGA time from a CPU clock that is periodically synced to the
+ * FPGA timer, which avoids reading the FPGA on every call.
+ *
+ * On the roboRIO, the result is within a few microseconds of
+ * HAL_GetFPGATime() (the sync error, typically 1-2 us, plus clock drift of at
+ * most ~10 us between resyncs every 100 ms). It never goes backwards. In
+ * simulation it is the same as HAL_GetFPGATime().
+ *
+ * @return The current time in microseconds according to the FPGA (since FPGA
+ * reset).
+ */
+uint64_t HAL_GetFPGATimeFast(int32_t* status);
+
 /**
  * Given an 32 bit FPGA time, expand it to the nearest likely 64 bit FPGA time.
  *
@@ -15,6 +15,18 @@
  * @{
  */
 
+/**
+ * An edge seen by an interrupt group.
+ */
+struct HAL_InterruptEvent {
+  /** The interrupt that saw the edge */
+  HAL_InterruptHandle interrupt;
+  /** True for a rising edge, false for a falling edge */
+  HAL_Bool rising;
+  /** The time of the edge in microseconds (relative to FPGA time) */
+  int64_t timestamp;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -108,6 +120,66 @@ void HAL_SetInterruptUpSourceEdge(HAL_InterruptHandle interruptHandle,
  */
 void HAL_ReleaseWaitingInterrupt(HAL_InterruptHandle interruptHandle,
                                  int32_t* status);
+
+/**
+ * Initializes an interrupt group, which waits on several interrupts from a
+ * single HAL thread and queues their edges as events.
+ *
+ * The interrupts must already be requested; their edges are set as usual
+ * with HAL_SetInterruptUpSourceEdge(). Don't wait on an interrupt in a group
+ * with HAL_WaitForInterrupt(), and don't put an interrupt in more than one
+ * group.
+ *
+ * @param interruptHandles the interrupts in the group
+ * @param numInterrupts    the number of interrupts
+ * @param queueDepth       the number of events to queue; edges seen while
+ *                         the queue is full are dropped
+ * @return the created interrupt group handle
+ */
+HAL_InterruptGroupHandle HAL_InitializeInterruptGroup(
+    const HAL_InterruptHandle* interruptHandles, int32_t numInterrupts,
+    int32_t queueDepth, int32_t* status);
+
+/**
+ * Frees an interrupt group. The interrupts in it are not freed.
+ *
+ * @param interruptGroupHandle the interrupt group handle
+ */
+void HAL_CleanInterruptGroup(HAL_InterruptGroupHandle interruptGroupHandle);
+
+/**
+ * Reads queued events from an interrupt group, oldest first, waiting for
+ * the first one if none are queued.
+ *
+ * @param interruptGroupHandle the interrupt group handle
+ * @param events               the buffer to read the events into
+ * @param maxEvents            the size of the buffer
+ * @param timeout              the maximum time to wait in seconds
+ * @return the number of events read; 0 on timeout or when released by
+ *         HAL_ReleaseWaitingInterruptGroup()
+ */
+int32_t HAL_ReadInterruptGroupEvents(
+    HAL_InterruptGroupHandle interruptGroupHandle,
+    struct HAL_InterruptEvent* events, int32_t maxEvents, double timeout,
+    int32_t* status);
+
+/**
+ * Releases a thread waiting in HAL_ReadInterruptGroupEvents().
+ *
+ * @param interruptGroupHandle the interrupt group handle
+ */
+void HAL_ReleaseWaitingInterruptGroup(
+    HAL_InterruptGroupHandle interruptGroupHandle, int32_t* status);
+
+/**
+ * Gets the number of edges dropped because the event queue of an interrupt
+ * group was full.
+ *
+ * @param interruptGroupHandle the interrupt group handle
+ * @return the number of dropped edges
+ */
+int64_t HAL_GetInterruptGroupDroppedCount(
+    HAL_InterruptGroupHandle interruptGroupHandle, int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -14,6 +14,44 @@
  * @{
  */
 
+/**
+ * A snapshot of the roboRIO power rails, the roboRIO status, and
+ * optionally a PDP, taken by the power status sampler.
+ */
+struct HAL_PowerStatus {
+  /** The FPGA time of the snapshot (microseconds) */
+  uint64_t timestamp;
+
+  double vinVoltage;
+  double vinCurrent;
+  double userVoltage6V;
+  double userCurrent6V;
+  HAL_Bool userActive6V;
+  int32_t userCurrentFaults6V;
+  double userVoltage5V;
+  double userCurrent5V;
+  HAL_Bool userActive5V;
+  int32_t userCurrentFaults5V;
+  double userVoltage3V3;
+  double userCurrent3V3;
+  HAL_Bool userActive3V3;
+  int32_t userCurrentFaults3V3;
+
+  HAL_Bool systemActive;
+  HAL_Bool brownedOut;
+
+  /** The sampled PDP, or HAL_kInvalidHandle if none */
+  HAL_PDPHandle pdpHandle;
+  /** False if the PDP could not be read; the PDP fields are then zero */
+  HAL_Bool pdpValid;
+  double pdpVoltage;
+  double pdpTemperature;
+  double pdpTotalCurrent;
+  double pdpTotalPower;
+  double pdpTotalEnergy;
+  double pdpChannelCurrents[16];
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -115,6 +153,37 @@ HAL_Bool HAL_GetUserActive3V3(int32_t* status);
  * @return the number of 3V3 fault counts
  */
 int32_t HAL_GetUserCurrentFaults3V3(int32_t* status);
+
+/**
+ * Starts the power status sampler, which reads the roboRIO power rails, the
+ * roboRIO status and (optionally) a PDP together once per period on a HAL
+ * thread.
+ *
+ * While it runs, the power, HAL_GetSystemActive(), HAL_GetBrownedOut() and
+ * (for the sampled PDP) PDP getters return the latest snapshot instead of
+ * reading the device on every call. In simulation, the getters always return
+ * the current sim values.
+ *
+ * @param pdpHandle the PDP to sample, or HAL_kInvalidHandle for none
+ * @param period    the sample period (seconds)
+ */
+void HAL_StartPowerStatusSampler(HAL_PDPHandle pdpHandle, double period,
+                                 int32_t* status);
+
+/**
+ * Stops the power status sampler. The getters go back to reading the device
+ * on every call.
+ */
+void HAL_StopPowerStatusSampler(void);
+
+/**
+ * Gets the latest snapshot from the power status sampler. If the sampler
+ * isn't running (or hasn't taken a snapshot yet), reads a new one without a
+ * PDP.
+ *
+ * @param powerStatus the snapshot
+ */
+void HAL_GetPowerStatus(struct HAL_PowerStatus* powerStatus, int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
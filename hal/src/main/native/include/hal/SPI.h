@@ -254,6 +254,85 @@ void HAL_ConfigureSPIAutoStall(HAL_SPIPort port, int32_t csToSclkTicks,
                                int32_t stallTicks, int32_t pow2BytesPerRead,
                                int32_t* status);
 
+/**
+ * Called on the auto SPI stream thread with each batch of received transfers.
+ *
+ * @param param        The param passed to HAL_StartSPIAutoStream.
+ * @param data         The received transfers, in the format returned by
+ *                     HAL_ReadSPIAutoReceivedData.
+ * @param numTransfers The number of transfers.
+ */
+typedef void (*HAL_SPIAutoStreamCallback)(void* param, const uint32_t* data,
+                                          int32_t numTransfers);
+
+/**
+ * Starts streaming the data received by the SPI accumulator.
+ *
+ * A real-time thread drains whole transfers into a ring buffer as they
+ * arrive, so readers don't need to poll the FPGA. When a callback is given, it
+ * is called on the stream thread with each batch of transfers, and the
+ * transfers are released when it returns; otherwise the transfers stay in the
+ * ring until released with HAL_ReleaseSPIAutoStream. While the ring is full,
+ * the FPGA buffer fills up and further transfers are dropped (see
+ * HAL_GetSPIAutoDroppedCount).
+ *
+ * Auto SPI must be initialized first, and the stream stopped before it is
+ * freed.
+ *
+ * @param port         The number of the port to use. 0-3 for Onboard CS0-CS2,
+ *                     4 for MXP.
+ * @param transferSize The combined dataSize + zeroSize set in
+ *                     HAL_SetSPIAutoTransmitData.
+ * @param depth        The number of transfers the ring holds.
+ * @param period       How often the thread checks for data when none is
+ *                     available (in seconds).
+ * @param callback     The callback, or null to read with
+ *                     HAL_AcquireSPIAutoStream.
+ * @param param        The parameter to pass to the callback.
+ */
+void HAL_StartSPIAutoStream(HAL_SPIPort port, int32_t transferSize,
+                            int32_t depth, double period,
+                            HAL_SPIAutoStreamCallback callback, void* param,
+                            int32_t* status);
+
+/**
+ * Stops streaming the data received by the SPI accumulator. Must not be called
+ * from the stream callback.
+ *
+ * @param port The number of the port to use. 0-3 for Onboard CS0-CS2, 4 for
+ * MXP.
+ */
+void HAL_StopSPIAutoStream(HAL_SPIPort port, int32_t* status);
+
+/**
+ * Gets the oldest transfers in the auto SPI stream without copying them.
+ *
+ * The returned transfers are contiguous, so fewer than are in the ring may be
+ * returned when they wrap around its end. They stay valid until they are
+ * released or the stream is stopped.
+ *
+ * @param port    The number of the port to use. 0-3 for Onboard CS0-CS2, 4 for
+ *                MXP.
+ * @param data    Set to the first transfer, in the format returned by
+ *                HAL_ReadSPIAutoReceivedData.
+ * @param timeout How long to wait for a transfer if none are in the ring (in
+ *                seconds).
+ * @return        The number of transfers.
+ */
+int32_t HAL_AcquireSPIAutoStream(HAL_SPIPort port, const uint32_t** data,
+                                 double timeout, int32_t* status);
+
+/**
+ * Releases the oldest transfers in the auto SPI stream, making room for new
+ * ones.
+ *
+ * @param port         The number of the port to use. 0-3 for Onboard CS0-CS2,
+ *                     4 for MXP.
+ * @param numTransfers The number of transfers to release.
+ */
+void HAL_ReleaseSPIAutoStream(HAL_SPIPort port, int32_t numTransfers,
+                              int32_t* status);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
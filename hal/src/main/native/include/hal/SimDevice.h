@@ -378,6 +378,19 @@ inline void HAL_SetSimValueBoolean(HAL_SimValueHandle handle, HAL_Bool value) {
  */
 void HAL_ResetSimValue(HAL_SimValueHandle handle);
 
+/**
+ * Sets several simulated values at once.  This is equivalent to setting each
+ * in turn, except that the values changed callbacks of each device (see
+ * HALSIM_RegisterSimDeviceValuesChangedCallback()) are called once, after all
+ * of its values have been set.
+ *
+ * @param handles simulated value handles
+ * @param values the values to set, one per handle
+ * @param count the number of handles and values
+ */
+void HAL_SetSimValues(const HAL_SimValueHandle* handles,
+                      const struct HAL_Value* values, int32_t count);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -40,6 +40,8 @@ typedef HAL_Handle HAL_GyroHandle;
 
 typedef HAL_Handle HAL_InterruptHandle;
 
+typedef HAL_Handle HAL_InterruptGroupHandle;
+
 typedef HAL_Handle HAL_NotifierHandle;
 
 typedef HAL_Handle HAL_RelayHandle;
@@ -13,6 +13,7 @@
 
 #include "hal/Errors.h"
 #include "hal/Types.h"
+#include "hal/handles/HandleSlot.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -22,7 +23,7 @@ namespace hal {
  * allows a limited number of handles that are allocated by index.
  * The enum value is separate, as 2 enum values are allowed per handle
  * Because they are allocated by index, each individual index holds its own
- * mutex, which reduces contention heavily.
+ * mutex, which reduces contention heavily. Looking up a handle is lock-free.
  *
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -44,11 +45,13 @@ class DigitalHandleResource : public HandleBase {
     return getHandleTypedIndex(handle, enumValue, m_version);
   }
   std::shared_ptr<TStruct> Get(THandle handle, HAL_HandleEnum enumValue);
+  /* Borrows the structure without copying its shared_ptr; see Borrowed */
+  Borrowed<TStruct> Borrow(THandle handle, HAL_HandleEnum enumValue);
   void Free(THandle handle, HAL_HandleEnum enumValue);
   void ResetHandles() override;
 
  private:
-  std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<HandleSlot<TStruct>, size> m_structures;
   std::array<wpi::mutex, size> m_handleMutexes;
 };
 
@@ -64,16 +67,16 @@ DigitalHandleResource<THandle, TStruct, size>::Allocate(
   }
   std::scoped_lock lock(m_handleMutexes[index]);
   // check for allocation, otherwise allocate and return a valid handle
-  if (m_structures[index] != nullptr) {
+  if (m_structures[index].IsAllocated()) {
     *handle = HAL_kInvalidHandle;
     *status = RESOURCE_IS_ALLOCATED;
-    return m_structures[index];
+    return m_structures[index].Owner();
   }
-  m_structures[index] = std::make_shared<TStruct>();
+  m_structures[index].Set(std::make_shared<TStruct>());
   *handle =
       static_cast<THandle>(hal::createHandle(index, enumValue, m_version));
   *status = HAL_SUCCESS;
-  return m_structures[index];
+  return m_structures[index].Owner();
 }
 
 template <typename THandle, typename TStruct, int16_t size>
@@ -84,10 +87,20 @@ std::shared_ptr<TStruct> DigitalHandleResource<THandle, TStruct, size>::Get(
   if (index < 0 || index >= size) {
     return nullptr;
   }
-  std::scoped_lock lock(m_handleMutexes[index]);
   // return structure. Null will propagate correctly, so no need to manually
   // check.
-  return m_structures[index];
+  return m_structures[index].Get();
+}
+
+template <typename THandle, typename TStruct, int16_t size>
+Borrowed<TStruct> DigitalHandleResource<THandle, TStruct, size>::Borrow(
+    THandle handle, HAL_HandleEnum enumValue) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = GetIndex(handle, enumValue);
+  if (index < 0 || index >= size) {
+    return {};
+  }
+  return m_structures[index].Borrow();
 }
 
 template <typename THandle, typename TStruct, int16_t size>
@@ -100,14 +113,14 @@ void DigitalHandleResource<THandle, TStruct, size>::Free(
   }
   // lock and deallocated handle
   std::scoped_lock lock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_structures[index].Reset();
 }
 
 template <typename THandle, typename TStruct, int16_t size>
 void DigitalHandleResource<THandle, TStruct, size>::ResetHandles() {
   for (int i = 0; i < size; i++) {
     std::scoped_lock lock(m_handleMutexes[i]);
-    m_structures[i].reset();
+    m_structures[i].Reset();
   }
   HandleBase::ResetHandles();
 }
@@ -0,0 +1,157 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace hal {
+
+template <typename TStruct>
+class HandleSlot;
+
+/**
+ * A reference to the structure of a handle, borrowed for the duration of a
+ * call without copying its shared_ptr.
+ *
+ * While any borrow of a handle is alive, freeing the handle waits for it to be
+ * released, so borrows must be short lived: don't hold one across a blocking
+ * call, and never free a handle while holding a borrow of it.
+ *
+ * @tparam TStruct The struct type held by the handle
+ */
+template <typename TStruct>
+class Borrowed {
+ public:
+  Borrowed() = default;
+  Borrowed(const Borrowed&) = delete;
+  Borrowed& operator=(const Borrowed&) = delete;
+  Borrowed(Borrowed&& rhs) noexcept
+      : m_ptr{std::exchange(rhs.m_ptr, nullptr)},
+        m_borrowers{std::exchange(rhs.m_borrowers, nullptr)} {}
+  Borrowed& operator=(Borrowed&& rhs) noexcept {
+    Release();
+    m_ptr = std::exchange(rhs.m_ptr, nullptr);
+    m_borrowers = std::exchange(rhs.m_borrowers, nullptr);
+    return *this;
+  }
+  ~Borrowed() { Release(); }
+
+  TStruct* get() const { return m_ptr; }
+  TStruct* operator->() const { return m_ptr; }
+  TStruct& operator*() const { return *m_ptr; }
+  explicit operator bool() const { return m_ptr != nullptr; }
+  bool operator==(std::nullptr_t) const { return m_ptr == nullptr; }
+  bool operator!=(std::nullptr_t) const { return m_ptr != nullptr; }
+
+ private:
+  friend class HandleSlot<TStruct>;
+
+  Borrowed(TStruct* ptr, std::atomic<int32_t>* borrowers)
+      : m_ptr{ptr}, m_borrowers{borrowers} {}
+
+  void Release() {
+    if (m_borrowers) {
+      m_borrowers->fetch_sub(1, std::memory_order_release);
+      m_borrowers = nullptr;
+    }
+    m_ptr = nullptr;
+  }
+
+  TStruct* m_ptr = nullptr;
+  std::atomic<int32_t>* m_borrowers = nullptr;
+};
+
+/**
+ * One slot of a handle resource. Lookups are lock-free: a reader counts itself
+ * as a borrower and then reads the published pointer, and clearing the slot
+ * unpublishes the pointer and then waits for the borrowers to leave before
+ * releasing the structure.
+ *
+ * Set() and Reset() must be serialized by the owning resource.
+ *
+ * @tparam TStruct The struct type held by the slot
+ */
+template <typename TStruct>
+class HandleSlot {
+ public:
+  /**
+   * Borrows the structure in the slot.
+   *
+   * @return The borrowed structure, or an empty borrow if the slot is free
+   */
+  Borrowed<TStruct> Borrow() {
+    // Counting the borrower before reading the pointer pairs with Reset()
+    // clearing the pointer before waiting on the count; both are seq_cst, so
+    // either the pointer read sees null or Reset() sees the borrower
+    m_borrowers.fetch_add(1);
+    TStruct* ptr = m_ptr.load();
+    if (!ptr) {
+      m_borrowers.fetch_sub(1, std::memory_order_release);
+      return {};
+    }
+    return {ptr, &m_borrowers};
+  }
+
+  /**
+   * Returns a shared reference to the structure in the slot, or nullptr if the
+   * slot is free.
+   */
+  std::shared_ptr<TStruct> Get() {
+    auto borrowed = Borrow();
+    if (!borrowed) {
+      return nullptr;
+    }
+    // The owner isn't released while there are borrowers
+    return m_owner;
+  }
+
+  /**
+   * Returns whether the slot holds a structure. Must be serialized with Set()
+   * and Reset().
+   */
+  bool IsAllocated() const { return m_owner != nullptr; }
+
+  /**
+   * Returns the structure in the slot. Must be serialized with Set() and
+   * Reset().
+   */
+  const std::shared_ptr<TStruct>& Owner() const { return m_owner; }
+
+  /**
+   * Puts a structure in a free slot.
+   *
+   * @param structure The structure
+   */
+  void Set(std::shared_ptr<TStruct> structure) {
+    m_owner = std::move(structure);
+    m_ptr.store(m_owner.get());
+  }
+
+  /**
+   * Clears the slot once every outstanding borrow has been released.
+   *
+   * @return The structure previously in the slot
+   */
+  std::shared_ptr<TStruct> Reset() {
+    m_ptr.store(nullptr);
+    while (m_borrowers.load(std::memory_order_acquire) != 0) {
+      std::this_thread::yield();
+    }
+    return std::move(m_owner);
+  }
+
+ private:
+  std::shared_ptr<TStruct> m_owner;
+  std::atomic<TStruct*> m_ptr{nullptr};
+  std::atomic<int32_t> m_borrowers{0};
+};
+
+}  // namespace hal
@@ -67,6 +67,7 @@ enum class HAL_HandleEnum {
   DMA = 22,
   AddressableLED = 23,
   CTREPCM = 24,
+  InterruptGroup = 25,
 };
 
 /**
@@ -13,6 +13,7 @@
 
 #include "hal/Errors.h"
 #include "hal/Types.h"
+#include "hal/handles/HandleSlot.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -21,7 +22,7 @@ namespace hal {
  * The IndexedHandleResource class is a way to track handles. This version
  * allows a limited number of handles that are allocated by index.
  * Because they are allocated by index, each individual index holds its own
- * mutex, which reduces contention heavily.]
+ * mutex, which reduces contention heavily. Looking up a handle is lock-free.
  *
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -45,11 +46,13 @@ class IndexedHandleResource : public HandleBase {
     return getHandleTypedIndex(handle, enumValue, m_version);
   }
   std::shared_ptr<TStruct> Get(THandle handle);
+  /* Borrows the structure without copying its shared_ptr; see Borrowed */
+  Borrowed<TStruct> Borrow(THandle handle);
   void Free(THandle handle);
   void ResetHandles() override;
 
  private:
-  std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<HandleSlot<TStruct>, size> m_structures;
   std::array<wpi::mutex, size> m_handleMutexes;
 };
 
@@ -66,16 +69,16 @@ IndexedHandleResource<THandle, TStruct, size, enumValue>::Allocate(
   }
   std::scoped_lock lock(m_handleMutexes[index]);
   // check for allocation, otherwise allocate and return a valid handle
-  if (m_structures[index] != nullptr) {
+  if (m_structures[index].IsAllocated()) {
     *status = RESOURCE_IS_ALLOCATED;
     *handle = HAL_kInvalidHandle;
-    return m_structures[index];
+    return m_structures[index].Owner();
   }
-  m_structures[index] = std::make_shared<TStruct>();
+  m_structures[index].Set(std::make_shared<TStruct>());
   *handle =
       static_cast<THandle>(hal::createHandle(index, enumValue, m_version));
   *status = HAL_SUCCESS;
-  return m_structures[index];
+  return m_structures[index].Owner();
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -87,10 +90,22 @@ IndexedHandleResource<THandle, TStruct, size, enumValue>::Get(THandle handle) {
   if (index < 0 || index >= size) {
     return nullptr;
   }
-  std::scoped_lock lock(m_handleMutexes[index]);
   // return structure. Null will propagate correctly, so no need to manually
   // check.
-  return m_structures[index];
+  return m_structures[index].Get();
+}
+
+template <typename THandle, typename TStruct, int16_t size,
+          HAL_HandleEnum enumValue>
+Borrowed<TStruct>
+IndexedHandleResource<THandle, TStruct, size, enumValue>::Borrow(
+    THandle handle) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = GetIndex(handle);
+  if (index < 0 || index >= size) {
+    return {};
+  }
+  return m_structures[index].Borrow();
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -104,7 +119,7 @@ void IndexedHandleResource<THandle, TStruct, size, enumValue>::Free(
   }
   // lock and deallocated handle
   std::scoped_lock lock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_structures[index].Reset();
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -112,7 +127,7 @@ template <typename THandle, typename TStruct, int16_t size,
 void IndexedHandleResource<THandle, TStruct, size, enumValue>::ResetHandles() {
   for (int i = 0; i < size; i++) {
     std::scoped_lock lock(m_handleMutexes[i]);
-    m_structures[i].reset();
+    m_structures[i].Reset();
   }
   HandleBase::ResetHandles();
 }
@@ -12,6 +12,7 @@
 #include <wpi/mutex.h>
 
 #include "hal/Types.h"
+#include "hal/handles/HandleSlot.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -20,6 +21,7 @@ namespace hal {
  * The LimitedClassedHandleResource class is a way to track handles. This
  * version
  * allows a limited number of handles that are allocated sequentially.
+ * Looking up a handle is lock-free; only allocating and freeing lock.
  *
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -43,12 +45,13 @@ class LimitedClassedHandleResource : public HandleBase {
     return getHandleTypedIndex(handle, enumValue, m_version);
   }
   std::shared_ptr<TStruct> Get(THandle handle);
+  /* Borrows the structure without copying its shared_ptr; see Borrowed */
+  Borrowed<TStruct> Borrow(THandle handle);
   void Free(THandle handle);
   void ResetHandles() override;
 
  private:
-  std::array<std::shared_ptr<TStruct>, size> m_structures;
-  std::array<wpi::mutex, size> m_handleMutexes;
+  std::array<HandleSlot<TStruct>, size> m_structures;
   wpi::mutex m_allocateMutex;
 };
 
@@ -60,11 +63,8 @@ LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::Allocate(
   // globally lock to loop through indices
   std::scoped_lock lock(m_allocateMutex);
   for (int16_t i = 0; i < size; i++) {
-    if (m_structures[i] == nullptr) {
-      // if a false index is found, grab its specific mutex
-      // and allocate it.
-      std::scoped_lock lock(m_handleMutexes[i]);
-      m_structures[i] = toSet;
+    if (!m_structures[i].IsAllocated()) {
+      m_structures[i].Set(toSet);
       return static_cast<THandle>(createHandle(i, enumValue, m_version));
     }
   }
@@ -81,10 +81,22 @@ LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::Get(
   if (index < 0 || index >= size) {
     return nullptr;
   }
-  std::scoped_lock lock(m_handleMutexes[index]);
   // return structure. Null will propagate correctly, so no need to manually
   // check.
-  return m_structures[index];
+  return m_structures[index].Get();
+}
+
+template <typename THandle, typename TStruct, int16_t size,
+          HAL_HandleEnum enumValue>
+Borrowed<TStruct>
+LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::Borrow(
+    THandle handle) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = GetIndex(handle);
+  if (index < 0 || index >= size) {
+    return {};
+  }
+  return m_structures[index].Borrow();
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -98,8 +110,7 @@ void LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::Free(
   }
   // lock and deallocated handle
   std::scoped_lock allocateLock(m_allocateMutex);
-  std::scoped_lock handleLock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_structures[index].Reset();
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -109,8 +120,7 @@ void LimitedClassedHandleResource<THandle, TStruct, size,
   {
     std::scoped_lock allocateLock(m_allocateMutex);
     for (int i = 0; i < size; i++) {
-      std::scoped_lock handleLock(m_handleMutexes[i]);
-      m_structures[i].reset();
+      m_structures[i].Reset();
     }
   }
   HandleBase::ResetHandles();
@@ -6,13 +6,15 @@
 
 #include <stdint.h>
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <utility>
-#include <vector>
 
 #include <wpi/mutex.h>
 
 #include "hal/Types.h"
+#include "hal/handles/HandleSlot.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -24,7 +26,9 @@ namespace hal {
  * down.
  * However, automatic array management has not been implemented, but might be in
  * the future.
- * Because we have to loop through the allocator, we must use a global mutex.
+ * Because we have to loop through the allocator, allocating and freeing use a
+ * global mutex. Looking up a handle is lock-free: the slots are stored in
+ * blocks that are never moved or freed while the resource exists.
 
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -39,12 +43,15 @@ class UnlimitedHandleResource : public HandleBase {
   UnlimitedHandleResource() = default;
   UnlimitedHandleResource(const UnlimitedHandleResource&) = delete;
   UnlimitedHandleResource& operator=(const UnlimitedHandleResource&) = delete;
+  ~UnlimitedHandleResource();
 
   THandle Allocate(std::shared_ptr<TStruct> structure);
   int16_t GetIndex(THandle handle) {
     return getHandleTypedIndex(handle, enumValue, m_version);
   }
   std::shared_ptr<TStruct> Get(THandle handle);
+  /* Borrows the structure without copying its shared_ptr; see Borrowed */
+  Borrowed<TStruct> Borrow(THandle handle);
   /* Returns structure previously at that handle (or nullptr if none) */
   std::shared_ptr<TStruct> Free(THandle handle);
   void ResetHandles() override;
@@ -56,18 +63,45 @@ class UnlimitedHandleResource : public HandleBase {
   void ForEach(Functor func);
 
  private:
-  std::vector<std::shared_ptr<TStruct>> m_structures;
+  static constexpr int kBlockSize = 256;
+  static constexpr int kNumBlocks = (INT16_MAX + kBlockSize) / kBlockSize;
+  using Block = std::array<HandleSlot<TStruct>, kBlockSize>;
+
+  // Returns the slot at an index, or nullptr if its block isn't allocated
+  HandleSlot<TStruct>* GetSlot(int16_t index) {
+    if (index < 0) {
+      return nullptr;
+    }
+    Block* block = m_blocks[index / kBlockSize].load(std::memory_order_acquire);
+    if (!block) {
+      return nullptr;
+    }
+    return &(*block)[index % kBlockSize];
+  }
+
+  std::array<std::atomic<Block*>, kNumBlocks> m_blocks{};
+  // Number of indices that have been used; protected by m_handleMutex
+  int m_size = 0;
   wpi::mutex m_handleMutex;
 };
 
+template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
+UnlimitedHandleResource<THandle, TStruct, enumValue>::
+    ~UnlimitedHandleResource() {
+  for (auto& block : m_blocks) {
+    delete block.load(std::memory_order_relaxed);
+  }
+}
+
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 THandle UnlimitedHandleResource<THandle, TStruct, enumValue>::Allocate(
     std::shared_ptr<TStruct> structure) {
   std::scoped_lock lock(m_handleMutex);
-  size_t i;
-  for (i = 0; i < m_structures.size(); i++) {
-    if (m_structures[i] == nullptr) {
-      m_structures[i] = structure;
+  int i;
+  for (i = 0; i < m_size; i++) {
+    auto slot = GetSlot(i);
+    if (!slot->IsAllocated()) {
+      slot->Set(structure);
       return static_cast<THandle>(createHandle(i, enumValue, m_version));
     }
   }
@@ -75,7 +109,12 @@ THandle UnlimitedHandleResource<THandle, TStruct, enumValue>::Allocate(
     return HAL_kInvalidHandle;
   }
 
-  m_structures.push_back(structure);
+  auto& block = m_blocks[i / kBlockSize];
+  if (!block.load(std::memory_order_relaxed)) {
+    block.store(new Block, std::memory_order_release);
+  }
+  ++m_size;
+  GetSlot(i)->Set(structure);
   return static_cast<THandle>(
       createHandle(static_cast<int16_t>(i), enumValue, m_version));
 }
@@ -83,31 +122,40 @@ THandle UnlimitedHandleResource<THandle, TStruct, enumValue>::Allocate(
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 std::shared_ptr<TStruct>
 UnlimitedHandleResource<THandle, TStruct, enumValue>::Get(THandle handle) {
-  int16_t index = GetIndex(handle);
-  std::scoped_lock lock(m_handleMutex);
-  if (index < 0 || index >= static_cast<int16_t>(m_structures.size())) {
+  auto slot = GetSlot(GetIndex(handle));
+  if (!slot) {
     return nullptr;
   }
-  return m_structures[index];
+  return slot->Get();
+}
+
+template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
+Borrowed<TStruct>
+UnlimitedHandleResource<THandle, TStruct, enumValue>::Borrow(THandle handle) {
+  auto slot = GetSlot(GetIndex(handle));
+  if (!slot) {
+    return {};
+  }
+  return slot->Borrow();
 }
 
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 std::shared_ptr<TStruct>
 UnlimitedHandleResource<THandle, TStruct, enumValue>::Free(THandle handle) {
-  int16_t index = GetIndex(handle);
   std::scoped_lock lock(m_handleMutex);
-  if (index < 0 || index >= static_cast<int16_t>(m_structures.size())) {
+  auto slot = GetSlot(GetIndex(handle));
+  if (!slot) {
     return nullptr;
   }
-  return std::move(m_structures[index]);
+  return slot->Reset();
 }
 
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 void UnlimitedHandleResource<THandle, TStruct, enumValue>::ResetHandles() {
   {
     std::scoped_lock lock(m_handleMutex);
-    for (size_t i = 0; i < m_structures.size(); i++) {
-      m_structures[i].reset();
+    for (int i = 0; i < m_size; i++) {
+      GetSlot(i)->Reset();
     }
   }
   HandleBase::ResetHandles();
@@ -118,11 +166,11 @@ template <typename Functor>
 void UnlimitedHandleResource<THandle, TStruct, enumValue>::ForEach(
     Functor func) {
   std::scoped_lock lock(m_handleMutex);
-  size_t i;
-  for (i = 0; i < m_structures.size(); i++) {
-    if (m_structures[i] != nullptr) {
+  for (int i = 0; i < m_size; i++) {
+    auto& owner = GetSlot(i)->Owner();
+    if (owner != nullptr) {
       func(static_cast<THandle>(createHandle(i, enumValue, m_version)),
-           m_structures[i].get());
+           owner.get());
     }
   }
 }
@@ -27,6 +27,20 @@ typedef void (*HAL_JoystickOutputsCallback)(const char* name, void* param,
 typedef void (*HAL_MatchInfoCallback)(const char* name, void* param,
                                       const HAL_MatchInfo* info);
 
+/**
+ * The driver station state that changes with every driver station packet,
+ * for setting all of it at once with HALSIM_SetDriverStationState().
+ */
+struct HALSIM_DriverStationState {
+  HAL_ControlWord controlWord;
+  HAL_AllianceStationID allianceStationId;
+  double matchTime;
+  HAL_JoystickAxes joystickAxes[HAL_kMaxJoysticks];
+  HAL_JoystickPOVs joystickPOVs[HAL_kMaxJoysticks];
+  HAL_JoystickButtons joystickButtons[HAL_kMaxJoysticks];
+};
+typedef struct HALSIM_DriverStationState HALSIM_DriverStationState;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -164,6 +178,17 @@ int32_t HALSIM_RegisterDriverStationNewDataCallback(HAL_NotifyCallback callback,
 void HALSIM_CancelDriverStationNewDataCallback(int32_t uid);
 void HALSIM_NotifyDriverStationNewData(void);
 
+/**
+ * Sets the control word, alliance station, match time and the data of every
+ * joystick, then notifies of new data once.
+ *
+ * The joysticks are updated under a single lock acquisition, and callbacks
+ * are only called for values that changed.
+ *
+ * @param state the new driver station state
+ */
+void HALSIM_SetDriverStationState(const HALSIM_DriverStationState* state);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -19,6 +19,29 @@ HAL_Bool HALSIM_IsTimingPaused(void);
 void HALSIM_StepTiming(uint64_t delta);
 void HALSIM_StepTimingAsync(uint64_t delta);
 
+/**
+ * Runs timing as fast as possible: timing is paused, and whenever every
+ * notifier is waiting for its alarm, it is stepped directly to the next alarm.
+ * Timing stays paused when this is disabled.
+ *
+ * @param enable true to enable, false to disable
+ */
+void HALSIM_SetTimingFastForward(HAL_Bool enable);
+HAL_Bool HALSIM_IsTimingFastForward(void);
+
+/**
+ * Runs timing in lock step: timing is fast forwarded, and the notifiers due at
+ * each alarm time are woken one at a time in creation order, each running
+ * until it waits for its next alarm before the next is woken. Sim time then
+ * only advances when all notifiers are blocked, so a program whose threads
+ * are all driven by notifiers runs the same way every time. Disabling lock
+ * step also disables fast forwarding.
+ *
+ * @param enable true to enable, false to disable
+ */
+void HALSIM_SetTimingLockStep(HAL_Bool enable);
+HAL_Bool HALSIM_IsTimingLockStep(void);
+
 typedef int32_t (*HALSIM_SendErrorHandler)(
     HAL_Bool isError, int32_t errorCode, HAL_Bool isLVCode, const char* details,
     const char* location, const char* callStack, HAL_Bool printMsg);
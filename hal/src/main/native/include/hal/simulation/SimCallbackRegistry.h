@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include <wpi/Compiler.h>
 #include <wpi/UidVector.h>
+#include <wpi/lock_stats.h>
 #include <wpi/spinlock.h>
 
 #include "hal/simulation/NotifyListener.h"
@@ -17,6 +20,19 @@ namespace hal {
 
 namespace impl {
 
+/**
+ * Copy-on-write callback list. Registering or cancelling a callback replaces
+ * the list under a lock, while invoking callbacks reads the current list with
+ * atomics and calls them without holding any lock, so callbacks may register
+ * and cancel callbacks themselves.
+ *
+ * Cancel waits for invocations that may still see the cancelled callback, so
+ * once it returns the callback's param can be freed.  Invocations are counted
+ * per epoch; Cancel flips the epoch twice and waits for each count to drain,
+ * so a steady stream of new invocations can't hold it up.  The wait is
+ * skipped when Cancel is called from inside a callback, which would otherwise
+ * wait on itself.
+ */
 class SimCallbackRegistryBase {
  public:
   using RawFunctor = void (*)();
@@ -25,10 +41,22 @@ class SimCallbackRegistryBase {
   using CallbackVector = wpi::UidVector<HalCallbackListener<RawFunctor>, 4>;
 
  public:
+  SimCallbackRegistryBase() { wpi::SetLockName(m_mutex, "HAL sim callbacks"); }
+
   void Cancel(int32_t uid) {
-    std::scoped_lock lock(m_mutex);
-    if (m_callbacks && uid > 0) {
-      m_callbacks->erase(uid - 1);
+    {
+      std::scoped_lock lock(m_mutex);
+      auto callbacks = std::atomic_load(&m_callbacks);
+      if (!callbacks || uid <= 0) {
+        return;
+      }
+      auto newCallbacks = std::make_shared<CallbackVector>(*callbacks);
+      newCallbacks->erase(uid - 1);
+      StoreCallbacks(std::move(newCallbacks));
+    }
+    // Not under m_mutex, as running callbacks may take it
+    if (InvokeDepth() == 0) {
+      WaitForInvokes();
     }
   }
 
@@ -45,20 +73,70 @@ class SimCallbackRegistryBase {
     if (callback == nullptr) {
       return -1;
     }
-    if (!m_callbacks) {
-      m_callbacks = std::make_unique<CallbackVector>();
-    }
-    return m_callbacks->emplace_back(param, callback) + 1;
+    auto callbacks = std::atomic_load(&m_callbacks);
+    auto newCallbacks = callbacks ? std::make_shared<CallbackVector>(*callbacks)
+                                  : std::make_shared<CallbackVector>();
+    int32_t uid = newCallbacks->emplace_back(param, callback) + 1;
+    StoreCallbacks(std::move(newCallbacks));
+    return uid;
   }
 
-  LLVM_ATTRIBUTE_ALWAYS_INLINE void DoReset() {
-    if (m_callbacks) {
-      m_callbacks->clear();
+  LLVM_ATTRIBUTE_ALWAYS_INLINE void DoReset() { StoreCallbacks(nullptr); }
+
+  /**
+   * Calls func with each registered callback.  Only touches the list, which is
+   * never modified once published, when there are callbacks.  The call is
+   * counted so Cancel can wait for it.
+   */
+  template <typename F>
+  LLVM_ATTRIBUTE_ALWAYS_INLINE void ForEachCallback(F&& func) const {
+    if (!m_hasCallbacks.load(std::memory_order_acquire)) {
+      return;
     }
+    auto& count = m_invokes[m_epoch.load() & 1];
+    ++count;
+    ++InvokeDepth();
+    if (auto callbacks = std::atomic_load(&m_callbacks)) {
+      for (auto&& cb : *callbacks) {
+        func(cb);
+      }
+    }
+    --InvokeDepth();
+    --count;
   }
 
   mutable wpi::recursive_spinlock m_mutex;
-  std::unique_ptr<CallbackVector> m_callbacks;
+
+ private:
+  // Number of invocations in progress on this thread, across all registries
+  static int& InvokeDepth() {
+    thread_local int depth = 0;
+    return depth;
+  }
+
+  // Must be called after the new list is stored; an invocation that read
+  // the old list was counted in one of the two epochs before it did so
+  void WaitForInvokes() {
+    for (int i = 0; i < 2; ++i) {
+      auto& count = m_invokes[m_epoch.fetch_xor(1) & 1];
+      while (count.load() != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // Must be called with m_mutex held
+  void StoreCallbacks(std::shared_ptr<const CallbackVector> callbacks) {
+    bool hasCallbacks = callbacks && !callbacks->empty();
+    // An empty list is kept so UIDs of cancelled callbacks aren't reused early
+    std::atomic_store(&m_callbacks, std::move(callbacks));
+    m_hasCallbacks.store(hasCallbacks, std::memory_order_release);
+  }
+
+  std::shared_ptr<const CallbackVector> m_callbacks;
+  std::atomic<bool> m_hasCallbacks{false};
+  mutable std::atomic<int> m_invokes[2] = {};
+  std::atomic<unsigned int> m_epoch{0};
 };
 
 }  // namespace impl
@@ -79,18 +157,11 @@ class SimCallbackRegistry : public impl::SimCallbackRegistryBase {
 
   template <typename... U>
   void Invoke(U&&... u) const {
-#ifdef _MSC_VER  // work around VS2019 16.4.0 bug
-    std::scoped_lock<wpi::recursive_spinlock> lock(m_mutex);
-#else
-    std::scoped_lock lock(m_mutex);
-#endif
-    if (m_callbacks) {
-      const char* name = GetName();
-      for (auto&& cb : *m_callbacks) {
-        reinterpret_cast<CallbackFunction>(cb.callback)(name, cb.param,
-                                                        std::forward<U>(u)...);
-      }
-    }
+    const char* name = GetName();
+    ForEachCallback([&](const auto& cb) {
+      reinterpret_cast<CallbackFunction>(cb.callback)(name, cb.param,
+                                                      std::forward<U>(u)...);
+    });
   }
 
   template <typename... U>
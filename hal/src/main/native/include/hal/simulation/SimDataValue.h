@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <type_traits>
 
 #include <wpi/Compiler.h>
 #include <wpi/UidVector.h>
@@ -18,22 +20,22 @@ namespace hal {
 namespace impl {
 template <typename T, HAL_Value (*MakeValue)(T)>
 class SimDataValueBase : protected SimCallbackRegistryBase {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SimDataValue types must be trivially copyable");
+
  public:
   explicit SimDataValueBase(T value) : m_value(value) {}
 
   LLVM_ATTRIBUTE_ALWAYS_INLINE void CancelCallback(int32_t uid) { Cancel(uid); }
 
-  T Get() const {
-    std::scoped_lock lock(m_mutex);
-    return m_value;
-  }
+  T Get() const { return m_value.load(std::memory_order_acquire); }
 
   LLVM_ATTRIBUTE_ALWAYS_INLINE operator T() const { return Get(); }  // NOLINT
 
   void Reset(T value) {
     std::scoped_lock lock(m_mutex);
     DoReset();
-    m_value = value;
+    m_value.store(value, std::memory_order_release);
   }
 
   wpi::recursive_spinlock& GetMutex() { return m_mutex; }
@@ -48,7 +50,7 @@ class SimDataValueBase : protected SimCallbackRegistryBase {
     }
     if (initialNotify) {
       // We know that the callback is not null because of earlier null check
-      HAL_Value value = MakeValue(m_value);
+      HAL_Value value = MakeValue(Get());
       lock.unlock();
       callback(name, param, &value);
     }
@@ -56,20 +58,18 @@ class SimDataValueBase : protected SimCallbackRegistryBase {
   }
 
   void DoSet(T value, const char* name) {
-    std::scoped_lock lock(this->m_mutex);
-    if (m_value != value) {
-      m_value = value;
-      if (m_callbacks) {
-        HAL_Value halValue = MakeValue(value);
-        for (auto&& cb : *m_callbacks) {
-          reinterpret_cast<HAL_NotifyCallback>(cb.callback)(name, cb.param,
-                                                            &halValue);
-        }
-      }
+    // Callbacks run outside any lock, so the callbacks of concurrent sets may
+    // run in either order, but each change notifies exactly once
+    if (m_value.exchange(value, std::memory_order_acq_rel) != value) {
+      HAL_Value halValue = MakeValue(value);
+      ForEachCallback([&](const auto& cb) {
+        reinterpret_cast<HAL_NotifyCallback>(cb.callback)(name, cb.param,
+                                                          &halValue);
+      });
     }
   }
 
-  T m_value;
+  std::atomic<T> m_value;
 };
 }  // namespace impl
 
@@ -50,6 +50,22 @@ int32_t HALSIM_RegisterSimValueCreatedCallback(HAL_SimDeviceHandle device,
 
 void HALSIM_CancelSimValueCreatedCallback(int32_t uid);
 
+/**
+ * Register a callback for changes to any of a device's values.  It is called
+ * after the value changed callbacks, once per HAL_SetSimValues() call for
+ * each device with values in it, and once per HAL_SetSimValue() or
+ * HAL_ResetSimValue() call.
+ *
+ * @param device simulated device handle
+ * @param callback callback
+ * @param initialNotify if true, the callback is called immediately
+ */
+int32_t HALSIM_RegisterSimDeviceValuesChangedCallback(
+    HAL_SimDeviceHandle device, void* param, HALSIM_SimDeviceCallback callback,
+    HAL_Bool initialNotify);
+
+void HALSIM_CancelSimDeviceValuesChangedCallback(int32_t uid);
+
 int32_t HALSIM_RegisterSimValueChangedCallback(HAL_SimValueHandle handle,
                                                void* param,
                                                HALSIM_SimValueCallback callback,
@@ -0,0 +1,45 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include "hal/Types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Saves a snapshot of all of the HAL sim data (including the values of every
+ * sim device) into a single binary blob.
+ *
+ * The snapshot is in native byte order and is only meant to be restored by
+ * the same build of the HAL. Values are read one at a time, so pause timing
+ * to get a consistent snapshot of a running program.
+ *
+ * @param buffer the buffer to write the snapshot to (may be null if size is 0)
+ * @param size the size of the buffer in bytes
+ * @return the size of the snapshot in bytes; if this is greater than size,
+ *         the buffer is too small and its contents are unspecified
+ */
+int32_t HALSIM_SaveSimState(void* buffer, int32_t size);
+
+/**
+ * Restores the HAL sim data from a snapshot saved by HALSIM_SaveSimState().
+ * Changed values notify their callbacks as if they were set individually.
+ *
+ * Sim device values are matched by device and value name; values in the
+ * snapshot that no longer exist are ignored, and values not in the snapshot
+ * are left unchanged.
+ *
+ * @param buffer the snapshot
+ * @param size the size of the snapshot in bytes
+ * @return true if restored, false if the snapshot is invalid (in which case
+ *         nothing is changed)
+ */
+HAL_Bool HALSIM_RestoreSimState(const void* buffer, int32_t size);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
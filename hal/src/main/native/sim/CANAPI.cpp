@@ -5,6 +5,7 @@
 #include "hal/CANAPI.h"
 
 #include <wpi/DenseMap.h>
+#include <wpi/SmallVector.h>
 
 #include "CANAPIInternal.h"
 #include "HALInitializer.h"
@@ -52,7 +53,7 @@ void InitializeCANAPI() {
 }  // namespace init
 namespace can {
 int32_t GetCANModuleFromHandle(HAL_CANHandle handle, int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return -1;
@@ -106,7 +107,7 @@ void HAL_CleanCAN(HAL_CANHandle handle) {
 
 void HAL_WriteCANPacket(HAL_CANHandle handle, const uint8_t* data,
                         int32_t length, int32_t apiId, int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -122,10 +123,54 @@ void HAL_WriteCANPacket(HAL_CANHandle handle, const uint8_t* data,
   can->periodicSends[apiId] = -1;
 }
 
+void HAL_WriteCANPacketBatch(const struct HAL_CANPacket* packets,
+                             int32_t count, int32_t* status) {
+  // The device each packet was sent to, or null if it failed
+  wpi::SmallVector<std::shared_ptr<CANStorage>, 16> sent;
+  sent.reserve(count);
+
+  // Send every packet before any bookkeeping so the frames go out together
+  std::shared_ptr<CANStorage> can;
+  for (int32_t i = 0; i < count; ++i) {
+    const auto& packet = packets[i];
+    if (i == 0 || packet.handle != packets[i - 1].handle) {
+      can = canHandles->Get(packet.handle);
+    }
+    if (!can) {
+      if (*status == 0) {
+        *status = HAL_HANDLE_ERROR;
+      }
+      sent.emplace_back();
+      continue;
+    }
+    auto id = CreateCANId(can.get(), packet.apiId);
+
+    int32_t sendStatus = 0;
+    HAL_CAN_SendMessage(id, packet.data, packet.length,
+                        HAL_CAN_SEND_PERIOD_NO_REPEAT, &sendStatus);
+
+    if (sendStatus != 0) {
+      if (*status == 0) {
+        *status = sendStatus;
+      }
+      sent.emplace_back();
+      continue;
+    }
+    sent.emplace_back(can);
+  }
+
+  for (int32_t i = 0; i < count; ++i) {
+    if (sent[i]) {
+      std::scoped_lock lock(sent[i]->mapMutex);
+      sent[i]->periodicSends[packets[i].apiId] = -1;
+    }
+  }
+}
+
 void HAL_WriteCANPacketRepeating(HAL_CANHandle handle, const uint8_t* data,
                                  int32_t length, int32_t apiId,
                                  int32_t repeatMs, int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -143,7 +188,7 @@ void HAL_WriteCANPacketRepeating(HAL_CANHandle handle, const uint8_t* data,
 
 void HAL_WriteCANRTRFrame(HAL_CANHandle handle, int32_t length, int32_t apiId,
                           int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -164,7 +209,7 @@ void HAL_WriteCANRTRFrame(HAL_CANHandle handle, int32_t length, int32_t apiId,
 
 void HAL_StopCANPacketRepeating(HAL_CANHandle handle, int32_t apiId,
                                 int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -184,7 +229,7 @@ void HAL_StopCANPacketRepeating(HAL_CANHandle handle, int32_t apiId,
 void HAL_ReadCANPacketNew(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
                           int32_t* length, uint64_t* receivedTimestamp,
                           int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -210,7 +255,7 @@ void HAL_ReadCANPacketNew(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
 void HAL_ReadCANPacketLatest(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
                              int32_t* length, uint64_t* receivedTimestamp,
                              int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -247,7 +292,7 @@ void HAL_ReadCANPacketTimeout(HAL_CANHandle handle, int32_t apiId,
                               uint8_t* data, int32_t* length,
                               uint64_t* receivedTimestamp, int32_t timeoutMs,
                               int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -291,7 +336,7 @@ void HAL_ReadCANPeriodicPacket(HAL_CANHandle handle, int32_t apiId,
                                uint8_t* data, int32_t* length,
                                uint64_t* receivedTimestamp, int32_t timeoutMs,
                                int32_t periodMs, int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->Borrow(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -4,43 +4,400 @@
 
 #include "hal/DMA.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <wpi/SmallVector.h>
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "DMAInternal.h"
+#include "ErrorsInternal.h"
+#include "HALInitializer.h"
+#include "MockHooksInternal.h"
+#include "hal/AnalogAccumulator.h"
+#include "hal/AnalogInput.h"
+#include "hal/Counter.h"
+#include "hal/DIO.h"
+#include "hal/DutyCycle.h"
+#include "hal/Encoder.h"
+#include "hal/Errors.h"
+#include "hal/handles/HandlesInternal.h"
+#include "hal/handles/LimitedHandleResource.h"
+
+using namespace hal;
+
+// The FPGA clock the timed trigger counts in
+static constexpr uint32_t kSystemClockTicksPerMicrosecond = 40;
+
+// Each sensor in a sample takes its kind, its handle and a 64-bit value
+static constexpr int32_t kWordsPerSensor = 4;
+static constexpr int32_t kMaxSensors =
+    sizeof(HAL_DMASample::readBuffer) / sizeof(uint32_t) / kWordsPerSensor;
+
+namespace {
+enum class SensorKind : uint32_t {
+  kEncoder = 1,
+  kEncoderPeriod,
+  kCounter,
+  kCounterPeriod,
+  kDigitalSource,
+  kAnalogInput,
+  kAveragedAnalogInput,
+  kAccumulatorCount,
+  kAccumulatorValue,
+  kDutyCycle,
+};
+
+struct Sensor {
+  SensorKind kind;
+  HAL_Handle handle;
+};
+
+struct DMA {
+  wpi::mutex mutex;
+  wpi::condition_variable cond;
+  std::vector<Sensor> sensors;
+  // Timed trigger period in microseconds
+  uint64_t period = 1;
+  bool started = false;
+  bool paused = false;
+  uint64_t nextTrigger = 0;
+  // Ring buffer of samples; the oldest is dropped when it is full
+  std::vector<HAL_DMASample> queue;
+  size_t head = 0;
+  size_t count = 0;
+};
+}  // namespace
+
+static LimitedHandleResource<HAL_DMAHandle, DMA, 1, HAL_HandleEnum::DMA>*
+    dmaHandles;
+
+static wpi::mutex startedMutex;
+static wpi::SmallVector<std::shared_ptr<DMA>, 1> startedDMAs;
+
+namespace hal::init {
+void InitializeDMA() {
+  static LimitedHandleResource<HAL_DMAHandle, DMA, 1, HAL_HandleEnum::DMA> dH;
+  dmaHandles = &dH;
+}
+}  // namespace hal::init
+
+static int32_t ClampPeriod(double seconds) {
+  double micros = seconds * 1.0e6;
+  if (micros >= std::numeric_limits<int32_t>::max()) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  return static_cast<int32_t>(micros);
+}
+
+static int64_t ReadSensor(const Sensor& sensor) {
+  int32_t status = 0;
+  switch (sensor.kind) {
+    case SensorKind::kEncoder:
+      return HAL_GetEncoderRaw(sensor.handle, &status);
+    case SensorKind::kEncoderPeriod:
+      return ClampPeriod(HAL_GetEncoderPeriod(sensor.handle, &status));
+    case SensorKind::kCounter:
+      return HAL_GetCounter(sensor.handle, &status);
+    case SensorKind::kCounterPeriod:
+      return ClampPeriod(HAL_GetCounterPeriod(sensor.handle, &status));
+    case SensorKind::kDigitalSource:
+      return HAL_GetDIO(sensor.handle, &status);
+    case SensorKind::kAnalogInput:
+      return HAL_GetAnalogValue(sensor.handle, &status);
+    case SensorKind::kAveragedAnalogInput:
+      return HAL_GetAnalogAverageValue(sensor.handle, &status);
+    case SensorKind::kAccumulatorCount: {
+      int64_t value = 0;
+      int64_t count = 0;
+      HAL_GetAccumulatorOutput(sensor.handle, &value, &count, &status);
+      return count;
+    }
+    case SensorKind::kAccumulatorValue: {
+      int64_t value = 0;
+      int64_t count = 0;
+      HAL_GetAccumulatorOutput(sensor.handle, &value, &count, &status);
+      return value;
+    }
+    case SensorKind::kDutyCycle:
+      return HAL_GetDutyCycleOutputRaw(sensor.handle, &status);
+  }
+  return 0;
+}
+
+static void CaptureSensors(const DMA& dma, HAL_DMASample* sample) {
+  uint32_t* words = sample->readBuffer;
+  for (auto&& sensor : dma.sensors) {
+    uint64_t value = static_cast<uint64_t>(ReadSensor(sensor));
+    words[0] = static_cast<uint32_t>(sensor.kind);
+    words[1] = static_cast<uint32_t>(sensor.handle);
+    words[2] = static_cast<uint32_t>(value);
+    words[3] = static_cast<uint32_t>(value >> 32);
+    words += kWordsPerSensor;
+  }
+}
+
+// Takes the samples for every trigger up to currentTime. The sensors only
+// change between timing steps, so every trigger since the last call sees the
+// same values, and they are read once.
+static void SampleLocked(DMA& dma, uint64_t currentTime) {
+  if (!dma.started || dma.nextTrigger > currentTime) {
+    return;
+  }
+  uint64_t triggers = (currentTime - dma.nextTrigger) / dma.period + 1;
+  uint64_t triggerTime = dma.nextTrigger;
+  dma.nextTrigger += triggers * dma.period;
+  if (dma.paused) {
+    return;
+  }
+
+  // Samples that would be dropped before they could be read aren't taken
+  size_t capacity = dma.queue.size();
+  if (triggers > capacity) {
+    triggerTime += (triggers - capacity) * dma.period;
+    triggers = capacity;
+  }
+
+  HAL_DMASample sample;
+  std::memset(&sample, 0, sizeof(sample));
+  std::fill(std::begin(sample.channelOffsets), std::end(sample.channelOffsets),
+            -1);
+  sample.captureSize = dma.sensors.size() * kWordsPerSensor;
+  CaptureSensors(dma, &sample);
+
+  for (uint64_t i = 0; i < triggers; ++i) {
+    sample.timeStamp = triggerTime;
+    triggerTime += dma.period;
+    dma.queue[(dma.head + dma.count) % capacity] = sample;
+    if (dma.count < capacity) {
+      ++dma.count;
+    } else {
+      dma.head = (dma.head + 1) % capacity;
+    }
+  }
+  dma.cond.notify_all();
+}
+
+static void RemoveStarted(DMA* dma) {
+  std::scoped_lock lock(startedMutex);
+  startedDMAs.erase(
+      std::remove_if(startedDMAs.begin(), startedDMAs.end(),
+                     [&](const auto& started) { return started.get() == dma; }),
+      startedDMAs.end());
+}
+
+static void AddSensor(HAL_DMAHandle handle, SensorKind kind,
+                      HAL_Handle sensorHandle, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  std::scoped_lock lock(dma->mutex);
+  if (dma->started) {
+    *status = HAL_INVALID_DMA_ADDITION;
+    return;
+  }
+
+  for (auto&& sensor : dma->sensors) {
+    if (sensor.kind == kind && sensor.handle == sensorHandle) {
+      return;
+    }
+  }
+  if (static_cast<int32_t>(dma->sensors.size()) >= kMaxSensors) {
+    *status = NO_AVAILABLE_RESOURCES;
+    return;
+  }
+  dma->sensors.push_back({kind, sensorHandle});
+}
+
+static bool FindSensor(const HAL_DMASample* dmaSample, SensorKind kind,
+                       HAL_Handle sensorHandle, int64_t* value,
+                       int32_t* status) {
+  const uint32_t* words = dmaSample->readBuffer;
+  const uint32_t* end =
+      words + std::min<uint32_t>(dmaSample->captureSize,
+                                 kMaxSensors * kWordsPerSensor);
+  for (; words < end; words += kWordsPerSensor) {
+    if (words[0] == static_cast<uint32_t>(kind) &&
+        words[1] == static_cast<uint32_t>(sensorHandle)) {
+      *value = static_cast<int64_t>(static_cast<uint64_t>(words[3]) << 32 |
+                                    words[2]);
+      return true;
+    }
+  }
+  *status = NiFpga_Status_ResourceNotFound;
+  return false;
+}
+
+namespace hal {
+void SampleDMA(uint64_t currentTime) {
+  wpi::SmallVector<std::shared_ptr<DMA>, 1> started;
+  {
+    std::scoped_lock lock(startedMutex);
+    started.append(startedDMAs.begin(), startedDMAs.end());
+  }
+  for (auto&& dma : started) {
+    std::scoped_lock lock(dma->mutex);
+    SampleLocked(*dma, currentTime);
+  }
+}
+}  // namespace hal
+
 extern "C" {
 HAL_DMAHandle HAL_InitializeDMA(int32_t* status) {
-  return HAL_kInvalidHandle;
+  HAL_Handle handle = dmaHandles->Allocate();
+  if (handle == HAL_kInvalidHandle) {
+    *status = NO_AVAILABLE_RESOURCES;
+    return HAL_kInvalidHandle;
+  }
+  return handle;
+}
+void HAL_FreeDMA(HAL_DMAHandle handle) {
+  auto dma = dmaHandles->Get(handle);
+  dmaHandles->Free(handle);
+
+  if (!dma) {
+    return;
+  }
+
+  RemoveStarted(dma.get());
+  std::scoped_lock lock(dma->mutex);
+  dma->started = false;
+  dma->cond.notify_all();
 }
-void HAL_FreeDMA(HAL_DMAHandle handle) {}
 
-void HAL_SetDMAPause(HAL_DMAHandle handle, HAL_Bool pause, int32_t* status) {}
+void HAL_SetDMAPause(HAL_DMAHandle handle, HAL_Bool pause, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  std::scoped_lock lock(dma->mutex);
+  if (!dma->started) {
+    *status = HAL_INVALID_DMA_STATE;
+    return;
+  }
+
+  // Triggers before the change keep the old state
+  SampleLocked(*dma, GetFPGATime());
+  dma->paused = pause;
+}
 void HAL_SetDMATimedTrigger(HAL_DMAHandle handle, double periodSeconds,
-                            int32_t* status) {}
+                            int32_t* status) {
+  constexpr double baseMultipler = kSystemClockTicksPerMicrosecond * 1000000;
+  uint32_t cycles = static_cast<uint32_t>(baseMultipler * periodSeconds);
+  HAL_SetDMATimedTriggerCycles(handle, cycles, status);
+}
 void HAL_SetDMATimedTriggerCycles(HAL_DMAHandle handle, uint32_t cycles,
-                                  int32_t* status) {}
+                                  int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  std::scoped_lock lock(dma->mutex);
+  if (dma->started) {
+    *status = HAL_INVALID_DMA_ADDITION;
+    return;
+  }
+
+  // FPGA time only has microsecond resolution
+  dma->period = std::max<uint64_t>(cycles / kSystemClockTicksPerMicrosecond, 1);
+}
 
 void HAL_AddDMAEncoder(HAL_DMAHandle handle, HAL_EncoderHandle encoderHandle,
-                       int32_t* status) {}
+                       int32_t* status) {
+  if (getHandleType(encoderHandle) != HAL_HandleEnum::Encoder) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  AddSensor(handle, SensorKind::kEncoder, encoderHandle, status);
+}
 void HAL_AddDMAEncoderPeriod(HAL_DMAHandle handle,
                              HAL_EncoderHandle encoderHandle, int32_t* status) {
+  if (getHandleType(encoderHandle) != HAL_HandleEnum::Encoder) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  AddSensor(handle, SensorKind::kEncoderPeriod, encoderHandle, status);
 }
 void HAL_AddDMACounter(HAL_DMAHandle handle, HAL_CounterHandle counterHandle,
-                       int32_t* status) {}
+                       int32_t* status) {
+  if (getHandleType(counterHandle) != HAL_HandleEnum::Counter) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  AddSensor(handle, SensorKind::kCounter, counterHandle, status);
+}
 void HAL_AddDMACounterPeriod(HAL_DMAHandle handle,
                              HAL_CounterHandle counterHandle, int32_t* status) {
+  if (getHandleType(counterHandle) != HAL_HandleEnum::Counter) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  AddSensor(handle, SensorKind::kCounterPeriod, counterHandle, status);
 }
 void HAL_AddDMADigitalSource(HAL_DMAHandle handle,
-                             HAL_Handle digitalSourceHandle, int32_t* status) {}
+                             HAL_Handle digitalSourceHandle, int32_t* status) {
+  // Analog trigger outputs have no sim value to sample
+  if (getHandleType(digitalSourceHandle) == HAL_HandleEnum::AnalogTrigger) {
+    *status = HAL_SIM_NOT_SUPPORTED;
+    return;
+  }
+  if (getHandleType(digitalSourceHandle) != HAL_HandleEnum::DIO) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  AddSensor(handle, SensorKind::kDigitalSource, digitalSourceHandle, status);
+}
 void HAL_AddDMAAnalogInput(HAL_DMAHandle handle,
-                           HAL_AnalogInputHandle aInHandle, int32_t* status) {}
+                           HAL_AnalogInputHandle aInHandle, int32_t* status) {
+  if (getHandleType(aInHandle) != HAL_HandleEnum::AnalogInput) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  AddSensor(handle, SensorKind::kAnalogInput, aInHandle, status);
+}
 
 void HAL_AddDMAAveragedAnalogInput(HAL_DMAHandle handle,
                                    HAL_AnalogInputHandle aInHandle,
-                                   int32_t* status) {}
+                                   int32_t* status) {
+  if (getHandleType(aInHandle) != HAL_HandleEnum::AnalogInput) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  AddSensor(handle, SensorKind::kAveragedAnalogInput, aInHandle, status);
+}
 
 void HAL_AddDMAAnalogAccumulator(HAL_DMAHandle handle,
                                  HAL_AnalogInputHandle aInHandle,
-                                 int32_t* status) {}
+                                 int32_t* status) {
+  if (!HAL_IsAccumulatorChannel(aInHandle, status)) {
+    *status = HAL_INVALID_ACCUMULATOR_CHANNEL;
+    return;
+  }
+  AddSensor(handle, SensorKind::kAccumulatorCount, aInHandle, status);
+  if (*status == 0) {
+    AddSensor(handle, SensorKind::kAccumulatorValue, aInHandle, status);
+  }
+}
 
 void HAL_AddDMADutyCycle(HAL_DMAHandle handle,
                          HAL_DutyCycleHandle dutyCycleHandle, int32_t* status) {
+  if (getHandleType(dutyCycleHandle) != HAL_HandleEnum::DutyCycle) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  AddSensor(handle, SensorKind::kDutyCycle, dutyCycleHandle, status);
 }
 
 int32_t HAL_SetDMAExternalTrigger(HAL_DMAHandle handle,
@@ -48,17 +405,87 @@ int32_t HAL_SetDMAExternalTrigger(HAL_DMAHandle handle,
                                   HAL_AnalogTriggerType analogTriggerType,
                                   HAL_Bool rising, HAL_Bool falling,
                                   int32_t* status) {
+  // Sim sensor values don't have edges to trigger on
+  *status = HAL_SIM_NOT_SUPPORTED;
   return 0;
 }
 
-void HAL_ClearDMASensors(HAL_DMAHandle handle, int32_t* status) {}
-void HAL_ClearDMAExternalTriggers(HAL_DMAHandle handle, int32_t* status) {}
+void HAL_ClearDMASensors(HAL_DMAHandle handle, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
 
-void HAL_StartDMA(HAL_DMAHandle handle, int32_t queueDepth, int32_t* status) {}
-void HAL_StopDMA(HAL_DMAHandle handle, int32_t* status) {}
+  std::scoped_lock lock(dma->mutex);
+  if (dma->started) {
+    *status = HAL_INVALID_DMA_STATE;
+    return;
+  }
+
+  dma->sensors.clear();
+}
+void HAL_ClearDMAExternalTriggers(HAL_DMAHandle handle, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  std::scoped_lock lock(dma->mutex);
+  if (dma->started) {
+    *status = HAL_INVALID_DMA_STATE;
+  }
+}
+
+void HAL_StartDMA(HAL_DMAHandle handle, int32_t queueDepth, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  if (queueDepth <= 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  {
+    std::scoped_lock lock(dma->mutex);
+    if (dma->started) {
+      *status = HAL_INVALID_DMA_STATE;
+      return;
+    }
+
+    dma->queue.assign(queueDepth, HAL_DMASample{});
+    dma->head = 0;
+    dma->count = 0;
+    dma->paused = false;
+    dma->nextTrigger = GetFPGATime() + dma->period;
+    dma->started = true;
+  }
+
+  std::scoped_lock lock(startedMutex);
+  startedDMAs.push_back(dma);
+}
+void HAL_StopDMA(HAL_DMAHandle handle, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  RemoveStarted(dma.get());
+  std::scoped_lock lock(dma->mutex);
+  dma->started = false;
+  dma->queue.clear();
+  dma->count = 0;
+  dma->cond.notify_all();
+}
 
 void* HAL_GetDMADirectPointer(HAL_DMAHandle handle) {
-  return nullptr;
+  auto dma = dmaHandles->Get(handle);
+  return dma.get();
 }
 
 enum HAL_DMAReadStatus HAL_ReadDMADirect(void* dmaPointer,
@@ -66,69 +493,168 @@ enum HAL_DMAReadStatus HAL_ReadDMADirect(void* dmaPointer,
                                          double timeoutSeconds,
                                          int32_t* remainingOut,
                                          int32_t* status) {
-  return HAL_DMA_ERROR;
+  DMA* dma = static_cast<DMA*>(dmaPointer);
+  *remainingOut = 0;
+
+  auto timeoutTime =
+      std::chrono::steady_clock::now() +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(timeoutSeconds));
+
+  std::unique_lock lock(dma->mutex);
+  for (;;) {
+    if (!dma->started) {
+      *status = HAL_INVALID_DMA_STATE;
+      return HAL_DMA_ERROR;
+    }
+
+    // In real time, triggers since the last read are sampled now
+    uint64_t currentTime = GetFPGATime();
+    SampleLocked(*dma, currentTime);
+
+    if (dma->count > 0) {
+      *dmaSample = dma->queue[dma->head];
+      dma->head = (dma->head + 1) % dma->queue.size();
+      --dma->count;
+      *remainingOut = dma->count;
+      return HAL_DMA_OK;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now >= timeoutTime) {
+      return HAL_DMA_TIMEOUT;
+    }
+
+    // While timing is paused, samples only come from stepping it, which
+    // notifies the condition variable
+    auto wakeTime = timeoutTime;
+    if (!IsTimingPaused() && !dma->paused) {
+      wakeTime = std::min(
+          wakeTime,
+          now + std::chrono::microseconds(dma->nextTrigger - currentTime));
+    }
+    dma->cond.wait_until(lock, wakeTime);
+  }
 }
 
 enum HAL_DMAReadStatus HAL_ReadDMA(HAL_DMAHandle handle,
                                    HAL_DMASample* dmaSample,
                                    double timeoutSeconds, int32_t* remainingOut,
                                    int32_t* status) {
-  return HAL_DMA_ERROR;
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return HAL_DMA_ERROR;
+  }
+
+  return HAL_ReadDMADirect(dma.get(), dmaSample, timeoutSeconds, remainingOut,
+                           status);
 }
 
 // Sampling Code
 uint64_t HAL_GetDMASampleTime(const HAL_DMASample* dmaSample, int32_t* status) {
-  return 0;
+  return dmaSample->timeStamp;
 }
 
 int32_t HAL_GetDMASampleEncoderRaw(const HAL_DMASample* dmaSample,
                                    HAL_EncoderHandle encoderHandle,
                                    int32_t* status) {
-  return 0;
+  int64_t value = 0;
+  if (!FindSensor(dmaSample, SensorKind::kEncoder, encoderHandle, &value,
+                  status)) {
+    return -1;
+  }
+  return static_cast<int32_t>(value);
 }
 
 int32_t HAL_GetDMASampleCounter(const HAL_DMASample* dmaSample,
                                 HAL_CounterHandle counterHandle,
                                 int32_t* status) {
-  return 0;
+  int64_t value = 0;
+  if (!FindSensor(dmaSample, SensorKind::kCounter, counterHandle, &value,
+                  status)) {
+    return -1;
+  }
+  return static_cast<int32_t>(value);
 }
 
 int32_t HAL_GetDMASampleEncoderPeriodRaw(const HAL_DMASample* dmaSample,
                                          HAL_EncoderHandle encoderHandle,
                                          int32_t* status) {
-  return 0;
+  int64_t value = 0;
+  if (!FindSensor(dmaSample, SensorKind::kEncoderPeriod, encoderHandle, &value,
+                  status)) {
+    return -1;
+  }
+  return static_cast<int32_t>(value);
 }
 
 int32_t HAL_GetDMASampleCounterPeriod(const HAL_DMASample* dmaSample,
                                       HAL_CounterHandle counterHandle,
                                       int32_t* status) {
-  return 0;
+  int64_t value = 0;
+  if (!FindSensor(dmaSample, SensorKind::kCounterPeriod, counterHandle, &value,
+                  status)) {
+    return -1;
+  }
+  return static_cast<int32_t>(value);
 }
 HAL_Bool HAL_GetDMASampleDigitalSource(const HAL_DMASample* dmaSample,
                                        HAL_Handle dSourceHandle,
                                        int32_t* status) {
-  return 0;
+  int64_t value = 0;
+  if (!FindSensor(dmaSample, SensorKind::kDigitalSource, dSourceHandle, &value,
+                  status)) {
+    return false;
+  }
+  return value != 0;
 }
 int32_t HAL_GetDMASampleAnalogInputRaw(const HAL_DMASample* dmaSample,
                                        HAL_AnalogInputHandle aInHandle,
                                        int32_t* status) {
-  return 0;
+  int64_t value = 0;
+  if (!FindSensor(dmaSample, SensorKind::kAnalogInput, aInHandle, &value,
+                  status)) {
+    return 0xFFFFFFFF;
+  }
+  return static_cast<int32_t>(value);
 }
 
 int32_t HAL_GetDMASampleAveragedAnalogInputRaw(const HAL_DMASample* dmaSample,
                                                HAL_AnalogInputHandle aInHandle,
                                                int32_t* status) {
-  return 0;
+  int64_t value = 0;
+  if (!FindSensor(dmaSample, SensorKind::kAveragedAnalogInput, aInHandle,
+                  &value, status)) {
+    return 0xFFFFFFFF;
+  }
+  return static_cast<int32_t>(value);
 }
 
 void HAL_GetDMASampleAnalogAccumulator(const HAL_DMASample* dmaSample,
                                        HAL_AnalogInputHandle aInHandle,
                                        int64_t* count, int64_t* value,
-                                       int32_t* status) {}
+                                       int32_t* status) {
+  int64_t sampledCount = 0;
+  int64_t sampledValue = 0;
+  if (!FindSensor(dmaSample, SensorKind::kAccumulatorCount, aInHandle,
+                  &sampledCount, status) ||
+      !FindSensor(dmaSample, SensorKind::kAccumulatorValue, aInHandle,
+                  &sampledValue, status)) {
+    return;
+  }
+  *count = sampledCount;
+  *value = sampledValue;
+}
 
 int32_t HAL_GetDMASampleDutyCycleOutputRaw(const HAL_DMASample* dmaSample,
                                            HAL_DutyCycleHandle dutyCycleHandle,
                                            int32_t* status) {
-  return 0;
+  int64_t value = 0;
+  if (!FindSensor(dmaSample, SensorKind::kDutyCycle, dutyCycleHandle, &value,
+                  status)) {
+    return -1;
+  }
+  return static_cast<int32_t>(value);
 }
 }  // extern "C"
@@ -0,0 +1,17 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace hal {
+/**
+ * Takes the samples of every started DMA whose timed trigger has fired up to
+ * the given FPGA time, using the current sensor values.
+ *
+ * @param currentTime The FPGA time in microseconds.
+ */
+void SampleDMA(uint64_t currentTime);
+}  // namespace hal
@@ -37,16 +37,9 @@ class SimPeriodicCallbackRegistry : public impl::SimCallbackRegistryBase {
   }
 
   void operator()() const {
-#ifdef _MSC_VER  // work around VS2019 16.4.0 bug
-    std::scoped_lock<wpi::recursive_spinlock> lock(m_mutex);
-#else
-    std::scoped_lock lock(m_mutex);
-#endif
-    if (m_callbacks) {
-      for (auto&& cb : *m_callbacks) {
-        reinterpret_cast<HALSIM_SimPeriodicCallback>(cb.callback)(cb.param);
-      }
-    }
+    ForEachCallback([](const auto& cb) {
+      reinterpret_cast<HALSIM_SimPeriodicCallback>(cb.callback)(cb.param);
+    });
   }
 };
 }  // namespace
@@ -94,6 +87,7 @@ void InitializeHAL() {
   InitializeCounter();
   InitializeDigitalInternal();
   InitializeDIO();
+  InitializeDMA();
   InitializeDutyCycle();
   InitializeDriverStation();
   InitializeEncoder();
@@ -276,6 +270,10 @@ uint64_t HAL_GetFPGATime(int32_t* status) {
   return hal::GetFPGATime();
 }
 
+uint64_t HAL_GetFPGATimeFast(int32_t* status) {
+  return hal::GetFPGATime();
+}
+
 uint64_t HAL_ExpandFPGATime(uint32_t unexpanded_lower, int32_t* status) {
   // Capture the current FPGA time.  This will give us the upper half of the
   // clock.
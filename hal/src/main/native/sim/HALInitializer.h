@@ -52,6 +52,7 @@ extern void InitializeConstants();
 extern void InitializeCounter();
 extern void InitializeDigitalInternal();
 extern void InitializeDIO();
+extern void InitializeDMA();
 extern void InitializeDriverStation();
 extern void InitializeEncoder();
 extern void InitializeExtensions();
@@ -4,8 +4,13 @@
 
 #include "hal/Interrupts.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <vector>
 
+#include <wpi/BoundedConcurrentQueue.h>
 #include <wpi/condition_variable.h>
 
 #include "AnalogInternal.h"
@@ -55,6 +60,25 @@ struct SynchronousWaitData {
   wpi::condition_variable waitCond;
   HAL_Bool waitPredicate{false};
 };
+
+struct InterruptGroup {
+  explicit InterruptGroup(int32_t queueDepth)
+      : events{static_cast<size_t>(queueDepth)} {}
+
+  std::vector<HAL_Handle> sourceHandles;
+  wpi::BoundedConcurrentQueue<HAL_InterruptEvent> events;
+  std::atomic<int64_t> dropped{0};
+};
+
+// An interrupt in a group, watched with a sim value callback
+struct InterruptGroupSource {
+  HAL_InterruptHandle interruptHandle;
+  std::shared_ptr<Interrupt> interrupt;
+  std::shared_ptr<InterruptGroup> group;
+  int32_t inputIndex = 0;  // DIO or analog input index
+  int32_t callbackId = -1;
+  std::atomic<bool> previousState;
+};
 }  // namespace
 
 static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
@@ -65,6 +89,15 @@ static UnlimitedHandleResource<SynchronousWaitDataHandle, SynchronousWaitData,
                                HAL_HandleEnum::Vendor>*
     synchronousInterruptHandles;
 
+static UnlimitedHandleResource<HAL_InterruptGroupHandle, InterruptGroup,
+                               HAL_HandleEnum::InterruptGroup>*
+    interruptGroupHandles;
+
+using InterruptGroupSourceHandle = HAL_Handle;
+static UnlimitedHandleResource<InterruptGroupSourceHandle,
+                               InterruptGroupSource, HAL_HandleEnum::Vendor>*
+    interruptGroupSourceHandles;
+
 namespace hal::init {
 void InitializeInterrupts() {
   static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
@@ -75,6 +108,14 @@ void InitializeInterrupts() {
                                  HAL_HandleEnum::Vendor>
       siH;
   synchronousInterruptHandles = &siH;
+  static UnlimitedHandleResource<HAL_InterruptGroupHandle, InterruptGroup,
+                                 HAL_HandleEnum::InterruptGroup>
+      igH;
+  interruptGroupHandles = &igH;
+  static UnlimitedHandleResource<InterruptGroupSourceHandle,
+                                 InterruptGroupSource, HAL_HandleEnum::Vendor>
+      igsH;
+  interruptGroupSourceHandles = &igsH;
 }
 }  // namespace hal::init
 
@@ -423,4 +464,191 @@ void HAL_ReleaseWaitingInterrupt(HAL_InterruptHandle interruptHandle,
         }
       });
 }
+
+static void ProcessInterruptGroupEdge(InterruptGroupSource* source,
+                                      bool state) {
+  if (source->previousState.exchange(state) == state) {
+    return;
+  }
+  if ((state && !source->interrupt->fireOnUp) ||
+      (!state && !source->interrupt->fireOnDown)) {
+    return;
+  }
+  HAL_InterruptEvent event{source->interruptHandle, state,
+                           static_cast<int64_t>(hal::GetFPGATime())};
+  if (!source->group->events.try_push(event)) {
+    source->group->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+static void ProcessInterruptGroupDigital(const char* name, void* param,
+                                         const struct HAL_Value* value) {
+  // void* is an InterruptGroupSourceHandle.
+  auto source = interruptGroupSourceHandles->Get(
+      static_cast<InterruptGroupSourceHandle>(
+          reinterpret_cast<uintptr_t>(param)));
+  if (source == nullptr || value->type != HAL_Type::HAL_BOOLEAN) {
+    return;
+  }
+  ProcessInterruptGroupEdge(source.get(), value->data.v_boolean);
+}
+
+static void ProcessInterruptGroupAnalog(const char* name, void* param,
+                                        const struct HAL_Value* value) {
+  // void* is an InterruptGroupSourceHandle.
+  auto source = interruptGroupSourceHandles->Get(
+      static_cast<InterruptGroupSourceHandle>(
+          reinterpret_cast<uintptr_t>(param)));
+  if (source == nullptr || value->type != HAL_Type::HAL_DOUBLE) {
+    return;
+  }
+  int32_t status = 0;
+  bool state = GetAnalogTriggerValue(source->interrupt->portHandle,
+                                     source->interrupt->trigType, &status);
+  if (status != 0) {
+    return;
+  }
+  ProcessInterruptGroupEdge(source.get(), state);
+}
+
+static void FreeInterruptGroupSources(InterruptGroup* group) {
+  for (auto sourceHandle : group->sourceHandles) {
+    auto source = interruptGroupSourceHandles->Free(sourceHandle);
+    if (source == nullptr) {
+      continue;
+    }
+    if (source->interrupt->isAnalog) {
+      SimAnalogInData[source->inputIndex].voltage.CancelCallback(
+          source->callbackId);
+    } else {
+      SimDIOData[source->inputIndex].value.CancelCallback(source->callbackId);
+    }
+  }
+  group->sourceHandles.clear();
+}
+
+HAL_InterruptGroupHandle HAL_InitializeInterruptGroup(
+    const HAL_InterruptHandle* interruptHandles, int32_t numInterrupts,
+    int32_t queueDepth, int32_t* status) {
+  hal::init::CheckInit();
+  if (numInterrupts < 1 || queueDepth < 1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return HAL_kInvalidHandle;
+  }
+
+  auto group = std::make_shared<InterruptGroup>(queueDepth);
+  for (int32_t i = 0; i < numInterrupts; ++i) {
+    auto source = std::make_shared<InterruptGroupSource>();
+    source->interruptHandle = interruptHandles[i];
+    source->interrupt = ::interruptHandles->Get(interruptHandles[i]);
+    source->group = group;
+    if (source->interrupt == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      break;
+    }
+    auto interrupt = source->interrupt.get();
+    if (interrupt->isAnalog) {
+      source->inputIndex =
+          GetAnalogTriggerInputIndex(interrupt->portHandle, status);
+      source->previousState = GetAnalogTriggerValue(
+          interrupt->portHandle, interrupt->trigType, status);
+    } else {
+      source->inputIndex =
+          GetDigitalInputChannel(interrupt->portHandle, status);
+      if (*status == 0) {
+        source->previousState = SimDIOData[source->inputIndex].value;
+      }
+    }
+    if (*status != 0) {
+      break;
+    }
+
+    auto sourceHandle = interruptGroupSourceHandles->Allocate(source);
+    if (sourceHandle == HAL_kInvalidHandle) {
+      *status = NO_AVAILABLE_RESOURCES;
+      break;
+    }
+    group->sourceHandles.push_back(sourceHandle);
+    void* param = reinterpret_cast<void*>(static_cast<uintptr_t>(sourceHandle));
+    if (interrupt->isAnalog) {
+      source->callbackId =
+          SimAnalogInData[source->inputIndex].voltage.RegisterCallback(
+              &ProcessInterruptGroupAnalog, param, false);
+    } else {
+      source->callbackId =
+          SimDIOData[source->inputIndex].value.RegisterCallback(
+              &ProcessInterruptGroupDigital, param, false);
+    }
+  }
+  if (*status != 0) {
+    FreeInterruptGroupSources(group.get());
+    return HAL_kInvalidHandle;
+  }
+
+  HAL_InterruptGroupHandle handle = interruptGroupHandles->Allocate(group);
+  if (handle == HAL_kInvalidHandle) {
+    FreeInterruptGroupSources(group.get());
+    *status = NO_AVAILABLE_RESOURCES;
+  }
+  return handle;
+}
+
+void HAL_CleanInterruptGroup(HAL_InterruptGroupHandle interruptGroupHandle) {
+  auto group = interruptGroupHandles->Free(interruptGroupHandle);
+  if (group == nullptr) {
+    return;
+  }
+  FreeInterruptGroupSources(group.get());
+}
+
+int32_t HAL_ReadInterruptGroupEvents(
+    HAL_InterruptGroupHandle interruptGroupHandle,
+    struct HAL_InterruptEvent* events, int32_t maxEvents, double timeout,
+    int32_t* status) {
+  auto group = interruptGroupHandles->Get(interruptGroupHandle);
+  if (group == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  if (maxEvents < 1) {
+    return 0;
+  }
+
+  // An invalid handle is a release from HAL_ReleaseWaitingInterruptGroup()
+  HAL_InterruptEvent event;
+  if (!group->events.try_pop_for(
+          event, std::chrono::duration<double>((std::max)(timeout, 0.0))) ||
+      event.interrupt == HAL_kInvalidHandle) {
+    return 0;
+  }
+  int32_t count = 0;
+  do {
+    if (event.interrupt == HAL_kInvalidHandle) {
+      break;
+    }
+    events[count++] = event;
+  } while (count < maxEvents && group->events.try_pop(event));
+  return count;
+}
+
+void HAL_ReleaseWaitingInterruptGroup(
+    HAL_InterruptGroupHandle interruptGroupHandle, int32_t* status) {
+  auto group = interruptGroupHandles->Get(interruptGroupHandle);
+  if (group == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  // If the queue is full, no one is waiting
+  group->events.try_push({HAL_kInvalidHandle, false, 0});
+}
+
+int64_t HAL_GetInterruptGroupDroppedCount(
+    HAL_InterruptGroupHandle interruptGroupHandle, int32_t* status) {
+  auto group = interruptGroupHandles->Get(interruptGroupHandle);
+  if (group == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  return group->dropped.load(std::memory_order_relaxed);
+}
 }  // extern "C"
@@ -9,8 +9,10 @@
 #include <thread>
 
 #include <fmt/format.h>
+#include <wpi/SafeThread.h>
 #include <wpi/timestamp.h>
 
+#include "DMAInternal.h"
 #include "MockHooksInternal.h"
 #include "NotifierInternal.h"
 #include "hal/simulation/NotifierData.h"
@@ -21,6 +23,18 @@ static std::atomic<uint64_t> programStartTime{0};
 static std::atomic<uint64_t> programPauseTime{0};
 static std::atomic<uint64_t> programStepTime{0};
 
+namespace {
+// Jumps timing to each notifier alarm as soon as every notifier is waiting
+class FastForwardThread : public wpi::SafeThread {
+ public:
+  void Main() override;
+};
+}  // namespace
+
+static wpi::SafeThreadOwner<FastForwardThread> fastForwardThread;
+static std::atomic<bool> fastForwardEnabled{false};
+static std::atomic<bool> lockStepEnabled{false};
+
 namespace hal::init {
 void InitializeMockHooks() {
   wpi::SetNowImpl(GetFPGATime);
@@ -127,12 +141,68 @@ void HALSIM_StepTiming(uint64_t delta) {
     StepTiming(step);
     delta -= step;
 
+    // Sensors only change in notifier callbacks, so DMA sees the values from
+    // before this step for every trigger in it
+    SampleDMA(curTime + step);
     WakeupWaitNotifiers();
   }
 }
 
+void HALSIM_SetTimingFastForward(HAL_Bool enable) {
+  if (enable) {
+    HALSIM_PauseTiming();
+    fastForwardThread.SetJoinAtExit(false);
+    fastForwardThread.Start();
+  } else {
+    fastForwardThread.Join();
+  }
+  fastForwardEnabled = enable;
+}
+
+HAL_Bool HALSIM_IsTimingFastForward(void) {
+  return fastForwardEnabled;
+}
+
+void HALSIM_SetTimingLockStep(HAL_Bool enable) {
+  SetNotifiersLockStep(enable);
+  HALSIM_SetTimingFastForward(enable);
+  lockStepEnabled = enable;
+}
+
+HAL_Bool HALSIM_IsTimingLockStep(void) {
+  return lockStepEnabled;
+}
+
 void HALSIM_StepTimingAsync(uint64_t delta) {
   StepTiming(delta);
+  SampleDMA(GetFPGATime());
   WakeupNotifiers();
 }
 }  // extern "C"
+
+void FastForwardThread::Main() {
+  std::unique_lock lock(m_mutex);
+  while (m_active) {
+    lock.unlock();
+    WaitNotifiers();
+    int32_t status = 0;
+    uint64_t curTime = HAL_GetFPGATime(&status);
+    uint64_t nextTimeout = HALSIM_GetNextNotifierTimeout();
+    if (nextTimeout != UINT64_MAX) {
+      // An alarm set in the past fires without stepping
+      if (nextTimeout > curTime) {
+        StepTiming(nextTimeout - curTime);
+      }
+      SampleDMA(GetFPGATime());
+      WakeupWaitNotifiers();
+      lock.lock();
+      continue;
+    }
+
+    // Nothing can run until a notifier sets an alarm
+    lock.lock();
+    if (HALSIM_GetNextNotifierTimeout() == UINT64_MAX) {
+      m_cond.wait_for(lock, std::chrono::milliseconds(1));
+    }
+  }
+}
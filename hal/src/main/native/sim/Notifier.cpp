@@ -4,6 +4,7 @@
 
 #include "hal/Notifier.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdio>
@@ -12,7 +13,9 @@
 
 #include <wpi/SmallVector.h>
 #include <wpi/condition_variable.h>
+#include <wpi/indexed_priority_queue.h>
 #include <wpi/mutex.h>
+#include <wpi/span.h>
 
 #include "HALInitializer.h"
 #include "NotifierInternal.h"
@@ -30,6 +33,7 @@ struct Notifier {
   bool waitTimeValid = false;    // True if waitTime is set and in the future
   bool waitingForAlarm = false;  // True if in HAL_WaitForNotifierAlarm()
   uint64_t waitCount = 0;        // Counts calls to HAL_WaitForNotifierAlarm()
+  bool released = false;         // Set by WakeupWaitNotifiers() to fire
   wpi::mutex mutex;
   wpi::condition_variable cond;
 };
@@ -59,6 +63,90 @@ class NotifierHandleContainer
 
 static NotifierHandleContainer* notifierHandles;
 static std::atomic<bool> notifiersPaused{false};
+static std::atomic<bool> notifiersLockStep{false};
+
+// Active notifiers with a valid wait time, earliest first.  Taken while
+// holding a notifier's mutex, never the other way around.
+static wpi::mutex timeoutQueueMutex;
+static wpi::indexed_priority_queue<HAL_NotifierHandle, uint64_t,
+                                   std::greater<uint64_t>>
+    timeoutQueue;
+
+static void UpdateTimeout(HAL_NotifierHandle handle, uint64_t waitTime) {
+  std::scoped_lock lock(timeoutQueueMutex);
+  if (waitTime == UINT64_MAX) {
+    timeoutQueue.remove(handle);
+  } else {
+    timeoutQueue.push(handle, waitTime);
+  }
+}
+
+// Lets WaitNotifiers() and WakeupWaitNotifiers() stop waiting for a notifier
+// that was stopped
+static void NotifyNotifierWaiters() {
+  // They check notifiers while holding the mutex, so taking it here ensures
+  // they either saw the change or are waiting for this notification
+  {
+    std::scoped_lock lock(notifiersWaiterMutex);
+  }
+  notifiersWaiterCond.notify_all();
+}
+
+// Collects the notifiers whose timeouts have expired at curTime
+static void GetDueNotifiers(uint64_t curTime,
+                            wpi::SmallVectorImpl<HAL_NotifierHandle>& due) {
+  std::scoped_lock lock(timeoutQueueMutex);
+  timeoutQueue.for_each_top(curTime, [&](HAL_NotifierHandle handle, uint64_t) {
+    due.push_back(handle);
+  });
+}
+
+// Wakes the notifiers whose timeouts have expired at curTime and waits for
+// them to call HAL_WaitForNotifierAlarm() again
+static void WakeAndWaitNotifiers(std::unique_lock<wpi::mutex>& ulock,
+                                 uint64_t curTime,
+                                 wpi::span<const HAL_NotifierHandle> handles) {
+  wpi::SmallVector<std::pair<HAL_NotifierHandle, uint64_t>, 8> waiters;
+  for (auto handle : handles) {
+    auto notifier = notifierHandles->Get(handle);
+    if (!notifier) {
+      continue;
+    }
+    std::scoped_lock lock(notifier->mutex);
+
+    // The timeout may have changed since the queue was read
+    if (notifier->active && notifier->waitTimeValid &&
+        curTime >= notifier->waitTime) {
+      waiters.emplace_back(handle, notifier->waitCount);
+      notifier->released = true;
+      notifier->cond.notify_all();
+    }
+  }
+  for (;;) {
+    int count = 0;
+    int end = waiters.size();
+    while (count < end) {
+      auto& it = waiters[count];
+      if (auto notifier = notifierHandles->Get(it.first)) {
+        std::scoped_lock lock(notifier->mutex);
+
+        // waitCount is used here instead of waitingForAlarm because we want to
+        // wait until HAL_WaitForNotifierAlarm() is exited, then reentered
+        if (notifier->active && notifier->waitCount == it.second) {
+          ++count;
+          continue;
+        }
+      }
+      // No longer need to wait for it, put at end so it can be erased
+      it.swap(waiters[--end]);
+    }
+    if (count == 0) {
+      break;
+    }
+    waiters.resize(count);
+    notifiersWaiterCond.wait_for(ulock, std::chrono::duration<double>(1));
+  }
+}
 
 namespace hal {
 namespace init {
@@ -78,9 +166,24 @@ void ResumeNotifiers() {
 }
 
 void WakeupNotifiers() {
-  notifierHandles->ForEach([](HAL_NotifierHandle handle, Notifier* notifier) {
-    notifier->cond.notify_all();
-  });
+  if (!notifiersPaused) {
+    // In real time, every waiter needs to recompute how long to sleep
+    notifierHandles->ForEach(
+        [](HAL_NotifierHandle handle, Notifier* notifier) {
+          notifier->cond.notify_all();
+        });
+    return;
+  }
+
+  // While paused, waiters sleep until woken, so only the due ones need it
+  int32_t status = 0;
+  wpi::SmallVector<HAL_NotifierHandle, 8> due;
+  GetDueNotifiers(HAL_GetFPGATime(&status), due);
+  for (auto handle : due) {
+    if (auto notifier = notifierHandles->Get(handle)) {
+      notifier->cond.notify_all();
+    }
+  }
 }
 
 void WaitNotifiers() {
@@ -117,46 +220,32 @@ void WaitNotifiers() {
   }
 }
 
+void SetNotifiersLockStep(bool enable) {
+  notifiersLockStep = enable;
+  WakeupNotifiers();
+}
+
 void WakeupWaitNotifiers() {
   std::unique_lock ulock(notifiersWaiterMutex);
   int32_t status = 0;
   uint64_t curTime = HAL_GetFPGATime(&status);
-  wpi::SmallVector<std::pair<HAL_NotifierHandle, uint64_t>, 8> waiters;
-
-  // Wake up Notifiers that have expired timeouts
-  notifierHandles->ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
-    std::scoped_lock lock(notifier->mutex);
 
-    // Only wait for the Notifier if it has a valid timeout that's expired
-    if (notifier->active && notifier->waitTimeValid &&
-        curTime >= notifier->waitTime) {
-      waiters.emplace_back(handle, notifier->waitCount);
-      notifier->cond.notify_all();
-    }
-  });
-  for (;;) {
-    int count = 0;
-    int end = waiters.size();
-    while (count < end) {
-      auto& it = waiters[count];
-      if (auto notifier = notifierHandles->Get(it.first)) {
-        std::scoped_lock lock(notifier->mutex);
+  // Wake up only the Notifiers that have expired timeouts
+  wpi::SmallVector<HAL_NotifierHandle, 8> due;
+  GetDueNotifiers(curTime, due);
+  if (!notifiersLockStep) {
+    WakeAndWaitNotifiers(ulock, curTime, due);
+    return;
+  }
 
-        // waitCount is used here instead of waitingForAlarm because we want to
-        // wait until HAL_WaitForNotifierAlarm() is exited, then reentered
-        if (notifier->active && notifier->waitCount == it.second) {
-          ++count;
-          continue;
-        }
-      }
-      // No longer need to wait for it, put at end so it can be erased
-      it.swap(waiters[--end]);
-    }
-    if (count == 0) {
-      break;
-    }
-    waiters.resize(count);
-    notifiersWaiterCond.wait_for(ulock, std::chrono::duration<double>(1));
+  // In lock step, run them one at a time in creation order, so the order
+  // their alarms are handled in doesn't depend on thread scheduling
+  std::sort(due.begin(), due.end(),
+            [](HAL_NotifierHandle lhs, HAL_NotifierHandle rhs) {
+              return getHandleIndex(lhs) < getHandleIndex(rhs);
+            });
+  for (auto handle : due) {
+    WakeAndWaitNotifiers(ulock, curTime, {&handle, 1});
   }
 }
 }  // namespace hal
@@ -199,8 +288,10 @@ void HAL_StopNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
     std::scoped_lock lock(notifier->mutex);
     notifier->active = false;
     notifier->waitTimeValid = false;
+    UpdateTimeout(notifierHandle, UINT64_MAX);
   }
   notifier->cond.notify_all();
+  NotifyNotifierWaiters();
 }
 
 void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
@@ -214,8 +305,10 @@ void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
     std::scoped_lock lock(notifier->mutex);
     notifier->active = false;
     notifier->waitTimeValid = false;
+    UpdateTimeout(notifierHandle, UINT64_MAX);
   }
   notifier->cond.notify_all();
+  NotifyNotifierWaiters();
 }
 
 void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
@@ -229,6 +322,10 @@ void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
     std::scoped_lock lock(notifier->mutex);
     notifier->waitTime = triggerTime;
     notifier->waitTimeValid = (triggerTime != UINT64_MAX);
+    notifier->released = false;
+    if (notifier->active) {
+      UpdateTimeout(notifierHandle, triggerTime);
+    }
   }
 
   // We wake up any waiters to change how long they're sleeping for
@@ -245,6 +342,8 @@ void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
   {
     std::scoped_lock lock(notifier->mutex);
     notifier->waitTimeValid = false;
+    notifier->released = false;
+    UpdateTimeout(notifierHandle, UINT64_MAX);
   }
 }
 
@@ -263,9 +362,14 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
   notifiersWaiterCond.notify_all();
   while (notifier->active) {
     uint64_t curTime = HAL_GetFPGATime(status);
-    if (notifier->waitTimeValid && curTime >= notifier->waitTime) {
+    // In lock step, expired alarms only fire once WakeupWaitNotifiers() gets
+    // to them
+    if (notifier->waitTimeValid && curTime >= notifier->waitTime &&
+        (notifier->released || !notifiersLockStep)) {
       notifier->waitTimeValid = false;
       notifier->waitingForAlarm = false;
+      notifier->released = false;
+      UpdateTimeout(notifierHandle, UINT64_MAX);
       return curTime;
     }
 
@@ -284,15 +388,8 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
 }
 
 uint64_t HALSIM_GetNextNotifierTimeout(void) {
-  uint64_t timeout = UINT64_MAX;
-  notifierHandles->ForEach([&](HAL_NotifierHandle, Notifier* notifier) {
-    std::scoped_lock lock(notifier->mutex);
-    if (notifier->active && notifier->waitTimeValid &&
-        timeout > notifier->waitTime) {
-      timeout = notifier->waitTime;
-    }
-  });
-  return timeout;
+  std::scoped_lock lock(timeoutQueueMutex);
+  return timeoutQueue.empty() ? UINT64_MAX : timeoutQueue.top().second;
 }
 
 int32_t HALSIM_GetNumNotifiers(void) {
@@ -10,4 +10,5 @@ void ResumeNotifiers();
 void WakeupNotifiers();
 void WaitNotifiers();
 void WakeupWaitNotifiers();
+void SetNotifiersLockStep(bool enable);
 }  // namespace hal
@@ -64,6 +64,11 @@ void HAL_ResetSimValue(HAL_SimValueHandle handle) {
   SimSimDeviceData->ResetValue(handle);
 }
 
+void HAL_SetSimValues(const HAL_SimValueHandle* handles,
+                      const struct HAL_Value* values, int32_t count) {
+  SimSimDeviceData->SetValues(handles, values, count);
+}
+
 hal::SimDevice::SimDevice(const char* name, int index) {
   m_handle = HAL_CreateSimDevice(fmt::format("{}[{}]", name, index).c_str());
 }
@@ -28,6 +28,15 @@ class AccelerometerData {
   SimDataValue<double, HAL_MakeDouble, GetZName> z{0.0};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(active);
+    func(range);
+    func(x);
+    func(y);
+    func(z);
+  }
 };
 extern AccelerometerData* SimAccelerometerData;
 }  // namespace hal
@@ -36,6 +36,21 @@ void AddressableLEDData::SetData(const HAL_AddressableLEDData* d, int32_t len) {
   data(reinterpret_cast<const uint8_t*>(d), len * sizeof(d[0]));
 }
 
+void AddressableLEDData::SetDataRange(const HAL_AddressableLEDData* d,
+                                      int32_t start, int32_t len) {
+  start = (std::min)(HAL_kAddressableLEDMaxLength, start);
+  len = (std::min)(HAL_kAddressableLEDMaxLength - start, len);
+  // Data callbacks always see the strip from the start
+  std::vector<HAL_AddressableLEDData> strip(start + len);
+  {
+    std::scoped_lock lock(m_dataMutex);
+    std::memcpy(m_data + start, d, len * sizeof(d[0]));
+    std::memcpy(strip.data(), m_data, strip.size() * sizeof(d[0]));
+  }
+  data(reinterpret_cast<const uint8_t*>(strip.data()),
+       strip.size() * sizeof(d[0]));
+}
+
 int32_t AddressableLEDData::GetData(HAL_AddressableLEDData* d) {
   std::scoped_lock lock(m_dataMutex);
   int32_t len = length;
@@ -25,6 +25,8 @@ class AddressableLEDData {
 
  public:
   void SetData(const HAL_AddressableLEDData* d, int32_t len);
+  void SetDataRange(const HAL_AddressableLEDData* d, int32_t start,
+                    int32_t len);
   int32_t GetData(HAL_AddressableLEDData* d);
 
   SimDataValue<HAL_Bool, HAL_MakeBoolean, GetInitializedName> initialized{
@@ -35,6 +37,14 @@ class AddressableLEDData {
   SimCallbackRegistry<HAL_ConstBufferCallback, GetDataName> data;
 
   void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(outputPort);
+    func(length);
+    func(running);
+  }
 };
 extern AddressableLEDData* SimAddressableLEDData;
 }  // namespace hal
@@ -20,6 +20,13 @@ class AnalogGyroData {
       false};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(angle);
+    func(rate);
+    func(initialized);
+  }
 };
 extern AnalogGyroData* SimAnalogGyroData;
 }  // namespace hal
@@ -38,6 +38,19 @@ class AnalogInData {
       accumulatorDeadband{0};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(averageBits);
+    func(oversampleBits);
+    func(voltage);
+    func(accumulatorInitialized);
+    func(accumulatorValue);
+    func(accumulatorCount);
+    func(accumulatorCenter);
+    func(accumulatorDeadband);
+  }
 };
 extern AnalogInData* SimAnalogInData;
 }  // namespace hal
@@ -17,6 +17,12 @@ class AnalogOutData {
   SimDataValue<HAL_Bool, HAL_MakeBoolean, GetInitializedName> initialized{0};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(voltage);
+    func(initialized);
+  }
 };
 extern AnalogOutData* SimAnalogOutData;
 }  // namespace hal
@@ -31,6 +31,14 @@ class AnalogTriggerData {
   std::atomic<int32_t> inputPort;
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(triggerLowerBound);
+    func(triggerUpperBound);
+    func(triggerMode);
+  }
 };
 extern AnalogTriggerData* SimAnalogTriggerData;
 }  // namespace hal
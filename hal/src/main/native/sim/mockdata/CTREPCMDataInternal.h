@@ -38,6 +38,18 @@ class CTREPCMData {
       compressorCurrent{0.0};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    for (auto& output : solenoidOutput) {
+      func(output);
+    }
+    func(compressorOn);
+    func(closedLoopEnabled);
+    func(pressureSwitch);
+    func(compressorCurrent);
+  }
 };
 extern CTREPCMData* SimCTREPCMData;
 }  // namespace hal
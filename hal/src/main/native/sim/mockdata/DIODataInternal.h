@@ -25,6 +25,15 @@ class DIOData {
   SimDataValue<int32_t, HAL_MakeInt, GetFilterIndexName> filterIndex{-1};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(value);
+    func(pulseLength);
+    func(isInput);
+    func(filterIndex);
+  }
 };
 extern DIOData* SimDIOData;
 }  // namespace hal
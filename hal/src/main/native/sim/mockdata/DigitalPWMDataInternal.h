@@ -20,6 +20,13 @@ class DigitalPWMData {
   SimDataValue<int32_t, HAL_MakeInt, GetPinName> pin{0};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(dutyCycle);
+    func(pin);
+  }
 };
 extern DigitalPWMData* SimDigitalPWMData;
 }  // namespace hal
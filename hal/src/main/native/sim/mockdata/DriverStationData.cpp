@@ -2,7 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 
 #include "DriverStationDataInternal.h"
 #include "hal/DriverStation.h"
@@ -220,6 +222,55 @@ void DriverStationData::NotifyNewData() {
   HAL_ReleaseDSMutex();
 }
 
+static bool Equal(const HAL_JoystickAxes& lhs, const HAL_JoystickAxes& rhs) {
+  return lhs.count == rhs.count &&
+         std::equal(std::begin(lhs.axes), std::end(lhs.axes),
+                    std::begin(rhs.axes));
+}
+
+static bool Equal(const HAL_JoystickPOVs& lhs, const HAL_JoystickPOVs& rhs) {
+  return lhs.count == rhs.count &&
+         std::equal(std::begin(lhs.povs), std::end(lhs.povs),
+                    std::begin(rhs.povs));
+}
+
+static bool Equal(const HAL_JoystickButtons& lhs,
+                  const HAL_JoystickButtons& rhs) {
+  return lhs.count == rhs.count && lhs.buttons == rhs.buttons;
+}
+
+void DriverStationData::SetState(const HALSIM_DriverStationState* state) {
+  enabled.Set(state->controlWord.enabled);
+  autonomous.Set(state->controlWord.autonomous);
+  test.Set(state->controlWord.test);
+  eStop.Set(state->controlWord.eStop);
+  fmsAttached.Set(state->controlWord.fmsAttached);
+  dsAttached.Set(state->controlWord.dsAttached);
+  allianceStationId.Set(state->allianceStationId);
+  matchTime.Set(state->matchTime);
+
+  {
+    std::scoped_lock lock(m_joystickDataMutex);
+    for (int i = 0; i < kNumJoysticks; i++) {
+      auto& data = m_joystickData[i];
+      if (!Equal(data.axes, state->joystickAxes[i])) {
+        data.axes = state->joystickAxes[i];
+        m_joystickAxesCallbacks(i, &data.axes);
+      }
+      if (!Equal(data.povs, state->joystickPOVs[i])) {
+        data.povs = state->joystickPOVs[i];
+        m_joystickPOVsCallbacks(i, &data.povs);
+      }
+      if (!Equal(data.buttons, state->joystickButtons[i])) {
+        data.buttons = state->joystickButtons[i];
+        m_joystickButtonsCallbacks(i, &data.buttons);
+      }
+    }
+  }
+
+  NotifyNewData();
+}
+
 void DriverStationData::SetJoystickButton(int32_t stick, int32_t button,
                                           HAL_Bool state) {
   if (stick < 0 || stick >= kNumJoysticks) {
@@ -494,6 +545,10 @@ void HALSIM_NotifyDriverStationNewData(void) {
   SimDriverStationData->NotifyNewData();
 }
 
+void HALSIM_SetDriverStationState(const HALSIM_DriverStationState* state) {
+  SimDriverStationData->SetState(state);
+}
+
 void HALSIM_SetJoystickButton(int32_t stick, int32_t button, HAL_Bool state) {
   SimDriverStationData->SetJoystickButton(stick, button, state);
 }
@@ -40,6 +40,18 @@ class DriverStationData {
   DriverStationData();
   void ResetData();
 
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(enabled);
+    func(autonomous);
+    func(test);
+    func(eStop);
+    func(fmsAttached);
+    func(dsAttached);
+    func(allianceStationId);
+    func(matchTime);
+  }
+
   int32_t RegisterJoystickAxesCallback(int32_t joystickNum,
                                        HAL_JoystickAxesCallback callback,
                                        void* param, HAL_Bool initialNotify);
@@ -95,6 +107,8 @@ class DriverStationData {
 
   void NotifyNewData();
 
+  void SetState(const HALSIM_DriverStationState* state);
+
   void SetJoystickButton(int32_t stick, int32_t button, HAL_Bool state);
   void SetJoystickAxis(int32_t stick, int32_t axis, double value);
   void SetJoystickPOV(int32_t stick, int32_t pov, int32_t value);
@@ -25,6 +25,13 @@ class DutyCycleData {
   SimDataValue<double, HAL_MakeDouble, GetOutputName> output{0};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(frequency);
+    func(output);
+  }
 };
 extern DutyCycleData* SimDutyCycleData;
 }  // namespace hal
@@ -42,6 +42,19 @@ class EncoderData {
       distancePerPulse{1};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(count);
+    func(period);
+    func(reset);
+    func(maxPeriod);
+    func(direction);
+    func(reverseDirection);
+    func(samplesToAverage);
+    func(distancePerPulse);
+  }
 };
 extern EncoderData* SimEncoderData;
 }  // namespace hal
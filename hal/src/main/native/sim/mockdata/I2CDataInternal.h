@@ -25,6 +25,11 @@ class I2CData {
   SimCallbackRegistry<HAL_ConstBufferCallback, GetWriteName> write;
 
   void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+  }
 };
 extern I2CData* SimI2CData;
 }  // namespace hal
@@ -28,6 +28,16 @@ class PDPData {
       current[kNumPDPChannels];
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(temperature);
+    func(voltage);
+    for (auto& channelCurrent : current) {
+      func(channelCurrent);
+    }
+  }
 };
 extern PDPData* SimPDPData;
 }  // namespace hal
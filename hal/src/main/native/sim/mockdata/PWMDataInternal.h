@@ -26,6 +26,16 @@ class PWMData {
   SimDataValue<HAL_Bool, HAL_MakeBoolean, GetZeroLatchName> zeroLatch{false};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+    func(rawValue);
+    func(speed);
+    func(position);
+    func(periodScale);
+    func(zeroLatch);
+  }
 };
 extern PWMData* SimPWMData;
 }  // namespace hal
@@ -23,6 +23,14 @@ class RelayData {
   SimDataValue<HAL_Bool, HAL_MakeBoolean, GetReverseName> reverse{false};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initializedForward);
+    func(initializedReverse);
+    func(forward);
+    func(reverse);
+  }
 };
 extern RelayData* SimRelayData;
 }  // namespace hal
@@ -48,6 +48,25 @@ class RoboRioData {
   SimDataValue<int32_t, HAL_MakeInt, GetUserFaults3V3Name> userFaults3V3{0};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(fpgaButton);
+    func(vInVoltage);
+    func(vInCurrent);
+    func(userVoltage6V);
+    func(userCurrent6V);
+    func(userActive6V);
+    func(userVoltage5V);
+    func(userCurrent5V);
+    func(userActive5V);
+    func(userVoltage3V3);
+    func(userCurrent3V3);
+    func(userActive3V3);
+    func(userFaults6V);
+    func(userFaults5V);
+    func(userFaults3V3);
+  }
 };
 extern RoboRioData* SimRoboRioData;
 }  // namespace hal
@@ -23,6 +23,15 @@ class SPIAccelerometerData {
   SimDataValue<double, HAL_MakeDouble, GetZName> z{0.0};
 
   virtual void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(active);
+    func(range);
+    func(x);
+    func(y);
+    func(z);
+  }
 };
 extern SPIAccelerometerData* SimSPIAccelerometerData;
 }  // namespace hal
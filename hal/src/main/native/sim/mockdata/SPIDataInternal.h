@@ -32,6 +32,11 @@ class SPIData {
       autoReceivedData;
 
   void ResetData();
+
+  template <typename F>
+  void ForEachValue(F&& func) {
+    func(initialized);
+  }
 };
 extern SPIData* SimSPIData;
 }  // namespace hal
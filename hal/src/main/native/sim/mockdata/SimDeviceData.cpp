@@ -6,6 +6,7 @@
 
 #include <algorithm>
 
+#include <wpi/SmallVector.h>
 #include <wpi/StringExtras.h>
 
 #include "SimDeviceDataInternal.h"
@@ -54,8 +55,28 @@ SimDeviceData::Value* SimDeviceData::LookupValue(HAL_SimValueHandle handle) {
   return deviceImpl->values[handle].get();
 }
 
+bool SimDeviceData::IsDeviceEnabledImpl(const char* name) {
+  auto [it, inserted] = m_enabledCache.try_emplace(name, true);
+  if (inserted) {
+    for (const auto& elem : m_prefixEnabled) {
+      if (wpi::starts_with(name, elem.first)) {
+        it->second = elem.second;
+        break;
+      }
+    }
+  }
+  return it->second;
+}
+
+void SimDeviceData::NotifyValuesChanged(HAL_SimDeviceHandle handle) {
+  if (Device* deviceImpl = LookupDevice(handle)) {
+    deviceImpl->valuesChanged(deviceImpl->name.c_str(), handle);
+  }
+}
+
 void SimDeviceData::SetDeviceEnabled(const char* prefix, bool enabled) {
   std::scoped_lock lock(m_mutex);
+  m_enabledCache.clear();
   auto it =
       std::find_if(m_prefixEnabled.begin(), m_prefixEnabled.end(),
                    [=](const auto& elem) { return elem.first == prefix; });
@@ -72,25 +93,15 @@ void SimDeviceData::SetDeviceEnabled(const char* prefix, bool enabled) {
 
 bool SimDeviceData::IsDeviceEnabled(const char* name) {
   std::scoped_lock lock(m_mutex);
-  for (const auto& elem : m_prefixEnabled) {
-    if (wpi::starts_with(name, elem.first)) {
-      return elem.second;
-    }
-  }
-  return true;
+  return IsDeviceEnabledImpl(name);
 }
 
 HAL_SimDeviceHandle SimDeviceData::CreateDevice(const char* name) {
   std::scoped_lock lock(m_mutex);
 
   // don't create if disabled
-  for (const auto& elem : m_prefixEnabled) {
-    if (wpi::starts_with(name, elem.first)) {
-      if (elem.second) {
-        break;  // enabled
-      }
-      return 0;  // disabled
-    }
+  if (!IsDeviceEnabledImpl(name)) {
+    return 0;
   }
 
   // check for duplicates and don't overwrite them
@@ -220,6 +231,33 @@ void SimDeviceData::SetValue(HAL_SimValueHandle handle,
   // notify callbacks
   valueImpl->changed(valueImpl->name.c_str(), valueImpl->handle,
                      valueImpl->direction, &value);
+  NotifyValuesChanged(handle >> 16);
+}
+
+void SimDeviceData::SetValues(const HAL_SimValueHandle* handles,
+                              const HAL_Value* values, int32_t count) {
+  std::scoped_lock lock(m_mutex);
+  // devices to notify, in the order their values were first set
+  wpi::SmallVector<HAL_SimDeviceHandle, 8> devices;
+  for (int32_t i = 0; i < count; ++i) {
+    Value* valueImpl = LookupValue(handles[i]);
+    if (!valueImpl) {
+      continue;
+    }
+
+    valueImpl->value = values[i];
+
+    // notify callbacks
+    valueImpl->changed(valueImpl->name.c_str(), valueImpl->handle,
+                       valueImpl->direction, &values[i]);
+    HAL_SimDeviceHandle device = handles[i] >> 16;
+    if (std::find(devices.begin(), devices.end(), device) == devices.end()) {
+      devices.emplace_back(device);
+    }
+  }
+  for (auto device : devices) {
+    NotifyValuesChanged(device);
+  }
 }
 
 void SimDeviceData::ResetValue(HAL_SimValueHandle handle) {
@@ -261,6 +299,7 @@ void SimDeviceData::ResetValue(HAL_SimValueHandle handle) {
   // notify changed callbacks
   valueImpl->changed(valueImpl->name.c_str(), valueImpl->handle,
                      valueImpl->direction, &valueImpl->value);
+  NotifyValuesChanged(handle >> 16);
 }
 
 int32_t SimDeviceData::RegisterDeviceCreatedCallback(
@@ -376,6 +415,39 @@ void SimDeviceData::CancelValueCreatedCallback(int32_t uid) {
   deviceImpl->valueCreated.Cancel(uid & 0xffff);
 }
 
+int32_t SimDeviceData::RegisterDeviceValuesChangedCallback(
+    HAL_SimDeviceHandle device, void* param, HALSIM_SimDeviceCallback callback,
+    bool initialNotify) {
+  std::scoped_lock lock(m_mutex);
+  Device* deviceImpl = LookupDevice(device);
+  if (!deviceImpl) {
+    return -1;
+  }
+
+  // register callback
+  int32_t index = deviceImpl->valuesChanged.Register(callback, param);
+
+  // initial notification
+  if (initialNotify) {
+    callback(deviceImpl->name.c_str(), param, device);
+  }
+
+  // encode device into uid
+  return (device << 16) | (index & 0xffff);
+}
+
+void SimDeviceData::CancelDeviceValuesChangedCallback(int32_t uid) {
+  if (uid <= 0) {
+    return;
+  }
+  std::scoped_lock lock(m_mutex);
+  Device* deviceImpl = LookupDevice(uid >> 16);
+  if (!deviceImpl) {
+    return;
+  }
+  deviceImpl->valuesChanged.Cancel(uid & 0xffff);
+}
+
 int32_t SimDeviceData::RegisterValueChangedCallback(
     HAL_SimValueHandle handle, void* param, HALSIM_SimValueCallback callback,
     bool initialNotify) {
@@ -510,6 +582,7 @@ void SimDeviceData::ResetData() {
   m_devices.clear();
   m_deviceMap.clear();
   m_prefixEnabled.clear();
+  m_enabledCache.clear();
   m_deviceCreated.Reset();
   m_deviceFreed.Reset();
 }
@@ -577,6 +650,17 @@ void HALSIM_CancelSimValueCreatedCallback(int32_t uid) {
   SimSimDeviceData->CancelValueCreatedCallback(uid);
 }
 
+int32_t HALSIM_RegisterSimDeviceValuesChangedCallback(
+    HAL_SimDeviceHandle device, void* param, HALSIM_SimDeviceCallback callback,
+    HAL_Bool initialNotify) {
+  return SimSimDeviceData->RegisterDeviceValuesChangedCallback(
+      device, param, callback, initialNotify);
+}
+
+void HALSIM_CancelSimDeviceValuesChangedCallback(int32_t uid) {
+  SimSimDeviceData->CancelDeviceValuesChangedCallback(uid);
+}
+
 int32_t HALSIM_RegisterSimValueChangedCallback(HAL_SimValueHandle handle,
                                                void* param,
                                                HALSIM_SimValueCallback callback,
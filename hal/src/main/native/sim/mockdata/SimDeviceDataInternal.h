@@ -162,11 +162,14 @@ class SimDeviceData {
     wpi::UidVector<std::unique_ptr<Value>, 16> values;
     wpi::StringMap<Value*> valueMap;
     impl::SimUnnamedCallbackRegistry<HALSIM_SimValueCallback> valueCreated;
+    impl::SimUnnamedCallbackRegistry<HALSIM_SimDeviceCallback> valuesChanged;
   };
 
   wpi::UidVector<std::shared_ptr<Device>, 4> m_devices;
   wpi::StringMap<std::weak_ptr<Device>> m_deviceMap;
   std::vector<std::pair<std::string, bool>> m_prefixEnabled;
+  // IsDeviceEnabled() results by name; cleared when m_prefixEnabled changes
+  wpi::StringMap<bool> m_enabledCache;
 
   wpi::recursive_spinlock m_mutex;
 
@@ -176,6 +179,9 @@ class SimDeviceData {
   // call with lock held, returns null if does not exist
   Device* LookupDevice(HAL_SimDeviceHandle handle);
   Value* LookupValue(HAL_SimValueHandle handle);
+  // call with lock held
+  bool IsDeviceEnabledImpl(const char* name);
+  void NotifyValuesChanged(HAL_SimDeviceHandle handle);
 
  public:
   void SetDeviceEnabled(const char* prefix, bool enabled);
@@ -191,6 +197,8 @@ class SimDeviceData {
   HAL_Value GetValue(HAL_SimValueHandle handle);
   void SetValue(HAL_SimValueHandle handle, const HAL_Value& value);
   void ResetValue(HAL_SimValueHandle handle);
+  void SetValues(const HAL_SimValueHandle* handles, const HAL_Value* values,
+                 int32_t count);
 
   int32_t RegisterDeviceCreatedCallback(const char* prefix, void* param,
                                         HALSIM_SimDeviceCallback callback,
@@ -215,6 +223,13 @@ class SimDeviceData {
 
   void CancelValueCreatedCallback(int32_t uid);
 
+  int32_t RegisterDeviceValuesChangedCallback(HAL_SimDeviceHandle device,
+                                              void* param,
+                                              HALSIM_SimDeviceCallback callback,
+                                              bool initialNotify);
+
+  void CancelDeviceValuesChangedCallback(int32_t uid);
+
   int32_t RegisterValueChangedCallback(HAL_SimValueHandle handle, void* param,
                                        HALSIM_SimValueCallback callback,
                                        bool initialNotify);
@@ -0,0 +1,366 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../PortsInternal.h"
+#include "AccelerometerDataInternal.h"
+#include "AddressableLEDDataInternal.h"
+#include "AnalogGyroDataInternal.h"
+#include "AnalogInDataInternal.h"
+#include "AnalogOutDataInternal.h"
+#include "AnalogTriggerDataInternal.h"
+#include "CTREPCMDataInternal.h"
+#include "DIODataInternal.h"
+#include "DigitalPWMDataInternal.h"
+#include "DriverStationDataInternal.h"
+#include "DutyCycleDataInternal.h"
+#include "EncoderDataInternal.h"
+#include "I2CDataInternal.h"
+#include "PDPDataInternal.h"
+#include "PWMDataInternal.h"
+#include "RelayDataInternal.h"
+#include "RoboRioDataInternal.h"
+#include "SPIAccelerometerDataInternal.h"
+#include "SPIDataInternal.h"
+#include "SimDeviceDataInternal.h"
+#include "hal/simulation/SimState.h"
+
+using namespace hal;
+
+namespace {
+// "HSIM"
+constexpr uint32_t kMagic = 0x4d495348;
+constexpr uint32_t kVersion = 1;
+
+class StateWriter {
+ public:
+  StateWriter(void* buffer, int32_t size)
+      : m_buffer{static_cast<uint8_t*>(buffer)},
+        m_size{buffer ? static_cast<size_t>((std::max)(size, 0)) : 0} {}
+
+  // Writes past the end of the buffer are only counted
+  void Write(const void* data, size_t len) {
+    if (m_pos + len <= m_size) {
+      std::memcpy(m_buffer + m_pos, data, len);
+    }
+    m_pos += len;
+  }
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    Write(&value, sizeof(T));
+  }
+
+  void WriteString(std::string_view str) {
+    Write(static_cast<uint32_t>(str.size()));
+    Write(str.data(), str.size());
+  }
+
+  // Returns the position of the space to fill in later with WriteAt()
+  size_t Reserve(size_t len) {
+    size_t pos = m_pos;
+    m_pos += len;
+    return pos;
+  }
+
+  template <typename T>
+  void WriteAt(size_t pos, const T& value) {
+    if (pos + sizeof(T) <= m_size) {
+      std::memcpy(m_buffer + pos, &value, sizeof(T));
+    }
+  }
+
+  size_t GetPosition() const { return m_pos; }
+
+ private:
+  uint8_t* m_buffer;
+  size_t m_size;
+  size_t m_pos = 0;
+};
+
+class StateReader {
+ public:
+  StateReader(const void* buffer, int32_t size)
+      : m_buffer{static_cast<const uint8_t*>(buffer)},
+        m_size{buffer ? static_cast<size_t>((std::max)(size, 0)) : 0} {}
+
+  bool Read(void* data, size_t len) {
+    if (len > m_size - m_pos) {
+      return false;
+    }
+    std::memcpy(data, m_buffer + m_pos, len);
+    m_pos += len;
+    return true;
+  }
+
+  template <typename T>
+  bool Read(T* value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return Read(value, sizeof(T));
+  }
+
+  bool ReadString(std::string* str) {
+    uint32_t len;
+    if (!Read(&len) || len > m_size - m_pos) {
+      return false;
+    }
+    str->assign(reinterpret_cast<const char*>(m_buffer + m_pos), len);
+    m_pos += len;
+    return true;
+  }
+
+  size_t GetPosition() const { return m_pos; }
+  bool AtEnd() const { return m_pos == m_size; }
+
+ private:
+  const uint8_t* m_buffer;
+  size_t m_size;
+  size_t m_pos = 0;
+};
+
+template <typename Data, typename F>
+void ForEachValue(Data* data, int32_t count, F& func) {
+  for (int32_t i = 0; i < count; ++i) {
+    data[i].ForEachValue(func);
+  }
+}
+
+// Every SimDataValue of every device; these make up the fixed size part of a
+// snapshot. The counts match the data arrays in the matching *Data.cpp files.
+template <typename F>
+void ForEachSimDataValue(F&& func) {
+  ForEachValue(SimAccelerometerData, 1, func);
+  ForEachValue(SimAddressableLEDData, kNumAddressableLEDs, func);
+  ForEachValue(SimAnalogGyroData, kNumAccumulators, func);
+  ForEachValue(SimAnalogInData, kNumAnalogInputs, func);
+  ForEachValue(SimAnalogOutData, kNumAnalogOutputs, func);
+  ForEachValue(SimAnalogTriggerData, kNumAnalogTriggers, func);
+  ForEachValue(SimCTREPCMData, kNumCTREPCMModules, func);
+  ForEachValue(SimDIOData, kNumDigitalChannels, func);
+  ForEachValue(SimDigitalPWMData, kNumDigitalPWMOutputs, func);
+  ForEachValue(SimDriverStationData, 1, func);
+  ForEachValue(SimDutyCycleData, kNumDutyCycles, func);
+  ForEachValue(SimEncoderData, kNumEncoders, func);
+  ForEachValue(SimI2CData, 2, func);
+  ForEachValue(SimPDPData, kNumPDPModules, func);
+  ForEachValue(SimPWMData, kNumPWMChannels, func);
+  ForEachValue(SimRelayData, kNumRelayHeaders, func);
+  ForEachValue(SimRoboRioData, 1, func);
+  ForEachValue(SimSPIAccelerometerData, 5, func);
+  ForEachValue(SimSPIData, 5, func);
+}
+
+struct JoystickState {
+  HAL_JoystickAxes axes;
+  HAL_JoystickPOVs povs;
+  HAL_JoystickButtons buttons;
+  HAL_JoystickDescriptor descriptor;
+  int64_t outputs;
+  int32_t leftRumble;
+  int32_t rightRumble;
+};
+
+void SaveFixedState(StateWriter& writer) {
+  ForEachSimDataValue([&](auto& value) { writer.Write(value.Get()); });
+
+  for (int32_t i = 0; i < HAL_kMaxJoysticks; ++i) {
+    JoystickState joystick;
+    std::memset(&joystick, 0, sizeof(joystick));
+    SimDriverStationData->GetJoystickAxes(i, &joystick.axes);
+    SimDriverStationData->GetJoystickPOVs(i, &joystick.povs);
+    SimDriverStationData->GetJoystickButtons(i, &joystick.buttons);
+    SimDriverStationData->GetJoystickDescriptor(i, &joystick.descriptor);
+    SimDriverStationData->GetJoystickOutputs(
+        i, &joystick.outputs, &joystick.leftRumble, &joystick.rightRumble);
+    writer.Write(joystick);
+  }
+
+  HAL_MatchInfo matchInfo;
+  std::memset(&matchInfo, 0, sizeof(matchInfo));
+  SimDriverStationData->GetMatchInfo(&matchInfo);
+  writer.Write(matchInfo);
+}
+
+bool RestoreFixedState(StateReader& reader, bool apply) {
+  bool ok = true;
+  ForEachSimDataValue([&](auto& value) {
+    decltype(value.Get()) newValue;
+    if (ok && reader.Read(&newValue)) {
+      if (apply) {
+        value.Set(newValue);
+      }
+    } else {
+      ok = false;
+    }
+  });
+  if (!ok) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < HAL_kMaxJoysticks; ++i) {
+    JoystickState joystick;
+    if (!reader.Read(&joystick)) {
+      return false;
+    }
+    if (apply) {
+      SimDriverStationData->SetJoystickAxes(i, &joystick.axes);
+      SimDriverStationData->SetJoystickPOVs(i, &joystick.povs);
+      SimDriverStationData->SetJoystickButtons(i, &joystick.buttons);
+      SimDriverStationData->SetJoystickDescriptor(i, &joystick.descriptor);
+      SimDriverStationData->SetJoystickOutputs(
+          i, joystick.outputs, joystick.leftRumble, joystick.rightRumble);
+    }
+  }
+
+  HAL_MatchInfo matchInfo;
+  if (!reader.Read(&matchInfo)) {
+    return false;
+  }
+  if (apply) {
+    SimDriverStationData->SetMatchInfo(&matchInfo);
+  }
+  return true;
+}
+
+void SaveAddressableLEDState(StateWriter& writer) {
+  std::vector<HAL_AddressableLEDData> data(HAL_kAddressableLEDMaxLength);
+  for (int32_t i = 0; i < kNumAddressableLEDs; ++i) {
+    int32_t len = SimAddressableLEDData[i].GetData(data.data());
+    writer.Write(len);
+    writer.Write(data.data(), len * sizeof(data[0]));
+  }
+}
+
+bool RestoreAddressableLEDState(StateReader& reader, bool apply) {
+  std::vector<HAL_AddressableLEDData> data(HAL_kAddressableLEDMaxLength);
+  for (int32_t i = 0; i < kNumAddressableLEDs; ++i) {
+    int32_t len;
+    if (!reader.Read(&len) || len < 0 || len > HAL_kAddressableLEDMaxLength ||
+        !reader.Read(data.data(), len * sizeof(data[0]))) {
+      return false;
+    }
+    if (apply) {
+      SimAddressableLEDData[i].SetData(data.data(), len);
+    }
+  }
+  return true;
+}
+
+void SaveSimDeviceState(StateWriter& writer) {
+  size_t numDevicesPos = writer.Reserve(sizeof(uint32_t));
+  struct DeviceContext {
+    StateWriter* writer;
+    uint32_t numDevices = 0;
+    uint32_t numValues = 0;
+  } ctx{&writer};
+
+  SimSimDeviceData->EnumerateDevices(
+      "", &ctx,
+      [](const char* name, void* param, HAL_SimDeviceHandle handle) {
+        auto& ctx = *static_cast<DeviceContext*>(param);
+        ++ctx.numDevices;
+        ctx.writer->WriteString(name);
+        size_t numValuesPos = ctx.writer->Reserve(sizeof(uint32_t));
+        ctx.numValues = 0;
+        SimSimDeviceData->EnumerateValues(
+            handle, param,
+            [](const char* name, void* param, HAL_SimValueHandle handle,
+               int32_t direction, const HAL_Value* value) {
+              auto& ctx = *static_cast<DeviceContext*>(param);
+              ++ctx.numValues;
+              ctx.writer->WriteString(name);
+              ctx.writer->Write(*value);
+            });
+        ctx.writer->WriteAt(numValuesPos, ctx.numValues);
+      });
+
+  writer.WriteAt(numDevicesPos, ctx.numDevices);
+}
+
+bool RestoreSimDeviceState(StateReader& reader, bool apply) {
+  uint32_t numDevices;
+  if (!reader.Read(&numDevices)) {
+    return false;
+  }
+  std::string deviceName;
+  std::string valueName;
+  for (uint32_t i = 0; i < numDevices; ++i) {
+    uint32_t numValues;
+    if (!reader.ReadString(&deviceName) || !reader.Read(&numValues)) {
+      return false;
+    }
+    HAL_SimDeviceHandle device =
+        apply ? SimSimDeviceData->GetDeviceHandle(deviceName.c_str()) : 0;
+    for (uint32_t j = 0; j < numValues; ++j) {
+      HAL_Value value;
+      if (!reader.ReadString(&valueName) || !reader.Read(&value)) {
+        return false;
+      }
+      if (device == 0) {
+        continue;
+      }
+      HAL_SimValueHandle handle =
+          SimSimDeviceData->GetValueHandle(device, valueName.c_str());
+      // Skip values that were recreated with a different type
+      if (handle != 0 && SimSimDeviceData->GetValue(handle).type == value.type) {
+        SimSimDeviceData->SetValue(handle, value);
+      }
+    }
+  }
+  return true;
+}
+
+bool RestoreSimState(StateReader& reader, bool apply) {
+  uint32_t magic, version, fixedSize;
+  if (!reader.Read(&magic) || magic != kMagic || !reader.Read(&version) ||
+      version != kVersion || !reader.Read(&fixedSize)) {
+    return false;
+  }
+  // A snapshot from a different build has a different set of values
+  size_t fixedStart = reader.GetPosition();
+  if (!RestoreFixedState(reader, apply) ||
+      reader.GetPosition() - fixedStart != fixedSize) {
+    return false;
+  }
+  return RestoreAddressableLEDState(reader, apply) &&
+         RestoreSimDeviceState(reader, apply) && reader.AtEnd();
+}
+}  // namespace
+
+extern "C" {
+
+int32_t HALSIM_SaveSimState(void* buffer, int32_t size) {
+  StateWriter writer{buffer, size};
+  writer.Write(kMagic);
+  writer.Write(kVersion);
+  size_t fixedSizePos = writer.Reserve(sizeof(uint32_t));
+  size_t fixedStart = writer.GetPosition();
+  SaveFixedState(writer);
+  writer.WriteAt(fixedSizePos,
+                 static_cast<uint32_t>(writer.GetPosition() - fixedStart));
+  SaveAddressableLEDState(writer);
+  SaveSimDeviceState(writer);
+  return static_cast<int32_t>(writer.GetPosition());
+}
+
+HAL_Bool HALSIM_RestoreSimState(const void* buffer, int32_t size) {
+  // Validate the whole snapshot before changing anything
+  StateReader validator{buffer, size};
+  if (!RestoreSimState(validator, false)) {
+    return false;
+  }
+  StateReader reader{buffer, size};
+  RestoreSimState(reader, true);
+  SimDriverStationData->NotifyNewData();
+  return true;
+}
+
+}  // extern "C"
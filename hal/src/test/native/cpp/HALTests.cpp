@@ -9,4 +9,14 @@ namespace hal {
 TEST(HALTests, RuntimeType) {
   EXPECT_EQ(HAL_RuntimeType::HAL_Mock, HAL_GetRuntimeType());
 }
+
+TEST(HALTests, FPGATimeFast) {
+  int32_t status = 0;
+  uint64_t before = HAL_GetFPGATime(&status);
+  uint64_t fast = HAL_GetFPGATimeFast(&status);
+  uint64_t after = HAL_GetFPGATime(&status);
+  EXPECT_EQ(0, status);
+  EXPECT_LE(before, fast);
+  EXPECT_LE(fast, after);
+}
 }  // namespace hal
@@ -0,0 +1,74 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "hal/DIO.h"
+#include "hal/HAL.h"
+#include "hal/Interrupts.h"
+#include "hal/simulation/DIOData.h"
+
+namespace hal {
+
+TEST(InterruptGroupTests, EdgesFromSeveralSources) {
+  int32_t status = 0;
+  HAL_DigitalHandle dio[2];
+  HAL_InterruptHandle interrupts[2];
+  for (int i = 0; i < 2; ++i) {
+    dio[i] = HAL_InitializeDIOPort(HAL_GetPort(4 + i), true, nullptr, &status);
+    ASSERT_EQ(0, status);
+    interrupts[i] = HAL_InitializeInterrupts(&status);
+    ASSERT_EQ(0, status);
+    HAL_RequestInterrupts(interrupts[i], dio[i], HAL_Trigger_kInWindow,
+                          &status);
+    ASSERT_EQ(0, status);
+    HALSIM_SetDIOValue(4 + i, false);
+  }
+  HAL_SetInterruptUpSourceEdge(interrupts[0], true, false, &status);
+  HAL_SetInterruptUpSourceEdge(interrupts[1], true, true, &status);
+  ASSERT_EQ(0, status);
+
+  HAL_InterruptGroupHandle group =
+      HAL_InitializeInterruptGroup(interrupts, 2, 2, &status);
+  ASSERT_EQ(0, status);
+  ASSERT_NE(HAL_kInvalidHandle, group);
+
+  HAL_InterruptEvent events[4];
+  EXPECT_EQ(0, HAL_ReadInterruptGroupEvents(group, events, 4, 0, &status));
+
+  HALSIM_SetDIOValue(4, true);
+  HALSIM_SetDIOValue(4, false);  // falling edges not enabled on 4
+  HALSIM_SetDIOValue(5, true);
+  HALSIM_SetDIOValue(5, false);  // dropped, queue is full
+
+  ASSERT_EQ(2, HAL_ReadInterruptGroupEvents(group, events, 4, 1, &status));
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(interrupts[0], events[0].interrupt);
+  EXPECT_TRUE(events[0].rising);
+  EXPECT_EQ(interrupts[1], events[1].interrupt);
+  EXPECT_TRUE(events[1].rising);
+  EXPECT_LE(events[0].timestamp, events[1].timestamp);
+  EXPECT_EQ(1, HAL_GetInterruptGroupDroppedCount(group, &status));
+
+  // A release wakes a waiting read
+  std::thread releaser([&] {
+    int32_t status = 0;
+    HAL_ReleaseWaitingInterruptGroup(group, &status);
+  });
+  EXPECT_EQ(0, HAL_ReadInterruptGroupEvents(group, events, 4, 10, &status));
+  releaser.join();
+
+  HAL_CleanInterruptGroup(group);
+  for (int i = 0; i < 2; ++i) {
+    HAL_CleanInterrupts(interrupts[i]);
+    HAL_FreeDIOPort(dio[i]);
+  }
+  // Edges after the group is freed go nowhere
+  HALSIM_SetDIOValue(4, true);
+  EXPECT_EQ(0, HAL_ReadInterruptGroupEvents(group, events, 4, 0, &status));
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+}
+
+}  // namespace hal
@@ -0,0 +1,70 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "hal/HAL.h"
+#include "hal/PDP.h"
+#include "hal/Power.h"
+#include "hal/simulation/PDPData.h"
+#include "hal/simulation/RoboRioData.h"
+
+namespace hal {
+
+TEST(PowerStatusSamplerTests, Snapshot) {
+  int32_t status = 0;
+  HAL_PDPHandle pdp = HAL_InitializePDP(0, &status);
+  ASSERT_EQ(0, status);
+  HALSIM_SetRoboRioVInVoltage(11.5);
+  HALSIM_SetPDPVoltage(0, 12.25);
+  HALSIM_SetPDPCurrent(0, 5, 20);
+
+  // Without the sampler, a snapshot is read on demand
+  HAL_PowerStatus powerStatus;
+  HAL_GetPowerStatus(&powerStatus, &status);
+  ASSERT_EQ(0, status);
+  EXPECT_EQ(11.5, powerStatus.vinVoltage);
+  EXPECT_EQ(HAL_kInvalidHandle, powerStatus.pdpHandle);
+  EXPECT_FALSE(powerStatus.pdpValid);
+
+  HAL_StartPowerStatusSampler(pdp, 0.005, &status);
+  ASSERT_EQ(0, status);
+  HAL_StartPowerStatusSampler(pdp, 0.005, &status);
+  EXPECT_EQ(RESOURCE_IS_ALLOCATED, status);
+  status = 0;
+
+  for (int i = 0; i < 200; ++i) {
+    HAL_GetPowerStatus(&powerStatus, &status);
+    if (powerStatus.pdpValid) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ASSERT_TRUE(powerStatus.pdpValid);
+  EXPECT_EQ(pdp, powerStatus.pdpHandle);
+  EXPECT_EQ(11.5, powerStatus.vinVoltage);
+  EXPECT_EQ(12.25, powerStatus.pdpVoltage);
+  EXPECT_EQ(20, powerStatus.pdpChannelCurrents[5]);
+  EXPECT_GT(powerStatus.timestamp, 0u);
+
+  // New values show up in a later snapshot
+  HALSIM_SetRoboRioVInVoltage(10);
+  for (int i = 0; i < 200; ++i) {
+    HAL_GetPowerStatus(&powerStatus, &status);
+    if (powerStatus.vinVoltage == 10) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(10, powerStatus.vinVoltage);
+
+  HAL_StopPowerStatusSampler();
+  HAL_CleanPDP(pdp);
+  HALSIM_ResetRoboRioData();
+  HALSIM_ResetPDPData(0);
+}
+
+}  // namespace hal
@@ -2,6 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "hal/CANAPI.h"
 #include "hal/HAL.h"
@@ -77,4 +80,41 @@ TEST(HALCanTests, CanIdPackingTest) {
   ASSERT_EQ(static_cast<int32_t>(HAL_CANDeviceType::HAL_CAN_Dev_kMiscellaneous),
             (storePair.first & 0x1F000000) >> 24);
 }
+
+TEST(HALCanTests, WritePacketBatch) {
+  int32_t status = 0;
+  CANTestStore first(3, &status);
+  ASSERT_EQ(0, status);
+  CANTestStore second(4, &status);
+  ASSERT_EQ(0, status);
+
+  std::vector<std::pair<uint32_t, uint8_t>> sent;
+  auto cbHandle = HALSIM_RegisterCanSendMessageCallback(
+      [](const char* name, void* param, uint32_t messageID, const uint8_t* data,
+         uint8_t dataSize, int32_t periodMs, int32_t* status) {
+        reinterpret_cast<std::vector<std::pair<uint32_t, uint8_t>>*>(param)
+            ->emplace_back(messageID, data[0]);
+      },
+      &sent);
+  CANSendCallbackStore cbStore(cbHandle);
+
+  HAL_CANPacket packets[] = {{first.handle, 1, {10}, 8},
+                             {first.handle, 2, {11}, 8},
+                             {HAL_kInvalidHandle, 3, {12}, 8},
+                             {second.handle, 1, {13}, 8}};
+  HAL_WriteCANPacketBatch(packets, 4, &status);
+
+  // The packet with the invalid handle is skipped, but the rest are sent
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+  ASSERT_EQ(3u, sent.size());
+  EXPECT_EQ(3u, sent[0].first & 0x3F);
+  EXPECT_EQ(1u, (sent[0].first & 0x0000FFC0) >> 6);
+  EXPECT_EQ(10, sent[0].second);
+  EXPECT_EQ(3u, sent[1].first & 0x3F);
+  EXPECT_EQ(2u, (sent[1].first & 0x0000FFC0) >> 6);
+  EXPECT_EQ(11, sent[1].second);
+  EXPECT_EQ(4u, sent[2].first & 0x3F);
+  EXPECT_EQ(1u, (sent[2].first & 0x0000FFC0) >> 6);
+  EXPECT_EQ(13, sent[2].second);
+}
 }  // namespace hal
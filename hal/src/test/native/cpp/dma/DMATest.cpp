@@ -0,0 +1,91 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "gtest/gtest.h"
+#include "hal/AnalogInput.h"
+#include "hal/DIO.h"
+#include "hal/DMA.h"
+#include "hal/HAL.h"
+#include "hal/simulation/AnalogInData.h"
+#include "hal/simulation/DIOData.h"
+#include "hal/simulation/MockHooks.h"
+
+namespace hal {
+TEST(HALDMATests, TimedTriggerSamplesWhenStepping) {
+  HALSIM_PauseTiming();
+
+  int32_t status = 0;
+  HAL_DigitalHandle dio =
+      HAL_InitializeDIOPort(HAL_GetPort(0), true, nullptr, &status);
+  ASSERT_EQ(0, status);
+  HAL_AnalogInputHandle analog =
+      HAL_InitializeAnalogInputPort(HAL_GetPort(0), nullptr, &status);
+  ASSERT_EQ(0, status);
+  HAL_DMAHandle dma = HAL_InitializeDMA(&status);
+  ASSERT_EQ(0, status);
+
+  HAL_AddDMADigitalSource(dma, dio, &status);
+  HAL_AddDMAAnalogInput(dma, analog, &status);
+  HAL_SetDMATimedTrigger(dma, 0.001, &status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_SetDIOValue(0, true);
+  HALSIM_SetAnalogInVoltage(0, 2.5);
+  int32_t expectedRaw = HAL_GetAnalogValue(analog, &status);
+
+  uint64_t startTime = HAL_GetFPGATime(&status);
+  HAL_StartDMA(dma, 4, &status);
+  ASSERT_EQ(0, status);
+
+  // No trigger has fired yet
+  HAL_DMASample sample;
+  int32_t remaining = 0;
+  EXPECT_EQ(HAL_DMA_TIMEOUT, HAL_ReadDMA(dma, &sample, 0, &remaining, &status));
+
+  HALSIM_StepTiming(3000);
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_EQ(HAL_DMA_OK, HAL_ReadDMA(dma, &sample, 0, &remaining, &status));
+    EXPECT_EQ(3 - i, remaining);
+    EXPECT_EQ(startTime + i * 1000u, HAL_GetDMASampleTime(&sample, &status));
+    EXPECT_TRUE(HAL_GetDMASampleDigitalSource(&sample, dio, &status));
+    EXPECT_EQ(expectedRaw,
+              HAL_GetDMASampleAnalogInputRaw(&sample, analog, &status));
+  }
+  EXPECT_EQ(0, status);
+
+  // Sensors that weren't added aren't in the sample
+  HAL_GetDMASampleAveragedAnalogInputRaw(&sample, analog, &status);
+  EXPECT_NE(0, status);
+  status = 0;
+
+  // The queue keeps the newest samples
+  HALSIM_SetDIOValue(0, false);
+  HALSIM_StepTiming(6000);
+  ASSERT_EQ(HAL_DMA_OK, HAL_ReadDMA(dma, &sample, 0, &remaining, &status));
+  EXPECT_EQ(3, remaining);
+  EXPECT_EQ(startTime + 6000u, HAL_GetDMASampleTime(&sample, &status));
+  EXPECT_FALSE(HAL_GetDMASampleDigitalSource(&sample, dio, &status));
+  for (int i = 0; i < 3; ++i) {
+    HAL_ReadDMA(dma, &sample, 0, &remaining, &status);
+  }
+
+  // Triggers while paused aren't sampled
+  HAL_SetDMAPause(dma, true, &status);
+  HALSIM_StepTiming(2000);
+  EXPECT_EQ(HAL_DMA_TIMEOUT, HAL_ReadDMA(dma, &sample, 0, &remaining, &status));
+  HAL_SetDMAPause(dma, false, &status);
+  HALSIM_StepTiming(1000);
+  ASSERT_EQ(HAL_DMA_OK, HAL_ReadDMA(dma, &sample, 0, &remaining, &status));
+  EXPECT_EQ(startTime + 12000u, HAL_GetDMASampleTime(&sample, &status));
+  EXPECT_EQ(0, status);
+
+  HAL_StopDMA(dma, &status);
+  EXPECT_EQ(HAL_DMA_ERROR, HAL_ReadDMA(dma, &sample, 0, &remaining, &status));
+
+  HAL_FreeDMA(dma);
+  HAL_FreeAnalogInputPort(analog);
+  HAL_FreeDIOPort(dio);
+  HALSIM_ResumeTiming();
+}
+}  // namespace hal
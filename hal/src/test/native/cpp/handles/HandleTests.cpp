@@ -2,14 +2,26 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "hal/HAL.h"
 #include "hal/handles/IndexedClassedHandleResource.h"
+#include "hal/handles/LimitedHandleResource.h"
+#include "hal/handles/UnlimitedHandleResource.h"
 
 #define HAL_TestHandle HAL_Handle
 
 namespace {
 class MyTestClass {};
+
+struct MyTestStruct {
+  int value = 0;
+};
 }  // namespace
 
 namespace hal {
@@ -22,4 +34,79 @@ TEST(HandleTests, ClassedHandleTest) {
   EXPECT_EQ(0, status);
 }
 
+
+TEST(HandleTests, BorrowTest) {
+  hal::LimitedHandleResource<HAL_TestHandle, MyTestStruct, 4,
+                             HAL_HandleEnum::Vendor>
+      testResource;
+  auto handle = testResource.Allocate();
+  ASSERT_NE(HAL_kInvalidHandle, handle);
+
+  {
+    auto borrowed = testResource.Borrow(handle);
+    ASSERT_TRUE(borrowed);
+    borrowed->value = 5;
+  }
+  EXPECT_EQ(5, testResource.Get(handle)->value);
+
+  testResource.Free(handle);
+  EXPECT_FALSE(testResource.Borrow(handle));
+  EXPECT_EQ(nullptr, testResource.Get(handle));
+}
+
+TEST(HandleTests, UnlimitedBorrowTest) {
+  hal::UnlimitedHandleResource<HAL_TestHandle, MyTestStruct,
+                               HAL_HandleEnum::Vendor>
+      testResource;
+
+  // Span several blocks of slots
+  std::vector<HAL_TestHandle> handles;
+  for (int i = 0; i < 600; ++i) {
+    auto structure = std::make_shared<MyTestStruct>();
+    structure->value = i;
+    handles.push_back(testResource.Allocate(structure));
+  }
+  for (int i = 0; i < 600; ++i) {
+    auto borrowed = testResource.Borrow(handles[i]);
+    ASSERT_TRUE(borrowed);
+    EXPECT_EQ(i, borrowed->value);
+  }
+
+  auto freed = testResource.Free(handles[300]);
+  ASSERT_NE(nullptr, freed);
+  EXPECT_EQ(300, freed->value);
+  EXPECT_FALSE(testResource.Borrow(handles[300]));
+
+  // The freed index is reused
+  auto handle = testResource.Allocate(std::make_shared<MyTestStruct>());
+  EXPECT_EQ(handles[300], handle);
+}
+
+TEST(HandleTests, FreeWaitsForBorrow) {
+  hal::UnlimitedHandleResource<HAL_TestHandle, MyTestStruct,
+                               HAL_HandleEnum::Vendor>
+      testResource;
+  auto structure = std::make_shared<MyTestStruct>();
+  std::weak_ptr<MyTestStruct> weak = structure;
+  auto handle = testResource.Allocate(std::move(structure));
+
+  auto borrowed = testResource.Borrow(handle);
+  ASSERT_TRUE(borrowed);
+
+  std::atomic_bool freed{false};
+  std::thread freeThread{[&] {
+    testResource.Free(handle);
+    freed = true;
+  }};
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // Free() can't finish, so the structure is still alive
+  EXPECT_FALSE(freed);
+  borrowed->value = 1;
+
+  borrowed = {};
+  freeThread.join();
+  EXPECT_TRUE(freed);
+  EXPECT_TRUE(weak.expired());
+}
 }  // namespace hal
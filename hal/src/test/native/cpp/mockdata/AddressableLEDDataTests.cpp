@@ -0,0 +1,55 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "gtest/gtest.h"
+#include "hal/AddressableLED.h"
+#include "hal/HAL.h"
+#include "hal/PWM.h"
+#include "hal/simulation/AddressableLEDData.h"
+
+namespace hal {
+
+TEST(AddressableLEDSimTests, TestWriteDataRange) {
+  int32_t status = 0;
+  HAL_DigitalHandle pwm =
+      HAL_InitializePWMPort(HAL_GetPort(2), nullptr, &status);
+  ASSERT_EQ(0, status);
+  HAL_AddressableLEDHandle led = HAL_InitializeAddressableLED(pwm, &status);
+  ASSERT_EQ(0, status);
+  int32_t index = HALSIM_FindAddressableLEDForChannel(2);
+  ASSERT_GE(index, 0);
+  HAL_SetAddressableLEDLength(led, 4, &status);
+  ASSERT_EQ(0, status);
+
+  HAL_AddressableLEDData data[4] = {};
+  for (int i = 0; i < 4; ++i) {
+    data[i].r = i;
+  }
+  HAL_WriteAddressableLEDData(led, data, 4, &status);
+  ASSERT_EQ(0, status);
+
+  HAL_AddressableLEDData changed[2] = {};
+  changed[0].g = 10;
+  changed[1].g = 20;
+  HAL_WriteAddressableLEDDataRange(led, changed, 1, 2, &status);
+  ASSERT_EQ(0, status);
+
+  HAL_AddressableLEDData out[HAL_kAddressableLEDMaxLength];
+  ASSERT_EQ(4, HALSIM_GetAddressableLEDData(index, out));
+  EXPECT_EQ(0, out[0].r);
+  EXPECT_EQ(10, out[1].g);
+  EXPECT_EQ(0, out[1].r);
+  EXPECT_EQ(20, out[2].g);
+  EXPECT_EQ(3, out[3].r);
+
+  // The range must fit in the strip
+  HAL_WriteAddressableLEDDataRange(led, changed, 3, 2, &status);
+  EXPECT_EQ(HAL_USE_LAST_ERROR, status);
+
+  HAL_FreeAddressableLED(led);
+  HAL_FreePWMPort(pwm, &status);
+  HALSIM_ResetAddressableLEDData(index);
+}
+
+}  // namespace hal
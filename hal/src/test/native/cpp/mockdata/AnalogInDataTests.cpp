@@ -2,6 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <atomic>
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "hal/AnalogInput.h"
 #include "hal/HAL.h"
@@ -78,4 +81,56 @@ TEST(AnalogInSimTests, TestAnalogInInitialization) {
   EXPECT_STREQ("Initialized", gTestAnalogInCallbackName.c_str());
   HALSIM_CancelAnalogInInitializedCallback(INDEX_TO_TEST, callbackId);
 }
+
+TEST(AnalogInSimTests, TestAnalogInVoltageCallbackCancelsItself) {
+  const int INDEX_TO_TEST = 2;
+
+  struct Data {
+    int uid = 0;
+    int count = 0;
+  } data;
+  data.uid = HALSIM_RegisterAnalogInVoltageCallback(
+      INDEX_TO_TEST,
+      [](const char* name, void* param, const struct HAL_Value* value) {
+        auto data = static_cast<Data*>(param);
+        ++data->count;
+        HALSIM_CancelAnalogInVoltageCallback(INDEX_TO_TEST, data->uid);
+      },
+      &data, false);
+  ASSERT_TRUE(0 != data.uid);
+
+  HALSIM_SetAnalogInVoltage(INDEX_TO_TEST, 1.0);
+  HALSIM_SetAnalogInVoltage(INDEX_TO_TEST, 2.0);
+  EXPECT_EQ(1, data.count);
+  EXPECT_EQ(2.0, HALSIM_GetAnalogInVoltage(INDEX_TO_TEST));
+  HALSIM_ResetAnalogInData(INDEX_TO_TEST);
+}
+
+TEST(AnalogInSimTests, TestAnalogInVoltageConcurrentCallbacks) {
+  const int INDEX_TO_TEST = 3;
+
+  std::atomic<int> count{0};
+  std::atomic<bool> done{false};
+  std::thread registrar{[&] {
+    while (!done) {
+      int uid = HALSIM_RegisterAnalogInVoltageCallback(
+          INDEX_TO_TEST,
+          [](const char* name, void* param, const struct HAL_Value* value) {
+            ++*static_cast<std::atomic<int>*>(param);
+          },
+          &count, false);
+      HALSIM_CancelAnalogInVoltageCallback(INDEX_TO_TEST, uid);
+    }
+  }};
+
+  // Every set changes the value, and never sees a partial callback list
+  for (int i = 1; i <= 10000; ++i) {
+    HALSIM_SetAnalogInVoltage(INDEX_TO_TEST, i);
+    EXPECT_EQ(i, HALSIM_GetAnalogInVoltage(INDEX_TO_TEST));
+  }
+  done = true;
+  registrar.join();
+  EXPECT_LE(count, 10000);
+  HALSIM_ResetAnalogInData(INDEX_TO_TEST);
+}
 }  // namespace hal
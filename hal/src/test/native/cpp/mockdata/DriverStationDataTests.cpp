@@ -136,4 +136,54 @@ TEST(DriverStationTests, EventInfoTest) {
   EXPECT_EQ(42, dataBack.replayNumber);
 }
 
+TEST(DriverStationTests, SetStateTest) {
+  HALSIM_DriverStationState state;
+  std::memset(&state, 0, sizeof(state));
+  state.controlWord.enabled = true;
+  state.controlWord.autonomous = true;
+  state.controlWord.dsAttached = true;
+  state.allianceStationId = HAL_AllianceStationID_kBlue2;
+  state.matchTime = 12.5;
+  state.joystickAxes[1].count = 2;
+  state.joystickAxes[1].axes[1] = 0.5;
+  state.joystickButtons[3].count = 4;
+  state.joystickButtons[3].buttons = 0x5;
+
+  int axesCalls = 0;
+  int32_t uid = HALSIM_RegisterJoystickAxesCallback(
+      1,
+      [](const char* name, void* param, int32_t joystickNum,
+         const HAL_JoystickAxes* axes) { ++*static_cast<int*>(param); },
+      &axesCalls, false);
+
+  HALSIM_SetDriverStationState(&state);
+
+  HAL_ControlWord controlWord;
+  HAL_GetControlWord(&controlWord);
+  EXPECT_TRUE(controlWord.enabled);
+  EXPECT_TRUE(controlWord.autonomous);
+  EXPECT_FALSE(controlWord.test);
+  EXPECT_TRUE(controlWord.dsAttached);
+  int32_t status = 0;
+  EXPECT_EQ(HAL_AllianceStationID_kBlue2, HAL_GetAllianceStation(&status));
+  EXPECT_EQ(12.5, HAL_GetMatchTime(&status));
+
+  HAL_JoystickAxes axes;
+  HAL_GetJoystickAxes(1, &axes);
+  EXPECT_EQ(2, axes.count);
+  EXPECT_EQ(0.5, axes.axes[1]);
+  HAL_JoystickButtons buttons;
+  HAL_GetJoystickButtons(3, &buttons);
+  EXPECT_EQ(4, buttons.count);
+  EXPECT_EQ(0x5u, buttons.buttons);
+
+  // Callbacks are only called for changed values
+  EXPECT_EQ(1, axesCalls);
+  HALSIM_SetDriverStationState(&state);
+  EXPECT_EQ(1, axesCalls);
+
+  HALSIM_CancelJoystickAxesCallback(uid);
+  HALSIM_ResetDriverStationData();
+}
+
 }  // namespace hal
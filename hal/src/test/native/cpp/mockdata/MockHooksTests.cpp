@@ -0,0 +1,93 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <wpi/mutex.h>
+
+#include "gtest/gtest.h"
+#include "hal/HAL.h"
+#include "hal/Notifier.h"
+#include "hal/simulation/MockHooks.h"
+
+namespace hal {
+TEST(MockHooksTests, FastForwardJumpsToAlarms) {
+  int32_t status = 0;
+  HAL_NotifierHandle notifier = HAL_InitializeNotifier(&status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_SetTimingFastForward(true);
+  EXPECT_TRUE(HALSIM_IsTimingFastForward());
+  EXPECT_TRUE(HALSIM_IsTimingPaused());
+
+  auto wallStart = std::chrono::steady_clock::now();
+  uint64_t triggerTime = HAL_GetFPGATime(&status);
+  for (int i = 0; i < 100; ++i) {
+    triggerTime += 1000000;
+    HAL_UpdateNotifierAlarm(notifier, triggerTime, &status);
+    EXPECT_EQ(triggerTime, HAL_WaitForNotifierAlarm(notifier, &status));
+  }
+  // 100 seconds of alarms run much faster than real time
+  EXPECT_LT(std::chrono::steady_clock::now() - wallStart,
+            std::chrono::seconds(10));
+
+  HAL_StopNotifier(notifier, &status);
+  HALSIM_SetTimingFastForward(false);
+  EXPECT_FALSE(HALSIM_IsTimingFastForward());
+  HAL_CleanNotifier(notifier, &status);
+  HALSIM_ResumeTiming();
+}
+
+TEST(MockHooksTests, LockStepRunsDueNotifiersInOrder) {
+  int32_t status = 0;
+  HAL_NotifierHandle notifiers[2];
+  for (auto& notifier : notifiers) {
+    notifier = HAL_InitializeNotifier(&status);
+    ASSERT_EQ(0, status);
+  }
+
+  HALSIM_SetTimingLockStep(true);
+  EXPECT_TRUE(HALSIM_IsTimingLockStep());
+
+  // Both notifiers share every alarm time, so without lock step the order
+  // they record in would depend on thread scheduling
+  wpi::mutex orderMutex;
+  std::vector<int> order;
+  uint64_t startTime = HAL_GetFPGATime(&status);
+  auto run = [&](int i) {
+    int32_t status = 0;
+    uint64_t triggerTime = startTime;
+    for (int j = 0; j < 20; ++j) {
+      triggerTime += 20000;
+      HAL_UpdateNotifierAlarm(notifiers[i], triggerTime, &status);
+      if (HAL_WaitForNotifierAlarm(notifiers[i], &status) == 0) {
+        return;
+      }
+      std::scoped_lock lock(orderMutex);
+      order.push_back(i);
+    }
+    // Lock step waits for a woken notifier to wait again or stop
+    HAL_StopNotifier(notifiers[i], &status);
+  };
+  std::thread second{run, 1};
+  std::thread first{run, 0};
+  second.join();
+  first.join();
+
+  ASSERT_EQ(40u, order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(i % 2), order[i]);
+  }
+
+  HALSIM_SetTimingLockStep(false);
+  EXPECT_FALSE(HALSIM_IsTimingLockStep());
+  EXPECT_FALSE(HALSIM_IsTimingFastForward());
+  for (auto notifier : notifiers) {
+    HAL_CleanNotifier(notifier, &status);
+  }
+  HALSIM_ResumeTiming();
+}
+}  // namespace hal
@@ -2,6 +2,11 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "hal/HAL.h"
 #include "hal/SPI.h"
@@ -36,4 +41,84 @@ TEST(SpiSimTests, TestSpiInitialization) {
   EXPECT_STREQ("Initialized", gTestSpiCallbackName.c_str());
 }
 
+// Auto SPI device with one data byte per transfer; transfer i has timestamp i
+struct TestSpiAutoDevice {
+  std::atomic<int32_t> numPending{0};
+  uint32_t next = 0;
+
+  static void Read(const char* name, void* param, uint32_t* buffer,
+                   int32_t numToRead, int32_t* outputCount) {
+    auto device = static_cast<TestSpiAutoDevice*>(param);
+    if (numToRead == 0) {
+      *outputCount = device->numPending * 2;
+      return;
+    }
+    for (int32_t i = 0; i < numToRead; i += 2, ++device->next) {
+      buffer[i] = device->next;
+      buffer[i + 1] = device->next & 0xff;
+    }
+    device->numPending -= numToRead / 2;
+    *outputCount = numToRead;
+  }
+};
+
+TEST(SpiSimTests, TestSpiAutoStream) {
+  const int INDEX_TO_TEST = 3;
+
+  TestSpiAutoDevice device;
+  device.numPending = 10;
+  int callbackId = HALSIM_RegisterSPIReadAutoReceivedDataCallback(
+      INDEX_TO_TEST, &TestSpiAutoDevice::Read, &device);
+
+  int32_t status = 0;
+  HAL_StartSPIAutoStream(HAL_SPI_kOnboardCS3, 1, 4, 0.001, nullptr, nullptr,
+                         &status);
+  ASSERT_EQ(0, status);
+
+  // The ring holds 4 transfers, so the rest wait until there's room
+  std::vector<uint32_t> timestamps;
+  while (timestamps.size() < 10) {
+    const uint32_t* data;
+    int32_t count =
+        HAL_AcquireSPIAutoStream(HAL_SPI_kOnboardCS3, &data, 1, &status);
+    ASSERT_GT(count, 0);
+    ASSERT_LE(count, 4);
+    for (int32_t i = 0; i < count; ++i) {
+      timestamps.push_back(data[i * 2]);
+      EXPECT_EQ(data[i * 2], data[i * 2 + 1]);
+    }
+    HAL_ReleaseSPIAutoStream(HAL_SPI_kOnboardCS3, count, &status);
+    ASSERT_EQ(0, status);
+  }
+  for (uint32_t i = 0; i < timestamps.size(); ++i) {
+    EXPECT_EQ(i, timestamps[i]);
+  }
+  HAL_ReleaseSPIAutoStream(HAL_SPI_kOnboardCS3, 1, &status);
+  EXPECT_EQ(PARAMETER_OUT_OF_RANGE, status);
+  status = 0;
+  HAL_StopSPIAutoStream(HAL_SPI_kOnboardCS3, &status);
+
+  // With a callback, transfers are handed to it on the stream thread
+  std::atomic<int32_t> numReceived{0};
+  HAL_StartSPIAutoStream(
+      HAL_SPI_kOnboardCS3, 1, 4, 0.001,
+      [](void* param, const uint32_t* data, int32_t numTransfers) {
+        *static_cast<std::atomic<int32_t>*>(param) += numTransfers;
+      },
+      &numReceived, &status);
+  ASSERT_EQ(0, status);
+  device.numPending = 6;
+  for (int i = 0; i < 1000 && numReceived < 6; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(6, numReceived);
+  const uint32_t* data;
+  HAL_AcquireSPIAutoStream(HAL_SPI_kOnboardCS3, &data, 0, &status);
+  EXPECT_EQ(INCOMPATIBLE_STATE, status);
+  status = 0;
+  HAL_StopSPIAutoStream(HAL_SPI_kOnboardCS3, &status);
+
+  HALSIM_CancelSPIReadAutoReceivedDataCallback(INDEX_TO_TEST, callbackId);
+}
+
 }  // namespace hal
@@ -0,0 +1,80 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "hal/Value.h"
+#include "hal/simulation/SimCallbackRegistry.h"
+
+namespace hal {
+HAL_SIMCALLBACKREGISTRY_DEFINE_NAME(Test)
+
+using TestRegistry = SimCallbackRegistry<HAL_NotifyCallback, GetTestName>;
+
+namespace {
+struct SlowParam {
+  std::atomic<bool> entered{false};
+  std::atomic<bool> freed{false};
+  std::atomic<bool> usedAfterFree{false};
+};
+}  // namespace
+
+TEST(SimCallbackRegistryTests, CancelWaitsForInvoke) {
+  TestRegistry registry;
+  SlowParam param;
+  int32_t uid = registry.Register(
+      [](const char* name, void* p, const HAL_Value* value) {
+        auto& param = *static_cast<SlowParam*>(p);
+        param.entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (param.freed) {
+          param.usedAfterFree = true;
+        }
+      },
+      &param);
+  ASSERT_GT(uid, 0);
+
+  std::atomic<bool> stop{false};
+  std::thread invoker{[&] {
+    HAL_Value value = HAL_MakeBoolean(true);
+    while (!stop) {
+      registry(&value);
+    }
+  }};
+  while (!param.entered) {
+    std::this_thread::yield();
+  }
+
+  registry.Cancel(uid);
+  // What a CallbackStore does with its param once the callback is cancelled
+  param.freed = true;
+  stop = true;
+  invoker.join();
+  EXPECT_FALSE(param.usedAfterFree);
+}
+
+TEST(SimCallbackRegistryTests, CancelFromCallback) {
+  TestRegistry registry;
+  struct Param {
+    TestRegistry* registry;
+    int32_t uid;
+    int count;
+  } param{&registry, 0, 0};
+  param.uid = registry.Register(
+      [](const char* name, void* p, const HAL_Value* value) {
+        auto& param = *static_cast<Param*>(p);
+        ++param.count;
+        param.registry->Cancel(param.uid);
+      },
+      &param);
+
+  HAL_Value value = HAL_MakeBoolean(true);
+  registry(&value);
+  registry(&value);
+  EXPECT_EQ(1, param.count);
+}
+}  // namespace hal
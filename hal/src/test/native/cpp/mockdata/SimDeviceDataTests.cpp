@@ -2,6 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "hal/SimDevice.h"
 #include "hal/simulation/SimDeviceData.h"
@@ -19,4 +22,49 @@ TEST(SimDeviceSimTests, TestEnabled) {
   ASSERT_EQ(HAL_CreateSimDevice("foo"), 0);
 }
 
+TEST(SimDeviceSimTests, TestSetValues) {
+  HAL_SimDeviceHandle dev1 = HAL_CreateSimDevice("values1");
+  HAL_SimDeviceHandle dev2 = HAL_CreateSimDevice("values2");
+  HAL_SimValueHandle a =
+      HAL_CreateSimValue(dev1, "a", HAL_SimValueOutput, HAL_MakeDouble(0));
+  HAL_SimValueHandle b =
+      HAL_CreateSimValue(dev1, "b", HAL_SimValueOutput, HAL_MakeInt(0));
+  HAL_SimValueHandle c =
+      HAL_CreateSimValue(dev2, "c", HAL_SimValueOutput, HAL_MakeBoolean(0));
+
+  std::vector<std::string> calls;
+  auto callback = [](const char* name, void* param,
+                     HAL_SimDeviceHandle handle) {
+    static_cast<std::vector<std::string>*>(param)->emplace_back(name);
+  };
+  int32_t uid1 = HALSIM_RegisterSimDeviceValuesChangedCallback(
+      dev1, &calls, callback, false);
+  int32_t uid2 = HALSIM_RegisterSimDeviceValuesChangedCallback(
+      dev2, &calls, callback, false);
+
+  HAL_SimValueHandle handles[] = {a, b, c, a};
+  HAL_Value values[] = {HAL_MakeDouble(1), HAL_MakeInt(2), HAL_MakeBoolean(1),
+                        HAL_MakeDouble(3)};
+  HAL_SetSimValues(handles, values, 4);
+  EXPECT_EQ(calls, (std::vector<std::string>{"values1", "values2"}));
+  EXPECT_EQ(HAL_GetSimValueDouble(a), 3);
+  EXPECT_EQ(HAL_GetSimValueInt(b), 2);
+  EXPECT_TRUE(HAL_GetSimValueBoolean(c));
+
+  // single sets and resets notify too
+  calls.clear();
+  HAL_SetSimValueInt(b, 4);
+  HAL_ResetSimValue(a);
+  EXPECT_EQ(calls, (std::vector<std::string>{"values1", "values1"}));
+
+  HALSIM_CancelSimDeviceValuesChangedCallback(uid1);
+  HALSIM_CancelSimDeviceValuesChangedCallback(uid2);
+  calls.clear();
+  HAL_SetSimValues(handles, values, 4);
+  EXPECT_TRUE(calls.empty());
+
+  HAL_FreeSimDevice(dev1);
+  HAL_FreeSimDevice(dev2);
+}
+
 }  // namespace hal
@@ -0,0 +1,56 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hal/SimDevice.h"
+#include "hal/simulation/DriverStationData.h"
+#include "hal/simulation/EncoderData.h"
+#include "hal/simulation/PDPData.h"
+#include "hal/simulation/SimState.h"
+
+namespace hal {
+
+TEST(SimStateTests, SaveAndRestore) {
+  HAL_SimDeviceHandle device = HAL_CreateSimDevice("StateDevice");
+  ASSERT_NE(0, device);
+  HAL_SimValueHandle position =
+      HAL_CreateSimValueDouble(device, "Position", HAL_SimValueOutput, 1.5);
+  HALSIM_SetEncoderCount(2, 42);
+  HALSIM_SetPDPCurrent(1, 3, 7.5);
+  HALSIM_SetJoystickAxis(0, 1, 0.25);
+
+  int32_t size = HALSIM_SaveSimState(nullptr, 0);
+  ASSERT_GT(size, 0);
+  std::vector<uint8_t> snapshot(size);
+  ASSERT_EQ(size, HALSIM_SaveSimState(snapshot.data(), size));
+
+  HALSIM_SetEncoderCount(2, 7);
+  HALSIM_SetPDPCurrent(1, 3, 0);
+  HALSIM_SetJoystickAxis(0, 1, -1);
+  HAL_SetSimValueDouble(position, 9);
+
+  ASSERT_TRUE(HALSIM_RestoreSimState(snapshot.data(), size));
+  EXPECT_EQ(42, HALSIM_GetEncoderCount(2));
+  EXPECT_EQ(7.5, HALSIM_GetPDPCurrent(1, 3));
+  HAL_JoystickAxes axes;
+  HALSIM_GetJoystickAxes(0, &axes);
+  EXPECT_FLOAT_EQ(0.25, axes.axes[1]);
+  EXPECT_EQ(1.5, HAL_GetSimValueDouble(position));
+
+  // A truncated or corrupt snapshot changes nothing
+  HALSIM_SetEncoderCount(2, 7);
+  EXPECT_FALSE(HALSIM_RestoreSimState(snapshot.data(), size - 1));
+  snapshot[0] ^= 0xff;
+  EXPECT_FALSE(HALSIM_RestoreSimState(snapshot.data(), size));
+  EXPECT_EQ(7, HALSIM_GetEncoderCount(2));
+
+  HAL_FreeSimDevice(device);
+  HALSIM_ResetEncoderData(2);
+  HALSIM_ResetPDPData(1);
+  HALSIM_ResetDriverStationData();
+}
+
+}  // namespace hal
@@ -0,0 +1,308 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// End-to-end benchmarks of a server and clients connected over loopback, for
+// catching performance regressions in Storage, Dispatcher, and the wire
+// encoding.  Run with no arguments; results are printed to stdout.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <wpi/mutex.h>
+
+#include "ntcore.h"
+
+using Clock = std::chrono::steady_clock;
+
+static std::atomic<uint64_t> gAllocations{0};
+
+void* operator new(std::size_t size) {
+  ++gAllocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+unsigned int gNextPort = 10200;
+
+double Elapsed(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+NT_Inst CreateQuietInstance() {
+  auto inst = nt::CreateInstance();
+  // a logger that ignores everything replaces the default stderr logger
+  nt::AddLogger(
+      inst, [](const nt::LogMessage&) {}, 0, UINT_MAX);
+  return inst;
+}
+
+// Waits for pred() to be true, polling; returns false on timeout.
+template <typename F>
+bool WaitFor(F pred, double timeout = 10.0) {
+  auto start = Clock::now();
+  while (!pred()) {
+    if (Elapsed(start) > timeout) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return true;
+}
+
+// A server and clients connected to it over loopback.
+class Loopback {
+ public:
+  explicit Loopback(int num_clients) : m_port(gNextPort++) {
+    m_server = CreateQuietInstance();
+    nt::StartServer(m_server, "", "127.0.0.1", m_port);
+    for (int i = 0; i < num_clients; ++i) {
+      m_clients.push_back(CreateQuietInstance());
+    }
+  }
+
+  ~Loopback() {
+    for (auto client : m_clients) {
+      nt::DestroyInstance(client);
+    }
+    nt::DestroyInstance(m_server);
+  }
+
+  // Returns false if a client failed to connect.
+  bool Connect() {
+    for (auto client : m_clients) {
+      nt::StartClient(client, "127.0.0.1", m_port);
+    }
+    for (auto client : m_clients) {
+      if (!WaitFor([&] { return nt::IsConnected(client); })) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  NT_Inst server() const { return m_server; }
+  const std::vector<NT_Inst>& clients() const { return m_clients; }
+
+ private:
+  unsigned int m_port;
+  NT_Inst m_server;
+  std::vector<NT_Inst> m_clients;
+};
+
+// Local sets on the server as fast as possible; counts how many of the
+// changes reach a listener on the client.  Intermediate values of an entry
+// may be coalesced, so fewer updates are delivered than are set.
+void BenchThroughput(int num_entries) {
+  Loopback net{1};
+  auto server = net.server();
+  auto client = net.clients()[0];
+  std::vector<NT_Entry> entries;
+  for (int i = 0; i < num_entries; ++i) {
+    auto entry = nt::GetEntry(server, "/bench/" + std::to_string(i));
+    nt::SetEntryValue(entry, nt::Value::MakeDouble(0));
+    entries.push_back(entry);
+  }
+  if (!net.Connect()) {
+    std::puts("throughput: client failed to connect");
+    return;
+  }
+
+  std::atomic<uint64_t> received{0};
+  std::atomic<bool> done{false};
+  auto last =
+      nt::GetEntry(client, "/bench/" + std::to_string(num_entries - 1));
+  nt::AddEntryListener(
+      client, "/bench/",
+      [&](const nt::EntryNotification& event) {
+        ++received;
+        if (event.entry == last && event.value->GetDouble() < 0) {
+          done = true;
+        }
+      },
+      NT_NOTIFY_UPDATE);
+
+  uint64_t sets = 0;
+  auto start = Clock::now();
+  for (double round = 1; Elapsed(start) < 1.0; ++round) {
+    for (auto entry : entries) {
+      nt::SetEntryValue(entry, nt::Value::MakeDouble(round));
+    }
+    sets += entries.size();
+  }
+  double set_time = Elapsed(start);
+  // a final negative value marks the end of the run
+  for (auto entry : entries) {
+    nt::SetEntryValue(entry, nt::Value::MakeDouble(-1));
+  }
+  nt::Flush(server);
+  WaitFor([&] { return done.load(); });
+  double total_time = Elapsed(start);
+
+  std::printf(
+      "throughput: %6d entries: %10.0f sets/s  %10.0f delivered updates/s\n",
+      num_entries, sets / set_time, received / total_time);
+}
+
+// Periodic sets on the server; measures the time until each client's
+// listener sees the change.
+void BenchLatency(int num_clients) {
+  Loopback net{num_clients};
+  auto server = net.server();
+  auto entry = nt::GetEntry(server, "/ping");
+  nt::SetEntryValue(entry, nt::Value::MakeDouble(0));
+  if (!net.Connect()) {
+    std::puts("latency: client failed to connect");
+    return;
+  }
+
+  wpi::mutex mutex;
+  std::vector<double> samples;
+  std::atomic<int64_t> sent_ns{0};
+  for (auto client : net.clients()) {
+    nt::AddEntryListener(
+        nt::GetEntry(client, "/ping"),
+        [&](const nt::EntryNotification&) {
+          auto now = Clock::now().time_since_epoch();
+          double us =
+              std::chrono::duration<double, std::micro>(
+                  now - std::chrono::nanoseconds(sent_ns.load()))
+                  .count();
+          std::scoped_lock lock(mutex);
+          samples.push_back(us);
+        },
+        NT_NOTIFY_UPDATE);
+  }
+
+  constexpr int kSamples = 200;
+  for (int i = 1; i <= kSamples; ++i) {
+    sent_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now().time_since_epoch())
+                  .count();
+    nt::SetEntryValue(entry, nt::Value::MakeDouble(i));
+    nt::Flush(server);
+    // wait for every client, and space the sets out past the flush limit
+    WaitFor(
+        [&] {
+          std::scoped_lock lock(mutex);
+          return samples.size() >= static_cast<size_t>(i * num_clients);
+        },
+        1.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(6));
+  }
+
+  std::scoped_lock lock(mutex);
+  if (samples.empty()) {
+    std::printf("latency: %2d clients: no updates received\n", num_clients);
+    return;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&](double p) {
+    return samples[static_cast<size_t>(p * (samples.size() - 1))];
+  };
+  std::printf("latency: %2d clients: p50 %8.1f us  p99 %8.1f us  (%zu/%d)\n",
+              num_clients, percentile(0.5), percentile(0.99), samples.size(),
+              kSamples * num_clients);
+}
+
+// Heap allocations per local set, in the whole process (including the
+// network threads), with and without a connected client.
+void BenchAllocations(int num_clients) {
+  Loopback net{num_clients};
+  auto server = net.server();
+  auto entry = nt::GetEntry(server, "/alloc");
+  nt::SetEntryValue(entry, nt::Value::MakeDouble(0));
+  if (!net.Connect()) {
+    std::puts("allocations: client failed to connect");
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  constexpr int kSets = 100000;
+  uint64_t start_fast = gAllocations;
+  for (int i = 0; i < kSets; ++i) {
+    nt::SetEntryDouble(entry, i, 0);
+  }
+  uint64_t fast = gAllocations - start_fast;
+
+  uint64_t start_value = gAllocations;
+  for (int i = 0; i < kSets; ++i) {
+    nt::SetEntryValue(entry, nt::Value::MakeDouble(i));
+  }
+  // let the network threads send what was queued
+  nt::Flush(server);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  uint64_t value = gAllocations - start_value;
+
+  std::printf(
+      "allocations: %d clients: SetEntryDouble %.3f/set  SetEntryValue "
+      "%.3f/set\n",
+      num_clients, static_cast<double>(fast) / kSets,
+      static_cast<double>(value) / kSets);
+}
+
+// Time for a client to connect to a server with many entries and receive
+// all of them.
+void BenchHandshake(int num_entries) {
+  Loopback net{1};
+  auto server = net.server();
+  for (int i = 0; i < num_entries; ++i) {
+    nt::SetEntryValue(nt::GetEntry(server, "/big/" + std::to_string(i)),
+                      nt::Value::MakeString("value " + std::to_string(i)));
+  }
+  auto client = net.clients()[0];
+
+  auto start = Clock::now();
+  if (!net.Connect()) {
+    std::puts("handshake: client failed to connect");
+    return;
+  }
+  double connect_time = Elapsed(start);
+  WaitFor([&] {
+    return nt::GetEntries(client, "/big/", 0).size() ==
+           static_cast<size_t>(num_entries);
+  });
+  double total_time = Elapsed(start);
+
+  std::printf("handshake: %6d entries: connected %8.2f ms  all entries %8.2f "
+              "ms\n",
+              num_entries, connect_time * 1000, total_time * 1000);
+}
+
+}  // namespace
+
+int main() {
+  for (int num_entries : {10, 100, 1000, 10000}) {
+    BenchThroughput(num_entries);
+  }
+  for (int num_clients : {1, 4, 16}) {
+    BenchLatency(num_clients);
+  }
+  for (int num_clients : {0, 1}) {
+    BenchAllocations(num_clients);
+  }
+  for (int num_entries : {1000, 10000, 50000}) {
+    BenchHandshake(num_entries);
+  }
+  return 0;
+}
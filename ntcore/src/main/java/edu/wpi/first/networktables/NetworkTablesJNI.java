@@ -90,6 +90,19 @@ public final class NetworkTablesJNI {
 
   public static native boolean setDoubleArray(int entry, long time, double[] value, boolean force);
 
+  /**
+   * Sets a double array entry from a direct buffer, without creating a Java array.
+   *
+   * @param entry entry handle
+   * @param time time stamp
+   * @param value direct buffer holding the values, in native byte order
+   * @param len number of values
+   * @param force true to change the entry type if needed
+   * @return false if the entry type is different and force is false
+   */
+  public static native boolean setDoubleArray(
+      int entry, long time, ByteBuffer value, int len, boolean force);
+
   public static native boolean setStringArray(int entry, long time, String[] value, boolean force);
 
   public static native NetworkTableValue getValue(int entry);
@@ -106,6 +119,17 @@ public final class NetworkTablesJNI {
 
   public static native double[] getDoubleArray(int entry, double[] defaultValue);
 
+  /**
+   * Gets a double array entry into a direct buffer, without creating a Java array. As many
+   * values as fit are stored, in native byte order.
+   *
+   * @param entry entry handle
+   * @param value direct buffer to store the values in
+   * @return the number of values in the entry (which may be more than were stored), or -1 if the
+   *     entry is not a double array
+   */
+  public static native int getDoubleArray(int entry, ByteBuffer value);
+
   public static native String[] getStringArray(int entry, String[] defaultValue);
 
   public static native boolean setDefaultBoolean(int entry, long time, boolean defaultValue);
@@ -149,8 +173,33 @@ public final class NetworkTablesJNI {
   public static native EntryNotification[] pollEntryListenerTimeout(
       NetworkTableInstance inst, int poller, double timeout) throws InterruptedException;
 
+  /**
+   * Polls for entry listener events, serializing them into a direct buffer instead of creating an
+   * EntryNotification per event. Waits for new events only once the events from the previous
+   * poll have all been returned; events that don't fit in the buffer are returned by the next
+   * call. Don't mix this with pollEntryListener() on the same poller.
+   *
+   * <p>Each event is stored in native byte order as: int listener, int entry, int flags, the
+   * name, then the value. Strings (and raw and rpc values) are an int byte count followed by the
+   * UTF-8 bytes. A value is a byte type (NetworkTableType value, 0 if there is no value), a long
+   * last change time, then the data: a byte (0 or 1) for booleans, a double for doubles, a
+   * string for strings, raw and rpc values, and an int count followed by the elements for
+   * arrays.
+   *
+   * @param poller poller handle
+   * @param timeout timeout, in seconds (negative to wait forever)
+   * @param buffer direct buffer to store the events in
+   * @return the number of events stored (0 if it timed out), or the negated size in bytes of the
+   *     next event if it doesn't fit in the buffer
+   * @throws InterruptedException if the poll was canceled
+   */
+  public static native int pollEntryListenerBuffer(int poller, double timeout, ByteBuffer buffer)
+      throws InterruptedException;
+
   public static native void cancelPollEntryListener(int poller);
 
+  public static native void setEntryListenerPollerQueue(int poller, int mode, int maxSize);
+
   public static native void removeEntryListener(int entryListener);
 
   public static native boolean waitForEntryListenerQueue(int inst, double timeout);
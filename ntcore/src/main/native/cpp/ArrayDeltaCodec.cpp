@@ -0,0 +1,243 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ArrayDeltaCodec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include <wpi/span.h>
+
+#include "WireEncoder.h"
+
+using namespace nt;
+
+// Arrays are limited to 255 elements on the wire, so the start and count of
+// each range fit in a byte.
+static constexpr size_t kMaxArraySize = 0xff;
+
+template <typename T>
+static bool Same(const T& lhs, const T& rhs) {
+  return lhs == rhs;
+}
+
+// Compare bit patterns so that -0.0 and NaN payloads are sent exactly
+static bool Same(double lhs, double rhs) {
+  return std::memcmp(&lhs, &rhs, sizeof(double)) == 0;
+}
+
+template <typename T>
+static bool FindRanges(wpi::span<const T> prev, wpi::span<const T> cur,
+                       std::string* ranges, std::vector<T>* changed) {
+  if (prev.size() != cur.size() || cur.size() > kMaxArraySize) {
+    return false;
+  }
+  size_t i = 0;
+  while (i < cur.size()) {
+    if (Same(prev[i], cur[i])) {
+      ++i;
+      continue;
+    }
+    size_t start = i;
+    for (; i < cur.size() && !Same(prev[i], cur[i]); ++i) {
+      changed->push_back(cur[i]);
+    }
+    ranges->push_back(static_cast<char>(start));
+    ranges->push_back(static_cast<char>(i - start));
+  }
+  return true;
+}
+
+template <typename T>
+static bool ApplyRanges(wpi::span<const T> base, std::string_view ranges,
+                        wpi::span<const T> elems, std::vector<T>* out) {
+  out->assign(base.begin(), base.end());
+  size_t pos = 0;
+  for (size_t i = 0; i + 1 < ranges.size(); i += 2) {
+    size_t start = static_cast<unsigned char>(ranges[i]);
+    size_t count = static_cast<unsigned char>(ranges[i + 1]);
+    if (start + count > out->size() || pos + count > elems.size()) {
+      return false;
+    }
+    std::copy_n(elems.begin() + pos, count, out->begin() + start);
+    pos += count;
+  }
+  return pos == elems.size();
+}
+
+static size_t ArraySize(const Value& value) {
+  switch (value.type()) {
+    case NT_BOOLEAN_ARRAY:
+      return value.GetBooleanArray().size();
+    case NT_DOUBLE_ARRAY:
+      return value.GetDoubleArray().size();
+    case NT_STRING_ARRAY:
+      return value.GetStringArray().size();
+    default:
+      return 0;
+  }
+}
+
+void ArrayDeltaCodec::Write(const Message& msg, WireEncoder& encoder) {
+  unsigned int id = msg.id();
+  if (m_send_deltas && msg.Is(Message::kEntryUpdate) && id < m_sent.size() &&
+      m_sent[id]) {
+    if (auto delta = MakeDelta(*m_sent[id], msg)) {
+      delta->Write(encoder);
+      Track(&m_sent, msg);
+      return;
+    }
+  }
+  msg.Write(encoder);
+  if (encoder.proto_rev() >= 0x0300u) {
+    Track(&m_sent, msg);
+  }
+}
+
+std::shared_ptr<Message> ArrayDeltaCodec::Read(std::shared_ptr<Message> msg) {
+  if (msg->Is(Message::kEntryArrayDelta)) {
+    unsigned int id = msg->id();
+    if (id >= m_received.size() || !m_received[id]) {
+      return nullptr;
+    }
+    auto value = ApplyDelta(*m_received[id], *msg);
+    if (!value) {
+      return nullptr;
+    }
+    msg = Message::EntryUpdate(id, msg->seq_num_uid(), std::move(value));
+  }
+  Track(&m_received, *msg);
+  return msg;
+}
+
+std::shared_ptr<Message> ArrayDeltaCodec::MakeDelta(const Value& prev,
+                                                    const Message& msg) {
+  auto value = msg.value();
+  if (!value || prev.type() != value->type()) {
+    return nullptr;
+  }
+  std::string ranges;
+  std::shared_ptr<Value> changed;
+  size_t unchanged_size = 0;
+  switch (value->type()) {
+    case NT_BOOLEAN_ARRAY: {
+      std::vector<int> elems;
+      if (!FindRanges(prev.GetBooleanArray(), value->GetBooleanArray(),
+                      &ranges, &elems)) {
+        return nullptr;
+      }
+      unchanged_size = ArraySize(*value) - elems.size();
+      changed = Value::MakeBooleanArray(elems, value->time());
+      break;
+    }
+    case NT_DOUBLE_ARRAY: {
+      std::vector<double> elems;
+      if (!FindRanges(prev.GetDoubleArray(), value->GetDoubleArray(), &ranges,
+                      &elems)) {
+        return nullptr;
+      }
+      unchanged_size = (ArraySize(*value) - elems.size()) * 8;
+      changed = Value::MakeDoubleArray(elems, value->time());
+      break;
+    }
+    case NT_STRING_ARRAY: {
+      std::vector<std::string> elems;
+      auto cur = value->GetStringArray();
+      if (!FindRanges(prev.GetStringArray(), cur, &ranges, &elems)) {
+        return nullptr;
+      }
+      // lower bound on the encoded size of the strings left out
+      for (auto&& str : cur) {
+        unchanged_size += str.size() + 1;
+      }
+      for (auto&& str : elems) {
+        unchanged_size -= str.size() + 1;
+      }
+      changed = Value::MakeStringArray(std::move(elems), value->time());
+      break;
+    }
+    default:
+      return nullptr;
+  }
+  // the delta adds a range count and two bytes per range
+  if (unchanged_size <= 1 + ranges.size()) {
+    return nullptr;
+  }
+  return Message::EntryArrayDelta(msg.id(), msg.seq_num_uid(), ranges,
+                                  std::move(changed));
+}
+
+std::shared_ptr<Value> ArrayDeltaCodec::ApplyDelta(const Value& base,
+                                                   const Message& delta) {
+  auto elems = delta.value();
+  if (!elems || base.type() != elems->type()) {
+    return nullptr;
+  }
+  switch (base.type()) {
+    case NT_BOOLEAN_ARRAY: {
+      std::vector<int> v;
+      if (!ApplyRanges(base.GetBooleanArray(), delta.ranges(),
+                       elems->GetBooleanArray(), &v)) {
+        return nullptr;
+      }
+      return Value::MakeBooleanArray(v, elems->time());
+    }
+    case NT_DOUBLE_ARRAY: {
+      std::vector<double> v;
+      if (!ApplyRanges(base.GetDoubleArray(), delta.ranges(),
+                       elems->GetDoubleArray(), &v)) {
+        return nullptr;
+      }
+      return Value::MakeDoubleArray(v, elems->time());
+    }
+    case NT_STRING_ARRAY: {
+      std::vector<std::string> v;
+      if (!ApplyRanges(base.GetStringArray(), delta.ranges(),
+                       elems->GetStringArray(), &v)) {
+        return nullptr;
+      }
+      return Value::MakeStringArray(std::move(v), elems->time());
+    }
+    default:
+      return nullptr;
+  }
+}
+
+void ArrayDeltaCodec::Track(Values* values, const Message& msg) {
+  switch (msg.type()) {
+    case Message::kEntryAssign:
+    case Message::kEntryUpdate: {
+      unsigned int id = msg.id();
+      if (id >= 0xffff) {
+        return;  // not yet assigned an id
+      }
+      // only arrays that can be sent whole are delta bases
+      auto value = msg.value();
+      bool keep = value &&
+                  (value->IsBooleanArray() || value->IsDoubleArray() ||
+                   value->IsStringArray()) &&
+                  ArraySize(*value) <= kMaxArraySize;
+      if (id >= values->size()) {
+        if (!keep) {
+          return;
+        }
+        values->resize(id + 1);
+      }
+      (*values)[id] = keep ? std::move(value) : nullptr;
+      break;
+    }
+    case Message::kEntryDelete:
+      if (msg.id() < values->size()) {
+        (*values)[msg.id()].reset();
+      }
+      break;
+    case Message::kClearEntries:
+      values->clear();
+      break;
+    default:
+      break;
+  }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_ARRAYDELTACODEC_H_
+#define NTCORE_ARRAYDELTACODEC_H_
+
+#include <memory>
+#include <vector>
+
+#include "Message.h"
+
+namespace nt {
+
+class WireEncoder;
+
+/* Per-connection state for the array delta protocol extension.  Array entry
+ * values are remembered as they are sent and received, so an update that only
+ * changes some elements of a same-size array can be sent as an
+ * ENTRY_ARRAY_DELTA holding just the changed index ranges, and a received
+ * delta can be expanded back into a full ENTRY_UPDATE.
+ *
+ * The send half (Write) and the receive half (Read) keep separate state, so
+ * they may be called from different threads; each half is not thread safe on
+ * its own.
+ */
+class ArrayDeltaCodec {
+ public:
+  /* Send deltas.  Only enable once the peer has agreed to the extension. */
+  void set_send_deltas(bool enable) { m_send_deltas = enable; }
+  bool send_deltas() const { return m_send_deltas; }
+
+  /* Encodes msg, as a delta if possible. */
+  void Write(const Message& msg, WireEncoder& encoder);
+
+  /* Tracks a received message.  Deltas are expanded into entry updates;
+   * returns nullptr if a delta doesn't apply to the last received value.
+   */
+  std::shared_ptr<Message> Read(std::shared_ptr<Message> msg);
+
+  /* Builds a delta message for an update from prev to msg's value, or returns
+   * nullptr if a delta wouldn't be smaller than the full update.
+   */
+  static std::shared_ptr<Message> MakeDelta(const Value& prev,
+                                            const Message& msg);
+
+  /* Applies a delta message to base.  Returns nullptr if it doesn't fit. */
+  static std::shared_ptr<Value> ApplyDelta(const Value& base,
+                                           const Message& delta);
+
+ private:
+  using Values = std::vector<std::shared_ptr<Value>>;
+
+  static void Track(Values* values, const Message& msg);
+
+  bool m_send_deltas = false;
+  Values m_sent;      // indexed by id
+  Values m_received;  // indexed by id
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_ARRAYDELTACODEC_H_
@@ -0,0 +1,62 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "CompressionCodec.h"
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <wpi/raw_istream.h>
+
+#include "Lz4.h"
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+
+using namespace nt;
+
+void CompressionCodec::Write(WireEncoder& encoder) {
+  size_t size = encoder.size();
+  if (!m_compress || size < kMinCompressSize ||
+      size > Message::kMaxUncompressedSize) {
+    return;
+  }
+  if (m_backoff > 0) {
+    --m_backoff;
+    return;
+  }
+  m_buf.clear();
+  Lz4Compress(encoder.ToStringView(), m_buf);
+  // allow for the COMPRESSED message header
+  if (m_buf.size() + 10 >= size) {
+    m_backoff = kBackoffBatches;
+    return;
+  }
+  encoder.Reset();
+  encoder.Write8(Message::kCompressed);
+  encoder.WriteUleb128(size);
+  encoder.WriteString({m_buf.data(), m_buf.size()});
+}
+
+bool CompressionCodec::Read(const Message& msg, const WireDecoder& outer,
+                            const Message::GetEntryTypeFunc& get_entry_type,
+                            std::vector<std::shared_ptr<Message>>* out) {
+  std::string data;
+  if (!Lz4Decompress(msg.str(), msg.uncompressed_size(), &data)) {
+    return false;
+  }
+  wpi::raw_mem_istream is(data.data(), data.size());
+  WireDecoder decoder(is, outer.proto_rev(), outer.logger());
+  decoder.set_timestamps(outer.timestamps(), outer.time_offset());
+  while (is.in_avail() > 0) {
+    decoder.Reset();
+    auto inner = Message::Read(decoder, get_entry_type);
+    // a batch is compressed at most once
+    if (!inner || inner->Is(Message::kCompressed)) {
+      return false;
+    }
+    out->emplace_back(std::move(inner));
+  }
+  return true;
+}
@@ -0,0 +1,67 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_COMPRESSIONCODEC_H_
+#define NTCORE_COMPRESSIONCODEC_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include <wpi/SmallVector.h>
+
+#include "Message.h"
+
+namespace nt {
+
+class WireDecoder;
+class WireEncoder;
+
+/* Per-connection state for the compression protocol extension.  An encoded
+ * batch of outgoing messages is replaced by a single COMPRESSED message
+ * holding the LZ4-compressed batch when that is smaller, and a received
+ * COMPRESSED message is expanded back into the messages it holds.
+ *
+ * Small batches (a few entry updates, keep alives) rarely compress, so they
+ * are sent as is.  If a large batch doesn't shrink either, the next few
+ * batches aren't tried, so incompressible traffic costs little CPU.
+ *
+ * As with ArrayDeltaCodec, the send half (Write) and the receive half (Read)
+ * may be called from different threads.
+ */
+class CompressionCodec {
+ public:
+  // Batches smaller than this are never compressed
+  static constexpr size_t kMinCompressSize = 128;
+  // Batches skipped after one that didn't compress
+  static constexpr unsigned int kBackoffBatches = 16;
+
+  /* Compress outgoing batches.  Only enable once the peer has agreed to the
+   * extension.
+   */
+  void set_compress(bool enable) { m_compress = enable; }
+  bool compress() const { return m_compress; }
+
+  /* Compresses the messages encoded in encoder, if worthwhile. */
+  void Write(WireEncoder& encoder);
+
+  /* Expands a COMPRESSED message, appending the messages it holds to out.
+   * They are decoded with the settings (protocol revision, logger,
+   * timestamps) of outer, the decoder that read msg.  Returns false if it is
+   * malformed.
+   */
+  static bool Read(const Message& msg, const WireDecoder& outer,
+                   const Message::GetEntryTypeFunc& get_entry_type,
+                   std::vector<std::shared_ptr<Message>>* out);
+
+ private:
+  bool m_compress = false;
+  unsigned int m_backoff = 0;
+  wpi::SmallVector<char, 1024> m_buf;
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_COMPRESSIONCODEC_H_
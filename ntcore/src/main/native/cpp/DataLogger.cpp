@@ -0,0 +1,273 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "DataLogger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include <fmt/format.h>
+#include <wpi/DataLog.h>
+#include <wpi/SmallString.h>
+#include <wpi/StringExtras.h>
+#include <wpi/fs.h>
+#include <wpi/leb128.h>
+#include <wpi/raw_ostream.h>
+#include <wpi/timestamp.h>
+
+#include "Log.h"
+#include "networktables/NetworkTableValue.h"
+
+using namespace nt;
+
+class DataLogger::Thread : public wpi::SafeThread {
+ public:
+  Thread(DataLogger& owner, std::unique_ptr<wpi::raw_fd_ostream> os)
+      : m_owner(owner), m_os(std::move(os)) {}
+
+  void Main() override;
+
+  // Writes everything in the ring; returns false on a write error.
+  bool Drain();
+
+  DataLogger& m_owner;
+  std::unique_ptr<wpi::raw_fd_ostream> m_os;
+};
+
+DataLogger::DataLogger(wpi::Logger& logger) : m_logger(logger) {}
+
+DataLogger::~DataLogger() {
+  Stop();
+}
+
+const char* DataLogger::Start(std::string_view filename, size_t buffer_size) {
+  Stop();
+
+  std::error_code ec;
+  auto os = std::make_unique<wpi::raw_fd_ostream>(filename, ec);
+  if (ec.value() != 0) {
+    return "could not open file";
+  }
+
+  m_start_time = wpi::Now();
+  m_started.clear();
+  m_encoder.Reset();
+  m_encoder.Write32(m_start_time >> 32);
+  m_encoder.Write32(m_start_time & 0xffffffff);
+  *os << kHeader << m_encoder.ToStringView();
+
+  if (!m_ring || m_ring_size != buffer_size) {
+    m_ring = std::make_unique<char[]>(buffer_size);
+    m_ring_size = buffer_size;
+  }
+  m_head = 0;
+  m_tail = 0;
+  m_dropped = 0;
+
+  DEBUG0("logging entry values to '{}'", filename);
+  m_owner.Start(*this, std::move(os));
+  return nullptr;
+}
+
+void DataLogger::Stop() {
+  // joining lets the writer drain the ring and close the file
+  m_owner.Join();
+  if (m_dropped != 0) {
+    WARNING("entry value log dropped {} records", m_dropped.load());
+  }
+}
+
+void DataLogger::Append(unsigned int local_id, std::string_view name,
+                        const Value& value) {
+  switch (value.type()) {
+    case NT_BOOLEAN:
+    case NT_DOUBLE:
+    case NT_STRING:
+    case NT_RAW:
+    case NT_BOOLEAN_ARRAY:
+    case NT_DOUBLE_ARRAY:
+    case NT_STRING_ARRAY:
+      break;
+    default:
+      return;
+  }
+
+  // Encode the start record (if needed) and the value record back to back,
+  // so they're queued or dropped together.
+  wpi::SmallString<16> len;
+  m_encoder.Reset();
+  bool start = local_id >= m_started.size() || !m_started[local_id];
+  if (start) {
+    m_encoder.Write8(kStart);
+    m_encoder.WriteUleb128(local_id);
+    m_encoder.WriteString(name);
+    wpi::WriteUleb128(len, m_encoder.size());
+  }
+  size_t start_size = m_encoder.size();
+  m_encoder.Write8(kValue);
+  m_encoder.WriteUleb128(local_id);
+  uint64_t time = value.last_change();
+  m_encoder.WriteUleb128(time > m_start_time ? time - m_start_time : 0);
+  m_encoder.WriteType(value.type());
+  m_encoder.WriteUnboundedValue(value);
+  size_t len_pos = len.size();
+  wpi::WriteUleb128(len, m_encoder.size() - start_size);
+
+  std::string_view data = m_encoder.ToStringView();
+  size_t size = len.size() + data.size();
+  uint64_t head = m_head.load(std::memory_order_relaxed);
+  uint64_t tail = m_tail.load(std::memory_order_acquire);
+  if (size > m_ring_size - (head - tail)) {
+    ++m_dropped;
+    return;
+  }
+
+  auto copy = [&](std::string_view piece) {
+    size_t pos = head % m_ring_size;
+    size_t first = (std::min)(piece.size(), m_ring_size - pos);
+    std::memcpy(&m_ring[pos], piece.data(), first);
+    std::memcpy(&m_ring[0], piece.data() + first, piece.size() - first);
+    head += piece.size();
+  };
+  std::string_view lens = len.str();
+  if (start) {
+    copy(lens.substr(0, len_pos));
+    copy(data.substr(0, start_size));
+  }
+  copy(lens.substr(len_pos));
+  copy(data.substr(start_size));
+  m_head.store(head, std::memory_order_release);
+
+  if (start) {
+    if (local_id >= m_started.size()) {
+      m_started.resize(local_id + 1);
+    }
+    m_started[local_id] = true;
+  }
+}
+
+bool DataLogger::Thread::Drain() {
+  auto& owner = m_owner;
+  uint64_t tail = owner.m_tail.load(std::memory_order_relaxed);
+  uint64_t head = owner.m_head.load(std::memory_order_acquire);
+  if (head == tail) {
+    return true;
+  }
+  size_t pos = tail % owner.m_ring_size;
+  size_t size = head - tail;
+  size_t first = (std::min)(size, owner.m_ring_size - pos);
+  m_os->write(&owner.m_ring[pos], first);
+  m_os->write(&owner.m_ring[0], size - first);
+  m_os->flush();
+  owner.m_tail.store(head, std::memory_order_release);
+  return !m_os->has_error();
+}
+
+void DataLogger::Thread::Main() {
+  auto& m_logger = m_owner.m_logger;
+  bool ok = true;
+  while (m_active && ok) {
+    {
+      std::unique_lock lock(m_mutex);
+      m_cond.wait_for(lock, std::chrono::milliseconds(20),
+                      [&] { return !m_active; });
+    }
+    ok = Drain();
+  }
+  if (ok) {
+    ok = Drain();
+  }
+  m_os->close();
+  if (!ok || m_os->has_error()) {
+    m_os->clear_error();
+    WARNING("{}", "error writing entry value log");
+  }
+}
+
+static std::string_view LogType(NT_Type type) {
+  switch (type) {
+    case NT_BOOLEAN:
+      return "boolean";
+    case NT_DOUBLE:
+      return "double";
+    case NT_STRING:
+      return "string";
+    case NT_RAW:
+      return "raw";
+    case NT_BOOLEAN_ARRAY:
+      return "boolean[]";
+    case NT_DOUBLE_ARRAY:
+      return "double[]";
+    case NT_STRING_ARRAY:
+      return "string[]";
+    default:
+      return {};
+  }
+}
+
+EntryLogSink::~EntryLogSink() {
+  for (auto&& entry : m_entries) {
+    if (entry.entry != 0) {
+      m_log.Finish(entry.entry);
+    }
+  }
+}
+
+void EntryLogSink::Append(unsigned int local_id, std::string_view name,
+                          const Value& value) {
+  if (!wpi::starts_with(name, m_prefix)) {
+    return;
+  }
+  std::string_view type = LogType(value.type());
+  if (type.empty()) {
+    return;
+  }
+
+  if (local_id >= m_entries.size()) {
+    m_entries.resize(local_id + 1);
+  }
+  auto& entry = m_entries[local_id];
+  int64_t time = value.last_change();
+  if (entry.type != value.type()) {
+    if (entry.entry != 0) {
+      m_log.Finish(entry.entry, time);
+    }
+    entry.entry =
+        m_log.Start(fmt::format("{}{}", m_logPrefix, name), type, "", time);
+    entry.type = value.type();
+  }
+
+  switch (value.type()) {
+    case NT_BOOLEAN:
+      m_log.AppendBoolean(entry.entry, value.GetBoolean(), time);
+      break;
+    case NT_DOUBLE:
+      m_log.AppendDouble(entry.entry, value.GetDouble(), time);
+      break;
+    case NT_STRING:
+      m_log.AppendString(entry.entry, value.GetString(), time);
+      break;
+    case NT_RAW: {
+      auto raw = value.GetRaw();
+      m_log.AppendRaw(entry.entry,
+                      {reinterpret_cast<const uint8_t*>(raw.data()),
+                       raw.size()},
+                      time);
+      break;
+    }
+    case NT_BOOLEAN_ARRAY:
+      m_log.AppendBooleanArray(entry.entry, value.GetBooleanArray(), time);
+      break;
+    case NT_DOUBLE_ARRAY:
+      m_log.AppendDoubleArray(entry.entry, value.GetDoubleArray(), time);
+      break;
+    case NT_STRING_ARRAY:
+      m_log.AppendStringArray(entry.entry, value.GetStringArray(), time);
+      break;
+    default:
+      break;
+  }
+}
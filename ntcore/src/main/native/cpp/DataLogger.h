@@ -0,0 +1,130 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_DATALOGGER_H_
+#define NTCORE_DATALOGGER_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wpi/SafeThread.h>
+
+#include "WireEncoder.h"
+
+namespace wpi {
+class Logger;
+namespace log {
+class DataLog;
+}  // namespace log
+}  // namespace wpi
+
+namespace nt {
+
+class Value;
+
+/* Logs every value change to a binary file.
+ *
+ * Append() is called by Storage with its mutex held, so there is only ever
+ * one producer.  It encodes the record into a scratch buffer and copies it
+ * into a fixed-size ring that a background thread drains to disk; it never
+ * blocks or does file I/O.  If the writer falls behind and the ring fills,
+ * records are dropped (and counted) rather than stalling the caller.
+ *
+ * The file is kHeader, then a 64-bit start time (wpi::Now() units,
+ * big-endian), then records.  Each record is a ULEB128 length followed by
+ * that many bytes: the record type, the ULEB128 local entry id, and either
+ * the entry name (start record, written the first time an entry is logged)
+ * or the ULEB128 time since the start time, the value type, and the value
+ * (value record).  Values are encoded by WireEncoder::WriteUnboundedValue().
+ */
+class DataLogger {
+ public:
+  static constexpr char kHeader[] = "\x89NTL";
+  static constexpr size_t kDefaultBufferSize = 1024 * 1024;
+
+  enum RecordType { kStart = 1, kValue = 2 };
+
+  explicit DataLogger(wpi::Logger& logger);
+  ~DataLogger();
+
+  DataLogger(const DataLogger&) = delete;
+  DataLogger& operator=(const DataLogger&) = delete;
+
+  // Opens filename (replacing any existing file) and starts the writer.
+  // Returns error string, or nullptr if successful.  Must not be called
+  // while the logger is attached to Storage.
+  const char* Start(std::string_view filename,
+                    size_t buffer_size = kDefaultBufferSize);
+
+  // Writes out everything buffered and closes the file.  Must not be called
+  // while the logger is attached to Storage.
+  void Stop();
+
+  // Queues a value record.  Single producer only (see class comment).
+  void Append(unsigned int local_id, std::string_view name,
+              const Value& value);
+
+  // Number of records dropped because the ring was full.
+  uint64_t dropped() const { return m_dropped; }
+
+ private:
+  class Thread;
+  wpi::SafeThreadOwner<Thread> m_owner;
+  wpi::Logger& m_logger;
+
+  // Producer-only state
+  WireEncoder m_encoder{0x0300};
+  std::vector<bool> m_started;
+  uint64_t m_start_time = 0;
+
+  // Byte ring shared with the writer thread.  m_head and m_tail only ever
+  // increase; the producer owns m_head, the writer owns m_tail.
+  std::unique_ptr<char[]> m_ring;
+  size_t m_ring_size = 0;
+  std::atomic<uint64_t> m_head{0};
+  std::atomic<uint64_t> m_tail{0};
+  std::atomic<uint64_t> m_dropped{0};
+};
+
+/* Logs value changes to a wpi::log::DataLog, for entries whose names start
+ * with prefix, as log entries named logPrefix followed by the entry name.
+ *
+ * Like DataLogger, Append() is called by Storage with its mutex held.  Log
+ * entries are started the first time a value is logged, and restarted if the
+ * entry's type changes; they are finished when the sink is destroyed.
+ */
+class EntryLogSink {
+ public:
+  EntryLogSink(wpi::log::DataLog& log, std::string_view prefix,
+               std::string_view logPrefix)
+      : m_log{log}, m_prefix{prefix}, m_logPrefix{logPrefix} {}
+  ~EntryLogSink();
+
+  EntryLogSink(const EntryLogSink&) = delete;
+  EntryLogSink& operator=(const EntryLogSink&) = delete;
+
+  void Append(unsigned int local_id, std::string_view name,
+              const Value& value);
+
+ private:
+  struct LogEntry {
+    int entry = 0;
+    NT_Type type = NT_UNASSIGNED;
+  };
+
+  wpi::log::DataLog& m_log;
+  std::string m_prefix;
+  std::string m_logPrefix;
+  // by local id; entry is 0 if not started
+  std::vector<LogEntry> m_entries;
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_DATALOGGER_H_
@@ -0,0 +1,112 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "DatagramLane.h"
+
+#include <mutex>
+
+#include <wpi/Endian.h>
+#include <wpi/raw_istream.h>
+
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+
+using namespace nt;
+
+static constexpr size_t kTokenSize = 4;
+
+void DatagramLane::Track(const Message& msg) {
+  if (!msg.Is(Message::kEntryAssign) && !msg.Is(Message::kFlagsUpdate)) {
+    return;
+  }
+  unsigned int id = msg.id();
+  if (id == 0xffff) {
+    return;  // not assigned yet
+  }
+  bool unreliable = (msg.flags() & NT_UNRELIABLE) != 0;
+  std::scoped_lock lock(m_mutex);
+  if (id >= m_unreliable.size()) {
+    if (!unreliable) {
+      return;
+    }
+    m_unreliable.resize(id + 1);
+  }
+  m_unreliable[id] = unreliable;
+}
+
+bool DatagramLane::IsLossy(const Message& msg) const {
+  if (!msg.Is(Message::kEntryUpdate)) {
+    return false;
+  }
+  std::scoped_lock lock(m_mutex);
+  return msg.id() < m_unreliable.size() && m_unreliable[msg.id()];
+}
+
+void DatagramLane::Encode(uint32_t token,
+                          wpi::span<const std::shared_ptr<Message>> msgs,
+                          std::vector<std::string>* datagrams,
+                          std::vector<std::shared_ptr<Message>>* oversize) {
+  char header[kTokenSize];
+  wpi::support::endian::write32be(header, token);
+  WireEncoder encoder{0x0300u};
+  WireEncoder one{0x0300u};
+  for (auto& msg : msgs) {
+    if (!msg) {
+      continue;
+    }
+    one.Reset();
+    msg->Write(one);
+    if (kTokenSize + one.size() > kMaxDatagramSize) {
+      oversize->emplace_back(msg);
+      continue;
+    }
+    if (kTokenSize + encoder.size() + one.size() > kMaxDatagramSize) {
+      datagrams->emplace_back(header, kTokenSize);
+      datagrams->back() += encoder.ToStringView();
+      encoder.Reset();
+    }
+    msg->Write(encoder);
+  }
+  if (encoder.size() != 0) {
+    datagrams->emplace_back(header, kTokenSize);
+    datagrams->back() += encoder.ToStringView();
+  }
+}
+
+bool DatagramLane::GetToken(std::string_view data, uint32_t* token) {
+  if (data.size() < kTokenSize) {
+    return false;
+  }
+  *token = wpi::support::endian::read32be(data.data());
+  return true;
+}
+
+bool DatagramLane::Decode(std::string_view data, wpi::Logger& logger,
+                          std::vector<std::shared_ptr<Message>>* msgs) {
+  data.remove_prefix(kTokenSize);
+  wpi::raw_mem_istream is(data.data(), data.size());
+  WireDecoder decoder(is, 0x0300u, logger);
+  while (is.in_avail() > 0) {
+    // updates carry their type in protocol 3.0
+    auto msg = Message::Read(decoder, [](unsigned int) {
+      return NT_UNASSIGNED;
+    });
+    if (!msg || !msg->Is(Message::kEntryUpdate)) {
+      return false;
+    }
+    unsigned int id = msg->id();
+    if (id >= m_received.size()) {
+      m_received.resize(id + 1);
+    }
+    auto& received = m_received[id];
+    SequenceNumber seq_num{msg->seq_num_uid()};
+    if (received.present && seq_num <= received.seq_num) {
+      continue;  // late or duplicated
+    }
+    received.present = true;
+    received.seq_num = seq_num;
+    msgs->emplace_back(std::move(msg));
+  }
+  return true;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_DATAGRAMLANE_H_
+#define NTCORE_DATAGRAMLANE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wpi/mutex.h>
+#include <wpi/span.h>
+
+#include "Message.h"
+#include "SequenceNumber.h"
+
+namespace wpi {
+class Logger;
+}  // namespace wpi
+
+namespace nt {
+
+/* A connection's side of the datagram lane (see Message::kDatagramExt).
+ * Learns which entries are unreliable from the assignments and flag
+ * updates passing through the connection, and encodes and decodes the
+ * datagrams carrying their updates.
+ */
+class DatagramLane {
+ public:
+  // Kept under common path MTUs so datagrams aren't fragmented.
+  static constexpr size_t kMaxDatagramSize = 1200;
+
+  // Notes the flags of entries assigned or flagged in either direction.
+  void Track(const Message& msg);
+
+  // Whether msg is an update to an unreliable entry.
+  bool IsLossy(const Message& msg) const;
+
+  // Encodes updates into datagrams for token.  Updates that don't fit in a
+  // datagram on their own are added to oversize instead.
+  static void Encode(uint32_t token,
+                     wpi::span<const std::shared_ptr<Message>> msgs,
+                     std::vector<std::string>* datagrams,
+                     std::vector<std::shared_ptr<Message>>* oversize);
+
+  // Gets the token a datagram is for.  Returns false if it is too short.
+  static bool GetToken(std::string_view data, uint32_t* token);
+
+  // Decodes the updates in a datagram, dropping the ones not newer than the
+  // last one received for their entry.  Returns false if it is malformed.
+  // Must only be called from one thread at a time.
+  bool Decode(std::string_view data, wpi::Logger& logger,
+              std::vector<std::shared_ptr<Message>>* msgs);
+
+ private:
+  mutable wpi::mutex m_mutex;
+  std::vector<bool> m_unreliable;  // indexed by id
+
+  // Decode() only: the sequence number last received for each id
+  struct Received {
+    bool present = false;
+    SequenceNumber seq_num;
+  };
+  std::vector<Received> m_received;
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_DATAGRAMLANE_H_
@@ -0,0 +1,79 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "DatagramSocket.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <wpi/SmallString.h>
+#include <wpi/trace.h>
+
+#include "Log.h"
+
+using namespace nt;
+
+// Larger than any datagram we send; longer ones are truncated and rejected.
+static constexpr int kReceiveBufferSize = 2048;
+
+DatagramSocket::DatagramSocket(wpi::Logger& logger) : m_logger(logger) {}
+
+DatagramSocket::~DatagramSocket() {
+  Stop();
+}
+
+bool DatagramSocket::Start(std::string_view address, int port,
+                           ReceiveFunc func) {
+  Stop();
+  m_udp = std::make_unique<wpi::UDPClient>(address, m_logger);
+  if (m_udp->start(port) != 0) {
+    m_udp.reset();
+    return false;
+  }
+  // the receive thread polls for termination
+  m_udp->set_timeout(0.1);
+  m_receive = std::move(func);
+  m_active = true;
+  m_thread = std::thread(&DatagramSocket::ThreadMain, this);
+  return true;
+}
+
+void DatagramSocket::Stop() {
+  m_active = false;
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+  std::scoped_lock lock(m_send_mutex);
+  m_udp.reset();
+}
+
+bool DatagramSocket::Send(std::string_view data, std::string_view addr,
+                          int port) {
+  std::scoped_lock lock(m_send_mutex);
+  if (!m_udp) {
+    return false;
+  }
+  return m_udp->send(data, addr, port) == static_cast<int>(data.size());
+}
+
+void DatagramSocket::ThreadMain() {
+  WPI_TRACE_THREAD_NAME("NT datagram");
+  std::string buf(kReceiveBufferSize, '\0');
+  wpi::SmallString<64> addr;
+  while (m_active) {
+    int port = 0;
+    int len = m_udp->receive(reinterpret_cast<uint8_t*>(buf.data()),
+                             buf.size(), &addr, &port);
+    if (len <= 0 || len >= kReceiveBufferSize) {
+      continue;  // timeout, error, or truncated
+    }
+    DEBUG4("received {} byte datagram from {} port {}", len, addr.str(),
+           port);
+    m_receive(std::string_view{buf.data(), static_cast<size_t>(len)},
+              addr.str(), port);
+  }
+}
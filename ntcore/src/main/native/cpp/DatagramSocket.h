@@ -0,0 +1,59 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_DATAGRAMSOCKET_H_
+#define NTCORE_DATAGRAMSOCKET_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+#include <wpi/UDPClient.h>
+#include <wpi/mutex.h>
+
+namespace wpi {
+class Logger;
+}  // namespace wpi
+
+namespace nt {
+
+/* A UDP socket for the datagram lane (see Message::kDatagramExt), with a
+ * thread that passes each received datagram to a callback.  Shared by all
+ * connections of a server, or by a client's successive connections.
+ */
+class DatagramSocket {
+ public:
+  using ReceiveFunc = std::function<void(
+      std::string_view data, std::string_view addr, int port)>;
+
+  explicit DatagramSocket(wpi::Logger& logger);
+  ~DatagramSocket();
+
+  // Binds to port (an ephemeral port if 0) on address (any if empty) and
+  // starts receiving.  Returns false if the socket can't be bound.
+  bool Start(std::string_view address, int port, ReceiveFunc func);
+  void Stop();
+
+  // addr must be a resolved IPv4 address.
+  bool Send(std::string_view data, std::string_view addr, int port);
+
+  DatagramSocket(const DatagramSocket&) = delete;
+  DatagramSocket& operator=(const DatagramSocket&) = delete;
+
+ private:
+  void ThreadMain();
+
+  wpi::Logger& m_logger;
+  std::unique_ptr<wpi::UDPClient> m_udp;
+  ReceiveFunc m_receive;
+  std::thread m_thread;
+  std::atomic_bool m_active{false};
+  wpi::mutex m_send_mutex;
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_DATAGRAMSOCKET_H_
@@ -6,27 +6,39 @@
 
 #include <algorithm>
 #include <iterator>
+#include <random>
 
+#include <wpi/EventLoopRunner.h>
 #include <wpi/SmallVector.h>
 #include <wpi/StringExtras.h>
 #include <wpi/TCPAcceptor.h>
 #include <wpi/TCPConnector.h>
 #include <wpi/timestamp.h>
+#include <wpi/trace.h>
+#include <wpi/uv/Tcp.h>
 
+#include "DatagramLane.h"
+#include "DatagramSocket.h"
 #include "IConnectionNotifier.h"
 #include "IStorage.h"
 #include "Log.h"
 #include "NetworkConnection.h"
+#include "UvNetworkConnection.h"
 
 using namespace nt;
 
 void Dispatcher::StartServer(std::string_view persist_filename,
                              const char* listen_address, unsigned int port) {
   std::string listen_address_copy(wpi::trim(listen_address));
+  if (GetServerEventLoop()) {
+    StartServerLoop(persist_filename, listen_address_copy, port);
+    return;
+  }
   DispatcherBase::StartServer(
       persist_filename,
       std::unique_ptr<wpi::NetworkAcceptor>(new wpi::TCPAcceptor(
-          static_cast<int>(port), listen_address_copy.c_str(), m_logger)));
+          static_cast<int>(port), listen_address_copy.c_str(), m_logger)),
+      listen_address_copy, port);
 }
 
 void Dispatcher::SetServer(const char* server_name, unsigned int port) {
@@ -121,17 +133,77 @@ void DispatcherBase::StartLocal() {
 
 void DispatcherBase::StartServer(
     std::string_view persist_filename,
-    std::unique_ptr<wpi::NetworkAcceptor> acceptor) {
+    std::unique_ptr<wpi::NetworkAcceptor> acceptor,
+    std::string_view datagram_address, unsigned int datagram_port) {
+  if (!StartServerCommon(persist_filename)) {
+    return;
+  }
+  m_server_acceptor = std::move(acceptor);
+
+  if (m_datagrams && datagram_port != 0) {
+    auto socket = std::make_shared<DatagramSocket>(m_logger);
+    if (socket->Start(datagram_address, datagram_port,
+                      [this](auto data, auto addr, int port) {
+                        ReceiveDatagram(data, addr, port);
+                      })) {
+      std::scoped_lock lock(m_user_mutex);
+      m_datagram_socket = std::move(socket);
+    } else {
+      WARNING("server: could not listen for datagrams on port {}",
+              datagram_port);
+    }
+  }
+
+  m_dispatch_thread = std::thread(&Dispatcher::DispatchThreadMain, this);
+  m_clientserver_thread = std::thread(&Dispatcher::ServerThreadMain, this);
+}
+
+void DispatcherBase::StartServerLoop(std::string_view persist_filename,
+                                     std::string_view listen_address,
+                                     unsigned int port) {
+  if (!StartServerCommon(persist_filename)) {
+    return;
+  }
+
+  m_dispatch_thread = std::thread(&Dispatcher::DispatchThreadMain, this);
+
+  m_server_loop = std::make_unique<wpi::EventLoopRunner>();
+  bool listening = false;
+  m_server_loop->ExecSync([&](wpi::uv::Loop& loop) {
+    auto server = wpi::uv::Tcp::Create(loop);
+    if (!server) {
+      return;
+    }
+    server->error.connect([this, srv = server.get()](wpi::uv::Error err) {
+      ERROR("server: could not listen: {}", err.str());
+      srv->Close();
+    });
+    server->connection.connect(
+        [this, srv = server.get()] { ServerLoopAccept(*srv); });
+    server->Bind(listen_address, port);
+    server->Listen();
+    listening = !server->IsClosing();
+  });
+  if (!listening) {
+    m_active = false;
+    m_networkMode = NT_NET_MODE_SERVER | NT_NET_MODE_FAILURE;
+    return;
+  }
+  m_networkMode = NT_NET_MODE_SERVER;
+}
+
+bool DispatcherBase::StartServerCommon(std::string_view persist_filename) {
   {
     std::scoped_lock lock(m_user_mutex);
     if (m_active) {
-      return;
+      return false;
     }
     m_active = true;
+    // lets resuming clients tell a restarted server apart
+    m_server_session = std::random_device{}();
   }
   m_networkMode = NT_NET_MODE_SERVER | NT_NET_MODE_STARTING;
   m_persist_filename = persist_filename;
-  m_server_acceptor = std::move(acceptor);
 
   // Load persistent file.  Ignore errors, but pass along warnings.
   if (!persist_filename.empty()) {
@@ -148,9 +220,7 @@ void DispatcherBase::StartServer(
   }
 
   m_storage.SetDispatcher(this, true);
-
-  m_dispatch_thread = std::thread(&Dispatcher::DispatchThreadMain, this);
-  m_clientserver_thread = std::thread(&Dispatcher::ServerThreadMain, this);
+  return true;
 }
 
 void DispatcherBase::StartClient() {
@@ -194,10 +264,26 @@ void DispatcherBase::Stop() {
     m_clientserver_thread.join();
   }
 
+  // closes the event loop server and all of its connections
+  if (m_server_loop) {
+    m_server_loop->Stop();
+    m_server_loop.reset();
+    m_networkMode = NT_NET_MODE_NONE;
+  }
+
   std::vector<std::shared_ptr<INetworkConnection>> conns;
+  std::shared_ptr<DatagramSocket> datagram_socket;
   {
     std::scoped_lock lock(m_user_mutex);
     conns.swap(m_connections);
+    datagram_socket.swap(m_datagram_socket);
+    m_datagram_conns.clear();
+    ClearPendingUpdatesLocked();
+  }
+
+  // the socket's thread calls back under the user mutex
+  if (datagram_socket) {
+    datagram_socket->Stop();
   }
 
   // close all connections
@@ -219,6 +305,20 @@ void DispatcherBase::SetIdentity(std::string_view name) {
   m_identity = name;
 }
 
+void DispatcherBase::SetClientSubscriptions(
+    wpi::span<const std::string_view> prefixes) {
+  std::scoped_lock lock(m_user_mutex);
+  m_client_subscriptions.assign(prefixes.begin(), prefixes.end());
+  // otherwise they're sent in the next client hello
+  if (!m_client_subscribe_ext) {
+    return;
+  }
+  auto msg = Message::Subscribe(m_client_subscriptions);
+  for (auto& conn : m_connections) {
+    conn->QueueOutgoing(msg);
+  }
+}
+
 void DispatcherBase::Flush() {
   auto now = wpi::Now();
   {
@@ -233,6 +333,14 @@ void DispatcherBase::Flush() {
   m_flush_cv.notify_one();
 }
 
+void DispatcherBase::FlushOutgoing() {
+  {
+    std::scoped_lock lock(m_flush_mutex);
+    m_do_flush = true;
+  }
+  m_flush_cv.notify_one();
+}
+
 std::vector<ConnectionInfo> DispatcherBase::GetConnections() const {
   std::vector<ConnectionInfo> conns;
   if (!m_active) {
@@ -269,6 +377,28 @@ bool DispatcherBase::IsConnected() const {
   return false;
 }
 
+bool DispatcherBase::GetServerTimeOffset(int64_t* offset) const {
+  if (!m_active) {
+    return false;
+  }
+
+  // the server's own clock is the reference
+  if ((m_networkMode & NT_NET_MODE_SERVER) != 0) {
+    *offset = 0;
+    return true;
+  }
+
+  std::scoped_lock lock(m_user_mutex);
+  for (auto& conn : m_connections) {
+    if (conn->state() == NetworkConnection::kActive &&
+        conn->server_time_offset(offset)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 unsigned int DispatcherBase::AddListener(
     std::function<void(const ConnectionNotification& event)> callback,
     bool immediate_notify) const {
@@ -318,13 +448,16 @@ void DispatcherBase::ClearConnectorOverride() {
 }
 
 void DispatcherBase::DispatchThreadMain() {
+  WPI_TRACE_THREAD_NAME("NT dispatch");
   auto timeout_time = std::chrono::steady_clock::now();
 
   static const auto save_delta_time = std::chrono::seconds(1);
   auto next_save_time = timeout_time + save_delta_time;
+  auto next_low_priority_time = timeout_time;
 
   int count = 0;
 
+  m_storage.SetPeriodicMirror(true);
   while (m_active) {
     // handle loop taking too long
     auto start = std::chrono::steady_clock::now();
@@ -342,6 +475,15 @@ void DispatcherBase::DispatchThreadMain() {
     if (!m_active) {
       break;  // in case we were woken up to terminate
     }
+    WPI_TRACE_SCOPE("ntcore.dispatch");
+
+    // low priority updates go out with every few periodic updates
+    auto now = std::chrono::steady_clock::now();
+    bool low_priority = now >= next_low_priority_time;
+    if (low_priority) {
+      next_low_priority_time =
+          now + std::chrono::milliseconds(m_update_rate * kLowPriorityDivisor);
+    }
 
     // perform periodic persistent save
     if ((m_networkMode & NT_NET_MODE_SERVER) != 0 &&
@@ -351,12 +493,18 @@ void DispatcherBase::DispatchThreadMain() {
       if (start > next_save_time) {
         next_save_time = start + save_delta_time;
       }
-      const char* err = m_storage.SavePersistent(m_persist_filename, true);
+      const char* err =
+          m_persist_journal
+              ? m_storage.SavePersistentJournal(m_persist_filename, true)
+              : m_storage.SavePersistent(m_persist_filename, true);
       if (err) {
         WARNING("periodic persistent save: {}", err);
       }
     }
 
+    // values published through in-process channels since the last update
+    m_storage.MirrorLocalChannels();
+
     {
       std::scoped_lock user_lock(m_user_mutex);
       bool reconnect = false;
@@ -366,6 +514,8 @@ void DispatcherBase::DispatchThreadMain() {
         count = 0;
       }
 
+      FlushPendingUpdates(low_priority);
+
       for (auto& conn : m_connections) {
         // post outgoing messages if connection is active
         // only send keep-alives on client
@@ -386,12 +536,147 @@ void DispatcherBase::DispatchThreadMain() {
       }
     }
   }
+  m_storage.SetPeriodicMirror(false);
 }
 
 void DispatcherBase::QueueOutgoing(std::shared_ptr<Message> msg,
                                    INetworkConnection* only,
                                    INetworkConnection* except) {
   std::scoped_lock user_lock(m_user_mutex);
+  QueueOutgoingLocked(std::move(msg), only, except);
+}
+
+void DispatcherBase::QueueOutgoingLocked(std::shared_ptr<Message> msg,
+                                         INetworkConnection* only,
+                                         INetworkConnection* except) {
+  // keep ordering with any coalesced updates
+  if (!m_pending_ids.empty()) {
+    switch (msg->type()) {
+      case Message::kEntryAssign:
+      case Message::kEntryUpdate:
+      case Message::kFlagsUpdate:
+      case Message::kEntryDelete:
+        FlushPendingUpdate(msg->id());
+        break;
+      case Message::kExecuteRpc:
+      case Message::kRpcResponse:
+        break;
+      default:
+        FlushPendingUpdates();
+        break;
+    }
+  }
+
+  QueueOutgoingImpl(std::move(msg), only, except);
+}
+
+void DispatcherBase::QueueOutgoingUpdate(unsigned int id, unsigned int seq_num,
+                                         std::shared_ptr<Value> value,
+                                         unsigned int priority) {
+  std::scoped_lock user_lock(m_user_mutex);
+  QueueOutgoingUpdateLocked(id, seq_num, std::move(value), priority);
+}
+
+void DispatcherBase::QueueOutgoingBatch(wpi::span<Outgoing> batch) {
+  std::scoped_lock user_lock(m_user_mutex);
+  for (auto& out : batch) {
+    if (out.msg) {
+      QueueOutgoingLocked(std::move(out.msg), nullptr, nullptr);
+    } else {
+      QueueOutgoingUpdateLocked(out.id, out.seq_num, std::move(out.value),
+                                out.priority);
+    }
+  }
+}
+
+void DispatcherBase::QueueOutgoingUpdateLocked(unsigned int id,
+                                               unsigned int seq_num,
+                                               std::shared_ptr<Value> value,
+                                               unsigned int priority) {
+  if (m_connections.empty()) {
+    return;
+  }
+  if (id >= m_pending_updates.size()) {
+    m_pending_updates.resize(id + 1);
+  }
+  auto& pending = m_pending_updates[id];
+  if (!pending.pending) {
+    pending.pending = true;
+    m_pending_ids.push_back(id);
+  }
+  pending.seq_num = seq_num;
+  pending.priority = priority;
+  if (value->IsBoolean() || value->IsDouble()) {
+    pending.scalar = value->value();
+    pending.value.reset();
+  } else {
+    pending.value = std::move(value);
+  }
+}
+
+void DispatcherBase::FlushPendingUpdate(unsigned int id) {
+  if (id >= m_pending_updates.size()) {
+    return;
+  }
+  auto& pending = m_pending_updates[id];
+  if (!pending.pending) {
+    return;
+  }
+  std::shared_ptr<Value> value;
+  if (pending.value) {
+    value = std::move(pending.value);
+  } else if (pending.scalar.type == NT_BOOLEAN) {
+    value = Value::MakeBoolean(pending.scalar.data.v_boolean != 0,
+                               pending.scalar.last_change);
+  } else {
+    value = Value::MakeDouble(pending.scalar.data.v_double,
+                              pending.scalar.last_change);
+  }
+  // the id is left in m_pending_ids; FlushPendingUpdates() skips it
+  QueueOutgoingImpl(Message::EntryUpdate(id, pending.seq_num, std::move(value)),
+                    nullptr, nullptr);
+  pending.pending = false;
+  pending.value.reset();
+}
+
+void DispatcherBase::FlushPendingUpdates(bool low_priority) {
+  size_t kept = 0;
+  for (auto id : m_pending_ids) {
+    auto& pending = m_pending_updates[id];
+    if (!pending.pending) {
+      continue;
+    }
+    if (!low_priority && pending.priority == NT_PRIORITY_LOW) {
+      m_pending_ids[kept++] = id;
+      continue;
+    }
+    FlushPendingUpdate(id);
+  }
+  m_pending_ids.resize(kept);
+}
+
+void DispatcherBase::ClearPendingUpdates() {
+  std::scoped_lock user_lock(m_user_mutex);
+  ClearPendingUpdatesLocked();
+}
+
+void DispatcherBase::ClearPendingUpdate(unsigned int id) {
+  std::scoped_lock user_lock(m_user_mutex);
+  if (id < m_pending_updates.size()) {
+    // the id is left in m_pending_ids; FlushPendingUpdates() skips it
+    m_pending_updates[id].pending = false;
+    m_pending_updates[id].value.reset();
+  }
+}
+
+void DispatcherBase::ClearPendingUpdatesLocked() {
+  m_pending_updates.clear();
+  m_pending_ids.clear();
+}
+
+void DispatcherBase::QueueOutgoingImpl(std::shared_ptr<Message> msg,
+                                       INetworkConnection* only,
+                                       INetworkConnection* except) {
   for (auto& conn : m_connections) {
     if (conn.get() == except) {
       continue;
@@ -409,6 +694,7 @@ void DispatcherBase::QueueOutgoing(std::shared_ptr<Message> msg,
 }
 
 void DispatcherBase::ServerThreadMain() {
+  WPI_TRACE_THREAD_NAME("NT server");
   if (m_server_acceptor->start() != 0) {
     m_active = false;
     m_networkMode = NT_NET_MODE_SERVER | NT_NET_MODE_FAILURE;
@@ -439,25 +725,115 @@ void DispatcherBase::ServerThreadMain() {
                   std::weak_ptr<NetworkConnection>(conn)));
     {
       std::scoped_lock lock(m_user_mutex);
-      // reuse dead connection slots
-      bool placed = false;
-      for (auto& c : m_connections) {
-        if (c->state() == NetworkConnection::kDead) {
-          c = conn;
-          placed = true;
-          break;
-        }
-      }
-      if (!placed) {
-        m_connections.emplace_back(conn);
-      }
+      AddServerConnection(conn);
       conn->Start();
     }
   }
   m_networkMode = NT_NET_MODE_NONE;
 }
 
+void DispatcherBase::ServerLoopAccept(wpi::uv::Tcp& server) {
+  auto tcp = server.Accept();
+  if (!tcp) {
+    return;
+  }
+  // turn off Nagle algorithm; we bundle packets for transmission
+  tcp->SetNoDelay(true);
+
+  using namespace std::placeholders;
+  auto conn = std::make_shared<UvNetworkConnection>(
+      ++m_connections_uid, tcp, m_notifier, m_logger,
+      [this](UvNetworkConnection& c, const Message& hello,
+             const Message* session, UvNetworkConnection::Outgoing* outgoing) {
+        return ServerHandshakeHello(c, hello, session, outgoing);
+      },
+      [this](UvNetworkConnection& c, unsigned int flags,
+             UvNetworkConnection::Outgoing* outgoing) {
+        ServerHandshakeExtensions(c, flags, outgoing);
+      },
+      std::bind(&IStorage::GetMessageEntryType, &m_storage, _1));  // NOLINT
+  auto info = conn->info();
+  DEBUG0("server: client connection from {} port {}", info.remote_ip,
+         info.remote_port);
+  conn->set_process_incoming(
+      std::bind(&IStorage::ProcessIncoming, &m_storage, _1, _2,  // NOLINT
+                std::weak_ptr<UvNetworkConnection>(conn)));
+  {
+    std::scoped_lock lock(m_user_mutex);
+    AddServerConnection(conn);
+    conn->Start();
+  }
+}
+
+void DispatcherBase::AddServerConnection(
+    std::shared_ptr<INetworkConnection> conn) {
+  // reuse dead connection slots
+  for (auto& c : m_connections) {
+    if (c->state() == NetworkConnection::kDead) {
+      c = std::move(conn);
+      return;
+    }
+  }
+  m_connections.emplace_back(std::move(conn));
+}
+
+void DispatcherBase::EnableDatagrams(NetworkConnection& conn, uint32_t token,
+                                     bool client, std::string_view addr,
+                                     int port) {
+  std::scoped_lock lock(m_user_mutex);
+  if (client && !m_datagram_socket) {
+    // bound once, to an ephemeral port
+    auto socket = std::make_shared<DatagramSocket>(m_logger);
+    if (!socket->Start("", 0, [this](auto data, auto addr, int port) {
+          ReceiveDatagram(data, addr, port);
+        })) {
+      WARNING("{}", "client: could not open datagram socket");
+      return;
+    }
+    m_datagram_socket = std::move(socket);
+  }
+  if (!m_datagram_socket) {
+    return;
+  }
+  for (auto& c : m_connections) {
+    if (c.get() != &conn) {
+      continue;
+    }
+    // forget connections that have gone away
+    for (auto it = m_datagram_conns.begin(); it != m_datagram_conns.end();) {
+      auto cur = it++;
+      if (cur->second.expired()) {
+        m_datagram_conns.erase(cur);
+      }
+    }
+    m_datagram_conns[token] = std::static_pointer_cast<NetworkConnection>(c);
+    conn.set_datagrams(m_datagram_socket, token, client, addr, port);
+    return;
+  }
+}
+
+void DispatcherBase::ReceiveDatagram(std::string_view data,
+                                     std::string_view addr, int port) {
+  uint32_t token;
+  if (!DatagramLane::GetToken(data, &token)) {
+    return;
+  }
+  std::shared_ptr<NetworkConnection> conn;
+  {
+    std::scoped_lock lock(m_user_mutex);
+    auto it = m_datagram_conns.find(token);
+    if (it == m_datagram_conns.end()) {
+      return;
+    }
+    conn = it->second.lock();
+  }
+  if (conn) {
+    conn->ProcessDatagram(data, addr, port);
+  }
+}
+
 void DispatcherBase::ClientThreadMain() {
+  WPI_TRACE_THREAD_NAME("NT client");
   while (m_active) {
     // sleep between retries
     std::this_thread::sleep_for(std::chrono::milliseconds(250));
@@ -497,6 +873,7 @@ void DispatcherBase::ClientThreadMain() {
         std::bind(&IStorage::ProcessIncoming, &m_storage, _1, _2,  // NOLINT
                   std::weak_ptr<NetworkConnection>(conn)));
     m_connections.resize(0);  // disconnect any current
+    ClearPendingUpdatesLocked();
     m_connections.emplace_back(conn);
     conn->set_proto_rev(m_reconnect_proto_rev);
     conn->Start();
@@ -514,20 +891,48 @@ void DispatcherBase::ClientThreadMain() {
 bool DispatcherBase::ClientHandshake(
     NetworkConnection& conn, std::function<std::shared_ptr<Message>()> get_msg,
     std::function<void(wpi::span<std::shared_ptr<Message>>)> send_msgs) {
-  // get identity
+  // get identity and session
   std::string self_id;
+  bool have_session;
+  uint32_t session;
+  std::vector<std::string> subscriptions;
   {
     std::scoped_lock lock(m_user_mutex);
     self_id = m_identity;
+    // the session is only worth resuming with the server that gave it
+    have_session = m_have_client_session &&
+                   m_client_session_ip == conn.stream().getPeerIP() &&
+                   m_client_session_port == conn.stream().getPeerPort();
+    session = m_client_session;
+    m_have_client_session = false;
+    subscriptions = m_client_subscriptions;
+    m_client_subscribe_ext = false;
+  }
+
+  // Ask to resume the session by sending what we have.  Only the server
+  // that gave us the session is sent hello flags, as it's known to
+  // understand them.
+  unsigned int hello_flags = 0;
+  std::string digest;
+  bool resume = have_session && conn.proto_rev() >= 0x0300;
+  if (resume) {
+    m_storage.GetSessionDigest(&digest);
+    hello_flags |= Message::kSessionResumeExt;
+    if (m_compression) {
+      hello_flags |= Message::kCompressionExt;
+    }
   }
 
   // send client hello
   DEBUG0("{}", "client: sending hello");
-  auto msg = Message::ClientHello(self_id);
-  send_msgs(wpi::span(&msg, 1));
+  NetworkConnection::Outgoing hello{Message::ClientHello(self_id, hello_flags)};
+  if (resume) {
+    hello.emplace_back(Message::Session(session, digest));
+  }
+  send_msgs(hello);
 
   // wait for response
-  msg = get_msg();
+  auto msg = get_msg();
   if (!msg) {
     // disconnected, retry
     DEBUG0("{}", "client: server disconnected before first response");
@@ -542,6 +947,13 @@ bool DispatcherBase::ClientHandshake(
   }
 
   bool new_server = true;
+  bool array_deltas = false;
+  bool time_sync = false;
+  bool compression = false;
+  bool resumed = false;
+  bool sessions = false;
+  bool subscribe_ext = false;
+  bool datagrams = false;
   if (conn.proto_rev() >= 0x0300) {
     // should be server hello; if not, disconnect.
     if (!msg->Is(Message::kServerHello)) {
@@ -551,6 +963,19 @@ bool DispatcherBase::ClientHandshake(
     if ((msg->flags() & 1) != 0) {
       new_server = false;
     }
+    array_deltas = (msg->flags() & Message::kArrayDeltaExt) != 0;
+    time_sync = (msg->flags() & Message::kTimeSyncExt) != 0;
+    compression =
+        m_compression && (msg->flags() & Message::kCompressionExt) != 0;
+    sessions = (msg->flags() & Message::kSessionExt) != 0;
+    subscribe_ext = (msg->flags() & Message::kSubscribeExt) != 0;
+    datagrams = m_datagrams && (msg->flags() & Message::kDatagramExt) != 0;
+    if (compression && (hello_flags & Message::kCompressionExt) != 0) {
+      // the server compresses from the server hello on
+      conn.set_compression(true);
+      compression = false;
+    }
+    resumed = resume && (msg->flags() & Message::kSessionResumeExt) != 0;
     // get the next message
     msg = get_msg();
   }
@@ -573,7 +998,8 @@ bool DispatcherBase::ClientHandshake(
       msg = get_msg();
       continue;
     }
-    if (!msg->Is(Message::kEntryAssign)) {
+    if (!msg->Is(Message::kEntryAssign) &&
+        !(resumed && msg->Is(Message::kEntryDelete))) {
       // unexpected message
       DEBUG0(
           "client: received message ({}) other than entry assignment during "
@@ -589,7 +1015,40 @@ bool DispatcherBase::ClientHandshake(
   // generate outgoing assignments
   NetworkConnection::Outgoing outgoing;
 
-  m_storage.ApplyInitialAssignments(conn, incoming, new_server, &outgoing);
+  if (resumed) {
+    DEBUG0("client: resumed session with {} changed entries",
+           incoming.size());
+  } else {
+    digest.clear();
+  }
+  m_storage.ApplyInitialAssignments(conn, incoming, new_server, digest,
+                                    &outgoing);
+
+  unsigned int ext_flags = 0;
+  if (array_deltas) {
+    ext_flags |= Message::kArrayDeltaExt;
+  }
+  if (time_sync) {
+    ext_flags |= Message::kTimeSyncExt;
+  }
+  if (compression) {
+    ext_flags |= Message::kCompressionExt;
+  }
+  if (sessions) {
+    ext_flags |= Message::kSessionExt;
+  }
+  if (datagrams) {
+    ext_flags |= Message::kDatagramExt;
+  }
+  if (ext_flags != 0) {
+    // the server only sends deltas and timestamps once it has seen this
+    outgoing.emplace_back(Message::Extensions(ext_flags));
+    conn.set_array_deltas(array_deltas);
+  }
+  if (subscribe_ext && !subscriptions.empty()) {
+    // the initial assignments above were not filtered
+    outgoing.emplace_back(Message::Subscribe(subscriptions));
+  }
 
   if (conn.proto_rev() >= 0x0300) {
     outgoing.emplace_back(Message::ClientHelloDone());
@@ -598,6 +1057,59 @@ bool DispatcherBase::ClientHandshake(
   if (!outgoing.empty()) {
     send_msgs(outgoing);
   }
+  // the assignments above were sent before EXTENSIONS, so without timestamps
+  // or compression
+  if (time_sync) {
+    conn.set_time_sync(true, true);
+  }
+  if (compression) {
+    conn.set_compression(true);
+  }
+
+  // the server answers the hello done with the session and datagram lane
+  bool got_session = false;
+  uint32_t datagram_token = 0;
+  while (sessions || datagrams) {
+    msg = get_msg();
+    if (!msg) {
+      DEBUG0("{}", "client: server disconnected before answering extensions");
+      return false;
+    }
+    if (msg->Is(Message::kKeepAlive)) {
+      continue;
+    }
+    if (sessions && msg->Is(Message::kSession)) {
+      session = msg->id();
+      sessions = false;
+      got_session = true;
+    } else if (!sessions && datagrams && msg->Is(Message::kDatagramLane)) {
+      datagram_token = msg->id();
+      datagrams = false;
+    } else {
+      DEBUG0("client: received message ({}) other than extension answer",
+             msg->type());
+      return false;
+    }
+  }
+  if (datagram_token != 0) {
+    EnableDatagrams(conn, datagram_token, true, conn.stream().getPeerIP(),
+                    conn.stream().getPeerPort());
+  }
+
+  {
+    std::scoped_lock lock(m_user_mutex);
+    if (got_session) {
+      m_have_client_session = true;
+      m_client_session = session;
+      m_client_session_ip = conn.stream().getPeerIP();
+      m_client_session_port = conn.stream().getPeerPort();
+    }
+    // catch up with subscriptions changed during the handshake
+    m_client_subscribe_ext = subscribe_ext;
+    if (subscribe_ext && m_client_subscriptions != subscriptions) {
+      conn.QueueOutgoing(Message::Subscribe(m_client_subscriptions));
+    }
+  }
 
   INFO("client: CONNECTED to server {} port {}", conn.stream().getPeerIP(),
        conn.stream().getPeerPort());
@@ -618,37 +1130,33 @@ bool DispatcherBase::ServerHandshake(
     return false;
   }
 
-  // Check that the client requested version is not too high.
-  unsigned int proto_rev = msg->id();
-  if (proto_rev > 0x0300) {
-    DEBUG0("{}", "server: client requested proto > 0x0300");
-    auto toSend = Message::ProtoUnsup();
-    send_msgs(wpi::span(&toSend, 1));
-    return false;
+  // A client resuming a session follows the hello with its digest.
+  std::shared_ptr<Message> session;
+  if (msg->id() >= 0x0300 &&
+      (msg->flags() & Message::kSessionResumeExt) != 0) {
+    conn.set_proto_rev(msg->id());
+    session = get_msg();
+    if (!session || !session->Is(Message::kSession)) {
+      DEBUG0("{}", "server: client hello not followed by session");
+      return false;
+    }
   }
 
-  if (proto_rev >= 0x0300) {
-    conn.set_remote_id(msg->str());
+  // Offer a datagram lane if we have a socket
+  bool datagrams;
+  {
+    std::scoped_lock lock(m_user_mutex);
+    datagrams = m_datagram_socket != nullptr;
   }
 
-  // Set the proto version to the client requested version
-  DEBUG0("server: client protocol {}", proto_rev);
-  conn.set_proto_rev(proto_rev);
-
   // Send initial set of assignments
   NetworkConnection::Outgoing outgoing;
-
-  // Start with server hello.  TODO: initial connection flag
-  if (proto_rev >= 0x0300) {
-    std::scoped_lock lock(m_user_mutex);
-    outgoing.emplace_back(Message::ServerHello(0u, m_identity));
+  if (!ServerHandshakeHello(conn, *msg, session.get(), &outgoing,
+                            datagrams)) {
+    send_msgs(outgoing);
+    return false;
   }
-
-  // Get snapshot of initial assignments
-  m_storage.GetInitialAssignments(conn, &outgoing);
-
-  // Finish with server hello done
-  outgoing.emplace_back(Message::ServerHelloDone());
+  unsigned int proto_rev = conn.proto_rev();
 
   // Batch transmit
   DEBUG0("{}", "server: sending initial assignments");
@@ -658,9 +1166,11 @@ bool DispatcherBase::ServerHandshake(
   // done message, so we can batch the assigns before marking the connection
   // active.  In pre-3.0, we need to just immediately mark it active and hand
   // off control to the dispatcher to assign them as they arrive.
+  uint32_t datagram_token = 0;
   if (proto_rev >= 0x0300) {
     // receive client initial assignments
     std::vector<std::shared_ptr<Message>> incoming;
+    unsigned int ext_flags = 0;
     msg = get_msg();
     for (;;) {
       if (!msg) {
@@ -676,7 +1186,15 @@ bool DispatcherBase::ServerHandshake(
         msg = get_msg();
         continue;
       }
-      if (!msg->Is(Message::kEntryAssign)) {
+      if (msg->Is(Message::kExtensions)) {
+        ext_flags = msg->flags();
+        conn.set_array_deltas((ext_flags & Message::kArrayDeltaExt) != 0);
+        conn.set_time_sync((ext_flags & Message::kTimeSyncExt) != 0, false);
+        msg = get_msg();
+        continue;
+      }
+      // subscriptions are processed in order with the assignments
+      if (!msg->Is(Message::kEntryAssign) && !msg->Is(Message::kSubscribe)) {
         // unexpected message
         DEBUG0(
             "server: received message ({}) other than entry assignment during "
@@ -688,16 +1206,122 @@ bool DispatcherBase::ServerHandshake(
       // get the next message (blocks)
       msg = get_msg();
     }
+
+    // pick a token for the datagram lane if the client asked for one
+    if (datagrams && (ext_flags & Message::kDatagramExt) != 0) {
+      std::scoped_lock lock(m_user_mutex);
+      std::random_device rd;
+      do {
+        datagram_token = rd();
+      } while (datagram_token == 0 ||
+               m_datagram_conns.find(datagram_token) !=
+                   m_datagram_conns.end());
+    }
+    outgoing.clear();
+    ServerHandshakeExtensions(conn, ext_flags, &outgoing, datagram_token);
+    if (!outgoing.empty()) {
+      send_msgs(outgoing);
+    }
+
     for (auto& msg : incoming) {
       m_storage.ProcessIncoming(msg, &conn, std::weak_ptr<NetworkConnection>());
     }
   }
 
+  if (datagram_token != 0) {
+    EnableDatagrams(conn, datagram_token, false);
+  }
+
   INFO("server: client CONNECTED: {} port {}", conn.stream().getPeerIP(),
        conn.stream().getPeerPort());
   return true;
 }
 
+template <typename Conn>
+bool DispatcherBase::ServerHandshakeHello(
+    Conn& conn, const Message& hello, const Message* session,
+    std::vector<std::shared_ptr<Message>>* outgoing, bool datagrams) {
+  // Check that the client requested version is not too high.
+  unsigned int proto_rev = hello.id();
+  if (proto_rev > 0x0300) {
+    DEBUG0("{}", "server: client requested proto > 0x0300");
+    outgoing->emplace_back(Message::ProtoUnsup());
+    return false;
+  }
+
+  if (proto_rev >= 0x0300) {
+    conn.set_remote_id(hello.str());
+  }
+
+  // Set the proto version to the client requested version
+  DEBUG0("server: client protocol {}", proto_rev);
+  conn.set_proto_rev(proto_rev);
+
+  if (proto_rev < 0x0300) {
+    m_storage.GetInitialAssignments(conn, outgoing);
+    outgoing->emplace_back(Message::ServerHelloDone());
+    return true;
+  }
+
+  // advertise the extensions the client can enable with EXTENSIONS
+  unsigned int flags = Message::kArrayDeltaExt | Message::kTimeSyncExt |
+                       Message::kSessionExt | Message::kSubscribeExt;
+  if (m_compression) {
+    flags |= Message::kCompressionExt;
+  }
+  if (datagrams) {
+    flags |= Message::kDatagramExt;
+  }
+  if (m_compression && (hello.flags() & Message::kCompressionExt) != 0) {
+    // compress everything from the server hello on
+    conn.set_compression(true);
+  }
+  std::string self_id;
+  uint32_t server_session;
+  {
+    std::scoped_lock lock(m_user_mutex);
+    self_id = m_identity;
+    server_session = m_server_session;
+  }
+
+  // Get snapshot of initial assignments, or just the changes if the client
+  // is resuming a session with this server.
+  std::vector<std::shared_ptr<Message>> assignments;
+  if (session && session->id() == server_session &&
+      m_storage.GetResumeAssignments(conn, session->str(), &assignments)) {
+    DEBUG0("server: resuming session, sending {} changed entries",
+           assignments.size());
+    flags |= Message::kSessionResumeExt;
+  } else {
+    assignments.clear();
+    m_storage.GetInitialAssignments(conn, &assignments);
+  }
+
+  // Start with server hello.  TODO: initial connection flag
+  outgoing->emplace_back(Message::ServerHello(flags, self_id));
+  outgoing->insert(outgoing->end(), assignments.begin(), assignments.end());
+
+  // Finish with server hello done
+  outgoing->emplace_back(Message::ServerHelloDone());
+  return true;
+}
+
+template <typename Conn>
+void DispatcherBase::ServerHandshakeExtensions(
+    Conn& conn, unsigned int flags,
+    std::vector<std::shared_ptr<Message>>* outgoing, uint32_t datagram_token) {
+  if (m_compression && (flags & Message::kCompressionExt) != 0) {
+    conn.set_compression(true);
+  }
+  if ((flags & Message::kSessionExt) != 0) {
+    std::scoped_lock lock(m_user_mutex);
+    outgoing->emplace_back(Message::Session(m_server_session, {}));
+  }
+  if (datagram_token != 0) {
+    outgoing->emplace_back(Message::DatagramLane(datagram_token));
+  }
+}
+
 void DispatcherBase::ClientReconnect(unsigned int proto_rev) {
   if ((m_networkMode & NT_NET_MODE_SERVER) != 0) {
     return;
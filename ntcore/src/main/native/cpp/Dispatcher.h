@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include <wpi/DenseMap.h>
 #include <wpi/condition_variable.h>
 #include <wpi/mutex.h>
 #include <wpi/span.h>
@@ -22,13 +23,18 @@
 #include "INetworkConnection.h"
 
 namespace wpi {
+class EventLoopRunner;
 class Logger;
 class NetworkAcceptor;
 class NetworkStream;
+namespace uv {
+class Tcp;
+}  // namespace uv
 }  // namespace wpi
 
 namespace nt {
 
+class DatagramSocket;
 class IConnectionNotifier;
 class IStorage;
 class NetworkConnection;
@@ -45,15 +51,29 @@ class DispatcherBase : public IDispatcher {
 
   unsigned int GetNetworkMode() const;
   void StartLocal();
+  // If datagram_port is nonzero and datagrams are enabled, the server also
+  // listens for datagrams on it.
   void StartServer(std::string_view persist_filename,
-                   std::unique_ptr<wpi::NetworkAcceptor> acceptor);
+                   std::unique_ptr<wpi::NetworkAcceptor> acceptor,
+                   std::string_view datagram_address = {},
+                   unsigned int datagram_port = 0);
+  // Start a server that runs all client connections on one event loop thread.
+  void StartServerLoop(std::string_view persist_filename,
+                       std::string_view listen_address, unsigned int port);
   void StartClient();
   void Stop();
   void SetUpdateRate(double interval);
+  void SetServerEventLoop(bool enabled) { m_server_event_loop = enabled; }
+  bool GetServerEventLoop() const { return m_server_event_loop; }
+  void SetPersistentJournal(bool enabled) { m_persist_journal = enabled; }
+  void SetNetworkCompression(bool enabled) { m_compression = enabled; }
+  void SetNetworkDatagrams(bool enabled) { m_datagrams = enabled; }
   void SetIdentity(std::string_view name);
+  void SetClientSubscriptions(wpi::span<const std::string_view> prefixes);
   void Flush();
   std::vector<ConnectionInfo> GetConnections() const;
   bool IsConnected() const;
+  bool GetServerTimeOffset(int64_t* offset) const;
 
   unsigned int AddListener(
       std::function<void(const ConnectionNotification& event)> callback,
@@ -75,6 +95,19 @@ class DispatcherBase : public IDispatcher {
   void ServerThreadMain();
   void ClientThreadMain();
 
+  bool StartServerCommon(std::string_view persist_filename);
+  void ServerLoopAccept(wpi::uv::Tcp& server);
+  // Must be called with m_user_mutex held
+  void AddServerConnection(std::shared_ptr<INetworkConnection> conn);
+
+  // Starts sending unreliable updates on conn as datagrams for token.
+  // addr and port are the server's, on a client.
+  void EnableDatagrams(NetworkConnection& conn, uint32_t token, bool client,
+                       std::string_view addr = {}, int port = 0);
+  // Called by the datagram socket's thread.
+  void ReceiveDatagram(std::string_view data, std::string_view addr,
+                       int port);
+
   bool ClientHandshake(
       NetworkConnection& conn,
       std::function<std::shared_ptr<Message>()> get_msg,
@@ -83,20 +116,65 @@ class DispatcherBase : public IDispatcher {
       NetworkConnection& conn,
       std::function<std::shared_ptr<Message>()> get_msg,
       std::function<void(wpi::span<std::shared_ptr<Message>>)> send_msgs);
+  // Handles the client hello for either connection type.  Returns false if
+  // the connection should be dropped after sending outgoing.
+  // session is the SESSION message that followed the hello, if any.
+  // datagrams is true if the connection can have a datagram lane.
+  template <typename Conn>
+  bool ServerHandshakeHello(Conn& conn, const Message& hello,
+                            const Message* session,
+                            std::vector<std::shared_ptr<Message>>* outgoing,
+                            bool datagrams = false);
+  // Enables the extensions the client requested with EXTENSIONS, once its
+  // hello done arrives, and fills in the messages that answer them.
+  // datagram_token is nonzero if the connection gets a datagram lane.
+  template <typename Conn>
+  void ServerHandshakeExtensions(
+      Conn& conn, unsigned int flags,
+      std::vector<std::shared_ptr<Message>>* outgoing,
+      uint32_t datagram_token = 0);
 
   void ClientReconnect(unsigned int proto_rev = 0x0300);
 
   void QueueOutgoing(std::shared_ptr<Message> msg, INetworkConnection* only,
                      INetworkConnection* except) override;
+  void QueueOutgoingUpdate(unsigned int id, unsigned int seq_num,
+                           std::shared_ptr<Value> value,
+                           unsigned int priority) override;
+  void QueueOutgoingBatch(wpi::span<Outgoing> batch) override;
+  void FlushOutgoing() override;
+  void ClearPendingUpdates() override;
+  void ClearPendingUpdate(unsigned int id) override;
+
+  // Must be called with m_user_mutex held
+  void QueueOutgoingLocked(std::shared_ptr<Message> msg,
+                           INetworkConnection* only,
+                           INetworkConnection* except);
+  void QueueOutgoingUpdateLocked(unsigned int id, unsigned int seq_num,
+                                 std::shared_ptr<Value> value,
+                                 unsigned int priority);
+  void FlushPendingUpdate(unsigned int id);
+  // Low priority updates are kept pending unless low_priority is true.
+  void FlushPendingUpdates(bool low_priority = true);
+  // Drops all pending updates, for when the connections they were queued
+  // for are replaced.
+  void ClearPendingUpdatesLocked();
+  void QueueOutgoingImpl(std::shared_ptr<Message> msg,
+                         INetworkConnection* only, INetworkConnection* except);
 
   IStorage& m_storage;
   IConnectionNotifier& m_notifier;
   unsigned int m_networkMode = NT_NET_MODE_NONE;
   std::string m_persist_filename;
+  std::atomic_bool m_persist_journal{false};
   std::thread m_dispatch_thread;
   std::thread m_clientserver_thread;
 
   std::unique_ptr<wpi::NetworkAcceptor> m_server_acceptor;
+  std::unique_ptr<wpi::EventLoopRunner> m_server_loop;
+  std::atomic_bool m_server_event_loop{false};
+  std::atomic_bool m_compression{false};
+  std::atomic_bool m_datagrams{false};
   Connector m_client_connector_override;
   Connector m_client_connector;
   uint8_t m_connections_uid = 0;
@@ -106,6 +184,42 @@ class DispatcherBase : public IDispatcher {
   std::vector<std::shared_ptr<INetworkConnection>> m_connections;
   std::string m_identity;
 
+  // Session token of this server, or on a client, of the server last
+  // connected to (if it supports sessions) and that server's address.  A
+  // client's session is cleared while it is connecting, so a failed resume
+  // isn't tried again.
+  uint32_t m_server_session = 0;
+  bool m_have_client_session = false;
+  uint32_t m_client_session = 0;
+  std::string m_client_session_ip;
+  int m_client_session_port = 0;
+
+  // Prefixes a client subscribes to (everything if empty), and whether the
+  // server it is connected to supports changing them.
+  std::vector<std::string> m_client_subscriptions;
+  bool m_client_subscribe_ext = false;
+
+  // Datagram lane socket (the server's, or one kept across a client's
+  // connections) and the connections it carries, by token.
+  std::shared_ptr<DatagramSocket> m_datagram_socket;
+  wpi::DenseMap<uint32_t, std::weak_ptr<NetworkConnection>> m_datagram_conns;
+
+  // Value updates coalesced by id between dispatches (uses user mutex).
+  // Only the latest value for each id is turned into a message.  Low
+  // priority updates are only sent every kLowPriorityDivisor update periods.
+  static constexpr unsigned int kLowPriorityDivisor = 5;
+  struct PendingUpdate {
+    bool pending = false;
+    unsigned int seq_num = 0;
+    unsigned int priority = NT_PRIORITY_NORMAL;
+    // Boolean and double values are copied here rather than referenced, so
+    // that Storage can keep updating its own copy in place.
+    NT_Value scalar{};
+    std::shared_ptr<Value> value;
+  };
+  std::vector<PendingUpdate> m_pending_updates;
+  std::vector<unsigned int> m_pending_ids;
+
   std::atomic_bool m_active;       // set to false to terminate threads
   std::atomic_uint m_update_rate;  // periodic dispatch update rate, in ms
 
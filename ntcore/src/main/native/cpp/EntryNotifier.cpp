@@ -4,6 +4,10 @@
 
 #include "EntryNotifier.h"
 
+#include <algorithm>
+#include <climits>
+#include <tuple>
+
 #include <wpi/StringExtras.h>
 
 #include "Log.h"
@@ -23,6 +27,18 @@ bool EntryNotifier::local_notifiers() const {
   return m_local_notifiers;
 }
 
+bool impl::EntryNotifierThread::Coalesce(EntryNotification* queued,
+                                         const EntryNotification& data) {
+  // a poller always sees an entry go away, so deletes are never merged
+  if (queued->listener != data.listener || queued->entry != data.entry ||
+      ((queued->flags | data.flags) & NT_NOTIFY_DELETE) != 0) {
+    return false;
+  }
+  queued->value = data.value;
+  queued->flags |= data.flags;
+  return true;
+}
+
 bool impl::EntryNotifierThread::Matches(const EntryListenerData& listener,
                                         const EntryNotification& data) {
   if (!data.value) {
@@ -58,6 +74,90 @@ bool impl::EntryNotifierThread::Matches(const EntryListenerData& listener,
   return true;
 }
 
+unsigned int impl::EntryNotifierThread::FindPrefixChild(unsigned int node,
+                                                       char ch) const {
+  for (auto&& child : m_prefix_nodes[node].children) {
+    if (child.first == ch) {
+      return child.second;
+    }
+  }
+  return UINT_MAX;
+}
+
+void impl::EntryNotifierThread::ListenerAdded(unsigned int listener_uid) {
+  auto& listener = m_listeners[listener_uid];
+  if (listener.entry != 0) {
+    m_entry_listeners[listener.entry].push_back(listener_uid);
+    return;
+  }
+
+  // walk the trie, creating nodes as needed
+  unsigned int node = 0;
+  for (char ch : listener.prefix) {
+    unsigned int child = FindPrefixChild(node, ch);
+    if (child == UINT_MAX) {
+      child = m_prefix_nodes.size();
+      m_prefix_nodes[node].children.emplace_back(ch, child);
+      m_prefix_nodes.emplace_back();
+    }
+    node = child;
+  }
+  m_prefix_nodes[node].listeners.push_back(listener_uid);
+}
+
+void impl::EntryNotifierThread::ListenerRemoved(unsigned int listener_uid) {
+  auto& listener = m_listeners[listener_uid];
+  if (listener.entry != 0) {
+    auto it = m_entry_listeners.find(listener.entry);
+    if (it == m_entry_listeners.end()) {
+      return;
+    }
+    auto& uids = it->second;
+    uids.erase(std::remove(uids.begin(), uids.end(), listener_uid),
+               uids.end());
+    if (uids.empty()) {
+      m_entry_listeners.erase(it);
+    }
+    return;
+  }
+
+  unsigned int node = 0;
+  for (char ch : listener.prefix) {
+    node = FindPrefixChild(node, ch);
+    if (node == UINT_MAX) {
+      return;
+    }
+  }
+  auto& uids = m_prefix_nodes[node].listeners;
+  uids.erase(std::remove(uids.begin(), uids.end(), listener_uid), uids.end());
+}
+
+void impl::EntryNotifierThread::GetCandidates(
+    const EntryNotification& data, std::vector<unsigned int>* candidates) {
+  auto it = m_entry_listeners.find(data.entry);
+  if (it != m_entry_listeners.end()) {
+    candidates->insert(candidates->end(), it->second.begin(),
+                       it->second.end());
+  }
+
+  // every node on the path to the name is a matching prefix
+  unsigned int node = 0;
+  for (size_t i = 0;; ++i) {
+    auto& uids = m_prefix_nodes[node].listeners;
+    candidates->insert(candidates->end(), uids.begin(), uids.end());
+    if (i == data.name.size()) {
+      break;
+    }
+    node = FindPrefixChild(node, data.name[i]);
+    if (node == UINT_MAX) {
+      break;
+    }
+  }
+
+  // notify in the order listeners were added, as a linear scan would
+  std::sort(candidates->begin(), candidates->end());
+}
+
 unsigned int EntryNotifier::Add(
     std::function<void(const EntryNotification& event)> callback,
     std::string_view prefix, unsigned int flags) {
@@ -107,3 +207,21 @@ void EntryNotifier::NotifyEntry(unsigned int local_id, std::string_view name,
   Send(only_listener, 0, Handle(m_inst, local_id, Handle::kEntry).handle(),
        name, value, flags);
 }
+
+void EntryNotifier::NotifyEntries(wpi::span<const Notification> notifications) {
+  // same as NotifyEntry(), but with a single queue push and wakeup
+  auto thr = GetThreadSharedPtr();
+  if (!thr || !thr->m_active || !thr->m_hasListeners) {
+    return;
+  }
+  impl::EntryNotifierThread::PendingBatch batch;
+  for (auto& n : notifications) {
+    if ((n.flags & NT_NOTIFY_LOCAL) != 0 && !m_local_notifiers) {
+      continue;
+    }
+    DEBUG0("notifying '{}' (local={}), flags={}", n.name, n.local_id, n.flags);
+    batch.Add(UINT_MAX, 0, Handle(m_inst, n.local_id, Handle::kEntry).handle(),
+              n.name, n.value, n.flags);
+  }
+  thr->Enqueue(std::move(batch));
+}
@@ -9,8 +9,12 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <wpi/CallbackManager.h>
+#include <wpi/DenseMap.h>
+#include <wpi/SmallVector.h>
 
 #include "Handle.h"
 #include "IEntryNotifier.h"
@@ -52,11 +56,18 @@ class EntryNotifierThread
     : public wpi::CallbackThread<EntryNotifierThread, EntryNotification,
                                  EntryListenerData> {
  public:
-  explicit EntryNotifierThread(int inst) : m_inst(inst) {}
+  explicit EntryNotifierThread(int inst) : m_inst(inst), m_prefix_nodes(1) {}
 
   bool Matches(const EntryListenerData& listener,
                const EntryNotification& data);
 
+  void ListenerAdded(unsigned int listener_uid);
+  void ListenerRemoved(unsigned int listener_uid);
+  void GetCandidates(const EntryNotification& data,
+                     std::vector<unsigned int>* candidates);
+
+  bool Coalesce(EntryNotification* queued, const EntryNotification& data);
+
   void SetListener(EntryNotification* data, unsigned int listener_uid) {
     data->listener =
         Handle(m_inst, listener_uid, Handle::kEntryListener).handle();
@@ -68,6 +79,22 @@ class EntryNotifierThread
   }
 
   int m_inst;
+
+ private:
+  unsigned int FindPrefixChild(unsigned int node, char ch) const;
+
+  // Listeners on a single entry, keyed by entry handle.
+  wpi::DenseMap<NT_Entry, wpi::SmallVector<unsigned int, 2>> m_entry_listeners;
+
+  // Listeners on a prefix, stored in a trie so that only the listeners whose
+  // prefix actually matches a name need to be visited.  Node 0 is the root
+  // (empty prefix).  Nodes are never freed, as the number of distinct
+  // prefixes is small.
+  struct PrefixNode {
+    wpi::SmallVector<std::pair<char, unsigned int>, 2> children;
+    wpi::SmallVector<unsigned int, 2> listeners;
+  };
+  std::vector<PrefixNode> m_prefix_nodes;
 };
 
 }  // namespace impl
@@ -97,6 +124,7 @@ class EntryNotifier
   void NotifyEntry(unsigned int local_id, std::string_view name,
                    std::shared_ptr<Value> value, unsigned int flags,
                    unsigned int only_listener = UINT_MAX) override;
+  void NotifyEntries(wpi::span<const Notification> notifications) override;
 
  private:
   int m_inst;
@@ -6,6 +6,9 @@
 #define NTCORE_IDISPATCHER_H_
 
 #include <memory>
+#include <utility>
+
+#include <wpi/span.h>
 
 #include "Message.h"
 
@@ -24,6 +27,50 @@ class IDispatcher {
   virtual void QueueOutgoing(std::shared_ptr<Message> msg,
                              INetworkConnection* only,
                              INetworkConnection* except) = 0;
+
+  // Queue a value update to all connections.  Implementations may coalesce
+  // multiple updates to the same id between flushes, so only the latest
+  // value is sent.  Low priority (NT_EntryPriority) updates may be held
+  // for longer.
+  virtual void QueueOutgoingUpdate(unsigned int id, unsigned int seq_num,
+                                   std::shared_ptr<Value> value,
+                                   unsigned int /*priority*/) {
+    QueueOutgoing(Message::EntryUpdate(id, seq_num, std::move(value)), nullptr,
+                  nullptr);
+  }
+
+  // One message for QueueOutgoingBatch(): msg if set, otherwise a value
+  // update as for QueueOutgoingUpdate().
+  struct Outgoing {
+    std::shared_ptr<Message> msg;
+    unsigned int id = 0;
+    unsigned int seq_num = 0;
+    std::shared_ptr<Value> value;
+    unsigned int priority = NT_PRIORITY_NORMAL;
+  };
+
+  // Queue several messages to all connections, in order.  Implementations
+  // may queue them all at once.
+  virtual void QueueOutgoingBatch(wpi::span<Outgoing> batch) {
+    for (auto& out : batch) {
+      if (out.msg) {
+        QueueOutgoing(std::move(out.msg), nullptr, nullptr);
+      } else {
+        QueueOutgoingUpdate(out.id, out.seq_num, std::move(out.value),
+                            out.priority);
+      }
+    }
+  }
+
+  // Drop coalesced updates that haven't been sent yet, for every id or for
+  // one id, when the ids they were queued under are no longer assigned.
+  virtual void ClearPendingUpdates() {}
+  virtual void ClearPendingUpdate(unsigned int /*id*/) {}
+
+  // Send queued messages without waiting for the next periodic update.
+  // Unlike a user flush, this is not rate limited; requests made while a
+  // send is in progress are coalesced into the next one.
+  virtual void FlushOutgoing() {}
 };
 
 }  // namespace nt
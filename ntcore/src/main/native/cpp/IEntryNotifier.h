@@ -9,6 +9,8 @@
 #include <memory>
 #include <string_view>
 
+#include <wpi/span.h>
+
 #include "ntcore_cpp.h"
 
 namespace nt {
@@ -36,6 +38,22 @@ class IEntryNotifier {
   virtual void NotifyEntry(unsigned int local_id, std::string_view name,
                            std::shared_ptr<Value> value, unsigned int flags,
                            unsigned int only_listener = UINT_MAX) = 0;
+
+  // One notification for NotifyEntries().
+  struct Notification {
+    unsigned int local_id;
+    std::string_view name;
+    std::shared_ptr<Value> value;
+    unsigned int flags;
+  };
+
+  // Same as calling NotifyEntry() for each notification, but implementations
+  // may queue them all at once.
+  virtual void NotifyEntries(wpi::span<const Notification> notifications) {
+    for (auto& n : notifications) {
+      NotifyEntry(n.local_id, n.name, n.value, n.flags);
+    }
+  }
 };
 
 }  // namespace nt
@@ -5,9 +5,12 @@
 #ifndef NTCORE_INETWORKCONNECTION_H_
 #define NTCORE_INETWORKCONNECTION_H_
 
+#include <stdint.h>
+
 #include <memory>
 
 #include "Message.h"
+#include "SubscriptionFilter.h"
 #include "ntcore_cpp.h"
 
 namespace nt {
@@ -31,6 +34,17 @@ class INetworkConnection {
 
   virtual State state() const = 0;
   virtual void set_state(State state) = 0;
+
+  // Gets the estimated server time minus local time (time sync extension).
+  // Returns false if it isn't known.
+  virtual bool server_time_offset(int64_t* offset) const { return false; }
+
+  // The entries the remote subscribed to; QueueOutgoing() drops messages for
+  // the others.
+  SubscriptionFilter& subscriptions() { return m_subscriptions; }
+
+ private:
+  SubscriptionFilter m_subscriptions;
 };
 
 }  // namespace nt
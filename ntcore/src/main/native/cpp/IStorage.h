@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -44,17 +45,38 @@ class IStorage {
   virtual void GetInitialAssignments(
       INetworkConnection& conn,
       std::vector<std::shared_ptr<Message>>* msgs) = 0;
+  // Like GetInitialAssignments(), but only for the entries that differ from
+  // a client's session digest, preceded by deletes for the entries in it that
+  // no longer exist.  Returns false if the digest is malformed.
+  virtual bool GetResumeAssignments(
+      INetworkConnection& conn, std::string_view digest,
+      std::vector<std::shared_ptr<Message>>* msgs) = 0;
+  // Gets the client's session digest: the id, sequence number and flags of
+  // each assigned entry.
+  virtual void GetSessionDigest(std::string* digest) const = 0;
+  // If resume_digest is not empty, msgs came from GetResumeAssignments() for
+  // that digest, so entries it doesn't mention are kept.
   virtual void ApplyInitialAssignments(
       INetworkConnection& conn, wpi::span<std::shared_ptr<Message>> msgs,
-      bool new_server, std::vector<std::shared_ptr<Message>>* out_msgs) = 0;
+      bool new_server, std::string_view resume_digest,
+      std::vector<std::shared_ptr<Message>>* out_msgs) = 0;
 
   // Filename-based save/load functions.  Used both by periodic saves and
   // accessible directly via the user API.
   virtual const char* SavePersistent(std::string_view filename,
                                      bool periodic) const = 0;
+  virtual const char* SavePersistentJournal(std::string_view filename,
+                                            bool periodic) const = 0;
   virtual const char* LoadPersistent(
       std::string_view filename,
       std::function<void(size_t line, const char* msg)> warn) = 0;
+
+  // Sets the entries whose values were published through in-process channels
+  // since the last call.  While periodic mirroring is on, the dispatcher
+  // thread calls this before each update; otherwise values are mirrored as
+  // they are published.
+  virtual void MirrorLocalChannels() = 0;
+  virtual void SetPeriodicMirror(bool periodic) = 0;
 };
 
 }  // namespace nt
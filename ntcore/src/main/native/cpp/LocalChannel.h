@@ -0,0 +1,140 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_LOCALCHANNEL_H_
+#define NTCORE_LOCALCHANNEL_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "networktables/NetworkTableValue.h"
+
+namespace nt {
+
+/* An entry's in-process channel: a mailbox holding the entry's latest value
+ * that publishers and readers in this process use without the storage lock.
+ * Every store increments a sequence number, which readers compare against
+ * the last one they saw.  Values published here are marked dirty until
+ * Storage mirrors them to the entry; values set through Storage are
+ * delivered here.  Readers are lock-free; writers serialize on a per-channel
+ * mutex, which is uncontended with a single publisher.
+ */
+class LocalChannel {
+ public:
+  explicit LocalChannel(unsigned int local_id_) : local_id{local_id_} {}
+
+  // Stores a value published in this process.  Returns true if the channel
+  // was not already waiting to be mirrored, so the caller must queue it.
+  bool Publish(std::shared_ptr<Value> value) {
+    bool queue;
+    {
+      std::scoped_lock lock(m_write_mutex);
+      std::atomic_store(&m_value, std::move(value));
+      queue = !m_dirty;
+      m_dirty = true;
+    }
+    Changed();
+    return queue;
+  }
+
+  // Stores a value set through Storage, unless it is already current (e.g.
+  // it was mirrored from here) or a value published here is waiting to be
+  // mirrored, which will replace it.  Called with the storage lock held.
+  void Deliver(const std::shared_ptr<Value>& value) {
+    {
+      std::scoped_lock lock(m_write_mutex);
+      if (m_dirty || std::atomic_load(&m_value) == value) {
+        return;
+      }
+      std::atomic_store(&m_value, value);
+    }
+    Changed();
+  }
+
+  // Clears the dirty mark and gets the value to mirror.  A value published
+  // after this marks the channel dirty again.
+  std::shared_ptr<Value> TakeDirty() {
+    std::scoped_lock lock(m_write_mutex);
+    m_dirty = false;
+    return std::atomic_load(&m_value);
+  }
+
+  std::shared_ptr<Value> GetValue() const { return std::atomic_load(&m_value); }
+
+  // Gets the value if the sequence number differs from *seq, and updates
+  // *seq.  Returns false if there is no new value.
+  bool Read(uint64_t* seq, std::shared_ptr<Value>* value) const {
+    uint64_t cur = m_seq.load();
+    if (cur == *seq) {
+      return false;
+    }
+    // the value may be newer than cur, in which case it is read again
+    *value = std::atomic_load(&m_value);
+    *seq = cur;
+    return true;
+  }
+
+  // Like Read(), but waits for a new value (forever if timeout is negative),
+  // or until Wake() is called with terminating set.
+  bool Wait(uint64_t* seq, std::shared_ptr<Value>* value, double timeout,
+            const std::atomic_bool& terminating) {
+    if (Read(seq, value)) {
+      return true;
+    }
+    auto ready = [&] { return terminating || m_seq.load() != *seq; };
+    ++m_waiters;
+    {
+      std::unique_lock lock(m_wait_mutex);
+      if (timeout < 0) {
+        m_wait_cv.wait(lock, ready);
+      } else {
+        m_wait_cv.wait_for(lock, std::chrono::duration<double>(timeout),
+                           ready);
+      }
+    }
+    --m_waiters;
+    return !terminating && Read(seq, value);
+  }
+
+  // Wakes blocked readers, e.g. on shutdown.
+  void Wake() {
+    std::scoped_lock lock(m_wait_mutex);
+    m_wait_cv.notify_all();
+  }
+
+  const unsigned int local_id;
+
+  // Next channel in Storage's list of dirty channels.
+  LocalChannel* next_dirty = nullptr;
+
+ private:
+  void Changed() {
+    // sequentially consistent with the waiter count, so either the reader
+    // sees the new sequence number or the publisher sees the reader
+    m_seq.fetch_add(1);
+    if (m_waiters.load() != 0) {
+      Wake();
+    }
+  }
+
+  // only accessed with std::atomic_load() and std::atomic_store()
+  std::shared_ptr<Value> m_value;
+  std::atomic<uint64_t> m_seq{0};
+  wpi::mutex m_write_mutex;
+  bool m_dirty = false;
+  std::atomic<int> m_waiters{0};
+  wpi::mutex m_wait_mutex;
+  wpi::condition_variable m_wait_cv;
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_LOCALCHANNEL_H_
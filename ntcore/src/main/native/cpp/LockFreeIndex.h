@@ -0,0 +1,66 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_LOCKFREEINDEX_H_
+#define NTCORE_LOCKFREEINDEX_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace nt {
+
+/* A table of pointers indexed by small integers that can be read without a
+ * lock.  Storage is allocated in fixed chunks that never move, so growing
+ * the table doesn't invalidate concurrent reads.  Set() calls must be
+ * serialized by the caller; indexes at or beyond kCapacity are ignored.
+ */
+template <typename T, size_t kChunkSize = 1024, size_t kChunks = 64>
+class LockFreeIndex {
+ public:
+  static constexpr size_t kCapacity = kChunkSize * kChunks;
+
+  LockFreeIndex() = default;
+  LockFreeIndex(const LockFreeIndex&) = delete;
+  LockFreeIndex& operator=(const LockFreeIndex&) = delete;
+
+  ~LockFreeIndex() {
+    for (auto& chunk : m_chunks) {
+      delete[] chunk.load(std::memory_order_relaxed);
+    }
+  }
+
+  void Set(size_t index, T* value) {
+    if (index >= kCapacity) {
+      return;
+    }
+    auto& chunk = m_chunks[index / kChunkSize];
+    auto slots = chunk.load(std::memory_order_relaxed);
+    if (!slots) {
+      slots = new std::atomic<T*>[kChunkSize];
+      for (size_t i = 0; i < kChunkSize; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+      chunk.store(slots, std::memory_order_release);
+    }
+    slots[index % kChunkSize].store(value, std::memory_order_release);
+  }
+
+  T* Get(size_t index) const {
+    if (index >= kCapacity) {
+      return nullptr;
+    }
+    auto slots = m_chunks[index / kChunkSize].load(std::memory_order_acquire);
+    if (!slots) {
+      return nullptr;
+    }
+    return slots[index % kChunkSize].load(std::memory_order_acquire);
+  }
+
+ private:
+  std::atomic<std::atomic<T*>*> m_chunks[kChunks] = {};
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_LOCKFREEINDEX_H_
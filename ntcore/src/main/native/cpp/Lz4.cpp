@@ -0,0 +1,166 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "Lz4.h"
+
+#include <stdint.h>
+
+#include <cstring>
+#include <memory>
+
+using namespace nt;
+
+// Format constants from the LZ4 block format specification
+static constexpr size_t kMinMatch = 4;
+// The last match must start at least this many bytes before the end
+static constexpr size_t kMatchStartLimit = 12;
+// The last bytes are always literals
+static constexpr size_t kLastLiterals = 5;
+static constexpr size_t kMaxOffset = 65535;
+
+static constexpr int kHashLog = 12;
+
+static uint32_t Read32(const char* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static uint32_t Hash(uint32_t v) {
+  return (v * 2654435761u) >> (32 - kHashLog);
+}
+
+// Writes the remainder of a length whose token nibble is 15
+static void WriteLength(wpi::SmallVectorImpl<char>& out, size_t len) {
+  len -= 15;
+  while (len >= 255) {
+    out.push_back(static_cast<char>(255));
+    len -= 255;
+  }
+  out.push_back(static_cast<char>(len));
+}
+
+static void WriteSequence(wpi::SmallVectorImpl<char>& out, const char* lit,
+                          size_t lit_len, size_t offset, size_t match_len) {
+  size_t ml = match_len - kMinMatch;
+  out.push_back(static_cast<char>(((lit_len < 15 ? lit_len : 15) << 4) |
+                                  (ml < 15 ? ml : 15)));
+  if (lit_len >= 15) {
+    WriteLength(out, lit_len);
+  }
+  out.append(lit, lit + lit_len);
+  out.push_back(static_cast<char>(offset & 0xff));
+  out.push_back(static_cast<char>(offset >> 8));
+  if (ml >= 15) {
+    WriteLength(out, ml);
+  }
+}
+
+void nt::Lz4Compress(std::string_view in, wpi::SmallVectorImpl<char>& out) {
+  const char* base = in.data();
+  size_t size = in.size();
+  size_t anchor = 0;  // start of pending literals
+
+  if (size > kMatchStartLimit) {
+    // positions of recently seen 4-byte sequences, by hash
+    auto table = std::make_unique<uint32_t[]>(1 << kHashLog);
+    size_t match_limit = size - kLastLiterals;
+    size_t pos = 0;
+    while (pos + kMatchStartLimit <= size) {
+      uint32_t seq = Read32(base + pos);
+      uint32_t& slot = table[Hash(seq)];
+      size_t cand = slot;
+      slot = static_cast<uint32_t>(pos);
+      if (cand >= pos || pos - cand > kMaxOffset ||
+          Read32(base + cand) != seq) {
+        // skip ahead faster the longer nothing has matched
+        pos += 1 + ((pos - anchor) >> 6);
+        continue;
+      }
+      size_t len = kMinMatch;
+      while (pos + len < match_limit && base[cand + len] == base[pos + len]) {
+        ++len;
+      }
+      WriteSequence(out, base + anchor, pos - anchor, pos - cand, len);
+      pos += len;
+      anchor = pos;
+    }
+  }
+
+  // last literals
+  size_t lit_len = size - anchor;
+  out.push_back(static_cast<char>((lit_len < 15 ? lit_len : 15) << 4));
+  if (lit_len >= 15) {
+    WriteLength(out, lit_len);
+  }
+  out.append(base + anchor, base + size);
+}
+
+bool nt::Lz4Decompress(std::string_view in, size_t size, std::string* out) {
+  auto p = reinterpret_cast<const unsigned char*>(in.data());
+  auto end = p + in.size();
+  size_t start = out->size();
+  out->reserve(start + size);
+
+  auto read_length = [&](size_t* len) {
+    for (;;) {
+      if (p == end) {
+        return false;
+      }
+      unsigned int b = *p++;
+      *len += b;
+      if (b != 255) {
+        return true;
+      }
+    }
+  };
+
+  for (;;) {
+    if (p == end) {
+      return false;
+    }
+    unsigned int token = *p++;
+
+    // literals
+    size_t lit_len = token >> 4;
+    if (lit_len == 15 && !read_length(&lit_len)) {
+      return false;
+    }
+    if (lit_len > static_cast<size_t>(end - p) ||
+        lit_len > size - (out->size() - start)) {
+      return false;
+    }
+    out->append(reinterpret_cast<const char*>(p), lit_len);
+    p += lit_len;
+    if (p == end) {
+      break;  // the last sequence has no match
+    }
+
+    // match
+    if (end - p < 2) {
+      return false;
+    }
+    size_t offset = p[0] | (p[1] << 8);
+    p += 2;
+    size_t match_len = token & 15;
+    if (match_len == 15 && !read_length(&match_len)) {
+      return false;
+    }
+    match_len += kMinMatch;
+    size_t produced = out->size() - start;
+    if (offset == 0 || offset > produced || match_len > size - produced) {
+      return false;
+    }
+    size_t from = out->size() - offset;
+    if (offset >= match_len) {
+      out->append(*out, from, match_len);
+    } else {
+      // overlapping copy repeats the last offset bytes
+      for (size_t i = 0; i < match_len; ++i) {
+        out->push_back((*out)[from + i]);
+      }
+    }
+  }
+  return out->size() - start == size;
+}
@@ -0,0 +1,29 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_LZ4_H_
+#define NTCORE_LZ4_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <wpi/SmallVector.h>
+
+namespace nt {
+
+/* Compresses in as a single block in the LZ4 block format (no frame header or
+ * checksum), appending it to out.  Favors speed over compression ratio.
+ */
+void Lz4Compress(std::string_view in, wpi::SmallVectorImpl<char>& out);
+
+/* Decompresses an LZ4 block that expands to exactly size bytes, appending
+ * them to out.  Returns false if the block is malformed or does not expand
+ * to size bytes; out may then hold partial data.
+ */
+bool Lz4Decompress(std::string_view in, size_t size, std::string* out);
+
+}  // namespace nt
+
+#endif  // NTCORE_LZ4_H_
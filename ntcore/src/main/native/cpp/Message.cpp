@@ -14,6 +14,21 @@
 
 using namespace nt;
 
+// Reads a value time (time sync extension), converting it to the local time
+// base.  A zero time was never sent, so it is rejected.
+static bool ReadTime(WireDecoder& decoder, uint64_t* time) {
+  uint64_t wire_time;
+  if (!decoder.ReadUleb128(&wire_time)) {
+    return false;
+  }
+  if (wire_time == 0) {
+    decoder.set_error("received zero value time");
+    return false;
+  }
+  *time = decoder.FromWireTime(wire_time);
+  return true;
+}
+
 std::shared_ptr<Message> Message::Read(WireDecoder& decoder,
                                        GetEntryTypeFunc get_entry_type) {
   unsigned int msg_type = 0;
@@ -37,6 +52,15 @@ std::shared_ptr<Message> Message::Read(WireDecoder& decoder,
         if (!decoder.ReadString(&msg->m_str)) {
           return nullptr;
         }
+        // split off the flags
+        size_t size = msg->m_str.size();
+        if (size > kHelloFlagsMarker.size() &&
+            std::string_view{msg->m_str}
+                    .substr(size - kHelloFlagsMarker.size() - 1,
+                            kHelloFlagsMarker.size()) == kHelloFlagsMarker) {
+          msg->m_flags = static_cast<unsigned char>(msg->m_str.back());
+          msg->m_str.resize(size - kHelloFlagsMarker.size() - 1);
+        }
       }
       break;
     }
@@ -66,6 +90,91 @@ std::shared_ptr<Message> Message::Read(WireDecoder& decoder,
         return nullptr;
       }
       break;
+    case kExtensions:
+      if (decoder.proto_rev() < 0x0300u) {
+        decoder.set_error("received EXTENSIONS in protocol < 3.0");
+        return nullptr;
+      }
+      if (!decoder.Read8(&msg->m_flags)) {
+        return nullptr;
+      }
+      break;
+    case kCompressed: {
+      if (decoder.proto_rev() < 0x0300u) {
+        decoder.set_error("received COMPRESSED in protocol < 3.0");
+        return nullptr;
+      }
+      uint64_t size;
+      if (!decoder.ReadUleb128(&size)) {
+        return nullptr;
+      }
+      if (size > kMaxUncompressedSize) {
+        decoder.set_error("received COMPRESSED with excessive size");
+        return nullptr;
+      }
+      msg->m_id = size;
+      if (!decoder.ReadString(&msg->m_str)) {
+        return nullptr;
+      }
+      break;
+    }
+    case kSession: {
+      if (decoder.proto_rev() < 0x0300u) {
+        decoder.set_error("received SESSION in protocol < 3.0");
+        return nullptr;
+      }
+      uint32_t token;
+      if (!decoder.Read32(&token)) {
+        return nullptr;
+      }
+      msg->m_id = token;
+      if (!decoder.ReadString(&msg->m_str)) {
+        return nullptr;
+      }
+      break;
+    }
+    case kTimeSync:
+      if (decoder.proto_rev() < 0x0300u) {
+        decoder.set_error("received TIME_SYNC in protocol < 3.0");
+        return nullptr;
+      }
+      if (!decoder.ReadUleb128(&msg->m_client_time)) {
+        return nullptr;
+      }
+      if (!decoder.ReadUleb128(&msg->m_server_time)) {
+        return nullptr;
+      }
+      break;
+    case kDatagramLane: {
+      if (decoder.proto_rev() < 0x0300u) {
+        decoder.set_error("received DATAGRAM_LANE in protocol < 3.0");
+        return nullptr;
+      }
+      uint32_t token;
+      if (!decoder.Read32(&token)) {
+        return nullptr;
+      }
+      msg->m_id = token;
+      break;
+    }
+    case kSubscribe: {
+      if (decoder.proto_rev() < 0x0300u) {
+        decoder.set_error("received SUBSCRIBE in protocol < 3.0");
+        return nullptr;
+      }
+      uint64_t count;
+      if (!decoder.ReadUleb128(&count)) {
+        return nullptr;
+      }
+      std::vector<std::string> prefixes;
+      for (uint64_t i = 0; i < count; ++i) {
+        if (!decoder.ReadString(&prefixes.emplace_back())) {
+          return nullptr;
+        }
+      }
+      msg->m_value = Value::MakeStringArray(std::move(prefixes));
+      break;
+    }
     case kEntryAssign: {
       if (!decoder.ReadString(&msg->m_str)) {
         return nullptr;  // name
@@ -85,7 +194,11 @@ std::shared_ptr<Message> Message::Read(WireDecoder& decoder,
           return nullptr;  // flags
         }
       }
-      msg->m_value = decoder.ReadValue(type);
+      uint64_t time = 0;
+      if (decoder.timestamps() && !ReadTime(decoder, &time)) {
+        return nullptr;
+      }
+      msg->m_value = decoder.ReadValue(type, time);
       if (!msg->m_value) {
         return nullptr;
       }
@@ -98,6 +211,10 @@ std::shared_ptr<Message> Message::Read(WireDecoder& decoder,
       if (!decoder.Read16(&msg->m_seq_num_uid)) {
         return nullptr;  // seq num
       }
+      uint64_t time = 0;
+      if (decoder.timestamps() && !ReadTime(decoder, &time)) {
+        return nullptr;
+      }
       NT_Type type;
       if (decoder.proto_rev() >= 0x0300u) {
         if (!decoder.ReadType(&type)) {
@@ -107,7 +224,7 @@ std::shared_ptr<Message> Message::Read(WireDecoder& decoder,
         type = get_entry_type(msg->m_id);
       }
       WPI_DEBUG4(decoder.logger(), "update message data type: {}", type);
-      msg->m_value = decoder.ReadValue(type);
+      msg->m_value = decoder.ReadValue(type, time);
       if (!msg->m_value) {
         return nullptr;
       }
@@ -152,6 +269,45 @@ std::shared_ptr<Message> Message::Read(WireDecoder& decoder,
       }
       break;
     }
+    case kEntryArrayDelta: {
+      if (decoder.proto_rev() < 0x0300u) {
+        decoder.set_error("received ENTRY_ARRAY_DELTA in protocol < 3.0");
+        return nullptr;
+      }
+      if (!decoder.Read16(&msg->m_id)) {
+        return nullptr;  // id
+      }
+      if (!decoder.Read16(&msg->m_seq_num_uid)) {
+        return nullptr;  // seq num
+      }
+      uint64_t time = 0;
+      if (decoder.timestamps() && !ReadTime(decoder, &time)) {
+        return nullptr;
+      }
+      NT_Type type;
+      if (!decoder.ReadType(&type)) {
+        return nullptr;
+      }
+      if (type != NT_BOOLEAN_ARRAY && type != NT_DOUBLE_ARRAY &&
+          type != NT_STRING_ARRAY) {
+        decoder.set_error("received ENTRY_ARRAY_DELTA with non-array type");
+        return nullptr;
+      }
+      unsigned int num_ranges;
+      if (!decoder.Read8(&num_ranges)) {
+        return nullptr;
+      }
+      const char* ranges;
+      if (!decoder.Read(&ranges, num_ranges * 2)) {
+        return nullptr;
+      }
+      msg->m_str.assign(ranges, num_ranges * 2);
+      msg->m_value = decoder.ReadValue(type, time);
+      if (!msg->m_value) {
+        return nullptr;
+      }
+      break;
+    }
     case kExecuteRpc: {
       if (decoder.proto_rev() < 0x0300u) {
         decoder.set_error("received EXECUTE_RPC in protocol < 3.0");
@@ -204,9 +360,19 @@ std::shared_ptr<Message> Message::Read(WireDecoder& decoder,
   return msg;
 }
 
-std::shared_ptr<Message> Message::ClientHello(std::string_view self_id) {
+std::vector<std::string> Message::prefixes() const {
+  if (!m_value || !m_value->IsStringArray()) {
+    return {};
+  }
+  auto prefixes = m_value->GetStringArray();
+  return {prefixes.begin(), prefixes.end()};
+}
+
+std::shared_ptr<Message> Message::ClientHello(std::string_view self_id,
+                                              unsigned int flags) {
   auto msg = std::make_shared<Message>(kClientHello, private_init());
   msg->m_str = self_id;
+  msg->m_flags = flags;
   return msg;
 }
 
@@ -218,6 +384,49 @@ std::shared_ptr<Message> Message::ServerHello(unsigned int flags,
   return msg;
 }
 
+std::shared_ptr<Message> Message::Extensions(unsigned int flags) {
+  auto msg = std::make_shared<Message>(kExtensions, private_init());
+  msg->m_flags = flags;
+  return msg;
+}
+
+std::shared_ptr<Message> Message::Compressed(unsigned int uncompressed_size,
+                                             std::string_view data) {
+  auto msg = std::make_shared<Message>(kCompressed, private_init());
+  msg->m_id = uncompressed_size;
+  msg->m_str = data;
+  return msg;
+}
+
+std::shared_ptr<Message> Message::Session(uint32_t token,
+                                          std::string_view digest) {
+  auto msg = std::make_shared<Message>(kSession, private_init());
+  msg->m_id = token;
+  msg->m_str = digest;
+  return msg;
+}
+
+std::shared_ptr<Message> Message::Subscribe(
+    wpi::span<const std::string> prefixes) {
+  auto msg = std::make_shared<Message>(kSubscribe, private_init());
+  msg->m_value = Value::MakeStringArray(prefixes);
+  return msg;
+}
+
+std::shared_ptr<Message> Message::DatagramLane(uint32_t token) {
+  auto msg = std::make_shared<Message>(kDatagramLane, private_init());
+  msg->m_id = token;
+  return msg;
+}
+
+std::shared_ptr<Message> Message::TimeSync(uint64_t client_time,
+                                           uint64_t server_time) {
+  auto msg = std::make_shared<Message>(kTimeSync, private_init());
+  msg->m_client_time = client_time;
+  msg->m_server_time = server_time;
+  return msg;
+}
+
 std::shared_ptr<Message> Message::EntryAssign(std::string_view name,
                                               unsigned int id,
                                               unsigned int seq_num,
@@ -242,6 +451,17 @@ std::shared_ptr<Message> Message::EntryUpdate(unsigned int id,
   return msg;
 }
 
+std::shared_ptr<Message> Message::EntryArrayDelta(
+    unsigned int id, unsigned int seq_num, std::string_view ranges,
+    std::shared_ptr<Value> value) {
+  auto msg = std::make_shared<Message>(kEntryArrayDelta, private_init());
+  msg->m_str = ranges;
+  msg->m_value = value;
+  msg->m_id = id;
+  msg->m_seq_num_uid = seq_num;
+  return msg;
+}
+
 std::shared_ptr<Message> Message::FlagsUpdate(unsigned int id,
                                               unsigned int flags) {
   auto msg = std::make_shared<Message>(kFlagsUpdate, private_init());
@@ -285,7 +505,14 @@ void Message::Write(WireEncoder& encoder) const {
       if (encoder.proto_rev() < 0x0300u) {
         return;
       }
-      encoder.WriteString(m_str);
+      if (m_flags == 0) {
+        encoder.WriteString(m_str);
+      } else {
+        std::string id = m_str;
+        id += kHelloFlagsMarker;
+        id += static_cast<char>(m_flags);
+        encoder.WriteString(id);
+      }
       break;
     case kProtoUnsup:
       encoder.Write8(kProtoUnsup);
@@ -308,6 +535,56 @@ void Message::Write(WireEncoder& encoder) const {
       }
       encoder.Write8(kClientHelloDone);
       break;
+    case kExtensions:
+      if (encoder.proto_rev() < 0x0300u) {
+        return;  // new message in version 3.0
+      }
+      encoder.Write8(kExtensions);
+      encoder.Write8(m_flags);
+      break;
+    case kCompressed:
+      if (encoder.proto_rev() < 0x0300u) {
+        return;  // new message in version 3.0
+      }
+      encoder.Write8(kCompressed);
+      encoder.WriteUleb128(m_id);
+      encoder.WriteString(m_str);
+      break;
+    case kSession:
+      if (encoder.proto_rev() < 0x0300u) {
+        return;  // new message in version 3.0
+      }
+      encoder.Write8(kSession);
+      encoder.Write32(m_id);
+      encoder.WriteString(m_str);
+      break;
+    case kTimeSync:
+      if (encoder.proto_rev() < 0x0300u) {
+        return;  // new message in version 3.0
+      }
+      encoder.Write8(kTimeSync);
+      encoder.WriteUleb128(m_client_time);
+      encoder.WriteUleb128(m_server_time);
+      break;
+    case kDatagramLane:
+      if (encoder.proto_rev() < 0x0300u) {
+        return;  // new message in version 3.0
+      }
+      encoder.Write8(kDatagramLane);
+      encoder.Write32(m_id);
+      break;
+    case kSubscribe: {
+      if (encoder.proto_rev() < 0x0300u) {
+        return;  // new message in version 3.0
+      }
+      encoder.Write8(kSubscribe);
+      auto prefixes = m_value->GetStringArray();
+      encoder.WriteUleb128(prefixes.size());
+      for (auto&& prefix : prefixes) {
+        encoder.WriteString(prefix);
+      }
+      break;
+    }
     case kEntryAssign:
       encoder.Write8(kEntryAssign);
       encoder.WriteString(m_str);
@@ -317,12 +594,18 @@ void Message::Write(WireEncoder& encoder) const {
       if (encoder.proto_rev() >= 0x0300u) {
         encoder.Write8(m_flags);
       }
+      if (encoder.timestamps()) {
+        encoder.WriteUleb128(encoder.ToWireTime(m_value->time()));
+      }
       encoder.WriteValue(*m_value);
       break;
     case kEntryUpdate:
       encoder.Write8(kEntryUpdate);
       encoder.Write16(m_id);
       encoder.Write16(m_seq_num_uid);
+      if (encoder.timestamps()) {
+        encoder.WriteUleb128(encoder.ToWireTime(m_value->time()));
+      }
       if (encoder.proto_rev() >= 0x0300u) {
         encoder.WriteType(m_value->type());
       }
@@ -343,6 +626,23 @@ void Message::Write(WireEncoder& encoder) const {
       encoder.Write8(kEntryDelete);
       encoder.Write16(m_id);
       break;
+    case kEntryArrayDelta:
+      if (encoder.proto_rev() < 0x0300u) {
+        return;  // new message in version 3.0
+      }
+      encoder.Write8(kEntryArrayDelta);
+      encoder.Write16(m_id);
+      encoder.Write16(m_seq_num_uid);
+      if (encoder.timestamps()) {
+        encoder.WriteUleb128(encoder.ToWireTime(m_value->time()));
+      }
+      encoder.WriteType(m_value->type());
+      encoder.Write8(m_str.size() / 2);
+      for (char ch : m_str) {
+        encoder.Write8(static_cast<unsigned char>(ch));
+      }
+      encoder.WriteValue(*m_value);
+      break;
     case kClearEntries:
       if (encoder.proto_rev() < 0x0300u) {
         return;  // new message in version 3.0
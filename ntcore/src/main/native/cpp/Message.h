@@ -5,10 +5,15 @@
 #ifndef NTCORE_MESSAGE_H_
 #define NTCORE_MESSAGE_H_
 
+#include <stdint.h>
+
 #include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
+
+#include <wpi/span.h>
 
 #include "networktables/NetworkTableValue.h"
 
@@ -29,16 +34,74 @@ class Message {
     kServerHelloDone = 0x03,
     kServerHello = 0x04,
     kClientHelloDone = 0x05,
+    kExtensions = 0x06,
+    kCompressed = 0x07,
+    kSession = 0x08,
+    kTimeSync = 0x09,
+    kSubscribe = 0x0A,
+    kDatagramLane = 0x0B,
     kEntryAssign = 0x10,
     kEntryUpdate = 0x11,
     kFlagsUpdate = 0x12,
     kEntryDelete = 0x13,
     kClearEntries = 0x14,
+    kEntryArrayDelta = 0x15,
     kExecuteRpc = 0x20,
     kRpcResponse = 0x21
   };
   using GetEntryTypeFunc = std::function<NT_Type(unsigned int id)>;
 
+  // Protocol extensions.  The server advertises the ones it supports in the
+  // SERVER_HELLO flags (bit 0 is the "client previously seen" flag), and the
+  // client enables them by sending an EXTENSIONS message before
+  // CLIENT_HELLO_DONE.  Peers that don't know about an extension never see it.
+  static constexpr unsigned int kArrayDeltaExt = 0x02;
+  // With compression, the server compresses from receiving EXTENSIONS on,
+  // and the client from sending it on; either sends COMPRESSED messages.
+  static constexpr unsigned int kCompressionExt = 0x04;
+  // With sessions, the server answers the client hello done with a SESSION
+  // message holding its session token.  When a client reconnects to the
+  // address of the server that gave it the token, it can request
+  // kSessionResumeExt (and kCompressionExt, to also compress the initial
+  // assignments) in the CLIENT_HELLO flags, and follow the CLIENT_HELLO with
+  // a SESSION message holding the token and a digest of the entries it has
+  // (see Storage::GetSessionDigest()).  The CLIENT_HELLO flags are sent by
+  // appending kHelloFlagsMarker and a flags byte to the identity; this is
+  // only done for a server that has already shown it understands them, as
+  // older servers would just see a longer identity.  If the server
+  // acknowledges kSessionResumeExt in the SERVER_HELLO flags, the initial
+  // assignments only hold the entries that differ from the digest, plus
+  // ENTRY_DELETEs for the ones it no longer has.
+  static constexpr unsigned int kSessionExt = 0x08;
+  static constexpr unsigned int kSessionResumeExt = 0x10;
+  // With time sync, the client periodically sends TIME_SYNC requests holding
+  // its send time, which the server answers with its receive time (in place
+  // of keep alives), and the client estimates the offset between the two
+  // clocks from the exchanges with the smallest round trip (see TimeSync).
+  // ENTRY_ASSIGN, ENTRY_UPDATE and ENTRY_ARRAY_DELTA then carry the value's
+  // time in the server's time base (ULEB128 microseconds, after the flags or
+  // sequence number), so receivers see when a value was published.
+  static constexpr unsigned int kTimeSyncExt = 0x20;
+  // With subscriptions, the client only receives the entries whose names
+  // start with one of the prefixes it subscribed to (plus the ones it
+  // assigned itself).  The prefixes are sent in a SUBSCRIBE message (ULEB128
+  // count followed by strings), first before CLIENT_HELLO_DONE (the initial
+  // assignments are not filtered), and again whenever they change; the
+  // server then assigns the newly matched entries.  An empty prefix list
+  // subscribes to everything.
+  static constexpr unsigned int kSubscribeExt = 0x40;
+  // With datagrams, the server answers the client hello done (after any
+  // SESSION) with a DATAGRAM_LANE message holding a random token for the
+  // connection.  Both sides may then send ENTRY_UPDATEs for entries flagged
+  // NT_UNRELIABLE as UDP datagrams instead: the token (4 bytes, big endian)
+  // followed by messages encoded as in protocol 3.0 without extensions.  The
+  // server listens on the same port number as for TCP, and learns the
+  // client's address from its datagrams; the client sends one with just the
+  // token about once a second when it has nothing else to send.  Receivers
+  // drop updates not newer (by sequence number) than the last one received.
+  static constexpr unsigned int kDatagramExt = 0x80;
+  static constexpr std::string_view kHelloFlagsMarker{"\0nt-ext", 7};
+
   Message() = default;
   Message(MsgType type, const private_init&) : m_type(type) {}
 
@@ -53,6 +116,28 @@ class Message {
   unsigned int flags() const { return m_flags; }
   unsigned int seq_num_uid() const { return m_seq_num_uid; }
 
+  // For kEntryArrayDelta, str() holds a (start, count) byte pair for each
+  // replaced range and value() holds the replacement elements of all ranges.
+  std::string_view ranges() const { return m_str; }
+
+  // For kCompressed, str() holds an LZ4 block that decompresses to
+  // uncompressed_size() bytes of encoded messages.
+  static constexpr unsigned int kMaxUncompressedSize = 16 * 1024 * 1024;
+  unsigned int uncompressed_size() const { return m_id; }
+
+  // For kSession, id() holds the server's session token and str() the
+  // client's digest (empty from the server).
+
+  // For kDatagramLane, id() holds the connection's datagram token.
+
+  // For kSubscribe, the subscribed prefixes.
+  std::vector<std::string> prefixes() const;
+
+  // For kTimeSync, the client's send time and the server's receive time (0
+  // in a request), each in the sender's time base.
+  uint64_t client_time() const { return m_client_time; }
+  uint64_t server_time() const { return m_server_time; }
+
   // Read and write from wire representation
   void Write(WireEncoder& encoder) const;
   static std::shared_ptr<Message> Read(WireDecoder& decoder,
@@ -76,9 +161,20 @@ class Message {
   }
 
   // Create messages with data
-  static std::shared_ptr<Message> ClientHello(std::string_view self_id);
+  static std::shared_ptr<Message> ClientHello(std::string_view self_id,
+                                              unsigned int flags = 0);
   static std::shared_ptr<Message> ServerHello(unsigned int flags,
                                               std::string_view self_id);
+  static std::shared_ptr<Message> Extensions(unsigned int flags);
+  static std::shared_ptr<Message> Compressed(unsigned int uncompressed_size,
+                                             std::string_view data);
+  static std::shared_ptr<Message> Session(uint32_t token,
+                                          std::string_view digest);
+  static std::shared_ptr<Message> TimeSync(uint64_t client_time,
+                                           uint64_t server_time);
+  static std::shared_ptr<Message> Subscribe(
+      wpi::span<const std::string> prefixes);
+  static std::shared_ptr<Message> DatagramLane(uint32_t token);
   static std::shared_ptr<Message> EntryAssign(std::string_view name,
                                               unsigned int id,
                                               unsigned int seq_num,
@@ -87,6 +183,10 @@ class Message {
   static std::shared_ptr<Message> EntryUpdate(unsigned int id,
                                               unsigned int seq_num,
                                               std::shared_ptr<Value> value);
+  static std::shared_ptr<Message> EntryArrayDelta(unsigned int id,
+                                                  unsigned int seq_num,
+                                                  std::string_view ranges,
+                                                  std::shared_ptr<Value> value);
   static std::shared_ptr<Message> FlagsUpdate(unsigned int id,
                                               unsigned int flags);
   static std::shared_ptr<Message> EntryDelete(unsigned int id);
@@ -107,6 +207,8 @@ class Message {
   unsigned int m_id{0};  // also used for proto_rev
   unsigned int m_flags{0};
   unsigned int m_seq_num_uid{0};
+  uint64_t m_client_time{0};
+  uint64_t m_server_time{0};
 };
 
 }  // namespace nt
@@ -6,10 +6,13 @@
 
 #include <utility>
 
+#include <wpi/Endian.h>
 #include <wpi/NetworkStream.h>
 #include <wpi/raw_socket_istream.h>
 #include <wpi/timestamp.h>
+#include <wpi/trace.h>
 
+#include "DatagramSocket.h"
 #include "IConnectionNotifier.h"
 #include "Log.h"
 #include "WireDecoder.h"
@@ -27,6 +30,7 @@ NetworkConnection::NetworkConnection(unsigned int uid,
       m_stream(std::move(stream)),
       m_notifier(notifier),
       m_logger(logger),
+      m_outgoing(kOutgoingQueueSize),
       m_handshake(std::move(handshake)),
       m_get_entry_type(std::move(get_entry_type)),
       m_state(kCreated) {
@@ -49,9 +53,8 @@ void NetworkConnection::Start() {
   m_active = true;
   set_state(kInit);
   // clear queue
-  while (!m_outgoing.empty()) {
-    m_outgoing.pop();
-  }
+  ClearOutgoing();
+  m_outgoing_bytes = 0;
   // reset shutdown flags
   {
     std::scoped_lock lock(m_shutdown_mutex);
@@ -71,8 +74,9 @@ void NetworkConnection::Stop() {
   if (m_stream) {
     m_stream->close();
   }
-  // send an empty outgoing message set so the write thread terminates
-  m_outgoing.push(Outgoing());
+  // send an empty outgoing message set so the write thread terminates; if
+  // the queue is full, the write thread has batches to wake it anyway
+  m_outgoing.try_emplace();
   // wait for threads to terminate, with timeout
   if (m_write_thread.joinable()) {
     std::unique_lock lock(m_shutdown_mutex);
@@ -97,8 +101,12 @@ void NetworkConnection::Stop() {
     }
   }
   // clear queue
-  while (!m_outgoing.empty()) {
-    m_outgoing.pop();
+  ClearOutgoing();
+}
+
+void NetworkConnection::ClearOutgoing() {
+  std::string data;
+  while (m_outgoing.try_pop(data)) {
   }
 }
 
@@ -148,6 +156,7 @@ void NetworkConnection::set_remote_id(std::string_view remote_id) {
 }
 
 void NetworkConnection::ReadThreadMain() {
+  WPI_TRACE_THREAD_NAME("NT read");
   wpi::raw_socket_istream is(*m_stream);
   WireDecoder decoder(is, m_proto_rev, m_logger);
 
@@ -156,15 +165,20 @@ void NetworkConnection::ReadThreadMain() {
           *this,
           [&] {
             decoder.set_proto_rev(m_proto_rev);
-            auto msg = Message::Read(decoder, m_get_entry_type);
+            decoder.set_timestamps(m_time_sync.enabled(),
+                                   m_time_sync.offset());
+            auto msg = ReadMessage(decoder);
             if (!msg && decoder.error()) {
               DEBUG0("error reading in handshake: {}", decoder.error());
             }
             return msg;
           },
           [&](auto msgs) {
-            m_outgoing.emplace(std::vector<std::shared_ptr<Message>>(
-                msgs.begin(), msgs.end()));
+            for (auto& msg : msgs) {
+              m_datagram_lane.Track(*msg);
+            }
+            std::scoped_lock lock(m_pending_mutex);
+            PushOutgoing(msgs);
           })) {
     set_state(kDead);
     m_active = false;
@@ -177,8 +191,9 @@ void NetworkConnection::ReadThreadMain() {
       break;
     }
     decoder.set_proto_rev(m_proto_rev);
+    decoder.set_timestamps(m_time_sync.enabled(), m_time_sync.offset());
     decoder.Reset();
-    auto msg = Message::Read(decoder, m_get_entry_type);
+    auto msg = ReadMessage(decoder);
     if (!msg) {
       if (decoder.error()) {
         INFO("read error: {}", decoder.error());
@@ -192,12 +207,17 @@ void NetworkConnection::ReadThreadMain() {
     DEBUG3("received type={} with str={} id={} seq_num={}", msg->type(),
            msg->str(), msg->id(), msg->seq_num_uid());
     m_last_update = Now();
+    WPI_TRACE_SCOPE("ntcore.read.process");
+    if (msg->Is(Message::kTimeSync)) {
+      ProcessTimeSync(*msg);
+      continue;
+    }
     m_process_incoming(std::move(msg), this);
   }
   DEBUG2("read thread died ({})", fmt::ptr(this));
   set_state(kDead);
   m_active = false;
-  m_outgoing.push(Outgoing());  // also kill write thread
+  m_outgoing.try_emplace();  // also kill write thread
 
 done:
   // use condition variable to signal thread shutdown
@@ -209,35 +229,23 @@ done:
 }
 
 void NetworkConnection::WriteThreadMain() {
-  WireEncoder encoder(m_proto_rev);
-
+  WPI_TRACE_THREAD_NAME("NT write");
   while (m_active) {
-    auto msgs = m_outgoing.pop();
+    auto data = m_outgoing.pop();
     DEBUG4("{}", "write thread woke up");
-    if (msgs.empty()) {
+    if (data.empty()) {
       continue;
     }
-    encoder.set_proto_rev(m_proto_rev);
-    encoder.Reset();
-    DEBUG3("sending {} messages", msgs.size());
-    for (auto& msg : msgs) {
-      if (msg) {
-        DEBUG3("sending type={} with str={} id={} seq_num={}", msg->type(),
-               msg->str(), msg->id(), msg->seq_num_uid());
-        msg->Write(encoder);
-      }
-    }
+    WPI_TRACE_SCOPE("ntcore.write.send");
     wpi::NetworkStream::Error err;
     if (!m_stream) {
       break;
     }
-    if (encoder.size() == 0) {
-      continue;
-    }
-    if (m_stream->send(encoder.data(), encoder.size(), &err) == 0) {
+    if (m_stream->send(data.data(), data.size(), &err) == 0) {
       break;
     }
-    DEBUG4("sent {} bytes", encoder.size());
+    m_outgoing_bytes -= data.size();
+    DEBUG4("sent {} bytes", data.size());
   }
   DEBUG2("write thread died ({})", fmt::ptr(this));
   set_state(kDead);
@@ -245,6 +253,8 @@ void NetworkConnection::WriteThreadMain() {
   if (m_stream) {
     m_stream->close();  // also kill read thread
   }
+  // nothing will be sent; this also frees a producer waiting on a full queue
+  ClearOutgoing();
 
   // use condition variable to signal thread shutdown
   {
@@ -254,113 +264,184 @@ void NetworkConnection::WriteThreadMain() {
   }
 }
 
-void NetworkConnection::QueueOutgoing(std::shared_ptr<Message> msg) {
-  std::scoped_lock lock(m_pending_mutex);
-
-  // Merge with previous.  One case we don't combine: delete/assign loop.
-  switch (msg->type()) {
-    case Message::kEntryAssign:
-    case Message::kEntryUpdate: {
-      // don't do this for unassigned id's
-      unsigned int id = msg->id();
-      if (id == 0xffff) {
-        m_pending_outgoing.push_back(msg);
-        break;
-      }
-      if (id < m_pending_update.size() && m_pending_update[id].first != 0) {
-        // overwrite the previous one for this id
-        auto& oldmsg = m_pending_outgoing[m_pending_update[id].first - 1];
-        if (oldmsg && oldmsg->Is(Message::kEntryAssign) &&
-            msg->Is(Message::kEntryUpdate)) {
-          // need to update assignment with new seq_num and value
-          oldmsg = Message::EntryAssign(oldmsg->str(), id, msg->seq_num_uid(),
-                                        msg->value(), oldmsg->flags());
-        } else {
-          oldmsg = msg;  // easy update
-        }
-      } else {
-        // new, but remember it
-        size_t pos = m_pending_outgoing.size();
-        m_pending_outgoing.push_back(msg);
-        if (id >= m_pending_update.size()) {
-          m_pending_update.resize(id + 1);
-        }
-        m_pending_update[id].first = pos + 1;
-      }
+std::shared_ptr<Message> NetworkConnection::ReadMessage(WireDecoder& decoder) {
+  while (m_inflated.empty()) {
+    auto msg = Message::Read(decoder, m_get_entry_type);
+    if (!msg || !msg->Is(Message::kCompressed)) {
+      m_inflated.emplace_back(std::move(msg));
       break;
     }
-    case Message::kEntryDelete: {
-      // don't do this for unassigned id's
-      unsigned int id = msg->id();
-      if (id == 0xffff) {
-        m_pending_outgoing.push_back(msg);
-        break;
-      }
+    Outgoing msgs;
+    if (!CompressionCodec::Read(*msg, decoder, m_get_entry_type, &msgs)) {
+      decoder.set_error("bad COMPRESSED message");
+      return nullptr;
+    }
+    m_inflated.insert(m_inflated.end(), msgs.begin(), msgs.end());
+  }
+  auto msg = std::move(m_inflated.front());
+  m_inflated.pop_front();
+  if (msg) {
+    msg = m_deltas.Read(std::move(msg));
+    if (!msg) {
+      decoder.set_error("received ENTRY_ARRAY_DELTA for unknown array");
+    } else {
+      m_datagram_lane.Track(*msg);
+    }
+  }
+  return msg;
+}
+
+void NetworkConnection::set_array_deltas(bool enable) {
+  std::scoped_lock lock(m_pending_mutex);
+  m_deltas.set_send_deltas(enable);
+}
+
+void NetworkConnection::set_compression(bool enable) {
+  std::scoped_lock lock(m_pending_mutex);
+  m_compression.set_compress(enable);
+}
+
+void NetworkConnection::set_time_sync(bool enable, bool client) {
+  std::scoped_lock lock(m_pending_mutex);
+  m_time_sync.set_enabled(enable, client);
+}
+
+void NetworkConnection::set_datagrams(std::shared_ptr<DatagramSocket> socket,
+                                      uint32_t token, bool client,
+                                      std::string_view addr, int port) {
+  std::scoped_lock lock(m_pending_mutex);
+  m_datagram_socket = std::move(socket);
+  m_datagram_token = token;
+  m_datagram_client = client;
+  m_datagram_addr = addr;
+  m_datagram_port = port;
+  m_last_datagram = {};
+}
 
-      // clear previous updates
-      if (id < m_pending_update.size()) {
-        if (m_pending_update[id].first != 0) {
-          m_pending_outgoing[m_pending_update[id].first - 1].reset();
-          m_pending_update[id].first = 0;
-        }
-        if (m_pending_update[id].second != 0) {
-          m_pending_outgoing[m_pending_update[id].second - 1].reset();
-          m_pending_update[id].second = 0;
-        }
+void NetworkConnection::ProcessDatagram(std::string_view data,
+                                        std::string_view addr, int port) {
+  {
+    std::scoped_lock lock(m_pending_mutex);
+    if (!m_datagram_client &&
+        (addr != m_datagram_addr || port != m_datagram_port)) {
+      // only accept the client's address from the host it connected from
+      if (addr != m_stream->getPeerIP()) {
+        return;
       }
+      DEBUG0("server: datagrams from {} port {}", addr, port);
+      m_datagram_addr = addr;
+      m_datagram_port = port;
+    }
+  }
+  if (state() != kActive) {
+    return;
+  }
+  std::vector<std::shared_ptr<Message>> msgs;
+  if (!m_datagram_lane.Decode(data, m_logger, &msgs)) {
+    DEBUG0("{}", "received malformed datagram");
+    return;
+  }
+  if (msgs.empty()) {
+    return;
+  }
+  m_last_update = Now();
+  for (auto& msg : msgs) {
+    m_process_incoming(std::move(msg), this);
+  }
+}
 
-      // add deletion
-      m_pending_outgoing.push_back(msg);
-      break;
+void NetworkConnection::PostDatagrams(
+    bool keep_alive, std::chrono::steady_clock::time_point now) {
+  if (!m_datagram_socket || m_datagram_addr.empty()) {
+    return;
+  }
+  if (!m_datagram_pending.empty()) {
+    std::vector<std::string> datagrams;
+    Outgoing oversize;
+    DatagramLane::Encode(m_datagram_token, m_datagram_pending.messages(),
+                         &datagrams, &oversize);
+    m_datagram_pending.clear();
+    for (auto& datagram : datagrams) {
+      m_datagram_socket->Send(datagram, m_datagram_addr, m_datagram_port);
     }
-    case Message::kFlagsUpdate: {
-      // don't do this for unassigned id's
-      unsigned int id = msg->id();
-      if (id == 0xffff) {
-        m_pending_outgoing.push_back(msg);
-        break;
-      }
-      if (id < m_pending_update.size() && m_pending_update[id].second != 0) {
-        // overwrite the previous one for this id
-        m_pending_outgoing[m_pending_update[id].second - 1] = msg;
-      } else {
-        // new, but remember it
-        size_t pos = m_pending_outgoing.size();
-        m_pending_outgoing.push_back(msg);
-        if (id >= m_pending_update.size()) {
-          m_pending_update.resize(id + 1);
-        }
-        m_pending_update[id].second = pos + 1;
-      }
-      break;
+    // too large for a datagram; these go on TCP
+    for (auto& msg : oversize) {
+      m_pending.Queue(std::move(msg));
     }
-    case Message::kClearEntries: {
-      // knock out all previous assigns/updates!
-      for (auto& i : m_pending_outgoing) {
-        if (!i) {
-          continue;
-        }
-        auto t = i->type();
-        if (t == Message::kEntryAssign || t == Message::kEntryUpdate ||
-            t == Message::kFlagsUpdate || t == Message::kEntryDelete ||
-            t == Message::kClearEntries) {
-          i.reset();
-        }
-      }
-      m_pending_update.resize(0);
-      m_pending_outgoing.push_back(msg);
-      break;
+    m_last_datagram = now;
+  } else if (keep_alive && m_datagram_client &&
+             (now - m_last_datagram) >= std::chrono::seconds(1)) {
+    // lets the server learn (and keep) our address
+    std::string datagram(4, '\0');
+    wpi::support::endian::write32be(datagram.data(), m_datagram_token);
+    m_datagram_socket->Send(datagram, m_datagram_addr, m_datagram_port);
+    m_last_datagram = now;
+  }
+}
+
+bool NetworkConnection::server_time_offset(int64_t* offset) const {
+  if (!m_time_sync.synchronized()) {
+    return false;
+  }
+  *offset = m_time_sync.offset();
+  return true;
+}
+
+void NetworkConnection::ProcessTimeSync(const Message& msg) {
+  // answer right away; queueing would add to the measured round trip
+  if (auto reply = m_time_sync.Process(msg, Now())) {
+    std::scoped_lock lock(m_pending_mutex);
+    PushOutgoing(wpi::span(&reply, 1));
+  }
+}
+
+void NetworkConnection::PushOutgoing(
+    wpi::span<const std::shared_ptr<Message>> msgs) {
+  m_encoder.set_proto_rev(m_proto_rev);
+  m_encoder.set_timestamps(m_time_sync.enabled(), m_time_sync.offset());
+  m_encoder.Reset();
+  DEBUG3("sending {} messages", msgs.size());
+  for (auto& msg : msgs) {
+    if (msg) {
+      DEBUG3("sending type={} with str={} id={} seq_num={}", msg->type(),
+             msg->str(), msg->id(), msg->seq_num_uid());
+      m_deltas.Write(*msg, m_encoder);
     }
-    default:
-      m_pending_outgoing.push_back(msg);
-      break;
   }
+  if (m_encoder.size() == 0 || !m_active) {
+    return;
+  }
+  m_compression.Write(m_encoder);
+  m_outgoing_bytes += m_encoder.size();
+  m_outgoing.emplace(m_encoder.ToStringView());
+}
+
+void NetworkConnection::QueueOutgoing(std::shared_ptr<Message> msg) {
+  std::scoped_lock lock(m_pending_mutex);
+  // filtered in queue order, so assignments are seen before their updates
+  if (!subscriptions().Filter(*msg)) {
+    return;
+  }
+  m_datagram_lane.Track(*msg);
+  if (!m_datagram_addr.empty() && m_datagram_lane.IsLossy(*msg)) {
+    m_datagram_pending.Queue(std::move(msg));
+    return;
+  }
+  m_pending.Queue(std::move(msg));
 }
 
 void NetworkConnection::PostOutgoing(bool keep_alive) {
   std::scoped_lock lock(m_pending_mutex);
   auto now = std::chrono::steady_clock::now();
-  if (m_pending_outgoing.empty()) {
+  PostDatagrams(keep_alive, now);
+  // time sync requests also serve as keep-alives
+  if (keep_alive) {
+    if (auto sync = m_time_sync.Poll(Now())) {
+      PushOutgoing(wpi::span(&sync, 1));
+      m_last_post = now;
+    }
+  }
+  if (m_pending.empty()) {
     if (!keep_alive) {
       return;
     }
@@ -368,11 +449,18 @@ void NetworkConnection::PostOutgoing(bool keep_alive) {
     if ((now - m_last_post) < std::chrono::seconds(1)) {
       return;
     }
-    m_outgoing.emplace(Outgoing{Message::KeepAlive()});
+    auto msg = Message::KeepAlive();
+    PushOutgoing(wpi::span(&msg, 1));
   } else {
-    m_outgoing.emplace(std::move(m_pending_outgoing));
-    m_pending_outgoing.resize(0);
-    m_pending_update.resize(0);
+    // If the write thread has fallen behind, hold everything back; updates
+    // keep merging into m_pending until it catches up.
+    if (m_outgoing_bytes > m_max_outgoing_bytes) {
+      DEBUG4("holding {} messages, {} bytes queued", m_pending.size(),
+             m_outgoing_bytes.load());
+      return;
+    }
+    PushOutgoing(m_pending.messages());
+    m_pending.clear();
   }
   m_last_post = now;
 }  // NOLINT
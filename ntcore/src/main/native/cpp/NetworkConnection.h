@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -16,13 +17,19 @@
 #include <utility>
 #include <vector>
 
-#include <wpi/ConcurrentQueue.h>
+#include <wpi/BoundedConcurrentQueue.h>
 #include <wpi/condition_variable.h>
 #include <wpi/mutex.h>
 #include <wpi/span.h>
 
+#include "ArrayDeltaCodec.h"
+#include "CompressionCodec.h"
+#include "DatagramLane.h"
 #include "INetworkConnection.h"
 #include "Message.h"
+#include "PendingMessages.h"
+#include "TimeSync.h"
+#include "WireEncoder.h"
 #include "ntcore_cpp.h"
 
 namespace wpi {
@@ -32,7 +39,9 @@ class NetworkStream;
 
 namespace nt {
 
+class DatagramSocket;
 class IConnectionNotifier;
+class WireDecoder;
 
 class NetworkConnection : public INetworkConnection {
  public:
@@ -43,7 +52,16 @@ class NetworkConnection : public INetworkConnection {
   using ProcessIncomingFunc =
       std::function<void(std::shared_ptr<Message>, NetworkConnection*)>;
   using Outgoing = std::vector<std::shared_ptr<Message>>;
-  using OutgoingQueue = wpi::ConcurrentQueue<Outgoing>;
+  // Encoded message batches; an empty batch wakes the write thread.  The
+  // queue is lock-free, so posting never waits on the write thread's lock.
+  using OutgoingQueue = wpi::BoundedConcurrentQueue<std::string>;
+
+  // Batches queued to the write thread before posting waits for it.  The
+  // byte limit normally holds messages back long before this is reached.
+  static constexpr size_t kOutgoingQueueSize = 256;
+
+  // Default limit on encoded bytes queued to the write thread.
+  static constexpr size_t kDefaultMaxOutgoingBytes = 64 * 1024;
 
   NetworkConnection(unsigned int uid,
                     std::unique_ptr<wpi::NetworkStream> stream,
@@ -68,6 +86,37 @@ class NetworkConnection : public INetworkConnection {
   void QueueOutgoing(std::shared_ptr<Message> msg) final;
   void PostOutgoing(bool keep_alive) override;
 
+  // Set the limit on encoded bytes waiting for the write thread.  Once it is
+  // exceeded, PostOutgoing() holds messages back and keeps coalescing them so
+  // a slow peer only receives the latest value of each entry.
+  void set_max_outgoing_bytes(size_t bytes) { m_max_outgoing_bytes = bytes; }
+
+  // Send array updates as deltas.  Set by the handshake once both ends have
+  // agreed to the extension.
+  void set_array_deltas(bool enable);
+
+  // Compress outgoing message batches.  Set by the handshake once both ends
+  // have agreed to the extension.
+  void set_compression(bool enable);
+
+  // Exchange time syncs and timestamp entry values.  Set by the handshake
+  // once both ends have agreed to the extension.
+  void set_time_sync(bool enable, bool client);
+
+  bool server_time_offset(int64_t* offset) const final;
+
+  // Send updates to unreliable entries as datagrams through socket.  Set by
+  // the handshake once both ends have agreed to the extension.  A client
+  // gives the server's address; a server learns the client's from its
+  // datagrams, and sends on TCP until then.
+  void set_datagrams(std::shared_ptr<DatagramSocket> socket, uint32_t token,
+                     bool client, std::string_view addr = {}, int port = 0);
+
+  // Processes a datagram received for this connection's token.  Called by
+  // the socket's receive thread.
+  void ProcessDatagram(std::string_view data, std::string_view addr,
+                       int port);
+
   unsigned int uid() const { return m_uid; }
 
   unsigned int proto_rev() const final;
@@ -88,6 +137,25 @@ class NetworkConnection : public INetworkConnection {
   void ReadThreadMain();
   void WriteThreadMain();
 
+  // Encodes msgs and queues them to the write thread.  Must be called with
+  // m_pending_mutex held.
+  void PushOutgoing(wpi::span<const std::shared_ptr<Message>> msgs);
+
+  // Reads one message, expanding compressed batches and array deltas.  Read
+  // thread only.
+  std::shared_ptr<Message> ReadMessage(WireDecoder& decoder);
+
+  // Answers or applies a received TIME_SYNC.  Read thread only.
+  void ProcessTimeSync(const Message& msg);
+
+  // Drops any batches not yet taken by the write thread.
+  void ClearOutgoing();
+
+  // Sends the updates held for the datagram lane, or a keep alive datagram
+  // from a client.  Must be called with m_pending_mutex held.
+  void PostDatagrams(bool keep_alive,
+                     std::chrono::steady_clock::time_point now);
+
   unsigned int m_uid;
   std::unique_ptr<wpi::NetworkStream> m_stream;
   IConnectionNotifier& m_notifier;
@@ -108,8 +176,29 @@ class NetworkConnection : public INetworkConnection {
   std::chrono::steady_clock::time_point m_last_post;
 
   wpi::mutex m_pending_mutex;
-  Outgoing m_pending_outgoing;
-  std::vector<std::pair<size_t, size_t>> m_pending_update;
+  PendingMessages m_pending;
+  WireEncoder m_encoder{0x0300};
+  ArrayDeltaCodec m_deltas;
+  CompressionCodec m_compression;
+  TimeSync m_time_sync;
+
+  // Datagram lane (uses pending mutex); datagrams are only sent once
+  // m_datagram_addr is known
+  DatagramLane m_datagram_lane;
+  std::shared_ptr<DatagramSocket> m_datagram_socket;
+  uint32_t m_datagram_token = 0;
+  bool m_datagram_client = false;
+  std::string m_datagram_addr;
+  int m_datagram_port = 0;
+  PendingMessages m_datagram_pending;
+  std::chrono::steady_clock::time_point m_last_datagram;
+
+  // Read thread only: messages expanded from a compressed batch
+  std::deque<std::shared_ptr<Message>> m_inflated;
+
+  // Bytes queued to but not yet sent by the write thread
+  std::atomic<size_t> m_outgoing_bytes{0};
+  std::atomic<size_t> m_max_outgoing_bytes{kDefaultMaxOutgoingBytes};
 
   // Condition variables for shutdown
   wpi::mutex m_shutdown_mutex;
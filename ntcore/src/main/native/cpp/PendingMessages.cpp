@@ -0,0 +1,108 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "PendingMessages.h"
+
+using namespace nt;
+
+void PendingMessages::Queue(std::shared_ptr<Message> msg) {
+  // Merge with previous.  One case we don't combine: delete/assign loop.
+  switch (msg->type()) {
+    case Message::kEntryAssign:
+    case Message::kEntryUpdate: {
+      // don't do this for unassigned id's
+      unsigned int id = msg->id();
+      if (id == 0xffff) {
+        m_msgs.push_back(msg);
+        break;
+      }
+      if (id < m_update.size() && m_update[id].first != 0) {
+        // overwrite the previous one for this id
+        auto& oldmsg = m_msgs[m_update[id].first - 1];
+        if (oldmsg && oldmsg->Is(Message::kEntryAssign) &&
+            msg->Is(Message::kEntryUpdate)) {
+          // need to update assignment with new seq_num and value
+          oldmsg = Message::EntryAssign(oldmsg->str(), id, msg->seq_num_uid(),
+                                        msg->value(), oldmsg->flags());
+        } else {
+          oldmsg = msg;  // easy update
+        }
+      } else {
+        // new, but remember it
+        size_t pos = m_msgs.size();
+        m_msgs.push_back(msg);
+        if (id >= m_update.size()) {
+          m_update.resize(id + 1);
+        }
+        m_update[id].first = pos + 1;
+      }
+      break;
+    }
+    case Message::kEntryDelete: {
+      // don't do this for unassigned id's
+      unsigned int id = msg->id();
+      if (id == 0xffff) {
+        m_msgs.push_back(msg);
+        break;
+      }
+
+      // clear previous updates
+      if (id < m_update.size()) {
+        if (m_update[id].first != 0) {
+          m_msgs[m_update[id].first - 1].reset();
+          m_update[id].first = 0;
+        }
+        if (m_update[id].second != 0) {
+          m_msgs[m_update[id].second - 1].reset();
+          m_update[id].second = 0;
+        }
+      }
+
+      // add deletion
+      m_msgs.push_back(msg);
+      break;
+    }
+    case Message::kFlagsUpdate: {
+      // don't do this for unassigned id's
+      unsigned int id = msg->id();
+      if (id == 0xffff) {
+        m_msgs.push_back(msg);
+        break;
+      }
+      if (id < m_update.size() && m_update[id].second != 0) {
+        // overwrite the previous one for this id
+        m_msgs[m_update[id].second - 1] = msg;
+      } else {
+        // new, but remember it
+        size_t pos = m_msgs.size();
+        m_msgs.push_back(msg);
+        if (id >= m_update.size()) {
+          m_update.resize(id + 1);
+        }
+        m_update[id].second = pos + 1;
+      }
+      break;
+    }
+    case Message::kClearEntries: {
+      // knock out all previous assigns/updates!
+      for (auto& i : m_msgs) {
+        if (!i) {
+          continue;
+        }
+        auto t = i->type();
+        if (t == Message::kEntryAssign || t == Message::kEntryUpdate ||
+            t == Message::kFlagsUpdate || t == Message::kEntryDelete ||
+            t == Message::kClearEntries) {
+          i.reset();
+        }
+      }
+      m_update.resize(0);
+      m_msgs.push_back(msg);
+      break;
+    }
+    default:
+      m_msgs.push_back(msg);
+      break;
+  }
+}
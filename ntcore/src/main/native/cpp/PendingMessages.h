@@ -0,0 +1,46 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_PENDINGMESSAGES_H_
+#define NTCORE_PENDINGMESSAGES_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Message.h"
+
+namespace nt {
+
+/* Outgoing messages for a connection that have not been posted yet.
+ * Assignments, updates, and flag changes for the same entry are merged so
+ * that only the latest is sent.  Not thread safe; callers provide locking.
+ */
+class PendingMessages {
+ public:
+  using Messages = std::vector<std::shared_ptr<Message>>;
+
+  void Queue(std::shared_ptr<Message> msg);
+
+  bool empty() const { return m_msgs.empty(); }
+  size_t size() const { return m_msgs.size(); }
+
+  /* Queued messages, in order.  Merged-away entries are null. */
+  const Messages& messages() const { return m_msgs; }
+
+  void clear() {
+    m_msgs.resize(0);
+    m_update.resize(0);
+  }
+
+ private:
+  Messages m_msgs;
+  // indexed by id; 1-based positions in m_msgs of the assign/update and the
+  // flags update for that id (0 if none)
+  std::vector<std::pair<size_t, size_t>> m_update;
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_PENDINGMESSAGES_H_
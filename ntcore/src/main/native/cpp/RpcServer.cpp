@@ -6,11 +6,90 @@
 
 using namespace nt;
 
+impl::RpcServerThread::~RpcServerThread() {
+  StopWorkers();
+}
+
+void impl::RpcServerThread::Main() {
+  CallbackThread::Main();
+  // Workers don't hold a reference to this thread, so stop them while it's
+  // still alive.
+  StopWorkers();
+}
+
+void impl::RpcServerThread::StopWorkers() {
+  {
+    std::scoped_lock lock(m_work_mutex);
+    m_workers_stop = true;
+  }
+  m_work_cond.notify_all();
+  for (auto& worker : m_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void impl::RpcServerThread::DoCallback(
+    std::function<void(const RpcAnswer& call)> callback,
+    const RpcNotifierData& data) {
+  unsigned int num_workers = m_num_workers;
+  if (num_workers == 0) {
+    RunCallback(callback, data);
+    return;
+  }
+  {
+    std::scoped_lock lock(m_work_mutex);
+    if (m_workers_stop) {
+      return;
+    }
+    while (m_workers.size() < num_workers) {
+      m_workers.emplace_back(&RpcServerThread::WorkerMain, this);
+    }
+    m_work.emplace_back(std::move(callback), data);
+  }
+  m_work_cond.notify_one();
+}
+
+void impl::RpcServerThread::RunCallback(
+    const std::function<void(const RpcAnswer& call)>& callback,
+    const RpcNotifierData& data) {
+  DEBUG4("rpc calling {}", data.name);
+  unsigned int local_id = Handle{data.entry}.GetIndex();
+  unsigned int call_uid = Handle{data.call}.GetIndex();
+  RpcIdPair lookup_uid{local_id, call_uid};
+  callback(data);
+  {
+    std::scoped_lock lock(m_mutex);
+    auto i = m_response_map.find(lookup_uid);
+    if (i != m_response_map.end()) {
+      // post an empty response and erase it
+      (i->getSecond())("");
+      m_response_map.erase(i);
+    }
+  }
+}
+
+void impl::RpcServerThread::WorkerMain() {
+  std::unique_lock lock(m_work_mutex);
+  for (;;) {
+    m_work_cond.wait(lock, [&] { return m_workers_stop || !m_work.empty(); });
+    if (m_workers_stop) {
+      return;
+    }
+    auto work = std::move(m_work.front());
+    m_work.pop_front();
+    lock.unlock();
+    RunCallback(work.first, work.second);
+    lock.lock();
+  }
+}
+
 RpcServer::RpcServer(int inst, wpi::Logger& logger)
     : m_inst(inst), m_logger(logger) {}
 
 void RpcServer::Start() {
-  DoStart(m_inst, m_logger);
+  DoStart(m_inst, m_logger, m_num_workers.load());
 }
 
 unsigned int RpcServer::Add(
@@ -39,6 +118,9 @@ void RpcServer::ProcessRpc(unsigned int local_id, unsigned int call_uid,
 bool RpcServer::PostRpcResponse(unsigned int local_id, unsigned int call_uid,
                                 std::string_view result) {
   auto thr = GetThread();
+  if (!thr) {
+    return false;
+  }
   auto i = thr->m_response_map.find(impl::RpcIdPair{local_id, call_uid});
   if (i == thr->m_response_map.end()) {
     WARNING("{}",
@@ -49,3 +131,10 @@ bool RpcServer::PostRpcResponse(unsigned int local_id, unsigned int call_uid,
   thr->m_response_map.erase(i);
   return true;
 }
+
+void RpcServer::SetWorkerThreads(unsigned int count) {
+  m_num_workers = count;
+  if (auto thr = GetThread()) {
+    thr->m_num_workers = count;
+  }
+}
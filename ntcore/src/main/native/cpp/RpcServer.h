@@ -5,10 +5,16 @@
 #ifndef NTCORE_RPCSERVER_H_
 #define NTCORE_RPCSERVER_H_
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <wpi/CallbackManager.h>
 #include <wpi/DenseMap.h>
+#include <wpi/condition_variable.h>
 #include <wpi/mutex.h>
 
 #include "Handle.h"
@@ -38,8 +44,11 @@ class RpcServerThread
     : public wpi::CallbackThread<RpcServerThread, RpcAnswer, RpcListenerData,
                                  RpcNotifierData> {
  public:
-  RpcServerThread(int inst, wpi::Logger& logger)
-      : m_inst(inst), m_logger(logger) {}
+  RpcServerThread(int inst, wpi::Logger& logger, unsigned int num_workers)
+      : m_inst(inst), m_logger(logger), m_num_workers(num_workers) {}
+  ~RpcServerThread() override;
+
+  void Main() override;
 
   bool Matches(const RpcListenerData& /*listener*/,
                const RpcNotifierData& data) {
@@ -53,27 +62,31 @@ class RpcServerThread
     m_response_map.insert(std::make_pair(lookup_uid, data->send_response));
   }
 
+  // Runs the callback on this thread, or on a worker if there are any.
   void DoCallback(std::function<void(const RpcAnswer& call)> callback,
-                  const RpcNotifierData& data) {
-    DEBUG4("rpc calling {}", data.name);
-    unsigned int local_id = Handle{data.entry}.GetIndex();
-    unsigned int call_uid = Handle{data.call}.GetIndex();
-    RpcIdPair lookup_uid{local_id, call_uid};
-    callback(data);
-    {
-      std::scoped_lock lock(m_mutex);
-      auto i = m_response_map.find(lookup_uid);
-      if (i != m_response_map.end()) {
-        // post an empty response and erase it
-        (i->getSecond())("");
-        m_response_map.erase(i);
-      }
-    }
-  }
+                  const RpcNotifierData& data);
+
+  // Runs the callback, then sends an empty response if the callback didn't
+  // post one.
+  void RunCallback(const std::function<void(const RpcAnswer& call)>& callback,
+                   const RpcNotifierData& data);
+
+  void WorkerMain();
+  void StopWorkers();
 
   int m_inst;
   wpi::Logger& m_logger;
   wpi::DenseMap<RpcIdPair, IRpcServer::SendResponseFunc> m_response_map;
+
+  // Worker pool for callbacks.  Started on first use, and only grows.
+  std::atomic<unsigned int> m_num_workers;
+  wpi::mutex m_work_mutex;
+  wpi::condition_variable m_work_cond;
+  std::deque<std::pair<std::function<void(const RpcAnswer& call)>,
+                       RpcNotifierData>>
+      m_work;
+  std::vector<std::thread> m_workers;
+  bool m_workers_stop = false;
 };
 
 }  // namespace impl
@@ -101,9 +114,15 @@ class RpcServer
   bool PostRpcResponse(unsigned int local_id, unsigned int call_uid,
                        std::string_view result);
 
+  // Run callbacks on this many worker threads, so several calls (including
+  // several calls of the same RPC) may be serviced at once.  With zero,
+  // callbacks run one at a time on the callback thread.
+  void SetWorkerThreads(unsigned int count);
+
  private:
   int m_inst;
   wpi::Logger& m_logger;
+  std::atomic<unsigned int> m_num_workers{0};
 };
 
 }  // namespace nt
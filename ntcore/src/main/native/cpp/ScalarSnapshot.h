@@ -0,0 +1,58 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_SCALARSNAPSHOT_H_
+#define NTCORE_SCALARSNAPSHOT_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "ntcore_c.h"
+
+namespace nt {
+
+/* A seqlock-protected copy of an entry's type and, for a boolean or double,
+ * its value bits and last change time.  Readers never block; they retry if a
+ * store happened while they were reading.  Stores must be serialized by the
+ * caller.
+ */
+class ScalarSnapshot {
+ public:
+  void Store(NT_Type type, uint64_t bits, uint64_t last_change) {
+    unsigned int seq = m_seq.load(std::memory_order_relaxed);
+    m_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_type.store(type, std::memory_order_relaxed);
+    m_bits.store(bits, std::memory_order_relaxed);
+    m_last_change.store(last_change, std::memory_order_relaxed);
+    m_seq.store(seq + 2, std::memory_order_release);
+  }
+
+  void Load(NT_Type* type, uint64_t* bits, uint64_t* last_change) const {
+    for (;;) {
+      unsigned int seq = m_seq.load(std::memory_order_acquire);
+      if ((seq & 1) != 0) {
+        continue;  // store in progress
+      }
+      *type = m_type.load(std::memory_order_relaxed);
+      *bits = m_bits.load(std::memory_order_relaxed);
+      *last_change = m_last_change.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (m_seq.load(std::memory_order_relaxed) == seq) {
+        return;
+      }
+    }
+  }
+
+ private:
+  std::atomic<unsigned int> m_seq{0};
+  std::atomic<NT_Type> m_type{NT_UNASSIGNED};
+  std::atomic<uint64_t> m_bits{0};
+  std::atomic<uint64_t> m_last_change{0};
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_SCALARSNAPSHOT_H_
@@ -4,7 +4,13 @@
 
 #include "Storage.h"
 
+#include <algorithm>
+#include <string>
+
+#include <wpi/MathExtras.h>
 #include <wpi/StringExtras.h>
+#include <wpi/lock_stats.h>
+#include <wpi/raw_istream.h>
 #include <wpi/timestamp.h>
 
 #include "Handle.h"
@@ -13,6 +19,8 @@
 #include "INetworkConnection.h"
 #include "IRpcServer.h"
 #include "Log.h"
+#include "WireDecoder.h"
+#include "WireEncoder.h"
 
 using namespace nt;
 
@@ -20,11 +28,18 @@ Storage::Storage(IEntryNotifier& notifier, IRpcServer& rpc_server,
                  wpi::Logger& logger)
     : m_notifier(notifier), m_rpc_server(rpc_server), m_logger(logger) {
   m_terminating = false;
+  wpi::SetLockName(m_mutex, "NT storage");
 }
 
 Storage::~Storage() {
   m_terminating = true;
   m_rpc_results_cond.notify_all();
+  std::scoped_lock lock(m_mutex);
+  for (auto&& entry : m_localmap) {
+    if (entry->local_channel) {
+      entry->local_channel->Wake();
+    }
+  }
 }
 
 void Storage::SetDispatcher(IDispatcher* dispatcher, bool server) {
@@ -83,6 +98,9 @@ void Storage::ProcessIncoming(std::shared_ptr<Message> msg,
     case Message::kRpcResponse:
       ProcessIncomingRpcResponse(std::move(msg), conn);
       break;
+    case Message::kSubscribe:
+      ProcessIncomingSubscribe(std::move(msg), conn);
+      break;
     default:
       break;
   }
@@ -109,6 +127,8 @@ void Storage::ProcessIncomingEntryAssign(std::shared_ptr<Message> msg,
 
       entry->flags = msg->flags();
       entry->seq_num = seq_num;
+      // the sender needs to see the assigned id even if it didn't subscribe
+      conn->subscriptions().AddName(name);
       SetEntryValueImpl(entry, msg->value(), lock, false);
       return;
     }
@@ -140,6 +160,7 @@ void Storage::ProcessIncomingEntryAssign(std::shared_ptr<Message> msg,
         // didn't exist at all (rather than just being a response to a
         // id assignment request)
         entry->value = msg->value();
+        RecordValue(entry);
         entry->flags = msg->flags();
         entry->seq_num = seq_num;
 
@@ -190,7 +211,7 @@ void Storage::ProcessIncomingEntryAssign(std::shared_ptr<Message> msg,
   if (!may_need_update && conn->proto_rev() >= 0x0300) {
     // update persistent dirty flag if persistent flag changed
     if ((entry->flags & NT_PERSISTENT) != (msg->flags() & NT_PERSISTENT)) {
-      m_persistent_dirty = true;
+      MarkPersistentDirty(entry);
     }
     if (entry->flags != msg->flags()) {
       notify_flags |= NT_NOTIFY_FLAGS;
@@ -200,11 +221,12 @@ void Storage::ProcessIncomingEntryAssign(std::shared_ptr<Message> msg,
 
   // update persistent dirty flag if the value changed and it's persistent
   if (entry->IsPersistent() && *entry->value != *msg->value()) {
-    m_persistent_dirty = true;
+    MarkPersistentDirty(entry);
   }
 
   // update local
   entry->value = msg->value();
+  RecordValue(entry);
   entry->seq_num = seq_num;
 
   // notify
@@ -242,11 +264,12 @@ void Storage::ProcessIncomingEntryUpdate(std::shared_ptr<Message> msg,
 
   // update local
   entry->value = msg->value();
+  RecordValue(entry);
   entry->seq_num = seq_num;
 
   // update persistent dirty flag if it's a persistent value
   if (entry->IsPersistent()) {
-    m_persistent_dirty = true;
+    MarkPersistentDirty(entry);
   }
 
   // notify
@@ -257,8 +280,12 @@ void Storage::ProcessIncomingEntryUpdate(std::shared_ptr<Message> msg,
   // be any other connections, so don't bother)
   if (m_server && m_dispatcher) {
     auto dispatcher = m_dispatcher;
+    bool high_priority = entry->priority == NT_PRIORITY_HIGH;
     lock.unlock();
     dispatcher->QueueOutgoing(msg, nullptr, conn);
+    if (high_priority) {
+      dispatcher->FlushOutgoing();
+    }
   }
 }
 
@@ -363,7 +390,10 @@ void Storage::ProcessIncomingExecuteRpc(
       [=](std::string_view result) {
         auto c = conn_weak.lock();
         if (c) {
+          // send right away rather than at the next periodic update, as the
+          // caller is likely waiting on it
           c->QueueOutgoing(Message::RpcResponse(id, call_uid, result));
+          c->PostOutgoing(false);
         }
       },
       entry->rpc_uid);
@@ -394,24 +424,130 @@ void Storage::ProcessIncomingRpcResponse(std::shared_ptr<Message> msg,
   m_rpc_results_cond.notify_all();
 }
 
+void Storage::ProcessIncomingSubscribe(std::shared_ptr<Message> msg,
+                                       INetworkConnection* conn) {
+  if (!m_server) {
+    return;  // only the server filters
+  }
+  auto prefixes = msg->prefixes();
+  auto& filter = conn->subscriptions();
+  std::scoped_lock lock(m_mutex);
+  // Assign the newly matched entries.  This is queued with the lock held so
+  // later updates to them follow the assignments.  Entries that are no
+  // longer matched just stop being updated.
+  std::vector<std::shared_ptr<Message>> assigns;
+  SubscribeEntries(*conn, prefixes, [&](Entry* entry) {
+    if (!filter.IsSubscribed(entry->id)) {
+      assigns.emplace_back(Message::EntryAssign(entry->name, entry->id,
+                                                entry->seq_num.value(),
+                                                entry->value, entry->flags));
+    }
+  });
+  DEBUG0("server: client subscribed to {} prefixes, assigning {} entries",
+         prefixes.size(), assigns.size());
+  for (auto& assign : assigns) {
+    conn->QueueOutgoing(std::move(assign));
+  }
+}
+
 void Storage::GetInitialAssignments(
     INetworkConnection& conn, std::vector<std::shared_ptr<Message>>* msgs) {
   std::scoped_lock lock(m_mutex);
   conn.set_state(INetworkConnection::kSynchronized);
-  for (auto& i : m_entries) {
-    Entry* entry = i.getValue();
-    if (!entry->value) {
-      continue;
+  SubscribeEntries(conn, conn.subscriptions().GetPrefixes(), [&](Entry* entry) {
+    msgs->emplace_back(Message::EntryAssign(entry->name, entry->id,
+                                            entry->seq_num.value(),
+                                            entry->value, entry->flags));
+  });
+}
+
+namespace {
+struct DigestEntry {
+  bool present = false;
+  unsigned int seq_num = 0;
+  unsigned int flags = 0;
+};
+}  // namespace
+
+// Parses a session digest into a table indexed by id.
+static bool ParseSessionDigest(std::string_view digest, wpi::Logger& logger,
+                               std::vector<DigestEntry>* entries) {
+  wpi::raw_mem_istream is(digest.data(), digest.size());
+  WireDecoder decoder(is, 0x0300u, logger);
+  while (is.in_avail() > 0) {
+    uint64_t id;
+    DigestEntry entry;
+    if (!decoder.ReadUleb128(&id) || !decoder.Read16(&entry.seq_num) ||
+        !decoder.Read8(&entry.flags) || id >= 0xffff) {
+      return false;
     }
-    msgs->emplace_back(Message::EntryAssign(i.getKey(), entry->id,
+    if (id >= entries->size()) {
+      entries->resize(id + 1);
+    }
+    entry.present = true;
+    (*entries)[id] = entry;
+  }
+  return true;
+}
+
+bool Storage::GetResumeAssignments(
+    INetworkConnection& conn, std::string_view digest,
+    std::vector<std::shared_ptr<Message>>* msgs) {
+  std::vector<DigestEntry> known;
+  if (!ParseSessionDigest(digest, m_logger, &known)) {
+    return false;
+  }
+
+  std::scoped_lock lock(m_mutex);
+  conn.set_state(INetworkConnection::kSynchronized);
+  // Deletes go first, so that an entry that was deleted and recreated under
+  // a new id is reassigned rather than deleted.  Ids are never reused on the
+  // server, so the client's id still names the same entry if it exists.
+  for (unsigned int id = 0; id < known.size(); ++id) {
+    if (known[id].present &&
+        (id >= m_idmap.size() || !m_idmap[id] || !m_idmap[id]->value)) {
+      msgs->emplace_back(Message::EntryDelete(id));
+    }
+  }
+  SubscribeEntries(conn, conn.subscriptions().GetPrefixes(), [&](Entry* entry) {
+    if (entry->id < known.size()) {
+      auto& k = known[entry->id];
+      if (k.present && k.seq_num == entry->seq_num.value() &&
+          k.flags == entry->flags) {
+        return;  // client is up to date
+      }
+    }
+    msgs->emplace_back(Message::EntryAssign(entry->name, entry->id,
                                             entry->seq_num.value(),
                                             entry->value, entry->flags));
+  });
+  return true;
+}
+
+void Storage::GetSessionDigest(std::string* digest) const {
+  std::scoped_lock lock(m_mutex);
+  WireEncoder encoder(0x0300u);
+  for (auto entry : m_idmap) {
+    if (!entry || !entry->value) {
+      continue;
+    }
+    encoder.WriteUleb128(entry->id);
+    encoder.Write16(entry->seq_num.value());
+    encoder.Write8(entry->flags);
   }
+  digest->assign(encoder.ToStringView());
 }
 
 void Storage::ApplyInitialAssignments(
     INetworkConnection& conn, wpi::span<std::shared_ptr<Message>> msgs,
-    bool /*new_server*/, std::vector<std::shared_ptr<Message>>* out_msgs) {
+    bool /*new_server*/, std::string_view resume_digest,
+    std::vector<std::shared_ptr<Message>>* out_msgs) {
+  std::vector<DigestEntry> known;
+  if (!resume_digest.empty()) {
+    // this was checked when it was sent
+    ParseSessionDigest(resume_digest, m_logger, &known);
+  }
+
   std::unique_lock lock(m_mutex);
   if (m_server) {
     return;  // should not do this on server
@@ -421,16 +557,40 @@ void Storage::ApplyInitialAssignments(
 
   std::vector<std::shared_ptr<Message>> update_msgs;
 
-  // clear existing id's
-  for (auto& i : m_entries) {
-    i.getValue()->id = 0xffff;
-  }
+  if (known.empty()) {
+    // clear existing id's
+    for (auto& i : m_entries) {
+      i.getValue()->id = 0xffff;
+    }
+
+    // clear existing idmap
+    m_idmap.resize(0);
 
-  // clear existing idmap
-  m_idmap.resize(0);
+    // Updates still pending under the old ids, such as rate limited low
+    // priority ones, must not reach the server.  This is done under the lock
+    // so no update is queued under a new id first.
+    if (m_dispatcher) {
+      m_dispatcher->ClearPendingUpdates();
+    }
+  }
 
   // apply assignments
   for (auto& msg : msgs) {
+    if (!known.empty() && msg->Is(Message::kEntryDelete)) {
+      // unassign; it's deleted below unless written locally
+      unsigned int id = msg->id();
+      if (id < m_idmap.size() && m_idmap[id]) {
+        m_idmap[id]->id = 0xffff;
+        m_idmap[id] = nullptr;
+        if (m_dispatcher) {
+          m_dispatcher->ClearPendingUpdate(id);
+        }
+      }
+      if (id < known.size()) {
+        known[id].present = false;
+      }
+      continue;
+    }
     if (!msg->Is(Message::kEntryAssign)) {
       DEBUG0("{}", "client: received non-entry assignment request?");
       continue;
@@ -451,6 +611,7 @@ void Storage::ApplyInitialAssignments(
     if (!entry->value) {
       // doesn't currently exist
       entry->value = msg->value();
+      RecordValue(entry);
       entry->flags = msg->flags();
       // notify
       m_notifier.NotifyEntry(entry->local_id, name, entry->value,
@@ -465,6 +626,7 @@ void Storage::ApplyInitialAssignments(
             entry->id, entry->seq_num.value(), entry->value));
       } else {
         entry->value = msg->value();
+        RecordValue(entry);
         unsigned int notify_flags = NT_NOTIFY_UPDATE;
         // don't update flags from a <3.0 remote (not part of message)
         if (conn.proto_rev() >= 0x0300) {
@@ -484,6 +646,29 @@ void Storage::ApplyInitialAssignments(
       m_idmap.resize(id + 1);
     }
     m_idmap[id] = entry;
+    if (id < known.size()) {
+      known[id].present = false;
+    }
+  }
+
+  // Entries the server didn't send were up to date with the digest, but may
+  // have been written locally since it was taken; those writes were dropped
+  // because the connection wasn't active yet.
+  for (unsigned int id = 0; id < known.size(); ++id) {
+    if (!known[id].present || id >= m_idmap.size() || !m_idmap[id]) {
+      continue;
+    }
+    Entry* entry = m_idmap[id];
+    if (!entry->value) {
+      continue;
+    }
+    if (entry->seq_num.value() != known[id].seq_num) {
+      update_msgs.emplace_back(
+          Message::EntryUpdate(id, entry->seq_num.value(), entry->value));
+    }
+    if (entry->flags != known[id].flags) {
+      update_msgs.emplace_back(Message::FlagsUpdate(id, entry->flags));
+    }
   }
 
   // delete or generate assign messages for unassigned local entries
@@ -520,11 +705,39 @@ std::shared_ptr<Value> Storage::GetEntryValue(std::string_view name) const {
 }
 
 std::shared_ptr<Value> Storage::GetEntryValue(unsigned int local_id) const {
-  std::scoped_lock lock(m_mutex);
-  if (local_id >= m_localmap.size()) {
+  if (local_id >= m_fast_localmap.kCapacity) {
+    std::scoped_lock lock(m_mutex);
+    if (local_id >= m_localmap.size()) {
+      return nullptr;
+    }
+    return m_localmap[local_id]->value;
+  }
+
+  // Lock-free; booleans and doubles are returned as a copy of the snapshot
+  // (see PublishValue()).
+  const Entry* entry = m_fast_localmap.Get(local_id);
+  if (!entry) {
     return nullptr;
   }
-  return m_localmap[local_id]->value;
+  for (;;) {
+    if (auto value = std::atomic_load(&entry->published)) {
+      return value;
+    }
+    NT_Type type;
+    uint64_t bits;
+    uint64_t last_change;
+    entry->snapshot.Load(&type, &bits, &last_change);
+    switch (type) {
+      case NT_UNASSIGNED:
+        return nullptr;
+      case NT_BOOLEAN:
+        return Value::MakeBoolean(bits != 0, last_change);
+      case NT_DOUBLE:
+        return Value::MakeDouble(wpi::BitsToDouble(bits), last_change);
+      default:
+        break;  // changed to another type between the loads; try again
+    }
+  }
 }
 
 bool Storage::SetDefaultEntryValue(std::string_view name,
@@ -605,14 +818,168 @@ bool Storage::SetEntryValue(unsigned int local_id,
   return true;
 }
 
+bool Storage::SetEntryValues(wpi::span<const unsigned int> local_ids,
+                             wpi::span<const std::shared_ptr<Value>> values) {
+  bool ok = true;
+  ChangeBatch batch;
+  std::unique_lock lock(m_mutex);
+  size_t count = (std::min)(local_ids.size(), values.size());
+  for (size_t i = 0; i < count; ++i) {
+    auto& value = values[i];
+    if (!value || local_ids[i] >= m_localmap.size()) {
+      continue;
+    }
+    Entry* entry = m_localmap[local_ids[i]].get();
+    if (entry->value && entry->value->type() != value->type()) {
+      ok = false;  // error on type mismatch
+      continue;
+    }
+    SetEntryValueImpl(entry, value, lock, true, &batch);
+  }
+  SendChangeBatch(batch, lock);
+  return ok;
+}
+
+void Storage::SendChangeBatch(ChangeBatch& batch,
+                              std::unique_lock<wpi::mutex>& lock) {
+  if (!batch.notifications.empty()) {
+    m_notifier.NotifyEntries(batch.notifications);
+  }
+  if (batch.outgoing.empty() || !m_dispatcher) {
+    return;
+  }
+  auto dispatcher = m_dispatcher;
+  lock.unlock();
+  dispatcher->QueueOutgoingBatch(batch.outgoing);
+  if (std::any_of(batch.outgoing.begin(), batch.outgoing.end(),
+                  [](const auto& out) {
+                    return out.priority == NT_PRIORITY_HIGH;
+                  })) {
+    dispatcher->FlushOutgoing();
+  }
+}
+
+void Storage::GetEntryValues(
+    wpi::span<const unsigned int> local_ids,
+    std::vector<std::shared_ptr<Value>>* values) const {
+  // GetEntryValue() is lock-free for almost all ids, so there's nothing to
+  // gain by taking the lock once
+  values->clear();
+  values->reserve(local_ids.size());
+  for (auto local_id : local_ids) {
+    values->emplace_back(GetEntryValue(local_id));
+  }
+}
+
+LocalChannel* Storage::GetLocalChannel(unsigned int local_id) {
+  if (Entry* entry = m_fast_localmap.Get(local_id)) {
+    if (auto channel = entry->channel.load(std::memory_order_acquire)) {
+      return channel;
+    }
+  }
+
+  std::scoped_lock lock(m_mutex);
+  if (local_id >= m_localmap.size()) {
+    return nullptr;
+  }
+  Entry* entry = m_localmap[local_id].get();
+  if (!entry->local_channel) {
+    entry->local_channel = std::make_unique<LocalChannel>(local_id);
+    entry->local_channel->Deliver(entry->value);
+    entry->channel.store(entry->local_channel.get(),
+                         std::memory_order_release);
+  }
+  return entry->local_channel.get();
+}
+
+bool Storage::PublishLocalEntryValue(unsigned int local_id,
+                                     std::shared_ptr<Value> value) {
+  if (!value) {
+    return true;
+  }
+  auto channel = GetLocalChannel(local_id);
+  if (!channel) {
+    return true;
+  }
+  // the channel holds the entry's value unless a newer one is being
+  // published, so checking it is enough
+  auto cur = channel->GetValue();
+  if (cur && cur->type() != value->type()) {
+    return false;  // error on type mismatch
+  }
+  if (!channel->Publish(std::move(value))) {
+    return true;  // already queued
+  }
+
+  // push onto the dirty list
+  auto head = m_dirty_channels.load(std::memory_order_relaxed);
+  do {
+    channel->next_dirty = head;
+  } while (!m_dirty_channels.compare_exchange_weak(
+      head, channel, std::memory_order_release, std::memory_order_relaxed));
+
+  // without the dispatcher thread there's nothing to batch for
+  if (!m_periodic_mirror) {
+    MirrorLocalChannels();
+  }
+  return true;
+}
+
+bool Storage::ReadLocalEntryValue(unsigned int local_id, uint64_t* seq,
+                                  std::shared_ptr<Value>* value) {
+  auto channel = GetLocalChannel(local_id);
+  return channel && channel->Read(seq, value);
+}
+
+bool Storage::WaitForLocalEntryValue(unsigned int local_id, uint64_t* seq,
+                                     std::shared_ptr<Value>* value,
+                                     double timeout) {
+  auto channel = GetLocalChannel(local_id);
+  return channel && channel->Wait(seq, value, timeout, m_terminating);
+}
+
+void Storage::SetPeriodicMirror(bool periodic) {
+  m_periodic_mirror = periodic;
+  if (!periodic) {
+    MirrorLocalChannels();
+  }
+}
+
+void Storage::MirrorLocalChannels() {
+  auto channel = m_dirty_channels.exchange(nullptr, std::memory_order_acquire);
+  if (!channel) {
+    return;
+  }
+  ChangeBatch batch;
+  std::unique_lock lock(m_mutex);
+  while (channel) {
+    // read the link first; once TakeDirty() is called, the channel may be
+    // pushed onto the list again
+    auto next = channel->next_dirty;
+    auto value = channel->TakeDirty();
+    Entry* entry = m_localmap[channel->local_id].get();
+    if (!value || value == entry->value) {
+      // already set
+    } else if (entry->value && entry->value->type() != value->type()) {
+      // the entry's type changed after the value was published; drop it
+      channel->Deliver(entry->value);
+    } else {
+      SetEntryValueImpl(entry, std::move(value), lock, true, &batch);
+    }
+    channel = next;
+  }
+  SendChangeBatch(batch, lock);
+}
+
 void Storage::SetEntryValueImpl(Entry* entry, std::shared_ptr<Value> value,
-                                std::unique_lock<wpi::mutex>& lock,
-                                bool local) {
+                                std::unique_lock<wpi::mutex>& lock, bool local,
+                                ChangeBatch* batch) {
   if (!value) {
     return;
   }
   auto old_value = entry->value;
   entry->value = value;
+  RecordValue(entry);
 
   // if we're the server, assign an id if it doesn't have one
   if (m_server && entry->id == 0xffff) {
@@ -623,16 +990,24 @@ void Storage::SetEntryValueImpl(Entry* entry, std::shared_ptr<Value> value,
 
   // update persistent dirty flag if value changed and it's persistent
   if (entry->IsPersistent() && (!old_value || *old_value != *value)) {
-    m_persistent_dirty = true;
+    MarkPersistentDirty(entry);
   }
 
   // notify
+  unsigned int notify_flags = 0;
   if (!old_value) {
-    m_notifier.NotifyEntry(entry->local_id, entry->name, value,
-                           NT_NOTIFY_NEW | (local ? NT_NOTIFY_LOCAL : 0));
+    notify_flags = NT_NOTIFY_NEW | (local ? NT_NOTIFY_LOCAL : 0);
   } else if (*old_value != *value) {
-    m_notifier.NotifyEntry(entry->local_id, entry->name, value,
-                           NT_NOTIFY_UPDATE | (local ? NT_NOTIFY_LOCAL : 0));
+    notify_flags = NT_NOTIFY_UPDATE | (local ? NT_NOTIFY_LOCAL : 0);
+  }
+  if (notify_flags != 0) {
+    if (batch) {
+      batch->notifications.push_back(
+          {entry->local_id, entry->name, value, notify_flags});
+    } else {
+      m_notifier.NotifyEntry(entry->local_id, entry->name, value,
+                             notify_flags);
+    }
   }
 
   // remember local changes
@@ -651,19 +1026,283 @@ void Storage::SetEntryValueImpl(Entry* entry, std::shared_ptr<Value> value,
     }
     auto msg = Message::EntryAssign(
         entry->name, entry->id, entry->seq_num.value(), value, entry->flags);
+    if (batch) {
+      batch->outgoing.push_back(
+          {std::move(msg), 0, 0, nullptr, entry->priority});
+      return;
+    }
+    bool high_priority = entry->priority == NT_PRIORITY_HIGH;
     lock.unlock();
     dispatcher->QueueOutgoing(msg, nullptr, nullptr);
+    if (high_priority) {
+      dispatcher->FlushOutgoing();
+    }
   } else if (*old_value != *value) {
     if (local) {
       ++entry->seq_num;
     }
     // don't send an update if we don't have an assigned id yet
     if (entry->id != 0xffff) {
-      auto msg = Message::EntryUpdate(entry->id, entry->seq_num.value(), value);
+      unsigned int id = entry->id;
+      unsigned int seq_num = entry->seq_num.value();
+      unsigned int priority = entry->priority;
+      if (batch) {
+        batch->outgoing.push_back(
+            {nullptr, id, seq_num, std::move(value), priority});
+        return;
+      }
       lock.unlock();
-      dispatcher->QueueOutgoing(msg, nullptr, nullptr);
+      dispatcher->QueueOutgoingUpdate(id, seq_num, std::move(value), priority);
+      if (priority == NT_PRIORITY_HIGH) {
+        dispatcher->FlushOutgoing();
+      }
+    }
+  }
+}
+
+void Storage::SetEntryHistoryDepth(unsigned int local_id, size_t depth) {
+  std::scoped_lock lock(m_mutex);
+  if (local_id >= m_localmap.size()) {
+    return;
+  }
+  Entry* entry = m_localmap[local_id].get();
+  if (depth == 0) {
+    entry->history.reset();
+    return;
+  }
+  // keep the newest values that fit
+  auto history =
+      std::make_unique<wpi::circular_buffer<std::shared_ptr<Value>>>(depth);
+  if (entry->history) {
+    size_t size = entry->history->size();
+    for (size_t i = size > depth ? size - depth : 0; i < size; ++i) {
+      history->push_back((*entry->history)[i]);
     }
   }
+  if (entry->value &&
+      (history->size() == 0 || *history->back() != *entry->value)) {
+    history->push_back(entry->value);
+  }
+  entry->history = std::move(history);
+}
+
+const char* Storage::StartDataLog(std::string_view filename) {
+  StopDataLog();
+  auto logger = std::make_unique<DataLogger>(m_logger);
+  if (auto err = logger->Start(filename)) {
+    return err;
+  }
+  std::scoped_lock lock(m_mutex);
+  if (m_data_logger) {
+    return "data log already started";
+  }
+  m_data_logger = std::move(logger);
+  // start the log with the current values
+  for (auto& entry : m_localmap) {
+    if (entry->value) {
+      m_data_logger->Append(entry->local_id, entry->name, *entry->value);
+    }
+  }
+  return nullptr;
+}
+
+void Storage::StartDataLog(wpi::log::DataLog& log, std::string_view prefix,
+                           std::string_view logPrefix) {
+  std::scoped_lock lock(m_mutex);
+  m_entry_log = std::make_unique<EntryLogSink>(log, prefix, logPrefix);
+  // start the log with the current values
+  for (auto& entry : m_localmap) {
+    if (entry->value) {
+      m_entry_log->Append(entry->local_id, entry->name, *entry->value);
+    }
+  }
+}
+
+void Storage::StopDataLog() {
+  std::unique_lock lock(m_mutex);
+  auto logger = std::move(m_data_logger);
+  m_entry_log.reset();
+  lock.unlock();
+  if (logger) {
+    logger->Stop();
+  }
+}
+
+std::vector<std::shared_ptr<Value>> Storage::GetEntryHistory(
+    unsigned int local_id, uint64_t since) const {
+  std::vector<std::shared_ptr<Value>> values;
+  std::scoped_lock lock(m_mutex);
+  if (local_id >= m_localmap.size()) {
+    return values;
+  }
+  auto& history = m_localmap[local_id]->history;
+  if (!history) {
+    return values;
+  }
+  for (auto& value : *history) {
+    if (value->last_change() > since) {
+      values.emplace_back(value);
+    }
+  }
+  return values;
+}
+
+bool Storage::GetEntryBoolean(unsigned int local_id, bool* value,
+                              uint64_t* last_change) const {
+  uint64_t bits;
+  if (!GetEntryScalar(local_id, NT_BOOLEAN, &bits, last_change)) {
+    return false;
+  }
+  *value = bits != 0;
+  return true;
+}
+
+bool Storage::GetEntryDouble(unsigned int local_id, double* value,
+                             uint64_t* last_change) const {
+  uint64_t bits;
+  if (!GetEntryScalar(local_id, NT_DOUBLE, &bits, last_change)) {
+    return false;
+  }
+  *value = wpi::BitsToDouble(bits);
+  return true;
+}
+
+bool Storage::GetEntryScalar(unsigned int local_id, NT_Type type,
+                             uint64_t* bits, uint64_t* last_change) const {
+  const Entry* entry;
+  std::unique_lock lock(m_mutex, std::defer_lock);
+  if (local_id < m_fast_localmap.kCapacity) {
+    entry = m_fast_localmap.Get(local_id);
+  } else {
+    lock.lock();
+    entry =
+        local_id < m_localmap.size() ? m_localmap[local_id].get() : nullptr;
+  }
+  if (!entry) {
+    return false;
+  }
+  NT_Type cur_type;
+  uint64_t cur_last_change;
+  entry->snapshot.Load(&cur_type, bits, &cur_last_change);
+  if (cur_type != type) {
+    return false;
+  }
+  if (last_change) {
+    *last_change = cur_last_change;
+  }
+  return true;
+}
+
+void Storage::PublishValue(Entry* entry) {
+  auto& value = entry->value;
+  if (auto channel = entry->channel.load(std::memory_order_relaxed)) {
+    channel->Deliver(value);
+  }
+  if (value && value->IsBoolean()) {
+    entry->snapshot.Store(NT_BOOLEAN, value->GetBoolean() ? 1 : 0,
+                          value->last_change());
+  } else if (value && value->IsDouble()) {
+    entry->snapshot.Store(NT_DOUBLE, wpi::DoubleToBits(value->GetDouble()),
+                          value->last_change());
+  } else {
+    // publish the value before the type, so a reader that sees the type
+    // also sees the value
+    std::atomic_store(&entry->published, value);
+    entry->snapshot.Store(value ? value->type() : NT_UNASSIGNED, 0, 0);
+    return;
+  }
+  // booleans and doubles may be updated in place, so they must never be
+  // shared through published
+  if (entry->published) {
+    std::atomic_store(&entry->published, std::shared_ptr<Value>{});
+  }
+}
+
+bool Storage::SetEntryBoolean(unsigned int local_id, bool value,
+                              uint64_t time) {
+  NT_Value v;
+  v.type = NT_BOOLEAN;
+  v.last_change = time;
+  v.data.v_boolean = value;
+  return SetEntryScalarValue(local_id, v);
+}
+
+bool Storage::SetEntryDouble(unsigned int local_id, double value,
+                             uint64_t time) {
+  NT_Value v;
+  v.type = NT_DOUBLE;
+  v.last_change = time;
+  v.data.v_double = value;
+  return SetEntryScalarValue(local_id, v);
+}
+
+bool Storage::SetEntryScalarValue(unsigned int local_id,
+                                  const NT_Value& value) {
+  std::unique_lock lock(m_mutex);
+  if (local_id >= m_localmap.size()) {
+    return true;
+  }
+  Entry* entry = m_localmap[local_id].get();
+
+  auto& cur = entry->value;
+  if (cur && cur->type() != value.type) {
+    return false;  // error on type mismatch
+  }
+
+  // If nothing else references the current value, it's safe to update it in
+  // place.  References are only handed out with m_mutex held, so the count
+  // can only drop concurrently; the fence pairs with the release in the last
+  // holder's decrement.  Entries with history keep every value, so always
+  // get a new one.
+  if (!cur || cur.use_count() != 1 || entry->history) {
+    SetEntryValueImpl(entry,
+                      value.type == NT_BOOLEAN
+                          ? Value::MakeBoolean(value.data.v_boolean != 0,
+                                               value.last_change)
+                          : Value::MakeDouble(value.data.v_double,
+                                              value.last_change),
+                      lock, true);
+    return true;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  bool changed = value.type == NT_BOOLEAN
+                     ? cur->m_val.data.v_boolean != value.data.v_boolean
+                     : cur->m_val.data.v_double != value.data.v_double;
+  cur->m_val.data = value.data;
+  cur->m_val.last_change = value.last_change == 0 ? wpi::Now()
+                                                  : value.last_change;
+  entry->local_write = true;
+  RecordValue(entry);
+  if (!changed) {
+    return true;
+  }
+
+  // same handling as a changed value in SetEntryValueImpl()
+  if (entry->IsPersistent()) {
+    MarkPersistentDirty(entry);
+  }
+  m_notifier.NotifyEntry(entry->local_id, entry->name, cur,
+                         NT_NOTIFY_UPDATE | NT_NOTIFY_LOCAL);
+  if (!m_dispatcher) {
+    return true;
+  }
+  ++entry->seq_num;
+  // don't send an update if we don't have an assigned id yet
+  if (entry->id != 0xffff) {
+    auto dispatcher = m_dispatcher;
+    unsigned int id = entry->id;
+    unsigned int seq_num = entry->seq_num.value();
+    unsigned int priority = entry->priority;
+    auto msg_value = cur;
+    lock.unlock();
+    dispatcher->QueueOutgoingUpdate(id, seq_num, std::move(msg_value),
+                                    priority);
+    if (priority == NT_PRIORITY_HIGH) {
+      dispatcher->FlushOutgoing();
+    }
+  }
+  return true;
 }
 
 void Storage::SetEntryTypeValue(std::string_view name,
@@ -726,7 +1365,7 @@ void Storage::SetEntryFlagsImpl(Entry* entry, unsigned int flags,
 
   // update persistent dirty flag if persistent flag changed
   if ((entry->flags & NT_PERSISTENT) != (flags & NT_PERSISTENT)) {
-    m_persistent_dirty = true;
+    MarkPersistentDirty(entry);
   }
 
   entry->flags = flags;
@@ -766,6 +1405,46 @@ unsigned int Storage::GetEntryFlags(unsigned int local_id) const {
   return m_localmap[local_id]->flags;
 }
 
+void Storage::SetEntryPriority(unsigned int local_id, unsigned int priority) {
+  std::scoped_lock lock(m_mutex);
+  if (local_id >= m_localmap.size()) {
+    return;
+  }
+  m_localmap[local_id]->priority = priority;
+}
+
+unsigned int Storage::GetEntryPriority(unsigned int local_id) const {
+  std::scoped_lock lock(m_mutex);
+  if (local_id >= m_localmap.size()) {
+    return NT_PRIORITY_NORMAL;
+  }
+  return m_localmap[local_id]->priority;
+}
+
+void Storage::SetPrefixPriority(std::string_view prefix,
+                                unsigned int priority) {
+  std::scoped_lock lock(m_mutex);
+  auto it = std::find_if(
+      m_prefix_priorities.begin(), m_prefix_priorities.end(),
+      [&](const auto& elem) { return elem.first == prefix; });
+  if (it == m_prefix_priorities.end()) {
+    m_prefix_priorities.emplace_back(prefix, priority);
+  } else {
+    it->second = priority;
+  }
+
+  // entries under a longer prefix keep that prefix's priority
+  ForEachPrefixEntry(prefix, [&](Entry* entry) {
+    for (auto&& elem : m_prefix_priorities) {
+      if (elem.first.size() > prefix.size() &&
+          wpi::starts_with(entry->name, elem.first)) {
+        return;
+      }
+    }
+    entry->priority = priority;
+  });
+}
+
 void Storage::DeleteEntry(std::string_view name) {
   std::unique_lock lock(m_mutex);
   auto i = m_entries.find(name);
@@ -795,6 +1474,7 @@ void Storage::DeleteEntryImpl(Entry* entry, std::unique_lock<wpi::mutex>& lock,
   // empty the value and reset id and local_write flag
   std::shared_ptr<Value> old_value;
   old_value.swap(entry->value);
+  PublishValue(entry);
   entry->id = 0xffff;
   entry->local_write = false;
 
@@ -806,7 +1486,7 @@ void Storage::DeleteEntryImpl(Entry* entry, std::unique_lock<wpi::mutex>& lock,
 
   // update persistent dirty flag if it's a persistent value
   if (entry->IsPersistent()) {
-    m_persistent_dirty = true;
+    MarkPersistentDirty(entry);
   }
 
   // reset flags
@@ -847,6 +1527,7 @@ void Storage::DeleteAllEntriesImpl(bool local, F should_delete) {
       entry->id = 0xffff;
       entry->local_write = false;
       entry->value.reset();
+      PublishValue(entry);
       continue;
     }
   }
@@ -881,10 +1562,72 @@ Storage::Entry* Storage::GetOrNew(std::string_view name) {
     m_localmap.emplace_back(new Entry(name));
     entry = m_localmap.back().get();
     entry->local_id = m_localmap.size() - 1;
+    m_fast_localmap.Set(entry->local_id, entry);
+
+    size_t prefix_len = 0;
+    for (auto&& [prefix, priority] : m_prefix_priorities) {
+      if (prefix.size() >= prefix_len && wpi::starts_with(name, prefix)) {
+        prefix_len = prefix.size();
+        entry->priority = priority;
+      }
+    }
+
+    // keep the sorted index up to date
+    auto it = std::upper_bound(
+        m_sorted.begin(), m_sorted.end(), name,
+        [](std::string_view name, const Entry* other) {
+          return name < other->name;
+        });
+    m_sorted.insert(it, entry);
   }
   return entry;
 }
 
+template <typename F>
+void Storage::ForEachPrefixEntry(std::string_view prefix, F func) const {
+  auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), prefix,
+                             [](const Entry* entry, std::string_view prefix) {
+                               return std::string_view{entry->name} < prefix;
+                             });
+  for (; it != m_sorted.end() && wpi::starts_with((*it)->name, prefix); ++it) {
+    func(*it);
+  }
+}
+
+template <typename F>
+void Storage::SubscribeEntries(INetworkConnection& conn,
+                               wpi::span<const std::string> prefixes,
+                               F func) {
+  auto& filter = conn.subscriptions();
+  std::vector<unsigned int> ids;
+  auto add = [&](Entry* entry) {
+    if (entry->value) {
+      func(entry);
+      ids.push_back(entry->id);
+    }
+  };
+  // normalizes the prefixes without touching conn's filter yet
+  SubscriptionFilter matcher;
+  matcher.Set(prefixes, {});
+  if (!matcher.IsActive()) {
+    for (auto& i : m_entries) {
+      add(i.getValue());
+    }
+  } else {
+    // the normalized prefixes don't overlap, so each entry is visited once
+    for (auto&& prefix : matcher.GetPrefixes()) {
+      ForEachPrefixEntry(prefix, add);
+    }
+    for (auto&& name : filter.GetNames()) {
+      auto it = m_entries.find(name);
+      if (it != m_entries.end() && !matcher.Matches(name)) {
+        add(it->getValue());
+      }
+    }
+  }
+  filter.Set(prefixes, ids);
+}
+
 unsigned int Storage::GetEntry(std::string_view name) {
   if (name.empty()) {
     return UINT_MAX;
@@ -897,17 +1640,16 @@ std::vector<unsigned int> Storage::GetEntries(std::string_view prefix,
                                               unsigned int types) {
   std::scoped_lock lock(m_mutex);
   std::vector<unsigned int> ids;
-  for (auto& i : m_entries) {
-    Entry* entry = i.getValue();
+  ForEachPrefixEntry(prefix, [&](Entry* entry) {
     auto value = entry->value.get();
-    if (!value || !wpi::starts_with(i.getKey(), prefix)) {
-      continue;
+    if (!value) {
+      return;
     }
     if (types != 0 && (types & value->type()) == 0) {
-      continue;
+      return;
     }
     ids.push_back(entry->local_id);
-  }
+  });
   return ids;
 }
 
@@ -971,23 +1713,22 @@ std::vector<EntryInfo> Storage::GetEntryInfo(int inst, std::string_view prefix,
                                              unsigned int types) {
   std::scoped_lock lock(m_mutex);
   std::vector<EntryInfo> infos;
-  for (auto& i : m_entries) {
-    Entry* entry = i.getValue();
+  ForEachPrefixEntry(prefix, [&](Entry* entry) {
     auto value = entry->value.get();
-    if (!value || !wpi::starts_with(i.getKey(), prefix)) {
-      continue;
+    if (!value) {
+      return;
     }
     if (types != 0 && (types & value->type()) == 0) {
-      continue;
+      return;
     }
     EntryInfo info;
     info.entry = Handle(inst, entry->local_id, Handle::kEntry);
-    info.name = i.getKey();
+    info.name = entry->name;
     info.type = value->type();
     info.flags = entry->flags;
     info.last_change = value->last_change();
     infos.push_back(std::move(info));
-  }
+  });
   return infos;
 }
 
@@ -999,14 +1740,13 @@ unsigned int Storage::AddListener(
   unsigned int uid = m_notifier.Add(callback, prefix, flags);
   // perform immediate notifications
   if ((flags & NT_NOTIFY_IMMEDIATE) != 0 && (flags & NT_NOTIFY_NEW) != 0) {
-    for (auto& i : m_entries) {
-      Entry* entry = i.getValue();
-      if (!entry->value || !wpi::starts_with(i.getKey(), prefix)) {
-        continue;
+    ForEachPrefixEntry(prefix, [&](Entry* entry) {
+      if (!entry->value) {
+        return;
       }
-      m_notifier.NotifyEntry(entry->local_id, i.getKey(), entry->value,
+      m_notifier.NotifyEntry(entry->local_id, entry->name, entry->value,
                              NT_NOTIFY_IMMEDIATE | NT_NOTIFY_NEW, uid);
-    }
+    });
   }
   return uid;
 }
@@ -1036,17 +1776,13 @@ unsigned int Storage::AddPolledListener(unsigned int poller,
   unsigned int uid = m_notifier.AddPolled(poller, prefix, flags);
   // perform immediate notifications
   if ((flags & NT_NOTIFY_IMMEDIATE) != 0 && (flags & NT_NOTIFY_NEW) != 0) {
-    for (auto& i : m_entries) {
-      if (!wpi::starts_with(i.getKey(), prefix)) {
-        continue;
-      }
-      Entry* entry = i.getValue();
+    ForEachPrefixEntry(prefix, [&](Entry* entry) {
       if (!entry->value) {
-        continue;
+        return;
       }
-      m_notifier.NotifyEntry(entry->local_id, i.getKey(), entry->value,
+      m_notifier.NotifyEntry(entry->local_id, entry->name, entry->value,
                              NT_NOTIFY_IMMEDIATE | NT_NOTIFY_NEW, uid);
-    }
+    });
   }
   return uid;
 }
@@ -1069,6 +1805,46 @@ unsigned int Storage::AddPolledListener(unsigned int poller,
   return uid;
 }
 
+void Storage::MarkPersistentDirty(Entry* entry) {
+  m_persistent_dirty = true;
+  if (!entry->persistent_changed) {
+    entry->persistent_changed = true;
+    m_persistent_changes.push_back(entry);
+  }
+}
+
+bool Storage::GetJournalEntries(
+    bool periodic, bool snapshot,
+    std::vector<std::pair<std::string, std::shared_ptr<Value>>>* entries)
+    const {
+  std::scoped_lock lock(m_mutex);
+  // for periodic, don't write anything unless something has changed
+  if (periodic && m_persistent_changes.empty()) {
+    return false;
+  }
+  if (snapshot) {
+    entries->reserve(m_entries.size());
+    for (auto entry : m_sorted) {
+      if (entry->value && entry->IsPersistent()) {
+        entries->emplace_back(entry->name, entry->value);
+      }
+    }
+  } else {
+    // a null value records that the entry is no longer persistent
+    entries->reserve(m_persistent_changes.size());
+    for (auto entry : m_persistent_changes) {
+      entries->emplace_back(entry->name, entry->IsPersistent()
+                                             ? entry->value
+                                             : std::shared_ptr<Value>{});
+    }
+  }
+  for (auto entry : m_persistent_changes) {
+    entry->persistent_changed = false;
+  }
+  m_persistent_changes.clear();
+  return true;
+}
+
 bool Storage::GetPersistentEntries(
     bool periodic,
     std::vector<std::pair<std::string, std::shared_ptr<Value>>>* entries)
@@ -1082,22 +1858,15 @@ bool Storage::GetPersistentEntries(
     }
     m_persistent_dirty = false;
     entries->reserve(m_entries.size());
-    for (auto& i : m_entries) {
-      Entry* entry = i.getValue();
+    // m_sorted is already in name order
+    for (auto entry : m_sorted) {
       // only write persistent-flagged values
       if (!entry->value || !entry->IsPersistent()) {
         continue;
       }
-      entries->emplace_back(i.getKey(), entry->value);
+      entries->emplace_back(entry->name, entry->value);
     }
   }
-
-  // sort in name order
-  std::sort(entries->begin(), entries->end(),
-            [](const std::pair<std::string, std::shared_ptr<Value>>& a,
-               const std::pair<std::string, std::shared_ptr<Value>>& b) {
-              return a.first < b.first;
-            });
   return true;
 }
 
@@ -1108,23 +1877,13 @@ bool Storage::GetEntries(
   // copy values out of storage as quickly as possible so lock isn't held
   {
     std::scoped_lock lock(m_mutex);
-    entries->reserve(m_entries.size());
-    for (auto& i : m_entries) {
-      Entry* entry = i.getValue();
-      // only write values with given prefix
-      if (!entry->value || !wpi::starts_with(i.getKey(), prefix)) {
-        continue;
+    // only write values with given prefix; these are visited in name order
+    ForEachPrefixEntry(prefix, [&](Entry* entry) {
+      if (entry->value) {
+        entries->emplace_back(entry->name, entry->value);
       }
-      entries->emplace_back(i.getKey(), entry->value);
-    }
+    });
   }
-
-  // sort in name order
-  std::sort(entries->begin(), entries->end(),
-            [](const std::pair<std::string, std::shared_ptr<Value>>& a,
-               const std::pair<std::string, std::shared_ptr<Value>>& b) {
-              return a.first < b.first;
-            });
   return true;
 }
 
@@ -1139,6 +1898,7 @@ void Storage::CreateRpc(unsigned int local_id, std::string_view def,
   auto old_value = entry->value;
   auto value = Value::MakeRpc(def);
   entry->value = value;
+  PublishValue(entry);
 
   // set up the RPC info
   entry->rpc_uid = rpc_uid;
@@ -1218,6 +1978,7 @@ unsigned int Storage::CallRpc(unsigned int local_id, std::string_view params) {
     auto dispatcher = m_dispatcher;
     lock.unlock();
     dispatcher->QueueOutgoing(msg, nullptr, nullptr);
+    dispatcher->FlushOutgoing();
   }
   return call_uid;
 }
@@ -1278,6 +2039,74 @@ bool Storage::GetRpcResult(unsigned int local_id, unsigned int call_uid,
   }
 }
 
+bool Storage::GetRpcResults(unsigned int local_id,
+                            wpi::span<const unsigned int> call_uids,
+                            std::vector<std::string>* results, double timeout,
+                            bool* timed_out) {
+  std::unique_lock lock(m_mutex);
+
+  // only allow one blocking call per rpc call uid
+  for (size_t i = 0; i < call_uids.size(); ++i) {
+    if (!m_rpc_blocking_calls.insert(RpcIdPair{local_id, call_uids[i]})
+             .second) {
+      for (size_t j = 0; j < i; ++j) {
+        m_rpc_blocking_calls.erase(RpcIdPair{local_id, call_uids[j]});
+      }
+      return false;
+    }
+  }
+  auto finish = [&] {
+    for (auto call_uid : call_uids) {
+      m_rpc_blocking_calls.erase(RpcIdPair{local_id, call_uid});
+    }
+  };
+
+  auto timeout_time =
+      std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
+  *timed_out = false;
+  for (;;) {
+    bool all = true;
+    for (auto call_uid : call_uids) {
+      RpcIdPair call_pair{local_id, call_uid};
+      // if element does not exist, we have been canceled
+      if (m_rpc_blocking_calls.count(call_pair) == 0) {
+        finish();
+        return false;
+      }
+      if (m_rpc_results.find(call_pair) == m_rpc_results.end()) {
+        all = false;
+      }
+    }
+    if (all) {
+      break;
+    }
+    if (timeout == 0 || m_terminating) {
+      finish();
+      return false;
+    }
+    if (timeout < 0) {
+      m_rpc_results_cond.wait(lock);
+    } else if (m_rpc_results_cond.wait_until(lock, timeout_time) ==
+               std::cv_status::timeout) {
+      finish();
+      *timed_out = true;
+      return false;
+    }
+  }
+
+  // only take the results once they are all in, so that after a timeout
+  // they can still be collected individually
+  results->clear();
+  results->reserve(call_uids.size());
+  for (auto call_uid : call_uids) {
+    auto i = m_rpc_results.find(RpcIdPair{local_id, call_uid});
+    results->emplace_back(std::move(i->getSecond()));
+    m_rpc_results.erase(i);
+  }
+  finish();
+  return true;
+}
+
 void Storage::CancelRpcResult(unsigned int local_id, unsigned int call_uid) {
   std::unique_lock lock(m_mutex);
   // safe to erase even if id does not exist
@@ -19,12 +19,19 @@
 #include <wpi/DenseMap.h>
 #include <wpi/SmallSet.h>
 #include <wpi/StringMap.h>
+#include <wpi/circular_buffer.h>
 #include <wpi/condition_variable.h>
 #include <wpi/mutex.h>
 #include <wpi/span.h>
 
+#include "DataLogger.h"
+#include "IDispatcher.h"
+#include "IEntryNotifier.h"
 #include "IStorage.h"
+#include "LocalChannel.h"
+#include "LockFreeIndex.h"
 #include "Message.h"
+#include "ScalarSnapshot.h"
 #include "SequenceNumber.h"
 #include "ntcore_cpp.h"
 
@@ -36,7 +43,6 @@ class raw_ostream;
 
 namespace nt {
 
-class IEntryNotifier;
 class INetworkConnection;
 class IRpcServer;
 class IStorageTest;
@@ -67,9 +73,13 @@ class Storage : public IStorage {
   void GetInitialAssignments(
       INetworkConnection& conn,
       std::vector<std::shared_ptr<Message>>* msgs) override;
+  bool GetResumeAssignments(
+      INetworkConnection& conn, std::string_view digest,
+      std::vector<std::shared_ptr<Message>>* msgs) override;
+  void GetSessionDigest(std::string* digest) const override;
   void ApplyInitialAssignments(
       INetworkConnection& conn, wpi::span<std::shared_ptr<Message>> msgs,
-      bool new_server,
+      bool new_server, std::string_view resume_digest,
       std::vector<std::shared_ptr<Message>>* out_msgs) override;
 
   // User functions.  These are the actual implementations of the corresponding
@@ -85,15 +95,63 @@ class Storage : public IStorage {
   bool SetEntryValue(std::string_view name, std::shared_ptr<Value> value);
   bool SetEntryValue(unsigned int local_id, std::shared_ptr<Value> value);
 
+  // Bulk versions of SetEntryValue() and GetEntryValue() by local id.  The
+  // setter takes the lock once, and notifies and sends all the changes as
+  // one batch; it returns false if any value had a type mismatch (those
+  // values aren't set).
+  bool SetEntryValues(wpi::span<const unsigned int> local_ids,
+                      wpi::span<const std::shared_ptr<Value>> values);
+  void GetEntryValues(wpi::span<const unsigned int> local_ids,
+                      std::vector<std::shared_ptr<Value>>* values) const;
+
   void SetEntryTypeValue(std::string_view name, std::shared_ptr<Value> value);
   void SetEntryTypeValue(unsigned int local_id, std::shared_ptr<Value> value);
 
+  // In-process channel accessors (see LocalChannel).  None of these take the
+  // storage lock once the entry's channel exists, except the publisher when
+  // periodic mirroring is off.  Published values reach the entry when the
+  // dispatcher thread calls MirrorLocalChannels().
+  bool PublishLocalEntryValue(unsigned int local_id,
+                              std::shared_ptr<Value> value);
+  bool ReadLocalEntryValue(unsigned int local_id, uint64_t* seq,
+                           std::shared_ptr<Value>* value);
+  bool WaitForLocalEntryValue(unsigned int local_id, uint64_t* seq,
+                              std::shared_ptr<Value>* value, double timeout);
+  void MirrorLocalChannels() override;
+  void SetPeriodicMirror(bool periodic) override;
+
+  // By-value accessors for boolean and double entries.  The getters don't
+  // copy the shared value, and the setters reuse the entry's current value
+  // in place when nothing else holds a reference to it, so most calls in a
+  // robot loop don't allocate.  The getters return false if the entry does
+  // not have a value of the requested type; the setters return false on type
+  // mismatch.
+  bool GetEntryBoolean(unsigned int local_id, bool* value,
+                       uint64_t* last_change) const;
+  bool GetEntryDouble(unsigned int local_id, double* value,
+                      uint64_t* last_change) const;
+  bool SetEntryBoolean(unsigned int local_id, bool value, uint64_t time);
+  bool SetEntryDouble(unsigned int local_id, double value, uint64_t time);
+
   void SetEntryFlags(std::string_view name, unsigned int flags);
   void SetEntryFlags(unsigned int local_id, unsigned int flags);
 
   unsigned int GetEntryFlags(std::string_view name) const;
   unsigned int GetEntryFlags(unsigned int local_id) const;
 
+  // Update priority (NT_EntryPriority) of local changes.  This is local to
+  // this instance and is not sent over the network.  A prefix priority
+  // applies to existing and future entries under the prefix; the longest
+  // matching prefix wins.
+  void SetEntryPriority(unsigned int local_id, unsigned int priority);
+  unsigned int GetEntryPriority(unsigned int local_id) const;
+  void SetPrefixPriority(std::string_view prefix, unsigned int priority);
+
+  // Value history kept per entry; see nt::SetEntryHistoryDepth().
+  void SetEntryHistoryDepth(unsigned int local_id, size_t depth);
+  std::vector<std::shared_ptr<Value>> GetEntryHistory(unsigned int local_id,
+                                                      uint64_t since) const;
+
   void DeleteEntry(std::string_view name);
   void DeleteEntry(unsigned int local_id);
 
@@ -126,6 +184,17 @@ class Storage : public IStorage {
   NT_Type GetEntryType(unsigned int local_id) const;
   uint64_t GetEntryLastChange(unsigned int local_id) const;
 
+  // Logs every value set (starting with the current values) to a binary
+  // file; see DataLogger for the format.  Returns error string, or nullptr
+  // if successful.
+  const char* StartDataLog(std::string_view filename);
+  // Logs every value set (starting with the current values) for entries
+  // starting with prefix to a wpi::log::DataLog; see EntryLogSink.
+  void StartDataLog(wpi::log::DataLog& log, std::string_view prefix,
+                    std::string_view logPrefix);
+  // Stops both kinds of data log
+  void StopDataLog();
+
   // Filename-based save/load functions.  Used both by periodic saves and
   // accessible directly via the user API.
   const char* SavePersistent(std::string_view filename,
@@ -134,6 +203,14 @@ class Storage : public IStorage {
       std::string_view filename,
       std::function<void(size_t line, const char* msg)> warn) override;
 
+  // Binary journal variant of SavePersistent().  The journal starts with a
+  // snapshot of all persistent entries, and each save appends only the
+  // entries changed since the previous one.  The file is compacted back to a
+  // snapshot once the appended records outgrow it.  LoadPersistent() reads
+  // either format.
+  const char* SavePersistentJournal(std::string_view filename,
+                                    bool periodic) const override;
+
   const char* SaveEntries(std::string_view filename,
                           std::string_view prefix) const;
   const char* LoadEntries(
@@ -149,6 +226,16 @@ class Storage : public IStorage {
 
   void SaveEntries(wpi::raw_ostream& os, std::string_view prefix) const;
 
+  // Writes a full journal if snapshot is true, otherwise appends records for
+  // the entries changed since the last journal write.  If periodic, nothing
+  // is written and false is returned unless something has changed.
+  bool SavePersistentJournal(wpi::raw_ostream& os, bool snapshot,
+                             bool periodic = false) const;
+  // Replays a journal.  Warnings are given a record number in place of a
+  // line number.
+  bool LoadJournal(wpi::raw_istream& is,
+                   std::function<void(size_t line, const char* msg)> warn);
+
   // RPC configuration needs to come through here as RPC definitions are
   // actually special Storage value types.
   void CreateRpc(unsigned int local_id, std::string_view def,
@@ -158,9 +245,19 @@ class Storage : public IStorage {
                     std::string* result);
   bool GetRpcResult(unsigned int local_id, unsigned int call_uid,
                     std::string* result, double timeout, bool* timed_out);
+  // Waits for the results of several outstanding calls.  Either all results
+  // are returned (in call_uids order) or, on timeout or cancel, none are
+  // consumed.
+  bool GetRpcResults(unsigned int local_id,
+                     wpi::span<const unsigned int> call_uids,
+                     std::vector<std::string>* results, double timeout,
+                     bool* timed_out);
   void CancelRpcResult(unsigned int local_id, unsigned int call_uid);
 
  private:
+  // Identifies a binary persistent journal file
+  static constexpr char kJournalHeader[] = "\x89NTJ";
+
   // Data for each table entry.
   struct Entry {
     explicit Entry(std::string_view name_) : name(name_) {}
@@ -174,6 +271,12 @@ class Storage : public IStorage {
     std::shared_ptr<Value> value;
     unsigned int flags{0};
 
+    // Copy of value for the lock-free getters (see PublishValue()).
+    // Booleans and doubles are in snapshot; other values are in published,
+    // which is only accessed with std::atomic_load() and std::atomic_store().
+    ScalarSnapshot snapshot;
+    std::shared_ptr<Value> published;
+
     // Unique ID for this entry as used in network messages.  The value is
     // assigned by the server, so on the client this is 0xffff until an
     // entry assignment is received back from the server.
@@ -189,6 +292,21 @@ class Storage : public IStorage {
     // on client to determine whether or not to accept remote changes.
     bool local_write{false};
 
+    // Update priority (NT_EntryPriority) used when sending changes.
+    unsigned int priority{NT_PRIORITY_NORMAL};
+
+    // In-process channel, created on first use and readable without
+    // m_mutex through channel.
+    std::unique_ptr<LocalChannel> local_channel;
+    std::atomic<LocalChannel*> channel{nullptr};
+
+    // Recent values, oldest first.  Only allocated once history is enabled
+    // with SetEntryHistoryDepth().
+    std::unique_ptr<wpi::circular_buffer<std::shared_ptr<Value>>> history;
+
+    // If the entry is on the persistent journal change list.
+    bool persistent_changed{false};
+
     // RPC handle.
     unsigned int rpc_uid{UINT_MAX};
 
@@ -198,6 +316,10 @@ class Storage : public IStorage {
   };
 
   using EntriesMap = wpi::StringMap<Entry*>;
+  // Entries sorted by name; used to answer prefix queries without visiting
+  // every entry.  Entries are never removed from m_entries (deletion only
+  // clears the value), so this is only ever added to in GetOrNew().
+  using SortedEntries = std::vector<Entry*>;
   using IdMap = std::vector<Entry*>;
   using LocalMap = std::vector<std::unique_ptr<Entry>>;
   using RpcIdPair = std::pair<unsigned int, unsigned int>;
@@ -206,17 +328,42 @@ class Storage : public IStorage {
 
   mutable wpi::mutex m_mutex;
   EntriesMap m_entries;
+  SortedEntries m_sorted;
   IdMap m_idmap;
   LocalMap m_localmap;
+  // m_localmap entries, readable without m_mutex (entries are never freed)
+  LockFreeIndex<Entry> m_fast_localmap;
+  // Prefix priorities set with SetPrefixPriority()
+  std::vector<std::pair<std::string, unsigned int>> m_prefix_priorities;
   RpcResultMap m_rpc_results;
   RpcBlockingCallSet m_rpc_blocking_calls;
   // If any persistent values have changed
   mutable bool m_persistent_dirty = false;
+  // Entries whose persistent value or flag changed since the last journal
+  // write
+  mutable std::vector<Entry*> m_persistent_changes;
+
+  // Journal file state; the journal is only appended to once it has been
+  // written by this instance.
+  mutable wpi::mutex m_journal_mutex;
+  mutable std::string m_journal_filename;
+  mutable uint64_t m_journal_size = 0;
+  mutable uint64_t m_journal_snapshot_size = 0;
+  mutable bool m_journal_failed = false;
 
   // condition variable and termination flag for blocking on a RPC result
   std::atomic_bool m_terminating;
   wpi::condition_variable m_rpc_results_cond;
 
+  std::unique_ptr<DataLogger> m_data_logger;
+  std::unique_ptr<EntryLogSink> m_entry_log;
+
+  // Channels with values to mirror, linked through next_dirty
+  std::atomic<LocalChannel*> m_dirty_channels{nullptr};
+
+  // If the dispatcher thread calls MirrorLocalChannels()
+  std::atomic_bool m_periodic_mirror{false};
+
   // configured by dispatcher at startup
   IDispatcher* m_dispatcher = nullptr;
   bool m_server = true;
@@ -240,6 +387,8 @@ class Storage : public IStorage {
                                  std::weak_ptr<INetworkConnection> conn_weak);
   void ProcessIncomingRpcResponse(std::shared_ptr<Message> msg,
                                   INetworkConnection* conn);
+  void ProcessIncomingSubscribe(std::shared_ptr<Message> msg,
+                                INetworkConnection* conn);
 
   bool GetPersistentEntries(
       bool periodic,
@@ -248,8 +397,57 @@ class Storage : public IStorage {
   bool GetEntries(std::string_view prefix,
                   std::vector<std::pair<std::string, std::shared_ptr<Value>>>*
                       entries) const;
+  bool GetJournalEntries(
+      bool periodic, bool snapshot,
+      std::vector<std::pair<std::string, std::shared_ptr<Value>>>* entries)
+      const;
+  void ApplyLoadedEntries(
+      wpi::span<const std::pair<std::string, std::shared_ptr<Value>>> entries,
+      bool persistent);
+  // Must be called with m_mutex held
+  void MarkPersistentDirty(Entry* entry);
+  // Makes entry->value visible to the lock-free getters.  Must be called
+  // with m_mutex held whenever entry->value changes.
+  void PublishValue(Entry* entry);
+  // Publishes a newly set value and adds it to the entry's history and the
+  // data log.  Must be called with m_mutex held, after entry->value is set.
+  void RecordValue(Entry* entry) {
+    PublishValue(entry);
+    if (!entry->value) {
+      return;
+    }
+    if (entry->history && (entry->history->size() == 0 ||
+                           *entry->history->back() != *entry->value)) {
+      entry->history->push_back(entry->value);
+    }
+    if (m_data_logger) {
+      m_data_logger->Append(entry->local_id, entry->name, *entry->value);
+    }
+    if (m_entry_log) {
+      m_entry_log->Append(entry->local_id, entry->name, *entry->value);
+    }
+  }
+  // Changes collected by SetEntryValues(), to be notified and sent at once
+  struct ChangeBatch {
+    std::vector<IEntryNotifier::Notification> notifications;
+    std::vector<IDispatcher::Outgoing> outgoing;
+  };
+  // If batch is set, the lock is not released, and notifications and
+  // outgoing messages are added to batch instead.
   void SetEntryValueImpl(Entry* entry, std::shared_ptr<Value> value,
-                         std::unique_lock<wpi::mutex>& lock, bool local);
+                         std::unique_lock<wpi::mutex>& lock, bool local,
+                         ChangeBatch* batch = nullptr);
+  // Notifies and sends the changes in batch.  May release the lock.
+  void SendChangeBatch(ChangeBatch& batch,
+                       std::unique_lock<wpi::mutex>& lock);
+  // Gets (or creates) an entry's in-process channel; null if local_id is
+  // invalid.
+  LocalChannel* GetLocalChannel(unsigned int local_id);
+  // Reads the type, value bits, and last change time of a boolean or double
+  // entry.  Lock-free unless local_id is beyond the m_fast_localmap capacity.
+  bool GetEntryScalar(unsigned int local_id, NT_Type type, uint64_t* bits,
+                      uint64_t* last_change) const;
+  bool SetEntryScalarValue(unsigned int local_id, const NT_Value& value);
   void SetEntryFlagsImpl(Entry* entry, unsigned int flags,
                          std::unique_lock<wpi::mutex>& lock, bool local);
   void DeleteEntryImpl(Entry* entry, std::unique_lock<wpi::mutex>& lock,
@@ -260,6 +458,20 @@ class Storage : public IStorage {
   void DeleteAllEntriesImpl(bool local, F should_delete);
   void DeleteAllEntriesImpl(bool local);
   Entry* GetOrNew(std::string_view name);
+
+  // Calls func(Entry*) for every entry (including ones without a value)
+  // whose name starts with prefix, in name order.  Must be called with
+  // m_mutex held.
+  template <typename F>
+  void ForEachPrefixEntry(std::string_view prefix, F func) const;
+
+  // Subscribes conn to prefixes (plus the names it already has), calling
+  // func(Entry*) for each entry with a value it then matches before
+  // replacing its filter's ids with theirs.  Must be called with m_mutex
+  // held.
+  template <typename F>
+  void SubscribeEntries(INetworkConnection& conn,
+                        wpi::span<const std::string> prefixes, F func);
 };
 
 }  // namespace nt
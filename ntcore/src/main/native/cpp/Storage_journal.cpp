@@ -0,0 +1,238 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/SmallString.h>
+#include <wpi/StringMap.h>
+#include <wpi/fs.h>
+#include <wpi/leb128.h>
+#include <wpi/raw_istream.h>
+#include <wpi/raw_ostream.h>
+
+#include "Log.h"
+#include "Storage.h"
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+
+using namespace nt;
+
+// A journal is kJournalHeader followed by records.  Each record is a ULEB128
+// length followed by that many bytes: the record type, the entry name, and
+// for a set record the value type and value.  Values are encoded as on the
+// wire, except that array lengths are ULEB128 (arrays on the wire are limited
+// to 255 elements).  A remove record means the entry is no longer persistent.
+//
+// Appends aren't atomic, so a truncated last record is ignored when loading.
+// The file is never appended to until this instance has written a complete
+// snapshot, so a truncated record is always at the end.
+
+namespace {
+
+enum JournalRecordType { kJournalSet = 1, kJournalRemove = 2 };
+
+// Compact once the appended records are larger than both this and the
+// snapshot they follow.
+constexpr uint64_t kJournalMinCompactSize = 64 * 1024;
+
+using JournalEntry = std::pair<std::string, std::shared_ptr<Value>>;
+
+}  // namespace
+
+static bool IsJournalType(NT_Type type) {
+  switch (type) {
+    case NT_BOOLEAN:
+    case NT_DOUBLE:
+    case NT_STRING:
+    case NT_RAW:
+    case NT_BOOLEAN_ARRAY:
+    case NT_DOUBLE_ARRAY:
+    case NT_STRING_ARRAY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void WriteJournalRecord(wpi::raw_ostream& os, WireEncoder& encoder,
+                               std::string_view name, const Value* value) {
+  encoder.Reset();
+  if (value && IsJournalType(value->type())) {
+    encoder.Write8(kJournalSet);
+    encoder.WriteString(name);
+    encoder.WriteType(value->type());
+    encoder.WriteUnboundedValue(*value);
+  } else {
+    encoder.Write8(kJournalRemove);
+    encoder.WriteString(name);
+  }
+  wpi::SmallString<8> len;
+  wpi::WriteUleb128(len, encoder.size());
+  os << len.str() << encoder.ToStringView();
+}
+
+bool Storage::SavePersistentJournal(wpi::raw_ostream& os, bool snapshot,
+                                    bool periodic) const {
+  std::vector<JournalEntry> entries;
+  if (!GetJournalEntries(periodic, snapshot, &entries)) {
+    return false;
+  }
+  if (snapshot) {
+    os << kJournalHeader;
+  }
+  WireEncoder encoder(0x0300);
+  for (auto& entry : entries) {
+    WriteJournalRecord(os, encoder, entry.first, entry.second.get());
+  }
+  return true;
+}
+
+const char* Storage::SavePersistentJournal(std::string_view filename,
+                                           bool periodic) const {
+  std::scoped_lock lock(m_journal_mutex);
+
+  // Start with a snapshot unless we wrote the current journal, and compact
+  // it once the appended records outgrow the snapshot.
+  bool snapshot = m_journal_failed || m_journal_filename != filename ||
+                  (m_journal_size > kJournalMinCompactSize &&
+                   m_journal_size > 2 * m_journal_snapshot_size);
+
+  // Encode everything before creating the file, so it is written in one
+  // go.  After a failed write, the snapshot is needed even if nothing else
+  // has changed.
+  wpi::SmallString<1024> buf;
+  wpi::raw_svector_ostream bufos(buf);
+  if (!SavePersistentJournal(bufos, snapshot, periodic && !m_journal_failed)) {
+    return nullptr;
+  }
+
+  const char* err = nullptr;
+  std::error_code ec;
+  if (snapshot) {
+    // same safe replace as SavePersistent()
+    std::string fn{filename};
+    auto tmp = fmt::format("{}.tmp", filename);
+    auto bak = fmt::format("{}.bak", filename);
+    DEBUG0("compacting persistent journal '{}'", filename);
+    {
+      wpi::raw_fd_ostream os(tmp, ec);
+      if (ec.value() != 0) {
+        err = "could not open file";
+        goto done;
+      }
+      os << buf.str();
+      os.close();
+      if (os.has_error()) {
+        std::remove(tmp.c_str());
+        err = "error saving file";
+        goto done;
+      }
+    }
+    std::remove(bak.c_str());
+    std::rename(fn.c_str(), bak.c_str());
+    if (std::rename(tmp.c_str(), fn.c_str()) != 0) {
+      std::rename(bak.c_str(), fn.c_str());  // attempt to restore backup
+      err = "could not rename temp file to real file";
+      goto done;
+    }
+    m_journal_filename = filename;
+    m_journal_size = buf.size();
+    m_journal_snapshot_size = buf.size();
+  } else {
+    DEBUG4("appending {} bytes to persistent journal '{}'", buf.size(),
+           filename);
+    wpi::raw_fd_ostream os(filename, ec, fs::OF_Append);
+    if (ec.value() != 0) {
+      err = "could not open file";
+      goto done;
+    }
+    os << buf.str();
+    os.close();
+    if (os.has_error()) {
+      err = "error saving file";
+      goto done;
+    }
+    m_journal_size += buf.size();
+  }
+
+done:
+  // the changes have been taken off the change list, so recover them by
+  // writing a full snapshot next time
+  m_journal_failed = err != nullptr;
+  return err;
+}
+
+bool Storage::LoadJournal(
+    wpi::raw_istream& is,
+    std::function<void(size_t line, const char* msg)> warn) {
+  WireDecoder decoder(is, 0x0300, m_logger);
+  const char* header;
+  if (!decoder.Read(&header, sizeof(kJournalHeader) - 1) ||
+      std::string_view{header, sizeof(kJournalHeader) - 1} != kJournalHeader) {
+    if (warn) {
+      warn(0, "journal header mismatch, ignoring rest of file");
+    }
+    return false;
+  }
+
+  // replay into a map so only the final state of each entry is applied
+  wpi::StringMap<std::shared_ptr<Value>> values;
+  size_t record_num = 0;
+  for (;;) {
+    uint64_t size;
+    if (!decoder.ReadUleb128(&size)) {
+      break;  // end of journal
+    }
+    ++record_num;
+    const char* record;
+    if (!decoder.Read(&record, size)) {
+      if (warn) {
+        warn(record_num, "ignoring truncated record");
+      }
+      break;
+    }
+
+    wpi::raw_mem_istream ris(record, size);
+    WireDecoder rd(ris, 0x0300, m_logger);
+    unsigned int record_type;
+    std::string name;
+    NT_Type type;
+    if (!rd.Read8(&record_type) || !rd.ReadString(&name)) {
+      if (warn) {
+        warn(record_num, "ignoring invalid record");
+      }
+      continue;
+    }
+    if (record_type == kJournalRemove) {
+      values.erase(name);
+      continue;
+    }
+    std::shared_ptr<Value> value;
+    if (record_type == kJournalSet && rd.ReadType(&type) &&
+        IsJournalType(type)) {
+      value = rd.ReadUnboundedValue(type);
+    }
+    if (!value) {
+      if (warn) {
+        warn(record_num, "ignoring invalid record");
+      }
+      continue;
+    }
+    values[name] = std::move(value);
+  }
+
+  std::vector<JournalEntry> entries;
+  entries.reserve(values.size());
+  for (auto& value : values) {
+    entries.emplace_back(value.getKey(), std::move(value.getValue()));
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  ApplyLoadedEntries(entries, true);
+  return true;
+}
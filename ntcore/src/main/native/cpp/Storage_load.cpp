@@ -386,6 +386,13 @@ bool Storage::LoadEntries(
     return false;
   }
 
+  ApplyLoadedEntries(entries, persistent);
+  return true;
+}
+
+void Storage::ApplyLoadedEntries(
+    wpi::span<const std::pair<std::string, std::shared_ptr<Value>>> entries,
+    bool persistent) {
   // copy values into storage as quickly as possible so lock isn't held
   std::vector<std::shared_ptr<Message>> msgs;
   std::unique_lock lock(m_mutex);
@@ -393,6 +400,7 @@ bool Storage::LoadEntries(
     Entry* entry = GetOrNew(i.first);
     auto old_value = entry->value;
     entry->value = i.second;
+    RecordValue(entry);
     bool was_persist = entry->IsPersistent();
     if (!was_persist && persistent) {
       entry->flags |= NT_PERSISTENT;
@@ -451,8 +459,6 @@ bool Storage::LoadEntries(
       dispatcher->QueueOutgoing(std::move(msg), nullptr, nullptr);
     }
   }
-
-  return true;
 }
 
 const char* Storage::LoadPersistent(
@@ -463,7 +469,18 @@ const char* Storage::LoadPersistent(
   if (ec.value() != 0) {
     return "could not open file";
   }
-  if (!LoadEntries(is, "", true, warn)) {
+  // binary journals are recognized by their header
+  char header[sizeof(kJournalHeader) - 1];
+  is.read(header, sizeof(header));
+  bool journal = !is.has_error() &&
+                 std::string_view{header, sizeof(header)} == kJournalHeader;
+  is.close();
+
+  wpi::raw_fd_istream is2(filename, ec);
+  if (ec.value() != 0) {
+    return "could not open file";
+  }
+  if (journal ? !LoadJournal(is2, warn) : !LoadEntries(is2, "", true, warn)) {
     return "error reading file";
   }
   return nullptr;
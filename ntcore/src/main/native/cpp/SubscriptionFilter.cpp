@@ -0,0 +1,122 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "SubscriptionFilter.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <wpi/StringExtras.h>
+
+#include "Message.h"
+
+using namespace nt;
+
+void SubscriptionFilter::Set(wpi::span<const std::string> prefixes,
+                             wpi::span<const unsigned int> ids) {
+  std::vector<std::string> sorted{prefixes.begin(), prefixes.end()};
+  std::sort(sorted.begin(), sorted.end());
+  // a prefix sorts right before the names it matches, so dropping the ones
+  // matched by their predecessor leaves no prefix of another
+  std::vector<std::string> normalized;
+  for (auto&& prefix : sorted) {
+    if (normalized.empty() || !wpi::starts_with(prefix, normalized.back())) {
+      normalized.emplace_back(std::move(prefix));
+    }
+  }
+  bool active = !normalized.empty() && !normalized.front().empty();
+
+  std::scoped_lock lock(m_mutex);
+  m_prefixes = std::move(normalized);
+  m_ids.clear();
+  for (auto id : ids) {
+    if (id >= m_ids.size()) {
+      m_ids.resize(id + 1);
+    }
+    m_ids[id] = true;
+  }
+  m_active = active;
+}
+
+void SubscriptionFilter::AddName(std::string_view name) {
+  std::scoped_lock lock(m_mutex);
+  m_names[name] = true;
+}
+
+std::vector<std::string> SubscriptionFilter::GetPrefixes() const {
+  std::scoped_lock lock(m_mutex);
+  return m_prefixes;
+}
+
+std::vector<std::string> SubscriptionFilter::GetNames() const {
+  std::scoped_lock lock(m_mutex);
+  std::vector<std::string> names;
+  names.reserve(m_names.size());
+  for (auto&& name : m_names) {
+    names.emplace_back(name.getKey());
+  }
+  return names;
+}
+
+bool SubscriptionFilter::Matches(std::string_view name) const {
+  if (!m_active) {
+    return true;
+  }
+  std::scoped_lock lock(m_mutex);
+  return MatchesLocked(name);
+}
+
+bool SubscriptionFilter::IsSubscribed(unsigned int id) const {
+  if (!m_active) {
+    return true;
+  }
+  std::scoped_lock lock(m_mutex);
+  return IsSubscribedLocked(id);
+}
+
+bool SubscriptionFilter::MatchesLocked(std::string_view name) const {
+  // the only prefix that can match is the last one not after the name
+  auto it = std::upper_bound(
+      m_prefixes.begin(), m_prefixes.end(), name,
+      [](std::string_view lhs, const std::string& prefix) {
+        return lhs < prefix;
+      });
+  if (it != m_prefixes.begin() && wpi::starts_with(name, *(it - 1))) {
+    return true;
+  }
+  return m_names.count(name) != 0;
+}
+
+bool SubscriptionFilter::Filter(const Message& msg) {
+  if (!m_active) {
+    return true;
+  }
+  std::scoped_lock lock(m_mutex);
+  switch (msg.type()) {
+    case Message::kEntryAssign: {
+      bool subscribed = MatchesLocked(msg.str());
+      unsigned int id = msg.id();
+      if (id != 0xffff) {
+        if (id >= m_ids.size()) {
+          m_ids.resize(id + 1);
+        }
+        m_ids[id] = subscribed;
+      }
+      return subscribed;
+    }
+    case Message::kEntryUpdate:
+    case Message::kEntryArrayDelta:
+    case Message::kFlagsUpdate:
+      return IsSubscribedLocked(msg.id());
+    case Message::kEntryDelete: {
+      bool subscribed = IsSubscribedLocked(msg.id());
+      if (subscribed) {
+        m_ids[msg.id()] = false;
+      }
+      return subscribed;
+    }
+    default:
+      return true;
+  }
+}
@@ -0,0 +1,68 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_SUBSCRIPTIONFILTER_H_
+#define NTCORE_SUBSCRIPTIONFILTER_H_
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wpi/StringMap.h>
+#include <wpi/mutex.h>
+#include <wpi/span.h>
+
+namespace nt {
+
+class Message;
+
+/* The entries a remote has subscribed to (subscription extension), used by
+ * its connection to drop outgoing messages for everything else.  Entries
+ * are matched by name prefix when they are assigned, and the ids of the
+ * matched ones are remembered so updates can be filtered by id.  Without any
+ * prefixes everything is sent.
+ */
+class SubscriptionFilter {
+ public:
+  bool IsActive() const { return m_active; }
+
+  // Replaces the subscribed prefixes (everything if empty) and the ids of
+  // the entries they currently match.  Names added with AddName() stay
+  // subscribed.
+  void Set(wpi::span<const std::string> prefixes,
+           wpi::span<const unsigned int> ids);
+
+  // Subscribes to an entry by name, e.g. one the remote assigned itself and
+  // needs to see the id of.
+  void AddName(std::string_view name);
+
+  // Gets the subscribed prefixes, sorted and without any that another one is
+  // a prefix of, and the names added with AddName().
+  std::vector<std::string> GetPrefixes() const;
+  std::vector<std::string> GetNames() const;
+
+  bool Matches(std::string_view name) const;
+  bool IsSubscribed(unsigned int id) const;
+
+  // Returns whether msg should be sent, and remembers whether the entries it
+  // assigns are subscribed.
+  bool Filter(const Message& msg);
+
+ private:
+  bool MatchesLocked(std::string_view name) const;
+  bool IsSubscribedLocked(unsigned int id) const {
+    return id < m_ids.size() && m_ids[id];
+  }
+
+  std::atomic_bool m_active{false};
+  mutable wpi::mutex m_mutex;
+  std::vector<std::string> m_prefixes;
+  wpi::StringMap<bool> m_names;
+  std::vector<bool> m_ids;
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_SUBSCRIPTIONFILTER_H_
@@ -0,0 +1,53 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "TimeSync.h"
+
+using namespace nt;
+
+void TimeSync::set_enabled(bool enable, bool client) {
+  m_client = client;
+  m_enabled = enable;
+}
+
+std::shared_ptr<Message> TimeSync::Poll(uint64_t now) {
+  if (!m_enabled || !m_client || now < m_next_request) {
+    return nullptr;
+  }
+  ++m_requests;
+  m_next_request = now + (m_requests < kSamples ? kInterval / 10 : kInterval);
+  return Message::TimeSync(now, 0);
+}
+
+std::shared_ptr<Message> TimeSync::Process(const Message& msg, uint64_t now) {
+  if (!m_enabled) {
+    return nullptr;
+  }
+  if (!m_client) {
+    return Message::TimeSync(msg.client_time(), now);
+  }
+
+  // ignore answers that can't be to one of our requests
+  uint64_t t0 = msg.client_time();
+  if (t0 == 0 || t0 > now || msg.server_time() == 0) {
+    return nullptr;
+  }
+  uint64_t rtt = now - t0;
+  int64_t offset = static_cast<int64_t>(msg.server_time() - (t0 + rtt / 2));
+  m_samples[m_next_sample] = {rtt, offset};
+  m_next_sample = (m_next_sample + 1) % kSamples;
+  if (m_num_samples < kSamples) {
+    ++m_num_samples;
+  }
+
+  const Sample* best = &m_samples[0];
+  for (unsigned int i = 1; i < m_num_samples; ++i) {
+    if (m_samples[i].rtt < best->rtt) {
+      best = &m_samples[i];
+    }
+  }
+  m_offset = best->offset;
+  m_synchronized = true;
+  return nullptr;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_TIMESYNC_H_
+#define NTCORE_TIMESYNC_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "Message.h"
+
+namespace nt {
+
+/* Per-connection state for the time sync protocol extension.  The client
+ * sends TIME_SYNC requests stamped with its send time t0; the server answers
+ * each with the time t1 it received it, and the client notes the time t3 the
+ * answer arrived.  Assuming symmetric paths, the server clock is ahead of the
+ * client clock by t1 - (t0 + t3) / 2, with an error of at most half the round
+ * trip t3 - t0.  Delayed exchanges only ever make the round trip longer, so
+ * the estimate taken is the one from the fastest of the last kSamples
+ * exchanges.
+ *
+ * Times are wpi::Now() microseconds.  Poll() and Process() may be called
+ * from different threads; offset() may be called from any thread.
+ */
+class TimeSync {
+ public:
+  // Exchanges the estimate is taken from
+  static constexpr unsigned int kSamples = 8;
+  // Microseconds between requests; the first kSamples are 10 times faster
+  static constexpr uint64_t kInterval = 1000000;
+
+  /* Exchange time syncs.  Only enable once the peer has agreed to the
+   * extension.
+   */
+  void set_enabled(bool enable, bool client);
+  bool enabled() const { return m_enabled; }
+
+  /* Estimated server time minus local time (0 on the server). */
+  int64_t offset() const { return m_offset; }
+
+  /* Whether the client has received at least one answer. */
+  bool synchronized() const { return m_synchronized; }
+
+  /* Client: returns a request if one is due at now. */
+  std::shared_ptr<Message> Poll(uint64_t now);
+
+  /* Handles a received TIME_SYNC.  The server returns the answer to send;
+   * the client updates the offset and returns nullptr.
+   */
+  std::shared_ptr<Message> Process(const Message& msg, uint64_t now);
+
+ private:
+  struct Sample {
+    uint64_t rtt;
+    int64_t offset;
+  };
+
+  std::atomic_bool m_enabled{false};
+  std::atomic_bool m_client{false};
+  std::atomic_bool m_synchronized{false};
+  std::atomic<int64_t> m_offset{0};
+
+  // Poll() only
+  uint64_t m_next_request = 0;
+  unsigned int m_requests = 0;
+
+  // Process() only
+  Sample m_samples[kSamples];
+  unsigned int m_num_samples = 0;
+  unsigned int m_next_sample = 0;
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_TIMESYNC_H_
@@ -0,0 +1,426 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "UvNetworkConnection.h"
+
+#include <utility>
+
+#include <wpi/raw_istream.h>
+#include <wpi/timestamp.h>
+#include <wpi/uv/Async.h>
+#include <wpi/uv/Tcp.h>
+#include <wpi/uv/util.h>
+
+#include "IConnectionNotifier.h"
+#include "Log.h"
+#include "WireDecoder.h"
+
+using namespace nt;
+
+UvNetworkConnection::UvNetworkConnection(
+    unsigned int uid, std::shared_ptr<wpi::uv::Tcp> tcp,
+    IConnectionNotifier& notifier, wpi::Logger& logger, HelloFunc hello,
+    ExtensionsFunc extensions, Message::GetEntryTypeFunc get_entry_type)
+    : m_uid(uid),
+      m_tcp(tcp),
+      m_notifier(notifier),
+      m_logger(logger),
+      m_hello(std::move(hello)),
+      m_extensions(std::move(extensions)),
+      m_get_entry_type(std::move(get_entry_type)) {
+  wpi::uv::AddrToName(tcp->GetPeer(), &m_remote_ip, &m_remote_port);
+}
+
+UvNetworkConnection::~UvNetworkConnection() {
+  set_state(kDead);
+  for (auto& buf : m_write_queue) {
+    buf.Deallocate();
+  }
+}
+
+void UvNetworkConnection::Start() {
+  auto tcp = m_tcp.lock();
+  if (!tcp) {
+    return;
+  }
+  // the handles keep us alive until they are closed
+  auto self = shared_from_this();
+  auto async = wpi::uv::Async<>::Create(tcp->GetLoopRef());
+  if (!async) {
+    tcp->Close();
+    return;
+  }
+  async->wakeup.connect([this] { WriteQueued(); });
+  async->SetData(self);
+  m_write_async = async;
+
+  tcp->SetData(self);
+  tcp->error.connect([this](wpi::uv::Error err) {
+    DEBUG2("connection error: {}", err.str());
+    Close();
+  });
+  tcp->end.connect([this] { Close(); });
+  tcp->data.connect([this](wpi::uv::Buffer& buf, size_t len) {
+    ProcessData({buf.base, len});
+  });
+
+  set_state(kHandshake);
+  tcp->StartRead();
+}
+
+void UvNetworkConnection::Close() {
+  {
+    std::scoped_lock lock(m_pending_mutex);
+    if (m_closed) {
+      return;
+    }
+    m_closed = true;
+    for (auto& buf : m_write_queue) {
+      buf.Deallocate();
+    }
+    m_write_queue.clear();
+  }
+  DEBUG2("UvNetworkConnection closing ({})", fmt::ptr(this));
+  set_state(kDead);
+  m_read_buf.clear();
+  m_handshake_incoming.clear();
+  if (auto async = m_write_async.lock()) {
+    async->Close();
+  }
+  if (auto tcp = m_tcp.lock()) {
+    tcp->Close();
+  }
+}
+
+ConnectionInfo UvNetworkConnection::info() const {
+  return ConnectionInfo{remote_id(), m_remote_ip, m_remote_port, m_last_update,
+                        m_proto_rev};
+}
+
+unsigned int UvNetworkConnection::proto_rev() const {
+  return m_proto_rev;
+}
+
+void UvNetworkConnection::set_proto_rev(unsigned int proto_rev) {
+  m_proto_rev = proto_rev;
+}
+
+UvNetworkConnection::State UvNetworkConnection::state() const {
+  std::scoped_lock lock(m_state_mutex);
+  return m_state;
+}
+
+void UvNetworkConnection::set_state(State state) {
+  std::scoped_lock lock(m_state_mutex);
+  // Don't update state any more once we've died
+  if (m_state == kDead) {
+    return;
+  }
+  // One-shot notify state changes
+  if (m_state != kActive && state == kActive) {
+    m_notifier.NotifyConnection(true, info());
+  }
+  if (m_state != kDead && state == kDead) {
+    m_notifier.NotifyConnection(false, info());
+  }
+  m_state = state;
+}
+
+std::string UvNetworkConnection::remote_id() const {
+  std::scoped_lock lock(m_remote_id_mutex);
+  return m_remote_id;
+}
+
+void UvNetworkConnection::set_remote_id(std::string_view remote_id) {
+  std::scoped_lock lock(m_remote_id_mutex);
+  m_remote_id = remote_id;
+}
+
+void UvNetworkConnection::set_array_deltas(bool enable) {
+  std::scoped_lock lock(m_pending_mutex);
+  m_deltas.set_send_deltas(enable);
+}
+
+void UvNetworkConnection::set_compression(bool enable) {
+  std::scoped_lock lock(m_pending_mutex);
+  m_compression.set_compress(enable);
+}
+
+void UvNetworkConnection::set_time_sync(bool enable, bool client) {
+  std::scoped_lock lock(m_pending_mutex);
+  m_time_sync.set_enabled(enable, client);
+}
+
+void UvNetworkConnection::ProcessData(std::string_view data) {
+  // Decode as many complete messages as are available.  WireDecoder can't
+  // resume partway through a message, so a partial message is kept and
+  // decoded again from its start once more data arrives.
+  if (state() == kDead) {
+    return;
+  }
+  if (!m_read_buf.empty()) {
+    m_read_buf.append(data);
+    data = m_read_buf;
+  }
+  wpi::raw_mem_istream is(data.data(), data.size());
+  WireDecoder decoder(is, m_proto_rev, m_logger);
+  size_t consumed = 0;
+  while (consumed < data.size()) {
+    decoder.set_proto_rev(m_proto_rev);
+    decoder.set_timestamps(m_time_sync.enabled(), m_time_sync.offset());
+    decoder.Reset();
+    auto msg = Message::Read(decoder, m_get_entry_type);
+    if (!msg) {
+      if (decoder.error()) {
+        INFO("read error: {}", decoder.error());
+        // terminate connection on bad message
+        Close();
+        return;
+      }
+      break;  // incomplete message
+    }
+    consumed = data.size() - is.in_avail();
+    m_last_update = Now();
+    if (!msg->Is(Message::kCompressed)) {
+      if (!ProcessMessage(std::move(msg))) {
+        return;
+      }
+      continue;
+    }
+    Outgoing msgs;
+    if (!CompressionCodec::Read(*msg, decoder, m_get_entry_type, &msgs)) {
+      INFO("read error: {}", "bad COMPRESSED message");
+      Close();
+      return;
+    }
+    for (auto& inner : msgs) {
+      if (!ProcessMessage(std::move(inner))) {
+        return;
+      }
+    }
+  }
+
+  // keep any partial message
+  if (data.data() == m_read_buf.data()) {
+    m_read_buf.erase(0, consumed);
+  } else {
+    m_read_buf.assign(data.substr(consumed));
+  }
+}
+
+bool UvNetworkConnection::ProcessMessage(std::shared_ptr<Message> msg) {
+  msg = m_deltas.Read(std::move(msg));
+  if (!msg) {
+    INFO("read error: {}", "received ENTRY_ARRAY_DELTA for unknown array");
+    Close();
+    return false;
+  }
+  DEBUG3("received type={} with str={} id={} seq_num={}", msg->type(),
+         msg->str(), msg->id(), msg->seq_num_uid());
+  if (state() == kActive) {
+    if (msg->Is(Message::kTimeSync)) {
+      // answer right away; queueing would add to the measured round trip
+      if (auto reply = m_time_sync.Process(*msg, Now())) {
+        {
+          std::scoped_lock lock(m_pending_mutex);
+          Enqueue(wpi::span(&reply, 1));
+        }
+        WriteQueued();
+      }
+      return true;
+    }
+    m_process_incoming(std::move(msg), this);
+    return true;
+  }
+  return Handshake(std::move(msg));
+}
+
+bool UvNetworkConnection::Handshake(std::shared_ptr<Message> msg) {
+  // Wait for the client to send us a hello.
+  if (!m_got_hello) {
+    std::shared_ptr<Message> session;
+    if (m_resume_hello) {
+      if (!msg->Is(Message::kSession)) {
+        DEBUG0("{}", "server: client hello not followed by session");
+        Close();
+        return false;
+      }
+      session = std::move(msg);
+      msg = std::move(m_resume_hello);
+    } else if (!msg->Is(Message::kClientHello)) {
+      DEBUG0("{}", "server: client initial message was not client hello");
+      Close();
+      return false;
+    } else if (msg->id() >= 0x0300 &&
+               (msg->flags() & Message::kSessionResumeExt) != 0) {
+      // A client resuming a session follows the hello with its digest.
+      m_proto_rev = msg->id();
+      m_resume_hello = std::move(msg);
+      return true;
+    }
+    m_got_hello = true;
+
+    Outgoing outgoing;
+    bool ok = m_hello(*this, *msg, session.get(), &outgoing);
+    {
+      std::scoped_lock lock(m_pending_mutex);
+      Enqueue(outgoing);
+    }
+    WriteQueued();
+    if (!ok) {
+      // close once the response has been sent
+      set_state(kDead);
+      if (auto tcp = m_tcp.lock()) {
+        tcp->Shutdown([this] { Close(); });
+      }
+      return false;
+    }
+
+    // Pre-3.0 clients don't send a client hello done, so the connection is
+    // immediately active.
+    if (m_proto_rev < 0x0300) {
+      set_state(kActive);
+      INFO("server: client CONNECTED: {} port {}", m_remote_ip,
+           m_remote_port);
+    }
+    return true;
+  }
+
+  // Receive client initial assignments, which are batched until the client
+  // hello done.
+  if (msg->Is(Message::kClientHelloDone)) {
+    Outgoing outgoing;
+    m_extensions(*this, m_ext_flags, &outgoing);
+    if (!outgoing.empty()) {
+      {
+        std::scoped_lock lock(m_pending_mutex);
+        Enqueue(outgoing);
+      }
+      WriteQueued();
+    }
+    for (auto& assign : m_handshake_incoming) {
+      m_process_incoming(std::move(assign), this);
+    }
+    m_handshake_incoming.clear();
+    set_state(kActive);
+    INFO("server: client CONNECTED: {} port {}", m_remote_ip, m_remote_port);
+    return true;
+  }
+  // shouldn't receive a keep alive, but handle gracefully
+  if (msg->Is(Message::kKeepAlive)) {
+    return true;
+  }
+  if (msg->Is(Message::kExtensions)) {
+    m_ext_flags = msg->flags();
+    set_array_deltas((m_ext_flags & Message::kArrayDeltaExt) != 0);
+    set_time_sync((m_ext_flags & Message::kTimeSyncExt) != 0, false);
+    return true;
+  }
+  // subscriptions are processed in order with the assignments
+  if (!msg->Is(Message::kEntryAssign) && !msg->Is(Message::kSubscribe)) {
+    // unexpected message
+    DEBUG0(
+        "server: received message ({}) other than entry assignment during "
+        "initial handshake",
+        msg->type());
+    Close();
+    return false;
+  }
+  m_handshake_incoming.emplace_back(std::move(msg));
+  return true;
+}
+
+bool UvNetworkConnection::Enqueue(
+    wpi::span<const std::shared_ptr<Message>> msgs) {
+  if (m_closed) {
+    return false;
+  }
+  m_encoder.set_proto_rev(m_proto_rev);
+  m_encoder.set_timestamps(m_time_sync.enabled(), m_time_sync.offset());
+  m_encoder.Reset();
+  DEBUG3("sending {} messages", msgs.size());
+  for (auto& msg : msgs) {
+    if (msg) {
+      DEBUG3("sending type={} with str={} id={} seq_num={}", msg->type(),
+             msg->str(), msg->id(), msg->seq_num_uid());
+      m_deltas.Write(*msg, m_encoder);
+    }
+  }
+  if (m_encoder.size() == 0) {
+    return false;
+  }
+  m_compression.Write(m_encoder);
+  m_outgoing_bytes += m_encoder.size();
+  m_write_queue.emplace_back(wpi::uv::Buffer::Dup(m_encoder.ToStringView()));
+  return true;
+}
+
+void UvNetworkConnection::WriteQueued() {
+  std::vector<wpi::uv::Buffer> bufs;
+  {
+    std::scoped_lock lock(m_pending_mutex);
+    bufs.swap(m_write_queue);
+  }
+  if (bufs.empty()) {
+    return;
+  }
+  auto tcp = m_tcp.lock();
+  if (!tcp) {
+    for (auto& buf : bufs) {
+      buf.Deallocate();
+    }
+    return;
+  }
+  tcp->Write(bufs, [this](auto bufs, wpi::uv::Error err) {
+    for (auto&& buf : bufs) {
+      m_outgoing_bytes -= buf.len;
+      buf.Deallocate();
+    }
+    if (err) {
+      Close();
+    }
+  });
+}
+
+void UvNetworkConnection::QueueOutgoing(std::shared_ptr<Message> msg) {
+  std::scoped_lock lock(m_pending_mutex);
+  // filtered in queue order, so assignments are seen before their updates
+  if (!subscriptions().Filter(*msg)) {
+    return;
+  }
+  m_pending.Queue(std::move(msg));
+}
+
+void UvNetworkConnection::PostOutgoing(bool keep_alive) {
+  std::scoped_lock lock(m_pending_mutex);
+  if (m_closed) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (m_pending.empty()) {
+    if (!keep_alive) {
+      return;
+    }
+    // send keep-alives once a second (if no other messages have been sent)
+    if ((now - m_last_post) < std::chrono::seconds(1)) {
+      return;
+    }
+    auto msg = Message::KeepAlive();
+    Enqueue(wpi::span(&msg, 1));
+  } else {
+    // hold everything back while the socket is behind (see NetworkConnection)
+    if (m_outgoing_bytes > m_max_outgoing_bytes) {
+      DEBUG4("holding {} messages, {} bytes queued", m_pending.size(),
+             m_outgoing_bytes.load());
+      return;
+    }
+    Enqueue(m_pending.messages());
+    m_pending.clear();
+  }
+  m_last_post = now;
+  // m_closed is checked under the same lock, so the async is still open
+  if (auto async = m_write_async.lock()) {
+    async->Send();
+  }
+}
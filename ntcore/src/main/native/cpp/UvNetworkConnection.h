@@ -0,0 +1,168 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef NTCORE_UVNETWORKCONNECTION_H_
+#define NTCORE_UVNETWORKCONNECTION_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wpi/mutex.h>
+#include <wpi/span.h>
+#include <wpi/uv/Buffer.h>
+
+#include "ArrayDeltaCodec.h"
+#include "CompressionCodec.h"
+#include "INetworkConnection.h"
+#include "Message.h"
+#include "NetworkConnection.h"
+#include "PendingMessages.h"
+#include "TimeSync.h"
+#include "WireEncoder.h"
+#include "ntcore_cpp.h"
+
+namespace wpi {
+class Logger;
+namespace uv {
+template <typename... T>
+class Async;
+class Tcp;
+}  // namespace uv
+}  // namespace wpi
+
+namespace nt {
+
+class IConnectionNotifier;
+
+/* Server-side connection driven by a wpi::uv event loop instead of dedicated
+ * read and write threads.  Incoming data is decoded as it arrives; outgoing
+ * batches are encoded by PostOutgoing() and written by the loop.  Start() and
+ * all stream callbacks run on the loop thread.
+ */
+class UvNetworkConnection
+    : public INetworkConnection,
+      public std::enable_shared_from_this<UvNetworkConnection> {
+ public:
+  using Outgoing = NetworkConnection::Outgoing;
+  // Handles the client hello, and the SESSION message that follows it if the
+  // client is resuming a session.  Fills in the initial messages to send, and
+  // returns false if the connection should be dropped after sending them.
+  using HelloFunc =
+      std::function<bool(UvNetworkConnection& conn, const Message& hello,
+                         const Message* session, Outgoing* out)>;
+  // Handles the flags of the client's EXTENSIONS (0 if none) once its hello
+  // done arrives, filling in the messages that answer them.
+  using ExtensionsFunc = std::function<void(
+      UvNetworkConnection& conn, unsigned int flags, Outgoing* out)>;
+  using ProcessIncomingFunc =
+      std::function<void(std::shared_ptr<Message>, UvNetworkConnection*)>;
+
+  UvNetworkConnection(unsigned int uid, std::shared_ptr<wpi::uv::Tcp> tcp,
+                      IConnectionNotifier& notifier, wpi::Logger& logger,
+                      HelloFunc hello, ExtensionsFunc extensions,
+                      Message::GetEntryTypeFunc get_entry_type);
+  ~UvNetworkConnection() override;
+
+  // Set the input processor function.  This must be called before Start().
+  void set_process_incoming(ProcessIncomingFunc func) {
+    m_process_incoming = func;
+  }
+
+  // Must be called from the loop thread.
+  void Start();
+  void Close();
+
+  ConnectionInfo info() const final;
+
+  void QueueOutgoing(std::shared_ptr<Message> msg) final;
+  void PostOutgoing(bool keep_alive) final;
+
+  // Same meaning as NetworkConnection::set_max_outgoing_bytes().
+  void set_max_outgoing_bytes(size_t bytes) { m_max_outgoing_bytes = bytes; }
+  // Bytes encoded but not yet written to the socket.
+  size_t outgoing_bytes() const { return m_outgoing_bytes; }
+
+  // Same meaning as NetworkConnection::set_array_deltas().
+  void set_array_deltas(bool enable);
+
+  // Same meaning as NetworkConnection::set_compression().
+  void set_compression(bool enable);
+
+  // Same meaning as NetworkConnection::set_time_sync().
+  void set_time_sync(bool enable, bool client);
+
+  unsigned int uid() const { return m_uid; }
+
+  unsigned int proto_rev() const final;
+  void set_proto_rev(unsigned int proto_rev) final;
+
+  State state() const final;
+  void set_state(State state) final;
+
+  std::string remote_id() const;
+  void set_remote_id(std::string_view remote_id);
+
+  uint64_t last_update() const { return m_last_update; }
+
+ private:
+  void ProcessData(std::string_view data);
+  bool ProcessMessage(std::shared_ptr<Message> msg);
+  bool Handshake(std::shared_ptr<Message> msg);
+  void WriteQueued();
+
+  // Encodes msgs onto the write queue.  Must be called with m_pending_mutex
+  // held.
+  bool Enqueue(wpi::span<const std::shared_ptr<Message>> msgs);
+
+  unsigned int m_uid;
+  std::weak_ptr<wpi::uv::Tcp> m_tcp;
+  std::weak_ptr<wpi::uv::Async<>> m_write_async;
+  IConnectionNotifier& m_notifier;
+  wpi::Logger& m_logger;
+  HelloFunc m_hello;
+  ExtensionsFunc m_extensions;
+  Message::GetEntryTypeFunc m_get_entry_type;
+  ProcessIncomingFunc m_process_incoming;
+  std::string m_remote_ip;
+  unsigned int m_remote_port = 0;
+  std::atomic_uint m_proto_rev{0x0300};
+  mutable wpi::mutex m_state_mutex;
+  State m_state = kCreated;
+  mutable wpi::mutex m_remote_id_mutex;
+  std::string m_remote_id;
+  std::atomic_ullong m_last_update{0};
+  std::chrono::steady_clock::time_point m_last_post;
+
+  // Loop thread only: partial message data, and the handshake progress
+  bool m_got_hello = false;
+  std::shared_ptr<Message> m_resume_hello;  // waiting for its SESSION
+  unsigned int m_ext_flags = 0;
+  std::string m_read_buf;
+  Outgoing m_handshake_incoming;
+
+  wpi::mutex m_pending_mutex;
+  PendingMessages m_pending;
+  WireEncoder m_encoder{0x0300};
+  ArrayDeltaCodec m_deltas;
+  CompressionCodec m_compression;
+  TimeSync m_time_sync;
+  std::vector<wpi::uv::Buffer> m_write_queue;
+  bool m_closed = false;
+
+  // Bytes encoded but not yet written to the socket
+  std::atomic<size_t> m_outgoing_bytes{0};
+  std::atomic<size_t> m_max_outgoing_bytes{
+      NetworkConnection::kDefaultMaxOutgoingBytes};
+};
+
+}  // namespace nt
+
+#endif  // NTCORE_UVNETWORKCONNECTION_H_
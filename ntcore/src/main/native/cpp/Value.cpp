@@ -208,9 +208,14 @@ bool nt::operator==(const Value& lhs, const Value& rhs) {
     case NT_DOUBLE:
       return lhs.m_val.data.v_double == rhs.m_val.data.v_double;
     case NT_STRING:
-    case NT_RAW:
     case NT_RPC:
       return lhs.m_string == rhs.m_string;
+    case NT_RAW: {
+      auto l = lhs.GetRaw();
+      auto r = rhs.GetRaw();
+      // shared data (including a value compared to itself) is equal
+      return l.size() == r.size() && (l.data() == r.data() || l == r);
+    }
     case NT_BOOLEAN_ARRAY:
       if (lhs.m_val.data.arr_boolean.size != rhs.m_val.data.arr_boolean.size) {
         return false;
@@ -6,9 +6,13 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <wpi/MathExtras.h>
 #include <wpi/MemAlloc.h>
@@ -120,28 +124,28 @@ bool WireDecoder::ReadType(NT_Type* type) {
   return true;
 }
 
-std::shared_ptr<Value> WireDecoder::ReadValue(NT_Type type) {
+std::shared_ptr<Value> WireDecoder::ReadValue(NT_Type type, uint64_t time) {
   switch (type) {
     case NT_BOOLEAN: {
       unsigned int v;
       if (!Read8(&v)) {
         return nullptr;
       }
-      return Value::MakeBoolean(v != 0);
+      return Value::MakeBoolean(v != 0, time);
     }
     case NT_DOUBLE: {
       double v;
       if (!ReadDouble(&v)) {
         return nullptr;
       }
-      return Value::MakeDouble(v);
+      return Value::MakeDouble(v, time);
     }
     case NT_STRING: {
       std::string v;
       if (!ReadString(&v)) {
         return nullptr;
       }
-      return Value::MakeString(std::move(v));
+      return Value::MakeString(std::move(v), time);
     }
     case NT_RAW: {
       if (m_proto_rev < 0x0300u) {
@@ -152,7 +156,7 @@ std::shared_ptr<Value> WireDecoder::ReadValue(NT_Type type) {
       if (!ReadString(&v)) {
         return nullptr;
       }
-      return Value::MakeRaw(std::move(v));
+      return Value::MakeRaw(std::move(v), time);
     }
     case NT_RPC: {
       if (m_proto_rev < 0x0300u) {
@@ -163,7 +167,7 @@ std::shared_ptr<Value> WireDecoder::ReadValue(NT_Type type) {
       if (!ReadString(&v)) {
         return nullptr;
       }
-      return Value::MakeRpc(std::move(v));
+      return Value::MakeRpc(std::move(v), time);
     }
     case NT_BOOLEAN_ARRAY: {
       // size
@@ -181,7 +185,7 @@ std::shared_ptr<Value> WireDecoder::ReadValue(NT_Type type) {
       for (unsigned int i = 0; i < size; ++i) {
         v[i] = buf[i] ? 1 : 0;
       }
-      return Value::MakeBooleanArray(std::move(v));
+      return Value::MakeBooleanArray(std::move(v), time);
     }
     case NT_DOUBLE_ARRAY: {
       // size
@@ -199,7 +203,7 @@ std::shared_ptr<Value> WireDecoder::ReadValue(NT_Type type) {
       for (unsigned int i = 0; i < size; ++i) {
         v[i] = ::ReadDouble(buf);
       }
-      return Value::MakeDoubleArray(std::move(v));
+      return Value::MakeDoubleArray(std::move(v), time);
     }
     case NT_STRING_ARRAY: {
       // size
@@ -215,7 +219,7 @@ std::shared_ptr<Value> WireDecoder::ReadValue(NT_Type type) {
           return nullptr;
         }
       }
-      return Value::MakeStringArray(std::move(v));
+      return Value::MakeStringArray(std::move(v), time);
     }
     default:
       m_error = "invalid type when trying to read value";
@@ -223,6 +227,65 @@ std::shared_ptr<Value> WireDecoder::ReadValue(NT_Type type) {
   }
 }
 
+std::shared_ptr<Value> WireDecoder::ReadUnboundedValue(NT_Type type) {
+  // element counts can't exceed the record size, so this bounds reserve()
+  auto reserve = [&](auto& v, uint64_t size) {
+    v.reserve((std::min)(size, static_cast<uint64_t>(4096)));
+  };
+  switch (type) {
+    case NT_BOOLEAN_ARRAY: {
+      uint64_t size;
+      if (!ReadUleb128(&size)) {
+        return nullptr;
+      }
+      std::vector<int> v;
+      reserve(v, size);
+      for (uint64_t i = 0; i < size; ++i) {
+        unsigned int elem;
+        if (!Read8(&elem)) {
+          return nullptr;
+        }
+        v.push_back(elem ? 1 : 0);
+      }
+      return Value::MakeBooleanArray(std::move(v));
+    }
+    case NT_DOUBLE_ARRAY: {
+      uint64_t size;
+      if (!ReadUleb128(&size)) {
+        return nullptr;
+      }
+      std::vector<double> v;
+      reserve(v, size);
+      for (uint64_t i = 0; i < size; ++i) {
+        double elem;
+        if (!ReadDouble(&elem)) {
+          return nullptr;
+        }
+        v.push_back(elem);
+      }
+      return Value::MakeDoubleArray(std::move(v));
+    }
+    case NT_STRING_ARRAY: {
+      uint64_t size;
+      if (!ReadUleb128(&size)) {
+        return nullptr;
+      }
+      std::vector<std::string> v;
+      reserve(v, size);
+      for (uint64_t i = 0; i < size; ++i) {
+        std::string elem;
+        if (!ReadString(&elem)) {
+          return nullptr;
+        }
+        v.emplace_back(std::move(elem));
+      }
+      return Value::MakeStringArray(std::move(v));
+    }
+    default:
+      return ReadValue(type);
+  }
+}
+
 bool WireDecoder::ReadString(std::string* str) {
   size_t len;
   if (m_proto_rev < 0x0300u) {
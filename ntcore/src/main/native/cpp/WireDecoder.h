@@ -25,11 +25,19 @@ namespace nt {
  * that was interrupted partway.  Read functions return false if
  * raw_istream.read() returned false (indicating the end of the input data
  * stream).
+ *
+ * Reading from a raw_mem_istream decodes in place, without copying data or
+ * reading it a byte at a time.
  */
 class WireDecoder {
  public:
   WireDecoder(wpi::raw_istream& is, unsigned int proto_rev,
               wpi::Logger& logger);
+  WireDecoder(wpi::raw_mem_istream& is, unsigned int proto_rev,
+              wpi::Logger& logger)
+      : WireDecoder(static_cast<wpi::raw_istream&>(is), proto_rev, logger) {
+    m_mem = &is;
+  }
   ~WireDecoder();
 
   void set_proto_rev(unsigned int proto_rev) { m_proto_rev = proto_rev; }
@@ -40,6 +48,20 @@ class WireDecoder {
   /* Get the logger. */
   wpi::Logger& logger() const { return m_logger; }
 
+  /* Whether entry values carry a timestamp (the time sync extension), and
+   * the offset of the peer's time base from ours.  Received times are
+   * converted to the local time base.
+   */
+  void set_timestamps(bool enable, int64_t offset) {
+    m_timestamps = enable;
+    m_time_offset = offset;
+  }
+  bool timestamps() const { return m_timestamps; }
+  int64_t time_offset() const { return m_time_offset; }
+  uint64_t FromWireTime(uint64_t time) const {
+    return time - static_cast<uint64_t>(m_time_offset);
+  }
+
   /* Clears error indicator. */
   void Reset() { m_error = nullptr; }
 
@@ -56,6 +78,11 @@ class WireDecoder {
    * Caution: the buffer is only temporarily valid.
    */
   bool Read(const char** buf, size_t len) {
+    if (m_mem && len <= m_mem->in_avail()) {
+      *buf = m_mem->remaining().data();
+      m_mem->skip(len);
+      return true;
+    }
     if (len > m_allocated) {
       Realloc(len);
     }
@@ -125,11 +152,24 @@ class WireDecoder {
   bool ReadDouble(double* val);
 
   /* Reads an ULEB128-encoded unsigned integer. */
-  bool ReadUleb128(uint64_t* val) { return wpi::ReadUleb128(m_is, val); }
+  bool ReadUleb128(uint64_t* val) {
+    if (m_mem) {
+      auto data = m_mem->remaining();
+      if (size_t count = wpi::ReadUleb128(data, val)) {
+        m_mem->skip(count);
+        return true;
+      }
+      // incomplete; have the stream consume it all and flag the error
+    }
+    return wpi::ReadUleb128(m_is, val);
+  }
 
   bool ReadType(NT_Type* type);
   bool ReadString(std::string* str);
-  std::shared_ptr<Value> ReadValue(NT_Type type);
+  std::shared_ptr<Value> ReadValue(NT_Type type, uint64_t time = 0);
+
+  /* Reads a value written by WireEncoder::WriteUnboundedValue(). */
+  std::shared_ptr<Value> ReadUnboundedValue(NT_Type type);
 
   WireDecoder(const WireDecoder&) = delete;
   WireDecoder& operator=(const WireDecoder&) = delete;
@@ -141,6 +181,9 @@ class WireDecoder {
   /* Error indicator. */
   const char* m_error;
 
+  bool m_timestamps = false;
+  int64_t m_time_offset = 0;
+
  private:
   /* Reallocate temporary buffer to specified length. */
   void Realloc(size_t len);
@@ -148,6 +191,9 @@ class WireDecoder {
   /* input stream */
   wpi::raw_istream& m_is;
 
+  /* the same stream, if it's in memory */
+  wpi::raw_mem_istream* m_mem = nullptr;
+
   /* logger */
   wpi::Logger& m_logger;
 
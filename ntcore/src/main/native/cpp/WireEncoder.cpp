@@ -30,7 +30,7 @@ void WireEncoder::WriteDouble(double val) {
        static_cast<char>((v >> 8) & 0xff), static_cast<char>(v & 0xff)});
 }
 
-void WireEncoder::WriteUleb128(uint32_t val) {
+void WireEncoder::WriteUleb128(uint64_t val) {
   wpi::WriteUleb128(m_data, val);
 }
 
@@ -77,6 +77,38 @@ void WireEncoder::WriteType(NT_Type type) {
   m_data.push_back(ch);
 }
 
+void WireEncoder::WriteUnboundedValue(const Value& value) {
+  switch (value.type()) {
+    case NT_BOOLEAN_ARRAY: {
+      auto v = value.GetBooleanArray();
+      WriteUleb128(v.size());
+      for (auto elem : v) {
+        Write8(elem ? 1 : 0);
+      }
+      break;
+    }
+    case NT_DOUBLE_ARRAY: {
+      auto v = value.GetDoubleArray();
+      WriteUleb128(v.size());
+      for (auto elem : v) {
+        WriteDouble(elem);
+      }
+      break;
+    }
+    case NT_STRING_ARRAY: {
+      auto v = value.GetStringArray();
+      WriteUleb128(v.size());
+      for (auto& elem : v) {
+        WriteString(elem);
+      }
+      break;
+    }
+    default:
+      WriteValue(value);
+      break;
+  }
+}
+
 size_t WireEncoder::GetValueSize(const Value& value) const {
   switch (value.type()) {
     case NT_BOOLEAN:
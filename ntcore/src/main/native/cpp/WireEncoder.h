@@ -32,6 +32,19 @@ class WireEncoder {
   /* Get the active protocol revision. */
   unsigned int proto_rev() const { return m_proto_rev; }
 
+  /* Whether entry values carry a timestamp (the time sync extension), and
+   * the offset of the peer's time base from ours.  Times are sent in the
+   * peer's time base.
+   */
+  void set_timestamps(bool enable, int64_t offset) {
+    m_timestamps = enable;
+    m_time_offset = offset;
+  }
+  bool timestamps() const { return m_timestamps; }
+  uint64_t ToWireTime(uint64_t time) const {
+    return time + static_cast<uint64_t>(m_time_offset);
+  }
+
   /* Clears buffer and error indicator. */
   void Reset() {
     m_data.clear();
@@ -76,10 +89,15 @@ class WireEncoder {
   void WriteDouble(double val);
 
   /* Writes an ULEB128-encoded unsigned integer. */
-  void WriteUleb128(uint32_t val);
+  void WriteUleb128(uint64_t val);
 
   void WriteType(NT_Type type);
   void WriteValue(const Value& value);
+
+  /* Writes a value as WriteValue() does, except that array lengths are
+   * ULEB128 rather than limited to 255 elements.  Used for on-disk formats.
+   */
+  void WriteUnboundedValue(const Value& value);
   void WriteString(std::string_view str);
 
   /* Utility function to get the written size of a value (without actually
@@ -99,6 +117,9 @@ class WireEncoder {
   /* Error indicator. */
   const char* m_error;
 
+  bool m_timestamps = false;
+  int64_t m_time_offset = 0;
+
  private:
   wpi::SmallVector<char, 256> m_data;
 };
@@ -4,11 +4,18 @@
 
 #include <jni.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 #include <fmt/format.h>
 #include <wpi/ConvertUTF.h>
+#include <wpi/DenseMap.h>
 #include <wpi/jni_util.h>
+#include <wpi/mutex.h>
 
 #include "edu_wpi_first_networktables_NetworkTablesJNI.h"
 #include "ntcore.h"
@@ -158,6 +165,15 @@ std::shared_ptr<nt::Value> FromJavaDoubleArray(JNIEnv* env, jdoubleArray jarr,
   return nt::Value::MakeDoubleArray(ref, time);
 }
 
+std::shared_ptr<nt::Value> FromJavaDoubleArrayBB(JNIEnv* env, jobject jbb,
+                                                 int len, jlong time) {
+  JDoubleArrayRef ref{env, jbb, len};
+  if (!ref) {
+    return nullptr;
+  }
+  return nt::Value::MakeDoubleArray(ref, time);
+}
+
 std::shared_ptr<nt::Value> FromJavaStringArray(JNIEnv* env, jobjectArray jarr,
                                                jlong time) {
   size_t len = env->GetArrayLength(jarr);
@@ -361,6 +377,117 @@ static jobjectArray MakeJObject(JNIEnv* env, jobject inst,
   return jarr;
 }
 
+//
+// Serialization of entry notifications into direct buffers
+//
+
+namespace {
+// Writes native-order values into a buffer; once the end is passed, further
+// writes are dropped, and the overflow is reported by Overflowed()
+class BufferWriter {
+ public:
+  BufferWriter(uint8_t* buf, size_t size) : m_buf{buf}, m_size{size} {}
+
+  template <typename T>
+  void Write(T value) {
+    if (m_pos + sizeof(T) <= m_size) {
+      std::memcpy(m_buf + m_pos, &value, sizeof(T));
+    }
+    m_pos += sizeof(T);
+  }
+
+  void Write(std::string_view str) {
+    Write<int32_t>(str.size());
+    if (m_pos + str.size() <= m_size) {
+      std::memcpy(m_buf + m_pos, str.data(), str.size());
+    }
+    m_pos += str.size();
+  }
+
+  size_t GetPosition() const { return m_pos; }
+  void SetPosition(size_t pos) { m_pos = pos; }
+  bool Overflowed() const { return m_pos > m_size; }
+
+ private:
+  uint8_t* m_buf;
+  size_t m_size;
+  size_t m_pos = 0;
+};
+
+// Events polled from a poller but not yet copied to a Java buffer
+struct PendingEntryNotifications {
+  std::vector<nt::EntryNotification> events;
+  size_t next = 0;
+};
+}  // namespace
+
+static wpi::mutex pendingMutex;
+static wpi::DenseMap<NT_EntryListenerPoller,
+                     std::shared_ptr<PendingEntryNotifications>>
+    pendingNotifications;
+
+static void WriteValue(BufferWriter& out, const nt::Value* value) {
+  if (!value) {
+    out.Write<uint8_t>(NT_UNASSIGNED);
+    out.Write<int64_t>(0);
+    return;
+  }
+  out.Write<uint8_t>(value->type());
+  out.Write<int64_t>(value->last_change());
+  switch (value->type()) {
+    case NT_BOOLEAN:
+      out.Write<uint8_t>(value->GetBoolean() ? 1 : 0);
+      break;
+    case NT_DOUBLE:
+      out.Write<double>(value->GetDouble());
+      break;
+    case NT_STRING:
+      out.Write(value->GetString());
+      break;
+    case NT_RAW:
+      out.Write(value->GetRaw());
+      break;
+    case NT_RPC:
+      out.Write(value->GetRpc());
+      break;
+    case NT_BOOLEAN_ARRAY: {
+      auto arr = value->GetBooleanArray();
+      out.Write<int32_t>(arr.size());
+      for (auto v : arr) {
+        out.Write<uint8_t>(v ? 1 : 0);
+      }
+      break;
+    }
+    case NT_DOUBLE_ARRAY: {
+      auto arr = value->GetDoubleArray();
+      out.Write<int32_t>(arr.size());
+      for (auto v : arr) {
+        out.Write<double>(v);
+      }
+      break;
+    }
+    case NT_STRING_ARRAY: {
+      auto arr = value->GetStringArray();
+      out.Write<int32_t>(arr.size());
+      for (auto&& v : arr) {
+        out.Write(v);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+static void WriteEntryNotification(BufferWriter& out,
+                                   const nt::EntryNotification& event) {
+  out.Write<int32_t>(event.listener);
+  out.Write<int32_t>(event.entry);
+  out.Write<int32_t>(event.flags);
+  out.Write(event.name);
+  WriteValue(out, event.value.get());
+}
+
 extern "C" {
 
 /*
@@ -617,7 +744,7 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_setBooleanArray
  * Signature: (IJ[DZ)Z
  */
 JNIEXPORT jboolean JNICALL
-Java_edu_wpi_first_networktables_NetworkTablesJNI_setDoubleArray
+Java_edu_wpi_first_networktables_NetworkTablesJNI_setDoubleArray__IJ_3DZ
   (JNIEnv* env, jclass, jint entry, jlong time, jdoubleArray value,
    jboolean force)
 {
@@ -636,6 +763,36 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_setDoubleArray
   return nt::SetEntryValue(entry, v);
 }
 
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    setDoubleArray
+ * Signature: (IJLjava/lang/Object;IZ)Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_setDoubleArray__IJLjava_nio_ByteBuffer_2IZ
+  (JNIEnv* env, jclass, jint entry, jlong time, jobject value, jint len,
+   jboolean force)
+{
+  if (!value) {
+    nullPointerEx.Throw(env, "value cannot be null");
+    return false;
+  }
+  if (len < 0 || env->GetDirectBufferCapacity(value) <
+                     static_cast<jlong>(len) * jlong{sizeof(double)}) {
+    illegalArgEx.Throw(env, "len is larger than the buffer");
+    return false;
+  }
+  auto v = FromJavaDoubleArrayBB(env, value, len, time);
+  if (!v) {
+    return false;
+  }
+  if (force) {
+    nt::SetEntryTypeValue(entry, v);
+    return JNI_TRUE;
+  }
+  return nt::SetEntryValue(entry, v);
+}
+
 /*
  * Class:     edu_wpi_first_networktables_NetworkTablesJNI
  * Method:    setStringArray
@@ -760,7 +917,7 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_getBooleanArray
  * Signature: (I[D)[D
  */
 JNIEXPORT jdoubleArray JNICALL
-Java_edu_wpi_first_networktables_NetworkTablesJNI_getDoubleArray
+Java_edu_wpi_first_networktables_NetworkTablesJNI_getDoubleArray__I_3D
   (JNIEnv* env, jclass, jint entry, jdoubleArray defaultValue)
 {
   auto val = nt::GetEntryValue(entry);
@@ -770,6 +927,32 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_getDoubleArray
   return MakeJDoubleArray(env, val->GetDoubleArray());
 }
 
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    getDoubleArray
+ * Signature: (ILjava/lang/Object;)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_getDoubleArray__ILjava_nio_ByteBuffer_2
+  (JNIEnv* env, jclass, jint entry, jobject value)
+{
+  auto buf = static_cast<uint8_t*>(env->GetDirectBufferAddress(value));
+  if (!buf) {
+    illegalArgEx.Throw(env, "value must be a direct ByteBuffer");
+    return -1;
+  }
+  auto val = nt::GetEntryValue(entry);
+  if (!val || !val->IsDoubleArray()) {
+    return -1;
+  }
+  auto arr = val->GetDoubleArray();
+  size_t len = (std::min)(
+      arr.size(),
+      static_cast<size_t>(env->GetDirectBufferCapacity(value)) / sizeof(double));
+  std::memcpy(buf, arr.data(), len * sizeof(double));
+  return arr.size();
+}
+
 /*
  * Class:     edu_wpi_first_networktables_NetworkTablesJNI
  * Method:    getStringArray
@@ -1005,6 +1188,8 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_destroyEntryListenerPoller
   (JNIEnv*, jclass, jint poller)
 {
   nt::DestroyEntryListenerPoller(poller);
+  std::scoped_lock lock(pendingMutex);
+  pendingNotifications.erase(poller);
 }
 
 /*
@@ -1071,6 +1256,62 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_pollEntryListenerTimeout
   return MakeJObject(env, inst, events);
 }
 
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    pollEntryListenerBuffer
+ * Signature: (IDLjava/lang/Object;)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_pollEntryListenerBuffer
+  (JNIEnv* env, jclass, jint poller, jdouble timeout, jobject buffer)
+{
+  auto buf = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
+  if (!buf) {
+    illegalArgEx.Throw(env, "buffer must be a direct ByteBuffer");
+    return 0;
+  }
+  BufferWriter out{buf,
+                   static_cast<size_t>(env->GetDirectBufferCapacity(buffer))};
+
+  std::shared_ptr<PendingEntryNotifications> pending;
+  {
+    std::scoped_lock lock(pendingMutex);
+    auto& p = pendingNotifications[poller];
+    if (!p) {
+      p = std::make_shared<PendingEntryNotifications>();
+    }
+    pending = p;
+  }
+
+  // only wait for new events once the previous ones have all been copied
+  if (pending->next >= pending->events.size()) {
+    bool timed_out = false;
+    nt::PollEntryListener(poller, timeout, &timed_out, &pending->events);
+    pending->next = 0;
+    if (pending->events.empty() && !timed_out) {
+      interruptedEx.Throw(env, "PollEntryListener interrupted");
+      return 0;
+    }
+  }
+
+  // events that don't fit are returned by the next call
+  jint count = 0;
+  for (; pending->next < pending->events.size(); ++pending->next) {
+    size_t start = out.GetPosition();
+    WriteEntryNotification(out, pending->events[pending->next]);
+    if (out.Overflowed()) {
+      if (count == 0) {
+        // report the size needed for the event
+        return -static_cast<jint>(out.GetPosition() - start);
+      }
+      out.SetPosition(start);
+      break;
+    }
+    ++count;
+  }
+  return count;
+}
+
 /*
  * Class:     edu_wpi_first_networktables_NetworkTablesJNI
  * Method:    cancelPollEntryListener
@@ -1083,6 +1324,18 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_cancelPollEntryListener
   nt::CancelPollEntryListener(poller);
 }
 
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    setEntryListenerPollerQueue
+ * Signature: (III)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_setEntryListenerPollerQueue
+  (JNIEnv*, jclass, jint poller, jint mode, jint maxSize)
+{
+  nt::SetEntryListenerPollerQueue(poller, mode, maxSize < 0 ? 0 : maxSize);
+}
+
 /*
  * Class:     edu_wpi_first_networktables_NetworkTablesJNI
  * Method:    removeEntryListener
@@ -101,6 +101,10 @@ static void ConvertToC(const LogMessage& in, NT_LogMessage* out) {
   ConvertToC(in.message, &out->message);
 }
 
+static void ConvertToC(const std::shared_ptr<Value>& in, NT_Value* out) {
+  ConvertToC(*in, out);
+}
+
 template <typename O, typename I>
 static O* ConvertToC(const std::vector<I>& in, size_t* out_len) {
   if (!out_len) {
@@ -227,6 +231,16 @@ uint64_t NT_GetEntryLastChange(NT_Entry entry) {
   return nt::GetEntryLastChange(entry);
 }
 
+void NT_SetEntryHistoryDepth(NT_Entry entry, size_t depth) {
+  nt::SetEntryHistoryDepth(entry, depth);
+}
+
+struct NT_Value* NT_GetEntryHistory(NT_Entry entry, uint64_t since,
+                                    size_t* count) {
+  auto values = nt::GetEntryHistory(entry, since);
+  return ConvertToC<NT_Value>(values, count);
+}
+
 void NT_GetEntryValue(NT_Entry entry, struct NT_Value* value) {
   NT_InitValue(value);
   auto v = nt::GetEntryValue(entry);
@@ -257,6 +271,19 @@ unsigned int NT_GetEntryFlags(NT_Entry entry) {
   return nt::GetEntryFlags(entry);
 }
 
+void NT_SetEntryPriority(NT_Entry entry, unsigned int priority) {
+  nt::SetEntryPriority(entry, priority);
+}
+
+unsigned int NT_GetEntryPriority(NT_Entry entry) {
+  return nt::GetEntryPriority(entry);
+}
+
+void NT_SetPrefixPriority(NT_Inst inst, const char* prefix, size_t prefix_len,
+                          unsigned int priority) {
+  nt::SetPrefixPriority(inst, {prefix, prefix_len}, priority);
+}
+
 void NT_DeleteEntry(NT_Entry entry) {
   nt::DeleteEntry(entry);
 }
@@ -354,6 +381,11 @@ void NT_CancelPollEntryListener(NT_EntryListenerPoller poller) {
   nt::CancelPollEntryListener(poller);
 }
 
+void NT_SetEntryListenerPollerQueue(NT_EntryListenerPoller poller,
+                                    unsigned int mode, size_t max_size) {
+  nt::SetEntryListenerPollerQueue(poller, mode, max_size);
+}
+
 void NT_RemoveEntryListener(NT_EntryListener entry_listener) {
   nt::RemoveEntryListener(entry_listener);
 }
@@ -508,6 +540,10 @@ void NT_CancelRpcResult(NT_Entry entry, NT_RpcCall call) {
   nt::CancelRpcResult(entry, call);
 }
 
+void NT_SetRpcWorkerThreads(NT_Inst inst, unsigned int count) {
+  nt::SetRpcWorkerThreads(inst, count);
+}
+
 char* NT_PackRpcDefinition(const NT_RpcDefinition* def, size_t* packed_len) {
   auto packed = nt::PackRpcDefinition(ConvertFromC(*def));
 
@@ -595,6 +631,22 @@ void NT_StopServer(NT_Inst inst) {
   nt::StopServer(inst);
 }
 
+void NT_SetServerEventLoop(NT_Inst inst, NT_Bool enabled) {
+  nt::SetServerEventLoop(inst, enabled != 0);
+}
+
+void NT_SetNetworkCompression(NT_Inst inst, NT_Bool enabled) {
+  nt::SetNetworkCompression(inst, enabled != 0);
+}
+
+void NT_SetNetworkDatagrams(NT_Inst inst, NT_Bool enabled) {
+  nt::SetNetworkDatagrams(inst, enabled != 0);
+}
+
+void NT_SetPersistentJournal(NT_Inst inst, NT_Bool enabled) {
+  nt::SetPersistentJournal(inst, enabled != 0);
+}
+
 void NT_StartClientNone(NT_Inst inst) {
   nt::StartClient(inst);
 }
@@ -659,6 +711,10 @@ NT_Bool NT_IsConnected(NT_Inst inst) {
   return nt::IsConnected(inst);
 }
 
+NT_Bool NT_GetServerTimeOffset(NT_Inst inst, int64_t* offset) {
+  return nt::GetServerTimeOffset(inst, offset);
+}
+
 struct NT_ConnectionInfo* NT_GetConnections(NT_Inst inst, size_t* count) {
   auto conn_v = nt::GetConnections(inst);
   return ConvertToC<NT_ConnectionInfo>(conn_v, count);
@@ -688,6 +744,14 @@ const char* NT_LoadEntries(NT_Inst inst, const char* filename,
   return nt::LoadEntries(inst, filename, {prefix, prefix_len}, warn);
 }
 
+const char* NT_StartDataLog(NT_Inst inst, const char* filename) {
+  return nt::StartDataLog(inst, filename);
+}
+
+void NT_StopDataLog(NT_Inst inst) {
+  nt::StopDataLog(inst);
+}
+
 /*
  * Utility Functions
  */
@@ -778,6 +842,13 @@ void NT_DisposeValue(NT_Value* value) {
   value->last_change = 0;
 }
 
+void NT_DisposeValueArray(NT_Value* arr, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    NT_DisposeValue(&arr[i]);
+  }
+  std::free(arr);
+}
+
 void NT_InitValue(NT_Value* value) {
   value->type = NT_UNASSIGNED;
   value->last_change = 0;
@@ -935,7 +1006,7 @@ NT_Bool NT_SetEntryDouble(NT_Entry entry, uint64_t time, double v_double,
     nt::SetEntryTypeValue(entry, Value::MakeDouble(v_double, time));
     return 1;
   } else {
-    return nt::SetEntryValue(entry, Value::MakeDouble(v_double, time));
+    return nt::SetEntryDouble(entry, v_double, time);
   }
 }
 
@@ -945,7 +1016,7 @@ NT_Bool NT_SetEntryBoolean(NT_Entry entry, uint64_t time, NT_Bool v_boolean,
     nt::SetEntryTypeValue(entry, Value::MakeBoolean(v_boolean != 0, time));
     return 1;
   } else {
-    return nt::SetEntryValue(entry, Value::MakeBoolean(v_boolean != 0, time));
+    return nt::SetEntryBoolean(entry, v_boolean != 0, time);
   }
 }
 
@@ -1163,24 +1234,17 @@ NT_Bool NT_SetDefaultEntryStringArray(NT_Entry entry, uint64_t time,
 
 NT_Bool NT_GetEntryBoolean(NT_Entry entry, uint64_t* last_change,
                            NT_Bool* v_boolean) {
-  auto v = nt::GetEntryValue(entry);
-  if (!v || !v->IsBoolean()) {
+  bool v;
+  if (!nt::GetEntryBoolean(entry, &v, last_change)) {
     return 0;
   }
-  *v_boolean = v->GetBoolean();
-  *last_change = v->last_change();
+  *v_boolean = v;
   return 1;
 }
 
 NT_Bool NT_GetEntryDouble(NT_Entry entry, uint64_t* last_change,
                           double* v_double) {
-  auto v = nt::GetEntryValue(entry);
-  if (!v || !v->IsDouble()) {
-    return 0;
-  }
-  *last_change = v->last_change();
-  *v_double = v->GetDouble();
-  return 1;
+  return nt::GetEntryDouble(entry, v_double, last_change);
 }
 
 char* NT_GetEntryString(NT_Entry entry, uint64_t* last_change,
@@ -5,9 +5,12 @@
 #include <stdint.h>
 
 #include <cassert>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 
+#include <wpi/SmallVector.h>
+#include <wpi/lock_stats.h>
 #include <wpi/timestamp.h>
 
 #include "Handle.h"
@@ -127,6 +130,86 @@ std::shared_ptr<Value> GetEntryValue(NT_Entry entry) {
   return ii->storage.GetEntryValue(id);
 }
 
+bool GetEntryBoolean(NT_Entry entry, bool* value, uint64_t* last_change) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return false;
+  }
+
+  return ii->storage.GetEntryBoolean(id, value, last_change);
+}
+
+bool GetEntryDouble(NT_Entry entry, double* value, uint64_t* last_change) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return false;
+  }
+
+  return ii->storage.GetEntryDouble(id, value, last_change);
+}
+
+bool PublishLocalEntryValue(NT_Entry entry, std::shared_ptr<Value> value) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return false;
+  }
+
+  return ii->storage.PublishLocalEntryValue(id, std::move(value));
+}
+
+bool ReadLocalEntryValue(NT_Entry entry, uint64_t* seq,
+                         std::shared_ptr<Value>* value) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return false;
+  }
+
+  return ii->storage.ReadLocalEntryValue(id, seq, value);
+}
+
+bool WaitForLocalEntryValue(NT_Entry entry, uint64_t* seq,
+                            std::shared_ptr<Value>* value, double timeout) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return false;
+  }
+
+  return ii->storage.WaitForLocalEntryValue(id, seq, value, timeout);
+}
+
+void SetEntryHistoryDepth(NT_Entry entry, size_t depth) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return;
+  }
+
+  ii->storage.SetEntryHistoryDepth(id, depth);
+}
+
+std::vector<std::shared_ptr<Value>> GetEntryHistory(NT_Entry entry,
+                                                    uint64_t since) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return {};
+  }
+
+  return ii->storage.GetEntryHistory(id, since);
+}
+
 bool SetDefaultEntryValue(NT_Entry entry, std::shared_ptr<Value> value) {
   Handle handle{entry};
   int id = handle.GetTypedIndex(Handle::kEntry);
@@ -149,6 +232,71 @@ bool SetEntryValue(NT_Entry entry, std::shared_ptr<Value> value) {
   return ii->storage.SetEntryValue(id, value);
 }
 
+// Converts entry handles to local ids in the instance of the first handle.
+// Handles that are invalid or in another instance map to UINT_MAX.
+static InstanceImpl* GetEntryIds(wpi::span<const NT_Entry> entries,
+                                 wpi::SmallVectorImpl<unsigned int>* ids) {
+  if (entries.empty()) {
+    return nullptr;
+  }
+  int inst = Handle{entries[0]}.GetInst();
+  ids->clear();
+  ids->reserve(entries.size());
+  for (auto entry : entries) {
+    Handle handle{entry};
+    int id = handle.GetTypedIndex(Handle::kEntry);
+    ids->push_back(id < 0 || handle.GetInst() != inst ? UINT_MAX : id);
+  }
+  return InstanceImpl::Get(inst);
+}
+
+std::vector<std::shared_ptr<Value>> GetEntryValues(
+    wpi::span<const NT_Entry> entries) {
+  std::vector<std::shared_ptr<Value>> values;
+  wpi::SmallVector<unsigned int, 64> ids;
+  auto ii = GetEntryIds(entries, &ids);
+  if (!ii) {
+    values.resize(entries.size());
+    return values;
+  }
+
+  ii->storage.GetEntryValues(ids, &values);
+  return values;
+}
+
+bool SetEntryValues(wpi::span<const NT_Entry> entries,
+                    wpi::span<const std::shared_ptr<Value>> values) {
+  wpi::SmallVector<unsigned int, 64> ids;
+  auto ii = GetEntryIds(entries, &ids);
+  if (!ii) {
+    return entries.empty();
+  }
+
+  return ii->storage.SetEntryValues(ids, values);
+}
+
+bool SetEntryBoolean(NT_Entry entry, bool value, uint64_t time) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return false;
+  }
+
+  return ii->storage.SetEntryBoolean(id, value, time);
+}
+
+bool SetEntryDouble(NT_Entry entry, double value, uint64_t time) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return false;
+  }
+
+  return ii->storage.SetEntryDouble(id, value, time);
+}
+
 void SetEntryTypeValue(NT_Entry entry, std::shared_ptr<Value> value) {
   Handle handle{entry};
   int id = handle.GetTypedIndex(Handle::kEntry);
@@ -182,6 +330,38 @@ unsigned int GetEntryFlags(NT_Entry entry) {
   return ii->storage.GetEntryFlags(id);
 }
 
+void SetEntryPriority(NT_Entry entry, unsigned int priority) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return;
+  }
+
+  ii->storage.SetEntryPriority(id, priority);
+}
+
+unsigned int GetEntryPriority(NT_Entry entry) {
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return NT_PRIORITY_NORMAL;
+  }
+
+  return ii->storage.GetEntryPriority(id);
+}
+
+void SetPrefixPriority(NT_Inst inst, std::string_view prefix,
+                       unsigned int priority) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->storage.SetPrefixPriority(prefix, priority);
+}
+
 void DeleteEntry(NT_Entry entry) {
   Handle handle{entry};
   int id = handle.GetTypedIndex(Handle::kEntry);
@@ -352,6 +532,46 @@ std::vector<EntryNotification> PollEntryListener(NT_EntryListenerPoller poller,
                                  timed_out);
 }
 
+void PollEntryListener(NT_EntryListenerPoller poller, double timeout,
+                       bool* timed_out,
+                       std::vector<EntryNotification>* events) {
+  *timed_out = false;
+  events->clear();
+  Handle handle{poller};
+  int id = handle.GetTypedIndex(Handle::kEntryListenerPoller);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return;
+  }
+
+  ii->entry_notifier.Poll(static_cast<unsigned int>(id), timeout, timed_out,
+                          events);
+}
+
+void SetEntryListenerPollerQueue(NT_EntryListenerPoller poller,
+                                 unsigned int mode, size_t max_size) {
+  Handle handle{poller};
+  int id = handle.GetTypedIndex(Handle::kEntryListenerPoller);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return;
+  }
+
+  wpi::PollQueueMode queue_mode;
+  switch (mode) {
+    case NT_POLLER_QUEUE_DROP_OLDEST:
+      queue_mode = wpi::PollQueueMode::kDropOldest;
+      break;
+    case NT_POLLER_QUEUE_COALESCE:
+      queue_mode = wpi::PollQueueMode::kCoalesce;
+      break;
+    default:
+      queue_mode = wpi::PollQueueMode::kUnbounded;
+      break;
+  }
+  ii->entry_notifier.SetPollerQueue(id, queue_mode, max_size);
+}
+
 void CancelPollEntryListener(NT_EntryListenerPoller poller) {
   Handle handle{poller};
   int id = handle.GetTypedIndex(Handle::kEntryListenerPoller);
@@ -706,6 +926,43 @@ void CancelRpcResult(NT_Entry entry, NT_RpcCall call) {
   ii->storage.CancelRpcResult(id, call_uid);
 }
 
+bool GetRpcResults(NT_Entry entry, wpi::span<const NT_RpcCall> calls,
+                   std::vector<std::string>* results, double timeout,
+                   bool* timed_out) {
+  *timed_out = false;
+  Handle handle{entry};
+  int id = handle.GetTypedIndex(Handle::kEntry);
+  auto ii = InstanceImpl::Get(handle.GetInst());
+  if (id < 0 || !ii) {
+    return false;
+  }
+
+  wpi::SmallVector<unsigned int, 16> call_uids;
+  call_uids.reserve(calls.size());
+  for (auto call : calls) {
+    Handle chandle{call};
+    int call_uid = chandle.GetTypedIndex(Handle::kRpcCall);
+    if (call_uid < 0) {
+      return false;
+    }
+    if (handle.GetInst() != chandle.GetInst()) {
+      return false;
+    }
+    call_uids.push_back(call_uid);
+  }
+
+  return ii->storage.GetRpcResults(id, call_uids, results, timeout, timed_out);
+}
+
+void SetRpcWorkerThreads(NT_Inst inst, unsigned int count) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->rpc_server.SetWorkerThreads(count);
+}
+
 std::string PackRpcDefinition(const RpcDefinition& def) {
   WireEncoder enc(0x0300);
   enc.Write8(def.version);
@@ -820,6 +1077,27 @@ uint64_t Now() {
   return wpi::Now();
 }
 
+void PublishLockStats(NT_Inst inst, std::string_view prefix) {
+  for (auto&& stats : wpi::GetLockStats()) {
+    std::string base{prefix};
+    base += '/';
+    base += stats.name;
+    base += '/';
+    auto set = [&](std::string_view name, std::shared_ptr<Value> value) {
+      SetEntryValue(GetEntry(inst, base + std::string{name}), value);
+    };
+    set("acquisitions", Value::MakeDouble(stats.acquisitions));
+    set("contentions", Value::MakeDouble(stats.contentions));
+    set("maxWaitUs", Value::MakeDouble(stats.maxWaitNs / 1000.0));
+    set("maxHoldUs", Value::MakeDouble(stats.maxHoldNs / 1000.0));
+    double histogram[wpi::kLockWaitBuckets];
+    for (size_t i = 0; i < wpi::kLockWaitBuckets; ++i) {
+      histogram[i] = stats.waitHistogram[i];
+    }
+    set("waitHistogram", Value::MakeDoubleArray(histogram));
+  }
+}
+
 /*
  * Client/Server Functions
  */
@@ -879,6 +1157,42 @@ void StopServer(NT_Inst inst) {
   ii->dispatcher.Stop();
 }
 
+void SetServerEventLoop(NT_Inst inst, bool enabled) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->dispatcher.SetServerEventLoop(enabled);
+}
+
+void SetNetworkCompression(NT_Inst inst, bool enabled) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->dispatcher.SetNetworkCompression(enabled);
+}
+
+void SetNetworkDatagrams(NT_Inst inst, bool enabled) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->dispatcher.SetNetworkDatagrams(enabled);
+}
+
+void SetPersistentJournal(NT_Inst inst, bool enabled) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->dispatcher.SetPersistentJournal(enabled);
+}
+
 void StartClient(NT_Inst inst) {
   auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
   if (!ii) {
@@ -958,6 +1272,16 @@ void SetServerTeam(NT_Inst inst, unsigned int team, unsigned int port) {
   ii->dispatcher.SetServerTeam(team, port);
 }
 
+void SetClientSubscriptions(NT_Inst inst,
+                            wpi::span<const std::string_view> prefixes) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->dispatcher.SetClientSubscriptions(prefixes);
+}
+
 void StartDSClient(NT_Inst inst, unsigned int port) {
   auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
   if (!ii) {
@@ -1012,6 +1336,15 @@ bool IsConnected(NT_Inst inst) {
   return ii->dispatcher.IsConnected();
 }
 
+bool GetServerTimeOffset(NT_Inst inst, int64_t* offset) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return false;
+  }
+
+  return ii->dispatcher.GetServerTimeOffset(offset);
+}
+
 /*
  * Persistent Functions
  */
@@ -1057,6 +1390,35 @@ const char* LoadEntries(
   return ii->storage.LoadEntries(filename, prefix, warn);
 }
 
+const char* StartDataLog(NT_Inst inst, std::string_view filename) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return "invalid instance handle";
+  }
+
+  return ii->storage.StartDataLog(filename);
+}
+
+void StartDataLog(NT_Inst inst, wpi::log::DataLog& log,
+                  std::string_view prefix, std::string_view logPrefix) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->storage.StopDataLog();
+  ii->storage.StartDataLog(log, prefix, logPrefix);
+}
+
+void StopDataLog(NT_Inst inst) {
+  auto ii = InstanceImpl::Get(Handle{inst}.GetTypedInst(Handle::kInstance));
+  if (!ii) {
+    return;
+  }
+
+  ii->storage.StopDataLog();
+}
+
 NT_Logger AddLogger(NT_Inst inst,
                     std::function<void(const LogMessage& msg)> func,
                     unsigned int min_level, unsigned int max_level) {
@@ -34,7 +34,16 @@ class NetworkTableEntry final {
   /**
    * Flag values (as returned by GetFlags()).
    */
-  enum Flags { kPersistent = NT_PERSISTENT };
+  enum Flags { kPersistent = NT_PERSISTENT, kUnreliable = NT_UNRELIABLE };
+
+  /**
+   * Update priority values (as returned by GetPriority()).
+   */
+  enum Priority {
+    kNormalPriority = NT_PRIORITY_NORMAL,
+    kHighPriority = NT_PRIORITY_HIGH,
+    kLowPriority = NT_PRIORITY_LOW
+  };
 
   /**
    * Construct invalid instance.
@@ -118,6 +127,22 @@ class NetworkTableEntry final {
    */
   std::shared_ptr<Value> GetValue() const;
 
+  /**
+   * Starts (or stops) keeping the entry's most recent values.
+   *
+   * @param depth number of values to keep; 0 stops recording
+   */
+  void SetHistoryDepth(size_t depth);
+
+  /**
+   * Gets the entry's recorded values that changed after a given time, oldest
+   * first.  Empty unless SetHistoryDepth() has been called.
+   *
+   * @param since only return values with a later change time (0 for all)
+   * @return the entry's recent values
+   */
+  std::vector<std::shared_ptr<Value>> GetHistory(uint64_t since = 0) const;
+
   /**
    * Gets the entry's value as a boolean. If the entry does not exist or is of
    * different type, it will return the default value.
@@ -549,6 +574,22 @@ class NetworkTableEntry final {
    */
   void ClearFlags(unsigned int flags);
 
+  /**
+   * Sets the update priority.  Changes to a high priority entry are sent
+   * immediately rather than with the next periodic update, and changes to a
+   * low priority entry are sent less often than the update rate.
+   *
+   * @param priority the priority (Priority)
+   */
+  void SetPriority(unsigned int priority);
+
+  /**
+   * Returns the update priority.
+   *
+   * @return the priority (Priority)
+   */
+  unsigned int GetPriority() const;
+
   /**
    * Make value persistent through program restarts.
    */
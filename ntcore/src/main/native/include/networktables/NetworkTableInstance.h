@@ -160,6 +160,16 @@ class NetworkTableInstance final {
   std::vector<EntryInfo> GetEntryInfo(std::string_view prefix,
                                       unsigned int types) const;
 
+  /**
+   * Sets the update priority of all existing and future entries starting
+   * with the given prefix.  If several prefixes match an entry, the longest
+   * one wins.
+   *
+   * @param prefix entry name prefix
+   * @param priority priority (NetworkTableEntry::Priority)
+   */
+  void SetPrefixPriority(std::string_view prefix, unsigned int priority);
+
   /**
    * Gets the table with the specified key.
    *
@@ -322,6 +332,54 @@ class NetworkTableInstance final {
    */
   void StopServer();
 
+  /**
+   * Sets whether a server started with StartServer() runs all client
+   * connections on a single event loop thread rather than on two threads per
+   * client.  Must be called before StartServer() to take effect.
+   *
+   * @param enabled  true to use a single event loop thread
+   */
+  void SetServerEventLoop(bool enabled);
+
+  /**
+   * Sets whether network connections compress batches of messages.  A client
+   * with this enabled asks the server for compression when it connects; the
+   * server only agrees if it also has this enabled.  Takes effect on the next
+   * connection.
+   *
+   * @param enabled  true to compress
+   */
+  void SetNetworkCompression(bool enabled);
+
+  /**
+   * Sets whether network connections send updates to entries flagged
+   * kUnreliable as UDP datagrams, which avoids TCP head-of-line blocking on
+   * lossy links.  Both ends must enable it.  Takes effect when the server
+   * starts or on the next connection.
+   *
+   * @param enabled  true to use datagrams
+   */
+  void SetNetworkDatagrams(bool enabled);
+
+  /**
+   * Sets the number of worker threads that run RPC callbacks.  With zero
+   * (the default), callbacks run one at a time on a single thread; otherwise
+   * up to this many calls are answered concurrently.
+   *
+   * @param count    number of worker threads
+   */
+  void SetRpcWorkerThreads(unsigned int count);
+
+  /**
+   * Sets whether the server's periodic persistent saves write a binary
+   * journal of just the changed entries instead of rewriting the whole text
+   * file.  The journal is compacted automatically.  Either format is read at
+   * startup.
+   *
+   * @param enabled  true to save persistent values as a journal
+   */
+  void SetPersistentJournal(bool enabled);
+
   /**
    * Starts a client.  Use SetServer to set the server name and port.
    */
@@ -404,6 +462,15 @@ class NetworkTableInstance final {
    */
   void SetServerTeam(unsigned int team, unsigned int port = kDefaultPort);
 
+  /**
+   * Sets the entry name prefixes the client subscribes to.  A server that
+   * supports subscriptions then only sends the matching entries (and the
+   * ones this client creates).  An empty list subscribes to everything.
+   *
+   * @param prefixes entry name prefixes
+   */
+  void SetClientSubscriptions(wpi::span<const std::string_view> prefixes);
+
   /**
    * Starts requesting server address from Driver Station.
    * This connects to the Driver Station running on localhost to obtain the
@@ -449,6 +516,15 @@ class NetworkTableInstance final {
    */
   bool IsConnected() const;
 
+  /**
+   * Get the estimated offset of the server's clock from the local clock
+   * (server time minus local time, in microseconds).
+   *
+   * @param offset the offset (output)
+   * @return False if the offset isn't known.
+   */
+  bool GetServerTimeOffset(int64_t* offset) const;
+
   /** @} */
 
   /**
@@ -503,6 +579,32 @@ class NetworkTableInstance final {
       std::string_view filename, std::string_view prefix,
       std::function<void(size_t line, const char* msg)> warn);
 
+  /**
+   * Starts logging every entry value set to a binary file, replacing any
+   * existing file.  The log starts with the current values.  Logging does
+   * not block; if the background writer falls behind, values are dropped.
+   *
+   * @param filename  filename
+   * @return error string, or nullptr if successful
+   */
+  const char* StartDataLog(std::string_view filename);
+
+  /**
+   * Starts logging entry values to a data log, as log entries named logPrefix
+   * followed by the entry name.  The log starts with the current values.
+   *
+   * @param log       data log; must outlive the logging, until StopDataLog()
+   * @param prefix    only log entries whose names start with this prefix
+   * @param logPrefix prefix of the log entry names
+   */
+  void StartDataLog(wpi::log::DataLog& log, std::string_view prefix = "",
+                    std::string_view logPrefix = "NT:");
+
+  /**
+   * Stops logging entry values, writing out anything buffered.
+   */
+  void StopDataLog();
+
   /** @} */
 
   /**
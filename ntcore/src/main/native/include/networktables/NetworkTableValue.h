@@ -174,7 +174,7 @@ class Value final {
    */
   std::string_view GetRaw() const {
     assert(m_val.type == NT_RAW);
-    return m_string;
+    return {m_val.data.v_raw.str, m_val.data.v_raw.len};
   }
 
   /**
@@ -277,8 +277,8 @@ class Value final {
    *             time)
    * @return The entry value
    */
-  template <typename T,
-            typename std::enable_if<std::is_same<T, std::string>::value>::type>
+  template <typename T, typename std::enable_if_t<
+                            std::is_same_v<T, std::string>, int> = 0>
   static std::shared_ptr<Value> MakeString(T&& value, uint64_t time = 0) {
     auto val = std::make_shared<Value>(NT_STRING, time, private_init());
     val->m_string = std::forward<T>(value);
@@ -312,8 +312,8 @@ class Value final {
    *             time)
    * @return The entry value
    */
-  template <typename T,
-            typename std::enable_if<std::is_same<T, std::string>::value>::type>
+  template <typename T, typename std::enable_if_t<
+                            std::is_same_v<T, std::string>, int> = 0>
   static std::shared_ptr<Value> MakeRaw(T&& value, uint64_t time = 0) {
     auto val = std::make_shared<Value>(NT_RAW, time, private_init());
     val->m_string = std::forward<T>(value);
@@ -322,6 +322,29 @@ class Value final {
     return val;
   }
 
+  /**
+   * Creates a raw entry value that refers to existing data rather than
+   * copying it.  The data must not change while owner is alive; the value
+   * (and any copies of it held by storage or readers) keeps owner alive.
+   * This avoids copies of large values, such as a buffer that is published
+   * unchanged and then discarded.
+   *
+   * @param owner keeps the data alive (e.g. a shared_ptr to a buffer)
+   * @param value the data
+   * @param time if nonzero, the creation time to use (instead of the current
+   *             time)
+   * @return The entry value
+   */
+  static std::shared_ptr<Value> MakeRaw(std::shared_ptr<const void> owner,
+                                        std::string_view value,
+                                        uint64_t time = 0) {
+    auto val = std::make_shared<Value>(NT_RAW, time, private_init());
+    val->m_owner = std::move(owner);
+    val->m_val.data.v_raw.str = const_cast<char*>(value.data());
+    val->m_val.data.v_raw.len = value.size();
+    return val;
+  }
+
   /**
    * Creates a rpc entry value.
    *
@@ -471,10 +494,16 @@ class Value final {
   Value& operator=(const Value&) = delete;
   friend bool operator==(const Value& lhs, const Value& rhs);
 
+  // Storage updates boolean and double values in place when it holds the
+  // only reference to them.
+  friend class Storage;
+
  private:
   NT_Value m_val;
   std::string m_string;
   std::vector<std::string> m_string_array;
+  // Keeps raw data not in m_string alive
+  std::shared_ptr<const void> m_owner;
 };
 
 bool operator==(const Value& lhs, const Value& rhs);
@@ -58,8 +58,34 @@ enum NT_Type {
   NT_RPC = 0x80
 };
 
-/** NetworkTables entry flags. */
-enum NT_EntryFlags { NT_PERSISTENT = 0x01 };
+/**
+ * NetworkTables entry flags.  Updates to NT_UNRELIABLE entries only matter
+ * for their latest value, so they may be sent as datagrams that can be lost
+ * (see NT_SetNetworkDatagrams()).
+ */
+enum NT_EntryFlags { NT_PERSISTENT = 0x01, NT_UNRELIABLE = 0x02 };
+
+/**
+ * NetworkTables entry update priorities.  High priority changes are sent
+ * immediately; low priority changes are sent less often than the update
+ * rate.
+ */
+enum NT_EntryPriority {
+  NT_PRIORITY_NORMAL = 0,
+  NT_PRIORITY_HIGH = 1,
+  NT_PRIORITY_LOW = 2
+};
+
+/**
+ * How an entry listener poller's queue is bounded.  Bounded queues drop the
+ * oldest events; coalescing queues first merge an event into a queued one
+ * for the same listener and entry (deletions are never merged).
+ */
+enum NT_PollerQueueMode {
+  NT_POLLER_QUEUE_UNBOUNDED = 0,
+  NT_POLLER_QUEUE_DROP_OLDEST = 1,
+  NT_POLLER_QUEUE_COALESCE = 2
+};
 
 /** NetworkTables logging levels. */
 enum NT_LogLevel {
@@ -379,6 +405,39 @@ uint64_t NT_GetEntryLastChange(NT_Entry entry);
  */
 void NT_GetEntryValue(NT_Entry entry, struct NT_Value* value);
 
+/**
+ * Set Entry History Depth.
+ *
+ * Starts (or stops) keeping the most recent values of an entry so they can be
+ * read back in bulk with NT_GetEntryHistory().  Each distinct value is
+ * recorded along with its change time.  Changing the depth keeps the newest
+ * values.
+ *
+ * @param entry     entry handle
+ * @param depth     number of values to keep; 0 stops recording and discards
+ *                  the history
+ */
+void NT_SetEntryHistoryDepth(NT_Entry entry, size_t depth);
+
+/**
+ * Get Entry History.
+ *
+ * Returns the recorded values of an entry that changed after a given time,
+ * oldest first.  The values may differ in type if the entry's type has
+ * changed.
+ *
+ * @param entry     entry handle
+ * @param since     only return values with a later change time (0 for all)
+ * @param count     number of values returned (output)
+ * @return array of values; null if there are none
+ *
+ * It is the caller's responsibility to free the array once it's no longer
+ * needed (the utility function NT_DisposeValueArray() is useful for this
+ * purpose).
+ */
+struct NT_Value* NT_GetEntryHistory(NT_Entry entry, uint64_t since,
+                                    size_t* count);
+
 /**
  * Set Default Entry Value.
  *
@@ -436,6 +495,36 @@ void NT_SetEntryFlags(NT_Entry entry, unsigned int flags);
  */
 unsigned int NT_GetEntryFlags(NT_Entry entry);
 
+/**
+ * Set Entry Priority.  Local changes to a high priority entry are sent
+ * immediately rather than with the next periodic update, and changes to a
+ * low priority entry are sent less often than the update rate.
+ *
+ * @param entry     entry handle
+ * @param priority  priority (NT_EntryPriority)
+ */
+void NT_SetEntryPriority(NT_Entry entry, unsigned int priority);
+
+/**
+ * Get Entry Priority.
+ *
+ * @param entry     entry handle
+ * @return Priority (NT_EntryPriority)
+ */
+unsigned int NT_GetEntryPriority(NT_Entry entry);
+
+/**
+ * Set the priority of all existing and future entries whose names start
+ * with a prefix.  If several prefixes match an entry, the longest one wins.
+ *
+ * @param inst        instance handle
+ * @param prefix      entry name prefix
+ * @param prefix_len  length of prefix in bytes
+ * @param priority    priority (NT_EntryPriority)
+ */
+void NT_SetPrefixPriority(NT_Inst inst, const char* prefix, size_t prefix_len,
+                          unsigned int priority);
+
 /**
  * Delete Entry.
  *
@@ -635,6 +724,17 @@ struct NT_EntryNotification* NT_PollEntryListenerTimeout(
  */
 void NT_CancelPollEntryListener(NT_EntryListenerPoller poller);
 
+/**
+ * Bound a poller's event queue, so a poller that isn't polled often enough
+ * doesn't keep an ever-growing backlog.  Pollers are unbounded by default.
+ *
+ * @param poller    poller handle
+ * @param mode      queue mode (NT_PollerQueueMode)
+ * @param max_size  maximum number of queued events (ignored if unbounded)
+ */
+void NT_SetEntryListenerPollerQueue(NT_EntryListenerPoller poller,
+                                    unsigned int mode, size_t max_size);
+
 /**
  * Remove an entry listener.
  *
@@ -963,6 +1063,17 @@ char* NT_GetRpcResultTimeout(NT_Entry entry, NT_RpcCall call,
  */
 void NT_CancelRpcResult(NT_Entry entry, NT_RpcCall call);
 
+/**
+ * Sets the number of worker threads that run RPC callbacks.  With zero (the
+ * default), callbacks run one at a time on a single thread; otherwise up to
+ * this many calls are answered concurrently, so a callback must be thread
+ * safe.
+ *
+ * @param inst     instance handle
+ * @param count    number of worker threads
+ */
+void NT_SetRpcWorkerThreads(NT_Inst inst, unsigned int count);
+
 /**
  * Pack a RPC version 1 definition.
  *
@@ -1068,6 +1179,52 @@ void NT_StartServer(NT_Inst inst, const char* persist_filename,
  */
 void NT_StopServer(NT_Inst inst);
 
+/**
+ * Sets whether a server started with NT_StartServer() runs all client
+ * connections on a single event loop thread rather than on two threads per
+ * client.  Must be called before NT_StartServer() to take effect.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to use a single event loop thread
+ */
+void NT_SetServerEventLoop(NT_Inst inst, NT_Bool enabled);
+
+/**
+ * Sets whether network connections compress batches of messages.  A client
+ * with this enabled asks the server for compression when it connects; the
+ * server only agrees if it also has this enabled.  Peers that don't support
+ * compression are unaffected.  Takes effect on the next connection.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to compress
+ */
+void NT_SetNetworkCompression(NT_Inst inst, NT_Bool enabled);
+
+/**
+ * Sets whether network connections send updates to NT_UNRELIABLE entries as
+ * UDP datagrams, so a lost packet doesn't hold back later values the way a
+ * TCP retransmission does.  Late datagrams are dropped by sequence number.
+ * A client with this enabled asks the server for datagrams when it
+ * connects; the server (using the same port number) only agrees if it also
+ * has this enabled and isn't running the event loop server.  Assignments,
+ * flags and RPCs always use the TCP connection.  Takes effect when the
+ * server starts or on the next connection.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to use datagrams
+ */
+void NT_SetNetworkDatagrams(NT_Inst inst, NT_Bool enabled);
+
+/**
+ * Sets whether the server's periodic persistent saves write a binary journal
+ * of just the changed entries instead of rewriting the whole text file.  The
+ * journal is compacted automatically.  Either format is read at startup.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to save persistent values as a journal
+ */
+void NT_SetPersistentJournal(NT_Inst inst, NT_Bool enabled);
+
 /**
  * Starts a client.  Use NT_SetServer to set the server name and port.
  *
@@ -1207,6 +1364,17 @@ struct NT_ConnectionInfo* NT_GetConnections(NT_Inst inst, size_t* count);
  */
 NT_Bool NT_IsConnected(NT_Inst inst);
 
+/**
+ * Get the estimated offset of the server's clock from the local clock
+ * (server time minus local time, in microseconds).  A server always reports
+ * an offset of 0.
+ *
+ * @param inst    instance handle
+ * @param offset  the offset (output)
+ * @return False if the offset isn't known.
+ */
+NT_Bool NT_GetServerTimeOffset(NT_Inst inst, int64_t* offset);
+
 /** @} */
 
 /**
@@ -1266,6 +1434,23 @@ const char* NT_LoadEntries(NT_Inst inst, const char* filename,
                            const char* prefix, size_t prefix_len,
                            void (*warn)(size_t line, const char* msg));
 
+/**
+ * Starts logging every entry value set to a binary file.  See
+ * nt::StartDataLog() for details.
+ *
+ * @param inst      instance handle
+ * @param filename  filename
+ * @return error string, or NULL if successful
+ */
+const char* NT_StartDataLog(NT_Inst inst, const char* filename);
+
+/**
+ * Stops logging entry values, writing out anything buffered.
+ *
+ * @param inst  instance handle
+ */
+void NT_StopDataLog(NT_Inst inst);
+
 /** @} */
 
 /**
@@ -1280,6 +1465,14 @@ const char* NT_LoadEntries(NT_Inst inst, const char* filename,
  */
 void NT_DisposeValue(struct NT_Value* value);
 
+/**
+ * Frees an array of values.
+ *
+ * @param arr     pointer to the value array to free
+ * @param count   number of elements in the array
+ */
+void NT_DisposeValueArray(struct NT_Value* arr, size_t count);
+
 /**
  * Initializes a NT_Value.
  * Sets type to NT_UNASSIGNED and clears rest of struct.
@@ -20,6 +20,10 @@
 
 #include "networktables/NetworkTableValue.h"
 
+namespace wpi::log {
+class DataLog;
+}  // namespace wpi::log
+
 /** NetworkTables (ntcore) namespace */
 namespace nt {
 
@@ -194,7 +198,11 @@ class EntryNotification {
   /** Entry name. */
   std::string name;
 
-  /** The new value. */
+  /**
+   * The new value.  For a change received from a server and client that
+   * both support time synchronization, value->last_change() is the time the
+   * value was set by its publisher, in the local time base.
+   */
   std::shared_ptr<Value> value;
 
   /**
@@ -382,6 +390,59 @@ uint64_t GetEntryLastChange(NT_Entry entry);
  */
 std::shared_ptr<Value> GetEntryValue(NT_Entry entry);
 
+/**
+ * Get Entry Boolean Value.
+ *
+ * Unlike GetEntryValue(), this does not copy the shared entry value.
+ *
+ * @param entry       entry handle
+ * @param value       boolean value (output)
+ * @param last_change last change time (output; may be null)
+ * @return False if the entry does not exist or is not a boolean
+ */
+bool GetEntryBoolean(NT_Entry entry, bool* value,
+                     uint64_t* last_change = nullptr);
+
+/**
+ * Get Entry Double Value.
+ *
+ * Unlike GetEntryValue(), this does not copy the shared entry value.
+ *
+ * @param entry       entry handle
+ * @param value       double value (output)
+ * @param last_change last change time (output; may be null)
+ * @return False if the entry does not exist or is not a double
+ */
+bool GetEntryDouble(NT_Entry entry, double* value,
+                    uint64_t* last_change = nullptr);
+
+/**
+ * Set Entry History Depth.
+ *
+ * Starts (or stops) keeping the most recent values of an entry so they can be
+ * read back in bulk with GetEntryHistory().  Each distinct value is recorded
+ * along with its change time.  Changing the depth keeps the newest values.
+ *
+ * @param entry     entry handle
+ * @param depth     number of values to keep; 0 stops recording and discards
+ *                  the history
+ */
+void SetEntryHistoryDepth(NT_Entry entry, size_t depth);
+
+/**
+ * Get Entry History.
+ *
+ * Returns the recorded values of an entry that changed after a given time,
+ * oldest first.  The values may differ in type if the entry's type has
+ * changed.  Returns an empty vector if history is not enabled for the entry.
+ *
+ * @param entry     entry handle
+ * @param since     only return values with a later change time (0 for all)
+ * @return entry values
+ */
+std::vector<std::shared_ptr<Value>> GetEntryHistory(NT_Entry entry,
+                                                    uint64_t since = 0);
+
 /**
  * Set Default Entry Value
  *
@@ -407,6 +468,34 @@ bool SetDefaultEntryValue(NT_Entry entry, std::shared_ptr<Value> value);
  */
 bool SetEntryValue(NT_Entry entry, std::shared_ptr<Value> value);
 
+/**
+ * Set Entry Boolean Value.
+ *
+ * Equivalent to SetEntryValue() with a boolean value, but usually avoids
+ * allocating a new Value.
+ *
+ * @param entry     entry handle
+ * @param value     new entry value
+ * @param time      if nonzero, the change time to use (instead of the current
+ *                  time)
+ * @return False on error (type mismatch), True on success
+ */
+bool SetEntryBoolean(NT_Entry entry, bool value, uint64_t time = 0);
+
+/**
+ * Set Entry Double Value.
+ *
+ * Equivalent to SetEntryValue() with a double value, but usually avoids
+ * allocating a new Value.
+ *
+ * @param entry     entry handle
+ * @param value     new entry value
+ * @param time      if nonzero, the change time to use (instead of the current
+ *                  time)
+ * @return False on error (type mismatch), True on success
+ */
+bool SetEntryDouble(NT_Entry entry, double value, uint64_t time = 0);
+
 /**
  * Set Entry Type and Value.
  *
@@ -422,6 +511,85 @@ bool SetEntryValue(NT_Entry entry, std::shared_ptr<Value> value);
  */
 void SetEntryTypeValue(NT_Entry entry, std::shared_ptr<Value> value);
 
+/**
+ * Get Entry Values.
+ *
+ * Equivalent to calling GetEntryValue() for each entry.  All entries must be
+ * in the same instance.
+ *
+ * @param entries   entry handles
+ * @return entry values, in the same order as entries (nullptr for invalid
+ *         handles)
+ */
+std::vector<std::shared_ptr<Value>> GetEntryValues(
+    wpi::span<const NT_Entry> entries);
+
+/**
+ * Set Entry Values.
+ *
+ * Equivalent to calling SetEntryValue() for each entry and value pair, but
+ * takes the storage lock only once, and notifies listeners and queues the
+ * network messages for all the changes together.  All entries must be in the
+ * same instance; entries in other instances are ignored.
+ *
+ * @param entries   entry handles
+ * @param values    new entry values, one per entry (null values are skipped)
+ * @return False if any value had a type mismatch (those values are not set),
+ *         True otherwise
+ */
+bool SetEntryValues(wpi::span<const NT_Entry> entries,
+                    wpi::span<const std::shared_ptr<Value>> values);
+
+/**
+ * Publish Local Entry Value.
+ *
+ * Sets an entry value through the entry's in-process channel, for publishers
+ * whose readers are in the same process.  ReadLocalEntryValue() and
+ * WaitForLocalEntryValue() see the value immediately, without the storage
+ * lock or the listener threads.  The rest of NetworkTables (GetEntryValue(),
+ * listeners, and remote clients and servers) sees it after the next network
+ * update (see SetUpdateRate() and Flush()); if several values are published
+ * in between, only the latest is set.  If the network isn't running, the
+ * value is set immediately.
+ *
+ * @param entry     entry handle
+ * @param value     new entry value
+ * @return False on type mismatch, True otherwise
+ */
+bool PublishLocalEntryValue(NT_Entry entry, std::shared_ptr<Value> value);
+
+/**
+ * Read Local Entry Value.
+ *
+ * Reads an entry value through its in-process channel, which holds the value
+ * last set by PublishLocalEntryValue() or any other means.  This does not
+ * take a lock, so it is suitable for polling.
+ *
+ * @param entry     entry handle
+ * @param seq       sequence number of the last value read (0 initially);
+ *                  updated when a new value is returned
+ * @param value     entry value (output); null if the entry has no value
+ * @return False if the value has not changed since seq
+ */
+bool ReadLocalEntryValue(NT_Entry entry, uint64_t* seq,
+                         std::shared_ptr<Value>* value);
+
+/**
+ * Wait For Local Entry Value.
+ *
+ * Like ReadLocalEntryValue(), but blocks until the value changes from seq or
+ * the timeout expires.  The waiter is woken directly by the publisher.
+ *
+ * @param entry     entry handle
+ * @param seq       sequence number of the last value read (0 initially);
+ *                  updated when a new value is returned
+ * @param value     entry value (output); null if the entry has no value
+ * @param timeout   timeout, in seconds (negative to wait forever)
+ * @return False if the timeout expired or the instance is shutting down
+ */
+bool WaitForLocalEntryValue(NT_Entry entry, uint64_t* seq,
+                            std::shared_ptr<Value>* value, double timeout);
+
 /**
  * Set Entry Flags.
  *
@@ -438,6 +606,37 @@ void SetEntryFlags(NT_Entry entry, unsigned int flags);
  */
 unsigned int GetEntryFlags(NT_Entry entry);
 
+/**
+ * Set Entry Priority.  Local changes to a high priority entry are sent
+ * immediately rather than with the next periodic update, and changes to a
+ * low priority entry are sent less often than the update rate.  Priority is
+ * local to this instance; on a server it also applies when relaying client
+ * changes to other clients.
+ *
+ * @param entry     entry handle
+ * @param priority  priority (NT_EntryPriority)
+ */
+void SetEntryPriority(NT_Entry entry, unsigned int priority);
+
+/**
+ * Get Entry Priority.
+ *
+ * @param entry     entry handle
+ * @return Priority (NT_EntryPriority)
+ */
+unsigned int GetEntryPriority(NT_Entry entry);
+
+/**
+ * Set the priority of all existing and future entries whose names start
+ * with a prefix.  If several prefixes match an entry, the longest one wins.
+ *
+ * @param inst      instance handle
+ * @param prefix    entry name prefix
+ * @param priority  priority (NT_EntryPriority)
+ */
+void SetPrefixPriority(NT_Inst inst, std::string_view prefix,
+                       unsigned int priority);
+
 /**
  * Delete Entry.
  *
@@ -620,6 +819,30 @@ std::vector<EntryNotification> PollEntryListener(NT_EntryListenerPoller poller,
                                                  double timeout,
                                                  bool* timed_out);
 
+/**
+ * Get the next entry listener events, as PollEntryListener() does, into a
+ * caller-provided vector.  Its previous contents are replaced; reusing the
+ * same vector for every call avoids allocating once it has grown.
+ *
+ * @param poller      poller handle
+ * @param timeout     timeout, in seconds (negative to wait forever)
+ * @param timed_out   true if the timeout period elapsed (output)
+ * @param events      the entry listener events (output)
+ */
+void PollEntryListener(NT_EntryListenerPoller poller, double timeout,
+                       bool* timed_out, std::vector<EntryNotification>* events);
+
+/**
+ * Bound a poller's event queue, so a poller that isn't polled often enough
+ * doesn't keep an ever-growing backlog.  Pollers are unbounded by default.
+ *
+ * @param poller    poller handle
+ * @param mode      queue mode (NT_PollerQueueMode)
+ * @param max_size  maximum number of queued events (ignored if unbounded)
+ */
+void SetEntryListenerPollerQueue(NT_EntryListenerPoller poller,
+                                 unsigned int mode, size_t max_size);
+
 /**
  * Cancel a PollEntryListener call.  This wakes up a call to
  * PollEntryListener for this poller and causes it to immediately return
@@ -931,6 +1154,34 @@ bool GetRpcResult(NT_Entry entry, NT_RpcCall call, std::string* result,
  */
 void CancelRpcResult(NT_Entry entry, NT_RpcCall call);
 
+/**
+ * Get the results of several outstanding RPC calls to the same entry.  This
+ * function blocks until all of the results are received or it times out.
+ * If it fails, none of the results are consumed and each may still be
+ * retrieved with GetRpcResult() or ignored with CancelRpcResult().
+ *
+ * @param entry       entry handle of RPC entry
+ * @param calls       RPC call handles returned by CallRpc()
+ * @param results     received results, in the same order as calls (output)
+ * @param timeout     timeout, in seconds; negative to wait forever
+ * @param timed_out   true if the timeout period elapsed (output)
+ * @return False on error or timeout, true otherwise.
+ */
+bool GetRpcResults(NT_Entry entry, wpi::span<const NT_RpcCall> calls,
+                   std::vector<std::string>* results, double timeout,
+                   bool* timed_out);
+
+/**
+ * Sets the number of worker threads that run RPC callbacks.  With zero (the
+ * default), callbacks run one at a time on a single thread; otherwise up to
+ * this many calls are answered concurrently, so a callback must be thread
+ * safe.  May be called at any time; additional workers start as needed.
+ *
+ * @param inst     instance handle
+ * @param count    number of worker threads
+ */
+void SetRpcWorkerThreads(NT_Inst inst, unsigned int count);
+
 /**
  * Pack a RPC version 1 definition.
  *
@@ -1025,6 +1276,52 @@ void StartServer(NT_Inst inst, std::string_view persist_filename,
  */
 void StopServer(NT_Inst inst);
 
+/**
+ * Sets whether a server started with StartServer() runs all client
+ * connections on a single event loop thread rather than on two threads per
+ * client.  Must be called before StartServer() to take effect.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to use a single event loop thread
+ */
+void SetServerEventLoop(NT_Inst inst, bool enabled);
+
+/**
+ * Sets whether network connections compress batches of messages.  A client
+ * with this enabled asks the server for compression when it connects; the
+ * server only agrees if it also has this enabled.  Peers that don't support
+ * compression are unaffected.  Takes effect on the next connection.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to compress
+ */
+void SetNetworkCompression(NT_Inst inst, bool enabled);
+
+/**
+ * Sets whether network connections send updates to NT_UNRELIABLE entries as
+ * UDP datagrams, so a lost packet doesn't hold back later values the way a
+ * TCP retransmission does.  Late datagrams are dropped by sequence number.
+ * A client with this enabled asks the server for datagrams when it
+ * connects; the server (using the same port number) only agrees if it also
+ * has this enabled and isn't running the event loop server.  Assignments,
+ * flags and RPCs always use the TCP connection.  Takes effect when the
+ * server starts or on the next connection.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to use datagrams
+ */
+void SetNetworkDatagrams(NT_Inst inst, bool enabled);
+
+/**
+ * Sets whether the server's periodic persistent saves write a binary journal
+ * of just the changed entries instead of rewriting the whole text file.  The
+ * journal is compacted automatically.  Either format is read at startup.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to save persistent values as a journal
+ */
+void SetPersistentJournal(NT_Inst inst, bool enabled);
+
 /**
  * Starts a client.  Use SetServer to set the server name and port.
  *
@@ -1099,6 +1396,20 @@ void SetServer(
  */
 void SetServerTeam(NT_Inst inst, unsigned int team, unsigned int port);
 
+/**
+ * Sets the entry name prefixes a client subscribes to.  A server that
+ * supports subscriptions then only sends the entries matching one of them
+ * (and the ones this client creates), so a client that needs a small part
+ * of a large table only pays for that part.  Entries that stop matching are
+ * kept but no longer updated.  An empty list subscribes to everything, which
+ * is the default.
+ *
+ * @param inst      instance handle
+ * @param prefixes  entry name prefixes
+ */
+void SetClientSubscriptions(NT_Inst inst,
+                            wpi::span<const std::string_view> prefixes);
+
 /**
  * Starts requesting server address from Driver Station.
  * This connects to the Driver Station running on localhost to obtain the
@@ -1157,6 +1468,19 @@ std::vector<ConnectionInfo> GetConnections(NT_Inst inst);
  */
 bool IsConnected(NT_Inst inst);
 
+/**
+ * Get the estimated offset of the server's clock from the local clock
+ * (server time minus local time, in microseconds).  The estimate is
+ * refreshed periodically from exchanges with the server.  A server always
+ * reports an offset of 0.
+ *
+ * @param inst    instance handle
+ * @param offset  the offset (output)
+ * @return False if the offset isn't known (not connected, not yet estimated,
+ *         or the server doesn't support time synchronization).
+ */
+bool GetServerTimeOffset(NT_Inst inst, int64_t* offset);
+
 /** @} */
 
 /**
@@ -1215,6 +1539,41 @@ const char* LoadEntries(NT_Inst inst, std::string_view filename,
                         std::string_view prefix,
                         std::function<void(size_t line, const char* msg)> warn);
 
+/**
+ * Starts logging every entry value set to a binary file, replacing any
+ * existing file.  The log starts with the current values.  Values are
+ * buffered in memory and written by a background thread, so logging does
+ * not block the caller; if the writer falls behind, values are dropped.
+ * Any log already in progress is stopped first.
+ *
+ * @param inst      instance handle
+ * @param filename  filename
+ * @return error string, or nullptr if successful
+ */
+const char* StartDataLog(NT_Inst inst, std::string_view filename);
+
+/**
+ * Starts logging entry values to a data log.  Every value set for an entry
+ * whose name starts with prefix is appended to the log entry named logPrefix
+ * followed by the entry name, starting with the current values.  Any log
+ * already in progress is stopped first.
+ *
+ * @param inst      instance handle
+ * @param log       data log; must outlive the logging, until StopDataLog()
+ * @param prefix    only log entries whose names start with this prefix
+ * @param logPrefix prefix of the log entry names
+ */
+void StartDataLog(NT_Inst inst, wpi::log::DataLog& log,
+                  std::string_view prefix, std::string_view logPrefix);
+
+/**
+ * Stops logging entry values to a file or data log, writing out anything
+ * buffered.
+ *
+ * @param inst  instance handle
+ */
+void StopDataLog(NT_Inst inst);
+
 /** @} */
 
 /**
@@ -1231,6 +1590,18 @@ const char* LoadEntries(NT_Inst inst, std::string_view filename,
  */
 uint64_t Now();
 
+/**
+ * Publishes the lock statistics from wpi::GetLockStats() as entries under
+ * prefix/<lock name>/: acquisitions, contentions, maxWaitUs and maxHoldUs
+ * (doubles) and waitHistogram (a double array).  Locks are only
+ * instrumented in builds with WPI_INSTRUMENT_LOCKS; otherwise nothing is
+ * published.  Call periodically to update.
+ *
+ * @param inst   instance handle
+ * @param prefix entry name prefix
+ */
+void PublishLockStats(NT_Inst inst, std::string_view prefix = "/LockStats");
+
 /** @} */
 
 /**
@@ -0,0 +1,136 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <wpi/Logger.h>
+#include <wpi/raw_istream.h>
+
+#include "ArrayDeltaCodec.h"
+#include "TestPrinters.h"
+#include "ValueMatcher.h"
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+#include "gtest/gtest.h"
+
+namespace nt {
+
+class ArrayDeltaCodecTest : public ::testing::Test {
+ protected:
+  ArrayDeltaCodecTest() { sender.set_send_deltas(true); }
+
+  // Sends msg from sender to receiver; returns the message received.
+  std::shared_ptr<Message> Send(std::shared_ptr<Message> msg) {
+    WireEncoder e(0x0300u);
+    sender.Write(*msg, e);
+    last_size = e.size();
+    wpi::raw_mem_istream is(e.data(), e.size());
+    WireDecoder d(is, 0x0300u, logger);
+    auto received = Message::Read(d, [](unsigned int) { return NT_UNASSIGNED; });
+    if (!received) {
+      return nullptr;
+    }
+    last_type = received->type();
+    return receiver.Read(std::move(received));
+  }
+
+  wpi::Logger logger;
+  ArrayDeltaCodec sender;
+  ArrayDeltaCodec receiver;
+  size_t last_size = 0;
+  Message::MsgType last_type = Message::kUnknown;
+};
+
+TEST_F(ArrayDeltaCodecTest, DoubleArrayDelta) {
+  std::vector<double> v(30, 1.0);
+  auto msg = Send(Message::EntryAssign("foo", 5, 1, Value::MakeDoubleArray(v),
+                                       0));
+  ASSERT_TRUE(msg);
+  size_t full_size = last_size;
+
+  v[2] = 2.0;
+  v[20] = 3.0;
+  v[21] = 4.0;
+  auto value = Value::MakeDoubleArray(v);
+  msg = Send(Message::EntryUpdate(5, 2, value));
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(Message::kEntryArrayDelta, last_type);
+  EXPECT_LT(last_size, full_size / 4);
+  EXPECT_TRUE(msg->Is(Message::kEntryUpdate));
+  EXPECT_EQ(5u, msg->id());
+  EXPECT_EQ(2u, msg->seq_num_uid());
+  EXPECT_EQ(*value, *msg->value());
+
+  // the delta becomes the base for the next one
+  v[20] = 5.0;
+  value = Value::MakeDoubleArray(v);
+  msg = Send(Message::EntryUpdate(5, 3, value));
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(Message::kEntryArrayDelta, last_type);
+  EXPECT_EQ(*value, *msg->value());
+}
+
+TEST_F(ArrayDeltaCodecTest, StringArrayDelta) {
+  std::vector<std::string> v(10, "a fairly long string");
+  Send(Message::EntryAssign("foo", 1, 1, Value::MakeStringArray(v), 0));
+  v[9] = "changed";
+  auto value = Value::MakeStringArray(v);
+  auto msg = Send(Message::EntryUpdate(1, 2, value));
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(Message::kEntryArrayDelta, last_type);
+  EXPECT_EQ(*value, *msg->value());
+}
+
+TEST_F(ArrayDeltaCodecTest, FullUpdateWhenSizeChanges) {
+  Send(Message::EntryAssign("foo", 1, 1,
+                            Value::MakeDoubleArray({1.0, 2.0, 3.0}), 0));
+  auto value = Value::MakeDoubleArray({1.0, 2.0, 3.0, 4.0});
+  auto msg = Send(Message::EntryUpdate(1, 2, value));
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(Message::kEntryUpdate, last_type);
+  EXPECT_EQ(*value, *msg->value());
+}
+
+TEST_F(ArrayDeltaCodecTest, FullUpdateWhenAllChanged) {
+  Send(Message::EntryAssign("foo", 1, 1, Value::MakeBooleanArray({0, 0, 0}),
+                            0));
+  Send(Message::EntryUpdate(1, 2, Value::MakeBooleanArray({1, 1, 1})));
+  EXPECT_EQ(Message::kEntryUpdate, last_type);
+}
+
+TEST_F(ArrayDeltaCodecTest, NoDeltaUnlessEnabled) {
+  sender.set_send_deltas(false);
+  std::vector<double> v(30, 1.0);
+  Send(Message::EntryAssign("foo", 1, 1, Value::MakeDoubleArray(v), 0));
+  v[0] = 2.0;
+  Send(Message::EntryUpdate(1, 2, Value::MakeDoubleArray(v)));
+  EXPECT_EQ(Message::kEntryUpdate, last_type);
+}
+
+TEST_F(ArrayDeltaCodecTest, NoDeltaAfterDelete) {
+  std::vector<double> v(30, 1.0);
+  Send(Message::EntryAssign("foo", 1, 1, Value::MakeDoubleArray(v), 0));
+  Send(Message::EntryDelete(1));
+  v[0] = 2.0;
+  Send(Message::EntryUpdate(1, 2, Value::MakeDoubleArray(v)));
+  EXPECT_EQ(Message::kEntryUpdate, last_type);
+}
+
+TEST_F(ArrayDeltaCodecTest, DeltaWithoutBase) {
+  auto delta = Message::EntryArrayDelta(1, 2, std::string{0, 1},
+                                        Value::MakeDoubleArray({1.0}));
+  EXPECT_FALSE(receiver.Read(delta));
+}
+
+TEST_F(ArrayDeltaCodecTest, DeltaOutOfRange) {
+  receiver.Read(
+      Message::EntryAssign("foo", 1, 1, Value::MakeDoubleArray({1.0, 2.0}), 0));
+  auto delta = Message::EntryArrayDelta(1, 2, std::string{1, 2},
+                                        Value::MakeDoubleArray({3.0, 4.0}));
+  EXPECT_FALSE(receiver.Read(delta));
+}
+
+}  // namespace nt
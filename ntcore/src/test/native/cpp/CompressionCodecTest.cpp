@@ -0,0 +1,163 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <wpi/Logger.h>
+#include <wpi/SmallVector.h>
+#include <wpi/raw_istream.h>
+
+#include "CompressionCodec.h"
+#include "Lz4.h"
+#include "TestPrinters.h"
+#include "ValueMatcher.h"
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace nt {
+
+class CompressionCodecTest : public ::testing::Test {
+ protected:
+  CompressionCodecTest() { sender.set_compress(true); }
+
+  // Encodes msgs as one batch and decodes what was sent.
+  std::vector<std::shared_ptr<Message>> Send(
+      const std::vector<std::shared_ptr<Message>>& msgs) {
+    WireEncoder e(0x0300u);
+    for (auto& msg : msgs) {
+      msg->Write(e);
+    }
+    raw_size = e.size();
+    sender.Write(e);
+    sent_size = e.size();
+    wpi::raw_mem_istream is(e.data(), e.size());
+    WireDecoder d(is, 0x0300u, logger);
+    std::vector<std::shared_ptr<Message>> received;
+    while (is.in_avail() > 0) {
+      auto msg = Message::Read(d, get_entry_type);
+      if (!msg) {
+        ADD_FAILURE() << "read failed";
+        break;
+      }
+      if (!msg->Is(Message::kCompressed)) {
+        received.emplace_back(std::move(msg));
+      } else if (!CompressionCodec::Read(*msg, d, get_entry_type,
+                                         &received)) {
+        ADD_FAILURE() << "bad COMPRESSED message";
+      }
+    }
+    return received;
+  }
+
+  static std::string RoundTrip(std::string_view in) {
+    wpi::SmallVector<char, 256> compressed;
+    Lz4Compress(in, compressed);
+    std::string out;
+    EXPECT_TRUE(Lz4Decompress({compressed.data(), compressed.size()},
+                              in.size(), &out));
+    return out;
+  }
+
+  wpi::Logger logger;
+  Message::GetEntryTypeFunc get_entry_type = [](unsigned int) {
+    return NT_DOUBLE;
+  };
+  CompressionCodec sender;
+  size_t raw_size = 0;
+  size_t sent_size = 0;
+};
+
+TEST_F(CompressionCodecTest, Lz4RoundTrip) {
+  EXPECT_EQ("", RoundTrip(""));
+  EXPECT_EQ("short", RoundTrip("short"));
+  std::string repeated;
+  for (int i = 0; i < 1000; ++i) {
+    repeated += "/SmartDashboard/value" + std::to_string(i % 10);
+  }
+  EXPECT_EQ(repeated, RoundTrip(repeated));
+  // long runs and long literals both need extended lengths
+  EXPECT_EQ(std::string(5000, 'x'), RoundTrip(std::string(5000, 'x')));
+  std::mt19937 gen(42);
+  std::string random(5000, '\0');
+  for (auto& c : random) {
+    c = static_cast<char>(gen());
+  }
+  EXPECT_EQ(random, RoundTrip(random));
+}
+
+TEST_F(CompressionCodecTest, Lz4Malformed) {
+  std::string in(300, 'a');
+  wpi::SmallVector<char, 256> compressed;
+  Lz4Compress(in, compressed);
+  std::string_view block{compressed.data(), compressed.size()};
+  std::string out;
+  EXPECT_FALSE(Lz4Decompress(block, in.size() - 1, &out));
+  out.clear();
+  EXPECT_FALSE(Lz4Decompress(block, in.size() + 1, &out));
+  out.clear();
+  EXPECT_FALSE(Lz4Decompress(block.substr(0, block.size() - 1), in.size(),
+                             &out));
+  // match offset before the start of the output
+  out.clear();
+  EXPECT_FALSE(Lz4Decompress({"\x10" "a\x05\x00", 4}, 10, &out));
+}
+
+TEST_F(CompressionCodecTest, CompressesLargeBatch) {
+  std::vector<std::shared_ptr<Message>> msgs;
+  for (unsigned int i = 0; i < 100; ++i) {
+    msgs.emplace_back(Message::EntryAssign(
+        "/SmartDashboard/Drivetrain/value" + std::to_string(i), i, 1,
+        Value::MakeDouble(i), 0));
+  }
+  auto received = Send(msgs);
+  EXPECT_LT(sent_size, raw_size / 2);
+  ASSERT_EQ(msgs.size(), received.size());
+  for (size_t i = 0; i < msgs.size(); ++i) {
+    EXPECT_EQ(msgs[i]->str(), received[i]->str());
+    EXPECT_EQ(msgs[i]->id(), received[i]->id());
+    EXPECT_THAT(received[i]->value(), ValueEq(msgs[i]->value()));
+  }
+}
+
+TEST_F(CompressionCodecTest, SmallBatchUncompressed) {
+  auto received = Send({Message::EntryUpdate(1, 2, Value::MakeDouble(1.0))});
+  EXPECT_EQ(raw_size, sent_size);
+  ASSERT_EQ(1u, received.size());
+  EXPECT_TRUE(received[0]->Is(Message::kEntryUpdate));
+}
+
+TEST_F(CompressionCodecTest, Disabled) {
+  sender.set_compress(false);
+  std::vector<std::shared_ptr<Message>> msgs(
+      50, Message::EntryUpdate(1, 2, Value::MakeDouble(1.0)));
+  auto received = Send(msgs);
+  EXPECT_EQ(raw_size, sent_size);
+  EXPECT_EQ(msgs.size(), received.size());
+}
+
+TEST_F(CompressionCodecTest, IncompressibleBacksOff) {
+  std::mt19937 gen(1);
+  std::string random(1000, '\0');
+  for (auto& c : random) {
+    c = static_cast<char>(gen());
+  }
+  auto msg = Message::EntryAssign("foo", 1, 1, Value::MakeRaw(random), 0);
+  auto received = Send({msg});
+  EXPECT_EQ(raw_size, sent_size);
+  ASSERT_EQ(1u, received.size());
+  EXPECT_EQ(random, received[0]->value()->GetRaw());
+
+  // a compressible batch right after isn't tried
+  std::vector<std::shared_ptr<Message>> msgs(
+      50, Message::EntryUpdate(1, 2, Value::MakeDouble(1.0)));
+  Send(msgs);
+  EXPECT_EQ(raw_size, sent_size);
+}
+
+}  // namespace nt
@@ -104,3 +104,23 @@ TEST_F(ConnectionListenerTest, Threaded) {
   EXPECT_EQ(handle, result[0].listener);
   EXPECT_FALSE(result[0].connected);
 }
+
+TEST_F(ConnectionListenerTest, RemoteIdIsIdentity) {
+  // the server sees the identity as is, also when the client reconnects and
+  // resumes its session (sending hello flags after the identity)
+  for (int i = 0; i < 2; ++i) {
+    if (i == 0) {
+      Connect();
+    } else {
+      nt::StopClient(client_inst);
+      nt::StartClient(client_inst, "127.0.0.1", 10000);
+      while ((nt::GetNetworkMode(client_inst) & NT_NET_MODE_STARTING) != 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    auto conns = nt::GetConnections(server_inst);
+    ASSERT_EQ(conns.size(), 1u);
+    EXPECT_EQ(conns[0].remote_id, "client");
+  }
+}
@@ -0,0 +1,170 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <wpi/DataLog.h>
+#include <wpi/DataLogReader.h>
+#include <wpi/Logger.h>
+#include <wpi/fs.h>
+#include <wpi/raw_istream.h>
+
+#include "DataLogger.h"
+#include "TestPrinters.h"
+#include "ValueMatcher.h"
+#include "WireDecoder.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace nt {
+
+class DataLoggerTest : public ::testing::Test {
+ protected:
+  DataLoggerTest()
+      : filename((fs::temp_directory_path() / "ntcore_datalogger_test.bin")
+                     .string()) {}
+  ~DataLoggerTest() override { std::remove(filename.c_str()); }
+
+  struct Record {
+    unsigned int type;
+    uint64_t id;
+    std::string name;
+    uint64_t time;
+    std::shared_ptr<Value> value;
+  };
+
+  // Reads back the records in the log file.
+  std::vector<Record> ReadLog() {
+    std::vector<Record> records;
+    std::error_code ec;
+    wpi::raw_fd_istream is(filename, ec);
+    EXPECT_FALSE(ec);
+    WireDecoder d(is, 0x0300u, logger);
+    const char* header;
+    EXPECT_TRUE(d.Read(&header, 4));
+    EXPECT_EQ(std::string(DataLogger::kHeader), std::string(header, 4));
+    uint32_t start_hi, start_lo;
+    EXPECT_TRUE(d.Read32(&start_hi));
+    EXPECT_TRUE(d.Read32(&start_lo));
+    uint64_t len;
+    while (d.ReadUleb128(&len)) {
+      Record rec;
+      EXPECT_TRUE(d.Read8(&rec.type));
+      EXPECT_TRUE(d.ReadUleb128(&rec.id));
+      if (rec.type == DataLogger::kStart) {
+        EXPECT_TRUE(d.ReadString(&rec.name));
+      } else {
+        EXPECT_EQ(DataLogger::kValue, rec.type);
+        NT_Type type;
+        EXPECT_TRUE(d.ReadUleb128(&rec.time));
+        EXPECT_TRUE(d.ReadType(&type));
+        rec.value = d.ReadUnboundedValue(type);
+      }
+      records.emplace_back(std::move(rec));
+    }
+    return records;
+  }
+
+  wpi::Logger logger;
+  std::string filename;
+};
+
+TEST_F(DataLoggerTest, StartRecordOnce) {
+  DataLogger log(logger);
+  ASSERT_EQ(nullptr, log.Start(filename));
+  log.Append(3, "foo", *Value::MakeDouble(1.0));
+  log.Append(3, "foo", *Value::MakeDouble(2.0));
+  log.Append(1, "bar", *Value::MakeString("baz"));
+  log.Stop();
+  EXPECT_EQ(0u, log.dropped());
+
+  auto records = ReadLog();
+  ASSERT_EQ(5u, records.size());
+  EXPECT_EQ(DataLogger::kStart, records[0].type);
+  EXPECT_EQ(3u, records[0].id);
+  EXPECT_EQ("foo", records[0].name);
+  EXPECT_EQ(DataLogger::kValue, records[1].type);
+  EXPECT_THAT(records[1].value, ValueEq(Value::MakeDouble(1.0)));
+  EXPECT_THAT(records[2].value, ValueEq(Value::MakeDouble(2.0)));
+  EXPECT_EQ(DataLogger::kStart, records[3].type);
+  EXPECT_EQ("bar", records[3].name);
+  EXPECT_EQ(1u, records[4].id);
+  EXPECT_THAT(records[4].value, ValueEq(Value::MakeString("baz")));
+}
+
+TEST_F(DataLoggerTest, LargeArray) {
+  DataLogger log(logger);
+  ASSERT_EQ(nullptr, log.Start(filename));
+  std::vector<double> arr(1000, 0.5);
+  log.Append(0, "arr", *Value::MakeDoubleArray(arr));
+  log.Stop();
+
+  auto records = ReadLog();
+  ASSERT_EQ(2u, records.size());
+  EXPECT_THAT(records[1].value, ValueEq(Value::MakeDoubleArray(arr)));
+}
+
+TEST_F(DataLoggerTest, RpcNotLogged) {
+  DataLogger log(logger);
+  ASSERT_EQ(nullptr, log.Start(filename));
+  log.Append(0, "rpc", *Value::MakeRpc("def"));
+  log.Stop();
+
+  EXPECT_TRUE(ReadLog().empty());
+}
+
+TEST_F(DataLoggerTest, DropWhenFull) {
+  DataLogger log(logger);
+  // too small for even one record
+  ASSERT_EQ(nullptr, log.Start(filename, 4));
+  log.Append(0, "foo", *Value::MakeDouble(1.0));
+  log.Stop();
+  EXPECT_EQ(1u, log.dropped());
+
+  EXPECT_TRUE(ReadLog().empty());
+}
+
+TEST(EntryLogSinkTest, PrefixAndTypes) {
+  std::vector<uint8_t> data;
+  {
+    wpi::log::DataLog log{[&](wpi::span<const uint8_t> block) {
+      data.insert(data.end(), block.begin(), block.end());
+    }};
+    EntryLogSink sink{log, "/a/", "NT:"};
+    sink.Append(0, "/a/x", *Value::MakeDouble(1.0, 10));
+    sink.Append(1, "/b/y", *Value::MakeDouble(2.0, 20));
+    sink.Append(0, "/a/x", *Value::MakeDouble(3.0, 30));
+    sink.Append(2, "/a/rpc", *Value::MakeRpc("def", 40));
+    // a type change restarts the log entry
+    sink.Append(0, "/a/x", *Value::MakeString("s", 50));
+  }
+
+  wpi::log::DataLogReader reader{data};
+  std::vector<wpi::log::DataLogRecord> records{reader.begin(), reader.end()};
+  ASSERT_EQ(7u, records.size());
+  wpi::log::StartRecordData start;
+  ASSERT_TRUE(records[0].GetStartData(&start));
+  EXPECT_EQ("NT:/a/x", start.name);
+  EXPECT_EQ("double", start.type);
+  double value;
+  ASSERT_TRUE(records[1].GetDouble(&value));
+  EXPECT_EQ(1.0, value);
+  EXPECT_EQ(10, records[1].GetTimestamp());
+  ASSERT_TRUE(records[2].GetDouble(&value));
+  EXPECT_EQ(3.0, value);
+  EXPECT_TRUE(records[3].IsFinish());
+  ASSERT_TRUE(records[4].GetStartData(&start));
+  EXPECT_EQ("NT:/a/x", start.name);
+  EXPECT_EQ("string", start.type);
+  std::string_view str;
+  ASSERT_TRUE(records[5].GetString(&str));
+  EXPECT_EQ("s", str);
+  EXPECT_TRUE(records[6].IsFinish());
+}
+
+}  // namespace nt
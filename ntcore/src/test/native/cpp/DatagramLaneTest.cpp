@@ -0,0 +1,149 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <wpi/Logger.h>
+#include <wpi/raw_istream.h>
+
+#include "DatagramLane.h"
+#include "Message.h"
+#include "ValueMatcher.h"
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+#include "gtest/gtest.h"
+#include "ntcore_cpp.h"
+
+namespace nt {
+
+TEST(DatagramLaneTest, DatagramLaneMessage) {
+  wpi::Logger logger;
+  WireEncoder e(0x0300u);
+  Message::DatagramLane(0xdeadbeef)->Write(e);
+  wpi::raw_mem_istream is(e.data(), e.size());
+  WireDecoder d(is, 0x0300u, logger);
+  auto msg = Message::Read(d, [](unsigned int) { return NT_UNASSIGNED; });
+  ASSERT_TRUE(msg);
+  ASSERT_TRUE(msg->Is(Message::kDatagramLane));
+  EXPECT_EQ(msg->id(), 0xdeadbeefu);
+}
+
+TEST(DatagramLaneTest, Track) {
+  DatagramLane lane;
+  auto value = Value::MakeDouble(1);
+  auto update = Message::EntryUpdate(5, 2, value);
+  EXPECT_FALSE(lane.IsLossy(*update));
+
+  lane.Track(*Message::EntryAssign("/a", 5, 1, value, NT_UNRELIABLE));
+  EXPECT_TRUE(lane.IsLossy(*update));
+  // only updates go by datagram
+  EXPECT_FALSE(lane.IsLossy(*Message::FlagsUpdate(5, NT_UNRELIABLE)));
+  EXPECT_FALSE(lane.IsLossy(*Message::EntryUpdate(6, 2, value)));
+
+  lane.Track(*Message::FlagsUpdate(5, NT_PERSISTENT));
+  EXPECT_FALSE(lane.IsLossy(*update));
+}
+
+TEST(DatagramLaneTest, EncodeDecode) {
+  wpi::Logger logger;
+  std::vector<std::shared_ptr<Message>> msgs{
+      Message::EntryUpdate(1, 5, Value::MakeDouble(1)), nullptr,
+      Message::EntryUpdate(2, 7, Value::MakeString("x"))};
+  std::vector<std::string> datagrams;
+  std::vector<std::shared_ptr<Message>> oversize;
+  DatagramLane::Encode(42, msgs, &datagrams, &oversize);
+  ASSERT_EQ(datagrams.size(), 1u);
+  EXPECT_TRUE(oversize.empty());
+
+  uint32_t token = 0;
+  ASSERT_TRUE(DatagramLane::GetToken(datagrams[0], &token));
+  EXPECT_EQ(token, 42u);
+
+  DatagramLane lane;
+  std::vector<std::shared_ptr<Message>> decoded;
+  ASSERT_TRUE(lane.Decode(datagrams[0], logger, &decoded));
+  ASSERT_EQ(decoded.size(), 2u);
+  EXPECT_EQ(decoded[0]->id(), 1u);
+  EXPECT_EQ(decoded[0]->seq_num_uid(), 5u);
+  EXPECT_THAT(decoded[0]->value(), ValueEq(Value::MakeDouble(1)));
+  EXPECT_EQ(decoded[1]->id(), 2u);
+  EXPECT_THAT(decoded[1]->value(), ValueEq(Value::MakeString("x")));
+
+  // late and duplicated datagrams are dropped
+  decoded.clear();
+  ASSERT_TRUE(lane.Decode(datagrams[0], logger, &decoded));
+  EXPECT_TRUE(decoded.empty());
+  msgs = {Message::EntryUpdate(1, 4, Value::MakeDouble(0)),
+          Message::EntryUpdate(2, 8, Value::MakeString("y"))};
+  datagrams.clear();
+  DatagramLane::Encode(42, msgs, &datagrams, &oversize);
+  ASSERT_TRUE(lane.Decode(datagrams[0], logger, &decoded));
+  ASSERT_EQ(decoded.size(), 1u);
+  EXPECT_EQ(decoded[0]->id(), 2u);
+
+  // only updates are accepted
+  datagrams.clear();
+  msgs = {Message::FlagsUpdate(1, 0)};
+  DatagramLane::Encode(42, msgs, &datagrams, &oversize);
+  EXPECT_FALSE(lane.Decode(datagrams[0], logger, &decoded));
+}
+
+TEST(DatagramLaneTest, EncodeSplits) {
+  std::string big(DatagramLane::kMaxDatagramSize, 'x');
+  std::string half(DatagramLane::kMaxDatagramSize / 2, 'x');
+  std::vector<std::shared_ptr<Message>> msgs{
+      Message::EntryUpdate(1, 1, Value::MakeString(half)),
+      Message::EntryUpdate(2, 1, Value::MakeString(big)),
+      Message::EntryUpdate(3, 1, Value::MakeString(half))};
+  std::vector<std::string> datagrams;
+  std::vector<std::shared_ptr<Message>> oversize;
+  DatagramLane::Encode(1, msgs, &datagrams, &oversize);
+  ASSERT_EQ(datagrams.size(), 2u);
+  for (auto& datagram : datagrams) {
+    EXPECT_LE(datagram.size(), DatagramLane::kMaxDatagramSize);
+  }
+  ASSERT_EQ(oversize.size(), 1u);
+  EXPECT_EQ(oversize[0], msgs[1]);
+}
+
+TEST(DatagramLaneTest, ClientToServer) {
+  auto server_inst = CreateInstance();
+  auto client_inst = CreateInstance();
+  SetNetworkDatagrams(server_inst, true);
+  SetNetworkDatagrams(client_inst, true);
+  auto client_entry = GetEntry(client_inst, "/fast");
+  SetEntryValue(client_entry, Value::MakeDouble(1));
+  SetEntryFlags(client_entry, NT_UNRELIABLE);
+
+  StartServer(server_inst, "datagramlanetest.ini", "127.0.0.1", 10020);
+  StartClient(client_inst, "127.0.0.1", 10020);
+  auto poller = CreateConnectionListenerPoller(server_inst);
+  AddPolledConnectionListener(poller, false);
+  bool timed_out = false;
+  ASSERT_FALSE(PollConnectionListener(poller, 1.0, &timed_out).empty());
+
+  auto server_entry = GetEntry(server_inst, "/fast");
+  EXPECT_EQ(GetEntryFlags(server_entry), NT_UNRELIABLE);
+  SetEntryValue(client_entry, Value::MakeDouble(2));
+  Flush(client_inst);
+  std::shared_ptr<Value> value;
+  for (int i = 0; i < 100; ++i) {
+    value = GetEntryValue(server_entry);
+    if (value && value->IsDouble() && value->GetDouble() == 2) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_THAT(value, ValueEq(Value::MakeDouble(2)));
+
+  DestroyConnectionListenerPoller(poller);
+  DestroyInstance(client_inst);
+  DestroyInstance(server_inst);
+}
+
+}  // namespace nt
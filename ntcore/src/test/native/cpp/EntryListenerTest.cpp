@@ -163,3 +163,145 @@ TEST_F(EntryListenerTest, DISABLED_PrefixNewRemote) {
   ASSERT_THAT(events[0].value, nt::ValueEq(nt::Value::MakeDouble(1.0)));
   ASSERT_EQ(events[0].flags, NT_NOTIFY_NEW);
 }
+
+TEST_F(EntryListenerTest, PollerDropOldest) {
+  auto poller = nt::CreateEntryListenerPoller(server_inst);
+  nt::SetEntryListenerPollerQueue(poller, NT_POLLER_QUEUE_DROP_OLDEST, 3);
+  auto entry = nt::GetEntry(server_inst, "/foo");
+  nt::AddPolledEntryListener(
+      poller, entry, NT_NOTIFY_NEW | NT_NOTIFY_UPDATE | NT_NOTIFY_LOCAL);
+  for (int i = 0; i < 10; ++i) {
+    nt::SetEntryValue(entry, nt::Value::MakeDouble(i));
+  }
+  ASSERT_TRUE(nt::WaitForEntryListenerQueue(server_inst, 1.0));
+
+  std::vector<nt::EntryNotification> events;
+  bool timed_out = false;
+  nt::PollEntryListener(poller, 0, &timed_out, &events);
+  ASSERT_FALSE(timed_out);
+  ASSERT_EQ(events.size(), 3u);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_THAT(events[i].value, nt::ValueEq(nt::Value::MakeDouble(7 + i)));
+  }
+
+  // an empty queue times out and clears the output
+  nt::PollEntryListener(poller, 0, &timed_out, &events);
+  ASSERT_TRUE(timed_out);
+  ASSERT_TRUE(events.empty());
+  nt::DestroyEntryListenerPoller(poller);
+}
+
+TEST_F(EntryListenerTest, PollerCoalesce) {
+  auto poller = nt::CreateEntryListenerPoller(server_inst);
+  nt::SetEntryListenerPollerQueue(poller, NT_POLLER_QUEUE_COALESCE, 16);
+  auto foo = nt::GetEntry(server_inst, "/foo");
+  auto bar = nt::GetEntry(server_inst, "/bar");
+  nt::AddPolledEntryListener(poller, "/",
+                             NT_NOTIFY_NEW | NT_NOTIFY_UPDATE |
+                                 NT_NOTIFY_DELETE | NT_NOTIFY_LOCAL);
+  for (int i = 0; i < 10; ++i) {
+    nt::SetEntryValue(foo, nt::Value::MakeDouble(i));
+    nt::SetEntryValue(bar, nt::Value::MakeDouble(-i));
+  }
+  nt::DeleteEntry(bar);
+  ASSERT_TRUE(nt::WaitForEntryListenerQueue(server_inst, 1.0));
+
+  bool timed_out = false;
+  auto events = nt::PollEntryListener(poller, 0, &timed_out);
+  ASSERT_EQ(events.size(), 3u);
+  ASSERT_EQ(events[0].entry, foo);
+  ASSERT_THAT(events[0].value, nt::ValueEq(nt::Value::MakeDouble(9)));
+  ASSERT_EQ(events[0].flags,
+            (unsigned int)(NT_NOTIFY_NEW | NT_NOTIFY_UPDATE | NT_NOTIFY_LOCAL));
+  ASSERT_EQ(events[1].entry, bar);
+  ASSERT_THAT(events[1].value, nt::ValueEq(nt::Value::MakeDouble(-9)));
+  ASSERT_EQ(events[2].entry, bar);
+  ASSERT_EQ(events[2].flags,
+            (unsigned int)(NT_NOTIFY_DELETE | NT_NOTIFY_LOCAL));
+  nt::DestroyEntryListenerPoller(poller);
+}
+
+TEST_F(EntryListenerTest, UpdatesCoalesced) {
+  // a long update period, so only Flush() sends the updates
+  nt::SetUpdateRate(server_inst, 1.0);
+  auto server_entry = nt::GetEntry(server_inst, "/foo");
+  nt::SetEntryValue(server_entry, nt::Value::MakeDouble(0));
+  Connect();
+  if (HasFatalFailure()) {
+    return;
+  }
+  auto poller = nt::CreateEntryListenerPoller(client_inst);
+  nt::AddPolledEntryListener(poller, nt::GetEntry(client_inst, "/foo"),
+                             NT_NOTIFY_UPDATE);
+
+  // several updates within one period go out as one ENTRY_UPDATE carrying
+  // the latest value
+  for (int i = 1; i <= 3; ++i) {
+    nt::SetEntryValue(server_entry, nt::Value::MakeDouble(i));
+  }
+  nt::Flush(server_inst);
+
+  bool timed_out = false;
+  auto events = nt::PollEntryListener(poller, 2.0, &timed_out);
+  ASSERT_FALSE(timed_out);
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_THAT(events[0].value, nt::ValueEq(nt::Value::MakeDouble(3)));
+  events = nt::PollEntryListener(poller, 0.2, &timed_out);
+  ASSERT_TRUE(timed_out);
+  nt::DestroyEntryListenerPoller(poller);
+}
+
+TEST_F(EntryListenerTest, LowPriorityDroppedOnReconnect) {
+  // a second server, started once the client is connected to the first
+  auto other_inst = nt::CreateInstance();
+  nt::SetNetworkIdentity(other_inst, "other");
+  auto other_b = nt::GetEntry(other_inst, "/b");
+  nt::SetEntryValue(other_b, nt::Value::MakeDouble(1));
+
+  // the first server assigns /a id 0, and the second assigns /b id 0
+  auto server_a = nt::GetEntry(server_inst, "/a");
+  nt::SetEntryValue(server_a, nt::Value::MakeDouble(0));
+  nt::StartServer(server_inst, "entrylistenertest.ini", "127.0.0.1", 10000);
+  auto poller = nt::CreateConnectionListenerPoller(server_inst);
+  nt::AddPolledConnectionListener(poller, false);
+  nt::SetUpdateRate(client_inst, 0.5);
+  std::pair<std::string_view, unsigned int> servers[] = {{"127.0.0.1", 10000},
+                                                         {"127.0.0.1", 10010}};
+  nt::StartClient(client_inst, servers);
+  bool timed_out = false;
+  ASSERT_FALSE(nt::PollConnectionListener(poller, 1.0, &timed_out).empty());
+  nt::DestroyConnectionListenerPoller(poller);
+  nt::StartServer(other_inst, "entrylistenertest2.ini", "127.0.0.1", 10010);
+  poller = nt::CreateConnectionListenerPoller(other_inst);
+  nt::AddPolledConnectionListener(poller, false);
+
+  // wait for a low priority update to arrive, so the next one is held for
+  // several update periods
+  auto client_entry = nt::GetEntry(client_inst, "/a");
+  nt::SetEntryPriority(client_entry, NT_PRIORITY_LOW);
+  nt::SetEntryValue(client_entry, nt::Value::MakeDouble(1));
+  for (int i = 0; i < 50; ++i) {
+    auto value = nt::GetEntryValue(server_a);
+    if (value && value->GetDouble() == 1) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_THAT(nt::GetEntryValue(server_a),
+              nt::ValueEq(nt::Value::MakeDouble(1)));
+
+  // the client moves to the second server with that update still pending
+  // under /a's old id
+  nt::SetEntryValue(client_entry, nt::Value::MakeDouble(2));
+  nt::StopServer(server_inst);
+  ASSERT_FALSE(nt::PollConnectionListener(poller, 2.0, &timed_out).empty());
+
+  // /a gets a new id; the stale update must not be applied to /b
+  std::this_thread::sleep_for(std::chrono::milliseconds(3000));
+  EXPECT_THAT(nt::GetEntryValue(nt::GetEntry(other_inst, "/a")),
+              nt::ValueEq(nt::Value::MakeDouble(2)));
+  EXPECT_THAT(nt::GetEntryValue(other_b),
+              nt::ValueEq(nt::Value::MakeDouble(1)));
+  nt::DestroyConnectionListenerPoller(poller);
+  nt::DestroyInstance(other_inst);
+}
@@ -309,4 +309,46 @@ TEST_F(EntryNotifierTest, PollPrefixLocal) {
   ASSERT_EQ(results.size(), 6u);
 }
 
+TEST_F(EntryNotifierTest, PollPrefixNested) {
+  auto poller = notifier.CreatePoller();
+  auto h1 = notifier.AddPolled(poller, "", NT_NOTIFY_NEW);
+  auto h2 = notifier.AddPolled(poller, "/foo", NT_NOTIFY_NEW);
+  auto h3 = notifier.AddPolled(poller, "/foo/bar", NT_NOTIFY_NEW);
+  auto h4 = notifier.AddPolled(poller, "/foo/baz", NT_NOTIFY_NEW);
+  auto h5 = notifier.AddPolled(poller, "/b", NT_NOTIFY_NEW);
+  notifier.Remove(h5);
+
+  GenerateNotifications();
+
+  ASSERT_TRUE(notifier.WaitForQueue(1.0));
+  bool timed_out = false;
+  auto results = notifier.Poll(poller, 0, &timed_out);
+  ASSERT_FALSE(timed_out);
+  SCOPED_TRACE(::testing::PrintToString(results));
+
+  // "/foo/bar" matches h1, h2, h3; "/baz" and "/boo" match only h1
+  int h1count = 0;
+  int h2count = 0;
+  int h3count = 0;
+  for (const auto& result : results) {
+    auto index = Handle{result.listener}.GetIndex();
+    if (index == static_cast<int>(h1)) {
+      ++h1count;
+    } else if (index == static_cast<int>(h2)) {
+      ++h2count;
+      EXPECT_EQ(result.name, "/foo/bar");
+    } else if (index == static_cast<int>(h3)) {
+      ++h3count;
+      EXPECT_EQ(result.name, "/foo/bar");
+    } else if (index == static_cast<int>(h4)) {
+      ADD_FAILURE() << "non-matching prefix notified";
+    } else {
+      ADD_FAILURE() << "removed or unknown listener notified";
+    }
+  }
+  EXPECT_EQ(h1count, 6);
+  EXPECT_EQ(h2count, 2);
+  EXPECT_EQ(h3count, 2);
+}
+
 }  // namespace nt
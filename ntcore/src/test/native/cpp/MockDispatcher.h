@@ -17,6 +17,9 @@ class MockDispatcher : public IDispatcher {
   MOCK_METHOD3(QueueOutgoing,
                void(std::shared_ptr<Message> msg, INetworkConnection* only,
                     INetworkConnection* except));
+  MOCK_METHOD0(FlushOutgoing, void());
+  MOCK_METHOD0(ClearPendingUpdates, void());
+  MOCK_METHOD1(ClearPendingUpdate, void(unsigned int id));
 };
 
 }  // namespace nt
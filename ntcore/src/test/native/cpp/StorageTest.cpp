@@ -4,6 +4,9 @@
 
 #include "StorageTest.h"
 
+#include <chrono>
+#include <thread>
+
 #include <wpi/SmallString.h>
 #include <wpi/StringExtras.h>
 #include <wpi/raw_istream.h>
@@ -19,6 +22,7 @@
 
 using ::testing::_;
 using ::testing::AnyNumber;
+using ::testing::ElementsAre;
 using ::testing::IsNull;
 using ::testing::Return;
 
@@ -299,6 +303,203 @@ TEST_P(StorageTestPopulated, SetEntryValueDifferentValue) {
   }
 }
 
+TEST_P(StorageTestPopulated, SetEntryValues) {
+  // only changed values are notified and sent; mismatched types aren't set
+  auto value = Value::MakeDouble(1.0);
+  if (GetParam()) {
+    EXPECT_CALL(dispatcher,
+                QueueOutgoing(MessageEq(Message::EntryUpdate(1, 2, value)),
+                              IsNull(), IsNull()));
+  }
+  EXPECT_CALL(notifier,
+              NotifyEntry(1, std::string_view("foo2"), value,
+                          NT_NOTIFY_UPDATE | NT_NOTIFY_LOCAL, UINT_MAX));
+
+  unsigned int ids[] = {1, 2, 3, 100};
+  std::shared_ptr<Value> values[] = {value, Value::MakeDouble(1.0),
+                                     Value::MakeString("x"),
+                                     Value::MakeDouble(2.0)};
+  EXPECT_FALSE(storage.SetEntryValues(ids, values));
+  EXPECT_EQ(value, GetEntry("foo2")->value);
+  EXPECT_EQ(*Value::MakeBoolean(false), *GetEntry("bar2")->value);
+
+  std::vector<std::shared_ptr<Value>> got;
+  storage.GetEntryValues(ids, &got);
+  ASSERT_EQ(4u, got.size());
+  EXPECT_EQ(*value, *got[0]);
+  EXPECT_EQ(*Value::MakeBoolean(false), *got[2]);
+  EXPECT_FALSE(got[3]);
+}
+
+TEST_P(StorageTestPopulated, PublishLocalEntryValue) {
+  // published values are read back at once, and set when mirrored
+  storage.SetPeriodicMirror(true);
+  uint64_t seq = 0;
+  std::shared_ptr<Value> got;
+  ASSERT_TRUE(storage.ReadLocalEntryValue(1, &seq, &got));
+  EXPECT_EQ(GetEntry("foo2")->value, got);
+  EXPECT_FALSE(storage.ReadLocalEntryValue(1, &seq, &got));
+
+  auto value = Value::MakeDouble(1.0);
+  EXPECT_TRUE(storage.PublishLocalEntryValue(1, Value::MakeDouble(0.5)));
+  EXPECT_TRUE(storage.PublishLocalEntryValue(1, value));
+  EXPECT_FALSE(storage.PublishLocalEntryValue(1, Value::MakeString("x")));
+  ASSERT_TRUE(storage.ReadLocalEntryValue(1, &seq, &got));
+  EXPECT_EQ(value, got);
+  EXPECT_EQ(*Value::MakeDouble(0.0), *GetEntry("foo2")->value);
+
+  // only the latest value is set
+  if (GetParam()) {
+    EXPECT_CALL(dispatcher,
+                QueueOutgoing(MessageEq(Message::EntryUpdate(1, 2, value)),
+                              IsNull(), IsNull()));
+  }
+  EXPECT_CALL(notifier,
+              NotifyEntry(1, std::string_view("foo2"), value,
+                          NT_NOTIFY_UPDATE | NT_NOTIFY_LOCAL, UINT_MAX));
+  storage.MirrorLocalChannels();
+  EXPECT_EQ(value, GetEntry("foo2")->value);
+  EXPECT_FALSE(storage.ReadLocalEntryValue(1, &seq, &got));
+  ::testing::Mock::VerifyAndClearExpectations(&dispatcher);
+  ::testing::Mock::VerifyAndClearExpectations(&notifier);
+
+  // values set through storage are delivered
+  auto value2 = Value::MakeDouble(2.0);
+  if (GetParam()) {
+    EXPECT_CALL(dispatcher, QueueOutgoing(_, IsNull(), IsNull()));
+  }
+  EXPECT_CALL(notifier, NotifyEntry(1, _, _, _, UINT_MAX));
+  EXPECT_TRUE(storage.SetEntryValue(1, value2));
+  ASSERT_TRUE(storage.ReadLocalEntryValue(1, &seq, &got));
+  EXPECT_EQ(value2, got);
+}
+
+TEST_P(StorageTestPopulated, WaitForLocalEntryValue) {
+  storage.SetPeriodicMirror(true);
+  uint64_t seq = 0;
+  std::shared_ptr<Value> got;
+  ASSERT_TRUE(storage.ReadLocalEntryValue(3, &seq, &got));
+  EXPECT_FALSE(storage.WaitForLocalEntryValue(3, &seq, &got, 0.01));
+
+  auto value = Value::MakeBoolean(true);
+  std::thread publisher{[&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    storage.PublishLocalEntryValue(3, value);
+  }};
+  EXPECT_TRUE(storage.WaitForLocalEntryValue(3, &seq, &got, 10));
+  EXPECT_EQ(value, got);
+  publisher.join();
+}
+
+TEST_P(StorageTestPopulated, PublishLocalEntryValueUnmirrored) {
+  // without periodic mirroring, values are set as they are published
+  auto value = Value::MakeDouble(1.0);
+  if (GetParam()) {
+    EXPECT_CALL(dispatcher, QueueOutgoing(_, IsNull(), IsNull()));
+  }
+  EXPECT_CALL(notifier, NotifyEntry(1, _, value, _, UINT_MAX));
+  EXPECT_TRUE(storage.PublishLocalEntryValue(1, value));
+  EXPECT_EQ(value, GetEntry("foo2")->value);
+}
+
+TEST_P(StorageTestPopulated, SetEntryDoubleInPlace) {
+  // unshared value is updated in place; a held reference forces a new value
+  auto entry = GetEntry("foo2");
+  const Value* orig = entry->value.get();
+  if (GetParam()) {
+    EXPECT_CALL(dispatcher,
+                QueueOutgoing(MessageEq(Message::EntryUpdate(
+                                  1, 2, Value::MakeDouble(1.0))),
+                              IsNull(), IsNull()));
+  }
+  EXPECT_CALL(notifier, NotifyEntry(1, std::string_view("foo2"), _,
+                                    NT_NOTIFY_UPDATE | NT_NOTIFY_LOCAL,
+                                    UINT_MAX));
+  EXPECT_TRUE(storage.SetEntryDouble(1, 1.0, 0));
+  EXPECT_EQ(orig, entry->value.get());
+  ::testing::Mock::VerifyAndClearExpectations(&dispatcher);
+  ::testing::Mock::VerifyAndClearExpectations(&notifier);
+
+  auto held = entry->value;
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  EXPECT_TRUE(storage.SetEntryDouble(1, 2.0, 0));
+  EXPECT_NE(held, entry->value);
+  EXPECT_EQ(1.0, held->GetDouble());
+
+  double value;
+  EXPECT_TRUE(storage.GetEntryDouble(1, &value, nullptr));
+  EXPECT_EQ(2.0, value);
+}
+
+TEST_P(StorageTestPopulated, EntryHistory) {
+  EXPECT_TRUE(storage.GetEntryHistory(1, 0).empty());
+
+  // enabling history records the current value
+  storage.SetEntryHistoryDepth(1, 3);
+  auto history = storage.GetEntryHistory(1, 0);
+  ASSERT_EQ(1u, history.size());
+  EXPECT_EQ(*Value::MakeDouble(0.0), *history[0]);
+
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  storage.SetEntryDouble(1, 1.0, 10);
+  storage.SetEntryDouble(1, 1.0, 15);  // unchanged values aren't recorded
+  storage.SetEntryDouble(1, 2.0, 20);
+  storage.SetEntryDouble(1, 3.0, 30);
+  history = storage.GetEntryHistory(1, 0);
+  ASSERT_EQ(3u, history.size());
+  EXPECT_EQ(*Value::MakeDouble(1.0), *history[0]);
+  EXPECT_EQ(*Value::MakeDouble(3.0), *history[2]);
+  EXPECT_EQ(30u, history[2]->last_change());
+
+  history = storage.GetEntryHistory(1, 10);
+  ASSERT_EQ(2u, history.size());
+  EXPECT_EQ(20u, history[0]->last_change());
+
+  // shrinking keeps the newest
+  storage.SetEntryHistoryDepth(1, 1);
+  history = storage.GetEntryHistory(1, 0);
+  ASSERT_EQ(1u, history.size());
+  EXPECT_EQ(*Value::MakeDouble(3.0), *history[0]);
+
+  storage.SetEntryHistoryDepth(1, 0);
+  EXPECT_TRUE(storage.GetEntryHistory(1, 0).empty());
+}
+
+TEST_P(StorageTestPopulated, SetEntryBooleanTypeMismatch) {
+  EXPECT_FALSE(storage.SetEntryBoolean(1, true, 0));
+  bool value;
+  EXPECT_FALSE(storage.GetEntryBoolean(1, &value, nullptr));
+  EXPECT_EQ(0.0, GetEntry("foo2")->value->GetDouble());
+}
+
+TEST_P(StorageTestPopulated, GettersFollowTypeChanges) {
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  double d;
+  uint64_t last_change;
+  storage.SetEntryDouble(1, 2.0, 20);
+  ASSERT_TRUE(storage.GetEntryDouble(1, &d, &last_change));
+  EXPECT_EQ(2.0, d);
+  EXPECT_EQ(20u, last_change);
+  EXPECT_EQ(*Value::MakeDouble(2.0), *storage.GetEntryValue(1));
+
+  storage.SetEntryTypeValue(1, Value::MakeString("abc"));
+  EXPECT_FALSE(storage.GetEntryDouble(1, &d, nullptr));
+  EXPECT_EQ(*Value::MakeString("abc"), *storage.GetEntryValue(1));
+
+  storage.SetEntryTypeValue(1, Value::MakeBoolean(true));
+  bool b;
+  ASSERT_TRUE(storage.GetEntryBoolean(1, &b, nullptr));
+  EXPECT_TRUE(b);
+  EXPECT_EQ(*Value::MakeBoolean(true), *storage.GetEntryValue(1));
+
+  storage.DeleteEntry(1);
+  EXPECT_FALSE(storage.GetEntryBoolean(1, &b, nullptr));
+  EXPECT_FALSE(storage.GetEntryValue(1));
+}
+
 TEST_P(StorageTestEmpty, SetEntryValueEmptyName) {
   auto value = Value::MakeBoolean(true);
   EXPECT_TRUE(storage.SetEntryValue("", value));
@@ -550,6 +751,26 @@ TEST_P(StorageTestPopulated, GetEntryInfoPrefixTypes) {
   EXPECT_EQ(NT_BOOLEAN, info[0].type);
 }
 
+TEST_P(StorageTestPopulated, GetEntryInfoPrefixNeighbors) {
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  storage.SetEntryTypeValue("fo", Value::MakeBoolean(true));
+  storage.SetEntryTypeValue("fop", Value::MakeBoolean(true));
+  storage.SetEntryTypeValue("foo/a", Value::MakeBoolean(true));
+  ::testing::Mock::VerifyAndClearExpectations(&dispatcher);
+  ::testing::Mock::VerifyAndClearExpectations(&notifier);
+
+  auto info = storage.GetEntryInfo(0, "foo", 0u);
+  ASSERT_EQ(3u, info.size());
+  EXPECT_EQ("foo", info[0].name);
+  EXPECT_EQ("foo/a", info[1].name);
+  EXPECT_EQ("foo2", info[2].name);
+
+  EXPECT_EQ(3u, storage.GetEntries("foo", 0).size());
+  EXPECT_EQ(1u, storage.GetEntries("foo/", 0).size());
+  EXPECT_TRUE(storage.GetEntries("fooz", 0).empty());
+}
+
 TEST_P(StorageTestPersistent, SavePersistentEmpty) {
   wpi::SmallString<256> buf;
   wpi::raw_svector_ostream oss(buf);
@@ -619,6 +840,79 @@ TEST_P(StorageTestPersistent, SavePersistent) {
   ASSERT_EQ("", line);
 }
 
+TEST_P(StorageTestPersistent, SavePersistentJournal) {
+  for (auto& i : entries()) {
+    i.getValue()->flags = NT_PERSISTENT;
+  }
+  wpi::SmallString<256> buf;
+  wpi::raw_svector_ostream oss(buf);
+  storage.SavePersistentJournal(oss, true);
+  size_t snapshot_size = buf.size();
+
+  // only the changes are appended
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  storage.SetEntryValue("double/neg", Value::MakeDouble(2.0));
+  storage.SetEntryFlags("string/normal", 0);
+  EXPECT_TRUE(storage.SavePersistentJournal(oss, false));
+  EXPECT_LT(buf.size() - snapshot_size, 40u);
+
+  // a periodic save skips writing when nothing has changed
+  size_t size = buf.size();
+  EXPECT_FALSE(storage.SavePersistentJournal(oss, false, true));
+  EXPECT_EQ(buf.size(), size);
+
+  Storage loaded(notifier, rpc_server, logger);
+  MockLoadWarn warn;
+  auto warn_func = [&](size_t line, const char* msg) { warn.Warn(line, msg); };
+  wpi::raw_mem_istream iss(buf.data(), buf.size());
+  EXPECT_TRUE(loaded.LoadJournal(iss, warn_func));
+
+  EXPECT_EQ(*Value::MakeDouble(2.0), *loaded.GetEntryValue("double/neg"));
+  EXPECT_FALSE(loaded.GetEntryValue("string/normal"));
+  EXPECT_EQ(NT_PERSISTENT, loaded.GetEntryFlags("raw/special"));
+  for (auto& i : entries()) {
+    auto name = i.getKey();
+    if (name == "double/neg" || name == "string/normal") {
+      continue;
+    }
+    auto value = loaded.GetEntryValue(name);
+    ASSERT_TRUE(value) << name;
+    EXPECT_EQ(*i.getValue()->value, *value) << name;
+  }
+}
+
+TEST_P(StorageTestPersistent, LoadJournalTruncated) {
+  GetEntry("double/neg")->flags = NT_PERSISTENT;
+  GetEntry("double/zero")->flags = NT_PERSISTENT;
+  wpi::SmallString<256> buf;
+  wpi::raw_svector_ostream oss(buf);
+  storage.SavePersistentJournal(oss, true);
+  buf.pop_back();
+
+  Storage loaded(notifier, rpc_server, logger);
+  MockLoadWarn warn;
+  auto warn_func = [&](size_t line, const char* msg) { warn.Warn(line, msg); };
+  EXPECT_CALL(warn, Warn(2, std::string_view("ignoring truncated record")));
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  wpi::raw_mem_istream iss(buf.data(), buf.size());
+  EXPECT_TRUE(loaded.LoadJournal(iss, warn_func));
+  EXPECT_EQ(*Value::MakeDouble(-1.5), *loaded.GetEntryValue("double/neg"));
+  EXPECT_FALSE(loaded.GetEntryValue("double/zero"));
+}
+
+TEST_P(StorageTestEmpty, LoadJournalBadHeader) {
+  MockLoadWarn warn;
+  auto warn_func = [&](size_t line, const char* msg) { warn.Warn(line, msg); };
+
+  wpi::raw_mem_istream iss("[NetworkTables Storage 3.0]\n");
+  EXPECT_CALL(warn,
+              Warn(0, std::string_view(
+                          "journal header mismatch, ignoring rest of file")));
+  EXPECT_FALSE(storage.LoadJournal(iss, warn_func));
+  EXPECT_TRUE(entries().empty());
+}
+
 TEST_P(StorageTestEmpty, LoadPersistentBadHeader) {
   MockLoadWarn warn;
   auto warn_func = [&](size_t line, const char* msg) { warn.Warn(line, msg); };
@@ -991,6 +1285,198 @@ TEST_P(StorageTestPopulateOne, DeletedGetEntries) {
   EXPECT_TRUE(storage.GetEntries("", 0).empty());
 }
 
+TEST_P(StorageTestPopulated, GetResumeAssignments) {
+  if (!GetParam()) {
+    return;  // server only
+  }
+  ::testing::NiceMock<MockNetworkConnection> conn;
+  std::string digest;
+  storage.GetSessionDigest(&digest);
+
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  auto value = Value::MakeDouble(5.0);
+  storage.SetEntryValue("foo2", value);
+  storage.DeleteEntry("bar");
+
+  std::vector<std::shared_ptr<Message>> msgs;
+  ASSERT_TRUE(storage.GetResumeAssignments(conn, digest, &msgs));
+  ASSERT_EQ(2u, msgs.size());
+  EXPECT_THAT(msgs[0], MessageEq(Message::EntryDelete(2)));
+  EXPECT_THAT(msgs[1], MessageEq(Message::EntryAssign("foo2", 1, 2, value, 0)));
+
+  // a truncated digest is rejected
+  msgs.clear();
+  EXPECT_FALSE(storage.GetResumeAssignments(
+      conn, std::string_view{digest}.substr(0, digest.size() - 1), &msgs));
+}
+
+TEST_P(StorageTestPopulated, GetInitialAssignmentsSubscribed) {
+  if (!GetParam()) {
+    return;  // server only
+  }
+  ::testing::NiceMock<MockNetworkConnection> conn;
+  std::vector<std::string> prefixes{"bar"};
+  conn.subscriptions().Set(prefixes, {});
+
+  std::vector<std::shared_ptr<Message>> msgs;
+  storage.GetInitialAssignments(conn, &msgs);
+  ASSERT_EQ(2u, msgs.size());
+  EXPECT_EQ(msgs[0]->str(), "bar");
+  EXPECT_EQ(msgs[1]->str(), "bar2");
+  EXPECT_TRUE(conn.subscriptions().IsSubscribed(2));
+  EXPECT_TRUE(conn.subscriptions().IsSubscribed(3));
+  EXPECT_FALSE(conn.subscriptions().IsSubscribed(0));
+}
+
+TEST_P(StorageTestPopulated, ProcessIncomingSubscribe) {
+  if (!GetParam()) {
+    return;  // server only
+  }
+  ::testing::NiceMock<MockNetworkConnection> conn;
+  std::vector<std::string> prefixes{"foo2"};
+  std::vector<std::shared_ptr<Message>> msgs;
+  conn.subscriptions().Set(prefixes, {});
+  storage.GetInitialAssignments(conn, &msgs);
+  ASSERT_EQ(1u, msgs.size());
+
+  // only the newly matched entry is assigned
+  EXPECT_CALL(conn, QueueOutgoing(MessageEq(Message::EntryAssign(
+                        "foo", 0, 1, Value::MakeBoolean(true), 0))));
+  prefixes = {"foo"};
+  storage.ProcessIncoming(Message::Subscribe(prefixes), &conn, {});
+  EXPECT_TRUE(conn.subscriptions().IsSubscribed(0));
+  EXPECT_TRUE(conn.subscriptions().IsSubscribed(1));
+  EXPECT_FALSE(conn.subscriptions().IsSubscribed(2));
+}
+
+TEST_P(StorageTestEmpty, ProcessIncomingAssignSubscribesName) {
+  if (!GetParam()) {
+    return;  // server only
+  }
+  ::testing::NiceMock<MockNetworkConnection> conn;
+  std::vector<std::string> prefixes{"/cam/"};
+  conn.subscriptions().Set(prefixes, {});
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  storage.ProcessIncoming(
+      Message::EntryAssign("/mine", 0xffff, 0, Value::MakeDouble(1), 0), &conn,
+      {});
+  // the sender gets the assigned id back
+  EXPECT_TRUE(conn.subscriptions().Matches("/mine"));
+}
+
+TEST_P(StorageTestEmpty, PrefixPriority) {
+  unsigned int existing = storage.GetEntry("/vision/x");
+  storage.SetPrefixPriority("/vision/", NT_PRIORITY_HIGH);
+  storage.SetPrefixPriority("/vision/debug/", NT_PRIORITY_LOW);
+  storage.SetPrefixPriority("/", NT_PRIORITY_LOW);
+  EXPECT_EQ(unsigned{NT_PRIORITY_HIGH}, storage.GetEntryPriority(existing));
+  EXPECT_EQ(unsigned{NT_PRIORITY_LOW},
+            storage.GetEntryPriority(storage.GetEntry("/vision/debug/a")));
+  EXPECT_EQ(unsigned{NT_PRIORITY_HIGH},
+            storage.GetEntryPriority(storage.GetEntry("/vision/y")));
+  EXPECT_EQ(unsigned{NT_PRIORITY_LOW},
+            storage.GetEntryPriority(storage.GetEntry("/pdp")));
+  EXPECT_EQ(unsigned{NT_PRIORITY_NORMAL},
+            storage.GetEntryPriority(storage.GetEntry("other")));
+
+  storage.SetEntryPriority(existing, NT_PRIORITY_NORMAL);
+  EXPECT_EQ(unsigned{NT_PRIORITY_NORMAL}, storage.GetEntryPriority(existing));
+}
+
+TEST_P(StorageTestPopulated, SetEntryValueHighPriority) {
+  storage.SetEntryPriority(storage.GetEntry("foo2"), NT_PRIORITY_HIGH);
+  auto value = Value::MakeDouble(5.0);
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _));
+  if (GetParam()) {
+    EXPECT_CALL(dispatcher,
+                QueueOutgoing(MessageEq(Message::EntryUpdate(1, 2, value)),
+                              IsNull(), IsNull()));
+    EXPECT_CALL(dispatcher, FlushOutgoing());
+  }
+  storage.SetEntryValue("foo2", value);
+}
+
+TEST_P(StorageTestEmpty, GetRpcResults) {
+  if (!GetParam()) {
+    return;  // server only (calls are answered locally)
+  }
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  unsigned int local_id = storage.GetEntry("rpc");
+  storage.CreateRpc(local_id, "def", 5);
+
+  std::vector<IRpcServer::SendResponseFunc> responses;
+  EXPECT_CALL(rpc_server, ProcessRpc(local_id, _, _, _, _, _, 5))
+      .Times(2)
+      .WillRepeatedly(
+          [&](unsigned int, unsigned int, std::string_view, std::string_view,
+              const ConnectionInfo&, IRpcServer::SendResponseFunc send_response,
+              unsigned int) { responses.emplace_back(send_response); });
+  unsigned int calls[] = {storage.CallRpc(local_id, "a"),
+                          storage.CallRpc(local_id, "b")};
+  ASSERT_EQ(2u, responses.size());
+
+  // answered out of order; nothing is consumed until all are in
+  responses[1]("2");
+  std::vector<std::string> results;
+  bool timed_out = false;
+  EXPECT_FALSE(storage.GetRpcResults(local_id, calls, &results, 0.01,
+                                     &timed_out));
+  EXPECT_TRUE(timed_out);
+  responses[0]("1");
+  ASSERT_TRUE(storage.GetRpcResults(local_id, calls, &results, 0.01,
+                                    &timed_out));
+  EXPECT_FALSE(timed_out);
+  EXPECT_THAT(results, ElementsAre("1", "2"));
+
+  // results are only returned once
+  std::string result;
+  EXPECT_FALSE(storage.GetRpcResult(local_id, calls[1], &result, 0,
+                                    &timed_out));
+}
+
+TEST_P(StorageTestEmpty, ApplyResumeAssignments) {
+  if (GetParam()) {
+    return;  // client only
+  }
+  ::testing::NiceMock<MockNetworkConnection> conn;
+  EXPECT_CALL(conn, proto_rev()).WillRepeatedly(Return(0x0300u));
+  EXPECT_CALL(notifier, NotifyEntry(_, _, _, _, _)).Times(AnyNumber());
+  std::vector<std::shared_ptr<Message>> msgs{
+      Message::EntryAssign("foo", 0, 1, Value::MakeDouble(1.0), 0),
+      Message::EntryAssign("bar", 1, 1, Value::MakeDouble(2.0), 0),
+      Message::EntryAssign("baz", 2, 1, Value::MakeDouble(3.0), 0)};
+  std::vector<std::shared_ptr<Message>> out;
+  // a full assignment replaces every id
+  EXPECT_CALL(dispatcher, ClearPendingUpdates());
+  storage.ApplyInitialAssignments(conn, msgs, false, {}, &out);
+  EXPECT_TRUE(out.empty());
+  std::string digest;
+  storage.GetSessionDigest(&digest);
+
+  // written locally while reconnecting; the update is dropped
+  EXPECT_CALL(dispatcher, QueueOutgoing(_, _, _));
+  auto baz = Value::MakeDouble(4.0);
+  storage.SetEntryValue("baz", baz);
+  ::testing::Mock::VerifyAndClearExpectations(&dispatcher);
+
+  // the server changed foo and deleted bar; baz is resent
+  auto foo = Value::MakeDouble(5.0);
+  msgs = {Message::EntryDelete(1), Message::EntryAssign("foo", 0, 2, foo, 0)};
+  EXPECT_CALL(dispatcher, ClearPendingUpdate(1u));
+  EXPECT_CALL(dispatcher,
+              QueueOutgoing(MessageEq(Message::EntryUpdate(2, 2, baz)),
+                            IsNull(), IsNull()));
+  storage.ApplyInitialAssignments(conn, msgs, false, digest, &out);
+  EXPECT_TRUE(out.empty());
+  EXPECT_THAT(storage.GetEntryValue("foo"), ValueEq(foo));
+  EXPECT_FALSE(storage.GetEntryValue("bar"));
+  EXPECT_THAT(storage.GetEntryValue("baz"), ValueEq(baz));
+  EXPECT_EQ(2u, GetEntry("baz")->id);
+}
+
 INSTANTIATE_TEST_SUITE_P(StorageTestsEmpty, StorageTestEmpty,
                          ::testing::Bool());
 INSTANTIATE_TEST_SUITE_P(StorageTestsPopulateOne, StorageTestPopulateOne,
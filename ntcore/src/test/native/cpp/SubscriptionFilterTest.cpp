@@ -0,0 +1,155 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <wpi/Logger.h>
+#include <wpi/raw_istream.h>
+
+#include "Message.h"
+#include "SubscriptionFilter.h"
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+#include "gtest/gtest.h"
+#include "ntcore_cpp.h"
+
+namespace nt {
+
+static std::shared_ptr<Message> RoundTrip(const Message& msg) {
+  wpi::Logger logger;
+  WireEncoder e(0x0300u);
+  msg.Write(e);
+  wpi::raw_mem_istream is(e.data(), e.size());
+  WireDecoder d(is, 0x0300u, logger);
+  return Message::Read(d, [](unsigned int) { return NT_UNASSIGNED; });
+}
+
+TEST(SubscriptionFilterTest, ClientHelloFlags) {
+  // prefixes are only sent in SUBSCRIBE, so the identity just carries flags
+  auto msg = RoundTrip(*Message::ClientHello(
+      "dashboard", Message::kSessionResumeExt | Message::kCompressionExt));
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(msg->str(), "dashboard");
+  EXPECT_EQ(msg->flags(),
+            Message::kSessionResumeExt | Message::kCompressionExt);
+  EXPECT_TRUE(msg->prefixes().empty());
+
+  // without flags the identity is unchanged
+  msg = RoundTrip(*Message::ClientHello("dashboard"));
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(msg->str(), "dashboard");
+  EXPECT_EQ(msg->flags(), 0u);
+}
+
+TEST(SubscriptionFilterTest, SubscribeMessage) {
+  std::vector<std::string> prefixes{"/a/", "/b"};
+  auto msg = RoundTrip(*Message::Subscribe(prefixes));
+  ASSERT_TRUE(msg);
+  ASSERT_TRUE(msg->Is(Message::kSubscribe));
+  EXPECT_EQ(msg->prefixes(), prefixes);
+}
+
+TEST(SubscriptionFilterTest, Inactive) {
+  SubscriptionFilter filter;
+  EXPECT_FALSE(filter.IsActive());
+  EXPECT_TRUE(filter.Filter(*Message::EntryUpdate(5, 1, nullptr)));
+  // an empty prefix matches everything
+  std::vector<std::string> prefixes{"/a", ""};
+  filter.Set(prefixes, {});
+  EXPECT_FALSE(filter.IsActive());
+}
+
+TEST(SubscriptionFilterTest, Prefixes) {
+  SubscriptionFilter filter;
+  std::vector<std::string> prefixes{"/b/c", "/a/", "/b"};
+  filter.Set(prefixes, {});
+  EXPECT_TRUE(filter.IsActive());
+  EXPECT_EQ(filter.GetPrefixes(), (std::vector<std::string>{"/a/", "/b"}));
+  EXPECT_TRUE(filter.Matches("/a/x"));
+  EXPECT_TRUE(filter.Matches("/b/c/d"));
+  EXPECT_TRUE(filter.Matches("/bb"));
+  EXPECT_FALSE(filter.Matches("/a"));
+  EXPECT_FALSE(filter.Matches("/c"));
+  EXPECT_FALSE(filter.Matches(""));
+}
+
+TEST(SubscriptionFilterTest, FilterById) {
+  SubscriptionFilter filter;
+  std::vector<std::string> prefixes{"/cam/"};
+  std::vector<unsigned int> ids{3};
+  filter.Set(prefixes, ids);
+  auto value = Value::MakeDouble(1);
+
+  EXPECT_TRUE(filter.Filter(*Message::EntryUpdate(3, 1, value)));
+  EXPECT_FALSE(filter.Filter(*Message::EntryUpdate(4, 1, value)));
+
+  // assignments are matched by name, and subscribe their ids
+  EXPECT_FALSE(filter.Filter(*Message::EntryAssign("/x", 4, 0, value, 0)));
+  EXPECT_TRUE(filter.Filter(*Message::EntryAssign("/cam/x", 5, 0, value, 0)));
+  EXPECT_TRUE(filter.Filter(*Message::FlagsUpdate(5, 1)));
+  EXPECT_FALSE(filter.Filter(*Message::FlagsUpdate(4, 1)));
+
+  // deleted ids are forgotten
+  EXPECT_TRUE(filter.Filter(*Message::EntryDelete(5)));
+  EXPECT_FALSE(filter.IsSubscribed(5));
+  EXPECT_FALSE(filter.Filter(*Message::EntryDelete(4)));
+
+  // names stay subscribed when the prefixes change
+  filter.AddName("/mine");
+  filter.Set({}, {});
+  filter.Set(prefixes, {});
+  EXPECT_TRUE(filter.Filter(*Message::EntryAssign("/mine", 6, 0, value, 0)));
+  EXPECT_FALSE(filter.IsSubscribed(3));
+  EXPECT_TRUE(filter.Filter(*Message::ClearEntries()));
+}
+
+TEST(SubscriptionFilterTest, ClientSubscribes) {
+  auto server_inst = CreateInstance();
+  auto client_inst = CreateInstance();
+  auto server_a = GetEntry(server_inst, "/a/x");
+  auto server_b = GetEntry(server_inst, "/b/x");
+  SetEntryValue(server_a, Value::MakeDouble(1));
+  SetEntryValue(server_b, Value::MakeDouble(1));
+  std::string_view prefixes[] = {"/a/"};
+  SetClientSubscriptions(client_inst, prefixes);
+
+  StartServer(server_inst, "subscriptionfiltertest.ini", "127.0.0.1", 10030);
+  StartClient(client_inst, "127.0.0.1", 10030);
+  auto poller = CreateConnectionListenerPoller(server_inst);
+  AddPolledConnectionListener(poller, false);
+  bool timed_out = false;
+  ASSERT_FALSE(PollConnectionListener(poller, 1.0, &timed_out).empty());
+
+  // the initial assignments are not filtered, but later updates are
+  auto client_a = GetEntry(client_inst, "/a/x");
+  auto client_b = GetEntry(client_inst, "/b/x");
+  EXPECT_EQ(GetEntryType(client_b), NT_DOUBLE);
+  SetEntryValue(server_a, Value::MakeDouble(2));
+  SetEntryValue(server_b, Value::MakeDouble(2));
+  Flush(server_inst);
+  std::shared_ptr<Value> value;
+  for (int i = 0; i < 100; ++i) {
+    value = GetEntryValue(client_a);
+    if (value && value->IsDouble() && value->GetDouble() == 2) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_TRUE(value && value->IsDouble());
+  EXPECT_EQ(value->GetDouble(), 2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  value = GetEntryValue(client_b);
+  ASSERT_TRUE(value && value->IsDouble());
+  EXPECT_EQ(value->GetDouble(), 1);
+
+  DestroyConnectionListenerPoller(poller);
+  DestroyInstance(client_inst);
+  DestroyInstance(server_inst);
+}
+
+}  // namespace nt
@@ -0,0 +1,151 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+
+#include <wpi/Logger.h>
+#include <wpi/raw_istream.h>
+
+#include "TestPrinters.h"
+#include "TimeSync.h"
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+#include "gtest/gtest.h"
+
+namespace nt {
+
+class TimeSyncTest : public ::testing::Test {
+ protected:
+  TimeSyncTest() {
+    client.set_enabled(true, true);
+    server.set_enabled(true, false);
+  }
+
+  // One exchange: the request is sent at client time t0 and takes up_delay
+  // to arrive, and the answer takes down_delay.  The server clock is ahead
+  // of the client clock by kOffset.
+  void Exchange(uint64_t t0, uint64_t up_delay, uint64_t down_delay) {
+    auto request = Message::TimeSync(t0, 0);
+    auto reply = server.Process(*request, t0 + up_delay + kOffset);
+    ASSERT_TRUE(reply);
+    EXPECT_EQ(nullptr,
+              client.Process(*reply, t0 + up_delay + down_delay).get());
+  }
+
+  static constexpr int64_t kOffset = 5000000;
+  TimeSync client;
+  TimeSync server;
+};
+
+TEST_F(TimeSyncTest, ServerAnswers) {
+  auto reply = server.Process(*Message::TimeSync(1234, 0), 5678);
+  ASSERT_TRUE(reply);
+  EXPECT_EQ(Message::kTimeSync, reply->type());
+  EXPECT_EQ(1234u, reply->client_time());
+  EXPECT_EQ(5678u, reply->server_time());
+  EXPECT_EQ(0, server.offset());
+}
+
+TEST_F(TimeSyncTest, Disabled) {
+  TimeSync sync;
+  EXPECT_EQ(nullptr, sync.Poll(1000).get());
+  EXPECT_EQ(nullptr, sync.Process(*Message::TimeSync(1, 0), 2).get());
+}
+
+TEST_F(TimeSyncTest, SymmetricOffset) {
+  EXPECT_FALSE(client.synchronized());
+  Exchange(1000000, 400, 400);
+  EXPECT_TRUE(client.synchronized());
+  EXPECT_EQ(kOffset, client.offset());
+}
+
+TEST_F(TimeSyncTest, FastestExchangeWins) {
+  // a delayed answer is off by half the extra delay
+  Exchange(1000000, 300, 10300);
+  EXPECT_EQ(kOffset - 5000, client.offset());
+  // a fast exchange replaces it
+  Exchange(2000000, 200, 200);
+  EXPECT_EQ(kOffset, client.offset());
+  // and slower ones don't
+  Exchange(3000000, 5000, 300);
+  EXPECT_EQ(kOffset, client.offset());
+}
+
+TEST_F(TimeSyncTest, OldSamplesExpire) {
+  Exchange(1000000, 100, 100);
+  for (unsigned int i = 0; i < TimeSync::kSamples; ++i) {
+    Exchange(2000000 + i * 1000000, 300, 700);
+  }
+  EXPECT_EQ(kOffset - 200, client.offset());
+}
+
+TEST_F(TimeSyncTest, IgnoresBogusAnswers) {
+  Exchange(1000000, 400, 400);
+  // sent in the future
+  client.Process(*Message::TimeSync(9000000, 1), 2000000);
+  // not answered
+  client.Process(*Message::TimeSync(1500000, 0), 2000000);
+  EXPECT_EQ(kOffset, client.offset());
+}
+
+TEST_F(TimeSyncTest, PollInterval) {
+  EXPECT_EQ(nullptr, server.Poll(1000).get());
+  uint64_t now = 1000;
+  auto request = client.Poll(now);
+  ASSERT_TRUE(request);
+  EXPECT_EQ(now, request->client_time());
+  EXPECT_EQ(0u, request->server_time());
+  EXPECT_EQ(nullptr, client.Poll(now + 1).get());
+  // fast while the first samples are collected
+  for (unsigned int i = 1; i < TimeSync::kSamples; ++i) {
+    now += TimeSync::kInterval / 10;
+    EXPECT_TRUE(client.Poll(now)) << i;
+  }
+  now += TimeSync::kInterval / 10;
+  EXPECT_EQ(nullptr, client.Poll(now).get());
+  now += TimeSync::kInterval;
+  EXPECT_TRUE(client.Poll(now));
+}
+
+TEST_F(TimeSyncTest, WireTimestamps) {
+  // the client is 1000 us behind the server
+  WireEncoder e(0x0300u);
+  e.set_timestamps(true, 1000);
+  Message::EntryUpdate(5, 2, Value::MakeDouble(1.0, 7000))->Write(e);
+  Message::EntryAssign("foo", 5, 3, Value::MakeBoolean(true, 8000), 0)
+      ->Write(e);
+  Message::TimeSync(7, 9)->Write(e);
+
+  wpi::Logger logger;
+  wpi::raw_mem_istream is(e.data(), e.size());
+  WireDecoder d(is, 0x0300u, logger);
+  d.set_timestamps(true, 0);
+  auto get_entry_type = [](unsigned int) { return NT_DOUBLE; };
+  auto update = Message::Read(d, get_entry_type);
+  ASSERT_TRUE(update);
+  EXPECT_EQ(8000u, update->value()->time());
+  EXPECT_EQ(1.0, update->value()->GetDouble());
+  auto assign = Message::Read(d, get_entry_type);
+  ASSERT_TRUE(assign);
+  EXPECT_EQ(9000u, assign->value()->time());
+  EXPECT_EQ("foo", assign->str());
+  auto sync = Message::Read(d, get_entry_type);
+  ASSERT_TRUE(sync);
+  EXPECT_EQ(7u, sync->client_time());
+  EXPECT_EQ(9u, sync->server_time());
+  EXPECT_EQ(0u, is.in_avail());
+
+  // and back to the client's time base
+  WireEncoder e2(0x0300u);
+  e2.set_timestamps(true, 0);
+  update->Write(e2);
+  wpi::raw_mem_istream is2(e2.data(), e2.size());
+  WireDecoder d2(is2, 0x0300u, logger);
+  d2.set_timestamps(true, 1000);
+  auto back = Message::Read(d2, get_entry_type);
+  ASSERT_TRUE(back);
+  EXPECT_EQ(7000u, back->value()->time());
+}
+
+}  // namespace nt
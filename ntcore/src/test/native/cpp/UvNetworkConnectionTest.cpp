@@ -0,0 +1,187 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "UvNetworkConnection.h"  // NOLINT(build/include_order)
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <wpi/EventLoopRunner.h>
+#include <wpi/Logger.h>
+#include <wpi/NetworkStream.h>
+#include <wpi/TCPConnector.h>
+#include <wpi/raw_socket_istream.h>
+#include <wpi/uv/Loop.h>
+#include <wpi/uv/Tcp.h>
+#include <wpi/uv/util.h>
+
+#include "MockConnectionNotifier.h"
+#include "TestPrinters.h"
+#include "ValueMatcher.h"
+#include "WireDecoder.h"
+#include "gtest/gtest.h"
+#include "ntcore_cpp.h"
+
+using ::testing::NiceMock;
+
+namespace nt {
+
+class UvNetworkConnectionTest : public ::testing::Test {
+ protected:
+  // Accepts one connection as a UvNetworkConnection, with peer as the other
+  // end.
+  void Connect() {
+    unsigned int port = 0;
+    runner.ExecSync([&](wpi::uv::Loop& loop) {
+      auto server = wpi::uv::Tcp::Create(loop);
+      server->Bind("127.0.0.1", 0);
+      server->Listen([this, srv = server.get()] {
+        auto tcp = srv->Accept();
+        if (!tcp) {
+          return;
+        }
+        conn = std::make_shared<UvNetworkConnection>(
+            1, tcp, notifier, logger,
+            [](UvNetworkConnection&, const Message&, const Message*,
+               UvNetworkConnection::Outgoing*) { return false; },
+            [](UvNetworkConnection&, unsigned int,
+               UvNetworkConnection::Outgoing*) {},
+            [](unsigned int) { return NT_DOUBLE; });
+        conn->Start();
+        srv->Close();
+      });
+      std::string ip;
+      wpi::uv::AddrToName(server->GetSock(), &ip, &port);
+    });
+    peer = wpi::TCPConnector::connect("127.0.0.1", port, logger, 1);
+    ASSERT_TRUE(peer);
+    for (int i = 0; i < 100; ++i) {
+      bool accepted = false;
+      runner.ExecSync([&](wpi::uv::Loop&) { accepted = conn != nullptr; });
+      if (accepted) {
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    FAIL() << "connection not accepted";
+  }
+
+  ~UvNetworkConnectionTest() override {
+    if (conn) {
+      runner.ExecSync([&](wpi::uv::Loop&) { conn->Close(); });
+    }
+  }
+
+  // Reads the next message sent to the peer.
+  std::shared_ptr<Message> Receive() {
+    wpi::raw_socket_istream is(*peer);
+    WireDecoder decoder(is, 0x0300u, logger);
+    return Message::Read(decoder, [](unsigned int) { return NT_DOUBLE; });
+  }
+
+  bool WaitForWritten() {
+    for (int i = 0; i < 100; ++i) {
+      if (conn->outgoing_bytes() == 0) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  }
+
+  wpi::Logger logger;
+  NiceMock<MockConnectionNotifier> notifier;
+  wpi::EventLoopRunner runner;
+  std::shared_ptr<UvNetworkConnection> conn;
+  std::unique_ptr<wpi::NetworkStream> peer;
+};
+
+TEST_F(UvNetworkConnectionTest, OutgoingBudget) {
+  Connect();
+  if (HasFatalFailure()) {
+    return;
+  }
+  conn->set_max_outgoing_bytes(1);
+
+  // stall the loop so nothing posted is written yet
+  std::promise<void> resume;
+  auto stalled = resume.get_future().share();
+  runner.ExecAsync([stalled](wpi::uv::Loop&) { stalled.wait(); });
+
+  conn->QueueOutgoing(Message::EntryUpdate(1, 1, Value::MakeDouble(1)));
+  conn->PostOutgoing(false);
+  size_t queued = conn->outgoing_bytes();
+  EXPECT_GT(queued, 1u);
+
+  // over budget, so these are held and merged rather than encoded
+  conn->QueueOutgoing(Message::EntryUpdate(2, 1, Value::MakeDouble(1)));
+  conn->PostOutgoing(false);
+  conn->QueueOutgoing(Message::EntryUpdate(2, 2, Value::MakeDouble(2)));
+  conn->PostOutgoing(false);
+  EXPECT_EQ(conn->outgoing_bytes(), queued);
+
+  // the write completing returns the bytes to the budget
+  resume.set_value();
+  ASSERT_TRUE(WaitForWritten());
+  conn->PostOutgoing(false);
+  ASSERT_TRUE(WaitForWritten());
+
+  auto msg = Receive();
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(msg->id(), 1u);
+  msg = Receive();
+  ASSERT_TRUE(msg);
+  ASSERT_TRUE(msg->Is(Message::kEntryUpdate));
+  EXPECT_EQ(msg->id(), 2u);
+  EXPECT_EQ(msg->seq_num_uid(), 2u);
+  EXPECT_THAT(msg->value(), ValueEq(Value::MakeDouble(2)));
+}
+
+TEST(UvNetworkConnectionServerTest, Handshake) {
+  auto server_inst = CreateInstance();
+  auto client_inst = CreateInstance();
+  SetNetworkIdentity(client_inst, "client");
+  SetServerEventLoop(server_inst, true);
+  SetEntryValue(GetEntry(server_inst, "/server"), Value::MakeDouble(1));
+  SetEntryValue(GetEntry(client_inst, "/client"), Value::MakeDouble(2));
+
+  StartServer(server_inst, "uvnetworkconnectiontest.ini", "127.0.0.1", 10040);
+  StartClient(client_inst, "127.0.0.1", 10040);
+  auto poller = CreateConnectionListenerPoller(server_inst);
+  AddPolledConnectionListener(poller, false);
+  bool timed_out = false;
+  auto events = PollConnectionListener(poller, 1.0, &timed_out);
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_TRUE(events[0].connected);
+  EXPECT_EQ(events[0].conn.remote_id, "client");
+  EXPECT_EQ(events[0].conn.protocol_version, 0x0300u);
+
+  // each side has the other's initial assignments
+  EXPECT_THAT(GetEntryValue(GetEntry(client_inst, "/server")),
+              ValueEq(Value::MakeDouble(1)));
+  EXPECT_THAT(GetEntryValue(GetEntry(server_inst, "/client")),
+              ValueEq(Value::MakeDouble(2)));
+
+  // and updates flow once connected
+  SetEntryValue(GetEntry(client_inst, "/client"), Value::MakeDouble(3));
+  Flush(client_inst);
+  std::shared_ptr<Value> value;
+  for (int i = 0; i < 100; ++i) {
+    value = GetEntryValue(GetEntry(server_inst, "/client"));
+    if (value && value->IsDouble() && value->GetDouble() == 3) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_THAT(value, ValueEq(Value::MakeDouble(3)));
+
+  DestroyConnectionListenerPoller(poller);
+  DestroyInstance(client_inst);
+  DestroyInstance(server_inst);
+}
+
+}  // namespace nt
@@ -117,6 +117,38 @@ TEST_F(ValueTest, Raw) {
   NT_DisposeValue(&cv);
 }
 
+TEST_F(ValueTest, RawMove) {
+  std::string str(1000, 'x');
+  const char* data = str.data();
+  auto v = Value::MakeRaw(std::move(str));
+  ASSERT_EQ(NT_RAW, v->type());
+  ASSERT_EQ(data, v->GetRaw().data());
+  ASSERT_EQ(1000u, v->GetRaw().size());
+}
+
+TEST_F(ValueTest, RawShared) {
+  auto buf = std::make_shared<std::string>(1000, 'x');
+  auto v = Value::MakeRaw(buf, *buf);
+  buf.reset();
+  ASSERT_EQ(NT_RAW, v->type());
+  ASSERT_EQ(std::string(1000, 'x'), v->GetRaw());
+
+  // shares the buffer rather than copying it
+  auto buf2 = std::make_shared<std::string>("hello");
+  v = Value::MakeRaw(buf2, *buf2);
+  ASSERT_EQ(buf2->data(), v->GetRaw().data());
+  ASSERT_EQ(2, buf2.use_count());
+  NT_Value cv;
+  NT_InitValue(&cv);
+  ConvertToC(*v, &cv);
+  ASSERT_EQ(NT_RAW, cv.type);
+  ASSERT_EQ("hello"sv, cv.data.v_raw.str);
+  ASSERT_EQ(5u, cv.data.v_raw.len);
+  NT_DisposeValue(&cv);
+  v.reset();
+  ASSERT_EQ(1, buf2.use_count());
+}
+
 TEST_F(ValueTest, BooleanArray) {
   std::vector<int> vec{1, 0, 1};
   auto v = Value::MakeBooleanArray(vec);
@@ -307,6 +339,17 @@ TEST_F(ValueTest, StringComparison) {
   ASSERT_NE(*v1, *v2);
 }
 
+TEST_F(ValueTest, RawComparison) {
+  auto buf = std::make_shared<std::string>("hello");
+  auto v1 = Value::MakeRaw("hello");
+  auto v2 = Value::MakeRaw(buf, *buf);
+  ASSERT_EQ(*v1, *v2);
+  ASSERT_EQ(*v2, *Value::MakeRaw(buf, *buf));
+  ASSERT_NE(*v2, *Value::MakeRaw(buf, std::string_view{*buf}.substr(1)));
+  v1 = Value::MakeRaw("world");  // different contents
+  ASSERT_NE(*v1, *v2);
+}
+
 TEST_F(ValueTest, BooleanArrayComparison) {
   std::vector<int> vec{1, 0, 1};
   auto v1 = Value::MakeBooleanArray(vec);
@@ -28,6 +28,33 @@ void Clock::Load(gazebo::physics::ModelPtr model, sdf::ElementPtr sdf) {
   node->Init(scoped_name);
   pub = node->Advertise<gazebo::msgs::Float64>(topic);
 
+  if (sdf->HasElement("lockstep")) {
+    lockstep = sdf->Get<bool>("lockstep");
+  }
+  if (lockstep) {
+    ackSub = node->Subscribe(topic + "/ack", &Clock::AckCallback, this);
+  }
+
+  if (sdf->HasElement("sensor_topic")) {
+    for (auto elem = sdf->GetElement("encoder"); elem;
+         elem = elem->GetNextElement("encoder")) {
+      SensorEncoder encoder;
+      encoder.joint = model->GetJoint(elem->Get<std::string>("joint"));
+      encoder.channel = elem->Get<int>("channel");
+      encoder.multiplier =
+          elem->HasAttribute("multiplier") ? elem->Get<double>("multiplier")
+                                           : 1.0;
+      if (!encoder.joint) {
+        gzerr << "Clock: unknown encoder joint '"
+              << elem->Get<std::string>("joint") << "'" << std::endl;
+        continue;
+      }
+      encoders.push_back(encoder);
+    }
+    sensorPub = node->Advertise<gazebo::msgs::FRCChannels>(
+        sdf->Get<std::string>("sensor_topic"));
+  }
+
   // Connect to the world update event.
   // This will trigger the Update function every Gazebo iteration
   updateConn = gazebo::event::Events::ConnectWorldUpdateBegin(
@@ -35,7 +62,41 @@ void Clock::Load(gazebo::physics::ModelPtr model, sdf::ElementPtr sdf) {
 }
 
 void Clock::Update(const gazebo::common::UpdateInfo& info) {
+  double time = info.simTime.Double();
+
+  // The sensors are published first, so the robot program has them when it
+  // runs up to the time
+  if (sensorPub) {
+    gazebo::msgs::FRCChannels sensors;
+    sensors.set_time(time);
+    for (auto& encoder : encoders) {
+      sensors.add_channel(encoder.channel);
+      sensors.add_value(encoder.joint->Position(0) * encoder.multiplier);
+    }
+    sensorPub->Publish(sensors);
+  }
+
   gazebo::msgs::Float64 msg;
-  msg.set_data(info.simTime.Double());
+  msg.set_data(time);
   pub->Publish(msg);
+
+  if (lockstep) {
+    std::unique_lock lock(ackMutex);
+    if (!ackCond.wait_for(lock, std::chrono::seconds(1),
+                          [&] { return ackTime >= time; })) {
+      if (!ackTimedOut) {
+        gzwarn << "Clock: robot program did not acknowledge time " << time
+               << "; is it running?" << std::endl;
+      }
+      ackTimedOut = true;
+    }
+  }
+}
+
+void Clock::AckCallback(const gazebo::msgs::ConstFloat64Ptr& msg) {
+  {
+    std::scoped_lock lock(ackMutex);
+    ackTime = msg->data();
+  }
+  ackCond.notify_all();
 }
@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <gazebo/gazebo.hh>
 #include <gazebo/physics/physics.hh>
@@ -27,6 +31,25 @@
  *
  * - `topic`: Optional. Message will be published as a gazebo.msgs.Float64.
  *
+ * The clock can also synchronize the robot program with the simulation,
+ * when halsim_gazebo is configured to match:
+ *
+ *     <plugin name="my_clock" filename="libclock.so">
+ *       <topic>/gazebo/frc/time</topic>
+ *       <lockstep>true</lockstep>
+ *       <sensor_topic>/gazebo/frc/simulator/sensors</sensor_topic>
+ *       <encoder joint="Joint Name" channel="0" multiplier="1"/>
+ *     </plugin>
+ *
+ * - `lockstep`: Optional. If true, each update waits (for up to a second)
+ *   for the robot program to run up to the time and acknowledge it on
+ *   `topic`/ack.
+ * - `sensor_topic`: Optional. The positions of the `encoder` joints are
+ *   published together on this topic each update, as a
+ *   gazebo.msgs.FRCChannels.
+ * - `encoder`: Optional, repeated. `channel` is the robot encoder's channel
+ *   A, and the position is the joint angle in radians times `multiplier`.
+ *
  * \todo Make WorldPlugin?
  */
 class Clock : public gazebo::ModelPlugin {
@@ -52,4 +75,32 @@ class Clock : public gazebo::ModelPlugin {
 
   /// \brief Publisher handle.
   gazebo::transport::PublisherPtr pub;
+
+  /// \brief Callback for the robot program's acknowledgement of a time.
+  void AckCallback(const gazebo::msgs::ConstFloat64Ptr& msg);
+
+  /// \brief Whether to wait for the robot program each update.
+  bool lockstep = false;
+
+  /// \brief Whether the robot program has failed to acknowledge a time.
+  bool ackTimedOut = false;
+
+  /// \brief The last time acknowledged by the robot program.
+  double ackTime = -1;
+  std::mutex ackMutex;
+  std::condition_variable ackCond;
+
+  /// \brief Subscriber handle for acknowledgements.
+  gazebo::transport::SubscriberPtr ackSub;
+
+  /// \brief An encoder joint whose position is published.
+  struct SensorEncoder {
+    gazebo::physics::JointPtr joint;
+    int channel;
+    double multiplier;
+  };
+  std::vector<SensorEncoder> encoders;
+
+  /// \brief Publisher handle for the encoder positions.
+  gazebo::transport::PublisherPtr sensorPub;
 };
@@ -4,6 +4,8 @@
 
 #include "dc_motor.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string/replace.hpp>
 
 GZ_REGISTER_MODEL_PLUGIN(DCMotor)
@@ -26,8 +28,15 @@ void DCMotor::Load(gazebo::physics::ModelPtr model, sdf::ElementPtr sdf) {
     multiplier = 1;
   }
 
+  if (sdf->HasElement("channel")) {
+    channel = sdf->Get<int>("channel");
+  } else {
+    channel = -1;
+  }
+
   gzmsg << "Initializing motor: " << topic << " joint=" << joint->GetName()
-        << " multiplier=" << multiplier << std::endl;
+        << " multiplier=" << multiplier << " channel=" << channel
+        << std::endl;
 
   // Connect to Gazebo transport for messaging
   std::string scoped_name =
@@ -35,7 +44,15 @@ void DCMotor::Load(gazebo::physics::ModelPtr model, sdf::ElementPtr sdf) {
   boost::replace_all(scoped_name, "::", "/");
   node = gazebo::transport::NodePtr(new gazebo::transport::Node());
   node->Init(scoped_name);
-  sub = node->Subscribe(topic, &DCMotor::Callback, this);
+  if (channel >= 0) {
+    std::string batch_topic = "/gazebo/frc/simulator/pwm_batch";
+    if (sdf->HasElement("batch_topic")) {
+      batch_topic = sdf->Get<std::string>("batch_topic");
+    }
+    sub = node->Subscribe(batch_topic, &DCMotor::BatchCallback, this);
+  } else {
+    sub = node->Subscribe(topic, &DCMotor::Callback, this);
+  }
 
   // Connect to the world update event.
   // This will trigger the Update function every Gazebo iteration
@@ -48,7 +65,21 @@ void DCMotor::Update(const gazebo::common::UpdateInfo& info) {
 }
 
 void DCMotor::Callback(const gazebo::msgs::ConstFloat64Ptr& msg) {
-  signal = msg->data();
+  SetSignal(msg->data());
+}
+
+void DCMotor::BatchCallback(const gazebo::msgs::ConstFRCChannelsPtr& msg) {
+  int count = std::min(msg->channel_size(), msg->value_size());
+  for (int i = 0; i < count; i++) {
+    if (msg->channel(i) == channel) {
+      SetSignal(msg->value(i));
+      return;
+    }
+  }
+}
+
+void DCMotor::SetSignal(double value) {
+  signal = value;
   if (signal < -1) {
     signal = -1;
   } else if (signal > 1) {
@@ -31,6 +31,11 @@
  * - `joint`: Name of the joint this Dc motor is attached to.
  * - `topic`: Optional. Message type should be gazebo.msgs.Float64.
  * - `multiplier`: Optional. Defaults to 1.
+ * - `channel`: Optional. If set, the signal is instead read from the PWM
+ *   outputs batched by halsim_gazebo, for this PWM channel.
+ * - `batch_topic`: Optional. The topic of the batched PWM outputs, as a
+ *   gazebo.msgs.FRCChannels. Defaults to
+ *   /gazebo/frc/simulator/pwm_batch.
  */
 class DCMotor : public gazebo::ModelPlugin {
  public:
@@ -53,9 +58,18 @@ class DCMotor : public gazebo::ModelPlugin {
   /// \brief The joint that this dc motor drives.
   gazebo::physics::JointPtr joint;
 
+  /// \brief The PWM channel to read from batches; -1 if not batched.
+  int channel;
+
   /// \brief Callback for receiving msgs and storing the signal.
   void Callback(const gazebo::msgs::ConstFloat64Ptr& msg);
 
+  /// \brief Callback for receiving batched signals.
+  void BatchCallback(const gazebo::msgs::ConstFRCChannelsPtr& msg);
+
+  /// \brief Stores the signal, limited to the range [-1,1].
+  void SetSignal(double value);
+
   /// \brief The model to which this is attached.
   gazebo::physics::ModelPtr model;
 
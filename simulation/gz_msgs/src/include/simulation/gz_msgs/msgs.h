@@ -16,6 +16,7 @@
  #include "simulation/gz_msgs/bool.pb.h"
  #include "simulation/gz_msgs/driver-station.pb.h"
  #include "simulation/gz_msgs/float64.pb.h"
+ #include "simulation/gz_msgs/frc-channels.pb.h"
  #include "simulation/gz_msgs/frc_joystick.pb.h"
 
 
@@ -41,6 +42,9 @@ namespace gazebo {
 
     typedef boost::shared_ptr< msgs::DriverStation > DriverStationPtr;
     typedef const boost::shared_ptr< const msgs::DriverStation > ConstDriverStationPtr;
+
+    typedef boost::shared_ptr< msgs::FRCChannels > FRCChannelsPtr;
+    typedef const boost::shared_ptr< const msgs::FRCChannels > ConstFRCChannelsPtr;
   }
 }
 
@@ -246,16 +246,8 @@ void DSCommPacket::ReadJoystickDescriptionTag(wpi::span<const uint8_t> data) {
 
   packet.descriptor.buttonCount = data[0];
   packet.descriptor.povCount = data[1];
-}
 
-void DSCommPacket::SendJoysticks(void) {
-  for (int i = 0; i < HAL_kMaxJoysticks; i++) {
-    DSCommJoystickPacket& packet = m_joystick_packets[i];
-    HALSIM_SetJoystickAxes(i, &packet.axes);
-    HALSIM_SetJoystickPOVs(i, &packet.povs);
-    HALSIM_SetJoystickButtons(i, &packet.buttons);
-    HALSIM_SetJoystickDescriptor(i, &packet.descriptor);
-  }
+  HALSIM_SetJoystickDescriptor(joystickNum, &packet.descriptor);
 }
 
 void DSCommPacket::SetupSendBuffer(wpi::raw_uv_ostream& buf) {
@@ -306,16 +298,17 @@ void DSCommPacket::SetupJoystickTag(wpi::raw_uv_ostream& buf) {
 }
 
 void DSCommPacket::SendUDPToHALSim(void) {
-  SendJoysticks();
-
-  HALSIM_SetDriverStationMatchTime(m_match_time);
-  HALSIM_SetDriverStationEnabled(m_control_word.enabled);
-  HALSIM_SetDriverStationAutonomous(m_control_word.autonomous);
-  HALSIM_SetDriverStationTest(m_control_word.test);
-  HALSIM_SetDriverStationEStop(m_control_word.eStop);
-  HALSIM_SetDriverStationFmsAttached(m_control_word.fmsAttached);
-  HALSIM_SetDriverStationDsAttached(m_control_word.dsAttached);
-  HALSIM_SetDriverStationAllianceStationId(m_alliance_station);
-
-  HALSIM_NotifyDriverStationNewData();
+  // Everything in the packet is applied at once, with one notification
+  HALSIM_DriverStationState state;
+  state.controlWord = m_control_word;
+  state.allianceStationId = m_alliance_station;
+  state.matchTime = m_match_time;
+  for (int i = 0; i < HAL_kMaxJoysticks; i++) {
+    DSCommJoystickPacket& packet = m_joystick_packets[i];
+    state.joystickAxes[i] = packet.axes;
+    state.joystickPOVs[i] = packet.povs;
+    state.joystickButtons[i] = packet.buttons;
+  }
+
+  HALSIM_SetDriverStationState(&state);
 }
@@ -15,6 +15,7 @@
 
 #include <atomic>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <string_view>
 
@@ -23,6 +24,7 @@
 #include <hal/Extensions.h>
 #include <wpi/EventLoopRunner.h>
 #include <wpi/raw_uv_ostream.h>
+#include <wpi/timestamp.h>
 #include <wpi/uv/Tcp.h>
 #include <wpi/uv/Timer.h>
 #include <wpi/uv/Udp.h>
@@ -37,6 +39,13 @@ using namespace wpi::uv;
 static std::unique_ptr<Buffer> singleByte;
 static std::atomic<bool> gDSConnected = false;
 
+// In high rate mode, control packets may arrive faster than the driver
+// station's 50 Hz (e.g. from a test harness exercising joystick latency).
+// Each packet is still applied as it arrives, but packets older than the last
+// one applied are dropped, and replies are limited to the driver station rate.
+static bool gHighRate = false;
+static constexpr uint64_t kReplyPeriod = 20000;  // us
+
 namespace {
 struct DataStore {
   wpi::SmallVector<uint8_t, 128> m_frame;
@@ -126,11 +135,37 @@ static void SetupUdp(wpi::uv::Loop& loop) {
   simLoopTimer->Start(Timer::Time{100}, Timer::Time{100});
 
   // UDP Receive then send
-  udp->received.connect([udpLocal = udp.get()](Buffer& buf, size_t len,
-                                               const sockaddr& recSock,
-                                               unsigned int port) {
+  struct Sequence {
+    bool valid = false;
+    uint16_t last = 0;
+    uint64_t lastReplyTime = 0;
+  };
+  auto sequence = std::make_shared<Sequence>();
+  udp->received.connect([udpLocal = udp.get(), sequence](
+                            Buffer& buf, size_t len, const sockaddr& recSock,
+                            unsigned int port) {
     auto ds = udpLocal->GetLoop()->GetData<halsim::DSCommPacket>();
+    if (gHighRate && len >= 2) {
+      uint16_t seq = (static_cast<uint8_t>(buf.base[0]) << 8) |
+                     static_cast<uint8_t>(buf.base[1]);
+      if (sequence->valid &&
+          static_cast<int16_t>(static_cast<uint16_t>(seq - sequence->last)) <=
+              0) {
+        return;
+      }
+      sequence->valid = true;
+      sequence->last = seq;
+    }
     ds->DecodeUDP({reinterpret_cast<uint8_t*>(buf.base), len});
+    ds->SendUDPToHALSim();
+
+    if (gHighRate) {
+      uint64_t now = wpi::Now();
+      if (now - sequence->lastReplyTime < kReplyPeriod) {
+        return;
+      }
+      sequence->lastReplyTime = now;
+    }
 
     struct sockaddr_in outAddr;
     std::memcpy(&outAddr, &recSock, sizeof(sockaddr_in));
@@ -149,7 +184,6 @@ static void SetupUdp(wpi::uv::Loop& loop) {
         std::fflush(stderr);
       }
     });
-    ds->SendUDPToHALSim();
   });
 
   udp->StartRecv();
@@ -185,6 +219,10 @@ __declspec(dllexport)
 
   HAL_RegisterExtension("ds_socket", &gDSConnected);
 
+  if (const char* highRate = std::getenv("HALSIMDS_HIGH_RATE")) {
+    gHighRate = std::string_view{highRate} != "0";
+  }
+
   singleByte = std::make_unique<Buffer>("0");
 
   eventLoopRunner = std::make_unique<wpi::EventLoopRunner>();
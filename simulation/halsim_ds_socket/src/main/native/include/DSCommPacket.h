@@ -22,6 +22,11 @@ class DSCommPacket {
   DSCommPacket(void);
   void DecodeTCP(wpi::span<const uint8_t> packet);
   void DecodeUDP(wpi::span<const uint8_t> packet);
+
+  /**
+   * Applies the state decoded from the last UDP packet to the simulated
+   * driver station and joysticks, and notifies of new data.
+   */
   void SendUDPToHALSim(void);
   void SetupSendBuffer(wpi::raw_uv_ostream& buf);
 
@@ -48,7 +53,6 @@ class DSCommPacket {
   static const uint8_t kRobotHasCode = 0x20;
 
  private:
-  void SendJoysticks(void);
   void SetControl(uint8_t control, uint8_t request);
   void SetAlliance(uint8_t station_code);
   void SetupSendHeader(wpi::raw_uv_ostream& buf);
@@ -9,8 +9,6 @@ class DSCommPacketTest : public ::testing::Test {
  public:
   DSCommPacketTest() = default;
 
-  void SendJoysticks() { commPacket.SendJoysticks(); }
-
   halsim::DSCommJoystickPacket& ReadJoystickTag(wpi::span<const uint8_t> data,
                                                 int index) {
     commPacket.ReadJoystickTag(data, index);
@@ -156,3 +154,32 @@ TEST_F(DSCommPacketTest, GameDataTag) {
   ASSERT_EQ(matchInfo.gameSpecificMessage[2], 'B');
   ASSERT_EQ(matchInfo.gameSpecificMessage[3], 'C');
 }
+
+TEST_F(DSCommPacketTest, SendUDPToHALSim) {
+  uint8_t arr[] = {// Sequence, comm version
+                   0, 1, 1,
+                   // Control (enabled, autonomous), request, alliance
+                   0x06, 0x10, 4,
+                   // Joystick tag: size, tag, 2 axes, 4 buttons, no POVs
+                   7, 12, 2, 0, 127, 4, 0x05, 0};
+  commPacket.DecodeUDP(arr);
+  commPacket.SendUDPToHALSim();
+
+  EXPECT_TRUE(HALSIM_GetDriverStationEnabled());
+  EXPECT_TRUE(HALSIM_GetDriverStationAutonomous());
+  EXPECT_FALSE(HALSIM_GetDriverStationTest());
+  EXPECT_TRUE(HALSIM_GetDriverStationDsAttached());
+  EXPECT_EQ(HAL_AllianceStationID_kBlue2,
+            HALSIM_GetDriverStationAllianceStationId());
+
+  HAL_JoystickAxes axes;
+  HALSIM_GetJoystickAxes(0, &axes);
+  EXPECT_EQ(axes.count, 2);
+  EXPECT_EQ(axes.axes[1], 1.0);
+  HAL_JoystickButtons buttons;
+  HALSIM_GetJoystickButtons(0, &buttons);
+  EXPECT_EQ(buttons.count, 4);
+  EXPECT_EQ(buttons.buttons, 0x05u);
+
+  HALSIM_ResetDriverStationData();
+}
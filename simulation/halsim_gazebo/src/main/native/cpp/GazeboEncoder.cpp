@@ -9,6 +9,8 @@
 #include <hal/simulation/EncoderData.h>
 #include <hal/simulation/NotifyListener.h>
 
+#include "GazeboSync.h"
+
 static void encoder_init_callback(const char* name, void* param,
                                   const struct HAL_Value* value) {
   GazeboEncoder* encoder = static_cast<GazeboEncoder*>(param);
@@ -48,6 +50,15 @@ GazeboEncoder::GazeboEncoder(int index, HALSimGazebo* halsim) {
 }
 
 void GazeboEncoder::Control(const char* command) {
+  if (m_halsim->sync->IsBatching()) {
+    /* Count from the position at start or reset, as the encoder plugin
+       does */
+    if (m_hasPosition)
+      m_zero = m_position;
+    else
+      m_zeroPending = true;
+    return;
+  }
   if (!m_pub) {
     m_pub = m_halsim->node.Advertise<gazebo::msgs::String>(
         fmt::format("~/simulator/encoder/dio/{}/control",
@@ -61,7 +72,8 @@ void GazeboEncoder::Control(const char* command) {
 }
 
 void GazeboEncoder::Listen() {
-  if (!m_sub)
+  /* In batch mode, positions are received by GazeboSync */
+  if (!m_sub && !m_halsim->sync->IsBatching())
     m_sub = m_halsim->node.Subscribe<gazebo::msgs::Float64>(
         fmt::format("~/simulator/encoder/dio/{}/position",
                     HALSIM_GetEncoderDigitalChannelA(m_index)),
@@ -71,3 +83,13 @@ void GazeboEncoder::Listen() {
 void GazeboEncoder::Callback(const gazebo::msgs::ConstFloat64Ptr& msg) {
   HALSIM_SetEncoderCount(m_index, msg->data() * (m_reverse ? -1 : 1));
 }
+
+void GazeboEncoder::SetPosition(double position) {
+  m_position = position;
+  m_hasPosition = true;
+  if (m_zeroPending) {
+    m_zero = position;
+    m_zeroPending = false;
+  }
+  HALSIM_SetEncoderCount(m_index, (position - m_zero) * (m_reverse ? -1 : 1));
+}
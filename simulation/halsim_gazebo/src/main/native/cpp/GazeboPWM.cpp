@@ -9,6 +9,7 @@
 #include <hal/simulation/NotifyListener.h>
 #include <hal/simulation/PWMData.h>
 
+#include "GazeboSync.h"
 #include "simulation/gz_msgs/msgs.h"
 
 static void init_callback(const char* name, void* param,
@@ -32,6 +33,10 @@ GazeboPWM::GazeboPWM(int port, HALSimGazebo* halsim) {
 }
 
 void GazeboPWM::Publish(double value) {
+  if (m_halsim->sync->IsBatching()) {
+    m_halsim->sync->QueuePWM(m_port, value);
+    return;
+  }
   if (!m_pub) {
     m_pub = m_halsim->node.Advertise<gazebo::msgs::Float64>(
         fmt::format("~/simulator/pwm/{}", m_port));
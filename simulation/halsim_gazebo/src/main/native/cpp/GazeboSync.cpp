@@ -0,0 +1,110 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "GazeboSync.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+#include <hal/simulation/EncoderData.h>
+#include <hal/simulation/MockHooks.h>
+
+#include "GazeboEncoder.h"
+
+static bool GetEnvFlag(const char* name) {
+  const char* value = std::getenv(name);
+  return value != nullptr && std::string_view{value} != "0";
+}
+
+GazeboSync::GazeboSync(HALSimGazebo* halsim) : m_halsim(halsim) {}
+
+void GazeboSync::Initialize() {
+  m_batch = GetEnvFlag("HALSIM_GAZEBO_BATCH");
+  m_lockStep = GetEnvFlag("HALSIM_GAZEBO_LOCKSTEP");
+  if (!m_batch && !m_lockStep)
+    return;
+
+  const char* clock = std::getenv("HALSIM_GAZEBO_CLOCK");
+  m_clockTopic = clock != nullptr ? clock : "/gazebo/frc/time";
+
+  if (m_batch) {
+    m_pwmPub = m_halsim->node.Advertise<gazebo::msgs::FRCChannels>(
+        "~/simulator/pwm_batch");
+    m_sensorSub = m_halsim->node.Subscribe<gazebo::msgs::FRCChannels>(
+        "~/simulator/sensors", &GazeboSync::SensorCallback, this);
+  }
+  if (m_lockStep) {
+    m_ackPub =
+        m_halsim->node.Advertise<gazebo::msgs::Float64>(m_clockTopic + "/ack");
+    HALSIM_PauseTiming();
+  }
+  m_clockSub = m_halsim->node.Subscribe<gazebo::msgs::Float64>(
+      m_clockTopic, &GazeboSync::ClockCallback, this);
+
+  std::cout << "Gazebo clock sync on " << m_clockTopic
+            << (m_batch ? ", batched" : "")
+            << (m_lockStep ? ", lock-step" : "") << std::endl;
+}
+
+void GazeboSync::QueuePWM(int port, double value) {
+  std::scoped_lock lock(m_pwmMutex);
+  m_pwm[port] = value;
+  m_pwmSet.set(port);
+}
+
+void GazeboSync::ClockCallback(const gazebo::msgs::ConstFloat64Ptr& msg) {
+  int64_t time = std::llround(msg->data() * 1e6);
+
+  /* Runs the robot program up to the Gazebo time; the first message only
+     sets the starting point */
+  if (m_lockStep && m_lastTime >= 0 && time > m_lastTime)
+    HALSIM_StepTiming(time - m_lastTime);
+  m_lastTime = time;
+
+  if (m_batch)
+    PublishPWMBatch(msg->data());
+
+  if (m_lockStep) {
+    gazebo::msgs::Float64 ack;
+    ack.set_data(msg->data());
+    m_ackPub->Publish(ack);
+  }
+}
+
+void GazeboSync::SensorCallback(const gazebo::msgs::ConstFRCChannelsPtr& msg) {
+  /* Encoder positions, by the encoder's channel A */
+  int count = std::min(msg->channel_size(), msg->value_size());
+  for (int i = 0; i < HALSimGazebo::kEncoderCount; i++) {
+    GazeboEncoder* encoder = m_halsim->encoders[i];
+    if (!encoder->IsInitialized())
+      continue;
+    int channel = HALSIM_GetEncoderDigitalChannelA(i);
+    for (int j = 0; j < count; j++) {
+      if (msg->channel(j) == channel) {
+        encoder->SetPosition(msg->value(j));
+        break;
+      }
+    }
+  }
+}
+
+void GazeboSync::PublishPWMBatch(double time) {
+  gazebo::msgs::FRCChannels msg;
+  {
+    std::scoped_lock lock(m_pwmMutex);
+    if (m_pwmSet.none())
+      return;
+    for (int i = 0; i < HALSimGazebo::kPWMCount; i++) {
+      if (m_pwmSet.test(i)) {
+        msg.add_channel(i);
+        msg.add_value(m_pwm[i]);
+      }
+    }
+  }
+  msg.set_time(time);
+  m_pwmPub->Publish(msg);
+}
@@ -11,6 +11,7 @@
 #include "GazeboEncoder.h"
 #include "GazeboPCM.h"
 #include "GazeboPWM.h"
+#include "GazeboSync.h"
 #include "HALSimGazebo.h"
 
 /* Currently, robots never terminate, so we keep a single static object
@@ -28,6 +29,8 @@ int HALSIM_InitExtension(void) {
   }
   std::cout << "Gazebo Simulator Connected." << std::endl;
 
+  halsim.sync = new GazeboSync(&halsim);
+
   for (int i = 0; i < HALSimGazebo::kPWMCount; i++)
     halsim.pwms[i] = new GazeboPWM(i, &halsim);
 
@@ -46,6 +49,8 @@ int HALSIM_InitExtension(void) {
   for (int i = 0; i < dio_count; i++)
     halsim.dios.push_back(new GazeboDIO(i, &halsim));
 
+  halsim.sync->Initialize();
+
   return 0;
 }
 }  // extern "C"
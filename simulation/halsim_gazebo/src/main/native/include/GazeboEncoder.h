@@ -15,6 +15,8 @@ class GazeboEncoder {
   void SetReverse(bool value) { m_reverse = value; }
   void Control(const char* command);
   void Listen(void);
+  /* Sets the position from a sensor batch */
+  void SetPosition(double position);
 
  private:
   HALSimGazebo* m_halsim;
@@ -22,6 +24,12 @@ class GazeboEncoder {
   bool m_initialized;
   bool m_reverse;
 
+  /* In batch mode, the raw position is received and zeroed here */
+  double m_position = 0;
+  double m_zero = 0;
+  bool m_hasPosition = false;
+  bool m_zeroPending = false;
+
   void Callback(const gazebo::msgs::ConstFloat64Ptr& msg);
 
   gazebo::transport::PublisherPtr m_pub;
@@ -0,0 +1,57 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <bitset>
+#include <mutex>
+#include <string>
+
+#include "HALSimGazebo.h"
+#include "simulation/gz_msgs/msgs.h"
+
+/* Synchronizes with the Gazebo clock plugin.  In batch mode, the PWM outputs
+   are published together in one message each Gazebo update, and the encoder
+   positions are received together in one message.  In lock-step mode, the
+   robot program's time is paused and stepped to each Gazebo update's time,
+   and the clock plugin waits for the step to be acknowledged. */
+class GazeboSync {
+ public:
+  explicit GazeboSync(HALSimGazebo* halsim);
+
+  /* Reads the configuration from the environment and subscribes to the
+     clock; must be called after connecting */
+  void Initialize();
+
+  bool IsBatching() const { return m_batch; }
+
+  /* Sets a PWM output to be sent in the next batch */
+  void QueuePWM(int port, double value);
+
+ private:
+  void ClockCallback(const gazebo::msgs::ConstFloat64Ptr& msg);
+  void SensorCallback(const gazebo::msgs::ConstFRCChannelsPtr& msg);
+  void PublishPWMBatch(double time);
+
+  HALSimGazebo* m_halsim;
+  bool m_batch = false;
+  bool m_lockStep = false;
+  std::string m_clockTopic;
+
+  /* The time of the last clock message, in microseconds; -1 if none */
+  int64_t m_lastTime = -1;
+
+  std::mutex m_pwmMutex;
+  double m_pwm[HALSimGazebo::kPWMCount] = {};
+  /* Every output that has been set is sent in each batch, so motors that
+     subscribe late or miss a message still get it */
+  std::bitset<HALSimGazebo::kPWMCount> m_pwmSet;
+
+  gazebo::transport::SubscriberPtr m_clockSub;
+  gazebo::transport::SubscriberPtr m_sensorSub;
+  gazebo::transport::PublisherPtr m_ackPub;
+  gazebo::transport::PublisherPtr m_pwmPub;
+};
@@ -13,6 +13,7 @@ class GazeboPCM;
 class GazeboEncoder;
 class GazeboAnalogIn;
 class GazeboDIO;
+class GazeboSync;
 
 class HALSimGazebo {
  public:
@@ -21,6 +22,7 @@ class HALSimGazebo {
   static const int kEncoderCount = 8;
 
   GazeboNode node;
+  GazeboSync* sync;
   GazeboPWM* pwms[kPWMCount];
   GazeboPCM* pcms[kPCMCount];
   GazeboEncoder* encoders[kEncoderCount];
@@ -1162,25 +1162,10 @@ static void DriverStationExecute() {
     return;
   }
 
-  double curTime = glfwGetTime();
-
-  // update system joysticks
-  gNumGlfwJoysticks = 0;
-  for (int i = 0; i <= GLFW_JOYSTICK_LAST; ++i) {
-    gGlfwJoysticks[i]->Update();
-    if (gGlfwJoysticks[i]->IsPresent()) {
-      gNumGlfwJoysticks = i + 1;
-    }
-  }
   for (auto&& joy : gKeyboardJoysticks) {
     joy->Update();
   }
 
-  // update robot joysticks
-  for (auto&& joy : gRobotJoysticks) {
-    joy.Update();
-  }
-
   bool isEnabled = HALSIM_GetDriverStationEnabled();
   bool isAuto = HALSIM_GetDriverStationAutonomous();
   bool isTest = HALSIM_GetDriverStationTest();
@@ -1230,16 +1215,38 @@ static void DriverStationExecute() {
     }
     ImGui::End();
   }
+}
+
+// Updates the HAL from the joysticks every 20 ms, independent of rendering
+static void DriverStationPeriodic() {
+  gFMSModel->Update();
+
+  if (IsDSDisabled()) {
+    return;
+  }
+
+  // update system joysticks; there are none when running headless
+  gNumGlfwJoysticks = 0;
+  if (wpi::gui::GetSystemWindow()) {
+    for (int i = 0; i <= GLFW_JOYSTICK_LAST; ++i) {
+      gGlfwJoysticks[i]->Update();
+      if (gGlfwJoysticks[i]->IsPresent()) {
+        gNumGlfwJoysticks = i + 1;
+      }
+    }
+  }
+
+  // update robot joysticks
+  for (auto&& joy : gRobotJoysticks) {
+    joy.Update();
+  }
 
   // Update HAL
   for (int i = 0; i < HAL_kMaxJoysticks; ++i) {
     gRobotJoysticks[i].SetHAL(i);
   }
 
-  // Send new data every 20 ms (may be slower depending on GUI refresh rate)
-  static double lastNewDataTime = 0.0;
-  if ((curTime - lastNewDataTime) > 0.02 && !HALSIM_IsTimingPaused()) {
-    lastNewDataTime = curTime;
+  if (!HALSIM_IsTimingPaused()) {
     HALSIM_NotifyDriverStationNewData();
   }
 }
@@ -1513,7 +1520,16 @@ void DriverStationGui::GlobalInit() {
   gFMSModel = std::make_unique<FMSSimModel>();
 
   wpi::gui::AddEarlyExecute(DriverStationExecute);
-  wpi::gui::AddEarlyExecute([] { gFMSModel->Update(); });
+  wpi::gui::AddPeriodicExecute(DriverStationPeriodic, 0.02);
+
+  // Robot state changes should be shown even when rendering is throttled
+  auto requestFrame = [](const char*, void*, const HAL_Value*) {
+    wpi::gui::RequestFrame();
+  };
+  HALSIM_RegisterDriverStationEnabledCallback(requestFrame, nullptr, false);
+  HALSIM_RegisterDriverStationAutonomousCallback(requestFrame, nullptr, false);
+  HALSIM_RegisterDriverStationTestCallback(requestFrame, nullptr, false);
+  HALSIM_RegisterDriverStationEStopCallback(requestFrame, nullptr, false);
   if (auto win = dsManager.AddWindow("FMS", [] {
         DisplayFMS(gFMSModel.get(), &gFMSModel->m_matchTimeEnabled);
       })) {
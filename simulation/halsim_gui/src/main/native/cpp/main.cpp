@@ -6,6 +6,7 @@
 #include <glass/other/Plot.h>
 
 #include <cstdio>
+#include <cstdlib>
 #include <string_view>
 
 #include <hal/Extensions.h>
@@ -37,6 +38,15 @@ namespace gui = wpi::gui;
 
 static glass::PlotProvider gPlotProvider{"Plot"};
 
+// Rendering is throttled to these frame periods when there is no user input
+static constexpr double kIdleFramePeriod = 0.1;
+static constexpr double kMinimizedFramePeriod = 1.0;
+
+static bool IsHeadless() {
+  const char* headless = std::getenv("HALSIMGUI_HEADLESS");
+  return headless && std::string_view{headless} != "0";
+}
+
 extern "C" {
 #if defined(WIN32) || defined(_WIN32)
 __declspec(dllexport)
@@ -45,6 +55,7 @@ __declspec(dllexport)
   std::puts("Simulator GUI Initializing.");
 
   gui::CreateContext();
+  gui::SetIdleFramePeriods(kIdleFramePeriod, kMinimizedFramePeriod);
   glass::CreateContext();
   HALSimGui::GlobalInit();
   DriverStationGui::GlobalInit();
@@ -98,24 +109,32 @@ __declspec(dllexport)
     }
   });
 
-  if (!gui::Initialize("Robot Simulation", 1280, 720)) {
-    return 0;
-  }
   HAL_RegisterExtensionListener(
       nullptr, [](void*, const char* name, void* data) {
         if (std::string_view{name} == "ds_socket") {
           DriverStationGui::SetDSSocketExtension(data);
         }
       });
+  // Creating the window is slow, and must happen on the main thread, so do
+  // it in main; the robot program starts on its own thread meanwhile.
   HAL_SetMain(
       nullptr,
       [](void*) {
-        gui::Main();
+        if (!IsHeadless() && gui::Initialize("Robot Simulation", 1280, 720)) {
+          std::puts("Simulator GUI Initialized!");
+          std::fflush(stdout);
+          gui::Main();
+        } else {
+          // Run without rendering until the robot program exits; the driver
+          // station keeps running
+          std::puts("Simulator GUI running headless.");
+          std::fflush(stdout);
+          gui::MainHeadless();
+        }
         glass::DestroyContext();
         gui::DestroyContext();
       },
       [](void*) { gui::Exit(); });
-  std::puts("Simulator GUI Initialized!");
 
   return 0;
 }
@@ -0,0 +1,174 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "HALSimShm.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <hal/HALBase.h>
+#include <hal/simulation/AnalogInData.h>
+#include <hal/simulation/DIOData.h>
+#include <hal/simulation/DriverStationData.h>
+#include <hal/simulation/EncoderData.h>
+#include <hal/simulation/MockHooks.h>
+#include <hal/simulation/PWMData.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace halsimshm;
+
+HALSimShm::~HALSimShm() {
+  m_running = false;
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+#ifdef __linux__
+  if (m_region) {
+    munmap(m_region, sizeof(Region));
+  }
+  if (m_fd != -1) {
+    close(m_fd);
+    shm_unlink(m_name.c_str());
+  }
+#endif
+}
+
+#ifdef __linux__
+
+bool HALSimShm::Initialize() {
+  const char* name = std::getenv("HALSIMSHM_NAME");
+  if (name != nullptr) {
+    m_name = name;
+  } else {
+    m_name = "/wpilib_halsim";
+  }
+
+  const char* lockStep = std::getenv("HALSIMSHM_LOCKSTEP");
+  m_lockStep = lockStep != nullptr && std::string_view{lockStep} != "0";
+
+  m_fd = shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (m_fd == -1) {
+    fmt::print(stderr, "HALSimShm: could not create '{}': {}\n", m_name,
+               std::strerror(errno));
+    return false;
+  }
+  if (ftruncate(m_fd, sizeof(Region)) == -1) {
+    fmt::print(stderr, "HALSimShm: could not size '{}': {}\n", m_name,
+               std::strerror(errno));
+    return false;
+  }
+  void* mem = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, m_fd, 0);
+  if (mem == MAP_FAILED) {
+    fmt::print(stderr, "HALSimShm: could not map '{}': {}\n", m_name,
+               std::strerror(errno));
+    return false;
+  }
+
+  // the region is zeroed by ftruncate
+  m_region = new (mem) Region;
+  m_region->size = sizeof(Region);
+  m_region->version = kVersion;
+  // the magic number is written last, so engines that see it see the rest
+  std::atomic_thread_fence(std::memory_order_release);
+  m_region->magic = kMagic;
+
+  if (m_lockStep) {
+    HALSIM_PauseTiming();
+  }
+  return true;
+}
+
+void HALSimShm::Start() {
+  m_running = true;
+  m_thread = std::thread([this] { Main(); });
+}
+
+void HALSimShm::Main() {
+  // wake periodically to check for shutdown
+  static constexpr timespec kTimeout{0, 100000000};
+
+  // a request made before the thread started is still answered
+  uint32_t lastRequest = m_region->response.load(std::memory_order_relaxed);
+  while (m_running) {
+    uint32_t request = m_region->request.load(std::memory_order_acquire);
+    if (request == lastRequest) {
+      FutexWait(&m_region->request, lastRequest, &kTimeout);
+      continue;
+    }
+    lastRequest = request;
+    HandleRequest(request);
+  }
+}
+
+void HALSimShm::HandleRequest(uint32_t request) {
+  Inputs inputs;
+  m_region->inputs.Read(&inputs);
+  for (int i = 0; i < kNumAnalogIn; ++i) {
+    if (HALSIM_GetAnalogInInitialized(i)) {
+      HALSIM_SetAnalogInVoltage(i, inputs.analogInVoltage[i]);
+    }
+  }
+  for (int i = 0; i < kNumEncoders; ++i) {
+    if (HALSIM_GetEncoderInitialized(i)) {
+      HALSIM_SetEncoderCount(i, inputs.encoderCount[i]);
+      HALSIM_SetEncoderPeriod(i, inputs.encoderPeriod[i]);
+    }
+  }
+  for (int i = 0; i < kNumDIO; ++i) {
+    if (HALSIM_GetDIOInitialized(i) && HALSIM_GetDIOIsInput(i)) {
+      HALSIM_SetDIOValue(i, inputs.dioValue[i]);
+    }
+  }
+
+  if (m_region->stepMicros != 0) {
+    HALSIM_StepTiming(m_region->stepMicros);
+  }
+
+  Outputs outputs{};
+  for (int i = 0; i < kNumPWM; ++i) {
+    outputs.pwmInitialized[i] = HALSIM_GetPWMInitialized(i);
+    if (outputs.pwmInitialized[i]) {
+      outputs.pwmSpeed[i] = HALSIM_GetPWMSpeed(i);
+    }
+  }
+  for (int i = 0; i < kNumDIO; ++i) {
+    if (HALSIM_GetDIOInitialized(i)) {
+      outputs.dioIsInput[i] = HALSIM_GetDIOIsInput(i);
+      outputs.dioValue[i] = !outputs.dioIsInput[i] && HALSIM_GetDIOValue(i);
+    }
+  }
+  outputs.enabled = HALSIM_GetDriverStationEnabled();
+  m_region->outputs.Write(outputs);
+
+  int32_t status = 0;
+  m_region->timeMicros = HAL_GetFPGATime(&status);
+  m_region->response.store(request, std::memory_order_release);
+  FutexWake(&m_region->response);
+}
+
+#else
+
+bool HALSimShm::Initialize() {
+  std::fputs("HALSimShm: only supported on Linux\n", stderr);
+  return false;
+}
+
+void HALSimShm::Start() {}
+
+void HALSimShm::Main() {}
+
+void HALSimShm::HandleRequest(uint32_t) {}
+
+#endif
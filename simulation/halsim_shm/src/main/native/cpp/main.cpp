@@ -0,0 +1,36 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cstdio>
+#include <memory>
+
+#include <fmt/format.h>
+#include <hal/Extensions.h>
+
+#include "HALSimShm.h"
+
+using namespace halsimshm;
+
+static std::unique_ptr<HALSimShm> gShm;
+
+extern "C" {
+#if defined(WIN32) || defined(_WIN32)
+__declspec(dllexport)
+#endif
+    int HALSIM_InitExtension(void) {
+  std::puts("HALSim Shared Memory Initializing.");
+
+  HAL_OnShutdown(nullptr, [](void*) { gShm.reset(); });
+
+  gShm = std::make_unique<HALSimShm>();
+  if (!gShm->Initialize()) {
+    gShm.reset();
+    return -1;
+  }
+  gShm->Start();
+
+  fmt::print("HALSim Shared Memory Initialized at '{}'\n", gShm->GetName());
+  return 0;
+}
+}  // extern "C"
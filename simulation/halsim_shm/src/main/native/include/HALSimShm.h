@@ -0,0 +1,44 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "HALSimShmRegion.h"
+
+namespace halsimshm {
+
+// Serves the shared memory region to a physics engine; see HALSimShmRegion.h
+class HALSimShm {
+ public:
+  HALSimShm() = default;
+  ~HALSimShm();
+
+  HALSimShm(const HALSimShm&) = delete;
+  HALSimShm& operator=(const HALSimShm&) = delete;
+
+  // Reads the configuration and creates the region; returns false on error
+  bool Initialize();
+  void Start();
+
+  const std::string& GetName() const { return m_name; }
+
+ private:
+  void Main();
+  void HandleRequest(uint32_t request);
+
+  std::string m_name;
+  bool m_lockStep = false;
+
+  int m_fd = -1;
+  Region* m_region = nullptr;
+
+  std::atomic<bool> m_running{false};
+  std::thread m_thread;
+};
+
+}  // namespace halsimshm
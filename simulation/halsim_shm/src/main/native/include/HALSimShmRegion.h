@@ -0,0 +1,150 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/*
+ * The layout of the shared memory region exchanged with a physics engine.
+ * This header has no dependencies besides the standard library so it can be
+ * used by the engine.
+ *
+ * The robot program publishes its outputs and the engine publishes the inputs,
+ * each block guarded by a seqlock so either side may read the other's block at
+ * any time without blocking its writer.
+ *
+ * The engine drives the exchange: after writing the inputs, it sets
+ * stepMicros and increments request (waking it as a futex).  The robot side
+ * applies the inputs, steps the simulation time by stepMicros if nonzero
+ * (waiting for the robot program's notifiers, as HALSIM_StepTiming() does),
+ * publishes the outputs, and sets response to the request (waking it as a
+ * futex).  With timing paused, this runs the robot program in lock-step with
+ * the engine.
+ */
+
+namespace halsimshm {
+
+inline constexpr uint32_t kMagic = 0x4d485348;  // "HSHM"
+inline constexpr uint32_t kVersion = 1;
+
+inline constexpr int kNumPWM = 20;
+inline constexpr int kNumDIO = 31;
+inline constexpr int kNumAnalogIn = 8;
+inline constexpr int kNumEncoders = 8;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "shared memory atomics must be lock free");
+
+// Written by the robot program
+struct Outputs {
+  double pwmSpeed[kNumPWM];
+  uint8_t pwmInitialized[kNumPWM];
+  // the value of DIOs configured as outputs
+  uint8_t dioValue[kNumDIO];
+  uint8_t dioIsInput[kNumDIO];
+  uint8_t enabled;
+};
+
+// Written by the engine
+struct Inputs {
+  double analogInVoltage[kNumAnalogIn];
+  int32_t encoderCount[kNumEncoders];
+  double encoderPeriod[kNumEncoders];
+  // applied only to DIOs configured as inputs
+  uint8_t dioValue[kNumDIO];
+};
+
+// A block with a single writer.  The sequence number is odd while the writer
+// is updating the data.
+template <typename T>
+struct SeqlockBlock {
+  std::atomic<uint32_t> seq{0};
+  T data;
+
+  void Write(const T& value) {
+    uint32_t s = seq.load(std::memory_order_relaxed);
+    seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&data, &value, sizeof(T));
+    seq.store(s + 2, std::memory_order_release);
+  }
+
+  void Read(T* value) const {
+    for (;;) {
+      uint32_t s1 = seq.load(std::memory_order_acquire);
+      if ((s1 & 1) != 0) {
+        continue;
+      }
+      std::memcpy(value, &data, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq.load(std::memory_order_relaxed) == s1) {
+        return;
+      }
+    }
+  }
+};
+
+struct Region {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;
+
+  // lock-step handshake; both are futex words
+  std::atomic<uint32_t> request;
+  std::atomic<uint32_t> response;
+
+  // the time to step by for the current request; 0 to only exchange data
+  uint64_t stepMicros;
+  // the simulated FPGA time after the last response
+  uint64_t timeMicros;
+
+  SeqlockBlock<Outputs> outputs;
+  SeqlockBlock<Inputs> inputs;
+};
+
+#ifdef __linux__
+// Waits until the word no longer holds expected, the timeout passes, or a
+// spurious wakeup.  The word is shared between processes, so the futex
+// operations can't be process private.
+inline void FutexWait(std::atomic<uint32_t>* word, uint32_t expected,
+                      const timespec* timeout = nullptr) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected,
+          timeout, nullptr, 0);
+}
+
+inline void FutexWake(std::atomic<uint32_t>* word) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT32_MAX,
+          nullptr, nullptr, 0);
+}
+
+// Engine side of an exchange: sends a request to step by stepMicros (or 0
+// to only exchange data) and waits for the robot side to respond.  The
+// inputs should be written first.
+inline void Exchange(Region* region, uint64_t stepMicros) {
+  region->stepMicros = stepMicros;
+  uint32_t request =
+      region->request.fetch_add(1, std::memory_order_acq_rel) + 1;
+  FutexWake(&region->request);
+  for (;;) {
+    uint32_t response = region->response.load(std::memory_order_acquire);
+    if (response == request) {
+      return;
+    }
+    FutexWait(&region->response, response);
+  }
+}
+#endif
+
+}  // namespace halsimshm
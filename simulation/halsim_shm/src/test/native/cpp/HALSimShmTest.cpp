@@ -0,0 +1,71 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <hal/HALBase.h>
+#include <hal/simulation/AnalogInData.h>
+#include <hal/simulation/EncoderData.h>
+#include <hal/simulation/MockHooks.h>
+#include <hal/simulation/PWMData.h>
+
+#include "HALSimShm.h"
+#include "gtest/gtest.h"
+
+using namespace halsimshm;
+
+TEST(HALSimShmTest, Exchange) {
+  setenv("HALSIMSHM_NAME", "/halsim_shm_test", 1);
+  setenv("HALSIMSHM_LOCKSTEP", "1", 1);
+
+  HALSimShm shm;
+  ASSERT_TRUE(shm.Initialize());
+  shm.Start();
+
+  // map the region as an engine would
+  int fd = shm_open("/halsim_shm_test", O_RDWR, 0);
+  ASSERT_NE(fd, -1);
+  void* mem = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0);
+  ASSERT_NE(mem, MAP_FAILED);
+  auto region = static_cast<Region*>(mem);
+  EXPECT_EQ(region->magic, kMagic);
+  EXPECT_EQ(region->version, kVersion);
+  EXPECT_EQ(region->size, sizeof(Region));
+
+  HALSIM_SetPWMInitialized(2, true);
+  HALSIM_SetPWMSpeed(2, 0.5);
+  HALSIM_SetEncoderInitialized(1, true);
+  HALSIM_SetAnalogInInitialized(0, true);
+
+  Inputs inputs{};
+  inputs.encoderCount[1] = 42;
+  inputs.analogInVoltage[0] = 2.5;
+  region->inputs.Write(inputs);
+
+  int32_t status = 0;
+  uint64_t start = HAL_GetFPGATime(&status);
+  Exchange(region, 20000);
+
+  EXPECT_EQ(HALSIM_GetEncoderCount(1), 42);
+  EXPECT_EQ(HALSIM_GetAnalogInVoltage(0), 2.5);
+  EXPECT_EQ(region->timeMicros - start, 20000u);
+
+  Outputs outputs;
+  region->outputs.Read(&outputs);
+  EXPECT_TRUE(outputs.pwmInitialized[2]);
+  EXPECT_EQ(outputs.pwmSpeed[2], 0.5);
+  EXPECT_FALSE(outputs.pwmInitialized[3]);
+
+  // an exchange without a step doesn't advance time
+  Exchange(region, 0);
+  EXPECT_EQ(region->timeMicros - start, 20000u);
+
+  munmap(mem, sizeof(Region));
+  close(fd);
+  HALSIM_ResumeTiming();
+}
@@ -5,6 +5,7 @@
 #include "HALSimWS.h"
 
 #include <cstdio>
+#include <string_view>
 
 #include <fmt/format.h>
 #include <wpi/SmallString.h>
@@ -66,6 +67,19 @@ bool HALSimWS::Initialize() {
     m_uri = "/wpilibws";
   }
 
+  const char* format = std::getenv("HALSIMWS_FORMAT");
+  if (format != nullptr) {
+    std::string_view formatStr{format};
+    if (formatStr == "cbor") {
+      m_format = HALSimWireFormat::kCbor;
+    } else if (formatStr == "msgpack") {
+      m_format = HALSimWireFormat::kMsgPack;
+    } else if (formatStr != "json") {
+      fmt::print(stderr, "Unknown HALSIMWS_FORMAT '{}'\n", formatStr);
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -148,13 +162,13 @@ void HALSimWS::CloseWebsocket(
   }
 }
 
-void HALSimWS::OnNetValueChanged(const wpi::json& msg) {
+void HALSimWS::OnNetValueChanged(const wpi::json_document::value& msg) {
   // Look for "type" and "device" fields so that we can
   // generate the key
 
   try {
-    auto& type = msg.at("type").get_ref<const std::string&>();
-    auto& device = msg.at("device").get_ref<const std::string&>();
+    auto type = msg.at("type").get_string();
+    auto device = msg.at("device").get_string();
 
     wpi::SmallString<64> key;
     key.append(type);
@@ -18,6 +18,7 @@
 #include <WSProvider_RoboRIO.h>
 #include <WSProvider_SimDevice.h>
 #include <WSProvider_Solenoid.h>
+#include <WSProvider_Timing.h>
 #include <WSProvider_dPWM.h>
 #include <wpi/EventLoopRunner.h>
 
@@ -51,6 +52,7 @@ bool HALSimWSClient::Initialize() {
     HALSimWSProviderRelay::Initialize(registerFunc);
     HALSimWSProviderRoboRIO::Initialize(registerFunc);
     HALSimWSProviderSolenoid::Initialize(registerFunc);
+    HALSimWSProviderTiming::Initialize(registerFunc);
 
     simDevices.Initialize(loop);
 
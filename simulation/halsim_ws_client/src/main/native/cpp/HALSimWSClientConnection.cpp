@@ -5,8 +5,11 @@
 #include "HALSimWSClientConnection.h"
 
 #include <cstdio>
+#include <string>
+#include <string_view>
 
 #include <fmt/format.h>
+#include <wpi/SmallVector.h>
 #include <wpi/raw_uv_ostream.h>
 
 #include "HALSimWS.h"
@@ -19,19 +22,33 @@ void HALSimWSClientConnection::Initialize() {
   // Get a shared pointer to ourselves
   auto self = this->shared_from_this();
 
+  // Offer compression; the repeated message keys compress well
+  wpi::WebSocket::ClientOptions options;
+  options.deflate.enable = true;
+
+  // Request a binary format; the server may not support it
+  wpi::SmallVector<std::string_view, 1> protocols;
+  auto protocol = GetWireProtocol(m_client->GetRequestedFormat());
+  if (!protocol.empty()) {
+    protocols.push_back(protocol);
+  }
+
   auto ws = wpi::WebSocket::CreateClient(
       *m_stream, m_client->GetTargetUri(),
       fmt::format("{}:{}", m_client->GetTargetHost(),
-                  m_client->GetTargetPort()));
+                  m_client->GetTargetPort()),
+      protocols, options);
 
   ws->SetData(self);
 
   m_websocket = ws.get();
 
   // Hook up events
-  m_websocket->open.connect_extended([this](auto conn, auto) {
+  m_websocket->open.connect_extended([this](auto conn, auto protocol) {
     conn.disconnect();
 
+    m_format = GetWireFormat(protocol);
+
     if (!m_client->RegisterWebsocket(shared_from_this())) {
       std::fputs("Unable to register websocket\n", stderr);
       return;
@@ -46,9 +63,8 @@ void HALSimWSClientConnection::Initialize() {
       return;
     }
 
-    wpi::json j;
     try {
-      j = wpi::json::parse(msg);
+      m_document.parse(msg);
     } catch (const wpi::json::parse_error& e) {
       std::string err("JSON parse failed: ");
       err += e.what();
@@ -57,7 +73,26 @@ void HALSimWSClientConnection::Initialize() {
       return;
     }
 
-    m_client->OnNetValueChanged(j);
+    m_client->OnNetValueChanged(m_document.root());
+  });
+
+  // binary messages are only used with a binary subprotocol
+  m_websocket->binary.connect([this](auto data, bool) {
+    if (!m_ws_connected || m_format == HALSimWireFormat::kJson) {
+      return;
+    }
+
+    try {
+      m_document.assign(ReadBinaryMessage(m_format, data));
+    } catch (const wpi::json::parse_error& e) {
+      std::string err("binary parse failed: ");
+      err += e.what();
+      fmt::print(stderr, "{}\n", err);
+      m_websocket->Fail(1003, err);
+      return;
+    }
+
+    m_client->OnNetValueChanged(m_document.root());
   });
 
   m_websocket->closed.connect([this](uint16_t, auto) {
@@ -80,21 +115,29 @@ void HALSimWSClientConnection::OnSimValueChanged(const wpi::json& msg) {
                            return m_buffers.Allocate();
                          }};
 
-  os << msg;
+  if (m_format == HALSimWireFormat::kJson) {
+    os << msg;
+  } else {
+    WriteBinaryMessage(os, m_format, msg);
+  }
 
   // Call the websocket send function on the uv loop
   m_client->GetExec().Send([self = shared_from_this(), sendBufs] {
-    self->m_websocket->SendText(sendBufs,
-                                [self](auto bufs, wpi::uv::Error err) {
-                                  {
-                                    std::lock_guard lock(self->m_buffers_mutex);
-                                    self->m_buffers.Release(bufs);
-                                  }
-
-                                  if (err) {
-                                    fmt::print(stderr, "{}\n", err.str());
-                                    std::fflush(stderr);
-                                  }
-                                });
+    auto callback = [self](auto bufs, wpi::uv::Error err) {
+      {
+        std::lock_guard lock(self->m_buffers_mutex);
+        self->m_buffers.Release(bufs);
+      }
+
+      if (err) {
+        fmt::print(stderr, "{}\n", err.str());
+        std::fflush(stderr);
+      }
+    };
+    if (self->m_format == HALSimWireFormat::kJson) {
+      self->m_websocket->SendText(sendBufs, callback);
+    } else {
+      self->m_websocket->SendBinary(sendBufs, callback);
+    }
   });
 }
@@ -8,17 +8,15 @@
 #include <memory>
 #include <string>
 
+#include <HALSimBinaryFormat.h>
 #include <WSProviderContainer.h>
 #include <WSProvider_SimDevice.h>
+#include <wpi/json_document.h>
 #include <wpi/uv/Async.h>
 #include <wpi/uv/Loop.h>
 #include <wpi/uv/Tcp.h>
 #include <wpi/uv/Timer.h>
 
-namespace wpi {
-class json;
-}  // namespace wpi
-
 namespace wpilibws {
 
 class HALSimWSClientConnection;
@@ -39,11 +37,12 @@ class HALSimWS : public std::enable_shared_from_this<HALSimWS> {
   bool RegisterWebsocket(std::shared_ptr<HALSimBaseWebSocketConnection> hws);
   void CloseWebsocket(std::shared_ptr<HALSimBaseWebSocketConnection> hws);
 
-  void OnNetValueChanged(const wpi::json& msg);
+  void OnNetValueChanged(const wpi::json_document::value& msg);
 
   const std::string& GetTargetHost() const { return m_host; }
   const std::string& GetTargetUri() const { return m_uri; }
   int GetTargetPort() const { return m_port; }
+  HALSimWireFormat GetRequestedFormat() const { return m_format; }
   wpi::uv::Loop& GetLoop() { return m_loop; }
 
   UvExecFunc& GetExec() { return *m_exec; }
@@ -67,6 +66,7 @@ class HALSimWS : public std::enable_shared_from_this<HALSimWS> {
   std::string m_host;
   std::string m_uri;
   int m_port;
+  HALSimWireFormat m_format = HALSimWireFormat::kJson;
 };
 
 }  // namespace wpilibws
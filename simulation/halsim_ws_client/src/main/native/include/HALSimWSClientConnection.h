@@ -8,7 +8,9 @@
 #include <utility>
 
 #include <HALSimBaseWebSocketConnection.h>
+#include <HALSimBinaryFormat.h>
 #include <wpi/WebSocket.h>
+#include <wpi/json_document.h>
 #include <wpi/mutex.h>
 #include <wpi/uv/Buffer.h>
 #include <wpi/uv/Stream.h>
@@ -44,6 +46,13 @@ class HALSimWSClientConnection
   bool m_ws_connected = false;
   wpi::WebSocket* m_websocket = nullptr;
 
+  // incoming messages are parsed into this, reusing its memory
+  wpi::json_document m_document;
+
+  // the message encoding, from the negotiated subprotocol; only written
+  // before the websocket is registered
+  HALSimWireFormat m_format = HALSimWireFormat::kJson;
+
   wpi::uv::SimpleBufferPool<4> m_buffers;
   std::mutex m_buffers_mutex;
 };
@@ -0,0 +1,159 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "HALSimBinaryFormat.h"
+
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <wpi/StringMap.h>
+#include <wpi/raw_ostream.h>
+
+using namespace wpilibws;
+
+// The integer codes of the standard data keys are their indices.  This is part
+// of the protocol: new keys must only be added at the end.
+static constexpr std::string_view kKeys[] = {
+    // 0
+    "<init", "<>value", "<input", "<duty_cycle", "<dio_pin", "<speed",
+    "<position", "<raw", "<period_scale", "<zero_latch",
+    // 10
+    "<fwd", "<rev", "<init_fwd", "<init_rev", "<output", "<closed_loop",
+    "<voltage", "<range", "<avg_bits", "<oversample_bits",
+    // 20
+    "<accum_init", "<accum_center", "<accum_deadband", "<channel_a",
+    "<channel_b", "<samples_to_avg", "<reverse_direction", "<length",
+    "<running", "<outputs",
+    // 30
+    "<output_port", "<pulse_length", "<rumble_left", "<rumble_right", ">x",
+    ">y", ">z", ">voltage", ">accum_count", ">accum_value",
+    // 40
+    ">count", ">period", ">new_data", ">enabled", ">autonomous", ">test",
+    ">estop", ">fms", ">ds", ">station",
+    // 50
+    ">match_time", ">game_data", ">axes", ">buttons", ">povs", ">on",
+    ">pressure_switch", ">current", ">data", ">fpga_button",
+    // 60
+    ">vin_voltage", ">vin_current", ">6v_voltage", ">6v_current",
+    ">6v_active", ">6v_faults", ">5v_voltage", ">5v_current", ">5v_active",
+    ">5v_faults",
+    // 70
+    ">3v3_voltage", ">3v3_current", ">3v3_active", ">3v3_faults", ">pause",
+    ">step", "<stepped", "<time"};
+
+static const wpi::StringMap<int>& GetKeyCodes() {
+  static const wpi::StringMap<int> codes = [] {
+    wpi::StringMap<int> codes;
+    for (size_t i = 0; i < std::size(kKeys); ++i) {
+      codes.try_emplace(kKeys[i], static_cast<int>(i));
+    }
+    return codes;
+  }();
+  return codes;
+}
+
+static wpi::json Compact(const wpi::json& msg) {
+  if (msg.is_array()) {
+    wpi::json msgs = wpi::json::array();
+    for (auto&& m : msg) {
+      msgs.push_back(Compact(m));
+    }
+    return msgs;
+  }
+
+  auto type = msg.find("type");
+  auto device = msg.find("device");
+  auto data = msg.find("data");
+  if (type == msg.end() || device == msg.end() || data == msg.end() ||
+      !data->is_object()) {
+    return msg;
+  }
+
+  auto& codes = GetKeyCodes();
+  wpi::json fields = wpi::json::array();
+  for (auto field = data->begin(); field != data->end(); ++field) {
+    auto code = codes.find(field.key());
+    if (code != codes.end()) {
+      fields.push_back(code->second);
+    } else {
+      fields.push_back(field.key());
+    }
+    fields.push_back(field.value());
+  }
+  return wpi::json::array({*type, *device, std::move(fields)});
+}
+
+static wpi::json Expand(const wpi::json& msg) {
+  if (!msg.is_array() || msg.empty()) {
+    return msg;
+  }
+
+  // an array of messages
+  if (msg[0].is_array()) {
+    wpi::json msgs = wpi::json::array();
+    for (auto&& m : msg) {
+      msgs.push_back(Expand(m));
+    }
+    return msgs;
+  }
+
+  if (msg.size() != 3 || !msg[2].is_array()) {
+    return msg;
+  }
+
+  auto& fields = msg[2];
+  wpi::json data = wpi::json::object();
+  for (size_t i = 0; i + 1 < fields.size(); i += 2) {
+    auto& key = fields[i];
+    if (key.is_string()) {
+      data[key.get_ref<const std::string&>()] = fields[i + 1];
+    } else if (key.is_number_unsigned() &&
+               key.get<uint64_t>() < std::size(kKeys)) {
+      data[kKeys[key.get<uint64_t>()]] = fields[i + 1];
+    }
+    // unknown codes are ignored, like unknown keys
+  }
+  return {{"type", msg[0]}, {"device", msg[1]}, {"data", std::move(data)}};
+}
+
+HALSimWireFormat wpilibws::GetWireFormat(std::string_view protocol) {
+  if (protocol == kCborProtocol) {
+    return HALSimWireFormat::kCbor;
+  } else if (protocol == kMsgPackProtocol) {
+    return HALSimWireFormat::kMsgPack;
+  } else {
+    return HALSimWireFormat::kJson;
+  }
+}
+
+std::string_view wpilibws::GetWireProtocol(HALSimWireFormat format) {
+  switch (format) {
+    case HALSimWireFormat::kCbor:
+      return kCborProtocol;
+    case HALSimWireFormat::kMsgPack:
+      return kMsgPackProtocol;
+    default:
+      return {};
+  }
+}
+
+void wpilibws::WriteBinaryMessage(wpi::raw_ostream& os,
+                                  HALSimWireFormat format,
+                                  const wpi::json& msg) {
+  if (format == HALSimWireFormat::kMsgPack) {
+    wpi::json::to_msgpack(os, Compact(msg));
+  } else {
+    wpi::json::to_cbor(os, Compact(msg));
+  }
+}
+
+wpi::json wpilibws::ReadBinaryMessage(HALSimWireFormat format,
+                                      wpi::span<const uint8_t> data) {
+  if (format == HALSimWireFormat::kMsgPack) {
+    return Expand(wpi::json::from_msgpack(data));
+  } else {
+    return Expand(wpi::json::from_cbor(data));
+  }
+}
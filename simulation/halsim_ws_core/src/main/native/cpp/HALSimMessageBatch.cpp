@@ -0,0 +1,48 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "HALSimMessageBatch.h"
+
+#include <string>
+#include <utility>
+
+using namespace wpilibws;
+
+void HALSimMessageBatch::Add(const wpi::json& msg) {
+  auto type = msg.find("type");
+  auto device = msg.find("device");
+  auto data = msg.find("data");
+  if (type == msg.end() || !type->is_string() || device == msg.end() ||
+      !device->is_string() || data == msg.end() || !data->is_object()) {
+    // can't be merged; send as-is
+    m_messages.emplace_back(msg);
+    return;
+  }
+
+  // types never contain a slash, so this is unique
+  std::string key = type->get_ref<const std::string&>();
+  key += '/';
+  key += device->get_ref<const std::string&>();
+
+  auto [it, inserted] = m_indices.try_emplace(key, m_messages.size());
+  if (inserted) {
+    m_messages.emplace_back(msg);
+    return;
+  }
+
+  auto& pending = m_messages[it->second]["data"];
+  for (auto field = data->begin(); field != data->end(); ++field) {
+    pending[field.key()] = field.value();
+  }
+}
+
+wpi::json HALSimMessageBatch::Take() {
+  wpi::json msgs = wpi::json::array();
+  for (auto&& msg : m_messages) {
+    msgs.push_back(std::move(msg));
+  }
+  m_messages.clear();
+  m_indices.clear();
+  return msgs;
+}
@@ -95,16 +95,17 @@ void HALSimWSProviderAnalogIn::DoCancelCallbacks() {
   m_accumDeadbandCbKey = 0;
 }
 
-void HALSimWSProviderAnalogIn::OnNetValueChanged(const wpi::json& json) {
-  wpi::json::const_iterator it;
-  if ((it = json.find(">voltage")) != json.end()) {
-    HALSIM_SetAnalogInVoltage(m_channel, it.value());
+void HALSimWSProviderAnalogIn::OnNetValueChanged(
+    const wpi::json_document::value& json) {
+  const wpi::json_document::value* it;
+  if ((it = json.find(">voltage"))) {
+    HALSIM_SetAnalogInVoltage(m_channel, it->get<double>());
   }
-  if ((it = json.find(">accum_value")) != json.end()) {
-    HALSIM_SetAnalogInAccumulatorValue(m_channel, it.value());
+  if ((it = json.find(">accum_value"))) {
+    HALSIM_SetAnalogInAccumulatorValue(m_channel, it->get<int64_t>());
   }
-  if ((it = json.find(">accum_count")) != json.end()) {
-    HALSIM_SetAnalogInAccumulatorCount(m_channel, it.value());
+  if ((it = json.find(">accum_count"))) {
+    HALSIM_SetAnalogInAccumulatorCount(m_channel, it->get<int64_t>());
   }
 }
 
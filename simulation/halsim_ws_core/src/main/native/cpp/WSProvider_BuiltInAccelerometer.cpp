@@ -78,16 +78,16 @@ void HALSimWSProviderBuiltInAccelerometer::DoCancelCallbacks() {
 }
 
 void HALSimWSProviderBuiltInAccelerometer::OnNetValueChanged(
-    const wpi::json& json) {
-  wpi::json::const_iterator it;
-  if ((it = json.find(">x")) != json.end()) {
-    HALSIM_SetAccelerometerX(0, it.value());
+    const wpi::json_document::value& json) {
+  const wpi::json_document::value* it;
+  if ((it = json.find(">x"))) {
+    HALSIM_SetAccelerometerX(0, it->get<double>());
   }
-  if ((it = json.find(">y")) != json.end()) {
-    HALSIM_SetAccelerometerY(0, it.value());
+  if ((it = json.find(">y"))) {
+    HALSIM_SetAccelerometerY(0, it->get<double>());
   }
-  if ((it = json.find(">z")) != json.end()) {
-    HALSIM_SetAccelerometerZ(0, it.value());
+  if ((it = json.find(">z"))) {
+    HALSIM_SetAccelerometerZ(0, it->get<double>());
   }
 }
 
@@ -50,10 +50,11 @@ void HALSimWSProviderDIO::DoCancelCallbacks() {
   m_inputCbKey = 0;
 }
 
-void HALSimWSProviderDIO::OnNetValueChanged(const wpi::json& json) {
-  wpi::json::const_iterator it;
-  if ((it = json.find("<>value")) != json.end()) {
-    HALSIM_SetDIOValue(m_channel, static_cast<bool>(it.value()));
+void HALSimWSProviderDIO::OnNetValueChanged(
+    const wpi::json_document::value& json) {
+  const wpi::json_document::value* it;
+  if ((it = json.find("<>value"))) {
+    HALSIM_SetDIOValue(m_channel, it->get<bool>());
   }
 }
 
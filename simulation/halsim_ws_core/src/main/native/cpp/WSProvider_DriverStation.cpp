@@ -119,34 +119,35 @@ void HALSimWSProviderDriverStation::DoCancelCallbacks() {
   m_matchTimeCbKey = 0;
 }
 
-void HALSimWSProviderDriverStation::OnNetValueChanged(const wpi::json& json) {
+void HALSimWSProviderDriverStation::OnNetValueChanged(
+    const wpi::json_document::value& json) {
   // ignore if DS connected
   if (gDSSocketConnected && *gDSSocketConnected) {
     return;
   }
 
-  wpi::json::const_iterator it;
-  if ((it = json.find(">enabled")) != json.end()) {
-    HALSIM_SetDriverStationEnabled(it.value());
+  const wpi::json_document::value* it;
+  if ((it = json.find(">enabled"))) {
+    HALSIM_SetDriverStationEnabled(it->get<HAL_Bool>());
   }
-  if ((it = json.find(">autonomous")) != json.end()) {
-    HALSIM_SetDriverStationAutonomous(it.value());
+  if ((it = json.find(">autonomous"))) {
+    HALSIM_SetDriverStationAutonomous(it->get<HAL_Bool>());
   }
-  if ((it = json.find(">test")) != json.end()) {
-    HALSIM_SetDriverStationTest(it.value());
+  if ((it = json.find(">test"))) {
+    HALSIM_SetDriverStationTest(it->get<HAL_Bool>());
   }
-  if ((it = json.find(">estop")) != json.end()) {
-    HALSIM_SetDriverStationEStop(it.value());
+  if ((it = json.find(">estop"))) {
+    HALSIM_SetDriverStationEStop(it->get<HAL_Bool>());
   }
-  if ((it = json.find(">fms")) != json.end()) {
-    HALSIM_SetDriverStationFmsAttached(it.value());
+  if ((it = json.find(">fms"))) {
+    HALSIM_SetDriverStationFmsAttached(it->get<HAL_Bool>());
   }
-  if ((it = json.find(">ds")) != json.end()) {
-    HALSIM_SetDriverStationDsAttached(it.value());
+  if ((it = json.find(">ds"))) {
+    HALSIM_SetDriverStationDsAttached(it->get<HAL_Bool>());
   }
 
-  if ((it = json.find(">station")) != json.end()) {
-    auto& station = it.value().get_ref<const std::string&>();
+  if ((it = json.find(">station"))) {
+    auto station = it->get_string();
     if (station == "red1") {
       HALSIM_SetDriverStationAllianceStationId(HAL_AllianceStationID_kRed1);
     } else if (station == "red2") {
@@ -162,16 +163,16 @@ void HALSimWSProviderDriverStation::OnNetValueChanged(const wpi::json& json) {
     }
   }
 
-  if ((it = json.find(">match_time")) != json.end()) {
-    HALSIM_SetDriverStationMatchTime(it.value());
+  if ((it = json.find(">match_time"))) {
+    HALSIM_SetDriverStationMatchTime(it->get<double>());
   }
-  if ((it = json.find(">game_data")) != json.end()) {
-    HALSIM_SetGameSpecificMessage(
-        it.value().get_ref<const std::string&>().c_str());
+  if ((it = json.find(">game_data"))) {
+    // the document's strings are null-terminated
+    HALSIM_SetGameSpecificMessage(it->get_string().data());
   }
 
   // Only notify usercode if we get the new data message
-  if ((it = json.find(">new_data")) != json.end()) {
+  if ((it = json.find(">new_data"))) {
     HALSIM_NotifyDriverStationNewData();
   }
 }
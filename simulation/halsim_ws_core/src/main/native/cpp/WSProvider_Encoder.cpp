@@ -95,14 +95,15 @@ void HALSimWSProviderEncoder::DoCancelCallbacks() {
   m_samplesCbKey = 0;
 }
 
-void HALSimWSProviderEncoder::OnNetValueChanged(const wpi::json& json) {
-  wpi::json::const_iterator it;
-  if ((it = json.find(">count")) != json.end()) {
+void HALSimWSProviderEncoder::OnNetValueChanged(
+    const wpi::json_document::value& json) {
+  const wpi::json_document::value* it;
+  if ((it = json.find(">count"))) {
     HALSIM_SetEncoderCount(m_channel,
-                           static_cast<int32_t>(it.value()) - m_countOffset);
+                           it->get<int32_t>() - m_countOffset);
   }
-  if ((it = json.find(">period")) != json.end()) {
-    HALSIM_SetEncoderPeriod(m_channel, it.value());
+  if ((it = json.find(">period"))) {
+    HALSIM_SetEncoderPeriod(m_channel, it->get<double>());
   }
 }
 
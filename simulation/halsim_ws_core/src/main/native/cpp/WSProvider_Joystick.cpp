@@ -85,31 +85,30 @@ void HALSimWSProviderJoystick::DoCancelCallbacks() {
   m_dsNewDataCbKey = 0;
 }
 
-void HALSimWSProviderJoystick::OnNetValueChanged(const wpi::json& json) {
+void HALSimWSProviderJoystick::OnNetValueChanged(
+    const wpi::json_document::value& json) {
   // ignore if DS connected
   if (gDSSocketConnected && *gDSSocketConnected) {
     return;
   }
 
-  wpi::json::const_iterator it;
-  if ((it = json.find(">axes")) != json.end()) {
+  const wpi::json_document::value* it;
+  if ((it = json.find(">axes"))) {
     HAL_JoystickAxes axes{};
     axes.count =
-        std::min(it.value().size(),
-                 static_cast<wpi::json::size_type>(HAL_kMaxJoystickAxes));
+        std::min(it->size(), static_cast<size_t>(HAL_kMaxJoystickAxes));
     for (int i = 0; i < axes.count; i++) {
-      axes.axes[i] = it.value()[i];
+      axes.axes[i] = it->at(i).get<float>();
     }
 
     HALSIM_SetJoystickAxes(m_channel, &axes);
   }
 
-  if ((it = json.find(">buttons")) != json.end()) {
+  if ((it = json.find(">buttons"))) {
     HAL_JoystickButtons buttons{};
-    buttons.count =
-        std::min(it.value().size(), static_cast<wpi::json::size_type>(32));
+    buttons.count = std::min(it->size(), static_cast<size_t>(32));
     for (int i = 0; i < buttons.count; i++) {
-      if (it.value()[i]) {
+      if (it->at(i).get<bool>()) {
         buttons.buttons |= 1 << i;
       }
     }
@@ -117,13 +116,12 @@ void HALSimWSProviderJoystick::OnNetValueChanged(const wpi::json& json) {
     HALSIM_SetJoystickButtons(m_channel, &buttons);
   }
 
-  if ((it = json.find(">povs")) != json.end()) {
+  if ((it = json.find(">povs"))) {
     HAL_JoystickPOVs povs{};
     povs.count =
-        std::min(it.value().size(),
-                 static_cast<wpi::json::size_type>(HAL_kMaxJoystickPOVs));
+        std::min(it->size(), static_cast<size_t>(HAL_kMaxJoystickPOVs));
     for (int i = 0; i < povs.count; i++) {
-      povs.povs[i] = it.value()[i];
+      povs.povs[i] = it->at(i).get<int16_t>();
     }
 
     HALSIM_SetJoystickPOVs(m_channel, &povs);
@@ -87,56 +87,57 @@ void HALSimWSProviderRoboRIO::DoCancelCallbacks() {
   m_3v3VoltageCbKey = 0;
 }
 
-void HALSimWSProviderRoboRIO::OnNetValueChanged(const wpi::json& json) {
-  wpi::json::const_iterator it;
-  if ((it = json.find(">fpga_button")) != json.end()) {
-    HALSIM_SetRoboRioFPGAButton(static_cast<bool>(it.value()));
+void HALSimWSProviderRoboRIO::OnNetValueChanged(
+    const wpi::json_document::value& json) {
+  const wpi::json_document::value* it;
+  if ((it = json.find(">fpga_button"))) {
+    HALSIM_SetRoboRioFPGAButton(it->get<bool>());
   }
 
-  if ((it = json.find(">vin_voltage")) != json.end()) {
-    HALSIM_SetRoboRioVInVoltage(it.value());
+  if ((it = json.find(">vin_voltage"))) {
+    HALSIM_SetRoboRioVInVoltage(it->get<double>());
   }
-  if ((it = json.find(">vin_current")) != json.end()) {
-    HALSIM_SetRoboRioVInCurrent(it.value());
+  if ((it = json.find(">vin_current"))) {
+    HALSIM_SetRoboRioVInCurrent(it->get<double>());
   }
 
-  if ((it = json.find(">6v_voltage")) != json.end()) {
-    HALSIM_SetRoboRioUserVoltage6V(it.value());
+  if ((it = json.find(">6v_voltage"))) {
+    HALSIM_SetRoboRioUserVoltage6V(it->get<double>());
   }
-  if ((it = json.find(">6v_current")) != json.end()) {
-    HALSIM_SetRoboRioUserCurrent6V(it.value());
+  if ((it = json.find(">6v_current"))) {
+    HALSIM_SetRoboRioUserCurrent6V(it->get<double>());
   }
-  if ((it = json.find(">6v_active")) != json.end()) {
-    HALSIM_SetRoboRioUserActive6V(static_cast<bool>(it.value()));
+  if ((it = json.find(">6v_active"))) {
+    HALSIM_SetRoboRioUserActive6V(it->get<bool>());
   }
-  if ((it = json.find(">6v_faults")) != json.end()) {
-    HALSIM_SetRoboRioUserFaults6V(it.value());
+  if ((it = json.find(">6v_faults"))) {
+    HALSIM_SetRoboRioUserFaults6V(it->get<int32_t>());
   }
 
-  if ((it = json.find(">5v_voltage")) != json.end()) {
-    HALSIM_SetRoboRioUserVoltage5V(it.value());
+  if ((it = json.find(">5v_voltage"))) {
+    HALSIM_SetRoboRioUserVoltage5V(it->get<double>());
   }
-  if ((it = json.find(">5v_current")) != json.end()) {
-    HALSIM_SetRoboRioUserCurrent5V(it.value());
+  if ((it = json.find(">5v_current"))) {
+    HALSIM_SetRoboRioUserCurrent5V(it->get<double>());
   }
-  if ((it = json.find(">5v_active")) != json.end()) {
-    HALSIM_SetRoboRioUserActive5V(static_cast<bool>(it.value()));
+  if ((it = json.find(">5v_active"))) {
+    HALSIM_SetRoboRioUserActive5V(it->get<bool>());
   }
-  if ((it = json.find(">5v_faults")) != json.end()) {
-    HALSIM_SetRoboRioUserFaults5V(it.value());
+  if ((it = json.find(">5v_faults"))) {
+    HALSIM_SetRoboRioUserFaults5V(it->get<int32_t>());
   }
 
-  if ((it = json.find(">3v3_voltage")) != json.end()) {
-    HALSIM_SetRoboRioUserVoltage3V3(it.value());
+  if ((it = json.find(">3v3_voltage"))) {
+    HALSIM_SetRoboRioUserVoltage3V3(it->get<double>());
   }
-  if ((it = json.find(">3v3_current")) != json.end()) {
-    HALSIM_SetRoboRioUserCurrent3V3(it.value());
+  if ((it = json.find(">3v3_current"))) {
+    HALSIM_SetRoboRioUserCurrent3V3(it->get<double>());
   }
-  if ((it = json.find(">3v3_active")) != json.end()) {
-    HALSIM_SetRoboRioUserActive3V3(static_cast<bool>(it.value()));
+  if ((it = json.find(">3v3_active"))) {
+    HALSIM_SetRoboRioUserActive3V3(it->get<bool>());
   }
-  if ((it = json.find(">3v3_faults")) != json.end()) {
-    HALSIM_SetRoboRioUserFaults3V3(it.value());
+  if ((it = json.find(">3v3_faults"))) {
+    HALSIM_SetRoboRioUserFaults3V3(it->get<int32_t>());
   }
 }
 
@@ -57,37 +57,36 @@ void HALSimWSProviderSimDevice::CancelCallbacks() {
   m_simValueChangedCbKeys.clear();
 }
 
-void HALSimWSProviderSimDevice::OnNetValueChanged(const wpi::json& json) {
-  auto it = json.cbegin();
-  auto end = json.cend();
-
+void HALSimWSProviderSimDevice::OnNetValueChanged(
+    const wpi::json_document::value& json) {
   std::shared_lock lock(m_vhLock);
-  for (; it != end; ++it) {
-    auto vd = m_valueHandles.find(it.key());
+  for (auto&& member : json.members()) {
+    auto& jvalue = member.val;
+    auto vd = m_valueHandles.find(member.key);
     if (vd != m_valueHandles.end()) {
       HAL_Value value;
       value.type = vd->second->valueType;
       switch (value.type) {
         case HAL_BOOLEAN:
-          value.data.v_boolean = static_cast<bool>(it.value()) ? 1 : 0;
+          value.data.v_boolean = jvalue.get<bool>() ? 1 : 0;
           break;
         case HAL_DOUBLE:
-          value.data.v_double = it.value();
+          value.data.v_double = jvalue.get<double>();
           value.data.v_double -= vd->second->doubleOffset;
           break;
         case HAL_ENUM: {
-          if (it->is_string()) {
+          if (jvalue.is_string()) {
             auto& options = vd->second->options;
-            auto& str = it.value().get_ref<const std::string&>();
+            auto str = jvalue.get_string();
             auto optionIt =
                 std::find_if(options.begin(), options.end(),
                              [&](const std::string& v) { return v == str; });
             if (optionIt != options.end()) {
               value.data.v_enum = optionIt - options.begin();
             }
-          } else if (it->is_number()) {
+          } else if (jvalue.is_number()) {
             auto& values = vd->second->optionValues;
-            double num = it.value();
+            double num = jvalue.get<double>();
             auto valueIt = std::find_if(
                 values.begin(), values.end(),
                 [&](double v) { return std::fabs(v - num) < 1e-4; });
@@ -95,15 +94,15 @@ void HALSimWSProviderSimDevice::OnNetValueChanged(const wpi::json& json) {
               value.data.v_enum = valueIt - values.begin();
             }
           }
-          value.data.v_enum = it.value();
+          value.data.v_enum = jvalue.get<int32_t>();
           break;
         }
         case HAL_INT:
-          value.data.v_int = it.value();
+          value.data.v_int = jvalue.get<int32_t>();
           value.data.v_int -= vd->second->intOffset;
           break;
         case HAL_LONG:
-          value.data.v_long = it.value();
+          value.data.v_long = jvalue.get<int64_t>();
           value.data.v_long -= vd->second->intOffset;
           break;
         default:
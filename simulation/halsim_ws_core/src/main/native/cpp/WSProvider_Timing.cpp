@@ -0,0 +1,94 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "WSProvider_Timing.h"
+
+#include <hal/HALBase.h>
+#include <hal/simulation/MockHooks.h>
+
+namespace wpilibws {
+
+void HALSimWSProviderTiming::Initialize(WSRegisterFunc webRegisterFunc) {
+  CreateSingleProvider<HALSimWSProviderTiming>("Timing", webRegisterFunc);
+}
+
+HALSimWSProviderTiming::~HALSimWSProviderTiming() {
+  {
+    std::scoped_lock lock(m_mutex);
+    m_active = false;
+  }
+  m_cond.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+void HALSimWSProviderTiming::CancelCallbacks() {
+  // drop the commands of a client that's gone, and don't leave the robot
+  // program paused for it
+  std::scoped_lock lock(m_mutex);
+  m_commands.clear();
+  if (m_paused) {
+    m_commands.push_back({Command::kResume});
+    m_cond.notify_all();
+  }
+}
+
+void HALSimWSProviderTiming::OnNetValueChanged(
+    const wpi::json_document::value& json) {
+  const wpi::json_document::value* it;
+  if ((it = json.find(">pause"))) {
+    Enqueue({it->get<bool>() ? Command::kPause : Command::kResume});
+  }
+  if ((it = json.find(">step"))) {
+    auto step = it->get<int64_t>();
+    if (step > 0) {
+      Enqueue({Command::kStep, static_cast<uint64_t>(step)});
+    }
+  }
+}
+
+void HALSimWSProviderTiming::Enqueue(Command command) {
+  std::scoped_lock lock(m_mutex);
+  if (!m_thread.joinable()) {
+    m_thread = std::thread([this] { Main(); });
+  }
+  m_commands.push_back(command);
+  m_cond.notify_all();
+}
+
+void HALSimWSProviderTiming::Main() {
+  std::unique_lock lock(m_mutex);
+  for (;;) {
+    m_cond.wait(lock, [&] { return !m_active || !m_commands.empty(); });
+    if (!m_active) {
+      break;
+    }
+    auto command = m_commands.front();
+    m_commands.pop_front();
+    switch (command.kind) {
+      case Command::kPause:
+        m_paused = true;
+        HALSIM_PauseTiming();
+        break;
+      case Command::kResume:
+        m_paused = false;
+        HALSIM_ResumeTiming();
+        break;
+      case Command::kStep: {
+        lock.unlock();
+        // waits for the robot program's notifiers; the acknowledgement is
+        // sent after the values they changed
+        HALSIM_StepTiming(command.step);
+        int32_t status = 0;
+        ProcessHalCallback({{"<stepped", command.step},
+                            {"<time", HAL_GetFPGATime(&status)}});
+        lock.lock();
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace wpilibws
@@ -0,0 +1,46 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string_view>
+
+#include <wpi/json.h>
+#include <wpi/span.h>
+
+namespace wpi {
+class raw_ostream;
+}  // namespace wpi
+
+namespace wpilibws {
+
+// The encoding of the messages on a websocket, selected by its subprotocol
+enum class HALSimWireFormat { kJson, kCbor, kMsgPack };
+
+// Subprotocol names of the binary formats; without one, messages are JSON
+inline constexpr std::string_view kCborProtocol = "wpilibws.cbor";
+inline constexpr std::string_view kMsgPackProtocol = "wpilibws.msgpack";
+
+// Returns the format of a negotiated subprotocol
+HALSimWireFormat GetWireFormat(std::string_view protocol);
+
+// Returns the subprotocol name of a format; empty for JSON
+std::string_view GetWireProtocol(HALSimWireFormat format);
+
+// Writes a message, or an array of messages, in a binary format.  Each
+// message is written as a [type, device, [key, value, ...]] array with the
+// standard data keys replaced by small integers.
+void WriteBinaryMessage(wpi::raw_ostream& os, HALSimWireFormat format,
+                        const wpi::json& msg);
+
+// Reads a binary message, or array of messages, back into its JSON form.
+// Values that aren't messages are returned as-is.
+//
+// @throw wpi::json::parse_error if the data is malformed
+wpi::json ReadBinaryMessage(HALSimWireFormat format,
+                            wpi::span<const uint8_t> data);
+
+}  // namespace wpilibws
@@ -0,0 +1,33 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <vector>
+
+#include <wpi/StringMap.h>
+#include <wpi/json.h>
+
+namespace wpilibws {
+
+// Collects messages to be sent together as a single JSON array.  Messages for
+// the same type and device are merged into one, keeping the latest value of
+// each data field, so a value that changes many times between sends is only
+// sent once.  Not thread safe.
+class HALSimMessageBatch {
+ public:
+  void Add(const wpi::json& msg);
+
+  bool IsEmpty() const { return m_messages.empty(); }
+
+  // Returns the collected messages as an array and empties the batch
+  wpi::json Take();
+
+ private:
+  std::vector<wpi::json> m_messages;
+  // index into m_messages of the message for each "type/device"
+  wpi::StringMap<size_t> m_indices;
+};
+
+}  // namespace wpilibws
@@ -17,7 +17,7 @@ class HALSimWSProviderAnalogIn : public HALSimWSHalChanProvider {
   using HALSimWSHalChanProvider::HALSimWSHalChanProvider;
   ~HALSimWSProviderAnalogIn() override;
 
-  void OnNetValueChanged(const wpi::json& json) override;
+  void OnNetValueChanged(const wpi::json_document::value& json) override;
 
  protected:
   void RegisterCallbacks() override;
@@ -15,7 +15,7 @@ class HALSimWSProviderBuiltInAccelerometer : public HALSimWSHalProvider {
   using HALSimWSHalProvider::HALSimWSHalProvider;
   ~HALSimWSProviderBuiltInAccelerometer() override;
 
-  void OnNetValueChanged(const wpi::json& json) override;
+  void OnNetValueChanged(const wpi::json_document::value& json) override;
 
  protected:
   void RegisterCallbacks() override;
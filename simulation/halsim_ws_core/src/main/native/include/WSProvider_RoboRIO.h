@@ -17,7 +17,7 @@ class HALSimWSProviderRoboRIO : public HALSimWSHalProvider {
   using HALSimWSHalProvider::HALSimWSHalProvider;
   ~HALSimWSProviderRoboRIO() override;
 
-  void OnNetValueChanged(const wpi::json& json) override;
+  void OnNetValueChanged(const wpi::json_document::value& json) override;
 
  protected:
   void RegisterCallbacks() override;
@@ -48,7 +48,7 @@ class HALSimWSProviderSimDevice : public HALSimWSBaseProvider {
 
   void OnNetworkDisconnected() override;
 
-  void OnNetValueChanged(const wpi::json& json) override;
+  void OnNetValueChanged(const wpi::json_document::value& json) override;
 
   void ProcessHalCallback(const wpi::json& payload);
 
@@ -0,0 +1,52 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "WSHalProviders.h"
+
+namespace wpilibws {
+
+// Lets a client pause the simulation time and step it, so an external
+// simulator can run in lock-step with the robot program
+class HALSimWSProviderTiming : public HALSimWSHalProvider {
+ public:
+  static void Initialize(WSRegisterFunc webRegisterFunc);
+
+  using HALSimWSHalProvider::HALSimWSHalProvider;
+  ~HALSimWSProviderTiming() override;
+
+  void OnNetValueChanged(const wpi::json_document::value& json) override;
+
+ protected:
+  void RegisterCallbacks() override {}
+  void CancelCallbacks() override;
+
+ private:
+  struct Command {
+    enum Kind { kPause, kResume, kStep } kind;
+    uint64_t step = 0;
+  };
+
+  void Enqueue(Command command);
+  void Main();
+
+  // Stepping waits for the robot program, which may need the network loop
+  // that messages are received on, so commands run on their own thread
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::deque<Command> m_commands;
+  bool m_paused = false;
+  bool m_active = true;
+  std::thread m_thread;
+};
+
+}  // namespace wpilibws
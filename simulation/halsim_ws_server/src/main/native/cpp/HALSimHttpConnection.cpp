@@ -9,12 +9,13 @@
 #include <string_view>
 
 #include <fmt/format.h>
+#include <wpi/HttpUtil.h>
 #include <wpi/MimeTypes.h>
 #include <wpi/SmallVector.h>
+#include <wpi/SmallString.h>
 #include <wpi/StringExtras.h>
 #include <wpi/UrlParser.h>
 #include <wpi/fs.h>
-#include <wpi/raw_istream.h>
 #include <wpi/raw_uv_ostream.h>
 #include <wpi/uv/Request.h>
 
@@ -23,11 +24,29 @@ namespace uv = wpi::uv;
 using namespace wpilibws;
 
 bool HALSimHttpConnection::IsValidWsUpgrade(std::string_view protocol) {
-  if (m_request.GetUrl() != m_server->GetServerUri()) {
+  wpi::UrlParser url{m_request.GetUrl(), false};
+  if (!url.IsValid() || !url.HasPath() ||
+      url.GetPath() != m_server->GetServerUri()) {
     MySendError(404, "invalid websocket address");
     return false;
   }
 
+  m_format = GetWireFormat(protocol);
+
+  // "?batch=<ms>" selects batch mode with the given send period
+  if (url.HasQuery()) {
+    wpi::HttpQueryMap query{url.GetQuery()};
+    wpi::SmallString<16> buf;
+    if (auto batch = query.Get("batch", buf)) {
+      auto ms = wpi::parse_integer<unsigned int>(*batch, 10);
+      if (!ms || *ms == 0) {
+        MySendError(400, "invalid batch period");
+        return false;
+      }
+      m_batchPeriod = uv::Timer::Time{*ms};
+    }
+  }
+
   return true;
 }
 
@@ -44,6 +63,12 @@ void HALSimHttpConnection::ProcessWsUpgrade() {
     Log(200);
     m_isWsConnected = true;
     std::fputs("HALWebSim: websocket connected\n", stderr);
+
+    if (m_batchPeriod.count() != 0) {
+      m_batchTimer = uv::Timer::Create(m_server->GetLoop());
+      m_batchTimer->timeout.connect([this] { FlushBatch(); });
+      m_batchTimer->Start(m_batchPeriod, m_batchPeriod);
+    }
   });
 
   // parse incoming JSON, dispatch to parent
@@ -52,16 +77,32 @@ void HALSimHttpConnection::ProcessWsUpgrade() {
       return;
     }
 
-    wpi::json j;
     try {
-      j = wpi::json::parse(msg);
+      m_document.parse(msg);
     } catch (const wpi::json::parse_error& e) {
       std::string err("JSON parse failed: ");
       err += e.what();
       m_websocket->Fail(400, err);
       return;
     }
-    m_server->OnNetValueChanged(j);
+    DispatchMessage(m_document.root());
+  });
+
+  // binary messages are only used with a binary subprotocol
+  m_websocket->binary.connect([this](auto data, bool) {
+    if (!m_isWsConnected || m_format == HALSimWireFormat::kJson) {
+      return;
+    }
+
+    try {
+      m_document.assign(ReadBinaryMessage(m_format, data));
+    } catch (const wpi::json::parse_error& e) {
+      std::string err("binary parse failed: ");
+      err += e.what();
+      m_websocket->Fail(400, err);
+      return;
+    }
+    DispatchMessage(m_document.root());
   });
 
   m_websocket->closed.connect([this](uint16_t, auto) {
@@ -70,83 +111,84 @@ void HALSimHttpConnection::ProcessWsUpgrade() {
       std::fputs("HALWebSim: websocket disconnected\n", stderr);
       m_isWsConnected = false;
 
+      if (m_batchTimer) {
+        m_batchTimer->Close();
+        m_batchTimer.reset();
+      }
+
       m_server->CloseWebsocket(shared_from_this());
     }
   });
 }
 
 void HALSimHttpConnection::OnSimValueChanged(const wpi::json& msg) {
-  // render json to buffers
+  if (m_batchPeriod.count() != 0) {
+    std::scoped_lock lock(m_batchMutex);
+    m_batch.Add(msg);
+    return;
+  }
+
+  // call the websocket send function on the uv loop
+  m_server->GetExec().Send([self = shared_from_this(), sendBufs = Render(msg)] {
+    self->SendBuffers(sendBufs);
+  });
+}
+
+wpi::SmallVector<uv::Buffer, 4> HALSimHttpConnection::Render(
+    const wpi::json& msg) {
   wpi::SmallVector<uv::Buffer, 4> sendBufs;
   wpi::raw_uv_ostream os{sendBufs, [this]() -> uv::Buffer {
                            std::lock_guard lock(m_buffers_mutex);
                            return m_buffers.Allocate();
                          }};
-  os << msg;
-
-  // call the websocket send function on the uv loop
-  m_server->GetExec().Send([self = shared_from_this(), sendBufs] {
-    self->m_websocket->SendText(sendBufs,
-                                [self](auto bufs, wpi::uv::Error err) {
-                                  {
-                                    std::lock_guard lock(self->m_buffers_mutex);
-                                    self->m_buffers.Release(bufs);
-                                  }
-
-                                  if (err) {
-                                    fmt::print(stderr, "{}\n", err.str());
-                                    std::fflush(stderr);
-                                  }
-                                });
-  });
+  if (m_format == HALSimWireFormat::kJson) {
+    os << msg;
+  } else {
+    WriteBinaryMessage(os, m_format, msg);
+  }
+  return sendBufs;
 }
 
-void HALSimHttpConnection::SendFileResponse(int code, std::string_view codeText,
-                                            std::string_view contentType,
-                                            std::string_view filename,
-                                            std::string_view extraHeader) {
-  std::error_code ec;
-
-  // get file size
-  auto size = fs::file_size(filename, ec);
-  if (ec) {
-    MySendError(404, "error getting file size");
-    return;
-  }
+void HALSimHttpConnection::SendBuffers(wpi::span<const uv::Buffer> bufs) {
+  auto callback = [self = shared_from_this()](auto bufs, wpi::uv::Error err) {
+    {
+      std::lock_guard lock(self->m_buffers_mutex);
+      self->m_buffers.Release(bufs);
+    }
 
-  // open file
-  wpi::raw_fd_istream is{filename, ec, true};
-  if (ec) {
-    MySendError(404, "error opening file");
-    return;
+    if (err) {
+      fmt::print(stderr, "{}\n", err.str());
+      std::fflush(stderr);
+    }
+  };
+  if (m_format == HALSimWireFormat::kJson) {
+    m_websocket->SendText(bufs, callback);
+  } else {
+    m_websocket->SendBinary(bufs, callback);
   }
+}
 
-  wpi::SmallVector<uv::Buffer, 4> toSend;
-  wpi::raw_uv_ostream os{toSend, 4096};
-  BuildHeader(os, code, codeText, contentType, size, extraHeader);
-  SendData(os.bufs(), false);
-
-  Log(code);
-
-  // Read the file byte by byte
-  wpi::SmallVector<uv::Buffer, 4> bodyData;
-  wpi::raw_uv_ostream bodyOs{bodyData, 4096};
-
-  std::string fileBuf;
-  size_t oldSize = 0;
-
-  while (fileBuf.size() < size) {
-    oldSize = fileBuf.size();
-    fileBuf.resize(oldSize + 1);
-    is.read(&(*fileBuf.begin()) + oldSize, 1);
+void HALSimHttpConnection::DispatchMessage(
+    const wpi::json_document::value& msg) {
+  if (msg.is_array()) {
+    for (auto&& m : msg.elements()) {
+      m_server->OnNetValueChanged(m);
+    }
+  } else {
+    m_server->OnNetValueChanged(msg);
   }
+}
 
-  bodyOs << fileBuf;
-
-  SendData(bodyOs.bufs(), false);
-  if (!m_keepAlive) {
-    m_stream.Close();
+void HALSimHttpConnection::FlushBatch() {
+  wpi::json msgs;
+  {
+    std::scoped_lock lock(m_batchMutex);
+    if (m_batch.IsEmpty()) {
+      return;
+    }
+    msgs = m_batch.Take();
   }
+  SendBuffers(Render(msgs));
 }
 
 void HALSimHttpConnection::ProcessRequest() {
@@ -185,7 +227,11 @@ void HALSimHttpConnection::ProcessRequest() {
       MySendError(404, fmt::format("Resource '{}' not found", path));
     } else {
       auto contentType = wpi::MimeTypeFromPath(nativePath.string());
-      SendFileResponse(200, "OK", contentType, nativePath.string());
+      if (SendFileResponse(200, "OK", contentType, nativePath.string())) {
+        Log(200);
+      } else {
+        MySendError(404, "error reading file");
+      }
     }
   } else {
     MySendError(404, "Resource not found");
@@ -18,6 +18,7 @@
 #include <WSProvider_RoboRIO.h>
 #include <WSProvider_SimDevice.h>
 #include <WSProvider_Solenoid.h>
+#include <WSProvider_Timing.h>
 #include <WSProvider_dPWM.h>
 
 using namespace wpilibws;
@@ -50,6 +51,7 @@ bool HALSimWSServer::Initialize() {
     HALSimWSProviderRelay::Initialize(registerFunc);
     HALSimWSProviderRoboRIO::Initialize(registerFunc);
     HALSimWSProviderSolenoid::Initialize(registerFunc);
+    HALSimWSProviderTiming::Initialize(registerFunc);
 
     simDevices.Initialize(loop);
 
@@ -134,13 +134,13 @@ void HALSimWeb::CloseWebsocket(
   }
 }
 
-void HALSimWeb::OnNetValueChanged(const wpi::json& msg) {
+void HALSimWeb::OnNetValueChanged(const wpi::json_document::value& msg) {
   // Look for "type" and "device" fields so that we can
   // generate the key
 
   try {
-    auto& type = msg.at("type").get_ref<const std::string&>();
-    auto& device = msg.at("device").get_ref<const std::string&>();
+    auto type = msg.at("type").get_string();
+    auto device = msg.at("device").get_string();
 
     wpi::SmallString<64> key;
     key.append(type);
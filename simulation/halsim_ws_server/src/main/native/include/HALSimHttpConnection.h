@@ -10,10 +10,16 @@
 #include <utility>
 
 #include <HALSimBaseWebSocketConnection.h>
+#include <HALSimBinaryFormat.h>
+#include <HALSimMessageBatch.h>
 #include <wpi/HttpWebSocketServerConnection.h>
+#include <wpi/json_document.h>
+#include <wpi/SmallVector.h>
 #include <wpi/mutex.h>
+#include <wpi/span.h>
 #include <wpi/uv/AsyncFunction.h>
 #include <wpi/uv/Buffer.h>
+#include <wpi/uv/Timer.h>
 
 #include "HALSimWeb.h"
 
@@ -29,9 +35,13 @@ class HALSimHttpConnection
  public:
   HALSimHttpConnection(std::shared_ptr<HALSimWeb> server,
                        std::shared_ptr<wpi::uv::Stream> stream)
-      : wpi::HttpWebSocketServerConnection<HALSimHttpConnection>(stream, {}),
+      : wpi::HttpWebSocketServerConnection<HALSimHttpConnection>(
+            stream, {kCborProtocol, kMsgPackProtocol}),
         m_server(std::move(server)),
-        m_buffers(128) {}
+        m_buffers(128) {
+    // Accept compression; the repeated message keys compress well
+    m_deflateOptions.enable = true;
+  }
 
  public:
   // callable from any thread
@@ -41,22 +51,41 @@ class HALSimHttpConnection
   void ProcessRequest() override;
   bool IsValidWsUpgrade(std::string_view protocol) override;
   void ProcessWsUpgrade() override;
-  void SendFileResponse(int code, std::string_view codeText,
-                        std::string_view contentType, std::string_view filename,
-                        std::string_view extraHeader = {});
-
   void MySendError(int code, std::string_view message);
   void Log(int code);
 
+ private:
+  // render json to buffers; callable from any thread
+  wpi::SmallVector<wpi::uv::Buffer, 4> Render(const wpi::json& msg);
+  // must be called on the uv loop
+  void SendBuffers(wpi::span<const wpi::uv::Buffer> bufs);
+  // send the batched messages; must be called on the uv loop
+  void FlushBatch();
+  // dispatch a received message, or array of messages, to the server
+  void DispatchMessage(const wpi::json_document::value& msg);
+
  private:
   std::shared_ptr<HALSimWeb> m_server;
 
   // is the websocket connected?
   bool m_isWsConnected = false;
 
+  // incoming messages are parsed into this, reusing its memory
+  wpi::json_document m_document;
+
+  // the message encoding, from the negotiated subprotocol
+  HALSimWireFormat m_format = HALSimWireFormat::kJson;
+
   // these are only valid if the websocket is connected
   wpi::uv::SimpleBufferPool<4> m_buffers;
   std::mutex m_buffers_mutex;
+
+  // in batch mode, messages are merged into m_batch and sent as one array
+  // every m_batchPeriod; otherwise each message is sent as it is received
+  wpi::uv::Timer::Time m_batchPeriod{0};
+  std::shared_ptr<wpi::uv::Timer> m_batchTimer;
+  HALSimMessageBatch m_batch;
+  wpi::mutex m_batchMutex;
 };
 
 }  // namespace wpilibws
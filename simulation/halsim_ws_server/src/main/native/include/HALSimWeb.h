@@ -11,14 +11,11 @@
 #include <WSBaseProvider.h>
 #include <WSProviderContainer.h>
 #include <WSProvider_SimDevice.h>
+#include <wpi/json_document.h>
 #include <wpi/uv/Async.h>
 #include <wpi/uv/Loop.h>
 #include <wpi/uv/Tcp.h>
 
-namespace wpi {
-class json;
-}  // namespace wpi
-
 namespace wpilibws {
 
 class HALSimWeb : public std::enable_shared_from_this<HALSimWeb> {
@@ -39,7 +36,7 @@ class HALSimWeb : public std::enable_shared_from_this<HALSimWeb> {
   void CloseWebsocket(std::shared_ptr<HALSimBaseWebSocketConnection> hws);
 
   // network -> sim
-  void OnNetValueChanged(const wpi::json& msg);
+  void OnNetValueChanged(const wpi::json_document::value& msg);
 
   const std::string& GetWebrootSys() const { return m_webroot_sys; }
   const std::string& GetWebrootUser() const { return m_webroot_user; }
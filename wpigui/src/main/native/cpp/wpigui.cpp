@@ -5,8 +5,11 @@
 #include "wpigui.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
+#include <thread>
+#include <utility>
 
 #include <GLFW/glfw3.h>
 #include <imgui.h>
@@ -52,6 +55,33 @@ static void WindowPosCallback(GLFWwindow* window, int xpos, int ypos) {
   }
 }
 
+static void InputCallback() {
+  gContext->lastInputTime = glfwGetTime();
+}
+
+static void CursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
+  InputCallback();
+}
+
+static void MouseButtonCallback(GLFWwindow* window, int button, int action,
+                                int mods) {
+  InputCallback();
+}
+
+static void ScrollCallback(GLFWwindow* window, double xoffset,
+                           double yoffset) {
+  InputCallback();
+}
+
+static void KeyCallback(GLFWwindow* window, int key, int scancode, int action,
+                        int mods) {
+  InputCallback();
+}
+
+static void CharCallback(GLFWwindow* window, unsigned int c) {
+  InputCallback();
+}
+
 static void* IniReadOpen(ImGuiContext* ctx, ImGuiSettingsHandler* handler,
                          const char* name) {
   if (std::strcmp(name, "GLOBAL") != 0) {
@@ -241,6 +271,14 @@ bool gui::Initialize(const char* title, int width, int height) {
   glfwSetWindowMaximizeCallback(gContext->window, WindowMaximizeCallback);
   glfwSetWindowPosCallback(gContext->window, WindowPosCallback);
 
+  // Track input for frame throttling; these are chained to by the Dear ImGui
+  // callbacks installed in PlatformInitRenderer()
+  glfwSetCursorPosCallback(gContext->window, CursorPosCallback);
+  glfwSetMouseButtonCallback(gContext->window, MouseButtonCallback);
+  glfwSetScrollCallback(gContext->window, ScrollCallback);
+  glfwSetKeyCallback(gContext->window, KeyCallback);
+  glfwSetCharCallback(gContext->window, CharCallback);
+
   // Set icons
   if (!gContext->icons.empty()) {
     glfwSetWindowIcon(gContext->window, gContext->icons.size(),
@@ -277,12 +315,68 @@ bool gui::Initialize(const char* title, int width, int height) {
   return true;
 }
 
+// Frames are rendered at full rate for this long after user input
+static constexpr double kInputActivePeriod = 1.0;
+
+static double GetTime() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Runs the periodic executors that are due, and returns when the next one is
+// due
+static double RunPeriodicExecutors() {
+  double now = GetTime();
+  double nextTime = now + 1.0;
+  for (size_t i = 0; i < gContext->periodicExecutors.size(); ++i) {
+    auto& executor = gContext->periodicExecutors[i];
+    if (now >= executor.nextTime) {
+      // skip missed periods rather than running back to back
+      executor.nextTime = (std::max)(executor.nextTime + executor.period, now);
+      if (executor.execute) {
+        executor.execute();
+      }
+    }
+    nextTime = (std::min)(nextTime, executor.nextTime);
+  }
+  return nextTime - now;
+}
+
+static double GetFramePeriod() {
+  if (glfwGetWindowAttrib(gContext->window, GLFW_ICONIFIED)) {
+    return gContext->minimizedFramePeriod;
+  }
+  if (glfwGetTime() - gContext->lastInputTime < kInputActivePeriod) {
+    return 0;
+  }
+  return gContext->idleFramePeriod;
+}
+
 void gui::Main() {
   // Main loop
   while (!glfwWindowShouldClose(gContext->window) && !gContext->exit) {
-    // Poll and handle events (inputs, window resize, etc.)
-    glfwPollEvents();
-    PlatformRenderFrame();
+    double untilExecute = RunPeriodicExecutors();
+
+    // Poll and handle events (inputs, window resize, etc.); when throttled,
+    // wait for them until the next frame or periodic executor is due
+    double period = GetFramePeriod();
+    double untilFrame = gContext->lastFrameTime + period - glfwGetTime();
+    double timeout = (std::min)(untilFrame, untilExecute);
+    if (period == 0 || timeout <= 0 || gContext->frameRequested) {
+      glfwPollEvents();
+    } else {
+      glfwWaitEventsTimeout(timeout);
+    }
+
+    // Input may have ended the idle period
+    period = GetFramePeriod();
+    double now = glfwGetTime();
+    if (gContext->frameRequested.exchange(false) || period == 0 ||
+        now >= gContext->lastFrameTime + period) {
+      gContext->lastFrameTime = now;
+      PlatformRenderFrame();
+    }
   }
 
   // Cleanup
@@ -297,6 +391,7 @@ void gui::Main() {
   }
 
   glfwDestroyWindow(gContext->window);
+  gContext->window = nullptr;
   glfwTerminate();
 }
 
@@ -336,11 +431,23 @@ void gui::CommonRenderFrame() {
   ImGui::Render();
 }
 
+void gui::MainHeadless() {
+  while (!gContext->exit) {
+    double untilExecute = RunPeriodicExecutors();
+    // wake up regularly to check for exit
+    std::this_thread::sleep_for(
+        std::chrono::duration<double>((std::min)(untilExecute, 0.1)));
+  }
+}
+
 void gui::Exit() {
   if (!gContext) {
     return;
   }
   gContext->exit = true;
+  if (gContext->window) {
+    glfwPostEmptyEvent();
+  }
 }
 
 void gui::AddInit(std::function<void()> initialize) {
@@ -367,6 +474,27 @@ void gui::AddLateExecute(std::function<void()> execute) {
   }
 }
 
+void gui::AddPeriodicExecute(std::function<void()> execute, double period) {
+  if (execute) {
+    gContext->periodicExecutors.push_back({std::move(execute), period});
+  }
+}
+
+void gui::SetIdleFramePeriods(double idlePeriod, double minimizedPeriod) {
+  gContext->idleFramePeriod = idlePeriod;
+  gContext->minimizedFramePeriod = minimizedPeriod;
+}
+
+void gui::RequestFrame() {
+  if (!gContext) {
+    return;
+  }
+  gContext->frameRequested = true;
+  if (gContext->window) {
+    glfwPostEmptyEvent();
+  }
+}
+
 GLFWwindow* gui::GetSystemWindow() {
   return gContext->window;
 }
@@ -39,6 +39,12 @@ bool Initialize(const char* title, int width, int height);
  */
 void Main();
 
+/**
+ * Runs the periodic executors without a window, until Exit() is called.  This
+ * can be called instead of Initialize() and Main() to run headless.
+ */
+void MainHeadless();
+
 /**
  * Exits main GUI loop when current loop iteration finishes.
  * Safe to call from any thread, including from within main GUI loop.
@@ -79,6 +85,35 @@ void AddEarlyExecute(std::function<void()> execute);
  */
 void AddLateExecute(std::function<void()> execute);
 
+/**
+ * Adds periodic executor to GUI.  The passed function is called from the main
+ * loop every period, whether or not a frame is rendered, so it keeps running
+ * while rendering is throttled and in MainHeadless().  It must not call any
+ * Dear ImGui functions.
+ *
+ * @param execute execution function
+ * @param period period, in seconds
+ */
+void AddPeriodicExecute(std::function<void()> execute, double period);
+
+/**
+ * Sets how often frames are rendered while the GUI is idle.  Frames are
+ * rendered at the display refresh rate while there is user input (and for a
+ * second afterwards); otherwise only every idle period, or every minimized
+ * period while the main window is minimized.  A period of 0 (the default)
+ * renders at the display refresh rate.
+ *
+ * @param idlePeriod frame period when there is no user input, in seconds
+ * @param minimizedPeriod frame period when minimized, in seconds
+ */
+void SetIdleFramePeriods(double idlePeriod, double minimizedPeriod);
+
+/**
+ * Requests a frame be rendered as soon as possible, even if the GUI is idle,
+ * e.g. because displayed data has changed.  Safe to call from any thread.
+ */
+void RequestFrame();
+
 /**
  * Gets GLFW window handle.
  */
@@ -51,6 +51,20 @@ struct Context : public SavedSettings {
   std::vector<std::function<void()>> earlyExecutors;
   std::vector<std::function<void()>> lateExecutors;
 
+  struct PeriodicExecutor {
+    std::function<void()> execute;
+    double period;
+    double nextTime = 0;
+  };
+  std::vector<PeriodicExecutor> periodicExecutors;
+
+  // Frame throttling; a period of 0 renders every main loop iteration
+  double idleFramePeriod = 0;
+  double minimizedFramePeriod = 0;
+  double lastInputTime = 0;
+  double lastFrameTime = 0;
+  std::atomic_bool frameRequested{false};
+
   int fontScale = 2;  // updated by main loop
   std::vector<Font> fonts;
 
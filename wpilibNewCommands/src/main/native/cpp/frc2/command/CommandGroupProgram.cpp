@@ -0,0 +1,271 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc2/command/CommandGroupProgram.h"
+
+#include <memory>
+#include <typeinfo>
+
+#include <wpi/span.h>
+
+#include "frc2/command/ParallelCommandGroup.h"
+#include "frc2/command/ParallelDeadlineGroup.h"
+#include "frc2/command/ParallelRaceGroup.h"
+#include "frc2/command/SequentialCommandGroup.h"
+
+using namespace frc2;
+using namespace frc2::detail;
+
+void CommandGroupProgram::Initialize(Command* group) {
+  m_nodes.clear();
+  Compile(group, kNone);
+  InitializeNode(0);
+  m_running = true;
+}
+
+void CommandGroupProgram::Execute() {
+  m_stack.clear();
+  m_stack.emplace_back(BeginGroup(0));
+  while (!m_stack.empty()) {
+    auto frame = m_stack.back();
+    if (frame.child == kNone) {
+      m_stack.pop_back();
+      if (!m_stack.empty()) {
+        ChildExecuted(m_stack.back());
+      }
+    } else if (m_nodes[frame.child].kind == Kind::kLeaf) {
+      m_nodes[frame.child].command->Execute();
+      ChildExecuted(m_stack.back());
+    } else {
+      m_stack.emplace_back(BeginGroup(frame.child));
+    }
+  }
+}
+
+void CommandGroupProgram::End(bool interrupted) {
+  if (!m_nodes.empty()) {
+    EndNode(0, interrupted);
+  }
+  m_running = false;
+}
+
+bool CommandGroupProgram::IsFinished() {
+  return !m_nodes.empty() && IsNodeFinished(0);
+}
+
+void CommandGroupProgram::Compile(Command* command, uint32_t parent) {
+  uint32_t index = m_nodes.size();
+  m_nodes.push_back({command, Kind::kLeaf, parent, 0});
+
+  // Groups nested in the group are only inlined if they are exactly one of
+  // the group types, since subclasses may override their methods
+  auto is = [&](auto* group) {
+    using Group = std::remove_pointer_t<decltype(group)>;
+    return parent == kNone ? dynamic_cast<Group*>(command) != nullptr
+                           : typeid(*command) == typeid(Group);
+  };
+
+  wpi::span<const std::unique_ptr<Command>> commands;
+  Kind kind = Kind::kLeaf;
+  if (is(static_cast<SequentialCommandGroup*>(nullptr))) {
+    kind = Kind::kSequential;
+    commands = static_cast<SequentialCommandGroup*>(command)->m_commands;
+  } else if (is(static_cast<ParallelCommandGroup*>(nullptr))) {
+    kind = Kind::kParallel;
+    commands = static_cast<ParallelCommandGroup*>(command)->m_commands;
+  } else if (is(static_cast<ParallelRaceGroup*>(nullptr))) {
+    kind = Kind::kRace;
+    commands = static_cast<ParallelRaceGroup*>(command)->m_commands;
+  } else if (is(static_cast<ParallelDeadlineGroup*>(nullptr))) {
+    // The deadline is always the first command
+    kind = Kind::kDeadline;
+    commands = static_cast<ParallelDeadlineGroup*>(command)->m_commands;
+  }
+
+  m_nodes[index].kind = kind;
+  m_nodes[index].numChildren = commands.size();
+  for (auto&& child : commands) {
+    Compile(child.get(), index);
+  }
+  m_nodes[index].end = m_nodes.size();
+}
+
+void CommandGroupProgram::InitializeNode(uint32_t index) {
+  // A pre-order walk of the subtree, in the same order the groups would
+  // initialize their commands
+  for (uint32_t i = index; i < m_nodes[index].end;) {
+    auto& node = m_nodes[i];
+    if (i != index) {
+      auto& parent = m_nodes[node.parent];
+      // A sequential group only initializes its current command
+      if (parent.kind == Kind::kSequential && parent.current != i) {
+        i = node.end;
+        continue;
+      }
+    }
+
+    node.running = true;
+    switch (node.kind) {
+      case Kind::kLeaf:
+        node.command->Initialize();
+        break;
+      case Kind::kSequential:
+        node.current = i + 1;
+        break;
+      case Kind::kParallel:
+      case Kind::kDeadline:
+        node.numRunning = node.numChildren;
+        node.finished = false;
+        break;
+      case Kind::kRace:
+        node.finished = false;
+        break;
+    }
+    ++i;
+  }
+}
+
+void CommandGroupProgram::EndNode(uint32_t index, bool interrupted) {
+  // A pre-order walk of the subtree, deciding which commands each ending group
+  // ends the same way the groups would
+  for (uint32_t i = index; i < m_nodes[index].end;) {
+    auto& node = m_nodes[i];
+    bool end = true;
+    bool endInterrupted = interrupted;
+    if (i != index) {
+      auto& parent = m_nodes[node.parent];
+      end = false;
+      endInterrupted = true;
+      if (parent.ending) {
+        switch (parent.kind) {
+          case Kind::kSequential:
+            end = parent.endInterrupted && parent.current == i;
+            break;
+          case Kind::kParallel:
+            end = parent.endInterrupted && node.running;
+            break;
+          case Kind::kRace:
+            end = true;
+            endInterrupted = !IsNodeFinished(i);
+            break;
+          case Kind::kDeadline:
+            end = node.running;
+            break;
+          case Kind::kLeaf:
+            break;
+        }
+      }
+    }
+    if (!end) {
+      i = node.end;
+      continue;
+    }
+
+    if (node.kind == Kind::kLeaf) {
+      node.command->End(endInterrupted);
+      node.running = false;
+    } else {
+      node.ending = true;
+      node.endInterrupted = endInterrupted;
+    }
+    ++i;
+  }
+
+  // The groups' state is only reset once their children have been ended
+  for (uint32_t i = index; i < m_nodes[index].end; ++i) {
+    auto& node = m_nodes[i];
+    if (node.ending) {
+      node.ending = false;
+      node.running = false;
+      node.current = kNone;
+    }
+  }
+}
+
+bool CommandGroupProgram::IsNodeFinished(uint32_t index) {
+  auto& node = m_nodes[index];
+  switch (node.kind) {
+    case Kind::kLeaf:
+      return node.command->IsFinished();
+    case Kind::kSequential:
+      return node.current == node.end;
+    case Kind::kParallel:
+      return node.numRunning == 0;
+    case Kind::kRace:
+    case Kind::kDeadline:
+      return node.finished;
+  }
+  return false;
+}
+
+CommandGroupProgram::Frame CommandGroupProgram::BeginGroup(uint32_t group) {
+  auto& node = m_nodes[group];
+  switch (node.kind) {
+    case Kind::kSequential:
+      if (node.current != kNone && node.current != node.end) {
+        return {group, node.current};
+      }
+      break;
+    case Kind::kParallel:
+    case Kind::kDeadline:
+      return {group, NextRunningChild(group, group + 1)};
+    case Kind::kRace:
+      if (node.numChildren != 0) {
+        return {group, group + 1};
+      }
+      break;
+    case Kind::kLeaf:
+      break;
+  }
+  return {group, kNone};
+}
+
+uint32_t CommandGroupProgram::NextRunningChild(uint32_t group, uint32_t from) {
+  for (uint32_t i = from; i < m_nodes[group].end; i = m_nodes[i].end) {
+    if (m_nodes[i].running) {
+      return i;
+    }
+  }
+  return kNone;
+}
+
+void CommandGroupProgram::ChildExecuted(Frame& frame) {
+  auto& group = m_nodes[frame.group];
+  uint32_t child = frame.child;
+  uint32_t next = m_nodes[child].end;
+  switch (group.kind) {
+    case Kind::kSequential:
+      // Only one command of a sequential group runs each loop
+      frame.child = kNone;
+      if (IsNodeFinished(child)) {
+        EndNode(child, false);
+        group.current = next;
+        if (next < group.end) {
+          InitializeNode(next);
+        }
+      }
+      break;
+    case Kind::kParallel:
+    case Kind::kDeadline:
+      if (IsNodeFinished(child)) {
+        EndNode(child, false);
+        m_nodes[child].running = false;
+        --group.numRunning;
+        if (group.kind == Kind::kDeadline && child == frame.group + 1) {
+          group.finished = true;
+        }
+      }
+      frame.child = NextRunningChild(frame.group, next);
+      break;
+    case Kind::kRace:
+      if (IsNodeFinished(child)) {
+        group.finished = true;
+      }
+      frame.child = next < group.end ? next : kNone;
+      break;
+    case Kind::kLeaf:
+      frame.child = kNone;
+      break;
+  }
+}
@@ -4,10 +4,20 @@
 
 #include "frc2/command/CommandScheduler.h"
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include <frc/LoopProfiler.h>
 #include <frc/RobotBase.h>
 #include <frc/RobotState.h>
+#include <frc/Threads.h>
 #include <frc/TimedRobot.h>
 #include <frc/livewindow/LiveWindow.h>
 #include <hal/FRCUsageReporting.h>
@@ -16,32 +26,251 @@
 #include <networktables/NetworkTableEntry.h>
 #include <wpi/DenseMap.h>
 #include <wpi/SmallVector.h>
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
 #include <wpi/sendable/SendableRegistry.h>
+#include <wpi/trace.h>
 
 #include "frc2/command/CommandGroupBase.h"
 #include "frc2/command/CommandState.h"
 #include "frc2/command/Subsystem.h"
+#include "frc2/command/button/StickSnapshot.h"
 
 using namespace frc2;
 
+// Names are only built while the loop profiler is enabled
+static std::string ProfilerPhaseName(Subsystem* subsystem) {
+  if (!frc::LoopProfiler::IsEnabled()) {
+    return {};
+  }
+  if (auto sendable = dynamic_cast<wpi::Sendable*>(subsystem)) {
+    return wpi::SendableRegistry::GetName(sendable) + ".Periodic()";
+  }
+  return "Subsystem Periodic()";
+}
+
+static std::string ProfilerPhaseName(Command* command) {
+  if (!frc::LoopProfiler::IsEnabled()) {
+    return {};
+  }
+  return command->GetName() + ".Execute()";
+}
+
+namespace {
+// A set of subsystems, as a bitmask of their dense indices
+class RequirementMask {
+ public:
+  void Set(size_t index) {
+    if (index / 64 >= m_words.size()) {
+      m_words.resize(index / 64 + 1);
+    }
+    m_words[index / 64] |= uint64_t{1} << (index % 64);
+  }
+
+  bool Test(size_t index) const {
+    return index / 64 < m_words.size() &&
+           (m_words[index / 64] & (uint64_t{1} << (index % 64))) != 0;
+  }
+
+  void Add(const RequirementMask& other) {
+    if (other.m_words.size() > m_words.size()) {
+      m_words.resize(other.m_words.size());
+    }
+    for (size_t i = 0; i < other.m_words.size(); ++i) {
+      m_words[i] |= other.m_words[i];
+    }
+  }
+
+  void Remove(const RequirementMask& other) {
+    size_t size = std::min(m_words.size(), other.m_words.size());
+    for (size_t i = 0; i < size; ++i) {
+      m_words[i] &= ~other.m_words[i];
+    }
+  }
+
+ private:
+  wpi::SmallVector<uint64_t, 1> m_words;
+};
+
+// Runs the Periodic() of a batch of subsystems on a pool of threads, with the
+// calling thread as one of the workers
+class PeriodicWorkers {
+ public:
+  PeriodicWorkers(int numThreads, int priority) {
+    for (int i = 0; i < numThreads; ++i) {
+      auto& thread = m_threads.emplace_back([this] { ThreadMain(); });
+      frc::SetThreadPriority(thread, true, priority);
+    }
+  }
+
+  ~PeriodicWorkers() {
+    {
+      std::scoped_lock lock(m_mutex);
+      m_stop = true;
+    }
+    m_startCond.notify_all();
+    for (auto&& thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  // Returns once every Periodic() has returned; rethrows the first exception
+  // any of them threw
+  void Run(wpi::span<Subsystem* const> subsystems) {
+    {
+      std::unique_lock lock(m_mutex);
+      m_doneCond.wait(lock, [&] { return m_active == 0; });
+      m_subsystems = subsystems;
+      m_next = 0;
+      m_remaining = subsystems.size();
+      ++m_generation;
+    }
+    m_startCond.notify_all();
+    RunSubsystems();
+
+    std::unique_lock lock(m_mutex);
+    // Workers that woke up late may still be looking at the batch
+    m_doneCond.wait(lock, [&] { return m_remaining == 0 && m_active == 0; });
+    m_subsystems = {};
+    if (m_exception) {
+      std::rethrow_exception(std::exchange(m_exception, nullptr));
+    }
+  }
+
+ private:
+  void ThreadMain() {
+    std::unique_lock lock(m_mutex);
+    uint64_t generation = 0;
+    for (;;) {
+      m_startCond.wait(lock,
+                       [&] { return m_stop || m_generation != generation; });
+      if (m_stop) {
+        return;
+      }
+      generation = m_generation;
+      ++m_active;
+      lock.unlock();
+      RunSubsystems();
+      lock.lock();
+      if (--m_active == 0) {
+        m_doneCond.notify_all();
+      }
+    }
+  }
+
+  void RunSubsystems() {
+    for (size_t i = m_next++; i < m_subsystems.size(); i = m_next++) {
+      try {
+        frc::LoopProfiler::Scope scope{ProfilerPhaseName(m_subsystems[i])};
+        m_subsystems[i]->Periodic();
+      } catch (...) {
+        std::scoped_lock lock(m_mutex);
+        if (!m_exception) {
+          m_exception = std::current_exception();
+        }
+      }
+      if (--m_remaining == 0) {
+        std::scoped_lock lock(m_mutex);
+        m_doneCond.notify_all();
+      }
+    }
+  }
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_startCond;
+  wpi::condition_variable m_doneCond;
+  std::vector<std::thread> m_threads;
+  bool m_stop = false;
+  uint64_t m_generation = 0;
+  int m_active = 0;
+  std::exception_ptr m_exception;
+
+  // The current batch; only changed while no worker is active
+  wpi::span<Subsystem* const> m_subsystems;
+  std::atomic<size_t> m_next{0};
+  std::atomic<size_t> m_remaining{0};
+};
+}  // namespace
+
 class CommandScheduler::Impl {
  public:
   // A map from commands to their scheduling state.  Also used as a set of the
   // currently-running commands.
   wpi::DenseMap<Command*, CommandState> scheduledCommands;
 
+  struct ScheduledCommand {
+    Command* command;
+    RequirementMask requirements;
+    // The requirements when the command was scheduled, so they can be released
+    // without calling into a command that is being destroyed
+    wpi::SmallVector<Subsystem*, 4> requiredSubsystems;
+    // Watchdog epochs, registered when the command is scheduled so running it
+    // doesn't build the names every loop
+    int executeEpoch;
+    int endEpoch;
+    int interruptEpoch;
+  };
+
+  // The currently-running commands in the order they were scheduled, so they
+  // run in a stable order.  Entries of commands that finish during the run
+  // loop are set to null and removed after it.
+  std::vector<ScheduledCommand> scheduledOrder;
+
+  // Watchdog epochs of the fixed parts of the run loop
+  int subsystemPeriodicEpoch;
+  int buttonsEpoch;
+
   // A map from required subsystems to their requiring commands.  Also used as a
   // set of the currently-required subsystems.
   wpi::DenseMap<Subsystem*, Command*> requirements;
 
+  // Dense indices of every subsystem seen, so sets of subsystems can be kept
+  // as bitmasks.  Indices aren't reused; a subsystem at the same address gets
+  // the same index.
+  wpi::DenseMap<const Subsystem*, size_t> subsystemIndices;
+
+  // The currently-required subsystems, the same set as the keys of
+  // requirements.
+  RequirementMask requiredMask;
+
+  struct RegisteredSubsystem {
+    std::unique_ptr<Command> defaultCommand;
+    size_t index = 0;
+  };
+
   // A map from subsystems registered with the scheduler to their default
   // commands.  Also used as a list of currently-registered subsystems.
-  wpi::DenseMap<Subsystem*, std::unique_ptr<Command>> subsystems;
+  wpi::DenseMap<Subsystem*, RegisteredSubsystem> subsystems;
+
+  // Worker threads for the parallel periodic phase, if enabled
+  std::unique_ptr<PeriodicWorkers> periodicWorkers;
+  bool parallelPeriodic = false;
+
+  // The order the subsystems' Periodic() are run in when the parallel
+  // periodic phase is enabled: batches of thread-safe subsystems that can run
+  // at the same time, then the rest.  Rebuilt when the subsystems change.
+  bool periodicPlanValid = false;
+  std::vector<std::vector<Subsystem*>> parallelBatches;
+  std::vector<Subsystem*> serialSubsystems;
 
   // The set of currently-registered buttons that will be polled every
   // iteration.
   wpi::SmallVector<wpi::unique_function<void()>, 4> buttons;
 
+  struct ButtonCondition {
+    std::shared_ptr<std::function<bool()>> condition;
+    bool pressedLast;
+    // Called when the condition changes
+    std::vector<wpi::unique_function<void(bool, bool)>> onChange;
+    // Called when the condition changes and while it is true
+    std::vector<wpi::unique_function<void(bool, bool)>> continuous;
+  };
+
+  // The conditions of the button bindings, each evaluated once per poll, and
+  // a map from each condition to its index in buttonConditions.
+  std::vector<ButtonCondition> buttonConditions;
+  wpi::DenseMap<const std::function<bool()>*, size_t> buttonConditionIndices;
+
   bool disabled{false};
 
   // Lists of user-supplied actions to be executed on scheduling events for
@@ -54,11 +283,98 @@ class CommandScheduler::Impl {
   // Flag and queues for avoiding concurrent modification if commands are
   // scheduled/canceled during run
 
+  struct ScheduleRequest {
+    Command* command;
+    bool interruptible;
+    int priority;
+  };
+
   bool inRunLoop = false;
-  wpi::DenseMap<Command*, bool> toSchedule;
+  wpi::SmallVector<ScheduleRequest, 4> toSchedule;
   wpi::SmallVector<Command*, 4> toCancel;
+
+  size_t SubsystemIndex(const Subsystem* subsystem) {
+    return subsystemIndices.try_emplace(subsystem, subsystemIndices.size())
+        .first->second;
+  }
+
+  RequirementMask MaskOf(const wpi::SmallSet<Subsystem*, 4>& subsystems) {
+    RequirementMask mask;
+    for (auto&& subsystem : subsystems) {
+      mask.Set(SubsystemIndex(subsystem));
+    }
+    return mask;
+  }
+
+  RegisteredSubsystem& Register(Subsystem* subsystem) {
+    auto& registered = subsystems[subsystem];
+    registered.index = SubsystemIndex(subsystem);
+    periodicPlanValid = false;
+    return registered;
+  }
+
+  void PlanPeriodic();
 };
 
+void CommandScheduler::Impl::PlanPeriodic() {
+  struct Dependencies {
+    Subsystem* subsystem;
+    size_t index;
+    wpi::SmallVector<const void*, 4> reads;
+    wpi::SmallVector<const void*, 4> writes;
+    size_t batch = 0;
+  };
+
+  parallelBatches.clear();
+  serialSubsystems.clear();
+
+  std::vector<Dependencies> parallel;
+  for (auto&& [subsystem, registered] : subsystems) {
+    if (subsystem->IsPeriodicThreadSafe()) {
+      auto& dependencies = parallel.emplace_back();
+      dependencies.subsystem = subsystem;
+      dependencies.index = registered.index;
+      subsystem->GetPeriodicDependencies(dependencies.reads,
+                                         dependencies.writes);
+    } else {
+      serialSubsystems.emplace_back(subsystem);
+    }
+  }
+
+  // Registration order, so the plan doesn't depend on subsystem addresses
+  auto byIndex = [&](Subsystem* a, Subsystem* b) {
+    return subsystems[a].index < subsystems[b].index;
+  };
+  std::sort(serialSubsystems.begin(), serialSubsystems.end(), byIndex);
+  std::sort(parallel.begin(), parallel.end(),
+            [](auto& a, auto& b) { return a.index < b.index; });
+
+  auto overlaps = [](auto& a, auto& b) {
+    return std::any_of(a.begin(), a.end(), [&](const void* data) {
+      return std::find(b.begin(), b.end(), data) != b.end();
+    });
+  };
+
+  // Each subsystem goes in the batch after the last one it conflicts with
+  for (size_t i = 0; i < parallel.size(); ++i) {
+    auto& current = parallel[i];
+    for (size_t j = 0; j < i; ++j) {
+      auto& other = parallel[j];
+      if (overlaps(current.writes, other.reads) ||
+          overlaps(current.writes, other.writes) ||
+          overlaps(current.reads, other.writes)) {
+        current.batch = std::max(current.batch, other.batch + 1);
+      }
+    }
+    if (current.batch >= parallelBatches.size()) {
+      parallelBatches.resize(current.batch + 1);
+    }
+    parallelBatches[current.batch].emplace_back(current.subsystem);
+  }
+
+  periodicPlanValid = true;
+}
+
 template <typename TMap, typename TKey>
 static bool ContainsKey(const TMap& map, TKey keyToCheck) {
   return map.find(keyToCheck) != map.end();
@@ -70,6 +386,9 @@ CommandScheduler::CommandScheduler()
       }) {
   HAL_Report(HALUsageReporting::kResourceType_Command,
              HALUsageReporting::kCommand2_Scheduler);
+  m_impl->subsystemPeriodicEpoch =
+      m_watchdog.RegisterEpoch("Subsystem Periodic()");
+  m_impl->buttonsEpoch = m_watchdog.RegisterEpoch("buttons.Run()");
   wpi::SendableRegistry::AddLW(this, "Scheduler");
   frc::LiveWindow::SetEnabledCallback([this] {
     this->Disable();
@@ -95,17 +414,59 @@ void CommandScheduler::SetPeriod(units::second_t period) {
   m_watchdog.SetTimeout(period);
 }
 
+void CommandScheduler::SetParallelPeriodic(int numThreads, int priority) {
+  m_impl->periodicWorkers.reset();
+  m_impl->parallelPeriodic = numThreads > 0;
+  m_impl->periodicPlanValid = false;
+  if constexpr (!frc::RobotBase::IsSimulation()) {
+    if (numThreads > 0) {
+      m_impl->periodicWorkers =
+          std::make_unique<PeriodicWorkers>(numThreads, priority);
+    }
+  }
+}
+
 void CommandScheduler::AddButton(wpi::unique_function<void()> button) {
   m_impl->buttons.emplace_back(std::move(button));
 }
 
+void CommandScheduler::AddButtonBinding(
+    std::shared_ptr<std::function<bool()>> condition,
+    wpi::unique_function<void(bool, bool)> binding, bool continuous) {
+  auto [it, inserted] = m_impl->buttonConditionIndices.try_emplace(
+      condition.get(), m_impl->buttonConditions.size());
+  if (inserted) {
+    auto& added = m_impl->buttonConditions.emplace_back();
+    added.pressedLast = (*condition)();
+    added.condition = std::move(condition);
+  }
+  auto& buttonCondition = m_impl->buttonConditions[it->second];
+  if (continuous) {
+    buttonCondition.continuous.emplace_back(std::move(binding));
+  } else {
+    buttonCondition.onChange.emplace_back(std::move(binding));
+  }
+}
+
 void CommandScheduler::ClearButtons() {
   m_impl->buttons.clear();
+  m_impl->buttonConditions.clear();
+  m_impl->buttonConditionIndices.clear();
 }
 
 void CommandScheduler::Schedule(bool interruptible, Command* command) {
+  Schedule(interruptible, 0, command);
+}
+
+void CommandScheduler::Schedule(bool interruptible, int priority,
+                                Command* command) {
   if (m_impl->inRunLoop) {
-    m_impl->toSchedule.try_emplace(command, interruptible);
+    auto& toSchedule = m_impl->toSchedule;
+    if (std::find_if(toSchedule.begin(), toSchedule.end(), [&](auto& entry) {
+          return entry.command == command;
+        }) == toSchedule.end()) {
+      toSchedule.push_back({command, interruptible, priority});
+    }
     return;
   }
 
@@ -123,35 +484,42 @@ void CommandScheduler::Schedule(bool interruptible, Command* command) {
 
   const auto& requirements = command->GetRequirements();
 
-  wpi::SmallVector<Command*, 8> intersection;
-
-  bool isDisjoint = true;
-  bool allInterruptible = true;
-  for (auto&& i1 : m_impl->requirements) {
-    if (requirements.find(i1.first) != requirements.end()) {
-      isDisjoint = false;
-      allInterruptible &=
-          m_impl->scheduledCommands[i1.second].IsInterruptible();
-      intersection.emplace_back(i1.second);
-    }
-  }
-
-  if (isDisjoint || allInterruptible) {
-    if (allInterruptible) {
-      for (auto&& cmdToCancel : intersection) {
-        Cancel(cmdToCancel);
+  // The command is rejected at the first requirement held by a command it
+  // can't preempt
+  for (auto&& requirement : requirements) {
+    auto requiring = m_impl->requirements.find(requirement);
+    if (requiring != m_impl->requirements.end()) {
+      auto& state = m_impl->scheduledCommands.find(requiring->second)->second;
+      if (!state.IsInterruptible() || state.GetPriority() > priority) {
+        return;
       }
     }
-    command->Initialize();
-    m_impl->scheduledCommands[command] = CommandState{interruptible};
-    for (auto&& requirement : requirements) {
-      m_impl->requirements[requirement] = command;
-    }
-    for (auto&& action : m_impl->initActions) {
-      action(*command);
+  }
+  for (auto&& requirement : requirements) {
+    auto requiring = m_impl->requirements.find(requirement);
+    if (requiring != m_impl->requirements.end()) {
+      Cancel(requiring->second);
     }
-    m_watchdog.AddEpoch(command->GetName() + ".Initialize()");
   }
+
+  command->Initialize();
+  m_impl->scheduledCommands[command] = CommandState{interruptible, priority};
+  auto name = command->GetName();
+  auto requirementMask = m_impl->MaskOf(requirements);
+  m_impl->requiredMask.Add(requirementMask);
+  m_impl->scheduledOrder.push_back(
+      {command, std::move(requirementMask),
+       {requirements.begin(), requirements.end()},
+       m_watchdog.RegisterEpoch(name + ".Execute()"),
+       m_watchdog.RegisterEpoch(name + ".End(false)"),
+       m_watchdog.RegisterEpoch(name + ".End(true)")});
+  for (auto&& requirement : requirements) {
+    m_impl->requirements[requirement] = command;
+  }
+  for (auto&& action : m_impl->initActions) {
+    action(*command);
+  }
+  m_watchdog.AddEpoch(name + ".Initialize()");
 }
 
 void CommandScheduler::Schedule(Command* command) {
@@ -184,44 +552,101 @@ void CommandScheduler::Schedule(std::initializer_list<Command*> commands) {
   }
 }
 
+void CommandScheduler::RunPeriodic(Subsystem* subsystem) {
+  frc::LoopProfiler::Scope scope{ProfilerPhaseName(subsystem)};
+  subsystem->Periodic();
+  if constexpr (frc::RobotBase::IsSimulation()) {
+    subsystem->SimulationPeriodic();
+  }
+}
+
+void CommandScheduler::RunParallelPeriodic() {
+  if (!m_impl->periodicPlanValid) {
+    m_impl->PlanPeriodic();
+  }
+  for (auto&& batch : m_impl->parallelBatches) {
+    if (m_impl->periodicWorkers) {
+      m_impl->periodicWorkers->Run(batch);
+    } else {
+      // Simulation runs the same batches one subsystem at a time
+      for (auto subsystem : batch) {
+        RunPeriodic(subsystem);
+      }
+    }
+    m_watchdog.AddEpoch(m_impl->subsystemPeriodicEpoch);
+  }
+  for (auto subsystem : m_impl->serialSubsystems) {
+    RunPeriodic(subsystem);
+    m_watchdog.AddEpoch(m_impl->subsystemPeriodicEpoch);
+  }
+}
+
 void CommandScheduler::Run() {
   if (m_impl->disabled) {
     return;
   }
+  WPI_TRACE_SCOPE("commands.scheduler.run");
 
   m_watchdog.Reset();
+  frc::LoopProfiler::Scope runScope{"CommandScheduler::Run()"};
 
   // Run the periodic method of all registered subsystems.
-  for (auto&& subsystem : m_impl->subsystems) {
-    subsystem.getFirst()->Periodic();
-    if constexpr (frc::RobotBase::IsSimulation()) {
-      subsystem.getFirst()->SimulationPeriodic();
+  if (m_impl->parallelPeriodic) {
+    RunParallelPeriodic();
+  } else {
+    for (auto&& subsystem : m_impl->subsystems) {
+      RunPeriodic(subsystem.getFirst());
+      m_watchdog.AddEpoch(m_impl->subsystemPeriodicEpoch);
     }
-    m_watchdog.AddEpoch("Subsystem Periodic()");
   }
 
   // Poll buttons for new commands to add.
-  for (auto&& button : m_impl->buttons) {
-    button();
+  {
+    frc::LoopProfiler::Scope scope{"buttons.Run()"};
+    detail::ScopedStickSnapshot snapshot;
+    for (auto&& button : m_impl->buttons) {
+      button();
+    }
+    // Indexed, since a binding may add bindings
+    auto& conditions = m_impl->buttonConditions;
+    for (size_t i = 0; i < conditions.size(); ++i) {
+      bool pressed = (*conditions[i].condition)();
+      bool pressedLast = conditions[i].pressedLast;
+      conditions[i].pressedLast = pressed;
+      if (pressed != pressedLast) {
+        for (size_t j = 0; j < conditions[i].onChange.size(); ++j) {
+          conditions[i].onChange[j](pressed, pressedLast);
+        }
+      }
+      if (pressed || pressedLast) {
+        for (size_t j = 0; j < conditions[i].continuous.size(); ++j) {
+          conditions[i].continuous[j](pressed, pressedLast);
+        }
+      }
+    }
   }
-  m_watchdog.AddEpoch("buttons.Run()");
+  m_watchdog.AddEpoch(m_impl->buttonsEpoch);
 
   m_impl->inRunLoop = true;
-  // Run scheduled commands, remove finished commands.
-  for (auto iterator = m_impl->scheduledCommands.begin();
-       iterator != m_impl->scheduledCommands.end(); iterator++) {
-    Command* command = iterator->getFirst();
+  // Run scheduled commands, remove finished commands.  Commands scheduled or
+  // canceled by the commands are deferred until after the loop, so
+  // scheduledOrder only changes here by finishing commands.
+  for (auto& scheduled : m_impl->scheduledOrder) {
+    Command* command = scheduled.command;
 
     if (!command->RunsWhenDisabled() && frc::RobotState::IsDisabled()) {
       Cancel(command);
       continue;
     }
 
-    command->Execute();
-    for (auto&& action : m_impl->executeActions) {
-      action(*command);
+    {
+      frc::LoopProfiler::Scope scope{ProfilerPhaseName(command)};
+      command->Execute();
+      for (auto&& action : m_impl->executeActions) {
+        action(*command);
+      }
     }
-    m_watchdog.AddEpoch(command->GetName() + ".Execute()");
+    m_watchdog.AddEpoch(scheduled.executeEpoch);
 
     if (command->IsFinished()) {
       command->End(false);
@@ -229,18 +654,30 @@ void CommandScheduler::Run() {
         action(*command);
       }
 
-      for (auto&& requirement : command->GetRequirements()) {
+      for (auto&& requirement : scheduled.requiredSubsystems) {
         m_impl->requirements.erase(requirement);
       }
 
-      m_impl->scheduledCommands.erase(iterator);
-      m_watchdog.AddEpoch(command->GetName() + ".End(false)");
+      m_impl->requiredMask.Remove(scheduled.requirements);
+      m_impl->scheduledCommands.erase(command);
+      scheduled.command = nullptr;
+      m_watchdog.AddEpoch(scheduled.endEpoch);
     }
   }
   m_impl->inRunLoop = false;
+  m_impl->scheduledOrder.erase(
+      std::remove_if(m_impl->scheduledOrder.begin(),
+                     m_impl->scheduledOrder.end(),
+                     [](auto& scheduled) { return !scheduled.command; }),
+      m_impl->scheduledOrder.end());
 
-  for (auto&& commandInterruptible : m_impl->toSchedule) {
-    Schedule(commandInterruptible.second, commandInterruptible.first);
+  // Highest priority first, so a lower-priority command isn't started just to
+  // be preempted; requests with the same priority keep their order
+  std::stable_sort(
+      m_impl->toSchedule.begin(), m_impl->toSchedule.end(),
+      [](auto& a, auto& b) { return a.priority > b.priority; });
+  for (auto&& request : m_impl->toSchedule) {
+    Schedule(request.interruptible, request.priority, request.command);
   }
 
   for (auto&& command : m_impl->toCancel) {
@@ -252,9 +689,10 @@ void CommandScheduler::Run() {
 
   // Add default commands for un-required registered subsystems.
   for (auto&& subsystem : m_impl->subsystems) {
-    auto s = m_impl->requirements.find(subsystem.getFirst());
-    if (s == m_impl->requirements.end() && subsystem.getSecond()) {
-      Schedule({subsystem.getSecond().get()});
+    auto& registered = subsystem.getSecond();
+    if (registered.defaultCommand &&
+        !m_impl->requiredMask.Test(registered.index)) {
+      Schedule({registered.defaultCommand.get()});
     }
   }
 
@@ -265,13 +703,14 @@ void CommandScheduler::Run() {
 }
 
 void CommandScheduler::RegisterSubsystem(Subsystem* subsystem) {
-  m_impl->subsystems[subsystem] = nullptr;
+  m_impl->Register(subsystem).defaultCommand = nullptr;
 }
 
 void CommandScheduler::UnregisterSubsystem(Subsystem* subsystem) {
   auto s = m_impl->subsystems.find(subsystem);
   if (s != m_impl->subsystems.end()) {
     m_impl->subsystems.erase(s);
+    m_impl->periodicPlanValid = false;
   }
 }
 
@@ -306,7 +745,7 @@ void CommandScheduler::UnregisterSubsystem(
 Command* CommandScheduler::GetDefaultCommand(const Subsystem* subsystem) const {
   auto&& find = m_impl->subsystems.find(subsystem);
   if (find != m_impl->subsystems.end()) {
-    return find->second.get();
+    return find->second.defaultCommand.get();
   } else {
     return nullptr;
   }
@@ -330,13 +769,16 @@ void CommandScheduler::Cancel(Command* command) {
   for (auto&& action : m_impl->interruptActions) {
     action(*command);
   }
-  m_watchdog.AddEpoch(command->GetName() + ".End(true)");
-  m_impl->scheduledCommands.erase(find);
-  for (auto&& requirement : m_impl->requirements) {
-    if (requirement.second == command) {
-      m_impl->requirements.erase(requirement.first);
-    }
+  auto scheduled = std::find_if(
+      m_impl->scheduledOrder.begin(), m_impl->scheduledOrder.end(),
+      [&](auto& scheduled) { return scheduled.command == command; });
+  m_watchdog.AddEpoch(scheduled->interruptEpoch);
+  m_impl->requiredMask.Remove(scheduled->requirements);
+  for (auto&& requirement : scheduled->requiredSubsystems) {
+    m_impl->requirements.erase(requirement);
   }
+  m_impl->scheduledOrder.erase(scheduled);
+  m_impl->scheduledCommands.erase(find);
 }
 
 void CommandScheduler::Cancel(wpi::span<Command* const> commands) {
@@ -353,8 +795,8 @@ void CommandScheduler::Cancel(std::initializer_list<Command*> commands) {
 
 void CommandScheduler::CancelAll() {
   wpi::SmallVector<Command*, 16> commands;
-  for (auto&& command : m_impl->scheduledCommands) {
-    commands.emplace_back(command.first);
+  for (auto&& scheduled : m_impl->scheduledOrder) {
+    commands.emplace_back(scheduled.command);
   }
   Cancel(commands);
 }
@@ -448,9 +890,9 @@ void CommandScheduler::InitSendable(nt::NTSendableBuilder& builder) {
 
     wpi::SmallVector<std::string, 8> names;
     wpi::SmallVector<double, 8> ids;
-    for (auto&& command : m_impl->scheduledCommands) {
-      names.emplace_back(command.first->GetName());
-      uintptr_t ptrTmp = reinterpret_cast<uintptr_t>(command.first);
+    for (auto&& scheduled : m_impl->scheduledOrder) {
+      names.emplace_back(scheduled.command->GetName());
+      uintptr_t ptrTmp = reinterpret_cast<uintptr_t>(scheduled.command);
       ids.emplace_back(static_cast<double>(ptrTmp));
     }
     nt::NetworkTableEntry(namesEntry).SetStringArray(names);
@@ -460,5 +902,5 @@ void CommandScheduler::InitSendable(nt::NTSendableBuilder& builder) {
 
 void CommandScheduler::SetDefaultCommandImpl(Subsystem* subsystem,
                                              std::unique_ptr<Command> command) {
-  m_impl->subsystems[subsystem] = std::move(command);
+  m_impl->Register(subsystem).defaultCommand = std::move(command);
 }
@@ -7,8 +7,8 @@
 #include <frc/Timer.h>
 
 using namespace frc2;
-CommandState::CommandState(bool interruptible)
-    : m_interruptible{interruptible} {
+CommandState::CommandState(bool interruptible, int priority)
+    : m_interruptible{interruptible}, m_priority{priority} {
   StartTiming();
   StartRunning();
 }
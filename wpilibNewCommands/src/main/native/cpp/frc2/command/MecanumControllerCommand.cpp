@@ -255,6 +255,7 @@ MecanumControllerCommand::MecanumControllerCommand(
 
 void MecanumControllerCommand::Initialize() {
   m_prevTime = 0_s;
+  m_sampler = frc::TrajectorySampler{m_trajectory};
   auto initialState = m_trajectory.Sample(0_s);
 
   auto initialXVelocity =
@@ -279,7 +280,7 @@ void MecanumControllerCommand::Execute() {
   auto curTime = second_t(m_timer.Get());
   auto dt = curTime - m_prevTime;
 
-  auto m_desiredState = m_trajectory.Sample(curTime);
+  auto m_desiredState = m_sampler.Sample(curTime);
 
   auto targetChassisSpeeds =
       m_controller.Calculate(m_pose(), m_desiredState, m_desiredRotation());
@@ -12,44 +12,19 @@ ParallelCommandGroup::ParallelCommandGroup(
 }
 
 void ParallelCommandGroup::Initialize() {
-  for (auto& commandRunning : m_commands) {
-    commandRunning.first->Initialize();
-    commandRunning.second = true;
-  }
-  isRunning = true;
+  m_program.Initialize(this);
 }
 
 void ParallelCommandGroup::Execute() {
-  for (auto& commandRunning : m_commands) {
-    if (!commandRunning.second) {
-      continue;
-    }
-    commandRunning.first->Execute();
-    if (commandRunning.first->IsFinished()) {
-      commandRunning.first->End(false);
-      commandRunning.second = false;
-    }
-  }
+  m_program.Execute();
 }
 
 void ParallelCommandGroup::End(bool interrupted) {
-  if (interrupted) {
-    for (auto& commandRunning : m_commands) {
-      if (commandRunning.second) {
-        commandRunning.first->End(true);
-      }
-    }
-  }
-  isRunning = false;
+  m_program.End(interrupted);
 }
 
 bool ParallelCommandGroup::IsFinished() {
-  for (auto& command : m_commands) {
-    if (command.second) {
-      return false;
-    }
-  }
-  return true;
+  return m_program.IsFinished();
 }
 
 bool ParallelCommandGroup::RunsWhenDisabled() const {
@@ -64,7 +39,7 @@ void ParallelCommandGroup::AddCommands(
     }
   }
 
-  if (isRunning) {
+  if (m_program.IsRunning()) {
     throw FRC_MakeError(frc::err::CommandIllegalUse, "{}",
                         "Commands cannot be added to a CommandGroup "
                         "while the group is running");
@@ -75,7 +50,7 @@ void ParallelCommandGroup::AddCommands(
       command->SetGrouped(true);
       AddRequirements(command->GetRequirements());
       m_runWhenDisabled &= command->RunsWhenDisabled();
-      m_commands.emplace_back(std::move(command), false);
+      m_commands.emplace_back(std::move(command));
     } else {
       throw FRC_MakeError(frc::err::CommandIllegalUse, "{}",
                           "Multiple commands in a parallel group cannot "
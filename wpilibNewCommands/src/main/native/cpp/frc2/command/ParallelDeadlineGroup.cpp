@@ -14,39 +14,19 @@ ParallelDeadlineGroup::ParallelDeadlineGroup(
 }
 
 void ParallelDeadlineGroup::Initialize() {
-  for (auto& commandRunning : m_commands) {
-    commandRunning.first->Initialize();
-    commandRunning.second = true;
-  }
-  m_finished = false;
+  m_program.Initialize(this);
 }
 
 void ParallelDeadlineGroup::Execute() {
-  for (auto& commandRunning : m_commands) {
-    if (!commandRunning.second) {
-      continue;
-    }
-    commandRunning.first->Execute();
-    if (commandRunning.first->IsFinished()) {
-      commandRunning.first->End(false);
-      commandRunning.second = false;
-      if (commandRunning.first.get() == m_deadline) {
-        m_finished = true;
-      }
-    }
-  }
+  m_program.Execute();
 }
 
 void ParallelDeadlineGroup::End(bool interrupted) {
-  for (auto& commandRunning : m_commands) {
-    if (commandRunning.second) {
-      commandRunning.first->End(true);
-    }
-  }
+  m_program.End(interrupted);
 }
 
 bool ParallelDeadlineGroup::IsFinished() {
-  return m_finished;
+  return m_program.IsFinished();
 }
 
 bool ParallelDeadlineGroup::RunsWhenDisabled() const {
@@ -59,7 +39,7 @@ void ParallelDeadlineGroup::AddCommands(
     return;
   }
 
-  if (!m_finished) {
+  if (m_program.IsRunning()) {
     throw FRC_MakeError(frc::err::CommandIllegalUse, "{}",
                         "Commands cannot be added to a CommandGroup "
                         "while the group is running");
@@ -70,7 +50,7 @@ void ParallelDeadlineGroup::AddCommands(
       command->SetGrouped(true);
       AddRequirements(command->GetRequirements());
       m_runWhenDisabled &= command->RunsWhenDisabled();
-      m_commands.emplace_back(std::move(command), false);
+      m_commands.emplace_back(std::move(command));
     } else {
       throw FRC_MakeError(frc::err::CommandIllegalUse, "{}",
                           "Multiple commands in a parallel group cannot "
@@ -82,7 +62,7 @@ void ParallelDeadlineGroup::AddCommands(
 void ParallelDeadlineGroup::SetDeadline(std::unique_ptr<Command>&& deadline) {
   m_deadline = deadline.get();
   m_deadline->SetGrouped(true);
-  m_commands.emplace_back(std::move(deadline), false);
+  m_commands.emplace_back(std::move(deadline));
   AddRequirements(m_deadline->GetRequirements());
   m_runWhenDisabled &= m_deadline->RunsWhenDisabled();
 }
@@ -12,31 +12,19 @@ ParallelRaceGroup::ParallelRaceGroup(
 }
 
 void ParallelRaceGroup::Initialize() {
-  m_finished = false;
-  for (auto& commandRunning : m_commands) {
-    commandRunning->Initialize();
-  }
-  isRunning = true;
+  m_program.Initialize(this);
 }
 
 void ParallelRaceGroup::Execute() {
-  for (auto& commandRunning : m_commands) {
-    commandRunning->Execute();
-    if (commandRunning->IsFinished()) {
-      m_finished = true;
-    }
-  }
+  m_program.Execute();
 }
 
 void ParallelRaceGroup::End(bool interrupted) {
-  for (auto& commandRunning : m_commands) {
-    commandRunning->End(!commandRunning->IsFinished());
-  }
-  isRunning = false;
+  m_program.End(interrupted);
 }
 
 bool ParallelRaceGroup::IsFinished() {
-  return m_finished;
+  return m_program.IsFinished();
 }
 
 bool ParallelRaceGroup::RunsWhenDisabled() const {
@@ -49,7 +37,7 @@ void ParallelRaceGroup::AddCommands(
     return;
   }
 
-  if (isRunning) {
+  if (m_program.IsRunning()) {
     throw FRC_MakeError(frc::err::CommandIllegalUse, "{}",
                         "Commands cannot be added to a CommandGroup "
                         "while the group is running");
@@ -87,6 +87,7 @@ RamseteCommand::RamseteCommand(
 
 void RamseteCommand::Initialize() {
   m_prevTime = -1_s;
+  m_sampler = frc::TrajectorySampler{m_trajectory};
   auto initialState = m_trajectory.Sample(0_s);
   m_prevSpeeds = m_kinematics.ToWheelSpeeds(
       frc::ChassisSpeeds{initialState.velocity, 0_mps,
@@ -115,7 +116,7 @@ void RamseteCommand::Execute() {
   }
 
   auto targetWheelSpeeds = m_kinematics.ToWheelSpeeds(
-      m_controller.Calculate(m_pose(), m_trajectory.Sample(curTime)));
+      m_controller.Calculate(m_pose(), m_sampler.Sample(curTime)));
 
   if (m_usePID) {
     auto leftFeedforward = m_feedforward.Calculate(
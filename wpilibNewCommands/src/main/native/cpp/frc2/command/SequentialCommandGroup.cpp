@@ -14,41 +14,19 @@ SequentialCommandGroup::SequentialCommandGroup(
 }
 
 void SequentialCommandGroup::Initialize() {
-  m_currentCommandIndex = 0;
-
-  if (!m_commands.empty()) {
-    m_commands[0]->Initialize();
-  }
+  m_program.Initialize(this);
 }
 
 void SequentialCommandGroup::Execute() {
-  if (m_commands.empty()) {
-    return;
-  }
-
-  auto& currentCommand = m_commands[m_currentCommandIndex];
-
-  currentCommand->Execute();
-  if (currentCommand->IsFinished()) {
-    currentCommand->End(false);
-    m_currentCommandIndex++;
-    if (m_currentCommandIndex < m_commands.size()) {
-      m_commands[m_currentCommandIndex]->Initialize();
-    }
-  }
+  m_program.Execute();
 }
 
 void SequentialCommandGroup::End(bool interrupted) {
-  if (interrupted && !m_commands.empty() &&
-      m_currentCommandIndex != invalid_index &&
-      m_currentCommandIndex < m_commands.size()) {
-    m_commands[m_currentCommandIndex]->End(interrupted);
-  }
-  m_currentCommandIndex = invalid_index;
+  m_program.End(interrupted);
 }
 
 bool SequentialCommandGroup::IsFinished() {
-  return m_currentCommandIndex == m_commands.size();
+  return m_program.IsFinished();
 }
 
 bool SequentialCommandGroup::RunsWhenDisabled() const {
@@ -61,7 +39,7 @@ void SequentialCommandGroup::AddCommands(
     return;
   }
 
-  if (m_currentCommandIndex != invalid_index) {
+  if (m_program.IsRunning()) {
     throw FRC_MakeError(frc::err::CommandIllegalUse, "{}",
                         "Commands cannot be added to a CommandGroup "
                         "while the group is running");
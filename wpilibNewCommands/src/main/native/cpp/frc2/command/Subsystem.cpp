@@ -13,6 +13,14 @@ void Subsystem::Periodic() {}
 
 void Subsystem::SimulationPeriodic() {}
 
+bool Subsystem::IsPeriodicThreadSafe() const {
+  return false;
+}
+
+void Subsystem::GetPeriodicDependencies(
+    wpi::SmallVectorImpl<const void*>& reads,
+    wpi::SmallVectorImpl<const void*>& writes) const {}
+
 Command* Subsystem::GetDefaultCommand() const {
   return CommandScheduler::GetInstance().GetDefaultCommand(this);
 }
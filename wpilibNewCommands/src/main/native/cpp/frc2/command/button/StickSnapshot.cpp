@@ -0,0 +1,74 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc2/command/button/StickSnapshot.h"
+
+#include <frc/DriverStation.h>
+#include <hal/DriverStation.h>
+
+using namespace frc2::detail;
+
+namespace {
+struct StickSnapshot {
+  struct Stick {
+    bool buttonsRead = false;
+    bool povsRead = false;
+    HAL_JoystickButtons buttons;
+    HAL_JoystickPOVs povs;
+  };
+
+  int depth = 0;
+  Stick sticks[frc::DriverStation::kJoystickPorts];
+};
+}  // namespace
+
+static thread_local StickSnapshot snapshot;
+
+ScopedStickSnapshot::ScopedStickSnapshot() {
+  if (snapshot.depth++ == 0) {
+    for (auto& stick : snapshot.sticks) {
+      stick.buttonsRead = false;
+      stick.povsRead = false;
+    }
+  }
+}
+
+ScopedStickSnapshot::~ScopedStickSnapshot() {
+  --snapshot.depth;
+}
+
+bool frc2::detail::GetStickButton(int stick, int button) {
+  if (snapshot.depth == 0 || stick < 0 ||
+      stick >= frc::DriverStation::kJoystickPorts || button <= 0) {
+    return frc::DriverStation::GetStickButton(stick, button);
+  }
+  auto& data = snapshot.sticks[stick];
+  if (!data.buttonsRead) {
+    HAL_GetJoystickButtons(stick, &data.buttons);
+    data.buttonsRead = true;
+  }
+  if (button > data.buttons.count) {
+    // Reports the missing button
+    return frc::DriverStation::GetStickButton(stick, button);
+  }
+  return data.buttons.buttons & 1 << (button - 1);
+}
+
+int frc2::detail::GetStickPOV(int stick, int pov) {
+  if (snapshot.depth == 0 || stick < 0 ||
+      stick >= frc::DriverStation::kJoystickPorts || pov < 0 ||
+      pov >= HAL_kMaxJoystickPOVs) {
+    return frc::DriverStation::GetStickPOV(stick, pov);
+  }
+  auto& data = snapshot.sticks[stick];
+  if (!data.povsRead) {
+    HAL_GetJoystickPOVs(stick, &data.povs);
+    data.povsRead = true;
+  }
+  if (pov >= data.povs.count) {
+    // Reports the missing POV
+    return frc::DriverStation::GetStickPOV(stick, pov);
+  }
+  return data.povs.povs[pov];
+}
@@ -4,6 +4,8 @@
 
 #include "frc2/command/button/Trigger.h"
 
+#include <frc/Timer.h>
+
 #include "frc2/command/InstantCommand.h"
 
 using namespace frc2;
@@ -11,15 +13,11 @@ using namespace frc2;
 Trigger::Trigger(const Trigger& other) = default;
 
 Trigger Trigger::WhenActive(Command* command, bool interruptible) {
-  CommandScheduler::GetInstance().AddButton(
-      [pressedLast = m_isActive(), *this, command, interruptible]() mutable {
-        bool pressed = m_isActive();
-
+  AddBinding(
+      [command, interruptible](bool pressed, bool pressedLast) {
         if (!pressedLast && pressed) {
           command->Schedule(interruptible);
         }
-
-        pressedLast = pressed;
       });
 
   return *this;
@@ -37,18 +35,15 @@ Trigger Trigger::WhenActive(std::function<void()> toRun,
 }
 
 Trigger Trigger::WhileActiveContinous(Command* command, bool interruptible) {
-  CommandScheduler::GetInstance().AddButton(
-      [pressedLast = m_isActive(), *this, command, interruptible]() mutable {
-        bool pressed = m_isActive();
-
+  AddBinding(
+      [command, interruptible](bool pressed, bool pressedLast) {
         if (pressed) {
           command->Schedule(interruptible);
         } else if (pressedLast && !pressed) {
           command->Cancel();
         }
-
-        pressedLast = pressed;
-      });
+      },
+      true);
   return *this;
 }
 
@@ -65,31 +60,23 @@ Trigger Trigger::WhileActiveContinous(
 }
 
 Trigger Trigger::WhileActiveOnce(Command* command, bool interruptible) {
-  CommandScheduler::GetInstance().AddButton(
-      [pressedLast = m_isActive(), *this, command, interruptible]() mutable {
-        bool pressed = m_isActive();
-
+  AddBinding(
+      [command, interruptible](bool pressed, bool pressedLast) {
         if (!pressedLast && pressed) {
           command->Schedule(interruptible);
         } else if (pressedLast && !pressed) {
           command->Cancel();
         }
-
-        pressedLast = pressed;
       });
   return *this;
 }
 
 Trigger Trigger::WhenInactive(Command* command, bool interruptible) {
-  CommandScheduler::GetInstance().AddButton(
-      [pressedLast = m_isActive(), *this, command, interruptible]() mutable {
-        bool pressed = m_isActive();
-
+  AddBinding(
+      [command, interruptible](bool pressed, bool pressedLast) {
         if (pressedLast && !pressed) {
           command->Schedule(interruptible);
         }
-
-        pressedLast = pressed;
       });
   return *this;
 }
@@ -106,10 +93,8 @@ Trigger Trigger::WhenInactive(std::function<void()> toRun,
 }
 
 Trigger Trigger::ToggleWhenActive(Command* command, bool interruptible) {
-  CommandScheduler::GetInstance().AddButton(
-      [pressedLast = m_isActive(), *this, command, interruptible]() mutable {
-        bool pressed = m_isActive();
-
+  AddBinding(
+      [command, interruptible](bool pressed, bool pressedLast) {
         if (!pressedLast && pressed) {
           if (command->IsScheduled()) {
             command->Cancel();
@@ -117,22 +102,37 @@ Trigger Trigger::ToggleWhenActive(Command* command, bool interruptible) {
             command->Schedule(interruptible);
           }
         }
-
-        pressedLast = pressed;
       });
   return *this;
 }
 
 Trigger Trigger::CancelWhenActive(Command* command) {
-  CommandScheduler::GetInstance().AddButton(
-      [pressedLast = m_isActive(), *this, command]() mutable {
-        bool pressed = m_isActive();
-
+  AddBinding(
+      [command](bool pressed, bool pressedLast) {
         if (!pressedLast && pressed) {
           command->Cancel();
         }
-
-        pressedLast = pressed;
       });
   return *this;
 }
+
+Trigger Trigger::Debounce(units::second_t debounceTime, DebounceType type) {
+  // Same behavior as frc::Debouncer, with its state kept in the condition
+  return Trigger([isActive = m_isActive, debounceTime, type,
+                  baseline = type == DebounceType::kFalling,
+                  changeTime = frc::Timer::GetFPGATimestamp()]() mutable {
+    bool input = (*isActive)();
+    auto now = frc::Timer::GetFPGATimestamp();
+    if (input == baseline) {
+      changeTime = now;
+    }
+    if (now - changeTime >= debounceTime) {
+      if (type == DebounceType::kBoth) {
+        baseline = input;
+        changeTime = now;
+      }
+      return input;
+    }
+    return baseline;
+  });
+}
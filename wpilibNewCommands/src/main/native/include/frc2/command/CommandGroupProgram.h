@@ -0,0 +1,106 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <wpi/SmallVector.h>
+
+namespace frc2 {
+class Command;
+
+namespace detail {
+
+/**
+ * Runs a command group as a flat program.  When the group is initialized, it
+ * and every group nested in it are compiled into a single array of nodes, so
+ * each loop only the running leaf commands are called; the nested groups are
+ * run by the program instead of through their own Execute() and IsFinished().
+ *
+ * Only groups of exactly the types SequentialCommandGroup,
+ * ParallelCommandGroup, ParallelRaceGroup and ParallelDeadlineGroup are
+ * inlined.  Subclasses of them may override their methods, so they are run as
+ * leaf commands, with their own program.
+ */
+class CommandGroupProgram {
+ public:
+  /**
+   * Compiles the group and initializes it.
+   *
+   * @param group The group that owns this program.
+   */
+  void Initialize(Command* group);
+
+  void Execute();
+
+  void End(bool interrupted);
+
+  bool IsFinished();
+
+  /**
+   * Whether the group has been initialized and not ended.
+   */
+  bool IsRunning() const { return m_running; }
+
+ private:
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  enum class Kind : uint8_t {
+    kLeaf,
+    kSequential,
+    kParallel,
+    kRace,
+    kDeadline
+  };
+
+  // Nodes are stored in pre-order, so the children of a group follow it and
+  // the next sibling of a node is at its end index
+  struct Node {
+    Command* command;
+    Kind kind;
+    uint32_t parent;
+    // One past the last node of this node's subtree
+    uint32_t end;
+    uint32_t numChildren = 0;
+
+    // Whether the node has been initialized and not ended
+    bool running = false;
+    // Whether a race or deadline group has finished
+    bool finished = false;
+    // The running child of a sequential group; the group's end index once all
+    // of its children have finished
+    uint32_t current = kNone;
+    // The number of running children of a parallel or deadline group
+    uint32_t numRunning = 0;
+
+    // Scratch for EndNode()
+    bool ending = false;
+    bool endInterrupted = false;
+  };
+
+  // A group being executed, and the child of it that is executed next
+  struct Frame {
+    uint32_t group;
+    uint32_t child;
+  };
+
+  void Compile(Command* command, uint32_t parent);
+  void InitializeNode(uint32_t index);
+  void EndNode(uint32_t index, bool interrupted);
+  bool IsNodeFinished(uint32_t index);
+
+  Frame BeginGroup(uint32_t group);
+  uint32_t NextRunningChild(uint32_t group, uint32_t from);
+  void ChildExecuted(Frame& frame);
+
+  std::vector<Node> m_nodes;
+  wpi::SmallVector<Frame, 8> m_stack;
+  bool m_running = false;
+};
+
+}  // namespace detail
+}  // namespace frc2
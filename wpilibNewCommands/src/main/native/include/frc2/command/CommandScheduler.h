@@ -49,6 +49,22 @@ class CommandScheduler final : public nt::NTSendable,
    */
   void SetPeriod(units::second_t period);
 
+  /**
+   * Runs the Periodic() of thread-safe subsystems (see
+   * Subsystem::IsPeriodicThreadSafe()) in parallel on a pool of real-time
+   * worker threads, before the other subsystems run one at a time on the
+   * calling thread.  Subsystems with conflicting dependencies are run one
+   * after the other, in the order they were registered.
+   *
+   * <p>In simulation, every subsystem is run on the calling thread in the same
+   * order, so simulations stay deterministic.
+   *
+   * @param numThreads The number of worker threads, or 0 to run all subsystems
+   * on the calling thread.
+   * @param priority The real-time priority of the worker threads.
+   */
+  void SetParallelPeriodic(int numThreads, int priority = 15);
+
   /**
    * Adds a button binding to the scheduler, which will be polled to schedule
    * commands.
@@ -57,6 +73,20 @@ class CommandScheduler final : public nt::NTSendable,
    */
   void AddButton(wpi::unique_function<void()> button);
 
+  /**
+   * Adds a button binding that is only called when its condition changes.
+   * Bindings added with the same condition share a single evaluation of it
+   * each time the buttons are polled.
+   *
+   * @param condition The condition of the binding
+   * @param binding Called with the current and previous value of the condition
+   * @param continuous Whether to also call the binding every time the buttons
+   * are polled while the condition is true
+   */
+  void AddButtonBinding(std::shared_ptr<std::function<bool()>> condition,
+                        wpi::unique_function<void(bool, bool)> binding,
+                        bool continuous = false);
+
   /**
    * Removes all button bindings from the scheduler.
    */
@@ -74,6 +104,25 @@ class CommandScheduler final : public nt::NTSendable,
    */
   void Schedule(bool interruptible, Command* command);
 
+  /**
+   * Schedules a command for execution with a priority.  Does nothing if the
+   * command is already scheduled.  If a command's requirements are not
+   * available, it will only be started if all the commands currently using
+   * those requirements have been scheduled as interruptible and with a
+   * priority no higher than this command's.  If this is the case, they will be
+   * interrupted and the command will be scheduled; otherwise the command is not
+   * scheduled.
+   *
+   * <p>Commands scheduled without a priority have priority 0.  Commands
+   * scheduled while the scheduler is running commands are started after the
+   * run loop, highest priority first.
+   *
+   * @param interruptible whether this command can be interrupted
+   * @param priority      the priority of the command
+   * @param command       the command to schedule
+   */
+  void Schedule(bool interruptible, int priority, Command* command);
+
   /**
    * Schedules a command for execution, with interruptible defaulted to true.
    * Does nothing if the command is already scheduled.
@@ -341,6 +390,9 @@ class CommandScheduler final : public nt::NTSendable,
   void SetDefaultCommandImpl(Subsystem* subsystem,
                              std::unique_ptr<Command> command);
 
+  void RunPeriodic(Subsystem* subsystem);
+  void RunParallelPeriodic();
+
   class Impl;
   std::unique_ptr<Impl> m_impl;
 
@@ -15,16 +15,19 @@ class CommandState final {
  public:
   CommandState() = default;
 
-  explicit CommandState(bool interruptible);
+  explicit CommandState(bool interruptible, int priority = 0);
 
   bool IsInterruptible() const { return m_interruptible; }
 
+  int GetPriority() const { return m_priority; }
+
   // The time since this command was initialized.
   units::second_t TimeSinceInitialized() const;
 
  private:
   units::second_t m_startTime = -1_s;
   bool m_interruptible;
+  int m_priority = 0;
 
   void StartTiming();
   void StartRunning();
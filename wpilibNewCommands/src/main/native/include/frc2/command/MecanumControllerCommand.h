@@ -17,6 +17,7 @@
 #include <frc/kinematics/MecanumDriveKinematics.h>
 #include <frc/kinematics/MecanumDriveWheelSpeeds.h>
 #include <frc/trajectory/Trajectory.h>
+#include <frc/trajectory/TrajectorySampler.h>
 #include <units/angle.h>
 #include <units/length.h>
 #include <units/velocity.h>
@@ -425,6 +426,8 @@ class MecanumControllerCommand
 
  private:
   frc::Trajectory m_trajectory;
+  // set once scheduled, as the command may be moved before then
+  frc::TrajectorySampler m_sampler;
   std::function<frc::Pose2d()> m_pose;
   frc::SimpleMotorFeedforward<units::meters> m_feedforward;
   frc::MecanumDriveKinematics m_kinematics;
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "frc2/command/CommandGroupBase.h"
+#include "frc2/command/CommandGroupProgram.h"
 #include "frc2/command/CommandHelper.h"
 
 namespace frc2 {
@@ -85,9 +86,11 @@ class ParallelCommandGroup
  private:
   void AddCommands(std::vector<std::unique_ptr<Command>>&& commands) final;
 
-  std::vector<std::pair<std::unique_ptr<Command>, bool>> m_commands;
+  friend class detail::CommandGroupProgram;
+
+  std::vector<std::unique_ptr<Command>> m_commands;
+  detail::CommandGroupProgram m_program;
   bool m_runWhenDisabled{true};
-  bool isRunning = false;
 };
 }  // namespace frc2
 
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "frc2/command/CommandGroupBase.h"
+#include "frc2/command/CommandGroupProgram.h"
 #include "frc2/command/CommandHelper.h"
 
 namespace frc2 {
@@ -95,10 +96,13 @@ class ParallelDeadlineGroup
 
   void SetDeadline(std::unique_ptr<Command>&& deadline);
 
-  std::vector<std::pair<std::unique_ptr<Command>, bool>> m_commands;
+  friend class detail::CommandGroupProgram;
+
+  // The deadline is always the first command
+  std::vector<std::unique_ptr<Command>> m_commands;
   Command* m_deadline;
+  detail::CommandGroupProgram m_program;
   bool m_runWhenDisabled{true};
-  bool m_finished{true};
 };
 }  // namespace frc2
 
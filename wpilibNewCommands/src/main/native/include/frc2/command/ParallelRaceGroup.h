@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "frc2/command/CommandGroupBase.h"
+#include "frc2/command/CommandGroupProgram.h"
 #include "frc2/command/CommandHelper.h"
 
 namespace frc2 {
@@ -73,10 +74,11 @@ class ParallelRaceGroup
  private:
   void AddCommands(std::vector<std::unique_ptr<Command>>&& commands) final;
 
+  friend class detail::CommandGroupProgram;
+
   std::vector<std::unique_ptr<Command>> m_commands;
+  detail::CommandGroupProgram m_program;
   bool m_runWhenDisabled{true};
-  bool m_finished{false};
-  bool isRunning = false;
 };
 }  // namespace frc2
 
@@ -15,6 +15,7 @@
 #include <frc/geometry/Pose2d.h>
 #include <frc/kinematics/DifferentialDriveKinematics.h>
 #include <frc/trajectory/Trajectory.h>
+#include <frc/trajectory/TrajectorySampler.h>
 #include <units/length.h>
 #include <units/voltage.h>
 #include <wpi/span.h>
@@ -174,6 +175,8 @@ class RamseteCommand : public CommandHelper<CommandBase, RamseteCommand> {
 
  private:
   frc::Trajectory m_trajectory;
+  // set once scheduled, as the command may be moved before then
+  frc::TrajectorySampler m_sampler;
   std::function<frc::Pose2d()> m_pose;
   frc::RamseteController m_controller;
   frc::SimpleMotorFeedforward<units::meters> m_feedforward;
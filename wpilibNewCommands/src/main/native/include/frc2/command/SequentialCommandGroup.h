@@ -18,6 +18,7 @@
 #include <wpi/span.h>
 
 #include "frc2/command/CommandGroupBase.h"
+#include "frc2/command/CommandGroupProgram.h"
 #include "frc2/command/CommandHelper.h"
 
 namespace frc2 {
@@ -99,8 +100,10 @@ class SequentialCommandGroup
  private:
   void AddCommands(std::vector<std::unique_ptr<Command>>&& commands) final;
 
+  friend class detail::CommandGroupProgram;
+
   wpi::SmallVector<std::unique_ptr<Command>, 4> m_commands;
-  size_t m_currentCommandIndex{invalid_index};
+  detail::CommandGroupProgram m_program;
   bool m_runWhenDisabled{true};
 };
 }  // namespace frc2
@@ -0,0 +1,531 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable : 4521)
+#endif
+
+#include <stddef.h>
+
+#include <array>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <frc/Errors.h>
+#include <units/time.h>
+
+#include "frc2/command/CommandBase.h"
+#include "frc2/command/CommandGroupBase.h"
+#include "frc2/command/CommandHelper.h"
+#include "frc2/command/WaitCommand.h"
+
+namespace frc2 {
+namespace detail {
+
+// Calls func(command, index) for each command of the tuple, in order.  The
+// calls go straight to each command's own type, since the commands are stored
+// by value.
+template <typename Tuple, typename Func, size_t... Is>
+void ForEachCommand(Tuple& commands, Func&& func, std::index_sequence<Is...>) {
+  (func(std::get<Is>(commands), Is), ...);
+}
+
+// Calls func(command) for the command of the tuple at a runtime index
+template <typename Tuple, typename Func, size_t... Is>
+void VisitCommand(Tuple& commands, size_t index, Func&& func,
+                  std::index_sequence<Is...>) {
+  ((index == Is ? func(std::get<Is>(commands)) : void()), ...);
+}
+
+// Builds a static group from the commands' requirements, like the dynamic
+// groups do when commands are added to them
+template <bool Parallel, typename Group, typename... Commands>
+void AddStaticGroupCommands(Group& group, Commands&... commands) {
+  CommandGroupBase::RequireUngrouped({&commands...});
+  (
+      [&](Command& command) {
+        if constexpr (Parallel) {
+          if (!RequirementsDisjoint(&group, &command)) {
+            throw FRC_MakeError(frc::err::CommandIllegalUse, "{}",
+                                "Multiple commands in a parallel group cannot "
+                                "require the same subsystems");
+          }
+        }
+        command.SetGrouped(true);
+        group.AddRequirements(command.GetRequirements());
+      }(commands),
+      ...);
+}
+
+}  // namespace detail
+
+/**
+ * A SequentialCommandGroup whose commands are stored by value, with their
+ * types known at compile time.  The commands aren't heap-allocated, and
+ * calls to them are not virtual, so compositions of concrete command types
+ * build a single object; only the outermost group is type-erased when it is
+ * scheduled or added to another group.
+ *
+ * <p>Use MakeSequence() to deduce the command types.
+ *
+ * @see SequentialCommandGroup
+ */
+template <typename... Commands>
+class StaticSequentialGroup
+    : public CommandHelper<CommandBase, StaticSequentialGroup<Commands...>> {
+  static_assert(std::conjunction_v<std::is_base_of<Command, Commands>...>,
+                "Static groups can only hold commands");
+
+ public:
+  /**
+   * Creates a new StaticSequentialGroup.  The given commands will be run
+   * sequentially, with the group finishing when the last command finishes.
+   *
+   * @param commands the commands to include in this group.
+   */
+  explicit StaticSequentialGroup(Commands... commands)
+      : m_commands{std::move(commands)...} {
+    std::apply(
+        [this](auto&... commands) {
+          detail::AddStaticGroupCommands<false>(*this, commands...);
+        },
+        m_commands);
+  }
+
+  StaticSequentialGroup(StaticSequentialGroup&& other) = default;
+
+  // No copy constructors for command groups
+  StaticSequentialGroup(const StaticSequentialGroup&) = delete;
+
+  // Prevent template expansion from emulating copy ctor
+  StaticSequentialGroup(StaticSequentialGroup&) = delete;
+
+  void Initialize() override {
+    m_currentCommandIndex = 0;
+    Visit(0, [](auto& command) { InitializeCommand(command); });
+  }
+
+  void Execute() override {
+    Visit(m_currentCommandIndex, [this](auto& command) {
+      using T = std::remove_reference_t<decltype(command)>;
+      command.T::Execute();
+      if (command.T::IsFinished()) {
+        command.T::End(false);
+        ++m_currentCommandIndex;
+        Visit(m_currentCommandIndex,
+              [](auto& next) { InitializeCommand(next); });
+      }
+    });
+  }
+
+  void End(bool interrupted) override {
+    if (interrupted) {
+      Visit(m_currentCommandIndex, [](auto& command) {
+        using T = std::remove_reference_t<decltype(command)>;
+        command.T::End(true);
+      });
+    }
+    m_currentCommandIndex = kInvalidIndex;
+  }
+
+  bool IsFinished() override {
+    return m_currentCommandIndex == sizeof...(Commands);
+  }
+
+  bool RunsWhenDisabled() const override {
+    return std::apply(
+        [](auto&... commands) {
+          return (true && ... && commands.RunsWhenDisabled());
+        },
+        m_commands);
+  }
+
+ private:
+  static constexpr size_t kInvalidIndex = std::numeric_limits<size_t>::max();
+
+  template <typename T>
+  static void InitializeCommand(T& command) {
+    command.T::Initialize();
+  }
+
+  template <typename Func>
+  void Visit(size_t index, Func&& func) {
+    detail::VisitCommand(m_commands, index, std::forward<Func>(func),
+                         std::index_sequence_for<Commands...>{});
+  }
+
+  std::tuple<Commands...> m_commands;
+  size_t m_currentCommandIndex{kInvalidIndex};
+};
+
+/**
+ * A ParallelCommandGroup whose commands are stored by value, with their types
+ * known at compile time.
+ *
+ * <p>Use MakeParallel() to deduce the command types.
+ *
+ * @see ParallelCommandGroup
+ * @see StaticSequentialGroup
+ */
+template <typename... Commands>
+class StaticParallelGroup
+    : public CommandHelper<CommandBase, StaticParallelGroup<Commands...>> {
+  static_assert(std::conjunction_v<std::is_base_of<Command, Commands>...>,
+                "Static groups can only hold commands");
+
+ public:
+  /**
+   * Creates a new StaticParallelGroup.  The given commands will be executed
+   * simultaneously. The command group will finish when the last command
+   * finishes.  If the CommandGroup is interrupted, only the commands that are
+   * still running will be interrupted.
+   *
+   * @param commands the commands to include in this group.
+   */
+  explicit StaticParallelGroup(Commands... commands)
+      : m_commands{std::move(commands)...} {
+    std::apply(
+        [this](auto&... commands) {
+          detail::AddStaticGroupCommands<true>(*this, commands...);
+        },
+        m_commands);
+  }
+
+  StaticParallelGroup(StaticParallelGroup&& other) = default;
+
+  // No copy constructors for command groups
+  StaticParallelGroup(const StaticParallelGroup&) = delete;
+
+  // Prevent template expansion from emulating copy ctor
+  StaticParallelGroup(StaticParallelGroup&) = delete;
+
+  void Initialize() override {
+    ForEach([this](auto& command, size_t i) {
+      using T = std::remove_reference_t<decltype(command)>;
+      command.T::Initialize();
+      m_running[i] = true;
+    });
+  }
+
+  void Execute() override {
+    ForEach([this](auto& command, size_t i) {
+      using T = std::remove_reference_t<decltype(command)>;
+      if (!m_running[i]) {
+        return;
+      }
+      command.T::Execute();
+      if (command.T::IsFinished()) {
+        command.T::End(false);
+        m_running[i] = false;
+      }
+    });
+  }
+
+  void End(bool interrupted) override {
+    if (interrupted) {
+      ForEach([this](auto& command, size_t i) {
+        using T = std::remove_reference_t<decltype(command)>;
+        if (m_running[i]) {
+          command.T::End(true);
+        }
+      });
+    }
+  }
+
+  bool IsFinished() override {
+    for (bool running : m_running) {
+      if (running) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool RunsWhenDisabled() const override {
+    return std::apply(
+        [](auto&... commands) {
+          return (true && ... && commands.RunsWhenDisabled());
+        },
+        m_commands);
+  }
+
+ private:
+  template <typename Func>
+  void ForEach(Func&& func) {
+    detail::ForEachCommand(m_commands, std::forward<Func>(func),
+                           std::index_sequence_for<Commands...>{});
+  }
+
+  std::tuple<Commands...> m_commands;
+  std::array<bool, sizeof...(Commands)> m_running{};
+};
+
+/**
+ * A ParallelRaceGroup whose commands are stored by value, with their types
+ * known at compile time.
+ *
+ * <p>Use MakeRace() to deduce the command types.
+ *
+ * @see ParallelRaceGroup
+ * @see StaticSequentialGroup
+ */
+template <typename... Commands>
+class StaticRaceGroup
+    : public CommandHelper<CommandBase, StaticRaceGroup<Commands...>> {
+  static_assert(std::conjunction_v<std::is_base_of<Command, Commands>...>,
+                "Static groups can only hold commands");
+
+ public:
+  /**
+   * Creates a new StaticRaceGroup.  The given commands will be executed
+   * simultaneously, and will "race to the finish" - the first command to
+   * finish ends the entire command, with all other commands being interrupted.
+   *
+   * @param commands the commands to include in this group.
+   */
+  explicit StaticRaceGroup(Commands... commands)
+      : m_commands{std::move(commands)...} {
+    std::apply(
+        [this](auto&... commands) {
+          detail::AddStaticGroupCommands<true>(*this, commands...);
+        },
+        m_commands);
+  }
+
+  StaticRaceGroup(StaticRaceGroup&& other) = default;
+
+  // No copy constructors for command groups
+  StaticRaceGroup(const StaticRaceGroup&) = delete;
+
+  // Prevent template expansion from emulating copy ctor
+  StaticRaceGroup(StaticRaceGroup&) = delete;
+
+  void Initialize() override {
+    m_finished = false;
+    ForEach([](auto& command, size_t) {
+      using T = std::remove_reference_t<decltype(command)>;
+      command.T::Initialize();
+    });
+  }
+
+  void Execute() override {
+    ForEach([this](auto& command, size_t) {
+      using T = std::remove_reference_t<decltype(command)>;
+      command.T::Execute();
+      if (command.T::IsFinished()) {
+        m_finished = true;
+      }
+    });
+  }
+
+  void End(bool interrupted) override {
+    ForEach([](auto& command, size_t) {
+      using T = std::remove_reference_t<decltype(command)>;
+      command.T::End(!command.T::IsFinished());
+    });
+  }
+
+  bool IsFinished() override { return m_finished; }
+
+  bool RunsWhenDisabled() const override {
+    return std::apply(
+        [](auto&... commands) {
+          return (true && ... && commands.RunsWhenDisabled());
+        },
+        m_commands);
+  }
+
+ private:
+  template <typename Func>
+  void ForEach(Func&& func) {
+    detail::ForEachCommand(m_commands, std::forward<Func>(func),
+                           std::index_sequence_for<Commands...>{});
+  }
+
+  std::tuple<Commands...> m_commands;
+  bool m_finished{false};
+};
+
+/**
+ * A ParallelDeadlineGroup whose commands are stored by value, with their types
+ * known at compile time.  The first command is the deadline.
+ *
+ * <p>Use MakeDeadline() to deduce the command types.
+ *
+ * @see ParallelDeadlineGroup
+ * @see StaticSequentialGroup
+ */
+template <typename Deadline, typename... Commands>
+class StaticDeadlineGroup
+    : public CommandHelper<CommandBase,
+                           StaticDeadlineGroup<Deadline, Commands...>> {
+  static_assert(std::conjunction_v<std::is_base_of<Command, Deadline>,
+                                   std::is_base_of<Command, Commands>...>,
+                "Static groups can only hold commands");
+
+ public:
+  /**
+   * Creates a new StaticDeadlineGroup.  The given commands (including the
+   * deadline) will be executed simultaneously.  The command group will finish
+   * when the deadline finishes, interrupting all other still-running commands.
+   * If the command group is interrupted, only the commands still running will
+   * be interrupted.
+   *
+   * @param deadline the command that determines when the group ends
+   * @param commands the commands to be executed
+   */
+  explicit StaticDeadlineGroup(Deadline deadline, Commands... commands)
+      : m_commands{std::move(deadline), std::move(commands)...} {
+    std::apply(
+        [this](auto&... commands) {
+          detail::AddStaticGroupCommands<true>(*this, commands...);
+        },
+        m_commands);
+  }
+
+  StaticDeadlineGroup(StaticDeadlineGroup&& other) = default;
+
+  // No copy constructors for command groups
+  StaticDeadlineGroup(const StaticDeadlineGroup&) = delete;
+
+  // Prevent template expansion from emulating copy ctor
+  StaticDeadlineGroup(StaticDeadlineGroup&) = delete;
+
+  void Initialize() override {
+    ForEach([this](auto& command, size_t i) {
+      using T = std::remove_reference_t<decltype(command)>;
+      command.T::Initialize();
+      m_running[i] = true;
+    });
+    m_finished = false;
+  }
+
+  void Execute() override {
+    ForEach([this](auto& command, size_t i) {
+      using T = std::remove_reference_t<decltype(command)>;
+      if (!m_running[i]) {
+        return;
+      }
+      command.T::Execute();
+      if (command.T::IsFinished()) {
+        command.T::End(false);
+        m_running[i] = false;
+        if (i == 0) {
+          m_finished = true;
+        }
+      }
+    });
+  }
+
+  void End(bool interrupted) override {
+    ForEach([this](auto& command, size_t i) {
+      using T = std::remove_reference_t<decltype(command)>;
+      if (m_running[i]) {
+        command.T::End(true);
+      }
+    });
+  }
+
+  bool IsFinished() override { return m_finished; }
+
+  bool RunsWhenDisabled() const override {
+    return std::apply(
+        [](auto&... commands) {
+          return (true && ... && commands.RunsWhenDisabled());
+        },
+        m_commands);
+  }
+
+ private:
+  template <typename Func>
+  void ForEach(Func&& func) {
+    detail::ForEachCommand(
+        m_commands, std::forward<Func>(func),
+        std::index_sequence_for<Deadline, Commands...>{});
+  }
+
+  std::tuple<Deadline, Commands...> m_commands;
+  std::array<bool, 1 + sizeof...(Commands)> m_running{};
+  bool m_finished{true};
+};
+
+/**
+ * Composes commands to run in sequence, without heap-allocating them.
+ *
+ * @param commands the commands to run
+ * @return a StaticSequentialGroup of the commands
+ */
+template <typename... Commands>
+StaticSequentialGroup<std::decay_t<Commands>...> MakeSequence(
+    Commands&&... commands) {
+  return StaticSequentialGroup<std::decay_t<Commands>...>(
+      std::forward<Commands>(commands)...);
+}
+
+/**
+ * Composes commands to run in parallel, without heap-allocating them.
+ *
+ * @param commands the commands to run
+ * @return a StaticParallelGroup of the commands
+ */
+template <typename... Commands>
+StaticParallelGroup<std::decay_t<Commands>...> MakeParallel(
+    Commands&&... commands) {
+  return StaticParallelGroup<std::decay_t<Commands>...>(
+      std::forward<Commands>(commands)...);
+}
+
+/**
+ * Composes commands to race each other, without heap-allocating them.
+ *
+ * @param commands the commands to run
+ * @return a StaticRaceGroup of the commands
+ */
+template <typename... Commands>
+StaticRaceGroup<std::decay_t<Commands>...> MakeRace(Commands&&... commands) {
+  return StaticRaceGroup<std::decay_t<Commands>...>(
+      std::forward<Commands>(commands)...);
+}
+
+/**
+ * Composes commands to run in parallel until a deadline command finishes,
+ * without heap-allocating them.
+ *
+ * @param deadline the command that determines when the group ends
+ * @param commands the other commands to run
+ * @return a StaticDeadlineGroup of the commands
+ */
+template <typename Deadline, typename... Commands>
+StaticDeadlineGroup<std::decay_t<Deadline>, std::decay_t<Commands>...>
+MakeDeadline(Deadline&& deadline, Commands&&... commands) {
+  return StaticDeadlineGroup<std::decay_t<Deadline>,
+                             std::decay_t<Commands>...>(
+      std::forward<Deadline>(deadline), std::forward<Commands>(commands)...);
+}
+
+/**
+ * Interrupts a command if it doesn't finish within a time, without
+ * heap-allocating it; the static version of Command::WithTimeout().
+ *
+ * @param command the command to run
+ * @param duration the timeout
+ * @return a StaticRaceGroup of the command and a WaitCommand
+ */
+template <typename T>
+StaticRaceGroup<std::decay_t<T>, WaitCommand> MakeWithTimeout(
+    T&& command, units::second_t duration) {
+  return StaticRaceGroup<std::decay_t<T>, WaitCommand>(
+      std::forward<T>(command), WaitCommand(duration));
+}
+
+}  // namespace frc2
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
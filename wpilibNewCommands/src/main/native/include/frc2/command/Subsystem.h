@@ -7,6 +7,8 @@
 #include <type_traits>
 #include <utility>
 
+#include <wpi/SmallVector.h>
+
 #include "frc2/command/CommandScheduler.h"
 
 namespace frc2 {
@@ -53,6 +55,31 @@ class Subsystem {
    */
   virtual void SimulationPeriodic();
 
+  /**
+   * Whether Periodic() may be called from a worker thread, in parallel with the
+   * Periodic() of other subsystems, when enabled with
+   * CommandScheduler::SetParallelPeriodic().  A thread-safe Periodic() must
+   * not use anything shared with the rest of the robot program, other than the
+   * data it declares in GetPeriodicDependencies().
+   *
+   * @return Whether Periodic() is thread-safe; false by default.
+   */
+  virtual bool IsPeriodicThreadSafe() const;
+
+  /**
+   * Declares the shared data a thread-safe Periodic() reads and writes,
+   * identified by their addresses.  Two Periodic() calls are not run at the
+   * same time if one of them writes data the other reads or writes.  This is
+   * called when the scheduler plans the parallel periodic phase, so the
+   * dependencies should not change afterwards.
+   *
+   * @param reads Add the addresses of the data read by Periodic() to this.
+   * @param writes Add the addresses of the data written by Periodic() to this.
+   */
+  virtual void GetPeriodicDependencies(
+      wpi::SmallVectorImpl<const void*>& reads,
+      wpi::SmallVectorImpl<const void*>& writes) const;
+
   /**
    * Sets the default Command of the subsystem.  The default command will be
    * automatically scheduled when no other commands are scheduled that require
@@ -16,6 +16,7 @@
 #include <frc/kinematics/SwerveDriveKinematics.h>
 #include <frc/kinematics/SwerveModuleState.h>
 #include <frc/trajectory/Trajectory.h>
+#include <frc/trajectory/TrajectorySampler.h>
 #include <units/length.h>
 #include <units/time.h>
 #include <units/voltage.h>
@@ -217,6 +218,8 @@ class SwerveControllerCommand
 
  private:
   frc::Trajectory m_trajectory;
+  // set once scheduled, as the command may be moved before then
+  frc::TrajectorySampler m_sampler;
   std::function<frc::Pose2d()> m_pose;
   frc::SwerveDriveKinematics<NumModules> m_kinematics;
   frc::HolonomicDriveController m_controller;
@@ -6,6 +6,7 @@
 #include <frc/GenericHID.h>
 
 #include "Button.h"
+#include "StickSnapshot.h"
 
 namespace frc2 {
 /**
@@ -23,8 +24,8 @@ class JoystickButton : public Button {
    * @param buttonNumber The number of the button on the joystic.
    */
   explicit JoystickButton(frc::GenericHID* joystick, int buttonNumber)
-      : Button([joystick, buttonNumber] {
-          return joystick->GetRawButton(buttonNumber);
+      : Button([stick = joystick->GetPort(), buttonNumber] {
+          return detail::GetStickButton(stick, buttonNumber);
         }) {}
 };
 }  // namespace frc2
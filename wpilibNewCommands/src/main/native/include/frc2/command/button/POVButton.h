@@ -6,6 +6,7 @@
 #include <frc/GenericHID.h>
 
 #include "Button.h"
+#include "StickSnapshot.h"
 
 namespace frc2 {
 /**
@@ -24,8 +25,8 @@ class POVButton : public Button {
    * @param povNumber The number of the POV on the joystick.
    */
   POVButton(frc::GenericHID* joystick, int angle, int povNumber = 0)
-      : Button([joystick, angle, povNumber] {
-          return joystick->GetPOV(povNumber) == angle;
+      : Button([stick = joystick->GetPort(), angle, povNumber] {
+          return detail::GetStickPOV(stick, povNumber) == angle;
         }) {}
 };
 }  // namespace frc2
@@ -0,0 +1,41 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+namespace frc2::detail {
+
+/**
+ * Takes a snapshot of the joystick data for the current thread while in scope,
+ * so every button and POV read from it costs a single DriverStation read per
+ * joystick.  The CommandScheduler holds one while polling buttons.
+ */
+class ScopedStickSnapshot {
+ public:
+  ScopedStickSnapshot();
+  ~ScopedStickSnapshot();
+
+  ScopedStickSnapshot(const ScopedStickSnapshot&) = delete;
+  ScopedStickSnapshot& operator=(const ScopedStickSnapshot&) = delete;
+};
+
+/**
+ * Gets a joystick button, from the snapshot if one is in scope.
+ *
+ * @param stick The joystick port.
+ * @param button The button index, beginning at 1.
+ * @return The state of the button.
+ */
+bool GetStickButton(int stick, int button);
+
+/**
+ * Gets a joystick POV, from the snapshot if one is in scope.
+ *
+ * @param stick The joystick port.
+ * @param pov The POV index.
+ * @return The angle of the POV in degrees, or -1 if the POV is not pressed.
+ */
+int GetStickPOV(int stick, int pov);
+
+}  // namespace frc2::detail
@@ -9,6 +9,8 @@
 #include <memory>
 #include <utility>
 
+#include <units/time.h>
+#include <wpi/FunctionExtras.h>
 #include <wpi/span.h>
 
 #include "frc2/command/Command.h"
@@ -26,21 +28,32 @@ class Command;
  */
 class Trigger {
  public:
+  /**
+   * Which changes of a trigger are delayed by Debounce().
+   */
+  enum class DebounceType {
+    /** Delays the trigger becoming active. */
+    kRising,
+    /** Delays the trigger becoming inactive. */
+    kFalling,
+    /** Delays both. */
+    kBoth
+  };
+
   /**
    * Create a new trigger that is active when the given condition is true.
    *
    * @param isActive Whether the trigger is active.
    */
   explicit Trigger(std::function<bool()> isActive)
-      : m_isActive{std::move(isActive)} {}
+      : m_isActive{
+            std::make_shared<std::function<bool()>>(std::move(isActive))} {}
 
   /**
    * Create a new trigger that is never active (default constructor) - activity
    *  can be further determined by subclass code.
    */
-  Trigger() {
-    m_isActive = [] { return false; };
-  }
+  Trigger() : Trigger([] { return false; }) {}
 
   Trigger(const Trigger& other);
 
@@ -68,18 +81,13 @@ class Trigger {
   template <class T, typename = std::enable_if_t<std::is_base_of_v<
                          Command, std::remove_reference_t<T>>>>
   Trigger WhenActive(T&& command, bool interruptible = true) {
-    CommandScheduler::GetInstance().AddButton(
-        [pressedLast = m_isActive(), *this,
-         command = std::make_unique<std::remove_reference_t<T>>(
+    AddBinding(
+        [command = std::make_unique<std::remove_reference_t<T>>(
              std::forward<T>(command)),
-         interruptible]() mutable {
-          bool pressed = m_isActive();
-
+         interruptible](bool pressed, bool pressedLast) {
           if (!pressedLast && pressed) {
             command->Schedule(interruptible);
           }
-
-          pressedLast = pressed;
         });
 
     return *this;
@@ -127,21 +135,17 @@ class Trigger {
   template <class T, typename = std::enable_if_t<std::is_base_of_v<
                          Command, std::remove_reference_t<T>>>>
   Trigger WhileActiveContinous(T&& command, bool interruptible = true) {
-    CommandScheduler::GetInstance().AddButton(
-        [pressedLast = m_isActive(), *this,
-         command = std::make_unique<std::remove_reference_t<T>>(
+    AddBinding(
+        [command = std::make_unique<std::remove_reference_t<T>>(
              std::forward<T>(command)),
-         interruptible]() mutable {
-          bool pressed = m_isActive();
-
+         interruptible](bool pressed, bool pressedLast) {
           if (pressed) {
             command->Schedule(interruptible);
           } else if (pressedLast && !pressed) {
             command->Cancel();
           }
-
-          pressedLast = pressed;
-        });
+        },
+        true);
     return *this;
   }
 
@@ -187,20 +191,15 @@ class Trigger {
   template <class T, typename = std::enable_if_t<std::is_base_of_v<
                          Command, std::remove_reference_t<T>>>>
   Trigger WhileActiveOnce(T&& command, bool interruptible = true) {
-    CommandScheduler::GetInstance().AddButton(
-        [pressedLast = m_isActive(), *this,
-         command = std::make_unique<std::remove_reference_t<T>>(
+    AddBinding(
+        [command = std::make_unique<std::remove_reference_t<T>>(
              std::forward<T>(command)),
-         interruptible]() mutable {
-          bool pressed = m_isActive();
-
+         interruptible](bool pressed, bool pressedLast) {
           if (!pressedLast && pressed) {
             command->Schedule(interruptible);
           } else if (pressedLast && !pressed) {
             command->Cancel();
           }
-
-          pressedLast = pressed;
         });
     return *this;
   }
@@ -229,18 +228,13 @@ class Trigger {
   template <class T, typename = std::enable_if_t<std::is_base_of_v<
                          Command, std::remove_reference_t<T>>>>
   Trigger WhenInactive(T&& command, bool interruptible = true) {
-    CommandScheduler::GetInstance().AddButton(
-        [pressedLast = m_isActive(), *this,
-         command = std::make_unique<std::remove_reference_t<T>>(
+    AddBinding(
+        [command = std::make_unique<std::remove_reference_t<T>>(
              std::forward<T>(command)),
-         interruptible]() mutable {
-          bool pressed = m_isActive();
-
+         interruptible](bool pressed, bool pressedLast) {
           if (pressedLast && !pressed) {
             command->Schedule(interruptible);
           }
-
-          pressedLast = pressed;
         });
     return *this;
   }
@@ -287,13 +281,10 @@ class Trigger {
   template <class T, typename = std::enable_if_t<std::is_base_of_v<
                          Command, std::remove_reference_t<T>>>>
   Trigger ToggleWhenActive(T&& command, bool interruptible = true) {
-    CommandScheduler::GetInstance().AddButton(
-        [pressedLast = m_isActive(), *this,
-         command = std::make_unique<std::remove_reference_t<T>>(
+    AddBinding(
+        [command = std::make_unique<std::remove_reference_t<T>>(
              std::forward<T>(command)),
-         interruptible]() mutable {
-          bool pressed = m_isActive();
-
+         interruptible](bool pressed, bool pressedLast) {
           if (!pressedLast && pressed) {
             if (command->IsScheduled()) {
               command->Cancel();
@@ -301,8 +292,6 @@ class Trigger {
               command->Schedule(interruptible);
             }
           }
-
-          pressedLast = pressed;
         });
     return *this;
   }
@@ -317,13 +306,27 @@ class Trigger {
    */
   Trigger CancelWhenActive(Command* command);
 
+  /**
+   * Creates a new trigger that only changes once this trigger has held its new
+   * state for the debounce time.  The debouncer state is kept in the new
+   * trigger's condition, so bindings to it don't allocate anything per poll.
+   *
+   * @param debounceTime The time the state must be held.
+   * @param type Which changes to debounce.
+   * @return The debounced trigger.
+   */
+  Trigger Debounce(units::second_t debounceTime,
+                   DebounceType type = DebounceType::kRising);
+
   /**
    * Composes two triggers with logical AND.
    *
    * @return A trigger which is active when both component triggers are active.
    */
   Trigger operator&&(Trigger rhs) {
-    return Trigger([*this, rhs] { return m_isActive() && rhs.m_isActive(); });
+    return Trigger([lhs = m_isActive, rhs = rhs.m_isActive] {
+      return (*lhs)() && (*rhs)();
+    });
   }
 
   /**
@@ -332,7 +335,9 @@ class Trigger {
    * @return A trigger which is active when either component trigger is active.
    */
   Trigger operator||(Trigger rhs) {
-    return Trigger([*this, rhs] { return m_isActive() || rhs.m_isActive(); });
+    return Trigger([lhs = m_isActive, rhs = rhs.m_isActive] {
+      return (*lhs)() || (*rhs)();
+    });
   }
 
   /**
@@ -342,10 +347,18 @@ class Trigger {
    * and vice-versa.
    */
   Trigger operator!() {
-    return Trigger([*this] { return !m_isActive(); });
+    return Trigger([isActive = m_isActive] { return !(*isActive)(); });
   }
 
  private:
-  std::function<bool()> m_isActive;
+  void AddBinding(wpi::unique_function<void(bool, bool)> binding,
+                  bool continuous = false) {
+    CommandScheduler::GetInstance().AddButtonBinding(
+        m_isActive, std::move(binding), continuous);
+  }
+
+  // Shared by copies of the trigger, so the scheduler evaluates it once for
+  // all of their bindings
+  std::shared_ptr<std::function<bool()>> m_isActive;
 };
 }  // namespace frc2
@@ -2,10 +2,16 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <frc/Joystick.h>
+#include <frc/simulation/JoystickSim.h>
+#include <frc/simulation/SimHooks.h>
+
 #include "CommandTestBase.h"
 #include "frc2/command/CommandScheduler.h"
 #include "frc2/command/RunCommand.h"
 #include "frc2/command/WaitUntilCommand.h"
+#include "frc2/command/button/JoystickButton.h"
+#include "frc2/command/button/POVButton.h"
 #include "frc2/command/button/Trigger.h"
 #include "gtest/gtest.h"
 
@@ -190,3 +196,78 @@ TEST_F(ButtonTest, RValueButtonTest) {
   scheduler.Run();
   EXPECT_EQ(counter, 1);
 }
+
+TEST_F(ButtonTest, SharedConditionTest) {
+  auto& scheduler = CommandScheduler::GetInstance();
+  int evaluations = 0;
+  int pressedCount = 0;
+  int releasedCount = 0;
+  bool pressed = false;
+
+  Trigger trigger([&] {
+    evaluations++;
+    return pressed;
+  });
+  trigger.WhenActive([&pressedCount] { pressedCount++; });
+  trigger.WhenInactive([&releasedCount] { releasedCount++; });
+  evaluations = 0;
+
+  scheduler.Run();
+  EXPECT_EQ(evaluations, 1);
+  pressed = true;
+  scheduler.Run();
+  EXPECT_EQ(evaluations, 2);
+  EXPECT_EQ(pressedCount, 1);
+  EXPECT_EQ(releasedCount, 0);
+  pressed = false;
+  scheduler.Run();
+  EXPECT_EQ(pressedCount, 1);
+  EXPECT_EQ(releasedCount, 1);
+}
+
+TEST_F(ButtonTest, DebounceTest) {
+  frc::sim::PauseTiming();
+  auto& scheduler = CommandScheduler::GetInstance();
+  int counter = 0;
+  bool pressed = false;
+
+  Trigger([&pressed] { return pressed; })
+      .Debounce(100_ms)
+      .WhenActive([&counter] { counter++; });
+  pressed = true;
+  scheduler.Run();
+  EXPECT_EQ(counter, 0);
+  frc::sim::StepTiming(50_ms);
+  scheduler.Run();
+  EXPECT_EQ(counter, 0);
+  frc::sim::StepTiming(60_ms);
+  scheduler.Run();
+  EXPECT_EQ(counter, 1);
+  frc::sim::ResumeTiming();
+}
+
+TEST_F(ButtonTest, JoystickButtonTest) {
+  auto& scheduler = CommandScheduler::GetInstance();
+  frc::Joystick joystick{1};
+  frc::sim::JoystickSim joystickSim{joystick};
+  joystickSim.SetButtonCount(4);
+  joystickSim.SetPOVCount(1);
+  joystickSim.SetPOV(-1);
+  joystickSim.NotifyNewData();
+  int buttonCounter = 0;
+  int povCounter = 0;
+
+  JoystickButton(&joystick, 2).WhenPressed([&buttonCounter] {
+    buttonCounter++;
+  });
+  POVButton(&joystick, 90).WhenPressed([&povCounter] { povCounter++; });
+  scheduler.Run();
+  EXPECT_EQ(buttonCounter, 0);
+  EXPECT_EQ(povCounter, 0);
+  joystickSim.SetRawButton(2, true);
+  joystickSim.SetPOV(90);
+  joystickSim.NotifyNewData();
+  scheduler.Run();
+  EXPECT_EQ(buttonCounter, 1);
+  EXPECT_EQ(povCounter, 1);
+}
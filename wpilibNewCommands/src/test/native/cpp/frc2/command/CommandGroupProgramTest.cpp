@@ -0,0 +1,188 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "CommandTestBase.h"
+#include "frc2/command/CommandHelper.h"
+#include "frc2/command/ParallelCommandGroup.h"
+#include "frc2/command/ParallelDeadlineGroup.h"
+#include "frc2/command/ParallelRaceGroup.h"
+#include "frc2/command/SequentialCommandGroup.h"
+
+using namespace frc2;
+class CommandGroupProgramTest : public CommandTestBase {};
+
+namespace {
+// Subclasses of the groups aren't inlined into the program of the group
+// they're in, so they run the way nested groups did before flattening
+class NestedSequential
+    : public CommandHelper<SequentialCommandGroup, NestedSequential> {
+ public:
+  explicit NestedSequential(std::vector<std::unique_ptr<Command>>&& commands)
+      : CommandHelper(std::move(commands)) {}
+};
+
+class NestedParallel
+    : public CommandHelper<ParallelCommandGroup, NestedParallel> {
+ public:
+  explicit NestedParallel(std::vector<std::unique_ptr<Command>>&& commands)
+      : CommandHelper(std::move(commands)) {}
+};
+
+class NestedRace : public CommandHelper<ParallelRaceGroup, NestedRace> {
+ public:
+  explicit NestedRace(std::vector<std::unique_ptr<Command>>&& commands)
+      : CommandHelper(std::move(commands)) {}
+};
+
+class NestedDeadline
+    : public CommandHelper<ParallelDeadlineGroup, NestedDeadline> {
+ public:
+  NestedDeadline(std::unique_ptr<Command>&& deadline,
+                 std::vector<std::unique_ptr<Command>>&& commands)
+      : CommandHelper(std::move(deadline), std::move(commands)) {}
+};
+
+// Finishes a fixed number of executions after it is initialized, and logs
+// every call
+class LoggingCommand : public CommandHelper<CommandBase, LoggingCommand> {
+ public:
+  LoggingCommand(std::vector<std::string>* log, int id, int duration)
+      : m_log{log}, m_id{id}, m_duration{duration} {}
+
+  void Initialize() override {
+    m_executions = 0;
+    m_log->emplace_back(fmt::format("{} Initialize", m_id));
+  }
+
+  void Execute() override {
+    ++m_executions;
+    m_log->emplace_back(fmt::format("{} Execute", m_id));
+  }
+
+  void End(bool interrupted) override {
+    m_log->emplace_back(fmt::format("{} End({})", m_id, interrupted));
+  }
+
+  bool IsFinished() override {
+    m_log->emplace_back(fmt::format("{} IsFinished", m_id));
+    return m_executions >= m_duration;
+  }
+
+ private:
+  std::vector<std::string>* m_log;
+  int m_id;
+  int m_duration;
+  int m_executions = 0;
+};
+
+// Builds the same random tree of groups, either of the group types or of the
+// nested subclasses of them
+class TreeBuilder {
+ public:
+  TreeBuilder(std::vector<std::string>* log, unsigned int seed, bool nested)
+      : m_log{log}, m_random{seed}, m_nested{nested} {}
+
+  std::unique_ptr<Command> Build(int depth) {
+    int kind = depth == 0 ? 0 : Uniform(depth == 3 ? 1 : 0, 4);
+    if (kind == 0) {
+      return std::make_unique<LoggingCommand>(m_log, m_nextId++,
+                                              Uniform(0, 4));
+    }
+    std::vector<std::unique_ptr<Command>> commands;
+    int numCommands = Uniform(0, 3);
+    if (kind == 4) {
+      auto deadline = Build(depth - 1);
+      for (int i = 0; i < numCommands; ++i) {
+        commands.emplace_back(Build(depth - 1));
+      }
+      if (m_nested) {
+        return std::make_unique<NestedDeadline>(std::move(deadline),
+                                                std::move(commands));
+      }
+      return std::make_unique<ParallelDeadlineGroup>(std::move(deadline),
+                                                     std::move(commands));
+    }
+    for (int i = 0; i < numCommands; ++i) {
+      commands.emplace_back(Build(depth - 1));
+    }
+    switch (kind) {
+      case 1:
+        return m_nested ? Make<NestedSequential>(std::move(commands))
+                        : Make<SequentialCommandGroup>(std::move(commands));
+      case 2:
+        return m_nested ? Make<NestedParallel>(std::move(commands))
+                        : Make<ParallelCommandGroup>(std::move(commands));
+      default:
+        return m_nested ? Make<NestedRace>(std::move(commands))
+                        : Make<ParallelRaceGroup>(std::move(commands));
+    }
+  }
+
+  int Uniform(int min, int max) {
+    return std::uniform_int_distribution<int>{min, max}(m_random);
+  }
+
+ private:
+  template <typename Group>
+  static std::unique_ptr<Command> Make(
+      std::vector<std::unique_ptr<Command>>&& commands) {
+    return std::make_unique<Group>(std::move(commands));
+  }
+
+  std::vector<std::string>* m_log;
+  std::mt19937 m_random;
+  bool m_nested;
+  int m_nextId = 0;
+};
+
+std::vector<std::string> RunTree(unsigned int seed, bool nested) {
+  std::vector<std::string> log;
+  TreeBuilder builder{&log, seed, nested};
+  auto root = builder.Build(3);
+  int interruptAt = builder.Uniform(1, 12);
+
+  for (int run = 0; run < 2; ++run) {
+    log.emplace_back("Run");
+    root->Initialize();
+    for (int i = 0;; ++i) {
+      if (i == interruptAt) {
+        root->End(true);
+        break;
+      }
+      root->Execute();
+      if (root->IsFinished()) {
+        root->End(false);
+        break;
+      }
+    }
+  }
+  return log;
+}
+}  // namespace
+
+TEST_F(CommandGroupProgramTest, FlattenedMatchesNestedTest) {
+  for (unsigned int seed = 0; seed < 500; ++seed) {
+    auto flattened = RunTree(seed, false);
+    auto nested = RunTree(seed, true);
+    ASSERT_EQ(nested, flattened) << "seed " << seed;
+  }
+}
+
+TEST_F(CommandGroupProgramTest, AddWhileRunningTest) {
+  std::vector<std::string> log;
+  SequentialCommandGroup group{LoggingCommand{&log, 0, 1}};
+  group.Initialize();
+  EXPECT_THROW(group.AddCommands(LoggingCommand{&log, 1, 1}),
+               frc::RuntimeError);
+  group.End(true);
+  EXPECT_NO_THROW(group.AddCommands(LoggingCommand{&log, 1, 1}));
+}
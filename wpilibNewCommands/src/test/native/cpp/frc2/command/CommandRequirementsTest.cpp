@@ -2,6 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <memory>
+#include <vector>
+
 #include <frc/Errors.h>
 
 #include "CommandTestBase.h"
@@ -11,6 +14,7 @@
 #include "frc2/command/ParallelCommandGroup.h"
 #include "frc2/command/ParallelDeadlineGroup.h"
 #include "frc2/command/ParallelRaceGroup.h"
+#include "frc2/command/RunCommand.h"
 #include "frc2/command/SelectCommand.h"
 #include "frc2/command/SequentialCommandGroup.h"
 
@@ -79,3 +83,106 @@ TEST_F(CommandRequirementsTest, DefaultCommandRequirementErrorTest) {
   ASSERT_THROW(requirement1.SetDefaultCommand(std::move(command1)),
                frc::RuntimeError);
 }
+
+TEST_F(CommandRequirementsTest, ManySubsystemsTest) {
+  CommandScheduler scheduler = GetScheduler();
+
+  // More subsystems than fit in one word of the requirement mask
+  std::vector<std::unique_ptr<TestSubsystem>> subsystems;
+  for (int i = 0; i < 100; ++i) {
+    subsystems.emplace_back(std::make_unique<TestSubsystem>());
+  }
+
+  MockCommand command1({subsystems[3].get(), subsystems[90].get()});
+  MockCommand command2({subsystems[4].get(), subsystems[91].get()});
+  MockCommand command3({subsystems[90].get()});
+
+  EXPECT_CALL(command1, End(true)).Times(2);
+  EXPECT_CALL(command2, End(true));
+  EXPECT_CALL(command3, End(true));
+
+  scheduler.Schedule(&command1);
+  scheduler.Schedule(&command2);
+  EXPECT_TRUE(scheduler.IsScheduled(&command1));
+  EXPECT_TRUE(scheduler.IsScheduled(&command2));
+
+  scheduler.Schedule(&command3);
+  EXPECT_FALSE(scheduler.IsScheduled(&command1));
+  EXPECT_TRUE(scheduler.IsScheduled(&command2));
+  EXPECT_TRUE(scheduler.IsScheduled(&command3));
+  EXPECT_EQ(&command3, scheduler.Requiring(subsystems[90].get()));
+  EXPECT_EQ(nullptr, scheduler.Requiring(subsystems[3].get()));
+
+  scheduler.Schedule(&command1);
+  EXPECT_TRUE(scheduler.IsScheduled(&command1));
+  EXPECT_FALSE(scheduler.IsScheduled(&command3));
+  scheduler.CancelAll();
+}
+
+TEST_F(CommandRequirementsTest, PriorityPreemptionTest) {
+  CommandScheduler scheduler = GetScheduler();
+
+  TestSubsystem requirement;
+
+  MockCommand low({&requirement});
+  MockCommand high({&requirement});
+  MockCommand uninterruptible({&requirement});
+
+  EXPECT_CALL(low, Initialize()).Times(2);
+  EXPECT_CALL(low, End(true)).Times(2);
+  EXPECT_CALL(high, Initialize()).Times(2);
+  EXPECT_CALL(high, End(true)).Times(2);
+  EXPECT_CALL(uninterruptible, Initialize());
+  EXPECT_CALL(uninterruptible, End(true));
+
+  scheduler.Schedule(true, 0, &low);
+  scheduler.Schedule(true, 1, &high);
+  EXPECT_FALSE(scheduler.IsScheduled(&low));
+  EXPECT_TRUE(scheduler.IsScheduled(&high));
+
+  // Lower-priority commands are rejected
+  scheduler.Schedule(&low);
+  EXPECT_FALSE(scheduler.IsScheduled(&low));
+  EXPECT_TRUE(scheduler.IsScheduled(&high));
+
+  // Commands with the same priority preempt each other
+  scheduler.Schedule(true, 1, &low);
+  EXPECT_TRUE(scheduler.IsScheduled(&low));
+  EXPECT_FALSE(scheduler.IsScheduled(&high));
+
+  // Uninterruptible commands aren't preempted, whatever the priority
+  scheduler.Schedule(false, 1, &uninterruptible);
+  scheduler.Schedule(true, 2, &high);
+  EXPECT_TRUE(scheduler.IsScheduled(&uninterruptible));
+  EXPECT_FALSE(scheduler.IsScheduled(&high));
+  EXPECT_EQ(&uninterruptible, scheduler.Requiring(&requirement));
+
+  scheduler.Cancel(&uninterruptible);
+  scheduler.Schedule(true, 2, &high);
+  EXPECT_TRUE(scheduler.IsScheduled(&high));
+  scheduler.CancelAll();
+}
+
+TEST_F(CommandRequirementsTest, DeferredPriorityTest) {
+  CommandScheduler scheduler = GetScheduler();
+
+  TestSubsystem requirement;
+
+  MockCommand low({&requirement});
+  MockCommand high({&requirement});
+
+  EXPECT_CALL(low, Initialize()).Times(0);
+  EXPECT_CALL(high, Initialize());
+  EXPECT_CALL(high, End(true));
+
+  RunCommand command([&] {
+    scheduler.Schedule(true, 0, &low);
+    scheduler.Schedule(true, 1, &high);
+  });
+
+  scheduler.Schedule(&command);
+  scheduler.Run();
+  EXPECT_FALSE(scheduler.IsScheduled(&low));
+  EXPECT_TRUE(scheduler.IsScheduled(&high));
+  scheduler.CancelAll();
+}
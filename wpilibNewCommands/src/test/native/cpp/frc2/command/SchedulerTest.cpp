@@ -2,6 +2,8 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <vector>
+
 #include "CommandTestBase.h"
 #include "frc2/command/InstantCommand.h"
 #include "frc2/command/RunCommand.h"
@@ -69,3 +71,80 @@ TEST_F(SchedulerTest, SchedulerCancelAllTest) {
 
   EXPECT_EQ(counter, 2);
 }
+
+TEST_F(SchedulerTest, ScheduledOrderTest) {
+  CommandScheduler scheduler = GetScheduler();
+
+  std::vector<int> order;
+  RunCommand command1([&order] { order.push_back(1); }, {});
+  RunCommand command2([&order] { order.push_back(2); }, {});
+  RunCommand command3([&order] { order.push_back(3); }, {});
+
+  scheduler.Schedule(&command3);
+  scheduler.Schedule(&command1);
+  scheduler.Schedule(&command2);
+  scheduler.Run();
+  EXPECT_EQ((std::vector<int>{3, 1, 2}), order);
+
+  // Canceling keeps the order of the others, rescheduling goes last
+  scheduler.Cancel(&command3);
+  scheduler.Schedule(&command3);
+  order.clear();
+  scheduler.Run();
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), order);
+}
+
+namespace {
+class PeriodicSubsystem : public Subsystem {
+ public:
+  PeriodicSubsystem(std::vector<PeriodicSubsystem*>* order, bool threadSafe,
+                    std::vector<const void*> reads = {},
+                    std::vector<const void*> writes = {})
+      : m_order{order},
+        m_threadSafe{threadSafe},
+        m_reads{std::move(reads)},
+        m_writes{std::move(writes)} {}
+
+  void Periodic() override { m_order->emplace_back(this); }
+
+  bool IsPeriodicThreadSafe() const override { return m_threadSafe; }
+
+  void GetPeriodicDependencies(
+      wpi::SmallVectorImpl<const void*>& reads,
+      wpi::SmallVectorImpl<const void*>& writes) const override {
+    reads.append(m_reads.begin(), m_reads.end());
+    writes.append(m_writes.begin(), m_writes.end());
+  }
+
+ private:
+  std::vector<PeriodicSubsystem*>* m_order;
+  bool m_threadSafe;
+  std::vector<const void*> m_reads;
+  std::vector<const void*> m_writes;
+};
+}  // namespace
+
+TEST_F(SchedulerTest, ParallelPeriodicOrderTest) {
+  CommandScheduler scheduler = GetScheduler();
+
+  int data = 0;
+  std::vector<PeriodicSubsystem*> order;
+  PeriodicSubsystem writer{&order, true, {}, {&data}};
+  PeriodicSubsystem reader{&order, true, {&data}, {}};
+  PeriodicSubsystem unsafe{&order, false};
+  PeriodicSubsystem independent{&order, true};
+  scheduler.RegisterSubsystem({&writer, &reader, &unsafe, &independent});
+
+  // In simulation the batches are run one subsystem at a time
+  scheduler.SetParallelPeriodic(2);
+  scheduler.Run();
+  std::vector<PeriodicSubsystem*> expected{&writer, &independent, &reader,
+                                           &unsafe};
+  EXPECT_EQ(expected, order);
+
+  order.clear();
+  scheduler.UnregisterSubsystem(&writer);
+  scheduler.Run();
+  expected = {&reader, &independent, &unsafe};
+  EXPECT_EQ(expected, order);
+}
@@ -0,0 +1,143 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "CommandTestBase.h"
+#include "frc2/command/CommandHelper.h"
+#include "frc2/command/InstantCommand.h"
+#include "frc2/command/ParallelCommandGroup.h"
+#include "frc2/command/ParallelDeadlineGroup.h"
+#include "frc2/command/ParallelRaceGroup.h"
+#include "frc2/command/SequentialCommandGroup.h"
+#include "frc2/command/StaticCommandGroups.h"
+#include "frc2/command/WaitUntilCommand.h"
+
+using namespace frc2;
+class StaticCommandGroupsTest : public CommandTestBase {};
+
+namespace {
+// Finishes a fixed number of executions after it is initialized, and logs
+// every call
+class LoggingCommand : public CommandHelper<CommandBase, LoggingCommand> {
+ public:
+  LoggingCommand(std::vector<std::string>* log, int id, int duration)
+      : m_log{log}, m_id{id}, m_duration{duration} {}
+
+  void Initialize() override {
+    m_executions = 0;
+    m_log->emplace_back(fmt::format("{} Initialize", m_id));
+  }
+
+  void Execute() override {
+    ++m_executions;
+    m_log->emplace_back(fmt::format("{} Execute", m_id));
+  }
+
+  void End(bool interrupted) override {
+    m_log->emplace_back(fmt::format("{} End({})", m_id, interrupted));
+  }
+
+  bool IsFinished() override {
+    m_log->emplace_back(fmt::format("{} IsFinished", m_id));
+    return m_executions >= m_duration;
+  }
+
+ private:
+  std::vector<std::string>* m_log;
+  int m_id;
+  int m_duration;
+  int m_executions = 0;
+};
+
+void RunCommand(Command& command, int interruptAt) {
+  for (int run = 0; run < 2; ++run) {
+    command.Initialize();
+    for (int i = 0;; ++i) {
+      if (i == interruptAt) {
+        command.End(true);
+        break;
+      }
+      command.Execute();
+      if (command.IsFinished()) {
+        command.End(false);
+        break;
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST_F(StaticCommandGroupsTest, MatchesDynamicGroupsTest) {
+  for (int interruptAt = 0; interruptAt < 12; ++interruptAt) {
+    std::vector<std::string> staticLog;
+    std::vector<std::string> dynamicLog;
+    auto command = [](std::vector<std::string>* log, int id, int duration) {
+      return LoggingCommand{log, id, duration};
+    };
+
+    auto staticGroup = MakeSequence(
+        command(&staticLog, 0, 1),
+        MakeParallel(command(&staticLog, 1, 2), command(&staticLog, 2, 0)),
+        MakeRace(command(&staticLog, 3, 3), command(&staticLog, 4, 1)),
+        MakeDeadline(command(&staticLog, 5, 2), command(&staticLog, 6, 5),
+                     MakeSequence(command(&staticLog, 7, 1),
+                                  command(&staticLog, 8, 1))));
+    SequentialCommandGroup dynamicGroup{
+        command(&dynamicLog, 0, 1),
+        ParallelCommandGroup{command(&dynamicLog, 1, 2),
+                             command(&dynamicLog, 2, 0)},
+        ParallelRaceGroup{command(&dynamicLog, 3, 3),
+                          command(&dynamicLog, 4, 1)},
+        ParallelDeadlineGroup{
+            command(&dynamicLog, 5, 2), command(&dynamicLog, 6, 5),
+            SequentialCommandGroup{command(&dynamicLog, 7, 1),
+                                   command(&dynamicLog, 8, 1)}}};
+
+    RunCommand(staticGroup, interruptAt);
+    RunCommand(dynamicGroup, interruptAt);
+    ASSERT_EQ(dynamicLog, staticLog) << "interrupted at " << interruptAt;
+  }
+}
+
+TEST_F(StaticCommandGroupsTest, RequirementsTest) {
+  TestSubsystem requirement1;
+  TestSubsystem requirement2;
+
+  auto group = MakeSequence(InstantCommand([] {}, {&requirement1}),
+                            InstantCommand([] {}, {&requirement1}),
+                            InstantCommand([] {}, {&requirement2}));
+  EXPECT_TRUE(group.HasRequirement(&requirement1));
+  EXPECT_TRUE(group.HasRequirement(&requirement2));
+
+  EXPECT_THROW(MakeParallel(InstantCommand([] {}, {&requirement1}),
+                            InstantCommand([] {}, {&requirement1})),
+               frc::RuntimeError);
+}
+
+TEST_F(StaticCommandGroupsTest, ScheduleTest) {
+  CommandScheduler scheduler = GetScheduler();
+
+  bool finished = false;
+  int counter = 0;
+  auto group = MakeSequence(
+      InstantCommand([&counter] { counter++; }, {}),
+      MakeWithTimeout(WaitUntilCommand([&finished] { return finished; }),
+                      10_s));
+
+  scheduler.Schedule(&group);
+  scheduler.Run();
+  EXPECT_EQ(1, counter);
+  EXPECT_TRUE(scheduler.IsScheduled(&group));
+
+  scheduler.Run();
+  EXPECT_TRUE(scheduler.IsScheduled(&group));
+
+  finished = true;
+  scheduler.Run();
+  EXPECT_FALSE(scheduler.IsScheduled(&group));
+}
@@ -5,7 +5,7 @@
 #include "frc/commands/Scheduler.h"
 
 #include <algorithm>
-#include <set>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -24,24 +24,35 @@
 using namespace frc;
 
 struct Scheduler::Impl {
+  void TakeAdditions();
   void Remove(Command* command);
   void ProcessCommandAddition(Command* command);
-
-  using SubsystemSet = std::set<Subsystem*>;
-  SubsystemSet subsystems;
-  wpi::mutex buttonsMutex;
-  using ButtonVector = std::vector<std::unique_ptr<ButtonScheduler>>;
-  ButtonVector buttons;
-  using CommandVector = std::vector<Command*>;
-  wpi::mutex additionsMutex;
-  CommandVector additions;
-  using CommandSet = std::set<Command*>;
-  CommandSet commands;
+  void CompactCommands();
+
+  std::vector<Subsystem*> subsystems;
+  std::vector<std::unique_ptr<ButtonScheduler>> buttons;
+  // Removed commands are left as null until the next compaction, so commands
+  // may be removed while the list is being run
+  std::vector<Command*> commands;
+  bool commandsRemoved = false;
+  std::vector<Command*> additions;
   bool adding = false;
   bool enabled = true;
+
+  // Commands and buttons added from any thread. Run() only takes the lock
+  // when something has been queued.
+  wpi::mutex pendingMutex;
+  std::atomic<bool> hasPendingAdditions{false};
+  std::atomic<bool> hasPendingButtons{false};
+  std::vector<Command*> pendingAdditions;
+  std::vector<std::unique_ptr<ButtonScheduler>> pendingButtons;
+
+  // Bumped whenever the running commands change; the dashboard lists are only
+  // rebuilt when it differs from the version last published
+  uint64_t commandsVersion = 0;
+  uint64_t publishedVersion = 0;
   std::vector<std::string> commandsBuf;
   std::vector<double> idsBuf;
-  bool runningCommandsChanged = false;
 };
 
 Scheduler* Scheduler::GetInstance() {
@@ -50,24 +61,30 @@ Scheduler* Scheduler::GetInstance() {
 }
 
 void Scheduler::AddCommand(Command* command) {
-  std::scoped_lock lock(m_impl->additionsMutex);
-  if (std::find(m_impl->additions.begin(), m_impl->additions.end(), command) !=
-      m_impl->additions.end()) {
+  std::scoped_lock lock(m_impl->pendingMutex);
+  auto& pending = m_impl->pendingAdditions;
+  if (std::find(pending.begin(), pending.end(), command) != pending.end()) {
     return;
   }
-  m_impl->additions.push_back(command);
+  pending.push_back(command);
+  m_impl->hasPendingAdditions = true;
 }
 
 void Scheduler::AddButton(ButtonScheduler* button) {
-  std::scoped_lock lock(m_impl->buttonsMutex);
-  m_impl->buttons.emplace_back(button);
+  std::scoped_lock lock(m_impl->pendingMutex);
+  m_impl->pendingButtons.emplace_back(button);
+  m_impl->hasPendingButtons = true;
 }
 
 void Scheduler::RegisterSubsystem(Subsystem* subsystem) {
   if (!subsystem) {
     throw FRC_MakeError(err::NullParameter, "{}", "subsystem");
   }
-  m_impl->subsystems.insert(subsystem);
+  auto& subsystems = m_impl->subsystems;
+  if (std::find(subsystems.begin(), subsystems.end(), subsystem) ==
+      subsystems.end()) {
+    subsystems.push_back(subsystem);
+  }
 }
 
 void Scheduler::Run() {
@@ -77,48 +94,50 @@ void Scheduler::Run() {
       return;
     }
 
-    std::scoped_lock lock(m_impl->buttonsMutex);
+    if (m_impl->hasPendingButtons) {
+      std::scoped_lock lock(m_impl->pendingMutex);
+      for (auto& button : m_impl->pendingButtons) {
+        m_impl->buttons.emplace_back(std::move(button));
+      }
+      m_impl->pendingButtons.clear();
+      m_impl->hasPendingButtons = false;
+    }
+
     for (auto& button : m_impl->buttons) {
       button->Execute();
     }
   }
 
   // Call every subsystem's periodic method
-  for (auto& subsystem : m_impl->subsystems) {
-    subsystem->Periodic();
+  for (size_t i = 0; i < m_impl->subsystems.size(); ++i) {
+    m_impl->subsystems[i]->Periodic();
   }
 
-  m_impl->runningCommandsChanged = false;
-
   // Loop through the commands
-  for (auto cmdIter = m_impl->commands.begin();
-       cmdIter != m_impl->commands.end();) {
-    Command* command = *cmdIter;
-    // Increment before potentially removing to keep the iterator valid
-    ++cmdIter;
-    if (!command->Run()) {
-      Remove(command);
-      m_impl->runningCommandsChanged = true;
+  for (size_t i = 0; i < m_impl->commands.size(); ++i) {
+    Command* command = m_impl->commands[i];
+    if (command && !command->Run()) {
+      m_impl->Remove(command);
     }
   }
+  m_impl->CompactCommands();
 
   // Add the new things
-  {
-    std::scoped_lock lock(m_impl->additionsMutex);
-    for (auto& addition : m_impl->additions) {
-      // Check to make sure no adding during adding
-      if (m_impl->adding) {
-        FRC_ReportError(warn::IncompatibleState, "{}",
-                        "Can not start command from cancel method");
-      } else {
-        m_impl->ProcessCommandAddition(addition);
-      }
+  m_impl->TakeAdditions();
+  for (auto& addition : m_impl->additions) {
+    // Check to make sure no adding during adding
+    if (m_impl->adding) {
+      FRC_ReportError(warn::IncompatibleState, "{}",
+                      "Can not start command from cancel method");
+    } else {
+      m_impl->ProcessCommandAddition(addition);
     }
-    m_impl->additions.clear();
   }
+  m_impl->additions.clear();
 
   // Add in the defaults
-  for (auto& subsystem : m_impl->subsystems) {
+  for (size_t i = 0; i < m_impl->subsystems.size(); ++i) {
+    Subsystem* subsystem = m_impl->subsystems[i];
     if (subsystem->GetCurrentCommand() == nullptr) {
       if (m_impl->adding) {
         FRC_ReportError(warn::IncompatibleState, "{}",
@@ -140,9 +159,12 @@ void Scheduler::Remove(Command* command) {
 }
 
 void Scheduler::RemoveAll() {
-  while (m_impl->commands.size() > 0) {
-    Remove(*m_impl->commands.begin());
+  for (size_t i = 0; i < m_impl->commands.size(); ++i) {
+    if (Command* command = m_impl->commands[i]) {
+      Remove(command);
+    }
   }
+  m_impl->CompactCommands();
 }
 
 void Scheduler::ResetAll() {
@@ -151,6 +173,11 @@ void Scheduler::ResetAll() {
   m_impl->buttons.clear();
   m_impl->additions.clear();
   m_impl->commands.clear();
+  std::scoped_lock lock(m_impl->pendingMutex);
+  m_impl->pendingAdditions.clear();
+  m_impl->pendingButtons.clear();
+  m_impl->hasPendingAdditions = false;
+  m_impl->hasPendingButtons = false;
 }
 
 void Scheduler::SetEnabled(bool enabled) {
@@ -162,6 +189,8 @@ void Scheduler::InitSendable(nt::NTSendableBuilder& builder) {
   auto namesEntry = builder.GetEntry("Names");
   auto idsEntry = builder.GetEntry("Ids");
   auto cancelEntry = builder.GetEntry("Cancel");
+  // Publish the running commands on the first update
+  m_impl->publishedVersion = m_impl->commandsVersion - 1;
   builder.SetUpdateTable([=] {
     // Get the list of possible commands to cancel
     auto new_toCancel = cancelEntry.GetValue();
@@ -173,6 +202,9 @@ void Scheduler::InitSendable(nt::NTSendableBuilder& builder) {
     // Cancel commands whose cancel buttons were pressed on the SmartDashboard
     if (!toCancel.empty()) {
       for (auto& command : m_impl->commands) {
+        if (!command) {
+          continue;
+        }
         for (const auto& canceled : toCancel) {
           if (command->GetID() == canceled) {
             command->Cancel();
@@ -183,10 +215,14 @@ void Scheduler::InitSendable(nt::NTSendableBuilder& builder) {
     }
 
     // Set the running commands
-    if (m_impl->runningCommandsChanged) {
+    if (m_impl->publishedVersion != m_impl->commandsVersion) {
+      m_impl->publishedVersion = m_impl->commandsVersion;
       m_impl->commandsBuf.resize(0);
       m_impl->idsBuf.resize(0);
       for (const auto& command : m_impl->commands) {
+        if (!command) {
+          continue;
+        }
         m_impl->commandsBuf.emplace_back(
             wpi::SendableRegistry::GetName(command));
         m_impl->idsBuf.emplace_back(command->GetID());
@@ -214,10 +250,23 @@ Scheduler::~Scheduler() {
   frc::LiveWindow::SetDisabledCallback(nullptr);
 }
 
+void Scheduler::Impl::TakeAdditions() {
+  if (!hasPendingAdditions) {
+    return;
+  }
+  std::scoped_lock lock(pendingMutex);
+  additions.swap(pendingAdditions);
+  hasPendingAdditions = false;
+}
+
 void Scheduler::Impl::Remove(Command* command) {
-  if (!commands.erase(command)) {
+  if (!command->m_scheduled) {
     return;
   }
+  command->m_scheduled = false;
+  *std::find(commands.begin(), commands.end(), command) = nullptr;
+  commandsRemoved = true;
+  ++commandsVersion;
 
   for (auto&& requirement : command->GetRequirements()) {
     requirement->SetCurrentCommand(nullptr);
@@ -232,8 +281,7 @@ void Scheduler::Impl::ProcessCommandAddition(Command* command) {
   }
 
   // Only add if not already in
-  auto found = commands.find(command);
-  if (found == commands.end()) {
+  if (!command->m_scheduled) {
     // Check that the requirements can be had
     const auto& requirements = command->GetRequirements();
     for (const auto requirement : requirements) {
@@ -254,9 +302,18 @@ void Scheduler::Impl::ProcessCommandAddition(Command* command) {
     }
     adding = false;
 
-    commands.insert(command);
+    commands.push_back(command);
+    command->m_scheduled = true;
 
     command->StartRunning();
-    runningCommandsChanged = true;
+    ++commandsVersion;
+  }
+}
+
+void Scheduler::Impl::CompactCommands() {
+  if (commandsRemoved) {
+    commands.erase(std::remove(commands.begin(), commands.end(), nullptr),
+                   commands.end());
+    commandsRemoved = false;
   }
 }
@@ -460,6 +460,9 @@ class Command : public wpi::Sendable, public wpi::SendableHelper<Command> {
   // Whether or not it is running
   bool m_running = false;
 
+  // Whether or not it is in the Scheduler's list of commands
+  bool m_scheduled = false;
+
   // Whether or not it is interruptible
   bool m_interruptible = true;
 
@@ -4,6 +4,8 @@
 
 #include "frc/AddressableLED.h"
 
+#include <algorithm>
+
 #include <hal/AddressableLED.h>
 #include <hal/FRCUsageReporting.h>
 #include <hal/HALBase.h>
@@ -46,23 +48,46 @@ void AddressableLED::SetLength(int length) {
   int32_t status = 0;
   HAL_SetAddressableLEDLength(m_handle, length, &status);
   FRC_CheckErrorStatus(status, "Port {} length {}", m_port, length);
+  m_written.clear();
 }
 
 static_assert(sizeof(AddressableLED::LEDData) == sizeof(HAL_AddressableLEDData),
               "LED Structs MUST be the same size");
 
+static bool SameColor(const AddressableLED::LEDData& a,
+                      const AddressableLED::LEDData& b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
 void AddressableLED::SetData(wpi::span<const LEDData> ledData) {
   int32_t status = 0;
-  HAL_WriteAddressableLEDData(m_handle, ledData.begin(), ledData.size(),
-                              &status);
+  if (ledData.size() != m_written.size()) {
+    m_written.clear();
+    HAL_WriteAddressableLEDData(m_handle, ledData.begin(), ledData.size(),
+                                &status);
+    FRC_CheckErrorStatus(status, "Port {}", m_port);
+    m_written.assign(ledData.begin(), ledData.end());
+    return;
+  }
+
+  // Only copy the range that changed; an empty range still starts the next
+  // data cycle
+  auto first = std::mismatch(ledData.begin(), ledData.end(), m_written.begin(),
+                             SameColor)
+                   .first;
+  auto last = std::mismatch(ledData.rbegin(),
+                            std::make_reverse_iterator(first),
+                            m_written.rbegin(), SameColor)
+                  .first.base();
+  size_t start = first - ledData.begin();
+  HAL_WriteAddressableLEDDataRange(m_handle, ledData.data() + start, start,
+                                   last - first, &status);
   FRC_CheckErrorStatus(status, "Port {}", m_port);
+  std::copy(first, last, m_written.begin() + start);
 }
 
 void AddressableLED::SetData(std::initializer_list<LEDData> ledData) {
-  int32_t status = 0;
-  HAL_WriteAddressableLEDData(m_handle, ledData.begin(), ledData.size(),
-                              &status);
-  FRC_CheckErrorStatus(status, "Port {}", m_port);
+  SetData(wpi::span<const LEDData>{ledData.begin(), ledData.size()});
 }
 
 void AddressableLED::SetBitTiming(units::nanosecond_t lowTime0,
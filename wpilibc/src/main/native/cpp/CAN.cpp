@@ -4,12 +4,14 @@
 
 #include "frc/CAN.h"
 
+#include <cstring>
 #include <utility>
 
 #include <hal/CAN.h>
 #include <hal/CANAPI.h>
 #include <hal/Errors.h>
 #include <hal/FRCUsageReporting.h>
+#include <wpi/SmallVector.h>
 
 #include "frc/Errors.h"
 
@@ -80,6 +82,28 @@ int CAN::WriteRTRFrameNoError(int length, int apiId) {
   return status;
 }
 
+void CAN::WritePackets(wpi::span<const CANPacket> packets) {
+  int32_t status = WritePacketsNoError(packets);
+  FRC_CheckErrorStatus(status, "{}", "WritePackets");
+}
+
+int CAN::WritePacketsNoError(wpi::span<const CANPacket> packets) {
+  wpi::SmallVector<HAL_CANPacket, 16> halPackets;
+  halPackets.reserve(packets.size());
+  for (const auto& packet : packets) {
+    HAL_CANPacket halPacket;
+    halPacket.handle = packet.device->m_handle;
+    halPacket.apiId = packet.apiId;
+    std::memcpy(halPacket.data, packet.data, sizeof(halPacket.data));
+    halPacket.length = packet.length;
+    halPackets.push_back(halPacket);
+  }
+
+  int32_t status = 0;
+  HAL_WriteCANPacketBatch(halPackets.data(), halPackets.size(), &status);
+  return status;
+}
+
 void CAN::StopPacketRepeating(int apiId) {
   int32_t status = 0;
   HAL_StopCANPacketRepeating(m_handle, apiId, &status);
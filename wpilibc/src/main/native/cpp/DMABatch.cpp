@@ -0,0 +1,164 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/DMABatch.h"
+
+#include <algorithm>
+
+#include <hal/AnalogInput.h>
+
+#include "frc/AnalogInput.h"
+#include "frc/Counter.h"
+#include "frc/DMA.h"
+#include "frc/Encoder.h"
+#include "frc/Errors.h"
+
+using namespace frc;
+
+DMABatch::DMABatch(const DMA& dma) : m_dma{dma.dmaHandle} {}
+
+void DMABatch::SetTimestamps(wpi::span<uint64_t> timestamps) {
+  m_timestamps = timestamps;
+  UpdateCapacity(timestamps.size());
+}
+
+void DMABatch::AddEncoder(const Encoder* encoder, wpi::span<int32_t> counts) {
+  m_encoders.push_back({encoder->m_encoder, counts});
+  UpdateCapacity(counts.size());
+}
+
+void DMABatch::AddEncoderDistance(const Encoder* encoder,
+                                  wpi::span<double> distances) {
+  ScaledChannel channel;
+  channel.handle = encoder->m_encoder;
+  channel.out = distances;
+  channel.scale =
+      encoder->DecodingScaleFactor() * encoder->GetDistancePerPulse();
+  m_encoderDistances.push_back(channel);
+  UpdateCapacity(distances.size());
+}
+
+void DMABatch::AddCounter(const Counter* counter, wpi::span<int32_t> counts) {
+  m_counters.push_back({counter->m_counter, counts});
+  UpdateCapacity(counts.size());
+}
+
+void DMABatch::AddAnalogInputVoltage(const AnalogInput* analogInput,
+                                     wpi::span<double> voltages) {
+  int32_t status = 0;
+  AnalogChannel channel;
+  channel.handle = analogInput->m_port;
+  channel.out = voltages;
+  // the same conversion as HAL_GetAnalogValueToVolts()
+  channel.lsbWeight =
+      HAL_GetAnalogLSBWeight(analogInput->m_port, &status) * 1.0e-9;
+  channel.offset = HAL_GetAnalogOffset(analogInput->m_port, &status) * 1.0e-9;
+  FRC_CheckErrorStatus(status, "Channel {}", analogInput->GetChannel());
+  m_analogInputs.push_back(channel);
+  UpdateCapacity(voltages.size());
+}
+
+void DMABatch::Clear() {
+  m_timestamps = {};
+  m_encoders.clear();
+  m_encoderDistances.clear();
+  m_counters.clear();
+  m_analogInputs.clear();
+  m_capacity = 0;
+  m_hasChannel = false;
+}
+
+void DMABatch::UpdateCapacity(size_t size) {
+  m_capacity = m_hasChannel ? std::min(m_capacity, size) : size;
+  m_hasChannel = true;
+}
+
+size_t DMABatch::Read(units::second_t timeout, int32_t* remaining,
+                      int32_t* status) {
+  *remaining = 0;
+  if (m_samples.size() < m_capacity) {
+    m_samples.resize(m_capacity);
+  }
+
+  // only the first read waits; the rest drain what is already queued
+  size_t count = 0;
+  double wait = timeout.value();
+  while (count < m_capacity) {
+    int32_t readStatus = 0;
+    auto result =
+        HAL_ReadDMA(m_dma, &m_samples[count], wait, remaining, &readStatus);
+    if (result != HAL_DMA_OK) {
+      if (result == HAL_DMA_ERROR && *status == 0) {
+        *status = readStatus;
+      }
+      break;
+    }
+    ++count;
+    if (*remaining == 0) {
+      break;
+    }
+    wait = 0;
+  }
+
+  if (!m_timestamps.empty()) {
+    for (size_t i = 0; i < count; ++i) {
+      m_timestamps[i] = m_samples[i].timeStamp;
+    }
+  }
+
+  for (auto&& channel : m_encoders) {
+    int32_t channelStatus = 0;
+    for (size_t i = 0; i < count; ++i) {
+      channel.out[i] = HAL_GetDMASampleEncoderRaw(
+          &m_samples[i], channel.handle, &channelStatus);
+    }
+    if (channelStatus != 0 && *status == 0) {
+      *status = channelStatus;
+    }
+  }
+
+  for (auto&& channel : m_encoderDistances) {
+    int32_t channelStatus = 0;
+    for (size_t i = 0; i < count; ++i) {
+      channel.out[i] = HAL_GetDMASampleEncoderRaw(
+          &m_samples[i], channel.handle, &channelStatus);
+    }
+    if (channelStatus != 0 && *status == 0) {
+      *status = channelStatus;
+    }
+    double scale = channel.scale;
+    for (size_t i = 0; i < count; ++i) {
+      channel.out[i] *= scale;
+    }
+  }
+
+  for (auto&& channel : m_counters) {
+    int32_t channelStatus = 0;
+    for (size_t i = 0; i < count; ++i) {
+      channel.out[i] = HAL_GetDMASampleCounter(&m_samples[i], channel.handle,
+                                               &channelStatus);
+    }
+    if (channelStatus != 0 && *status == 0) {
+      *status = channelStatus;
+    }
+  }
+
+  for (auto&& channel : m_analogInputs) {
+    int32_t channelStatus = 0;
+    for (size_t i = 0; i < count; ++i) {
+      channel.out[i] = HAL_GetDMASampleAnalogInputRaw(
+          &m_samples[i], channel.handle, &channelStatus);
+    }
+    if (channelStatus != 0 && *status == 0) {
+      *status = channelStatus;
+    }
+    double lsbWeight = channel.lsbWeight;
+    double offset = channel.offset;
+    for (size_t i = 0; i < count; ++i) {
+      channel.out[i] = lsbWeight * channel.out[i] - offset;
+    }
+  }
+
+  return count;
+}
@@ -0,0 +1,148 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/DataLogManager.h"
+
+#include <ctime>
+#include <memory>
+#include <system_error>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <networktables/NetworkTableInstance.h>
+#include <wpi/DataLog.h>
+#include <wpi/fs.h>
+#include <wpi/mutex.h>
+
+#include "frc/Errors.h"
+#include "frc/Filesystem.h"
+#include "frc/RobotBase.h"
+
+using namespace frc;
+
+namespace {
+struct Instance {
+  ~Instance() {
+    // the NetworkTables sink refers to the log
+    if (log && ntLogging) {
+      nt::NetworkTableInstance::GetDefault().StopDataLog();
+    }
+  }
+
+  wpi::mutex mutex;
+  std::unique_ptr<wpi::log::DataLog> log;
+  wpi::log::StringLogEntry messages;
+  std::string logDir;
+  bool ntLogging = true;
+};
+}  // namespace
+
+static Instance& GetInstance() {
+  static Instance instance;
+  return instance;
+}
+
+static std::string MakeLogDir(std::string_view dir) {
+  if (!dir.empty()) {
+    return std::string{dir};
+  }
+  if constexpr (RobotBase::IsReal()) {
+    // prefer a USB stick, to keep the roboRIO's flash from filling up
+    std::error_code ec;
+    if (fs::is_directory("/u", ec)) {
+      return "/u/logs";
+    }
+  }
+  return filesystem::GetOperatingDirectory() + "/logs";
+}
+
+static std::string MakeLogFilename(std::string_view filename) {
+  if (!filename.empty()) {
+    return std::string{filename};
+  }
+  return fmt::format("FRC_{:%Y%m%d_%H%M%S}.wpilog",
+                     fmt::localtime(std::time(nullptr)));
+}
+
+static void StartImpl(Instance& inst, std::string_view dir,
+                      std::string_view filename, double period) {
+  if (inst.log) {
+    return;
+  }
+  inst.logDir = MakeLogDir(dir);
+  std::error_code ec;
+  fs::create_directories(inst.logDir, ec);
+  auto path = fs::path{inst.logDir} / MakeLogFilename(filename);
+  inst.log = std::make_unique<wpi::log::DataLog>(path.string(), ec, period);
+  if (ec) {
+    FRC_ReportError(warn::Warning, "could not open data log file '{}': {}",
+                    path.string(), ec.message());
+  }
+  inst.messages = wpi::log::StringLogEntry{*inst.log, "messages"};
+  if (inst.ntLogging) {
+    nt::NetworkTableInstance::GetDefault().StartDataLog(*inst.log);
+  }
+}
+
+void DataLogManager::Start(std::string_view dir, std::string_view filename,
+                           double period) {
+  auto& inst = GetInstance();
+  std::scoped_lock lock{inst.mutex};
+  StartImpl(inst, dir, filename, period);
+}
+
+void DataLogManager::Stop() {
+  auto& inst = GetInstance();
+  std::scoped_lock lock{inst.mutex};
+  if (!inst.log) {
+    return;
+  }
+  if (inst.ntLogging) {
+    nt::NetworkTableInstance::GetDefault().StopDataLog();
+  }
+  inst.messages = wpi::log::StringLogEntry{};
+  inst.log.reset();
+  inst.logDir.clear();
+}
+
+void DataLogManager::Log(std::string_view message) {
+  auto& inst = GetInstance();
+  {
+    std::scoped_lock lock{inst.mutex};
+    if (inst.log) {
+      inst.messages.Append(message);
+    }
+  }
+  fmt::print("{}\n", message);
+}
+
+wpi::log::DataLog& DataLogManager::GetLog() {
+  auto& inst = GetInstance();
+  std::scoped_lock lock{inst.mutex};
+  StartImpl(inst, "", "", 0.25);
+  return *inst.log;
+}
+
+std::string DataLogManager::GetLogDir() {
+  auto& inst = GetInstance();
+  std::scoped_lock lock{inst.mutex};
+  return inst.logDir;
+}
+
+void DataLogManager::LogNetworkTables(bool enabled) {
+  auto& inst = GetInstance();
+  std::scoped_lock lock{inst.mutex};
+  if (inst.ntLogging == enabled) {
+    return;
+  }
+  inst.ntLogging = enabled;
+  if (!inst.log) {
+    return;
+  }
+  if (enabled) {
+    nt::NetworkTableInstance::GetDefault().StartDataLog(*inst.log);
+  } else {
+    nt::NetworkTableInstance::GetDefault().StopDataLog();
+  }
+}
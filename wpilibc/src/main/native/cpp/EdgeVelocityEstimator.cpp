@@ -0,0 +1,115 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/EdgeVelocityEstimator.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <hal/HALBase.h>
+
+#include "frc/Errors.h"
+
+using namespace frc;
+
+EdgeVelocityEstimator::EdgeVelocityEstimator(size_t windowSize,
+                                             units::second_t maxAge)
+    : m_edges{std::max<size_t>(windowSize, 2)},
+      m_maxAge{static_cast<uint64_t>(maxAge.value() * 1.0e6)} {}
+
+void EdgeVelocityEstimator::AddEdge(uint64_t timestamp, double position) {
+  std::scoped_lock lock(m_mutex);
+  AddEdgeLocked(timestamp, position);
+}
+
+void EdgeVelocityEstimator::AddEdges(wpi::span<const uint64_t> timestamps,
+                                     wpi::span<const double> positions) {
+  size_t count = std::min(timestamps.size(), positions.size());
+  std::scoped_lock lock(m_mutex);
+  for (size_t i = 0; i < count; ++i) {
+    AddEdgeLocked(timestamps[i], positions[i]);
+  }
+}
+
+void EdgeVelocityEstimator::AddEdges(wpi::span<const uint64_t> timestamps,
+                                     wpi::span<const int32_t> counts) {
+  size_t count = std::min(timestamps.size(), counts.size());
+  std::scoped_lock lock(m_mutex);
+  for (size_t i = 0; i < count; ++i) {
+    AddEdgeLocked(timestamps[i], counts[i]);
+  }
+}
+
+void EdgeVelocityEstimator::AddEdgeLocked(uint64_t timestamp,
+                                          double position) {
+  if (m_edges.size() != 0) {
+    auto& newest = m_edges.back();
+    if (timestamp < newest.timestamp) {
+      return;  // out of order
+    }
+    if (position == newest.position) {
+      return;  // not an edge
+    }
+  }
+  m_edges.push_back({timestamp, position});
+}
+
+double EdgeVelocityEstimator::GetVelocity() const {
+  int32_t status = 0;
+  uint64_t now = HAL_GetFPGATime(&status);
+  FRC_CheckErrorStatus(status, "{}", "GetVelocity");
+  return GetVelocity(now);
+}
+
+double EdgeVelocityEstimator::GetVelocity(uint64_t now) const {
+  std::scoped_lock lock(m_mutex);
+  size_t size = m_edges.size();
+  if (size < 2) {
+    return 0.0;
+  }
+  const auto& newest = m_edges[size - 1];
+  if (now > newest.timestamp && now - newest.timestamp > m_maxAge) {
+    return 0.0;
+  }
+
+  // Fit relative to the newest edge so the sums keep their precision
+  size_t begin = 0;
+  while (newest.timestamp - m_edges[begin].timestamp > m_maxAge) {
+    ++begin;
+  }
+  size_t n = size - begin;
+  if (n < 2) {
+    return 0.0;
+  }
+  // seconds before the newest edge
+  auto age = [&](size_t i) {
+    return (newest.timestamp - m_edges[i].timestamp) * 1.0e-6;
+  };
+  double meanAge = 0.0;
+  double meanP = 0.0;
+  for (size_t i = begin; i < size; ++i) {
+    meanAge += age(i);
+    meanP += m_edges[i].position - newest.position;
+  }
+  meanAge /= n;
+  meanP /= n;
+  double sumTT = 0.0;
+  double sumTP = 0.0;
+  for (size_t i = begin; i < size; ++i) {
+    // time runs opposite to age
+    double t = meanAge - age(i);
+    double p = m_edges[i].position - newest.position - meanP;
+    sumTT += t * t;
+    sumTP += t * p;
+  }
+  if (sumTT == 0.0) {
+    return 0.0;
+  }
+  return sumTP / sumTT;
+}
+
+void EdgeVelocityEstimator::Reset() {
+  std::scoped_lock lock(m_mutex);
+  m_edges.reset();
+}
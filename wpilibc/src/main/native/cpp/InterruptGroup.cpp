@@ -0,0 +1,83 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/InterruptGroup.h"
+
+#include <algorithm>
+
+#include "frc/DigitalSource.h"
+#include "frc/Errors.h"
+
+using namespace frc;
+
+InterruptGroup::InterruptGroup(wpi::span<DigitalSource* const> sources,
+                               bool risingEdge, bool fallingEdge,
+                               int queueDepth) {
+  int32_t status = 0;
+  std::vector<HAL_InterruptHandle> handles;
+  for (auto source : sources) {
+    if (source == nullptr) {
+      throw FRC_MakeError(err::NullParameter, "{}", "Source is null");
+    }
+    m_interrupts.emplace_back(HAL_InitializeInterrupts(&status));
+    FRC_CheckErrorStatus(status, "{}", "Interrupt failed to initialize");
+    HAL_RequestInterrupts(m_interrupts.back(),
+                          source->GetPortHandleForRouting(),
+                          static_cast<HAL_AnalogTriggerType>(
+                              source->GetAnalogTriggerTypeForRouting()),
+                          &status);
+    FRC_CheckErrorStatus(status, "{}", "Interrupt request failed");
+    HAL_SetInterruptUpSourceEdge(m_interrupts.back(), risingEdge, fallingEdge,
+                                 &status);
+    FRC_CheckErrorStatus(status, "{}",
+                         "Interrupt setting up source edge failed");
+    handles.emplace_back(m_interrupts.back());
+  }
+
+  m_handle = HAL_InitializeInterruptGroup(handles.data(), handles.size(),
+                                          queueDepth, &status);
+  FRC_CheckErrorStatus(status, "{}", "Interrupt group failed to initialize");
+}
+
+InterruptGroup::~InterruptGroup() {
+  HAL_CleanInterruptGroup(m_handle);
+  for (auto& interrupt : m_interrupts) {
+    HAL_CleanInterrupts(interrupt);
+  }
+}
+
+int InterruptGroup::ReadEvents(wpi::span<Event> events,
+                               units::second_t timeout) {
+  if (m_buffer.size() < events.size()) {
+    m_buffer.resize(events.size());
+  }
+  int32_t status = 0;
+  int32_t count =
+      HAL_ReadInterruptGroupEvents(m_handle, m_buffer.data(), events.size(),
+                                   timeout.to<double>(), &status);
+  FRC_CheckErrorStatus(status, "{}", "Interrupt group read failed");
+
+  for (int32_t i = 0; i < count; ++i) {
+    auto& event = m_buffer[i];
+    auto it = std::find(m_interrupts.begin(), m_interrupts.end(),
+                        event.interrupt);
+    units::microsecond_t timestamp{static_cast<double>(event.timestamp)};
+    events[i] = {static_cast<int>(it - m_interrupts.begin()),
+                 static_cast<bool>(event.rising), timestamp};
+  }
+  return count;
+}
+
+void InterruptGroup::WakeupWaitingRead() {
+  int32_t status = 0;
+  HAL_ReleaseWaitingInterruptGroup(m_handle, &status);
+  FRC_CheckErrorStatus(status, "{}", "Interrupt group wakeup failed");
+}
+
+int64_t InterruptGroup::GetDroppedCount() const {
+  int32_t status = 0;
+  int64_t count = HAL_GetInterruptGroupDroppedCount(m_handle, &status);
+  FRC_CheckErrorStatus(status, "{}", "Interrupt group dropped count failed");
+  return count;
+}
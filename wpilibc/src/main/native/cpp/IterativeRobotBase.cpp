@@ -7,8 +7,10 @@
 #include <fmt/format.h>
 #include <hal/DriverStation.h>
 #include <networktables/NetworkTableInstance.h>
+#include <wpi/trace.h>
 
 #include "frc/Errors.h"
+#include "frc/LoopProfiler.h"
 #include "frc/livewindow/LiveWindow.h"
 #include "frc/shuffleboard/Shuffleboard.h"
 #include "frc/smartdashboard/SmartDashboard.h"
@@ -104,6 +106,8 @@ units::second_t IterativeRobotBase::GetPeriod() const {
 
 void IterativeRobotBase::LoopFunc() {
   m_watchdog.Reset();
+  LoopProfiler::Scope loopScope{"LoopFunc()"};
+  WPI_TRACE_SCOPE("wpilibc.robot.loop");
 
   // Call the appropriate function depending upon the current robot mode
   if (IsDisabled()) {
@@ -112,13 +116,19 @@ void IterativeRobotBase::LoopFunc() {
     if (m_lastMode != Mode::kDisabled) {
       LiveWindow::SetEnabled(false);
       Shuffleboard::DisableActuatorWidgets();
-      DisabledInit();
+      {
+        LoopProfiler::Scope scope{"DisabledInit()"};
+        DisabledInit();
+      }
       m_watchdog.AddEpoch("DisabledInit()");
       m_lastMode = Mode::kDisabled;
     }
 
     HAL_ObserveUserProgramDisabled();
-    DisabledPeriodic();
+    {
+      LoopProfiler::Scope scope{"DisabledPeriodic()"};
+      DisabledPeriodic();
+    }
     m_watchdog.AddEpoch("DisabledPeriodic()");
   } else if (IsAutonomous()) {
     // Call AutonomousInit() if we are now just entering autonomous mode from
@@ -126,13 +136,19 @@ void IterativeRobotBase::LoopFunc() {
     if (m_lastMode != Mode::kAutonomous) {
       LiveWindow::SetEnabled(false);
       Shuffleboard::DisableActuatorWidgets();
-      AutonomousInit();
+      {
+        LoopProfiler::Scope scope{"AutonomousInit()"};
+        AutonomousInit();
+      }
       m_watchdog.AddEpoch("AutonomousInit()");
       m_lastMode = Mode::kAutonomous;
     }
 
     HAL_ObserveUserProgramAutonomous();
-    AutonomousPeriodic();
+    {
+      LoopProfiler::Scope scope{"AutonomousPeriodic()"};
+      AutonomousPeriodic();
+    }
     m_watchdog.AddEpoch("AutonomousPeriodic()");
   } else if (IsOperatorControl()) {
     // Call TeleopInit() if we are now just entering teleop mode from
@@ -140,13 +156,19 @@ void IterativeRobotBase::LoopFunc() {
     if (m_lastMode != Mode::kTeleop) {
       LiveWindow::SetEnabled(false);
       Shuffleboard::DisableActuatorWidgets();
-      TeleopInit();
+      {
+        LoopProfiler::Scope scope{"TeleopInit()"};
+        TeleopInit();
+      }
       m_watchdog.AddEpoch("TeleopInit()");
       m_lastMode = Mode::kTeleop;
     }
 
     HAL_ObserveUserProgramTeleop();
-    TeleopPeriodic();
+    {
+      LoopProfiler::Scope scope{"TeleopPeriodic()"};
+      TeleopPeriodic();
+    }
     m_watchdog.AddEpoch("TeleopPeriodic()");
   } else {
     // Call TestInit() if we are now just entering test mode from
@@ -154,35 +176,58 @@ void IterativeRobotBase::LoopFunc() {
     if (m_lastMode != Mode::kTest) {
       LiveWindow::SetEnabled(true);
       Shuffleboard::EnableActuatorWidgets();
-      TestInit();
+      {
+        LoopProfiler::Scope scope{"TestInit()"};
+        TestInit();
+      }
       m_watchdog.AddEpoch("TestInit()");
       m_lastMode = Mode::kTest;
     }
 
     HAL_ObserveUserProgramTest();
-    TestPeriodic();
+    {
+      LoopProfiler::Scope scope{"TestPeriodic()"};
+      TestPeriodic();
+    }
     m_watchdog.AddEpoch("TestPeriodic()");
   }
 
-  RobotPeriodic();
+  {
+    LoopProfiler::Scope scope{"RobotPeriodic()"};
+    RobotPeriodic();
+  }
   m_watchdog.AddEpoch("RobotPeriodic()");
 
-  SmartDashboard::UpdateValues();
+  {
+    LoopProfiler::Scope scope{"SmartDashboard::UpdateValues()"};
+    SmartDashboard::UpdateValues();
+  }
   m_watchdog.AddEpoch("SmartDashboard::UpdateValues()");
-  LiveWindow::UpdateValues();
+  {
+    LoopProfiler::Scope scope{"LiveWindow::UpdateValues()"};
+    LiveWindow::UpdateValues();
+  }
   m_watchdog.AddEpoch("LiveWindow::UpdateValues()");
-  Shuffleboard::Update();
+  {
+    LoopProfiler::Scope scope{"Shuffleboard::Update()"};
+    Shuffleboard::Update();
+  }
   m_watchdog.AddEpoch("Shuffleboard::Update()");
 
   if constexpr (IsSimulation()) {
-    HAL_SimPeriodicBefore();
-    SimulationPeriodic();
-    HAL_SimPeriodicAfter();
+    {
+      LoopProfiler::Scope scope{"SimulationPeriodic()"};
+      HAL_SimPeriodicBefore();
+      SimulationPeriodic();
+      HAL_SimPeriodicAfter();
+    }
     m_watchdog.AddEpoch("SimulationPeriodic()");
   }
 
   m_watchdog.Disable();
 
+  LoopProfiler::Publish();
+
   // Flush NetworkTables
   if (m_ntFlushEnabled) {
     nt::NetworkTableInstance::GetDefault().Flush();
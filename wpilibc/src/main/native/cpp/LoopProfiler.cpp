@@ -0,0 +1,190 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/LoopProfiler.h"
+
+#include <atomic>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+#include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableEntry.h>
+#include <networktables/NetworkTableInstance.h>
+#include <wpi/StringMap.h>
+#include <wpi/circular_buffer.h>
+#include <wpi/json.h>
+#include <wpi/mutex.h>
+#include <wpi/raw_ostream.h>
+
+#include "frc/Errors.h"
+
+using namespace frc;
+
+namespace {
+struct Phase {
+  std::string name;
+  std::chrono::nanoseconds last{0};
+  std::chrono::nanoseconds max{0};
+  bool updated = false;  // since the last publish
+  nt::NetworkTableEntry lastEntry;
+  nt::NetworkTableEntry maxEntry;
+};
+
+struct Event {
+  int phaseId;
+  hal::fpga_clock::time_point start;
+  std::chrono::nanoseconds duration;
+};
+
+struct Profiler {
+  static constexpr size_t kDefaultCapacity = 8192;
+  static constexpr std::chrono::milliseconds kPublishPeriod{100};
+
+  std::atomic_bool enabled{false};
+
+  wpi::mutex mutex;
+  std::vector<Phase> phases;
+  wpi::StringMap<int> phaseIds;
+  wpi::circular_buffer<Event> events{kDefaultCapacity};
+  hal::fpga_clock::time_point lastPublishTime = hal::fpga_clock::epoch();
+};
+}  // namespace
+
+static Profiler& GetProfiler() {
+  static Profiler profiler;
+  return profiler;
+}
+
+LoopProfiler::Scope::Scope(std::string_view name)
+    : Scope(IsEnabled() ? RegisterPhase(name) : -1) {}
+
+LoopProfiler::Scope::Scope(int phaseId) : m_phaseId(phaseId) {
+  if (m_phaseId >= 0 && IsEnabled()) {
+    m_start = hal::fpga_clock::now();
+  } else {
+    m_phaseId = -1;
+  }
+}
+
+LoopProfiler::Scope::~Scope() {
+  if (m_phaseId >= 0) {
+    RecordPhase(m_phaseId, m_start, hal::fpga_clock::now());
+  }
+}
+
+void LoopProfiler::SetEnabled(bool enabled) {
+  GetProfiler().enabled = enabled;
+}
+
+bool LoopProfiler::IsEnabled() {
+  return GetProfiler().enabled;
+}
+
+void LoopProfiler::SetCapacity(size_t numPhases) {
+  auto& profiler = GetProfiler();
+  std::scoped_lock lock(profiler.mutex);
+  profiler.events = wpi::circular_buffer<Event>{numPhases};
+}
+
+int LoopProfiler::RegisterPhase(std::string_view name) {
+  auto& profiler = GetProfiler();
+  std::scoped_lock lock(profiler.mutex);
+  auto [it, inserted] =
+      profiler.phaseIds.try_emplace(name, profiler.phases.size());
+  if (inserted) {
+    profiler.phases.emplace_back().name = name;
+  }
+  return it->second;
+}
+
+void LoopProfiler::RecordPhase(int phaseId, hal::fpga_clock::time_point start,
+                               hal::fpga_clock::time_point end) {
+  auto& profiler = GetProfiler();
+  if (!profiler.enabled) {
+    return;
+  }
+  std::scoped_lock lock(profiler.mutex);
+  auto& phase = profiler.phases.at(phaseId);
+  phase.last = end - start;
+  if (phase.last > phase.max) {
+    phase.max = phase.last;
+  }
+  phase.updated = true;
+  profiler.events.push_back({phaseId, start, phase.last});
+}
+
+void LoopProfiler::Publish() {
+  using Seconds = std::chrono::duration<double>;
+
+  auto& profiler = GetProfiler();
+  if (!profiler.enabled) {
+    return;
+  }
+  auto now = hal::fpga_clock::now();
+  std::scoped_lock lock(profiler.mutex);
+  if (now - profiler.lastPublishTime < Profiler::kPublishPeriod) {
+    return;
+  }
+  profiler.lastPublishTime = now;
+
+  std::shared_ptr<nt::NetworkTable> table;
+  for (auto& phase : profiler.phases) {
+    if (!phase.updated) {
+      continue;
+    }
+    phase.updated = false;
+    if (!phase.lastEntry) {
+      if (!table) {
+        table =
+            nt::NetworkTableInstance::GetDefault().GetTable("LoopProfiler");
+      }
+      phase.lastEntry = table->GetEntry(phase.name + "/last");
+      phase.maxEntry = table->GetEntry(phase.name + "/max");
+    }
+    phase.lastEntry.SetDouble(Seconds{phase.last}.count());
+    phase.maxEntry.SetDouble(Seconds{phase.max}.count());
+  }
+}
+
+void LoopProfiler::WriteChromeTrace(wpi::raw_ostream& os) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  auto& profiler = GetProfiler();
+  std::scoped_lock lock(profiler.mutex);
+
+  // Names are escaped once per phase rather than once per event
+  std::vector<std::string> names;
+  names.reserve(profiler.phases.size());
+  for (auto& phase : profiler.phases) {
+    names.emplace_back(wpi::json(phase.name).dump());
+  }
+
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  for (auto& event : profiler.events) {
+    os << fmt::format(
+        "{}\n{{\"name\":{},\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":{},"
+        "\"dur\":{}}}",
+        first ? "" : ",", names[event.phaseId],
+        duration_cast<microseconds>(event.start.time_since_epoch()).count(),
+        duration_cast<microseconds>(event.duration).count());
+    first = false;
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool LoopProfiler::WriteChromeTrace(std::string_view filename) {
+  std::error_code ec;
+  wpi::raw_fd_ostream os(filename, ec);
+  if (ec) {
+    FRC_ReportError(warn::Warning, "Could not open '{}' for writing: {}",
+                    filename, ec.message());
+    return false;
+  }
+  WriteChromeTrace(os);
+  return true;
+}
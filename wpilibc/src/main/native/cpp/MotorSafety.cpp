@@ -4,33 +4,85 @@
 
 #include "frc/MotorSafety.h"
 
-#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <thread>
 #include <utility>
 
-#include <wpi/SmallPtrSet.h>
-
 #include "frc/DriverStation.h"
 #include "frc/Errors.h"
 
 using namespace frc;
 
-static wpi::SmallPtrSet<MotorSafety*, 32> instanceList;
-static wpi::mutex listMutex;
+namespace {
+// The stop times of every MotorSafety object, packed so CheckMotors() can
+// sweep them without touching the objects.  Objects with motor safety disabled
+// have an infinite stop time.  Slots are claimed and released without locks.
+struct Registry {
+  static constexpr size_t kMaxObjects = 512;
+
+  Registry() {
+    for (auto& stopTime : stopTimes) {
+      stopTime = std::numeric_limits<double>::infinity();
+    }
+    for (auto& object : objects) {
+      object = nullptr;
+    }
+  }
+
+  size_t Claim(MotorSafety* object) {
+    for (size_t slot = 0; slot < kMaxObjects; ++slot) {
+      MotorSafety* expected = nullptr;
+      if (objects[slot].compare_exchange_strong(expected, object)) {
+        size_t size = numSlots;
+        while (size < slot + 1 &&
+               !numSlots.compare_exchange_weak(size, slot + 1)) {
+        }
+        return slot;
+      }
+    }
+    throw FRC_MakeError(err::NoAvailableResources,
+                        "more than {} MotorSafety objects", kMaxObjects);
+  }
+
+  void Release(size_t slot) {
+    stopTimes[slot] = std::numeric_limits<double>::infinity();
+    objects[slot] = nullptr;
+    // A check that saw the object may still be using it
+    while (activeChecks != 0) {
+      std::this_thread::yield();
+    }
+  }
 
-MotorSafety::MotorSafety() {
-  std::scoped_lock lock(listMutex);
-  instanceList.insert(this);
+  std::array<std::atomic<double>, kMaxObjects> stopTimes;
+  std::array<std::atomic<MotorSafety*>, kMaxObjects> objects;
+  // One past the highest slot ever claimed
+  std::atomic<size_t> numSlots{0};
+  // The number of CheckMotors() calls in progress
+  std::atomic<int> activeChecks{0};
+};
+}  // namespace
+
+static Registry& GetRegistry() {
+  static Registry registry;
+  return registry;
 }
 
+MotorSafety::MotorSafety() : m_slot{GetRegistry().Claim(this)} {}
+
 MotorSafety::~MotorSafety() {
-  std::scoped_lock lock(listMutex);
-  instanceList.erase(this);
+  GetRegistry().Release(m_slot);
 }
 
 MotorSafety::MotorSafety(MotorSafety&& rhs)
-    : m_expiration(std::move(rhs.m_expiration)),
+    : m_slot{GetRegistry().Claim(this)},
+      m_expiration(std::move(rhs.m_expiration)),
       m_enabled(std::move(rhs.m_enabled)),
-      m_stopTime(std::move(rhs.m_stopTime)) {}
+      m_stopTime(std::move(rhs.m_stopTime)) {
+  std::scoped_lock lock(m_thisMutex);
+  UpdateSlot();
+}
 
 MotorSafety& MotorSafety::operator=(MotorSafety&& rhs) {
   std::scoped_lock lock(m_thisMutex, rhs.m_thisMutex);
@@ -38,6 +90,7 @@ MotorSafety& MotorSafety::operator=(MotorSafety&& rhs) {
   m_expiration = std::move(rhs.m_expiration);
   m_enabled = std::move(rhs.m_enabled);
   m_stopTime = std::move(rhs.m_stopTime);
+  UpdateSlot();
 
   return *this;
 }
@@ -45,6 +98,7 @@ MotorSafety& MotorSafety::operator=(MotorSafety&& rhs) {
 void MotorSafety::Feed() {
   std::scoped_lock lock(m_thisMutex);
   m_stopTime = Timer::GetFPGATimestamp() + m_expiration;
+  UpdateSlot();
 }
 
 void MotorSafety::SetExpiration(units::second_t expirationTime) {
@@ -65,6 +119,7 @@ bool MotorSafety::IsAlive() const {
 void MotorSafety::SetSafetyEnabled(bool enabled) {
   std::scoped_lock lock(m_thisMutex);
   m_enabled = enabled;
+  UpdateSlot();
 }
 
 bool MotorSafety::IsSafetyEnabled() const {
@@ -73,6 +128,43 @@ bool MotorSafety::IsSafetyEnabled() const {
 }
 
 void MotorSafety::Check() {
+  if (DriverStation::IsDisabled() || DriverStation::IsTest()) {
+    return;
+  }
+  CheckExpired(Timer::GetFPGATimestamp());
+}
+
+void MotorSafety::CheckMotors() {
+  if (DriverStation::IsDisabled() || DriverStation::IsTest()) {
+    return;
+  }
+
+  auto& registry = GetRegistry();
+  struct ActiveCheck {
+    explicit ActiveCheck(Registry& registry) : registry{registry} {
+      ++registry.activeChecks;
+    }
+    ~ActiveCheck() { --registry.activeChecks; }
+    Registry& registry;
+  } activeCheck{registry};
+
+  double now = Timer::GetFPGATimestamp().value();
+  size_t numSlots = registry.numSlots;
+  for (size_t slot = 0; slot < numSlots; ++slot) {
+    if (registry.stopTimes[slot].load(std::memory_order_relaxed) < now) {
+      if (auto object = registry.objects[slot].load()) {
+        object->CheckExpired(units::second_t{now});
+      }
+    }
+  }
+}
+
+void MotorSafety::UpdateSlot() {
+  GetRegistry().stopTimes[m_slot] =
+      m_enabled ? m_stopTime.value() : std::numeric_limits<double>::infinity();
+}
+
+void MotorSafety::CheckExpired(units::second_t now) {
   bool enabled;
   units::second_t stopTime;
 
@@ -82,20 +174,9 @@ void MotorSafety::Check() {
     stopTime = m_stopTime;
   }
 
-  if (!enabled || DriverStation::IsDisabled() || DriverStation::IsTest()) {
-    return;
-  }
-
-  if (stopTime < Timer::GetFPGATimestamp()) {
+  if (enabled && stopTime < now) {
     FRC_ReportError(err::Timeout, "{}... Output not updated often enough",
                     GetDescription());
     StopMotor();
   }
 }
-
-void MotorSafety::CheckMotors() {
-  std::scoped_lock lock(listMutex);
-  for (auto elem : instanceList) {
-    elem->Check();
-  }
-}
@@ -0,0 +1,168 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/NotifierExecutor.h"
+
+#include <stdint.h>
+
+#include <utility>
+
+#include <fmt/format.h>
+#include <hal/Notifier.h>
+#include <hal/Threads.h>
+#include <wpi/trace.h>
+
+#include "frc/Errors.h"
+#include "frc/Timer.h"
+
+using namespace frc;
+
+// Expiration times are compared in the alarm's microseconds, so an entry is
+// always due once the alarm set for it has fired
+static uint64_t ToAlarmTime(units::second_t time) {
+  return static_cast<uint64_t>(time * 1e6);
+}
+
+NotifierExecutor::NotifierExecutor() {
+  Start(false, 0);
+}
+
+NotifierExecutor::NotifierExecutor(int priority) {
+  Start(true, priority);
+}
+
+NotifierExecutor::~NotifierExecutor() {
+  int32_t status = 0;
+  // atomically set handle to 0, then clean
+  HAL_NotifierHandle handle = m_notifier.exchange(0);
+  HAL_StopNotifier(handle, &status);
+  FRC_ReportError(status, "{}", "StopNotifier");
+
+  // Join the thread to ensure the handlers have exited.
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+
+  HAL_CleanNotifier(handle, &status);
+}
+
+void NotifierExecutor::SetName(std::string_view name) {
+  fmt::memory_buffer buf;
+  fmt::format_to(fmt::appender{buf}, "{}", name);
+  buf.push_back('\0');  // null terminate
+  int32_t status = 0;
+  HAL_SetNotifierName(m_notifier, buf.data(), &status);
+}
+
+void NotifierExecutor::Start(bool realTime, int priority) {
+  int32_t status = 0;
+  m_notifier = HAL_InitializeNotifier(&status);
+  FRC_CheckErrorStatus(status, "{}", "InitializeNotifier");
+
+  m_thread = std::thread([=] { Main(realTime, priority); });
+}
+
+void NotifierExecutor::Main(bool realTime, int priority) {
+  WPI_TRACE_THREAD_NAME("Notifier executor");
+  if (realTime) {
+    int32_t status = 0;
+    HAL_SetCurrentThreadPriority(true, priority, &status);
+  }
+
+  for (;;) {
+    int32_t status = 0;
+    HAL_NotifierHandle notifier = m_notifier.load();
+    if (notifier == 0) {
+      break;
+    }
+    uint64_t curTime = HAL_WaitForNotifierAlarm(notifier, &status);
+    if (curTime == 0 || status != 0) {
+      break;
+    }
+
+    std::unique_lock lock(m_mutex);
+
+    // Call every handler that is due, earliest first
+    while (!m_entries.empty() &&
+           ToAlarmTime(m_entries.top()->expirationTime) <= curTime) {
+      Entry* entry = m_entries.pop();
+      if (entry->periodic) {
+        entry->expirationTime += entry->period;
+        m_entries.push(entry);
+      }
+
+      auto handler = entry->handler;
+      auto budget = entry->overrunBudget;
+      m_runningEntry = entry;
+      lock.unlock();
+
+      auto start = Timer::GetFPGATimestamp();
+      if (handler) {
+        WPI_TRACE_SCOPE("wpilibc.notifier.handler");
+        handler();
+      }
+      auto end = Timer::GetFPGATimestamp();
+
+      lock.lock();
+      // The entry is gone if the handler destroyed its Notifier
+      if (m_runningEntry != entry) {
+        continue;
+      }
+      m_runningEntry = nullptr;
+      m_handlerDone.notify_all();
+
+      if (budget > 0_s && end - start > budget) {
+        ++entry->overrunCount;
+        if (end - entry->lastOverrunPrintTime > 1_s) {
+          entry->lastOverrunPrintTime = end;
+          FRC_ReportError(warn::Warning,
+                          "Notifier {} handler took {:.6f}s, over its budget "
+                          "of {:.6f}s",
+                          entry->name, (end - start).value(), budget.value());
+        }
+      }
+    }
+
+    UpdateAlarm();
+  }
+}
+
+void NotifierExecutor::Schedule(Entry* entry) {
+  m_entries.remove(entry);
+  m_entries.push(entry);
+  UpdateAlarm();
+}
+
+void NotifierExecutor::Unschedule(Entry* entry) {
+  m_entries.remove(entry);
+  UpdateAlarm();
+}
+
+void NotifierExecutor::Remove(Entry* entry,
+                              std::unique_lock<wpi::mutex>& lock) {
+  Unschedule(entry);
+  if (std::this_thread::get_id() == m_thread.get_id()) {
+    if (m_runningEntry == entry) {
+      m_runningEntry = nullptr;
+    }
+    return;
+  }
+  m_handlerDone.wait(lock, [&] { return m_runningEntry != entry; });
+}
+
+void NotifierExecutor::UpdateAlarm() {
+  int32_t status = 0;
+  // Return if we are being destructed, or were not created successfully
+  auto notifier = m_notifier.load();
+  if (notifier == 0) {
+    return;
+  }
+  if (m_entries.empty()) {
+    HAL_CancelNotifierAlarm(notifier, &status);
+  } else {
+    HAL_UpdateNotifierAlarm(
+        notifier, ToAlarmTime(m_entries.top()->expirationTime), &status);
+  }
+  FRC_CheckErrorStatus(status, "{}", "UpdateNotifierAlarm");
+}
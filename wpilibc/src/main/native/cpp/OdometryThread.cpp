@@ -0,0 +1,99 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/OdometryThread.h"
+
+#include <mutex>
+#include <utility>
+
+#include "frc/DMA.h"
+#include "frc/DMASample.h"
+#include "frc/Errors.h"
+#include "frc/Timer.h"
+
+using namespace frc;
+
+OdometryThread::OdometryThread(UpdateFunc update, units::second_t period,
+                               int priority)
+    : m_update{std::move(update)},
+      m_period{period},
+      m_notifier{priority, [this] { Update(); }} {}
+
+OdometryThread::OdometryThread(DMA& dma, DMAUpdateFunc update,
+                               units::second_t period, int priority)
+    : m_dma{&dma},
+      m_dmaUpdate{std::move(update)},
+      m_period{period},
+      m_notifier{priority, [this] { UpdateFromDMA(); }} {}
+
+OdometryThread::~OdometryThread() {
+  Stop();
+}
+
+void OdometryThread::Start() {
+  m_notifier.StartPeriodic(m_period);
+}
+
+void OdometryThread::Stop() {
+  m_notifier.Stop();
+  // wait out an update already running
+  std::scoped_lock lock(m_updateMutex);
+}
+
+OdometryThread::Sample OdometryThread::GetLatest() const {
+  double x, y, theta, timestamp;
+  for (;;) {
+    uint32_t seq = m_seq.load(std::memory_order_acquire);
+    if ((seq & 1) != 0) {
+      continue;
+    }
+    x = m_x.load(std::memory_order_relaxed);
+    y = m_y.load(std::memory_order_relaxed);
+    theta = m_theta.load(std::memory_order_relaxed);
+    timestamp = m_timestamp.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_seq.load(std::memory_order_relaxed) == seq) {
+      break;
+    }
+  }
+  return {Pose2d{units::meter_t{x}, units::meter_t{y},
+                 Rotation2d{units::radian_t{theta}}},
+          units::second_t{timestamp}};
+}
+
+void OdometryThread::Update() {
+  std::scoped_lock lock(m_updateMutex);
+  auto timestamp = Timer::GetFPGATimestamp();
+  Publish(m_update(timestamp), timestamp);
+}
+
+void OdometryThread::UpdateFromDMA() {
+  std::scoped_lock lock(m_updateMutex);
+  DMASample sample;
+  int32_t remaining = 0;
+  do {
+    int32_t status = 0;
+    auto readStatus = sample.Update(m_dma, 0_s, &remaining, &status);
+    if (readStatus != DMASample::DMAReadStatus::kOk) {
+      if (readStatus == DMASample::DMAReadStatus::kError) {
+        FRC_ReportError(status, "{}", "OdometryThread DMA read");
+      }
+      return;
+    }
+    Publish(m_dmaUpdate(sample), sample.GetTimeStamp());
+  } while (remaining > 0);
+}
+
+void OdometryThread::Publish(const Pose2d& pose, units::second_t timestamp) {
+  uint32_t seq = m_seq.load(std::memory_order_relaxed);
+  m_seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  m_x.store(pose.X().to<double>(), std::memory_order_relaxed);
+  m_y.store(pose.Y().to<double>(), std::memory_order_relaxed);
+  m_theta.store(pose.Rotation().Radians().to<double>(),
+                std::memory_order_relaxed);
+  m_timestamp.store(timestamp.to<double>(), std::memory_order_relaxed);
+  m_seq.store(seq + 2, std::memory_order_release);
+  m_updateCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -5,10 +5,13 @@
 #include "frc/Preferences.h"
 
 #include <algorithm>
+#include <memory>
 
 #include <hal/FRCUsageReporting.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
+#include <wpi/StringMap.h>
+#include <wpi/mutex.h>
 
 using namespace frc;
 
@@ -22,6 +25,10 @@ struct Instance {
   std::shared_ptr<nt::NetworkTable> table{
       nt::NetworkTableInstance::GetDefault().GetTable(kTableName)};
   NT_EntryListener listener;
+
+  // Local copies read through handles; never freed, so handles stay valid
+  wpi::mutex cacheMutex;
+  wpi::StringMap<std::unique_ptr<detail::PreferenceValue>> cache;
 };
 }  // namespace
 
@@ -30,6 +37,32 @@ static Instance& GetInstance() {
   return instance;
 }
 
+static void StoreValue(detail::PreferenceValue& cached,
+                       const std::shared_ptr<nt::Value>& value) {
+  if (!value) {
+    cached.type.store(NT_UNASSIGNED, std::memory_order_release);
+    return;
+  }
+  if (value->IsDouble()) {
+    cached.number.store(value->GetDouble(), std::memory_order_relaxed);
+  } else if (value->IsBoolean()) {
+    cached.boolean.store(value->GetBoolean(), std::memory_order_relaxed);
+  }
+  cached.type.store(value->type(), std::memory_order_release);
+}
+
+// Entry listeners run asynchronously, so writes from this program update the
+// local copy right away
+static void UpdateCachedValue(std::string_view key,
+                              nt::NetworkTableEntry entry) {
+  auto& inst = ::GetInstance();
+  std::scoped_lock lock(inst.cacheMutex);
+  auto it = inst.cache.find(key);
+  if (it != inst.cache.end()) {
+    StoreValue(*it->second, entry.GetValue());
+  }
+}
+
 Preferences* Preferences::GetInstance() {
   ::GetInstance();
   static Preferences instance;
@@ -66,10 +99,31 @@ int64_t Preferences::GetLong(std::string_view key, int64_t defaultValue) {
       ::GetInstance().table->GetNumber(key, defaultValue));
 }
 
+Preferences::Double Preferences::GetDoubleHandle(std::string_view key,
+                                                 double defaultValue) {
+  return {GetCachedValue(key), defaultValue};
+}
+
+Preferences::Int Preferences::GetIntHandle(std::string_view key,
+                                           int defaultValue) {
+  return Int{GetDoubleHandle(key, defaultValue)};
+}
+
+Preferences::Long Preferences::GetLongHandle(std::string_view key,
+                                             int64_t defaultValue) {
+  return Long{GetDoubleHandle(key, defaultValue)};
+}
+
+Preferences::Boolean Preferences::GetBooleanHandle(std::string_view key,
+                                                   bool defaultValue) {
+  return {GetCachedValue(key), defaultValue};
+}
+
 void Preferences::SetString(std::string_view key, std::string_view value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetString(value);
   entry.SetPersistent();
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::PutString(std::string_view key, std::string_view value) {
@@ -79,12 +133,14 @@ void Preferences::PutString(std::string_view key, std::string_view value) {
 void Preferences::InitString(std::string_view key, std::string_view value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDefaultString(value);
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::SetInt(std::string_view key, int value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDouble(value);
   entry.SetPersistent();
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::PutInt(std::string_view key, int value) {
@@ -94,12 +150,14 @@ void Preferences::PutInt(std::string_view key, int value) {
 void Preferences::InitInt(std::string_view key, int value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDefaultDouble(value);
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::SetDouble(std::string_view key, double value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDouble(value);
   entry.SetPersistent();
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::PutDouble(std::string_view key, double value) {
@@ -109,12 +167,14 @@ void Preferences::PutDouble(std::string_view key, double value) {
 void Preferences::InitDouble(std::string_view key, double value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDefaultDouble(value);
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::SetFloat(std::string_view key, float value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDouble(value);
   entry.SetPersistent();
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::PutFloat(std::string_view key, float value) {
@@ -124,12 +184,14 @@ void Preferences::PutFloat(std::string_view key, float value) {
 void Preferences::InitFloat(std::string_view key, float value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDefaultDouble(value);
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::SetBoolean(std::string_view key, bool value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetBoolean(value);
   entry.SetPersistent();
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::PutBoolean(std::string_view key, bool value) {
@@ -139,12 +201,14 @@ void Preferences::PutBoolean(std::string_view key, bool value) {
 void Preferences::InitBoolean(std::string_view key, bool value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDefaultBoolean(value);
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::SetLong(std::string_view key, int64_t value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDouble(value);
   entry.SetPersistent();
+  UpdateCachedValue(key, entry);
 }
 
 void Preferences::PutLong(std::string_view key, int64_t value) {
@@ -154,6 +218,7 @@ void Preferences::PutLong(std::string_view key, int64_t value) {
 void Preferences::InitLong(std::string_view key, int64_t value) {
   auto entry = ::GetInstance().table->GetEntry(key);
   entry.SetDefaultDouble(value);
+  UpdateCachedValue(key, entry);
 }
 
 bool Preferences::ContainsKey(std::string_view key) {
@@ -161,7 +226,9 @@ bool Preferences::ContainsKey(std::string_view key) {
 }
 
 void Preferences::Remove(std::string_view key) {
-  ::GetInstance().table->Delete(key);
+  auto& inst = ::GetInstance();
+  inst.table->Delete(key);
+  UpdateCachedValue(key, inst.table->GetEntry(key));
 }
 
 void Preferences::RemoveAll() {
@@ -172,6 +239,30 @@ void Preferences::RemoveAll() {
   }
 }
 
+const detail::PreferenceValue* Preferences::GetCachedValue(
+    std::string_view key) {
+  static_assert(kBooleanType == NT_BOOLEAN);
+  static_assert(kNumberType == NT_DOUBLE);
+
+  auto& inst = ::GetInstance();
+  std::scoped_lock lock(inst.cacheMutex);
+  auto& cached = inst.cache[key];
+  if (!cached) {
+    cached = std::make_unique<detail::PreferenceValue>();
+    auto entry = inst.table->GetEntry(key);
+    StoreValue(*cached, entry.GetValue());
+    auto value = cached.get();
+    // Read the current value rather than the notified one, so a late
+    // notification can't overwrite a newer local write
+    entry.AddListener(
+        [value, entry](const nt::EntryNotification&) {
+          StoreValue(*value, entry.GetValue());
+        },
+        NT_NOTIFY_NEW | NT_NOTIFY_UPDATE | NT_NOTIFY_DELETE);
+  }
+  return cached.get();
+}
+
 Instance::Instance() {
   table->GetEntry(".type").SetString("RobotPreferences");
   listener = table->AddEntryListener(
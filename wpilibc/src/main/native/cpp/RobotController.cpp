@@ -9,6 +9,7 @@
 #include <hal/Power.h>
 
 #include "frc/Errors.h"
+#include "frc/PowerDistributionPanel.h"
 
 using namespace frc;
 
@@ -173,3 +174,21 @@ CANStatus RobotController::GetCANStatus() {
           static_cast<int>(txFullCount), static_cast<int>(receiveErrorCount),
           static_cast<int>(transmitErrorCount)};
 }
+
+void RobotController::StartPowerSampling(units::second_t period) {
+  int32_t status = 0;
+  HAL_StartPowerStatusSampler(HAL_kInvalidHandle, period.to<double>(),
+                              &status);
+  FRC_CheckErrorStatus(status, "{}", "StartPowerSampling");
+}
+
+void RobotController::StartPowerSampling(units::second_t period,
+                                         const PowerDistributionPanel& pdp) {
+  int32_t status = 0;
+  HAL_StartPowerStatusSampler(pdp.m_handle, period.to<double>(), &status);
+  FRC_CheckErrorStatus(status, "{}", "StartPowerSampling");
+}
+
+void RobotController::StopPowerSampling() {
+  HAL_StopPowerStatusSampler();
+}
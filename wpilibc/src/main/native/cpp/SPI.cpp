@@ -4,6 +4,7 @@
 
 #include "frc/SPI.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <utility>
@@ -15,7 +16,6 @@
 
 #include "frc/DigitalSource.h"
 #include "frc/Errors.h"
-#include "frc/Notifier.h"
 
 using namespace frc;
 
@@ -25,12 +25,7 @@ class SPI::Accumulator {
  public:
   Accumulator(HAL_SPIPort port, int xferSize, int validMask, int validValue,
               int dataShift, int dataSize, bool isSigned, bool bigEndian)
-      : m_notifier([=] {
-          std::scoped_lock lock(m_mutex);
-          Update();
-        }),
-        m_buf(new uint32_t[(xferSize + 1) * kAccumulateDepth]),
-        m_validMask(validMask),
+      : m_validMask(validMask),
         m_validValue(validValue),
         m_dataMax(1 << dataSize),
         m_dataMsbMask(1 << (dataSize - 1)),
@@ -39,12 +34,21 @@ class SPI::Accumulator {
         m_isSigned(isSigned),
         m_bigEndian(bigEndian),
         m_port(port) {}
-  ~Accumulator() { delete[] m_buf; }
+  ~Accumulator() {
+    int32_t status = 0;
+    HAL_StopSPIAutoStream(m_port, &status);
+  }
 
-  void Update();
+  // Called on the HAL auto SPI stream thread
+  static void StreamCallback(void* param, const uint32_t* buf,
+                             int32_t numTransfers) {
+    auto accum = static_cast<Accumulator*>(param);
+    std::scoped_lock lock(accum->m_mutex);
+    accum->Update(buf, numTransfers);
+  }
+
+  void Update(const uint32_t* buf, int32_t numTransfers);
 
-  Notifier m_notifier;
-  uint32_t* m_buf;
   wpi::mutex m_mutex;
 
   int64_t m_value = 0;
@@ -68,91 +72,66 @@ class SPI::Accumulator {
   HAL_SPIPort m_port;
 };
 
-void SPI::Accumulator::Update() {
-  bool done;
-  do {
-    done = true;
-    int32_t status = 0;
-
-    // get amount of data available
-    int32_t numToRead =
-        HAL_ReadSPIAutoReceivedData(m_port, m_buf, 0, 0, &status);
-    FRC_CheckErrorStatus(status, "Port {}", m_port);
-
-    // only get whole responses; +1 is for timestamp
-    numToRead -= numToRead % m_xferSize;
-    if (numToRead > m_xferSize * kAccumulateDepth) {
-      numToRead = m_xferSize * kAccumulateDepth;
-      done = false;
-    }
-    if (numToRead == 0) {
-      return;  // no samples
+void SPI::Accumulator::Update(const uint32_t* buf, int32_t numTransfers) {
+  // loop over all responses
+  for (int32_t off = 0; off < numTransfers * m_xferSize; off += m_xferSize) {
+    // get timestamp from first word
+    uint32_t timestamp = buf[off];
+
+    // convert from bytes
+    uint32_t resp = 0;
+    if (m_bigEndian) {
+      for (int32_t i = 1; i < m_xferSize; ++i) {
+        resp <<= 8;
+        resp |= buf[off + i] & 0xff;
+      }
+    } else {
+      for (int32_t i = m_xferSize - 1; i >= 1; --i) {
+        resp <<= 8;
+        resp |= buf[off + i] & 0xff;
+      }
     }
 
-    // read buffered data
-    HAL_ReadSPIAutoReceivedData(m_port, m_buf, numToRead, 0, &status);
-    FRC_CheckErrorStatus(status, "Port {}", m_port);
-
-    // loop over all responses
-    for (int32_t off = 0; off < numToRead; off += m_xferSize) {
-      // get timestamp from first word
-      uint32_t timestamp = m_buf[off];
-
-      // convert from bytes
-      uint32_t resp = 0;
-      if (m_bigEndian) {
-        for (int32_t i = 1; i < m_xferSize; ++i) {
-          resp <<= 8;
-          resp |= m_buf[off + i] & 0xff;
-        }
-      } else {
-        for (int32_t i = m_xferSize - 1; i >= 1; --i) {
-          resp <<= 8;
-          resp |= m_buf[off + i] & 0xff;
-        }
+    // process response
+    if ((resp & m_validMask) == static_cast<uint32_t>(m_validValue)) {
+      // valid sensor data; extract data field
+      int32_t data = static_cast<int32_t>(resp >> m_dataShift);
+      data &= m_dataMax - 1;
+      // 2s complement conversion if signed MSB is set
+      if (m_isSigned && (data & m_dataMsbMask) != 0) {
+        data -= m_dataMax;
       }
-
-      // process response
-      if ((resp & m_validMask) == static_cast<uint32_t>(m_validValue)) {
-        // valid sensor data; extract data field
-        int32_t data = static_cast<int32_t>(resp >> m_dataShift);
-        data &= m_dataMax - 1;
-        // 2s complement conversion if signed MSB is set
-        if (m_isSigned && (data & m_dataMsbMask) != 0) {
-          data -= m_dataMax;
-        }
-        // center offset
-        int32_t dataNoCenter = data;
-        data -= m_center;
-        // only accumulate if outside deadband
-        if (data < -m_deadband || data > m_deadband) {
-          m_value += data;
-          if (m_count != 0) {
-            // timestamps use the 1us FPGA clock; also handle rollover
-            if (timestamp >= m_lastTimestamp) {
-              m_integratedValue +=
-                  dataNoCenter *
-                      static_cast<int32_t>(timestamp - m_lastTimestamp) * 1e-6 -
-                  m_integratedCenter;
-            } else {
-              m_integratedValue +=
-                  dataNoCenter *
-                      static_cast<int32_t>((1ULL << 32) - m_lastTimestamp +
-                                           timestamp) *
-                      1e-6 -
-                  m_integratedCenter;
-            }
+      // center offset
+      int32_t dataNoCenter = data;
+      data -= m_center;
+      // only accumulate if outside deadband
+      if (data < -m_deadband || data > m_deadband) {
+        m_value += data;
+        if (m_count != 0) {
+          // timestamps use the 1us FPGA clock; also handle rollover
+          if (timestamp >= m_lastTimestamp) {
+            m_integratedValue +=
+                dataNoCenter *
+                    static_cast<int32_t>(timestamp - m_lastTimestamp) * 1e-6 -
+                m_integratedCenter;
+          } else {
+            m_integratedValue +=
+                dataNoCenter *
+                    static_cast<int32_t>((1ULL << 32) - m_lastTimestamp +
+                                         timestamp) *
+                    1e-6 -
+                m_integratedCenter;
           }
         }
-        ++m_count;
-        m_lastValue = data;
-      } else {
-        // no data from the sensor; just clear the last value
-        m_lastValue = 0;
       }
-      m_lastTimestamp = timestamp;
+      ++m_count;
+      m_lastValue = data;
+    } else {
+      // no data from the sensor; just clear the last value
+      m_lastValue = 0;
     }
-  } while (!done);
+    m_lastTimestamp = timestamp;
+  }
 }
 
 SPI::SPI(Port port) : m_port(static_cast<HAL_SPIPort>(port)) {
@@ -266,6 +245,7 @@ void SPI::SetAutoTransmitData(wpi::span<const uint8_t> dataToSend,
   HAL_SetSPIAutoTransmitData(m_port, dataToSend.data(), dataToSend.size(),
                              zeroSize, &status);
   FRC_CheckErrorStatus(status, "Port {}", m_port);
+  m_autoTransferSize = dataToSend.size() + zeroSize;
 }
 
 void SPI::StartAutoRate(units::second_t period) {
@@ -323,6 +303,34 @@ void SPI::ConfigureAutoStall(HAL_SPIPort port, int csToSclkTicks,
   FRC_CheckErrorStatus(status, "Port {}", m_port);
 }
 
+void SPI::StartAutoStream(int depth, units::second_t period) {
+  int32_t status = 0;
+  HAL_StartSPIAutoStream(m_port, m_autoTransferSize, depth, period.to<double>(),
+                         nullptr, nullptr, &status);
+  FRC_CheckErrorStatus(status, "Port {}", m_port);
+}
+
+void SPI::StopAutoStream() {
+  int32_t status = 0;
+  HAL_StopSPIAutoStream(m_port, &status);
+  FRC_CheckErrorStatus(status, "Port {}", m_port);
+}
+
+wpi::span<const uint32_t> SPI::AcquireAutoStream(units::second_t timeout) {
+  int32_t status = 0;
+  const uint32_t* data = nullptr;
+  int32_t numTransfers =
+      HAL_AcquireSPIAutoStream(m_port, &data, timeout.to<double>(), &status);
+  FRC_CheckErrorStatus(status, "Port {}", m_port);
+  return {data, static_cast<size_t>(numTransfers * (m_autoTransferSize + 1))};
+}
+
+void SPI::ReleaseAutoStream(int numTransfers) {
+  int32_t status = 0;
+  HAL_ReleaseSPIAutoStream(m_port, numTransfers, &status);
+  FRC_CheckErrorStatus(status, "Port {}", m_port);
+}
+
 void SPI::InitAccumulator(units::second_t period, int cmd, int xferSize,
                           int validMask, int validValue, int dataShift,
                           int dataSize, bool isSigned, bool bigEndian) {
@@ -348,7 +356,13 @@ void SPI::InitAccumulator(units::second_t period, int cmd, int xferSize,
   m_accum =
       std::make_unique<Accumulator>(m_port, xferSize, validMask, validValue,
                                     dataShift, dataSize, isSigned, bigEndian);
-  m_accum->m_notifier.StartPeriodic(period * kAccumulateDepth / 2);
+  // accumulate on the HAL stream thread as transfers arrive, checking at
+  // least once a millisecond
+  int32_t status = 0;
+  HAL_StartSPIAutoStream(m_port, xferSize, kAccumulateDepth,
+                         (std::min)(period.to<double>(), 0.001),
+                         &Accumulator::StreamCallback, m_accum.get(), &status);
+  FRC_CheckErrorStatus(status, "Port {}", m_port);
 }
 
 void SPI::InitAccumulator(double period, int cmd, int xferSize, int validMask,
@@ -396,7 +410,6 @@ int SPI::GetAccumulatorLastValue() const {
     return 0;
   }
   std::scoped_lock lock(m_accum->m_mutex);
-  m_accum->Update();
   return m_accum->m_lastValue;
 }
 
@@ -405,7 +418,6 @@ int64_t SPI::GetAccumulatorValue() const {
     return 0;
   }
   std::scoped_lock lock(m_accum->m_mutex);
-  m_accum->Update();
   return m_accum->m_value;
 }
 
@@ -414,7 +426,6 @@ int64_t SPI::GetAccumulatorCount() const {
     return 0;
   }
   std::scoped_lock lock(m_accum->m_mutex);
-  m_accum->Update();
   return m_accum->m_count;
 }
 
@@ -423,7 +434,6 @@ double SPI::GetAccumulatorAverage() const {
     return 0;
   }
   std::scoped_lock lock(m_accum->m_mutex);
-  m_accum->Update();
   if (m_accum->m_count == 0) {
     return 0.0;
   }
@@ -437,7 +447,6 @@ void SPI::GetAccumulatorOutput(int64_t& value, int64_t& count) const {
     return;
   }
   std::scoped_lock lock(m_accum->m_mutex);
-  m_accum->Update();
   value = m_accum->m_value;
   count = m_accum->m_count;
 }
@@ -455,7 +464,6 @@ double SPI::GetAccumulatorIntegratedValue() const {
     return 0;
   }
   std::scoped_lock lock(m_accum->m_mutex);
-  m_accum->Update();
   return m_accum->m_integratedValue;
 }
 
@@ -464,7 +472,6 @@ double SPI::GetAccumulatorIntegratedAverage() const {
     return 0;
   }
   std::scoped_lock lock(m_accum->m_mutex);
-  m_accum->Update();
   if (m_accum->m_count <= 1) {
     return 0.0;
   }
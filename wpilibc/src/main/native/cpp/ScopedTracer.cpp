@@ -9,11 +9,20 @@
 using namespace frc;
 
 ScopedTracer::ScopedTracer(std::string_view name, wpi::raw_ostream& os)
-    : m_name(name), m_os(os) {
+    : m_name(name), m_os(&os) {
   m_tracer.ResetTimer();
 }
 
+ScopedTracer::ScopedTracer(Tracer& tracer, int epochId)
+    : m_parent(&tracer),
+      m_epochId(epochId),
+      m_startTime(hal::fpga_clock::now()) {}
+
 ScopedTracer::~ScopedTracer() {
+  if (m_parent) {
+    m_parent->RecordEpoch(m_epochId, hal::fpga_clock::now() - m_startTime);
+    return;
+  }
   m_tracer.AddEpoch(m_name);
-  m_tracer.PrintEpochs(m_os);
+  m_tracer.PrintEpochs(*m_os);
 }
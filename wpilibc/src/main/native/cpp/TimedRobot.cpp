@@ -6,17 +6,136 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include <hal/DriverStation.h>
 #include <hal/FRCUsageReporting.h>
 #include <hal/Notifier.h>
+#include <hal/Threads.h>
+#include <wpi/mutex.h>
 
 #include "frc/Errors.h"
 #include "frc/Timer.h"
 
 using namespace frc;
 
+class TimedRobot::RateGroup {
+ public:
+  RateGroup(units::second_t startTime, units::second_t period,
+            units::second_t offset, bool dedicatedThread, int priority)
+      : period{period},
+        offset{offset},
+        dedicatedThread{dedicatedThread},
+        priority{priority},
+        expirationTime{startTime + offset +
+                       units::math::floor(
+                           (Timer::GetFPGATimestamp() - startTime) / period) *
+                           period +
+                       period} {
+    if (dedicatedThread) {
+      StartThread();
+    }
+  }
+
+  ~RateGroup() { Stop(); }
+
+  // Runs the callbacks, and updates the statistics
+  void Run();
+
+  // Sets the dedicated thread's first alarm
+  void Start();
+
+  // Stops the dedicated thread
+  void Stop();
+
+  const units::second_t period;
+  const units::second_t offset;
+  const bool dedicatedThread;
+  const int priority;
+
+  // Held while the callbacks run
+  wpi::mutex mutex;
+  std::vector<std::function<void()>> callbacks;
+
+  // The time the next run is scheduled for
+  units::second_t expirationTime;
+
+  mutable wpi::mutex statsMutex;
+  RateGroupStats stats;
+
+ private:
+  void StartThread();
+
+  hal::Handle<HAL_NotifierHandle> m_notifier;
+  std::thread m_thread;
+};
+
+void TimedRobot::RateGroup::Run() {
+  auto start = Timer::GetFPGATimestamp();
+  auto latency = start - expirationTime;
+  {
+    std::scoped_lock lock(mutex);
+    for (auto&& callback : callbacks) {
+      callback();
+    }
+  }
+  auto duration = Timer::GetFPGATimestamp() - start;
+  expirationTime += period;
+
+  std::scoped_lock lock(statsMutex);
+  ++stats.runs;
+  if (duration > period) {
+    ++stats.overruns;
+  }
+  stats.lastDuration = duration;
+  stats.maxDuration = units::math::max(stats.maxDuration, duration);
+  stats.lastLatency = latency;
+  stats.maxLatency = units::math::max(stats.maxLatency, latency);
+}
+
+void TimedRobot::RateGroup::Start() {
+  int32_t status = 0;
+  HAL_UpdateNotifierAlarm(
+      m_notifier, static_cast<uint64_t>(expirationTime * 1e6), &status);
+  FRC_CheckErrorStatus(status, "{}", "UpdateNotifierAlarm");
+}
+
+void TimedRobot::RateGroup::StartThread() {
+  int32_t status = 0;
+  m_notifier = HAL_InitializeNotifier(&status);
+  FRC_CheckErrorStatus(status, "{}", "InitializeNotifier");
+  HAL_SetNotifierName(m_notifier, "TimedRobot rate group", &status);
+
+  // The thread waits without an alarm until the group is started
+  m_thread = std::thread([this] {
+    int32_t status = 0;
+    HAL_SetCurrentThreadPriority(true, priority, &status);
+    for (;;) {
+      uint64_t curTime = HAL_WaitForNotifierAlarm(m_notifier, &status);
+      if (curTime == 0 || status != 0) {
+        break;
+      }
+      Run();
+      HAL_UpdateNotifierAlarm(
+          m_notifier, static_cast<uint64_t>(expirationTime * 1e6), &status);
+    }
+  });
+}
+
+void TimedRobot::RateGroup::Stop() {
+  if (!m_thread.joinable()) {
+    return;
+  }
+  int32_t status = 0;
+  HAL_StopNotifier(m_notifier, &status);
+  m_thread.join();
+  HAL_CleanNotifier(m_notifier, &status);
+}
+
 void TimedRobot::StartCompetition() {
   RobotInit();
 
@@ -24,6 +143,13 @@ void TimedRobot::StartCompetition() {
     SimulationInit();
   }
 
+  for (auto&& group : m_rateGroups) {
+    if (group->dedicatedThread) {
+      group->Start();
+    }
+  }
+  m_rateGroupsStarted = true;
+
   // Tell the DS that the robot is ready to be enabled
   HAL_ObserveUserProgramStarting();
 
@@ -66,6 +192,9 @@ void TimedRobot::StartCompetition() {
 void TimedRobot::EndCompetition() {
   int32_t status = 0;
   HAL_StopNotifier(m_notifier, &status);
+  for (auto&& group : m_rateGroups) {
+    group->Stop();
+  }
 }
 
 TimedRobot::TimedRobot(double period) : TimedRobot(units::second_t(period)) {}
@@ -84,6 +213,8 @@ TimedRobot::TimedRobot(units::second_t period) : IterativeRobotBase(period) {
 }
 
 TimedRobot::~TimedRobot() {
+  m_rateGroups.clear();
+
   int32_t status = 0;
 
   HAL_StopNotifier(m_notifier, &status);
@@ -96,3 +227,63 @@ void TimedRobot::AddPeriodic(std::function<void()> callback,
                              units::second_t period, units::second_t offset) {
   m_callbacks.emplace(callback, m_startTime, period, offset);
 }
+
+int TimedRobot::AddRateGroup(units::second_t period, bool dedicatedThread,
+                             int priority) {
+  auto& group = m_rateGroups.emplace_back(
+      std::make_unique<RateGroup>(m_startTime, period, ChooseOffset(period),
+                                  dedicatedThread, priority));
+  if (!dedicatedThread) {
+    AddPeriodic([group = group.get()] { group->Run(); }, period, group->offset);
+  } else if (m_rateGroupsStarted) {
+    group->Start();
+  }
+  return m_rateGroups.size() - 1;
+}
+
+void TimedRobot::AddRateGroupCallback(int group,
+                                      std::function<void()> callback) {
+  auto& rateGroup = *m_rateGroups.at(group);
+  std::scoped_lock lock(rateGroup.mutex);
+  rateGroup.callbacks.emplace_back(std::move(callback));
+}
+
+TimedRobot::RateGroupStats TimedRobot::GetRateGroupStats(int group) const {
+  auto& rateGroup = *m_rateGroups.at(group);
+  std::scoped_lock lock(rateGroup.statsMutex);
+  return rateGroup.stats;
+}
+
+units::second_t TimedRobot::ChooseOffset(units::second_t period) const {
+  // The phases within the new group's period at which the main loop and the
+  // other groups run
+  std::vector<double> phases;
+  auto addPhases = [&](units::second_t otherPeriod, units::second_t offset) {
+    double phase = std::fmod(offset.value(), otherPeriod.value());
+    if (otherPeriod >= period) {
+      phases.emplace_back(std::fmod(phase, period.value()));
+      return;
+    }
+    for (int i = 0; i < 1000 && phase < period.value(); ++i) {
+      phases.emplace_back(phase);
+      phase += otherPeriod.value();
+    }
+  };
+  addPhases(GetPeriod(), 0_s);
+  for (auto&& group : m_rateGroups) {
+    addPhases(group->period, group->offset);
+  }
+  std::sort(phases.begin(), phases.end());
+
+  // The middle of the largest gap between them, wrapping around the period
+  double bestGap = phases.front() + period.value() - phases.back();
+  double bestPhase = phases.back() + bestGap / 2;
+  for (size_t i = 1; i < phases.size(); ++i) {
+    double gap = phases[i] - phases[i - 1];
+    if (gap > bestGap) {
+      bestGap = gap;
+      bestPhase = phases[i - 1] + gap / 2;
+    }
+  }
+  return units::second_t{std::fmod(bestPhase, period.value())};
+}
@@ -4,7 +4,11 @@
 
 #include "frc/Tracer.h"
 
+#include <algorithm>
+
 #include <fmt/format.h>
+#include <networktables/NetworkTable.h>
+#include <wpi/MathExtras.h>
 #include <wpi/SmallString.h>
 #include <wpi/raw_ostream.h>
 
@@ -12,6 +16,26 @@
 
 using namespace frc;
 
+static int BucketIndex(std::chrono::nanoseconds duration) {
+  uint64_t us = std::max<int64_t>(duration.count() / 1000, 0);
+  if (us < 4) {
+    return us;
+  }
+  int exponent = wpi::Log2_64(us);
+  int index = 4 * (exponent - 1) + ((us >> (exponent - 2)) & 3);
+  return std::min(index, 127);
+}
+
+// The exclusive upper bound of a bucket
+static std::chrono::nanoseconds BucketLimit(int index) {
+  if (index < 4) {
+    return std::chrono::microseconds{index + 1};
+  }
+  int exponent = index / 4 + 1;
+  return std::chrono::microseconds{static_cast<int64_t>(5 + index % 4)
+                                   << (exponent - 2)};
+}
+
 Tracer::Tracer() {
   ResetTimer();
 }
@@ -22,15 +46,50 @@ void Tracer::ResetTimer() {
 
 void Tracer::ClearEpochs() {
   ResetTimer();
-  m_epochs.clear();
+  for (auto& epoch : m_epochs) {
+    epoch.added = false;
+  }
+}
+
+int Tracer::RegisterEpoch(std::string_view epochName) {
+  auto [it, inserted] = m_epochIds.try_emplace(epochName, m_epochs.size());
+  if (inserted) {
+    m_epochs.emplace_back().name = epochName;
+  }
+  return it->second;
+}
+
+int Tracer::RegisterEpoch(std::string_view epochName, int parentId) {
+  return RegisterEpoch(
+      fmt::format("{}/{}", m_epochs.at(parentId).name, epochName));
 }
 
 void Tracer::AddEpoch(std::string_view epochName) {
+  AddEpoch(RegisterEpoch(epochName));
+}
+
+void Tracer::AddEpoch(int epochId) {
   auto currentTime = hal::fpga_clock::now();
-  m_epochs[epochName] = currentTime - m_startTime;
+  RecordEpoch(epochId, currentTime - m_startTime);
   m_startTime = currentTime;
 }
 
+void Tracer::RecordEpoch(int epochId, std::chrono::nanoseconds duration) {
+  auto& epoch = m_epochs[epochId];
+  epoch.last = duration;
+  epoch.added = true;
+
+  if (epoch.count == 0 || duration < epoch.min) {
+    epoch.min = duration;
+  }
+  if (epoch.count == 0 || duration > epoch.max) {
+    epoch.max = duration;
+  }
+  epoch.total += duration;
+  ++epoch.count;
+  ++epoch.histogram[BucketIndex(duration)];
+}
+
 void Tracer::PrintEpochs() {
   wpi::SmallString<128> buf;
   wpi::raw_svector_ostream os(buf);
@@ -48,9 +107,60 @@ void Tracer::PrintEpochs(wpi::raw_ostream& os) {
   if (now - m_lastEpochsPrintTime > kMinPrintPeriod) {
     m_lastEpochsPrintTime = now;
     for (const auto& epoch : m_epochs) {
-      os << fmt::format(
-          "\t{}: {:.6f}s\n", epoch.getKey(),
-          duration_cast<microseconds>(epoch.getValue()).count() / 1.0e6);
+      if (!epoch.added) {
+        continue;
+      }
+      os << fmt::format("\t{}: {:.6f}s\n", epoch.name,
+                        duration_cast<microseconds>(epoch.last).count() / 1.0e6);
+    }
+  }
+}
+
+Tracer::EpochStats Tracer::GetEpochStats(int epochId) const {
+  auto& epoch = m_epochs.at(epochId);
+  EpochStats stats;
+  stats.count = epoch.count;
+  if (epoch.count == 0) {
+    return stats;
+  }
+  stats.min = epoch.min;
+  stats.mean = epoch.total / epoch.count;
+  stats.max = epoch.max;
+
+  // The bucket holding the 99th percentile sample
+  int64_t rank = (epoch.count * 99 + 99) / 100;
+  int64_t seen = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    seen += epoch.histogram[i];
+    if (seen >= rank) {
+      stats.p99 = std::clamp(BucketLimit(i), epoch.min, epoch.max);
+      break;
+    }
+  }
+  return stats;
+}
+
+void Tracer::ResetEpochStats() {
+  for (auto& epoch : m_epochs) {
+    epoch.count = 0;
+    epoch.min = epoch.max = epoch.total = std::chrono::nanoseconds{0};
+    epoch.histogram.fill(0);
+  }
+}
+
+void Tracer::PublishEpochStats(nt::NetworkTable& table) const {
+  using Seconds = std::chrono::duration<double>;
+
+  for (size_t i = 0; i < m_epochs.size(); ++i) {
+    auto stats = GetEpochStats(i);
+    if (stats.count == 0) {
+      continue;
     }
+    auto& name = m_epochs[i].name;
+    table.GetEntry(name + "/count").SetDouble(stats.count);
+    table.GetEntry(name + "/min").SetDouble(Seconds{stats.min}.count());
+    table.GetEntry(name + "/mean").SetDouble(Seconds{stats.mean}.count());
+    table.GetEntry(name + "/max").SetDouble(Seconds{stats.max}.count());
+    table.GetEntry(name + "/p99").SetDouble(Seconds{stats.p99}.count());
   }
 }
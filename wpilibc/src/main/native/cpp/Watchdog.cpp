@@ -196,10 +196,22 @@ void Watchdog::AddEpoch(std::string_view epochName) {
   m_tracer.AddEpoch(epochName);
 }
 
+int Watchdog::RegisterEpoch(std::string_view epochName) {
+  return m_tracer.RegisterEpoch(epochName);
+}
+
+void Watchdog::AddEpoch(int epochId) {
+  m_tracer.AddEpoch(epochId);
+}
+
 void Watchdog::PrintEpochs() {
   m_tracer.PrintEpochs();
 }
 
+void Watchdog::PublishEpochStats(nt::NetworkTable& table) const {
+  m_tracer.PublishEpochStats(table);
+}
+
 void Watchdog::Reset() {
   Enable();
 }
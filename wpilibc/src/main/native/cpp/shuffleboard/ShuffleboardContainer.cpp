@@ -28,6 +28,22 @@ ShuffleboardContainer::GetComponents() const {
   return m_components;
 }
 
+void ShuffleboardContainer::BuildComponents(
+    std::shared_ptr<nt::NetworkTable> parentTable,
+    std::shared_ptr<nt::NetworkTable> metaTable, std::string_view type) {
+  if (!m_table) {
+    m_table = parentTable->GetSubTable(GetTitle());
+    m_table->GetEntry(".type").SetString(type);
+  }
+  for (size_t i = m_componentMetaTables.size(); i < m_components.size(); ++i) {
+    m_componentMetaTables.emplace_back(
+        metaTable->GetSubTable(m_components[i]->GetTitle()));
+  }
+  for (size_t i = 0; i < m_components.size(); ++i) {
+    m_components[i]->BuildInto(m_table, m_componentMetaTables[i]);
+  }
+}
+
 ShuffleboardLayout& ShuffleboardContainer::GetLayout(std::string_view title,
                                                      BuiltInLayouts type) {
   return GetLayout(title, GetStringFromBuiltInLayout(type));
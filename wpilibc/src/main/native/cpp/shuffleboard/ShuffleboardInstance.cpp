@@ -14,8 +14,15 @@
 
 using namespace frc::detail;
 
+namespace {
+struct Tab {
+  std::unique_ptr<frc::ShuffleboardTab> tab;
+  std::shared_ptr<nt::NetworkTable> metaTable;
+};
+}  // namespace
+
 struct ShuffleboardInstance::Impl {
-  wpi::StringMap<std::unique_ptr<ShuffleboardTab>> tabs;
+  wpi::StringMap<Tab> tabs;
 
   bool tabsChanged = false;
   std::shared_ptr<nt::NetworkTable> rootTable;
@@ -32,34 +39,32 @@ ShuffleboardInstance::ShuffleboardInstance(nt::NetworkTableInstance ntInstance)
 ShuffleboardInstance::~ShuffleboardInstance() = default;
 
 frc::ShuffleboardTab& ShuffleboardInstance::GetTab(std::string_view title) {
-  if (m_impl->tabs.find(title) == m_impl->tabs.end()) {
-    m_impl->tabs.try_emplace(title,
-                             std::make_unique<ShuffleboardTab>(*this, title));
+  auto& tab = m_impl->tabs[title];
+  if (!tab.tab) {
+    tab.tab = std::make_unique<ShuffleboardTab>(*this, title);
+    tab.metaTable = m_impl->rootMetaTable->GetSubTable(title);
     m_impl->tabsChanged = true;
   }
-  return *m_impl->tabs.find(title)->second;
+  return *tab.tab;
 }
 
 void ShuffleboardInstance::Update() {
   if (m_impl->tabsChanged) {
     wpi::SmallVector<std::string, 16> tabTitles;
     for (auto& entry : m_impl->tabs) {
-      tabTitles.emplace_back(entry.second->GetTitle());
+      tabTitles.emplace_back(entry.second.tab->GetTitle());
     }
     m_impl->rootMetaTable->GetEntry("Tabs").ForceSetStringArray(tabTitles);
     m_impl->tabsChanged = false;
   }
   for (auto& entry : m_impl->tabs) {
-    auto& tab = *entry.second;
-    tab.BuildInto(m_impl->rootTable,
-                  m_impl->rootMetaTable->GetSubTable(tab.GetTitle()));
+    entry.second.tab->BuildInto(m_impl->rootTable, entry.second.metaTable);
   }
 }
 
 void ShuffleboardInstance::EnableActuatorWidgets() {
   for (auto& entry : m_impl->tabs) {
-    auto& tab = *entry.second;
-    for (auto& component : tab.GetComponents()) {
+    for (auto& component : entry.second.tab->GetComponents()) {
       component->EnableIfActuator();
     }
   }
@@ -67,8 +72,7 @@ void ShuffleboardInstance::EnableActuatorWidgets() {
 
 void ShuffleboardInstance::DisableActuatorWidgets() {
   for (auto& entry : m_impl->tabs) {
-    auto& tab = *entry.second;
-    for (auto& component : tab.GetComponents()) {
+    for (auto& component : entry.second.tab->GetComponents()) {
       component->DisableIfActuator();
     }
   }
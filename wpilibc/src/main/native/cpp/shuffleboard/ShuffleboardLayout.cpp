@@ -19,9 +19,5 @@ void ShuffleboardLayout::BuildInto(
     std::shared_ptr<nt::NetworkTable> parentTable,
     std::shared_ptr<nt::NetworkTable> metaTable) {
   BuildMetadata(metaTable);
-  auto table = parentTable->GetSubTable(GetTitle());
-  table->GetEntry(".type").SetString("ShuffleboardLayout");
-  for (auto& component : GetComponents()) {
-    component->BuildInto(table, metaTable->GetSubTable(component->GetTitle()));
-  }
+  BuildComponents(parentTable, metaTable, "ShuffleboardLayout");
 }
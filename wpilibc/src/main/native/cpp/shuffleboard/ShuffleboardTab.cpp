@@ -15,10 +15,5 @@ ShuffleboardRoot& ShuffleboardTab::GetRoot() {
 
 void ShuffleboardTab::BuildInto(std::shared_ptr<nt::NetworkTable> parentTable,
                                 std::shared_ptr<nt::NetworkTable> metaTable) {
-  auto tabTable = parentTable->GetSubTable(GetTitle());
-  tabTable->GetEntry(".type").SetString("ShuffleboardTab");
-  for (auto& component : GetComponents()) {
-    component->BuildInto(tabTable,
-                         metaTable->GetSubTable(component->GetTitle()));
-  }
+  BuildComponents(parentTable, metaTable, "ShuffleboardTab");
 }
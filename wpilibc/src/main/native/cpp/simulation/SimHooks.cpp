@@ -48,4 +48,20 @@ void StepTimingAsync(units::second_t delta) {
   HALSIM_StepTimingAsync(static_cast<uint64_t>(delta.to<double>() * 1e6));
 }
 
+void SetTimingFastForward(bool enable) {
+  HALSIM_SetTimingFastForward(enable);
+}
+
+bool IsTimingFastForward() {
+  return HALSIM_IsTimingFastForward();
+}
+
+void SetTimingLockStep(bool enable) {
+  HALSIM_SetTimingLockStep(enable);
+}
+
+bool IsTimingLockStep() {
+  return HALSIM_IsTimingLockStep();
+}
+
 }  // namespace frc::sim
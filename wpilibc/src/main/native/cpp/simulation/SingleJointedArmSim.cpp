@@ -9,7 +9,6 @@
 #include <units/voltage.h>
 #include <wpi/MathExtras.h>
 
-#include "frc/system/NumericalIntegration.h"
 #include "frc/system/plant/LinearSystemId.h"
 
 using namespace frc;
@@ -88,7 +87,7 @@ Eigen::Matrix<double, 2, 1> SingleJointedArmSim::UpdateX(
   // We therefore find that f(x, u) = Ax + Bu + [[0] [m * g * r / I *
   // std::cos(theta)]]
 
-  Eigen::Matrix<double, 2, 1> updatedXhat = RKDP(
+  Eigen::Matrix<double, 2, 1> updatedXhat = m_integrator.Integrate(
       [&](const auto& x, const auto& u) -> Eigen::Matrix<double, 2, 1> {
         Eigen::Matrix<double, 2, 1> xdot = m_plant.A() * x + m_plant.B() * u;
 
@@ -4,11 +4,10 @@
 
 #include "frc/smartdashboard/FieldObject2d.h"
 
+#include <algorithm>
 #include <vector>
 
-#include <wpi/Endian.h>
-#include <wpi/MathExtras.h>
-
+#include "frc/geometry/Pose2dArrayEncoding.h"
 #include "frc/trajectory/Trajectory.h"
 
 using namespace frc;
@@ -17,12 +16,14 @@ FieldObject2d::FieldObject2d(FieldObject2d&& rhs) {
   std::swap(m_name, rhs.m_name);
   std::swap(m_entry, rhs.m_entry);
   std::swap(m_poses, rhs.m_poses);
+  std::swap(m_encoded, rhs.m_encoded);
 }
 
 FieldObject2d& FieldObject2d::operator=(FieldObject2d&& rhs) {
   std::swap(m_name, rhs.m_name);
   std::swap(m_entry, rhs.m_entry);
   std::swap(m_poses, rhs.m_poses);
+  std::swap(m_encoded, rhs.m_encoded);
 
   return *this;
 }
@@ -91,33 +92,32 @@ void FieldObject2d::UpdateEntry(bool setDefault) {
       arr.push_back(translation.Y().to<double>());
       arr.push_back(pose.Rotation().Degrees().to<double>());
     }
+    m_encoded.clear();
     if (setDefault) {
       m_entry.SetDefaultDoubleArray(arr);
-    } else {
-      m_entry.ForceSetDoubleArray(arr);
+      return;
     }
-  } else {
-    // send as raw array of doubles if too big for NT array
-    std::vector<char> arr;
-    arr.resize(m_poses.size() * 3 * 8);
-    char* p = arr.data();
-    for (auto&& pose : m_poses) {
-      auto& translation = pose.Translation();
-      wpi::support::endian::write64be(
-          p, wpi::DoubleToBits(translation.X().to<double>()));
-      p += 8;
-      wpi::support::endian::write64be(
-          p, wpi::DoubleToBits(translation.Y().to<double>()));
-      p += 8;
-      wpi::support::endian::write64be(
-          p, wpi::DoubleToBits(pose.Rotation().Degrees().to<double>()));
-      p += 8;
+    // don't republish unchanged poses
+    auto value = m_entry.GetValue();
+    if (value && value->IsDoubleArray()) {
+      auto current = value->GetDoubleArray();
+      if (std::equal(current.begin(), current.end(), arr.begin(), arr.end())) {
+        return;
+      }
     }
+    m_entry.ForceSetDoubleArray(arr);
+  } else {
+    // send as compactly encoded raw if too big for NT array
+    EncodePose2dArray(m_poses, &m_encoded);
     if (setDefault) {
-      m_entry.SetDefaultRaw({arr.data(), arr.size()});
-    } else {
-      m_entry.ForceSetRaw({arr.data(), arr.size()});
+      m_entry.SetDefaultRaw(m_encoded);
+      return;
     }
+    auto value = m_entry.GetValue();
+    if (value && value->IsRaw() && value->GetRaw() == m_encoded) {
+      return;
+    }
+    m_entry.ForceSetRaw(m_encoded);
   }
 }
 
@@ -143,28 +143,16 @@ void FieldObject2d::UpdateFromEntry() const {
                  Rotation2d{units::degree_t{arr[i * 3 + 2]}}};
     }
   } else if (val->IsRaw()) {
-    // treat it simply as an array of doubles
     std::string_view data = val->GetRaw();
-
-    // must be triples of doubles
-    auto size = data.size();
-    if ((size % (3 * 8)) != 0) {
+    // the encoding is lossy, so keep the poses that were last published
+    if (data == m_encoded) {
       return;
     }
-    m_poses.resize(size / (3 * 8));
-    const char* p = data.data();
-    for (size_t i = 0; i < size / (3 * 8); ++i) {
-      double x = wpi::BitsToDouble(
-          wpi::support::endian::readNext<uint64_t, wpi::support::big,
-                                         wpi::support::unaligned>(p));
-      double y = wpi::BitsToDouble(
-          wpi::support::endian::readNext<uint64_t, wpi::support::big,
-                                         wpi::support::unaligned>(p));
-      double rot = wpi::BitsToDouble(
-          wpi::support::endian::readNext<uint64_t, wpi::support::big,
-                                         wpi::support::unaligned>(p));
-      m_poses[i] = Pose2d{units::meter_t{x}, units::meter_t{y},
-                          Rotation2d{units::degree_t{rot}}};
+    if (auto size = GetEncodedPose2dArraySize(data)) {
+      m_poses.resize(*size);
+      if (!DecodePose2dArray(data, m_poses)) {
+        m_poses.clear();
+      }
     }
   }
 }
@@ -7,6 +7,7 @@
 #include <cstdio>
 
 #include <networktables/NTSendableBuilder.h>
+#include <ntcore_cpp.h>
 
 using namespace frc;
 
@@ -21,12 +22,14 @@ Mechanism2d::Mechanism2d(double width, double height,
 
 MechanismRoot2d* Mechanism2d::GetRoot(std::string_view name, double x,
                                       double y) {
+  std::scoped_lock lock(m_mutex);
   auto& obj = m_roots[name];
   if (obj) {
     return obj.get();
   }
   obj = std::make_unique<MechanismRoot2d>(name, x, y,
                                           MechanismRoot2d::private_init{});
+  obj->SetBatched(m_batched);
   if (m_table) {
     obj->Update(m_table->GetSubTable(name));
   }
@@ -41,6 +44,28 @@ void Mechanism2d::SetBackgroundColor(const Color8Bit& color) {
   }
 }
 
+void Mechanism2d::SetBatched(bool batched) {
+  std::scoped_lock lock(m_mutex);
+  if (m_batched && !batched) {
+    PublishUpdates();
+  }
+  m_batched = batched;
+  for (auto&& entry : m_roots) {
+    entry.getValue()->SetBatched(batched);
+  }
+}
+
+void Mechanism2d::PublishUpdates() {
+  m_updateEntries.clear();
+  m_updateValues.clear();
+  for (auto&& entry : m_roots) {
+    entry.getValue()->CollectAllUpdates(m_updateEntries, m_updateValues);
+  }
+  if (!m_updateEntries.empty()) {
+    nt::SetEntryValues(m_updateEntries, m_updateValues);
+  }
+}
+
 void Mechanism2d::InitSendable(nt::NTSendableBuilder& builder) {
   builder.SetSmartDashboardType("Mechanism2d");
   m_table = builder.GetTable();
@@ -53,4 +78,11 @@ void Mechanism2d::InitSendable(nt::NTSendableBuilder& builder) {
     const auto& root = entry.getValue().get();
     root->Update(m_table->GetSubTable(entry.getKey()));
   }
+
+  builder.SetUpdateTable([this] {
+    std::scoped_lock lock(m_mutex);
+    if (m_batched) {
+      PublishUpdates();
+    }
+  });
 }
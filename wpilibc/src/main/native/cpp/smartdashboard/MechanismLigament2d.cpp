@@ -4,7 +4,9 @@
 
 #include "frc/smartdashboard/MechanismLigament2d.h"
 
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 
 using namespace frc;
 
@@ -15,7 +17,11 @@ MechanismLigament2d::MechanismLigament2d(std::string_view name, double length,
     : MechanismObject2d(name),
       m_length{length},
       m_angle{angle.to<double>()},
-      m_weight{lineWeight} {
+      m_weight{lineWeight},
+      m_publishedLength{NAN},
+      m_publishedAngle{NAN},
+      m_publishedWeight{NAN},
+      m_publishedColor{} {
   SetColor(color);
 }
 
@@ -27,6 +33,11 @@ void MechanismLigament2d::UpdateEntries(
   m_angleEntry = table->GetEntry("angle");
   m_weightEntry = table->GetEntry("weight");
   m_lengthEntry = table->GetEntry("length");
+  // republish everything to the new table
+  m_publishedLength = NAN;
+  m_publishedAngle = NAN;
+  m_publishedWeight = NAN;
+  m_publishedColor[0] = '\0';
   Flush();
 }
 
@@ -50,15 +61,21 @@ void MechanismLigament2d::SetLineWeight(double lineWidth) {
 }
 
 double MechanismLigament2d::GetAngle() {
-  if (m_angleEntry) {
+  std::scoped_lock lock(m_mutex);
+  // pick up changes made from the dashboard unless a newer local change is
+  // waiting to be published
+  if (m_angleEntry && m_angle == m_publishedAngle) {
     m_angle = m_angleEntry.GetDouble(0.0);
+    m_publishedAngle = m_angle;
   }
   return m_angle;
 }
 
 double MechanismLigament2d::GetLength() {
-  if (m_lengthEntry) {
+  std::scoped_lock lock(m_mutex);
+  if (m_lengthEntry && m_length == m_publishedLength) {
     m_length = m_lengthEntry.GetDouble(0.0);
+    m_publishedLength = m_length;
   }
   return m_length;
 }
@@ -69,13 +86,26 @@ void MechanismLigament2d::SetLength(double length) {
   Flush();
 }
 
-#define SAFE_WRITE(data, Type)           \
-  if (m_##data##Entry) {                 \
-    m_##data##Entry.Set##Type(m_##data); \
+static void CollectDouble(
+    const nt::NetworkTableEntry& entry, double value, double* published,
+    wpi::SmallVectorImpl<NT_Entry>& entries,
+    wpi::SmallVectorImpl<std::shared_ptr<nt::Value>>& values) {
+  if (entry && value != *published) {
+    entries.emplace_back(entry.GetHandle());
+    values.emplace_back(nt::Value::MakeDouble(value));
+    *published = value;
+  }
+}
+
+void MechanismLigament2d::CollectUpdates(
+    wpi::SmallVectorImpl<NT_Entry>& entries,
+    wpi::SmallVectorImpl<std::shared_ptr<nt::Value>>& values) {
+  if (m_colorEntry && std::strcmp(m_color, m_publishedColor) != 0) {
+    entries.emplace_back(m_colorEntry.GetHandle());
+    values.emplace_back(nt::Value::MakeString(m_color));
+    std::memcpy(m_publishedColor, m_color, sizeof(m_color));
   }
-void MechanismLigament2d::Flush() {
-  SAFE_WRITE(color, String)
-  SAFE_WRITE(angle, Double)
-  SAFE_WRITE(length, Double)
-  SAFE_WRITE(weight, Double)
+  CollectDouble(m_angleEntry, m_angle, &m_publishedAngle, entries, values);
+  CollectDouble(m_lengthEntry, m_length, &m_publishedLength, entries, values);
+  CollectDouble(m_weightEntry, m_weight, &m_publishedWeight, entries, values);
 }
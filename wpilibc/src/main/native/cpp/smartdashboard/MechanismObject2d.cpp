@@ -4,6 +4,8 @@
 
 #include "frc/smartdashboard/MechanismObject2d.h"
 
+#include <ntcore_cpp.h>
+
 using namespace frc;
 
 MechanismObject2d::MechanismObject2d(std::string_view name) : m_name{name} {}
@@ -21,3 +23,33 @@ void MechanismObject2d::Update(std::shared_ptr<nt::NetworkTable> table) {
     entry.getValue()->Update(m_table->GetSubTable(entry.getKey()));
   }
 }
+
+void MechanismObject2d::Flush() {
+  if (m_batched) {
+    return;
+  }
+  wpi::SmallVector<NT_Entry, 4> entries;
+  wpi::SmallVector<std::shared_ptr<nt::Value>, 4> values;
+  CollectUpdates(entries, values);
+  if (!entries.empty()) {
+    nt::SetEntryValues(entries, values);
+  }
+}
+
+void MechanismObject2d::SetBatched(bool batched) {
+  std::scoped_lock lock(m_mutex);
+  m_batched = batched;
+  for (auto&& entry : m_objects) {
+    entry.getValue()->SetBatched(batched);
+  }
+}
+
+void MechanismObject2d::CollectAllUpdates(
+    wpi::SmallVectorImpl<NT_Entry>& entries,
+    wpi::SmallVectorImpl<std::shared_ptr<nt::Value>>& values) {
+  std::scoped_lock lock(m_mutex);
+  CollectUpdates(entries, values);
+  for (auto&& entry : m_objects) {
+    entry.getValue()->CollectAllUpdates(entries, values);
+  }
+}
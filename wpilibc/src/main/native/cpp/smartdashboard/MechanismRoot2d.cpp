@@ -4,6 +4,8 @@
 
 #include "frc/smartdashboard/MechanismRoot2d.h"
 
+#include <cmath>
+
 #include "frc/util/Color8Bit.h"
 
 using namespace frc;
@@ -12,7 +14,11 @@ static constexpr char kPosition[] = "pos";
 
 MechanismRoot2d::MechanismRoot2d(std::string_view name, double x, double y,
                                  const private_init&)
-    : MechanismObject2d(name), m_x{x}, m_y{y} {}
+    : MechanismObject2d(name),
+      m_x{x},
+      m_y{y},
+      m_publishedX{NAN},
+      m_publishedY{NAN} {}
 
 void MechanismRoot2d::SetPosition(double x, double y) {
   std::scoped_lock lock(m_mutex);
@@ -23,11 +29,20 @@ void MechanismRoot2d::SetPosition(double x, double y) {
 
 void MechanismRoot2d::UpdateEntries(std::shared_ptr<nt::NetworkTable> table) {
   m_posEntry = table->GetEntry(kPosition);
+  // republish to the new table
+  m_publishedX = NAN;
+  m_publishedY = NAN;
   Flush();
 }
 
-inline void MechanismRoot2d::Flush() {
-  if (m_posEntry) {
-    m_posEntry.SetDoubleArray({m_x, m_y});
+void MechanismRoot2d::CollectUpdates(
+    wpi::SmallVectorImpl<NT_Entry>& entries,
+    wpi::SmallVectorImpl<std::shared_ptr<nt::Value>>& values) {
+  if (!m_posEntry || (m_x == m_publishedX && m_y == m_publishedY)) {
+    return;
   }
+  entries.emplace_back(m_posEntry.GetHandle());
+  values.emplace_back(nt::Value::MakeDoubleArray({m_x, m_y}));
+  m_publishedX = m_x;
+  m_publishedY = m_y;
 }
@@ -32,9 +32,21 @@ void SendableBuilderImpl::Update() {
   uint64_t time = nt::Now();
   for (auto& property : m_properties) {
     if (property.update) {
-      property.update(property.entry, time);
+      auto value = property.update(time);
+      // Skip values that haven't changed, rather than setting them again
+      if (value && property.lastValue && *value == *property.lastValue) {
+        continue;
+      }
+      property.lastValue = value;
+      m_updateEntries.push_back(property.entry.GetHandle());
+      m_updateValues.push_back(std::move(value));
     }
   }
+  if (!m_updateEntries.empty()) {
+    nt::SetEntryValues(m_updateEntries, m_updateValues);
+  }
+  m_updateEntries.clear();
+  m_updateValues.clear();
   for (auto& updateTable : m_updateTables) {
     updateTable();
   }
@@ -102,9 +114,8 @@ void SendableBuilderImpl::AddBooleanProperty(std::string_view key,
                                              std::function<void(bool)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeBoolean(getter(), time));
+    m_properties.back().update = [=](uint64_t time) {
+      return nt::Value::MakeBoolean(getter(), time);
     };
   }
   if (setter) {
@@ -128,9 +139,8 @@ void SendableBuilderImpl::AddDoubleProperty(
     std::function<void(double)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeDouble(getter(), time));
+    m_properties.back().update = [=](uint64_t time) {
+      return nt::Value::MakeDouble(getter(), time);
     };
   }
   if (setter) {
@@ -154,9 +164,8 @@ void SendableBuilderImpl::AddStringProperty(
     std::function<void(std::string_view)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeString(getter(), time));
+    m_properties.back().update = [=](uint64_t time) {
+      return nt::Value::MakeString(getter(), time);
     };
   }
   if (setter) {
@@ -180,9 +189,8 @@ void SendableBuilderImpl::AddBooleanArrayProperty(
     std::function<void(wpi::span<const int>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeBooleanArray(getter(), time));
+    m_properties.back().update = [=](uint64_t time) {
+      return nt::Value::MakeBooleanArray(getter(), time);
     };
   }
   if (setter) {
@@ -206,9 +214,8 @@ void SendableBuilderImpl::AddDoubleArrayProperty(
     std::function<void(wpi::span<const double>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeDoubleArray(getter(), time));
+    m_properties.back().update = [=](uint64_t time) {
+      return nt::Value::MakeDoubleArray(getter(), time);
     };
   }
   if (setter) {
@@ -232,9 +239,8 @@ void SendableBuilderImpl::AddStringArrayProperty(
     std::function<void(wpi::span<const std::string>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeStringArray(getter(), time));
+    m_properties.back().update = [=](uint64_t time) {
+      return nt::Value::MakeStringArray(getter(), time);
     };
   }
   if (setter) {
@@ -258,9 +264,8 @@ void SendableBuilderImpl::AddRawProperty(
     std::function<void(std::string_view)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeRaw(getter(), time));
+    m_properties.back().update = [=](uint64_t time) {
+      return nt::Value::MakeRaw(getter(), time);
     };
   }
   if (setter) {
@@ -284,10 +289,7 @@ void SendableBuilderImpl::AddValueProperty(
     std::function<void(std::shared_ptr<nt::Value>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(getter());
-    };
+    m_properties.back().update = [=](uint64_t) { return getter(); };
   }
   if (setter) {
     m_properties.back().createListener =
@@ -307,10 +309,9 @@ void SendableBuilderImpl::AddSmallStringProperty(
     std::function<void(std::string_view)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
+    m_properties.back().update = [=](uint64_t time) {
       wpi::SmallString<128> buf;
-      entry.SetValue(nt::Value::MakeString(getter(buf), time));
+      return nt::Value::MakeString(getter(buf), time);
     };
   }
   if (setter) {
@@ -335,10 +336,9 @@ void SendableBuilderImpl::AddSmallBooleanArrayProperty(
     std::function<void(wpi::span<const int>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
+    m_properties.back().update = [=](uint64_t time) {
       wpi::SmallVector<int, 16> buf;
-      entry.SetValue(nt::Value::MakeBooleanArray(getter(buf), time));
+      return nt::Value::MakeBooleanArray(getter(buf), time);
     };
   }
   if (setter) {
@@ -364,10 +364,9 @@ void SendableBuilderImpl::AddSmallDoubleArrayProperty(
     std::function<void(wpi::span<const double>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
+    m_properties.back().update = [=](uint64_t time) {
       wpi::SmallVector<double, 16> buf;
-      entry.SetValue(nt::Value::MakeDoubleArray(getter(buf), time));
+      return nt::Value::MakeDoubleArray(getter(buf), time);
     };
   }
   if (setter) {
@@ -394,10 +393,9 @@ void SendableBuilderImpl::AddSmallStringArrayProperty(
     std::function<void(wpi::span<const std::string>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
+    m_properties.back().update = [=](uint64_t time) {
       wpi::SmallVector<std::string, 16> buf;
-      entry.SetValue(nt::Value::MakeStringArray(getter(buf), time));
+      return nt::Value::MakeStringArray(getter(buf), time);
     };
   }
   if (setter) {
@@ -422,10 +420,9 @@ void SendableBuilderImpl::AddSmallRawProperty(
     std::function<void(std::string_view)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
-    m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
+    m_properties.back().update = [=](uint64_t time) {
       wpi::SmallVector<char, 128> buf;
-      entry.SetValue(nt::Value::MakeRaw(getter(buf), time));
+      return nt::Value::MakeRaw(getter(buf), time);
     };
   }
   if (setter) {
@@ -4,6 +4,9 @@
 
 #include "frc/smartdashboard/SmartDashboard.h"
 
+#include <chrono>
+#include <iterator>
+
 #include <hal/FRCUsageReporting.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
@@ -12,6 +15,7 @@
 #include <wpi/sendable/SendableRegistry.h>
 
 #include "frc/Errors.h"
+#include "frc/Timer.h"
 #include "frc/smartdashboard/ListenerExecutor.h"
 #include "frc/smartdashboard/SendableBuilderImpl.h"
 
@@ -23,6 +27,17 @@ struct Instance {
   std::shared_ptr<nt::NetworkTable> table =
       nt::NetworkTableInstance::GetDefault().GetTable("SmartDashboard");
   wpi::StringMap<wpi::SendableRegistry::UID> tablesToData;
+  // Keys updated less often than every UpdateValues() call
+  struct UpdatePeriod {
+    units::second_t period;
+    units::second_t nextUpdateTime = 0_s;
+  };
+  wpi::StringMap<UpdatePeriod> updatePeriods;
+  // Budget for each UpdateValues() call; 0 for unlimited
+  int maxSendablesPerUpdate = 0;
+  units::second_t maxUpdateTime = 0_s;
+  // Where the next budgeted UpdateValues() call starts
+  size_t nextUpdateIndex = 0;
   wpi::mutex tablesToDataMutex;
 };
 }  // namespace
@@ -117,6 +132,25 @@ wpi::Sendable* SmartDashboard::GetData(std::string_view key) {
   return wpi::SendableRegistry::GetSendable(it->getValue());
 }
 
+void SmartDashboard::SetUpdatePeriod(std::string_view key,
+                                     units::second_t period) {
+  auto& inst = GetInstance();
+  std::scoped_lock lock(inst.tablesToDataMutex);
+  if (period <= 0_s) {
+    inst.updatePeriods.erase(key);
+  } else {
+    inst.updatePeriods[key].period = period;
+  }
+}
+
+void SmartDashboard::SetUpdateBudget(int maxSendables,
+                                     units::second_t maxTime) {
+  auto& inst = GetInstance();
+  std::scoped_lock lock(inst.tablesToDataMutex);
+  inst.maxSendablesPerUpdate = maxSendables;
+  inst.maxUpdateTime = maxTime;
+}
+
 bool SmartDashboard::PutBoolean(std::string_view keyName, bool value) {
   return GetInstance().table->GetEntry(keyName).SetBoolean(value);
 }
@@ -241,7 +275,55 @@ void SmartDashboard::UpdateValues() {
   auto& inst = GetInstance();
   inst.listenerExecutor.RunListenerTasks();
   std::scoped_lock lock(inst.tablesToDataMutex);
-  for (auto& i : inst.tablesToData) {
+  auto now = inst.updatePeriods.empty() ? 0_s : Timer::GetFPGATimestamp();
+  bool budgeted = inst.maxSendablesPerUpdate > 0 || inst.maxUpdateTime > 0_s;
+  auto start = std::chrono::steady_clock::now();
+  int updated = 0;
+
+  // Returns false once the budget is used up
+  auto update = [&](auto& i) {
+    if (!inst.updatePeriods.empty()) {
+      auto it = inst.updatePeriods.find(i.getKey());
+      if (it != inst.updatePeriods.end()) {
+        auto& updatePeriod = it->getValue();
+        if (now < updatePeriod.nextUpdateTime) {
+          return true;
+        }
+        updatePeriod.nextUpdateTime = now + updatePeriod.period;
+      }
+    }
     wpi::SendableRegistry::Update(i.getValue());
+    ++updated;
+    if (inst.maxSendablesPerUpdate > 0 &&
+        updated >= inst.maxSendablesPerUpdate) {
+      return false;
+    }
+    return inst.maxUpdateTime <= 0_s ||
+           std::chrono::steady_clock::now() - start <
+               std::chrono::duration<double>(inst.maxUpdateTime.to<double>());
+  };
+
+  if (!budgeted) {
+    for (auto& i : inst.tablesToData) {
+      update(i);
+    }
+    return;
+  }
+
+  // Resume where the last call ran out of budget, wrapping around once
+  size_t size = inst.tablesToData.size();
+  size_t first = inst.nextUpdateIndex < size ? inst.nextUpdateIndex : 0;
+  size_t index = 0;
+  auto it = inst.tablesToData.begin();
+  std::advance(it, first);
+  for (index = first; index < first + size; ++index, ++it) {
+    if (index == size) {
+      it = inst.tablesToData.begin();
+    }
+    if (!update(*it)) {
+      ++index;
+      break;
+    }
   }
+  inst.nextUpdateIndex = index % (size == 0 ? 1 : size);
 }
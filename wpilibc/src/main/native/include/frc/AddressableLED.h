@@ -5,6 +5,7 @@
 #pragma once
 
 #include <initializer_list>
+#include <vector>
 
 #include <hal/AddressableLEDTypes.h>
 #include <hal/Types.h>
@@ -105,6 +106,9 @@ class AddressableLED {
    * <p>If the output is enabled, this will start writing the next data cycle.
    * It is safe to call, even while output is enabled.
    *
+   * <p>Only the LEDs that changed since the last call are copied to the
+   * driver, so animations that change a few LEDs at a time are cheap.
+   *
    * @param ledData the buffer to write
    */
   void SetData(wpi::span<const LEDData> ledData);
@@ -160,5 +164,7 @@ class AddressableLED {
   hal::Handle<HAL_DigitalHandle> m_pwmHandle;
   hal::Handle<HAL_AddressableLEDHandle> m_handle;
   int m_port;
+  // The data last written to the driver
+  std::vector<LEDData> m_written;
 };
 }  // namespace frc
@@ -32,6 +32,7 @@ class AnalogInput : public wpi::Sendable,
   friend class AnalogTrigger;
   friend class AnalogGyro;
   friend class DMA;
+  friend class DMABatch;
   friend class DMASample;
 
  public:
@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include <hal/CANAPITypes.h>
+#include <wpi/span.h>
 
 namespace frc {
 struct CANData {
@@ -15,6 +16,22 @@ struct CANData {
   uint64_t timestamp;
 };
 
+class CAN;
+
+/**
+ * A packet to write with CAN::WritePackets().
+ */
+struct CANPacket {
+  /** The device to write to */
+  const CAN* device;
+  /** The API ID to write */
+  int apiId;
+  /** The data to write */
+  uint8_t data[8];
+  /** The data length to write */
+  int length;
+};
+
 /**
  * High level class for interfacing with CAN devices conforming to
  * the standard CAN spec.
@@ -119,6 +136,27 @@ class CAN {
    */
   int WriteRTRFrameNoError(int length, int apiId);
 
+  /**
+   * Write packets to any number of CAN devices in one HAL call, for example
+   * the control frames of every swerve module. The packets are sent back to
+   * back, so the devices receive them closer together than with a
+   * WritePacket() call each.
+   *
+   * Every packet is attempted even if an earlier one fails; the first failure
+   * is reported.
+   *
+   * @param packets The packets to write.
+   */
+  static void WritePackets(wpi::span<const CANPacket> packets);
+
+  /**
+   * Write packets to any number of CAN devices in one HAL call.
+   *
+   * @param packets The packets to write.
+   * @return The error of the first packet that failed, or 0.
+   */
+  static int WritePacketsNoError(wpi::span<const CANPacket> packets);
+
   /**
    * Stop a repeating packet with a specific ID. This ID is 10 bits.
    *
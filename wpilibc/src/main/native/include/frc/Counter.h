@@ -34,6 +34,7 @@ class Counter : public CounterBase,
                 public wpi::Sendable,
                 public wpi::SendableHelper<Counter> {
   friend class DMA;
+  friend class DMABatch;
   friend class DMASample;
 
  public:
@@ -18,6 +18,7 @@ class PWM;
 class PWMMotorController;
 
 class DMA {
+  friend class DMABatch;
   friend class DMASample;
 
  public:
@@ -0,0 +1,138 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <hal/DMA.h>
+#include <hal/Types.h>
+#include <units/time.h>
+#include <wpi/span.h>
+
+namespace frc {
+class AnalogInput;
+class Counter;
+class DMA;
+class Encoder;
+
+/**
+ * Reads every available DMA sample at once and decodes them into
+ * caller-provided arrays, one per channel.
+ *
+ * Each registered channel is decoded in its own pass over the batch, with its
+ * handle and scaling looked up once when it is added rather than per sample,
+ * so high-rate pipelines can process the results with simple loops.
+ *
+ * The batch size is the length of the shortest registered array.
+ */
+class DMABatch {
+ public:
+  /**
+   * Constructs a batch reader for a DMA object.
+   *
+   * @param dma The DMA object to read samples from. Must outlive this.
+   */
+  explicit DMABatch(const DMA& dma);
+
+  DMABatch(DMABatch&&) = default;
+  DMABatch& operator=(DMABatch&&) = default;
+
+  /**
+   * Sets the array to decode sample timestamps into, in FPGA microseconds.
+   *
+   * @param timestamps Timestamp of each sample.
+   */
+  void SetTimestamps(wpi::span<uint64_t> timestamps);
+
+  /**
+   * Adds an encoder to decode raw counts for. The encoder must have been
+   * added to the DMA object.
+   *
+   * @param encoder The encoder.
+   * @param counts  Raw count of each sample.
+   */
+  void AddEncoder(const Encoder* encoder, wpi::span<int32_t> counts);
+
+  /**
+   * Adds an encoder to decode distances for. The encoder must have been added
+   * to the DMA object. Its distance per pulse is read when it is added.
+   *
+   * @param encoder   The encoder.
+   * @param distances Distance of each sample.
+   */
+  void AddEncoderDistance(const Encoder* encoder, wpi::span<double> distances);
+
+  /**
+   * Adds a counter to decode counts for. The counter must have been added to
+   * the DMA object.
+   *
+   * @param counter The counter.
+   * @param counts  Count of each sample.
+   */
+  void AddCounter(const Counter* counter, wpi::span<int32_t> counts);
+
+  /**
+   * Adds an analog input to decode voltages for. The analog input must have
+   * been added to the DMA object.
+   *
+   * @param analogInput The analog input.
+   * @param voltages    Voltage of each sample.
+   */
+  void AddAnalogInputVoltage(const AnalogInput* analogInput,
+                             wpi::span<double> voltages);
+
+  /**
+   * Removes all of the registered arrays.
+   */
+  void Clear();
+
+  /**
+   * Gets the most samples a Read() can return.
+   *
+   * @return The length of the shortest registered array.
+   */
+  size_t GetCapacity() const { return m_capacity; }
+
+  /**
+   * Reads the samples queued up to the capacity and decodes them.
+   *
+   * @param timeout   How long to wait for the first sample.
+   * @param remaining Set to the number of samples left in the queue.
+   * @param status    Set to the first error reading or decoding samples.
+   * @return The number of samples decoded into each array.
+   */
+  size_t Read(units::second_t timeout, int32_t* remaining, int32_t* status);
+
+ private:
+  void UpdateCapacity(size_t size);
+
+  template <typename T>
+  struct Channel {
+    HAL_Handle handle;
+    wpi::span<T> out;
+  };
+
+  struct ScaledChannel : public Channel<double> {
+    double scale;
+  };
+
+  struct AnalogChannel : public Channel<double> {
+    double lsbWeight;
+    double offset;
+  };
+
+  HAL_DMAHandle m_dma;
+  size_t m_capacity = 0;
+  bool m_hasChannel = false;
+  wpi::span<uint64_t> m_timestamps;
+  std::vector<Channel<int32_t>> m_encoders;
+  std::vector<ScaledChannel> m_encoderDistances;
+  std::vector<Channel<int32_t>> m_counters;
+  std::vector<AnalogChannel> m_analogInputs;
+  std::vector<HAL_DMASample> m_samples;
+};
+}  // namespace frc
@@ -0,0 +1,86 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace wpi::log {
+class DataLog;
+}  // namespace wpi::log
+
+namespace frc {
+
+/**
+ * Manages the robot's data log file: a wpi::log::DataLog for high-rate
+ * typed time series, written in the background with negligible cost to the
+ * robot loop.
+ *
+ * The log is kept in the "logs" directory of a USB stick if one is plugged
+ * into the roboRIO, otherwise in /home/lvuser/logs (in simulation, the logs
+ * directory under the directory the program was launched from).  By
+ * default, every NetworkTables value change is logged as well, as entries
+ * named "NT:" followed by the NetworkTables key.
+ *
+ * Robot code logs its own entries through GetLog(), e.g.
+ * @code{.cpp}
+ * wpi::log::DoubleLogEntry voltage{frc::DataLogManager::GetLog(), "voltage"};
+ * voltage.Append(frc::RobotController::GetBatteryVoltage().value());
+ * @endcode
+ */
+class DataLogManager final {
+ public:
+  DataLogManager() = delete;
+
+  /**
+   * Starts the data log.  Does nothing if it is already started.
+   *
+   * @param dir      directory to put the log file in; empty for the default
+   *                 described above
+   * @param filename log file name; empty for FRC_yyyyMMdd_HHmmss.wpilog
+   *                 (local time)
+   * @param period   time between writes to the file, in seconds
+   */
+  static void Start(std::string_view dir = "", std::string_view filename = "",
+                    double period = 0.25);
+
+  /**
+   * Stops the data log, writing out anything buffered and closing the file.
+   */
+  static void Stop();
+
+  /**
+   * Logs a message to the "messages" entry, and prints it to the console.
+   * The message is not logged if the data log has not been started.
+   *
+   * @param message message
+   */
+  static void Log(std::string_view message);
+
+  /**
+   * Gets the data log, starting it with the default settings if it has not
+   * been started.
+   *
+   * @return data log
+   */
+  static wpi::log::DataLog& GetLog();
+
+  /**
+   * Gets the directory the log file is in.
+   *
+   * @return log directory, or empty if the data log has not been started
+   */
+  static std::string GetLogDir();
+
+  /**
+   * Enables or disables logging NetworkTables value changes.  Enabled by
+   * default.
+   *
+   * @param enabled true to log NetworkTables
+   */
+  static void LogNetworkTables(bool enabled);
+};
+
+}  // namespace frc
@@ -0,0 +1,107 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <units/time.h>
+#include <wpi/circular_buffer.h>
+#include <wpi/mutex.h>
+#include <wpi/span.h>
+
+namespace frc {
+
+/**
+ * Estimates velocity from timestamped sensor edges with a least-squares fit
+ * of position against time over a sliding window of the most recent edges.
+ *
+ * Unlike Encoder::GetRate(), which averages the periods between the last few
+ * edges, the fit uses where each edge was and when it happened, so it stays
+ * smooth at low speeds and follows changes in speed at high ones without
+ * another filter on top.
+ *
+ * Edges are FPGA timestamps (in microseconds) paired with positions. They can
+ * come from a DMABatch (for Encoder and Counter, with a timed or external
+ * trigger), from an AsynchronousInterrupt callback, or from polling a
+ * DutyCycleEncoder with HAL_GetFPGATime(). Samples at the same position as
+ * the previous one aren't edges and are ignored, so sampling faster than the
+ * edges arrive is harmless.
+ *
+ * Edges may be added from a different thread than the velocity is read on.
+ */
+class EdgeVelocityEstimator {
+ public:
+  /**
+   * Constructs an estimator.
+   *
+   * @param windowSize The number of edges to fit over. More edges are
+   *                   smoother; fewer respond faster.
+   * @param maxAge     How long without an edge before the sensor is
+   *                   considered stopped. Edges older than this relative to
+   *                   the newest one are also left out of the fit.
+   */
+  explicit EdgeVelocityEstimator(size_t windowSize = 8,
+                                 units::second_t maxAge = 100_ms);
+
+  /**
+   * Adds an edge.
+   *
+   * @param timestamp The FPGA time of the edge, in microseconds.
+   * @param position  The position after the edge.
+   */
+  void AddEdge(uint64_t timestamp, double position);
+
+  /**
+   * Adds a batch of edges, as decoded by DMABatch.
+   *
+   * @param timestamps The FPGA time of each edge, in microseconds.
+   * @param positions  The position after each edge.
+   */
+  void AddEdges(wpi::span<const uint64_t> timestamps,
+                wpi::span<const double> positions);
+
+  /**
+   * Adds a batch of edges with raw counts, as decoded by DMABatch.
+   *
+   * @param timestamps The FPGA time of each edge, in microseconds.
+   * @param counts     The count after each edge.
+   */
+  void AddEdges(wpi::span<const uint64_t> timestamps,
+                wpi::span<const int32_t> counts);
+
+  /**
+   * Gets the velocity as of the current FPGA time.
+   *
+   * @return The velocity in position units per second; 0 if stopped.
+   */
+  double GetVelocity() const;
+
+  /**
+   * Gets the velocity as of a given time.
+   *
+   * @param now The FPGA time in microseconds.
+   * @return The velocity in position units per second; 0 if stopped.
+   */
+  double GetVelocity(uint64_t now) const;
+
+  /**
+   * Forgets all of the edges.
+   */
+  void Reset();
+
+ private:
+  void AddEdgeLocked(uint64_t timestamp, double position);
+
+  struct Edge {
+    uint64_t timestamp;
+    double position;
+  };
+
+  mutable wpi::mutex m_mutex;
+  wpi::circular_buffer<Edge> m_edges;
+  uint64_t m_maxAge;
+};
+
+}  // namespace frc
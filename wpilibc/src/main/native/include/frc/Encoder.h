@@ -39,6 +39,7 @@ class Encoder : public CounterBase,
                 public wpi::Sendable,
                 public wpi::SendableHelper<Encoder> {
   friend class DMA;
+  friend class DMABatch;
   friend class DMASample;
 
  public:
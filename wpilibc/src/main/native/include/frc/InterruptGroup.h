@@ -0,0 +1,89 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <hal/Interrupts.h>
+#include <hal/Types.h>
+#include <units/time.h>
+#include <wpi/span.h>
+
+namespace frc {
+class DigitalSource;
+
+/**
+ * Class for handling interrupts from several digital sources at once.
+ *
+ * <p>A single HAL thread waits on all of the sources and queues their edges,
+ * with timestamps, in the order they happened. This is cheaper than a
+ * SynchronousInterrupt or AsynchronousInterrupt per source, and edges that
+ * happen while no one is reading are queued rather than lost.
+ *
+ * <p>Edges that happen while the queue is full are dropped; see
+ * GetDroppedCount().
+ */
+class InterruptGroup {
+ public:
+  /**
+   * An edge seen by the group.
+   */
+  struct Event {
+    /** The index of the source in the span passed to the constructor */
+    int source;
+    /** True for a rising edge, false for a falling edge */
+    bool rising;
+    /** The time of the edge, relative to FPGA time */
+    units::second_t timestamp;
+  };
+
+  /**
+   * Construct an Interrupt Group from Digital Sources.
+   *
+   * <p>The sources must outlive the group.
+   *
+   * @param sources the sources to watch
+   * @param risingEdge true to queue rising edges
+   * @param fallingEdge true to queue falling edges
+   * @param queueDepth the number of edges to queue
+   */
+  explicit InterruptGroup(wpi::span<DigitalSource* const> sources,
+                          bool risingEdge = true, bool fallingEdge = false,
+                          int queueDepth = 1024);
+
+  ~InterruptGroup();
+
+  InterruptGroup(InterruptGroup&&) = default;
+  InterruptGroup& operator=(InterruptGroup&&) = default;
+
+  /**
+   * Read the queued edges, oldest first, waiting for the first one if none
+   * are queued. Only one thread should read at a time.
+   *
+   * @param events the buffer to read the edges into
+   * @param timeout The timeout to wait for. 0s or less will return
+   * immediately.
+   * @return The number of edges read; 0 on timeout or wakeup.
+   */
+  int ReadEvents(wpi::span<Event> events, units::second_t timeout);
+
+  /**
+   * Wake up an existing ReadEvents() call. Can be called from any thread.
+   */
+  void WakeupWaitingRead();
+
+  /**
+   * Get the number of edges dropped because the queue was full.
+   */
+  int64_t GetDroppedCount() const;
+
+ private:
+  std::vector<hal::Handle<HAL_InterruptHandle>> m_interrupts;
+  hal::Handle<HAL_InterruptGroupHandle> m_handle;
+  std::vector<HAL_InterruptEvent> m_buffer;
+};
+}  // namespace frc
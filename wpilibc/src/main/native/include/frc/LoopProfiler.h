@@ -0,0 +1,125 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <string_view>
+
+#include <hal/cpp/fpga_clock.h>
+
+namespace wpi {
+class raw_ostream;
+}  // namespace wpi
+
+namespace frc {
+
+/**
+ * Records how long each phase of the robot loop takes.
+ *
+ * When enabled, IterativeRobotBase records each of the robot's periodic
+ * functions, the dashboard updates and the simulation periodic functions, and
+ * the command scheduler records each subsystem and command. The most recent
+ * phases are kept in a ring buffer that can be written out as a Chrome trace
+ * (viewable in chrome://tracing or Perfetto), and the last and maximum time of
+ * each phase are published to the "LoopProfiler" NetworkTables table.
+ *
+ * Phases are meant to be recorded from the main robot thread.
+ */
+class LoopProfiler {
+ public:
+  LoopProfiler() = delete;
+
+  /**
+   * Times a phase from construction to destruction. Nested scopes show up as
+   * nested phases in the trace.
+   */
+  class Scope {
+   public:
+    /**
+     * Starts timing a phase, if the profiler is enabled.
+     *
+     * @param name The name of the phase.
+     */
+    explicit Scope(std::string_view name);
+
+    /**
+     * Starts timing a phase, if the profiler is enabled.
+     *
+     * @param phaseId The ID returned by RegisterPhase().
+     */
+    explicit Scope(int phaseId);
+
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    int m_phaseId;
+    hal::fpga_clock::time_point m_start;
+  };
+
+  /**
+   * Enables or disables recording. Recording is disabled by default.
+   *
+   * @param enabled True to record phases.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Returns true if phases are being recorded.
+   */
+  static bool IsEnabled();
+
+  /**
+   * Sets how many of the most recent phases are kept for the trace. This
+   * clears the phases recorded so far. The default is 8192.
+   *
+   * @param numPhases The number of phases to keep.
+   */
+  static void SetCapacity(size_t numPhases);
+
+  /**
+   * Registers a phase name, or gets the ID of an already registered one.
+   *
+   * @param name The name of the phase.
+   * @return The phase ID.
+   */
+  static int RegisterPhase(std::string_view name);
+
+  /**
+   * Records a phase, if the profiler is enabled.
+   *
+   * @param phaseId The ID returned by RegisterPhase().
+   * @param start The time the phase started.
+   * @param end The time the phase ended.
+   */
+  static void RecordPhase(int phaseId, hal::fpga_clock::time_point start,
+                          hal::fpga_clock::time_point end);
+
+  /**
+   * Publishes the phase times to NetworkTables. This is called at the end of
+   * each robot loop, and publishes at most every 100 ms.
+   */
+  static void Publish();
+
+  /**
+   * Writes the recorded phases as a Chrome trace JSON document.
+   *
+   * @param os The stream to write to.
+   */
+  static void WriteChromeTrace(wpi::raw_ostream& os);
+
+  /**
+   * Writes the recorded phases as a Chrome trace JSON file.
+   *
+   * @param filename The file to write.
+   * @return True if the file was written.
+   */
+  static bool WriteChromeTrace(std::string_view filename);
+};
+
+}  // namespace frc
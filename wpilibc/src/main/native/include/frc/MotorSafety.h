@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 #include <string>
 
 #include <units/time.h>
@@ -86,7 +88,9 @@ class MotorSafety {
    * Check the motors to see if any have timed out.
    *
    * This static method is called periodically to poll all the motors and stop
-   * any that have timed out.
+   * any that have timed out.  The motors' stop times are kept in a packed
+   * array, so all of them are checked against a single timestamp without
+   * locking any of the motors.
    */
   static void CheckMotors();
 
@@ -96,6 +100,15 @@ class MotorSafety {
  private:
   static constexpr auto kDefaultSafetyExpiration = 100_ms;
 
+  // Publishes the stop time CheckMotors() checks; must hold m_thisMutex
+  void UpdateSlot();
+
+  // Stops the motor if it is still expired at the given time
+  void CheckExpired(units::second_t now);
+
+  // This object's index in the array of stop times
+  size_t m_slot;
+
   // The expiration time for this object
   units::second_t m_expiration = kDefaultSafetyExpiration;
 
@@ -6,16 +6,15 @@
 
 #include <stdint.h>
 
-#include <atomic>
 #include <functional>
+#include <memory>
 #include <string_view>
-#include <thread>
 #include <type_traits>
 #include <utility>
 
-#include <hal/Types.h>
 #include <units/time.h>
-#include <wpi/mutex.h>
+
+#include "frc/NotifierExecutor.h"
 
 namespace frc {
 
@@ -57,6 +56,17 @@ class Notifier {
                  std::bind(std::forward<Callable>(f), std::forward<Arg>(arg),
                            std::forward<Args>(args)...)) {}
 
+  /**
+   * Create a Notifier for timer event notification, whose handler is called on
+   * the thread of a shared executor instead of a thread of its own.
+   *
+   * @param executor The executor to call the handler on.  It must outlive the
+   *                 Notifier.
+   * @param handler  The handler is called at the notification time which is set
+   *                 using StartSingle or StartPeriodic.
+   */
+  Notifier(NotifierExecutor& executor, std::function<void()> handler);
+
   /**
    * Free the resources for a timer event.
    */
@@ -79,6 +89,25 @@ class Notifier {
    */
   void SetHandler(std::function<void()> handler);
 
+  /**
+   * Reports calls of the handler that take longer than a budget.  This is
+   * mostly useful for Notifiers on a shared executor, where a slow handler
+   * delays the others.  Overruns are counted, and reported at most once a
+   * second.
+   *
+   * @param budget The longest a call of the handler should take, or 0 to
+   *               disable overrun detection.
+   */
+  void SetOverrunBudget(units::second_t budget);
+
+  /**
+   * Returns the number of calls of the handler that took longer than the
+   * overrun budget.
+   *
+   * @return The number of overruns.
+   */
+  int GetOverrunCount() const;
+
   /**
    * Register for single event notification.
    *
@@ -129,38 +158,16 @@ class Notifier {
   static bool SetHALThreadPriority(bool realTime, int32_t priority);
 
  private:
-  /**
-   * Update the HAL alarm time.
-   *
-   * @param triggerTime the time at which the next alarm will be triggered
-   */
-  void UpdateAlarm(uint64_t triggerTime);
-
-  /**
-   * Update the HAL alarm time based on m_expirationTime.
-   */
-  void UpdateAlarm();
-
-  // The thread waiting on the HAL alarm
-  std::thread m_thread;
-
-  // Held while updating process information
-  wpi::mutex m_processMutex;
-
-  // HAL handle, atomic for proper destruction
-  std::atomic<HAL_NotifierHandle> m_notifier{0};
-
-  // Address of the handler
-  std::function<void()> m_handler;
+  Notifier(std::unique_ptr<NotifierExecutor> ownExecutor,
+           NotifierExecutor* executor, std::function<void()> handler);
 
-  // The absolute expiration time
-  units::second_t m_expirationTime = 0_s;
+  // The executor running only this Notifier, if it wasn't given one
+  std::unique_ptr<NotifierExecutor> m_ownExecutor;
 
-  // The relative time (either periodic or single)
-  units::second_t m_period = 0_s;
+  NotifierExecutor* m_executor;
 
-  // True if this is a periodic event
-  bool m_periodic = false;
+  // The state of this Notifier, guarded by the executor's mutex
+  std::unique_ptr<NotifierExecutor::Entry> m_entry;
 };
 
 }  // namespace frc
@@ -0,0 +1,125 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <hal/Types.h>
+#include <units/time.h>
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+#include <wpi/priority_queue.h>
+
+namespace frc {
+
+class Notifier;
+
+/**
+ * Runs the handlers of many Notifiers on a single thread, waiting on a single
+ * HAL notifier alarm set to the earliest expiration time of the Notifiers.
+ *
+ * Notifiers created with an executor don't have their own thread, so a
+ * handler that runs long delays the handlers of the other Notifiers on the
+ * executor; Notifier::SetOverrunBudget() can be used to detect that.
+ *
+ * The executor must outlive the Notifiers created with it.
+ */
+class NotifierExecutor {
+ public:
+  /**
+   * Create an executor running on a thread with the default priority.
+   */
+  NotifierExecutor();
+
+  /**
+   * Create an executor running on a thread with a real-time priority.
+   *
+   * @param priority The FIFO real-time scheduler priority ([1..99] where a
+   *                 higher number represents higher priority). See "man 7
+   *                 sched" for more details.
+   */
+  explicit NotifierExecutor(int priority);
+
+  ~NotifierExecutor();
+
+  NotifierExecutor(const NotifierExecutor&) = delete;
+  NotifierExecutor& operator=(const NotifierExecutor&) = delete;
+
+  /**
+   * Sets the name of the executor's HAL notifier.  Used for debugging purposes
+   * only.
+   *
+   * @param name Name
+   */
+  void SetName(std::string_view name);
+
+ private:
+  friend class Notifier;
+
+  // The state of a Notifier, guarded by m_mutex
+  struct Entry {
+    std::function<void()> handler;
+
+    // The absolute expiration time
+    units::second_t expirationTime = 0_s;
+
+    // The relative time (either periodic or single)
+    units::second_t period = 0_s;
+
+    // True if this is a periodic event
+    bool periodic = false;
+
+    // Handler calls longer than this are reported; 0 to disable
+    units::second_t overrunBudget = 0_s;
+    units::second_t lastOverrunPrintTime = 0_s;
+    int overrunCount = 0;
+
+    std::string name;
+
+    bool operator>(const Entry& rhs) const {
+      return expirationTime > rhs.expirationTime;
+    }
+  };
+
+  template <typename T>
+  struct DerefGreater {
+    constexpr bool operator()(const T& lhs, const T& rhs) const {
+      return *lhs > *rhs;
+    }
+  };
+
+  void Start(bool realTime, int priority);
+  void Main(bool realTime, int priority);
+
+  // Queues the entry at its expiration time; must hold m_mutex
+  void Schedule(Entry* entry);
+
+  // Removes the entry from the queue; must hold m_mutex
+  void Unschedule(Entry* entry);
+
+  // Unschedules the entry and waits for a call of its handler in progress to
+  // return, unless called from the handler; must hold m_mutex
+  void Remove(Entry* entry, std::unique_lock<wpi::mutex>& lock);
+
+  // Must hold m_mutex
+  void UpdateAlarm();
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_handlerDone;
+  std::atomic<HAL_NotifierHandle> m_notifier{0};
+  wpi::priority_queue<Entry*, std::vector<Entry*>, DerefGreater<Entry*>>
+      m_entries;
+  // The entry whose handler is being called
+  Entry* m_runningEntry = nullptr;
+  std::thread m_thread;
+};
+
+}  // namespace frc
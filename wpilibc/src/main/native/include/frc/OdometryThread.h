@@ -0,0 +1,152 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+
+#include <units/time.h>
+#include <wpi/mutex.h>
+
+#include "frc/Notifier.h"
+#include "frc/geometry/Pose2d.h"
+
+namespace frc {
+
+class DMA;
+class DMASample;
+
+/**
+ * Updates odometry or a pose estimator on a real-time thread at a higher rate
+ * than the robot loop.
+ *
+ * The update function reads the sensors and updates the odometry with the
+ * FPGA timestamp it's given (e.g. with a pose estimator's UpdateWithTime()),
+ * returning the new pose. The robot loop reads the latest pose with
+ * GetLatest() or GetPose(), which never wait on the odometry thread.
+ *
+ * With a DMA, the sensors are sampled by the FPGA instead: the thread wakes
+ * periodically and passes each DMA sample taken since to the update function,
+ * so the odometry is updated at the DMA's trigger rate with the time each
+ * sample was taken.
+ *
+ * While the thread is running, the odometry must only be used from the update
+ * function. To reset it, Stop() the thread, reset the odometry, and Start()
+ * the thread again.
+ */
+class OdometryThread {
+ public:
+  /**
+   * Reads the sensors and updates the odometry with the given FPGA timestamp,
+   * returning the new pose.
+   */
+  using UpdateFunc = std::function<Pose2d(units::second_t timestamp)>;
+
+  /**
+   * Updates the odometry from a DMA sample, using its timestamp and sensor
+   * values, and returns the new pose.
+   */
+  using DMAUpdateFunc = std::function<Pose2d(const DMASample& sample)>;
+
+  /**
+   * The latest pose.
+   */
+  struct Sample {
+    /** The pose. */
+    Pose2d pose;
+
+    /** The FPGA timestamp of the pose. */
+    units::second_t timestamp = 0_s;
+  };
+
+  /**
+   * Creates an odometry thread that reads the sensors itself.
+   *
+   * @param update   The update function.
+   * @param period   The period at which to update.
+   * @param priority The FIFO real-time scheduler priority of the thread.
+   */
+  explicit OdometryThread(UpdateFunc update, units::second_t period = 4_ms,
+                          int priority = kDefaultPriority);
+
+  /**
+   * Creates an odometry thread that updates from DMA samples. The DMA must
+   * already have the sensors added and a trigger set (e.g. with
+   * SetTimedTrigger()), and be started with a queue deep enough to hold the
+   * samples taken in one period. It must outlive this object.
+   *
+   * @param dma      The DMA.
+   * @param update   The update function.
+   * @param period   The period at which to read samples.
+   * @param priority The FIFO real-time scheduler priority of the thread.
+   */
+  OdometryThread(DMA& dma, DMAUpdateFunc update,
+                 units::second_t period = 10_ms,
+                 int priority = kDefaultPriority);
+
+  ~OdometryThread();
+
+  OdometryThread(const OdometryThread&) = delete;
+  OdometryThread& operator=(const OdometryThread&) = delete;
+
+  /**
+   * Starts updating.
+   */
+  void Start();
+
+  /**
+   * Stops updating. Waits for an update in progress to finish, so the
+   * odometry may be used once this returns.
+   */
+  void Stop();
+
+  /**
+   * Gets the latest pose and its timestamp.
+   */
+  Sample GetLatest() const;
+
+  /**
+   * Gets the latest pose.
+   */
+  Pose2d GetPose() const { return GetLatest().pose; }
+
+  /**
+   * Gets the number of updates made.
+   */
+  uint64_t GetUpdateCount() const {
+    return m_updateCount.load(std::memory_order_relaxed);
+  }
+
+  /** The default scheduler priority, below the HAL's own threads. */
+  static constexpr int kDefaultPriority = 30;
+
+ private:
+  void Update();
+  void UpdateFromDMA();
+  void Publish(const Pose2d& pose, units::second_t timestamp);
+
+  UpdateFunc m_update;
+  DMA* m_dma = nullptr;
+  DMAUpdateFunc m_dmaUpdate;
+  units::second_t m_period;
+
+  // held by the thread while updating, so Stop() can wait for it
+  wpi::mutex m_updateMutex;
+
+  // the latest pose, published with a sequence lock (odd while being written)
+  std::atomic<uint32_t> m_seq{0};
+  std::atomic<double> m_x{0.0};
+  std::atomic<double> m_y{0.0};
+  std::atomic<double> m_theta{0.0};
+  std::atomic<double> m_timestamp{0.0};
+  std::atomic<uint64_t> m_updateCount{0};
+
+  // last, so it stops before the rest is destroyed
+  Notifier m_notifier;
+};
+
+}  // namespace frc
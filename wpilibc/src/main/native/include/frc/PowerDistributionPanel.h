@@ -97,6 +97,8 @@ class PowerDistributionPanel
   void InitSendable(wpi::SendableBuilder& builder) override;
 
  private:
+  friend class RobotController;
+
   hal::Handle<HAL_PDPHandle> m_handle;
   int m_module;
 };
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -14,6 +15,15 @@
 
 namespace frc {
 
+namespace detail {
+// The local copy of a preference read through a handle
+struct PreferenceValue {
+  std::atomic<int> type{0};  // NT_Type, or NT_UNASSIGNED if there is none
+  std::atomic<double> number{0};
+  std::atomic<bool> boolean{false};
+};
+}  // namespace detail
+
 /**
  * The preferences class provides a relatively simple way to save important
  * values to the roboRIO to access the next time the roboRIO is booted.
@@ -30,6 +40,96 @@ namespace frc {
  */
 class Preferences {
  public:
+  /**
+   * A handle to a double preference. Reading it only reads a local copy,
+   * which is kept up to date as the preference changes.
+   */
+  class Double {
+   public:
+    /**
+     * Returns the value of the preference, or the default value if the
+     * preference doesn't exist or isn't a number.
+     */
+    double Get() const {
+      if (m_value->type.load(std::memory_order_acquire) != kNumberType) {
+        return m_defaultValue;
+      }
+      return m_value->number.load(std::memory_order_relaxed);
+    }
+
+   private:
+    friend class Preferences;
+    Double(const detail::PreferenceValue* value, double defaultValue)
+        : m_value{value}, m_defaultValue{defaultValue} {}
+
+    const detail::PreferenceValue* m_value;
+    double m_defaultValue;
+  };
+
+  /**
+   * A handle to an int preference. Reading it only reads a local copy, which
+   * is kept up to date as the preference changes.
+   */
+  class Int {
+   public:
+    /**
+     * Returns the value of the preference, or the default value if the
+     * preference doesn't exist or isn't a number.
+     */
+    int Get() const { return static_cast<int>(m_value.Get()); }
+
+   private:
+    friend class Preferences;
+    explicit Int(Double value) : m_value{value} {}
+
+    Double m_value;
+  };
+
+  /**
+   * A handle to a long preference. Reading it only reads a local copy, which
+   * is kept up to date as the preference changes.
+   */
+  class Long {
+   public:
+    /**
+     * Returns the value of the preference, or the default value if the
+     * preference doesn't exist or isn't a number.
+     */
+    int64_t Get() const { return static_cast<int64_t>(m_value.Get()); }
+
+   private:
+    friend class Preferences;
+    explicit Long(Double value) : m_value{value} {}
+
+    Double m_value;
+  };
+
+  /**
+   * A handle to a boolean preference. Reading it only reads a local copy,
+   * which is kept up to date as the preference changes.
+   */
+  class Boolean {
+   public:
+    /**
+     * Returns the value of the preference, or the default value if the
+     * preference doesn't exist or isn't a boolean.
+     */
+    bool Get() const {
+      if (m_value->type.load(std::memory_order_acquire) != kBooleanType) {
+        return m_defaultValue;
+      }
+      return m_value->boolean.load(std::memory_order_relaxed);
+    }
+
+   private:
+    friend class Preferences;
+    Boolean(const detail::PreferenceValue* value, bool defaultValue)
+        : m_value{value}, m_defaultValue{defaultValue} {}
+
+    const detail::PreferenceValue* m_value;
+    bool m_defaultValue;
+  };
+
   /**
    * Get the one and only {@link Preferences} object.
    *
@@ -108,6 +208,49 @@ class Preferences {
    */
   static int64_t GetLong(std::string_view key, int64_t defaultValue = 0);
 
+  /**
+   * Returns a handle to the double at the given key. Reading the handle is
+   * much cheaper than calling GetDouble(), so it is well suited to reading
+   * the preference in periodic code. Get the handle once and keep it.
+   *
+   * @param key          the key
+   * @param defaultValue the value the handle reads if none exists in the table
+   * @return the handle
+   */
+  static Double GetDoubleHandle(std::string_view key,
+                                double defaultValue = 0.0);
+
+  /**
+   * Returns a handle to the int at the given key. Reading the handle is much
+   * cheaper than calling GetInt().
+   *
+   * @param key          the key
+   * @param defaultValue the value the handle reads if none exists in the table
+   * @return the handle
+   */
+  static Int GetIntHandle(std::string_view key, int defaultValue = 0);
+
+  /**
+   * Returns a handle to the long at the given key. Reading the handle is much
+   * cheaper than calling GetLong().
+   *
+   * @param key          the key
+   * @param defaultValue the value the handle reads if none exists in the table
+   * @return the handle
+   */
+  static Long GetLongHandle(std::string_view key, int64_t defaultValue = 0);
+
+  /**
+   * Returns a handle to the boolean at the given key. Reading the handle is
+   * much cheaper than calling GetBoolean().
+   *
+   * @param key          the key
+   * @param defaultValue the value the handle reads if none exists in the table
+   * @return the handle
+   */
+  static Boolean GetBooleanHandle(std::string_view key,
+                                  bool defaultValue = false);
+
   /**
    * Puts the given string into the preferences table.
    *
@@ -293,6 +436,12 @@ class Preferences {
   static void RemoveAll();
 
  private:
+  // Values of NT_Type, which isn't included here
+  static constexpr int kBooleanType = 0x01;
+  static constexpr int kNumberType = 0x02;
+
+  static const detail::PreferenceValue* GetCachedValue(std::string_view key);
+
   Preferences() = default;
 };
 
@@ -6,10 +6,13 @@
 
 #include <stdint.h>
 
+#include <units/time.h>
 #include <units/voltage.h>
 
 namespace frc {
 
+class PowerDistributionPanel;
+
 struct CANStatus {
   float percentBusUtilization;
   int busOffCount;
@@ -189,6 +192,36 @@ class RobotController {
   static int GetFaultCount6V();
 
   static CANStatus GetCANStatus();
+
+  /**
+   * Start reading the power rails and roboRIO status in the background once
+   * per period.
+   *
+   * While sampling, the power getters (including GetBatteryVoltage()) return
+   * the latest sample instead of reading the hardware on every call, so
+   * telemetry loops can call them freely.
+   *
+   * @param period The sample period.
+   */
+  static void StartPowerSampling(units::second_t period);
+
+  /**
+   * Start reading the power rails, roboRIO status and a PDP in the background
+   * once per period.
+   *
+   * While sampling, the power getters and the getters of the PDP return the
+   * latest sample, so all of the PDP channels come from one bulk read.
+   *
+   * @param period The sample period.
+   * @param pdp The PDP to sample.
+   */
+  static void StartPowerSampling(units::second_t period,
+                                 const PowerDistributionPanel& pdp);
+
+  /**
+   * Stop the background sampling started by StartPowerSampling().
+   */
+  static void StopPowerSampling();
 };
 
 }  // namespace frc
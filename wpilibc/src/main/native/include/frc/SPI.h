@@ -263,6 +263,46 @@ class SPI {
   void ConfigureAutoStall(HAL_SPIPort port, int csToSclkTicks, int stallTicks,
                           int pow2BytesPerRead);
 
+  /**
+   * Start streaming the automatic SPI received data into a ring buffer.
+   *
+   * A real-time HAL thread drains whole transfers into the ring as they
+   * arrive, so they can be read with AcquireAutoStream() without polling the
+   * FPGA. While the ring is full, further transfers are dropped (see
+   * GetAutoDroppedCount()). SetAutoTransmitData() must be called first, and
+   * the stream can't be used together with the accumulator.
+   *
+   * @param depth number of transfers the ring holds
+   * @param period how often to check for data when none is available
+   */
+  void StartAutoStream(int depth, units::second_t period);
+
+  /**
+   * Stop streaming the automatic SPI received data.
+   */
+  void StopAutoStream();
+
+  /**
+   * Get the oldest transfers in the automatic SPI stream without copying them.
+   *
+   * Each transfer is in the format returned by ReadAutoReceivedData(). The
+   * transfers are contiguous, so fewer than are in the ring may be returned
+   * when they wrap around its end. They stay valid until they are released
+   * with ReleaseAutoStream() or the stream is stopped.
+   *
+   * @param timeout how long to wait for a transfer if none are in the ring
+   * @return The words of the transfers
+   */
+  wpi::span<const uint32_t> AcquireAutoStream(units::second_t timeout);
+
+  /**
+   * Release the oldest transfers in the automatic SPI stream, making room for
+   * new ones.
+   *
+   * @param numTransfers number of transfers to release
+   */
+  void ReleaseAutoStream(int numTransfers);
+
   /**
    * Initialize the accumulator.
    *
@@ -407,6 +447,8 @@ class SPI {
  private:
   void Init();
 
+  int m_autoTransferSize = 0;  // data + zero bytes per auto transfer
+
   class Accumulator;
   std::unique_ptr<Accumulator> m_accum;
 };
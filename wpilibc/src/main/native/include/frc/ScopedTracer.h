@@ -7,6 +7,8 @@
 #include <string>
 #include <string_view>
 
+#include <hal/cpp/fpga_clock.h>
+
 #include "frc/Tracer.h"
 
 namespace wpi {
@@ -19,7 +21,11 @@ namespace frc {
  * parts of code to execute. This class uses RAII, meaning you simply
  * need to create an instance at the top of the block you are timing. After the
  * block finishes execution (i.e. when the ScopedTracer instance gets
- * destroyed), the epoch is printed to the provided raw_ostream.
+ * destroyed), the epoch is printed to the provided raw_ostream, or added to
+ * the epoch of the provided Tracer.
+ *
+ * ScopedTracers on a Tracer can be nested to time an operation hierarchically,
+ * using epochs registered with Tracer::RegisterEpoch(name, parentId).
  */
 class ScopedTracer {
  public:
@@ -30,6 +36,16 @@ class ScopedTracer {
    * @param os A reference to the raw_ostream to print data to.
    */
   ScopedTracer(std::string_view name, wpi::raw_ostream& os);
+
+  /**
+   * Constructs a ScopedTracer instance that adds the time until it is
+   * destroyed to an epoch of a Tracer, without restarting its epoch timer.
+   *
+   * @param tracer The Tracer to add the time to.
+   * @param epochId The ID returned by Tracer::RegisterEpoch().
+   */
+  ScopedTracer(Tracer& tracer, int epochId);
+
   ~ScopedTracer();
 
   ScopedTracer(const ScopedTracer&) = delete;
@@ -38,6 +54,10 @@ class ScopedTracer {
  private:
   Tracer m_tracer;
   std::string m_name;
-  wpi::raw_ostream& m_os;
+  wpi::raw_ostream* m_os = nullptr;
+
+  Tracer* m_parent = nullptr;
+  int m_epochId = 0;
+  hal::fpga_clock::time_point m_startTime;
 };
 }  // namespace frc
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -80,7 +83,77 @@ class TimedRobot : public IterativeRobotBase {
   void AddPeriodic(std::function<void()> callback, units::second_t period,
                    units::second_t offset = 0_s);
 
+  /**
+   * Statistics of the runs of a rate group.
+   */
+  struct RateGroupStats {
+    /// The number of times the group has run
+    int64_t runs = 0;
+
+    /// The number of runs that took longer than the group's period
+    int64_t overruns = 0;
+
+    /// The duration of the last run
+    units::second_t lastDuration = 0_s;
+
+    /// The longest run
+    units::second_t maxDuration = 0_s;
+
+    /// How late the last run started
+    units::second_t lastLatency = 0_s;
+
+    /// How late the latest-starting run started
+    units::second_t maxLatency = 0_s;
+  };
+
+  /**
+   * Add a rate group, a set of callbacks that run one after the other at the
+   * same period.
+   *
+   * The group's offset from the common starting time is chosen to be as far
+   * as possible from the runs of TimedRobot and of the other rate groups, so
+   * their loads are spread across the period.
+   *
+   * By default the group is scheduled on TimedRobot's Notifier, like
+   * AddPeriodic().  A group on a dedicated thread isn't delayed by
+   * TimedRobot's other callbacks, for example a 5 ms control loop behind a
+   * 20 ms RobotPeriodic(), but its callbacks run concurrently with them and
+   * must be thread-safe.
+   *
+   * @param period          The period at which to run the group's callbacks.
+   * @param dedicatedThread Whether to run the group on a thread of its own.
+   * @param priority        The real-time priority of the dedicated thread
+   *                        ([1..99] where a higher number represents higher
+   *                        priority).
+   * @return The index of the rate group.
+   */
+  int AddRateGroup(units::second_t period, bool dedicatedThread = false,
+                   int priority = 30);
+
+  /**
+   * Add a callback to a rate group.  Callbacks run in the order they were
+   * added.
+   *
+   * @param group    The index of the rate group.
+   * @param callback The callback to run.
+   */
+  void AddRateGroupCallback(int group, std::function<void()> callback);
+
+  /**
+   * Get the statistics of a rate group's runs.
+   *
+   * @param group The index of the rate group.
+   * @return The statistics of the group.
+   */
+  RateGroupStats GetRateGroupStats(int group) const;
+
  private:
+  class RateGroup;
+
+  // Returns the offset of a new rate group's runs that is furthest from the
+  // runs of the main loop and the other rate groups
+  units::second_t ChooseOffset(units::second_t period) const;
+
   class Callback {
    public:
     std::function<void()> func;
@@ -115,6 +188,11 @@ class TimedRobot : public IterativeRobotBase {
 
   wpi::priority_queue<Callback, std::vector<Callback>, std::greater<Callback>>
       m_callbacks;
+
+  std::vector<std::unique_ptr<RateGroup>> m_rateGroups;
+
+  // Whether the dedicated threads of the rate groups have been started
+  bool m_rateGroupsStarted = false;
 };
 
 }  // namespace frc
@@ -4,12 +4,21 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <array>
 #include <chrono>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include <hal/cpp/fpga_clock.h>
 #include <wpi/StringMap.h>
 
+namespace nt {
+class NetworkTable;
+}  // namespace nt
+
 namespace wpi {
 class raw_ostream;
 }  // namespace wpi
@@ -22,9 +31,29 @@ namespace frc {
  *
  * Epochs are a way to partition the time elapsed so that when overruns occur,
  * one can determine which parts of an operation consumed the most time.
+ *
+ * Epochs can be registered ahead of time with RegisterEpoch(), so that adding
+ * them doesn't need to look up (or allocate) the name. Every time added to an
+ * epoch is also aggregated into statistics that can be published with
+ * PublishEpochStats().
+ *
+ * A Tracer is not thread safe; use one per thread.
  */
 class Tracer {
  public:
+  /**
+   * Statistics of the times added to an epoch.
+   */
+  struct EpochStats {
+    /** The number of times added */
+    int64_t count = 0;
+    std::chrono::nanoseconds min{0};
+    std::chrono::nanoseconds mean{0};
+    std::chrono::nanoseconds max{0};
+    /** The 99th percentile, from a histogram accurate to within 25% */
+    std::chrono::nanoseconds p99{0};
+  };
+
   /**
    * Constructs a Tracer instance.
    */
@@ -37,9 +66,28 @@ class Tracer {
 
   /**
    * Clears all epochs.
+   *
+   * Registered epochs keep their IDs and statistics.
    */
   void ClearEpochs();
 
+  /**
+   * Registers an epoch, or gets the ID of an already registered one.
+   *
+   * @param epochName The name to associate with the epoch.
+   * @return The epoch ID.
+   */
+  int RegisterEpoch(std::string_view epochName);
+
+  /**
+   * Registers an epoch nested in another one, named "parent/epochName".
+   *
+   * @param epochName The name to associate with the epoch.
+   * @param parentId The ID of the parent epoch.
+   * @return The epoch ID.
+   */
+  int RegisterEpoch(std::string_view epochName, int parentId);
+
   /**
    * Adds time since last epoch to the list printed by PrintEpochs().
    *
@@ -50,6 +98,22 @@ class Tracer {
    */
   void AddEpoch(std::string_view epochName);
 
+  /**
+   * Adds time since last epoch to the list printed by PrintEpochs().
+   *
+   * @param epochId The ID returned by RegisterEpoch().
+   */
+  void AddEpoch(int epochId);
+
+  /**
+   * Adds a time to an epoch without restarting the epoch timer. This is how
+   * ScopedTracer times nested scopes.
+   *
+   * @param epochId The ID returned by RegisterEpoch().
+   * @param duration The time to add.
+   */
+  void RecordEpoch(int epochId, std::chrono::nanoseconds duration);
+
   /**
    * Prints list of epochs added so far and their times to the DriverStation.
    */
@@ -62,12 +126,48 @@ class Tracer {
    */
   void PrintEpochs(wpi::raw_ostream& os);
 
+  /**
+   * Gets the statistics of all of the times added to an epoch.
+   *
+   * @param epochId The ID returned by RegisterEpoch().
+   */
+  EpochStats GetEpochStats(int epochId) const;
+
+  /**
+   * Clears the statistics of all epochs.
+   */
+  void ResetEpochStats();
+
+  /**
+   * Publishes the statistics of each epoch to a NetworkTables table, as
+   * "<epoch>/count", and "<epoch>/min", "mean", "max" and "p99" in seconds.
+   *
+   * @param table The table to publish to.
+   */
+  void PublishEpochStats(nt::NetworkTable& table) const;
+
  private:
   static constexpr std::chrono::milliseconds kMinPrintPeriod{1000};
 
+  // Histogram buckets of 4 per power of two microseconds
+  static constexpr int kNumBuckets = 128;
+
+  struct Epoch {
+    std::string name;
+    std::chrono::nanoseconds last{0};
+    bool added = false;  // since ClearEpochs()
+
+    int64_t count = 0;
+    std::chrono::nanoseconds min{0};
+    std::chrono::nanoseconds max{0};
+    std::chrono::nanoseconds total{0};
+    std::array<uint32_t, kNumBuckets> histogram{};
+  };
+
   hal::fpga_clock::time_point m_startTime;
   hal::fpga_clock::time_point m_lastEpochsPrintTime = hal::fpga_clock::epoch();
 
-  wpi::StringMap<std::chrono::nanoseconds> m_epochs;
+  std::vector<Epoch> m_epochs;
+  wpi::StringMap<int> m_epochIds;
 };
 }  // namespace frc
@@ -78,11 +78,34 @@ class Watchdog {
    */
   void AddEpoch(std::string_view epochName);
 
+  /**
+   * Registers an epoch, so it can be added without looking up its name.
+   *
+   * @param epochName The name to associate with the epoch.
+   * @return The epoch ID.
+   */
+  int RegisterEpoch(std::string_view epochName);
+
+  /**
+   * Adds time since last epoch to the list printed by PrintEpochs().
+   *
+   * @param epochId The ID returned by RegisterEpoch().
+   */
+  void AddEpoch(int epochId);
+
   /**
    * Prints list of epochs added so far and their times.
    */
   void PrintEpochs();
 
+  /**
+   * Publishes the min, mean, max and 99th percentile time of each epoch to a
+   * NetworkTables table.
+   *
+   * @param table The table to publish to.
+   */
+  void PublishEpochStats(nt::NetworkTable& table) const;
+
   /**
    * Resets the watchdog timer.
    *
@@ -10,6 +10,7 @@
 #include <string_view>
 #include <vector>
 
+#include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
 #include <networktables/NetworkTableValue.h>
 #include <wpi/SmallSet.h>
@@ -475,11 +476,31 @@ class ShuffleboardContainer : public virtual ShuffleboardValue {
  protected:
   bool m_isLayout = false;
 
+  /**
+   * Builds the entries for the components of this container into its subtable
+   * of parentTable. The container's type and the components' metadata tables
+   * are only looked up again for components added since the last call, so
+   * each call after the first just refreshes the components' data.
+   *
+   * @param parentTable The table containing all the data for the parent.
+   * @param metaTable   The table containing all the metadata for this
+   *                    container.
+   * @param type        The value of the container's ".type" entry.
+   */
+  void BuildComponents(std::shared_ptr<nt::NetworkTable> parentTable,
+                       std::shared_ptr<nt::NetworkTable> metaTable,
+                       std::string_view type);
+
  private:
   wpi::SmallSet<std::string, 32> m_usedTitles;
   std::vector<std::unique_ptr<ShuffleboardComponentBase>> m_components;
   wpi::StringMap<ShuffleboardLayout*> m_layouts;
 
+  // Built by BuildComponents(); the metadata tables are indexed like
+  // m_components, so components without one are new since the last build
+  std::shared_ptr<nt::NetworkTable> m_table;
+  std::vector<std::shared_ptr<nt::NetworkTable>> m_componentMetaTables;
+
   /**
    * Adds title to internal set if it hasn't already.
    *
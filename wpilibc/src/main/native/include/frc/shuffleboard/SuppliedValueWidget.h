@@ -32,14 +32,19 @@ class SuppliedValueWidget : public ShuffleboardWidget<SuppliedValueWidget<T> > {
 
   void BuildInto(std::shared_ptr<nt::NetworkTable> parentTable,
                  std::shared_ptr<nt::NetworkTable> metaTable) override {
+    if (this->m_metadataDirty) {
+      metaTable->GetEntry("Controllable").SetBoolean(false);
+    }
     this->BuildMetadata(metaTable);
-    metaTable->GetEntry("Controllable").SetBoolean(false);
 
-    auto entry = parentTable->GetEntry(this->GetTitle());
-    m_setter(entry, m_supplier());
+    if (!m_entry) {
+      m_entry = parentTable->GetEntry(this->GetTitle());
+    }
+    m_setter(m_entry, m_supplier());
   }
 
  private:
+  nt::NetworkTableEntry m_entry;
   std::function<T()> m_supplier;
   std::function<void(nt::NetworkTableEntry, T)> m_setter;
 };
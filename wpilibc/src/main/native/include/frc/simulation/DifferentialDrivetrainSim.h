@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <frc/RandomStream.h>
 #include <frc/kinematics/DifferentialDriveKinematics.h>
 #include <frc/system/LinearSystem.h>
 #include <frc/system/plant/DCMotor.h>
@@ -187,6 +190,14 @@ class DifferentialDrivetrainSim {
    */
   void SetPose(const frc::Pose2d& pose);
 
+  /**
+   * Reseeds the measurement noise, so the noise of a simulation run can be
+   * reproduced.
+   *
+   * @param seed The seed.
+   */
+  void SetNoiseSeed(uint64_t seed) { m_noiseStream.Seed(seed); }
+
   Eigen::Matrix<double, 7, 1> Dynamics(const Eigen::Matrix<double, 7, 1>& x,
                                        const Eigen::Matrix<double, 2, 1>& u);
 
@@ -323,5 +334,6 @@ class DifferentialDrivetrainSim {
   Eigen::Matrix<double, 2, 1> m_u;
   Eigen::Matrix<double, 7, 1> m_y;
   std::array<double, 7> m_measurementStdDevs;
+  RandomStream m_noiseStream;
 };
 }  // namespace frc::sim
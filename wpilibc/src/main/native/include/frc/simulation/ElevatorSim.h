@@ -11,6 +11,7 @@
 #include <units/velocity.h>
 
 #include "frc/simulation/LinearSystemSim.h"
+#include "frc/system/NumericalIntegration.h"
 #include "frc/system/plant/DCMotor.h"
 
 namespace frc::sim {
@@ -133,5 +134,7 @@ class ElevatorSim : public LinearSystemSim<2, 1, 1> {
   units::meter_t m_minHeight;
   units::meter_t m_maxHeight;
   double m_gearing;
+  RKDPIntegrator<Eigen::Matrix<double, 2, 1>, Eigen::Matrix<double, 1, 1>>
+      m_integrator;
 };
 }  // namespace frc::sim
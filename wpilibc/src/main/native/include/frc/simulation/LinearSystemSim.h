@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <array>
 
 #include <Eigen/Core>
 #include <units/current.h>
 #include <units/time.h>
 
+#include "frc/RandomStream.h"
 #include "frc/RobotController.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/system/LinearSystem.h"
@@ -61,7 +64,8 @@ class LinearSystemSim {
     // Add noise. If the user did not pass a noise vector to the
     // constructor, then this method will not do anything because
     // the standard deviations default to zero.
-    m_y += frc::MakeWhiteNoiseVector<Outputs>(m_measurementStdDevs);
+    m_y += frc::MakeWhiteNoiseVector<Outputs>(m_noiseStream,
+                                              m_measurementStdDevs);
   }
 
   /**
@@ -106,6 +110,14 @@ class LinearSystemSim {
    */
   void SetState(const Eigen::Matrix<double, States, 1>& state) { m_x = state; }
 
+  /**
+   * Reseeds the measurement noise, so the noise of a simulation run can be
+   * reproduced.
+   *
+   * @param seed The seed.
+   */
+  void SetNoiseSeed(uint64_t seed) { m_noiseStream.Seed(seed); }
+
   /**
    * Returns the current drawn by this simulated system. Override this method to
    * add a custom current calculation.
@@ -149,5 +161,6 @@ class LinearSystemSim {
   Eigen::Matrix<double, Outputs, 1> m_y;
   Eigen::Matrix<double, Inputs, 1> m_u;
   std::array<double, Outputs> m_measurementStdDevs;
+  RandomStream m_noiseStream;
 };
 }  // namespace frc::sim
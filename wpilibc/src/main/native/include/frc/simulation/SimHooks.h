@@ -60,4 +60,37 @@ void StepTiming(units::second_t delta);
  */
 void StepTimingAsync(units::second_t delta);
 
+/**
+ * Run the simulator time as fast as possible. While enabled, the time is
+ * paused and jumps directly to the next notifier alarm whenever all notifiers
+ * are waiting. The time stays paused when this is disabled.
+ *
+ * @param enable true to enable
+ */
+void SetTimingFastForward(bool enable);
+
+/**
+ * Check if the simulator time is running as fast as possible.
+ *
+ * @return true if enabled
+ */
+bool IsTimingFastForward();
+
+/**
+ * Run the simulator time in lock step. The time is fast forwarded, and the
+ * notifiers due at each alarm run one at a time in creation order, so a
+ * program driven entirely by notifiers behaves the same way on every run.
+ * Disabling lock step also disables fast forwarding.
+ *
+ * @param enable true to enable
+ */
+void SetTimingLockStep(bool enable);
+
+/**
+ * Check if the simulator time is running in lock step.
+ *
+ * @return true if enabled
+ */
+bool IsTimingLockStep();
+
 }  // namespace frc::sim
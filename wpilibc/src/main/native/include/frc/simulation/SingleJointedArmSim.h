@@ -12,6 +12,7 @@
 #include <units/moment_of_inertia.h>
 
 #include "frc/simulation/LinearSystemSim.h"
+#include "frc/system/NumericalIntegration.h"
 #include "frc/system/plant/DCMotor.h"
 
 namespace frc::sim {
@@ -154,5 +155,7 @@ class SingleJointedArmSim : public LinearSystemSim<2, 1, 1> {
   const DCMotor m_gearbox;
   double m_gearing;
   bool m_simulateGravity;
+  RKDPIntegrator<Eigen::Matrix<double, 2, 1>, Eigen::Matrix<double, 1, 1>>
+      m_integrator;
 };
 }  // namespace frc::sim
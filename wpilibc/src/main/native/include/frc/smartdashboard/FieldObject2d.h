@@ -109,6 +109,8 @@ class FieldObject2d {
   std::string m_name;
   nt::NetworkTableEntry m_entry;
   mutable wpi::SmallVector<Pose2d, 1> m_poses;
+  // the last compact encoding of m_poses, reused between updates
+  std::string m_encoded;
 };
 
 }  // namespace frc
@@ -9,6 +9,7 @@
 
 #include <networktables/NTSendable.h>
 #include <networktables/NetworkTableEntry.h>
+#include <wpi/SmallVector.h>
 #include <wpi/StringMap.h>
 #include <wpi/mutex.h>
 #include <wpi/sendable/SendableHelper.h>
@@ -69,6 +70,16 @@ class Mechanism2d : public nt::NTSendable,
    */
   void SetBackgroundColor(const Color8Bit& color);
 
+  /**
+   * Set whether changes to the nodes are batched.  By default each change is
+   * published as it is made; when batched, the changes accumulate and are
+   * published together each time SmartDashboard::UpdateValues() is called.
+   * Either way, values that have not changed are not republished.
+   *
+   * @param batched true to batch changes
+   */
+  void SetBatched(bool batched);
+
   void InitSendable(nt::NTSendableBuilder& builder) override;
 
  private:
@@ -78,5 +89,10 @@ class Mechanism2d : public nt::NTSendable,
   mutable wpi::mutex m_mutex;
   std::shared_ptr<nt::NetworkTable> m_table;
   wpi::StringMap<std::unique_ptr<MechanismRoot2d>> m_roots;
+  bool m_batched = false;
+  wpi::SmallVector<NT_Entry, 16> m_updateEntries;
+  wpi::SmallVector<std::shared_ptr<nt::Value>, 16> m_updateValues;
+
+  void PublishUpdates();
 };
 }  // namespace frc
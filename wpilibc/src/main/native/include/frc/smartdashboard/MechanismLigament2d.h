@@ -70,9 +70,11 @@ class MechanismLigament2d : public MechanismObject2d {
 
  protected:
   void UpdateEntries(std::shared_ptr<nt::NetworkTable> table) override;
+  void CollectUpdates(
+      wpi::SmallVectorImpl<NT_Entry>& entries,
+      wpi::SmallVectorImpl<std::shared_ptr<nt::Value>>& values) override;
 
  private:
-  void Flush();
   double m_length;
   nt::NetworkTableEntry m_lengthEntry;
   double m_angle;
@@ -81,5 +83,11 @@ class MechanismLigament2d : public MechanismObject2d {
   nt::NetworkTableEntry m_weightEntry;
   char m_color[10];
   nt::NetworkTableEntry m_colorEntry;
+
+  // the values last published; NaN or empty if never published
+  double m_publishedLength;
+  double m_publishedAngle;
+  double m_publishedWeight;
+  char m_publishedColor[10];
 };
 }  // namespace frc
@@ -12,6 +12,8 @@
 #include <utility>
 
 #include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableValue.h>
+#include <wpi/SmallVector.h>
 #include <wpi/StringMap.h>
 
 #include "frc/Errors.h"
@@ -41,8 +43,28 @@ class MechanismObject2d {
    */
   virtual void UpdateEntries(std::shared_ptr<nt::NetworkTable> table) = 0;
 
+  /**
+   * Appends the entries and values of the properties that changed since they
+   * were last published, and marks them published.  Called with m_mutex held.
+   *
+   * @param entries entries (output)
+   * @param values values (output)
+   */
+  virtual void CollectUpdates(
+      wpi::SmallVectorImpl<NT_Entry>& entries,
+      wpi::SmallVectorImpl<std::shared_ptr<nt::Value>>& values) = 0;
+
+  /**
+   * Publishes the changed properties, or in batched mode leaves them to be
+   * published with the rest of the mechanism.  Called with m_mutex held.
+   */
+  void Flush();
+
   mutable wpi::mutex m_mutex;
 
+  // whether changes are published by Mechanism2d rather than by Flush()
+  bool m_batched = false;
+
  public:
   virtual ~MechanismObject2d() = default;
 
@@ -76,6 +98,7 @@ class MechanismObject2d {
     }
     obj = std::make_unique<T>(name, std::forward<Args>(args)...);
     T* ex = static_cast<T*>(obj.get());
+    ex->SetBatched(m_batched);
     if (m_table) {
       ex->Update(m_table->GetSubTable(name));
     }
@@ -87,5 +110,9 @@ class MechanismObject2d {
   wpi::StringMap<std::unique_ptr<MechanismObject2d>> m_objects;
   std::shared_ptr<nt::NetworkTable> m_table;
   void Update(std::shared_ptr<nt::NetworkTable> table);
+  void SetBatched(bool batched);
+  void CollectAllUpdates(
+      wpi::SmallVectorImpl<NT_Entry>& entries,
+      wpi::SmallVectorImpl<std::shared_ptr<nt::Value>>& values);
 };
 }  // namespace frc
@@ -41,9 +41,14 @@ class MechanismRoot2d : private MechanismObject2d {
 
  private:
   void UpdateEntries(std::shared_ptr<nt::NetworkTable> table) override;
-  inline void Flush();
+  void CollectUpdates(
+      wpi::SmallVectorImpl<NT_Entry>& entries,
+      wpi::SmallVectorImpl<std::shared_ptr<nt::Value>>& values) override;
   double m_x;
   double m_y;
   nt::NetworkTableEntry m_posEntry;
+  // the position last published; NaN if never published
+  double m_publishedX;
+  double m_publishedY;
 };
 }  // namespace frc
@@ -55,6 +55,7 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
 
   /**
    * Update the network table values by calling the getters for all properties.
+   * Only values that changed since the last update are set.
    */
   void Update() override;
 
@@ -160,6 +161,7 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
     Property(Property&& other) noexcept
         : entry(other.entry),
           listener(other.listener),
+          lastValue(std::move(other.lastValue)),
           update(std::move(other.update)),
           createListener(std::move(other.createListener)) {
       other.entry = nt::NetworkTableEntry();
@@ -171,6 +173,7 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
       listener = other.listener;
       other.entry = nt::NetworkTableEntry();
       other.listener = 0;
+      lastValue = std::move(other.lastValue);
       update = std::move(other.update);
       createListener = std::move(other.createListener);
       return *this;
@@ -193,11 +196,17 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
 
     nt::NetworkTableEntry entry;
     NT_EntryListener listener = 0;
-    std::function<void(nt::NetworkTableEntry entry, uint64_t time)> update;
+    // The value last set by Update()
+    std::shared_ptr<nt::Value> lastValue;
+    // Returns the value to set the entry to
+    std::function<std::shared_ptr<nt::Value>(uint64_t time)> update;
     std::function<NT_EntryListener(nt::NetworkTableEntry entry)> createListener;
   };
 
   std::vector<Property> m_properties;
+  // Scratch space for Update(), so all properties are set at once
+  std::vector<NT_Entry> m_updateEntries;
+  std::vector<std::shared_ptr<nt::Value>> m_updateValues;
   std::function<void()> m_safeState;
   std::vector<std::function<void()>> m_updateTables;
   std::shared_ptr<nt::NetworkTable> m_table;
@@ -11,6 +11,7 @@
 
 #include <networktables/NetworkTableEntry.h>
 #include <networktables/NetworkTableValue.h>
+#include <units/time.h>
 #include <wpi/span.h>
 
 namespace wpi {
@@ -141,6 +142,29 @@ class SmartDashboard {
    */
   static wpi::Sendable* GetData(std::string_view keyName);
 
+  /**
+   * Sets how often the Sendable at the specified key is updated by
+   * UpdateValues(). By default it is updated every call. Slowly changing
+   * Sendables can be updated less often to save loop time.
+   *
+   * @param key    the key the Sendable was put at
+   * @param period the minimum time between updates, or 0 to update every call
+   */
+  static void SetUpdatePeriod(std::string_view key, units::second_t period);
+
+  /**
+   * Limits how much work each UpdateValues() call does. Once either limit is
+   * reached, the remaining Sendables are updated by the following calls,
+   * continuing in round-robin order, so the loop time stays bounded and the
+   * dashboard refresh rate degrades instead.
+   *
+   * @param maxSendables the most Sendables to update per call, or 0 for no
+   *                     limit
+   * @param maxTime      the time after which no more Sendables are updated in
+   *                     a call, or 0 for no limit
+   */
+  static void SetUpdateBudget(int maxSendables, units::second_t maxTime);
+
   /**
    * Maps the specified key to the specified value in this table.
    *
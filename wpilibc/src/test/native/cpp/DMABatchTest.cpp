@@ -0,0 +1,69 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/DMABatch.h"  // NOLINT(build/include_order)
+
+#include <array>
+
+#include <hal/HALBase.h>
+
+#include "frc/AnalogInput.h"
+#include "frc/DMA.h"
+#include "frc/Encoder.h"
+#include "frc/simulation/AnalogInputSim.h"
+#include "frc/simulation/EncoderSim.h"
+#include "frc/simulation/SimHooks.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+TEST(DMABatchTest, Read) {
+  frc::sim::PauseTiming();
+
+  Encoder encoder{0, 1};
+  AnalogInput analog{0};
+  sim::EncoderSim encoderSim{encoder};
+  sim::AnalogInputSim analogSim{analog};
+
+  DMA dma;
+  dma.AddEncoder(&encoder);
+  dma.AddAnalogInput(&analog);
+  dma.SetTimedTrigger(1_ms);
+
+  std::array<uint64_t, 4> timestamps;
+  std::array<int32_t, 8> counts;
+  std::array<double, 4> voltages;
+  DMABatch batch{dma};
+  batch.SetTimestamps(timestamps);
+  batch.AddEncoder(&encoder, counts);
+  batch.AddAnalogInputVoltage(&analog, voltages);
+  EXPECT_EQ(batch.GetCapacity(), 4u);
+
+  encoderSim.SetCount(42);
+  analogSim.SetVoltage(2.5);
+  int32_t status = 0;
+  uint64_t startTime = HAL_GetFPGATime(&status);
+  dma.Start(16);
+
+  int32_t remaining = 0;
+  EXPECT_EQ(batch.Read(0_s, &remaining, &status), 0u);
+  EXPECT_EQ(status, 0);
+
+  frc::sim::StepTiming(6_ms);
+  ASSERT_EQ(batch.Read(0_s, &remaining, &status), 4u);
+  EXPECT_EQ(status, 0);
+  EXPECT_EQ(remaining, 2);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(timestamps[i], startTime + (i + 1) * 1000u);
+    EXPECT_EQ(counts[i], encoder.GetRaw());
+    EXPECT_NEAR(voltages[i], 2.5, 0.01);
+  }
+
+  ASSERT_EQ(batch.Read(0_s, &remaining, &status), 2u);
+  EXPECT_EQ(remaining, 0);
+  EXPECT_EQ(timestamps[1], startTime + 6000u);
+
+  dma.Stop();
+  frc::sim::ResumeTiming();
+}
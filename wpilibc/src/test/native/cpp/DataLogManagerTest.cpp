@@ -0,0 +1,62 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/DataLogManager.h"  // NOLINT(build/include_order)
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <networktables/NetworkTableInstance.h>
+#include <wpi/DataLogReader.h>
+#include <wpi/StringMap.h>
+#include <wpi/fs.h>
+
+#include "gtest/gtest.h"
+
+TEST(DataLogManagerTest, MessagesAndNetworkTables) {
+  auto dir = fs::temp_directory_path() / "DataLogManagerTest";
+  auto entry = nt::NetworkTableInstance::GetDefault().GetEntry(
+      "/DataLogManagerTest/value");
+  entry.SetDouble(1.5);
+
+  frc::DataLogManager::Start(dir.string(), "test.wpilog");
+  EXPECT_EQ(frc::DataLogManager::GetLogDir(), dir.string());
+  frc::DataLogManager::Log("hello");
+  entry.SetDouble(2.5);
+  frc::DataLogManager::Stop();
+  EXPECT_EQ(frc::DataLogManager::GetLogDir(), "");
+
+  std::ifstream is{(dir / "test.wpilog").string(), std::ios::binary};
+  std::vector<uint8_t> data{std::istreambuf_iterator<char>{is},
+                            std::istreambuf_iterator<char>{}};
+  wpi::log::DataLogReader reader{data};
+  ASSERT_TRUE(reader.IsValid());
+
+  wpi::StringMap<int> entries;
+  std::vector<std::string> messages;
+  std::vector<double> values;
+  for (auto&& record : reader) {
+    wpi::log::StartRecordData start;
+    if (record.GetStartData(&start)) {
+      entries[start.name] = start.entry;
+      continue;
+    }
+    if (record.GetEntry() == entries["messages"]) {
+      std::string_view message;
+      record.GetString(&message);
+      messages.emplace_back(message);
+    } else if (record.GetEntry() ==
+               entries["NT:/DataLogManagerTest/value"]) {
+      double value;
+      ASSERT_TRUE(record.GetDouble(&value));
+      values.push_back(value);
+    }
+  }
+  EXPECT_EQ(messages, std::vector<std::string>{"hello"});
+  EXPECT_EQ(values, (std::vector<double>{1.5, 2.5}));
+
+  fs::remove_all(dir);
+}
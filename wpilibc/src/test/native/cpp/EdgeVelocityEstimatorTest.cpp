@@ -0,0 +1,111 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/EdgeVelocityEstimator.h"  // NOLINT(build/include_order)
+
+#include <array>
+
+#include "frc/DMA.h"
+#include "frc/DMABatch.h"
+#include "frc/Encoder.h"
+#include "frc/simulation/EncoderSim.h"
+#include "frc/simulation/SimHooks.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+TEST(EdgeVelocityEstimatorTest, ConstantVelocity) {
+  EdgeVelocityEstimator estimator{4};
+  EXPECT_EQ(estimator.GetVelocity(0), 0.0);
+
+  // an edge every 2 ms, 0.01 per edge is 5 units per second
+  for (int i = 0; i < 10; ++i) {
+    estimator.AddEdge(1000000 + i * 2000, i * 0.01);
+  }
+  EXPECT_NEAR(estimator.GetVelocity(1018000), 5.0, 1e-9);
+
+  // reversing
+  for (int i = 0; i < 4; ++i) {
+    estimator.AddEdge(1020000 + i * 4000, 0.08 - i * 0.01);
+  }
+  EXPECT_NEAR(estimator.GetVelocity(1032000), -2.5, 1e-9);
+}
+
+TEST(EdgeVelocityEstimatorTest, UnevenEdges) {
+  // a least-squares fit, not the average of the last periods
+  EdgeVelocityEstimator estimator{3};
+  estimator.AddEdge(0, 0);
+  estimator.AddEdge(1000, 1);
+  estimator.AddEdge(3000, 2);
+  // t = {0, 1, 3} ms, p = {0, 1, 2}: slope = 3 / (14 / 3) per ms
+  EXPECT_NEAR(estimator.GetVelocity(3000), 9000.0 / 14, 1e-9);
+}
+
+TEST(EdgeVelocityEstimatorTest, IgnoresNonEdges) {
+  EdgeVelocityEstimator estimator{8};
+  estimator.AddEdge(0, 0);
+  estimator.AddEdge(500, 0);
+  estimator.AddEdge(1000, 1);
+  estimator.AddEdge(1500, 1);
+  estimator.AddEdge(2000, 2);
+  // out of order
+  estimator.AddEdge(1200, 5);
+  EXPECT_NEAR(estimator.GetVelocity(2000), 1000.0, 1e-9);
+}
+
+TEST(EdgeVelocityEstimatorTest, Stopped) {
+  EdgeVelocityEstimator estimator{8, 10_ms};
+  estimator.AddEdge(0, 0);
+  estimator.AddEdge(1000, 1);
+  EXPECT_NEAR(estimator.GetVelocity(5000), 1000.0, 1e-9);
+  EXPECT_EQ(estimator.GetVelocity(12000), 0.0);
+
+  // edges from before the stop don't count once moving again
+  estimator.AddEdge(50000, 2);
+  EXPECT_EQ(estimator.GetVelocity(50000), 0.0);
+  estimator.AddEdge(52000, 3);
+  EXPECT_NEAR(estimator.GetVelocity(52000), 500.0, 1e-9);
+
+  estimator.Reset();
+  EXPECT_EQ(estimator.GetVelocity(52000), 0.0);
+}
+
+TEST(EdgeVelocityEstimatorTest, DMA) {
+  frc::sim::PauseTiming();
+
+  Encoder encoder{0, 1};
+  encoder.SetDistancePerPulse(0.25);
+  sim::EncoderSim encoderSim{encoder};
+
+  DMA dma;
+  dma.AddEncoder(&encoder);
+  dma.SetTimedTrigger(1_ms);
+
+  std::array<uint64_t, 32> timestamps;
+  std::array<double, 32> distances;
+  DMABatch batch{dma};
+  batch.SetTimestamps(timestamps);
+  batch.AddEncoderDistance(&encoder, distances);
+
+  EdgeVelocityEstimator estimator;
+  dma.Start(64);
+  for (int i = 1; i <= 10; ++i) {
+    encoderSim.SetCount(i);
+    frc::sim::StepTiming(2_ms);
+  }
+
+  int32_t remaining = 0;
+  int32_t status = 0;
+  size_t count = batch.Read(0_s, &remaining, &status);
+  EXPECT_EQ(status, 0);
+  ASSERT_EQ(count, 20u);
+  EXPECT_DOUBLE_EQ(distances[19], encoder.GetDistance());
+  estimator.AddEdges(wpi::span{timestamps.data(), count},
+                     wpi::span<const double>{distances.data(), count});
+  // a pulse every 2 ms
+  EXPECT_NEAR(estimator.GetVelocity(), 0.25 / 0.002, 1e-6);
+
+  dma.Stop();
+  frc::sim::ResumeTiming();
+}
@@ -0,0 +1,48 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <string_view>
+
+#include <wpi/SmallString.h>
+#include <wpi/raw_ostream.h>
+
+#include "frc/LoopProfiler.h"
+#include "frc/simulation/SimHooks.h"
+#include "gtest/gtest.h"
+
+TEST(LoopProfilerTest, ChromeTrace) {
+  frc::LoopProfiler::SetCapacity(16);
+  {
+    // Nothing is recorded while disabled
+    frc::LoopProfiler::Scope scope{"disabled_phase"};
+  }
+
+  frc::LoopProfiler::SetEnabled(true);
+  frc::sim::PauseTiming();
+  {
+    frc::LoopProfiler::Scope outer{"outer_phase"};
+    frc::sim::StepTiming(10_ms);
+    {
+      frc::LoopProfiler::Scope inner{"inner \"phase\""};
+      frc::sim::StepTiming(5_ms);
+    }
+  }
+  frc::sim::ResumeTiming();
+  frc::LoopProfiler::SetEnabled(false);
+
+  wpi::SmallString<512> buf;
+  wpi::raw_svector_ostream os(buf);
+  frc::LoopProfiler::WriteChromeTrace(os);
+  std::string_view out = os.str();
+
+  EXPECT_EQ(std::string_view::npos, out.find("disabled_phase"));
+  auto outer = out.find("{\"name\":\"outer_phase\",\"ph\":\"X\"");
+  auto inner = out.find("{\"name\":\"inner \\\"phase\\\"\",\"ph\":\"X\"");
+  ASSERT_NE(std::string_view::npos, outer);
+  ASSERT_NE(std::string_view::npos, inner);
+  // The inner phase ends first, so it is recorded first
+  EXPECT_LT(inner, outer);
+  EXPECT_NE(std::string_view::npos, out.find("\"dur\":15000}"));
+  EXPECT_NE(std::string_view::npos, out.find("\"dur\":5000}"));
+}
@@ -0,0 +1,102 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/MotorSafety.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "frc/simulation/DriverStationSim.h"
+#include "frc/simulation/SimHooks.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+namespace {
+class MockMotorSafety : public MotorSafety {
+ public:
+  void StopMotor() override { stopped = true; }
+  std::string GetDescription() const override { return "MockMotorSafety"; }
+
+  bool stopped = false;
+};
+
+class MotorSafetyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    frc::sim::PauseTiming();
+    frc::sim::DriverStationSim::SetEnabled(true);
+    frc::sim::DriverStationSim::SetTest(false);
+    frc::sim::DriverStationSim::NotifyNewData();
+  }
+
+  void TearDown() override {
+    frc::sim::DriverStationSim::SetEnabled(false);
+    frc::sim::DriverStationSim::NotifyNewData();
+    frc::sim::ResumeTiming();
+  }
+};
+}  // namespace
+
+TEST_F(MotorSafetyTest, CheckMotors) {
+  std::vector<std::unique_ptr<MockMotorSafety>> motors;
+  for (int i = 0; i < 24; ++i) {
+    auto& motor = motors.emplace_back(std::make_unique<MockMotorSafety>());
+    // Every third motor has motor safety disabled
+    motor->SetSafetyEnabled(i % 3 != 0);
+    motor->Feed();
+  }
+
+  MotorSafety::CheckMotors();
+  for (auto& motor : motors) {
+    EXPECT_FALSE(motor->stopped);
+  }
+
+  frc::sim::StepTiming(50_ms);
+  // Only the even motors are fed
+  for (size_t i = 0; i < motors.size(); i += 2) {
+    motors[i]->Feed();
+  }
+  frc::sim::StepTiming(60_ms);
+
+  MotorSafety::CheckMotors();
+  for (size_t i = 0; i < motors.size(); ++i) {
+    EXPECT_EQ(i % 2 != 0 && i % 3 != 0, motors[i]->stopped) << "motor " << i;
+  }
+}
+
+TEST_F(MotorSafetyTest, Disabled) {
+  MockMotorSafety motor;
+  motor.SetSafetyEnabled(true);
+  motor.Feed();
+  frc::sim::StepTiming(200_ms);
+
+  frc::sim::DriverStationSim::SetEnabled(false);
+  frc::sim::DriverStationSim::NotifyNewData();
+  MotorSafety::CheckMotors();
+  EXPECT_FALSE(motor.stopped);
+
+  frc::sim::DriverStationSim::SetEnabled(true);
+  frc::sim::DriverStationSim::NotifyNewData();
+  MotorSafety::CheckMotors();
+  EXPECT_TRUE(motor.stopped);
+}
+
+TEST_F(MotorSafetyTest, SlotsReused) {
+  // Destroyed objects release their slots, and moved-to objects are checked
+  for (int i = 0; i < 1000; ++i) {
+    MockMotorSafety motor;
+    motor.SetSafetyEnabled(true);
+    motor.Feed();
+  }
+
+  MockMotorSafety motor;
+  motor.SetSafetyEnabled(true);
+  motor.Feed();
+  MockMotorSafety moved{std::move(motor)};
+  frc::sim::StepTiming(200_ms);
+  MotorSafety::CheckMotors();
+  EXPECT_TRUE(moved.stopped);
+}
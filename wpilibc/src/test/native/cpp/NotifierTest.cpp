@@ -0,0 +1,93 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/Notifier.h"  // NOLINT(build/include_order)
+
+#include <atomic>
+
+#include "frc/NotifierExecutor.h"
+#include "frc/simulation/SimHooks.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+namespace {
+class NotifierTest : public ::testing::Test {
+ protected:
+  void SetUp() override { frc::sim::PauseTiming(); }
+
+  void TearDown() override { frc::sim::ResumeTiming(); }
+};
+}  // namespace
+
+TEST_F(NotifierTest, StartPeriodic) {
+  std::atomic<int> counter{0};
+  Notifier notifier{[&] { ++counter; }};
+
+  notifier.StartPeriodic(20_ms);
+  frc::sim::StepTiming(10_ms);
+  EXPECT_EQ(0, counter);
+  frc::sim::StepTiming(10_ms);
+  EXPECT_EQ(1, counter);
+  frc::sim::StepTiming(50_ms);
+  EXPECT_EQ(3, counter);
+
+  notifier.Stop();
+  frc::sim::StepTiming(50_ms);
+  EXPECT_EQ(3, counter);
+}
+
+TEST_F(NotifierTest, StartSingle) {
+  std::atomic<int> counter{0};
+  Notifier notifier{[&] { ++counter; }};
+
+  notifier.StartSingle(20_ms);
+  frc::sim::StepTiming(100_ms);
+  EXPECT_EQ(1, counter);
+}
+
+TEST_F(NotifierTest, SharedExecutor) {
+  NotifierExecutor executor;
+  std::atomic<int> fastCounter{0};
+  std::atomic<int> slowCounter{0};
+  std::atomic<int> singleCounter{0};
+
+  Notifier fast{executor, [&] { ++fastCounter; }};
+  Notifier slow{executor, [&] { ++slowCounter; }};
+  Notifier single{executor, [&] { ++singleCounter; }};
+
+  fast.StartPeriodic(10_ms);
+  slow.StartPeriodic(25_ms);
+  single.StartSingle(15_ms);
+  frc::sim::StepTiming(100_ms);
+  EXPECT_EQ(10, fastCounter);
+  EXPECT_EQ(4, slowCounter);
+  EXPECT_EQ(1, singleCounter);
+
+  slow.Stop();
+  {
+    // Destroying a Notifier removes it from the executor
+    Notifier destroyed{executor, [&] { ++singleCounter; }};
+    destroyed.StartPeriodic(5_ms);
+  }
+  frc::sim::StepTiming(100_ms);
+  EXPECT_EQ(20, fastCounter);
+  EXPECT_EQ(4, slowCounter);
+  EXPECT_EQ(1, singleCounter);
+}
+
+TEST_F(NotifierTest, OverrunBudget) {
+  NotifierExecutor executor;
+  Notifier notifier{executor, [] { frc::sim::StepTimingAsync(5_ms); }};
+
+  notifier.SetOverrunBudget(10_ms);
+  notifier.StartSingle(10_ms);
+  frc::sim::StepTiming(10_ms);
+  EXPECT_EQ(0, notifier.GetOverrunCount());
+
+  notifier.SetOverrunBudget(2_ms);
+  notifier.StartSingle(10_ms);
+  frc::sim::StepTiming(10_ms);
+  EXPECT_EQ(1, notifier.GetOverrunCount());
+}
@@ -0,0 +1,48 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/OdometryThread.h"  // NOLINT(build/include_order)
+
+#include "frc/simulation/SimHooks.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+namespace {
+class OdometryThreadTest : public ::testing::Test {
+ protected:
+  void SetUp() override { frc::sim::PauseTiming(); }
+
+  void TearDown() override { frc::sim::ResumeTiming(); }
+};
+}  // namespace
+
+TEST_F(OdometryThreadTest, Update) {
+  int updates = 0;
+  units::second_t lastTimestamp = 0_s;
+  OdometryThread thread{[&](units::second_t timestamp) {
+                          ++updates;
+                          lastTimestamp = timestamp;
+                          return Pose2d{units::meter_t{1.0 * updates}, 2_m,
+                                        Rotation2d{90_deg}};
+                        },
+                        5_ms};
+
+  EXPECT_EQ(thread.GetUpdateCount(), 0u);
+  thread.Start();
+  frc::sim::StepTiming(20_ms);
+  thread.Stop();
+
+  // the odometry may be used once stopped
+  EXPECT_EQ(updates, 4);
+  EXPECT_EQ(thread.GetUpdateCount(), 4u);
+  auto latest = thread.GetLatest();
+  EXPECT_DOUBLE_EQ(latest.pose.X().to<double>(), 4.0);
+  EXPECT_DOUBLE_EQ(latest.pose.Y().to<double>(), 2.0);
+  EXPECT_NEAR(latest.pose.Rotation().Degrees().to<double>(), 90.0, 1e-9);
+  EXPECT_EQ(latest.timestamp, lastTimestamp);
+
+  frc::sim::StepTiming(20_ms);
+  EXPECT_EQ(updates, 4);
+}
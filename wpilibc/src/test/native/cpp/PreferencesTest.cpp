@@ -0,0 +1,32 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/Preferences.h"
+#include "gtest/gtest.h"
+
+TEST(PreferencesTest, Handles) {
+  auto kP = frc::Preferences::GetDoubleHandle("handleTestP", 1.5);
+  auto count = frc::Preferences::GetIntHandle("handleTestP", 7);
+  auto enabled = frc::Preferences::GetBooleanHandle("handleTestEnabled", true);
+  EXPECT_EQ(1.5, kP.Get());
+  EXPECT_EQ(7, count.Get());
+  EXPECT_TRUE(enabled.Get());
+
+  frc::Preferences::SetDouble("handleTestP", 2.75);
+  frc::Preferences::SetBoolean("handleTestEnabled", false);
+  EXPECT_EQ(2.75, kP.Get());
+  EXPECT_EQ(2, count.Get());
+  EXPECT_FALSE(enabled.Get());
+
+  // A handle for an existing key reads its value right away
+  EXPECT_EQ(2.75, frc::Preferences::GetDoubleHandle("handleTestP").Get());
+
+  // The wrong type reads as the default
+  EXPECT_TRUE(frc::Preferences::GetBooleanHandle("handleTestP", true).Get());
+
+  frc::Preferences::Remove("handleTestP");
+  frc::Preferences::Remove("handleTestEnabled");
+  EXPECT_EQ(1.5, kP.Get());
+  EXPECT_TRUE(enabled.Get());
+}
@@ -26,3 +26,36 @@ TEST(ScopedTracerTest, Timing) {
   std::string_view out = os.str();
   EXPECT_TRUE(wpi::starts_with(out, "	timing_test: 1.5"));
 }
+
+TEST(ScopedTracerTest, NestedEpochs) {
+  frc::Tracer tracer;
+  int outer = tracer.RegisterEpoch("outer");
+  int inner = tracer.RegisterEpoch("inner", outer);
+  EXPECT_EQ(inner, tracer.RegisterEpoch("outer/inner"));
+
+  frc::sim::PauseTiming();
+  for (int i = 0; i < 3; ++i) {
+    frc::ScopedTracer outerTracer(tracer, outer);
+    frc::sim::StepTiming(10_ms);
+    {
+      frc::ScopedTracer innerTracer(tracer, inner);
+      frc::sim::StepTiming(units::millisecond_t{20.0 * (i + 1)});
+    }
+  }
+  frc::sim::ResumeTiming();
+
+  auto outerStats = tracer.GetEpochStats(outer);
+  EXPECT_EQ(3, outerStats.count);
+  EXPECT_EQ(std::chrono::milliseconds{30}, outerStats.min);
+  EXPECT_EQ(std::chrono::milliseconds{70}, outerStats.max);
+
+  auto innerStats = tracer.GetEpochStats(inner);
+  EXPECT_EQ(3, innerStats.count);
+  EXPECT_EQ(std::chrono::milliseconds{20}, innerStats.min);
+  EXPECT_EQ(std::chrono::milliseconds{40}, innerStats.mean);
+  EXPECT_EQ(std::chrono::milliseconds{60}, innerStats.max);
+  EXPECT_EQ(std::chrono::milliseconds{60}, innerStats.p99);
+
+  tracer.ResetEpochStats();
+  EXPECT_EQ(0, tracer.GetEpochStats(inner).count);
+}
@@ -389,3 +389,56 @@ TEST_F(TimedRobotTest, AddPeriodicWithOffset) {
   robot.EndCompetition();
   robotThread.join();
 }
+
+TEST_F(TimedRobotTest, RateGroups) {
+  MockRobot robot;
+
+  std::atomic<uint32_t> fastCount{0};
+  std::atomic<uint32_t> dedicatedCount{0};
+  int fast = robot.AddRateGroup(5_ms);
+  robot.AddRateGroupCallback(fast, [&] { fastCount++; });
+  int dedicated = robot.AddRateGroup(10_ms, true);
+  robot.AddRateGroupCallback(dedicated, [&] { dedicatedCount++; });
+
+  // Expirations in this test (ms)
+  //
+  // The groups are offset to the middle of the largest gap between the runs
+  // before them: 2.5 ms for the 5 ms group, then 5 ms for the 10 ms group.
+  //
+  // Robot | Fast | Dedicated
+  // ========================
+  //    20 |  7.5 |        15
+  //    40 | 12.5 |        25
+  //       | 17.5 |        35
+  //       | 22.5 |
+  //       |  ... |
+
+  std::thread robotThread{[&] { robot.StartCompetition(); }};
+
+  frc::sim::DriverStationSim::SetEnabled(false);
+  frc::sim::DriverStationSim::NotifyNewData();
+  frc::sim::StepTiming(0_ms);  // Wait for Notifiers
+
+  EXPECT_EQ(0u, fastCount);
+  EXPECT_EQ(0u, dedicatedCount);
+
+  frc::sim::StepTiming(20_ms);
+
+  EXPECT_EQ(1u, robot.m_disabledPeriodicCount);
+  EXPECT_EQ(3u, fastCount);
+  EXPECT_EQ(1u, dedicatedCount);
+
+  frc::sim::StepTiming(20_ms);
+
+  EXPECT_EQ(2u, robot.m_disabledPeriodicCount);
+  EXPECT_EQ(7u, fastCount);
+  EXPECT_EQ(3u, dedicatedCount);
+
+  auto stats = robot.GetRateGroupStats(fast);
+  EXPECT_EQ(7, stats.runs);
+  EXPECT_EQ(0, stats.overruns);
+  EXPECT_EQ(3, robot.GetRateGroupStats(dedicated).runs);
+
+  robot.EndCompetition();
+  robotThread.join();
+}
@@ -106,3 +106,22 @@ TEST(ShuffleboardInstanceTest, NestedActuatorWidgetsAreDisabled) {
   EXPECT_FALSE(controllable)
       << "The nested actuator widget should have been disabled";
 }
+
+TEST(ShuffleboardInstanceTest, ComponentsAddedAfterUpdate) {
+  NTWrapper ntInst;
+  frc::detail::ShuffleboardInstance shuffleboardInst{ntInst.inst};
+
+  auto& layout = shuffleboardInst.GetTab("Tab").GetLayout("Title", "Layout");
+  shuffleboardInst.Update();
+
+  auto& widget = layout.Add("Value", "string");
+  shuffleboardInst.Update();
+  EXPECT_EQ("/Shuffleboard/Tab/Title/Value", widget.GetEntry().GetName());
+
+  // metadata changed after the first update is still published
+  widget.WithWidget("Text View");
+  shuffleboardInst.Update();
+  auto entry = ntInst.inst.GetEntry(
+      "/Shuffleboard/.metadata/Tab/Title/Value/PreferredComponent");
+  EXPECT_EQ("Text View", entry.GetString("Not Set"));
+}
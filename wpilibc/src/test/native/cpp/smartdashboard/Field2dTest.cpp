@@ -0,0 +1,57 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <networktables/NetworkTableInstance.h>
+
+#include "frc/smartdashboard/Field2d.h"
+#include "frc/smartdashboard/SmartDashboard.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+TEST(Field2dTest, LargePoseArrays) {
+  Field2d field;
+  SmartDashboard::PutData("Field2dTest", &field);
+  auto entry = nt::NetworkTableInstance::GetDefault().GetEntry(
+      "/SmartDashboard/Field2dTest/traj");
+
+  std::vector<Pose2d> poses;
+  for (int i = 0; i < 200; ++i) {
+    poses.emplace_back(units::meter_t{0.01 * i}, 1_m,
+                       Rotation2d{units::degree_t{0.5 * i}});
+  }
+  auto obj = field.GetObject("traj");
+  obj->SetPoses(poses);
+  auto value = entry.GetValue();
+  ASSERT_TRUE(value && value->IsRaw());
+  EXPECT_EQ(value->GetRaw().size(), 8u + 12u + 199u * 6u);
+
+  // unchanged poses are not republished
+  obj->SetPoses(poses);
+  EXPECT_EQ(entry.GetValue(), value);
+
+  // the poses are not rounded by the encoding
+  EXPECT_EQ(obj->GetPoses(), poses);
+
+  poses[100] = Pose2d{5_m, 5_m, 0_deg};
+  obj->SetPoses(poses);
+  EXPECT_NE(entry.GetValue(), value);
+}
+
+TEST(Field2dTest, SmallPoseArrays) {
+  Field2d field;
+  SmartDashboard::PutData("Field2dSmallTest", &field);
+  auto entry = nt::NetworkTableInstance::GetDefault().GetEntry(
+      "/SmartDashboard/Field2dSmallTest/Robot");
+
+  field.SetRobotPose(1_m, 2_m, 90_deg);
+  auto value = entry.GetValue();
+  ASSERT_TRUE(value && value->IsDoubleArray());
+  field.SetRobotPose(1_m, 2_m, 90_deg);
+  EXPECT_EQ(entry.GetValue(), value);
+  field.SetRobotPose(1_m, 3_m, 90_deg);
+  EXPECT_EQ(entry.GetDoubleArray({}), (std::vector<double>{1, 3, 90}));
+}
@@ -0,0 +1,76 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <networktables/NetworkTableInstance.h>
+
+#include "frc/smartdashboard/Mechanism2d.h"
+#include "frc/smartdashboard/MechanismLigament2d.h"
+#include "frc/smartdashboard/SmartDashboard.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+TEST(Mechanism2dTest, Immediate) {
+  Mechanism2d mech{3, 3};
+  auto root = mech.GetRoot("root", 1, 1);
+  auto ligament = root->Append<MechanismLigament2d>("arm", 2, 90_deg);
+  SmartDashboard::PutData("Mechanism2dTest", &mech);
+  auto inst = nt::NetworkTableInstance::GetDefault();
+  auto entry = inst.GetEntry("/SmartDashboard/Mechanism2dTest/root/arm/angle");
+  auto color = inst.GetEntry("/SmartDashboard/Mechanism2dTest/root/arm/color");
+  EXPECT_EQ(entry.GetDouble(0), 90);
+
+  ligament->SetAngle(45_deg);
+  EXPECT_EQ(entry.GetDouble(0), 45);
+
+  // unchanged values are not republished (doubles are read back as copies,
+  // so compare a string value)
+  auto value = color.GetValue();
+  ligament->SetColor({235, 137, 52});
+  ligament->SetAngle(45_deg);
+  EXPECT_EQ(color.GetValue(), value);
+  ligament->SetColor({0, 0, 0});
+  EXPECT_EQ(color.GetString(""), "#000000");
+
+  // changes from the dashboard are read back
+  entry.SetDouble(30);
+  EXPECT_EQ(ligament->GetAngle(), 30);
+}
+
+TEST(Mechanism2dTest, Batched) {
+  Mechanism2d mech{3, 3};
+  mech.SetBatched(true);
+  auto root = mech.GetRoot("root", 1, 1);
+  auto ligament = root->Append<MechanismLigament2d>("arm", 2, 90_deg);
+  SmartDashboard::PutData("Mechanism2dBatchedTest", &mech);
+  auto inst = nt::NetworkTableInstance::GetDefault();
+  auto angle = inst.GetEntry(
+      "/SmartDashboard/Mechanism2dBatchedTest/root/arm/angle");
+  auto pos = inst.GetEntry("/SmartDashboard/Mechanism2dBatchedTest/root/pos");
+  // publishing runs the first update
+  EXPECT_EQ(angle.GetDouble(0), 90);
+  EXPECT_EQ(pos.GetDoubleArray({}), (std::vector<double>{1, 1}));
+
+  ligament->SetAngle(45_deg);
+  ligament->SetAngle(60_deg);
+  root->SetPosition(2, 1);
+  EXPECT_EQ(angle.GetDouble(0), 90);
+  // a local change not yet published is not overwritten by the dashboard
+  EXPECT_EQ(ligament->GetAngle(), 60);
+  SmartDashboard::UpdateValues();
+  EXPECT_EQ(angle.GetDouble(0), 60);
+  EXPECT_EQ(pos.GetDoubleArray({}), (std::vector<double>{2, 1}));
+
+  auto value = pos.GetValue();
+  root->SetPosition(2, 1);
+  SmartDashboard::UpdateValues();
+  EXPECT_EQ(pos.GetValue(), value);
+
+  // leaving batched mode publishes pending changes
+  ligament->SetAngle(10_deg);
+  mech.SetBatched(false);
+  EXPECT_EQ(angle.GetDouble(0), 10);
+}
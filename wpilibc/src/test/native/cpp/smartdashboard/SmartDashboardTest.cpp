@@ -0,0 +1,98 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <wpi/sendable/Sendable.h>
+#include <wpi/sendable/SendableBuilder.h>
+#include <wpi/sendable/SendableHelper.h>
+
+#include "frc/simulation/SimHooks.h"
+#include "frc/smartdashboard/SmartDashboard.h"
+#include "gtest/gtest.h"
+
+namespace {
+class CountingSendable : public wpi::Sendable,
+                         public wpi::SendableHelper<CountingSendable> {
+ public:
+  void InitSendable(wpi::SendableBuilder& builder) override {
+    builder.AddDoubleProperty(
+        "value",
+        [this] {
+          ++getterCalls;
+          return value;
+        },
+        nullptr);
+  }
+
+  int getterCalls = 0;
+  double value = 0;
+};
+}  // namespace
+
+TEST(SmartDashboardTest, UpdateValues) {
+  CountingSendable sendable;
+  frc::SmartDashboard::PutData("UpdateValuesTest", &sendable);
+  auto entry = frc::SmartDashboard::GetEntry("UpdateValuesTest/value");
+
+  sendable.value = 1;
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(1, entry.GetDouble(0));
+
+  // An unchanged value isn't set again, so a change made elsewhere stays
+  entry.SetDouble(5);
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(5, entry.GetDouble(0));
+
+  sendable.value = 2;
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(2, entry.GetDouble(0));
+}
+
+TEST(SmartDashboardTest, UpdatePeriod) {
+  CountingSendable sendable;
+  frc::SmartDashboard::PutData("UpdatePeriodTest", &sendable);
+  frc::SmartDashboard::SetUpdatePeriod("UpdatePeriodTest", 100_ms);
+
+  frc::sim::PauseTiming();
+  int startCalls = sendable.getterCalls;
+  for (int i = 0; i < 10; ++i) {
+    frc::SmartDashboard::UpdateValues();
+    frc::sim::StepTiming(20_ms);
+  }
+  frc::sim::ResumeTiming();
+  // Updated at 0 ms and 100 ms
+  EXPECT_EQ(2, sendable.getterCalls - startCalls);
+
+  frc::SmartDashboard::SetUpdatePeriod("UpdatePeriodTest", 0_s);
+  startCalls = sendable.getterCalls;
+  frc::SmartDashboard::UpdateValues();
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(2, sendable.getterCalls - startCalls);
+}
+
+TEST(SmartDashboardTest, UpdateBudget) {
+  CountingSendable sendables[3];
+  frc::SmartDashboard::PutData("UpdateBudgetTest0", &sendables[0]);
+  frc::SmartDashboard::PutData("UpdateBudgetTest1", &sendables[1]);
+  frc::SmartDashboard::PutData("UpdateBudgetTest2", &sendables[2]);
+  frc::SmartDashboard::SetUpdateBudget(2, 0_s);
+
+  auto totalCalls = [&] {
+    return sendables[0].getterCalls + sendables[1].getterCalls +
+           sendables[2].getterCalls;
+  };
+  for (int i = 0; i < 10; ++i) {
+    int before = totalCalls();
+    frc::SmartDashboard::UpdateValues();
+    EXPECT_LE(totalCalls() - before, 2);
+  }
+  // Every Sendable still gets its turn
+  for (auto& sendable : sendables) {
+    EXPECT_GT(sendable.getterCalls, 0);
+  }
+
+  frc::SmartDashboard::SetUpdateBudget(0, 0_s);
+  int before = totalCalls();
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(3, totalCalls() - before);
+}
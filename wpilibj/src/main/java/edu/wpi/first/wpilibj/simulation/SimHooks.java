@@ -71,4 +71,44 @@ public final class SimHooks {
   public static void stepTimingAsync(double deltaSeconds) {
     SimulatorJNI.stepTimingAsync((long) (deltaSeconds * 1e6));
   }
+
+  /**
+   * Run the simulator time as fast as possible. While enabled, the time is paused and jumps
+   * directly to the next notifier alarm whenever all notifiers are waiting. The time stays paused
+   * when this is disabled.
+   *
+   * @param enable true to enable
+   */
+  public static void setTimingFastForward(boolean enable) {
+    SimulatorJNI.setTimingFastForward(enable);
+  }
+
+  /**
+   * Check if the simulator time is running as fast as possible.
+   *
+   * @return true if enabled
+   */
+  public static boolean isTimingFastForward() {
+    return SimulatorJNI.isTimingFastForward();
+  }
+
+  /**
+   * Run the simulator time in lock step. The time is fast forwarded, and the notifiers due at each
+   * alarm run one at a time in creation order, so a program driven entirely by notifiers behaves
+   * the same way on every run. Disabling lock step also disables fast forwarding.
+   *
+   * @param enable true to enable
+   */
+  public static void setTimingLockStep(boolean enable) {
+    SimulatorJNI.setTimingLockStep(enable);
+  }
+
+  /**
+   * Check if the simulator time is running in lock step.
+   *
+   * @return true if enabled
+   */
+  public static boolean isTimingLockStep() {
+    return SimulatorJNI.isTimingLockStep();
+  }
 }
@@ -0,0 +1,91 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/RandomStream.h"
+
+#include <cmath>
+#include <random>
+
+#include <wpi/numbers>
+
+using namespace frc;
+
+// Uses the Box-Muller transform to turn two uniform numbers into two normally
+// distributed ones.
+static void GaussianPair(RandomStream& gen, double* a, double* b) {
+  // 1 - Uniform() is in (0, 1], so the log is finite
+  double r = std::sqrt(-2.0 * std::log(1.0 - gen.Uniform()));
+  double theta = 2.0 * wpi::numbers::pi * gen.Uniform();
+  *a = r * std::cos(theta);
+  *b = r * std::sin(theta);
+}
+
+RandomStream::RandomStream() : RandomStream(GetThreadDefault()()) {}
+
+void RandomStream::Seed(uint64_t seed) {
+  // splitmix64, as recommended for seeding xoshiro; it never produces an
+  // all-zero state
+  for (auto& s : m_s) {
+    uint64_t z = (seed += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    s = z ^ (z >> 31);
+  }
+  m_hasSpare = false;
+}
+
+double RandomStream::Gaussian() {
+  if (m_hasSpare) {
+    m_hasSpare = false;
+    return m_spare;
+  }
+  double result;
+  GaussianPair(*this, &result, &m_spare);
+  m_hasSpare = true;
+  return result;
+}
+
+void RandomStream::FillGaussian(double* out, size_t count) {
+  size_t i = 0;
+  if (m_hasSpare && count > 0) {
+    out[i++] = m_spare;
+    m_hasSpare = false;
+  }
+  for (; i + 1 < count; i += 2) {
+    GaussianPair(*this, &out[i], &out[i + 1]);
+  }
+  if (i < count) {
+    out[i] = Gaussian();
+  }
+}
+
+RandomStream RandomStream::Split() {
+  // the xoshiro256 jump polynomial; advances by 2^128 steps
+  static constexpr uint64_t kJump[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+                                       0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+  RandomStream result{NoSeed{}};
+  result.m_s = m_s;
+  std::array<uint64_t, 4> s{};
+  for (uint64_t jump : kJump) {
+    for (int b = 0; b < 64; ++b) {
+      if (jump & (uint64_t{1} << b)) {
+        for (int i = 0; i < 4; ++i) {
+          s[i] ^= m_s[i];
+        }
+      }
+      (*this)();
+    }
+  }
+  m_s = s;
+  m_hasSpare = false;
+  return result;
+}
+
+RandomStream& RandomStream::GetThreadDefault() {
+  thread_local RandomStream stream{[] {
+    std::random_device rd;
+    return (uint64_t{rd()} << 32) | rd();
+  }()};
+  return stream;
+}
@@ -4,6 +4,7 @@
 
 #include "frc/estimator/DifferentialDrivePoseEstimator.h"
 
+#include <wpi/SmallVector.h>
 #include <wpi/timestamp.h>
 
 #include "frc/StateSpaceUtil.h"
@@ -17,15 +18,7 @@ DifferentialDrivePoseEstimator::DifferentialDrivePoseEstimator(
     const wpi::array<double, 3>& localMeasurementStdDevs,
     const wpi::array<double, 3>& visionMeasurmentStdDevs,
     units::second_t nominalDt)
-    : m_observer(
-          &DifferentialDrivePoseEstimator::F,
-          [](const Eigen::Matrix<double, 5, 1>& x,
-             const Eigen::Matrix<double, 3, 1>& u) {
-            return frc::MakeMatrix<3, 1>(x(3, 0), x(4, 0), x(2, 0));
-          },
-          stateStdDevs, localMeasurementStdDevs, frc::AngleMean<5, 5>(2),
-          frc::AngleMean<3, 5>(2), frc::AngleResidual<5>(2),
-          frc::AngleResidual<3>(2), frc::AngleAdd<5>(2), nominalDt),
+    : m_observer(Model{}, stateStdDevs, localMeasurementStdDevs, nominalDt),
       m_nominalDt(nominalDt) {
   SetVisionMeasurementStdDevs(visionMeasurmentStdDevs);
 
@@ -36,8 +29,17 @@ DifferentialDrivePoseEstimator::DifferentialDrivePoseEstimator(
         u, y,
         [](const Eigen::Matrix<double, 5, 1>& x,
            const Eigen::Matrix<double, 3, 1>&) { return x.block<3, 1>(0, 0); },
-        m_visionContR, frc::AngleMean<3, 5>(2), frc::AngleResidual<3>(2),
-        frc::AngleResidual<5>(2), frc::AngleAdd<5>(2));
+        m_visionContR,
+        [](const auto& sigmas, const auto& Wm) {
+          return frc::AngleMean<3, 5>(sigmas, Wm, 2);
+        },
+        [](const auto& a, const auto& b) {
+          return frc::AngleResidual<3>(a, b, 2);
+        },
+        [](const auto& a, const auto& b) {
+          return frc::AngleResidual<5>(a, b, 2);
+        },
+        [](const auto& a, const auto& b) { return frc::AngleAdd<5>(a, b, 2); });
   };
 
   m_gyroOffset = initialPose.Rotation() - gyroAngle;
@@ -73,7 +75,30 @@ void DifferentialDrivePoseEstimator::AddVisionMeasurement(
     const Pose2d& visionRobotPose, units::second_t timestamp) {
   m_latencyCompensator.ApplyPastGlobalMeasurement<3>(
       &m_observer, m_nominalDt, PoseTo3dVector(visionRobotPose),
-      m_visionCorrect, timestamp);
+      m_visionCorrect, timestamp,
+      m_latencyReplayMode == LatencyReplayMode::kDeltas ? &ReplayPoseDelta<5>
+                                                        : nullptr);
+}
+
+void DifferentialDrivePoseEstimator::AddVisionMeasurements(
+    wpi::span<const VisionMeasurement> measurements) {
+  wpi::SmallVector<units::second_t, 8> timestamps;
+  for (auto&& measurement : measurements) {
+    timestamps.emplace_back(measurement.timestamp);
+  }
+  Eigen::Matrix<double, 3, 3> visionContR = m_visionContR;
+  m_latencyCompensator.ApplyPastGlobalMeasurements(
+      &m_observer, m_nominalDt, timestamps,
+      [&](const Eigen::Matrix<double, 3, 1>& u, size_t i) {
+        auto& measurement = measurements[i];
+        m_visionContR = measurement.stdDevs
+                            ? frc::MakeCovMatrix(*measurement.stdDevs)
+                            : visionContR;
+        m_visionCorrect(u, PoseTo3dVector(measurement.pose));
+      },
+      m_latencyReplayMode == LatencyReplayMode::kDeltas ? &ReplayPoseDelta<5>
+                                                        : nullptr);
+  m_visionContR = visionContR;
 }
 
 Pose2d DifferentialDrivePoseEstimator::Update(
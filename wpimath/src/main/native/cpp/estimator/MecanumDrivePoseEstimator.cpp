@@ -4,6 +4,7 @@
 
 #include "frc/estimator/MecanumDrivePoseEstimator.h"
 
+#include <wpi/SmallVector.h>
 #include <wpi/timestamp.h>
 
 #include "frc/StateSpaceUtil.h"
@@ -18,15 +19,7 @@ frc::MecanumDrivePoseEstimator::MecanumDrivePoseEstimator(
     const wpi::array<double, 1>& localMeasurementStdDevs,
     const wpi::array<double, 3>& visionMeasurementStdDevs,
     units::second_t nominalDt)
-    : m_observer([](const Eigen::Matrix<double, 3, 1>& x,
-                    const Eigen::Matrix<double, 3, 1>& u) { return u; },
-                 [](const Eigen::Matrix<double, 3, 1>& x,
-                    const Eigen::Matrix<double, 3, 1>& u) {
-                   return x.block<1, 1>(2, 0);
-                 },
-                 stateStdDevs, localMeasurementStdDevs, frc::AngleMean<3, 3>(2),
-                 frc::AngleMean<1, 3>(0), frc::AngleResidual<3>(2),
-                 frc::AngleResidual<1>(0), frc::AngleAdd<3>(2), nominalDt),
+    : m_observer(Model{}, stateStdDevs, localMeasurementStdDevs, nominalDt),
       m_kinematics(kinematics),
       m_nominalDt(nominalDt) {
   SetVisionMeasurementStdDevs(visionMeasurementStdDevs);
@@ -38,8 +31,17 @@ frc::MecanumDrivePoseEstimator::MecanumDrivePoseEstimator(
         u, y,
         [](const Eigen::Matrix<double, 3, 1>& x,
            const Eigen::Matrix<double, 3, 1>&) { return x; },
-        m_visionContR, frc::AngleMean<3, 3>(2), frc::AngleResidual<3>(2),
-        frc::AngleResidual<3>(2), frc::AngleAdd<3>(2));
+        m_visionContR,
+        [](const auto& sigmas, const auto& Wm) {
+          return frc::AngleMean<3, 3>(sigmas, Wm, 2);
+        },
+        [](const auto& a, const auto& b) {
+          return frc::AngleResidual<3>(a, b, 2);
+        },
+        [](const auto& a, const auto& b) {
+          return frc::AngleResidual<3>(a, b, 2);
+        },
+        [](const auto& a, const auto& b) { return frc::AngleAdd<3>(a, b, 2); });
   };
 
   // Set initial state.
@@ -77,7 +79,30 @@ void frc::MecanumDrivePoseEstimator::AddVisionMeasurement(
     const Pose2d& visionRobotPose, units::second_t timestamp) {
   m_latencyCompensator.ApplyPastGlobalMeasurement<3>(
       &m_observer, m_nominalDt, PoseTo3dVector(visionRobotPose),
-      m_visionCorrect, timestamp);
+      m_visionCorrect, timestamp,
+      m_latencyReplayMode == LatencyReplayMode::kDeltas ? &ReplayPoseDelta<3>
+                                                        : nullptr);
+}
+
+void frc::MecanumDrivePoseEstimator::AddVisionMeasurements(
+    wpi::span<const VisionMeasurement> measurements) {
+  wpi::SmallVector<units::second_t, 8> timestamps;
+  for (auto&& measurement : measurements) {
+    timestamps.emplace_back(measurement.timestamp);
+  }
+  Eigen::Matrix<double, 3, 3> visionContR = m_visionContR;
+  m_latencyCompensator.ApplyPastGlobalMeasurements(
+      &m_observer, m_nominalDt, timestamps,
+      [&](const Eigen::Matrix<double, 3, 1>& u, size_t i) {
+        auto& measurement = measurements[i];
+        m_visionContR = measurement.stdDevs
+                            ? frc::MakeCovMatrix(*measurement.stdDevs)
+                            : visionContR;
+        m_visionCorrect(u, PoseTo3dVector(measurement.pose));
+      },
+      m_latencyReplayMode == LatencyReplayMode::kDeltas ? &ReplayPoseDelta<3>
+                                                        : nullptr);
+  m_visionContR = visionContR;
 }
 
 Pose2d frc::MecanumDrivePoseEstimator::Update(
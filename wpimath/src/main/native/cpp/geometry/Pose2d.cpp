@@ -10,21 +10,6 @@
 
 using namespace frc;
 
-Pose2d::Pose2d(Translation2d translation, Rotation2d rotation)
-    : m_translation(translation), m_rotation(rotation) {}
-
-Pose2d::Pose2d(units::meter_t x, units::meter_t y, Rotation2d rotation)
-    : m_translation(x, y), m_rotation(rotation) {}
-
-Pose2d Pose2d::operator+(const Transform2d& other) const {
-  return TransformBy(other);
-}
-
-Transform2d Pose2d::operator-(const Pose2d& other) const {
-  const auto pose = this->RelativeTo(other);
-  return Transform2d(pose.Translation(), pose.Rotation());
-}
-
 bool Pose2d::operator==(const Pose2d& other) const {
   return m_translation == other.m_translation && m_rotation == other.m_rotation;
 }
@@ -33,14 +18,20 @@ bool Pose2d::operator!=(const Pose2d& other) const {
   return !operator==(other);
 }
 
-Pose2d Pose2d::TransformBy(const Transform2d& other) const {
-  return {m_translation + (other.Translation().RotateBy(m_rotation)),
-          m_rotation + other.Rotation()};
+void Pose2d::TransformBy(wpi::span<const Pose2d> poses,
+                         const Transform2d& other, wpi::span<Pose2d> out) {
+  for (size_t i = 0; i < poses.size(); ++i) {
+    out[i] = poses[i].TransformBy(other);
+  }
 }
 
-Pose2d Pose2d::RelativeTo(const Pose2d& other) const {
-  const Transform2d transform{other, *this};
-  return {transform.Translation(), transform.Rotation()};
+void Pose2d::RelativeTo(wpi::span<const Pose2d> poses, const Pose2d& other,
+                        wpi::span<Pose2d> out) {
+  const auto inverse = -other.m_rotation;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    out[i] = {(poses[i].m_translation - other.m_translation).RotateBy(inverse),
+              poses[i].m_rotation + inverse};
+  }
 }
 
 Pose2d Pose2d::Exp(const Twist2d& twist) const {
@@ -0,0 +1,188 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/geometry/Pose2dArrayEncoding.h"
+
+#include <stdint.h>
+
+#include <cmath>
+
+#include <wpi/Endian.h>
+#include <wpi/MathExtras.h>
+
+using namespace frc;
+
+static constexpr char kMagic[4] = {'\xff', 'P', '2', 'D'};
+static constexpr size_t kHeaderSize = 8;
+static constexpr size_t kFullSize = 12;
+static constexpr size_t kDeltaSize = 6;
+static constexpr int16_t kEscape = INT16_MIN;
+
+// delta scales: millimeters and hundredths of a degree
+static constexpr double kPosScale = 1000.0;
+static constexpr double kRotScale = 100.0;
+
+namespace {
+// The decoded value of one coordinate, which deltas are taken from; the
+// encoder and decoder update it with the same arithmetic.
+struct Coordinate {
+  explicit Coordinate(double scale) : scale{scale} {}
+
+  // returns false if the delta to value does not fit
+  bool GetDelta(double v, int16_t* delta) const {
+    double d = std::round((v - value) * scale);
+    if (!(std::abs(d) <= INT16_MAX)) {
+      return false;
+    }
+    *delta = static_cast<int16_t>(d);
+    return true;
+  }
+  void ApplyDelta(int16_t delta) { value += delta / scale; }
+  void SetFull(float v) { value = v; }
+
+  double scale;
+  double value = 0;
+};
+}  // namespace
+
+static void AppendInt16(std::string* out, int16_t v) {
+  char buf[2];
+  wpi::support::endian::write16le(buf, v);
+  out->append(buf, 2);
+}
+
+static void AppendFloat(std::string* out, float v) {
+  char buf[4];
+  wpi::support::endian::write32le(buf, wpi::FloatToBits(v));
+  out->append(buf, 4);
+}
+
+void frc::EncodePose2dArray(wpi::span<const Pose2d> poses, std::string* out) {
+  out->clear();
+  out->reserve(kHeaderSize + kFullSize +
+               (poses.empty() ? 0 : (poses.size() - 1) * kDeltaSize));
+  out->append(kMagic, sizeof(kMagic));
+  char count[4];
+  wpi::support::endian::write32le(count, poses.size());
+  out->append(count, 4);
+
+  Coordinate x{kPosScale};
+  Coordinate y{kPosScale};
+  Coordinate rot{kRotScale};
+  bool first = true;
+  for (auto&& pose : poses) {
+    double vx = pose.X().to<double>();
+    double vy = pose.Y().to<double>();
+    double vrot = pose.Rotation().Degrees().to<double>();
+    int16_t dx, dy, drot;
+    if (!first && x.GetDelta(vx, &dx) && y.GetDelta(vy, &dy) &&
+        rot.GetDelta(vrot, &drot)) {
+      AppendInt16(out, dx);
+      AppendInt16(out, dy);
+      AppendInt16(out, drot);
+      x.ApplyDelta(dx);
+      y.ApplyDelta(dy);
+      rot.ApplyDelta(drot);
+    } else {
+      if (!first) {
+        AppendInt16(out, kEscape);
+      }
+      float fx = vx;
+      float fy = vy;
+      float frot = vrot;
+      AppendFloat(out, fx);
+      AppendFloat(out, fy);
+      AppendFloat(out, frot);
+      x.SetFull(fx);
+      y.SetFull(fy);
+      rot.SetFull(frot);
+    }
+    first = false;
+  }
+}
+
+static bool IsCompact(std::string_view data) {
+  return data.size() >= kHeaderSize &&
+         data.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) == 0;
+}
+
+std::optional<size_t> frc::GetEncodedPose2dArraySize(std::string_view data) {
+  if (IsCompact(data)) {
+    size_t count = wpi::support::endian::read32le(data.data() + 4);
+    // reject counts the data is too short for
+    size_t minSize =
+        kHeaderSize + (count == 0 ? 0 : kFullSize + (count - 1) * kDeltaSize);
+    if (count > data.size() || data.size() < minSize) {
+      return {};
+    }
+    return count;
+  }
+  if ((data.size() % 24) != 0) {
+    return {};
+  }
+  return data.size() / 24;
+}
+
+static Pose2d MakePose(double x, double y, double rot) {
+  return Pose2d{units::meter_t{x}, units::meter_t{y},
+                Rotation2d{units::degree_t{rot}}};
+}
+
+bool frc::DecodePose2dArray(std::string_view data, wpi::span<Pose2d> poses) {
+  auto count = GetEncodedPose2dArraySize(data);
+  if (!count || *count != poses.size()) {
+    return false;
+  }
+
+  const char* p = data.data();
+  const char* end = p + data.size();
+  if (!IsCompact(data)) {
+    for (auto&& pose : poses) {
+      double x = wpi::BitsToDouble(wpi::support::endian::read64be(p));
+      double y = wpi::BitsToDouble(wpi::support::endian::read64be(p + 8));
+      double rot = wpi::BitsToDouble(wpi::support::endian::read64be(p + 16));
+      pose = MakePose(x, y, rot);
+      p += 24;
+    }
+    return true;
+  }
+
+  p += kHeaderSize;
+  Coordinate x{kPosScale};
+  Coordinate y{kPosScale};
+  Coordinate rot{kRotScale};
+  bool first = true;
+  for (auto&& pose : poses) {
+    bool full = first;
+    if (!first) {
+      if ((end - p) < static_cast<ptrdiff_t>(kDeltaSize)) {
+        return false;
+      }
+      int16_t dx = wpi::support::endian::read16le(p);
+      int16_t dy = wpi::support::endian::read16le(p + 2);
+      int16_t drot = wpi::support::endian::read16le(p + 4);
+      if (dx == kEscape) {
+        full = true;
+        p += 2;
+      } else {
+        x.ApplyDelta(dx);
+        y.ApplyDelta(dy);
+        rot.ApplyDelta(drot);
+        p += kDeltaSize;
+      }
+    }
+    if (full) {
+      if ((end - p) < static_cast<ptrdiff_t>(kFullSize)) {
+        return false;
+      }
+      x.SetFull(wpi::BitsToFloat(wpi::support::endian::read32le(p)));
+      y.SetFull(wpi::BitsToFloat(wpi::support::endian::read32le(p + 4)));
+      rot.SetFull(wpi::BitsToFloat(wpi::support::endian::read32le(p + 8)));
+      p += kFullSize;
+    }
+    pose = MakePose(x.value, y.value, rot.value);
+    first = false;
+  }
+  return p == end;
+}
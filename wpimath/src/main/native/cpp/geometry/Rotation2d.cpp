@@ -31,23 +31,12 @@ Rotation2d::Rotation2d(double x, double y) {
     m_sin = 0.0;
     m_cos = 1.0;
   }
-  m_value = units::radian_t(std::atan2(m_sin, m_cos));
-}
-
-Rotation2d Rotation2d::operator+(const Rotation2d& other) const {
-  return RotateBy(other);
-}
-
-Rotation2d Rotation2d::operator-(const Rotation2d& other) const {
-  return *this + -other;
-}
-
-Rotation2d Rotation2d::operator-() const {
-  return Rotation2d(-m_value);
+  // The angle is computed when it's asked for
+  m_value = kUnknownAngle;
 }
 
 Rotation2d Rotation2d::operator*(double scalar) const {
-  return Rotation2d(m_value * scalar);
+  return Rotation2d(Radians() * scalar);
 }
 
 bool Rotation2d::operator==(const Rotation2d& other) const {
@@ -58,11 +47,6 @@ bool Rotation2d::operator!=(const Rotation2d& other) const {
   return !operator==(other);
 }
 
-Rotation2d Rotation2d::RotateBy(const Rotation2d& other) const {
-  return {Cos() * other.Cos() - Sin() * other.Sin(),
-          Cos() * other.Sin() + Sin() * other.Cos()};
-}
-
 void frc::to_json(wpi::json& json, const Rotation2d& rotation) {
   json = wpi::json{{"radians", rotation.Radians().to<double>()}};
 }
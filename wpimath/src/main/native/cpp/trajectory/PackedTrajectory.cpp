@@ -0,0 +1,165 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/PackedTrajectory.h"
+
+#include <algorithm>
+
+#include <wpi/numbers>
+
+#include "units/math.h"
+
+using namespace frc;
+
+PackedTrajectory::PackedTrajectory(const Trajectory& trajectory) {
+  const auto& states = trajectory.States();
+  m_t.reserve(states.size());
+  m_velocity.reserve(states.size());
+  m_acceleration.reserve(states.size());
+  m_x.reserve(states.size());
+  m_y.reserve(states.size());
+  m_heading.reserve(states.size());
+  m_curvature.reserve(states.size());
+  for (auto&& state : states) {
+    m_t.push_back(state.t);
+    m_velocity.push_back(state.velocity);
+    m_acceleration.push_back(state.acceleration);
+    m_x.push_back(state.pose.X());
+    m_y.push_back(state.pose.Y());
+    m_heading.push_back(state.pose.Rotation().Radians());
+    m_curvature.push_back(state.curvature);
+  }
+}
+
+Trajectory PackedTrajectory::ToTrajectory() const {
+  std::vector<Trajectory::State> states;
+  states.reserve(size());
+  for (size_t i = 0; i < size(); ++i) {
+    states.push_back(GetState(i));
+  }
+  return Trajectory{states};
+}
+
+Trajectory::State PackedTrajectory::GetState(size_t i) const {
+  return {m_t[i], m_velocity[i], m_acceleration[i],
+          Pose2d{m_x[i], m_y[i], m_heading[i]}, m_curvature[i]};
+}
+
+Trajectory::State PackedTrajectory::Sample(units::second_t t) const {
+  if (t <= m_t.front()) {
+    return GetState(0);
+  }
+  if (t >= m_t.back()) {
+    return GetState(size() - 1);
+  }
+
+  // Use binary search to get the element with a timestamp no less than the
+  // requested timestamp. This starts at 1 because we use the previous state
+  // later on for interpolation.
+  return Interpolate(
+      std::lower_bound(m_t.cbegin() + 1, m_t.cend(), t) - m_t.cbegin(), t);
+}
+
+void PackedTrajectory::Sample(wpi::span<const units::second_t> times,
+                              wpi::span<Trajectory::State> states) const {
+  size_t index = 1;
+  for (size_t i = 0; i < times.size(); ++i) {
+    auto t = times[i];
+    if (t <= m_t.front()) {
+      states[i] = GetState(0);
+    } else if (t >= m_t.back()) {
+      states[i] = GetState(size() - 1);
+    } else {
+      if (m_t[index - 1] >= t) {
+        // Not in increasing order; search from the start.
+        index = std::lower_bound(m_t.cbegin() + 1, m_t.cend(), t) -
+                m_t.cbegin();
+      } else {
+        while (m_t[index] < t) {
+          ++index;
+        }
+      }
+      states[i] = Interpolate(index, t);
+    }
+  }
+}
+
+Trajectory::State PackedTrajectory::Interpolate(size_t index,
+                                                units::second_t t) const {
+  // If the difference in states is negligible, then we are spot on!
+  if (units::math::abs(m_t[index] - m_t[index - 1]) < 1E-9_s) {
+    return GetState(index);
+  }
+  // Interpolate between the two states for the state that we want.
+  return GetState(index - 1).Interpolate(
+      GetState(index), (t - m_t[index - 1]) / (m_t[index] - m_t[index - 1]));
+}
+
+PackedTrajectory PackedTrajectory::TransformBy(
+    const Transform2d& transform) const {
+  // Each pose keeps its offset from the first pose, relative to the first
+  // pose's heading, so all of them are turned by the change in the first
+  // pose's heading, about the first pose, and moved with it.
+  Pose2d firstPose{m_x[0], m_y[0], m_heading[0]};
+  Pose2d newFirstPose = firstPose + transform;
+  Rotation2d rotation = newFirstPose.Rotation() - firstPose.Rotation();
+  return Transformed(rotation, newFirstPose.Translation() -
+                                   firstPose.Translation().RotateBy(rotation));
+}
+
+PackedTrajectory PackedTrajectory::RelativeTo(const Pose2d& pose) const {
+  Rotation2d rotation = -pose.Rotation();
+  return Transformed(rotation, -pose.Translation().RotateBy(rotation));
+}
+
+PackedTrajectory PackedTrajectory::Transformed(
+    const Rotation2d& rotation, const Translation2d& translation) const {
+  PackedTrajectory result{*this};
+  double cos = rotation.Cos();
+  double sin = rotation.Sin();
+  double dx = translation.X().value();
+  double dy = translation.Y().value();
+  double dtheta = rotation.Radians().value();
+  for (size_t i = 0; i < size(); ++i) {
+    double x = m_x[i].value();
+    double y = m_y[i].value();
+    result.m_x[i] = units::meter_t{cos * x - sin * y + dx};
+    result.m_y[i] = units::meter_t{sin * x + cos * y + dy};
+
+    // Keep headings in (-pi, pi], as Rotation2d addition does
+    double theta = m_heading[i].value() + dtheta;
+    theta = theta > wpi::numbers::pi ? theta - 2 * wpi::numbers::pi : theta;
+    theta = theta <= -wpi::numbers::pi ? theta + 2 * wpi::numbers::pi : theta;
+    result.m_heading[i] = units::radian_t{theta};
+  }
+  return result;
+}
+
+PackedTrajectory PackedTrajectory::operator+(
+    const PackedTrajectory& other) const {
+  // If this is a default constructed trajectory with no states, then we can
+  // simply return the rhs trajectory.
+  if (m_t.empty()) {
+    return other;
+  }
+
+  // Here we omit the first state of the other trajectory because we don't want
+  // two time points with different states.
+  PackedTrajectory result{*this};
+  auto append = [](auto& to, const auto& from) {
+    to.insert(to.end(), from.begin() + 1, from.end());
+  };
+  size_t offset = size();
+  append(result.m_t, other.m_t);
+  for (size_t i = offset; i < result.m_t.size(); ++i) {
+    result.m_t[i] += TotalTime();
+  }
+  append(result.m_velocity, other.m_velocity);
+  append(result.m_acceleration, other.m_acceleration);
+  append(result.m_x, other.m_x);
+  append(result.m_y, other.m_y);
+  append(result.m_heading, other.m_heading);
+  append(result.m_curvature, other.m_curvature);
+  return result;
+}
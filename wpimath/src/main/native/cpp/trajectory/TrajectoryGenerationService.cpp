@@ -0,0 +1,181 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/TrajectoryGenerationService.h"
+
+#include <cstring>
+#include <utility>
+
+#include <wpi/Hashing.h>
+
+using namespace frc;
+
+namespace {
+enum Kind { kCubicControlVectors, kCubicPoses, kQuinticControlVectors, kPoses };
+}  // namespace
+
+static void Add(std::vector<uint64_t>& values, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  values.push_back(bits);
+}
+
+static void Add(std::vector<uint64_t>& values, const Translation2d& point) {
+  Add(values, point.X().value());
+  Add(values, point.Y().value());
+}
+
+static void Add(std::vector<uint64_t>& values, const Pose2d& pose) {
+  Add(values, pose.Translation());
+  Add(values, pose.Rotation().Radians().value());
+}
+
+template <int Degree>
+static void Add(std::vector<uint64_t>& values,
+                const typename Spline<Degree>::ControlVector& vector) {
+  for (double x : vector.x) {
+    Add(values, x);
+  }
+  for (double y : vector.y) {
+    Add(values, y);
+  }
+}
+
+size_t TrajectoryGenerationService::KeyHash::operator()(const Key& key) const {
+  return wpi::hash_combine(
+      key.kind, key.config,
+      wpi::hash_combine_range(key.values.begin(), key.values.end()));
+}
+
+TrajectoryGenerationService::TrajectoryGenerationService(
+    size_t cacheSize, const wpi::ThreadPool::Options& options)
+    : m_cacheSize{cacheSize}, m_pool{options} {}
+
+TrajectoryGenerationService::~TrajectoryGenerationService() = default;
+
+wpi::future<Trajectory> TrajectoryGenerationService::GenerateTrajectory(
+    const Spline<3>::ControlVector& initial,
+    std::vector<Translation2d> interiorWaypoints,
+    const Spline<3>::ControlVector& end,
+    std::shared_ptr<const TrajectoryConfig> config) {
+  Key key{kCubicControlVectors, {}, config.get()};
+  Add<3>(key.values, initial);
+  for (auto&& waypoint : interiorWaypoints) {
+    Add(key.values, waypoint);
+  }
+  Add<3>(key.values, end);
+  return Generate(std::move(key), config,
+                  [=, interiorWaypoints = std::move(interiorWaypoints)](
+                      wpi::ThreadPool& pool) {
+                    return TrajectoryGenerator::GenerateTrajectory(
+                        initial, interiorWaypoints, end, *config, pool);
+                  });
+}
+
+wpi::future<Trajectory> TrajectoryGenerationService::GenerateTrajectory(
+    const Pose2d& start, std::vector<Translation2d> interiorWaypoints,
+    const Pose2d& end, std::shared_ptr<const TrajectoryConfig> config) {
+  Key key{kCubicPoses, {}, config.get()};
+  Add(key.values, start);
+  for (auto&& waypoint : interiorWaypoints) {
+    Add(key.values, waypoint);
+  }
+  Add(key.values, end);
+  return Generate(std::move(key), config,
+                  [=, interiorWaypoints = std::move(interiorWaypoints)](
+                      wpi::ThreadPool& pool) {
+                    return TrajectoryGenerator::GenerateTrajectory(
+                        start, interiorWaypoints, end, *config, pool);
+                  });
+}
+
+wpi::future<Trajectory> TrajectoryGenerationService::GenerateTrajectory(
+    std::vector<Spline<5>::ControlVector> controlVectors,
+    std::shared_ptr<const TrajectoryConfig> config) {
+  Key key{kQuinticControlVectors, {}, config.get()};
+  for (auto&& vector : controlVectors) {
+    Add<5>(key.values, vector);
+  }
+  return Generate(
+      std::move(key), config,
+      [=, controlVectors = std::move(controlVectors)](wpi::ThreadPool& pool) {
+        return TrajectoryGenerator::GenerateTrajectory(controlVectors, *config,
+                                                       pool);
+      });
+}
+
+wpi::future<Trajectory> TrajectoryGenerationService::GenerateTrajectory(
+    std::vector<Pose2d> waypoints,
+    std::shared_ptr<const TrajectoryConfig> config) {
+  Key key{kPoses, {}, config.get()};
+  for (auto&& waypoint : waypoints) {
+    Add(key.values, waypoint);
+  }
+  return Generate(
+      std::move(key), config,
+      [=, waypoints = std::move(waypoints)](wpi::ThreadPool& pool) {
+        return TrajectoryGenerator::GenerateTrajectory(waypoints, *config,
+                                                       pool);
+      });
+}
+
+void TrajectoryGenerationService::ClearCache() {
+  std::scoped_lock lock{m_mutex};
+  // generation tasks hold their entries, so still deliver to their waiters
+  m_entries.clear();
+  m_order.clear();
+}
+
+uint64_t TrajectoryGenerationService::GetCacheHits() const {
+  std::scoped_lock lock{m_mutex};
+  return m_hits;
+}
+
+wpi::future<Trajectory> TrajectoryGenerationService::Generate(
+    Key key, std::shared_ptr<const TrajectoryConfig> config,
+    wpi::unique_function<Trajectory(wpi::ThreadPool& pool)> generate) {
+  std::scoped_lock lock{m_mutex};
+  auto& entry = m_entries[key];
+  if (entry) {
+    ++m_hits;
+    if (entry->result) {
+      return wpi::make_ready_future(Trajectory{*entry->result});
+    }
+    return entry->waiters.emplace_back().get_future();
+  }
+
+  entry = std::make_shared<Entry>();
+  entry->config = std::move(config);
+  auto future = entry->waiters.emplace_back().get_future();
+  m_order.emplace_back(std::move(key));
+  m_pool.Post([this, entry, generate = std::move(generate)]() mutable {
+    auto trajectory = generate(m_pool);
+    std::vector<wpi::promise<Trajectory>> waiters;
+    {
+      std::scoped_lock lock{m_mutex};
+      entry->result = trajectory;
+      waiters.swap(entry->waiters);
+      Evict();
+    }
+    for (size_t i = 0; i + 1 < waiters.size(); ++i) {
+      waiters[i].set_value(Trajectory{trajectory});
+    }
+    waiters.back().set_value(std::move(trajectory));
+  });
+  return future;
+}
+
+void TrajectoryGenerationService::Evict() {
+  while (m_entries.size() > m_cacheSize && !m_order.empty()) {
+    auto it = m_entries.find(m_order.front());
+    if (it != m_entries.end()) {
+      if (!it->second->result) {
+        // still generating; evicted once done
+        break;
+      }
+      m_entries.erase(it);
+    }
+    m_order.pop_front();
+  }
+}
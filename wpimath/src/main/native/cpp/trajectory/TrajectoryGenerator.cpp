@@ -11,6 +11,7 @@
 #include "frc/spline/SplineHelper.h"
 #include "frc/spline/SplineParameterizer.h"
 #include "frc/trajectory/TrajectoryParameterizer.h"
+#include "units/math.h"
 
 using namespace frc;
 
@@ -26,26 +27,17 @@ void TrajectoryGenerator::ReportError(const char* error) {
   }
 }
 
-Trajectory TrajectoryGenerator::GenerateTrajectory(
-    Spline<3>::ControlVector initial,
-    const std::vector<Translation2d>& interiorWaypoints,
-    Spline<3>::ControlVector end, const TrajectoryConfig& config) {
+template <typename MakeSplines>
+Trajectory TrajectoryGenerator::GenerateFromSplines(
+    MakeSplines&& makeSplines, const TrajectoryConfig& config,
+    units::meters_per_second_t startVelocity, wpi::ThreadPool* pool) {
   const Transform2d flip{Translation2d(), Rotation2d(180_deg)};
 
-  // Make theta normal for trajectory generation if path is reversed.
-  // Flip the headings.
-  if (config.IsReversed()) {
-    initial.x[1] *= -1;
-    initial.y[1] *= -1;
-    end.x[1] *= -1;
-    end.y[1] *= -1;
-  }
-
   std::vector<frc::SplineParameterizer::PoseWithCurvature> points;
   try {
-    points =
-        SplinePointsFromSplines(SplineHelper::CubicSplinesFromControlVectors(
-            initial, interiorWaypoints, end));
+    auto splines = makeSplines();
+    points = pool ? SplinePointsFromSplines(splines, *pool)
+                  : SplinePointsFromSplines(splines);
   } catch (SplineParameterizer::MalformedSplineException& e) {
     ReportError(e.what());
     return kDoNothingTrajectory;
@@ -60,23 +52,36 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
   }
 
   return TrajectoryParameterizer::TimeParameterizeTrajectory(
-      points, config.Constraints(), config.StartVelocity(),
-      config.EndVelocity(), config.MaxVelocity(), config.MaxAcceleration(),
-      config.IsReversed());
+      points, config.Constraints(), startVelocity, config.EndVelocity(),
+      config.MaxVelocity(), config.MaxAcceleration(), config.IsReversed(),
+      config.MaxJerk());
 }
 
-Trajectory TrajectoryGenerator::GenerateTrajectory(
-    const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
-    const Pose2d& end, const TrajectoryConfig& config) {
-  auto [startCV, endCV] = SplineHelper::CubicControlVectorsFromWaypoints(
-      start, interiorWaypoints, end);
-  return GenerateTrajectory(startCV, interiorWaypoints, endCV, config);
+Trajectory TrajectoryGenerator::GenerateCubic(
+    Spline<3>::ControlVector initial,
+    const std::vector<Translation2d>& interiorWaypoints,
+    Spline<3>::ControlVector end, const TrajectoryConfig& config,
+    wpi::ThreadPool* pool) {
+  // Make theta normal for trajectory generation if path is reversed.
+  // Flip the headings.
+  if (config.IsReversed()) {
+    initial.x[1] *= -1;
+    initial.y[1] *= -1;
+    end.x[1] *= -1;
+    end.y[1] *= -1;
+  }
+
+  return GenerateFromSplines(
+      [&] {
+        return SplineHelper::CubicSplinesFromControlVectors(
+            initial, interiorWaypoints, end);
+      },
+      config, config.StartVelocity(), pool);
 }
 
-Trajectory TrajectoryGenerator::GenerateTrajectory(
+Trajectory TrajectoryGenerator::GenerateQuintic(
     std::vector<Spline<5>::ControlVector> controlVectors,
-    const TrajectoryConfig& config) {
-  const Transform2d flip{Translation2d(), Rotation2d(180_deg)};
+    const TrajectoryConfig& config, wpi::ThreadPool* pool) {
   // Make theta normal for trajectory generation if path is reversed.
   if (config.IsReversed()) {
     for (auto& vector : controlVectors) {
@@ -86,58 +91,171 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
     }
   }
 
-  std::vector<frc::SplineParameterizer::PoseWithCurvature> points;
-  try {
-    points = SplinePointsFromSplines(
-        SplineHelper::QuinticSplinesFromControlVectors(controlVectors));
-  } catch (SplineParameterizer::MalformedSplineException& e) {
-    ReportError(e.what());
-    return kDoNothingTrajectory;
-  }
+  return GenerateFromSplines(
+      [&] {
+        return SplineHelper::QuinticSplinesFromControlVectors(controlVectors);
+      },
+      config, config.StartVelocity(), pool);
+}
 
-  // After trajectory generation, flip theta back so it's relative to the
-  // field. Also fix curvature.
+Trajectory TrajectoryGenerator::GenerateQuintic(
+    const std::vector<Pose2d>& waypoints, const TrajectoryConfig& config,
+    wpi::ThreadPool* pool) {
+  auto newWaypoints = waypoints;
+  const Transform2d flip{Translation2d(), Rotation2d(180_deg)};
   if (config.IsReversed()) {
-    for (auto& point : points) {
-      point = {point.first + flip, -point.second};
+    for (auto& waypoint : newWaypoints) {
+      waypoint = waypoint + flip;
     }
   }
 
-  return TrajectoryParameterizer::TimeParameterizeTrajectory(
-      points, config.Constraints(), config.StartVelocity(),
-      config.EndVelocity(), config.MaxVelocity(), config.MaxAcceleration(),
-      config.IsReversed());
+  return GenerateFromSplines(
+      [&] { return SplineHelper::QuinticSplinesFromWaypoints(newWaypoints); },
+      config, config.StartVelocity(), pool);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    Spline<3>::ControlVector initial,
+    const std::vector<Translation2d>& interiorWaypoints,
+    Spline<3>::ControlVector end, const TrajectoryConfig& config) {
+  return GenerateCubic(initial, interiorWaypoints, end, config, nullptr);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
+    const Pose2d& end, const TrajectoryConfig& config) {
+  auto [startCV, endCV] = SplineHelper::CubicControlVectorsFromWaypoints(
+      start, interiorWaypoints, end);
+  return GenerateCubic(startCV, interiorWaypoints, endCV, config, nullptr);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    std::vector<Spline<5>::ControlVector> controlVectors,
+    const TrajectoryConfig& config) {
+  return GenerateQuintic(std::move(controlVectors), config, nullptr);
 }
 
 Trajectory TrajectoryGenerator::GenerateTrajectory(
     const std::vector<Pose2d>& waypoints, const TrajectoryConfig& config) {
+  return GenerateQuintic(waypoints, config, nullptr);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    Spline<3>::ControlVector initial,
+    const std::vector<Translation2d>& interiorWaypoints,
+    Spline<3>::ControlVector end, const TrajectoryConfig& config,
+    wpi::ThreadPool& pool) {
+  return GenerateCubic(initial, interiorWaypoints, end, config, &pool);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
+    const Pose2d& end, const TrajectoryConfig& config, wpi::ThreadPool& pool) {
+  auto [startCV, endCV] = SplineHelper::CubicControlVectorsFromWaypoints(
+      start, interiorWaypoints, end);
+  return GenerateCubic(startCV, interiorWaypoints, endCV, config, &pool);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    std::vector<Spline<5>::ControlVector> controlVectors,
+    const TrajectoryConfig& config, wpi::ThreadPool& pool) {
+  return GenerateQuintic(std::move(controlVectors), config, &pool);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    const std::vector<Pose2d>& waypoints, const TrajectoryConfig& config,
+    wpi::ThreadPool& pool) {
+  return GenerateQuintic(waypoints, config, &pool);
+}
+
+Trajectory TrajectoryGenerator::Replan(const Trajectory& trajectory,
+                                       units::second_t time,
+                                       const std::vector<Pose2d>& waypoints,
+                                       const TrajectoryConfig& config) {
+  return ReplanQuintic(trajectory, time, waypoints, config, nullptr);
+}
+
+Trajectory TrajectoryGenerator::Replan(const Trajectory& trajectory,
+                                       units::second_t time,
+                                       const std::vector<Pose2d>& waypoints,
+                                       const TrajectoryConfig& config,
+                                       wpi::ThreadPool& pool) {
+  return ReplanQuintic(trajectory, time, waypoints, config, &pool);
+}
+
+Trajectory TrajectoryGenerator::ReplanQuintic(
+    const Trajectory& trajectory, units::second_t time,
+    const std::vector<Pose2d>& waypoints, const TrajectoryConfig& config,
+    wpi::ThreadPool* pool) {
+  if (waypoints.empty()) {
+    ReportError("Replanning needs at least one waypoint to replan to.");
+    return trajectory;
+  }
+
+  // The junction, and the waypoints after it, with theta made normal for
+  // trajectory generation if the path is reversed
+  auto junction = trajectory.Sample(time);
+  Pose2d start = junction.pose;
+  units::curvature_t curvature = junction.curvature;
   auto newWaypoints = waypoints;
-  const Transform2d flip{Translation2d(), Rotation2d(180_deg)};
   if (config.IsReversed()) {
+    const Transform2d flip{Translation2d(), Rotation2d(180_deg)};
+    start = start + flip;
+    curvature = -curvature;
     for (auto& waypoint : newWaypoints) {
       waypoint = waypoint + flip;
     }
   }
 
-  std::vector<SplineParameterizer::PoseWithCurvature> points;
-  try {
-    points = SplinePointsFromSplines(
-        SplineHelper::QuinticSplinesFromWaypoints(newWaypoints));
-  } catch (SplineParameterizer::MalformedSplineException& e) {
-    ReportError(e.what());
-    return kDoNothingTrajectory;
+  auto tail = GenerateFromSplines(
+      [&] {
+        std::vector<QuinticHermiteSpline> splines;
+        splines.reserve(newWaypoints.size());
+        Pose2d p0 = start;
+        for (size_t i = 0; i < newWaypoints.size(); ++i) {
+          const auto& p1 = newWaypoints[i];
+
+          // Scaled like SplineHelper::QuinticSplinesFromWaypoints(). Only
+          // the first spline starts with a curvature, the junction's; with
+          // a tangent of length scalar, that takes a second derivative of
+          // scalar^2 * curvature along the normal.
+          const double scalar =
+              1.2 * p0.Translation().Distance(p1.Translation()).to<double>();
+          const double k = i == 0 ? curvature.to<double>() : 0.0;
+          const double cos0 = p0.Rotation().Cos();
+          const double sin0 = p0.Rotation().Sin();
+          splines.emplace_back(
+              wpi::array<double, 3>{p0.X().to<double>(), scalar * cos0,
+                                    -scalar * scalar * k * sin0},
+              wpi::array<double, 3>{p1.X().to<double>(),
+                                    scalar * p1.Rotation().Cos(), 0.0},
+              wpi::array<double, 3>{p0.Y().to<double>(), scalar * sin0,
+                                    scalar * scalar * k * cos0},
+              wpi::array<double, 3>{p1.Y().to<double>(),
+                                    scalar * p1.Rotation().Sin(), 0.0});
+          p0 = p1;
+        }
+        return splines;
+      },
+      config, units::math::abs(junction.velocity), pool);
+  if (tail == kDoNothingTrajectory) {
+    // Keep following the old trajectory; the error has been reported
+    return trajectory;
   }
 
-  // After trajectory generation, flip theta back so it's relative to the
-  // field. Also fix curvature.
-  if (config.IsReversed()) {
-    for (auto& point : points) {
-      point = {point.first + flip, -point.second};
+  // Keep the states before the junction, and splice the tail on after them
+  const auto& states = trajectory.States();
+  std::vector<Trajectory::State> spliced;
+  spliced.reserve(states.size() + tail.States().size());
+  for (auto&& state : states) {
+    if (state.t >= junction.t) {
+      break;
     }
+    spliced.push_back(state);
   }
-
-  return TrajectoryParameterizer::TimeParameterizeTrajectory(
-      points, config.Constraints(), config.StartVelocity(),
-      config.EndVelocity(), config.MaxVelocity(), config.MaxAcceleration(),
-      config.IsReversed());
+  for (auto state : tail.States()) {
+    state.t += junction.t;
+    spliced.push_back(state);
+  }
+  return Trajectory{spliced};
 }
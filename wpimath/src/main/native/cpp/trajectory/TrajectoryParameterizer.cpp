@@ -28,213 +28,136 @@
 
 #include "frc/trajectory/TrajectoryParameterizer.h"
 
-#include <fmt/format.h>
+#include <stdexcept>
 
 #include "units/math.h"
 
 using namespace frc;
 
-Trajectory TrajectoryParameterizer::TimeParameterizeTrajectory(
-    const std::vector<PoseWithCurvature>& points,
-    const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints,
-    units::meters_per_second_t startVelocity,
-    units::meters_per_second_t endVelocity,
-    units::meters_per_second_t maxVelocity,
-    units::meters_per_second_squared_t maxAcceleration, bool reversed) {
-  std::vector<ConstrainedState> constrainedStates(points.size());
-
-  ConstrainedState predecessor{points.front(), 0_m, startVelocity,
-                               -maxAcceleration, maxAcceleration};
-
-  constrainedStates[0] = predecessor;
-
-  // Forward pass
-  for (unsigned int i = 0; i < points.size(); i++) {
-    auto& constrainedState = constrainedStates[i];
-    constrainedState.pose = points[i];
-
-    // Begin constraining based on predecessor
-    units::meter_t ds = constrainedState.pose.first.Translation().Distance(
-        predecessor.pose.first.Translation());
-    constrainedState.distance = ds + predecessor.distance;
-
-    // We may need to iterate to find the maximum end velocity and common
-    // acceleration, since acceleration limits may be a function of velocity.
-    while (true) {
-      // Enforce global max velocity and max reachable velocity by global
-      // acceleration limit. vf = std::sqrt(vi^2 + 2*a*d).
-
-      constrainedState.maxVelocity = units::math::min(
-          maxVelocity,
-          units::math::sqrt(predecessor.maxVelocity * predecessor.maxVelocity +
-                            predecessor.maxAcceleration * ds * 2.0));
-
-      constrainedState.minAcceleration = -maxAcceleration;
-      constrainedState.maxAcceleration = maxAcceleration;
-
-      // At this point, the constrained state is fully constructed apart from
-      // all the custom-defined user constraints.
-      for (const auto& constraint : constraints) {
-        constrainedState.maxVelocity = units::math::min(
-            constrainedState.maxVelocity,
-            constraint->MaxVelocity(constrainedState.pose.first,
-                                    constrainedState.pose.second,
-                                    constrainedState.maxVelocity));
+class TrajectoryParameterizer::DynamicConstraints {
+ public:
+  DynamicConstraints(
+      const std::vector<PoseWithCurvature>& points,
+      const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints)
+      : m_constraints{constraints},
+        m_limits(constraints.size()),
+        m_hasLimits(constraints.size()) {
+    for (size_t i = 0; i < constraints.size(); ++i) {
+      m_limits[i].resize(points.size());
+      m_hasLimits[i] = constraints[i]->MaxVelocities(points, m_limits[i]);
+      if (!m_hasLimits[i]) {
+        m_limits[i].clear();
       }
-
-      // Now enforce all acceleration limits.
-      EnforceAccelerationLimits(reversed, constraints, &constrainedState);
-
-      if (ds.to<double>() < kEpsilon) {
-        break;
-      }
-
-      // If the actual acceleration for this state is higher than the max
-      // acceleration that we applied, then we need to reduce the max
-      // acceleration of the predecessor and try again.
-      units::meters_per_second_squared_t actualAcceleration =
-          (constrainedState.maxVelocity * constrainedState.maxVelocity -
-           predecessor.maxVelocity * predecessor.maxVelocity) /
-          (ds * 2.0);
-
-      // If we violate the max acceleration constraint, let's modify the
-      // predecessor.
-      if (constrainedState.maxAcceleration < actualAcceleration - 1E-6_mps_sq) {
-        predecessor.maxAcceleration = constrainedState.maxAcceleration;
-      } else {
-        // Constrain the predecessor's max acceleration to the current
-        // acceleration.
-        if (actualAcceleration > predecessor.minAcceleration + 1E-6_mps_sq) {
-          predecessor.maxAcceleration = actualAcceleration;
-        }
-        // If the actual acceleration is less than the predecessor's min
-        // acceleration, it will be repaired in the backward pass.
-        break;
+      if (constraints[i]->LimitsAcceleration()) {
+        m_accelConstraints.emplace_back(constraints[i].get());
       }
     }
-    predecessor = constrainedState;
   }
 
-  ConstrainedState successor{points.back(), constrainedStates.back().distance,
-                             endVelocity, -maxAcceleration, maxAcceleration};
-
-  // Backward pass
-  for (int i = points.size() - 1; i >= 0; i--) {
-    auto& constrainedState = constrainedStates[i];
-    units::meter_t ds =
-        constrainedState.distance - successor.distance;  // negative
-
-    while (true) {
-      // Enforce max velocity limit (reverse)
-      // vf = std::sqrt(vi^2 + 2*a*d), where vi = successor.
-      units::meters_per_second_t newMaxVelocity =
-          units::math::sqrt(successor.maxVelocity * successor.maxVelocity +
-                            successor.minAcceleration * ds * 2.0);
-
-      // No more limits to impose! This state can be finalized.
-      if (newMaxVelocity >= constrainedState.maxVelocity) {
-        break;
-      }
-
-      constrainedState.maxVelocity = newMaxVelocity;
-
-      // Check all acceleration constraints with the new max velocity.
-      EnforceAccelerationLimits(reversed, constraints, &constrainedState);
-
-      if (ds.to<double>() > -kEpsilon) {
-        break;
-      }
-
-      // If the actual acceleration for this state is lower than the min
-      // acceleration, then we need to lower the min acceleration of the
-      // successor and try again.
-      units::meters_per_second_squared_t actualAcceleration =
-          (constrainedState.maxVelocity * constrainedState.maxVelocity -
-           successor.maxVelocity * successor.maxVelocity) /
-          (ds * 2.0);
-      if (constrainedState.minAcceleration > actualAcceleration + 1E-6_mps_sq) {
-        successor.minAcceleration = constrainedState.minAcceleration;
-      } else {
-        successor.minAcceleration = actualAcceleration;
-        break;
-      }
+  units::meters_per_second_t MaxVelocity(
+      size_t index, const PoseWithCurvature& pose,
+      units::meters_per_second_t velocity) const {
+    // in the order of the constraints, as each sees the velocity limited by
+    // those before it
+    for (size_t i = 0; i < m_constraints.size(); ++i) {
+      velocity = units::math::min(
+          velocity, m_hasLimits[i] ? m_limits[i][index]
+                                   : m_constraints[i]->MaxVelocity(
+                                         pose.first, pose.second, velocity));
     }
-    successor = constrainedState;
+    return velocity;
   }
 
-  // Now we can integrate the constrained states forward in time to obtain our
-  // trajectory states.
-
-  std::vector<Trajectory::State> states(points.size());
-  units::second_t t = 0_s;
-  units::meter_t s = 0_m;
-  units::meters_per_second_t v = 0_mps;
-
-  for (unsigned int i = 0; i < constrainedStates.size(); i++) {
-    auto state = constrainedStates[i];
-
-    // Calculate the change in position between the current state and the
-    // previous state.
-    units::meter_t ds = state.distance - s;
-
-    // Calculate the acceleration between the current state and the previous
-    // state.
-    units::meters_per_second_squared_t accel =
-        (state.maxVelocity * state.maxVelocity - v * v) / (ds * 2);
-
-    // Calculate dt.
-    units::second_t dt = 0_s;
-    if (i > 0) {
-      states.at(i - 1).acceleration = reversed ? -accel : accel;
-      if (units::math::abs(accel) > 1E-6_mps_sq) {
-        // v_f = v_0 + a * t
-        dt = (state.maxVelocity - v) / accel;
-      } else if (units::math::abs(v) > 1E-6_mps) {
-        // delta_x = v * t
-        dt = ds / v;
-      } else {
-        throw std::runtime_error(fmt::format(
-            "Something went wrong at iteration {} of time parameterization.",
-            i));
-      }
+  void EnforceAccelerationLimits(bool reverse, size_t index,
+                                 ConstrainedState* state) const {
+    units::meters_per_second_t speed =
+        reverse ? -state->maxVelocity : state->maxVelocity;
+    for (auto constraint : m_accelConstraints) {
+      ApplyAccelerationLimits(
+          reverse,
+          constraint->MinMaxAcceleration(state->pose.first, state->pose.second,
+                                         speed),
+          state);
     }
+  }
 
-    v = state.maxVelocity;
-    s = state.distance;
+ private:
+  const std::vector<std::unique_ptr<TrajectoryConstraint>>& m_constraints;
+  // the velocity limits from MaxVelocities(), for constraints with them
+  std::vector<std::vector<units::meters_per_second_t>> m_limits;
+  std::vector<bool> m_hasLimits;
+  std::vector<const TrajectoryConstraint*> m_accelConstraints;
+};
 
-    t += dt;
+Trajectory TrajectoryParameterizer::TimeParameterizeTrajectory(
+    const std::vector<PoseWithCurvature>& points,
+    const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints,
+    units::meters_per_second_t startVelocity,
+    units::meters_per_second_t endVelocity,
+    units::meters_per_second_t maxVelocity,
+    units::meters_per_second_squared_t maxAcceleration, bool reversed,
+    Jerk_t maxJerk) {
+  return Parameterize(points, DynamicConstraints{points, constraints},
+                      startVelocity, endVelocity, maxVelocity, maxAcceleration,
+                      reversed, maxJerk);
+}
 
-    states[i] = {t, reversed ? -v : v, reversed ? -accel : accel,
-                 state.pose.first, state.pose.second};
+units::meters_per_second_squared_t TrajectoryParameterizer::LimitJerk(
+    units::meters_per_second_squared_t acceleration,
+    units::meters_per_second_squared_t lastAcceleration,
+    units::second_t lastDuration, units::meters_per_second_t velocity,
+    units::meter_t ds, units::meters_per_second_t velocityLimit,
+    Jerk_t maxJerk) {
+  if (acceleration <= 0_mps_sq) {
+    return acceleration;
   }
 
-  return Trajectory(states);
+  // The acceleration builds up from the last one, or from zero
+  lastAcceleration = units::math::max(lastAcceleration, 0_mps_sq);
+
+  // Both limits only get harder to meet as a grows, so bisect for the
+  // largest a below the given one that meets them
+  auto feasible = [&](units::meters_per_second_squared_t a) {
+    units::meters_per_second_t endVelocity =
+        units::math::sqrt(velocity * velocity + 2.0 * a * ds);
+    units::second_t dt = 2.0 * ds / (velocity + endVelocity);
+    // Each acceleration applies from the middle of its segment, and easing
+    // off from a at the max jerk gains a^2 / (2 * jerk) of velocity
+    return a <= lastAcceleration + maxJerk * (lastDuration + dt) / 2.0 &&
+           a * a <= maxJerk * (2.0 * velocityLimit - velocity - endVelocity);
+  };
+  if (feasible(acceleration)) {
+    return acceleration;
+  }
+  units::meters_per_second_squared_t low = 0_mps_sq;
+  units::meters_per_second_squared_t high = acceleration;
+  for (int i = 0; i < 20; ++i) {
+    auto mid = (low + high) / 2.0;
+    if (feasible(mid)) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
 }
 
-void TrajectoryParameterizer::EnforceAccelerationLimits(
-    bool reverse,
-    const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints,
+void TrajectoryParameterizer::ApplyAccelerationLimits(
+    bool reverse, const TrajectoryConstraint::MinMax& minMaxAccel,
     ConstrainedState* state) {
-  for (auto&& constraint : constraints) {
-    double factor = reverse ? -1.0 : 1.0;
-
-    auto minMaxAccel = constraint->MinMaxAcceleration(
-        state->pose.first, state->pose.second, state->maxVelocity * factor);
-
-    if (minMaxAccel.minAcceleration > minMaxAccel.maxAcceleration) {
-      throw std::runtime_error(
-          "The constraint's min acceleration was greater than its max "
-          "acceleration. To debug this, remove all constraints from the config "
-          "and add each one individually. If the offending constraint was "
-          "packaged with WPILib, please file a bug report.");
-    }
+  if (minMaxAccel.minAcceleration > minMaxAccel.maxAcceleration) {
+    throw std::runtime_error(
+        "The constraint's min acceleration was greater than its max "
+        "acceleration. To debug this, remove all constraints from the config "
+        "and add each one individually. If the offending constraint was "
+        "packaged with WPILib, please file a bug report.");
+  }
 
-    state->minAcceleration = units::math::max(
-        state->minAcceleration,
-        reverse ? -minMaxAccel.maxAcceleration : minMaxAccel.minAcceleration);
+  state->minAcceleration = units::math::max(
+      state->minAcceleration,
+      reverse ? -minMaxAccel.maxAcceleration : minMaxAccel.minAcceleration);
 
-    state->maxAcceleration = units::math::min(
-        state->maxAcceleration,
-        reverse ? -minMaxAccel.minAcceleration : minMaxAccel.maxAcceleration);
-  }
+  state->maxAcceleration = units::math::min(
+      state->maxAcceleration,
+      reverse ? -minMaxAccel.minAcceleration : minMaxAccel.maxAcceleration);
 }
@@ -0,0 +1,82 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/TrajectorySampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "units/math.h"
+
+using namespace frc;
+
+Trajectory::State TrajectorySampler::Sample(units::second_t t) {
+  const auto& states = m_trajectory->States();
+  if (t <= states.front().t) {
+    return states.front();
+  }
+  if (t >= m_trajectory->TotalTime()) {
+    return states.back();
+  }
+
+  if (m_index >= states.size() || states[m_index - 1].t >= t) {
+    // Earlier than the last sample, so search from the start like
+    // Trajectory::Sample().
+    m_index = std::lower_bound(states.cbegin() + 1, states.cend(), t,
+                               [](const auto& a, const auto& b) {
+                                 return a.t < b;
+                               }) -
+              states.cbegin();
+  } else {
+    // Walk forward to the first state with a timestamp no less than the
+    // requested timestamp. This stops before the end, as the last state is at
+    // the total time.
+    while (states[m_index].t < t) {
+      ++m_index;
+    }
+  }
+
+  const auto& sample = states[m_index];
+  const auto& prevSample = states[m_index - 1];
+
+  // If the difference in states is negligible, then we are spot on!
+  if (units::math::abs(sample.t - prevSample.t) < 1E-9_s) {
+    return sample;
+  }
+  // Interpolate between the two states for the state that we want.
+  return prevSample.Interpolate(sample,
+                                (t - prevSample.t) / (sample.t - prevSample.t));
+}
+
+UniformTrajectory::UniformTrajectory(const Trajectory& trajectory,
+                                     units::second_t period)
+    : m_period(period), m_totalTime(trajectory.TotalTime()) {
+  size_t count =
+      static_cast<size_t>(std::ceil((m_totalTime / m_period).value())) + 1;
+  m_states.reserve(count);
+  TrajectorySampler sampler{trajectory};
+  for (size_t i = 0; i + 1 < count; ++i) {
+    m_states.push_back(sampler.Sample(m_period * static_cast<double>(i)));
+  }
+  m_states.push_back(trajectory.States().back());
+}
+
+Trajectory::State UniformTrajectory::Sample(units::second_t t) const {
+  if (t <= 0_s) {
+    return m_states.front();
+  }
+  if (t >= m_totalTime) {
+    return m_states.back();
+  }
+
+  size_t index = std::min(static_cast<size_t>((t / m_period).value()),
+                          m_states.size() - 2);
+  const auto& prevSample = m_states[index];
+  const auto& sample = m_states[index + 1];
+  if (units::math::abs(sample.t - prevSample.t) < 1E-9_s) {
+    return sample;
+  }
+  return prevSample.Interpolate(sample,
+                                (t - prevSample.t) / (sample.t - prevSample.t));
+}
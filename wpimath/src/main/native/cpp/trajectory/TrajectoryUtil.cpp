@@ -4,9 +4,12 @@
 
 #include "frc/trajectory/TrajectoryUtil.h"
 
+#include <cstring>
 #include <system_error>
 
 #include <fmt/format.h>
+#include <wpi/Endian.h>
+#include <wpi/MappedFileRegion.h>
 #include <wpi/SmallString.h>
 #include <wpi/json.h>
 #include <wpi/raw_istream.h>
@@ -14,6 +17,42 @@
 
 using namespace frc;
 
+namespace {
+constexpr char kBinaryMagic[4] = {'W', 'T', 'R', 'J'};
+constexpr uint32_t kBinaryVersion = 1;
+constexpr size_t kBinaryHeaderSize = 16;
+// t, v, a, x, y, theta, curvature
+constexpr size_t kBinaryFields = 7;
+}  // namespace
+
+static void WriteDouble(uint8_t* data, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  wpi::support::endian::write64le(data, bits);
+}
+
+static double ReadDouble(const uint8_t* data) {
+  uint64_t bits = wpi::support::endian::read64le(data);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Converts the states one at a time, so only one state's JSON is built at once
+static std::vector<Trajectory::State> ReadStates(
+    wpi::json::pull_parser& parser) {
+  using event_t = wpi::json::pull_parser::event_t;
+  if (parser.next() != event_t::start_array) {
+    // Throws the same error as converting the whole value would
+    return parser.get_value().get<std::vector<Trajectory::State>>();
+  }
+  std::vector<Trajectory::State> states;
+  while (parser.next() != event_t::end_array) {
+    states.emplace_back(parser.get_value().get<Trajectory::State>());
+  }
+  return states;
+}
+
 void TrajectoryUtil::ToPathweaverJson(const Trajectory& trajectory,
                                       std::string_view path) {
   std::error_code error_code;
@@ -36,10 +75,8 @@ Trajectory TrajectoryUtil::FromPathweaverJson(std::string_view path) {
     throw std::runtime_error(fmt::format("Cannot open file: {}", path));
   }
 
-  wpi::json json;
-  input >> json;
-
-  return Trajectory{json.get<std::vector<Trajectory::State>>()};
+  wpi::json::pull_parser parser{input, false};
+  return Trajectory{ReadStates(parser)};
 }
 
 std::string TrajectoryUtil::SerializeTrajectory(const Trajectory& trajectory) {
@@ -48,6 +85,100 @@ std::string TrajectoryUtil::SerializeTrajectory(const Trajectory& trajectory) {
 }
 
 Trajectory TrajectoryUtil::DeserializeTrajectory(std::string_view json_str) {
-  wpi::json json = wpi::json::parse(json_str);
-  return Trajectory{json.get<std::vector<Trajectory::State>>()};
+  wpi::raw_mem_istream input{json_str.data(), json_str.size()};
+  wpi::json::pull_parser parser{input};
+  return Trajectory{ReadStates(parser)};
+}
+
+void TrajectoryUtil::ToBinary(const Trajectory& trajectory,
+                              std::string_view path) {
+  std::error_code error_code;
+
+  wpi::raw_fd_ostream output{path, error_code};
+  if (error_code) {
+    throw std::runtime_error(fmt::format("Cannot open file: {}", path));
+  }
+
+  auto data = SerializeTrajectoryBinary(trajectory);
+  output.write(reinterpret_cast<const char*>(data.data()), data.size());
+  output.flush();
+}
+
+Trajectory TrajectoryUtil::FromBinary(std::string_view path) {
+  std::error_code error_code;
+
+  wpi::MappedFileRegion region{fs::path{path},
+                               wpi::MappedFileRegion::kReadOnly, error_code};
+  if (error_code) {
+    throw std::runtime_error(fmt::format("Cannot open file: {}", path));
+  }
+  // All of it is read, so start paging it in
+  region.Advise(wpi::MappedFileRegion::kWillNeed);
+
+  return DeserializeTrajectoryBinary(region.bytes());
+}
+
+std::vector<uint8_t> TrajectoryUtil::SerializeTrajectoryBinary(
+    const Trajectory& trajectory) {
+  const auto& states = trajectory.States();
+  size_t count = states.size();
+  std::vector<uint8_t> data(kBinaryHeaderSize +
+                            kBinaryFields * count * sizeof(double));
+  std::memcpy(data.data(), kBinaryMagic, sizeof(kBinaryMagic));
+  wpi::support::endian::write32le(&data[4], kBinaryVersion);
+  wpi::support::endian::write64le(&data[8], count);
+
+  uint8_t* arrays = &data[kBinaryHeaderSize];
+  for (size_t i = 0; i < count; ++i) {
+    const auto& state = states[i];
+    double values[kBinaryFields] = {state.t.value(),
+                                    state.velocity.value(),
+                                    state.acceleration.value(),
+                                    state.pose.X().value(),
+                                    state.pose.Y().value(),
+                                    state.pose.Rotation().Radians().value(),
+                                    state.curvature.value()};
+    for (size_t field = 0; field < kBinaryFields; ++field) {
+      WriteDouble(arrays + (field * count + i) * sizeof(double),
+                  values[field]);
+    }
+  }
+  return data;
+}
+
+Trajectory TrajectoryUtil::DeserializeTrajectoryBinary(
+    wpi::span<const uint8_t> data) {
+  if (data.size() < kBinaryHeaderSize ||
+      std::memcmp(data.data(), kBinaryMagic, sizeof(kBinaryMagic)) != 0) {
+    throw std::runtime_error("Not a binary trajectory");
+  }
+  uint32_t version = wpi::support::endian::read32le(&data[4]);
+  if (version != kBinaryVersion) {
+    throw std::runtime_error(
+        fmt::format("Unsupported binary trajectory version: {}", version));
+  }
+  uint64_t count = wpi::support::endian::read64le(&data[8]);
+  if (count == 0) {
+    throw std::runtime_error("Empty binary trajectory");
+  }
+  if (count > (data.size() - kBinaryHeaderSize) /
+                  (kBinaryFields * sizeof(double))) {
+    throw std::runtime_error("Truncated binary trajectory");
+  }
+
+  const uint8_t* arrays = &data[kBinaryHeaderSize];
+  auto field = [&](size_t field, size_t i) {
+    return ReadDouble(arrays + (field * count + i) * sizeof(double));
+  };
+  std::vector<Trajectory::State> states;
+  states.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    states.push_back(
+        {units::second_t{field(0, i)}, units::meters_per_second_t{field(1, i)},
+         units::meters_per_second_squared_t{field(2, i)},
+         Pose2d{units::meter_t{field(3, i)}, units::meter_t{field(4, i)},
+                units::radian_t{field(5, i)}},
+         units::curvature_t{field(6, i)}});
+  }
+  return Trajectory{states};
 }
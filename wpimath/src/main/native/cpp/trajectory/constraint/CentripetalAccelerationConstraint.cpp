@@ -4,6 +4,8 @@
 
 #include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
 
+#include <cmath>
+
 #include "units/math.h"
 
 using namespace frc;
@@ -37,3 +39,15 @@ CentripetalAccelerationConstraint::MinMaxAcceleration(
   // of the robot.
   return {};
 }
+
+bool CentripetalAccelerationConstraint::MaxVelocities(
+    wpi::span<const PoseWithCurvature> points,
+    wpi::span<units::meters_per_second_t> limits) const {
+  // v = std::sqrt(ac / k), as in MaxVelocity()
+  double ac = m_maxCentripetalAcceleration.value();
+  for (size_t i = 0; i < points.size(); ++i) {
+    limits[i] = units::meters_per_second_t{
+        std::sqrt(ac / std::abs(points[i].second.value()))};
+  }
+  return true;
+}
@@ -4,6 +4,8 @@
 
 #include "frc/trajectory/constraint/DifferentialDriveKinematicsConstraint.h"
 
+#include <cmath>
+
 using namespace frc;
 
 DifferentialDriveKinematicsConstraint::DifferentialDriveKinematicsConstraint(
@@ -27,3 +29,17 @@ DifferentialDriveKinematicsConstraint::MinMaxAcceleration(
     units::meters_per_second_t speed) const {
   return {};
 }
+
+bool DifferentialDriveKinematicsConstraint::MaxVelocities(
+    wpi::span<const PoseWithCurvature> points,
+    wpi::span<units::meters_per_second_t> limits) const {
+  // The wheel speeds are proportional to the velocity, so normalizing them
+  // caps it.  At a velocity of 1, the faster wheel goes 1 + |k| * width / 2.
+  double halfWidth = m_kinematics.trackWidth.value() / 2;
+  double maxSpeed = m_maxSpeed.value();
+  for (size_t i = 0; i < points.size(); ++i) {
+    limits[i] = units::meters_per_second_t{
+        maxSpeed / (1 + std::abs(points[i].second.value()) * halfWidth)};
+  }
+  return true;
+}
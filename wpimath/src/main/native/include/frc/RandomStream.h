@@ -0,0 +1,118 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+
+namespace frc {
+
+/**
+ * A seedable stream of random numbers for simulation noise.
+ *
+ * This is a xoshiro256++ generator: it's small enough to keep one per
+ * simulated mechanism and much cheaper to seed than std::mt19937, and seeding
+ * it explicitly makes a simulation run reproducible. It satisfies
+ * UniformRandomBitGenerator, so it can also be used with the <random>
+ * distributions.
+ *
+ * A stream isn't thread-safe; use one per thread (see GetThreadDefault()) or
+ * Split() off independent streams.
+ */
+class RandomStream {
+ public:
+  using result_type = uint64_t;
+
+  /**
+   * Creates a stream seeded from the calling thread's default stream.
+   */
+  RandomStream();
+
+  /**
+   * Creates a stream with the given seed. Streams with the same seed produce
+   * the same sequence.
+   *
+   * @param seed The seed.
+   */
+  explicit RandomStream(uint64_t seed) { Seed(seed); }
+
+  /**
+   * Reseeds the stream.
+   *
+   * @param seed The seed.
+   */
+  void Seed(uint64_t seed);
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * Returns the next 64 random bits.
+   */
+  result_type operator()() {
+    uint64_t result = Rotl(m_s[0] + m_s[3], 23) + m_s[0];
+    uint64_t t = m_s[1] << 17;
+    m_s[2] ^= m_s[0];
+    m_s[3] ^= m_s[1];
+    m_s[1] ^= m_s[2];
+    m_s[0] ^= m_s[3];
+    m_s[2] ^= t;
+    m_s[3] = Rotl(m_s[3], 45);
+    return result;
+  }
+
+  /**
+   * Returns a uniformly distributed number in [0, 1).
+   */
+  double Uniform() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+  /**
+   * Returns a normally distributed number with a mean of 0 and a standard
+   * deviation of 1.
+   */
+  double Gaussian();
+
+  /**
+   * Fills an array with normally distributed numbers with a mean of 0 and a
+   * standard deviation of 1. The numbers are generated in pairs, so this is
+   * cheaper than calling Gaussian() for each one.
+   *
+   * @param out   The array to fill.
+   * @param count The number of elements in the array.
+   */
+  void FillGaussian(double* out, size_t count);
+
+  /**
+   * Returns a new stream that doesn't overlap this one, and advances this
+   * stream past it. Use this to give each of several simulations its own
+   * stream from a single seed.
+   */
+  RandomStream Split();
+
+  /**
+   * Returns the calling thread's default stream, which is seeded once from
+   * std::random_device.
+   */
+  static RandomStream& GetThreadDefault();
+
+ private:
+  struct NoSeed {};
+  explicit RandomStream(NoSeed) {}
+
+  static constexpr uint64_t Rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  std::array<uint64_t, 4> m_s;
+  double m_spare = 0.0;
+  bool m_hasSpare = false;
+};
+
+}  // namespace frc
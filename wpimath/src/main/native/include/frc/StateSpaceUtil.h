@@ -6,12 +6,12 @@
 
 #include <array>
 #include <cmath>
-#include <random>
 #include <type_traits>
 
 #include "Eigen/Core"
 #include "Eigen/QR"
 #include "Eigen/src/Eigenvalues/EigenSolver.h"
+#include "frc/RandomStream.h"
 #include "frc/geometry/Pose2d.h"
 
 namespace frc {
@@ -43,18 +43,6 @@ void CovMatrixImpl(Matrix& result, T elem, Ts... elems) {
   }
 }
 
-template <typename Matrix, typename T, typename... Ts>
-void WhiteNoiseVectorImpl(Matrix& result, T elem, Ts... elems) {
-  std::random_device rd;
-  std::mt19937 gen{rd()};
-  std::normal_distribution<> distr{0.0, elem};
-
-  result(result.rows() - (sizeof...(Ts) + 1)) = distr(gen);
-  if constexpr (sizeof...(Ts) > 0) {
-    WhiteNoiseVectorImpl(result, elems...);
-  }
-}
-
 template <int States, int Inputs>
 bool IsStabilizableImpl(const Eigen::Matrix<double, States, States>& A,
                         const Eigen::Matrix<double, States, Inputs>& B) {
@@ -193,18 +181,38 @@ Eigen::Matrix<double, N, N> MakeCovMatrix(
   return result;
 }
 
+/**
+ * Creates a vector of normally distributed white noise with the given noise
+ * intensities for each element.
+ *
+ * @param gen     The random stream to draw the noise from.
+ * @param stdDevs An array whose elements are the standard deviations of each
+ *                element of the noise vector.
+ * @return White noise vector.
+ */
+template <int N>
+Eigen::Matrix<double, N, 1> MakeWhiteNoiseVector(
+    RandomStream& gen, const std::array<double, N>& stdDevs) {
+  Eigen::Matrix<double, N, 1> result;
+  gen.FillGaussian(result.data(), N);
+  return result.cwiseProduct(
+      Eigen::Map<const Eigen::Matrix<double, N, 1>>(stdDevs.data()));
+}
+
 template <typename... Ts, typename = std::enable_if_t<
                               std::conjunction_v<std::is_same<double, Ts>...>>>
 Eigen::Matrix<double, sizeof...(Ts), 1> MakeWhiteNoiseVector(Ts... stdDevs) {
-  Eigen::Matrix<double, sizeof...(Ts), 1> result;
-  detail::WhiteNoiseVectorImpl(result, stdDevs...);
-  return result;
+  return MakeWhiteNoiseVector<sizeof...(Ts)>(RandomStream::GetThreadDefault(),
+                                             {stdDevs...});
 }
 
 /**
  * Creates a vector of normally distributed white noise with the given noise
  * intensities for each element.
  *
+ * The noise is drawn from the calling thread's default RandomStream; use the
+ * overload taking a RandomStream for reproducible noise.
+ *
  * @param stdDevs An array whose elements are the standard deviations of each
  *                element of the noise vector.
  * @return White noise vector.
@@ -212,21 +220,7 @@ Eigen::Matrix<double, sizeof...(Ts), 1> MakeWhiteNoiseVector(Ts... stdDevs) {
 template <int N>
 Eigen::Matrix<double, N, 1> MakeWhiteNoiseVector(
     const std::array<double, N>& stdDevs) {
-  std::random_device rd;
-  std::mt19937 gen{rd()};
-
-  Eigen::Matrix<double, N, 1> result;
-  for (int i = 0; i < N; ++i) {
-    // Passing a standard deviation of 0.0 to std::normal_distribution is
-    // undefined behavior
-    if (stdDevs[i] == 0.0) {
-      result(i) = 0.0;
-    } else {
-      std::normal_distribution distr{0.0, stdDevs[i]};
-      result(i) = distr(gen);
-    }
-  }
-  return result;
+  return MakeWhiteNoiseVector<N>(RandomStream::GetThreadDefault(), stdDevs);
 }
 
 /**
@@ -27,8 +27,12 @@ namespace frc {
  * <strong> u_ff = B<sup>+</sup> (rDot - f(x)) </strong>, where <strong>
  * B<sup>+</sup> </strong> is the pseudoinverse of B.
  *
- * This feedforward does not account for a dynamic B matrix, B is either
- * determined or supplied when the feedforward is created and remains constant.
+ * By default B is either determined or supplied when the feedforward is
+ * created and remains constant.  For plants whose B matrix depends on the
+ * state, B can instead be relinearized about the reference (numerically, or
+ * with a supplied function of the state) once the reference has moved more
+ * than a tolerance from where B was last determined.  Between
+ * relinearizations, the factorization of B is reused.
  *
  * For more on the underlying math, read
  * https://file.tavsys.net/control/controls-engineering-in-frc.pdf.
@@ -53,9 +57,42 @@ class ControlAffinePlantInversionFeedforward {
           f,
       units::second_t dt)
       : m_dt(dt), m_f(f) {
-    m_B = NumericalJacobianU<States, States, Inputs>(
+    SetB(NumericalJacobianU<States, States, Inputs>(
         f, Eigen::Matrix<double, States, 1>::Zero(),
-        Eigen::Matrix<double, Inputs, 1>::Zero());
+        Eigen::Matrix<double, Inputs, 1>::Zero()));
+
+    Reset();
+  }
+
+  /**
+   * Constructs a feedforward with given model dynamics as a function
+   * of state and input, for a plant whose B matrix depends on the state.
+   * B is calculated through a NumericalJacobian about the reference, and
+   * recalculated whenever the reference moves more than
+   * relinearizationTolerance from where it was last calculated.
+   *
+   * @param f  A vector-valued function of x, the state, and
+   *           u, the input, that returns the derivative of
+   *           the state vector. HAS to be control-affine
+   *           (of the form f(x) + B(x)u).
+   * @param dt The timestep between calls of calculate().
+   * @param relinearizationTolerance The distance (2-norm) the reference can
+   *           move before B is recalculated; 0 recalculates it whenever the
+   *           reference changes.
+   */
+  ControlAffinePlantInversionFeedforward(
+      std::function<Eigen::Matrix<double, States, 1>(
+          const Eigen::Matrix<double, States, 1>&,
+          const Eigen::Matrix<double, Inputs, 1>&)>
+          f,
+      units::second_t dt, double relinearizationTolerance)
+      : m_dt(dt),
+        m_f(f),
+        m_relinearizationTolerance(relinearizationTolerance) {
+    m_BFunc = [=](const Eigen::Matrix<double, States, 1>& x) {
+      return NumericalJacobianU<States, States, Inputs>(
+          f, x, Eigen::Matrix<double, Inputs, 1>::Zero());
+    };
 
     Reset();
   }
@@ -74,7 +111,42 @@ class ControlAffinePlantInversionFeedforward {
           const Eigen::Matrix<double, States, 1>&)>
           f,
       const Eigen::Matrix<double, States, Inputs>& B, units::second_t dt)
-      : m_B(B), m_dt(dt) {
+      : m_dt(dt) {
+    m_f = [=](const Eigen::Matrix<double, States, 1>& x,
+              const Eigen::Matrix<double, Inputs, 1>& u)
+        -> Eigen::Matrix<double, States, 1> { return f(x); };
+    SetB(B);
+
+    Reset();
+  }
+
+  /**
+   * Constructs a feedforward with given model dynamics as a function of state,
+   * and the plant's B matrix(continuous input matrix) as a function of state.
+   * B is evaluated at the reference, and reevaluated whenever the reference
+   * moves more than relinearizationTolerance from where it was last
+   * evaluated.
+   *
+   * @param f  A vector-valued function of x, the state,
+   *           that returns the derivative of the state vector.
+   * @param B  A function of x, the state, that returns the continuous input
+   *           matrix of the plant being controlled.
+   * @param dt The timestep between calls of calculate().
+   * @param relinearizationTolerance The distance (2-norm) the reference can
+   *           move before B is reevaluated; 0 reevaluates it whenever the
+   *           reference changes.
+   */
+  ControlAffinePlantInversionFeedforward(
+      std::function<Eigen::Matrix<double, States, 1>(
+          const Eigen::Matrix<double, States, 1>&)>
+          f,
+      std::function<Eigen::Matrix<double, States, Inputs>(
+          const Eigen::Matrix<double, States, 1>&)>
+          B,
+      units::second_t dt, double relinearizationTolerance = 0.0)
+      : m_dt(dt),
+        m_BFunc(B),
+        m_relinearizationTolerance(relinearizationTolerance) {
     m_f = [=](const Eigen::Matrix<double, States, 1>& x,
               const Eigen::Matrix<double, Inputs, 1>& u)
         -> Eigen::Matrix<double, States, 1> { return f(x); };
@@ -168,16 +240,31 @@ class ControlAffinePlantInversionFeedforward {
       const Eigen::Matrix<double, States, 1>& nextR) {
     Eigen::Matrix<double, States, 1> rDot = (nextR - r) / m_dt.to<double>();
 
-    m_uff = m_B.householderQr().solve(
-        rDot - m_f(r, Eigen::Matrix<double, Inputs, 1>::Zero()));
+    if (m_BFunc && (!m_linearized || (r - m_linearizationPoint).norm() >
+                                         m_relinearizationTolerance)) {
+      SetB(m_BFunc(r));
+      m_linearizationPoint = r;
+      m_linearized = true;
+    }
+
+    m_uff = m_BQr.solve(rDot -
+                        m_f(r, Eigen::Matrix<double, Inputs, 1>::Zero()));
 
     m_r = nextR;
     return m_uff;
   }
 
  private:
+  void SetB(const Eigen::Matrix<double, States, Inputs>& B) {
+    m_B = B;
+    m_BQr.compute(m_B);
+  }
+
   Eigen::Matrix<double, States, Inputs> m_B;
 
+  // Factorization of m_B, reused until B changes
+  Eigen::HouseholderQR<Eigen::Matrix<double, States, Inputs>> m_BQr;
+
   units::second_t m_dt;
 
   /**
@@ -188,6 +275,16 @@ class ControlAffinePlantInversionFeedforward {
       const Eigen::Matrix<double, Inputs, 1>&)>
       m_f;
 
+  // B as a function of state, if it is relinearized; empty if B is constant
+  std::function<Eigen::Matrix<double, States, Inputs>(
+      const Eigen::Matrix<double, States, 1>&)>
+      m_BFunc;
+  double m_relinearizationTolerance = 0.0;
+
+  // The state B was last linearized about (if m_linearized)
+  Eigen::Matrix<double, States, 1> m_linearizationPoint;
+  bool m_linearized = false;
+
   // Current reference
   Eigen::Matrix<double, States, 1> m_r;
 
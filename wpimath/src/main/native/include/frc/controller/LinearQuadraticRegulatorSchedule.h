@@ -0,0 +1,359 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <wpi/array.h>
+
+#include "Eigen/Core"
+#include "Eigen/src/Cholesky/LLT.h"
+#include "Eigen/src/Eigenvalues/ComplexSchur.h"
+#include "Eigen/src/LU/Determinant.h"
+#include "Eigen/src/LU/InverseImpl.h"
+#include "drake/math/discrete_algebraic_riccati_equation.h"
+#include "frc/StateSpaceUtil.h"
+#include "frc/system/Discretization.h"
+#include "units/time.h"
+#include "unsupported/Eigen/src/MatrixFunctions/MatrixPower.h"
+#include "unsupported/Eigen/src/MatrixFunctions/MatrixSquareRoot.h"
+
+namespace frc {
+namespace detail {
+
+/**
+ * Solves the discrete algebraic Riccati equation starting from a guess at the
+ * solution, such as the solution for a nearby plant.
+ *
+ * This uses Newton's method (Hewer's algorithm): each iteration takes the gain
+ * of the current guess and solves the closed-loop Lyapunov equation for the
+ * next one, by doubling. Near the solution it converges in a few iterations,
+ * far cheaper than the full solve. If the guess's gain doesn't stabilize the
+ * plant, or the iteration doesn't converge, it falls back to the full solve.
+ *
+ * @param A  Discrete system matrix.
+ * @param B  Discrete input matrix.
+ * @param Q  The state cost matrix.
+ * @param R  The input cost matrix.
+ * @param S0 The guess at the solution.
+ * @return The solution S.
+ */
+template <int States, int Inputs>
+Eigen::Matrix<double, States, States> DiscreteAlgebraicRiccatiEquationFrom(
+    const Eigen::Matrix<double, States, States>& A,
+    const Eigen::Matrix<double, States, Inputs>& B,
+    const Eigen::Matrix<double, States, States>& Q,
+    const Eigen::Matrix<double, Inputs, Inputs>& R,
+    const Eigen::Matrix<double, States, States>& S0) {
+  constexpr int kMaxIterations = 20;
+  constexpr int kMaxDoublings = 64;
+  constexpr double kTolerance = 1e-10;
+
+  Eigen::Matrix<double, States, States> S = S0;
+  for (int i = 0; i < kMaxIterations; ++i) {
+    // K = (BᵀSB + R)⁻¹BᵀSA
+    Eigen::Matrix<double, Inputs, States> K =
+        (B.transpose() * S * B + R).llt().solve(B.transpose() * S * A);
+    Eigen::Matrix<double, States, States> Acl = A - B * K;
+
+    // S = AclᵀSAcl + Q + KᵀRK, summed as Σ (Aclᵀ)ⁿ(Q + KᵀRK)Aclⁿ by doubling
+    // the number of terms each step
+    Eigen::Matrix<double, States, States> next = Q + K.transpose() * R * K;
+    bool converged = false;
+    for (int j = 0; j < kMaxDoublings; ++j) {
+      Eigen::Matrix<double, States, States> step =
+          Acl.transpose() * next * Acl;
+      next += step;
+      double stepNorm = step.norm();
+      if (!std::isfinite(stepNorm)) {
+        break;
+      }
+      if (stepNorm <= kTolerance * next.norm()) {
+        converged = true;
+        break;
+      }
+      Acl = Acl * Acl;
+    }
+    if (!converged) {
+      // the gain doesn't stabilize the plant
+      break;
+    }
+
+    bool done = (next - S).norm() <= kTolerance * next.norm();
+    S = next;
+    if (done) {
+      return S;
+    }
+  }
+
+  return drake::math::DiscreteAlgebraicRiccatiEquation(A, B, Q, R);
+}
+
+}  // namespace detail
+
+/**
+ * A gain-scheduled linear-quadratic regulator (LQR).
+ *
+ * The gain K is computed ahead of time at a grid of operating points, such as
+ * arm angles or drivetrain velocities, each plant linearized there. At runtime
+ * the gain for the current operating point is interpolated between its
+ * neighbors on the grid, which is far cheaper than building a
+ * LinearQuadraticRegulator for it every loop.
+ *
+ * Each grid point's Riccati equation is solved starting from its neighbor's
+ * solution. Solve() computes the exact gain for a plant off the grid, the same
+ * way.
+ *
+ * Like LinearQuadraticRegulator, this uses the control law u = K(r - x).
+ */
+template <int States, int Inputs>
+class LinearQuadraticRegulatorSchedule {
+ public:
+  /**
+   * Constructs a controller, computing its gains at the given operating
+   * points.
+   *
+   * @param points Operating points, in increasing order.
+   * @param plant  A function of an operating point that returns the
+   *               continuous system and input matrices (A, B) of the plant
+   *               linearized there, as a std::pair.
+   * @param Qelems The maximum desired error tolerance for each state.
+   * @param Relems The maximum desired control effort for each input.
+   * @param dt     Discretization timestep.
+   * @throws std::invalid_argument if there are no points or they aren't
+   *         increasing.
+   */
+  template <typename F>
+  LinearQuadraticRegulatorSchedule(std::vector<double> points, F&& plant,
+                                   const wpi::array<double, States>& Qelems,
+                                   const wpi::array<double, Inputs>& Relems,
+                                   units::second_t dt)
+      : LinearQuadraticRegulatorSchedule(std::move(points), plant,
+                                         MakeCostMatrix(Qelems),
+                                         MakeCostMatrix(Relems), dt) {}
+
+  /**
+   * Constructs a controller, computing its gains at the given operating
+   * points.
+   *
+   * @param points Operating points, in increasing order.
+   * @param plant  A function of an operating point that returns the
+   *               continuous system and input matrices (A, B) of the plant
+   *               linearized there, as a std::pair.
+   * @param Q      The state cost matrix.
+   * @param R      The input cost matrix.
+   * @param dt     Discretization timestep.
+   * @throws std::invalid_argument if there are no points or they aren't
+   *         increasing.
+   */
+  template <typename F>
+  LinearQuadraticRegulatorSchedule(
+      std::vector<double> points, F&& plant,
+      const Eigen::Matrix<double, States, States>& Q,
+      const Eigen::Matrix<double, Inputs, Inputs>& R, units::second_t dt)
+      : m_Q{Q}, m_R{R}, m_dt{dt} {
+    if (points.empty()) {
+      throw std::invalid_argument("No operating points");
+    }
+    if (std::adjacent_find(points.begin(), points.end(),
+                           [](double a, double b) { return a >= b; }) !=
+        points.end()) {
+      throw std::invalid_argument("Operating points must be increasing");
+    }
+
+    m_points.reserve(points.size());
+    for (double point : points) {
+      auto [A, B] = plant(point);
+      auto& entry = m_points.emplace_back();
+      entry.point = point;
+      DiscretizeAB<States, Inputs>(A, B, dt, &entry.discA, &entry.discB);
+      if (m_points.size() == 1) {
+        entry.S = drake::math::DiscreteAlgebraicRiccatiEquation(
+            entry.discA, entry.discB, Q, R);
+      } else {
+        entry.S = detail::DiscreteAlgebraicRiccatiEquationFrom<States, Inputs>(
+            entry.discA, entry.discB, Q, R, m_points[m_points.size() - 2].S);
+      }
+      entry.K = Gain(entry.discA, entry.discB, entry.S);
+    }
+
+    Reset();
+  }
+
+  LinearQuadraticRegulatorSchedule(LinearQuadraticRegulatorSchedule&&) =
+      default;
+  LinearQuadraticRegulatorSchedule& operator=(
+      LinearQuadraticRegulatorSchedule&&) = default;
+
+  /**
+   * Returns the controller matrix K at an operating point, interpolated
+   * between the grid points around it. Outside the grid, the gain at the
+   * nearest end is used.
+   *
+   * @param point The operating point.
+   */
+  Eigen::Matrix<double, Inputs, States> K(double point) const {
+    auto upper =
+        std::upper_bound(m_points.begin(), m_points.end(), point,
+                         [](double p, const Point& b) { return p < b.point; });
+    if (upper == m_points.begin()) {
+      return upper->K;
+    }
+    if (upper == m_points.end()) {
+      return m_points.back().K;
+    }
+    auto lower = upper - 1;
+    double t = (point - lower->point) / (upper->point - lower->point);
+    return lower->K + t * (upper->K - lower->K);
+  }
+
+  /**
+   * Returns the reference vector r.
+   */
+  const Eigen::Matrix<double, States, 1>& R() const { return m_r; }
+
+  /**
+   * Returns an element of the reference vector r.
+   *
+   * @param i Row of r.
+   */
+  double R(int i) const { return m_r(i, 0); }
+
+  /**
+   * Returns the control input vector u.
+   */
+  const Eigen::Matrix<double, Inputs, 1>& U() const { return m_u; }
+
+  /**
+   * Returns an element of the control input vector u.
+   *
+   * @param i Row of u.
+   */
+  double U(int i) const { return m_u(i, 0); }
+
+  /**
+   * Resets the controller.
+   */
+  void Reset() {
+    m_r.setZero();
+    m_u.setZero();
+  }
+
+  /**
+   * Returns the next output of the controller.
+   *
+   * @param x     The current state x.
+   * @param point The current operating point.
+   */
+  Eigen::Matrix<double, Inputs, 1> Calculate(
+      const Eigen::Matrix<double, States, 1>& x, double point) {
+    m_u = K(point) * (m_r - x);
+    return m_u;
+  }
+
+  /**
+   * Returns the next output of the controller.
+   *
+   * @param x     The current state x.
+   * @param nextR The next reference vector r.
+   * @param point The current operating point.
+   */
+  Eigen::Matrix<double, Inputs, 1> Calculate(
+      const Eigen::Matrix<double, States, 1>& x,
+      const Eigen::Matrix<double, States, 1>& nextR, double point) {
+    m_r = nextR;
+    return Calculate(x, point);
+  }
+
+  /**
+   * Computes the exact gain for a plant, for when interpolating isn't close
+   * enough. The Riccati equation is solved starting from the previous call's
+   * solution, or the nearest grid point's on the first call, so calling this
+   * each loop as the plant changes slowly stays cheap.
+   *
+   * The gain isn't latency compensated, and doesn't change the grid.
+   *
+   * @param point The operating point, to pick the first starting solution.
+   * @param A     Continuous system matrix of the plant.
+   * @param B     Continuous input matrix of the plant.
+   * @return The controller matrix K.
+   */
+  Eigen::Matrix<double, Inputs, States> Solve(
+      double point, const Eigen::Matrix<double, States, States>& A,
+      const Eigen::Matrix<double, States, Inputs>& B) {
+    Eigen::Matrix<double, States, States> discA;
+    Eigen::Matrix<double, States, Inputs> discB;
+    DiscretizeAB<States, Inputs>(A, B, m_dt, &discA, &discB);
+
+    if (!m_lastS) {
+      m_lastS = Nearest(point).S;
+    }
+    m_lastS = detail::DiscreteAlgebraicRiccatiEquationFrom<States, Inputs>(
+        discA, discB, m_Q, m_R, *m_lastS);
+    return Gain(discA, discB, *m_lastS);
+  }
+
+  /**
+   * Adjusts the gains at every grid point to compensate for a pure time delay
+   * in the input, as LinearQuadraticRegulator::LatencyCompensate() does for
+   * one plant.
+   *
+   * @param inputDelay Input time delay.
+   */
+  void LatencyCompensate(units::second_t inputDelay) {
+    for (auto& entry : m_points) {
+      entry.K = entry.K * (entry.discA - entry.discB * entry.K)
+                              .pow(inputDelay / m_dt);
+    }
+  }
+
+ private:
+  struct Point {
+    double point;
+    Eigen::Matrix<double, States, States> discA;
+    Eigen::Matrix<double, States, Inputs> discB;
+    Eigen::Matrix<double, States, States> S;
+    Eigen::Matrix<double, Inputs, States> K;
+  };
+
+  Eigen::Matrix<double, Inputs, States> Gain(
+      const Eigen::Matrix<double, States, States>& discA,
+      const Eigen::Matrix<double, States, Inputs>& discB,
+      const Eigen::Matrix<double, States, States>& S) const {
+    // K = (BᵀSB + R)⁻¹BᵀSA
+    return (discB.transpose() * S * discB + m_R)
+        .llt()
+        .solve(discB.transpose() * S * discA);
+  }
+
+  const Point& Nearest(double point) const {
+    return *std::min_element(m_points.begin(), m_points.end(),
+                             [&](const Point& a, const Point& b) {
+                               return std::abs(a.point - point) <
+                                      std::abs(b.point - point);
+                             });
+  }
+
+  std::vector<Point> m_points;
+  Eigen::Matrix<double, States, States> m_Q;
+  Eigen::Matrix<double, Inputs, Inputs> m_R;
+  units::second_t m_dt;
+
+  // The previous Solve() solution
+  std::optional<Eigen::Matrix<double, States, States>> m_lastS;
+
+  // Current reference
+  Eigen::Matrix<double, States, 1> m_r;
+
+  // Computed controller output
+  Eigen::Matrix<double, Inputs, 1> m_u;
+};
+
+}  // namespace frc
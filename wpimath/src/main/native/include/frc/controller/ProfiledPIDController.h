@@ -16,6 +16,7 @@
 #include "frc/MathUtil.h"
 #include "frc/controller/PIDController.h"
 #include "frc/trajectory/TrapezoidProfile.h"
+#include "units/math.h"
 #include "units/time.h"
 
 namespace frc {
@@ -56,7 +57,9 @@ class ProfiledPIDController
    */
   ProfiledPIDController(double Kp, double Ki, double Kd,
                         Constraints constraints, units::second_t period = 20_ms)
-      : m_controller(Kp, Ki, Kd, period), m_constraints(constraints) {
+      : m_controller(Kp, Ki, Kd, period),
+        m_constraints(constraints),
+        m_profile(constraints, State{}) {
     detail::ReportProfiledPIDController();
   }
 
@@ -180,6 +183,23 @@ class ProfiledPIDController
    */
   bool AtSetpoint() const { return m_controller.AtSetpoint(); }
 
+  /**
+   * Returns the total time of the profile planned by the last Calculate(),
+   * from the setpoint that call started at to the goal.
+   */
+  units::second_t TotalTime() const { return m_profile.TotalTime(); }
+
+  /**
+   * Returns the time left from the current setpoint until a target position
+   * is reached, following the profile planned by the last Calculate().
+   *
+   * @param target The target position.
+   */
+  units::second_t TimeLeftUntil(Distance_t target) const {
+    return units::math::max(m_profile.TimeLeftUntil(target) - GetPeriod(),
+                            0_s);
+  }
+
   /**
    * Enables continuous input.
    *
@@ -269,8 +289,9 @@ class ProfiledPIDController
       m_setpoint.position = setpointMinDistance + measurement;
     }
 
-    frc::TrapezoidProfile<Distance> profile{m_constraints, m_goal, m_setpoint};
-    m_setpoint = profile.Calculate(GetPeriod());
+    m_profile =
+        frc::TrapezoidProfile<Distance>{m_constraints, m_goal, m_setpoint};
+    m_setpoint = m_profile.Calculate(GetPeriod());
     return m_controller.Calculate(measurement.template to<double>(),
                                   m_setpoint.position.template to<double>());
   }
@@ -360,6 +381,7 @@ class ProfiledPIDController
   typename frc::TrapezoidProfile<Distance>::State m_goal;
   typename frc::TrapezoidProfile<Distance>::State m_setpoint;
   typename frc::TrapezoidProfile<Distance>::Constraints m_constraints;
+  frc::TrapezoidProfile<Distance> m_profile;
 };
 
 }  // namespace frc
@@ -0,0 +1,511 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <wpi/span.h>
+
+#include "frc/MathUtil.h"
+#include "frc/trajectory/TrapezoidProfile.h"
+#include "units/math.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * A set of profiled PID controllers for many axes of the same kind (e.g. the
+ * steering of each swerve module), updated together by one Calculate() call.
+ *
+ * Each axis behaves like a ProfiledPIDController, but its state is kept in an
+ * array per field, and its trapezoid profile is kept between calls: the
+ * profile is only planned again when the axis's goal or constraints change, it
+ * is reset, or continuous input wraps the goal and setpoint differently.
+ * Otherwise each call just advances along it, so TotalTime() and
+ * TimeLeftUntil() stay available without recomputing the profile.
+ */
+template <class Distance>
+class ProfiledPIDControllerBank {
+ public:
+  using Distance_t = units::unit_t<Distance>;
+  using Velocity =
+      units::compound_unit<Distance, units::inverse<units::seconds>>;
+  using Velocity_t = units::unit_t<Velocity>;
+  using State = typename TrapezoidProfile<Distance>::State;
+  using Constraints = typename TrapezoidProfile<Distance>::Constraints;
+
+  /**
+   * Constructs a bank of controllers, all with the same gains and constraints.
+   * Call Reset() for each axis before it starts running.
+   *
+   * @param size        The number of axes.
+   * @param Kp          The proportional coefficient.
+   * @param Ki          The integral coefficient.
+   * @param Kd          The derivative coefficient.
+   * @param constraints Velocity and acceleration constraints for goals.
+   * @param period      The period between controller updates in seconds. The
+   *                    default is 20 milliseconds.
+   */
+  ProfiledPIDControllerBank(size_t size, double Kp, double Ki, double Kd,
+                            Constraints constraints,
+                            units::second_t period = 20_ms)
+      : m_period{period.value()},
+        m_Kp(size, Kp),
+        m_Ki(size, Ki),
+        m_Kd(size, Kd),
+        m_minimumIntegral(size, -1.0),
+        m_maximumIntegral(size, 1.0),
+        m_continuous(size, false),
+        m_minimumInput(size, 0.0),
+        m_maximumInput(size, 0.0),
+        m_positionTolerance(size, 0.05),
+        m_velocityTolerance(size, std::numeric_limits<double>::infinity()),
+        m_positionError(size, 0.0),
+        m_velocityError(size, 0.0),
+        m_prevError(size, 0.0),
+        m_totalError(size, 0.0),
+        m_constraints(size, constraints),
+        m_goalPosition(size, 0.0),
+        m_goalVelocity(size, 0.0),
+        m_setpointPosition(size, 0.0),
+        m_setpointVelocity(size, 0.0),
+        m_replan(size, true),
+        m_direction(size, 1.0),
+        m_initialPosition(size, 0.0),
+        m_initialVelocity(size, 0.0),
+        m_finalPosition(size, 0.0),
+        m_finalVelocity(size, 0.0),
+        m_endAccel(size, 0.0),
+        m_endFullSpeed(size, 0.0),
+        m_endDeccel(size, 0.0),
+        m_time(size, 0.0) {
+    if (period <= 0_s) {
+      m_period = 0.02;
+    }
+  }
+
+  /**
+   * Returns the number of axes.
+   */
+  size_t size() const { return m_Kp.size(); }
+
+  /**
+   * Gets the period of the controllers.
+   */
+  units::second_t GetPeriod() const { return units::second_t{m_period}; }
+
+  /**
+   * Sets the gains of an axis.
+   *
+   * @param i  The axis.
+   * @param Kp Proportional coefficient
+   * @param Ki Integral coefficient
+   * @param Kd Differential coefficient
+   */
+  void SetPID(size_t i, double Kp, double Ki, double Kd) {
+    m_Kp[i] = Kp;
+    m_Ki[i] = Ki;
+    m_Kd[i] = Kd;
+  }
+
+  /**
+   * Sets the velocity and acceleration constraints of an axis.
+   *
+   * @param i           The axis.
+   * @param constraints Velocity and acceleration constraints for goal.
+   */
+  void SetConstraints(size_t i, Constraints constraints) {
+    m_constraints[i] = constraints;
+    m_replan[i] = true;
+  }
+
+  /**
+   * Sets the goal of an axis.
+   *
+   * @param i    The axis.
+   * @param goal The desired unprofiled setpoint.
+   */
+  void SetGoal(size_t i, State goal) {
+    if (goal.position.value() != m_goalPosition[i] ||
+        goal.velocity.value() != m_goalVelocity[i]) {
+      m_goalPosition[i] = goal.position.value();
+      m_goalVelocity[i] = goal.velocity.value();
+      m_replan[i] = true;
+    }
+  }
+
+  /**
+   * Sets the goal of an axis, at rest.
+   *
+   * @param i    The axis.
+   * @param goal The desired unprofiled setpoint.
+   */
+  void SetGoal(size_t i, Distance_t goal) { SetGoal(i, {goal, Velocity_t{0}}); }
+
+  /**
+   * Gets the goal of an axis.
+   *
+   * @param i The axis.
+   */
+  State GetGoal(size_t i) const {
+    return {Distance_t{m_goalPosition[i]}, Velocity_t{m_goalVelocity[i]}};
+  }
+
+  /**
+   * Gets the current setpoint of an axis.
+   *
+   * @param i The axis.
+   */
+  State GetSetpoint(size_t i) const {
+    return {Distance_t{m_setpointPosition[i]},
+            Velocity_t{m_setpointVelocity[i]}};
+  }
+
+  /**
+   * Enables continuous input for an axis.
+   *
+   * @param i            The axis.
+   * @param minimumInput The minimum value expected from the input.
+   * @param maximumInput The maximum value expected from the input.
+   */
+  void EnableContinuousInput(size_t i, Distance_t minimumInput,
+                             Distance_t maximumInput) {
+    m_continuous[i] = true;
+    m_minimumInput[i] = minimumInput.value();
+    m_maximumInput[i] = maximumInput.value();
+  }
+
+  /**
+   * Disables continuous input for an axis.
+   *
+   * @param i The axis.
+   */
+  void DisableContinuousInput(size_t i) { m_continuous[i] = false; }
+
+  /**
+   * Sets the minimum and maximum values for the integrator of an axis.
+   *
+   * @param i               The axis.
+   * @param minimumIntegral The minimum value of the integrator.
+   * @param maximumIntegral The maximum value of the integrator.
+   */
+  void SetIntegratorRange(size_t i, double minimumIntegral,
+                          double maximumIntegral) {
+    m_minimumIntegral[i] = minimumIntegral;
+    m_maximumIntegral[i] = maximumIntegral;
+  }
+
+  /**
+   * Sets the error of an axis which is considered tolerable for use with
+   * AtSetpoint().
+   *
+   * @param i                 The axis.
+   * @param positionTolerance Position error which is tolerable.
+   * @param velocityTolerance Velocity error which is tolerable.
+   */
+  void SetTolerance(
+      size_t i, Distance_t positionTolerance,
+      Velocity_t velocityTolerance = std::numeric_limits<double>::infinity()) {
+    m_positionTolerance[i] = positionTolerance.value();
+    m_velocityTolerance[i] = velocityTolerance.value();
+  }
+
+  /**
+   * Returns the difference between the setpoint and the measurement of an
+   * axis, as of the last Calculate().
+   *
+   * @param i The axis.
+   */
+  Distance_t GetPositionError(size_t i) const {
+    return Distance_t{m_positionError[i]};
+  }
+
+  /**
+   * Returns the change in error per second of an axis.
+   *
+   * @param i The axis.
+   */
+  Velocity_t GetVelocityError(size_t i) const {
+    return Velocity_t{m_velocityError[i]};
+  }
+
+  /**
+   * Returns true if the error of an axis is within its tolerance.
+   *
+   * @param i The axis.
+   */
+  bool AtSetpoint(size_t i) const {
+    return std::abs(m_positionError[i]) < m_positionTolerance[i] &&
+           std::abs(m_velocityError[i]) < m_velocityTolerance[i];
+  }
+
+  /**
+   * Returns true if an axis is within tolerance of its setpoint and the
+   * setpoint has reached the goal.
+   *
+   * @param i The axis.
+   */
+  bool AtGoal(size_t i) const {
+    return AtSetpoint(i) && GetGoal(i) == GetSetpoint(i);
+  }
+
+  /**
+   * Returns the total time of an axis's current profile, from where it was
+   * planned to the goal.
+   *
+   * @param i The axis.
+   */
+  units::second_t TotalTime(size_t i) const {
+    return units::second_t{m_endDeccel[i]};
+  }
+
+  /**
+   * Returns the time left from the current setpoint of an axis until a target
+   * position is reached, following its current profile.
+   *
+   * @param i      The axis.
+   * @param target The target position.
+   */
+  units::second_t TimeLeftUntil(size_t i, Distance_t target) const {
+    double direction = m_direction[i];
+    TrapezoidProfile<Distance> profile{
+        m_constraints[i],
+        {Distance_t{m_finalPosition[i] * direction},
+         Velocity_t{m_finalVelocity[i] * direction}},
+        {Distance_t{m_initialPosition[i] * direction},
+         Velocity_t{m_initialVelocity[i] * direction}}};
+    return units::math::max(
+        profile.TimeLeftUntil(target) - units::second_t{m_time[i]}, 0_s);
+  }
+
+  /**
+   * Resets the error terms of an axis and starts its setpoint at a measured
+   * state.
+   *
+   * @param i           The axis.
+   * @param measurement The current measured state of the axis.
+   */
+  void Reset(size_t i, const State& measurement) {
+    m_prevError[i] = 0;
+    m_totalError[i] = 0;
+    m_setpointPosition[i] = measurement.position.value();
+    m_setpointVelocity[i] = measurement.velocity.value();
+    m_replan[i] = true;
+  }
+
+  /**
+   * Resets the error terms of an axis and starts its setpoint at a measured
+   * position.
+   *
+   * @param i                The axis.
+   * @param measuredPosition The current measured position of the axis.
+   * @param measuredVelocity The current measured velocity of the axis.
+   */
+  void Reset(size_t i, Distance_t measuredPosition,
+             Velocity_t measuredVelocity = Velocity_t{0}) {
+    Reset(i, State{measuredPosition, measuredVelocity});
+  }
+
+  /**
+   * Advances every axis's setpoint by one period and calculates the outputs.
+   *
+   * @param measurements The current measurement of each axis.
+   * @param outputs      Where to store the output of each axis.
+   */
+  void Calculate(wpi::span<const Distance_t> measurements,
+                 wpi::span<double> outputs) {
+    size_t n = size();
+    for (size_t i = 0; i < n; ++i) {
+      if (m_continuous[i]) {
+        WrapToMeasurement(i, measurements[i].value());
+      }
+      if (m_replan[i]) {
+        Plan(i);
+      }
+      m_time[i] += m_period;
+      Sample(i);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      double measurement = measurements[i].value();
+      double error = m_setpointPosition[i] - measurement;
+      if (m_continuous[i]) {
+        double errorBound = (m_maximumInput[i] - m_minimumInput[i]) / 2.0;
+        error = frc::InputModulus(error, -errorBound, errorBound);
+      }
+      m_prevError[i] = m_positionError[i];
+      m_positionError[i] = error;
+      m_velocityError[i] = (error - m_prevError[i]) / m_period;
+      if (m_Ki[i] != 0) {
+        m_totalError[i] =
+            std::clamp(m_totalError[i] + error * m_period,
+                       m_minimumIntegral[i] / m_Ki[i],
+                       m_maximumIntegral[i] / m_Ki[i]);
+      }
+      outputs[i] = m_Kp[i] * error + m_Ki[i] * m_totalError[i] +
+                   m_Kd[i] * m_velocityError[i];
+    }
+  }
+
+ private:
+  // Moves the goal and setpoint to within half the input range of the
+  // measurement, like ProfiledPIDController does. Moving both by the same
+  // amount moves the profile with them; otherwise it has to be planned again.
+  void WrapToMeasurement(size_t i, double measurement) {
+    double range = m_maximumInput[i] - m_minimumInput[i];
+    double errorBound = range / 2.0;
+    double goalShift = WrapShift(m_goalPosition[i], measurement, errorBound);
+    double setpointShift =
+        WrapShift(m_setpointPosition[i], measurement, errorBound);
+    if (goalShift == 0 && setpointShift == 0) {
+      return;
+    }
+    m_goalPosition[i] += goalShift;
+    m_setpointPosition[i] += setpointShift;
+    if (goalShift == setpointShift) {
+      m_initialPosition[i] += goalShift * m_direction[i];
+      m_finalPosition[i] += goalShift * m_direction[i];
+    } else {
+      m_replan[i] = true;
+    }
+  }
+
+  // The whole number of input ranges to add to position to bring it within
+  // errorBound of measurement.
+  static double WrapShift(double position, double measurement,
+                          double errorBound) {
+    double wrapped =
+        frc::InputModulus(position - measurement, -errorBound, errorBound) +
+        measurement;
+    return std::round((wrapped - position) / (2 * errorBound)) *
+           (2 * errorBound);
+  }
+
+  // Plans the profile from the current setpoint to the goal, in the same way
+  // as TrapezoidProfile's constructor.
+  void Plan(size_t i) {
+    double maxVelocity = m_constraints[i].maxVelocity.value();
+    double maxAcceleration = m_constraints[i].maxAcceleration.value();
+    double direction =
+        m_setpointPosition[i] > m_goalPosition[i] ? -1.0 : 1.0;
+    double initialPosition = m_setpointPosition[i] * direction;
+    double initialVelocity =
+        std::min(m_setpointVelocity[i] * direction, maxVelocity);
+    double finalPosition = m_goalPosition[i] * direction;
+    double finalVelocity = m_goalVelocity[i] * direction;
+
+    // Plan as if the profile began and ended at zero velocity
+    double cutoffBegin = initialVelocity / maxAcceleration;
+    double cutoffDistBegin = cutoffBegin * cutoffBegin * maxAcceleration / 2.0;
+    double cutoffEnd = finalVelocity / maxAcceleration;
+    double cutoffDistEnd = cutoffEnd * cutoffEnd * maxAcceleration / 2.0;
+
+    double fullTrapezoidDist =
+        cutoffDistBegin + (finalPosition - initialPosition) + cutoffDistEnd;
+    double accelerationTime = maxVelocity / maxAcceleration;
+    double fullSpeedDist = fullTrapezoidDist - accelerationTime *
+                                                   accelerationTime *
+                                                   maxAcceleration;
+
+    // The profile never reaches full speed
+    if (fullSpeedDist < 0) {
+      accelerationTime = std::sqrt(fullTrapezoidDist / maxAcceleration);
+      fullSpeedDist = 0;
+    }
+
+    m_direction[i] = direction;
+    m_initialPosition[i] = initialPosition;
+    m_initialVelocity[i] = initialVelocity;
+    m_finalPosition[i] = finalPosition;
+    m_finalVelocity[i] = finalVelocity;
+    m_endAccel[i] = accelerationTime - cutoffBegin;
+    m_endFullSpeed[i] = m_endAccel[i] + fullSpeedDist / maxVelocity;
+    m_endDeccel[i] = m_endFullSpeed[i] + accelerationTime - cutoffEnd;
+    m_time[i] = 0;
+    m_replan[i] = false;
+  }
+
+  // Sets the setpoint to the profile's state at the current time, in the same
+  // way as TrapezoidProfile::Calculate().
+  void Sample(size_t i) {
+    double t = m_time[i];
+    double maxVelocity = m_constraints[i].maxVelocity.value();
+    double maxAcceleration = m_constraints[i].maxAcceleration.value();
+    double initialVelocity = m_initialVelocity[i];
+    double position;
+    double velocity;
+    if (t < m_endAccel[i]) {
+      velocity = initialVelocity + t * maxAcceleration;
+      position = m_initialPosition[i] +
+                 (initialVelocity + t * maxAcceleration / 2.0) * t;
+    } else if (t < m_endFullSpeed[i]) {
+      double endAccel = m_endAccel[i];
+      velocity = maxVelocity;
+      position = m_initialPosition[i] +
+                 (initialVelocity + endAccel * maxAcceleration / 2.0) *
+                     endAccel +
+                 maxVelocity * (t - endAccel);
+    } else if (t <= m_endDeccel[i]) {
+      double timeLeft = m_endDeccel[i] - t;
+      velocity = m_finalVelocity[i] + timeLeft * maxAcceleration;
+      position = m_finalPosition[i] -
+                 (m_finalVelocity[i] + timeLeft * maxAcceleration / 2.0) *
+                     timeLeft;
+    } else {
+      position = m_finalPosition[i];
+      velocity = m_finalVelocity[i];
+    }
+    m_setpointPosition[i] = position * m_direction[i];
+    m_setpointVelocity[i] = velocity * m_direction[i];
+  }
+
+  double m_period;
+
+  // Gains and limits
+  std::vector<double> m_Kp;
+  std::vector<double> m_Ki;
+  std::vector<double> m_Kd;
+  std::vector<double> m_minimumIntegral;
+  std::vector<double> m_maximumIntegral;
+  std::vector<uint8_t> m_continuous;
+  std::vector<double> m_minimumInput;
+  std::vector<double> m_maximumInput;
+  std::vector<double> m_positionTolerance;
+  std::vector<double> m_velocityTolerance;
+
+  // PID state
+  std::vector<double> m_positionError;
+  std::vector<double> m_velocityError;
+  std::vector<double> m_prevError;
+  std::vector<double> m_totalError;
+
+  // Goals and setpoints
+  std::vector<Constraints> m_constraints;
+  std::vector<double> m_goalPosition;
+  std::vector<double> m_goalVelocity;
+  std::vector<double> m_setpointPosition;
+  std::vector<double> m_setpointVelocity;
+
+  // Current profiles, with positions and velocities flipped by m_direction
+  // so they move forward; m_time is the time since each was planned
+  std::vector<uint8_t> m_replan;
+  std::vector<double> m_direction;
+  std::vector<double> m_initialPosition;
+  std::vector<double> m_initialVelocity;
+  std::vector<double> m_finalPosition;
+  std::vector<double> m_finalVelocity;
+  std::vector<double> m_endAccel;
+  std::vector<double> m_endFullSpeed;
+  std::vector<double> m_endDeccel;
+  std::vector<double> m_time;
+};
+
+}  // namespace frc
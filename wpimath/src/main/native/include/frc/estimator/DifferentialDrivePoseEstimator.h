@@ -5,10 +5,13 @@
 #pragma once
 
 #include <wpi/array.h>
+#include <wpi/span.h>
 
 #include "Eigen/Core"
+#include "frc/estimator/AngleStatistics.h"
+#include "frc/estimator/InlineUnscentedKalmanFilter.h"
 #include "frc/estimator/KalmanFilterLatencyCompensator.h"
-#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/estimator/VisionMeasurement.h"
 #include "frc/geometry/Pose2d.h"
 #include "frc/geometry/Rotation2d.h"
 #include "frc/kinematics/DifferentialDriveWheelSpeeds.h"
@@ -94,6 +97,19 @@ class DifferentialDrivePoseEstimator {
   void SetVisionMeasurementStdDevs(
       const wpi::array<double, 3>& visionMeasurementStdDevs);
 
+  /**
+   * Sets how vision measurements, which arrive late, are brought forward to
+   * the present. LatencyReplayMode::kDeltas reapplies the odometry since the
+   * measurement to the corrected pose instead of rerunning the filter for
+   * every update since, which is much cheaper with high latency or update
+   * rates. The default is LatencyReplayMode::kFilter.
+   *
+   * @param mode How to replay past updates.
+   */
+  void SetLatencyReplayMode(LatencyReplayMode mode) {
+    m_latencyReplayMode = mode;
+  }
+
   /**
    * Resets the robot's position on the field.
    *
@@ -173,6 +189,18 @@ class DifferentialDrivePoseEstimator {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * Adds several vision measurements to the Unscented Kalman Filter at once,
+   * such as the poses from every camera in a loop. The history since the
+   * oldest of them is replayed once, rather than once per measurement.
+   *
+   * Standard deviations given with a measurement only apply to it.
+   *
+   * @param measurements The vision measurements, in any order.
+   */
+  void AddVisionMeasurements(
+      wpi::span<const VisionMeasurement> measurements);
+
   /**
    * Updates the Unscented Kalman Filter using only wheel encoder information.
    * Note that this should be called every loop iteration.
@@ -205,12 +233,55 @@ class DifferentialDrivePoseEstimator {
                         units::meter_t rightDistance);
 
  private:
-  UnscentedKalmanFilter<5, 3, 3> m_observer;
-  KalmanFilterLatencyCompensator<5, 3, 3, UnscentedKalmanFilter<5, 3, 3>>
+  // The filter's functions, inlined into it. The state is
+  // [x, y, theta, dist_l, dist_r]ᵀ; the measurement is
+  // [dist_l, dist_r, theta]ᵀ.
+  struct Model : UnscentedKalmanFilterModel<5, 3, 3> {
+    static Eigen::Matrix<double, 5, 1> F(const Eigen::Matrix<double, 5, 1>& x,
+                                         const Eigen::Matrix<double, 3, 1>& u) {
+      return DifferentialDrivePoseEstimator::F(x, u);
+    }
+    static Eigen::Matrix<double, 3, 1> H(const Eigen::Matrix<double, 5, 1>& x,
+                                         const Eigen::Matrix<double, 3, 1>& u) {
+      Eigen::Matrix<double, 3, 1> y;
+      y << x(3, 0), x(4, 0), x(2, 0);
+      return y;
+    }
+    static Eigen::Matrix<double, 5, 1> MeanX(
+        const Eigen::Matrix<double, 5, 11>& sigmas,
+        const Eigen::Matrix<double, 11, 1>& Wm) {
+      return AngleMean<5, 5>(sigmas, Wm, 2);
+    }
+    static Eigen::Matrix<double, 3, 1> MeanY(
+        const Eigen::Matrix<double, 3, 11>& sigmas,
+        const Eigen::Matrix<double, 11, 1>& Wc) {
+      return AngleMean<3, 5>(sigmas, Wc, 2);
+    }
+    static Eigen::Matrix<double, 5, 1> ResidualX(
+        const Eigen::Matrix<double, 5, 1>& a,
+        const Eigen::Matrix<double, 5, 1>& b) {
+      return AngleResidual<5>(a, b, 2);
+    }
+    static Eigen::Matrix<double, 3, 1> ResidualY(
+        const Eigen::Matrix<double, 3, 1>& a,
+        const Eigen::Matrix<double, 3, 1>& b) {
+      return AngleResidual<3>(a, b, 2);
+    }
+    static Eigen::Matrix<double, 5, 1> AddX(
+        const Eigen::Matrix<double, 5, 1>& a,
+        const Eigen::Matrix<double, 5, 1>& b) {
+      return AngleAdd<5>(a, b, 2);
+    }
+  };
+
+  InlineUnscentedKalmanFilter<5, 3, 3, Model> m_observer;
+  KalmanFilterLatencyCompensator<5, 3, 3,
+                                 InlineUnscentedKalmanFilter<5, 3, 3, Model>>
       m_latencyCompensator;
   std::function<void(const Eigen::Matrix<double, 3, 1>& u,
                      const Eigen::Matrix<double, 3, 1>& y)>
       m_visionCorrect;
+  LatencyReplayMode m_latencyReplayMode = LatencyReplayMode::kFilter;
 
   Eigen::Matrix<double, 3, 3> m_visionContR;
 
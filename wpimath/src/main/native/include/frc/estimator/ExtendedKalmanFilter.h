@@ -5,6 +5,7 @@
 #pragma once
 
 #include <functional>
+#include <utility>
 
 #include <wpi/array.h>
 
@@ -12,6 +13,7 @@
 #include "Eigen/src/Cholesky/LDLT.h"
 #include "drake/math/discrete_algebraic_riccati_equation.h"
 #include "frc/StateSpaceUtil.h"
+#include "frc/system/AutoDiffJacobian.h"
 #include "frc/system/Discretization.h"
 #include "frc/system/NumericalIntegration.h"
 #include "frc/system/NumericalJacobian.h"
@@ -196,6 +198,43 @@ class ExtendedKalmanFilter {
    */
   void SetXhat(int i, double value) { m_xHat(i, 0) = value; }
 
+  /**
+   * Sets functions that return the Jacobians of f and h with respect to x,
+   * used by Predict() and Correct() in place of numerically differentiating f
+   * and h. Numerical differentiation evaluates them 2 * States times per step;
+   * AutoDiffJacobianX() gives exact Jacobians from one evaluation of f and h
+   * written for any scalar type:
+   *
+   * @code{.cpp}
+   * filter.SetJacobians(
+   *     [](const auto& x, const auto& u) {
+   *       return frc::AutoDiffJacobianX<States, States, Inputs>(f, x, u);
+   *     },
+   *     [](const auto& x, const auto& u) {
+   *       return frc::AutoDiffJacobianX<Outputs, States, Inputs>(h, x, u);
+   *     });
+   * @endcode
+   *
+   * The Correct() overloads taking their own h differentiate it numerically,
+   * unless also given its Jacobian.
+   *
+   * @param dfdx A function of x and u that returns the Jacobian of f with
+   *             respect to x, or nullptr to differentiate f numerically.
+   * @param dhdx A function of x and u that returns the Jacobian of h with
+   *             respect to x, or nullptr to differentiate h numerically.
+   */
+  void SetJacobians(std::function<Eigen::Matrix<double, States, States>(
+                        const Eigen::Matrix<double, States, 1>&,
+                        const Eigen::Matrix<double, Inputs, 1>&)>
+                        dfdx,
+                    std::function<Eigen::Matrix<double, Outputs, States>(
+                        const Eigen::Matrix<double, States, 1>&,
+                        const Eigen::Matrix<double, Inputs, 1>&)>
+                        dhdx) {
+    m_dfdx = std::move(dfdx);
+    m_dhdx = std::move(dhdx);
+  }
+
   /**
    * Resets the observer.
    */
@@ -213,7 +252,8 @@ class ExtendedKalmanFilter {
   void Predict(const Eigen::Matrix<double, Inputs, 1>& u, units::second_t dt) {
     // Find continuous A
     Eigen::Matrix<double, States, States> contA =
-        NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
+        m_dfdx ? m_dfdx(m_xHat, u)
+               : NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
 
     // Find discrete A and Q
     Eigen::Matrix<double, States, States> discA;
@@ -236,7 +276,12 @@ class ExtendedKalmanFilter {
    */
   void Correct(const Eigen::Matrix<double, Inputs, 1>& u,
                const Eigen::Matrix<double, Outputs, 1>& y) {
-    Correct<Outputs>(u, y, m_h, m_contR, m_residualFuncY, m_addFuncX);
+    if (m_dhdx) {
+      Correct<Outputs>(u, y, m_h, m_dhdx(m_xHat, u), m_contR, m_residualFuncY,
+                       m_addFuncX);
+    } else {
+      Correct<Outputs>(u, y, m_h, m_contR, m_residualFuncY, m_addFuncX);
+    }
   }
 
   template <int Rows>
@@ -288,8 +333,32 @@ class ExtendedKalmanFilter {
                    const Eigen::Matrix<double, States, 1>&,
                    const Eigen::Matrix<double, States, 1>)>
                    addFuncX) {
-    const Eigen::Matrix<double, Rows, States> C =
-        NumericalJacobianX<Rows, States, Inputs>(h, m_xHat, u);
+    Correct<Rows>(u, y, h,
+                  NumericalJacobianX<Rows, States, Inputs>(h, m_xHat, u), R,
+                  residualFuncY, addFuncX);
+  }
+
+  /**
+   * Correct the state estimate x-hat using the measurements in y, given the
+   * Jacobian of h at x-hat (for example from AutoDiffJacobianX()).
+   *
+   * @param u             Same control input used in the predict step.
+   * @param y             Measurement vector.
+   * @param h             A vector-valued function of x and u that returns
+   *                      the measurement vector.
+   * @param C             The Jacobian of h with respect to x at the current
+   *                      state estimate x-hat.
+   * @param R             Discrete measurement noise covariance matrix.
+   * @param residualFuncY A function that computes the residual of two
+   *                      measurement vectors (i.e. it subtracts them.)
+   * @param addFuncX      A function that adds two state vectors.
+   */
+  template <int Rows, typename H, typename ResidualFuncY, typename AddFuncX>
+  void Correct(const Eigen::Matrix<double, Inputs, 1>& u,
+               const Eigen::Matrix<double, Rows, 1>& y, H&& h,
+               const Eigen::Matrix<double, Rows, States>& C,
+               const Eigen::Matrix<double, Rows, Rows>& R,
+               ResidualFuncY&& residualFuncY, AddFuncX&& addFuncX) {
     const Eigen::Matrix<double, Rows, Rows> discR = DiscretizeR<Rows>(R, m_dt);
 
     Eigen::Matrix<double, Rows, Rows> S = C * m_P * C.transpose() + discR;
@@ -316,7 +385,6 @@ class ExtendedKalmanFilter {
     m_P = (Eigen::Matrix<double, States, States>::Identity() - K * C) * m_P;
   }
 
- private:
   std::function<Eigen::Matrix<double, States, 1>(
       const Eigen::Matrix<double, States, 1>&,
       const Eigen::Matrix<double, Inputs, 1>&)>
@@ -333,6 +401,14 @@ class ExtendedKalmanFilter {
       const Eigen::Matrix<double, States, 1>&,
       const Eigen::Matrix<double, States, 1>)>
       m_addFuncX;
+  std::function<Eigen::Matrix<double, States, States>(
+      const Eigen::Matrix<double, States, 1>&,
+      const Eigen::Matrix<double, Inputs, 1>&)>
+      m_dfdx;
+  std::function<Eigen::Matrix<double, Outputs, States>(
+      const Eigen::Matrix<double, States, 1>&,
+      const Eigen::Matrix<double, Inputs, 1>&)>
+      m_dhdx;
   Eigen::Matrix<double, States, 1> m_xHat;
   Eigen::Matrix<double, States, States> m_P;
   Eigen::Matrix<double, States, States> m_contQ;
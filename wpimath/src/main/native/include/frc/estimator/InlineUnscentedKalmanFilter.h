@@ -0,0 +1,292 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <utility>
+
+#include <wpi/ThreadPool.h>
+#include <wpi/array.h>
+
+#include "Eigen/Core"
+#include "frc/StateSpaceUtil.h"
+#include "frc/estimator/MerweScaledSigmaPoints.h"
+#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * The default arithmetic for an InlineUnscentedKalmanFilter model: plain
+ * weighted means, subtraction and addition. Models derive from this and add
+ * their dynamics F(x, u) and measurement H(x, u), overriding the arithmetic
+ * for states or measurements that need it (e.g. angles).
+ */
+template <int States, int Inputs, int Outputs>
+struct UnscentedKalmanFilterModel {
+  static Eigen::Matrix<double, States, 1> MeanX(
+      const Eigen::Matrix<double, States, 2 * States + 1>& sigmas,
+      const Eigen::Matrix<double, 2 * States + 1, 1>& Wm) {
+    return sigmas * Wm;
+  }
+
+  static Eigen::Matrix<double, Outputs, 1> MeanY(
+      const Eigen::Matrix<double, Outputs, 2 * States + 1>& sigmas,
+      const Eigen::Matrix<double, 2 * States + 1, 1>& Wc) {
+    return sigmas * Wc;
+  }
+
+  static Eigen::Matrix<double, States, 1> ResidualX(
+      const Eigen::Matrix<double, States, 1>& a,
+      const Eigen::Matrix<double, States, 1>& b) {
+    return a - b;
+  }
+
+  static Eigen::Matrix<double, Outputs, 1> ResidualY(
+      const Eigen::Matrix<double, Outputs, 1>& a,
+      const Eigen::Matrix<double, Outputs, 1>& b) {
+    return a - b;
+  }
+
+  static Eigen::Matrix<double, States, 1> AddX(
+      const Eigen::Matrix<double, States, 1>& a,
+      const Eigen::Matrix<double, States, 1>& b) {
+    return a + b;
+  }
+};
+
+/**
+ * An unscented Kalman filter whose functions are given by a model type
+ * instead of std::functions, so they can be inlined into the sigma point
+ * propagation. It's otherwise the same as UnscentedKalmanFilter, and doesn't
+ * allocate.
+ *
+ * The model must have these members (usually by deriving from
+ * UnscentedKalmanFilterModel, which provides the arithmetic):
+ *
+ * - F(x, u): the derivative of the state vector
+ * - H(x, u): the measurement vector
+ * - MeanX(sigmas, Wm) and MeanY(sigmas, Wc): the weighted mean of state and
+ *   measurement sigma points
+ * - ResidualX(a, b) and ResidualY(a, b): the residual of two state or
+ *   measurement vectors
+ * - AddX(a, b): the sum of two state vectors
+ *
+ * @tparam Model The model type.
+ */
+template <int States, int Inputs, int Outputs, typename Model>
+class InlineUnscentedKalmanFilter {
+ public:
+  /**
+   * Constructs an unscented Kalman filter.
+   *
+   * @param model              The model.
+   * @param stateStdDevs       Standard deviations of model states.
+   * @param measurementStdDevs Standard deviations of measurements.
+   * @param dt                 Nominal discretization timestep.
+   */
+  InlineUnscentedKalmanFilter(
+      Model model, const wpi::array<double, States>& stateStdDevs,
+      const wpi::array<double, Outputs>& measurementStdDevs,
+      units::second_t dt)
+      : m_model(std::move(model)) {
+    m_contQ = MakeCovMatrix(stateStdDevs);
+    m_contR = MakeCovMatrix(measurementStdDevs);
+    m_dt = dt;
+
+    Reset();
+  }
+
+  /**
+   * Returns the model.
+   */
+  const Model& GetModel() const { return m_model; }
+
+  /**
+   * Returns the error covariance matrix P.
+   */
+  const Eigen::Matrix<double, States, States>& P() const { return m_P; }
+
+  /**
+   * Returns an element of the error covariance matrix P.
+   *
+   * @param i Row of P.
+   * @param j Column of P.
+   */
+  double P(int i, int j) const { return m_P(i, j); }
+
+  /**
+   * Set the current error covariance matrix P.
+   *
+   * @param P The error covariance matrix P.
+   */
+  void SetP(const Eigen::Matrix<double, States, States>& P) { m_P = P; }
+
+  /**
+   * Returns the state estimate x-hat.
+   */
+  const Eigen::Matrix<double, States, 1>& Xhat() const { return m_xHat; }
+
+  /**
+   * Returns an element of the state estimate x-hat.
+   *
+   * @param i Row of x-hat.
+   */
+  double Xhat(int i) const { return m_xHat(i, 0); }
+
+  /**
+   * Set initial state estimate x-hat.
+   *
+   * @param xHat The state estimate x-hat.
+   */
+  void SetXhat(const Eigen::Matrix<double, States, 1>& xHat) { m_xHat = xHat; }
+
+  /**
+   * Set an element of the initial state estimate x-hat.
+   *
+   * @param i     Row of x-hat.
+   * @param value Value for element of x-hat.
+   */
+  void SetXhat(int i, double value) { m_xHat(i, 0) = value; }
+
+  /**
+   * Sets a thread pool on which to propagate the sigma points through the
+   * dynamics in Predict(). The sigma points are independent, so for filters
+   * with expensive dynamics this spreads most of the prediction's work over
+   * the pool. The model's F(x, u) must then be safe to call from several
+   * threads at once.
+   *
+   * Filters with fewer than minStates states keep propagating the sigma points
+   * on the calling thread.
+   *
+   * @param pool      The thread pool, or nullptr to propagate the sigma points
+   *                  on the calling thread. It must outlive the filter, or be
+   *                  unset first.
+   * @param minStates The smallest number of states for which the pool is
+   *                  used.
+   */
+  void SetThreadPool(wpi::ThreadPool* pool,
+                     int minStates = detail::kUnscentedParallelMinStates) {
+    m_pool = States >= minStates ? pool : nullptr;
+  }
+
+  /**
+   * Resets the observer.
+   */
+  void Reset() {
+    m_xHat.setZero();
+    m_P.setZero();
+    m_sigmasF.setZero();
+  }
+
+  /**
+   * Project the model into the future with a new control input u.
+   *
+   * @param u  New control input from controller.
+   * @param dt Timestep for prediction.
+   */
+  void Predict(const Eigen::Matrix<double, Inputs, 1>& u, units::second_t dt) {
+    m_dt = dt;
+    detail::UnscentedPredict<States, Inputs>(
+        [&](const auto& x, const auto& u) { return m_model.F(x, u); },
+        [&](const auto& sigmas, const auto& Wm) {
+          return m_model.MeanX(sigmas, Wm);
+        },
+        [&](const auto& a, const auto& b) { return m_model.ResidualX(a, b); },
+        m_pts, m_contQ, u, dt, &m_xHat, &m_P, &m_sigmasF, m_pool);
+  }
+
+  /**
+   * Correct the state estimate x-hat using the measurements in y.
+   *
+   * @param u Same control input used in the predict step.
+   * @param y Measurement vector.
+   */
+  void Correct(const Eigen::Matrix<double, Inputs, 1>& u,
+               const Eigen::Matrix<double, Outputs, 1>& y) {
+    Correct<Outputs>(
+        u, y, [&](const auto& x, const auto& u) { return m_model.H(x, u); },
+        m_contR,
+        [&](const auto& sigmas, const auto& Wc) {
+          return m_model.MeanY(sigmas, Wc);
+        },
+        [&](const auto& a, const auto& b) { return m_model.ResidualY(a, b); },
+        [&](const auto& a, const auto& b) { return m_model.ResidualX(a, b); },
+        [&](const auto& a, const auto& b) { return m_model.AddX(a, b); });
+  }
+
+  /**
+   * Correct the state estimate x-hat using the measurements in y.
+   *
+   * This is useful for when the measurements available during a timestep's
+   * Correct() call vary. The model's H(x, u) is used if one is not provided
+   * (the two-argument version of this function).
+   *
+   * @param u Same control input used in the predict step.
+   * @param y Measurement vector.
+   * @param h A vector-valued function of x and u that returns the measurement
+   *          vector.
+   * @param R Measurement noise covariance matrix (continuous-time).
+   */
+  template <int Rows, typename H>
+  void Correct(const Eigen::Matrix<double, Inputs, 1>& u,
+               const Eigen::Matrix<double, Rows, 1>& y, H&& h,
+               const Eigen::Matrix<double, Rows, Rows>& R) {
+    Correct<Rows>(
+        u, y, h, R,
+        [](const auto& sigmas, const auto& Wc)
+            -> Eigen::Matrix<double, Rows, 1> { return sigmas * Wc; },
+        [](const auto& a, const auto& b) -> Eigen::Matrix<double, Rows, 1> {
+          return a - b;
+        },
+        [&](const auto& a, const auto& b) { return m_model.ResidualX(a, b); },
+        [&](const auto& a, const auto& b) { return m_model.AddX(a, b); });
+  }
+
+  /**
+   * Correct the state estimate x-hat using the measurements in y.
+   *
+   * This is useful for when the measurements available during a timestep's
+   * Correct() call vary. The model's H(x, u) is used if one is not provided
+   * (the two-argument version of this function).
+   *
+   * @param u             Same control input used in the predict step.
+   * @param y             Measurement vector.
+   * @param h             A vector-valued function of x and u that returns the
+   *                      measurement vector.
+   * @param R             Measurement noise covariance matrix (continuous-time).
+   * @param meanFuncY     A function that computes the mean of 2 * States + 1
+   *                      measurement vectors using a given set of weights.
+   * @param residualFuncY A function that computes the residual of two
+   *                      measurement vectors (i.e. it subtracts them.)
+   * @param residualFuncX A function that computes the residual of two state
+   *                      vectors (i.e. it subtracts them.)
+   * @param addFuncX      A function that adds two state vectors.
+   */
+  template <int Rows, typename H, typename MeanFuncY, typename ResidualFuncY,
+            typename ResidualFuncX, typename AddFuncX>
+  void Correct(const Eigen::Matrix<double, Inputs, 1>& u,
+               const Eigen::Matrix<double, Rows, 1>& y, H&& h,
+               const Eigen::Matrix<double, Rows, Rows>& R,
+               MeanFuncY&& meanFuncY, ResidualFuncY&& residualFuncY,
+               ResidualFuncX&& residualFuncX, AddFuncX&& addFuncX) {
+    detail::UnscentedCorrect<States, Inputs, Rows>(
+        h, meanFuncY, residualFuncY, residualFuncX, addFuncX, m_pts, R, u, y,
+        m_dt, m_sigmasF, &m_xHat, &m_P);
+  }
+
+ private:
+  Model m_model;
+  Eigen::Matrix<double, States, 1> m_xHat;
+  Eigen::Matrix<double, States, States> m_P;
+  Eigen::Matrix<double, States, States> m_contQ;
+  Eigen::Matrix<double, Outputs, Outputs> m_contR;
+  Eigen::Matrix<double, States, 2 * States + 1> m_sigmasF;
+  units::second_t m_dt;
+  wpi::ThreadPool* m_pool = nullptr;
+
+  MerweScaledSigmaPoints<States> m_pts;
+};
+
+}  // namespace frc
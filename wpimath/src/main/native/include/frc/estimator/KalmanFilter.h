@@ -13,6 +13,7 @@
 #include "drake/math/discrete_algebraic_riccati_equation.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/system/Discretization.h"
+#include "frc/system/DiscretizationCache.h"
 #include "frc/system/LinearSystem.h"
 #include "units/time.h"
 #include "wpimath/MathShared.h"
@@ -50,7 +51,8 @@ class KalmanFilterImpl {
   KalmanFilterImpl(LinearSystem<States, Inputs, Outputs>& plant,
                    const wpi::array<double, States>& stateStdDevs,
                    const wpi::array<double, Outputs>& measurementStdDevs,
-                   units::second_t dt) {
+                   units::second_t dt)
+      : m_discretization{plant.A(), plant.B()} {
     m_plant = &plant;
 
     auto contQ = MakeCovMatrix(stateStdDevs);
@@ -149,11 +151,18 @@ class KalmanFilterImpl {
   /**
    * Project the model into the future with a new control input u.
    *
+   * The plant is discretized through a DiscretizationCache built from its A
+   * and B at construction, so varying timesteps don't each need a matrix
+   * exponential.
+   *
    * @param u  New control input from controller.
    * @param dt Timestep for prediction.
    */
   void Predict(const Eigen::Matrix<double, Inputs, 1>& u, units::second_t dt) {
-    m_xHat = m_plant->CalculateX(m_xHat, u, dt);
+    Eigen::Matrix<double, States, States> discA;
+    Eigen::Matrix<double, States, Inputs> discB;
+    m_discretization.DiscretizeAB(dt, &discA, &discB);
+    m_xHat = discA * m_xHat + discB * u;
   }
 
   /**
@@ -171,6 +180,8 @@ class KalmanFilterImpl {
  private:
   LinearSystem<States, Inputs, Outputs>* m_plant;
 
+  DiscretizationCache<States, Inputs> m_discretization;
+
   /**
    * The steady-state Kalman gain matrix.
    */
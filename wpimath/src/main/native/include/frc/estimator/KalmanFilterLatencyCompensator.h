@@ -6,9 +6,13 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <functional>
 #include <utility>
-#include <vector>
+
+#include <wpi/SmallVector.h>
+#include <wpi/circular_buffer.h>
+#include <wpi/span.h>
 
 #include "Eigen/Core"
 #include "units/math.h"
@@ -16,6 +20,46 @@
 
 namespace frc {
 
+/**
+ * How KalmanFilterLatencyCompensator brings the estimate back to the present
+ * after applying a past measurement.
+ */
+enum class LatencyReplayMode {
+  /// Rerun the filter's predict and correct steps for every later snapshot
+  kFilter,
+  /// Carry the change in state between later snapshots over to the corrected
+  /// state, e.g. reapplying the odometry to a corrected pose. Much cheaper,
+  /// but the error covariance isn't replayed: it's left as it was before the
+  /// measurement.
+  kDeltas
+};
+
+/**
+ * Replays the change in state between two snapshots for states that start
+ * with a field-relative x, y and heading, followed by states that add (like
+ * wheel distances). The change in position is rotated by the correction to
+ * the heading, as it was measured relative to the robot.
+ *
+ * @param oldPrev The state at the previous snapshot before the correction.
+ * @param old     The state at the snapshot before the correction.
+ * @param newPrev The state at the previous snapshot after the correction.
+ * @return The state at the snapshot after the correction.
+ */
+template <int States>
+Eigen::Matrix<double, States, 1> ReplayPoseDelta(
+    const Eigen::Matrix<double, States, 1>& oldPrev,
+    const Eigen::Matrix<double, States, 1>& old,
+    const Eigen::Matrix<double, States, 1>& newPrev) {
+  Eigen::Matrix<double, States, 1> result = newPrev + (old - oldPrev);
+  double cos = std::cos(newPrev(2) - oldPrev(2));
+  double sin = std::sin(newPrev(2) - oldPrev(2));
+  double dx = old(0) - oldPrev(0);
+  double dy = old(1) - oldPrev(1);
+  result(0) = newPrev(0) + dx * cos - dy * sin;
+  result(1) = newPrev(1) + dx * sin + dy * cos;
+  return result;
+}
+
 template <int States, int Inputs, int Outputs, typename KalmanFilterType>
 class KalmanFilterLatencyCompensator {
  public:
@@ -25,6 +69,12 @@ class KalmanFilterLatencyCompensator {
     Eigen::Matrix<double, Inputs, 1> inputs;
     Eigen::Matrix<double, Outputs, 1> localMeasurements;
 
+    ObserverSnapshot()
+        : xHat(Eigen::Matrix<double, States, 1>::Zero()),
+          errorCovariances(Eigen::Matrix<double, States, States>::Zero()),
+          inputs(Eigen::Matrix<double, Inputs, 1>::Zero()),
+          localMeasurements(Eigen::Matrix<double, Outputs, 1>::Zero()) {}
+
     ObserverSnapshot(const KalmanFilterType& observer,
                      const Eigen::Matrix<double, Inputs, 1>& u,
                      const Eigen::Matrix<double, Outputs, 1>& localY)
@@ -34,10 +84,26 @@ class KalmanFilterLatencyCompensator {
           localMeasurements(localY) {}
   };
 
+  using ReplayFunction = std::function<Eigen::Matrix<double, States, 1>(
+      const Eigen::Matrix<double, States, 1>& oldPrev,
+      const Eigen::Matrix<double, States, 1>& old,
+      const Eigen::Matrix<double, States, 1>& newPrev)>;
+
+  /**
+   * Constructs a latency compensator.
+   *
+   * @param maxSnapshots The number of observer snapshots to keep; older ones
+   *                     are dropped. Measurements older than the oldest
+   *                     snapshot are applied at it.
+   */
+  explicit KalmanFilterLatencyCompensator(
+      size_t maxSnapshots = kMaxPastObserverStates)
+      : m_pastObserverSnapshots(maxSnapshots) {}
+
   /**
    * Clears the observer snapshot buffer.
    */
-  void Reset() { m_pastObserverSnapshots.clear(); }
+  void Reset() { m_pastObserverSnapshots.reset(); }
 
   /**
    * Add past observer states to the observer snapshots list.
@@ -51,14 +117,10 @@ class KalmanFilterLatencyCompensator {
                         Eigen::Matrix<double, Inputs, 1> u,
                         Eigen::Matrix<double, Outputs, 1> localY,
                         units::second_t timestamp) {
-    // Add the new state into the vector.
-    m_pastObserverSnapshots.emplace_back(timestamp,
-                                         ObserverSnapshot{observer, u, localY});
-
-    // Remove the oldest snapshot if the vector exceeds our maximum size.
-    if (m_pastObserverSnapshots.size() > kMaxPastObserverStates) {
-      m_pastObserverSnapshots.erase(m_pastObserverSnapshots.begin());
-    }
+    // Add the new state into the buffer, overwriting the oldest snapshot if
+    // the buffer is full.
+    m_pastObserverSnapshots.push_back(
+        {timestamp, ObserverSnapshot{observer, u, localY}});
   }
 
   /**
@@ -71,6 +133,13 @@ class KalmanFilterLatencyCompensator {
    * @param globalMeasurementCorrect The function take calls correct() on the
    *                                 observer.
    * @param timestamp                The timestamp of the measurement.
+   * @param replay                   For LatencyReplayMode::kDeltas, gives the
+   *                                 corrected state at a later snapshot from
+   *                                 the state at it and the previous snapshot
+   *                                 before the correction and the corrected
+   *                                 state at the previous snapshot. If empty,
+   *                                 the filter is rerun
+   *                                 (LatencyReplayMode::kFilter).
    */
   template <int Rows>
   void ApplyPastGlobalMeasurement(
@@ -79,42 +148,77 @@ class KalmanFilterLatencyCompensator {
       std::function<void(const Eigen::Matrix<double, Inputs, 1>& u,
                          const Eigen::Matrix<double, Rows, 1>& y)>
           globalMeasurementCorrect,
-      units::second_t timestamp) {
+      units::second_t timestamp, const ReplayFunction& replay = {}) {
+    ApplyPastGlobalMeasurements(
+        observer, nominalDt, wpi::span<const units::second_t>{&timestamp, 1},
+        [&](const Eigen::Matrix<double, Inputs, 1>& u, size_t) {
+          globalMeasurementCorrect(u, y);
+        },
+        replay);
+  }
+
+  /**
+   * Add several past global measurements (such as from multiple cameras) to
+   * the estimator, replaying the history once from the oldest of them rather
+   * than once per measurement. The measurements are applied in timestamp
+   * order.
+   *
+   * @param observer                 The observer to apply the past global
+   *                                 measurements.
+   * @param nominalDt                The nominal timestep.
+   * @param timestamps               The timestamp of each measurement.
+   * @param globalMeasurementCorrect The function that calls correct() on the
+   *                                 observer with the measurement at the
+   *                                 given index.
+   * @param replay                   See ApplyPastGlobalMeasurement().
+   */
+  void ApplyPastGlobalMeasurements(
+      KalmanFilterType* observer, units::second_t nominalDt,
+      wpi::span<const units::second_t> timestamps,
+      const std::function<void(const Eigen::Matrix<double, Inputs, 1>& u,
+                               size_t index)>& globalMeasurementCorrect,
+      const ReplayFunction& replay = {}) {
     if (m_pastObserverSnapshots.size() == 0) {
       // State map was empty, which means that we got a measurement right at
       // startup. The only thing we can do is ignore the measurement.
       return;
     }
+    if (timestamps.empty()) {
+      return;
+    }
 
-    // We will perform a binary search to find the index of the element in the
-    // vector that has a timestamp that is equal to or greater than the vision
-    // measurement timestamp.
-    auto lowerBoundIter = std::lower_bound(
-        m_pastObserverSnapshots.cbegin(), m_pastObserverSnapshots.cend(),
-        timestamp,
-        [](const auto& entry, const auto& ts) { return entry.first < ts; });
-    int index = std::distance(m_pastObserverSnapshots.cbegin(), lowerBoundIter);
-
-    // High and Low should be the same. The sampled timestamp is greater than or
-    // equal to the vision pose timestamp. We will now find the entry which is
-    // closest in time to the requested timestamp.
-
-    size_t indexOfClosestEntry =
-        units::math::abs(
-            timestamp - m_pastObserverSnapshots[std::max(index - 1, 0)].first) <
-                units::math::abs(timestamp -
-                                 m_pastObserverSnapshots[index].first)
-            ? index - 1
-            : index;
+    // Pair each measurement with the snapshot it applies at, in the order
+    // they're applied.
+    wpi::SmallVector<std::pair<size_t, size_t>, 8> order;
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+      order.emplace_back(FindClosestSnapshot(timestamps[i]), i);
+    }
+    std::sort(order.begin(), order.end(), [&](const auto& a, const auto& b) {
+      if (a.first != b.first) {
+        return a.first < b.first;
+      }
+      if (timestamps[a.second] != timestamps[b.second]) {
+        return timestamps[a.second] < timestamps[b.second];
+      }
+      return a.second < b.second;
+    });
 
+    size_t indexOfClosestEntry = order.front().first;
     units::second_t lastTimestamp =
         m_pastObserverSnapshots[indexOfClosestEntry].first - nominalDt;
 
+    if (replay) {
+      ReplayDeltas(observer, order, lastTimestamp, globalMeasurementCorrect,
+                   replay);
+      return;
+    }
+
     // We will now go back in time to the state of the system at the time when
-    // the measurement was captured. We will reset the observer to that state,
-    // and apply correction based on the measurement. Then, we will go back
-    // through all observer states until the present and apply past inputs to
-    // get the present estimated state.
+    // the oldest measurement was captured. We will reset the observer to that
+    // state, and apply correction based on the measurements as we reach them.
+    // Then, we will go back through all observer states until the present and
+    // apply past inputs to get the present estimated state.
+    auto next = order.begin();
     for (size_t i = indexOfClosestEntry; i < m_pastObserverSnapshots.size();
          ++i) {
       auto& [key, snapshot] = m_pastObserverSnapshots[i];
@@ -122,29 +226,115 @@ class KalmanFilterLatencyCompensator {
       if (i == indexOfClosestEntry) {
         observer->SetP(snapshot.errorCovariances);
         observer->SetXhat(snapshot.xHat);
+      } else {
+        // Snapshots hold the state before their step, as AddObserverState()
+        // records them, so a later replay from here doesn't rerun the step.
+        snapshot = ObserverSnapshot{*observer, snapshot.inputs,
+                                    snapshot.localMeasurements};
       }
 
       observer->Predict(snapshot.inputs, key - lastTimestamp);
       observer->Correct(snapshot.inputs, snapshot.localMeasurements);
 
-      if (i == indexOfClosestEntry) {
-        // Note that the measurement is at a timestep close but probably not
-        // exactly equal to the timestep for which we called predict. This makes
-        // the assumption that the dt is small enough that the difference
-        // between the measurement time and the time that the inputs were
-        // captured at is very small.
-        globalMeasurementCorrect(snapshot.inputs, y);
+      // Note that the measurements are at a timestep close but probably not
+      // exactly equal to the timestep for which we called predict. This makes
+      // the assumption that the dt is small enough that the difference
+      // between the measurement time and the time that the inputs were
+      // captured at is very small.
+      for (; next != order.end() && next->first == i; ++next) {
+        globalMeasurementCorrect(snapshot.inputs, next->second);
       }
 
       lastTimestamp = key;
-      snapshot = ObserverSnapshot{*observer, snapshot.inputs,
-                                  snapshot.localMeasurements};
     }
   }
 
  private:
   static constexpr size_t kMaxPastObserverStates = 300;
-  std::vector<std::pair<units::second_t, ObserverSnapshot>>
+
+  size_t FindClosestSnapshot(units::second_t timestamp) const {
+    // We will perform a binary search to find the index of the element in the
+    // buffer that has a timestamp that is equal to or greater than the vision
+    // measurement timestamp.
+    size_t index = 0;
+    size_t high = m_pastObserverSnapshots.size();
+    while (index < high) {
+      size_t mid = index + (high - index) / 2;
+      if (m_pastObserverSnapshots[mid].first < timestamp) {
+        index = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    // Clamp measurements newer than the newest snapshot to it.
+    index = std::min(index, m_pastObserverSnapshots.size() - 1);
+
+    // The sampled timestamp is greater than or equal to the vision pose
+    // timestamp. We will now find the entry which is closest in time to the
+    // requested timestamp.
+    return index > 0 &&
+                   units::math::abs(timestamp -
+                                    m_pastObserverSnapshots[index - 1].first) <
+                       units::math::abs(timestamp -
+                                        m_pastObserverSnapshots[index].first)
+               ? index - 1
+               : index;
+  }
+
+  void ReplayDeltas(
+      KalmanFilterType* observer,
+      wpi::span<const std::pair<size_t, size_t>> order,
+      units::second_t lastTimestamp,
+      const std::function<void(const Eigen::Matrix<double, Inputs, 1>& u,
+                               size_t index)>& globalMeasurementCorrect,
+      const ReplayFunction& replay) {
+    Eigen::Matrix<double, States, 1> presentXhat = observer->Xhat();
+    Eigen::Matrix<double, States, States> presentP = observer->P();
+
+    // Only the steps at the measurements run the filter. Each snapshot holds
+    // the state before its step, so the state after a step is the corrected
+    // state of the next snapshot, and the present state after the last.
+    size_t size = m_pastObserverSnapshots.size();
+    auto next = order.begin();
+    Eigen::Matrix<double, States, 1> oldPrev =
+        m_pastObserverSnapshots[next->first].second.xHat;
+    Eigen::Matrix<double, States, 1> newPrev = oldPrev;
+    bool filtered = false;
+    for (size_t i = next->first; i < size; ++i) {
+      auto& [key, snapshot] = m_pastObserverSnapshots[i];
+      Eigen::Matrix<double, States, 1> old =
+          i + 1 < size ? m_pastObserverSnapshots[i + 1].second.xHat
+                       : presentXhat;
+      Eigen::Matrix<double, States, 1> corrected;
+      filtered = next != order.end() && next->first == i;
+      if (filtered) {
+        observer->SetP(snapshot.errorCovariances);
+        observer->SetXhat(newPrev);
+        observer->Predict(snapshot.inputs, key - lastTimestamp);
+        observer->Correct(snapshot.inputs, snapshot.localMeasurements);
+        for (; next != order.end() && next->first == i; ++next) {
+          globalMeasurementCorrect(snapshot.inputs, next->second);
+        }
+        corrected = observer->Xhat();
+      } else {
+        corrected = replay(oldPrev, old, newPrev);
+      }
+      if (i + 1 < size) {
+        m_pastObserverSnapshots[i + 1].second.xHat = corrected;
+      }
+      oldPrev = old;
+      newPrev = corrected;
+      lastTimestamp = key;
+    }
+
+    if (!filtered) {
+      // The filter's estimate is only the present one if it ran last.
+      observer->SetXhat(newPrev);
+      observer->SetP(presentP);
+    }
+  }
+
+  wpi::circular_buffer<std::pair<units::second_t, ObserverSnapshot>>
       m_pastObserverSnapshots;
 };
 }  // namespace frc
@@ -7,10 +7,13 @@
 #include <functional>
 
 #include <wpi/array.h>
+#include <wpi/span.h>
 
 #include "Eigen/Core"
+#include "frc/estimator/AngleStatistics.h"
+#include "frc/estimator/InlineUnscentedKalmanFilter.h"
 #include "frc/estimator/KalmanFilterLatencyCompensator.h"
-#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/estimator/VisionMeasurement.h"
 #include "frc/geometry/Pose2d.h"
 #include "frc/geometry/Rotation2d.h"
 #include "frc/kinematics/MecanumDriveKinematics.h"
@@ -93,6 +96,19 @@ class MecanumDrivePoseEstimator {
   void SetVisionMeasurementStdDevs(
       const wpi::array<double, 3>& visionMeasurementStdDevs);
 
+  /**
+   * Sets how vision measurements, which arrive late, are brought forward to
+   * the present. LatencyReplayMode::kDeltas reapplies the odometry since the
+   * measurement to the corrected pose instead of rerunning the filter for
+   * every update since, which is much cheaper with high latency or update
+   * rates. The default is LatencyReplayMode::kFilter.
+   *
+   * @param mode How to replay past updates.
+   */
+  void SetLatencyReplayMode(LatencyReplayMode mode) {
+    m_latencyReplayMode = mode;
+  }
+
   /**
    * Resets the robot's position on the field.
    *
@@ -173,6 +189,18 @@ class MecanumDrivePoseEstimator {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * Adds several vision measurements to the Unscented Kalman Filter at once,
+   * such as the poses from every camera in a loop. The history since the
+   * oldest of them is replayed once, rather than once per measurement.
+   *
+   * Standard deviations given with a measurement only apply to it.
+   *
+   * @param measurements The vision measurements, in any order.
+   */
+  void AddVisionMeasurements(
+      wpi::span<const VisionMeasurement> measurements);
+
   /**
    * Updates the the Unscented Kalman Filter using only wheel encoder
    * information. This should be called every loop, and the correct loop period
@@ -200,13 +228,53 @@ class MecanumDrivePoseEstimator {
                         const MecanumDriveWheelSpeeds& wheelSpeeds);
 
  private:
-  UnscentedKalmanFilter<3, 3, 1> m_observer;
+  // The filter's functions, inlined into it. The state is [x, y, theta]ᵀ;
+  // the measurement is [theta].
+  struct Model : UnscentedKalmanFilterModel<3, 3, 1> {
+    static Eigen::Matrix<double, 3, 1> F(const Eigen::Matrix<double, 3, 1>& x,
+                                         const Eigen::Matrix<double, 3, 1>& u) {
+      return u;
+    }
+    static Eigen::Matrix<double, 1, 1> H(const Eigen::Matrix<double, 3, 1>& x,
+                                         const Eigen::Matrix<double, 3, 1>& u) {
+      return x.block<1, 1>(2, 0);
+    }
+    static Eigen::Matrix<double, 3, 1> MeanX(
+        const Eigen::Matrix<double, 3, 7>& sigmas,
+        const Eigen::Matrix<double, 7, 1>& Wm) {
+      return AngleMean<3, 3>(sigmas, Wm, 2);
+    }
+    static Eigen::Matrix<double, 1, 1> MeanY(
+        const Eigen::Matrix<double, 1, 7>& sigmas,
+        const Eigen::Matrix<double, 7, 1>& Wc) {
+      return AngleMean<1, 3>(sigmas, Wc, 0);
+    }
+    static Eigen::Matrix<double, 3, 1> ResidualX(
+        const Eigen::Matrix<double, 3, 1>& a,
+        const Eigen::Matrix<double, 3, 1>& b) {
+      return AngleResidual<3>(a, b, 2);
+    }
+    static Eigen::Matrix<double, 1, 1> ResidualY(
+        const Eigen::Matrix<double, 1, 1>& a,
+        const Eigen::Matrix<double, 1, 1>& b) {
+      return AngleResidual<1>(a, b, 0);
+    }
+    static Eigen::Matrix<double, 3, 1> AddX(
+        const Eigen::Matrix<double, 3, 1>& a,
+        const Eigen::Matrix<double, 3, 1>& b) {
+      return AngleAdd<3>(a, b, 2);
+    }
+  };
+
+  InlineUnscentedKalmanFilter<3, 3, 1, Model> m_observer;
   MecanumDriveKinematics m_kinematics;
-  KalmanFilterLatencyCompensator<3, 3, 1, UnscentedKalmanFilter<3, 3, 1>>
+  KalmanFilterLatencyCompensator<3, 3, 1,
+                                 InlineUnscentedKalmanFilter<3, 3, 1, Model>>
       m_latencyCompensator;
   std::function<void(const Eigen::Matrix<double, 3, 1>& u,
                      const Eigen::Matrix<double, 3, 1>& y)>
       m_visionCorrect;
+  LatencyReplayMode m_latencyReplayMode = LatencyReplayMode::kFilter;
 
   Eigen::Matrix3d m_visionContR;
 
@@ -48,7 +48,7 @@ class MerweScaledSigmaPoints {
   /**
    * Returns number of sigma points for each variable in the state x.
    */
-  int NumSigmas() { return 2 * States + 1; }
+  int NumSigmas() const { return 2 * States + 1; }
 
   /**
    * Computes the sigma points for an unscented Kalman filter given the mean
@@ -64,7 +64,7 @@ class MerweScaledSigmaPoints {
    */
   Eigen::Matrix<double, States, 2 * States + 1> SigmaPoints(
       const Eigen::Matrix<double, States, 1>& x,
-      const Eigen::Matrix<double, States, States>& P) {
+      const Eigen::Matrix<double, States, States>& P) const {
     double lambda = std::pow(m_alpha, 2) * (States + m_kappa) - States;
     Eigen::Matrix<double, States, States> U =
         ((lambda + States) * P).llt().matrixL();
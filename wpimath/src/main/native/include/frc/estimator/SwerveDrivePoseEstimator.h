@@ -6,14 +6,17 @@
 
 #include <limits>
 
+#include <wpi/SmallVector.h>
 #include <wpi/array.h>
+#include <wpi/span.h>
 #include <wpi/timestamp.h>
 
 #include "Eigen/Core"
 #include "frc/StateSpaceUtil.h"
 #include "frc/estimator/AngleStatistics.h"
+#include "frc/estimator/InlineUnscentedKalmanFilter.h"
 #include "frc/estimator/KalmanFilterLatencyCompensator.h"
-#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/estimator/VisionMeasurement.h"
 #include "frc/geometry/Pose2d.h"
 #include "frc/geometry/Rotation2d.h"
 #include "frc/kinematics/SwerveDriveKinematics.h"
@@ -80,16 +83,7 @@ class SwerveDrivePoseEstimator {
       const wpi::array<double, 1>& localMeasurementStdDevs,
       const wpi::array<double, 3>& visionMeasurementStdDevs,
       units::second_t nominalDt = 0.02_s)
-      : m_observer([](const Eigen::Matrix<double, 3, 1>& x,
-                      const Eigen::Matrix<double, 3, 1>& u) { return u; },
-                   [](const Eigen::Matrix<double, 3, 1>& x,
-                      const Eigen::Matrix<double, 3, 1>& u) {
-                     return x.block<1, 1>(2, 0);
-                   },
-                   stateStdDevs, localMeasurementStdDevs,
-                   frc::AngleMean<3, 3>(2), frc::AngleMean<1, 3>(0),
-                   frc::AngleResidual<3>(2), frc::AngleResidual<1>(0),
-                   frc::AngleAdd<3>(2), nominalDt),
+      : m_observer(Model{}, stateStdDevs, localMeasurementStdDevs, nominalDt),
         m_kinematics(kinematics),
         m_nominalDt(nominalDt) {
     SetVisionMeasurementStdDevs(visionMeasurementStdDevs);
@@ -97,12 +91,23 @@ class SwerveDrivePoseEstimator {
     // Create correction mechanism for vision measurements.
     m_visionCorrect = [&](const Eigen::Matrix<double, 3, 1>& u,
                           const Eigen::Matrix<double, 3, 1>& y) {
-      m_observer.Correct<3>(
+      m_observer.template Correct<3>(
           u, y,
           [](const Eigen::Matrix<double, 3, 1>& x,
              const Eigen::Matrix<double, 3, 1>& u) { return x; },
-          m_visionContR, frc::AngleMean<3, 3>(2), frc::AngleResidual<3>(2),
-          frc::AngleResidual<3>(2), frc::AngleAdd<3>(2));
+          m_visionContR,
+          [](const auto& sigmas, const auto& Wm) {
+            return frc::AngleMean<3, 3>(sigmas, Wm, 2);
+          },
+          [](const auto& a, const auto& b) {
+            return frc::AngleResidual<3>(a, b, 2);
+          },
+          [](const auto& a, const auto& b) {
+            return frc::AngleResidual<3>(a, b, 2);
+          },
+          [](const auto& a, const auto& b) {
+            return frc::AngleAdd<3>(a, b, 2);
+          });
     };
 
     // Set initial state.
@@ -164,6 +169,19 @@ class SwerveDrivePoseEstimator {
     m_visionContR = frc::MakeCovMatrix(visionMeasurementStdDevs);
   }
 
+  /**
+   * Sets how vision measurements, which arrive late, are brought forward to
+   * the present. LatencyReplayMode::kDeltas reapplies the odometry since the
+   * measurement to the corrected pose instead of rerunning the filter for
+   * every update since, which is much cheaper with high latency or update
+   * rates. The default is LatencyReplayMode::kFilter.
+   *
+   * @param mode How to replay past updates.
+   */
+  void SetLatencyReplayMode(LatencyReplayMode mode) {
+    m_latencyReplayMode = mode;
+  }
+
   /**
    * Add a vision measurement to the Unscented Kalman Filter. This will correct
    * the odometry pose estimate while still accounting for measurement noise.
@@ -184,9 +202,11 @@ class SwerveDrivePoseEstimator {
    */
   void AddVisionMeasurement(const Pose2d& visionRobotPose,
                             units::second_t timestamp) {
-    m_latencyCompensator.ApplyPastGlobalMeasurement<3>(
+    m_latencyCompensator.template ApplyPastGlobalMeasurement<3>(
         &m_observer, m_nominalDt, PoseTo3dVector(visionRobotPose),
-        m_visionCorrect, timestamp);
+        m_visionCorrect, timestamp,
+        m_latencyReplayMode == LatencyReplayMode::kDeltas ? &ReplayPoseDelta<3>
+                                                          : nullptr);
   }
 
   /**
@@ -227,6 +247,36 @@ class SwerveDrivePoseEstimator {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * Adds several vision measurements to the Unscented Kalman Filter at once,
+   * such as the poses from every camera in a loop. The history since the
+   * oldest of them is replayed once, rather than once per measurement.
+   *
+   * Standard deviations given with a measurement only apply to it.
+   *
+   * @param measurements The vision measurements, in any order.
+   */
+  void AddVisionMeasurements(
+      wpi::span<const VisionMeasurement> measurements) {
+    wpi::SmallVector<units::second_t, 8> timestamps;
+    for (auto&& measurement : measurements) {
+      timestamps.emplace_back(measurement.timestamp);
+    }
+    Eigen::Matrix<double, 3, 3> visionContR = m_visionContR;
+    m_latencyCompensator.ApplyPastGlobalMeasurements(
+        &m_observer, m_nominalDt, timestamps,
+        [&](const Eigen::Matrix<double, 3, 1>& u, size_t i) {
+          auto& measurement = measurements[i];
+          m_visionContR = measurement.stdDevs
+                              ? frc::MakeCovMatrix(*measurement.stdDevs)
+                              : visionContR;
+          m_visionCorrect(u, PoseTo3dVector(measurement.pose));
+        },
+        m_latencyReplayMode == LatencyReplayMode::kDeltas ? &ReplayPoseDelta<3>
+                                                          : nullptr);
+    m_visionContR = visionContR;
+  }
+
   /**
    * Updates the the Unscented Kalman Filter using only wheel encoder
    * information. This should be called every loop, and the correct loop period
@@ -286,13 +336,53 @@ class SwerveDrivePoseEstimator {
   }
 
  private:
-  UnscentedKalmanFilter<3, 3, 1> m_observer;
+  // The filter's functions, inlined into it. The state is [x, y, theta]ᵀ;
+  // the measurement is [theta].
+  struct Model : UnscentedKalmanFilterModel<3, 3, 1> {
+    static Eigen::Matrix<double, 3, 1> F(const Eigen::Matrix<double, 3, 1>& x,
+                                         const Eigen::Matrix<double, 3, 1>& u) {
+      return u;
+    }
+    static Eigen::Matrix<double, 1, 1> H(const Eigen::Matrix<double, 3, 1>& x,
+                                         const Eigen::Matrix<double, 3, 1>& u) {
+      return x.block<1, 1>(2, 0);
+    }
+    static Eigen::Matrix<double, 3, 1> MeanX(
+        const Eigen::Matrix<double, 3, 7>& sigmas,
+        const Eigen::Matrix<double, 7, 1>& Wm) {
+      return AngleMean<3, 3>(sigmas, Wm, 2);
+    }
+    static Eigen::Matrix<double, 1, 1> MeanY(
+        const Eigen::Matrix<double, 1, 7>& sigmas,
+        const Eigen::Matrix<double, 7, 1>& Wc) {
+      return AngleMean<1, 3>(sigmas, Wc, 0);
+    }
+    static Eigen::Matrix<double, 3, 1> ResidualX(
+        const Eigen::Matrix<double, 3, 1>& a,
+        const Eigen::Matrix<double, 3, 1>& b) {
+      return AngleResidual<3>(a, b, 2);
+    }
+    static Eigen::Matrix<double, 1, 1> ResidualY(
+        const Eigen::Matrix<double, 1, 1>& a,
+        const Eigen::Matrix<double, 1, 1>& b) {
+      return AngleResidual<1>(a, b, 0);
+    }
+    static Eigen::Matrix<double, 3, 1> AddX(
+        const Eigen::Matrix<double, 3, 1>& a,
+        const Eigen::Matrix<double, 3, 1>& b) {
+      return AngleAdd<3>(a, b, 2);
+    }
+  };
+
+  InlineUnscentedKalmanFilter<3, 3, 1, Model> m_observer;
   SwerveDriveKinematics<NumModules>& m_kinematics;
-  KalmanFilterLatencyCompensator<3, 3, 1, UnscentedKalmanFilter<3, 3, 1>>
+  KalmanFilterLatencyCompensator<3, 3, 1,
+                                 InlineUnscentedKalmanFilter<3, 3, 1, Model>>
       m_latencyCompensator;
   std::function<void(const Eigen::Matrix<double, 3, 1>& u,
                      const Eigen::Matrix<double, 3, 1>& y)>
       m_visionCorrect;
+  LatencyReplayMode m_latencyReplayMode = LatencyReplayMode::kFilter;
 
   Eigen::Matrix3d m_visionContR;
 
@@ -6,6 +6,7 @@
 
 #include <functional>
 
+#include <wpi/ThreadPool.h>
 #include <wpi/array.h>
 
 #include "Eigen/Core"
@@ -20,6 +21,146 @@
 
 namespace frc {
 
+namespace detail {
+
+/**
+ * The predict step of an unscented Kalman filter, shared by
+ * UnscentedKalmanFilter and InlineUnscentedKalmanFilter.
+ *
+ * The sigma points are integrated together as one matrix, so the integrator's
+ * arithmetic runs over all of them at once; f is called on each column. If a
+ * thread pool is given, each sigma point is instead integrated on its own on
+ * the pool, which gives the same result.
+ */
+template <int States, int Inputs, typename F, typename MeanFuncX,
+          typename ResidualFuncX>
+void UnscentedPredict(F&& f, MeanFuncX&& meanFuncX,
+                      ResidualFuncX&& residualFuncX,
+                      const MerweScaledSigmaPoints<States>& pts,
+                      const Eigen::Matrix<double, States, States>& contQ,
+                      const Eigen::Matrix<double, Inputs, 1>& u,
+                      units::second_t dt,
+                      Eigen::Matrix<double, States, 1>* xHat,
+                      Eigen::Matrix<double, States, States>* P,
+                      Eigen::Matrix<double, States, 2 * States + 1>* sigmasF,
+                      wpi::ThreadPool* pool = nullptr) {
+  // Discretize Q before projecting mean and covariance forward
+  Eigen::Matrix<double, States, States> contA =
+      NumericalJacobianX<States, States, Inputs>(f, *xHat, u);
+  Eigen::Matrix<double, States, States> discA;
+  Eigen::Matrix<double, States, States> discQ;
+  DiscretizeAQTaylor<States>(contA, contQ, dt, &discA, &discQ);
+
+  Eigen::Matrix<double, States, 2 * States + 1> sigmas =
+      pts.SigmaPoints(*xHat, *P);
+
+  if (pool) {
+    pool->ParallelFor(0, pts.NumSigmas(), [&](size_t i) {
+      sigmasF->template block<States, 1>(0, i) =
+          RK4(f,
+              Eigen::Matrix<double, States, 1>{
+                  sigmas.template block<States, 1>(0, i)},
+              u, dt);
+    });
+  } else {
+    *sigmasF = RK4(
+        [&](const Eigen::Matrix<double, States, 2 * States + 1>& x,
+            const Eigen::Matrix<double, Inputs, 1>& u) {
+          Eigen::Matrix<double, States, 2 * States + 1> xdot;
+          for (int i = 0; i < pts.NumSigmas(); ++i) {
+            xdot.template block<States, 1>(0, i) =
+                f(Eigen::Matrix<double, States, 1>{
+                      x.template block<States, 1>(0, i)},
+                  u);
+          }
+          return xdot;
+        },
+        sigmas, u, dt);
+  }
+
+  auto ret = UnscentedTransform<States, States>(*sigmasF, pts.Wm(), pts.Wc(),
+                                                meanFuncX, residualFuncX);
+  *xHat = std::get<0>(ret);
+  *P = std::get<1>(ret);
+
+  *P += discQ;
+}
+
+/**
+ * The correct step of an unscented Kalman filter, shared by
+ * UnscentedKalmanFilter and InlineUnscentedKalmanFilter.
+ */
+template <int States, int Inputs, int Rows, typename H, typename MeanFuncY,
+          typename ResidualFuncY, typename ResidualFuncX, typename AddFuncX>
+void UnscentedCorrect(
+    H&& h, MeanFuncY&& meanFuncY, ResidualFuncY&& residualFuncY,
+    ResidualFuncX&& residualFuncX, AddFuncX&& addFuncX,
+    const MerweScaledSigmaPoints<States>& pts,
+    const Eigen::Matrix<double, Rows, Rows>& R,
+    const Eigen::Matrix<double, Inputs, 1>& u,
+    const Eigen::Matrix<double, Rows, 1>& y, units::second_t dt,
+    const Eigen::Matrix<double, States, 2 * States + 1>& sigmasF,
+    Eigen::Matrix<double, States, 1>* xHat,
+    Eigen::Matrix<double, States, States>* P) {
+  const Eigen::Matrix<double, Rows, Rows> discR = DiscretizeR<Rows>(R, dt);
+
+  // Transform sigma points into measurement space
+  Eigen::Matrix<double, Rows, 2 * States + 1> sigmasH;
+  Eigen::Matrix<double, States, 2 * States + 1> sigmas =
+      pts.SigmaPoints(*xHat, *P);
+  for (int i = 0; i < pts.NumSigmas(); ++i) {
+    sigmasH.template block<Rows, 1>(0, i) =
+        h(Eigen::Matrix<double, States, 1>{
+              sigmas.template block<States, 1>(0, i)},
+          u);
+  }
+
+  // Mean and covariance of prediction passed through UT
+  auto [yHat, Py] = UnscentedTransform<States, Rows>(
+      sigmasH, pts.Wm(), pts.Wc(), meanFuncY, residualFuncY);
+  Py += discR;
+
+  // Compute cross covariance of the state and the measurements
+  Eigen::Matrix<double, States, Rows> Pxy;
+  Pxy.setZero();
+  for (int i = 0; i < pts.NumSigmas(); ++i) {
+    // Pxy += (sigmas_f[:, i] - x̂)(sigmas_h[:, i] - ŷ)ᵀ W_c[i]
+    Pxy += pts.Wc(i) *
+           (residualFuncX(Eigen::Matrix<double, States, 1>{
+                              sigmasF.template block<States, 1>(0, i)},
+                          *xHat)) *
+           (residualFuncY(Eigen::Matrix<double, Rows, 1>{
+                              sigmasH.template block<Rows, 1>(0, i)},
+                          yHat))
+               .transpose();
+  }
+
+  // K = P_{xy} P_y⁻¹
+  // Kᵀ = P_yᵀ⁻¹ P_{xy}ᵀ
+  // P_yᵀKᵀ = P_{xy}ᵀ
+  // Kᵀ = P_yᵀ.solve(P_{xy}ᵀ)
+  // K = (P_yᵀ.solve(P_{xy}ᵀ)ᵀ
+  Eigen::Matrix<double, States, Rows> K =
+      Py.transpose().ldlt().solve(Pxy.transpose()).transpose();
+
+  // x̂ₖ₊₁⁺ = x̂ₖ₊₁⁻ + K(y − ŷ)
+  *xHat = addFuncX(*xHat, Eigen::Matrix<double, States, 1>{
+                              K * residualFuncY(y, yHat)});
+
+  // Pₖ₊₁⁺ = Pₖ₊₁⁻ − KP_yKᵀ
+  *P -= K * Py * K.transpose();
+}
+
+/**
+ * The smallest number of states for which an unscented Kalman filter given a
+ * thread pool propagates its sigma points in parallel, by default. Below
+ * this, handing the sigma points to the pool costs more than integrating
+ * them.
+ */
+inline constexpr int kUnscentedParallelMinStates = 8;
+
+}  // namespace detail
+
 template <int States, int Inputs, int Outputs>
 class UnscentedKalmanFilter {
  public:
@@ -186,6 +327,26 @@ class UnscentedKalmanFilter {
    */
   void SetXhat(int i, double value) { m_xHat(i, 0) = value; }
 
+  /**
+   * Sets a thread pool on which to propagate the sigma points through the
+   * dynamics in Predict(). The sigma points are independent, so for filters
+   * with expensive dynamics this spreads most of the prediction's work over
+   * the pool. f must then be safe to call from several threads at once.
+   *
+   * Filters with fewer than minStates states keep propagating the sigma points
+   * on the calling thread.
+   *
+   * @param pool      The thread pool, or nullptr to propagate the sigma points
+   *                  on the calling thread. It must outlive the filter, or be
+   *                  unset first.
+   * @param minStates The smallest number of states for which the pool is
+   *                  used.
+   */
+  void SetThreadPool(wpi::ThreadPool* pool,
+                     int minStates = detail::kUnscentedParallelMinStates) {
+    m_pool = States >= minStates ? pool : nullptr;
+  }
+
   /**
    * Resets the observer.
    */
@@ -203,29 +364,9 @@ class UnscentedKalmanFilter {
    */
   void Predict(const Eigen::Matrix<double, Inputs, 1>& u, units::second_t dt) {
     m_dt = dt;
-
-    // Discretize Q before projecting mean and covariance forward
-    Eigen::Matrix<double, States, States> contA =
-        NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
-    Eigen::Matrix<double, States, States> discA;
-    Eigen::Matrix<double, States, States> discQ;
-    DiscretizeAQTaylor<States>(contA, m_contQ, dt, &discA, &discQ);
-
-    Eigen::Matrix<double, States, 2 * States + 1> sigmas =
-        m_pts.SigmaPoints(m_xHat, m_P);
-
-    for (int i = 0; i < m_pts.NumSigmas(); ++i) {
-      Eigen::Matrix<double, States, 1> x =
-          sigmas.template block<States, 1>(0, i);
-      m_sigmasF.template block<States, 1>(0, i) = RK4(m_f, x, u, dt);
-    }
-
-    auto ret = UnscentedTransform<States, States>(
-        m_sigmasF, m_pts.Wm(), m_pts.Wc(), m_meanFuncX, m_residualFuncX);
-    m_xHat = std::get<0>(ret);
-    m_P = std::get<1>(ret);
-
-    m_P += discQ;
+    detail::UnscentedPredict<States, Inputs>(m_f, m_meanFuncX, m_residualFuncX,
+                                             m_pts, m_contQ, u, dt, &m_xHat,
+                                             &m_P, &m_sigmasF, m_pool);
   }
 
   /**
@@ -323,47 +464,9 @@ class UnscentedKalmanFilter {
                    const Eigen::Matrix<double, States, 1>&,
                    const Eigen::Matrix<double, States, 1>)>
                    addFuncX) {
-    const Eigen::Matrix<double, Rows, Rows> discR = DiscretizeR<Rows>(R, m_dt);
-
-    // Transform sigma points into measurement space
-    Eigen::Matrix<double, Rows, 2 * States + 1> sigmasH;
-    Eigen::Matrix<double, States, 2 * States + 1> sigmas =
-        m_pts.SigmaPoints(m_xHat, m_P);
-    for (int i = 0; i < m_pts.NumSigmas(); ++i) {
-      sigmasH.template block<Rows, 1>(0, i) =
-          h(sigmas.template block<States, 1>(0, i), u);
-    }
-
-    // Mean and covariance of prediction passed through UT
-    auto [yHat, Py] = UnscentedTransform<States, Rows>(
-        sigmasH, m_pts.Wm(), m_pts.Wc(), meanFuncY, residualFuncY);
-    Py += discR;
-
-    // Compute cross covariance of the state and the measurements
-    Eigen::Matrix<double, States, Rows> Pxy;
-    Pxy.setZero();
-    for (int i = 0; i < m_pts.NumSigmas(); ++i) {
-      // Pxy += (sigmas_f[:, i] - x̂)(sigmas_h[:, i] - ŷ)ᵀ W_c[i]
-      Pxy +=
-          m_pts.Wc(i) *
-          (residualFuncX(m_sigmasF.template block<States, 1>(0, i), m_xHat)) *
-          (residualFuncY(sigmasH.template block<Rows, 1>(0, i), yHat))
-              .transpose();
-    }
-
-    // K = P_{xy} P_y⁻¹
-    // Kᵀ = P_yᵀ⁻¹ P_{xy}ᵀ
-    // P_yᵀKᵀ = P_{xy}ᵀ
-    // Kᵀ = P_yᵀ.solve(P_{xy}ᵀ)
-    // K = (P_yᵀ.solve(P_{xy}ᵀ)ᵀ
-    Eigen::Matrix<double, States, Rows> K =
-        Py.transpose().ldlt().solve(Pxy.transpose()).transpose();
-
-    // x̂ₖ₊₁⁺ = x̂ₖ₊₁⁻ + K(y − ŷ)
-    m_xHat = addFuncX(m_xHat, K * residualFuncY(y, yHat));
-
-    // Pₖ₊₁⁺ = Pₖ₊₁⁻ − KP_yKᵀ
-    m_P -= K * Py * K.transpose();
+    detail::UnscentedCorrect<States, Inputs, Rows>(
+        h, meanFuncY, residualFuncY, residualFuncX, addFuncX, m_pts, R, u, y,
+        m_dt, m_sigmasF, &m_xHat, &m_P);
   }
 
  private:
@@ -401,6 +504,7 @@ class UnscentedKalmanFilter {
   Eigen::Matrix<double, Outputs, Outputs> m_contR;
   Eigen::Matrix<double, States, 2 * States + 1> m_sigmasF;
   units::second_t m_dt;
+  wpi::ThreadPool* m_pool = nullptr;
 
   MerweScaledSigmaPoints<States> m_pts;
 };
@@ -22,24 +22,21 @@ namespace frc {
  * @param sigmas   List of sigma points.
  * @param Wm       Weights for the mean.
  * @param Wc       Weights for the covariance.
+ * @param meanFunc A function that computes the mean of the sigma points using
+ *                 the given weights.
+ * @param residualFunc A function that computes the residual of two vectors
+ *                     (i.e. it subtracts them.)
  *
  * @return Tuple of x, mean of sigma points; P, covariance of sigma points after
  *         passing through the transform.
  */
-template <int States, int CovDim>
+template <int States, int CovDim, typename MeanFunc, typename ResidualFunc>
 std::tuple<Eigen::Matrix<double, CovDim, 1>,
            Eigen::Matrix<double, CovDim, CovDim>>
 UnscentedTransform(const Eigen::Matrix<double, CovDim, 2 * States + 1>& sigmas,
                    const Eigen::Matrix<double, 2 * States + 1, 1>& Wm,
                    const Eigen::Matrix<double, 2 * States + 1, 1>& Wc,
-                   std::function<Eigen::Matrix<double, CovDim, 1>(
-                       const Eigen::Matrix<double, CovDim, 2 * States + 1>&,
-                       const Eigen::Matrix<double, 2 * States + 1, 1>&)>
-                       meanFunc,
-                   std::function<Eigen::Matrix<double, CovDim, 1>(
-                       const Eigen::Matrix<double, CovDim, 1>&,
-                       const Eigen::Matrix<double, CovDim, 1>&)>
-                       residualFunc) {
+                   MeanFunc&& meanFunc, ResidualFunc&& residualFunc) {
   // New mean is usually just the sum of the sigmas * weight:
   //       n
   // dot = Σ W[k] Xᵢ[k]
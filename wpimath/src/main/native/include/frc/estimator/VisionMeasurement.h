@@ -0,0 +1,34 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <optional>
+
+#include <wpi/array.h>
+
+#include "frc/geometry/Pose2d.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * A robot pose measured by vision, for adding several at once to a pose
+ * estimator with AddVisionMeasurements().
+ */
+struct VisionMeasurement {
+  /// The pose of the robot as measured by the vision camera.
+  Pose2d pose;
+
+  /// The timestamp of the measurement, in the same epoch as the estimator's
+  /// updates.
+  units::second_t timestamp;
+
+  /// Standard deviations of the measurement in the form [x, y, theta]ᵀ, in
+  /// meters and radians. If empty, the estimator's vision measurement
+  /// standard deviations are used.
+  std::optional<wpi::array<double, 3>> stdDevs = std::nullopt;
+};
+
+}  // namespace frc
@@ -0,0 +1,111 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <wpi/span.h>
+
+namespace frc {
+
+/**
+ * A cascaded integrator-comb (CIC) decimator, for reducing the rate of
+ * integer sample streams like raw ADC counts read through DMA.
+ *
+ * A CIC filter of N stages decimating by R has the response of N cascaded
+ * R-tap moving averages, but takes N additions per input sample and N
+ * subtractions per output, with no multiplications or stored taps. Each
+ * output is scaled by 1/R<sup>N</sup>, so a constant input gives the same
+ * constant output.
+ *
+ * The integrators wrap around instead of saturating, which the combs undo
+ * exactly, so the filter runs indefinitely without losing precision as long
+ * as R<sup>N</sup> times the largest input magnitude fits in 63 bits.
+ */
+class CICDecimator {
+ public:
+  /**
+   * Creates a CIC decimator.
+   *
+   * @param stages The number of integrator and comb stages. More stages
+   *               attenuate more aliasing, but droop more in the passband.
+   * @param factor The number of input samples per output.
+   */
+  CICDecimator(int stages, int factor)
+      : m_integrators(stages, 0),
+        m_combs(stages, 0),
+        m_factor{factor},
+        m_gain{1.0 / std::pow(factor, stages)} {
+    if (stages <= 0) {
+      throw std::runtime_error("Number of stages must be greater than zero.");
+    }
+    if (factor <= 0) {
+      throw std::runtime_error("Decimation factor must be greater than zero.");
+    }
+  }
+
+  /**
+   * Reset the filter state, including the position in the decimation cycle.
+   */
+  void Reset() {
+    std::fill(m_integrators.begin(), m_integrators.end(), 0);
+    std::fill(m_combs.begin(), m_combs.end(), 0);
+    m_phase = 0;
+  }
+
+  /**
+   * Filters the next input samples.
+   *
+   * An output is returned for every factor-th sample given since the filter
+   * was created or reset; the samples don't need to come in multiples of the
+   * factor.
+   *
+   * @param input The input samples, oldest first.
+   *
+   * @return The filtered values at the kept samples, oldest first. They are
+   *         valid until the next call.
+   */
+  wpi::span<const double> Calculate(wpi::span<const int32_t> input) {
+    m_decimated.clear();
+
+    for (int32_t sample : input) {
+      // Unsigned arithmetic wraps around instead of overflowing
+      uint64_t value = static_cast<uint64_t>(static_cast<int64_t>(sample));
+      for (auto& integrator : m_integrators) {
+        integrator += value;
+        value = integrator;
+      }
+
+      if (++m_phase < m_factor) {
+        continue;
+      }
+      m_phase = 0;
+
+      for (auto& comb : m_combs) {
+        uint64_t delayed = comb;
+        comb = value;
+        value -= delayed;
+      }
+      m_decimated.push_back(static_cast<int64_t>(value) * m_gain);
+    }
+
+    return m_decimated;
+  }
+
+ private:
+  std::vector<uint64_t> m_integrators;
+  std::vector<uint64_t> m_combs;
+  int m_factor;
+  int m_phase = 0;
+  double m_gain;
+  std::vector<double> m_decimated;
+};
+
+}  // namespace frc
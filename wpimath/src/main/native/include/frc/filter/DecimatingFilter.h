@@ -0,0 +1,182 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+#include <wpi/circular_buffer.h>
+#include <wpi/span.h>
+
+#include "units/time.h"
+#include "wpimath/MathShared.h"
+
+namespace frc {
+
+/**
+ * A linear filter, like LinearFilter, whose output is decimated: it takes
+ * samples at a high rate (for example from DMA) and returns one output for
+ * every few of them, at the rate the control loop runs.
+ *
+ * If the filter is FIR (it has no feedback gains), outputs are only computed
+ * for the samples that are kept, so a filter decimating by M does 1/M of the
+ * multiplications of running every sample through LinearFilter. This is the
+ * cost of a polyphase decimator. An IIR filter depends on its previous
+ * outputs, so it still computes one for every sample and only returns every
+ * Mth.
+ *
+ * The static factory methods take the period between input samples, not
+ * between outputs.
+ */
+class DecimatingFilter {
+ public:
+  /**
+   * Create a decimating linear FIR or IIR filter.
+   *
+   * @param ffGains The "feed forward" or FIR gains.
+   * @param fbGains The "feed back" or IIR gains.
+   * @param factor  The number of input samples per output.
+   */
+  DecimatingFilter(wpi::span<const double> ffGains,
+                   wpi::span<const double> fbGains, int factor)
+      : m_inputs(ffGains.size()),
+        m_outputs(fbGains.size()),
+        m_inputGains(ffGains.begin(), ffGains.end()),
+        m_outputGains(fbGains.begin(), fbGains.end()),
+        m_factor{factor} {
+    if (factor <= 0) {
+      throw std::runtime_error("Decimation factor must be greater than zero.");
+    }
+
+    for (size_t i = 0; i < ffGains.size(); ++i) {
+      m_inputs.emplace_front(0.0);
+    }
+    for (size_t i = 0; i < fbGains.size(); ++i) {
+      m_outputs.emplace_front(0.0);
+    }
+
+    wpi::math::MathSharedStore::ReportUsage(
+        wpi::math::MathUsageId::kFilter_Linear, 1);
+  }
+
+  /**
+   * Create a decimating linear FIR or IIR filter.
+   *
+   * @param ffGains The "feed forward" or FIR gains.
+   * @param fbGains The "feed back" or IIR gains.
+   * @param factor  The number of input samples per output.
+   */
+  DecimatingFilter(std::initializer_list<double> ffGains,
+                   std::initializer_list<double> fbGains, int factor)
+      : DecimatingFilter({ffGains.begin(), ffGains.end()},
+                         {fbGains.begin(), fbGains.end()}, factor) {}
+
+  /**
+   * Creates a decimating one-pole IIR low-pass filter, as
+   * LinearFilter::SinglePoleIIR() does.
+   *
+   * @param timeConstant The discrete-time time constant in seconds.
+   * @param period       The period in seconds between input samples.
+   * @param factor       The number of input samples per output.
+   */
+  static DecimatingFilter SinglePoleIIR(double timeConstant,
+                                        units::second_t period, int factor) {
+    double gain = std::exp(-period.to<double>() / timeConstant);
+    return DecimatingFilter({1.0 - gain}, {-gain}, factor);
+  }
+
+  /**
+   * Creates a decimating K-tap FIR moving average filter, as
+   * LinearFilter::MovingAverage() does. Averaging over the samples since the
+   * last output (taps equal to factor) is the usual choice.
+   *
+   * @param taps   The number of samples to average over. Higher = smoother but
+   *               slower
+   * @param factor The number of input samples per output.
+   */
+  static DecimatingFilter MovingAverage(int taps, int factor) {
+    if (taps <= 0) {
+      throw std::runtime_error("Number of taps must be greater than zero.");
+    }
+
+    std::vector<double> gains(taps, 1.0 / taps);
+    return DecimatingFilter(gains, {}, factor);
+  }
+
+  /**
+   * Reset the filter state, including the position in the decimation cycle.
+   */
+  void Reset() {
+    std::fill(m_inputs.begin(), m_inputs.end(), 0.0);
+    std::fill(m_outputs.begin(), m_outputs.end(), 0.0);
+    m_phase = 0;
+  }
+
+  /**
+   * Filters the next input samples.
+   *
+   * An output is returned for every factor-th sample given since the filter
+   * was created or reset; the samples don't need to come in multiples of the
+   * factor.
+   *
+   * @param input The input samples, oldest first.
+   *
+   * @return The filtered values at the kept samples, oldest first. They are
+   *         valid until the next call.
+   */
+  wpi::span<const double> Calculate(wpi::span<const double> input) {
+    m_decimated.clear();
+
+    for (double sample : input) {
+      // Rotate the inputs
+      if (m_inputGains.size() > 0) {
+        m_inputs.push_front(sample);
+      }
+
+      ++m_phase;
+      bool keep = m_phase == m_factor;
+      if (keep) {
+        m_phase = 0;
+      } else if (m_outputGains.empty()) {
+        continue;
+      }
+
+      double retVal = 0.0;
+
+      // Calculate the new value
+      for (size_t i = 0; i < m_inputGains.size(); ++i) {
+        retVal += m_inputs[i] * m_inputGains[i];
+      }
+      for (size_t i = 0; i < m_outputGains.size(); ++i) {
+        retVal -= m_outputs[i] * m_outputGains[i];
+      }
+
+      // Rotate the outputs
+      if (m_outputGains.size() > 0) {
+        m_outputs.push_front(retVal);
+      }
+
+      if (keep) {
+        m_decimated.push_back(retVal);
+      }
+    }
+
+    return m_decimated;
+  }
+
+ private:
+  wpi::circular_buffer<double> m_inputs;
+  wpi::circular_buffer<double> m_outputs;
+  std::vector<double> m_inputGains;
+  std::vector<double> m_outputGains;
+  int m_factor;
+  int m_phase = 0;
+  std::vector<double> m_decimated;
+};
+
+}  // namespace frc
@@ -0,0 +1,174 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+#include <wpi/span.h>
+
+#include "Eigen/Core"
+#include "units/time.h"
+#include "wpimath/MathShared.h"
+
+namespace frc {
+
+/**
+ * Runs the same linear filter over many channels at once, for example the
+ * velocities of every swerve module or the currents of every PDP channel.
+ *
+ * The filter is the same as LinearFilter's. Each step of the history is stored
+ * as one contiguous row with an element per channel, so a gain is applied to
+ * all the channels with one vectorized multiply-add instead of a dot product
+ * per channel.
+ */
+class LinearFilterBank {
+ public:
+  /**
+   * Create a bank of linear FIR or IIR filters.
+   *
+   * @param channels The number of channels.
+   * @param ffGains  The "feed forward" or FIR gains.
+   * @param fbGains  The "feed back" or IIR gains.
+   */
+  LinearFilterBank(int channels, wpi::span<const double> ffGains,
+                   wpi::span<const double> fbGains)
+      : m_inputs{History::Zero(ffGains.size(), channels)},
+        m_outputs{History::Zero(fbGains.size(), channels)},
+        m_inputGains(ffGains.begin(), ffGains.end()),
+        m_outputGains(fbGains.begin(), fbGains.end()),
+        m_output{Eigen::VectorXd::Zero(channels)} {
+    wpi::math::MathSharedStore::ReportUsage(
+        wpi::math::MathUsageId::kFilter_Linear, 1);
+  }
+
+  /**
+   * Create a bank of linear FIR or IIR filters.
+   *
+   * @param channels The number of channels.
+   * @param ffGains  The "feed forward" or FIR gains.
+   * @param fbGains  The "feed back" or IIR gains.
+   */
+  LinearFilterBank(int channels, std::initializer_list<double> ffGains,
+                   std::initializer_list<double> fbGains)
+      : LinearFilterBank(channels, {ffGains.begin(), ffGains.end()},
+                         {fbGains.begin(), fbGains.end()}) {}
+
+  /**
+   * Creates a bank of one-pole IIR low-pass filters, as
+   * LinearFilter::SinglePoleIIR() does.
+   *
+   * @param channels     The number of channels.
+   * @param timeConstant The discrete-time time constant in seconds.
+   * @param period       The period in seconds between samples taken by the
+   *                     user.
+   */
+  static LinearFilterBank SinglePoleIIR(int channels, double timeConstant,
+                                        units::second_t period) {
+    double gain = std::exp(-period.to<double>() / timeConstant);
+    return LinearFilterBank(channels, {1.0 - gain}, {-gain});
+  }
+
+  /**
+   * Creates a bank of first-order high-pass filters, as
+   * LinearFilter::HighPass() does.
+   *
+   * @param channels     The number of channels.
+   * @param timeConstant The discrete-time time constant in seconds.
+   * @param period       The period in seconds between samples taken by the
+   *                     user.
+   */
+  static LinearFilterBank HighPass(int channels, double timeConstant,
+                                   units::second_t period) {
+    double gain = std::exp(-period.to<double>() / timeConstant);
+    return LinearFilterBank(channels, {gain, -gain}, {-gain});
+  }
+
+  /**
+   * Creates a bank of K-tap FIR moving average filters, as
+   * LinearFilter::MovingAverage() does.
+   *
+   * @param channels The number of channels.
+   * @param taps     The number of samples to average over. Higher = smoother
+   *                 but slower
+   */
+  static LinearFilterBank MovingAverage(int channels, int taps) {
+    if (taps <= 0) {
+      throw std::runtime_error("Number of taps must be greater than zero.");
+    }
+
+    std::vector<double> gains(taps, 1.0 / taps);
+    return LinearFilterBank(channels, gains, {});
+  }
+
+  /**
+   * Returns the number of channels.
+   */
+  int Channels() const { return static_cast<int>(m_output.size()); }
+
+  /**
+   * Reset the filter state of every channel.
+   */
+  void Reset() {
+    m_inputs.setZero();
+    m_outputs.setZero();
+  }
+
+  /**
+   * Calculates the next value of every channel's filter.
+   *
+   * @param input Current input value of each channel.
+   *
+   * @return The filtered value of each channel at this step
+   */
+  const Eigen::VectorXd& Calculate(const Eigen::VectorXd& input) {
+    const int numInputs = m_inputGains.size();
+    const int numOutputs = m_outputGains.size();
+
+    m_output.setZero();
+
+    // Rotate the inputs
+    if (numInputs > 0) {
+      m_inputHead = (m_inputHead + numInputs - 1) % numInputs;
+      m_inputs.row(m_inputHead) = input.transpose();
+    }
+
+    // Calculate the new value
+    for (int i = 0; i < numInputs; ++i) {
+      m_output += m_inputGains[i] *
+                  m_inputs.row((m_inputHead + i) % numInputs).transpose();
+    }
+    for (int i = 0; i < numOutputs; ++i) {
+      m_output -= m_outputGains[i] *
+                  m_outputs.row((m_outputHead + i) % numOutputs).transpose();
+    }
+
+    // Rotate the outputs
+    if (numOutputs > 0) {
+      m_outputHead = (m_outputHead + numOutputs - 1) % numOutputs;
+      m_outputs.row(m_outputHead) = m_output.transpose();
+    }
+
+    return m_output;
+  }
+
+ private:
+  // Ring buffer of samples, one row per step; row (head + i) % rows holds the
+  // sample from i steps ago
+  using History =
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  History m_inputs;
+  History m_outputs;
+  int m_inputHead = 0;
+  int m_outputHead = 0;
+  std::vector<double> m_inputGains;
+  std::vector<double> m_outputGains;
+  Eigen::VectorXd m_output;
+};
+
+}  // namespace frc
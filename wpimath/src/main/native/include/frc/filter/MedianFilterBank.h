@@ -0,0 +1,125 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <iterator>
+#include <set>
+#include <vector>
+
+#include <wpi/circular_buffer.h>
+
+#include "Eigen/Core"
+
+namespace frc {
+
+/**
+ * Runs a moving-window median filter, like MedianFilter, over many channels at
+ * once.
+ *
+ * Each channel keeps the lower and upper halves of its window in two ordered
+ * sets, so a sample is added and the oldest removed in O(log n) time for a
+ * window of n samples, rather than the O(n) of shifting a sorted array.
+ */
+class MedianFilterBank {
+ public:
+  /**
+   * Creates a new MedianFilterBank.
+   *
+   * @param channels The number of channels.
+   * @param size     The number of samples in the moving window.
+   */
+  MedianFilterBank(int channels, size_t size)
+      : m_channels(channels, Channel{size}),
+        m_output{Eigen::VectorXd::Zero(channels)},
+        m_size{size} {}
+
+  /**
+   * Returns the number of channels.
+   */
+  int Channels() const { return static_cast<int>(m_channels.size()); }
+
+  /**
+   * Calculates the moving-window median of every channel for its next value.
+   *
+   * @param next The next input value of each channel.
+   * @return The median of each channel's moving window, updated to include the
+   *         next value.
+   */
+  const Eigen::VectorXd& Calculate(const Eigen::VectorXd& next) {
+    for (int i = 0; i < Channels(); ++i) {
+      m_output(i) = m_channels[i].Calculate(next(i), m_size);
+    }
+    return m_output;
+  }
+
+  /**
+   * Resets the filter, clearing the window of every channel.
+   */
+  void Reset() {
+    for (auto& channel : m_channels) {
+      channel.Reset();
+    }
+  }
+
+ private:
+  struct Channel {
+    explicit Channel(size_t size) : valueBuffer(size) {}
+
+    double Calculate(double next, size_t size) {
+      // If buffer is at max size, pop element off of end of circular buffer
+      // and remove it from the half it's in
+      if (valueBuffer.size() == size) {
+        double oldest = valueBuffer.pop_back();
+        if (auto it = lower.find(oldest); it != lower.end()) {
+          lower.erase(it);
+        } else {
+          upper.erase(upper.find(oldest));
+        }
+      }
+
+      valueBuffer.push_front(next);
+      if (upper.empty() || next < *upper.begin()) {
+        lower.insert(next);
+      } else {
+        upper.insert(next);
+      }
+
+      // Keep the lower half the same size as the upper half, or one larger
+      if (lower.size() > upper.size() + 1) {
+        auto largest = std::prev(lower.end());
+        upper.insert(*largest);
+        lower.erase(largest);
+      } else if (upper.size() > lower.size()) {
+        auto smallest = upper.begin();
+        lower.insert(*smallest);
+        upper.erase(smallest);
+      }
+
+      if (lower.size() > upper.size()) {
+        // If size is odd, return middle element
+        return *lower.rbegin();
+      } else {
+        // If size is even, return average of middle elements
+        return (*lower.rbegin() + *upper.begin()) / 2.0;
+      }
+    }
+
+    void Reset() {
+      valueBuffer.reset();
+      lower.clear();
+      upper.clear();
+    }
+
+    wpi::circular_buffer<double> valueBuffer;
+    std::multiset<double> lower;
+    std::multiset<double> upper;
+  };
+
+  std::vector<Channel> m_channels;
+  Eigen::VectorXd m_output;
+  size_t m_size;
+};
+
+}  // namespace frc
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <wpi/span.h>
+
 #include "Transform2d.h"
 #include "Translation2d.h"
 #include "Twist2d.h"
@@ -31,7 +33,7 @@ class Pose2d {
    * @param translation The translational component of the pose.
    * @param rotation The rotational component of the pose.
    */
-  Pose2d(Translation2d translation, Rotation2d rotation);
+  constexpr Pose2d(Translation2d translation, Rotation2d rotation);
 
   /**
    * Convenience constructors that takes in x and y values directly instead of
@@ -41,7 +43,7 @@ class Pose2d {
    * @param y The y component of the translational component of the pose.
    * @param rotation The rotational component of the pose.
    */
-  Pose2d(units::meter_t x, units::meter_t y, Rotation2d rotation);
+  constexpr Pose2d(units::meter_t x, units::meter_t y, Rotation2d rotation);
 
   /**
    * Transforms the pose by the given transformation and returns the new
@@ -55,7 +57,7 @@ class Pose2d {
    *
    * @return The transformed pose.
    */
-  Pose2d operator+(const Transform2d& other) const;
+  constexpr Pose2d operator+(const Transform2d& other) const;
 
   /**
    * Returns the Transform2d that maps the one pose to another.
@@ -63,7 +65,7 @@ class Pose2d {
    * @param other The initial pose of the transformation.
    * @return The transform that maps the other pose to the current pose.
    */
-  Transform2d operator-(const Pose2d& other) const;
+  constexpr Transform2d operator-(const Pose2d& other) const;
 
   /**
    * Checks equality between this Pose2d and another object.
@@ -86,28 +88,28 @@ class Pose2d {
    *
    * @return Reference to the translational component of the pose.
    */
-  const Translation2d& Translation() const { return m_translation; }
+  constexpr const Translation2d& Translation() const { return m_translation; }
 
   /**
    * Returns the X component of the pose's translation.
    *
    * @return The x component of the pose's translation.
    */
-  units::meter_t X() const { return m_translation.X(); }
+  constexpr units::meter_t X() const { return m_translation.X(); }
 
   /**
    * Returns the Y component of the pose's translation.
    *
    * @return The y component of the pose's translation.
    */
-  units::meter_t Y() const { return m_translation.Y(); }
+  constexpr units::meter_t Y() const { return m_translation.Y(); }
 
   /**
    * Returns the underlying rotation.
    *
    * @return Reference to the rotational component of the pose.
    */
-  const Rotation2d& Rotation() const { return m_rotation; }
+  constexpr const Rotation2d& Rotation() const { return m_rotation; }
 
   /**
    * Transforms the pose by the given transformation and returns the new pose.
@@ -117,7 +119,7 @@ class Pose2d {
    *
    * @return The transformed pose.
    */
-  Pose2d TransformBy(const Transform2d& other) const;
+  constexpr Pose2d TransformBy(const Transform2d& other) const;
 
   /**
    * Returns the other pose relative to the current pose.
@@ -131,7 +133,32 @@ class Pose2d {
    *
    * @return The current pose relative to the new origin pose.
    */
-  Pose2d RelativeTo(const Pose2d& other) const;
+  constexpr Pose2d RelativeTo(const Pose2d& other) const;
+
+  /**
+   * Transforms each of the poses by the given transformation, as
+   * TransformBy(const Transform2d&) does.
+   *
+   * @param poses The poses to transform.
+   * @param other The transform to transform the poses by.
+   * @param out The transformed poses. It must be the same size as poses, and
+   * may be the same span.
+   */
+  static void TransformBy(wpi::span<const Pose2d> poses,
+                          const Transform2d& other, wpi::span<Pose2d> out);
+
+  /**
+   * Converts each of the poses into the coordinate frame of the given origin,
+   * as RelativeTo(const Pose2d&) does. The inverse of the origin's rotation is
+   * only found once.
+   *
+   * @param poses The poses to convert.
+   * @param other The pose that is the origin of the new coordinate frame.
+   * @param out The poses relative to the new origin. It must be the same size
+   * as poses, and may be the same span.
+   */
+  static void RelativeTo(wpi::span<const Pose2d> poses, const Pose2d& other,
+                         wpi::span<Pose2d> out);
 
   /**
    * Obtain a new Pose2d from a (constant curvature) velocity.
@@ -176,3 +203,5 @@ void to_json(wpi::json& json, const Pose2d& pose);
 void from_json(const wpi::json& json, Pose2d& pose);
 
 }  // namespace frc
+
+#include "Pose2d.inc"
@@ -0,0 +1,55 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <wpi/span.h>
+
+#include "Pose2d.h"
+
+namespace frc {
+
+/**
+ * Encodes an array of poses compactly, e.g. to publish a trajectory.
+ *
+ * The encoding is the bytes 0xFF 'P' '2' 'D', the number of poses as a
+ * little-endian uint32, and the first pose as little-endian float32 x and y
+ * (meters) and rotation (degrees).  Each following pose is encoded as three
+ * little-endian int16 deltas from the previous decoded pose, in millimeters
+ * and hundredths of a degree; if a delta does not fit, as -32768 followed by
+ * the pose as three float32s.  Deltas are from the decoded rather than the
+ * original pose, so rounding errors do not accumulate.  A smooth path takes 6
+ * bytes per pose.
+ *
+ * @param poses poses
+ * @param out   encoded data (output); cleared first
+ */
+void EncodePose2dArray(wpi::span<const Pose2d> poses, std::string* out);
+
+/**
+ * Gets the number of poses in data encoded by EncodePose2dArray() or as
+ * big-endian float64 x, y and rotation (degrees) triples, the older encoding
+ * of large Field2d objects.  The 0xFF that starts the compact encoding would
+ * make the first float64 of the older encoding a NaN.
+ *
+ * @param data encoded data
+ * @return number of poses, or empty if the data is not a pose array
+ */
+std::optional<size_t> GetEncodedPose2dArraySize(std::string_view data);
+
+/**
+ * Decodes a pose array encoded as accepted by GetEncodedPose2dArraySize().
+ *
+ * @param data  encoded data
+ * @param poses decoded poses (output); must be the size returned by
+ *              GetEncodedPose2dArraySize()
+ * @return false if the data is not a pose array of that size
+ */
+bool DecodePose2dArray(std::string_view data, wpi::span<Pose2d> poses);
+
+}  // namespace frc
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <cmath>
+#include <limits>
+
 #include "units/angle.h"
 
 namespace wpi {
@@ -15,6 +18,11 @@ namespace frc {
 /**
  * A rotation in a 2d coordinate frame represented a point on the unit circle
  * (cosine and sine).
+ *
+ * A rotation composed from others, or constructed from x and y components,
+ * only computes its angle when Radians() or Degrees() is called, so composing
+ * rotations takes a few multiplications and no trigonometry. Composition is
+ * constexpr.
  */
 class Rotation2d {
  public:
@@ -57,7 +65,7 @@ class Rotation2d {
    *
    * @return The sum of the two rotations.
    */
-  Rotation2d operator+(const Rotation2d& other) const;
+  constexpr Rotation2d operator+(const Rotation2d& other) const;
 
   /**
    * Subtracts the new rotation from the current rotation and returns the new
@@ -70,7 +78,7 @@ class Rotation2d {
    *
    * @return The difference between the two rotations.
    */
-  Rotation2d operator-(const Rotation2d& other) const;
+  constexpr Rotation2d operator-(const Rotation2d& other) const;
 
   /**
    * Takes the inverse of the current rotation. This is simply the negative of
@@ -78,7 +86,7 @@ class Rotation2d {
    *
    * @return The inverse of the current rotation.
    */
-  Rotation2d operator-() const;
+  constexpr Rotation2d operator-() const;
 
   /**
    * Multiplies the current rotation by a scalar.
@@ -110,51 +118,66 @@ class Rotation2d {
    * <pre>
    * [cos_new]   [other.cos, -other.sin][cos]
    * [sin_new] = [other.sin,  other.cos][sin]
-   * value_new = std::atan2(sin_new, cos_new)
    * </pre>
    *
+   * The angle of the new rotation, std::atan2(sin_new, cos_new), is computed
+   * when it's asked for.
+   *
    * @param other The rotation to rotate by.
    *
    * @return The new rotated Rotation2d.
    */
-  Rotation2d RotateBy(const Rotation2d& other) const;
+  constexpr Rotation2d RotateBy(const Rotation2d& other) const;
 
   /**
    * Returns the radian value of the rotation.
    *
    * @return The radian value of the rotation.
    */
-  units::radian_t Radians() const { return m_value; }
+  units::radian_t Radians() const {
+    return std::isnan(m_value.to<double>())
+               ? units::radian_t{std::atan2(m_sin, m_cos)}
+               : m_value;
+  }
 
   /**
    * Returns the degree value of the rotation.
    *
    * @return The degree value of the rotation.
    */
-  units::degree_t Degrees() const { return m_value; }
+  units::degree_t Degrees() const { return Radians(); }
 
   /**
    * Returns the cosine of the rotation.
    *
    * @return The cosine of the rotation.
    */
-  double Cos() const { return m_cos; }
+  constexpr double Cos() const { return m_cos; }
 
   /**
    * Returns the sine of the rotation.
    *
    * @return The sine of the rotation.
    */
-  double Sin() const { return m_sin; }
+  constexpr double Sin() const { return m_sin; }
 
   /**
    * Returns the tangent of the rotation.
    *
    * @return The tangent of the rotation.
    */
-  double Tan() const { return m_sin / m_cos; }
+  constexpr double Tan() const { return m_sin / m_cos; }
 
  private:
+  // Constructs a rotation from its cosine, sine and angle, which may be NaN
+  // to compute it when asked for
+  constexpr Rotation2d(double cos, double sin, units::radian_t value)
+      : m_value(value), m_cos(cos), m_sin(sin) {}
+
+  static constexpr units::radian_t kUnknownAngle{
+      std::numeric_limits<double>::quiet_NaN()};
+
+  // The angle, or NaN if it hasn't been computed from the cosine and sine
   units::radian_t m_value = 0_rad;
   double m_cos = 1;
   double m_sin = 0;
@@ -165,3 +188,5 @@ void to_json(wpi::json& json, const Rotation2d& rotation);
 void from_json(const wpi::json& json, Rotation2d& rotation);
 
 }  // namespace frc
+
+#include "Rotation2d.inc"
@@ -5,11 +5,13 @@
 #pragma once
 
 #include <cstddef>
+#include <type_traits>
 
 #include <wpi/array.h>
+#include <wpi/span.h>
 
 #include "Eigen/Core"
-#include "Eigen/QR"
+#include "Eigen/LU"
 #include "frc/geometry/Rotation2d.h"
 #include "frc/geometry/Translation2d.h"
 #include "frc/kinematics/ChassisSpeeds.h"
@@ -35,7 +37,12 @@ namespace frc {
  *
  * The inverse kinematics: [moduleStates] = [moduleLocations] * [chassisSpeeds]
  * We take the Moore-Penrose pseudoinverse of [moduleLocations] and then
- * multiply by [moduleStates] to get our chassis speeds.
+ * multiply by [moduleStates] to get our chassis speeds. The pseudoinverse is
+ * computed once, at construction.
+ *
+ * Both directions also have overloads that convert many sets of speeds at
+ * once with one matrix product, for callers like trajectory constraints that
+ * evaluate the kinematics at every point of a trajectory.
  *
  * Forward kinematics is also used for odometry -- determining the position of
  * the robot on the field using encoders and a gyro.
@@ -68,7 +75,10 @@ class SwerveDriveKinematics {
       // clang-format on
     }
 
-    m_forwardKinematics = m_inverseKinematics.householderQr();
+    // The closed-form pseudoinverse (MᵀM)⁻¹Mᵀ of the inverse kinematics
+    // matrix M, which has full column rank
+    auto Mt = m_inverseKinematics.transpose();
+    m_forwardKinematics = (Mt * m_inverseKinematics).inverse() * Mt;
 
     wpi::math::MathSharedStore::ReportUsage(
         wpi::math::MathUsageId::kKinematics_SwerveDrive, 1);
@@ -85,7 +95,10 @@ class SwerveDriveKinematics {
       // clang-format on
     }
 
-    m_forwardKinematics = m_inverseKinematics.householderQr();
+    // The closed-form pseudoinverse (MᵀM)⁻¹Mᵀ of the inverse kinematics
+    // matrix M, which has full column rank
+    auto Mt = m_inverseKinematics.transpose();
+    m_forwardKinematics = (Mt * m_inverseKinematics).inverse() * Mt;
 
     wpi::math::MathSharedStore::ReportUsage(
         wpi::math::MathUsageId::kKinematics_SwerveDrive, 1);
@@ -124,6 +137,20 @@ class SwerveDriveKinematics {
       const ChassisSpeeds& chassisSpeeds,
       const Translation2d& centerOfRotation = Translation2d()) const;
 
+  /**
+   * Performs inverse kinematics for many chassis velocities at once, as the
+   * single velocity overload does for each.
+   *
+   * @param chassisSpeeds The desired chassis speeds.
+   * @param moduleStates Storage for the module states of each chassis speed;
+   * it must be as long as chassisSpeeds.
+   * @param centerOfRotation The center of rotation.
+   */
+  void ToSwerveModuleStates(
+      wpi::span<const ChassisSpeeds> chassisSpeeds,
+      wpi::span<wpi::array<SwerveModuleState, NumModules>> moduleStates,
+      const Translation2d& centerOfRotation = Translation2d()) const;
+
   /**
    * Performs forward kinematics to return the resulting chassis state from the
    * given module states. This method is often used for odometry -- determining
@@ -136,7 +163,10 @@ class SwerveDriveKinematics {
    *
    * @return The resulting chassis speed.
    */
-  template <typename... ModuleStates>
+  template <typename... ModuleStates,
+            typename = std::enable_if_t<
+                (std::is_convertible_v<ModuleStates, SwerveModuleState> &&
+                 ...)>>
   ChassisSpeeds ToChassisSpeeds(ModuleStates&&... wheelStates) const;
 
   /**
@@ -155,6 +185,18 @@ class SwerveDriveKinematics {
   ChassisSpeeds ToChassisSpeeds(
       wpi::array<SwerveModuleState, NumModules> moduleStates) const;
 
+  /**
+   * Performs forward kinematics for many sets of module states at once, as the
+   * single set overload does for each.
+   *
+   * @param moduleStates The sets of module states.
+   * @param chassisSpeeds Storage for the chassis speed of each set of module
+   * states; it must be as long as moduleStates.
+   */
+  void ToChassisSpeeds(
+      wpi::span<const wpi::array<SwerveModuleState, NumModules>> moduleStates,
+      wpi::span<ChassisSpeeds> chassisSpeeds) const;
+
   /**
    * Normalizes the wheel speeds using some max attainable speed. Sometimes,
    * after inverse kinematics, the requested speed from a/several modules may be
@@ -172,9 +214,18 @@ class SwerveDriveKinematics {
       units::meters_per_second_t attainableMaxSpeed);
 
  private:
+  /**
+   * Rebuilds the inverse kinematics matrix for a new center of rotation.
+   */
+  void SetCenterOfRotation(const Translation2d& centerOfRotation) const;
+
+  /**
+   * Converts a module's velocity components to its speed and angle.
+   */
+  static SwerveModuleState ToSwerveModuleState(double vx, double vy);
+
   mutable Eigen::Matrix<double, NumModules * 2, 3> m_inverseKinematics;
-  Eigen::HouseholderQR<Eigen::Matrix<double, NumModules * 2, 3>>
-      m_forwardKinematics;
+  Eigen::Matrix<double, 3, NumModules * 2> m_forwardKinematics;
   wpi::array<Translation2d, NumModules> m_modules;
 
   mutable Translation2d m_previousCoR;
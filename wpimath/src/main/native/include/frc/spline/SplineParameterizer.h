@@ -28,7 +28,6 @@
 
 #pragma once
 
-#include <stack>
 #include <string>
 #include <utility>
 #include <vector>
@@ -53,6 +52,20 @@ class SplineParameterizer {
         : runtime_error(what_arg) {}
   };
 
+  // A range of the spline parameter left to parameterize
+  struct StackContents {
+    double t0;
+    double t1;
+  };
+
+  /**
+   * Reusable storage for Parameterize(). Once it has grown to fit a spline,
+   * parameterizing others like it doesn't allocate.
+   */
+  struct Workspace {
+    std::vector<StackContents> stack;
+  };
+
   /**
    * Parameterizes the spline. This method breaks up the spline into various
    * arcs until their dx, dy, and dtheta are within specific tolerances.
@@ -70,15 +83,50 @@ class SplineParameterizer {
   static std::vector<PoseWithCurvature> Parameterize(const Spline<Dim>& spline,
                                                      double t0 = 0.0,
                                                      double t1 = 1.0) {
+    Workspace workspace;
     std::vector<PoseWithCurvature> splinePoints;
-
     // The parameterization does not add the initial point. Let's add that.
     splinePoints.push_back(spline.GetPoint(t0));
+    Parameterize(spline, workspace, &splinePoints, t0, t1);
+    return splinePoints;
+  }
+
+  /**
+   * Parameterizes the spline, appending the points to a vector. Unlike the
+   * other overload, the point at t0 isn't included, so the points of
+   * consecutive splines can be appended to one vector.
+   *
+   * @param spline The spline to parameterize.
+   * @param workspace Storage for the parameterization.
+   * @param splinePoints The vector to append the points to. Space for them
+   * is reserved up front, estimated from the spline's length.
+   * @param t0 Starting internal spline parameter. It is recommended to leave
+   * this as default.
+   * @param t1 Ending internal spline parameter. It is recommended to leave this
+   * as default.
+   */
+  template <int Dim>
+  static void Parameterize(const Spline<Dim>& spline, Workspace& workspace,
+                           std::vector<PoseWithCurvature>* splinePoints,
+                           double t0 = 0.0, double t1 = 1.0) {
+    // Points are at most kMaxDx apart; estimate the length from chords.
+    units::meter_t length = 0_m;
+    Translation2d prev = spline.GetPoint(t0).first.Translation();
+    for (int i = 1; i <= kEstimateChords; ++i) {
+      Translation2d next =
+          spline.GetPoint(t0 + (t1 - t0) * i / kEstimateChords)
+              .first.Translation();
+      length += next.Distance(prev);
+      prev = next;
+    }
+    splinePoints->reserve(splinePoints->size() +
+                          static_cast<size_t>(length / kMaxDx) + 1);
 
     // We use an "explicit stack" to simulate recursion, instead of a recursive
     // function call This give us greater control, instead of a stack overflow
-    std::stack<StackContents> stack;
-    stack.emplace(StackContents{t0, t1});
+    auto& stack = workspace.stack;
+    stack.clear();
+    stack.push_back(StackContents{t0, t1});
 
     StackContents current;
     PoseWithCurvature start;
@@ -86,8 +134,8 @@ class SplineParameterizer {
     int iterations = 0;
 
     while (!stack.empty()) {
-      current = stack.top();
-      stack.pop();
+      current = stack.back();
+      stack.pop_back();
       start = spline.GetPoint(current.t0);
       end = spline.GetPoint(current.t1);
 
@@ -96,10 +144,11 @@ class SplineParameterizer {
       if (units::math::abs(twist.dy) > kMaxDy ||
           units::math::abs(twist.dx) > kMaxDx ||
           units::math::abs(twist.dtheta) > kMaxDtheta) {
-        stack.emplace(StackContents{(current.t0 + current.t1) / 2, current.t1});
-        stack.emplace(StackContents{current.t0, (current.t0 + current.t1) / 2});
+        double mid = (current.t0 + current.t1) / 2;
+        stack.push_back(StackContents{mid, current.t1});
+        stack.push_back(StackContents{current.t0, mid});
       } else {
-        splinePoints.push_back(spline.GetPoint(current.t1));
+        splinePoints->push_back(end);
       }
 
       if (iterations++ >= kMaxIterations) {
@@ -110,8 +159,6 @@ class SplineParameterizer {
             "in opposing directions.");
       }
     }
-
-    return splinePoints;
   }
 
  private:
@@ -120,10 +167,8 @@ class SplineParameterizer {
   static constexpr units::meter_t kMaxDy = 0.05_in;
   static constexpr units::radian_t kMaxDtheta = 0.0872_rad;
 
-  struct StackContents {
-    double t0;
-    double t1;
-  };
+  // Chords summed to estimate a spline's length.
+  static constexpr int kEstimateChords = 8;
 
   /**
    * A malformed spline does not actually explode the LIFO stack size. Instead,
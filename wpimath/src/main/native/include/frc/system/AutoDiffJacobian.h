@@ -0,0 +1,106 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include "Eigen/Core"
+#include "unsupported/Eigen/AutoDiff"
+
+namespace frc {
+
+/**
+ * A dual number: a scalar that carries its derivatives with respect to N
+ * variables through arithmetic, for forward-mode automatic differentiation.
+ *
+ * Functions differentiated with it must be templated on their scalar type, so
+ * they can be called with matrices of these, and must call math functions
+ * unqualified (e.g. `using std::sin;` then `sin(x(2))`) so the overloads for
+ * this type are found.
+ */
+template <int N>
+using AutoDiffScalar = Eigen::AutoDiffScalar<Eigen::Matrix<double, N, 1>>;
+
+/**
+ * Returns the Jacobian with respect to x for f(x), by forward-mode automatic
+ * differentiation: f is evaluated once, on dual numbers. Unlike
+ * NumericalJacobian(), the result is exact.
+ *
+ * @tparam Rows Number of rows in result of f(x).
+ * @tparam Cols Number of columns in result of f(x).
+ * @param f     Vector-valued function from which to compute Jacobian. It's
+ *              called with an Eigen::Matrix<AutoDiffScalar<Cols>, Cols, 1>.
+ * @param x     Vector argument.
+ */
+template <int Rows, int Cols, typename F>
+Eigen::Matrix<double, Rows, Cols> AutoDiffJacobian(
+    F&& f, const Eigen::Matrix<double, Cols, 1>& x) {
+  Eigen::Matrix<AutoDiffScalar<Cols>, Cols, 1> dualX;
+  for (int i = 0; i < Cols; ++i) {
+    dualX(i) = AutoDiffScalar<Cols>{x(i), Cols, i};
+  }
+
+  Eigen::Matrix<AutoDiffScalar<Cols>, Rows, 1> y = f(dualX);
+
+  Eigen::Matrix<double, Rows, Cols> result;
+  for (int i = 0; i < Rows; ++i) {
+    result.row(i) = y(i).derivatives().transpose();
+  }
+  return result;
+}
+
+/**
+ * Returns the Jacobian with respect to x for f(x, u, ...), by forward-mode
+ * automatic differentiation.
+ *
+ * @tparam Rows    Number of rows in result of f(x, u, ...).
+ * @tparam States  Number of rows in x.
+ * @tparam Inputs  Number of rows in u.
+ * @tparam F       Function object type.
+ * @tparam Args... Remaining arguments to f(x, u, ...).
+ * @param f        Vector-valued function from which to compute Jacobian. It's
+ *                 called with x and u as matrices of AutoDiffScalar<States>.
+ * @param x        State vector.
+ * @param u        Input vector.
+ */
+template <int Rows, int States, int Inputs, typename F, typename... Args>
+Eigen::Matrix<double, Rows, States> AutoDiffJacobianX(
+    F&& f, const Eigen::Matrix<double, States, 1>& x,
+    const Eigen::Matrix<double, Inputs, 1>& u, Args&&... args) {
+  const Eigen::Matrix<AutoDiffScalar<States>, Inputs, 1> dualU =
+      u.template cast<AutoDiffScalar<States>>();
+  return AutoDiffJacobian<Rows, States>(
+      [&](const Eigen::Matrix<AutoDiffScalar<States>, States, 1>& x) {
+        return f(x, dualU, args...);
+      },
+      x);
+}
+
+/**
+ * Returns the Jacobian with respect to u for f(x, u, ...), by forward-mode
+ * automatic differentiation.
+ *
+ * @tparam Rows    Number of rows in result of f(x, u, ...).
+ * @tparam States  Number of rows in x.
+ * @tparam Inputs  Number of rows in u.
+ * @tparam F       Function object type.
+ * @tparam Args... Remaining arguments to f(x, u, ...).
+ * @param f        Vector-valued function from which to compute Jacobian. It's
+ *                 called with x and u as matrices of AutoDiffScalar<Inputs>.
+ * @param x        State vector.
+ * @param u        Input vector.
+ */
+template <int Rows, int States, int Inputs, typename F, typename... Args>
+Eigen::Matrix<double, Rows, Inputs> AutoDiffJacobianU(
+    F&& f, const Eigen::Matrix<double, States, 1>& x,
+    const Eigen::Matrix<double, Inputs, 1>& u, Args&&... args) {
+  const Eigen::Matrix<AutoDiffScalar<Inputs>, States, 1> dualX =
+      x.template cast<AutoDiffScalar<Inputs>>();
+  return AutoDiffJacobian<Rows, Inputs>(
+      [&](const Eigen::Matrix<AutoDiffScalar<Inputs>, Inputs, 1>& u) {
+        return f(dualX, u, args...);
+      },
+      u);
+}
+
+}  // namespace frc
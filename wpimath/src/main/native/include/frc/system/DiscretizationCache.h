@@ -0,0 +1,114 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "Eigen/Core"
+#include "units/time.h"
+#include "unsupported/Eigen/src/MatrixFunctions/MatrixExponential.h"
+
+namespace frc {
+
+/**
+ * Discretizes a continuous A and B pair for varying timesteps, without a
+ * matrix exponential on every call.
+ *
+ * Loop timesteps vary only slightly around their nominal value, so the
+ * timestep is rounded to a multiple of a quantum and the discretization for
+ * that is cached. The remaining fraction of a quantum δ is applied as
+ * exp(Mδ), from its Taylor series: with δ at most half a quantum, the first
+ * few terms are enough. As M (the continuous A and B) commutes with itself,
+ * exp(M(t + δ)) = exp(Mt) exp(Mδ) exactly.
+ *
+ * The quantum should be small compared to the plant's fastest time constant;
+ * the default of 1 ms suits the mechanisms FRC robots control.
+ */
+template <int States, int Inputs>
+class DiscretizationCache {
+ public:
+  /**
+   * Constructs a cache for the given continuous matrices.
+   *
+   * @param contA   Continuous system matrix.
+   * @param contB   Continuous input matrix.
+   * @param quantum Timesteps are rounded to a multiple of this.
+   */
+  DiscretizationCache(const Eigen::Matrix<double, States, States>& contA,
+                      const Eigen::Matrix<double, States, Inputs>& contB,
+                      units::second_t quantum = 1_ms)
+      : m_quantum{quantum} {
+    m_Mcont.setZero();
+    m_Mcont.template block<States, States>(0, 0) = contA;
+    m_Mcont.template block<States, Inputs>(0, States) = contB;
+  }
+
+  /**
+   * Discretizes the matrices with the given timestep, as DiscretizeAB() does.
+   *
+   * @param dt    Discretization timestep.
+   * @param discA Storage for discrete system matrix.
+   * @param discB Storage for discrete input matrix.
+   */
+  void DiscretizeAB(units::second_t dt,
+                    Eigen::Matrix<double, States, States>* discA,
+                    Eigen::Matrix<double, States, Inputs>* discB) {
+    const double quantum = m_quantum.to<double>();
+    int64_t ticks = std::llround(dt.to<double>() / quantum);
+
+    // exp(Mδ) ≈ I + Mδ + (Mδ)²/2! + (Mδ)³/3! + (Mδ)⁴/4!, evaluated as
+    // I + Mδ(I + Mδ/2(I + Mδ/3(I + Mδ/4)))
+    Matrix Mdelta = m_Mcont * (dt.to<double>() - ticks * quantum);
+    Matrix correction = Matrix::Identity();
+    for (int n = 4; n >= 1; --n) {
+      correction = Matrix::Identity() + Mdelta * correction / n;
+    }
+
+    Matrix Mdisc = Lookup(ticks) * correction;
+    *discA = Mdisc.template block<States, States>(0, 0);
+    *discB = Mdisc.template block<States, Inputs>(0, States);
+  }
+
+ private:
+  using Matrix = Eigen::Matrix<double, States + Inputs, States + Inputs>;
+
+  // Enough for the few timesteps a loop's jitter rounds to
+  static constexpr size_t kMaxEntries = 8;
+
+  struct Entry {
+    int64_t ticks;
+    Matrix Mdisc;
+  };
+
+  const Matrix& Lookup(int64_t ticks) {
+    for (size_t i = 0; i < m_size; ++i) {
+      if (m_entries[i].ticks == ticks) {
+        return m_entries[i].Mdisc;
+      }
+    }
+
+    // replace the oldest once full
+    auto& entry = m_entries[m_next];
+    m_next = (m_next + 1) % kMaxEntries;
+    if (m_size < kMaxEntries) {
+      ++m_size;
+    }
+    entry.ticks = ticks;
+    entry.Mdisc = (m_Mcont * (ticks * m_quantum.to<double>())).exp();
+    return entry.Mdisc;
+  }
+
+  Matrix m_Mcont;
+  units::second_t m_quantum;
+  std::array<Entry, kMaxEntries> m_entries;
+  size_t m_size = 0;
+  size_t m_next = 0;
+};
+
+}  // namespace frc
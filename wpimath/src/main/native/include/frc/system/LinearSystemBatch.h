@@ -0,0 +1,244 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+
+#include <wpi/ThreadPool.h>
+
+#include "Eigen/Core"
+#include "frc/RandomStream.h"
+#include "frc/system/Discretization.h"
+#include "frc/system/LinearSystem.h"
+#include "frc/system/NumericalIntegration.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * Simulates many independent instances of one linear system together, for
+ * example the thousands of randomized runs of a Monte Carlo controller tuning.
+ *
+ * The states, inputs and outputs of the instances are stored as the columns of
+ * one matrix each, so an update is a few matrix products over all the
+ * instances rather than a matrix-vector product per instance. If a thread pool
+ * is given, the columns are split into blocks that are updated in parallel.
+ *
+ * The system is discretized once per update, so the instances share its
+ * timestep. Unlike frc::sim::LinearSystemSim, the inputs aren't clamped to the
+ * battery voltage; clamp them before SetInputs().
+ *
+ * @tparam States  The number of states of the system.
+ * @tparam Inputs  The number of inputs to the system.
+ * @tparam Outputs The number of outputs of the system.
+ */
+template <int States, int Inputs, int Outputs>
+class LinearSystemBatch {
+ public:
+  using StateMatrix = Eigen::Matrix<double, States, Eigen::Dynamic>;
+  using InputMatrix = Eigen::Matrix<double, Inputs, Eigen::Dynamic>;
+  using OutputMatrix = Eigen::Matrix<double, Outputs, Eigen::Dynamic>;
+
+  /**
+   * Creates a batch of instances of a linear system, all at the zero state.
+   *
+   * @param system             The system to simulate.
+   * @param size               The number of instances.
+   * @param measurementStdDevs The standard deviations of the measurements.
+   */
+  LinearSystemBatch(const LinearSystem<States, Inputs, Outputs>& system,
+                    int size,
+                    const std::array<double, Outputs>& measurementStdDevs = {})
+      : m_plant(system), m_measurementStdDevs(measurementStdDevs) {
+    m_x = StateMatrix::Zero(States, size);
+    m_u = InputMatrix::Zero(Inputs, size);
+    m_y = OutputMatrix::Zero(Outputs, size);
+  }
+
+  /**
+   * Returns the number of instances.
+   */
+  int Size() const { return static_cast<int>(m_x.cols()); }
+
+  /**
+   * Updates every instance with the linear system dynamics.
+   *
+   * @param dt The time between updates.
+   */
+  void Update(units::second_t dt) {
+    Eigen::Matrix<double, States, States> discA;
+    Eigen::Matrix<double, States, Inputs> discB;
+    DiscretizeAB<States, Inputs>(m_plant.A(), m_plant.B(), dt, &discA, &discB);
+
+    ForEachBlock([&](int first, int count) {
+      // x_k+1 = Ax_k + Bu_k
+      m_x.middleCols(first, count) = discA * m_x.middleCols(first, count) +
+                                     discB * m_u.middleCols(first, count);
+      UpdateY(first, count);
+    });
+    AddNoise();
+  }
+
+  /**
+   * Updates every instance by integrating dx/dt = f(x, u) with RK4, for
+   * systems like an arm whose dynamics aren't quite linear.
+   *
+   * f is called with blocks of instances: x and u have a column per instance,
+   * and f returns dx/dt in the same layout as x. With a thread pool, f must be
+   * safe to call from several threads at once. The outputs are still computed
+   * with the system's C and D.
+   *
+   * @param f  The dynamics of a block of instances.
+   * @param dt The time between updates.
+   */
+  template <typename F>
+  void Update(F&& f, units::second_t dt) {
+    ForEachBlock([&](int first, int count) {
+      m_x.middleCols(first, count) =
+          RK4(f, StateMatrix{m_x.middleCols(first, count)},
+              InputMatrix{m_u.middleCols(first, count)}, dt);
+      UpdateY(first, count);
+    });
+    AddNoise();
+  }
+
+  /**
+   * Returns the states of all instances, one column per instance.
+   */
+  const StateMatrix& GetStates() const { return m_x; }
+
+  /**
+   * Returns the state of one instance.
+   *
+   * @param instance The instance.
+   */
+  Eigen::Matrix<double, States, 1> GetState(int instance) const {
+    return m_x.col(instance);
+  }
+
+  /**
+   * Sets the states of all instances, one column per instance.
+   *
+   * @param states The new states.
+   */
+  void SetStates(const StateMatrix& states) { m_x = states; }
+
+  /**
+   * Sets the state of one instance.
+   *
+   * @param instance The instance.
+   * @param state    The new state.
+   */
+  void SetState(int instance, const Eigen::Matrix<double, States, 1>& state) {
+    m_x.col(instance) = state;
+  }
+
+  /**
+   * Sets the inputs of all instances, one column per instance.
+   *
+   * @param inputs The inputs.
+   */
+  void SetInputs(const InputMatrix& inputs) { m_u = inputs; }
+
+  /**
+   * Sets the input of one instance.
+   *
+   * @param instance The instance.
+   * @param input    The input.
+   */
+  void SetInput(int instance, const Eigen::Matrix<double, Inputs, 1>& input) {
+    m_u.col(instance) = input;
+  }
+
+  /**
+   * Returns the outputs of all instances as of the last update, one column per
+   * instance.
+   */
+  const OutputMatrix& GetOutputs() const { return m_y; }
+
+  /**
+   * Returns the output of one instance as of the last update.
+   *
+   * @param instance The instance.
+   */
+  Eigen::Matrix<double, Outputs, 1> GetOutput(int instance) const {
+    return m_y.col(instance);
+  }
+
+  /**
+   * Sets a thread pool on which to update blocks of instances in parallel.
+   *
+   * @param pool      The thread pool, or nullptr to update on the calling
+   *                  thread. It must outlive the batch, or be unset first.
+   * @param blockSize The number of instances updated together by one thread.
+   *                  Batches no larger than this are updated on the calling
+   *                  thread.
+   */
+  void SetThreadPool(wpi::ThreadPool* pool, int blockSize = 256) {
+    m_pool = pool;
+    m_blockSize = std::max(blockSize, 1);
+  }
+
+  /**
+   * Reseeds the measurement noise, so the noise of a run can be reproduced.
+   *
+   * @param seed The seed.
+   */
+  void SetNoiseSeed(uint64_t seed) { m_noiseStream.Seed(seed); }
+
+ private:
+  template <typename F>
+  void ForEachBlock(F&& func) {
+    const int size = Size();
+    if (m_pool == nullptr || size <= m_blockSize) {
+      func(0, size);
+      return;
+    }
+
+    const size_t numBlocks = (size + m_blockSize - 1) / m_blockSize;
+    m_pool->ParallelFor(
+        0, numBlocks,
+        [&](size_t block) {
+          const int first = static_cast<int>(block) * m_blockSize;
+          func(first, std::min(m_blockSize, size - first));
+        },
+        1);
+  }
+
+  void UpdateY(int first, int count) {
+    // y = Cx + Du
+    m_y.middleCols(first, count) = m_plant.C() * m_x.middleCols(first, count) +
+                                   m_plant.D() * m_u.middleCols(first, count);
+  }
+
+  void AddNoise() {
+    // The stream isn't shared with the pool, so the noise is added on the
+    // calling thread
+    m_noise.resize(Outputs, Size());
+    m_noiseStream.FillGaussian(m_noise.data(), m_noise.size());
+    m_y += Eigen::Map<const Eigen::Matrix<double, Outputs, 1>>(
+               m_measurementStdDevs.data())
+               .asDiagonal() *
+           m_noise;
+  }
+
+  LinearSystem<States, Inputs, Outputs> m_plant;
+
+  StateMatrix m_x;
+  InputMatrix m_u;
+  OutputMatrix m_y;
+  std::array<double, Outputs> m_measurementStdDevs;
+  RandomStream m_noiseStream;
+  OutputMatrix m_noise;
+
+  wpi::ThreadPool* m_pool = nullptr;
+  int m_blockSize = 256;
+};
+
+}  // namespace frc
@@ -206,4 +206,152 @@ T RKDP(F&& f, T x, U u, units::second_t dt, double maxError = 1e-6) {
   return x;
 }
 
+/**
+ * Performs adaptive Dormand-Prince integration of dx/dt = f(x, u) over
+ * successive calls, like RKDP() does for one.
+ *
+ * RKDP() starts its step size search from the whole timestep on every call.
+ * This keeps the last accepted step size between calls instead, so a model
+ * that needs small steps doesn't have several rejected steps at the start of
+ * each call. It also keeps the derivative at the end of the last step (the
+ * "first same as last" stage of Dormand-Prince), which is reused as the first
+ * stage of the next call if it starts from the same x and u.
+ *
+ * @tparam T The type of x.
+ * @tparam U The type of u.
+ */
+template <typename T, typename U>
+class RKDPIntegrator {
+ public:
+  /**
+   * Constructs an integrator.
+   *
+   * @param maxError The maximum acceptable truncation error. Usually a small
+   *                 number like 1e-6.
+   */
+  explicit RKDPIntegrator(double maxError = 1e-6) : m_maxError{maxError} {}
+
+  /**
+   * Integrates dx/dt = f(x, u) for dt.
+   *
+   * @param f  The function to integrate. It must take two arguments x and u,
+   *           and be the same function on every call (or Reset() must be
+   *           called when it changes).
+   * @param x  The initial value of x.
+   * @param u  The value u held constant over the integration period.
+   * @param dt The time over which to integrate.
+   */
+  template <typename F>
+  T Integrate(F&& f, T x, const U& u, units::second_t dt) {
+    // See https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method for the
+    // Butcher tableau the following arrays came from.
+
+    constexpr int kDim = 7;
+
+    // clang-format off
+    constexpr double A[kDim - 1][kDim - 1]{
+        {      1.0 / 5.0},
+        {      3.0 / 40.0,        9.0 / 40.0},
+        {     44.0 / 45.0,      -56.0 / 15.0,       32.0 / 9.0},
+        {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0},
+        { 9017.0 / 3168.0,     -355.0 / 33.0, 46732.0 / 5247.0,   49.0 / 176.0, -5103.0 / 18656.0},
+        {    35.0 / 384.0,               0.0,   500.0 / 1113.0,  125.0 / 192.0,  -2187.0 / 6784.0, 11.0 / 84.0}};
+    // clang-format on
+
+    constexpr std::array<double, kDim> b1{
+        35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0,
+        11.0 / 84.0,  0.0};
+    constexpr std::array<double, kDim> b2{5179.0 / 57600.0,    0.0,
+                                          7571.0 / 16695.0,    393.0 / 640.0,
+                                          -92097.0 / 339200.0, 187.0 / 2100.0,
+                                          1.0 / 40.0};
+
+    const double tf = dt.to<double>();
+    if (m_h <= 0.0) {
+      m_h = tf;
+    }
+
+    T k1 = m_hasLast && x == m_lastX && u == m_lastU ? m_lastK : f(x, u);
+
+    double dtElapsed = 0.0;
+    while (dtElapsed < tf) {
+      // Only allow us to advance up to the dt remaining. A step shortened this
+      // way says nothing about the step size the model needs, so it isn't
+      // kept for the next call.
+      const bool clipped = m_h >= tf - dtElapsed;
+      const double h = clipped ? tf - dtElapsed : m_h;
+
+      // clang-format off
+      T k2 = f(x + h * (A[0][0] * k1), u);
+      T k3 = f(x + h * (A[1][0] * k1 + A[1][1] * k2), u);
+      T k4 = f(x + h * (A[2][0] * k1 + A[2][1] * k2 + A[2][2] * k3), u);
+      T k5 = f(x + h * (A[3][0] * k1 + A[3][1] * k2 + A[3][2] * k3 + A[3][3] * k4), u);
+      T k6 = f(x + h * (A[4][0] * k1 + A[4][1] * k2 + A[4][2] * k3 + A[4][3] * k4 + A[4][4] * k5), u);
+      // clang-format on
+
+      T newX = x + h * (A[5][0] * k1 + A[5][1] * k2 + A[5][2] * k3 +
+                        A[5][3] * k4 + A[5][4] * k5 + A[5][5] * k6);
+      T k7 = f(newX, u);
+
+      double truncationError =
+          (h * ((b1[0] - b2[0]) * k1 + (b1[1] - b2[1]) * k2 +
+                (b1[2] - b2[2]) * k3 + (b1[3] - b2[3]) * k4 +
+                (b1[4] - b2[4]) * k5 + (b1[5] - b2[5]) * k6 +
+                (b1[6] - b2[6]) * k7))
+              .norm();
+
+      // Limit how fast the step size changes, so one lucky or unlucky step
+      // doesn't throw it far off
+      double scale =
+          truncationError == 0.0
+              ? 5.0
+              : std::clamp(
+                    0.9 * std::pow(m_maxError / truncationError, 1.0 / 5.0),
+                    0.2, 5.0);
+
+      if (truncationError > m_maxError) {
+        m_h = h * scale;
+        continue;
+      }
+
+      dtElapsed += h;
+      x = newX;
+      k1 = k7;
+      if (!clipped) {
+        m_h = h * scale;
+      }
+    }
+
+    m_lastX = x;
+    m_lastU = u;
+    m_lastK = k1;
+    m_hasLast = true;
+
+    return x;
+  }
+
+  /**
+   * Returns the step size the next call will start with, or zero if there
+   * hasn't been one yet.
+   */
+  units::second_t GetStepSize() const { return units::second_t{m_h}; }
+
+  /**
+   * Forgets the step size and derivative kept from previous calls.
+   */
+  void Reset() {
+    m_h = 0.0;
+    m_hasLast = false;
+  }
+
+ private:
+  double m_maxError;
+  double m_h = 0.0;
+
+  T m_lastX;
+  U m_lastU;
+  T m_lastK;
+  bool m_hasLast = false;
+};
+
 }  // namespace frc
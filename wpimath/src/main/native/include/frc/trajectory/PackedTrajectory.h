@@ -0,0 +1,163 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <wpi/span.h>
+
+#include "frc/geometry/Pose2d.h"
+#include "frc/geometry/Transform2d.h"
+#include "frc/trajectory/Trajectory.h"
+#include "units/acceleration.h"
+#include "units/angle.h"
+#include "units/curvature.h"
+#include "units/length.h"
+#include "units/time.h"
+#include "units/velocity.h"
+
+namespace frc {
+/**
+ * A trajectory stored as an array per field of its states (time, velocity,
+ * acceleration, x, y, heading and curvature) instead of an array of
+ * Trajectory::State. This takes less memory than Trajectory, as headings
+ * aren't stored with their cosine and sine, and operations that touch only
+ * some of the fields only read those arrays; transforms run as one loop over
+ * the coordinates that the compiler can vectorize.
+ */
+class PackedTrajectory {
+ public:
+  PackedTrajectory() = default;
+
+  /**
+   * Constructs a packed copy of a trajectory.
+   *
+   * @param trajectory The trajectory to copy.
+   */
+  explicit PackedTrajectory(const Trajectory& trajectory);
+
+  /**
+   * Converts back to a Trajectory.
+   * @return The trajectory.
+   */
+  Trajectory ToTrajectory() const;
+
+  /**
+   * Returns the number of states.
+   * @return The number of states.
+   */
+  size_t size() const { return m_t.size(); }
+
+  /**
+   * Returns the overall duration of the trajectory.
+   * @return The duration of the trajectory.
+   */
+  units::second_t TotalTime() const {
+    return m_t.empty() ? 0_s : m_t.back();
+  }
+
+  /**
+   * Returns a state of the trajectory.
+   *
+   * @param i The index of the state.
+   * @return The state.
+   */
+  Trajectory::State GetState(size_t i) const;
+
+  /** Returns the time of each state. */
+  wpi::span<const units::second_t> Times() const { return m_t; }
+
+  /** Returns the velocity at each state. */
+  wpi::span<const units::meters_per_second_t> Velocities() const {
+    return m_velocity;
+  }
+
+  /** Returns the acceleration at each state. */
+  wpi::span<const units::meters_per_second_squared_t> Accelerations() const {
+    return m_acceleration;
+  }
+
+  /** Returns the x coordinate of each state. */
+  wpi::span<const units::meter_t> X() const { return m_x; }
+
+  /** Returns the y coordinate of each state. */
+  wpi::span<const units::meter_t> Y() const { return m_y; }
+
+  /** Returns the heading at each state. */
+  wpi::span<const units::radian_t> Headings() const { return m_heading; }
+
+  /** Returns the curvature at each state. */
+  wpi::span<const units::curvature_t> Curvatures() const {
+    return m_curvature;
+  }
+
+  /**
+   * Sample the trajectory at a point in time. Gives the same state as
+   * Trajectory::Sample().
+   *
+   * @param t The point in time since the beginning of the trajectory to sample.
+   * @return The state at that point in time.
+   */
+  Trajectory::State Sample(units::second_t t) const;
+
+  /**
+   * Samples the trajectory at many points in time. The times should be in
+   * increasing order; each sample then continues from the last instead of
+   * searching the whole trajectory.
+   *
+   * @param times The points in time to sample.
+   * @param states Output for the state at each time; must be the same size
+   * as times.
+   */
+  void Sample(wpi::span<const units::second_t> times,
+              wpi::span<Trajectory::State> states) const;
+
+  /**
+   * Transforms all poses in the trajectory by the given transform, like
+   * Trajectory::TransformBy().
+   *
+   * @param transform The transform to transform the trajectory by.
+   * @return The transformed trajectory.
+   */
+  PackedTrajectory TransformBy(const Transform2d& transform) const;
+
+  /**
+   * Transforms all poses in the trajectory so that they are relative to the
+   * given pose, like Trajectory::RelativeTo().
+   *
+   * @param pose The pose that is the origin of the coordinate frame that
+   *             the current trajectory will be transformed into.
+   * @return The transformed trajectory.
+   */
+  PackedTrajectory RelativeTo(const Pose2d& pose) const;
+
+  /**
+   * Concatenates another trajectory to the current trajectory, like
+   * Trajectory::operator+().
+   *
+   * @param other The trajectory to concatenate.
+   * @return The concatenated trajectory.
+   */
+  PackedTrajectory operator+(const PackedTrajectory& other) const;
+
+ private:
+  // Interpolates for a time strictly inside the trajectory, given the first
+  // state with a time no less than it.
+  Trajectory::State Interpolate(size_t index, units::second_t t) const;
+
+  // Rotates every pose by the rotation, then translates it.
+  PackedTrajectory Transformed(const Rotation2d& rotation,
+                               const Translation2d& translation) const;
+
+  std::vector<units::second_t> m_t;
+  std::vector<units::meters_per_second_t> m_velocity;
+  std::vector<units::meters_per_second_squared_t> m_acceleration;
+  std::vector<units::meter_t> m_x;
+  std::vector<units::meter_t> m_y;
+  std::vector<units::radian_t> m_heading;
+  std::vector<units::curvature_t> m_curvature;
+};
+}  // namespace frc
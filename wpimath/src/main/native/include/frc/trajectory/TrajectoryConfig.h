@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -16,21 +17,25 @@
 #include "frc/trajectory/constraint/SwerveDriveKinematicsConstraint.h"
 #include "frc/trajectory/constraint/TrajectoryConstraint.h"
 #include "units/acceleration.h"
+#include "units/time.h"
 #include "units/velocity.h"
 
 namespace frc {
 /**
  * Represents the configuration for generating a trajectory. This class stores
- * the start velocity, end velocity, max velocity, max acceleration, custom
- * constraints, and the reversed flag.
+ * the start velocity, end velocity, max velocity, max acceleration, max jerk,
+ * custom constraints, and the reversed flag.
  *
  * The class must be constructed with a max velocity and max acceleration.
- * The other parameters (start velocity, end velocity, constraints, reversed)
- * have been defaulted to reasonable values (0, 0, {}, false). These values can
- * be changed via the SetXXX methods.
+ * The other parameters (start velocity, end velocity, max jerk, constraints,
+ * reversed) have been defaulted to reasonable values (0, 0, unlimited, {},
+ * false). These values can be changed via the SetXXX methods.
  */
 class TrajectoryConfig {
  public:
+  using Jerk_t = units::unit_t<units::compound_unit<
+      units::meters_per_second_squared, units::inverse<units::seconds>>>;
+
   /**
    * Constructs a config object.
    * @param maxVelocity The max velocity of the trajectory.
@@ -68,6 +73,13 @@ class TrajectoryConfig {
    */
   void SetReversed(bool reversed) { m_reversed = reversed; }
 
+  /**
+   * Sets the max jerk of the trajectory. The time parameterization then
+   * ramps the acceleration up and down instead of switching it on and off.
+   * @param maxJerk The max jerk of the trajectory, or infinity for none.
+   */
+  void SetMaxJerk(Jerk_t maxJerk) { m_maxJerk = maxJerk; }
+
   /**
    * Adds a user-defined constraint to the trajectory.
    * @param constraint The user-defined constraint.
@@ -136,6 +148,12 @@ class TrajectoryConfig {
     return m_maxAcceleration;
   }
 
+  /**
+   * Returns the maximum jerk of the trajectory.
+   * @return The maximum jerk of the trajectory, or infinity if it's unlimited.
+   */
+  Jerk_t MaxJerk() const { return m_maxJerk; }
+
   /**
    * Returns the user-defined constraints of the trajectory.
    * @return The user-defined constraints of the trajectory.
@@ -156,6 +174,7 @@ class TrajectoryConfig {
   units::meters_per_second_t m_endVelocity = 0_mps;
   units::meters_per_second_t m_maxVelocity;
   units::meters_per_second_squared_t m_maxAcceleration;
+  Jerk_t m_maxJerk{std::numeric_limits<double>::infinity()};
   std::vector<std::unique_ptr<TrajectoryConstraint>> m_constraints;
   bool m_reversed = false;
 };
@@ -0,0 +1,166 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <wpi/FunctionExtras.h>
+#include <wpi/ThreadPool.h>
+#include <wpi/future.h>
+#include <wpi/mutex.h>
+
+#include "frc/trajectory/Trajectory.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+
+namespace frc {
+/**
+ * Generates trajectories on a pool of worker threads, so the robot loop
+ * doesn't wait for them.  The splines of a trajectory are parameterized in
+ * parallel.
+ *
+ * Generated trajectories are cached, keyed by the waypoints and the config
+ * object: asking again for the same waypoints with the same config (the same
+ * object, not an equal one) returns the cached trajectory, or waits for the
+ * generation already running.  Configs are shared and must not be changed
+ * once passed in.
+ *
+ * Errors are reported through TrajectoryGenerator's error handler, from the
+ * worker threads.
+ */
+class TrajectoryGenerationService {
+ public:
+  /**
+   * Starts the workers.
+   *
+   * @param cacheSize Number of trajectories to keep cached once generated.
+   * @param options   Options for the worker pool (number of workers, their
+   *                  priority and CPUs).
+   */
+  explicit TrajectoryGenerationService(
+      size_t cacheSize = 16, const wpi::ThreadPool::Options& options = {});
+
+  /**
+   * Finishes the trajectories being generated and stops the workers.
+   */
+  ~TrajectoryGenerationService();
+
+  TrajectoryGenerationService(const TrajectoryGenerationService&) = delete;
+  TrajectoryGenerationService& operator=(const TrajectoryGenerationService&) =
+      delete;
+
+  /**
+   * Generates a trajectory from the given control vectors and config, like
+   * TrajectoryGenerator::GenerateTrajectory().
+   *
+   * @param initial           The initial control vector.
+   * @param interiorWaypoints The interior waypoints.
+   * @param end               The ending control vector.
+   * @param config            The configuration for the trajectory.
+   * @return Future for the generated trajectory.
+   */
+  wpi::future<Trajectory> GenerateTrajectory(
+      const Spline<3>::ControlVector& initial,
+      std::vector<Translation2d> interiorWaypoints,
+      const Spline<3>::ControlVector& end,
+      std::shared_ptr<const TrajectoryConfig> config);
+
+  /**
+   * Generates a trajectory from the given waypoints and config, like
+   * TrajectoryGenerator::GenerateTrajectory().
+   *
+   * @param start             The starting pose.
+   * @param interiorWaypoints The interior waypoints.
+   * @param end               The ending pose.
+   * @param config            The configuration for the trajectory.
+   * @return Future for the generated trajectory.
+   */
+  wpi::future<Trajectory> GenerateTrajectory(
+      const Pose2d& start, std::vector<Translation2d> interiorWaypoints,
+      const Pose2d& end, std::shared_ptr<const TrajectoryConfig> config);
+
+  /**
+   * Generates a trajectory from the given quintic control vectors and config,
+   * like TrajectoryGenerator::GenerateTrajectory().
+   *
+   * @param controlVectors List of quintic control vectors.
+   * @param config         The configuration for the trajectory.
+   * @return Future for the generated trajectory.
+   */
+  wpi::future<Trajectory> GenerateTrajectory(
+      std::vector<Spline<5>::ControlVector> controlVectors,
+      std::shared_ptr<const TrajectoryConfig> config);
+
+  /**
+   * Generates a trajectory from the given waypoints and config, like
+   * TrajectoryGenerator::GenerateTrajectory().
+   *
+   * @param waypoints List of waypoints.
+   * @param config    The configuration for the trajectory.
+   * @return Future for the generated trajectory.
+   */
+  wpi::future<Trajectory> GenerateTrajectory(
+      std::vector<Pose2d> waypoints,
+      std::shared_ptr<const TrajectoryConfig> config);
+
+  /**
+   * Drops all cached trajectories.  Trajectories being generated are still
+   * delivered.
+   */
+  void ClearCache();
+
+  /**
+   * Gets the number of requests answered from the cache (including those
+   * that waited for a generation already running).
+   */
+  uint64_t GetCacheHits() const;
+
+ private:
+  struct Key {
+    // which GenerateTrajectory() overload
+    int kind;
+    // the bits of the waypoint coordinates
+    std::vector<uint64_t> values;
+    const TrajectoryConfig* config;
+
+    bool operator==(const Key& rhs) const {
+      return kind == rhs.kind && config == rhs.config && values == rhs.values;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    // keeps the config (and so its address) alive while cached
+    std::shared_ptr<const TrajectoryConfig> config;
+    std::optional<Trajectory> result;
+    std::vector<wpi::promise<Trajectory>> waiters;
+  };
+
+  wpi::future<Trajectory> Generate(
+      Key key, std::shared_ptr<const TrajectoryConfig> config,
+      wpi::unique_function<Trajectory(wpi::ThreadPool& pool)> generate);
+  void Evict();
+
+  size_t m_cacheSize;
+  mutable wpi::mutex m_mutex;
+  std::unordered_map<Key, std::shared_ptr<Entry>, KeyHash> m_entries;
+  // cached keys, oldest first
+  std::deque<Key> m_order;
+  uint64_t m_hits = 0;
+
+  // last, so the workers stop before the cache is destroyed
+  wpi::ThreadPool m_pool;
+};
+}  // namespace frc
@@ -9,6 +9,8 @@
 #include <utility>
 #include <vector>
 
+#include <wpi/ThreadPool.h>
+
 #include "frc/spline/SplineParameterizer.h"
 #include "frc/trajectory/Trajectory.h"
 #include "frc/trajectory/TrajectoryConfig.h"
@@ -82,6 +84,113 @@ class TrajectoryGenerator {
   static Trajectory GenerateTrajectory(const std::vector<Pose2d>& waypoints,
                                        const TrajectoryConfig& config);
 
+  /**
+   * Generates a trajectory like GenerateTrajectory(Spline<3>::ControlVector,
+   * const std::vector<Translation2d>&, Spline<3>::ControlVector, const
+   * TrajectoryConfig&), parameterizing the splines in parallel.
+   *
+   * @param initial           The initial control vector.
+   * @param interiorWaypoints The interior waypoints.
+   * @param end               The ending control vector.
+   * @param config            The configuration for the trajectory.
+   * @param pool              The thread pool to parameterize on.
+   * @return The generated trajectory.
+   */
+  static Trajectory GenerateTrajectory(
+      Spline<3>::ControlVector initial,
+      const std::vector<Translation2d>& interiorWaypoints,
+      Spline<3>::ControlVector end, const TrajectoryConfig& config,
+      wpi::ThreadPool& pool);
+
+  /**
+   * Generates a trajectory like GenerateTrajectory(const Pose2d&, const
+   * std::vector<Translation2d>&, const Pose2d&, const TrajectoryConfig&),
+   * parameterizing the splines in parallel.
+   *
+   * @param start             The starting pose.
+   * @param interiorWaypoints The interior waypoints.
+   * @param end               The ending pose.
+   * @param config            The configuration for the trajectory.
+   * @param pool              The thread pool to parameterize on.
+   * @return The generated trajectory.
+   */
+  static Trajectory GenerateTrajectory(
+      const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
+      const Pose2d& end, const TrajectoryConfig& config, wpi::ThreadPool& pool);
+
+  /**
+   * Generates a trajectory like
+   * GenerateTrajectory(std::vector<Spline<5>::ControlVector>, const
+   * TrajectoryConfig&), parameterizing the splines in parallel.
+   *
+   * @param controlVectors List of quintic control vectors.
+   * @param config         The configuration for the trajectory.
+   * @param pool           The thread pool to parameterize on.
+   * @return The generated trajectory.
+   */
+  static Trajectory GenerateTrajectory(
+      std::vector<Spline<5>::ControlVector> controlVectors,
+      const TrajectoryConfig& config, wpi::ThreadPool& pool);
+
+  /**
+   * Generates a trajectory like GenerateTrajectory(const std::vector<Pose2d>&,
+   * const TrajectoryConfig&), parameterizing the splines in parallel.
+   *
+   * @param waypoints List of waypoints.
+   * @param config    The configuration for the trajectory.
+   * @param pool      The thread pool to parameterize on.
+   * @return The generated trajectory.
+   */
+  static Trajectory GenerateTrajectory(const std::vector<Pose2d>& waypoints,
+                                       const TrajectoryConfig& config,
+                                       wpi::ThreadPool& pool);
+
+  /**
+   * Replans a trajectory that is being followed, for example because its
+   * target moved. The states before the given time are kept, and from the
+   * junction (the trajectory sampled at that time) a new tail is generated
+   * through the given waypoints. Only the tail's splines are parameterized,
+   * so this costs about as much as generating the tail on its own.
+   *
+   * The tail starts at the junction's pose, curvature and speed, so the
+   * robot doesn't see a jump in any of them; if the config's constraints
+   * don't allow that speed, it is lowered. The tail's splines are quintic
+   * hermite splines, like GenerateTrajectory(const std::vector<Pose2d>&,
+   * const TrajectoryConfig&) uses. The config's start velocity is ignored.
+   *
+   * @param trajectory The trajectory being followed.
+   * @param time       The time along the trajectory to replan from, usually
+   *                   the current time.
+   * @param waypoints  The waypoints after the junction, ending with the new
+   *                   target.
+   * @param config     The configuration for the tail.
+   * @return The replanned trajectory, with the same time base as the old one,
+   *         or the old one if the tail couldn't be generated.
+   */
+  static Trajectory Replan(const Trajectory& trajectory, units::second_t time,
+                           const std::vector<Pose2d>& waypoints,
+                           const TrajectoryConfig& config);
+
+  /**
+   * Replans a trajectory like Replan(const Trajectory&, units::second_t, const
+   * std::vector<Pose2d>&, const TrajectoryConfig&), parameterizing the splines
+   * in parallel.
+   *
+   * @param trajectory The trajectory being followed.
+   * @param time       The time along the trajectory to replan from, usually
+   *                   the current time.
+   * @param waypoints  The waypoints after the junction, ending with the new
+   *                   target.
+   * @param config     The configuration for the tail.
+   * @param pool       The thread pool to parameterize on.
+   * @return The replanned trajectory, with the same time base as the old one,
+   *         or the old one if the tail couldn't be generated.
+   */
+  static Trajectory Replan(const Trajectory& trajectory, units::second_t time,
+                           const std::vector<Pose2d>& waypoints,
+                           const TrajectoryConfig& config,
+                           wpi::ThreadPool& pool);
+
   /**
    * Generate spline points from a vector of splines by parameterizing the
    * splines.
@@ -100,14 +209,48 @@ class TrajectoryGenerator {
     splinePoints.push_back(splines.front().GetPoint(0.0));
 
     // Iterate through the vector and parameterize each spline, adding the
-    // parameterized points to the final vector.
+    // parameterized points to the final vector. The first point of each
+    // spline isn't added, as it's a duplicate of the last point from the
+    // previous spline.
+    thread_local SplineParameterizer::Workspace workspace;
     for (auto&& spline : splines) {
-      auto points = SplineParameterizer::Parameterize(spline);
-      // Append the array of poses to the vector. We are removing the first
-      // point because it's a duplicate of the last point from the previous
-      // spline.
-      splinePoints.insert(std::end(splinePoints), std::begin(points) + 1,
-                          std::end(points));
+      SplineParameterizer::Parameterize(spline, workspace, &splinePoints);
+    }
+    return splinePoints;
+  }
+
+  /**
+   * Generate spline points from a vector of splines by parameterizing the
+   * splines in parallel.
+   *
+   * @param splines The splines to parameterize.
+   * @param pool The thread pool to parameterize on.
+   *
+   * @return The spline points for use in time parameterization of a trajectory.
+   */
+  template <typename Spline>
+  static std::vector<PoseWithCurvature> SplinePointsFromSplines(
+      const std::vector<Spline>& splines, wpi::ThreadPool& pool) {
+    std::vector<std::vector<PoseWithCurvature>> segments(splines.size());
+    pool.ParallelFor(
+        0, splines.size(),
+        [&](size_t i) {
+          thread_local SplineParameterizer::Workspace workspace;
+          SplineParameterizer::Parameterize(splines[i], workspace,
+                                            &segments[i]);
+        },
+        1);
+
+    size_t size = 1;
+    for (auto&& segment : segments) {
+      size += segment.size();
+    }
+    std::vector<PoseWithCurvature> splinePoints;
+    splinePoints.reserve(size);
+    splinePoints.push_back(splines.front().GetPoint(0.0));
+    for (auto&& segment : segments) {
+      splinePoints.insert(std::end(splinePoints), std::begin(segment),
+                          std::end(segment));
     }
     return splinePoints;
   }
@@ -124,6 +267,30 @@ class TrajectoryGenerator {
  private:
   static void ReportError(const char* error);
 
+  // The implementations of GenerateTrajectory(); pool may be null
+  static Trajectory GenerateCubic(
+      Spline<3>::ControlVector initial,
+      const std::vector<Translation2d>& interiorWaypoints,
+      Spline<3>::ControlVector end, const TrajectoryConfig& config,
+      wpi::ThreadPool* pool);
+  static Trajectory GenerateQuintic(
+      std::vector<Spline<5>::ControlVector> controlVectors,
+      const TrajectoryConfig& config, wpi::ThreadPool* pool);
+  static Trajectory GenerateQuintic(const std::vector<Pose2d>& waypoints,
+                                    const TrajectoryConfig& config,
+                                    wpi::ThreadPool* pool);
+
+  static Trajectory ReplanQuintic(const Trajectory& trajectory,
+                                  units::second_t time,
+                                  const std::vector<Pose2d>& waypoints,
+                                  const TrajectoryConfig& config,
+                                  wpi::ThreadPool* pool);
+
+  template <typename MakeSplines>
+  static Trajectory GenerateFromSplines(
+      MakeSplines&& makeSplines, const TrajectoryConfig& config,
+      units::meters_per_second_t startVelocity, wpi::ThreadPool* pool);
+
   static const Trajectory kDoNothingTrajectory;
   static std::function<void(const char*)> s_errorFunc;
 };
@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -42,6 +44,8 @@ namespace frc {
 class TrajectoryParameterizer {
  public:
   using PoseWithCurvature = std::pair<Pose2d, units::curvature_t>;
+  using Jerk_t = units::unit_t<units::compound_unit<
+      units::meters_per_second_squared, units::inverse<units::seconds>>>;
 
   /**
    * Parameterize the trajectory by time. This is where the velocity profile is
@@ -50,6 +54,14 @@ class TrajectoryParameterizer {
    * The derivation of the algorithm used can be found here:
    * <http://www2.informatik.uni-freiburg.de/~lau/students/Sprunk2008.pdf>
    *
+   * Constraints that implement TrajectoryConstraint::MaxVelocities() are
+   * evaluated for all the points at once.
+   *
+   * With a max jerk, each pass also limits how quickly the acceleration it
+   * imposes builds up, and eases it off as the velocity nears the max
+   * velocity, giving an S-curve profile in the same two passes. Velocity
+   * limits from the constraints still end acceleration abruptly.
+   *
    * @param points Reference to the spline points.
    * @param constraints A vector of various velocity and acceleration
    * constraints.
@@ -59,6 +71,7 @@ class TrajectoryParameterizer {
    * @param maxAcceleration The max acceleration for the trajectory.
    * @param reversed Whether the robot should move backwards. Note that the
    * robot will still move from a -> b -> ... -> z as defined in the waypoints.
+   * @param maxJerk The max jerk for the trajectory, or infinity for none.
    *
    * @return The trajectory.
    */
@@ -68,7 +81,40 @@ class TrajectoryParameterizer {
       units::meters_per_second_t startVelocity,
       units::meters_per_second_t endVelocity,
       units::meters_per_second_t maxVelocity,
-      units::meters_per_second_squared_t maxAcceleration, bool reversed);
+      units::meters_per_second_squared_t maxAcceleration, bool reversed,
+      Jerk_t maxJerk = Jerk_t{std::numeric_limits<double>::infinity()});
+
+  /**
+   * Parameterize the trajectory by time, with constraints whose types are
+   * known at compile time.  Unlike with a vector of constraints, their
+   * methods are called directly rather than through virtual calls, so they
+   * can be inlined.
+   *
+   * @param points Reference to the spline points.
+   * @param constraints A tuple of velocity and acceleration constraints.
+   * @param startVelocity The start velocity for the trajectory.
+   * @param endVelocity The end velocity for the trajectory.
+   * @param maxVelocity The max velocity for the trajectory.
+   * @param maxAcceleration The max acceleration for the trajectory.
+   * @param reversed Whether the robot should move backwards. Note that the
+   * robot will still move from a -> b -> ... -> z as defined in the waypoints.
+   * @param maxJerk The max jerk for the trajectory, or infinity for none.
+   *
+   * @return The trajectory.
+   */
+  template <typename... Constraints>
+  static Trajectory TimeParameterizeTrajectory(
+      const std::vector<PoseWithCurvature>& points,
+      const std::tuple<Constraints...>& constraints,
+      units::meters_per_second_t startVelocity,
+      units::meters_per_second_t endVelocity,
+      units::meters_per_second_t maxVelocity,
+      units::meters_per_second_squared_t maxAcceleration, bool reversed,
+      Jerk_t maxJerk = Jerk_t{std::numeric_limits<double>::infinity()}) {
+    return Parameterize(points, StaticConstraints<Constraints...>{constraints},
+                        startVelocity, endVelocity, maxVelocity,
+                        maxAcceleration, reversed, maxJerk);
+  }
 
  private:
   constexpr static double kEpsilon = 1E-6;
@@ -87,18 +133,71 @@ class TrajectoryParameterizer {
   };
 
   /**
-   * Enforces acceleration limits as defined by the constraints. This function
-   * is used when time parameterizing a trajectory.
+   * The constraints of a parameterization.  Both have:
+   *
+   * MaxVelocity(index, pose, velocity): returns the velocity at the pose
+   * (the index-th point) limited by all the constraints.
+   *
+   * EnforceAccelerationLimits(reverse, index, state): applies the
+   * acceleration limits of all the constraints to the state (the index-th
+   * point).
+   */
+  class DynamicConstraints;
+  template <typename... Constraints>
+  class StaticConstraints;
+
+  /**
+   * The parameterization algorithm, for either kind of constraints.
+   */
+  template <typename ConstraintSet>
+  static Trajectory Parameterize(
+      const std::vector<PoseWithCurvature>& points,
+      const ConstraintSet& constraints,
+      units::meters_per_second_t startVelocity,
+      units::meters_per_second_t endVelocity,
+      units::meters_per_second_t maxVelocity,
+      units::meters_per_second_squared_t maxAcceleration, bool reversed,
+      Jerk_t maxJerk);
+
+  /**
+   * Limits the acceleration over a segment of the trajectory by the max jerk.
+   * It may only exceed the acceleration of the previous segment by the jerk
+   * times the time between the middles of the segments, and must be low
+   * enough to ease off to zero before the velocity reaches velocityLimit.
+   *
+   * The segment is traversed in the direction of the pass, so the backward
+   * pass passes its decelerations as positive accelerations.
+   *
+   * @param acceleration The acceleration to limit.
+   * @param lastAcceleration The acceleration of the previous segment.
+   * @param lastDuration The duration of the previous segment.
+   * @param velocity The velocity at the start of the segment.
+   * @param ds The length of the segment.
+   * @param velocityLimit The velocity to ease off the acceleration before.
+   * @param maxJerk The max jerk.
+   *
+   * @return The limited acceleration.
+   */
+  static units::meters_per_second_squared_t LimitJerk(
+      units::meters_per_second_squared_t acceleration,
+      units::meters_per_second_squared_t lastAcceleration,
+      units::second_t lastDuration, units::meters_per_second_t velocity,
+      units::meter_t ds, units::meters_per_second_t velocityLimit,
+      Jerk_t maxJerk);
+
+  /**
+   * Enforces the acceleration limits of a constraint. This function is used
+   * when time parameterizing a trajectory.
    *
    * @param reverse Whether the robot is traveling backwards.
-   * @param constraints A vector of the user-defined velocity and acceleration
-   * constraints.
+   * @param minMax The acceleration limits of a constraint.
    * @param state Pointer to the constrained state that we are operating on.
    * This is mutated in place.
    */
-  static void EnforceAccelerationLimits(
-      bool reverse,
-      const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints,
+  static void ApplyAccelerationLimits(
+      bool reverse, const TrajectoryConstraint::MinMax& minMax,
       ConstrainedState* state);
 };
 }  // namespace frc
+
+#include "TrajectoryParameterizer.inc"
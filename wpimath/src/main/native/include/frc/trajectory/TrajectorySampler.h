@@ -0,0 +1,115 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "frc/trajectory/Trajectory.h"
+#include "units/time.h"
+
+namespace frc {
+/**
+ * Samples a trajectory at increasing times, as trajectory followers do.
+ * Instead of searching all of the trajectory's states on each call like
+ * Trajectory::Sample(), it remembers where the last sample was and walks
+ * forward from there, so sampling a whole trajectory takes time linear in its
+ * number of states.
+ *
+ * Sampling at an earlier time than the last sample is still correct, but
+ * searches from the start again.
+ *
+ * The sampler refers to the trajectory, which must outlive it and not be
+ * moved.
+ */
+class TrajectorySampler {
+ public:
+  /**
+   * Constructs a sampler without a trajectory. One must be assigned before
+   * sampling.
+   */
+  TrajectorySampler() = default;
+
+  /**
+   * Constructs a sampler for a trajectory.
+   *
+   * @param trajectory The trajectory to sample.
+   */
+  explicit TrajectorySampler(const Trajectory& trajectory)
+      : m_trajectory(&trajectory) {}
+
+  /**
+   * Sample the trajectory at a point in time. Gives the same state as
+   * Trajectory::Sample().
+   *
+   * @param t The point in time since the beginning of the trajectory to sample.
+   * @return The state at that point in time.
+   */
+  Trajectory::State Sample(units::second_t t);
+
+  /**
+   * Forgets the last sample, so the next one searches from the start.
+   */
+  void Reset() { m_index = 1; }
+
+ private:
+  const Trajectory* m_trajectory = nullptr;
+
+  // The first state that may be after the last sample
+  size_t m_index = 1;
+};
+
+/**
+ * A trajectory resampled at a fixed period, so the state nearest any time can
+ * be found by division instead of a search.
+ *
+ * Sampling between the resampled states interpolates between them, so gives
+ * slightly different states than sampling the original trajectory; use a
+ * period no longer than that of the states to keep the difference small.
+ */
+class UniformTrajectory {
+ public:
+  /**
+   * Resamples a trajectory.
+   *
+   * @param trajectory The trajectory to resample.
+   * @param period The time between the resampled states.
+   */
+  UniformTrajectory(const Trajectory& trajectory, units::second_t period);
+
+  /**
+   * Returns the overall duration of the trajectory.
+   * @return The duration of the trajectory.
+   */
+  units::second_t TotalTime() const { return m_totalTime; }
+
+  /**
+   * Returns the time between the resampled states.
+   * @return The time between the resampled states.
+   */
+  units::second_t Period() const { return m_period; }
+
+  /**
+   * Return the resampled states. State i is at i times the period, except the
+   * last, which is at the end of the trajectory.
+   * @return The resampled states.
+   */
+  const std::vector<Trajectory::State>& States() const { return m_states; }
+
+  /**
+   * Sample the trajectory at a point in time, interpolating between the
+   * resampled states around it.
+   *
+   * @param t The point in time since the beginning of the trajectory to sample.
+   * @return The state at that point in time.
+   */
+  Trajectory::State Sample(units::second_t t) const;
+
+ private:
+  std::vector<Trajectory::State> m_states;
+  units::second_t m_period;
+  units::second_t m_totalTime;
+};
+}  // namespace frc
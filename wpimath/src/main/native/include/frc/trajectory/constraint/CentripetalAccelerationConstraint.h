@@ -32,6 +32,12 @@ class CentripetalAccelerationConstraint : public TrajectoryConstraint {
   MinMax MinMaxAcceleration(const Pose2d& pose, units::curvature_t curvature,
                             units::meters_per_second_t speed) const override;
 
+  bool MaxVelocities(
+      wpi::span<const PoseWithCurvature> points,
+      wpi::span<units::meters_per_second_t> limits) const override;
+
+  bool LimitsAcceleration() const override { return false; }
+
  private:
   units::meters_per_second_squared_t m_maxCentripetalAcceleration;
 };
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "frc/trajectory/constraint/TrajectoryConstraint.h"
 #include "units/math.h"
 #include "units/velocity.h"
@@ -35,6 +37,15 @@ class MaxVelocityConstraint : public TrajectoryConstraint {
     return {};
   }
 
+  bool MaxVelocities(
+      wpi::span<const PoseWithCurvature> points,
+      wpi::span<units::meters_per_second_t> limits) const override {
+    std::fill(limits.begin(), limits.end(), m_maxVelocity);
+    return true;
+  }
+
+  bool LimitsAcceleration() const override { return false; }
+
  private:
   units::meters_per_second_t m_maxVelocity;
 };
@@ -32,6 +32,12 @@ class SwerveDriveKinematicsConstraint : public TrajectoryConstraint {
   MinMax MinMaxAcceleration(const Pose2d& pose, units::curvature_t curvature,
                             units::meters_per_second_t speed) const override;
 
+  bool MaxVelocities(
+      wpi::span<const PoseWithCurvature> points,
+      wpi::span<units::meters_per_second_t> limits) const override;
+
+  bool LimitsAcceleration() const override { return false; }
+
  private:
   const frc::SwerveDriveKinematics<NumModules>& m_kinematics;
   units::meters_per_second_t m_maxSpeed;
@@ -5,6 +5,9 @@
 #pragma once
 
 #include <limits>
+#include <utility>
+
+#include <wpi/span.h>
 
 #include "frc/geometry/Pose2d.h"
 #include "frc/spline/Spline.h"
@@ -19,6 +22,8 @@ namespace frc {
  */
 class TrajectoryConstraint {
  public:
+  using PoseWithCurvature = std::pair<Pose2d, units::curvature_t>;
+
   TrajectoryConstraint() = default;
 
   TrajectoryConstraint(const TrajectoryConstraint&) = default;
@@ -73,5 +78,35 @@ class TrajectoryConstraint {
   virtual MinMax MinMaxAcceleration(const Pose2d& pose,
                                     units::curvature_t curvature,
                                     units::meters_per_second_t speed) const = 0;
+
+  /**
+   * Computes the velocity limits at many points at once.
+   *
+   * This is for constraints whose max velocity at a point has a bound that
+   * doesn't depend on the velocity passed to MaxVelocity(): when the
+   * minimum of velocity and MaxVelocity(pose, curvature, velocity) is the
+   * minimum of velocity and that bound, for any velocity of at least zero.
+   * The trajectory parameterizer then computes the bounds once, rather than
+   * calling MaxVelocity() on every iteration.  The default returns false,
+   * so MaxVelocity() is used.
+   *
+   * @param points The points of the trajectory.
+   * @param limits Output; the velocity bound at each point.
+   *
+   * @return True if the limits were computed.
+   */
+  virtual bool MaxVelocities(
+      wpi::span<const PoseWithCurvature> points,
+      wpi::span<units::meters_per_second_t> limits) const {
+    return false;
+  }
+
+  /**
+   * Returns whether MinMaxAcceleration() may limit the acceleration.  The
+   * trajectory parameterizer skips constraints that return false.
+   *
+   * @return False if MinMaxAcceleration() always returns an unbounded MinMax.
+   */
+  virtual bool LimitsAcceleration() const { return true; }
 };
 }  // namespace frc
@@ -0,0 +1,78 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cmath>
+#include <vector>
+
+#include "frc/RandomStream.h"
+#include "frc/StateSpaceUtil.h"
+#include "gtest/gtest.h"
+
+TEST(RandomStreamTest, SeedIsReproducible) {
+  frc::RandomStream a{42};
+  frc::RandomStream b{42};
+  frc::RandomStream c{43};
+  bool differs = false;
+  for (int i = 0; i < 100; ++i) {
+    auto x = a();
+    EXPECT_EQ(x, b());
+    differs = differs || x != c();
+  }
+  EXPECT_TRUE(differs);
+
+  a.Seed(7);
+  b.Seed(7);
+  EXPECT_EQ(a.Gaussian(), b.Gaussian());
+}
+
+TEST(RandomStreamTest, Split) {
+  frc::RandomStream a{1};
+  frc::RandomStream b{1};
+  auto split = a.Split();
+  // the split stream starts where the parent was; the parent moves on
+  EXPECT_EQ(split(), b());
+  EXPECT_NE(a(), split());
+}
+
+TEST(RandomStreamTest, Uniform) {
+  frc::RandomStream gen{3};
+  for (int i = 0; i < 1000; ++i) {
+    double x = gen.Uniform();
+    EXPECT_GE(x, 0.0);
+    EXPECT_LT(x, 1.0);
+  }
+}
+
+TEST(RandomStreamTest, FillGaussian) {
+  frc::RandomStream gen{5};
+  // odd, so the last pair is split with the next call
+  std::vector<double> values(100001);
+  gen.FillGaussian(values.data(), values.size());
+
+  double mean = 0.0;
+  for (double x : values) {
+    mean += x;
+  }
+  mean /= values.size();
+  double variance = 0.0;
+  for (double x : values) {
+    variance += (x - mean) * (x - mean);
+  }
+  variance /= values.size();
+
+  EXPECT_NEAR(mean, 0.0, 0.02);
+  EXPECT_NEAR(variance, 1.0, 0.02);
+  EXPECT_TRUE(std::isfinite(gen.Gaussian()));
+}
+
+TEST(RandomStreamTest, WhiteNoiseVector) {
+  frc::RandomStream a{11};
+  frc::RandomStream b{11};
+  Eigen::Matrix<double, 3, 1> x =
+      frc::MakeWhiteNoiseVector<3>(a, {1.0, 0.0, 2.0});
+  Eigen::Matrix<double, 3, 1> y =
+      frc::MakeWhiteNoiseVector<3>(b, {1.0, 0.0, 2.0});
+  EXPECT_EQ(x, y);
+  EXPECT_EQ(x(1), 0.0);
+}
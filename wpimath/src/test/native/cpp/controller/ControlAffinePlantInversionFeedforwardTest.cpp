@@ -66,4 +66,52 @@ TEST(ControlAffinePlantInversionFeedforwardTest, CalculateState) {
   EXPECT_NEAR(48, feedforward.Calculate(r, nextR)(0, 0), 1e-6);
 }
 
+// B = [0, 1 + x0]^T
+Eigen::Matrix<double, 2, 1> StateDependentDynamics(
+    const Eigen::Matrix<double, 2, 1>& x,
+    const Eigen::Matrix<double, 1, 1>& u) {
+  return StateDynamics(x) + frc::MakeMatrix<2, 1>(0.0, 1.0 + x(0)) * u;
+}
+
+TEST(ControlAffinePlantInversionFeedforwardTest, CalculateRelinearized) {
+  frc::ControlAffinePlantInversionFeedforward<2, 1> feedforward{
+      StateDependentDynamics, units::second_t(0.02), 0.0};
+
+  Eigen::Matrix<double, 2, 1> r;
+  r << 2, 2;
+  Eigen::Matrix<double, 2, 1> nextR;
+  nextR << 3, 3;
+
+  EXPECT_NEAR(48 / 3.0, feedforward.Calculate(r, nextR)(0, 0), 1e-6);
+}
+
+TEST(ControlAffinePlantInversionFeedforwardTest, CalculateStateDependentB) {
+  int evaluations = 0;
+  frc::ControlAffinePlantInversionFeedforward<2, 1> feedforward{
+      StateDynamics,
+      [&](const Eigen::Matrix<double, 2, 1>& x) {
+        ++evaluations;
+        return frc::MakeMatrix<2, 1>(0.0, 1.0 + x(0));
+      },
+      units::second_t(0.02), 0.5};
+
+  Eigen::Matrix<double, 2, 1> r;
+  r << 2, 2;
+  Eigen::Matrix<double, 2, 1> nextR;
+  nextR << 3, 3;
+
+  EXPECT_NEAR(48 / 3.0, feedforward.Calculate(r, nextR)(0, 0), 1e-6);
+  EXPECT_EQ(1, evaluations);
+
+  // Within the tolerance, B (evaluated at x0 = 2) is reused
+  r << 2.1, 2;
+  EXPECT_NEAR(48 / 3.0, feedforward.Calculate(r, nextR)(0, 0), 1e-6);
+  EXPECT_EQ(1, evaluations);
+
+  // Beyond it, B is reevaluated
+  r << 2.6, 2;
+  EXPECT_NEAR(48 / 3.6, feedforward.Calculate(r, nextR)(0, 0), 1e-6);
+  EXPECT_EQ(2, evaluations);
+}
+
 }  // namespace frc
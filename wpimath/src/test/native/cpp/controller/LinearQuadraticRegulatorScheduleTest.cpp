@@ -0,0 +1,117 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Core"
+#include "frc/controller/LinearQuadraticRegulator.h"
+#include "frc/controller/LinearQuadraticRegulatorSchedule.h"
+#include "frc/system/LinearSystem.h"
+
+namespace frc {
+
+// An arm linearized about an angle from horizontal; gravity's restoring
+// torque changes with the angle.
+static std::pair<Eigen::Matrix<double, 2, 2>, Eigen::Matrix<double, 2, 1>>
+ArmPlant(double angle) {
+  Eigen::Matrix<double, 2, 2> A;
+  A << 0.0, 1.0, 20.0 * std::sin(angle), -8.0;
+  Eigen::Matrix<double, 2, 1> B;
+  B << 0.0, 12.0;
+  return {A, B};
+}
+
+static LinearSystem<2, 1, 1> ArmSystem(double angle) {
+  auto [A, B] = ArmPlant(angle);
+  Eigen::Matrix<double, 1, 2> C;
+  C << 1.0, 0.0;
+  return {A, B, C, Eigen::Matrix<double, 1, 1>::Zero()};
+}
+
+static void ExpectGain(const Eigen::Matrix<double, 1, 2>& expected,
+                       const Eigen::Matrix<double, 1, 2>& actual,
+                       double tolerance) {
+  EXPECT_NEAR(expected(0, 0), actual(0, 0), tolerance);
+  EXPECT_NEAR(expected(0, 1), actual(0, 1), tolerance);
+}
+
+TEST(LinearQuadraticRegulatorScheduleTest, GridGains) {
+  std::vector<double> angles{-1.5, -0.75, 0.0, 0.75, 1.5};
+  LinearQuadraticRegulatorSchedule<2, 1> schedule{
+      angles, ArmPlant, {0.02, 0.4}, {12.0}, 0.02_s};
+
+  for (double angle : angles) {
+    LinearQuadraticRegulator<2, 1> controller{
+        ArmSystem(angle), {0.02, 0.4}, {12.0}, 0.02_s};
+    ExpectGain(controller.K(), schedule.K(angle), 1e-6);
+  }
+
+  // between grid points
+  ExpectGain(0.5 * (schedule.K(0.0) + schedule.K(0.75)), schedule.K(0.375),
+             1e-9);
+
+  // clamped outside the grid
+  ExpectGain(schedule.K(1.5), schedule.K(3.0), 0.0);
+  ExpectGain(schedule.K(-1.5), schedule.K(-3.0), 0.0);
+
+  Eigen::Matrix<double, 2, 1> x;
+  x << 0.1, 0.0;
+  Eigen::Matrix<double, 2, 1> r;
+  r << 0.2, 0.0;
+  EXPECT_NEAR((schedule.K(0.1) * (r - x))(0),
+              schedule.Calculate(x, r, 0.1)(0), 1e-12);
+}
+
+TEST(LinearQuadraticRegulatorScheduleTest, Solve) {
+  LinearQuadraticRegulatorSchedule<2, 1> schedule{
+      {-1.5, 0.0, 1.5}, ArmPlant, {0.02, 0.4}, {12.0}, 0.02_s};
+
+  for (double angle : {0.3, 0.35, 1.2, -1.0}) {
+    auto [A, B] = ArmPlant(angle);
+    LinearQuadraticRegulator<2, 1> controller{
+        ArmSystem(angle), {0.02, 0.4}, {12.0}, 0.02_s};
+    ExpectGain(controller.K(), schedule.Solve(angle, A, B), 1e-6);
+  }
+}
+
+TEST(LinearQuadraticRegulatorScheduleTest, WarmStartFallback) {
+  auto [A, B] = ArmPlant(1.5);
+  Eigen::Matrix<double, 2, 2> discA;
+  Eigen::Matrix<double, 2, 1> discB;
+  DiscretizeAB<2, 1>(A, B, 0.02_s, &discA, &discB);
+  Eigen::Matrix<double, 2, 2> Q = MakeCostMatrix<2>({0.02, 0.4});
+  Eigen::Matrix<double, 1, 1> R = MakeCostMatrix<1>({12.0});
+
+  // a zero guess gives a zero gain, which doesn't stabilize the plant
+  Eigen::Matrix<double, 2, 2> S =
+      detail::DiscreteAlgebraicRiccatiEquationFrom<2, 1>(
+          discA, discB, Q, R, Eigen::Matrix<double, 2, 2>::Zero());
+  Eigen::Matrix<double, 2, 2> expected =
+      drake::math::DiscreteAlgebraicRiccatiEquation(discA, discB, Q, R);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      EXPECT_NEAR(expected(i, j), S(i, j), 1e-6 * expected.norm());
+    }
+  }
+}
+
+TEST(LinearQuadraticRegulatorScheduleTest, LatencyCompensate) {
+  LinearQuadraticRegulatorSchedule<2, 1> schedule{
+      {-1.5, 0.0, 1.5}, ArmPlant, {0.02, 0.4}, {12.0}, 0.02_s};
+  schedule.LatencyCompensate(0.01_s);
+
+  for (double angle : {-1.5, 0.0, 1.5}) {
+    auto plant = ArmSystem(angle);
+    LinearQuadraticRegulator<2, 1> controller{plant, {0.02, 0.4}, {12.0},
+                                              0.02_s};
+    controller.LatencyCompensate(plant, 0.02_s, 0.01_s);
+    ExpectGain(controller.K(), schedule.K(angle), 1e-6);
+  }
+}
+
+}  // namespace frc
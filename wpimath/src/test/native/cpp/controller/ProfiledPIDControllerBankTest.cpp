@@ -0,0 +1,115 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/controller/ProfiledPIDControllerBank.h"  // NOLINT(build/include_order)
+
+#include <array>
+
+#include <wpi/numbers>
+
+#include "frc/controller/ProfiledPIDController.h"
+#include "gtest/gtest.h"
+#include "units/acceleration.h"
+#include "units/angle.h"
+#include "units/angular_acceleration.h"
+#include "units/angular_velocity.h"
+#include "units/length.h"
+#include "units/velocity.h"
+
+using Controller = frc::ProfiledPIDController<units::meters>;
+using Bank = frc::ProfiledPIDControllerBank<units::meters>;
+
+static const Controller::Constraints kConstraints{1.75_mps, 0.75_mps_sq};
+
+TEST(ProfiledPIDControllerBankTest, MatchesControllers) {
+  std::array<Controller, 3> controllers{
+      Controller{1.3, 0.1, 0.05, kConstraints},
+      Controller{1.3, 0.1, 0.05, kConstraints},
+      Controller{1.3, 0.1, 0.05, kConstraints}};
+  Bank bank{3, 1.3, 0.1, 0.05, kConstraints};
+
+  std::array<units::meter_t, 3> positions{0_m, 1_m, -2_m};
+  std::array<units::meter_t, 3> goals{3_m, -1_m, -2.2_m};
+  for (size_t i = 0; i < 3; ++i) {
+    controllers[i].Reset(positions[i]);
+    bank.Reset(i, positions[i]);
+  }
+
+  std::array<double, 3> outputs;
+  for (int step = 0; step < 400; ++step) {
+    if (step == 200) {
+      goals[1] = 0.5_m;
+    }
+    for (size_t i = 0; i < 3; ++i) {
+      bank.SetGoal(i, goals[i]);
+    }
+    bank.Calculate(positions, outputs);
+    for (size_t i = 0; i < 3; ++i) {
+      double expected = controllers[i].Calculate(positions[i], goals[i]);
+      EXPECT_NEAR(outputs[i], expected, 1e-9);
+      EXPECT_NEAR(bank.GetSetpoint(i).position.value(),
+                  controllers[i].GetSetpoint().position.value(), 1e-9);
+      // a crude plant that lags the setpoint
+      positions[i] += (bank.GetSetpoint(i).position - positions[i]) * 0.5;
+    }
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(bank.GetSetpoint(i), bank.GetGoal(i));
+  }
+}
+
+TEST(ProfiledPIDControllerBankTest, ContinuousInput) {
+  using AngleController = frc::ProfiledPIDController<units::radians>;
+  AngleController::Constraints constraints{6.28_rad_per_s, 3.14_rad_per_s_sq};
+  AngleController controller{1.0, 0.0, 0.0, constraints};
+  frc::ProfiledPIDControllerBank<units::radians> bank{1, 1.0, 0.0, 0.0,
+                                                      constraints};
+  controller.EnableContinuousInput(-units::radian_t{wpi::numbers::pi},
+                                   units::radian_t{wpi::numbers::pi});
+  bank.EnableContinuousInput(0, -units::radian_t{wpi::numbers::pi},
+                             units::radian_t{wpi::numbers::pi});
+
+  // the short way to the goal is across the wrap
+  std::array<units::radian_t, 1> angle{3_rad};
+  controller.Reset(angle[0]);
+  bank.Reset(0, angle[0]);
+  bank.SetGoal(0, -3_rad);
+  std::array<double, 1> output;
+  for (int step = 0; step < 100; ++step) {
+    bank.Calculate(angle, output);
+    EXPECT_NEAR(output[0], controller.Calculate(angle[0], -3_rad), 1e-9);
+    angle[0] = frc::AngleModulus(bank.GetSetpoint(0).position);
+  }
+  EXPECT_NEAR(angle[0].value(), -3, 1e-9);
+}
+
+TEST(ProfiledPIDControllerBankTest, TimeLeft) {
+  Bank bank{1, 1.0, 0.0, 0.0, kConstraints};
+  Controller controller{1.0, 0.0, 0.0, kConstraints};
+  bank.Reset(0, 0_m);
+  controller.Reset(0_m);
+  bank.SetGoal(0, 3_m);
+  controller.SetGoal(3_m);
+
+  frc::TrapezoidProfile<units::meters> profile{kConstraints, {3_m, 0_mps}};
+  std::array<units::meter_t, 1> measurement{0_m};
+  std::array<double, 1> output;
+  bank.Calculate(measurement, output);
+  controller.Calculate(0_m);
+  EXPECT_DOUBLE_EQ(bank.TotalTime(0).value(), profile.TotalTime().value());
+  EXPECT_DOUBLE_EQ(controller.TotalTime().value(),
+                   profile.TotalTime().value());
+
+  auto timeLeft = bank.TimeLeftUntil(0, 3_m);
+  EXPECT_NEAR(timeLeft.value(), (profile.TotalTime() - 20_ms).value(), 1e-6);
+  EXPECT_NEAR(controller.TimeLeftUntil(3_m).value(), timeLeft.value(), 1e-6);
+
+  // the profile is kept, so the time left counts down
+  for (int i = 0; i < 10; ++i) {
+    bank.Calculate(measurement, output);
+  }
+  EXPECT_DOUBLE_EQ(bank.TotalTime(0).value(), profile.TotalTime().value());
+  EXPECT_NEAR(bank.TimeLeftUntil(0, 3_m).value(),
+              (timeLeft - 200_ms).value(), 1e-6);
+}
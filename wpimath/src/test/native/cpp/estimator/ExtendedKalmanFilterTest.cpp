@@ -11,6 +11,7 @@
 #include "Eigen/QR"
 #include "frc/StateSpaceUtil.h"
 #include "frc/estimator/ExtendedKalmanFilter.h"
+#include "frc/system/AutoDiffJacobian.h"
 #include "frc/system/NumericalJacobian.h"
 #include "frc/system/plant/DCMotor.h"
 #include "frc/trajectory/TrajectoryGenerator.h"
@@ -18,8 +19,13 @@
 
 namespace {
 
-Eigen::Matrix<double, 5, 1> Dynamics(const Eigen::Matrix<double, 5, 1>& x,
-                                     const Eigen::Matrix<double, 2, 1>& u) {
+// Written for any scalar type, so it can be automatically differentiated
+template <typename T>
+Eigen::Matrix<T, 5, 1> GenericDynamics(const Eigen::Matrix<T, 5, 1>& x,
+                                       const Eigen::Matrix<T, 2, 1>& u) {
+  using std::cos;
+  using std::sin;
+
   auto motors = frc::DCMotor::CIM(2);
 
   // constexpr double Glow = 15.32;       // Low gear ratio
@@ -35,34 +41,43 @@ Eigen::Matrix<double, 5, 1> Dynamics(const Eigen::Matrix<double, 5, 1>& x,
   auto k1 = (1 / m + units::math::pow<2>(rb) / J);
   auto k2 = (1 / m - units::math::pow<2>(rb) / J);
 
-  units::meters_per_second_t vl{x(3)};
-  units::meters_per_second_t vr{x(4)};
-  units::volt_t Vl{u(0)};
-  units::volt_t Vr{u(1)};
-
-  Eigen::Matrix<double, 5, 1> result;
-  auto v = 0.5 * (vl + vr);
-  result(0) = v.to<double>() * std::cos(x(2));
-  result(1) = v.to<double>() * std::sin(x(2));
-  result(2) = ((vr - vl) / (2.0 * rb)).to<double>();
-  result(3) =
-      k1.to<double>() * ((C1 * vl).to<double>() + (C2 * Vl).to<double>()) +
-      k2.to<double>() * ((C1 * vr).to<double>() + (C2 * Vr).to<double>());
-  result(4) =
-      k2.to<double>() * ((C1 * vl).to<double>() + (C2 * Vl).to<double>()) +
-      k1.to<double>() * ((C1 * vr).to<double>() + (C2 * Vr).to<double>());
+  T vl = x(3);
+  T vr = x(4);
+  T Vl = u(0);
+  T Vr = u(1);
+
+  Eigen::Matrix<T, 5, 1> result;
+  T v = 0.5 * (vl + vr);
+  result(0) = v * cos(x(2));
+  result(1) = v * sin(x(2));
+  result(2) = (vr - vl) / (2.0 * rb.to<double>());
+  result(3) = k1.to<double>() * (C1.to<double>() * vl + C2.to<double>() * Vl) +
+              k2.to<double>() * (C1.to<double>() * vr + C2.to<double>() * Vr);
+  result(4) = k2.to<double>() * (C1.to<double>() * vl + C2.to<double>() * Vl) +
+              k1.to<double>() * (C1.to<double>() * vr + C2.to<double>() * Vr);
   return result;
 }
 
-Eigen::Matrix<double, 3, 1> LocalMeasurementModel(
-    const Eigen::Matrix<double, 5, 1>& x,
-    const Eigen::Matrix<double, 2, 1>& u) {
+Eigen::Matrix<double, 5, 1> Dynamics(const Eigen::Matrix<double, 5, 1>& x,
+                                     const Eigen::Matrix<double, 2, 1>& u) {
+  return GenericDynamics<double>(x, u);
+}
+
+template <typename T>
+Eigen::Matrix<T, 3, 1> GenericLocalMeasurementModel(
+    const Eigen::Matrix<T, 5, 1>& x, const Eigen::Matrix<T, 2, 1>& u) {
   static_cast<void>(u);
-  Eigen::Matrix<double, 3, 1> y;
+  Eigen::Matrix<T, 3, 1> y;
   y << x(2), x(3), x(4);
   return y;
 }
 
+Eigen::Matrix<double, 3, 1> LocalMeasurementModel(
+    const Eigen::Matrix<double, 5, 1>& x,
+    const Eigen::Matrix<double, 2, 1>& u) {
+  return GenericLocalMeasurementModel<double>(x, u);
+}
+
 Eigen::Matrix<double, 5, 1> GlobalMeasurementModel(
     const Eigen::Matrix<double, 5, 1>& x,
     const Eigen::Matrix<double, 2, 1>& u) {
@@ -167,3 +182,53 @@ TEST(ExtendedKalmanFilterTest, Convergence) {
   ASSERT_NEAR(0.0, observer.Xhat(3), 1.0);
   ASSERT_NEAR(0.0, observer.Xhat(4), 1.0);
 }
+
+TEST(ExtendedKalmanFilterTest, AutoDiffJacobians) {
+  constexpr auto dt = 0.00505_s;
+
+  frc::ExtendedKalmanFilter<5, 2, 3> observer{Dynamics,
+                                              LocalMeasurementModel,
+                                              {0.5, 0.5, 10.0, 1.0, 1.0},
+                                              {0.0001, 0.01, 0.01},
+                                              dt};
+  frc::ExtendedKalmanFilter<5, 2, 3> autoDiffObserver{
+      Dynamics,
+      LocalMeasurementModel,
+      {0.5, 0.5, 10.0, 1.0, 1.0},
+      {0.0001, 0.01, 0.01},
+      dt};
+  autoDiffObserver.SetJacobians(
+      [](const auto& x, const auto& u) {
+        return frc::AutoDiffJacobianX<5, 5, 2>(
+            [](const auto& x, const auto& u) { return GenericDynamics(x, u); },
+            x, u);
+      },
+      [](const auto& x, const auto& u) {
+        return frc::AutoDiffJacobianX<3, 5, 2>(
+            [](const auto& x, const auto& u) {
+              return GenericLocalMeasurementModel(x, u);
+            },
+            x, u);
+      });
+
+  Eigen::Matrix<double, 2, 1> u;
+  u << 12.0, 11.0;
+  for (int i = 0; i < 20; ++i) {
+    observer.Predict(u, dt);
+    autoDiffObserver.Predict(u, dt);
+
+    Eigen::Matrix<double, 3, 1> localY =
+        LocalMeasurementModel(observer.Xhat(), u) +
+        frc::MakeWhiteNoiseVector(0.0001, 0.01, 0.01);
+    observer.Correct(u, localY);
+    autoDiffObserver.Correct(u, localY);
+  }
+
+  // numerical differentiation is only accurate to about 1e-10
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_NEAR(observer.Xhat(i), autoDiffObserver.Xhat(i), 1e-6);
+    for (int j = 0; j < 5; ++j) {
+      EXPECT_NEAR(observer.P(i, j), autoDiffObserver.P(i, j), 1e-6);
+    }
+  }
+}
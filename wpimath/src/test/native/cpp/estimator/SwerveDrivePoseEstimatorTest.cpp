@@ -12,7 +12,8 @@
 #include "frc/trajectory/TrajectoryGenerator.h"
 #include "gtest/gtest.h"
 
-TEST(SwerveDrivePoseEstimatorTest, TestAccuracy) {
+// With batched, each vision update is three cameras' measurements at once.
+static void TestAccuracy(frc::LatencyReplayMode mode, bool batched = false) {
   frc::SwerveDriveKinematics<4> kinematics{
       frc::Translation2d{1_m, 1_m}, frc::Translation2d{1_m, -1_m},
       frc::Translation2d{-1_m, -1_m}, frc::Translation2d{-1_m, 1_m}};
@@ -20,6 +21,7 @@ TEST(SwerveDrivePoseEstimatorTest, TestAccuracy) {
   frc::SwerveDrivePoseEstimator<4> estimator{
       frc::Rotation2d(), frc::Pose2d(), kinematics,
       {0.1, 0.1, 0.1},   {0.05},        {0.1, 0.1, 0.1}};
+  estimator.SetLatencyReplayMode(mode);
 
   frc::SwerveDriveOdometry<4> odometry{kinematics, frc::Rotation2d()};
 
@@ -42,6 +44,7 @@ TEST(SwerveDrivePoseEstimatorTest, TestAccuracy) {
   units::second_t lastVisionUpdateTime{-std::numeric_limits<double>::max()};
 
   std::vector<frc::Pose2d> visionPoses;
+  std::vector<frc::VisionMeasurement> visionMeasurements;
 
   double maxError = -std::numeric_limits<double>::max();
   double errorSum = 0;
@@ -50,7 +53,22 @@ TEST(SwerveDrivePoseEstimatorTest, TestAccuracy) {
     frc::Trajectory::State groundTruthState = trajectory.Sample(t);
 
     if (lastVisionUpdateTime + kVisionUpdateRate < t) {
-      if (lastVisionPose != frc::Pose2d()) {
+      if (batched) {
+        estimator.AddVisionMeasurements(visionMeasurements);
+        visionMeasurements.clear();
+        // newest first, the last with its own standard deviations
+        for (int i = 0; i < 3; ++i) {
+          auto time = t - i * dt;
+          visionMeasurements.push_back(
+              {trajectory.Sample(time).pose +
+                   frc::Transform2d(
+                       frc::Translation2d(distribution(generator) * 0.1_m,
+                                          distribution(generator) * 0.1_m),
+                       frc::Rotation2d(distribution(generator) * 0.1 * 1_rad)),
+               time});
+        }
+        visionMeasurements.back().stdDevs = {0.2, 0.2, 0.2};
+      } else if (lastVisionPose != frc::Pose2d()) {
         estimator.AddVisionMeasurement(lastVisionPose, lastVisionUpdateTime);
       }
       lastVisionPose =
@@ -88,3 +106,47 @@ TEST(SwerveDrivePoseEstimatorTest, TestAccuracy) {
             0.2);
   EXPECT_LT(maxError, 0.4);
 }
+
+TEST(SwerveDrivePoseEstimatorTest, TestAccuracy) {
+  TestAccuracy(frc::LatencyReplayMode::kFilter);
+}
+
+TEST(SwerveDrivePoseEstimatorTest, TestAccuracyReplayDeltas) {
+  TestAccuracy(frc::LatencyReplayMode::kDeltas);
+}
+
+TEST(SwerveDrivePoseEstimatorTest, TestAccuracyBatched) {
+  TestAccuracy(frc::LatencyReplayMode::kFilter, true);
+}
+
+TEST(SwerveDrivePoseEstimatorTest, TestAccuracyBatchedReplayDeltas) {
+  TestAccuracy(frc::LatencyReplayMode::kDeltas, true);
+}
+
+TEST(SwerveDrivePoseEstimatorTest, BatchOfOne) {
+  frc::SwerveDriveKinematics<2> kinematics{frc::Translation2d{1_m, 1_m},
+                                           frc::Translation2d{-1_m, -1_m}};
+  for (auto mode :
+       {frc::LatencyReplayMode::kFilter, frc::LatencyReplayMode::kDeltas}) {
+    frc::SwerveDrivePoseEstimator<2> single{
+        frc::Rotation2d(), frc::Pose2d(), kinematics,
+        {0.1, 0.1, 0.1},   {0.05},        {0.1, 0.1, 0.1}};
+    frc::SwerveDrivePoseEstimator<2> batch{
+        frc::Rotation2d(), frc::Pose2d(), kinematics,
+        {0.1, 0.1, 0.1},   {0.05},        {0.1, 0.1, 0.1}};
+    single.SetLatencyReplayMode(mode);
+    batch.SetLatencyReplayMode(mode);
+
+    frc::SwerveModuleState state{1_mps, frc::Rotation2d()};
+    for (int i = 0; i < 20; ++i) {
+      single.UpdateWithTime(i * 20_ms, frc::Rotation2d(), state, state);
+      batch.UpdateWithTime(i * 20_ms, frc::Rotation2d(), state, state);
+    }
+    frc::Pose2d visionPose{0.3_m, 0.1_m, frc::Rotation2d(5_deg)};
+    single.AddVisionMeasurement(visionPose, 200_ms);
+    frc::VisionMeasurement measurement{visionPose, 200_ms};
+    batch.AddVisionMeasurements(wpi::span{&measurement, 1});
+
+    EXPECT_EQ(single.GetEstimatedPosition(), batch.GetEstimatedPosition());
+  }
+}
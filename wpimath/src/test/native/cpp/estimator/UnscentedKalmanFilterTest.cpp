@@ -11,6 +11,7 @@
 #include "Eigen/QR"
 #include "frc/StateSpaceUtil.h"
 #include "frc/estimator/AngleStatistics.h"
+#include "frc/estimator/InlineUnscentedKalmanFilter.h"
 #include "frc/estimator/UnscentedKalmanFilter.h"
 #include "frc/system/NumericalIntegration.h"
 #include "frc/system/NumericalJacobian.h"
@@ -73,6 +74,18 @@ Eigen::Matrix<double, 5, 1> GlobalMeasurementModel(
   y << x(0), x(1), x(2), x(3), x(4);
   return y;
 }
+
+struct Model : frc::UnscentedKalmanFilterModel<5, 2, 3> {
+  static Eigen::Matrix<double, 5, 1> F(const Eigen::Matrix<double, 5, 1>& x,
+                                       const Eigen::Matrix<double, 2, 1>& u) {
+    return Dynamics(x, u);
+  }
+
+  static Eigen::Matrix<double, 3, 1> H(const Eigen::Matrix<double, 5, 1>& x,
+                                       const Eigen::Matrix<double, 2, 1>& u) {
+    return LocalMeasurementModel(x, u);
+  }
+};
 }  // namespace
 
 TEST(UnscentedKalmanFilterTest, Init) {
@@ -178,3 +191,95 @@ TEST(UnscentedKalmanFilterTest, Convergence) {
   ASSERT_NEAR(0.0, observer.Xhat(3), 1.0);
   ASSERT_NEAR(0.0, observer.Xhat(4), 1.0);
 }
+
+TEST(UnscentedKalmanFilterTest, InlineMatches) {
+  constexpr auto dt = 0.00505_s;
+
+  frc::UnscentedKalmanFilter<5, 2, 3> observer{Dynamics,
+                                               LocalMeasurementModel,
+                                               {0.5, 0.5, 10.0, 1.0, 1.0},
+                                               {0.0001, 0.01, 0.01},
+                                               dt};
+  frc::InlineUnscentedKalmanFilter<5, 2, 3, Model> inlineObserver{
+      Model{}, {0.5, 0.5, 10.0, 1.0, 1.0}, {0.0001, 0.01, 0.01}, dt};
+
+  Eigen::Matrix<double, 2, 1> u;
+  u << 12.0, 11.0;
+  auto R = frc::MakeCovMatrix(0.01, 0.01, 0.0001, 0.01, 0.01);
+  for (int i = 0; i < 20; ++i) {
+    observer.Predict(u, dt);
+    inlineObserver.Predict(u, dt);
+
+    Eigen::Matrix<double, 3, 1> localY =
+        LocalMeasurementModel(observer.Xhat(), u) +
+        frc::MakeWhiteNoiseVector(0.0001, 0.01, 0.01);
+    observer.Correct(u, localY);
+    inlineObserver.Correct(u, localY);
+
+    Eigen::Matrix<double, 5, 1> globalY =
+        GlobalMeasurementModel(observer.Xhat(), u) +
+        frc::MakeWhiteNoiseVector(0.01, 0.01, 0.0001, 0.01, 0.01);
+    observer.Correct<5>(u, globalY, GlobalMeasurementModel, R,
+                        frc::AngleMean<5, 5>(2), frc::AngleResidual<5>(2),
+                        frc::AngleResidual<5>(2), frc::AngleAdd<5>(2));
+    inlineObserver.Correct<5>(
+        u, globalY, GlobalMeasurementModel, R,
+        [](const auto& sigmas, const auto& Wc) {
+          return frc::AngleMean<5, 5>(sigmas, Wc, 2);
+        },
+        [](const auto& a, const auto& b) {
+          return frc::AngleResidual<5>(a, b, 2);
+        },
+        [](const auto& a, const auto& b) {
+          return frc::AngleResidual<5>(a, b, 2);
+        },
+        [](const auto& a, const auto& b) { return frc::AngleAdd<5>(a, b, 2); });
+  }
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_NEAR(observer.Xhat(i), inlineObserver.Xhat(i), 1e-9);
+    for (int j = 0; j < 5; ++j) {
+      EXPECT_NEAR(observer.P(i, j), inlineObserver.P(i, j), 1e-9);
+    }
+  }
+}
+
+TEST(UnscentedKalmanFilterTest, ParallelPredict) {
+  constexpr auto dt = 0.00505_s;
+
+  frc::UnscentedKalmanFilter<5, 2, 3> observer{Dynamics,
+                                               LocalMeasurementModel,
+                                               {0.5, 0.5, 10.0, 1.0, 1.0},
+                                               {0.0001, 0.01, 0.01},
+                                               dt};
+  frc::UnscentedKalmanFilter<5, 2, 3> parallelObserver{
+      Dynamics,
+      LocalMeasurementModel,
+      {0.5, 0.5, 10.0, 1.0, 1.0},
+      {0.0001, 0.01, 0.01},
+      dt};
+  wpi::ThreadPool::Options options;
+  options.numThreads = 4;
+  wpi::ThreadPool pool{options};
+  parallelObserver.SetThreadPool(&pool, 1);
+
+  Eigen::Matrix<double, 2, 1> u;
+  u << 12.0, 11.0;
+  for (int i = 0; i < 20; ++i) {
+    observer.Predict(u, dt);
+    parallelObserver.Predict(u, dt);
+
+    Eigen::Matrix<double, 3, 1> localY =
+        LocalMeasurementModel(observer.Xhat(), u) +
+        frc::MakeWhiteNoiseVector(0.0001, 0.01, 0.01);
+    observer.Correct(u, localY);
+    parallelObserver.Correct(u, localY);
+  }
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_NEAR(observer.Xhat(i), parallelObserver.Xhat(i), 1e-9);
+    for (int j = 0; j < 5; ++j) {
+      EXPECT_NEAR(observer.P(i, j), parallelObserver.P(i, j), 1e-9);
+    }
+  }
+}
@@ -0,0 +1,35 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/filter/CICDecimator.h"  // NOLINT(build/include_order)
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// Tests that one stage averages each block of samples
+TEST(CICDecimatorTest, SingleStageAveragesBlocks) {
+  frc::CICDecimator filter{1, 4};
+
+  std::vector<int32_t> input{1, 2, 3, 4, 10, 20, 30, 40, -8};
+  auto output = filter.Calculate(input);
+  ASSERT_EQ(output.size(), 2u);
+  EXPECT_DOUBLE_EQ(output[0], 2.5);
+  EXPECT_DOUBLE_EQ(output[1], 25.0);
+}
+
+// Tests that a constant input settles to the same constant output, even
+// once the integrators have wrapped around
+TEST(CICDecimatorTest, ConstantInput) {
+  frc::CICDecimator filter{3, 50};
+
+  std::vector<int32_t> input(5000, 4095);
+  for (int i = 0; i < 2000; ++i) {
+    filter.Calculate(input);
+  }
+
+  for (double output : filter.Calculate(input)) {
+    EXPECT_DOUBLE_EQ(output, 4095.0);
+  }
+}
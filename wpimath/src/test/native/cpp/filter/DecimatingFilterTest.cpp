@@ -0,0 +1,69 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/filter/DecimatingFilter.h"  // NOLINT(build/include_order)
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "frc/filter/LinearFilter.h"
+#include "gtest/gtest.h"
+#include "units/time.h"
+
+namespace {
+// Tests that a decimating filter returns every factor-th output of the same
+// LinearFilter, with the samples split across calls unevenly
+void ExpectMatches(frc::DecimatingFilter decimating,
+                   frc::LinearFilter<double> filter, int factor) {
+  std::vector<double> input;
+  for (int i = 0; i < 997; ++i) {
+    input.push_back(100.0 * std::sin(0.01 * i) + 20.0 * std::cos(1.3 * i));
+  }
+
+  std::vector<double> expected;
+  for (size_t i = 0; i < input.size(); ++i) {
+    double output = filter.Calculate(input[i]);
+    if ((i + 1) % factor == 0) {
+      expected.push_back(output);
+    }
+  }
+
+  std::vector<double> actual;
+  for (size_t begin = 0; begin < input.size(); begin += 37) {
+    auto count = std::min<size_t>(37, input.size() - begin);
+    for (double output :
+         decimating.Calculate(wpi::span{input}.subspan(begin, count))) {
+      actual.push_back(output);
+    }
+  }
+
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], 1e-9);
+  }
+}
+}  // namespace
+
+TEST(DecimatingFilterTest, MovingAverage) {
+  ExpectMatches(frc::DecimatingFilter::MovingAverage(10, 10),
+                frc::LinearFilter<double>::MovingAverage(10), 10);
+}
+
+TEST(DecimatingFilterTest, SinglePoleIIR) {
+  ExpectMatches(frc::DecimatingFilter::SinglePoleIIR(0.015915, 1_ms, 20),
+                frc::LinearFilter<double>::SinglePoleIIR(0.015915, 1_ms), 20);
+}
+
+TEST(DecimatingFilterTest, Reset) {
+  auto filter = frc::DecimatingFilter::MovingAverage(2, 2);
+
+  std::vector<double> input{1.0, 3.0, 5.0};
+  EXPECT_EQ(filter.Calculate(input).size(), 1u);
+  filter.Reset();
+
+  auto output = filter.Calculate(input);
+  ASSERT_EQ(output.size(), 1u);
+  EXPECT_DOUBLE_EQ(output[0], 2.0);
+}
@@ -0,0 +1,52 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/filter/LinearFilterBank.h"  // NOLINT(build/include_order)
+
+#include <cmath>
+#include <vector>
+
+#include "frc/filter/LinearFilter.h"
+#include "gtest/gtest.h"
+#include "units/time.h"
+
+// Tests that each channel of a bank matches a LinearFilter with the same gains
+TEST(LinearFilterBankTest, MatchesLinearFilter) {
+  constexpr int kChannels = 8;
+
+  auto bank = frc::LinearFilterBank(kChannels, {0.5, 0.25, 0.125}, {-0.3, 0.1});
+  std::vector<frc::LinearFilter<double>> filters(
+      kChannels, frc::LinearFilter<double>({0.5, 0.25, 0.125}, {-0.3, 0.1}));
+
+  Eigen::VectorXd input{kChannels};
+  for (int step = 0; step < 100; ++step) {
+    for (int i = 0; i < kChannels; ++i) {
+      input(i) = std::sin(0.1 * step + i) * (i + 1);
+    }
+
+    const Eigen::VectorXd& output = bank.Calculate(input);
+    for (int i = 0; i < kChannels; ++i) {
+      EXPECT_NEAR(filters[i].Calculate(input(i)), output(i), 1e-12);
+    }
+  }
+}
+
+TEST(LinearFilterBankTest, MovingAverage) {
+  auto bank = frc::LinearFilterBank::MovingAverage(2, 4);
+
+  Eigen::VectorXd input{2};
+  for (int step = 0; step < 4; ++step) {
+    input << step, -2.0 * step;
+    bank.Calculate(input);
+  }
+  input << 4.0, -8.0;
+
+  const Eigen::VectorXd& output = bank.Calculate(input);
+  EXPECT_DOUBLE_EQ(output(0), 2.5);
+  EXPECT_DOUBLE_EQ(output(1), -5.0);
+
+  bank.Reset();
+  input << 4.0, -8.0;
+  EXPECT_DOUBLE_EQ(bank.Calculate(input)(0), 1.0);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <random>
+#include <vector>
+
+#include "frc/filter/MedianFilter.h"
+#include "frc/filter/MedianFilterBank.h"
+#include "gtest/gtest.h"
+
+// Tests that each channel of a bank matches a MedianFilter, with repeated
+// values and while the windows fill
+TEST(MedianFilterBankTest, MatchesMedianFilter) {
+  constexpr int kChannels = 4;
+
+  for (size_t size : {1, 2, 5, 6}) {
+    frc::MedianFilterBank bank{kChannels, size};
+    std::vector<frc::MedianFilter<double>> filters(
+        kChannels, frc::MedianFilter<double>{size});
+
+    std::mt19937 gen{size};
+    std::uniform_int_distribution<int> distr{-5, 5};
+
+    Eigen::VectorXd input{kChannels};
+    for (int step = 0; step < 50; ++step) {
+      for (int i = 0; i < kChannels; ++i) {
+        input(i) = distr(gen);
+      }
+
+      const Eigen::VectorXd& output = bank.Calculate(input);
+      for (int i = 0; i < kChannels; ++i) {
+        EXPECT_EQ(filters[i].Calculate(input(i)), output(i));
+      }
+    }
+  }
+}
+
+TEST(MedianFilterBankTest, Reset) {
+  frc::MedianFilterBank bank{1, 3};
+
+  for (double value : {3.0, 0.0, 4.0}) {
+    bank.Calculate(Eigen::VectorXd::Constant(1, value));
+  }
+  bank.Reset();
+
+  EXPECT_EQ(bank.Calculate(Eigen::VectorXd::Constant(1, 1000.0))(0), 1000.0);
+}
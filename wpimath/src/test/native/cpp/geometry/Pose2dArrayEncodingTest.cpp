@@ -0,0 +1,96 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <string>
+#include <vector>
+
+#include <wpi/Endian.h>
+#include <wpi/MathExtras.h>
+
+#include "frc/geometry/Pose2dArrayEncoding.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+static std::vector<Pose2d> RoundTrip(const std::vector<Pose2d>& poses,
+                                     std::string* data) {
+  EncodePose2dArray(poses, data);
+  auto size = GetEncodedPose2dArraySize(*data);
+  EXPECT_TRUE(size);
+  std::vector<Pose2d> decoded(size.value_or(0));
+  EXPECT_TRUE(DecodePose2dArray(*data, decoded));
+  return decoded;
+}
+
+TEST(Pose2dArrayEncodingTest, Empty) {
+  std::string data;
+  EXPECT_TRUE(RoundTrip({}, &data).empty());
+  EXPECT_EQ(data.size(), 8u);
+}
+
+TEST(Pose2dArrayEncodingTest, Path) {
+  std::vector<Pose2d> poses;
+  for (int i = 0; i < 1000; ++i) {
+    poses.emplace_back(units::meter_t{1 + 0.0123 * i},
+                       units::meter_t{2 + 0.01 * std::sin(i * 0.1)},
+                       Rotation2d{units::degree_t{0.37 * i - 180}});
+  }
+  std::string data;
+  auto decoded = RoundTrip(poses, &data);
+  // all but the first pose are deltas
+  EXPECT_EQ(data.size(), 8u + 12u + 999u * 6u);
+  ASSERT_EQ(decoded.size(), poses.size());
+  for (size_t i = 0; i < poses.size(); ++i) {
+    // rounding errors don't accumulate
+    EXPECT_NEAR(decoded[i].X().to<double>(), poses[i].X().to<double>(),
+                0.0006);
+    EXPECT_NEAR(decoded[i].Y().to<double>(), poses[i].Y().to<double>(),
+                0.0006);
+    EXPECT_NEAR((decoded[i].Rotation() - poses[i].Rotation())
+                    .Degrees()
+                    .to<double>(),
+                0, 0.006);
+  }
+}
+
+TEST(Pose2dArrayEncodingTest, Jump) {
+  std::vector<Pose2d> poses{{1_m, 1_m, 0_deg}, {50_m, 1_m, 0_deg},
+                            {50.001_m, 1_m, 179_deg}, {50_m, 1_m, -179_deg}};
+  std::string data;
+  auto decoded = RoundTrip(poses, &data);
+  // the jump and the wrap each take an escape and a full pose
+  EXPECT_EQ(data.size(), 8u + 12u + 14u + 6u + 14u);
+  ASSERT_EQ(decoded.size(), 4u);
+  EXPECT_NEAR(decoded[1].X().to<double>(), 50, 1e-5);
+  EXPECT_NEAR(decoded[2].X().to<double>(), 50.001, 1e-5);
+  EXPECT_NEAR(decoded[3].Rotation().Degrees().to<double>(), -179, 1e-4);
+}
+
+TEST(Pose2dArrayEncodingTest, OlderEncoding) {
+  std::string data(48, '\0');
+  double values[] = {1, 2, 90, 3, 4, -90};
+  for (int i = 0; i < 6; ++i) {
+    wpi::support::endian::write64be(&data[i * 8], wpi::DoubleToBits(values[i]));
+  }
+  ASSERT_EQ(GetEncodedPose2dArraySize(data), 2u);
+  std::vector<Pose2d> decoded(2);
+  ASSERT_TRUE(DecodePose2dArray(data, decoded));
+  EXPECT_EQ(decoded[1].X().to<double>(), 3);
+  EXPECT_NEAR(decoded[1].Rotation().Degrees().to<double>(), -90, 1e-9);
+}
+
+TEST(Pose2dArrayEncodingTest, Invalid) {
+  EXPECT_FALSE(GetEncodedPose2dArraySize("abc"));
+
+  std::vector<Pose2d> poses(10);
+  std::string data;
+  EncodePose2dArray(poses, &data);
+  std::vector<Pose2d> decoded(10);
+  EXPECT_FALSE(DecodePose2dArray(data.substr(0, data.size() - 1), decoded));
+  decoded.resize(9);
+  EXPECT_FALSE(DecodePose2dArray(data, decoded));
+  // a count the data is too short for
+  data[4] = 100;
+  EXPECT_FALSE(GetEncodedPose2dArraySize(data));
+}
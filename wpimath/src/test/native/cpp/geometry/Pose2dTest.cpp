@@ -3,6 +3,7 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <cmath>
+#include <vector>
 
 #include "frc/geometry/Pose2d.h"
 #include "gtest/gtest.h"
@@ -57,3 +58,31 @@ TEST(Pose2dTest, Minus) {
   EXPECT_NEAR(transform.Y().to<double>(), 0.0, kEpsilon);
   EXPECT_NEAR(transform.Rotation().Degrees().to<double>(), 0.0, kEpsilon);
 }
+
+TEST(Pose2dTest, Constexpr) {
+  constexpr Pose2d pose{1_m, 2_m, Rotation2d{}};
+  constexpr Transform2d transform{Translation2d{5_m, units::meter_t{-1}},
+                                  Rotation2d{}};
+  constexpr Pose2d transformed = pose + transform;
+  static_assert(transformed.X() == 6_m && transformed.Y() == 1_m);
+  static_assert((transformed - pose).X() == 5_m);
+  static_assert((pose + transform.Inverse()).X() == units::meter_t{-4});
+}
+
+TEST(Pose2dTest, Batch) {
+  const std::vector<Pose2d> poses{Pose2d{0_m, 0_m, Rotation2d(0_deg)},
+                                  Pose2d{1_m, 2_m, Rotation2d(45_deg)},
+                                  Pose2d{-3_m, 4_m, Rotation2d(-120_deg)}};
+  const Transform2d transform{Translation2d{1_m, -1_m}, Rotation2d(30_deg)};
+  const Pose2d origin{2_m, 1_m, Rotation2d(60_deg)};
+
+  std::vector<Pose2d> transformed(poses.size());
+  Pose2d::TransformBy(poses, transform, transformed);
+  std::vector<Pose2d> relative = poses;
+  Pose2d::RelativeTo(relative, origin, relative);
+
+  for (size_t i = 0; i < poses.size(); ++i) {
+    EXPECT_EQ(transformed[i], poses[i].TransformBy(transform));
+    EXPECT_EQ(relative[i], poses[i].RelativeTo(origin));
+  }
+}
@@ -66,3 +66,21 @@ TEST(Rotation2dTest, Inequality) {
   const auto rot2 = Rotation2d(43.5_deg);
   EXPECT_NE(rot1, rot2);
 }
+
+TEST(Rotation2dTest, ComposedAngle) {
+  // The angle is computed when asked for
+  const auto rot = Rotation2d(1.0, 0.0).RotateBy(-Rotation2d(0.0, 1.0));
+  EXPECT_NEAR(rot.Degrees().to<double>(), -90.0, kEpsilon);
+
+  // An angle given on construction is kept as is
+  EXPECT_DOUBLE_EQ((-Rotation2d(400_deg)).Degrees().to<double>(), -400.0);
+
+  // Many compositions stay on the unit circle
+  Rotation2d sum;
+  const Rotation2d step{1.0_deg};
+  for (int i = 0; i < 100000; ++i) {
+    sum = sum + step;
+  }
+  EXPECT_NEAR(std::hypot(sum.Cos(), sum.Sin()), 1.0, kEpsilon);
+  EXPECT_NEAR(sum.Degrees().to<double>(), 100000 % 360 - 360.0, 1E-6);
+}
@@ -2,6 +2,8 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <vector>
+
 #include <wpi/numbers>
 
 #include "frc/geometry/Translation2d.h"
@@ -178,3 +180,37 @@ TEST_F(SwerveDriveKinematicsTest, NormalizeTest) {
   EXPECT_NEAR(arr[2].speed.to<double>(), 4.0 * kFactor, kEpsilon);
   EXPECT_NEAR(arr[3].speed.to<double>(), 7.0 * kFactor, kEpsilon);
 }
+
+TEST_F(SwerveDriveKinematicsTest, BatchedKinematics) {
+  std::vector<ChassisSpeeds> speeds{{5.0_mps, 0.0_mps, 0.0_rad_per_s},
+                                    {0.0_mps, 0.0_mps, 0.0_rad_per_s},
+                                    {1.0_mps, 3.0_mps, 1.5_rad_per_s},
+                                    {-2.0_mps, 0.5_mps, -0.7_rad_per_s}};
+  const Translation2d centerOfRotation{24_m, 0_m};
+
+  std::vector<wpi::array<SwerveModuleState, 4>> moduleStates(
+      speeds.size(), wpi::array<SwerveModuleState, 4>{wpi::empty_array});
+  m_kinematics.ToSwerveModuleStates(speeds, moduleStates, centerOfRotation);
+
+  std::vector<ChassisSpeeds> chassisSpeeds(speeds.size());
+  m_kinematics.ToChassisSpeeds(moduleStates, chassisSpeeds);
+
+  for (size_t j = 0; j < speeds.size(); ++j) {
+    auto expected =
+        m_kinematics.ToSwerveModuleStates(speeds[j], centerOfRotation);
+    for (size_t i = 0; i < 4; ++i) {
+      EXPECT_NEAR(moduleStates[j][i].speed.to<double>(),
+                  expected[i].speed.to<double>(), 1e-9);
+      EXPECT_NEAR(moduleStates[j][i].angle.Radians().to<double>(),
+                  expected[i].angle.Radians().to<double>(), 1e-9);
+    }
+
+    auto expectedSpeeds = m_kinematics.ToChassisSpeeds(expected);
+    EXPECT_NEAR(chassisSpeeds[j].vx.to<double>(),
+                expectedSpeeds.vx.to<double>(), 1e-9);
+    EXPECT_NEAR(chassisSpeeds[j].vy.to<double>(),
+                expectedSpeeds.vy.to<double>(), 1e-9);
+    EXPECT_NEAR(chassisSpeeds[j].omega.to<double>(),
+                expectedSpeeds.omega.to<double>(), 1e-9);
+  }
+}
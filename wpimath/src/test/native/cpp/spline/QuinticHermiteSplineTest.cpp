@@ -4,6 +4,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <vector>
 
 #include "frc/geometry/Pose2d.h"
 #include "frc/geometry/Rotation2d.h"
@@ -86,3 +87,27 @@ TEST_F(QuinticHermiteSplineTest, ThrowsOnMalformed) {
                    Pose2d(10_m, 11_m, Rotation2d(-90_deg))),
                SplineParameterizer::MalformedSplineException);
 }
+
+TEST_F(QuinticHermiteSplineTest, Workspace) {
+  const auto splines = SplineHelper::QuinticSplinesFromWaypoints(
+      {Pose2d(), Pose2d(1_m, 1_m, Rotation2d()),
+       Pose2d(0_m, 2_m, Rotation2d(180_deg))});
+
+  // Appending each spline's points to one vector with a reused workspace
+  // gives the same points as parameterizing each on its own.
+  SplineParameterizer::Workspace workspace;
+  std::vector<Spline<5>::PoseWithCurvature> appended{
+      splines.front().GetPoint(0.0)};
+  std::vector<Spline<5>::PoseWithCurvature> expected{appended};
+  for (auto&& spline : splines) {
+    SplineParameterizer::Parameterize(spline, workspace, &appended);
+    auto points = SplineParameterizer::Parameterize(spline);
+    expected.insert(expected.end(), points.begin() + 1, points.end());
+  }
+
+  ASSERT_EQ(appended.size(), expected.size());
+  for (size_t i = 0; i < appended.size(); ++i) {
+    EXPECT_EQ(appended[i].first, expected[i].first);
+    EXPECT_EQ(appended[i].second, expected[i].second);
+  }
+}
@@ -0,0 +1,73 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "frc/system/AutoDiffJacobian.h"
+
+namespace {
+
+Eigen::Matrix<double, 4, 4> A = (Eigen::Matrix<double, 4, 4>() << 1, 2, 4, 1, 5,
+                                 2, 3, 4, 5, 1, 3, 2, 1, 1, 3, 7)
+                                    .finished();
+
+Eigen::Matrix<double, 4, 2> B =
+    (Eigen::Matrix<double, 4, 2>() << 1, 1, 2, 1, 3, 2, 3, 7).finished();
+
+// Function from which to recover A and B
+template <typename T>
+Eigen::Matrix<T, 4, 1> AxBuFn(const Eigen::Matrix<T, 4, 1>& x,
+                              const Eigen::Matrix<T, 2, 1>& u) {
+  return A.template cast<T>() * x + B.template cast<T>() * u;
+}
+
+// Nonlinear function with known Jacobians
+template <typename T>
+Eigen::Matrix<T, 2, 1> PolarFn(const Eigen::Matrix<T, 2, 1>& x,
+                               const Eigen::Matrix<T, 1, 1>& u) {
+  using std::cos;
+  using std::sin;
+  Eigen::Matrix<T, 2, 1> result;
+  result << x(0) * cos(x(1)) * u(0), x(0) * sin(x(1)) * u(0);
+  return result;
+}
+
+}  // namespace
+
+// Test that we can recover A from AxBuFn() exactly
+TEST(AutoDiffJacobianTest, Ax) {
+  Eigen::Matrix<double, 4, 4> newA = frc::AutoDiffJacobianX<4, 4, 2>(
+      [](const auto& x, const auto& u) { return AxBuFn(x, u); },
+      Eigen::Matrix<double, 4, 1>::Zero(), Eigen::Matrix<double, 2, 1>::Zero());
+  EXPECT_EQ(newA, A);
+}
+
+// Test that we can recover B from AxBuFn() exactly
+TEST(AutoDiffJacobianTest, Bu) {
+  Eigen::Matrix<double, 4, 2> newB = frc::AutoDiffJacobianU<4, 4, 2>(
+      [](const auto& x, const auto& u) { return AxBuFn(x, u); },
+      Eigen::Matrix<double, 4, 1>::Zero(), Eigen::Matrix<double, 2, 1>::Zero());
+  EXPECT_EQ(newB, B);
+}
+
+TEST(AutoDiffJacobianTest, Nonlinear) {
+  Eigen::Matrix<double, 2, 1> x;
+  x << 2.0, 0.5;
+  Eigen::Matrix<double, 1, 1> u;
+  u << 3.0;
+
+  Eigen::Matrix<double, 2, 2> newA = frc::AutoDiffJacobianX<2, 2, 1>(
+      [](const auto& x, const auto& u) { return PolarFn(x, u); }, x, u);
+  EXPECT_DOUBLE_EQ(newA(0, 0), std::cos(0.5) * 3.0);
+  EXPECT_DOUBLE_EQ(newA(0, 1), -2.0 * std::sin(0.5) * 3.0);
+  EXPECT_DOUBLE_EQ(newA(1, 0), std::sin(0.5) * 3.0);
+  EXPECT_DOUBLE_EQ(newA(1, 1), 2.0 * std::cos(0.5) * 3.0);
+
+  Eigen::Matrix<double, 2, 1> newB = frc::AutoDiffJacobianU<2, 2, 1>(
+      [](const auto& x, const auto& u) { return PolarFn(x, u); }, x, u);
+  EXPECT_DOUBLE_EQ(newB(0, 0), 2.0 * std::cos(0.5));
+  EXPECT_DOUBLE_EQ(newB(1, 0), 2.0 * std::sin(0.5));
+}
@@ -0,0 +1,34 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include "Eigen/Core"
+#include "frc/system/Discretization.h"
+#include "frc/system/DiscretizationCache.h"
+
+// Tests that cached discretizations match DiscretizeAB() over jittering
+// timesteps
+TEST(DiscretizationCacheTest, MatchesDiscretizeAB) {
+  Eigen::Matrix<double, 2, 2> contA;
+  contA << 0, 1, -20, -35;
+  Eigen::Matrix<double, 2, 1> contB;
+  contB << 0, 40;
+
+  frc::DiscretizationCache<2, 1> cache{contA, contB};
+
+  for (auto dt : {0.02_s, 0.0203_s, 0.0197_s, 0.02_s, 0.02149_s, 0.0186_s,
+                  0.005_s, 0.1_s, 0.0201_s}) {
+    Eigen::Matrix<double, 2, 2> expectedA;
+    Eigen::Matrix<double, 2, 1> expectedB;
+    frc::DiscretizeAB<2, 1>(contA, contB, dt, &expectedA, &expectedB);
+
+    Eigen::Matrix<double, 2, 2> discA;
+    Eigen::Matrix<double, 2, 1> discB;
+    cache.DiscretizeAB(dt, &discA, &discB);
+
+    EXPECT_TRUE(discA.isApprox(expectedA, 1e-9));
+    EXPECT_TRUE(discB.isApprox(expectedB, 1e-9));
+  }
+}
@@ -0,0 +1,86 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include <wpi/ThreadPool.h>
+
+#include "Eigen/Core"
+#include "frc/system/LinearSystemBatch.h"
+#include "frc/system/plant/DCMotor.h"
+#include "frc/system/plant/LinearSystemId.h"
+#include "units/length.h"
+#include "units/mass.h"
+
+namespace {
+frc::LinearSystem<2, 1, 1> MakeElevator() {
+  return frc::LinearSystemId::ElevatorSystem(frc::DCMotor::Vex775Pro(4), 8_kg,
+                                             0.75_in, 14.67);
+}
+}  // namespace
+
+// Tests that each instance of a batch follows the single system
+TEST(LinearSystemBatchTest, MatchesLinearSystem) {
+  auto plant = MakeElevator();
+  frc::LinearSystemBatch<2, 1, 1> batch{plant, 3};
+
+  std::array<Eigen::Matrix<double, 2, 1>, 3> x;
+  std::array<Eigen::Matrix<double, 1, 1>, 3> u;
+  for (int i = 0; i < 3; ++i) {
+    x[i] << 0.1 * i, -0.2 * i;
+    u[i] << 4.0 * i - 6.0;
+    batch.SetState(i, x[i]);
+    batch.SetInput(i, u[i]);
+  }
+
+  for (int step = 0; step < 50; ++step) {
+    batch.Update(20_ms);
+    for (int i = 0; i < 3; ++i) {
+      x[i] = plant.CalculateX(x[i], u[i], 20_ms);
+    }
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(batch.GetState(i).isApprox(x[i], 1e-9));
+    EXPECT_TRUE(batch.GetOutput(i).isApprox(plant.CalculateY(x[i], u[i])));
+  }
+}
+
+// Tests that updating blocks of instances on a thread pool, with linear and
+// integrated dynamics, gives the same result as on the calling thread
+TEST(LinearSystemBatchTest, Parallel) {
+  constexpr int kSize = 1000;
+
+  auto plant = MakeElevator();
+  frc::LinearSystemBatch<2, 1, 1> batch{plant, kSize};
+  frc::LinearSystemBatch<2, 1, 1> parallelBatch{plant, kSize};
+  wpi::ThreadPool::Options options;
+  options.numThreads = 4;
+  wpi::ThreadPool pool{options};
+  parallelBatch.SetThreadPool(&pool, 64);
+
+  Eigen::Matrix<double, 1, Eigen::Dynamic> u =
+      Eigen::Matrix<double, 1, Eigen::Dynamic>::Random(1, kSize) * 12.0;
+  batch.SetInputs(u);
+  parallelBatch.SetInputs(u);
+
+  // The elevator's linear dynamics plus gravity
+  auto f = [&](const Eigen::Matrix<double, 2, Eigen::Dynamic>& x,
+               const Eigen::Matrix<double, 1, Eigen::Dynamic>& u) {
+    Eigen::Matrix<double, 2, Eigen::Dynamic> xdot =
+        plant.A() * x + plant.B() * u;
+    xdot.row(1).array() -= 9.8;
+    return xdot;
+  };
+
+  for (int step = 0; step < 20; ++step) {
+    batch.Update(20_ms);
+    parallelBatch.Update(20_ms);
+    batch.Update(f, 20_ms);
+    parallelBatch.Update(f, 20_ms);
+  }
+
+  EXPECT_TRUE(parallelBatch.GetStates().isApprox(batch.GetStates(), 1e-12));
+  EXPECT_TRUE(parallelBatch.GetOutputs().isApprox(batch.GetOutputs(), 1e-12));
+}
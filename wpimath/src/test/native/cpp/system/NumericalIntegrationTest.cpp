@@ -6,6 +6,7 @@
 
 #include <cmath>
 
+#include "frc/system/Discretization.h"
 #include "frc/system/NumericalIntegration.h"
 
 // Tests that integrating dx/dt = e^x works.
@@ -67,3 +68,39 @@ TEST(NumericalIntegrationTest, ExponentialRKDP) {
       y0, (Eigen::Matrix<double, 1, 1>() << 0.0).finished(), 0.1_s);
   EXPECT_NEAR(y1(0), std::exp(0.1) - std::exp(0), 1e-3);
 }
+
+// Tests that RKDPIntegrator follows the exact solution of a stiff linear
+// system over several calls, and keeps a step size smaller than the timestep
+TEST(NumericalIntegrationTest, RKDPIntegrator) {
+  Eigen::Matrix<double, 2, 2> A;
+  A << 0.0, 1.0, -4000.0, -10.0;
+  Eigen::Matrix<double, 2, 1> B;
+  B << 0.0, 1.0;
+  auto f = [&](const Eigen::Matrix<double, 2, 1>& x,
+               const Eigen::Matrix<double, 1, 1>& u)
+      -> Eigen::Matrix<double, 2, 1> { return A * x + B * u; };
+
+  Eigen::Matrix<double, 2, 2> discA;
+  Eigen::Matrix<double, 2, 1> discB;
+  frc::DiscretizeAB<2, 1>(A, B, 20_ms, &discA, &discB);
+
+  frc::RKDPIntegrator<Eigen::Matrix<double, 2, 1>, Eigen::Matrix<double, 1, 1>>
+      integrator;
+
+  Eigen::Matrix<double, 2, 1> x;
+  x << 1.0, 0.0;
+  Eigen::Matrix<double, 2, 1> expected = x;
+  Eigen::Matrix<double, 1, 1> u;
+  u << 12.0;
+  for (int i = 0; i < 50; ++i) {
+    x = integrator.Integrate(f, x, u, 20_ms);
+    expected = discA * expected + discB * u;
+  }
+
+  EXPECT_NEAR(x(0), expected(0), 1e-4);
+  EXPECT_NEAR(x(1), expected(1), 1e-3);
+  EXPECT_LT(integrator.GetStepSize(), 20_ms);
+
+  integrator.Reset();
+  EXPECT_EQ(integrator.GetStepSize(), 0_s);
+}
@@ -0,0 +1,75 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include "frc/trajectory/PackedTrajectory.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+static Trajectory GetTrajectory() {
+  return TrajectoryGenerator::GenerateTrajectory(
+      {Pose2d{0_m, 0_m, 0_deg}, Pose2d{2_m, 1_m, 45_deg},
+       Pose2d{4_m, 3_m, 170_deg}},
+      TrajectoryConfig{3_mps, 2_mps_sq});
+}
+
+static void ExpectNear(const Trajectory::State& a,
+                       const Trajectory::State& b) {
+  EXPECT_NEAR(a.t.value(), b.t.value(), 1e-9);
+  EXPECT_NEAR(a.velocity.value(), b.velocity.value(), 1e-9);
+  EXPECT_NEAR(a.acceleration.value(), b.acceleration.value(), 1e-9);
+  EXPECT_NEAR(a.pose.X().value(), b.pose.X().value(), 1e-9);
+  EXPECT_NEAR(a.pose.Y().value(), b.pose.Y().value(), 1e-9);
+  EXPECT_EQ(a.pose.Rotation(), b.pose.Rotation());
+  EXPECT_NEAR(a.curvature.value(), b.curvature.value(), 1e-9);
+}
+
+static void ExpectNear(const PackedTrajectory& a, const Trajectory& b) {
+  ASSERT_EQ(a.size(), b.States().size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    ExpectNear(a.GetState(i), b.States()[i]);
+  }
+}
+
+TEST(PackedTrajectoryTest, RoundTrip) {
+  auto trajectory = GetTrajectory();
+  PackedTrajectory packed{trajectory};
+  EXPECT_EQ(packed.TotalTime(), trajectory.TotalTime());
+  ExpectNear(packed, trajectory);
+  ExpectNear(PackedTrajectory{packed.ToTrajectory()}, trajectory);
+}
+
+TEST(PackedTrajectoryTest, Sample) {
+  auto trajectory = GetTrajectory();
+  PackedTrajectory packed{trajectory};
+
+  std::vector<units::second_t> times;
+  for (auto t = -0.1_s; t < trajectory.TotalTime() + 0.1_s; t += 0.013_s) {
+    times.push_back(t);
+  }
+  times.push_back(0.5_s);
+  std::vector<Trajectory::State> states(times.size());
+  packed.Sample(times, states);
+
+  for (size_t i = 0; i < times.size(); ++i) {
+    ExpectNear(packed.Sample(times[i]), trajectory.Sample(times[i]));
+    ExpectNear(states[i], trajectory.Sample(times[i]));
+  }
+}
+
+TEST(PackedTrajectoryTest, Transforms) {
+  auto trajectory = GetTrajectory();
+  PackedTrajectory packed{trajectory};
+
+  Transform2d transform{Translation2d{1_m, 2_m}, 30_deg};
+  ExpectNear(packed.TransformBy(transform), trajectory.TransformBy(transform));
+
+  Pose2d pose{1_m, 2_m, 120_deg};
+  ExpectNear(packed.RelativeTo(pose), trajectory.RelativeTo(pose));
+
+  ExpectNear(packed + packed, trajectory + trajectory);
+}
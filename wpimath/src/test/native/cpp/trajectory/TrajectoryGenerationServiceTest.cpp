@@ -0,0 +1,103 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <vector>
+
+#include "frc/spline/SplineHelper.h"
+#include "frc/trajectory/TrajectoryGenerationService.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+static std::vector<Pose2d> GetWaypoints() {
+  return {Pose2d{0_m, 0_m, 0_deg}, Pose2d{2_m, 1_m, 45_deg},
+          Pose2d{4_m, 3_m, 0_deg}, Pose2d{6_m, 2_m, -60_deg},
+          Pose2d{8_m, 0_m, 0_deg}};
+}
+
+static std::shared_ptr<TrajectoryConfig> GetConfig() {
+  auto config = std::make_shared<TrajectoryConfig>(3_mps, 2_mps_sq);
+  config->AddConstraint(
+      CentripetalAccelerationConstraint{units::meters_per_second_squared_t{1}});
+  return config;
+}
+
+static void ExpectSame(const Trajectory& a, const Trajectory& b) {
+  ASSERT_EQ(a.States().size(), b.States().size());
+  for (size_t i = 0; i < a.States().size(); ++i) {
+    EXPECT_EQ(a.States()[i], b.States()[i]);
+  }
+}
+
+TEST(TrajectoryGenerationServiceTest, MatchesGenerator) {
+  auto config = GetConfig();
+  TrajectoryGenerationService service;
+  auto trajectory = service.GenerateTrajectory(GetWaypoints(), config).get();
+  ExpectSame(trajectory,
+             TrajectoryGenerator::GenerateTrajectory(GetWaypoints(), *config));
+
+  Pose2d start{0_m, 0_m, 0_deg};
+  Pose2d end{6_m, 2_m, 0_deg};
+  std::vector<Translation2d> interior{Translation2d{2_m, 1_m},
+                                      Translation2d{4_m, 1_m}};
+  ExpectSame(service.GenerateTrajectory(start, interior, end, config).get(),
+             TrajectoryGenerator::GenerateTrajectory(start, interior, end,
+                                                     *config));
+}
+
+TEST(TrajectoryGenerationServiceTest, ParallelSplinePoints) {
+  wpi::ThreadPool::Options options;
+  options.numThreads = 4;
+  wpi::ThreadPool pool{options};
+  auto splines = SplineHelper::QuinticSplinesFromWaypoints(GetWaypoints());
+  auto points = TrajectoryGenerator::SplinePointsFromSplines(splines);
+  auto parallel = TrajectoryGenerator::SplinePointsFromSplines(splines, pool);
+  ASSERT_EQ(points.size(), parallel.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(points[i].first, parallel[i].first);
+    EXPECT_EQ(points[i].second, parallel[i].second);
+  }
+}
+
+TEST(TrajectoryGenerationServiceTest, Cache) {
+  auto config = GetConfig();
+  TrajectoryGenerationService service{1};
+  auto first = service.GenerateTrajectory(GetWaypoints(), config);
+  auto second = service.GenerateTrajectory(GetWaypoints(), config);
+  ExpectSame(first.get(), second.get());
+  EXPECT_EQ(service.GetCacheHits(), 1u);
+
+  ExpectSame(service.GenerateTrajectory(GetWaypoints(), config).get(),
+             TrajectoryGenerator::GenerateTrajectory(GetWaypoints(), *config));
+  EXPECT_EQ(service.GetCacheHits(), 2u);
+
+  // a different config object isn't a hit, even if equal
+  service.GenerateTrajectory(GetWaypoints(), GetConfig()).get();
+  EXPECT_EQ(service.GetCacheHits(), 2u);
+
+  // evicted by the last one
+  service.GenerateTrajectory(GetWaypoints(), config).get();
+  EXPECT_EQ(service.GetCacheHits(), 2u);
+
+  service.ClearCache();
+  service.GenerateTrajectory(GetWaypoints(), config).get();
+  EXPECT_EQ(service.GetCacheHits(), 2u);
+}
+
+TEST(TrajectoryGenerationServiceTest, Malformed) {
+  TrajectoryGenerator::SetErrorHandler([](const char*) {});
+  TrajectoryGenerationService service;
+  auto trajectory =
+      service
+          .GenerateTrajectory(
+              std::vector<Pose2d>{Pose2d{0_m, 0_m, 0_deg},
+                                  Pose2d{1_m, 0_m, 180_deg}},
+              std::make_shared<TrajectoryConfig>(12_fps, 12_fps_sq))
+          .get();
+  TrajectoryGenerator::SetErrorHandler(nullptr);
+  EXPECT_EQ(trajectory.States().size(), 1u);
+}
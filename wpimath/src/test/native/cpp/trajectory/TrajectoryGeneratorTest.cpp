@@ -41,3 +41,59 @@ TEST(TrajectoryGenertionTest, ReturnsEmptyOnMalformed) {
   ASSERT_EQ(t.States().size(), 1u);
   ASSERT_EQ(t.TotalTime(), 0_s);
 }
+
+TEST(TrajectoryGenerationTest, ObeysJerkLimit) {
+  std::vector<Pose2d> waypoints{Pose2d{0_m, 0_m, 0_deg},
+                                Pose2d{8_m, 0_m, 0_deg}};
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  auto unlimited = TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+
+  config.SetMaxJerk(TrajectoryConfig::Jerk_t{4});
+  auto trajectory = TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+  const auto& states = trajectory.States();
+
+  for (size_t i = 1; i + 1 < states.size(); ++i) {
+    auto dt = (states[i + 1].t - states[i - 1].t) / 2.0;
+    auto jerk = (states[i].acceleration - states[i - 1].acceleration) / dt;
+    EXPECT_LE(units::math::abs(jerk).value(), 4.0 * 1.1) << "at " << i;
+    EXPECT_LE(units::math::abs(states[i].acceleration), 2_mps_sq + 1E-9_mps_sq);
+    EXPECT_LE(states[i].velocity, 3_mps + 1E-9_mps);
+  }
+  EXPECT_NEAR(states.back().velocity.value(), 0.0, 1E-9);
+  EXPECT_GT(trajectory.TotalTime(), unlimited.TotalTime());
+  // Accelerating from rest at the max jerk until the max acceleration, then
+  // easing off, reaches the max velocity, so most of the path is covered at it
+  EXPECT_LT(trajectory.TotalTime(), unlimited.TotalTime() + 1_s);
+}
+
+TEST(TrajectoryGenerationTest, Replan) {
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  auto trajectory = TrajectoryGenerator::GenerateTrajectory(
+      std::vector<Pose2d>{Pose2d{0_m, 0_m, 0_deg}, Pose2d{3_m, 2_m, 90_deg},
+                          Pose2d{6_m, 4_m, 0_deg}},
+      config);
+
+  Pose2d target{7_m, 2_m, -45_deg};
+  auto time = trajectory.TotalTime() / 2.0;
+  auto replanned =
+      TrajectoryGenerator::Replan(trajectory, time, {target}, config);
+
+  // The states before the junction are kept
+  for (size_t i = 0; trajectory.States()[i].t < time; ++i) {
+    EXPECT_EQ(replanned.States()[i], trajectory.States()[i]);
+  }
+
+  // The junction's pose, curvature and velocity carry over
+  auto before = trajectory.Sample(time);
+  auto after = replanned.Sample(time);
+  EXPECT_NEAR(before.pose.X().value(), after.pose.X().value(), 1E-9);
+  EXPECT_NEAR(before.pose.Y().value(), after.pose.Y().value(), 1E-9);
+  EXPECT_NEAR(before.pose.Rotation().Radians().value(),
+              after.pose.Rotation().Radians().value(), 1E-9);
+  EXPECT_NEAR(before.curvature.value(), after.curvature.value(), 1E-6);
+  EXPECT_NEAR(before.velocity.value(), after.velocity.value(), 1E-9);
+
+  auto end = replanned.States().back();
+  EXPECT_EQ(end.pose, target);
+  EXPECT_NEAR(end.velocity.value(), 0.0, 1E-9);
+}
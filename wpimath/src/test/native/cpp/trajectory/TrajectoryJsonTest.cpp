@@ -2,6 +2,8 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <wpi/fs.h>
+
 #include "frc/trajectory/TrajectoryConfig.h"
 #include "frc/trajectory/TrajectoryUtil.h"
 #include "gtest/gtest.h"
@@ -18,3 +20,33 @@ TEST(TrajectoryJsonTest, DeserializeMatches) {
                       TrajectoryUtil::SerializeTrajectory(trajectory)));
   EXPECT_EQ(trajectory.States(), deserialized.States());
 }
+
+TEST(TrajectoryJsonTest, DeserializeBinaryMatches) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  auto data = TrajectoryUtil::SerializeTrajectoryBinary(trajectory);
+  Trajectory deserialized;
+  EXPECT_NO_THROW(deserialized =
+                      TrajectoryUtil::DeserializeTrajectoryBinary(data));
+  EXPECT_EQ(trajectory.States(), deserialized.States());
+
+  data.resize(data.size() - 1);
+  EXPECT_THROW(TrajectoryUtil::DeserializeTrajectoryBinary(data),
+               std::runtime_error);
+  data[0] = '{';
+  EXPECT_THROW(TrajectoryUtil::DeserializeTrajectoryBinary(data),
+               std::runtime_error);
+}
+
+TEST(TrajectoryJsonTest, BinaryFile) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  auto path =
+      (fs::temp_directory_path() / "TrajectoryJsonTest.wtrj").string();
+  TrajectoryUtil::ToBinary(trajectory, path);
+  auto loaded = TrajectoryUtil::FromBinary(path);
+  fs::remove(path);
+  EXPECT_EQ(trajectory.States(), loaded.States());
+}
@@ -0,0 +1,89 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "frc/kinematics/DifferentialDriveKinematics.h"
+#include "frc/kinematics/SwerveDriveKinematics.h"
+#include "frc/spline/SplineHelper.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/TrajectoryParameterizer.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "frc/trajectory/constraint/DifferentialDriveKinematicsConstraint.h"
+#include "frc/trajectory/constraint/MaxVelocityConstraint.h"
+#include "frc/trajectory/constraint/SwerveDriveKinematicsConstraint.h"
+#include "gtest/gtest.h"
+#include "units/math.h"
+
+using namespace frc;
+
+static std::vector<TrajectoryParameterizer::PoseWithCurvature> GetPoints() {
+  return TrajectoryGenerator::SplinePointsFromSplines(
+      SplineHelper::QuinticSplinesFromWaypoints(
+          {Pose2d{0_m, 0_m, 0_deg}, Pose2d{2_m, 1_m, 45_deg},
+           Pose2d{4_m, 3_m, 0_deg}, Pose2d{6_m, 2_m, -60_deg}}));
+}
+
+// MaxVelocities() must give the same limits as MaxVelocity()
+static void CheckMaxVelocities(const TrajectoryConstraint& constraint) {
+  auto points = GetPoints();
+  std::vector<units::meters_per_second_t> limits(points.size());
+  ASSERT_TRUE(constraint.MaxVelocities(points, limits));
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (auto velocity : {0_mps, 0.5_mps, 1_mps, 2_mps, 4_mps, 10_mps}) {
+      auto expected = units::math::min(
+          velocity, constraint.MaxVelocity(points[i].first, points[i].second,
+                                           velocity));
+      EXPECT_NEAR(units::math::min(velocity, limits[i]).value(),
+                  expected.value(), 1e-9);
+    }
+  }
+}
+
+TEST(TrajectoryParameterizerTest, MaxVelocities) {
+  CheckMaxVelocities(CentripetalAccelerationConstraint{1_mps_sq});
+  CheckMaxVelocities(MaxVelocityConstraint{2_mps});
+
+  DifferentialDriveKinematics differential{0.7_m};
+  CheckMaxVelocities(
+      DifferentialDriveKinematicsConstraint{differential, 3_mps});
+
+  SwerveDriveKinematics<4> swerve{
+      Translation2d{0.3_m, 0.3_m}, Translation2d{0.3_m, -0.3_m},
+      Translation2d{-0.3_m, 0.3_m}, Translation2d{-0.3_m, -0.3_m}};
+  CheckMaxVelocities(SwerveDriveKinematicsConstraint<4>{swerve, 3_mps});
+}
+
+TEST(TrajectoryParameterizerTest, StaticConstraints) {
+  auto points = GetPoints();
+  DifferentialDriveKinematics kinematics{0.7_m};
+  DifferentialDriveKinematicsConstraint kinematicsConstraint{kinematics,
+                                                             2.5_mps};
+  CentripetalAccelerationConstraint centripetal{1.5_mps_sq};
+
+  std::vector<std::unique_ptr<TrajectoryConstraint>> constraints;
+  constraints.emplace_back(
+      std::make_unique<DifferentialDriveKinematicsConstraint>(
+          kinematicsConstraint));
+  constraints.emplace_back(
+      std::make_unique<CentripetalAccelerationConstraint>(centripetal));
+
+  for (bool reversed : {false, true}) {
+    auto dynamic = TrajectoryParameterizer::TimeParameterizeTrajectory(
+        points, constraints, 0_mps, 0_mps, 3_mps, 2_mps_sq, reversed);
+    auto fixed = TrajectoryParameterizer::TimeParameterizeTrajectory(
+        points, std::tuple{kinematicsConstraint, centripetal}, 0_mps, 0_mps,
+        3_mps, 2_mps_sq, reversed);
+
+    ASSERT_EQ(dynamic.States().size(), fixed.States().size());
+    for (size_t i = 0; i < dynamic.States().size(); ++i) {
+      EXPECT_NEAR(dynamic.States()[i].t.value(), fixed.States()[i].t.value(),
+                  1e-9);
+      EXPECT_NEAR(dynamic.States()[i].velocity.value(),
+                  fixed.States()[i].velocity.value(), 1e-9);
+    }
+  }
+}
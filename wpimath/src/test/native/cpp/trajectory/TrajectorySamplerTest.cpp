@@ -0,0 +1,60 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/TrajectorySampler.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+static Trajectory GetTrajectory() {
+  return TrajectoryGenerator::GenerateTrajectory(
+      {Pose2d{0_m, 0_m, 0_deg}, Pose2d{2_m, 1_m, 45_deg},
+       Pose2d{4_m, 3_m, 0_deg}},
+      TrajectoryConfig{3_mps, 2_mps_sq});
+}
+
+TEST(TrajectorySamplerTest, MatchesSample) {
+  auto trajectory = GetTrajectory();
+  TrajectorySampler sampler{trajectory};
+
+  for (auto t = -0.1_s; t < trajectory.TotalTime() + 0.1_s; t += 0.013_s) {
+    EXPECT_EQ(sampler.Sample(t), trajectory.Sample(t));
+  }
+
+  // going back searches again
+  for (auto t : {1_s, 0.5_s, 0.5_s, 2_s, 0.1_s}) {
+    EXPECT_EQ(sampler.Sample(t), trajectory.Sample(t));
+  }
+
+  // the states themselves
+  sampler.Reset();
+  for (auto&& state : trajectory.States()) {
+    EXPECT_EQ(sampler.Sample(state.t), trajectory.Sample(state.t));
+  }
+}
+
+TEST(TrajectorySamplerTest, Uniform) {
+  auto trajectory = GetTrajectory();
+  UniformTrajectory uniform{trajectory, 0.02_s};
+  EXPECT_EQ(uniform.TotalTime(), trajectory.TotalTime());
+
+  const auto& states = uniform.States();
+  for (size_t i = 0; i + 1 < states.size(); ++i) {
+    EXPECT_EQ(states[i], trajectory.Sample(0.02_s * static_cast<double>(i)));
+  }
+  EXPECT_EQ(states.back(), trajectory.States().back());
+
+  for (auto t = 0_s; t < trajectory.TotalTime(); t += 0.013_s) {
+    auto expected = trajectory.Sample(t);
+    auto actual = uniform.Sample(t);
+    EXPECT_NEAR(actual.t.value(), expected.t.value(), 1e-9);
+    // within a period of acceleration
+    EXPECT_NEAR(actual.velocity.value(), expected.velocity.value(), 0.04);
+    EXPECT_NEAR(actual.pose.X().value(), expected.pose.X().value(), 1e-3);
+    EXPECT_NEAR(actual.pose.Y().value(), expected.pose.Y().value(), 1e-3);
+  }
+  EXPECT_EQ(uniform.Sample(trajectory.TotalTime() + 1_s),
+            trajectory.States().back());
+}
@@ -57,9 +57,19 @@
 
 #include "wpi/Base64.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "wpi/SmallVector.h"
 #include "wpi/raw_ostream.h"
 
+#include "cpu_features.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define WPI_BASE64_NEON
+#endif
+
 namespace wpi {
 
 // aaaack but it's fast and const should make it shared text page.
@@ -80,38 +90,355 @@ static const unsigned char pr2six[256] = {
     64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
     64, 64, 64, 64, 64, 64, 64, 64, 64};
 
+static const char basis_64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Input (and output) is handled in chunks of this many 4-character groups,
+// so the output reaches the stream in a few large writes
+static constexpr size_t kChunkGroups = 1024;
+
+// The vector paths encode or decode as many whole blocks as they can from
+// the start of the input and return the input length they handled; their
+// output is a multiple of 4 characters (encoding) or 3 bytes (decoding)
+// per 3 bytes or 4 characters done.  Decoders stop at the first block that
+// holds a character that is not part of the alphabet, and may store up to
+// 16 bytes past the end of their output.
+using EncodeBlocksFunc = size_t (*)(const unsigned char* in, size_t len,
+                                    char* out);
+using DecodeBlocksFunc = size_t (*)(const unsigned char* in, size_t len,
+                                    unsigned char* out);
+
+#ifdef WPI_CPU_X86
+// Algorithms by Wojciech Mula and Daniel Lemire, "Faster Base64 Encoding
+// and Decoding Using AVX2 Instructions" (ACM TWEB, 2018).
+
+// Converts 6-bit values to their characters
+WPI_TARGET("ssse3")
+static inline __m128i Base64Chars(__m128i indices) {
+  // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+  __m128i offsetIndex = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  offsetIndex =
+      _mm_or_si128(offsetIndex, _mm_and_si128(less, _mm_set1_epi8(13)));
+  const __m128i offsets =
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                    '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, offsetIndex), indices);
+}
+
+// Splits the first 12 bytes into 16 6-bit values
+WPI_TARGET("ssse3")
+static inline __m128i Base64Split(__m128i in) {
+  in = _mm_shuffle_epi8(
+      in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+WPI_TARGET("ssse3")
+static size_t EncodeBlocksSsse3(const unsigned char* in, size_t len,
+                                char* out) {
+  size_t i = 0;
+  // each block reads 16 bytes but only uses 12
+  for (; len - i >= 16; i += 12, out += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     Base64Chars(Base64Split(v)));
+  }
+  return i;
+}
+
+// Converts characters to their 6-bit values; returns false if any character
+// is not part of the alphabet
+WPI_TARGET("ssse3")
+static inline bool Base64Values(__m128i* v) {
+  const __m128i lutLo =
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                    0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lutHi =
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0,
+                                        0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask2F = _mm_set1_epi8(0x2F);
+  __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(*v, 4), mask2F);
+  __m128i loNibbles = _mm_and_si128(*v, mask2F);
+  __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+  __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+  if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi),
+                                       _mm_setzero_si128())) != 0) {
+    return false;
+  }
+  __m128i eq2F = _mm_cmpeq_epi8(*v, mask2F);
+  __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+  *v = _mm_add_epi8(*v, roll);
+  return true;
+}
+
+// Packs 16 6-bit values into the first 12 bytes
+WPI_TARGET("ssse3")
+static inline __m128i Base64Pack(__m128i v) {
+  __m128i merged = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+  __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                                                13, 12, -1, -1, -1, -1));
+}
+
+WPI_TARGET("ssse3")
+static size_t DecodeBlocksSsse3(const unsigned char* in, size_t len,
+                                unsigned char* out) {
+  size_t i = 0;
+  for (; len - i >= 16; i += 16, out += 12) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    if (!Base64Values(&v)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), Base64Pack(v));
+  }
+  return i;
+}
+
+// The AVX2 versions run the same steps on both 128-bit lanes at once
+
+WPI_TARGET("avx2")
+static size_t EncodeBlocksAvx2(const unsigned char* in, size_t len,
+                               char* out) {
+  const __m256i split = _mm256_set_epi8(
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1, 10, 11, 9, 10, 7, 8,
+      6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  const __m256i offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  size_t i = 0;
+  // each block reads 28 bytes but only uses 24
+  for (; len - i >= 28; i += 24, out += 32) {
+    __m256i v = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+    v = _mm256_shuffle_epi8(v, split);
+    __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00));
+    __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0));
+    __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    __m256i indices = _mm256_or_si256(t1, t3);
+
+    __m256i offsetIndex = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    offsetIndex = _mm256_or_si256(
+        offsetIndex, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    __m256i chars = _mm256_add_epi8(
+        _mm256_shuffle_epi8(offsets, offsetIndex), indices);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+  }
+  return i + EncodeBlocksSsse3(in + i, len - i, out);
+}
+
+WPI_TARGET("avx2")
+static size_t DecodeBlocksAvx2(const unsigned char* in, size_t len,
+                               unsigned char* out) {
+  const __m256i lutLo = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+      0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lutHi = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i lutRoll = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4,
+      -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i pack = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+      4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i mask2F = _mm256_set1_epi8(0x2F);
+  size_t i = 0;
+  for (; len - i >= 32; i += 32, out += 24) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask2F);
+    __m256i loNibbles = _mm256_and_si256(v, mask2F);
+    __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+    __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+    if (!_mm256_testz_si256(lo, hi)) {
+      break;
+    }
+    __m256i eq2F = _mm256_cmpeq_epi8(v, mask2F);
+    __m256i roll =
+        _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+    v = _mm256_add_epi8(v, roll);
+
+    __m256i merged = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+    __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+    packed = _mm256_shuffle_epi8(packed, pack);
+    packed = _mm256_permutevar8x32_epi32(
+        packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+  }
+  return i + DecodeBlocksSsse3(in + i, len - i, out);
+}
+#endif  // WPI_CPU_X86
+
+#ifdef WPI_BASE64_NEON
+static size_t EncodeBlocksNeon(const unsigned char* in, size_t len,
+                               char* out) {
+  static const int8_t offsetTable[16] = {
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A',      0,        0};
+  const uint8x16_t offsets = vreinterpretq_u8_s8(vld1q_s8(offsetTable));
+  const uint8x16_t mask3F = vdupq_n_u8(0x3F);
+  size_t i = 0;
+  for (; len - i >= 48; i += 48, out += 64) {
+    uint8x16x3_t v = vld3q_u8(in + i);
+    uint8x16x4_t chars;
+    chars.val[0] = vshrq_n_u8(v.val[0], 2);
+    chars.val[1] = vandq_u8(
+        vorrq_u8(vshlq_n_u8(v.val[0], 4), vshrq_n_u8(v.val[1], 4)), mask3F);
+    chars.val[2] = vandq_u8(
+        vorrq_u8(vshlq_n_u8(v.val[1], 2), vshrq_n_u8(v.val[2], 6)), mask3F);
+    chars.val[3] = vandq_u8(v.val[2], mask3F);
+    for (auto& c : chars.val) {
+      uint8x16_t offsetIndex = vqsubq_u8(c, vdupq_n_u8(51));
+      offsetIndex = vorrq_u8(
+          offsetIndex, vandq_u8(vcltq_u8(c, vdupq_n_u8(26)), vdupq_n_u8(13)));
+      c = vaddq_u8(vqtbl1q_u8(offsets, offsetIndex), c);
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(out), chars);
+  }
+  return i;
+}
+
+static size_t DecodeBlocksNeon(const unsigned char* in, size_t len,
+                               unsigned char* out) {
+  size_t i = 0;
+  for (; len - i >= 64; i += 64, out += 48) {
+    uint8x16x4_t v = vld4q_u8(in + i);
+    uint8x16_t valid = vdupq_n_u8(0xFF);
+    for (auto& c : v.val) {
+      uint8x16_t upper = vsubq_u8(c, vdupq_n_u8('A'));
+      uint8x16_t lower = vsubq_u8(c, vdupq_n_u8('a'));
+      uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+      uint8x16_t isUpper = vcltq_u8(upper, vdupq_n_u8(26));
+      uint8x16_t isLower = vcltq_u8(lower, vdupq_n_u8(26));
+      uint8x16_t isDigit = vcltq_u8(digit, vdupq_n_u8(10));
+      uint8x16_t isPlus = vceqq_u8(c, vdupq_n_u8('+'));
+      uint8x16_t isSlash = vceqq_u8(c, vdupq_n_u8('/'));
+      valid = vandq_u8(valid, vorrq_u8(vorrq_u8(isUpper, isLower),
+                                       vorrq_u8(isDigit,
+                                                vorrq_u8(isPlus, isSlash))));
+      c = vorrq_u8(
+          vorrq_u8(vandq_u8(isUpper, upper),
+                   vandq_u8(isLower, vaddq_u8(lower, vdupq_n_u8(26)))),
+          vorrq_u8(vandq_u8(isDigit, vaddq_u8(digit, vdupq_n_u8(52))),
+                   vorrq_u8(vandq_u8(isPlus, vdupq_n_u8(62)),
+                            vandq_u8(isSlash, vdupq_n_u8(63)))));
+    }
+    if (vminvq_u8(valid) == 0) {
+      break;
+    }
+    uint8x16x3_t bytes;
+    bytes.val[0] = vorrq_u8(vshlq_n_u8(v.val[0], 2), vshrq_n_u8(v.val[1], 4));
+    bytes.val[1] = vorrq_u8(vshlq_n_u8(v.val[1], 4), vshrq_n_u8(v.val[2], 2));
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(v.val[2], 6), v.val[3]);
+    vst3q_u8(out, bytes);
+  }
+  return i;
+}
+#endif  // WPI_BASE64_NEON
+
+static EncodeBlocksFunc GetEncodeBlocks() {
+  static const EncodeBlocksFunc func = []() -> EncodeBlocksFunc {
+#if defined(WPI_CPU_X86)
+    auto& cpu = detail::CpuFeatures::Get();
+    if (cpu.avx2) {
+      return EncodeBlocksAvx2;
+    } else if (cpu.ssse3) {
+      return EncodeBlocksSsse3;
+    }
+#elif defined(WPI_BASE64_NEON)
+    return EncodeBlocksNeon;
+#endif
+    return nullptr;
+  }();
+  return func;
+}
+
+static DecodeBlocksFunc GetDecodeBlocks() {
+  static const DecodeBlocksFunc func = []() -> DecodeBlocksFunc {
+#if defined(WPI_CPU_X86)
+    auto& cpu = detail::CpuFeatures::Get();
+    if (cpu.avx2) {
+      return DecodeBlocksAvx2;
+    } else if (cpu.ssse3) {
+      return DecodeBlocksSsse3;
+    }
+#elif defined(WPI_BASE64_NEON)
+    return DecodeBlocksNeon;
+#endif
+    return nullptr;
+  }();
+  return func;
+}
+
 size_t Base64Decode(raw_ostream& os, std::string_view encoded) {
   auto bytes_begin = reinterpret_cast<const unsigned char*>(encoded.data());
   auto bytes_end = bytes_begin + encoded.size();
-  const unsigned char* end = bytes_begin;
-  while (pr2six[*end] <= 63 && end != bytes_end) {
+  const unsigned char* cur = bytes_begin;
+  unsigned char buf[kChunkGroups * 3 + 16];
+
+  // whole blocks of valid characters, while there are any
+  if (auto decodeBlocks = GetDecodeBlocks()) {
+    for (;;) {
+      size_t len = (std::min)(static_cast<size_t>(bytes_end - cur),
+                              kChunkGroups * 4);
+      size_t done = decodeBlocks(cur, len, buf);
+      os.write(reinterpret_cast<const char*>(buf), done / 4 * 3);
+      cur += done;
+      if (done != len || done == 0) {
+        break;
+      }
+    }
+  }
+
+  const unsigned char* end = cur;
+  while (end != bytes_end && pr2six[*end] <= 63) {
     ++end;
   }
-  size_t nprbytes = end - bytes_begin;
+  size_t nprbytes = end - cur;
   if (nprbytes == 0) {
-    return 0;
+    return cur - bytes_begin;
   }
 
-  const unsigned char* cur = bytes_begin;
-
+  unsigned char* out = buf;
   while (nprbytes > 4) {
-    os << static_cast<unsigned char>(pr2six[cur[0]] << 2 | pr2six[cur[1]] >> 4);
-    os << static_cast<unsigned char>(pr2six[cur[1]] << 4 | pr2six[cur[2]] >> 2);
-    os << static_cast<unsigned char>(pr2six[cur[2]] << 6 | pr2six[cur[3]]);
+    *out++ = pr2six[cur[0]] << 2 | pr2six[cur[1]] >> 4;
+    *out++ = pr2six[cur[1]] << 4 | pr2six[cur[2]] >> 2;
+    *out++ = pr2six[cur[2]] << 6 | pr2six[cur[3]];
     cur += 4;
     nprbytes -= 4;
+    if (out - buf >= static_cast<ptrdiff_t>(kChunkGroups * 3)) {
+      os.write(reinterpret_cast<const char*>(buf), out - buf);
+      out = buf;
+    }
   }
 
   // Note: (nprbytes == 1) would be an error, so just ignore that case
   if (nprbytes > 1) {
-    os << static_cast<unsigned char>(pr2six[cur[0]] << 2 | pr2six[cur[1]] >> 4);
+    *out++ = pr2six[cur[0]] << 2 | pr2six[cur[1]] >> 4;
   }
   if (nprbytes > 2) {
-    os << static_cast<unsigned char>(pr2six[cur[1]] << 4 | pr2six[cur[2]] >> 2);
+    *out++ = pr2six[cur[1]] << 4 | pr2six[cur[2]] >> 2;
   }
   if (nprbytes > 3) {
-    os << static_cast<unsigned char>(pr2six[cur[2]] << 6 | pr2six[cur[3]]);
+    *out++ = pr2six[cur[2]] << 6 | pr2six[cur[3]];
   }
+  os.write(reinterpret_cast<const char*>(buf), out - buf);
 
   return (end - bytes_begin) + ((4 - nprbytes) & 3);
 }
@@ -132,35 +459,42 @@ std::string_view Base64Decode(std::string_view encoded, size_t* num_read,
   return os.str();
 }
 
-static const char basis_64[] =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 void Base64Encode(raw_ostream& os, std::string_view plain) {
   if (plain.empty()) {
     return;
   }
+  auto in = reinterpret_cast<const unsigned char*>(plain.data());
   size_t len = plain.size();
+  auto encodeBlocks = GetEncodeBlocks();
+  char buf[kChunkGroups * 4];
+
+  while (len >= 3) {
+    size_t chunk = (std::min)(len, kChunkGroups * 3) / 3 * 3;
+    size_t i = encodeBlocks ? encodeBlocks(in, chunk, buf) : 0;
+    char* out = buf + i / 3 * 4;
+    for (; i < chunk; i += 3) {
+      *out++ = basis_64[in[i] >> 2];
+      *out++ = basis_64[((in[i] & 0x3) << 4) | (in[i + 1] >> 4)];
+      *out++ = basis_64[((in[i + 1] & 0xF) << 2) | (in[i + 2] >> 6)];
+      *out++ = basis_64[in[i + 2] & 0x3F];
+    }
+    os.write(buf, out - buf);
+    in += chunk;
+    len -= chunk;
+  }
 
-  size_t i;
-  for (i = 0; (i + 2) < len; i += 3) {
-    os << basis_64[(plain[i] >> 2) & 0x3F];
-    os << basis_64[((plain[i] & 0x3) << 4) |
-                   (static_cast<int>(plain[i + 1] & 0xF0) >> 4)];
-    os << basis_64[((plain[i + 1] & 0xF) << 2) |
-                   (static_cast<int>(plain[i + 2] & 0xC0) >> 6)];
-    os << basis_64[plain[i + 2] & 0x3F];
-  }
-  if (i < len) {
-    os << basis_64[(plain[i] >> 2) & 0x3F];
-    if (i == (len - 1)) {
-      os << basis_64[((plain[i] & 0x3) << 4)];
-      os << '=';
+  if (len > 0) {
+    char* out = buf;
+    *out++ = basis_64[in[0] >> 2];
+    if (len == 1) {
+      *out++ = basis_64[((in[0] & 0x3) << 4)];
+      *out++ = '=';
     } else {
-      os << basis_64[((plain[i] & 0x3) << 4) |
-                     (static_cast<int>(plain[i + 1] & 0xF0) >> 4)];
-      os << basis_64[((plain[i + 1] & 0xF) << 2)];
+      *out++ = basis_64[((in[0] & 0x3) << 4) | (in[1] >> 4)];
+      *out++ = basis_64[((in[1] & 0xF) << 2)];
     }
-    os << '=';
+    *out++ = '=';
+    os.write(buf, out - buf);
   }
 }
 
@@ -0,0 +1,388 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLog.h"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+#include "wpi/Endian.h"
+#include "wpi/raw_ostream.h"
+#include "wpi/timestamp.h"
+
+using namespace wpi::log;
+
+static constexpr uint8_t kControlStart = 0;
+static constexpr uint8_t kControlFinish = 1;
+static constexpr uint8_t kControlSetMetadata = 2;
+
+// Number of bytes needed to hold val, at least 1
+static size_t ByteLength(uint64_t val) {
+  size_t len = 1;
+  while (len < 8 && (val >> (len * 8)) != 0) {
+    ++len;
+  }
+  return len;
+}
+
+static uint8_t* WriteVarInt(uint8_t* out, uint64_t val, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    *out++ = static_cast<uint8_t>(val >> (i * 8));
+  }
+  return out;
+}
+
+static uint8_t* Write32(uint8_t* out, uint32_t val) {
+  wpi::support::endian::write32le(out, val);
+  return out + 4;
+}
+
+static uint8_t* WriteString(uint8_t* out, std::string_view str) {
+  out = Write32(out, str.size());
+  std::memcpy(out, str.data(), str.size());
+  return out + str.size();
+}
+
+static uint8_t* WriteFloat(uint8_t* out, float val) {
+  uint32_t bits;
+  std::memcpy(&bits, &val, 4);
+  wpi::support::endian::write32le(out, bits);
+  return out + 4;
+}
+
+static uint8_t* WriteDouble(uint8_t* out, double val) {
+  uint64_t bits;
+  std::memcpy(&bits, &val, 8);
+  wpi::support::endian::write64le(out, bits);
+  return out + 8;
+}
+
+static int64_t Timestamp(int64_t timestamp) {
+  return timestamp == 0 ? wpi::Now() : timestamp;
+}
+
+static std::function<void(wpi::span<const uint8_t> data)> MakeFileWriter(
+    std::string_view filename, std::error_code& ec) {
+  auto os = std::make_shared<wpi::raw_fd_ostream>(filename, ec);
+  if (ec) {
+    return [](auto) {};
+  }
+  return [os](wpi::span<const uint8_t> data) {
+    os->write(reinterpret_cast<const char*>(data.data()), data.size());
+    os->flush();
+  };
+}
+
+DataLog::DataLog(std::string_view filename, std::error_code& ec,
+                 double period, std::string_view extraHeader)
+    : DataLog{MakeFileWriter(filename, ec), period, extraHeader} {}
+
+DataLog::DataLog(std::function<void(span<const uint8_t> data)> write,
+                 double period, std::string_view extraHeader)
+    : m_write{std::move(write)} {
+  m_active.reserve(kBufferSize);
+  m_spare.reserve(kBufferSize);
+
+  m_active.resize(12 + extraHeader.size());
+  uint8_t* out = m_active.data();
+  std::memcpy(out, "WPILOG", 6);
+  wpi::support::endian::write16le(out + 6, 0x0100);
+  WriteString(out + 8, extraHeader);
+
+  m_thread = std::thread{[=] { WriterThreadMain(period); }};
+}
+
+DataLog::~DataLog() {
+  {
+    std::scoped_lock lock{m_mutex};
+    m_shutdown = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+}
+
+void DataLog::Flush() {
+  {
+    std::scoped_lock lock{m_mutex};
+    m_flush = true;
+  }
+  m_cond.notify_all();
+}
+
+void DataLog::Pause() {
+  std::scoped_lock lock{m_mutex};
+  m_paused = true;
+}
+
+void DataLog::Resume() {
+  std::scoped_lock lock{m_mutex};
+  m_paused = false;
+}
+
+uint64_t DataLog::GetDroppedRecords() const {
+  std::scoped_lock lock{m_mutex};
+  return m_dropped;
+}
+
+void DataLog::WriterThreadMain(double period) {
+  auto timeout = std::chrono::duration<double>(period);
+  std::unique_lock lock{m_mutex};
+
+  // the writer owns the spare half while writing it
+  auto writeSpare = [&] {
+    m_spareState = kWriting;
+    lock.unlock();
+    m_write(m_spare);
+    lock.lock();
+    m_spare.clear();
+    m_spareState = kFree;
+  };
+
+  while (!m_shutdown || !m_active.empty() || m_spareState == kFull) {
+    if (!m_shutdown) {
+      m_cond.wait_for(lock, timeout, [&] {
+        return m_shutdown || m_flush || m_spareState == kFull;
+      });
+    }
+    m_flush = false;
+    if (m_spareState == kFull) {
+      writeSpare();
+    }
+    if (!m_active.empty()) {
+      std::swap(m_active, m_spare);
+      writeSpare();
+    }
+  }
+}
+
+uint8_t* DataLog::Reserve(int entry, size_t payloadSize, int64_t timestamp,
+                          bool control) {
+  size_t idLen = ByteLength(entry);
+  size_t sizeLen = ByteLength(payloadSize);
+  size_t timeLen = ByteLength(timestamp);
+  size_t size = 1 + idLen + sizeLen + timeLen + payloadSize;
+
+  if (m_active.size() + size > kBufferSize && !control) {
+    if (m_spareState != kFree) {
+      ++m_dropped;
+      return nullptr;
+    }
+    // hand the full half to the writer; a record bigger than a whole half
+    // still goes in (by itself)
+    if (!m_active.empty()) {
+      std::swap(m_active, m_spare);
+      m_spareState = kFull;
+      m_cond.notify_all();
+    }
+  }
+
+  size_t pos = m_active.size();
+  m_active.resize(pos + size);
+  uint8_t* out = &m_active[pos];
+  *out++ = (idLen - 1) | ((sizeLen - 1) << 2) | ((timeLen - 1) << 4);
+  out = WriteVarInt(out, entry, idLen);
+  out = WriteVarInt(out, payloadSize, sizeLen);
+  return WriteVarInt(out, timestamp, timeLen);
+}
+
+int DataLog::Start(std::string_view name, std::string_view type,
+                   std::string_view metadata, int64_t timestamp) {
+  timestamp = Timestamp(timestamp);
+  std::scoped_lock lock{m_mutex};
+  auto& info = m_entries[name];
+  if (info.count > 0) {
+    if (info.type != type) {
+      return 0;
+    }
+    ++info.count;
+    return info.id;
+  }
+  info.type = type;
+  info.id = ++m_lastId;
+  info.count = 1;
+
+  uint8_t* out = Reserve(0,
+                         1 + 4 + 4 + name.size() + 4 + type.size() + 4 +
+                             metadata.size(),
+                         timestamp, true);
+  *out++ = kControlStart;
+  out = Write32(out, info.id);
+  out = WriteString(out, name);
+  out = WriteString(out, type);
+  WriteString(out, metadata);
+  return info.id;
+}
+
+void DataLog::Finish(int entry, int64_t timestamp) {
+  if (entry <= 0) {
+    return;
+  }
+  timestamp = Timestamp(timestamp);
+  std::scoped_lock lock{m_mutex};
+  // finishing is rare enough to search for the entry
+  auto it = m_entries.begin();
+  for (; it != m_entries.end(); ++it) {
+    if (it->second.id == entry) {
+      break;
+    }
+  }
+  if (it == m_entries.end() || --it->second.count > 0) {
+    return;
+  }
+  m_entries.erase(it);
+
+  uint8_t* out = Reserve(0, 1 + 4, timestamp, true);
+  *out++ = kControlFinish;
+  Write32(out, entry);
+}
+
+void DataLog::SetMetadata(int entry, std::string_view metadata,
+                          int64_t timestamp) {
+  if (entry <= 0) {
+    return;
+  }
+  timestamp = Timestamp(timestamp);
+  std::scoped_lock lock{m_mutex};
+  uint8_t* out = Reserve(0, 1 + 4 + 4 + metadata.size(), timestamp, true);
+  *out++ = kControlSetMetadata;
+  out = Write32(out, entry);
+  WriteString(out, metadata);
+}
+
+uint8_t* DataLog::ReserveData(int entry, size_t payloadSize,
+                              int64_t timestamp) {
+  if (entry <= 0 || m_paused) {
+    return nullptr;
+  }
+  return Reserve(entry, payloadSize, Timestamp(timestamp), false);
+}
+
+void DataLog::AppendRaw(int entry, span<const uint8_t> data,
+                        int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, data.size(), timestamp)) {
+    std::memcpy(out, data.data(), data.size());
+  }
+}
+
+void DataLog::AppendBoolean(int entry, bool value, int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, 1, timestamp)) {
+    *out = value ? 1 : 0;
+  }
+}
+
+void DataLog::AppendInteger(int entry, int64_t value, int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, 8, timestamp)) {
+    wpi::support::endian::write64le(out, value);
+  }
+}
+
+void DataLog::AppendFloat(int entry, float value, int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, 4, timestamp)) {
+    WriteFloat(out, value);
+  }
+}
+
+void DataLog::AppendDouble(int entry, double value, int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, 8, timestamp)) {
+    WriteDouble(out, value);
+  }
+}
+
+void DataLog::AppendString(int entry, std::string_view value,
+                           int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, value.size(), timestamp)) {
+    std::memcpy(out, value.data(), value.size());
+  }
+}
+
+void DataLog::AppendBooleanArray(int entry, span<const bool> arr,
+                                 int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, arr.size(), timestamp)) {
+    for (bool value : arr) {
+      *out++ = value ? 1 : 0;
+    }
+  }
+}
+
+void DataLog::AppendBooleanArray(int entry, span<const int> arr,
+                                 int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, arr.size(), timestamp)) {
+    for (int value : arr) {
+      *out++ = value ? 1 : 0;
+    }
+  }
+}
+
+void DataLog::AppendIntegerArray(int entry, span<const int64_t> arr,
+                                 int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, arr.size() * 8, timestamp)) {
+    for (int64_t value : arr) {
+      wpi::support::endian::write64le(out, value);
+      out += 8;
+    }
+  }
+}
+
+void DataLog::AppendFloatArray(int entry, span<const float> arr,
+                               int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, arr.size() * 4, timestamp)) {
+    for (float value : arr) {
+      out = WriteFloat(out, value);
+    }
+  }
+}
+
+void DataLog::AppendDoubleArray(int entry, span<const double> arr,
+                                int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, arr.size() * 8, timestamp)) {
+    for (double value : arr) {
+      out = WriteDouble(out, value);
+    }
+  }
+}
+
+template <typename T>
+static void WriteStringArray(uint8_t* out, wpi::span<const T> arr) {
+  out = Write32(out, arr.size());
+  for (auto&& str : arr) {
+    out = WriteString(out, str);
+  }
+}
+
+template <typename T>
+static size_t StringArraySize(wpi::span<const T> arr) {
+  size_t size = 4;
+  for (auto&& str : arr) {
+    size += 4 + str.size();
+  }
+  return size;
+}
+
+void DataLog::AppendStringArray(int entry, span<const std::string> arr,
+                                int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, StringArraySize(arr), timestamp)) {
+    WriteStringArray(out, arr);
+  }
+}
+
+void DataLog::AppendStringArray(int entry, span<const std::string_view> arr,
+                                int64_t timestamp) {
+  std::scoped_lock lock{m_mutex};
+  if (uint8_t* out = ReserveData(entry, StringArraySize(arr), timestamp)) {
+    WriteStringArray(out, arr);
+  }
+}
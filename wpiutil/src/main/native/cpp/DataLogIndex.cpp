@@ -0,0 +1,134 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogIndex.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace wpi::log;
+
+DataLogIndex::DataLogIndex(const fs::path& path, std::error_code& ec)
+    : m_mapping{path, MappedFileRegion::kReadOnly, ec},
+      m_reader{m_mapping.bytes()} {
+  Build();
+}
+
+DataLogIndex::DataLogIndex(span<const uint8_t> data) : m_reader{data} {
+  Build();
+}
+
+const DataLogIndex::Entry* DataLogIndex::Find(std::string_view name) const {
+  for (auto it = m_entries.rbegin(), end = m_entries.rend(); it != end; ++it) {
+    if (it->name == name) {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
+
+DataLogRecord DataLogIndex::GetRecord(const Entry& entry, size_t i) const {
+  DataLogRecord record;
+  m_reader.GetRecordAt(entry.offsets[i], &record);
+  return record;
+}
+
+size_t DataLogIndex::Seek(const Entry& entry, int64_t timestamp) const {
+  auto it = std::upper_bound(
+      entry.offsets.begin(), entry.offsets.end(), timestamp,
+      [&](int64_t ts, uint64_t offset) { return ts < GetTimestamp(offset); });
+  if (it == entry.offsets.begin()) {
+    return kNone;
+  }
+  return it - entry.offsets.begin() - 1;
+}
+
+int64_t DataLogIndex::GetTimestamp(uint64_t offset) const {
+  DataLogRecord record;
+  m_reader.GetRecordAt(offset, &record);
+  return record.GetTimestamp();
+}
+
+void DataLogIndex::Build() {
+  if (!m_reader.IsValid()) {
+    return;
+  }
+  if (m_mapping) {
+    m_mapping.Advise(MappedFileRegion::kSequential);
+  }
+
+  // the index in m_entries of each started log entry ID
+  std::unordered_map<int, size_t> started;
+  // whether each entry's records are in timestamp order so far, and the
+  // timestamp of its last record
+  std::vector<bool> sorted;
+  std::vector<int64_t> lastTimestamp;
+  bool first = true;
+
+  for (auto it = m_reader.begin(), end = m_reader.end(); it != end; ++it) {
+    auto& record = *it;
+    int64_t timestamp = record.GetTimestamp();
+    if (first) {
+      m_startTimestamp = timestamp;
+      m_endTimestamp = timestamp;
+      first = false;
+    } else {
+      m_startTimestamp = (std::min)(m_startTimestamp, timestamp);
+      m_endTimestamp = (std::max)(m_endTimestamp, timestamp);
+    }
+
+    if (record.IsControl()) {
+      StartRecordData start;
+      int finished;
+      MetadataRecordData metadata;
+      if (record.GetStartData(&start)) {
+        started[start.entry] = m_entries.size();
+        m_entries.push_back({start.entry, start.name, start.type,
+                             start.metadata, timestamp, INT64_MAX, {}});
+        sorted.push_back(true);
+        lastTimestamp.push_back(INT64_MIN);
+      } else if (record.GetFinishEntry(&finished)) {
+        auto entry = started.find(finished);
+        if (entry != started.end()) {
+          m_entries[entry->second].finishTimestamp = timestamp;
+          started.erase(entry);
+        }
+      } else if (record.GetSetMetadataData(&metadata)) {
+        auto entry = started.find(metadata.entry);
+        if (entry != started.end()) {
+          m_entries[entry->second].metadata = metadata.metadata;
+        }
+      }
+      continue;
+    }
+
+    // records of entries that were never started are ignored
+    auto entry = started.find(record.GetEntry());
+    if (entry == started.end()) {
+      continue;
+    }
+    size_t i = entry->second;
+    if (timestamp < lastTimestamp[i]) {
+      sorted[i] = false;
+    }
+    lastTimestamp[i] = timestamp;
+    m_entries[i].offsets.push_back(it.GetOffset());
+  }
+
+  // records are normally appended in time order, but an entry's timestamps
+  // can come from more than one clock
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    if (!sorted[i]) {
+      std::stable_sort(m_entries[i].offsets.begin(),
+                       m_entries[i].offsets.end(),
+                       [&](uint64_t a, uint64_t b) {
+                         return GetTimestamp(a) < GetTimestamp(b);
+                       });
+    }
+  }
+
+  if (m_mapping) {
+    m_mapping.Advise(MappedFileRegion::kRandom);
+  }
+}
@@ -0,0 +1,251 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogReader.h"
+
+#include <cstring>
+
+#include "wpi/Endian.h"
+
+using namespace wpi::log;
+
+static constexpr uint8_t kControlStart = 0;
+static constexpr uint8_t kControlFinish = 1;
+static constexpr uint8_t kControlSetMetadata = 2;
+
+static uint64_t ReadVarInt(const uint8_t* in, size_t len) {
+  uint64_t val = 0;
+  for (size_t i = 0; i < len; ++i) {
+    val |= static_cast<uint64_t>(in[i]) << (i * 8);
+  }
+  return val;
+}
+
+// Reads a 32-bit length and that many bytes from the front of data
+static bool ReadString(wpi::span<const uint8_t>* data, std::string_view* str) {
+  if (data->size() < 4) {
+    return false;
+  }
+  uint32_t len = wpi::support::endian::read32le(data->data());
+  if (len > data->size() - 4) {
+    return false;
+  }
+  *str = {reinterpret_cast<const char*>(data->data() + 4), len};
+  *data = data->subspan(4 + len);
+  return true;
+}
+
+bool DataLogRecord::IsStart() const {
+  return m_entry == 0 && m_data.size() >= 17 && m_data[0] == kControlStart;
+}
+
+bool DataLogRecord::IsFinish() const {
+  return m_entry == 0 && m_data.size() == 5 && m_data[0] == kControlFinish;
+}
+
+bool DataLogRecord::IsSetMetadata() const {
+  return m_entry == 0 && m_data.size() >= 9 &&
+         m_data[0] == kControlSetMetadata;
+}
+
+bool DataLogRecord::GetStartData(StartRecordData* out) const {
+  if (!IsStart()) {
+    return false;
+  }
+  out->entry = wpi::support::endian::read32le(&m_data[1]);
+  auto data = m_data.subspan(5);
+  return ReadString(&data, &out->name) && ReadString(&data, &out->type) &&
+         ReadString(&data, &out->metadata);
+}
+
+bool DataLogRecord::GetFinishEntry(int* out) const {
+  if (!IsFinish()) {
+    return false;
+  }
+  *out = wpi::support::endian::read32le(&m_data[1]);
+  return true;
+}
+
+bool DataLogRecord::GetSetMetadataData(MetadataRecordData* out) const {
+  if (!IsSetMetadata()) {
+    return false;
+  }
+  out->entry = wpi::support::endian::read32le(&m_data[1]);
+  auto data = m_data.subspan(5);
+  return ReadString(&data, &out->metadata);
+}
+
+bool DataLogRecord::GetBoolean(bool* value) const {
+  if (m_data.size() != 1) {
+    return false;
+  }
+  *value = m_data[0] != 0;
+  return true;
+}
+
+bool DataLogRecord::GetInteger(int64_t* value) const {
+  if (m_data.size() != 8) {
+    return false;
+  }
+  *value = wpi::support::endian::read64le(m_data.data());
+  return true;
+}
+
+bool DataLogRecord::GetFloat(float* value) const {
+  if (m_data.size() != 4) {
+    return false;
+  }
+  uint32_t bits = wpi::support::endian::read32le(m_data.data());
+  std::memcpy(value, &bits, 4);
+  return true;
+}
+
+bool DataLogRecord::GetDouble(double* value) const {
+  if (m_data.size() != 8) {
+    return false;
+  }
+  uint64_t bits = wpi::support::endian::read64le(m_data.data());
+  std::memcpy(value, &bits, 8);
+  return true;
+}
+
+bool DataLogRecord::GetString(std::string_view* value) const {
+  *value = {reinterpret_cast<const char*>(m_data.data()), m_data.size()};
+  return true;
+}
+
+bool DataLogRecord::GetBooleanArray(std::vector<int>* arr) const {
+  arr->clear();
+  arr->reserve(m_data.size());
+  for (uint8_t value : m_data) {
+    arr->push_back(value != 0);
+  }
+  return true;
+}
+
+bool DataLogRecord::GetIntegerArray(std::vector<int64_t>* arr) const {
+  arr->clear();
+  if ((m_data.size() % 8) != 0) {
+    return false;
+  }
+  arr->reserve(m_data.size() / 8);
+  for (size_t pos = 0; pos < m_data.size(); pos += 8) {
+    arr->push_back(wpi::support::endian::read64le(&m_data[pos]));
+  }
+  return true;
+}
+
+bool DataLogRecord::GetFloatArray(std::vector<float>* arr) const {
+  arr->clear();
+  if ((m_data.size() % 4) != 0) {
+    return false;
+  }
+  arr->reserve(m_data.size() / 4);
+  for (size_t pos = 0; pos < m_data.size(); pos += 4) {
+    uint32_t bits = wpi::support::endian::read32le(&m_data[pos]);
+    float value;
+    std::memcpy(&value, &bits, 4);
+    arr->push_back(value);
+  }
+  return true;
+}
+
+bool DataLogRecord::GetDoubleArray(std::vector<double>* arr) const {
+  arr->clear();
+  if ((m_data.size() % 8) != 0) {
+    return false;
+  }
+  arr->reserve(m_data.size() / 8);
+  for (size_t pos = 0; pos < m_data.size(); pos += 8) {
+    uint64_t bits = wpi::support::endian::read64le(&m_data[pos]);
+    double value;
+    std::memcpy(&value, &bits, 8);
+    arr->push_back(value);
+  }
+  return true;
+}
+
+bool DataLogRecord::GetStringArray(std::vector<std::string_view>* arr) const {
+  arr->clear();
+  if (m_data.size() < 4) {
+    return false;
+  }
+  uint32_t count = wpi::support::endian::read32le(m_data.data());
+  // each string takes at least 4 bytes
+  if (count > (m_data.size() - 4) / 4) {
+    return false;
+  }
+  arr->reserve(count);
+  auto data = m_data.subspan(4);
+  for (uint32_t i = 0; i < count; ++i) {
+    std::string_view str;
+    if (!ReadString(&data, &str)) {
+      arr->clear();
+      return false;
+    }
+    arr->push_back(str);
+  }
+  return data.empty();
+}
+
+bool DataLogReader::IsValid() const {
+  if (m_data.size() < 12 ||
+      std::string_view{reinterpret_cast<const char*>(m_data.data()), 6} !=
+          "WPILOG") {
+    return false;
+  }
+  // only major version 1 is understood
+  if (wpi::support::endian::read16le(&m_data[6]) < 0x0100 ||
+      wpi::support::endian::read16le(&m_data[6]) >= 0x0200) {
+    return false;
+  }
+  return wpi::support::endian::read32le(&m_data[8]) <= m_data.size() - 12;
+}
+
+uint16_t DataLogReader::GetVersion() const {
+  if (!IsValid()) {
+    return 0;
+  }
+  return wpi::support::endian::read16le(&m_data[6]);
+}
+
+std::string_view DataLogReader::GetExtraHeader() const {
+  if (!IsValid()) {
+    return {};
+  }
+  return {reinterpret_cast<const char*>(&m_data[12]),
+          wpi::support::endian::read32le(&m_data[8])};
+}
+
+DataLogReader::iterator DataLogReader::begin() const {
+  if (!IsValid()) {
+    return end();
+  }
+  return {this, 12 + wpi::support::endian::read32le(&m_data[8])};
+}
+
+bool DataLogReader::GetRecord(size_t pos, size_t* next,
+                              DataLogRecord* record) const {
+  if (pos >= m_data.size()) {
+    return false;
+  }
+  uint8_t header = m_data[pos];
+  size_t idLen = (header & 0x3) + 1;
+  size_t sizeLen = ((header >> 2) & 0x3) + 1;
+  size_t timeLen = ((header >> 4) & 0x7) + 1;
+  size_t headerLen = 1 + idLen + sizeLen + timeLen;
+  if (m_data.size() - pos < headerLen) {
+    return false;
+  }
+  const uint8_t* in = &m_data[pos + 1];
+  int entry = ReadVarInt(in, idLen);
+  uint64_t size = ReadVarInt(in + idLen, sizeLen);
+  int64_t timestamp = ReadVarInt(in + idLen + sizeLen, timeLen);
+  if (size > m_data.size() - pos - headerLen) {
+    return false;
+  }
+  *record = {entry, timestamp, m_data.subspan(pos + headerLen, size)};
+  *next = pos + headerLen + size;
+  return true;
+}
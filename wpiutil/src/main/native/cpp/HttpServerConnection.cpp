@@ -4,16 +4,36 @@
 
 #include "wpi/HttpServerConnection.h"
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
 #include "fmt/format.h"
 #include "wpi/SmallString.h"
 #include "wpi/SmallVector.h"
 #include "wpi/SpanExtras.h"
 #include "wpi/StringExtras.h"
 #include "wpi/fmt/raw_ostream.h"
+#include "wpi/fs.h"
 #include "wpi/raw_uv_ostream.h"
 
 using namespace wpi;
 
+// Files are read into write buffers of this size
+static constexpr size_t kFileBlockSize = 64 * 1024;
+
+// Strips a weak validator prefix; If-None-Match uses weak comparison
+static std::string_view StripWeak(std::string_view etag) {
+  if (wpi::starts_with(etag, "W/")) {
+    etag.remove_prefix(2);
+  }
+  return etag;
+}
+
 HttpServerConnection::HttpServerConnection(std::shared_ptr<uv::Stream> stream)
     : m_stream(*stream) {
   // process HTTP messages
@@ -21,15 +41,26 @@ HttpServerConnection::HttpServerConnection(std::shared_ptr<uv::Stream> stream)
       m_request.messageComplete.connect_connection([this](bool keepAlive) {
         m_keepAlive = keepAlive;
         ProcessRequest();
+        // the connection closes once the response is written, so stop
+        // parsing any requests pipelined after this one
+        if (!m_keepAlive) {
+          m_request.Pause(true);
+        }
       });
 
-  // look for Accept-Encoding headers to determine if gzip is acceptable
-  m_request.messageBegin.connect([this] { m_acceptGzip = false; });
+  // look for Accept-Encoding headers to determine if gzip is acceptable,
+  // and If-None-Match headers for cached responses
+  m_request.messageBegin.connect([this] {
+    m_acceptGzip = false;
+    m_ifNoneMatch.clear();
+  });
   m_request.header.connect(
       [this](std::string_view name, std::string_view value) {
         if (wpi::equals_lower(name, "accept-encoding") &&
             wpi::contains(value, "gzip")) {
           m_acceptGzip = true;
+        } else if (wpi::equals_lower(name, "if-none-match")) {
+          m_ifNoneMatch = value;
         }
       });
 
@@ -37,7 +68,7 @@ HttpServerConnection::HttpServerConnection(std::shared_ptr<uv::Stream> stream)
   m_dataConn =
       stream->data.connect_connection([this](uv::Buffer& buf, size_t size) {
         m_request.Execute({buf.base, size});
-        if (m_request.HasError()) {
+        if (m_request.HasError() && m_request.GetError() != HPE_PAUSED) {
           // could not parse; just close the connection
           m_stream.Close();
         }
@@ -52,6 +83,11 @@ HttpServerConnection::HttpServerConnection(std::shared_ptr<uv::Stream> stream)
 }
 
 void HttpServerConnection::BuildCommonHeaders(raw_ostream& os) {
+  if (m_revalidate) {
+    os << "Server: WebServer/1.0\r\n"
+          "Cache-Control: no-cache\r\n";
+    return;
+  }
   os << "Server: WebServer/1.0\r\n"
         "Cache-Control: no-store, no-cache, must-revalidate, pre-check=0, "
         "post-check=0, max-age=0\r\n"
@@ -66,7 +102,7 @@ void HttpServerConnection::BuildHeader(raw_ostream& os, int code,
                                        std::string_view extra) {
   fmt::print(os, "HTTP/{}.{} {} {}\r\n", m_request.GetMajor(),
              m_request.GetMinor(), code, codeText);
-  if (contentLength == 0) {
+  if (contentLength == 0 && code != 304) {
     m_keepAlive = false;
   }
   if (!m_keepAlive) {
@@ -137,6 +173,114 @@ void HttpServerConnection::SendStaticResponse(
   });
 }
 
+void HttpServerConnection::SendCacheableResponse(std::string_view contentType,
+                                                 std::string_view content,
+                                                 bool gzipped,
+                                                 std::string_view etag,
+                                                 std::string_view extraHeader) {
+  m_revalidate = true;
+  auto extra = fmt::format("ETag: {}\r\n{}{}", etag,
+                           gzipped ? "Vary: Accept-Encoding\r\n" : "",
+                           extraHeader);
+  if (IsNotModified(etag)) {
+    SendResponse(304, "Not Modified", contentType, {}, extra);
+  } else {
+    SendStaticResponse(200, "OK", contentType, content, gzipped, extra);
+  }
+  m_revalidate = false;
+}
+
+bool HttpServerConnection::SendFileResponse(int code,
+                                            std::string_view codeText,
+                                            std::string_view contentType,
+                                            std::string_view filename,
+                                            std::string_view extraHeader) {
+  std::error_code ec;
+  fs::path path{filename};
+  auto size = fs::file_size(path, ec);
+  if (ec) {
+    return false;
+  }
+  auto mtime = fs::last_write_time(path, ec);
+  if (ec) {
+    return false;
+  }
+  auto etag = fmt::format("\"{:x}-{:x}\"", mtime.time_since_epoch().count(),
+                          size);
+  auto extra = fmt::format("ETag: {}\r\n{}", etag, extraHeader);
+
+  m_revalidate = true;
+  if (code == 200 && IsNotModified(etag)) {
+    SendResponse(304, "Not Modified", contentType, {}, extra);
+    m_revalidate = false;
+    return true;
+  }
+
+  fs::file_t file = fs::OpenFileForRead(path, ec, fs::OF_None);
+  if (ec) {
+    m_revalidate = false;
+    return false;
+  }
+  int fd = fs::FileToFd(file, ec, fs::OF_None);
+  if (ec) {
+    m_revalidate = false;
+    return false;
+  }
+
+  SmallVector<uv::Buffer, 4> bufs;
+  raw_uv_ostream os{bufs, 4096};
+  BuildHeader(os, code, codeText, contentType, size, extra);
+  m_revalidate = false;
+
+  // read the content straight into the write buffers
+  for (uint64_t left = size; left > 0;) {
+    auto buf = uv::Buffer::Allocate(
+        static_cast<size_t>((std::min)(left, uint64_t{kFileBlockSize})));
+#ifdef _WIN32
+    int count = ::_read(fd, buf.base, buf.len);
+#else
+    ssize_t count = ::read(fd, buf.base, buf.len);
+#endif
+    if (count <= 0) {
+      // the file shrank; the length has been sent, so give up on the
+      // connection
+      buf.Deallocate();
+      m_keepAlive = false;
+      break;
+    }
+    buf.len = static_cast<decltype(buf.len)>(count);
+    bufs.emplace_back(buf);
+    left -= count;
+  }
+#ifdef _WIN32
+  ::_close(fd);
+#else
+  ::close(fd);
+#endif
+
+  SendData(bufs, !m_keepAlive);
+  return true;
+}
+
+bool HttpServerConnection::IsNotModified(std::string_view etag) const {
+  std::string_view header = wpi::trim(m_ifNoneMatch);
+  if (header.empty()) {
+    return false;
+  }
+  if (header == "*") {
+    return true;
+  }
+  etag = StripWeak(etag);
+  while (!header.empty()) {
+    auto [tag, rest] = wpi::split(header, ',');
+    if (StripWeak(wpi::trim(tag)) == etag) {
+      return true;
+    }
+    header = rest;
+  }
+  return false;
+}
+
 void HttpServerConnection::SendError(int code, std::string_view message) {
   std::string_view codeText, extra, baseMessage;
   switch (code) {
@@ -4,14 +4,232 @@
 
 #include "wpi/Logger.h"
 
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "wpi/BoundedConcurrentQueue.h"
+#include "wpi/DenseMap.h"
+
 using namespace wpi;
 
+namespace {
+struct LogRecord {
+  LogRecord(unsigned int level_, const char* file_, unsigned int line_,
+            std::string_view msg_)
+      : level{level_}, file{file_}, line{line_}, msg{msg_} {}
+
+  unsigned int level;
+  const char* file;
+  unsigned int line;
+  std::string msg;
+};
+
+// A thread's queued messages
+struct LogBuffer {
+  explicit LogBuffer(size_t size) : queue{size} {}
+
+  SpscQueue<LogRecord> queue;
+};
+}  // namespace
+
+namespace wpi::detail {
+class AsyncLogThread : public SafeThread {
+ public:
+  AsyncLogThread(Logger::LogFunc func, size_t bufferSize)
+      : m_func{std::make_shared<Logger::LogFunc>(std::move(func))},
+        m_bufferSize{bufferSize} {}
+
+  void Main() override;
+
+  void Push(unsigned int level, const char* file, unsigned int line,
+            std::string_view msg);
+  void SetFunc(Logger::LogFunc func);
+  void Flush();
+
+  std::atomic<uint64_t> m_dropped{0};
+
+ private:
+  LogBuffer& GetBuffer();
+  bool HasQueued() const;
+
+  // Distinguishes the per-thread buffers of different async loggers.  Ids are
+  // never reused, so a thread's cached buffer pointer for a logger that no
+  // longer exists is never looked up again.
+  static inline std::atomic<uint64_t> gNextId{0};
+  const uint64_t m_id = ++gNextId;
+
+  // Protected by m_mutex
+  std::shared_ptr<Logger::LogFunc> m_func;
+  std::vector<std::unique_ptr<LogBuffer>> m_buffers;
+  int m_flushWaiters = 0;
+  uint64_t m_passes = 0;
+  wpi::condition_variable m_flushCond;
+
+  const size_t m_bufferSize;
+  std::atomic_bool m_sleeping{false};
+};
+}  // namespace wpi::detail
+
+using detail::AsyncLogThread;
+
+LogBuffer& AsyncLogThread::GetBuffer() {
+  static thread_local DenseMap<uint64_t, LogBuffer*> buffers;
+  auto& buffer = buffers[m_id];
+  if (!buffer) {
+    std::scoped_lock lock(m_mutex);
+    buffer = m_buffers.emplace_back(std::make_unique<LogBuffer>(m_bufferSize))
+                 .get();
+  }
+  return *buffer;
+}
+
+bool AsyncLogThread::HasQueued() const {
+  for (auto&& buffer : m_buffers) {
+    if (!buffer->queue.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AsyncLogThread::Push(unsigned int level, const char* file,
+                          unsigned int line, std::string_view msg) {
+  if (!GetBuffer().queue.try_emplace(level, file, line, msg)) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // Pairs with the fence in Main(): either the sleeping flag is seen here, or
+  // Main() sees the message before it sleeps
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_sleeping.load(std::memory_order_relaxed)) {
+    { std::scoped_lock lock(m_mutex); }
+    m_cond.notify_one();
+  }
+}
+
+void AsyncLogThread::SetFunc(Logger::LogFunc func) {
+  auto newFunc = std::make_shared<Logger::LogFunc>(std::move(func));
+  std::scoped_lock lock(m_mutex);
+  m_func = std::move(newFunc);
+}
+
+void AsyncLogThread::Flush() {
+  std::unique_lock lock(m_mutex);
+  // The pass running now may have already passed some buffers, so wait for
+  // the one after it to finish
+  uint64_t done = m_passes + 2;
+  ++m_flushWaiters;
+  m_cond.notify_one();
+  m_flushCond.wait(lock, [&] { return m_passes >= done || !m_active; });
+  --m_flushWaiters;
+}
+
+void AsyncLogThread::Main() {
+  std::vector<LogBuffer*> buffers;
+  uint64_t reportedDropped = 0;
+  std::unique_lock lock(m_mutex);
+  for (;;) {
+    m_sleeping = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_cond.wait(lock, [&] {
+      return !m_active || m_flushWaiters != 0 || HasQueued();
+    });
+    m_sleeping = false;
+    bool active = m_active;
+
+    // The sink may be slow, so call it without the lock
+    buffers.clear();
+    for (auto&& buffer : m_buffers) {
+      buffers.emplace_back(buffer.get());
+    }
+    auto func = m_func;
+    lock.unlock();
+
+    LogRecord record{0, nullptr, 0, {}};
+    for (auto buffer : buffers) {
+      while (buffer->queue.try_pop(record)) {
+        (*func)(record.level, record.file, record.line, record.msg.c_str());
+      }
+    }
+
+    uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != reportedDropped) {
+      auto msg = fmt::format("dropped {} log messages (buffer full)",
+                             dropped - reportedDropped);
+      (*func)(WPI_LOG_WARNING, __FILE__, __LINE__, msg.c_str());
+      reportedDropped = dropped;
+    }
+
+    lock.lock();
+    ++m_passes;
+    m_flushCond.notify_all();
+    if (!active) {
+      break;
+    }
+  }
+}
+
+Logger::~Logger() {
+  DisableAsync();
+}
+
+void Logger::SetLogger(LogFunc func) {
+  if (m_async) {
+    m_async->SetFunc(func);
+  }
+  m_func = std::move(func);
+}
+
+void Logger::EnableAsync(size_t bufferSize) {
+  if (m_async) {
+    return;
+  }
+  m_asyncOwner.Start(m_func, bufferSize);
+  m_async = m_asyncOwner.GetThreadSharedPtr();
+}
+
+void Logger::DisableAsync() {
+  if (!m_async) {
+    return;
+  }
+  // Stop under the lock so Main() can't miss the wakeup; it delivers the
+  // queued messages before exiting
+  {
+    std::scoped_lock lock(m_async->m_mutex);
+    m_async->m_active = false;
+  }
+  m_async->m_cond.notify_all();
+  m_asyncOwner.Join();
+  m_async.reset();
+}
+
+void Logger::Flush() {
+  if (m_async) {
+    m_async->Flush();
+  }
+}
+
+uint64_t Logger::GetDroppedCount() const {
+  return m_async ? m_async->m_dropped.load(std::memory_order_relaxed) : 0;
+}
+
+void Logger::DoLogAsync(unsigned int level, const char* file,
+                        unsigned int line, std::string_view msg) {
+  m_async->Push(level, file, line, msg);
+}
+
 void Logger::DoLog(unsigned int level, const char* file, unsigned int line,
                    const char* msg) {
   if (!m_func || level < m_min_level) {
     return;
   }
-  m_func(level, file, line, msg);
+  if (m_async) {
+    DoLogAsync(level, file, line, msg);
+  } else {
+    m_func(level, file, line, msg);
+  }
 }
 
 void Logger::LogV(unsigned int level, const char* file, unsigned int line,
@@ -21,6 +239,10 @@ void Logger::LogV(unsigned int level, const char* file, unsigned int line,
   }
   fmt::memory_buffer out;
   fmt::vformat_to(fmt::appender{out}, format, args);
+  if (m_async) {
+    DoLogAsync(level, file, line, {out.data(), out.size()});
+    return;
+  }
   out.push_back('\0');
   m_func(level, file, line, out.data());
 }
@@ -0,0 +1,199 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MappedFileRegion.h"
+
+#include <sys/types.h>
+
+#include <cerrno>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include "wpi/MathExtras.h"
+#include "wpi/WindowsError.h"
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace wpi;
+
+MappedFileRegion::MappedFileRegion(fs::file_t f, uint64_t length,
+                                   uint64_t offset, MapMode mapMode,
+                                   std::error_code& ec) {
+  ec = std::error_code();
+#ifdef _WIN32
+  if (f == fs::kInvalidFile) {
+    ec = wpi::mapWindowsError(ERROR_INVALID_HANDLE);
+    return;
+  }
+
+  DWORD flprotect;
+  DWORD dwDesiredAccess;
+  switch (mapMode) {
+    case kReadOnly:
+      flprotect = PAGE_READONLY;
+      dwDesiredAccess = FILE_MAP_READ;
+      break;
+    case kReadWrite:
+      flprotect = PAGE_READWRITE;
+      dwDesiredAccess = FILE_MAP_WRITE;
+      break;
+    case kPriv:
+      flprotect = PAGE_WRITECOPY;
+      dwDesiredAccess = FILE_MAP_COPY;
+      break;
+  }
+
+  HANDLE fileMappingHandle =
+      ::CreateFileMappingW(f, 0, flprotect, Hi_32(offset + length),
+                           Lo_32(offset + length), 0);
+  if (fileMappingHandle == nullptr) {
+    ec = wpi::mapWindowsError(GetLastError());
+    return;
+  }
+
+  m_mapping = ::MapViewOfFile(fileMappingHandle, dwDesiredAccess,
+                              Hi_32(offset), Lo_32(offset), length);
+  if (m_mapping == nullptr) {
+    ec = wpi::mapWindowsError(GetLastError());
+    ::CloseHandle(fileMappingHandle);
+    return;
+  }
+
+  // with a zero length the view is the rest of the file
+  size_t size = length;
+  if (length == 0) {
+    MEMORY_BASIC_INFORMATION mbi;
+    SIZE_T result = VirtualQuery(m_mapping, &mbi, sizeof(mbi));
+    if (result == 0) {
+      ec = wpi::mapWindowsError(GetLastError());
+      ::UnmapViewOfFile(m_mapping);
+      ::CloseHandle(fileMappingHandle);
+      m_mapping = nullptr;
+      return;
+    }
+    size = mbi.RegionSize;
+  }
+
+  // the view keeps the mapping object alive
+  ::CloseHandle(fileMappingHandle);
+
+  // Flush() needs a handle to the file, which the caller may close
+  if (!::DuplicateHandle(::GetCurrentProcess(), f, ::GetCurrentProcess(),
+                         &m_fileHandle, 0, 0, DUPLICATE_SAME_ACCESS)) {
+    ec = wpi::mapWindowsError(GetLastError());
+    ::UnmapViewOfFile(m_mapping);
+    m_mapping = nullptr;
+    return;
+  }
+  m_size = size;
+#else
+  int prot = (mapMode == kReadOnly) ? PROT_READ : (PROT_READ | PROT_WRITE);
+  int flags = (mapMode == kReadWrite) ? MAP_SHARED : MAP_PRIVATE;
+  m_mapping = ::mmap(nullptr, length, prot, flags, f, offset);
+  if (m_mapping == MAP_FAILED) {
+    ec = std::error_code(errno, std::generic_category());
+    m_mapping = nullptr;
+    return;
+  }
+  m_size = length;
+#endif
+}
+
+MappedFileRegion::MappedFileRegion(const fs::path& path, MapMode mapMode,
+                                   std::error_code& ec) {
+  auto size = fs::file_size(path, ec);
+  if (ec || size == 0) {
+    // there's nothing to map in an empty file
+    return;
+  }
+  fs::file_t f = mapMode == kReadWrite
+                     ? fs::OpenFileForReadWrite(path, ec, fs::CD_OpenExisting,
+                                                fs::OF_None)
+                     : fs::OpenFileForRead(path, ec);
+  if (ec) {
+    return;
+  }
+  *this = MappedFileRegion(f, size, 0, mapMode, ec);
+  fs::CloseFile(f);
+}
+
+void MappedFileRegion::Flush() {
+#ifdef _WIN32
+  if (!::FlushViewOfFile(m_mapping, 0)) {
+    return;
+  }
+  if (m_fileHandle) {
+    ::FlushFileBuffers(m_fileHandle);
+  }
+#else
+  if (m_mapping) {
+    ::msync(m_mapping, m_size, MS_SYNC);
+  }
+#endif
+}
+
+void MappedFileRegion::Advise(Advice advice) {
+#ifndef _WIN32
+  if (!m_mapping) {
+    return;
+  }
+  int native;
+  switch (advice) {
+    case kSequential:
+      native = MADV_SEQUENTIAL;
+      break;
+    case kRandom:
+      native = MADV_RANDOM;
+      break;
+    case kWillNeed:
+      native = MADV_WILLNEED;
+      break;
+    default:
+      native = MADV_NORMAL;
+      break;
+  }
+  ::madvise(m_mapping, m_size, native);
+#endif
+}
+
+void MappedFileRegion::Unmap() {
+  if (!m_mapping) {
+    return;
+  }
+#ifdef _WIN32
+  ::UnmapViewOfFile(m_mapping);
+  if (m_fileHandle) {
+    ::CloseHandle(m_fileHandle);
+    m_fileHandle = nullptr;
+  }
+#else
+  ::munmap(m_mapping, m_size);
+#endif
+  m_mapping = nullptr;
+}
+
+size_t MappedFileRegion::GetAlignment() {
+#ifdef _WIN32
+  SYSTEM_INFO sysInfo;
+  ::GetSystemInfo(&sysInfo);
+  return sysInfo.dwAllocationGranularity;
+#else
+  static long pageSize = ::sysconf(_SC_PAGESIZE);  // NOLINT
+  return pageSize;
+#endif
+}
+
+MappedFileRegion raw_mapped_istream::Map(std::string_view filename,
+                                         std::error_code& ec) {
+  MappedFileRegion region{fs::path{filename}, MappedFileRegion::kReadOnly, ec};
+  region.Advise(MappedFileRegion::kSequential);
+  return region;
+}
@@ -0,0 +1,225 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MemoryResource.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "wpi/MemAlloc.h"
+
+using namespace wpi;
+
+static constexpr size_t kMaxAlign = MemoryResource::kMaxAlign;
+
+static char* AlignUp(char* p, size_t alignment) {
+  auto addr = reinterpret_cast<uintptr_t>(p);
+  return reinterpret_cast<char*>((addr + alignment - 1) & ~(alignment - 1));
+}
+
+namespace {
+class HeapMemoryResource : public MemoryResource {
+ protected:
+  void* DoAllocate(size_t bytes, size_t alignment) override {
+    if (alignment <= kMaxAlign) {
+      return safe_malloc(bytes == 0 ? 1 : bytes);
+    }
+    // Over-aligned: keep the pointer malloc returned just before the block
+    auto base =
+        static_cast<char*>(safe_malloc(bytes + alignment + sizeof(void*)));
+    char* p = AlignUp(base + sizeof(void*), alignment);
+    reinterpret_cast<void**>(p)[-1] = base;
+    return p;
+  }
+
+  void DoDeallocate(void* p, size_t bytes, size_t alignment) override {
+    if (alignment <= kMaxAlign) {
+      std::free(p);
+    } else {
+      std::free(static_cast<void**>(p)[-1]);
+    }
+  }
+};
+}  // namespace
+
+MemoryResource* wpi::GetHeapMemoryResource() {
+  static HeapMemoryResource* resource = new HeapMemoryResource;
+  return resource;
+}
+
+struct MonotonicArena::Chunk {
+  Chunk* next;
+  size_t size;
+};
+
+// Chunk data starts after the header, maximally aligned
+static constexpr size_t kArenaHeaderSize =
+    (sizeof(void*) * 2 + kMaxAlign - 1) & ~(kMaxAlign - 1);
+
+MonotonicArena::MonotonicArena(size_t chunkSize, MemoryResource* upstream)
+    : m_upstream{upstream},
+      m_buffer{nullptr},
+      m_bufferSize{0},
+      m_nextChunkSize{std::max<size_t>(chunkSize, 64)},
+      m_pos{nullptr},
+      m_end{nullptr} {}
+
+MonotonicArena::MonotonicArena(void* buffer, size_t size,
+                               MemoryResource* upstream)
+    : m_upstream{upstream},
+      m_buffer{static_cast<char*>(buffer)},
+      m_bufferSize{size},
+      m_nextChunkSize{std::max<size_t>(size * 2, 64)},
+      m_pos{m_buffer},
+      m_end{m_buffer + size} {}
+
+MonotonicArena::~MonotonicArena() {
+  Release();
+}
+
+void MonotonicArena::Reset() {
+  m_current = nullptr;
+  m_pos = m_buffer;
+  m_end = m_buffer ? m_buffer + m_bufferSize : nullptr;
+  m_used = 0;
+}
+
+void MonotonicArena::Release() {
+  while (m_chunks) {
+    Chunk* next = m_chunks->next;
+    m_upstream->Deallocate(m_chunks, kArenaHeaderSize + m_chunks->size,
+                           kMaxAlign);
+    m_chunks = next;
+  }
+  Reset();
+}
+
+bool MonotonicArena::Fit(size_t bytes, size_t alignment, void** result) {
+  if (!m_pos) {
+    return false;
+  }
+  char* p = AlignUp(m_pos, alignment);
+  if (p > m_end || static_cast<size_t>(m_end - p) < bytes) {
+    return false;
+  }
+  *result = p;
+  m_pos = p + bytes;
+  return true;
+}
+
+void* MonotonicArena::DoAllocate(size_t bytes, size_t alignment) {
+  m_used += bytes;
+  void* result;
+  if (Fit(bytes, alignment, &result)) {
+    return result;
+  }
+
+  // Move on through the chunks kept from before the last Reset()
+  for (;;) {
+    Chunk* next = m_current ? m_current->next : m_chunks;
+    if (!next) {
+      break;
+    }
+    m_current = next;
+    m_pos = reinterpret_cast<char*>(next) + kArenaHeaderSize;
+    m_end = m_pos + next->size;
+    if (Fit(bytes, alignment, &result)) {
+      return result;
+    }
+  }
+
+  // Add a chunk at the end
+  size_t size = std::max(m_nextChunkSize, bytes + alignment);
+  m_nextChunkSize = size * 2;
+  auto chunk = static_cast<Chunk*>(
+      m_upstream->Allocate(kArenaHeaderSize + size, kMaxAlign));
+  chunk->next = nullptr;
+  chunk->size = size;
+  if (m_current) {
+    m_current->next = chunk;
+  } else {
+    m_chunks = chunk;
+  }
+  m_current = chunk;
+  m_pos = reinterpret_cast<char*>(chunk) + kArenaHeaderSize;
+  m_end = m_pos + size;
+  Fit(bytes, alignment, &result);
+  return result;
+}
+
+static constexpr size_t kPoolHeaderSize =
+    (sizeof(void*) + kMaxAlign - 1) & ~(kMaxAlign - 1);
+
+static size_t ClassIndex(size_t bytes, size_t minSize) {
+  size_t index = 0;
+  for (size_t size = minSize; size < bytes; size <<= 1) {
+    ++index;
+  }
+  return index;
+}
+
+PoolResource::PoolResource(MemoryResource* upstream) : m_upstream{upstream} {}
+
+PoolResource::~PoolResource() {
+  Release();
+}
+
+void PoolResource::Release() {
+  while (m_chunks) {
+    Chunk* next = m_chunks->next;
+    m_upstream->Deallocate(m_chunks, kPoolHeaderSize + kChunkSize, kMaxAlign);
+    m_chunks = next;
+  }
+  std::fill(std::begin(m_free), std::end(m_free), nullptr);
+  m_pos = nullptr;
+  m_end = nullptr;
+}
+
+void* PoolResource::DoAllocate(size_t bytes, size_t alignment) {
+  if (bytes > kMaxPooledSize || alignment > kMaxAlign) {
+    return m_upstream->Allocate(bytes, alignment);
+  }
+  size_t index = ClassIndex(bytes, kMinPooledSize);
+  if (Block* block = m_free[index]) {
+    m_free[index] = block->next;
+    return block;
+  }
+
+  size_t size = kMinPooledSize << index;
+  if (static_cast<size_t>(m_end - m_pos) < size) {
+    // Put what's left of the chunk in the free lists, largest blocks first
+    for (size_t i = kNumClasses; i-- > 0;) {
+      size_t blockSize = kMinPooledSize << i;
+      while (static_cast<size_t>(m_end - m_pos) >= blockSize) {
+        auto block = reinterpret_cast<Block*>(m_pos);
+        block->next = m_free[i];
+        m_free[i] = block;
+        m_pos += blockSize;
+      }
+    }
+
+    auto chunk = static_cast<Chunk*>(
+        m_upstream->Allocate(kPoolHeaderSize + kChunkSize, kMaxAlign));
+    chunk->next = m_chunks;
+    m_chunks = chunk;
+    m_pos = reinterpret_cast<char*>(chunk) + kPoolHeaderSize;
+    m_end = m_pos + kChunkSize;
+  }
+  void* result = m_pos;
+  m_pos += size;
+  return result;
+}
+
+void PoolResource::DoDeallocate(void* p, size_t bytes, size_t alignment) {
+  if (bytes > kMaxPooledSize || alignment > kMaxAlign) {
+    m_upstream->Deallocate(p, bytes, alignment);
+    return;
+  }
+  size_t index = ClassIndex(bytes, kMinPooledSize);
+  auto block = static_cast<Block*>(p);
+  block->next = m_free[index];
+  m_free[index] = block;
+}
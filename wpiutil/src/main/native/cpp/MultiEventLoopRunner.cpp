@@ -0,0 +1,111 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MultiEventLoopRunner.h"
+
+#ifdef _WIN32
+#include <WinSock2.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <thread>
+
+#include "wpi/uv/Tcp.h"
+
+using namespace wpi;
+
+// Duplicates the socket of a handle so it can be opened on another loop.
+static bool DupSocket(uv::Tcp& tcp, uv_os_sock_t* sock) {
+  uv_os_fd_t fd;
+  if (uv_fileno(tcp.GetRawHandle(), &fd) != 0) {
+    return false;
+  }
+#ifdef _WIN32
+  WSAPROTOCOL_INFOW info;
+  if (WSADuplicateSocketW(reinterpret_cast<SOCKET>(fd), GetCurrentProcessId(),
+                          &info) != 0) {
+    return false;
+  }
+  *sock = WSASocketW(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO,
+                     &info, 0, WSA_FLAG_OVERLAPPED);
+  return *sock != INVALID_SOCKET;
+#else
+  *sock = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  return *sock >= 0;
+#endif
+}
+
+static void CloseSocket(uv_os_sock_t sock) {
+#ifdef _WIN32
+  ::closesocket(sock);
+#else
+  ::close(sock);
+#endif
+}
+
+MultiEventLoopRunner::MultiEventLoopRunner(size_t numShards) {
+  if (numShards == 0) {
+    numShards = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  m_shards.reserve(numShards);
+  for (size_t i = 0; i < numShards; ++i) {
+    m_shards.push_back({std::make_unique<EventLoopRunner>(),
+                        std::make_shared<std::atomic<size_t>>(0)});
+  }
+}
+
+MultiEventLoopRunner::~MultiEventLoopRunner() {
+  Stop();
+}
+
+void MultiEventLoopRunner::Stop() {
+  // stop accepting before stopping the shards connections are handed to
+  m_acceptor.Stop();
+  for (auto& shard : m_shards) {
+    shard.runner->Stop();
+  }
+}
+
+void MultiEventLoopRunner::ExecSyncAll(LoopFunc func) {
+  for (auto& shard : m_shards) {
+    shard.runner->ExecSync(func);
+  }
+}
+
+bool MultiEventLoopRunner::HandOff(uv::Tcp& client, ConnectionFunc func) {
+  uv_os_sock_t sock;
+  if (!DupSocket(client, &sock)) {
+    return false;
+  }
+  client.Close();
+
+  auto& shard = *std::min_element(
+      m_shards.begin(), m_shards.end(), [](const auto& a, const auto& b) {
+        return a.connections->load(std::memory_order_relaxed) <
+               b.connections->load(std::memory_order_relaxed);
+      });
+  shard.connections->fetch_add(1, std::memory_order_relaxed);
+  shard.runner->ExecAsync([sock, func = std::move(func),
+                           connections = shard.connections](uv::Loop& loop) {
+    auto tcp = uv::Tcp::Create(loop);
+    if (!tcp) {
+      CloseSocket(sock);
+      connections->fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+    tcp->closed.connect([connections] {
+      connections->fetch_sub(1, std::memory_order_relaxed);
+    });
+    if (uv_tcp_open(tcp->GetRaw(), sock) != 0) {
+      CloseSocket(sock);
+      tcp->Close();
+      return;
+    }
+    func(loop, std::move(tcp));
+  });
+  return true;
+}
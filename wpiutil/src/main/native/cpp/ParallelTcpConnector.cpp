@@ -0,0 +1,295 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/ParallelTcpConnector.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "fmt/format.h"
+#include "wpi/Logger.h"
+#include "wpi/uv/GetAddrInfo.h"
+#include "wpi/uv/Loop.h"
+#include "wpi/uv/Tcp.h"
+#include "wpi/uv/util.h"
+
+using namespace wpi;
+
+static size_t AddrLen(const sockaddr& addr) {
+  switch (addr.sa_family) {
+    case AF_INET:
+      return sizeof(sockaddr_in);
+    case AF_INET6:
+      return sizeof(sockaddr_in6);
+    default:
+      return 0;
+  }
+}
+
+static std::string AddrToString(const sockaddr_storage& addr) {
+  std::string ip;
+  unsigned int port = 0;
+  int err;
+  switch (addr.ss_family) {
+    case AF_INET:
+      err = uv::AddrToName(reinterpret_cast<const sockaddr_in&>(addr), &ip,
+                           &port);
+      break;
+    case AF_INET6:
+      err = uv::AddrToName(reinterpret_cast<const sockaddr_in6&>(addr), &ip,
+                           &port);
+      break;
+    default:
+      return "unknown address";
+  }
+  if (err != 0) {
+    return "unknown address";
+  }
+  return fmt::format("{} port {}", ip, port);
+}
+
+std::shared_ptr<ParallelTcpConnector> ParallelTcpConnector::Create(
+    uv::Loop& loop, uv::Timer::Time reconnectRate, Logger& logger) {
+  auto connector = std::make_shared<ParallelTcpConnector>(
+      loop, reconnectRate, logger, private_init{});
+  if (!connector->m_reconnectTimer || !connector->m_attemptTimer) {
+    return nullptr;
+  }
+  return connector;
+}
+
+ParallelTcpConnector::ParallelTcpConnector(uv::Loop& loop,
+                                           uv::Timer::Time reconnectRate,
+                                           Logger& logger, const private_init&)
+    : m_loop{loop},
+      m_logger{logger},
+      m_reconnectRate{reconnectRate},
+      m_reconnectTimer{uv::Timer::Create(loop)},
+      m_attemptTimer{uv::Timer::Create(loop)} {
+  // the timers are closed with the connector, so can't outlive it
+  if (m_reconnectTimer) {
+    m_reconnectTimer->timeout.connect([this] {
+      if (!m_isConnected) {
+        Connect();
+      }
+    });
+  }
+  if (m_attemptTimer) {
+    m_attemptTimer->timeout.connect([this] { StartNextAttempt(); });
+  }
+}
+
+ParallelTcpConnector::~ParallelTcpConnector() {
+  Close();
+}
+
+void ParallelTcpConnector::Close() {
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+  CancelAll();
+  if (m_reconnectTimer) {
+    m_reconnectTimer->Close();
+  }
+  if (m_attemptTimer) {
+    m_attemptTimer->Close();
+  }
+}
+
+void ParallelTcpConnector::SetServers(
+    span<const std::pair<std::string, unsigned int>> servers) {
+  if (!std::equal(servers.begin(), servers.end(), m_servers.begin(),
+                  m_servers.end())) {
+    m_servers.assign(servers.begin(), servers.end());
+    m_haveCached = false;
+    if (!m_isConnected) {
+      Connect();
+    }
+  } else if (!m_isConnected && !IsConnecting()) {
+    Connect();
+  }
+}
+
+void ParallelTcpConnector::Disconnected() {
+  m_isConnected = false;
+  Connect();
+}
+
+void ParallelTcpConnector::Connect() {
+  if (m_closed || m_isConnected || m_servers.empty()) {
+    return;
+  }
+  CancelAll();
+  ++m_round;
+  m_reconnectTimer->Start(m_reconnectRate);
+
+  // the last winner goes first, without waiting for any name to resolve
+  if (m_haveCached) {
+    m_pending.push_back(m_cached);
+    m_seen.push_back(m_cached.addr);
+  }
+  for (size_t i = 0; i < m_servers.size(); ++i) {
+    Resolve(i);
+  }
+  StartNextAttempt();
+}
+
+void ParallelTcpConnector::CancelAll() {
+  if (m_attemptTimer) {
+    m_attemptTimer->Stop();
+  }
+  for (auto&& weak : m_resolvers) {
+    if (auto req = weak.lock()) {
+      req->Cancel();
+    }
+  }
+  for (auto&& weak : m_attempts) {
+    if (auto tcp = weak.lock()) {
+      tcp->Close();
+    }
+  }
+  m_resolvers.clear();
+  m_attempts.clear();
+  m_pending.clear();
+  m_seen.clear();
+  m_outstanding = 0;
+}
+
+void ParallelTcpConnector::Resolve(size_t server) {
+  auto req = std::make_shared<uv::GetAddrInfoReq>();
+  req->resolved.connect([weak = weak_from_this(), round = m_round,
+                         server](const addrinfo& info) {
+    auto self = weak.lock();
+    if (!self || self->m_round != round) {
+      return;
+    }
+    for (auto ai = &info; ai; ai = ai->ai_next) {
+      if (ai->ai_addr) {
+        self->AddCandidate(*ai->ai_addr, server);
+      }
+    }
+    self->AttemptDone();
+  });
+  req->error = [weak = weak_from_this(), round = m_round,
+                server](uv::Error err) {
+    auto self = weak.lock();
+    if (!self || self->m_round != round) {
+      return;
+    }
+    WPI_DEBUG1(self->m_logger, "could not resolve {}: {}",
+               self->m_servers[server].first, err.str());
+    self->AttemptDone();
+  };
+
+  addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = m_family;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_protocol = IPPROTO_TCP;
+
+  ++m_outstanding;
+  m_resolvers.emplace_back(req);
+  uv::GetAddrInfo(m_loop, req, m_servers[server].first,
+                  fmt::to_string(m_servers[server].second), &hints);
+}
+
+void ParallelTcpConnector::AddCandidate(const sockaddr& addr, size_t server) {
+  size_t len = AddrLen(addr);
+  if (len == 0 || (m_family != AF_UNSPEC && addr.sa_family != m_family)) {
+    return;
+  }
+
+  // several names often resolve to the same address
+  Candidate candidate;
+  std::memset(&candidate.addr, 0, sizeof(candidate.addr));
+  std::memcpy(&candidate.addr, &addr, len);
+  candidate.server = server;
+  for (auto&& seen : m_seen) {
+    if (std::memcmp(&seen, &candidate.addr, len) == 0) {
+      return;
+    }
+  }
+  m_seen.push_back(candidate.addr);
+  m_pending.push_back(candidate);
+
+  // start it now, unless an attempt is still within its delay
+  if (!m_attemptTimer->IsActive()) {
+    StartNextAttempt();
+  }
+}
+
+void ParallelTcpConnector::StartNextAttempt() {
+  if (m_pending.empty()) {
+    return;
+  }
+  Candidate candidate = m_pending.front();
+  m_pending.pop_front();
+
+  auto tcp = uv::Tcp::Create(m_loop);
+  if (!tcp) {
+    return;
+  }
+  ++m_outstanding;
+  m_attempts.emplace_back(tcp);
+  m_attemptTimer->Start(m_attemptDelay);
+
+  tcp->error.connect([weak = weak_from_this(), round = m_round,
+                      tcpPtr = tcp.get(), candidate](uv::Error err) {
+    auto self = weak.lock();
+    if (!self || self->m_round != round) {
+      return;
+    }
+    WPI_DEBUG1(self->m_logger, "connect to {} ({}) failed: {}",
+               self->m_servers[candidate.server].first,
+               AddrToString(candidate.addr), err.str());
+    tcpPtr->Close();
+    // the next attempt needn't wait out the delay
+    self->m_attemptTimer->Stop();
+    self->StartNextAttempt();
+    self->AttemptDone();
+  });
+
+  WPI_DEBUG1(m_logger, "connecting to {} ({})",
+             m_servers[candidate.server].first, AddrToString(candidate.addr));
+  tcp->Connect(reinterpret_cast<const sockaddr&>(candidate.addr),
+               [weak = weak_from_this(), round = m_round, tcpPtr = tcp.get(),
+                candidate] {
+                 auto self = weak.lock();
+                 if (!self || self->m_round != round || self->m_isConnected) {
+                   tcpPtr->Close();
+                   return;
+                 }
+                 self->Succeeded(*tcpPtr, candidate);
+               });
+}
+
+void ParallelTcpConnector::AttemptDone() {
+  if (--m_outstanding != 0 || !m_pending.empty() || m_isConnected) {
+    return;
+  }
+  WPI_DEBUG(m_logger, "could not connect to any of {} servers",
+            m_servers.size());
+  failed();
+}
+
+void ParallelTcpConnector::Succeeded(uv::Tcp& tcp, const Candidate& candidate) {
+  WPI_INFO(m_logger, "connected to {} ({})", m_servers[candidate.server].first,
+           AddrToString(candidate.addr));
+  m_isConnected = true;
+  m_haveCached = true;
+  m_cached = candidate;
+  m_reconnectTimer->Stop();
+
+  // hand this one off and abandon the rest
+  m_attempts.erase(std::remove_if(m_attempts.begin(), m_attempts.end(),
+                                  [&](const auto& weak) {
+                                    return weak.lock().get() == &tcp;
+                                  }),
+                   m_attempts.end());
+  CancelAll();
+  ++m_round;
+
+  connected(tcp);
+}
@@ -4,19 +4,43 @@
 
 #include "wpi/PortForwarder.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+#include <atomic>
+
 #include "fmt/format.h"
 #include "wpi/DenseMap.h"
-#include "wpi/EventLoopRunner.h"
+#include "wpi/MultiEventLoopRunner.h"
 #include "wpi/uv/GetAddrInfo.h"
+#include "wpi/uv/Poll.h"
 #include "wpi/uv/Tcp.h"
 #include "wpi/uv/Timer.h"
 
 using namespace wpi;
 
+namespace {
+struct Counters {
+  std::atomic<uint64_t> connections{0};
+  std::atomic<uint64_t> bytesToRemote{0};
+  std::atomic<uint64_t> bytesFromRemote{0};
+};
+
+struct Server {
+  std::weak_ptr<uv::Tcp> tcp;
+  std::shared_ptr<Counters> counters;
+};
+}  // namespace
+
 struct PortForwarder::Impl {
  public:
-  EventLoopRunner runner;
-  DenseMap<unsigned int, std::weak_ptr<uv::Tcp>> servers;
+  MultiEventLoopRunner runner;
+  DenseMap<unsigned int, Server> servers;
 };
 
 PortForwarder::PortForwarder() : m_impl{new Impl} {}
@@ -26,10 +50,15 @@ PortForwarder& PortForwarder::GetInstance() {
   return instance;
 }
 
-static void CopyStream(uv::Stream& in, std::weak_ptr<uv::Stream> outWeak) {
-  in.data.connect([&in, outWeak](uv::Buffer& buf, size_t len) {
-    uv::Buffer buf2 = buf.Dup();
+static void CopyStream(uv::Stream& in, std::weak_ptr<uv::Stream> outWeak,
+                       std::shared_ptr<Counters> counters,
+                       std::atomic<uint64_t> Counters::*bytes) {
+  in.data.connect([&in, outWeak, counters, bytes](uv::Buffer& buf,
+                                                   size_t len) {
+    // hand the read buffer itself to the write
+    uv::Buffer buf2 = buf.Move();
     buf2.len = len;
+    ((*counters).*bytes).fetch_add(len, std::memory_order_relaxed);
     auto out = outWeak.lock();
     if (!out) {
       buf2.Deallocate();
@@ -44,114 +73,337 @@ static void CopyStream(uv::Stream& in, std::weak_ptr<uv::Stream> outWeak) {
   });
 }
 
-void PortForwarder::Add(unsigned int port, std::string_view remoteHost,
-                        unsigned int remotePort) {
-  m_impl->runner.ExecSync([&](uv::Loop& loop) {
-    auto server = uv::Tcp::Create(loop);
+#ifdef __linux__
+namespace {
+// Relays between two connected sockets through a pipe in each direction with
+// splice(), so forwarded data never leaves the kernel.  The sockets are
+// duplicated and polled directly; their Tcp handles are left idle and closed
+// along with the relay.
+class SpliceRelay {
+ public:
+  // Side 0 is the client, side 1 the remote.  Returns false (leaving the
+  // handles untouched) if the relay can't be set up.
+  static bool Start(uv::Tcp& client, uv::Tcp& remote,
+                    std::shared_ptr<Counters> counters);
 
-    // bind to local port
-    server->Bind("", port);
+  SpliceRelay(uv::Tcp& client, uv::Tcp& remote,
+              std::shared_ptr<Counters> counters)
+      : m_tcps{client.shared_from_this(), remote.shared_from_this()},
+        m_counters{std::move(counters)} {}
+  ~SpliceRelay();
 
-    // when we get a connection, accept it
-    server->connection.connect([serverPtr = server.get(),
-                                host = std::string{remoteHost}, remotePort] {
-      auto& loop = serverPtr->GetLoopRef();
-      auto client = serverPtr->Accept();
-      if (!client) {
-        return;
+  SpliceRelay(const SpliceRelay&) = delete;
+  SpliceRelay& operator=(const SpliceRelay&) = delete;
+
+ private:
+  // Not more than a pipe holds by default
+  static constexpr size_t kPipeSize = 65536;
+
+  // A direction of the relay; m_pipes[i] carries data from side i.
+  struct Pipe {
+    int rd = -1;
+    int wr = -1;
+    size_t pending = 0;
+    bool eof = false;
+    bool shutdown = false;
+  };
+
+  void Pump(int from);
+  void UpdateEvents();
+  void Close();
+
+  std::weak_ptr<uv::Tcp> m_tcps[2];
+  int m_fds[2] = {-1, -1};
+  std::weak_ptr<uv::Poll> m_polls[2];
+  int m_events[2] = {0, 0};
+  Pipe m_pipes[2];
+  std::shared_ptr<Counters> m_counters;
+  bool m_closed = false;
+};
+}  // namespace
+
+bool SpliceRelay::Start(uv::Tcp& client, uv::Tcp& remote,
+                        std::shared_ptr<Counters> counters) {
+  auto relay =
+      std::make_shared<SpliceRelay>(client, remote, std::move(counters));
+  uv::Tcp* tcps[2] = {&client, &remote};
+  for (int i = 0; i < 2; ++i) {
+    uv_os_fd_t fd;
+    if (uv_fileno(tcps[i]->GetRawHandle(), &fd) != 0) {
+      return false;
+    }
+    relay->m_fds[i] = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    int pipefd[2];
+    if (relay->m_fds[i] < 0 || pipe2(pipefd, O_NONBLOCK | O_CLOEXEC) != 0) {
+      return false;
+    }
+    relay->m_pipes[i].rd = pipefd[0];
+    relay->m_pipes[i].wr = pipefd[1];
+  }
+
+  std::shared_ptr<uv::Poll> polls[2];
+  for (int i = 0; i < 2; ++i) {
+    polls[i] = uv::Poll::Create(client.GetLoopRef(), relay->m_fds[i]);
+    if (!polls[i]) {
+      if (i == 1) {
+        polls[0]->Close();
+      }
+      return false;
+    }
+  }
+  for (int i = 0; i < 2; ++i) {
+    // the polls keep the relay alive until they're closed
+    polls[i]->SetData(relay);
+    polls[i]->pollEvent.connect([r = relay.get(), i](int events) {
+      if (events & (UV_READABLE | UV_DISCONNECT)) {
+        r->Pump(i);
+      }
+      if (events & UV_WRITABLE) {
+        r->Pump(1 - i);
+      }
+    });
+    polls[i]->error.connect([r = relay.get()](uv::Error) { r->Close(); });
+    relay->m_polls[i] = polls[i];
+  }
+  relay->UpdateEvents();
+  return true;
+}
+
+SpliceRelay::~SpliceRelay() {
+  for (int i = 0; i < 2; ++i) {
+    for (int fd : {m_fds[i], m_pipes[i].rd, m_pipes[i].wr}) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+  }
+}
+
+void SpliceRelay::Pump(int from) {
+  if (m_closed) {
+    return;
+  }
+  auto& pipe = m_pipes[from];
+  int to = 1 - from;
+  if (!pipe.eof && pipe.pending < kPipeSize) {
+    ssize_t n = splice(m_fds[from], nullptr, pipe.wr, nullptr,
+                       kPipeSize - pipe.pending,
+                       SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (n == 0) {
+      pipe.eof = true;
+    } else if (n > 0) {
+      pipe.pending += n;
+    } else if (errno != EAGAIN) {
+      Close();
+      return;
+    }
+  }
+  if (pipe.pending > 0) {
+    ssize_t n = splice(pipe.rd, nullptr, m_fds[to], nullptr, pipe.pending,
+                       SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (n > 0) {
+      pipe.pending -= n;
+      (from == 0 ? m_counters->bytesToRemote : m_counters->bytesFromRemote)
+          .fetch_add(n, std::memory_order_relaxed);
+    } else if (n < 0 && errno != EAGAIN) {
+      Close();
+      return;
+    }
+  }
+  // pass on the end of the stream once the pipe is drained, and close both
+  // when both sides have ended
+  if (pipe.eof && pipe.pending == 0 && !pipe.shutdown) {
+    pipe.shutdown = true;
+    ::shutdown(m_fds[to], SHUT_WR);
+    if (m_pipes[to].shutdown) {
+      Close();
+      return;
+    }
+  }
+  UpdateEvents();
+}
+
+void SpliceRelay::UpdateEvents() {
+  for (int i = 0; i < 2; ++i) {
+    int events = 0;
+    if (!m_pipes[i].eof && m_pipes[i].pending < kPipeSize) {
+      events |= UV_READABLE | UV_DISCONNECT;
+    }
+    if (m_pipes[1 - i].pending > 0) {
+      events |= UV_WRITABLE;
+    }
+    if (events == m_events[i]) {
+      continue;
+    }
+    m_events[i] = events;
+    if (auto poll = m_polls[i].lock()) {
+      if (events == 0) {
+        poll->Stop();
+      } else {
+        poll->Start(events);
       }
+    }
+  }
+}
 
-      // close on error
-      client->error.connect(
-          [clientPtr = client.get()](uv::Error err) { clientPtr->Close(); });
+void SpliceRelay::Close() {
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+  for (int i = 0; i < 2; ++i) {
+    if (auto poll = m_polls[i].lock()) {
+      poll->Close();
+    }
+    if (auto tcp = m_tcps[i].lock()) {
+      tcp->Close();
+    }
+  }
+}
+#endif
+
+// Forwards a client connection to the remote host.
+static void Forward(uv::Loop& loop, std::shared_ptr<uv::Tcp> client,
+                    const std::string& host, unsigned int remotePort,
+                    const std::shared_ptr<Counters>& counters) {
+  // close on error
+  client->error.connect(
+      [clientPtr = client.get()](uv::Error err) { clientPtr->Close(); });
+
+  // connected flag
+  auto connected = std::make_shared<bool>(false);
+  client->SetData(connected);
+
+  auto remote = uv::Tcp::Create(loop);
+  remote->error.connect(
+      [remotePtr = remote.get(),
+       clientWeak = std::weak_ptr<uv::Tcp>(client)](uv::Error err) {
+        remotePtr->Close();
+        if (auto client = clientWeak.lock()) {
+          client->Close();
+        }
+      });
+
+  // resolve address
+  uv::GetAddrInfo(
+      loop,
+      [clientWeak = std::weak_ptr<uv::Tcp>(client),
+       remoteWeak = std::weak_ptr<uv::Tcp>(remote),
+       counters](const addrinfo& addr) {
+        auto remote = remoteWeak.lock();
+        if (!remote) {
+          return;
+        }
 
-      // connected flag
-      auto connected = std::make_shared<bool>(false);
-      client->SetData(connected);
+        // connect to remote address/port
+        remote->Connect(*addr.ai_addr, [remotePtr = remote.get(), remoteWeak,
+                                        clientWeak, counters] {
+          auto client = clientWeak.lock();
+          if (!client) {
+            remotePtr->Close();
+            return;
+          }
+          *(client->GetData<bool>()) = true;
+
+#ifdef __linux__
+          if (SpliceRelay::Start(*client, *remotePtr, counters)) {
+            return;
+          }
+#endif
 
-      auto remote = uv::Tcp::Create(loop);
-      remote->error.connect(
-          [remotePtr = remote.get(),
-           clientWeak = std::weak_ptr<uv::Tcp>(client)](uv::Error err) {
+          // close both when either side closes
+          client->end.connect([clientPtr = client.get(), remoteWeak] {
+            clientPtr->Close();
+            if (auto remote = remoteWeak.lock()) {
+              remote->Close();
+            }
+          });
+          remotePtr->end.connect([remotePtr, clientWeak] {
             remotePtr->Close();
             if (auto client = clientWeak.lock()) {
               client->Close();
             }
           });
 
-      // resolve address
-      uv::GetAddrInfo(
-          loop,
-          [clientWeak = std::weak_ptr<uv::Tcp>(client),
-           remoteWeak = std::weak_ptr<uv::Tcp>(remote)](const addrinfo& addr) {
-            auto remote = remoteWeak.lock();
-            if (!remote) {
-              return;
-            }
+          // copy bidirectionally
+          client->StartRead();
+          remotePtr->StartRead();
+          CopyStream(*client, remoteWeak, counters, &Counters::bytesToRemote);
+          CopyStream(*remotePtr, clientWeak, counters,
+                     &Counters::bytesFromRemote);
+        });
+      },
+      host, fmt::to_string(remotePort));
 
-            // connect to remote address/port
-            remote->Connect(*addr.ai_addr, [remotePtr = remote.get(),
-                                            remoteWeak, clientWeak] {
-              auto client = clientWeak.lock();
-              if (!client) {
-                remotePtr->Close();
-                return;
-              }
-              *(client->GetData<bool>()) = true;
-
-              // close both when either side closes
-              client->end.connect([clientPtr = client.get(), remoteWeak] {
-                clientPtr->Close();
-                if (auto remote = remoteWeak.lock()) {
-                  remote->Close();
-                }
-              });
-              remotePtr->end.connect([remotePtr, clientWeak] {
-                remotePtr->Close();
-                if (auto client = clientWeak.lock()) {
-                  client->Close();
-                }
-              });
-
-              // copy bidirectionally
-              client->StartRead();
-              remotePtr->StartRead();
-              CopyStream(*client, remoteWeak);
-              CopyStream(*remotePtr, clientWeak);
-            });
-          },
-          host, fmt::to_string(remotePort));
-
-      // time out for connection
-      uv::Timer::SingleShot(loop, uv::Timer::Time{500},
-                            [connectedWeak = std::weak_ptr<bool>(connected),
-                             clientWeak = std::weak_ptr<uv::Tcp>(client),
-                             remoteWeak = std::weak_ptr<uv::Tcp>(remote)] {
-                              if (auto connected = connectedWeak.lock()) {
-                                if (!*connected) {
-                                  if (auto client = clientWeak.lock()) {
-                                    client->Close();
-                                  }
-                                  if (auto remote = remoteWeak.lock()) {
-                                    remote->Close();
-                                  }
-                                }
+  // time out for connection
+  uv::Timer::SingleShot(loop, uv::Timer::Time{500},
+                        [connectedWeak = std::weak_ptr<bool>(connected),
+                         clientWeak = std::weak_ptr<uv::Tcp>(client),
+                         remoteWeak = std::weak_ptr<uv::Tcp>(remote)] {
+                          if (auto connected = connectedWeak.lock()) {
+                            if (!*connected) {
+                              if (auto client = clientWeak.lock()) {
+                                client->Close();
                               }
-                            });
+                              if (auto remote = remoteWeak.lock()) {
+                                remote->Close();
+                              }
+                            }
+                          }
+                        });
+}
+
+void PortForwarder::Add(unsigned int port, std::string_view remoteHost,
+                        unsigned int remotePort) {
+  m_impl->runner.GetAcceptor().ExecSync([&](uv::Loop& loop) {
+    auto server = uv::Tcp::Create(loop);
+    auto counters = std::make_shared<Counters>();
+
+    // bind to local port
+    server->Bind("", port);
+
+    // when we get a connection, accept it
+    server->connection.connect([serverPtr = server.get(),
+                                runner = &m_impl->runner,
+                                host = std::string{remoteHost}, remotePort,
+                                counters] {
+      auto client = serverPtr->Accept();
+      if (!client) {
+        return;
+      }
+      counters->connections.fetch_add(1, std::memory_order_relaxed);
+
+      // serve the connection from the least busy loop
+      runner->HandOff(*client, [host, remotePort, counters](
+                                   uv::Loop& loop, auto client) {
+        Forward(loop, std::move(client), host, remotePort, counters);
+      });
     });
 
     // start listening for incoming connections
     server->Listen();
 
-    m_impl->servers[port] = server;
+    m_impl->servers[port] = Server{server, counters};
   });
 }
 
 void PortForwarder::Remove(unsigned int port) {
-  m_impl->runner.ExecSync([&](uv::Loop& loop) {
-    if (auto server = m_impl->servers.lookup(port).lock()) {
+  m_impl->runner.GetAcceptor().ExecSync([&](uv::Loop& loop) {
+    if (auto server = m_impl->servers.lookup(port).tcp.lock()) {
       server->Close();
       m_impl->servers.erase(port);
     }
   });
 }
+
+PortForwarder::Stats PortForwarder::GetStats(unsigned int port) {
+  Stats stats;
+  m_impl->runner.GetAcceptor().ExecSync([&](uv::Loop& loop) {
+    if (auto counters = m_impl->servers.lookup(port).counters) {
+      stats.connections = counters->connections.load();
+      stats.bytesToRemote = counters->bytesToRemote.load();
+      stats.bytesFromRemote = counters->bytesFromRemote.load();
+    }
+  });
+  return stats;
+}
@@ -4,24 +4,106 @@
 
 #include "wpi/TCPConnector.h"  // NOLINT(build/include_order)
 
-#include <atomic>
 #include <chrono>
-#include <thread>
-#include <tuple>
+#include <string>
+#include <utility>
+#include <vector>
 
-#include "wpi/SmallSet.h"
+#ifdef _WIN32
+#include <WinSock2.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "wpi/EventLoopRunner.h"
+#include "wpi/ParallelTcpConnector.h"
+#include "wpi/TCPStream.h"
 #include "wpi/condition_variable.h"
 #include "wpi/mutex.h"
+#include "wpi/uv/Tcp.h"
 
 using namespace wpi;
 
-// MSVC < 1900 doesn't have support for thread_local
-#if !defined(_MSC_VER) || _MSC_VER >= 1900
-// clang check for availability of thread_local
-#if !defined(__has_feature) || __has_feature(cxx_thread_local)
-#define HAVE_THREAD_LOCAL
-#endif
+namespace {
+using ServerList = std::vector<std::pair<std::string, unsigned int>>;
+
+// The connector of one calling thread.  Everything but the result is only
+// touched on the loop thread.
+struct ConnectState {
+  std::shared_ptr<ParallelTcpConnector> connector;
+  Logger* logger = nullptr;
+  ServerList servers;  // given to the connector
+
+  wpi::mutex mutex;
+  wpi::condition_variable cond;
+  std::unique_ptr<NetworkStream> stream;
+  ServerList streamServers;  // the servers when stream connected
+  bool failed = false;
+
+  // Drops a stream that connected for a different server list, such as one
+  // that completed after an earlier call with other servers timed out.
+  // Must be called with mutex held.
+  void DropStaleStream(const ServerList& current) {
+    if (stream && streamServers != current) {
+      stream.reset();
+    }
+  }
+};
+
+// Closes the thread's connector when the thread exits
+struct ThreadConnectState {
+  ~ThreadConnectState();
+  std::shared_ptr<ConnectState> state = std::make_shared<ConnectState>();
+};
+}  // namespace
+
+// All the parallel connects of the process share one loop thread
+static EventLoopRunner& GetConnectRunner() {
+  static EventLoopRunner runner;
+  return runner;
+}
+
+ThreadConnectState::~ThreadConnectState() {
+  GetConnectRunner().ExecAsync([state = std::move(state)](uv::Loop&) {
+    if (state->connector) {
+      state->connector->Close();
+    }
+  });
+}
+
+// Moves the socket of a connected handle into a blocking socket descriptor
+static int DetachSocket(uv::Tcp& tcp) {
+  uv_os_fd_t fd;
+  if (uv_fileno(tcp.GetRawHandle(), &fd) != 0) {
+    return -1;
+  }
+#ifdef _WIN32
+  WSAPROTOCOL_INFOW info;
+  if (WSADuplicateSocketW(reinterpret_cast<SOCKET>(fd), GetCurrentProcessId(),
+                          &info) != 0) {
+    return -1;
+  }
+  SOCKET sd = WSASocketW(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO,
+                         FROM_PROTOCOL_INFO, &info, 0, WSA_FLAG_OVERLAPPED);
+  if (sd == INVALID_SOCKET) {
+    return -1;
+  }
+  u_long mode = 0;
+  ioctlsocket(sd, FIONBIO, &mode);
+  return static_cast<int>(sd);
+#else
+  int sd = ::dup(fd);
+  if (sd < 0) {
+    return -1;
+  }
+  int flags = fcntl(sd, F_GETFL, nullptr);
+  if (flags >= 0) {
+    fcntl(sd, F_SETFL, flags & ~O_NONBLOCK);
+  }
+  return sd;
 #endif
+}
 
 std::unique_ptr<NetworkStream> TCPConnector::connect_parallel(
     span<const std::pair<const char*, int>> servers, Logger& logger,
@@ -30,102 +112,89 @@ std::unique_ptr<NetworkStream> TCPConnector::connect_parallel(
     return nullptr;
   }
 
-  // structure to make sure we don't start duplicate workers
-  struct GlobalState {
-    wpi::mutex mtx;
-#ifdef HAVE_THREAD_LOCAL
-    SmallSet<std::pair<std::string, int>, 16> active;
-#else
-    SmallSet<std::tuple<std::thread::id, std::string, int>, 16> active;
-#endif
-  };
-#ifdef HAVE_THREAD_LOCAL
-  thread_local auto global = std::make_shared<GlobalState>();
-#else
-  static auto global = std::make_shared<GlobalState>();
-  auto this_id = std::this_thread::get_id();
-#endif
-  auto local = global;  // copy to an automatic variable for lambda capture
-
-  // structure shared between threads and this function
-  struct Result {
-    wpi::mutex mtx;
-    wpi::condition_variable cv;
-    std::unique_ptr<NetworkStream> stream;
-    std::atomic<unsigned int> count{0};
-    std::atomic<bool> done{false};
-  };
-  auto result = std::make_shared<Result>();
-
-  // start worker threads; this is I/O bound so we don't limit to # of procs
-  Logger* plogger = &logger;
-  unsigned int num_workers = 0;
+  // Keeping the connector between calls lets an attempt still running when
+  // the last call timed out carry on rather than start over, and retries
+  // the address that last connected first
+  thread_local ThreadConnectState threadState;
+  auto state = threadState.state;
+
+  ServerList serversCopy;
+  serversCopy.reserve(servers.size());
   for (const auto& server : servers) {
-    std::pair<std::string, int> server_copy{std::string{server.first},
-                                            server.second};
-#ifdef HAVE_THREAD_LOCAL
-    const auto& active_tracker = server_copy;
-#else
-    std::tuple<std::thread::id, std::string, int> active_tracker{
-        this_id, server_copy.first, server_copy.second};
-#endif
+    serversCopy.emplace_back(server.first, server.second);
+  }
 
-    // don't start a new worker if we had a previously still-active connection
-    // attempt to the same server
-    {
-      std::scoped_lock lock(local->mtx);
-      if (local->active.count(active_tracker) > 0) {
-        continue;  // already in set
-      }
+  {
+    std::scoped_lock lock(state->mutex);
+    // a connection that completed after the last call gave up
+    state->DropStaleStream(serversCopy);
+    if (state->stream) {
+      return std::move(state->stream);
     }
+    state->failed = false;
+  }
 
-    ++num_workers;
-
-    // start the worker
-    std::thread([=] {
-      if (!result->done) {
-        // add to global state
-        {
-          std::scoped_lock lock(local->mtx);
-          local->active.insert(active_tracker);
+  auto& runner = GetConnectRunner();
+  runner.ExecSync([&](uv::Loop& loop) {
+    auto& connector = state->connector;
+    if (connector && state->logger != &logger) {
+      connector->Close();
+      connector.reset();
+    }
+    if (!connector) {
+      // start over at the caller's timeout if nothing has connected
+      connector = ParallelTcpConnector::Create(
+          loop, uv::Timer::Time{(timeout == 0 ? 1 : timeout) * 1000}, logger);
+      if (!connector) {
+        std::scoped_lock lock(state->mutex);
+        state->failed = true;
+        return;
+      }
+      state->logger = &logger;
+      // TCPStream only handles IPv4
+      connector->SetAddressFamily(AF_INET);
+      connector->connected.connect([weak = std::weak_ptr{state}](
+                                       uv::Tcp& tcp) {
+        sockaddr_storage peer = tcp.GetPeer();
+        int sd = DetachSocket(tcp);
+        tcp.Close();
+        if (sd < 0) {
+          return;
         }
-
-        // try to connect
-        auto stream = connect(server_copy.first.c_str(), server_copy.second,
-                              *plogger, timeout);
-
-        // remove from global state
-        {
-          std::scoped_lock lock(local->mtx);
-          local->active.erase(active_tracker);
+        std::unique_ptr<NetworkStream> stream{
+            new TCPStream(sd, reinterpret_cast<sockaddr_in*>(&peer))};
+        if (auto state = weak.lock()) {
+          std::scoped_lock lock(state->mutex);
+          state->stream = std::move(stream);
+          state->streamServers = state->servers;
+          state->cond.notify_all();
         }
-
-        // successful connection
-        if (stream) {
-          std::scoped_lock lock(result->mtx);
-          if (!result->done.exchange(true)) {
-            result->stream = std::move(stream);
-          }
+      });
+      connector->failed.connect([weak = std::weak_ptr{state}] {
+        if (auto state = weak.lock()) {
+          std::scoped_lock lock(state->mutex);
+          state->failed = true;
+          state->cond.notify_all();
         }
-      }
-      ++result->count;
-      result->cv.notify_all();
-    }).detach();
-  }
+      });
+    }
+    state->servers = serversCopy;
+    connector->SetServers(serversCopy);
+    // being called again means the last connection is gone
+    if (connector->IsConnected()) {
+      connector->Disconnected();
+    }
+  });
 
-  // wait for a result, timeout, or all finished
-  std::unique_lock lock(result->mtx);
+  // wait for a connection, timeout, or all failed
+  std::unique_lock lock(state->mutex);
+  // one may have connected for the old servers before they were replaced
+  state->DropStaleStream(serversCopy);
+  auto ready = [&] { return state->stream || state->failed; };
   if (timeout == 0) {
-    result->cv.wait(
-        lock, [&] { return result->stream || result->count >= num_workers; });
+    state->cond.wait(lock, ready);
   } else {
-    auto timeout_time =
-        std::chrono::steady_clock::now() + std::chrono::seconds(timeout);
-    result->cv.wait_until(lock, timeout_time, [&] {
-      return result->stream || result->count >= num_workers;
-    });
+    state->cond.wait_for(lock, std::chrono::seconds(timeout), ready);
   }
-
-  // no need to wait for remaining worker threads; shared_ptr will clean up
-  return std::move(result->stream);
+  return std::move(state->stream);
 }
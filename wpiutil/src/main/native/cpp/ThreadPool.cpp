@@ -0,0 +1,227 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace wpi;
+
+struct ThreadPool::Worker {
+  std::thread thread;
+  // The owner pushes and pops at the back; thieves take from the front
+  wpi::mutex mutex;
+  std::deque<Task> tasks;
+};
+
+// The pool and index of the worker running on this thread, if any
+static thread_local ThreadPool* gCurrentPool = nullptr;
+static thread_local unsigned int gCurrentIndex = 0;
+
+static void SetCurrentThreadAffinity(int cpu) {
+#ifdef _WIN32
+  SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu);
+#elif defined(__linux__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+#endif
+}
+
+ThreadPool::ThreadPool() {
+  Start({});
+}
+
+ThreadPool::ThreadPool(const Options& options) {
+  Start(options);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::scoped_lock lock(m_sleepMutex);
+    m_stopping = true;
+  }
+  m_sleepCond.notify_all();
+  for (auto&& worker : m_workers) {
+    worker->thread.join();
+  }
+}
+
+void ThreadPool::Start(const Options& options) {
+  unsigned int numThreads = options.numThreads;
+  if (numThreads == 0) {
+    numThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+  }
+
+  // All the workers must exist before any can steal from the others
+  m_workers.reserve(numThreads);
+  for (unsigned int i = 0; i < numThreads; ++i) {
+    m_workers.emplace_back(std::make_unique<Worker>());
+  }
+  for (unsigned int i = 0; i < numThreads; ++i) {
+    int cpu = options.cpus.empty() ? -1 : options.cpus[i % options.cpus.size()];
+    m_workers[i]->thread = std::thread([=, start = options.threadStart] {
+      if (cpu >= 0) {
+        SetCurrentThreadAffinity(cpu);
+      }
+      if (start) {
+        start(i);
+      }
+      WorkerMain(i);
+    });
+  }
+}
+
+void ThreadPool::Post(unique_function<void()> task) {
+  if (gCurrentPool == this) {
+    auto& worker = *m_workers[gCurrentIndex];
+    std::scoped_lock lock(worker.mutex);
+    worker.tasks.emplace_back(std::move(task));
+  } else {
+    std::scoped_lock lock(m_sharedMutex);
+    m_shared.emplace_back(std::move(task));
+  }
+  m_pending.fetch_add(1, std::memory_order_relaxed);
+
+  // Pairs with the fence in WorkerMain(): either a sleeping worker is seen
+  // here, or it sees the task before it sleeps
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_sleeping.load(std::memory_order_relaxed) != 0) {
+    { std::scoped_lock lock(m_sleepMutex); }
+    m_sleepCond.notify_one();
+  }
+}
+
+void ThreadPool::WorkerMain(unsigned int index) {
+  gCurrentPool = this;
+  gCurrentIndex = index;
+
+  Task task;
+  for (;;) {
+    if (TryGetTask(index, &task)) {
+      m_pending.fetch_sub(1, std::memory_order_relaxed);
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock lock(m_sleepMutex);
+    if (m_stopping && m_pending.load(std::memory_order_relaxed) == 0) {
+      break;
+    }
+    m_sleeping.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_sleepCond.wait(lock, [&] {
+      return m_stopping || m_pending.load(std::memory_order_relaxed) != 0;
+    });
+    m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  gCurrentPool = nullptr;
+}
+
+bool ThreadPool::TryGetTask(unsigned int index, Task* task) {
+  // Newest of our own first, as it is most likely still in cache
+  {
+    auto& worker = *m_workers[index];
+    std::scoped_lock lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      *task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+      return true;
+    }
+  }
+
+  {
+    std::scoped_lock lock(m_sharedMutex);
+    if (!m_shared.empty()) {
+      *task = std::move(m_shared.front());
+      m_shared.pop_front();
+      return true;
+    }
+  }
+
+  // Steal the oldest of another worker's, as it likely covers the most work
+  size_t numWorkers = m_workers.size();
+  for (size_t i = 1; i < numWorkers; ++i) {
+    auto& victim = *m_workers[(index + i) % numWorkers];
+    std::unique_lock lock(victim.mutex, std::try_to_lock);
+    if (lock && !victim.tasks.empty()) {
+      *task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace {
+// Shared by the chunk runners of a ParallelFor() call.  Runners that start
+// after the call has returned only touch this, never the body.
+struct ParallelState {
+  explicit ParallelState(size_t numChunks_) : numChunks{numChunks_} {}
+
+  const size_t numChunks;
+  function_ref<void(size_t)>* body = nullptr;
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> done{0};
+  std::atomic_bool failed{false};
+  std::exception_ptr error;
+  wpi::mutex mutex;
+  wpi::condition_variable cond;
+};
+}  // namespace
+
+static void RunParallelChunks(ParallelState& state) {
+  size_t ran = 0;
+  for (size_t chunk; (chunk = state.next.fetch_add(1)) < state.numChunks;) {
+    ++ran;
+    if (state.failed) {
+      continue;  // claim the rest so the call can finish
+    }
+    try {
+      (*state.body)(chunk);
+    } catch (...) {
+      std::scoped_lock lock(state.mutex);
+      if (!state.error) {
+        state.error = std::current_exception();
+      }
+      state.failed = true;
+    }
+  }
+  if (ran != 0 && state.done.fetch_add(ran) + ran == state.numChunks) {
+    std::scoped_lock lock(state.mutex);
+    state.cond.notify_all();
+  }
+}
+
+void ThreadPool::RunChunks(size_t numChunks, function_ref<void(size_t)> body) {
+  auto state = std::make_shared<ParallelState>(numChunks);
+  state->body = &body;
+
+  // The calling thread runs chunks too, so it needs one helper fewer
+  size_t helpers = (std::min)(numChunks - 1, m_workers.size());
+  for (size_t i = 0; i < helpers; ++i) {
+    Post([state] { RunParallelChunks(*state); });
+  }
+  RunParallelChunks(*state);
+
+  // Wait for the chunks other threads have started
+  std::unique_lock lock(state->mutex);
+  state->cond.wait(lock, [&] { return state->done == numChunks; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
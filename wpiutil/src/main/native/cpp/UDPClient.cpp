@@ -114,6 +114,13 @@ int UDPClient::start(int port) {
     WPI_ERROR(m_logger, "bind() failed: {}", SocketStrerror());
     return result;
   }
+  if (port == 0) {
+    // receive() needs the port; find out which ephemeral port was bound
+    socklen_t len = sizeof(addr);
+    if (getsockname(m_lsd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+      port = ntohs(addr.sin_port);
+    }
+  }
   m_port = port;
   return 0;
 }
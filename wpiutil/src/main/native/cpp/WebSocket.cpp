@@ -16,6 +16,8 @@
 #include "wpi/sha1.h"
 #include "wpi/uv/Stream.h"
 
+#include "WebSocketDeflate.h"
+
 using namespace wpi;
 
 namespace {
@@ -35,8 +37,72 @@ class WebSocketWriteReq : public uv::WriteReq {
   SmallVector<uv::Buffer, 4> m_bufs;
   size_t m_startUser;
 };
+
+// Shared by the writes of a broadcast message; m_bufs is the frame header
+// followed by the user buffers
+class BroadcastData {
+ public:
+  BroadcastData(span<const uv::Buffer> data, size_t pending,
+                std::function<void(span<uv::Buffer>, uv::Error)> callback)
+      : m_pending{pending}, m_callback{std::move(callback)} {
+    m_bufs.emplace_back();
+    m_bufs.append(data.begin(), data.end());
+  }
+
+  void Finish(uv::Error err) {
+    if (err && !m_err) {
+      m_err = err;
+    }
+    if (--m_pending == 0) {
+      m_callback(span{m_bufs}.subspan(1), m_err);
+    }
+  }
+
+  SmallVector<uint8_t, 10> m_header;
+  SmallVector<uv::Buffer, 4> m_bufs;
+
+ private:
+  size_t m_pending;
+  uv::Error m_err{0};
+  std::function<void(span<uv::Buffer>, uv::Error)> m_callback;
+};
 }  // namespace
 
+static void WriteHeader(raw_ostream& os, uint8_t opcode, uint64_t size,
+                        uint8_t maskFlag) {
+  // opcode (includes FIN bit)
+  os << static_cast<unsigned char>(opcode);
+
+  // payload length
+  if (size < 126) {
+    os << static_cast<unsigned char>(maskFlag | size);
+  } else if (size <= 0xffff) {
+    os << static_cast<unsigned char>(maskFlag | 126);
+    const uint8_t sizeMsb[] = {static_cast<uint8_t>((size >> 8) & 0xff),
+                               static_cast<uint8_t>(size & 0xff)};
+    os << span{sizeMsb};
+  } else {
+    os << static_cast<unsigned char>(maskFlag | 127);
+    const uint8_t sizeMsb[] = {static_cast<uint8_t>((size >> 56) & 0xff),
+                               static_cast<uint8_t>((size >> 48) & 0xff),
+                               static_cast<uint8_t>((size >> 40) & 0xff),
+                               static_cast<uint8_t>((size >> 32) & 0xff),
+                               static_cast<uint8_t>((size >> 24) & 0xff),
+                               static_cast<uint8_t>((size >> 16) & 0xff),
+                               static_cast<uint8_t>((size >> 8) & 0xff),
+                               static_cast<uint8_t>(size & 0xff)};
+    os << span{sizeMsb};
+  }
+}
+
+static uint64_t PayloadSize(span<const uv::Buffer> data) {
+  uint64_t size = 0;
+  for (auto&& buf : data) {
+    size += buf.len;
+  }
+  return size;
+}
+
 class WebSocket::ClientHandshakeData {
  public:
   ClientHandshakeData() {
@@ -65,6 +131,7 @@ class WebSocket::ClientHandshakeData {
   bool hasConnection = false;
   bool hasAccept = false;
   bool hasProtocol = false;
+  DeflateOptions deflate;  // the compression offered, if enabled
 
   std::weak_ptr<uv::Timer> timer;
 };
@@ -110,9 +177,16 @@ std::shared_ptr<WebSocket> WebSocket::CreateServer(uv::Stream& stream,
                                                    std::string_view key,
                                                    std::string_view version,
                                                    std::string_view protocol) {
+  return CreateServer(stream, key, version, protocol, {}, {});
+}
+
+std::shared_ptr<WebSocket> WebSocket::CreateServer(
+    uv::Stream& stream, std::string_view key, std::string_view version,
+    std::string_view protocol, std::string_view extensions,
+    const DeflateOptions& deflate) {
   auto ws = std::make_shared<WebSocket>(stream, true, private_init{});
   stream.SetData(ws);
-  ws->StartServer(key, version, protocol);
+  ws->StartServer(key, version, protocol, extensions, deflate);
   return ws;
 }
 
@@ -174,6 +248,14 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
     os << "\r\n";
   }
 
+  // compression (if enabled)
+  if (options.deflate.enable && IsDeflateAvailable()) {
+    os << "Sec-WebSocket-Extensions: ";
+    WriteDeflateOffer(os, options.deflate);
+    os << "\r\n";
+    m_clientHandshake->deflate = options.deflate;
+  }
+
   // other headers
   for (auto&& header : options.extraHeaders) {
     os << header.first << ": " << header.second << "\r\n";
@@ -217,10 +299,18 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
           }
           m_clientHandshake->hasAccept = true;
         } else if (equals_lower(name, "sec-websocket-extensions")) {
-          // No extensions are supported
-          if (!value.empty()) {
+          // Only the compression we offered is supported
+          if (value.empty()) {
+            return;
+          }
+          std::optional<WebSocketDeflateParams> params;
+          if (m_clientHandshake->deflate.enable && !m_deflate) {
+            params = ParseDeflateResponse(value, m_clientHandshake->deflate);
+          }
+          if (!params) {
             return Terminate(1010, "unsupported extension");
           }
+          m_deflate = std::make_unique<Deflate>(*params, false);
         } else if (equals_lower(name, "sec-websocket-protocol")) {
           // Make sure it was one of the provided protocols
           bool match = false;
@@ -261,7 +351,9 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
 }
 
 void WebSocket::StartServer(std::string_view key, std::string_view version,
-                            std::string_view protocol) {
+                            std::string_view protocol,
+                            std::string_view extensions,
+                            const DeflateOptions& deflate) {
   m_protocol = protocol;
 
   // Build server response
@@ -296,6 +388,16 @@ void WebSocket::StartServer(std::string_view key, std::string_view version,
     os << "Sec-WebSocket-Protocol: " << protocol << "\r\n";
   }
 
+  // accept compression if offered
+  if (deflate.enable && IsDeflateAvailable()) {
+    if (auto params = NegotiateDeflate(extensions, deflate)) {
+      os << "Sec-WebSocket-Extensions: ";
+      WriteDeflateResponse(os, *params);
+      os << "\r\n";
+      m_deflate = std::make_unique<Deflate>(*params, true);
+    }
+  }
+
   // end headers
   os << "\r\n";
 
@@ -380,8 +482,14 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
           return;  // need more data
         }
 
-        // Validate RSV bits are zero
-        if ((m_header[0] & 0x70) != 0) {
+        // Validate RSV bits are zero, except RSV1 on the first frame of a
+        // compressed message
+        uint8_t rsv = m_header[0] & 0x70;
+        uint8_t opcode = m_header[0] & kOpMask;
+        if (rsv == kFlagRsv1 && m_deflate &&
+            (opcode == kOpText || opcode == kOpBinary)) {
+          m_compressedMessage = true;
+        } else if (rsv != 0) {
           return Fail(1002, "nonzero RSV");
         }
       }
@@ -467,9 +575,25 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
           }
         }
 
-        // Handle message
         bool fin = (m_header[0] & kFlagFin) != 0;
         uint8_t opcode = m_header[0] & kOpMask;
+
+        // Decompress data frames of a compressed message
+        if (m_compressedMessage &&
+            (opcode == kOpText || opcode == kOpBinary || opcode == kOpCont)) {
+          if (!m_deflate->Decompress(m_payload, m_frameStart, fin,
+                                     m_maxMessageSize)) {
+            return Fail(1007, "invalid compressed data");
+          }
+          if (m_payload.size() > m_maxMessageSize) {
+            return Fail(1009, "message too large");
+          }
+          if (fin) {
+            m_compressedMessage = false;
+          }
+        }
+
+        // Handle message
         switch (opcode) {
           case kOpCont:
             switch (m_fragmentOpcode) {
@@ -592,33 +716,22 @@ void WebSocket::Send(
   auto req = std::make_shared<WebSocketWriteReq>(callback);
   raw_uv_ostream os{req->m_bufs, 4096};
 
-  // opcode (includes FIN bit)
-  os << static_cast<unsigned char>(opcode);
-
-  // payload length
-  uint64_t size = 0;
-  for (auto&& buf : data) {
-    size += buf.len;
-  }
-  if (size < 126) {
-    os << static_cast<unsigned char>((m_server ? 0x00 : kFlagMasking) | size);
-  } else if (size <= 0xffff) {
-    os << static_cast<unsigned char>((m_server ? 0x00 : kFlagMasking) | 126);
-    const uint8_t sizeMsb[] = {static_cast<uint8_t>((size >> 8) & 0xff),
-                               static_cast<uint8_t>(size & 0xff)};
-    os << span{sizeMsb};
-  } else {
-    os << static_cast<unsigned char>((m_server ? 0x00 : kFlagMasking) | 127);
-    const uint8_t sizeMsb[] = {static_cast<uint8_t>((size >> 56) & 0xff),
-                               static_cast<uint8_t>((size >> 48) & 0xff),
-                               static_cast<uint8_t>((size >> 40) & 0xff),
-                               static_cast<uint8_t>((size >> 32) & 0xff),
-                               static_cast<uint8_t>((size >> 24) & 0xff),
-                               static_cast<uint8_t>((size >> 16) & 0xff),
-                               static_cast<uint8_t>((size >> 8) & 0xff),
-                               static_cast<uint8_t>(size & 0xff)};
-    os << span{sizeMsb};
+  // compress data frames if negotiated; like masked data, the compressed data
+  // is copied, so the user bufs aren't sent
+  uint8_t op = opcode & kOpMask;
+  bool compress =
+      m_deflate && (op == kOpText || op == kOpBinary || op == kOpCont);
+  uv::Buffer compressed;
+  span<const uv::Buffer> payload = data;
+  if (compress) {
+    compressed = m_deflate->Compress(data, (opcode & kFlagFin) != 0);
+    payload = {&compressed, 1};
+    if (op != kOpCont) {
+      opcode |= kFlagRsv1;
+    }
   }
+  WriteHeader(os, opcode, PayloadSize(payload),
+              m_server ? 0x00 : kFlagMasking);
 
   // clients need to mask the input data
   if (!m_server) {
@@ -633,7 +746,7 @@ void WebSocket::Send(
     os << span<const uint8_t>{key, 4};
     // copy and mask data
     int n = 0;
-    for (auto&& buf : data) {
+    for (auto&& buf : payload) {
       for (auto&& ch : buf.data()) {
         os << static_cast<unsigned char>(static_cast<uint8_t>(ch) ^ key[n++]);
         if (n >= 4) {
@@ -645,6 +758,11 @@ void WebSocket::Send(
     req->m_bufs.append(data.begin(), data.end());
     // don't send the user bufs as we copied their data
     m_stream.Write(span{req->m_bufs}.subspan(0, req->m_startUser), req);
+  } else if (compress) {
+    os << std::string_view{compressed.base, compressed.len};
+    req->m_startUser = req->m_bufs.size();
+    req->m_bufs.append(data.begin(), data.end());
+    m_stream.Write(span{req->m_bufs}.subspan(0, req->m_startUser), req);
   } else {
     // servers can just send the buffers directly without masking
     req->m_startUser = req->m_bufs.size();
@@ -652,3 +770,35 @@ void WebSocket::Send(
     m_stream.Write(req->m_bufs, req);
   }
 }
+
+void WebSocket::Broadcast(
+    span<const std::shared_ptr<WebSocket>> websockets, uint8_t opcode,
+    span<const uv::Buffer> data,
+    std::function<void(span<uv::Buffer>, uv::Error)> callback) {
+  if (websockets.empty()) {
+    SmallVector<uv::Buffer, 4> bufs{data.begin(), data.end()};
+    callback(bufs, uv::Error{0});
+    return;
+  }
+
+  auto shared =
+      std::make_shared<BroadcastData>(data, websockets.size(), callback);
+  raw_usvector_ostream os{shared->m_header};
+  WriteHeader(os, opcode, PayloadSize(data), 0x00);
+  shared->m_bufs[0] = uv::Buffer{os.array()};
+
+  for (auto&& ws : websockets) {
+    if (ws->m_state != OPEN) {
+      shared->Finish(
+          uv::Error{ws->m_state == CONNECTING ? UV_EAGAIN : UV_ESHUTDOWN});
+    } else if (!ws->m_server || ws->m_deflate) {
+      ws->Send(opcode, data,
+               [shared](auto, uv::Error err) { shared->Finish(err); });
+    } else {
+      // servers don't mask, so every connection can send the same frame
+      auto req = std::make_shared<uv::WriteReq>();
+      req->finish.connect([shared](uv::Error err) { shared->Finish(err); });
+      ws->m_stream.Write(shared->m_bufs, req);
+    }
+  }
+}
@@ -0,0 +1,316 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "WebSocketDeflate.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include "wpi/StringExtras.h"
+#include "wpi/raw_ostream.h"
+
+using namespace wpi;
+
+// zlib can't compress with a window smaller than 9 bits, though it can
+// decompress data compressed with one
+static constexpr int kMinWindowBits = 9;
+static constexpr int kMaxWindowBits = 15;
+
+namespace {
+// The parameters of an offer or a response
+struct DeflateParameters {
+  bool serverNoContextTakeover = false;
+  bool clientNoContextTakeover = false;
+  std::optional<int> serverMaxWindowBits;
+  bool hasClientMaxWindowBits = false;
+  std::optional<int> clientMaxWindowBits;  // the value, if one was given
+};
+}  // namespace
+
+// Returns nullopt for another extension or invalid (unknown, repeated, or out
+// of range) parameters
+static std::optional<DeflateParameters> ParseParameters(std::string_view str) {
+  SmallVector<std::string_view, 4> parts;
+  split(str, parts, ';', -1, false);
+  if (parts.empty() || trim(parts[0]) != "permessage-deflate") {
+    return std::nullopt;
+  }
+
+  DeflateParameters params;
+  for (auto part : span{parts}.subspan(1)) {
+    bool hasValue = part.find('=') != std::string_view::npos;
+    auto [name, value] = split(part, '=');
+    name = trim(name);
+    value = trim(trim(value), '"');
+    std::optional<int> bits;
+    if (hasValue) {
+      bits = parse_integer<int>(value, 10);
+      if (!bits || *bits < 8 || *bits > kMaxWindowBits) {
+        return std::nullopt;
+      }
+    }
+
+    if (name == "server_no_context_takeover" && !hasValue &&
+        !params.serverNoContextTakeover) {
+      params.serverNoContextTakeover = true;
+    } else if (name == "client_no_context_takeover" && !hasValue &&
+               !params.clientNoContextTakeover) {
+      params.clientNoContextTakeover = true;
+    } else if (name == "server_max_window_bits" && hasValue &&
+               !params.serverMaxWindowBits) {
+      params.serverMaxWindowBits = bits;
+    } else if (name == "client_max_window_bits" &&
+               !params.hasClientMaxWindowBits) {
+      params.hasClientMaxWindowBits = true;
+      params.clientMaxWindowBits = bits;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return params;
+}
+
+static int ClampWindowBits(int bits) {
+  return std::clamp(bits, kMinWindowBits, kMaxWindowBits);
+}
+
+std::optional<WebSocketDeflateParams> wpi::NegotiateDeflate(
+    std::string_view offers, const WebSocket::DeflateOptions& options) {
+  SmallVector<std::string_view, 2> list;
+  split(offers, list, ',', -1, false);
+  for (auto str : list) {
+    auto offer = ParseParameters(str);
+    if (!offer) {
+      continue;
+    }
+
+    WebSocketDeflateParams params;
+    params.serverNoContextTakeover =
+        offer->serverNoContextTakeover || options.serverNoContextTakeover;
+    params.clientNoContextTakeover =
+        offer->clientNoContextTakeover || options.clientNoContextTakeover;
+    params.serverMaxWindowBits = ClampWindowBits(options.serverMaxWindowBits);
+    if (offer->serverMaxWindowBits) {
+      if (*offer->serverMaxWindowBits < kMinWindowBits) {
+        continue;
+      }
+      params.serverMaxWindowBits =
+          (std::min)(params.serverMaxWindowBits, *offer->serverMaxWindowBits);
+    }
+    // The client's window can only be limited if it offered to limit it
+    if (offer->hasClientMaxWindowBits) {
+      params.clientMaxWindowBits =
+          (std::min)(ClampWindowBits(options.clientMaxWindowBits),
+                     offer->clientMaxWindowBits.value_or(kMaxWindowBits));
+    }
+    return params;
+  }
+  return std::nullopt;
+}
+
+std::optional<WebSocketDeflateParams> wpi::ParseDeflateResponse(
+    std::string_view response, const WebSocket::DeflateOptions& options) {
+  // We made a single offer, so the server can accept only that
+  if (response.find(',') != std::string_view::npos) {
+    return std::nullopt;
+  }
+  auto resp = ParseParameters(response);
+  if (!resp) {
+    return std::nullopt;
+  }
+
+  // The server must agree to what we asked of it
+  int serverMaxWindowBits = ClampWindowBits(options.serverMaxWindowBits);
+  if ((options.serverNoContextTakeover && !resp->serverNoContextTakeover) ||
+      (serverMaxWindowBits < kMaxWindowBits &&
+       resp->serverMaxWindowBits.value_or(kMaxWindowBits) >
+           serverMaxWindowBits) ||
+      (resp->hasClientMaxWindowBits && !resp->clientMaxWindowBits)) {
+    return std::nullopt;
+  }
+
+  WebSocketDeflateParams params;
+  params.serverNoContextTakeover = resp->serverNoContextTakeover;
+  params.clientNoContextTakeover =
+      resp->clientNoContextTakeover || options.clientNoContextTakeover;
+  params.serverMaxWindowBits =
+      resp->serverMaxWindowBits.value_or(kMaxWindowBits);
+  params.clientMaxWindowBits =
+      (std::min)(ClampWindowBits(options.clientMaxWindowBits),
+                 resp->clientMaxWindowBits.value_or(kMaxWindowBits));
+  if (params.clientMaxWindowBits < kMinWindowBits) {
+    return std::nullopt;
+  }
+  return params;
+}
+
+void wpi::WriteDeflateOffer(raw_ostream& os,
+                            const WebSocket::DeflateOptions& options) {
+  os << "permessage-deflate";
+  if (options.serverNoContextTakeover) {
+    os << "; server_no_context_takeover";
+  }
+  if (options.clientNoContextTakeover) {
+    os << "; client_no_context_takeover";
+  }
+  int serverBits = ClampWindowBits(options.serverMaxWindowBits);
+  if (serverBits < kMaxWindowBits) {
+    os << fmt::format("; server_max_window_bits={}", serverBits);
+  }
+  // Always offer to limit our window, so the server may ask us to
+  os << "; client_max_window_bits";
+  int clientBits = ClampWindowBits(options.clientMaxWindowBits);
+  if (clientBits < kMaxWindowBits) {
+    os << fmt::format("={}", clientBits);
+  }
+}
+
+void wpi::WriteDeflateResponse(raw_ostream& os,
+                               const WebSocketDeflateParams& params) {
+  os << "permessage-deflate";
+  if (params.serverNoContextTakeover) {
+    os << "; server_no_context_takeover";
+  }
+  if (params.clientNoContextTakeover) {
+    os << "; client_no_context_takeover";
+  }
+  if (params.serverMaxWindowBits < kMaxWindowBits) {
+    os << fmt::format("; server_max_window_bits={}",
+                      params.serverMaxWindowBits);
+  }
+  if (params.clientMaxWindowBits < kMaxWindowBits) {
+    os << fmt::format("; client_max_window_bits={}",
+                      params.clientMaxWindowBits);
+  }
+}
+
+#ifdef WPI_HAVE_ZLIB
+
+bool WebSocket::IsDeflateAvailable() {
+  return true;
+}
+
+// The empty stored block that ends a flush; it is left off the end of each
+// message
+static constexpr uint8_t kTail[] = {0x00, 0x00, 0xff, 0xff};
+
+static constexpr size_t kChunkSize = 4096;
+
+WebSocket::Deflate::Deflate(const WebSocketDeflateParams& params, bool server)
+    : m_compress{},
+      m_decompress{},
+      m_compressReset{server ? params.serverNoContextTakeover
+                             : params.clientNoContextTakeover},
+      m_decompressReset{server ? params.clientNoContextTakeover
+                               : params.serverNoContextTakeover} {
+  int windowBits =
+      server ? params.serverMaxWindowBits : params.clientMaxWindowBits;
+  // Negative window bits select raw deflate data, without a zlib header.
+  // The peer may compress with any window up to the maximum.
+  deflateInit2(&m_compress, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -windowBits, 8,
+               Z_DEFAULT_STRATEGY);
+  inflateInit2(&m_decompress, -kMaxWindowBits);
+}
+
+WebSocket::Deflate::~Deflate() {
+  deflateEnd(&m_compress);
+  inflateEnd(&m_decompress);
+}
+
+span<const uint8_t> WebSocket::Deflate::Compress(span<const uv::Buffer> data,
+                                                 bool fin) {
+  m_out.clear();
+  auto run = [&](const char* in, size_t len, int flush) {
+    m_compress.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(in));  // NOLINT
+    m_compress.avail_in = static_cast<uInt>(len);
+    do {
+      size_t used = m_out.size();
+      m_out.resize(used + kChunkSize);
+      m_compress.next_out = m_out.data() + used;
+      m_compress.avail_out = static_cast<uInt>(kChunkSize);
+      deflate(&m_compress, flush);
+      m_out.resize(m_out.size() - m_compress.avail_out);
+    } while (m_compress.avail_out == 0);
+  };
+  for (auto&& buf : data) {
+    run(buf.base, buf.len, Z_NO_FLUSH);
+  }
+  run(nullptr, 0, Z_SYNC_FLUSH);
+
+  if (fin) {
+    if (m_out.size() >= std::size(kTail) &&
+        std::equal(std::begin(kTail), std::end(kTail),
+                   m_out.end() - std::size(kTail))) {
+      m_out.resize(m_out.size() - std::size(kTail));
+    }
+    if (m_compressReset) {
+      deflateReset(&m_compress);
+    }
+  }
+  return m_out;
+}
+
+bool WebSocket::Deflate::Decompress(SmallVectorImpl<uint8_t>& payload,
+                                    size_t start, bool fin, size_t maxSize) {
+  if (fin) {
+    payload.append(std::begin(kTail), std::end(kTail));
+  }
+  m_decompress.next_in = payload.data() + start;
+  m_decompress.avail_in = static_cast<uInt>(payload.size() - start);
+
+  m_out.clear();
+  for (;;) {
+    size_t used = m_out.size();
+    m_out.resize(used + kChunkSize);
+    m_decompress.next_out = m_out.data() + used;
+    m_decompress.avail_out = static_cast<uInt>(kChunkSize);
+    int ret = inflate(&m_decompress, Z_SYNC_FLUSH);
+    m_out.resize(m_out.size() - m_decompress.avail_out);
+    if (ret == Z_STREAM_END) {
+      // a final block; anything after it starts over
+      inflateReset(&m_decompress);
+    } else if (ret == Z_BUF_ERROR) {
+      break;  // no more progress possible
+    } else if (ret != Z_OK) {
+      return false;
+    }
+    if ((start + m_out.size()) > maxSize ||
+        (m_decompress.avail_in == 0 && m_decompress.avail_out != 0)) {
+      break;
+    }
+  }
+
+  payload.resize(start);
+  payload.append(m_out.begin(), m_out.end());
+  if (fin && m_decompressReset) {
+    inflateReset(&m_decompress);
+  }
+  return true;
+}
+
+#else
+
+bool WebSocket::IsDeflateAvailable() {
+  return false;
+}
+
+// Never constructed, as compression is never negotiated
+WebSocket::Deflate::Deflate(const WebSocketDeflateParams&, bool) {}
+
+WebSocket::Deflate::~Deflate() = default;
+
+span<const uint8_t> WebSocket::Deflate::Compress(span<const uv::Buffer>,
+                                                 bool) {
+  return {};
+}
+
+bool WebSocket::Deflate::Decompress(SmallVectorImpl<uint8_t>&, size_t, bool,
+                                    size_t) {
+  return false;
+}
+
+#endif  // WPI_HAVE_ZLIB
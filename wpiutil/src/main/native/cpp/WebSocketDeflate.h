@@ -0,0 +1,78 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WEBSOCKETDEFLATE_H_
+#define WPIUTIL_WEBSOCKETDEFLATE_H_
+
+#include <stdint.h>
+
+#include <optional>
+#include <string_view>
+
+#ifdef WPI_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "wpi/SmallVector.h"
+#include "wpi/WebSocket.h"
+#include "wpi/span.h"
+#include "wpi/uv/Buffer.h"
+
+namespace wpi {
+
+class raw_ostream;
+
+// Negotiated permessage-deflate parameters
+struct WebSocketDeflateParams {
+  bool serverNoContextTakeover = false;
+  bool clientNoContextTakeover = false;
+  int serverMaxWindowBits = 15;
+  int clientMaxWindowBits = 15;
+};
+
+// Server side: picks the first of the client's offers (the value of its
+// Sec-WebSocket-Extensions header) that is acceptable
+std::optional<WebSocketDeflateParams> NegotiateDeflate(
+    std::string_view offers, const WebSocket::DeflateOptions& options);
+
+// Client side: checks the server's response to our offer
+std::optional<WebSocketDeflateParams> ParseDeflateResponse(
+    std::string_view response, const WebSocket::DeflateOptions& options);
+
+// Writes a Sec-WebSocket-Extensions header value
+void WriteDeflateOffer(raw_ostream& os,
+                       const WebSocket::DeflateOptions& options);
+void WriteDeflateResponse(raw_ostream& os,
+                          const WebSocketDeflateParams& params);
+
+class WebSocket::Deflate {
+ public:
+  Deflate(const WebSocketDeflateParams& params, bool server);
+  ~Deflate();
+
+  Deflate(const Deflate&) = delete;
+  Deflate& operator=(const Deflate&) = delete;
+
+  // Compresses a frame of a message; the result is valid until the next call
+  span<const uint8_t> Compress(span<const uv::Buffer> data, bool fin);
+
+  // Replaces the compressed frame at the end of payload (starting at start)
+  // with its decompressed data, stopping once the payload is larger than
+  // maxSize.  Returns false if the data is invalid.
+  bool Decompress(SmallVectorImpl<uint8_t>& payload, size_t start, bool fin,
+                  size_t maxSize);
+
+#ifdef WPI_HAVE_ZLIB
+ private:
+  z_stream m_compress;
+  z_stream m_decompress;
+  bool m_compressReset;    // no context takeover when compressing
+  bool m_decompressReset;  // no context takeover when decompressing
+  SmallVector<uint8_t, 1024> m_out;
+#endif
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WEBSOCKETDEFLATE_H_
@@ -0,0 +1,86 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define WPI_CPU_X86
+
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC allows any intrinsic in any function
+#define WPI_TARGET(features)
+#else
+#include <cpuid.h>
+#define WPI_TARGET(features) __attribute__((target(features)))
+#endif
+
+#include <immintrin.h>
+#endif
+
+namespace wpi::detail {
+
+#ifdef WPI_CPU_X86
+/**
+ * Instruction set extensions of the CPU that are used by optional fast
+ * paths, detected on first use.  Compile such a path with WPI_TARGET and
+ * only call it if the feature is present.
+ */
+struct CpuFeatures {
+  bool ssse3 = false;
+  bool sse41 = false;
+  bool avx2 = false;
+  bool sha = false;
+
+  static const CpuFeatures& Get() {
+    static const CpuFeatures features = Detect();
+    return features;
+  }
+
+ private:
+  static void Cpuid(int leaf, unsigned int regs[4]) {
+#ifdef _MSC_VER
+    __cpuidex(reinterpret_cast<int*>(regs), leaf, 0);
+#else
+    __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+  }
+
+  static unsigned long long Xgetbv() {  // NOLINT(runtime/int)
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) |  // NOLINT
+           eax;
+#endif
+  }
+
+  static CpuFeatures Detect() {
+    CpuFeatures features;
+    unsigned int regs[4];
+    Cpuid(0, regs);
+    unsigned int maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+      return features;
+    }
+    Cpuid(1, regs);
+    features.ssse3 = (regs[2] & (1u << 9)) != 0;
+    features.sse41 = (regs[2] & (1u << 19)) != 0;
+    // AVX state must also be enabled by the OS
+    bool osAvx = (regs[2] & (1u << 27)) != 0 && (regs[2] & (1u << 28)) != 0 &&
+                 (Xgetbv() & 6) == 6;
+    if (maxLeaf >= 7) {
+      Cpuid(7, regs);
+      features.avx2 = osAvx && (regs[1] & (1u << 5)) != 0;
+      features.sha = (regs[1] & (1u << 29)) != 0;
+    }
+    return features;
+  }
+};
+#endif
+
+}  // namespace wpi::detail
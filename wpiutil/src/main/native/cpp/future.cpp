@@ -4,12 +4,28 @@
 
 #include "wpi/future.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace wpi {
 namespace detail {
 
 PromiseFactoryBase::~PromiseFactoryBase() {
   m_active = false;
-  m_resultCv.notify_all();  // wake up any waiters
+  Notify();  // wake up any waiters
+}
+
+void PromiseFactoryBase::Notify() {
+  std::unique_lock lock(m_resultMutex);
+  for (auto&& request : m_requests) {
+    for (Waiter* waiter = request.second; waiter; waiter = waiter->next) {
+      waiter->cv.notify_all();
+    }
+  }
+  for (Waiter* waiter = m_orphans; waiter; waiter = waiter->next) {
+    waiter->cv.notify_all();
+  }
 }
 
 void PromiseFactoryBase::IgnoreResult(uint64_t request) {
@@ -20,7 +36,7 @@ void PromiseFactoryBase::IgnoreResult(uint64_t request) {
 uint64_t PromiseFactoryBase::CreateRequest() {
   std::unique_lock lock(m_resultMutex);
   uint64_t req = ++m_uid;
-  m_requests.push_back(req);
+  m_requests.try_emplace(req, nullptr);
   return req;
 }
 
@@ -28,21 +44,44 @@ bool PromiseFactoryBase::EraseRequest(uint64_t request) {
   if (request == 0) {
     return false;
   }
-  auto it = std::find_if(m_requests.begin(), m_requests.end(),
-                         [=](auto r) { return r == request; });
+  auto it = m_requests.find(request);
   if (it == m_requests.end()) {
     return false;  // no waiters
   }
+  // The waiters can't check for the result until the caller (which holds
+  // the lock) has stored it
+  for (Waiter* waiter = it->second; waiter; waiter = waiter->next) {
+    waiter->cv.notify_all();
+  }
   m_requests.erase(it);
   return true;
 }
 
+void PromiseFactoryBase::AddWaiter(uint64_t request, Waiter* waiter) {
+  auto it = m_requests.find(request);
+  Waiter*& head = it != m_requests.end() ? it->second : m_orphans;
+  waiter->next = head;
+  head = waiter;
+}
+
+void PromiseFactoryBase::RemoveWaiter(uint64_t request, Waiter* waiter) {
+  // If the request has completed, its list went with it
+  auto it = m_requests.find(request);
+  Waiter** link = it != m_requests.end() ? &it->second : &m_orphans;
+  for (; *link; link = &(*link)->next) {
+    if (*link == waiter) {
+      *link = waiter->next;
+      return;
+    }
+  }
+}
+
 }  // namespace detail
 
 future<void> PromiseFactory<void>::MakeReadyFuture() {
   std::unique_lock lock(GetResultMutex());
   uint64_t req = CreateErasedRequest();
-  m_results.emplace_back(req);
+  m_results.try_emplace(req, true);
   return future<void>{this, req};
 }
 
@@ -51,37 +90,32 @@ void PromiseFactory<void>::SetValue(uint64_t request) {
   if (!EraseRequest(request)) {
     return;
   }
-  auto it = std::find_if(m_thens.begin(), m_thens.end(),
-                         [=](const auto& x) { return x.request == request; });
+  auto it = m_thens.find(request);
   if (it != m_thens.end()) {
-    uint64_t outRequest = it->outRequest;
-    ThenFunction func = std::move(it->func);
+    uint64_t outRequest = it->second.outRequest;
+    ThenFunction func = std::move(it->second.func);
     m_thens.erase(it);
     lock.unlock();
     return func(outRequest);
   }
-  m_results.emplace_back(request);
-  Notify();
+  m_results.try_emplace(request, true);
 }
 
 void PromiseFactory<void>::SetThen(uint64_t request, uint64_t outRequest,
                                    ThenFunction func) {
   std::unique_lock lock(GetResultMutex());
-  auto it = std::find_if(m_results.begin(), m_results.end(),
-                         [=](const auto& r) { return r == request; });
+  auto it = m_results.find(request);
   if (it != m_results.end()) {
     m_results.erase(it);
     lock.unlock();
     return func(outRequest);
   }
-  m_thens.emplace_back(request, outRequest, func);
+  m_thens.try_emplace(request, outRequest, std::move(func));
 }
 
 bool PromiseFactory<void>::IsReady(uint64_t request) noexcept {
   std::unique_lock lock(GetResultMutex());
-  auto it = std::find_if(m_results.begin(), m_results.end(),
-                         [=](const auto& r) { return r == request; });
-  return it != m_results.end();
+  return m_results.count(request) != 0;
 }
 
 void PromiseFactory<void>::GetResult(uint64_t request) {
@@ -89,15 +123,14 @@ void PromiseFactory<void>::GetResult(uint64_t request) {
   std::unique_lock lock(GetResultMutex());
   while (IsActive()) {
     // Did we get a response to *our* request?
-    auto it = std::find_if(m_results.begin(), m_results.end(),
-                           [=](const auto& r) { return r == request; });
+    auto it = m_results.find(request);
     if (it != m_results.end()) {
-      // Yes, remove it from the vector and we're done.
+      // Yes, remove it and we're done.
       m_results.erase(it);
       return;
     }
     // No, keep waiting for a response
-    Wait(lock);
+    Wait(lock, request);
   }
 }
 
@@ -106,13 +139,11 @@ void PromiseFactory<void>::WaitResult(uint64_t request) {
   std::unique_lock lock(GetResultMutex());
   while (IsActive()) {
     // Did we get a response to *our* request?
-    auto it = std::find_if(m_results.begin(), m_results.end(),
-                           [=](const auto& r) { return r == request; });
-    if (it != m_results.end()) {
+    if (m_results.count(request) != 0) {
       return;
     }
     // No, keep waiting for a response
-    Wait(lock);
+    Wait(lock, request);
   }
 }
 
@@ -121,4 +152,52 @@ PromiseFactory<void>& PromiseFactory<void>::GetInstance() {
   return inst;
 }
 
+future<void> when_all(std::vector<future<void>> futures) {
+  struct State {
+    std::atomic<size_t> remaining;
+    promise<void> result;
+  };
+  auto state = std::make_shared<State>();
+  // one more than the futures, so it can't complete while hooking them up
+  state->remaining = futures.size() + 1;
+  auto finish = [](State& s) {
+    if (--s.remaining == 0) {
+      s.result.set_value();
+    }
+  };
+  auto result = state->result.get_future();
+  for (auto&& f : futures) {
+    if (!f.valid()) {
+      finish(*state);
+    } else {
+      f.then([state, finish] { finish(*state); });
+    }
+  }
+  finish(*state);
+  return result;
+}
+
+future<size_t> when_any(std::vector<future<void>> futures) {
+  struct State {
+    std::atomic_bool done{false};
+    promise<size_t> result;
+  };
+  auto state = std::make_shared<State>();
+  auto result = state->result.get_future();
+  for (size_t i = 0; i < futures.size(); ++i) {
+    if (!futures[i].valid()) {
+      if (!state->done.exchange(true)) {
+        state->result.set_value(i);
+      }
+    } else {
+      futures[i].then([state, i] {
+        if (!state->done.exchange(true)) {
+          state->result.set_value(i);
+        }
+      });
+    }
+  }
+  return result;
+}
+
 }  // namespace wpi
@@ -0,0 +1,391 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/json_document.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "wpi/raw_istream.h"
+
+using namespace wpi;
+
+// The first block, and the smallest size of any block
+static constexpr size_t kMinBlockSize = 4096;
+
+// Keys beyond this many distinct ones are copied into the arena instead, so
+// unusual input can't grow the table without bound
+static constexpr size_t kMaxInternedKeys = 1024;
+
+const char* json_document::value::type_name() const {
+  switch (m_type) {
+    case value_t::null:
+      return "null";
+    case value_t::object:
+      return "object";
+    case value_t::array:
+      return "array";
+    case value_t::string:
+      return "string";
+    case value_t::boolean:
+      return "boolean";
+    case value_t::discarded:
+      return "discarded";
+    default:
+      return "number";
+  }
+}
+
+void json_document::value::throw_type_error(const char* expected) const {
+  throw json::type_error::create(
+      302, fmt::format("type must be {}, but is", expected), type_name());
+}
+
+size_t json_document::value::size() const {
+  switch (m_type) {
+    case value_t::null:
+      return 0;
+    case value_t::object:
+    case value_t::array:
+      return m_size;
+    default:
+      return 1;
+  }
+}
+
+bool json_document::value::get_boolean() const {
+  if (m_type != value_t::boolean) {
+    throw_type_error("boolean");
+  }
+  return m_boolean;
+}
+
+double json_document::value::get_double() const {
+  switch (m_type) {
+    case value_t::number_integer:
+      return static_cast<double>(m_integer);
+    case value_t::number_unsigned:
+      return static_cast<double>(m_unsigned);
+    case value_t::number_float:
+      return m_float;
+    case value_t::boolean:
+      return m_boolean ? 1.0 : 0.0;
+    default:
+      throw_type_error("number");
+  }
+}
+
+int64_t json_document::value::get_int64() const {
+  switch (m_type) {
+    case value_t::number_integer:
+      return m_integer;
+    case value_t::number_unsigned:
+      return static_cast<int64_t>(m_unsigned);
+    case value_t::number_float:
+      return static_cast<int64_t>(m_float);
+    case value_t::boolean:
+      return m_boolean ? 1 : 0;
+    default:
+      throw_type_error("number");
+  }
+}
+
+std::string_view json_document::value::get_string() const {
+  if (m_type != value_t::string) {
+    throw_type_error("string");
+  }
+  return {m_string, m_size};
+}
+
+const json_document::value* json_document::value::find(
+    std::string_view key) const {
+  for (auto&& m : members()) {
+    if (m.key == key) {
+      return &m.val;
+    }
+  }
+  return nullptr;
+}
+
+const json_document::value& json_document::value::at(
+    std::string_view key) const {
+  if (m_type != value_t::object) {
+    throw json::type_error::create(304, "cannot use at() with", type_name());
+  }
+  if (auto val = find(key)) {
+    return *val;
+  }
+  throw json::out_of_range::create(403,
+                                   fmt::format("key '{}' not found", key));
+}
+
+const json_document::value& json_document::value::at(size_t idx) const {
+  if (m_type != value_t::array) {
+    throw json::type_error::create(304, "cannot use at() with", type_name());
+  }
+  if (idx >= m_size) {
+    throw json::out_of_range::create(
+        401, fmt::format("array index {} is out of range", idx));
+  }
+  return m_elements[idx];
+}
+
+span<const json_document::value> json_document::value::elements() const {
+  if (m_type != value_t::array) {
+    return {};
+  }
+  return {m_elements, m_size};
+}
+
+span<const json_document::member> json_document::value::members() const {
+  if (m_type != value_t::object) {
+    return {};
+  }
+  return {m_members, m_size};
+}
+
+json json_document::value::to_json() const {
+  switch (m_type) {
+    case value_t::object: {
+      json result = value_t::object;
+      for (auto&& m : members()) {
+        result.emplace(m.key, m.val.to_json());
+      }
+      return result;
+    }
+    case value_t::array: {
+      json result = value_t::array;
+      for (auto&& element : elements()) {
+        result.push_back(element.to_json());
+      }
+      return result;
+    }
+    case value_t::string:
+      return get_string();
+    case value_t::boolean:
+      return m_boolean;
+    case value_t::number_integer:
+      return m_integer;
+    case value_t::number_unsigned:
+      return m_unsigned;
+    case value_t::number_float:
+      return m_float;
+    default:
+      return nullptr;
+  }
+}
+
+json_document::~json_document() = default;
+
+void json_document::parse(std::string_view s) {
+  raw_mem_istream is(s.data(), s.size());
+  parse(is);
+}
+
+void json_document::parse(raw_istream& is, bool strict) {
+  using event_t = json::pull_parser::event_t;
+
+  clear();
+  m_stack.clear();
+  m_open.clear();
+
+  json::pull_parser parser(is, strict);
+  value root;
+  std::string_view key;
+  for (;;) {
+    value val;
+    // On error the parser throws, leaving the document empty
+    switch (parser.next()) {
+      case event_t::key:
+        key = intern(parser.get_string());
+        continue;
+      case event_t::start_object:
+      case event_t::start_array:
+        m_open.push_back({m_stack.size(), key});
+        continue;
+      case event_t::end_object: {
+        size_t start = m_open.back().start;
+        key = m_open.back().key;
+        m_open.pop_back();
+        size_t count = m_stack.size() - start;
+        auto members = static_cast<member*>(
+            allocate(count * sizeof(member), alignof(member)));
+        std::uninitialized_copy(m_stack.begin() + start, m_stack.end(),
+                                members);
+        m_stack.resize(start);
+        val.m_type = value_t::object;
+        val.m_size = static_cast<uint32_t>(count);
+        val.m_members = members;
+        break;
+      }
+      case event_t::end_array: {
+        size_t start = m_open.back().start;
+        key = m_open.back().key;
+        m_open.pop_back();
+        size_t count = m_stack.size() - start;
+        auto elements = static_cast<value*>(
+            allocate(count * sizeof(value), alignof(value)));
+        for (size_t i = 0; i < count; ++i) {
+          new (&elements[i]) value(m_stack[start + i].val);
+        }
+        m_stack.resize(start);
+        val.m_type = value_t::array;
+        val.m_size = static_cast<uint32_t>(count);
+        val.m_elements = elements;
+        break;
+      }
+      case event_t::null:
+        break;
+      case event_t::boolean:
+        val.m_type = value_t::boolean;
+        val.m_boolean = parser.get_boolean();
+        break;
+      case event_t::number_integer:
+        val.m_type = value_t::number_integer;
+        val.m_integer = parser.get_number_integer();
+        break;
+      case event_t::number_unsigned:
+        val.m_type = value_t::number_unsigned;
+        val.m_unsigned = parser.get_number_unsigned();
+        break;
+      case event_t::number_float:
+        val.m_type = value_t::number_float;
+        val.m_float = parser.get_number_float();
+        break;
+      case event_t::string: {
+        auto str = parser.get_string();
+        val.m_type = value_t::string;
+        val.m_size = static_cast<uint32_t>(str.size());
+        val.m_string = copy_string(str);
+        break;
+      }
+      case event_t::end_of_input:
+      default:
+        m_root = root;
+        return;
+    }
+
+    if (m_open.empty()) {
+      root = val;
+    } else {
+      m_stack.push_back({key, val});
+    }
+    key = {};
+  }
+}
+
+void json_document::assign(const json& j) {
+  clear();
+  m_root = copy_value(j);
+}
+
+json_document::value json_document::copy_value(const json& j) {
+  value val;
+  switch (j.type()) {
+    case value_t::object: {
+      auto members = static_cast<member*>(
+          allocate(j.size() * sizeof(member), alignof(member)));
+      size_t i = 0;
+      for (auto it = j.begin(); it != j.end(); ++it, ++i) {
+        new (&members[i]) member{intern(it.key()), copy_value(it.value())};
+      }
+      val.m_type = value_t::object;
+      val.m_size = static_cast<uint32_t>(i);
+      val.m_members = members;
+      break;
+    }
+    case value_t::array: {
+      auto elements = static_cast<value*>(
+          allocate(j.size() * sizeof(value), alignof(value)));
+      size_t i = 0;
+      for (auto&& element : j) {
+        new (&elements[i++]) value(copy_value(element));
+      }
+      val.m_type = value_t::array;
+      val.m_size = static_cast<uint32_t>(i);
+      val.m_elements = elements;
+      break;
+    }
+    case value_t::string: {
+      auto& str = j.get_ref<const std::string&>();
+      val.m_type = value_t::string;
+      val.m_size = static_cast<uint32_t>(str.size());
+      val.m_string = copy_string(str);
+      break;
+    }
+    case value_t::boolean:
+      val.m_type = value_t::boolean;
+      val.m_boolean = j.get<bool>();
+      break;
+    case value_t::number_integer:
+      val.m_type = value_t::number_integer;
+      val.m_integer = j.get<int64_t>();
+      break;
+    case value_t::number_unsigned:
+      val.m_type = value_t::number_unsigned;
+      val.m_unsigned = j.get<uint64_t>();
+      break;
+    case value_t::number_float:
+      val.m_type = value_t::number_float;
+      val.m_float = j.get<double>();
+      break;
+    default:
+      break;
+  }
+  return val;
+}
+
+void json_document::clear() {
+  m_root = value{};
+
+  // Merge the blocks of a document that outgrew the first one, so the next
+  // parse of a similar input fits in a single block
+  if (m_blocks.size() > 1) {
+    m_blocks.clear();
+    m_blockSize = m_capacity;
+    m_blocks.emplace_back(new char[m_blockSize]);
+  }
+  if (!m_blocks.empty()) {
+    m_cur = m_blocks.front().get();
+    m_end = m_cur + m_blockSize;
+  }
+}
+
+std::string_view json_document::intern(std::string_view key) {
+  auto it = m_keys.find(key);
+  if (it != m_keys.end()) {
+    return it->getKey();
+  }
+  if (m_keys.size() < kMaxInternedKeys) {
+    return m_keys.try_emplace(key).first->getKey();
+  }
+  return {copy_string(key), key.size()};
+}
+
+const char* json_document::copy_string(std::string_view str) {
+  auto buf = static_cast<char*>(allocate(str.size() + 1, 1));
+  std::memcpy(buf, str.data(), str.size());
+  buf[str.size()] = '\0';
+  return buf;
+}
+
+void* json_document::allocate(size_t size, size_t align) {
+  uintptr_t cur = reinterpret_cast<uintptr_t>(m_cur);
+  uintptr_t aligned = (cur + align - 1) & ~(align - 1);
+  if (m_cur == nullptr ||
+      aligned + size > reinterpret_cast<uintptr_t>(m_end)) {
+    // Grow geometrically so a large input takes few blocks
+    m_blockSize = std::max({kMinBlockSize, m_blockSize * 2, size + align});
+    m_blocks.emplace_back(new char[m_blockSize]);
+    m_capacity += m_blockSize;
+    m_cur = m_blocks.back().get();
+    m_end = m_cur + m_blockSize;
+    cur = reinterpret_cast<uintptr_t>(m_cur);
+    aligned = (cur + align - 1) & ~(align - 1);
+  }
+  m_cur = reinterpret_cast<char*>(aligned + size);
+  return reinterpret_cast<void*>(aligned);
+}
@@ -34,6 +34,7 @@ SOFTWARE.
 #define WPI_JSON_IMPLEMENTATION
 #include "wpi/json.h"
 
+#include <array>
 #include <clocale>
 #include <cmath>
 #include <cstdlib>
@@ -43,6 +44,8 @@ SOFTWARE.
 #include "wpi/raw_istream.h"
 #include "wpi/raw_ostream.h"
 
+#include "json_scan.h"
+
 namespace wpi {
 
 /*!
@@ -84,6 +87,17 @@ class json::lexer
     lexer(const lexer&) = delete;
     lexer& operator=(lexer&) = delete;
 
+    /*!
+    @brief read the input in blocks rather than a character at a time
+
+    Only for a parser that reads the input to its end, as the lexer may read
+    past the last token.
+    */
+    void enable_read_ahead() noexcept
+    {
+        read_ahead = true;
+    }
+
   private:
     /////////////////////
     // locales
@@ -270,19 +284,43 @@ class json::lexer
             return current;
         }
         char c;
-        is.read(c);
-        if (JSON_UNLIKELY(is.has_error()))
+        if (JSON_LIKELY(buffer_cur != buffer_end) or (read_ahead and fill_buffer()))
         {
-            current = std::char_traits<char>::eof();
+            c = *buffer_cur++;
         }
         else
         {
-            current = std::char_traits<char>::to_int_type(c);
-            token_string.push_back(c);
+            is.read(c);
+            if (JSON_UNLIKELY(is.has_error()))
+            {
+                current = std::char_traits<char>::eof();
+                return current;
+            }
         }
+        current = std::char_traits<char>::to_int_type(c);
+        token_string.push_back(c);
         return current;
     }
 
+    /// refill the read-ahead buffer with what the input has available;
+    /// false if nothing is available without blocking
+    bool fill_buffer()
+    {
+        const std::size_t n = is.readsome(buffer.data(), buffer.size());
+        buffer_cur = buffer.data();
+        buffer_end = buffer_cur + n;
+        return n != 0;
+    }
+
+    /// consume the next n buffered characters as a sequence of get() would,
+    /// except that current is not updated
+    void skip_buffered(std::size_t n)
+    {
+        token_string.append(buffer_cur, buffer_cur + n);
+        chars_read += n;
+        buffer_cur += n;
+    }
+
     /// unget current character (return it again on next get)
     void unget()
     {
@@ -362,6 +400,14 @@ class json::lexer
         return error_message;
     }
 
+    /*!
+    @brief create the exception for a syntax error
+
+    @param[in] last_token  the unexpected token read
+    @param[in] expected    the token expected instead, or uninitialized
+    */
+    parse_error syntax_error(token_type last_token, token_type expected) const;
+
     /////////////////////
     // actual scanner
     /////////////////////
@@ -378,6 +424,14 @@ class json::lexer
     /// unget characters
     SmallVector<std::char_traits<char>::int_type, 4> unget_chars;
 
+    /// whether to read the input in blocks
+    bool read_ahead = false;
+
+    /// read-ahead buffer and its unread characters
+    std::array<char, 512> buffer;
+    const char* buffer_cur = nullptr;
+    const char* buffer_end = nullptr;
+
     /// the number of characters read
     std::size_t chars_read = 0;
 
@@ -441,6 +495,11 @@ class json::parser
     */
     bool accept(const bool strict = true)
     {
+        if (strict)
+        {
+            m_lexer.enable_read_ahead();
+        }
+
         // read first token
         get_token();
 
@@ -634,6 +693,17 @@ json::lexer::token_type json::lexer::scan_string()
 
     while (true)
     {
+        // copy a buffered run of characters that need no checks at once
+        if (JSON_LIKELY(unget_chars.empty()))
+        {
+            const std::size_t n = detail::count_plain_chars(buffer_cur, buffer_end);
+            if (n != 0)
+            {
+                token_buffer.append(buffer_cur, buffer_cur + n);
+                skip_buffered(n);
+            }
+        }
+
         // get next character
         switch (get())
         {
@@ -1425,6 +1495,16 @@ json::lexer::token_type json::lexer::scan()
     // read next character and ignore whitespace
     do
     {
+        // skip buffered whitespace without going through get()
+        if (JSON_LIKELY(unget_chars.empty()))
+        {
+            const char* p = buffer_cur;
+            while (p != buffer_end and (*p == ' ' or *p == '\t' or *p == '\n' or *p == '\r'))
+            {
+                ++p;
+            }
+            skip_buffered(static_cast<std::size_t>(p - buffer_cur));
+        }
         get();
     }
     while (current == ' ' or current == '\t' or current == '\n' or current == '\r');
@@ -1486,6 +1566,11 @@ json::lexer::token_type json::lexer::scan()
 
 void json::parser::parse(const bool strict, json& result)
 {
+    if (strict)
+    {
+        m_lexer.enable_read_ahead();
+    }
+
     // read first token
     get_token();
 
@@ -1896,25 +1981,503 @@ bool json::parser::accept_internal()
     }
 }
 
-void json::parser::throw_exception() const
+json::parse_error json::lexer::syntax_error(token_type last_token, token_type expected) const
 {
     std::string error_msg = "syntax error - ";
     if (last_token == token_type::parse_error)
     {
-        error_msg += std::string(m_lexer.get_error_message()) + "; last read: '" +
-                     m_lexer.get_token_string() + "'";
+        error_msg += std::string(get_error_message()) + "; last read: '" +
+                     get_token_string() + "'";
     }
     else
     {
-        error_msg += "unexpected " + std::string(lexer_t::token_type_name(last_token));
+        error_msg += "unexpected " + std::string(token_type_name(last_token));
     }
 
     if (expected != token_type::uninitialized)
     {
-        error_msg += "; expected " + std::string(lexer_t::token_type_name(expected));
+        error_msg += "; expected " + std::string(token_type_name(expected));
+    }
+
+    return parse_error::create(101, get_position(), error_msg);
+}
+
+void json::parser::throw_exception() const
+{
+    JSON_THROW(m_lexer.syntax_error(last_token, expected));
+}
+
+/////////////////
+// pull parser //
+/////////////////
+
+/*!
+@brief incremental syntax analysis
+
+This class implements the state machine behind json::pull_parser and
+json::sax_parse.  Rather than recursing, it keeps a stack of the open
+containers and reads just enough tokens for the next event on each call.
+*/
+class json::pull_parser_impl
+{
+    using lexer_t = json::lexer;
+    using token_type = typename lexer_t::token_type;
+    using event_t = json::pull_parser::event_t;
+
+  public:
+    /// a parser reading from an input adapter; errors are thrown unless
+    /// a SAX handler is given to report them to
+    pull_parser_impl(raw_istream& s, const bool strict_, json_sax* sax_ = nullptr)
+        : m_lexer(s), strict(strict_), sax(sax_)
+    {
+        if (strict)
+        {
+            m_lexer.enable_read_ahead();
+        }
     }
 
-    JSON_THROW(parse_error::create(101, m_lexer.get_position(), error_msg));
+    /*!
+    @brief read the next event
+
+    After an error (with a SAX handler), returns event_t::end_of_input.
+    */
+    event_t next();
+
+    /// build the value started by the last event into result
+    void build(json& result);
+
+    /// skip the value started by the last event
+    void skip();
+
+    /// the lexer, holding the values of the last event
+    lexer_t m_lexer;
+    /// the last event
+    event_t event = event_t::end_of_input;
+    /// the value of the last boolean event
+    bool boolean_value = false;
+    /// the open containers; true for objects, false for arrays
+    SmallVector<bool, 16> containers;
+    /// whether an error has been reported to the SAX handler
+    bool errored = false;
+    /// the result of json_sax::parse_error
+    bool sax_result = false;
+
+  private:
+    enum class state_t : uint8_t
+    {
+        begin,        ///< expecting the top-level value
+        first,        ///< just opened a container
+        after_key,    ///< read an object key; expecting `:` and the value
+        after_value,  ///< read a value; expecting `,`, the end of the
+                      ///< container, or (at the top level) the end of input
+        done          ///< the value ended or an error occurred
+    };
+
+    /// get next token from lexer
+    token_type get_token()
+    {
+        return (last_token = m_lexer.scan());
+    }
+
+    /// report an error if the last token is not t
+    bool expect(token_type t)
+    {
+        if (JSON_UNLIKELY(t != last_token))
+        {
+            error(m_lexer.syntax_error(last_token, t));
+            return false;
+        }
+        return true;
+    }
+
+    /// throw ex, or report it to the SAX handler
+    template <typename Exception>
+    void error(const Exception& ex)
+    {
+        state = state_t::done;
+        if (sax == nullptr)
+        {
+            JSON_THROW(ex);
+        }
+        errored = true;
+        sax_result = sax->parse_error(m_lexer.get_position(), ex);
+    }
+
+    /// the event for a value starting with the last token
+    event_t read_value();
+
+    /// the event for an object key, the last token
+    event_t read_key();
+
+    /// the event for the end of the innermost container
+    event_t end_container();
+
+    /// the type of the last read token
+    token_type last_token = token_type::uninitialized;
+    /// the parse state
+    state_t state = state_t::begin;
+    /// whether to expect the end of input after the value
+    const bool strict = true;
+    /// the handler to report errors to, if any
+    json_sax* const sax = nullptr;
+};
+
+json::pull_parser::event_t json::pull_parser_impl::next()
+{
+    switch (state)
+    {
+        case state_t::begin:
+        {
+            get_token();
+            return (event = read_value());
+        }
+
+        case state_t::first:
+        {
+            get_token();
+            if (containers.back())
+            {
+                if (last_token == token_type::end_object)
+                {
+                    return (event = end_container());
+                }
+                return (event = read_key());
+            }
+            if (last_token == token_type::end_array)
+            {
+                return (event = end_container());
+            }
+            return (event = read_value());
+        }
+
+        case state_t::after_key:
+        {
+            get_token();
+            if (not expect(token_type::name_separator))
+            {
+                return (event = event_t::end_of_input);
+            }
+            get_token();
+            return (event = read_value());
+        }
+
+        case state_t::after_value:
+        {
+            if (containers.empty())
+            {
+                // in strict mode, input must be completely read
+                state = state_t::done;
+                if (strict)
+                {
+                    get_token();
+                    expect(token_type::end_of_input);
+                }
+                return (event = event_t::end_of_input);
+            }
+
+            // comma -> next value
+            get_token();
+            bool object = containers.back();
+            if (last_token == token_type::value_separator)
+            {
+                get_token();
+                return (event = object ? read_key() : read_value());
+            }
+
+            // closing } or ]
+            if (not expect(object ? token_type::end_object : token_type::end_array))
+            {
+                return (event = event_t::end_of_input);
+            }
+            return (event = end_container());
+        }
+
+        case state_t::done:
+        default:
+            return (event = event_t::end_of_input);
+    }
+}
+
+json::pull_parser::event_t json::pull_parser_impl::read_value()
+{
+    state = state_t::after_value;
+    switch (last_token)
+    {
+        case token_type::begin_object:
+            containers.push_back(true);
+            state = state_t::first;
+            return event_t::start_object;
+
+        case token_type::begin_array:
+            containers.push_back(false);
+            state = state_t::first;
+            return event_t::start_array;
+
+        case token_type::literal_null:
+            return event_t::null;
+
+        case token_type::literal_true:
+            boolean_value = true;
+            return event_t::boolean;
+
+        case token_type::literal_false:
+            boolean_value = false;
+            return event_t::boolean;
+
+        case token_type::value_string:
+            return event_t::string;
+
+        case token_type::value_unsigned:
+            return event_t::number_unsigned;
+
+        case token_type::value_integer:
+            return event_t::number_integer;
+
+        case token_type::value_float:
+        {
+            // error in case of infinity or NAN
+            if (JSON_UNLIKELY(not std::isfinite(m_lexer.get_number_float())))
+            {
+                error(out_of_range::create(406,
+                    fmt::format("number overflow parsing '{}'", m_lexer.get_token_string())));
+                return event_t::end_of_input;
+            }
+            return event_t::number_float;
+        }
+
+        case token_type::parse_error:
+            // using "uninitialized" to avoid "expected" message
+            expect(token_type::uninitialized);
+            return event_t::end_of_input;
+
+        default:
+            // the last token was unexpected; we expected a value
+            expect(token_type::literal_or_value);
+            return event_t::end_of_input;
+    }
+}
+
+json::pull_parser::event_t json::pull_parser_impl::read_key()
+{
+    if (not expect(token_type::value_string))
+    {
+        return event_t::end_of_input;
+    }
+    state = state_t::after_key;
+    return event_t::key;
+}
+
+json::pull_parser::event_t json::pull_parser_impl::end_container()
+{
+    bool object = containers.back();
+    containers.pop_back();
+    state = state_t::after_value;
+    return object ? event_t::end_object : event_t::end_array;
+}
+
+void json::pull_parser_impl::build(json& result)
+{
+    switch (event)
+    {
+        case event_t::key:
+        {
+            next();
+            build(result);
+            break;
+        }
+
+        case event_t::start_object:
+        {
+            result = value_t::object;
+            while (next() == event_t::key)
+            {
+                // the key is overwritten by reading the value
+                std::string key(m_lexer.get_string());
+                next();
+                json value;
+                build(value);
+                result.m_value.object->try_emplace(key, std::move(value));
+            }
+            break;
+        }
+
+        case event_t::start_array:
+        {
+            result = value_t::array;
+            while (next() != event_t::end_array and event != event_t::end_of_input)
+            {
+                result.m_value.array->emplace_back();
+                build(result.m_value.array->back());
+            }
+            break;
+        }
+
+        case event_t::null:
+            result = nullptr;
+            break;
+
+        case event_t::boolean:
+            result = boolean_value;
+            break;
+
+        case event_t::number_integer:
+            result = m_lexer.get_number_integer();
+            break;
+
+        case event_t::number_unsigned:
+            result = m_lexer.get_number_unsigned();
+            break;
+
+        case event_t::number_float:
+            result = m_lexer.get_number_float();
+            break;
+
+        case event_t::string:
+            result = m_lexer.get_string();
+            break;
+
+        default:
+            break;
+    }
+}
+
+void json::pull_parser_impl::skip()
+{
+    if (event == event_t::key)
+    {
+        next();
+    }
+    if (event == event_t::start_object or event == event_t::start_array)
+    {
+        // read until the container is closed
+        std::size_t depth = containers.size();
+        while (containers.size() >= depth and next() != event_t::end_of_input)
+        {
+        }
+    }
+}
+
+json::pull_parser::pull_parser(raw_istream& i, const bool strict)
+    : m_impl(std::make_unique<pull_parser_impl>(i, strict))
+{}
+
+json::pull_parser::~pull_parser() = default;
+
+json::pull_parser::event_t json::pull_parser::next()
+{
+    return m_impl->next();
+}
+
+json::pull_parser::event_t json::pull_parser::event() const noexcept
+{
+    return m_impl->event;
+}
+
+std::size_t json::pull_parser::depth() const noexcept
+{
+    return m_impl->containers.size();
+}
+
+bool json::pull_parser::get_boolean() const noexcept
+{
+    return m_impl->boolean_value;
+}
+
+int64_t json::pull_parser::get_number_integer() const noexcept
+{
+    return m_impl->m_lexer.get_number_integer();
+}
+
+uint64_t json::pull_parser::get_number_unsigned() const noexcept
+{
+    return m_impl->m_lexer.get_number_unsigned();
+}
+
+double json::pull_parser::get_number_float() const noexcept
+{
+    return m_impl->m_lexer.get_number_float();
+}
+
+std::string_view json::pull_parser::get_string() const noexcept
+{
+    return m_impl->m_lexer.get_string();
+}
+
+json json::pull_parser::get_value()
+{
+    json result;
+    m_impl->build(result);
+    return result;
+}
+
+void json::pull_parser::skip_value()
+{
+    m_impl->skip();
+}
+
+bool json::sax_parse(raw_istream& i, json_sax* sax, const bool strict)
+{
+    using event_t = pull_parser::event_t;
+    pull_parser_impl p(i, strict, sax);
+    for (;;)
+    {
+        bool keep_going = true;
+        switch (p.next())
+        {
+            case event_t::null:
+                keep_going = sax->null();
+                break;
+            case event_t::boolean:
+                keep_going = sax->boolean(p.boolean_value);
+                break;
+            case event_t::number_integer:
+                keep_going = sax->number_integer(p.m_lexer.get_number_integer());
+                break;
+            case event_t::number_unsigned:
+                keep_going = sax->number_unsigned(p.m_lexer.get_number_unsigned());
+                break;
+            case event_t::number_float:
+                keep_going = sax->number_float(p.m_lexer.get_number_float());
+                break;
+            case event_t::string:
+                keep_going = sax->string(p.m_lexer.get_string());
+                break;
+            case event_t::start_object:
+                keep_going = sax->start_object();
+                break;
+            case event_t::key:
+                keep_going = sax->key(p.m_lexer.get_string());
+                break;
+            case event_t::end_object:
+                keep_going = sax->end_object();
+                break;
+            case event_t::start_array:
+                keep_going = sax->start_array();
+                break;
+            case event_t::end_array:
+                keep_going = sax->end_array();
+                break;
+            case event_t::end_of_input:
+            default:
+                return p.errored ? p.sax_result : true;
+        }
+        if (not keep_going)
+        {
+            return false;
+        }
+    }
+}
+
+bool json::sax_parse(std::string_view s, json_sax* sax, const bool strict)
+{
+    raw_mem_istream is(span<const char>(s.data(), s.size()));
+    return sax_parse(is, sax, strict);
+}
+
+bool json::sax_parse(span<const uint8_t> arr, json_sax* sax, const bool strict)
+{
+    raw_mem_istream is(arr);
+    return sax_parse(is, sax, strict);
 }
 
 json json::parse(std::string_view s,
@@ -0,0 +1,90 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define WPI_JSON_SCAN_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define WPI_JSON_SCAN_NEON
+#endif
+
+#include "wpi/MathExtras.h"
+
+namespace wpi::detail {
+
+/*!
+@brief count the leading characters that need no special handling in a string
+
+Both the lexer (reading a string body) and the serializer (escaping one) can
+copy a run of printable ASCII characters other than `"` and `\` as is; any
+other byte (control characters, DEL, and everything that is part of a UTF-8
+sequence) must take the byte-by-byte path.  The run is found 16 bytes at a
+time with SSE2 or NEON where available.
+
+@return the length of the run at the start of [first, last)
+*/
+inline std::size_t count_plain_chars(const char* first, const char* last) noexcept
+{
+    const char* p = first;
+
+#if defined(WPI_JSON_SCAN_SSE2)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i del = _mm_set1_epi8(0x7F);
+    // as signed bytes, 0x80..0xFF are also less than 0x20
+    const __m128i space = _mm_set1_epi8(0x20);
+    for (; last - p >= 16; p += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, del), _mm_cmplt_epi8(v, space)));
+        const int mask = _mm_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return static_cast<std::size_t>(p - first) +
+                   countTrailingZeros(static_cast<unsigned int>(mask));
+        }
+    }
+#elif defined(WPI_JSON_SCAN_NEON)
+    const uint8x16_t quote = vdupq_n_u8('\"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    const uint8x16_t del = vdupq_n_u8(0x7F);
+    for (; last - p >= 16; p += 16)
+    {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        const uint8x16_t special = vorrq_u8(
+            vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)),
+            vorrq_u8(vcltq_u8(v, space), vcgeq_u8(v, del)));
+        // narrow to 4 bits per byte so the mask fits in 64 bits
+        const uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+        if (mask != 0)
+        {
+            return static_cast<std::size_t>(p - first) +
+                   countTrailingZeros(mask) / 4;
+        }
+    }
+#endif
+
+    for (; p != last; ++p)
+    {
+        const auto c = static_cast<unsigned char>(*p);
+        if (c < 0x20 or c >= 0x7F or c == '\"' or c == '\\')
+        {
+            break;
+        }
+    }
+    return static_cast<std::size_t>(p - first);
+}
+
+}  // namespace wpi::detail
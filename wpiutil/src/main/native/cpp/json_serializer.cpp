@@ -38,6 +38,7 @@ SOFTWARE.
 #include "wpi/SmallString.h"
 #include "wpi/raw_os_ostream.h"
 
+#include "json_scan.h"
 #include "json_serializer.h"
 
 namespace wpi {
@@ -1338,6 +1339,22 @@ void json::serializer::dump_escaped(std::string_view s, const bool ensure_ascii)
 
     for (std::size_t i = 0; i < s.size(); ++i)
     {
+        // copy a run of characters that need no escaping in one write
+        if (state == UTF8_ACCEPT)
+        {
+            const std::size_t n = detail::count_plain_chars(s.data() + i,
+                                                            s.data() + s.size());
+            if (n != 0)
+            {
+                o.write(s.data() + i, n);
+                i += n;
+                if (i == s.size())
+                {
+                    break;
+                }
+            }
+        }
+
         const auto byte = static_cast<uint8_t>(s[i]);
 
         switch (decode(state, codepoint, byte))
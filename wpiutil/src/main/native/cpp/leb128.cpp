@@ -4,6 +4,8 @@
 
 #include "wpi/leb128.h"
 
+#include <algorithm>
+
 #include "wpi/raw_istream.h"
 
 namespace wpi {
@@ -18,6 +20,11 @@ uint64_t SizeUleb128(uint64_t val) {
 }
 
 uint64_t WriteUleb128(SmallVectorImpl<char>& dest, uint64_t val) {
+  if (val < 0x80) {
+    dest.push_back(static_cast<char>(val));
+    return 1;
+  }
+
   size_t count = 0;
 
   do {
@@ -35,6 +42,28 @@ uint64_t WriteUleb128(SmallVectorImpl<char>& dest, uint64_t val) {
   return count;
 }
 
+// 64 bits at 7 per byte
+static constexpr size_t kMaxUleb128Size = 10;
+
+size_t WriteUleb128Array(SmallVectorImpl<char>& dest,
+                         span<const uint64_t> vals) {
+  size_t oldSize = dest.size();
+  dest.reserve(oldSize + vals.size() * kMaxUleb128Size);
+  auto out = reinterpret_cast<unsigned char*>(dest.data() + oldSize);
+  auto start = out;
+  for (uint64_t val : vals) {
+    // most sizes and counts fit in a byte
+    while (val >= 0x80) {
+      *out++ = (val & 0x7f) | 0x80;
+      val >>= 7;
+    }
+    *out++ = val;
+  }
+  size_t count = out - start;
+  dest.set_size(oldSize + count);
+  return count;
+}
+
 uint64_t ReadUleb128(const char* addr, uint64_t* ret) {
   uint64_t result = 0;
   int shift = 0;
@@ -45,7 +74,7 @@ uint64_t ReadUleb128(const char* addr, uint64_t* ret) {
     addr++;
     count++;
 
-    result |= (byte & 0x7f) << shift;
+    result |= static_cast<uint64_t>(byte & 0x7f) << shift;
     shift += 7;
 
     if (!(byte & 0x80)) {
@@ -58,6 +87,37 @@ uint64_t ReadUleb128(const char* addr, uint64_t* ret) {
   return count;
 }
 
+size_t ReadUleb128(span<const char> buf, uint64_t* ret) {
+  auto data = reinterpret_cast<const unsigned char*>(buf.data());
+  if (!buf.empty() && data[0] < 0x80) {
+    *ret = data[0];
+    return 1;
+  }
+
+  size_t len = (std::min)(buf.size(), kMaxUleb128Size);
+  uint64_t result = 0;
+  for (size_t i = 0; i < len; ++i) {
+    result |= static_cast<uint64_t>(data[i] & 0x7f) << (7 * i);
+    if (!(data[i] & 0x80)) {
+      *ret = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+size_t ReadUleb128Array(span<const char> buf, span<uint64_t> vals) {
+  size_t pos = 0;
+  for (auto&& val : vals) {
+    size_t count = ReadUleb128(buf.subspan(pos), &val);
+    if (count == 0) {
+      return 0;
+    }
+    pos += count;
+  }
+  return pos;
+}
+
 bool ReadUleb128(raw_istream& is, uint64_t* ret) {
   uint64_t result = 0;
   int shift = 0;
@@ -69,7 +129,7 @@ bool ReadUleb128(raw_istream& is, uint64_t* ret) {
       return false;
     }
 
-    result |= (byte & 0x7f) << shift;
+    result |= static_cast<uint64_t>(byte & 0x7f) << shift;
     shift += 7;
 
     if (!(byte & 0x80)) {
@@ -16,22 +16,95 @@
 #include "wpi/Compiler.h"
 #include "wpi/MathExtras.h"
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 using namespace wpi;
 
-/// HashString - Hash function for strings.
+static constexpr uint64_t kHashSecret[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull,
+    0x589965cc75374cc3ull};
+
+/// Multiplies A and B to 128 bits, returning the low half in A and the high
+/// half in B.
+static inline void HashMultiply(uint64_t &A, uint64_t &B) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t R = A;
+  R *= B;
+  A = static_cast<uint64_t>(R);
+  B = static_cast<uint64_t>(R >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  A = _umul128(A, B, &B);
+#else
+  uint64_t HA = A >> 32, HB = B >> 32, LA = A & 0xffffffff,
+           LB = B & 0xffffffff;
+  uint64_t RH = HA * HB, RM0 = HA * LB, RM1 = HB * LA, RL = LA * LB;
+  uint64_t T = RL + (RM0 << 32);
+  uint64_t C = T < RL;
+  uint64_t Lo = T + (RM1 << 32);
+  C += Lo < T;
+  A = Lo;
+  B = RH + (RM0 >> 32) + (RM1 >> 32) + C;
+#endif
+}
+
+static inline uint64_t HashMix(uint64_t A, uint64_t B) {
+  HashMultiply(A, B);
+  return A ^ B;
+}
+
+static inline uint64_t HashRead64(const unsigned char *P) {
+  uint64_t V;
+  std::memcpy(&V, P, sizeof(V));
+  return V;
+}
+
+static inline uint64_t HashRead32(const unsigned char *P) {
+  uint32_t V;
+  std::memcpy(&V, P, sizeof(V));
+  return V;
+}
+
+/// hash - Hash function for strings.
 ///
-/// This is the Bernstein hash function.
-//
-// FIXME: Investigate whether a modified bernstein hash function performs
-// better: http://eternallyconfuzzled.com/tuts/algorithms/jsw_tut_hashing.aspx
-//   X*33+c -> X*33^c
-static inline unsigned HashString(std::string_view str,
-                                  unsigned result = 0) noexcept {
-  for (std::string_view::size_type i = 0, e = str.size(); i != e; ++i) {
-    result = result * 33 + static_cast<unsigned char>(str[i]);
+/// This is wyhash (final version 4), which mixes 8 or 16 bytes per multiply
+/// instead of a byte at a time.  The result depends on the host byte order,
+/// which is fine as it is never stored outside the process.
+uint32_t StringMapImpl::hash(std::string_view Key) {
+  auto P = reinterpret_cast<const unsigned char *>(Key.data());
+  size_t Len = Key.size();
+  uint64_t Seed = HashMix(kHashSecret[0], kHashSecret[1]);
+  uint64_t A, B;
+  if (LLVM_LIKELY(Len <= 16)) {
+    if (LLVM_LIKELY(Len >= 4)) {
+      size_t Off = (Len >> 3) << 2;
+      A = (HashRead32(P) << 32) | HashRead32(P + Off);
+      B = (HashRead32(P + Len - 4) << 32) | HashRead32(P + Len - 4 - Off);
+    } else if (LLVM_LIKELY(Len > 0)) {
+      A = (uint64_t{P[0]} << 16) | (uint64_t{P[Len >> 1]} << 8) | P[Len - 1];
+      B = 0;
+    } else {
+      A = B = 0;
+    }
+  } else {
+    size_t I = Len;
+    while (I > 16) {
+      Seed = HashMix(HashRead64(P) ^ kHashSecret[1], HashRead64(P + 8) ^ Seed);
+      I -= 16;
+      P += 16;
+    }
+    A = HashRead64(P + I - 16);
+    B = HashRead64(P + I - 8);
   }
-  return result;
+  A ^= kHashSecret[1];
+  B ^= Seed;
+  HashMultiply(A, B);
+  return static_cast<uint32_t>(
+      HashMix(A ^ kHashSecret[0] ^ Len, B ^ kHashSecret[1]));
 }
 
 /// Returns the number of buckets to allocate to ensure that the DenseMap can
@@ -45,8 +118,10 @@ static unsigned getMinBucketToReserveForEntries(unsigned NumEntries) {
   return NextPowerOf2(NumEntries * 4 / 3 + 1);
 }
 
-StringMapImpl::StringMapImpl(unsigned InitSize, unsigned itemSize) {
+StringMapImpl::StringMapImpl(unsigned InitSize, unsigned itemSize,
+                             MemoryResource *resource) {
   ItemSize = itemSize;
+  Resource = resource;
 
   // If a size is specified, initialize the table with that many buckets.
   if (InitSize) {
@@ -72,9 +147,7 @@ void StringMapImpl::init(unsigned InitSize) {
   NumItems = 0;
   NumTombstones = 0;
 
-  TheTable = static_cast<StringMapEntryBase **>(
-      safe_calloc(NewNumBuckets+1,
-                  sizeof(StringMapEntryBase **) + sizeof(unsigned)));
+  TheTable = allocateTable(NewNumBuckets);
 
   // Set the member only if TheTable was successfully allocated
   NumBuckets = NewNumBuckets;
@@ -84,18 +157,42 @@ void StringMapImpl::init(unsigned InitSize) {
   TheTable[NumBuckets] = (StringMapEntryBase*)2;
 }
 
+StringMapEntryBase **StringMapImpl::allocateTable(unsigned Size) {
+  size_t BucketSize = sizeof(StringMapEntryBase *) + sizeof(unsigned);
+  if (!Resource) {
+    return static_cast<StringMapEntryBase **>(
+        safe_calloc(Size + 1, BucketSize));
+  }
+  void *Table = Resource->Allocate((Size + 1) * BucketSize,
+                                   alignof(StringMapEntryBase *));
+  std::memset(Table, 0, (Size + 1) * BucketSize);
+  return static_cast<StringMapEntryBase **>(Table);
+}
+
+void StringMapImpl::freeTable(StringMapEntryBase **Table, unsigned Size) {
+  if (!Resource) {
+    free(Table);
+  } else if (Table) {
+    Resource->Deallocate(Table,
+                         (Size + 1) * (sizeof(StringMapEntryBase *) +
+                                       sizeof(unsigned)),
+                         alignof(StringMapEntryBase *));
+  }
+}
+
 /// LookupBucketFor - Look up the bucket that the specified string should end
 /// up in.  If it already exists as a key in the map, the Item pointer for the
 /// specified bucket will be non-null.  Otherwise, it will be null.  In either
 /// case, the FullHashValue field of the bucket will be set to the hash value
 /// of the string.
-unsigned StringMapImpl::LookupBucketFor(std::string_view Name) {
+unsigned StringMapImpl::LookupBucketFor(std::string_view Name,
+                                        uint32_t FullHashValue) {
+  assert(FullHashValue == hash(Name) && "hash does not match the key");
   unsigned HTSize = NumBuckets;
   if (HTSize == 0) {  // Hash table unallocated so far?
     init(16);
     HTSize = NumBuckets;
   }
-  unsigned FullHashValue = HashString(Name);
   unsigned BucketNo = FullHashValue & (HTSize-1);
   unsigned *HashTable = (unsigned *)(TheTable + NumBuckets + 1);
 
@@ -146,10 +243,11 @@ unsigned StringMapImpl::LookupBucketFor(std::string_view Name) {
 /// FindKey - Look up the bucket that contains the specified key. If it exists
 /// in the map, return the bucket number of the key.  Otherwise return -1.
 /// This does not modify the map.
-int StringMapImpl::FindKey(std::string_view Key) const {
+int StringMapImpl::FindKey(std::string_view Key,
+                           uint32_t FullHashValue) const {
+  assert(FullHashValue == hash(Key) && "hash does not match the key");
   unsigned HTSize = NumBuckets;
   if (HTSize == 0) return -1;  // Really empty table?
-  unsigned FullHashValue = HashString(Key);
   unsigned BucketNo = FullHashValue & (HTSize-1);
   unsigned *HashTable = (unsigned *)(TheTable + NumBuckets + 1);
 
@@ -231,8 +329,7 @@ unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
   unsigned NewBucketNo = BucketNo;
   // Allocate one extra bucket which will always be non-empty.  This allows the
   // iterators to stop at end.
-  auto NewTableArray = static_cast<StringMapEntryBase **>(
-      safe_calloc(NewSize+1, sizeof(StringMapEntryBase *) + sizeof(unsigned)));
+  auto NewTableArray = allocateTable(NewSize);
 
   unsigned *NewHashArray = (unsigned *)(NewTableArray + NewSize + 1);
   NewTableArray[NewSize] = (StringMapEntryBase*)2;
@@ -267,7 +364,7 @@ unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
     }
   }
 
-  free(TheTable);
+  freeTable(TheTable, NumBuckets);
 
   TheTable = NewTableArray;
   NumBuckets = NewSize;
@@ -0,0 +1,88 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/lock_stats.h"
+
+#include <memory>
+#include <mutex>
+
+#include "wpi/MathExtras.h"
+#include "wpi/StringMap.h"
+
+using namespace wpi;
+
+namespace {
+struct Registry {
+  // not a wpi::mutex, which may itself be instrumented
+  std::mutex mutex;
+  wpi::StringMap<std::unique_ptr<detail::LockStatsEntry>> entries;
+  // in order of creation
+  std::vector<detail::LockStatsEntry*> order;
+};
+}  // namespace
+
+static Registry& GetRegistry() {
+  // leaked, as locks may be used during static destruction
+  static Registry* registry = new Registry;
+  return *registry;
+}
+
+void detail::LockStatsEntry::RecordWait(uint64_t waitNs) {
+  contentions.fetch_add(1, std::memory_order_relaxed);
+  totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+  UpdateMax(maxWaitNs, waitNs);
+  uint64_t us = waitNs / 1000;
+  size_t bucket = us == 0 ? 0 : Log2_64(us) + 1;
+  if (bucket >= kLockWaitBuckets) {
+    bucket = kLockWaitBuckets - 1;
+  }
+  waitHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+detail::LockStatsEntry* detail::GetLockStatsEntry(std::string_view name) {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock{registry.mutex};
+  auto& entry = registry.entries[name];
+  if (!entry) {
+    entry = std::make_unique<LockStatsEntry>(name);
+    registry.order.emplace_back(entry.get());
+  }
+  return entry.get();
+}
+
+std::vector<LockStats> wpi::GetLockStats() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock{registry.mutex};
+  std::vector<LockStats> rv;
+  rv.reserve(registry.order.size());
+  for (auto entry : registry.order) {
+    auto& stats = rv.emplace_back();
+    stats.name = entry->name;
+    stats.acquisitions = entry->acquisitions.load(std::memory_order_relaxed);
+    stats.contentions = entry->contentions.load(std::memory_order_relaxed);
+    stats.totalWaitNs = entry->totalWaitNs.load(std::memory_order_relaxed);
+    stats.maxWaitNs = entry->maxWaitNs.load(std::memory_order_relaxed);
+    stats.maxHoldNs = entry->maxHoldNs.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kLockWaitBuckets; ++i) {
+      stats.waitHistogram[i] =
+          entry->waitHistogram[i].load(std::memory_order_relaxed);
+    }
+  }
+  return rv;
+}
+
+void wpi::ResetLockStats() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock{registry.mutex};
+  for (auto entry : registry.order) {
+    entry->acquisitions.store(0, std::memory_order_relaxed);
+    entry->contentions.store(0, std::memory_order_relaxed);
+    entry->totalWaitNs.store(0, std::memory_order_relaxed);
+    entry->maxWaitNs.store(0, std::memory_order_relaxed);
+    entry->maxHoldNs.store(0, std::memory_order_relaxed);
+    for (auto& count : entry->waitHistogram) {
+      count.store(0, std::memory_order_relaxed);
+    }
+  }
+}
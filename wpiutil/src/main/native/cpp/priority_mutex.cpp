@@ -0,0 +1,148 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/priority_mutex.h"
+
+#ifdef __linux__
+
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+using namespace wpi;
+
+static long Futex(std::atomic<uint32_t>* addr, int op, uint32_t val,  // NOLINT
+                  const timespec* timeout, std::atomic<uint32_t>* addr2,
+                  uint32_t val3) {
+  return ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), op, val,
+                   timeout, reinterpret_cast<uint32_t*>(addr2), val3);
+}
+
+static timespec ToTimespec(std::chrono::steady_clock::time_point time) {
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                time.time_since_epoch())
+                .count();
+  if (ns < 0) {
+    ns = 0;
+  }
+  timespec ts;
+  ts.tv_sec = ns / 1000000000;
+  ts.tv_nsec = ns % 1000000000;
+  return ts;
+}
+
+// A forked child has a new TID, so the cached one is invalidated
+static std::atomic<unsigned int> gForkGeneration{0};
+
+uint32_t detail::GetCurrentThreadTid() {
+  static int registered = pthread_atfork(nullptr, nullptr, [] {
+    gForkGeneration.fetch_add(1, std::memory_order_relaxed);
+  });
+  (void)registered;
+  thread_local unsigned int generation = UINT_MAX;
+  thread_local uint32_t tid = 0;
+  unsigned int current = gForkGeneration.load(std::memory_order_relaxed);
+  if (generation != current) {
+    tid = ::syscall(SYS_gettid);
+    generation = current;
+  }
+  return tid;
+}
+
+void detail::PriorityMutexLock(std::atomic<uint32_t>* word) {
+  while (Futex(word, FUTEX_LOCK_PI_PRIVATE, 0, nullptr, nullptr, 0) != 0) {
+    // interrupted, or the owner is exiting
+    if (errno != EINTR && errno != EAGAIN) {
+      // e.g. already held by this thread, or no PI futexes in this kernel
+      throw std::system_error(errno, std::generic_category(),
+                              "priority_mutex lock");
+    }
+  }
+}
+
+void detail::PriorityMutexUnlock(std::atomic<uint32_t>* word) {
+  Futex(word, FUTEX_UNLOCK_PI_PRIVATE, 0, nullptr, nullptr, 0);
+}
+
+bool priority_condition_variable::WaitPi(
+    std::atomic<uint32_t>& mutex,
+    const std::chrono::steady_clock::time_point* timeout) {
+  uint32_t seq = Prepare();
+  m_mutex.store(&mutex);
+
+  // unlock as priority_mutex::unlock() does
+  uint32_t expected = detail::GetCurrentThreadTid();
+  if (!mutex.compare_exchange_strong(expected, 0, std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+    detail::PriorityMutexUnlock(&mutex);
+  }
+
+  timespec ts;
+  if (timeout) {
+    ts = ToTimespec(*timeout);
+  }
+  // the kernel takes the mutex for us before returning 0
+  long rv = Futex(&m_seq, FUTEX_WAIT_REQUEUE_PI_PRIVATE, seq,  // NOLINT
+                  timeout ? &ts : nullptr, &mutex, 0);
+  int err = rv == 0 ? 0 : errno;
+  m_waiters.fetch_sub(1);
+
+  // after a timeout the kernel may have taken the mutex anyway
+  if (rv != 0 && !detail::PriorityMutexIsOwner(mutex)) {
+    expected = 0;
+    if (!mutex.compare_exchange_strong(
+            expected, detail::GetCurrentThreadTid(), std::memory_order_acquire,
+            std::memory_order_relaxed)) {
+      detail::PriorityMutexLock(&mutex);
+    }
+  }
+  return err != ETIMEDOUT;
+}
+
+bool priority_condition_variable::WaitPlain(
+    uint32_t seq, const std::chrono::steady_clock::time_point* timeout) {
+  timespec ts;
+  if (timeout) {
+    ts = ToTimespec(*timeout);
+  }
+  // an absolute timeout needs the bitset variant
+  long rv = Futex(&m_seq, FUTEX_WAIT_BITSET_PRIVATE, seq,  // NOLINT
+                  timeout ? &ts : nullptr, nullptr, FUTEX_BITSET_MATCH_ANY);
+  int err = rv == 0 ? 0 : errno;
+  m_waiters.fetch_sub(1);
+  return err != ETIMEDOUT;
+}
+
+void priority_condition_variable::Notify(bool all) {
+  m_seq.fetch_add(1);
+  if (m_waiters.load() == 0) {
+    return;
+  }
+  if (auto mutex = m_mutex.load()) {
+    // move the waiters onto the mutex; fails if notified meanwhile
+    for (;;) {
+      uint32_t seq = m_seq.load();
+      if (Futex(&m_seq, FUTEX_CMP_REQUEUE_PI_PRIVATE, 1,
+                // the timeout argument is the number to requeue
+                reinterpret_cast<const timespec*>(
+                    static_cast<uintptr_t>(all ? INT_MAX : 0)),
+                mutex, seq) >= 0) {
+        return;
+      }
+      if (errno != EAGAIN) {
+        // waiters without a priority_mutex
+        break;
+      }
+    }
+  }
+  Futex(&m_seq, FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, nullptr, nullptr, 0);
+}
+
+#endif  // __linux__
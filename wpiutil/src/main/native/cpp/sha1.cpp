@@ -19,6 +19,17 @@
 
 #include "wpi/sha1.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if defined(__aarch64__) && \
+    (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define WPI_SHA1_ARM
+#include <arm_neon.h>
+#endif
+
+#include "cpu_features.h"
 #include "wpi/SmallVector.h"
 #include "wpi/StringExtras.h"
 #include "wpi/raw_istream.h"
@@ -212,13 +223,180 @@ static void buffer_to_block(const unsigned char* buffer,
   }
 }
 
+#ifdef WPI_CPU_X86
+/*
+ * SHA extensions: each sha1rnds4 does four rounds, with sha1nexte deriving
+ * E for the next four and sha1msg1/sha1msg2 the message schedule.  Step k
+ * does rounds 4k to 4k+3; msg[k % 4] holds their message words.
+ */
+template <int k>
+WPI_TARGET("sha,sse4.1,ssse3")
+static inline void sha_ni_step(__m128i& abcd, __m128i e[2], __m128i msg[4]) {
+  __m128i& cur = e[k % 2];
+  if constexpr (k == 0) {
+    cur = _mm_add_epi32(cur, msg[0]);
+  } else {
+    cur = _mm_sha1nexte_epu32(cur, msg[k % 4]);
+  }
+  e[(k + 1) % 2] = abcd;
+  if constexpr (k >= 3 && k <= 18) {
+    msg[(k + 1) % 4] = _mm_sha1msg2_epu32(msg[(k + 1) % 4], msg[k % 4]);
+  }
+  abcd = _mm_sha1rnds4_epu32(abcd, cur, k / 5);
+  if constexpr (k >= 1 && k <= 16) {
+    msg[(k + 3) % 4] = _mm_sha1msg1_epu32(msg[(k + 3) % 4], msg[k % 4]);
+  }
+  if constexpr (k >= 2 && k <= 17) {
+    msg[(k + 2) % 4] = _mm_xor_si128(msg[(k + 2) % 4], msg[k % 4]);
+  }
+}
+
+template <int... k>
+WPI_TARGET("sha,sse4.1,ssse3")
+static inline void sha_ni_steps(__m128i& abcd, __m128i e[2], __m128i msg[4],
+                                std::integer_sequence<int, k...>) {
+  (sha_ni_step<k>(abcd, e, msg), ...);
+}
+
+WPI_TARGET("sha,sse4.1,ssse3")
+static void transform_sha_ni(uint32_t digest[], const unsigned char* data,
+                             size_t blocks) {
+  // the instructions want A in the high lane and big-endian words
+  const __m128i byteSwap =
+      _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+  __m128i abcd = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(digest)), 0x1b);
+  __m128i e0 = _mm_set_epi32(digest[4], 0, 0, 0);
+
+  for (; blocks > 0; --blocks, data += BLOCK_BYTES) {
+    __m128i abcdSave = abcd;
+    __m128i eSave = e0;
+    __m128i msg[4];
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)),
+          byteSwap);
+    }
+    __m128i e[2] = {e0, e0};
+    sha_ni_steps(abcd, e, msg, std::make_integer_sequence<int, 20>{});
+    // step 19 left the E of the next block's first round in e[0]
+    e0 = _mm_sha1nexte_epu32(e[0], eSave);
+    abcd = _mm_add_epi32(abcd, abcdSave);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(digest),
+                   _mm_shuffle_epi32(abcd, 0x1b));
+  digest[4] = _mm_extract_epi32(e0, 3);
+}
+#endif  // WPI_CPU_X86
+
+#ifdef WPI_SHA1_ARM
+/*
+ * ARMv8 crypto extensions: each vsha1 step does four rounds; vsha1h gives E
+ * for the next four and vsha1su0/vsha1su1 the message schedule.
+ */
+static void transform_arm(uint32_t digest[], const unsigned char* data,
+                          size_t blocks) {
+  uint32x4_t abcd = vld1q_u32(digest);
+  uint32_t e0 = digest[4];
+  const uint32x4_t k0 = vdupq_n_u32(0x5a827999);
+  const uint32x4_t k1 = vdupq_n_u32(0x6ed9eba1);
+  const uint32x4_t k2 = vdupq_n_u32(0x8f1bbcdc);
+  const uint32x4_t k3 = vdupq_n_u32(0xca62c1d6);
+
+  for (; blocks > 0; --blocks, data += BLOCK_BYTES) {
+    uint32x4_t abcdSave = abcd;
+    uint32_t eSave = e0;
+    uint32x4_t msg[4];
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+    }
+    uint32_t e = e0;
+    for (int k = 0; k < 20; ++k) {
+      const uint32x4_t& kk = k < 5 ? k0 : k < 10 ? k1 : k < 15 ? k2 : k3;
+      uint32x4_t wk = vaddq_u32(msg[k % 4], kk);
+      uint32_t next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+      if (k < 5) {
+        abcd = vsha1cq_u32(abcd, e, wk);
+      } else if (k >= 10 && k < 15) {
+        abcd = vsha1mq_u32(abcd, e, wk);
+      } else {
+        abcd = vsha1pq_u32(abcd, e, wk);
+      }
+      e = next;
+      // the words four steps on
+      if (k < 16) {
+        msg[k % 4] = vsha1su1q_u32(
+            vsha1su0q_u32(msg[k % 4], msg[(k + 1) % 4], msg[(k + 2) % 4]),
+            msg[(k + 3) % 4]);
+      }
+    }
+    abcd = vaddq_u32(abcd, abcdSave);
+    e0 = e + eSave;
+  }
+
+  vst1q_u32(digest, abcd);
+  digest[4] = e0;
+}
+#endif  // WPI_SHA1_ARM
+
+/*
+ * Hashes whole blocks straight from data, with the SHA instructions if the
+ * CPU has them.
+ */
+static void transform_blocks(uint32_t digest[], const unsigned char* data,
+                             size_t blocks, uint64_t& transforms) {
+  transforms += blocks;
+#if defined(WPI_CPU_X86)
+  const auto& cpu = detail::CpuFeatures::Get();
+  if (cpu.sha && cpu.sse41 && cpu.ssse3) {
+    transform_sha_ni(digest, data, blocks);
+    return;
+  }
+#elif defined(WPI_SHA1_ARM)
+  transform_arm(digest, data, blocks);
+  return;
+#endif
+  uint64_t unused = 0;
+  for (; blocks > 0; --blocks, data += BLOCK_BYTES) {
+    uint32_t block[BLOCK_INTS];
+    buffer_to_block(data, block);
+    do_transform(digest, block, unused);
+  }
+}
+
 SHA1::SHA1() {
   reset(digest, buf_size, transforms);
 }
 
 void SHA1::Update(std::string_view s) {
-  raw_mem_istream is(span<const char>(s.data(), s.size()));
-  Update(is);
+  auto data = reinterpret_cast<const unsigned char*>(s.data());
+  size_t len = s.size();
+
+  // top up a partial block first
+  if (buf_size != 0) {
+    size_t n = (std::min)(len, BLOCK_BYTES - buf_size);
+    std::memcpy(&buffer[buf_size], data, n);
+    buf_size += n;
+    data += n;
+    len -= n;
+    if (buf_size != BLOCK_BYTES) {
+      return;
+    }
+    transform_blocks(digest, buffer, 1, transforms);
+    buf_size = 0;
+  }
+
+  // whole blocks needn't be copied
+  size_t blocks = len / BLOCK_BYTES;
+  if (blocks != 0) {
+    transform_blocks(digest, data, blocks, transforms);
+    data += blocks * BLOCK_BYTES;
+    len -= blocks * BLOCK_BYTES;
+  }
+
+  std::memcpy(buffer, data, len);
+  buf_size = len;
 }
 
 void SHA1::Update(raw_istream& is) {
@@ -227,9 +405,7 @@ void SHA1::Update(raw_istream& is) {
     if (buf_size != BLOCK_BYTES) {
       return;
     }
-    uint32_t block[BLOCK_INTS];
-    buffer_to_block(buffer, block);
-    do_transform(digest, block, transforms);
+    transform_blocks(digest, buffer, 1, transforms);
     buf_size = 0;
   }
 }
@@ -249,20 +425,16 @@ static void finalize(uint32_t digest[], unsigned char* buffer, size_t& buf_size,
     buffer[i] = 0x00;
   }
 
-  uint32_t block[BLOCK_INTS];
-  buffer_to_block(buffer, block);
-
   if (buf_size > BLOCK_BYTES - 8) {
-    do_transform(digest, block, transforms);
-    for (size_t i = 0; i < BLOCK_INTS - 2; i++) {
-      block[i] = 0;
-    }
+    transform_blocks(digest, buffer, 1, transforms);
+    std::memset(buffer, 0, BLOCK_BYTES - 8);
   }
 
-  /* Append total_bits, split this uint64_t into two uint32_t */
-  block[BLOCK_INTS - 1] = total_bits;
-  block[BLOCK_INTS - 2] = (total_bits >> 32);
-  do_transform(digest, block, transforms);
+  /* Append total_bits, big-endian */
+  for (size_t i = 0; i < 8; i++) {
+    buffer[BLOCK_BYTES - 1 - i] = (total_bits >> (8 * i)) & 0xff;
+  }
+  transform_blocks(digest, buffer, 1, transforms);
 
   /* Hex string */
   static const char* const LUT = "0123456789abcdef";
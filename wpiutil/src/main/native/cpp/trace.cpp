@@ -0,0 +1,263 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/trace.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "wpi/fmt/raw_ostream.h"
+#include "wpi/raw_ostream.h"
+#include "wpi/static_spsc_ring.h"
+
+using namespace wpi;
+
+namespace {
+
+struct Event {
+  const char* name;
+  uint64_t start;
+  uint64_t duration;
+};
+
+// Written by its thread, drained by the collector
+struct ThreadBuffer {
+  explicit ThreadBuffer(int tid) : tid{tid} {}
+
+  static_spsc_ring<Event, 2048> ring;
+  const int tid;
+  std::atomic<uint64_t> dropped{0};
+  // set when the thread exits; the collector frees the buffer once drained
+  std::atomic<bool> exited{false};
+};
+
+struct CollectedEvent {
+  Event event;
+  int tid;
+};
+
+struct Collector {
+  // not a wpi::mutex, which may itself be instrumented
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  // names of every thread that ever had a buffer, by tid
+  std::vector<std::string> threadNames;
+  std::vector<CollectedEvent> events;
+  size_t maxEvents = 0;
+  uint64_t dropped = 0;
+  uint64_t startTime = 0;
+  int nextTid = 1;
+  bool running = false;
+  std::thread thread;
+
+  void Drain();
+  void Main();
+};
+
+// The calling thread's buffer and name
+struct ThreadState {
+  ~ThreadState() {
+    if (buffer) {
+      buffer->exited = true;
+    }
+  }
+
+  ThreadBuffer* buffer = nullptr;
+  std::string name;
+};
+
+}  // namespace
+
+static Collector& GetCollector() {
+  // leaked, as threads may record during static destruction
+  static Collector* collector = new Collector;
+  return *collector;
+}
+
+static ThreadState& GetThreadState() {
+  thread_local ThreadState state;
+  return state;
+}
+
+void Collector::Drain() {
+  for (auto&& buffer : buffers) {
+    bool exited = buffer->exited;
+    Event popped[256];
+    while (size_t count = buffer->ring.pop(popped)) {
+      for (size_t i = 0; i < count; ++i) {
+        if (events.size() < maxEvents) {
+          events.push_back({popped[i], buffer->tid});
+        } else {
+          ++dropped;
+        }
+      }
+    }
+    dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+    // an exited thread pushed nothing after setting exited
+    if (exited) {
+      buffer.reset();
+    }
+  }
+  buffers.erase(std::remove(buffers.begin(), buffers.end(), nullptr),
+                buffers.end());
+}
+
+void Collector::Main() {
+  std::unique_lock lock{mutex};
+  while (running) {
+    wakeup.wait_for(lock, std::chrono::milliseconds(10));
+    Drain();
+  }
+}
+
+void detail::RecordTraceEvent(const char* name, uint64_t start,
+                              uint64_t duration) {
+  auto& state = GetThreadState();
+  if (!state.buffer) {
+    auto& collector = GetCollector();
+    std::scoped_lock lock{collector.mutex};
+    int tid = collector.nextTid++;
+    state.buffer =
+        collector.buffers.emplace_back(std::make_unique<ThreadBuffer>(tid))
+            .get();
+    collector.threadNames.resize(tid + 1);
+    collector.threadNames[tid] = state.name;
+  }
+  if (!state.buffer->ring.push({name, start, duration})) {
+    state.buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void detail::SetTraceThreadName(std::string_view name) {
+  auto& state = GetThreadState();
+  state.name = name;
+  if (state.buffer) {
+    auto& collector = GetCollector();
+    std::scoped_lock lock{collector.mutex};
+    collector.threadNames[state.buffer->tid] = name;
+  }
+}
+
+void wpi::StartTracing(size_t maxEvents) {
+  auto& collector = GetCollector();
+  std::scoped_lock lock{collector.mutex};
+  if (collector.running) {
+    return;
+  }
+  // discard anything left from the last run
+  collector.maxEvents = 0;
+  collector.Drain();
+  collector.events.clear();
+  collector.events.shrink_to_fit();
+  collector.maxEvents = maxEvents;
+  collector.dropped = 0;
+  collector.startTime = detail::TraceNow();
+  collector.running = true;
+  collector.thread = std::thread{[&] { collector.Main(); }};
+  detail::gTracing = true;
+}
+
+void wpi::StopTracing() {
+  auto& collector = GetCollector();
+  std::thread thread;
+  {
+    std::scoped_lock lock{collector.mutex};
+    if (!collector.running) {
+      return;
+    }
+    detail::gTracing = false;
+    collector.running = false;
+    thread = std::move(collector.thread);
+  }
+  collector.wakeup.notify_all();
+  thread.join();
+  std::scoped_lock lock{collector.mutex};
+  collector.Drain();
+}
+
+uint64_t wpi::GetTraceDroppedEvents() {
+  auto& collector = GetCollector();
+  std::scoped_lock lock{collector.mutex};
+  return collector.dropped;
+}
+
+// Writes a JSON string; names and thread names are not expected to need
+// more than quotes, backslashes and control characters escaped
+static void WriteString(raw_ostream& os, std::string_view str) {
+  os << '"';
+  for (char ch : str) {
+    if (ch == '"' || ch == '\\') {
+      os << '\\' << ch;
+    } else if (static_cast<unsigned char>(ch) < 0x20) {
+      fmt::print(os, "\\u{:04x}", static_cast<unsigned int>(ch));
+    } else {
+      os << ch;
+    }
+  }
+  os << '"';
+}
+
+void wpi::WriteTrace(raw_ostream& os) {
+  auto& collector = GetCollector();
+  std::scoped_lock lock{collector.mutex};
+  collector.Drain();
+
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (size_t tid = 1; tid < collector.threadNames.size(); ++tid) {
+    auto& name = collector.threadNames[tid];
+    if (name.empty()) {
+      continue;
+    }
+    os << (first ? "\n" : ",\n");
+    first = false;
+    fmt::print(os,
+               "{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,"
+               "\"tid\":{},\"args\":{{\"name\":",
+               tid);
+    WriteString(os, name);
+    os << "}}";
+  }
+
+  for (auto&& [event, tid] : collector.events) {
+    os << (first ? "\n" : ",\n");
+    first = false;
+    std::string_view name = event.name;
+    os << "{\"name\":";
+    WriteString(os, name);
+    os << ",\"cat\":";
+    WriteString(os, name.substr(0, name.find('.')));
+    // timestamps are in microseconds
+    double ts = (static_cast<int64_t>(event.start - collector.startTime)) /
+                1000.0;
+    if (event.duration == UINT64_MAX) {
+      fmt::print(os, ",\"ph\":\"i\",\"s\":\"t\",\"ts\":{:.3f}", ts);
+    } else {
+      fmt::print(os, ",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f}", ts,
+                 event.duration / 1000.0);
+    }
+    fmt::print(os, ",\"pid\":1,\"tid\":{}}}", tid);
+  }
+  fmt::print(os, "\n],\"otherData\":{{\"droppedEvents\":{}}}}}\n",
+             collector.dropped);
+}
+
+bool wpi::WriteTraceFile(std::string_view filename) {
+  std::error_code ec;
+  raw_fd_ostream os{filename, ec};
+  if (ec) {
+    return false;
+  }
+  WriteTrace(os);
+  return true;
+}
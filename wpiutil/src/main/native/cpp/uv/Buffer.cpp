@@ -0,0 +1,216 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/uv/Buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace wpi::uv;
+
+// Buffers are carved from blocks of power-of-two size classes, from 64 bytes
+// to the 64 KiB libuv asks for when reading; larger buffers go straight to the
+// heap.  Each block starts with a header recording its size class, as
+// buffers' lengths are routinely changed to the amount of data in them.
+//
+// Freed blocks go to a per-thread free list (so per-loop, as each loop runs
+// on its own thread) and overflow to lists shared between threads, which also
+// rebalance buffers that are allocated on one thread and freed on another.
+
+namespace {
+constexpr unsigned int kMinShift = 6;
+constexpr unsigned int kMaxShift = 16;
+constexpr unsigned int kNumClasses = kMaxShift - kMinShift + 1;
+constexpr unsigned int kUnpooled = kNumClasses;
+
+// Keeps the buffer itself 16-byte aligned.
+constexpr size_t kHeaderSize = 16;
+
+// Bytes kept in each class's free lists.
+constexpr size_t kThreadBytes = 256 * 1024;
+constexpr size_t kSharedBytes = 1024 * 1024;
+
+struct Header {
+  unsigned int sizeClass;
+};
+
+constexpr size_t GetClassSize(unsigned int sizeClass) {
+  return size_t{1} << (sizeClass + kMinShift);
+}
+
+constexpr size_t GetClassDepth(unsigned int sizeClass, size_t bytes) {
+  return std::max<size_t>(bytes / GetClassSize(sizeClass), 2);
+}
+
+unsigned int GetSizeClass(size_t size) {
+  unsigned int shift = kMinShift;
+  while (shift <= kMaxShift && (size_t{1} << shift) < size) {
+    ++shift;
+  }
+  return shift - kMinShift;
+}
+
+using FreeList = std::vector<char*>;
+
+struct Shared {
+  // not a wpi::mutex, which may itself be instrumented
+  std::mutex mutex;
+  FreeList free[kNumClasses];
+  size_t bytes = 0;
+
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> heapAllocations{0};
+
+  // Moves blocks from list beyond keep to the shared list, freeing those that
+  // don't fit.
+  void Put(unsigned int sizeClass, FreeList& list, size_t keep);
+
+  // Moves up to count blocks from the shared list to list.
+  void Take(unsigned int sizeClass, FreeList& list, size_t count);
+};
+
+struct ThreadCache {
+  ~ThreadCache();
+
+  FreeList free[kNumClasses];
+};
+}  // namespace
+
+static Shared& GetShared() {
+  // leaked, as buffers may be freed during static destruction
+  static Shared* shared = new Shared;
+  return *shared;
+}
+
+// Set once the calling thread's cache is destroyed; buffers freed after that
+// go straight to the shared lists.
+static thread_local bool gThreadCacheDestroyed = false;
+
+static ThreadCache* GetThreadCache() {
+  if (gThreadCacheDestroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+void Shared::Put(unsigned int sizeClass, FreeList& list, size_t keep) {
+  if (list.size() <= keep) {
+    return;
+  }
+  size_t size = GetClassSize(sizeClass);
+  size_t depth = GetClassDepth(sizeClass, kSharedBytes);
+  std::scoped_lock lock(mutex);
+  auto& shared = free[sizeClass];
+  while (list.size() > keep) {
+    char* block = list.back();
+    list.pop_back();
+    if (shared.size() < depth) {
+      shared.push_back(block);
+      bytes += size;
+    } else {
+      delete[] block;
+    }
+  }
+}
+
+void Shared::Take(unsigned int sizeClass, FreeList& list, size_t count) {
+  std::scoped_lock lock(mutex);
+  auto& shared = free[sizeClass];
+  count = std::min(count, shared.size());
+  list.insert(list.end(), shared.end() - count, shared.end());
+  shared.resize(shared.size() - count);
+  bytes -= count * GetClassSize(sizeClass);
+}
+
+ThreadCache::~ThreadCache() {
+  gThreadCacheDestroyed = true;
+  for (unsigned int i = 0; i < kNumClasses; ++i) {
+    GetShared().Put(i, free[i], 0);
+  }
+}
+
+Buffer Buffer::Allocate(size_t size) {
+  auto& shared = GetShared();
+  shared.allocations.fetch_add(1, std::memory_order_relaxed);
+  unsigned int sizeClass = GetSizeClass(size);
+  char* block = nullptr;
+  if (sizeClass != kUnpooled) {
+    FreeList local;
+    auto cache = GetThreadCache();
+    auto& list = cache ? cache->free[sizeClass] : local;
+    if (list.empty()) {
+      // refill half the thread's list at a time to amortize the lock
+      shared.Take(sizeClass, list,
+                  cache ? GetClassDepth(sizeClass, kThreadBytes) / 2 : 1);
+    }
+    if (!list.empty()) {
+      block = list.back();
+      list.pop_back();
+    }
+  }
+  if (!block) {
+    shared.heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    block = new char[kHeaderSize +
+                     (sizeClass == kUnpooled ? size : GetClassSize(sizeClass))];
+    reinterpret_cast<Header*>(block)->sizeClass = sizeClass;
+  }
+  return Buffer{block + kHeaderSize, size};
+}
+
+void Buffer::Deallocate() {
+  if (base) {
+    char* block = base - kHeaderSize;
+    unsigned int sizeClass = reinterpret_cast<Header*>(block)->sizeClass;
+    if (sizeClass == kUnpooled) {
+      delete[] block;
+    } else if (auto cache = GetThreadCache()) {
+      auto& list = cache->free[sizeClass];
+      size_t depth = GetClassDepth(sizeClass, kThreadBytes);
+      if (list.size() >= depth) {
+        // hand half to other threads
+        GetShared().Put(sizeClass, list, depth / 2);
+      }
+      list.push_back(block);
+    } else {
+      FreeList list{block};
+      GetShared().Put(sizeClass, list, 0);
+    }
+  }
+  base = nullptr;
+  len = 0;
+}
+
+BufferPoolStats wpi::uv::GetBufferPoolStats() {
+  auto& shared = GetShared();
+  BufferPoolStats stats;
+  stats.allocations = shared.allocations.load(std::memory_order_relaxed);
+  stats.heapAllocations =
+      shared.heapAllocations.load(std::memory_order_relaxed);
+  std::scoped_lock lock(shared.mutex);
+  stats.sharedBytes = shared.bytes;
+  return stats;
+}
+
+void wpi::uv::TrimBufferPool() {
+  auto& shared = GetShared();
+  if (auto cache = GetThreadCache()) {
+    for (auto& list : cache->free) {
+      for (char* block : list) {
+        delete[] block;
+      }
+      list.clear();
+    }
+  }
+  std::scoped_lock lock(shared.mutex);
+  for (auto& list : shared.free) {
+    for (char* block : list) {
+      delete[] block;
+    }
+    list.clear();
+  }
+  shared.bytes = 0;
+}
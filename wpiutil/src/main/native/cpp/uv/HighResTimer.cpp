@@ -0,0 +1,250 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/uv/HighResTimer.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+#include "wpi/uv/Loop.h"
+
+#if defined(_WIN32) && !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace wpi::uv {
+
+HighResTimer::~HighResTimer() noexcept {
+#ifdef _WIN32
+  if (m_wait) {
+    // waits for a running callback to finish
+    ::UnregisterWaitEx(m_wait, INVALID_HANDLE_VALUE);
+  }
+  if (m_timer) {
+    ::CloseHandle(m_timer);
+  }
+#else
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+#endif
+}
+
+void HighResTimer::Expired(Time now, uint64_t count) {
+  if (!m_active) {
+    return;
+  }
+  // the latest of the count expirations that have passed
+  Time due = m_deadline + m_repeat * (count - 1);
+  Time lateness = now > due ? now - due : Time{0};
+  ++m_stats.expirations;
+  m_stats.missed += count - 1;
+  m_stats.lastLateness = lateness;
+  if (lateness > m_stats.maxLateness) {
+    m_stats.maxLateness = lateness;
+  }
+  m_stats.totalLateness += lateness;
+  if (m_repeat == Time{0}) {
+    Stop();
+  } else {
+    m_deadline += m_repeat * count;
+#ifdef _WIN32
+    // the waitable timer period is whole milliseconds, so arm each expiration
+    Arm();
+#endif
+  }
+  timeout();
+}
+
+#ifdef _WIN32
+
+std::shared_ptr<HighResTimer> HighResTimer::Create(Loop& loop) {
+  HANDLE timer = ::CreateWaitableTimerExW(
+      nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+      TIMER_ALL_ACCESS);
+  if (!timer) {
+    // high resolution timers need Windows 10 1803 or later
+    timer = ::CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+  }
+  if (!timer) {
+    loop.ReportError(uv_translate_sys_error(::GetLastError()));
+    return nullptr;
+  }
+
+  auto h = std::make_shared<HighResTimer>(private_init{});
+  h->m_timer = timer;
+  int err = uv_async_init(loop.GetRaw(), h->GetRaw(), [](uv_async_t* handle) {
+    HighResTimer& h = *static_cast<HighResTimer*>(handle->data);
+    Time now = Now();
+    if (!h.m_active) {
+      return;
+    }
+    if (now < h.m_deadline) {
+      // woken early, or by an expiration since replaced
+      h.Arm();
+      return;
+    }
+    uint64_t count = 1;
+    if (h.m_repeat != Time{0}) {
+      count += (now - h.m_deadline) / h.m_repeat;
+    }
+    h.Expired(now, count);
+  });
+  if (err < 0) {
+    loop.ReportError(err);
+    return nullptr;
+  }
+
+  h->Keep();
+
+  // the wait callback runs on a thread pool thread
+  if (!::RegisterWaitForSingleObject(
+          &h->m_wait, timer,
+          [](PVOID param, BOOLEAN) {
+            uv_async_send(static_cast<uv_async_t*>(param));
+          },
+          h->GetRaw(), INFINITE, WT_EXECUTEINWAITTHREAD)) {
+    loop.ReportError(uv_translate_sys_error(::GetLastError()));
+    h->m_wait = nullptr;
+    h->Close();
+    return nullptr;
+  }
+  return h;
+}
+
+HighResTimer::Time HighResTimer::Now() {
+  return std::chrono::duration_cast<Time>(
+      std::chrono::steady_clock::now().time_since_epoch());
+}
+
+void HighResTimer::Arm() {
+  // negative due times are relative, in 100 ns units
+  LARGE_INTEGER due;
+  Time now = Now();
+  due.QuadPart = m_deadline > now ? -((m_deadline - now).count() / 100) : 0;
+  if (due.QuadPart == 0) {
+    due.QuadPart = -1;
+  }
+  if (!::SetWaitableTimer(m_timer, &due, 0, nullptr, nullptr, FALSE)) {
+    ReportError(uv_translate_sys_error(::GetLastError()));
+  }
+}
+
+void HighResTimer::Start(Time timeout, Time repeat) {
+  m_repeat = repeat;
+  m_deadline = Now() + timeout;
+  m_active = true;
+  Arm();
+}
+
+void HighResTimer::Stop() {
+  m_active = false;
+  ::CancelWaitableTimer(m_timer);
+}
+
+#elif defined(__linux__)
+
+static timespec ToTimespec(HighResTimer::Time time) {
+  timespec ts;
+  ts.tv_sec = time.count() / 1000000000;
+  ts.tv_nsec = time.count() % 1000000000;
+  return ts;
+}
+
+std::shared_ptr<HighResTimer> HighResTimer::Create(Loop& loop) {
+  int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (fd < 0) {
+    loop.ReportError(-errno);
+    return nullptr;
+  }
+  auto h = std::make_shared<HighResTimer>(private_init{});
+  int err = uv_poll_init(loop.GetRaw(), h->GetRaw(), fd);
+  if (err < 0) {
+    ::close(fd);
+    loop.ReportError(err);
+    return nullptr;
+  }
+  h->m_fd = fd;
+  h->Keep();
+  return h;
+}
+
+HighResTimer::Time HighResTimer::Now() {
+  // the timerfd clock
+  timespec ts;
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+  return std::chrono::seconds{ts.tv_sec} + Time{ts.tv_nsec};
+}
+
+void HighResTimer::Arm() {
+  itimerspec spec;
+  spec.it_value = ToTimespec(m_deadline);
+  spec.it_interval = ToTimespec(m_repeat);
+  if (::timerfd_settime(m_fd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+    ReportError(-errno);
+  }
+}
+
+void HighResTimer::Start(Time timeout, Time repeat) {
+  m_repeat = repeat;
+  m_deadline = Now() + timeout;
+  m_active = true;
+  Arm();
+  Invoke(&uv_poll_start, GetRaw(), UV_READABLE,
+         [](uv_poll_t* handle, int status, int events) {
+           HighResTimer& h = *static_cast<HighResTimer*>(handle->data);
+           if (status < 0) {
+             h.ReportError(status);
+             return;
+           }
+           // the number of expirations since the last read
+           uint64_t count;
+           if (::read(h.m_fd, &count, sizeof(count)) !=
+                   static_cast<ssize_t>(sizeof(count)) ||
+               count == 0) {
+             return;
+           }
+           h.Expired(Now(), count);
+         });
+}
+
+void HighResTimer::Stop() {
+  m_active = false;
+  itimerspec spec{};
+  ::timerfd_settime(m_fd, 0, &spec, nullptr);
+  Invoke(&uv_poll_stop, GetRaw());
+}
+
+#else
+
+std::shared_ptr<HighResTimer> HighResTimer::Create(Loop& loop) {
+  loop.ReportError(UV_ENOSYS);
+  return nullptr;
+}
+
+HighResTimer::Time HighResTimer::Now() {
+  return std::chrono::duration_cast<Time>(
+      std::chrono::steady_clock::now().time_since_epoch());
+}
+
+void HighResTimer::Arm() {}
+
+void HighResTimer::Start(Time timeout, Time repeat) {}
+
+void HighResTimer::Stop() {}
+
+#endif
+
+}  // namespace wpi::uv
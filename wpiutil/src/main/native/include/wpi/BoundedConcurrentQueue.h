@@ -0,0 +1,518 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_BOUNDEDCONCURRENTQUEUE_H_
+#define WPIUTIL_WPI_BOUNDEDCONCURRENTQUEUE_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "wpi/MathExtras.h"
+#include "wpi/condition_variable.h"
+#include "wpi/mutex.h"
+
+namespace wpi {
+
+namespace detail {
+
+// Keeps the producer and consumer indices from sharing a cache line
+inline constexpr size_t kQueueCacheLineSize = 64;
+
+// Parks threads until a queue can be pushed to (or popped from).  Waking
+// costs a fence and a load unless a thread is actually parked, so the
+// queue stays lock-free while no one waits.
+class QueueParker {
+ public:
+  template <typename Pred>
+  void Wait(Pred ready) {
+    std::unique_lock lock(m_mutex);
+    m_waiters.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in Notify(): either the notifier sees the waiter,
+    // or ready() sees the notifier's change
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_cond.wait(lock, ready);
+    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // Returns ready(), which is false if the deadline passed first
+  template <typename Pred, typename Clock, typename Duration>
+  bool WaitUntil(Pred ready,
+                 const std::chrono::time_point<Clock, Duration>& deadline) {
+    std::unique_lock lock(m_mutex);
+    m_waiters.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool result = m_cond.wait_until(lock, deadline, ready);
+    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    return result;
+  }
+
+  void Notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) != 0) {
+      // Taking the lock ensures the waiter is either before its check of
+      // ready() or already waiting
+      { std::scoped_lock lock(m_mutex); }
+      m_cond.notify_one();
+    }
+  }
+
+ private:
+  std::atomic<int> m_waiters{0};
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+};
+
+// Uninitialized storage for one queued value
+template <typename T>
+struct QueueSlot {
+  T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+  template <typename... Args>
+  void construct(Args&&... args) {
+    new (storage) T(std::forward<Args>(args)...);
+  }
+
+  void destroy() { get()->~T(); }
+
+  alignas(T) unsigned char storage[sizeof(T)];
+};
+
+}  // namespace detail
+
+/**
+ * A fixed-capacity queue for any number of producer and consumer threads.
+ *
+ * Unlike ConcurrentQueue, pushing and popping take no lock; each is a few
+ * atomic operations on a ring of slots, so a thread that is preempted in the
+ * middle of one never blocks the others.  Threads only sleep (on a condition
+ * variable) in the blocking functions, while the queue is empty (pop) or
+ * full (push).
+ *
+ * @tparam T value type; must be move constructible
+ */
+template <typename T>
+class BoundedConcurrentQueue {
+ public:
+  /**
+   * Constructs a queue.
+   *
+   * @param capacity the most values it can hold; rounded up to a power of 2
+   *                 (and at least 2)
+   */
+  explicit BoundedConcurrentQueue(size_t capacity)
+      : m_mask{static_cast<size_t>(PowerOf2Ceil((std::max)(capacity,
+                                                           size_t{2}))) -
+               1},
+        m_cells{new Cell[m_mask + 1]} {
+    for (size_t i = 0; i <= m_mask; ++i) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~BoundedConcurrentQueue() {
+    while (try_pop_impl([](T&&) {})) {
+    }
+  }
+
+  BoundedConcurrentQueue(const BoundedConcurrentQueue&) = delete;
+  BoundedConcurrentQueue& operator=(const BoundedConcurrentQueue&) = delete;
+
+  /**
+   * Returns the most values the queue can hold.
+   */
+  size_t capacity() const { return m_mask + 1; }
+
+  /**
+   * Returns the number of queued values.  With other threads active this is
+   * only a snapshot.
+   */
+  size_t size() const {
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  /**
+   * Returns whether the queue is empty.  With other threads active this is
+   * only a snapshot.
+   */
+  bool empty() const { return size() == 0; }
+
+  /**
+   * Constructs a value at the back of the queue, unless it is full.
+   *
+   * @return false if the queue was full (args are left untouched)
+   */
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    Cell* cell;
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &m_cells[pos & m_mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (m_tail.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // the slot hasn't been popped yet
+      } else {
+        pos = m_tail.load(std::memory_order_relaxed);  // another push won
+      }
+    }
+    cell->slot.construct(std::forward<Args>(args)...);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    m_notEmpty.Notify();
+    return true;
+  }
+
+  bool try_push(const T& item) { return try_emplace(item); }
+  bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+  /**
+   * Constructs a value at the back of the queue, waiting while it is full.
+   */
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    // try_emplace() only uses args once it has a slot
+    while (!try_emplace(std::forward<Args>(args)...)) {
+      m_notFull.Wait([&] { return can_push(); });
+    }
+  }
+
+  void push(const T& item) { emplace(item); }
+  void push(T&& item) { emplace(std::move(item)); }
+
+  /**
+   * Removes the value at the front of the queue, unless it is empty.
+   *
+   * @param item set to the removed value
+   * @return false if the queue was empty
+   */
+  bool try_pop(T& item) {
+    return try_pop_impl([&](T&& value) { item = std::move(value); });
+  }
+
+  /**
+   * Removes the value at the front of the queue, unless it is empty.
+   */
+  std::optional<T> try_pop() {
+    std::optional<T> item;
+    try_pop_impl([&](T&& value) { item.emplace(std::move(value)); });
+    return item;
+  }
+
+  /**
+   * Removes the value at the front of the queue, waiting while it is empty.
+   */
+  T pop() {
+    for (;;) {
+      if (auto item = try_pop()) {
+        return std::move(*item);
+      }
+      m_notEmpty.Wait([&] { return can_pop(); });
+    }
+  }
+
+  /**
+   * Removes the value at the front of the queue, waiting while it is empty.
+   *
+   * @param item set to the removed value
+   */
+  void pop(T& item) {
+    while (!try_pop(item)) {
+      m_notEmpty.Wait([&] { return can_pop(); });
+    }
+  }
+
+  /**
+   * Removes the value at the front of the queue, waiting up to a timeout
+   * while it is empty.
+   *
+   * @param item set to the removed value
+   * @param timeout how long to wait
+   * @return false if the queue was still empty after the timeout
+   */
+  template <typename Rep, typename Period>
+  bool try_pop_for(T& item,
+                   const std::chrono::duration<Rep, Period>& timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!try_pop(item)) {
+      if (!m_notEmpty.WaitUntil([&] { return can_pop(); }, deadline)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  // The sequence number says whose turn the slot is: pos when it is free
+  // for the push to position pos, pos + 1 when it holds that push's value
+  struct Cell {
+    std::atomic<size_t> sequence;
+    detail::QueueSlot<T> slot;
+  };
+
+  template <typename F>
+  bool try_pop_impl(F&& consume) {
+    Cell* cell;
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &m_cells[pos & m_mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (m_head.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // the slot hasn't been pushed yet
+      } else {
+        pos = m_head.load(std::memory_order_relaxed);  // another pop won
+      }
+    }
+    consume(std::move(*cell->slot.get()));
+    cell->slot.destroy();
+    // free for the push one lap later
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    m_notFull.Notify();
+    return true;
+  }
+
+  bool can_push() const {
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    size_t seq = m_cells[pos & m_mask].sequence.load(std::memory_order_acquire);
+    return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) >= 0;
+  }
+
+  bool can_pop() const {
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    size_t seq = m_cells[pos & m_mask].sequence.load(std::memory_order_acquire);
+    return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) >= 0;
+  }
+
+  const size_t m_mask;
+  std::unique_ptr<Cell[]> m_cells;
+  alignas(detail::kQueueCacheLineSize) std::atomic<size_t> m_tail{0};
+  alignas(detail::kQueueCacheLineSize) std::atomic<size_t> m_head{0};
+  alignas(detail::kQueueCacheLineSize) detail::QueueParker m_notEmpty;
+  detail::QueueParker m_notFull;
+};
+
+/**
+ * A fixed-capacity queue for exactly one producer thread and one consumer
+ * thread.
+ *
+ * Cheaper than BoundedConcurrentQueue: a push or a pop is a load and a store
+ * of the indices, with no read-modify-write.  As with it, threads only sleep
+ * in the blocking functions, while the queue is empty (pop) or full (push).
+ *
+ * @tparam T value type; must be move constructible
+ */
+template <typename T>
+class SpscQueue {
+ public:
+  /**
+   * Constructs a queue.
+   *
+   * @param capacity the most values it can hold; rounded up to a power of 2
+   */
+  explicit SpscQueue(size_t capacity)
+      : m_mask{static_cast<size_t>(PowerOf2Ceil((std::max)(capacity,
+                                                           size_t{1}))) -
+               1},
+        m_slots{new detail::QueueSlot<T>[m_mask + 1]} {}
+
+  ~SpscQueue() {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    for (size_t i = m_head.load(std::memory_order_relaxed); i != tail; ++i) {
+      m_slots[i & m_mask].destroy();
+    }
+  }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /**
+   * Returns the most values the queue can hold.
+   */
+  size_t capacity() const { return m_mask + 1; }
+
+  /**
+   * Returns the number of queued values.  With other threads active this is
+   * only a snapshot.
+   */
+  size_t size() const {
+    size_t head = m_head.load(std::memory_order_acquire);
+    return m_tail.load(std::memory_order_acquire) - head;
+  }
+
+  /**
+   * Returns whether the queue is empty.  With other threads active this is
+   * only a snapshot.
+   */
+  bool empty() const { return size() == 0; }
+
+  /**
+   * Constructs a value at the back of the queue, unless it is full.  Producer
+   * thread only.
+   *
+   * @return false if the queue was full (args are left untouched)
+   */
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_headCache > m_mask) {
+      m_headCache = m_head.load(std::memory_order_acquire);
+      if (tail - m_headCache > m_mask) {
+        return false;
+      }
+    }
+    m_slots[tail & m_mask].construct(std::forward<Args>(args)...);
+    m_tail.store(tail + 1, std::memory_order_release);
+    m_notEmpty.Notify();
+    return true;
+  }
+
+  bool try_push(const T& item) { return try_emplace(item); }
+  bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+  /**
+   * Constructs a value at the back of the queue, waiting while it is full.
+   * Producer thread only.
+   */
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    // try_emplace() only uses args once it has a slot
+    while (!try_emplace(std::forward<Args>(args)...)) {
+      m_notFull.Wait([&] {
+        return m_tail.load(std::memory_order_relaxed) -
+                   m_head.load(std::memory_order_acquire) <=
+               m_mask;
+      });
+    }
+  }
+
+  void push(const T& item) { emplace(item); }
+  void push(T&& item) { emplace(std::move(item)); }
+
+  /**
+   * Removes the value at the front of the queue, unless it is empty.
+   * Consumer thread only.
+   *
+   * @param item set to the removed value
+   * @return false if the queue was empty
+   */
+  bool try_pop(T& item) {
+    return try_pop_impl([&](T&& value) { item = std::move(value); });
+  }
+
+  /**
+   * Removes the value at the front of the queue, unless it is empty.
+   * Consumer thread only.
+   */
+  std::optional<T> try_pop() {
+    std::optional<T> item;
+    try_pop_impl([&](T&& value) { item.emplace(std::move(value)); });
+    return item;
+  }
+
+  /**
+   * Removes the value at the front of the queue, waiting while it is empty.
+   * Consumer thread only.
+   */
+  T pop() {
+    for (;;) {
+      if (auto item = try_pop()) {
+        return std::move(*item);
+      }
+      m_notEmpty.Wait([&] { return can_pop(); });
+    }
+  }
+
+  /**
+   * Removes the value at the front of the queue, waiting while it is empty.
+   * Consumer thread only.
+   *
+   * @param item set to the removed value
+   */
+  void pop(T& item) {
+    while (!try_pop(item)) {
+      m_notEmpty.Wait([&] { return can_pop(); });
+    }
+  }
+
+  /**
+   * Removes the value at the front of the queue, waiting up to a timeout
+   * while it is empty.
+   * Consumer thread only.
+   *
+   * @param item set to the removed value
+   * @param timeout how long to wait
+   * @return false if the queue was still empty after the timeout
+   */
+  template <typename Rep, typename Period>
+  bool try_pop_for(T& item,
+                   const std::chrono::duration<Rep, Period>& timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!try_pop(item)) {
+      if (!m_notEmpty.WaitUntil([&] { return can_pop(); }, deadline)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  template <typename F>
+  bool try_pop_impl(F&& consume) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tailCache) {
+      m_tailCache = m_tail.load(std::memory_order_acquire);
+      if (head == m_tailCache) {
+        return false;
+      }
+    }
+    auto& slot = m_slots[head & m_mask];
+    consume(std::move(*slot.get()));
+    slot.destroy();
+    m_head.store(head + 1, std::memory_order_release);
+    m_notFull.Notify();
+    return true;
+  }
+
+  bool can_pop() const {
+    return m_tail.load(std::memory_order_acquire) !=
+           m_head.load(std::memory_order_relaxed);
+  }
+
+  const size_t m_mask;
+  std::unique_ptr<detail::QueueSlot<T>[]> m_slots;
+
+  // Written by the producer; m_headCache saves reading m_head on every push
+  alignas(detail::kQueueCacheLineSize) std::atomic<size_t> m_tail{0};
+  size_t m_headCache = 0;
+
+  // Written by the consumer; m_tailCache saves reading m_tail on every pop
+  alignas(detail::kQueueCacheLineSize) std::atomic<size_t> m_head{0};
+  size_t m_tailCache = 0;
+
+  alignas(detail::kQueueCacheLineSize) detail::QueueParker m_notEmpty;
+  detail::QueueParker m_notFull;
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_BOUNDEDCONCURRENTQUEUE_H_
@@ -35,6 +35,17 @@ class CallbackListenerData {
   unsigned int poller_uid = UINT_MAX;
 };
 
+// How a poller's queue behaves when its owner doesn't keep up.
+enum class PollQueueMode {
+  // Every notification is kept.
+  kUnbounded,
+  // At most max_size notifications are kept; the oldest are dropped.
+  kDropOldest,
+  // As kDropOldest, but a notification first merges into a queued one for
+  // the same key (see CallbackThread::Coalesce()) if there is one.
+  kCoalesce
+};
+
 // CRTP callback manager thread
 // @tparam Derived        derived class
 // @tparam NotifierData   data buffered for each callback
@@ -43,6 +54,16 @@ class CallbackListenerData {
 //   bool Matches(const ListenerData& listener, const NotifierData& data);
 //   void SetListener(NotifierData* data, unsigned int listener_uid);
 //   void DoCallback(Callback callback, const NotifierData& data);
+// Derived may additionally hide the following functions to maintain an index
+// of listeners (all are called with m_mutex held):
+//   void ListenerAdded(unsigned int listener_uid);
+//   void ListenerRemoved(unsigned int listener_uid);
+//   void GetCandidates(const NotifierData& data,
+//                      std::vector<unsigned int>* candidates);
+// Derived may also hide the following function to support
+// PollQueueMode::kCoalesce; it merges data into queued and returns true if
+// they are for the same key (called with the poller mutex held):
+//   bool Coalesce(NotifierData* queued, const NotifierData& data);
 template <typename Derived, typename TUserInfo,
           typename TListenerData =
               CallbackListenerData<std::function<void(const TUserInfo& info)>>,
@@ -60,15 +81,123 @@ class CallbackThread : public wpi::SafeThread {
         poller->Terminate();
       }
     }
+    for (auto item = m_pending.exchange(nullptr); item;) {
+      auto next = item->next;
+      delete item;
+      item = next;
+    }
   }
 
   void Main() override;
 
+  // Default listener index hooks; see above.
+  void ListenerAdded(unsigned int listener_uid) {}
+  void ListenerRemoved(unsigned int listener_uid) {}
+  void GetCandidates(const NotifierData& data,
+                     std::vector<unsigned int>* candidates) {
+    for (size_t i = 0; i < m_listeners.size(); ++i) {
+      candidates->push_back(static_cast<unsigned int>(i));
+    }
+  }
+  bool Coalesce(NotifierData* queued, const NotifierData& data) {
+    return false;
+  }
+
   wpi::UidVector<ListenerData, 64> m_listeners;
+  // Whether m_listeners has any; kept by CallbackManager so notifications
+  // can be dropped early without m_mutex.
+  std::atomic_bool m_hasListeners{false};
 
   std::queue<std::pair<unsigned int, NotifierData>> m_queue;
   wpi::condition_variable m_queue_empty;
 
+ private:
+  struct PendingItem {
+    template <typename... Args>
+    explicit PendingItem(unsigned int only_listener, Args&&... args)
+        : item{std::piecewise_construct, std::make_tuple(only_listener),
+               std::forward_as_tuple(std::forward<Args>(args)...)} {}
+    std::pair<unsigned int, NotifierData> item;
+    PendingItem* next = nullptr;
+  };
+
+ public:
+  // Notifications built up by a producer, to be queued by Enqueue() at once.
+  class PendingBatch {
+   public:
+    PendingBatch() = default;
+    PendingBatch(const PendingBatch&) = delete;
+    PendingBatch& operator=(const PendingBatch&) = delete;
+    ~PendingBatch() {
+      while (m_newest) {
+        auto next = m_newest->next;
+        delete m_newest;
+        m_newest = next;
+      }
+    }
+
+    template <typename... Args>
+    void Add(unsigned int only_listener, Args&&... args) {
+      auto item =
+          new PendingItem(only_listener, std::forward<Args>(args)...);
+      item->next = m_newest;
+      m_newest = item;
+      if (!m_oldest) {
+        m_oldest = item;
+      }
+    }
+
+    bool empty() const { return m_newest == nullptr; }
+
+   private:
+    friend class CallbackThread;
+    PendingItem* m_newest = nullptr;
+    PendingItem* m_oldest = nullptr;
+  };
+
+  // Queues notifications without m_mutex, so producers don't wait for the
+  // thread while it is matching listeners or running callbacks.  Main()
+  // moves them to m_queue.  The mutex is only taken (uncontended) to wake
+  // the thread if it is asleep.
+  void Enqueue(PendingBatch&& batch) {
+    if (batch.empty()) {
+      return;
+    }
+    PendingItem* head = m_pending.load(std::memory_order_relaxed);
+    do {
+      batch.m_oldest->next = head;
+    } while (!m_pending.compare_exchange_weak(head, batch.m_newest,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+    batch.m_newest = nullptr;
+    batch.m_oldest = nullptr;
+    if (head) {
+      // Main() hasn't taken the earlier ones yet, so it will see these too
+      return;
+    }
+    // Pairs with the fence in Main(): either we see it asleep, or it sees
+    // the pushed items before it sleeps
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+      // Taking the lock ensures Main() is waiting, not between its check of
+      // m_pending and the wait
+      { std::scoped_lock lock(m_mutex); }
+      m_cond.notify_one();
+    }
+  }
+
+  template <typename... Args>
+  void Enqueue(unsigned int only_listener, Args&&... args) {
+    PendingBatch batch;
+    batch.Add(only_listener, std::forward<Args>(args)...);
+    Enqueue(std::move(batch));
+  }
+
+  // Whether there are notifications from Enqueue() not yet in m_queue.
+  bool HasPending() const {
+    return m_pending.load(std::memory_order_acquire) != nullptr;
+  }
+
   struct Poller {
     void Terminate() {
       {
@@ -77,7 +206,27 @@ class CallbackThread : public wpi::SafeThread {
       }
       poll_cond.notify_all();
     }
-    std::queue<NotifierData> poll_queue;
+    size_t size() const { return poll_queue.size() - poll_head; }
+    bool empty() const { return poll_head == poll_queue.size(); }
+    // Drops queued notifications until at most max_size remain.
+    void Trim() {
+      if (mode == PollQueueMode::kUnbounded || size() <= max_size) {
+        return;
+      }
+      poll_head += size() - max_size;
+      // compact once the dropped prefix is as long as the queue
+      if (poll_head >= size()) {
+        poll_queue.erase(poll_queue.begin(), poll_queue.begin() + poll_head);
+        poll_head = 0;
+      }
+    }
+
+    // The queue is poll_queue[poll_head:].  The vector is only cleared or
+    // compacted, never shrunk, so steady-state polling doesn't allocate.
+    std::vector<NotifierData> poll_queue;
+    size_t poll_head = 0;
+    PollQueueMode mode = PollQueueMode::kUnbounded;
+    size_t max_size = 0;
     wpi::mutex poll_mutex;
     wpi::condition_variable poll_cond;
     bool terminating = false;
@@ -85,9 +234,28 @@ class CallbackThread : public wpi::SafeThread {
   };
   wpi::UidVector<std::shared_ptr<Poller>, 64> m_pollers;
 
+  // Moves the notifications from Enqueue() to m_queue, oldest first.
   // Must be called with m_mutex held
-  template <typename... Args>
-  void SendPoller(unsigned int poller_uid, Args&&... args) {
+  void TakePending() {
+    PendingItem* item = m_pending.exchange(nullptr, std::memory_order_acquire);
+    PendingItem* oldest = nullptr;
+    while (item) {
+      auto next = item->next;
+      item->next = oldest;
+      oldest = item;
+      item = next;
+    }
+    while (oldest) {
+      m_queue.emplace(std::move(oldest->item));
+      auto next = oldest->next;
+      delete oldest;
+      oldest = next;
+    }
+  }
+
+  // Must be called with m_mutex held
+  template <typename T>
+  void SendPoller(unsigned int poller_uid, T&& data) {
     if (poller_uid > m_pollers.size()) {
       return;
     }
@@ -97,22 +265,42 @@ class CallbackThread : public wpi::SafeThread {
     }
     {
       std::scoped_lock lock(poller->poll_mutex);
-      poller->poll_queue.emplace(std::forward<Args>(args)...);
+      if (poller->mode == PollQueueMode::kCoalesce) {
+        for (size_t i = poller->poll_head; i < poller->poll_queue.size();
+             ++i) {
+          if (static_cast<Derived*>(this)->Coalesce(&poller->poll_queue[i],
+                                                    data)) {
+            return;  // the poller was already notified of the queued one
+          }
+        }
+      }
+      poller->poll_queue.emplace_back(std::forward<T>(data));
+      poller->Trim();
     }
     poller->poll_cond.notify_one();
   }
+
+ private:
+  std::atomic<PendingItem*> m_pending{nullptr};  // newest first
+  std::atomic_bool m_sleeping{false};
 };
 
 template <typename Derived, typename TUserInfo, typename TListenerData,
           typename TNotifierData>
 void CallbackThread<Derived, TUserInfo, TListenerData, TNotifierData>::Main() {
+  std::vector<unsigned int> candidates;
   std::unique_lock lock(m_mutex);
   while (m_active) {
-    while (m_queue.empty()) {
-      m_cond.wait(lock);
-      if (!m_active) {
-        return;
+    TakePending();
+    if (m_queue.empty()) {
+      m_sleeping.store(true, std::memory_order_relaxed);
+      // Pairs with the fence in Enqueue()
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!HasPending()) {
+        m_cond.wait(lock);
       }
+      m_sleeping.store(false, std::memory_order_relaxed);
+      continue;
     }
 
     while (!m_queue.empty()) {
@@ -138,8 +326,14 @@ void CallbackThread<Derived, TUserInfo, TListenerData, TNotifierData>::Main() {
           }
         }
       } else {
-        // Use index because iterator might get invalidated.
-        for (size_t i = 0; i < m_listeners.size(); ++i) {
+        // Snapshot the candidate listener uids, as listeners might be added
+        // or removed while the lock is released for a callback.
+        candidates.clear();
+        static_cast<Derived*>(this)->GetCandidates(item.second, &candidates);
+        for (unsigned int i : candidates) {
+          if (i >= m_listeners.size()) {
+            continue;
+          }
           auto& listener = m_listeners[i];
           if (!listener) {
             continue;
@@ -147,8 +341,7 @@ void CallbackThread<Derived, TUserInfo, TListenerData, TNotifierData>::Main() {
           if (!static_cast<Derived*>(this)->Matches(listener, item.second)) {
             continue;
           }
-          static_cast<Derived*>(this)->SetListener(&item.second,
-                                                   static_cast<unsigned>(i));
+          static_cast<Derived*>(this)->SetListener(&item.second, i);
           if (listener.callback) {
             lock.unlock();
             static_cast<Derived*>(this)->DoCallback(listener.callback,
@@ -184,7 +377,12 @@ class CallbackManager {
     if (!thr) {
       return;
     }
+    if (listener_uid < thr->m_listeners.size() &&
+        thr->m_listeners[listener_uid]) {
+      thr->ListenerRemoved(listener_uid);
+    }
     thr->m_listeners.erase(listener_uid);
+    thr->m_hasListeners = !thr->m_listeners.empty();
   }
 
   unsigned int CreatePoller() {
@@ -203,9 +401,11 @@ class CallbackManager {
     // Remove any listeners that are associated with this poller
     for (size_t i = 0; i < thr->m_listeners.size(); ++i) {
       if (thr->m_listeners[i].poller_uid == poller_uid) {
+        thr->ListenerRemoved(static_cast<unsigned int>(i));
         thr->m_listeners.erase(i);
       }
     }
+    thr->m_hasListeners = !thr->m_listeners.empty();
 
     // Wake up any blocked pollers
     if (poller_uid >= thr->m_pollers.size()) {
@@ -219,6 +419,27 @@ class CallbackManager {
     return thr->m_pollers.erase(poller_uid);
   }
 
+  // Sets how a poller's queue is bounded.  max_size is ignored (and may be
+  // 0) for PollQueueMode::kUnbounded.
+  void SetPollerQueue(unsigned int poller_uid, PollQueueMode mode,
+                      size_t max_size) {
+    std::shared_ptr<typename Thread::Poller> poller;
+    {
+      auto thr = m_owner.GetThread();
+      if (!thr || poller_uid >= thr->m_pollers.size()) {
+        return;
+      }
+      poller = thr->m_pollers[poller_uid];
+      if (!poller) {
+        return;
+      }
+    }
+    std::scoped_lock lock(poller->poll_mutex);
+    poller->mode = mode;
+    poller->max_size = max_size < 1 ? 1 : max_size;
+    poller->Trim();
+  }
+
   bool WaitForQueue(double timeout) {
     auto thr = m_owner.GetThread();
     if (!thr) {
@@ -228,7 +449,7 @@ class CallbackManager {
     auto& lock = thr.GetLock();
     auto timeout_time = std::chrono::steady_clock::now() +
                         std::chrono::duration<double>(timeout);
-    while (!thr->m_queue.empty()) {
+    while (!thr->m_queue.empty() || thr->HasPending()) {
       if (!thr->m_active) {
         return true;
       }
@@ -256,38 +477,47 @@ class CallbackManager {
   std::vector<typename Thread::UserInfo> Poll(unsigned int poller_uid,
                                               double timeout, bool* timed_out) {
     std::vector<typename Thread::UserInfo> infos;
+    Poll(poller_uid, timeout, timed_out, &infos);
+    return infos;
+  }
+
+  // Same as above, but replaces the contents of infos, so a caller that
+  // reuses it doesn't allocate once it has grown to the usual batch size.
+  void Poll(unsigned int poller_uid, double timeout, bool* timed_out,
+            std::vector<typename Thread::UserInfo>* infos) {
+    infos->clear();
+    *timed_out = false;
     std::shared_ptr<typename Thread::Poller> poller;
     {
       auto thr = m_owner.GetThread();
       if (!thr) {
-        return infos;
+        return;
       }
       if (poller_uid > thr->m_pollers.size()) {
-        return infos;
+        return;
       }
       poller = thr->m_pollers[poller_uid];
       if (!poller) {
-        return infos;
+        return;
       }
     }
 
     std::unique_lock lock(poller->poll_mutex);
     auto timeout_time = std::chrono::steady_clock::now() +
                         std::chrono::duration<double>(timeout);
-    *timed_out = false;
-    while (poller->poll_queue.empty()) {
+    while (poller->empty()) {
       if (poller->terminating) {
-        return infos;
+        return;
       }
       if (poller->canceling) {
         // Note: this only works if there's a single thread calling this
         // function for any particular poller, but that's the intended use.
         poller->canceling = false;
-        return infos;
+        return;
       }
       if (timeout == 0) {
         *timed_out = true;
-        return infos;
+        return;
       }
       if (timeout < 0) {
         poller->poll_cond.wait(lock);
@@ -295,16 +525,17 @@ class CallbackManager {
         auto cond_timed_out = poller->poll_cond.wait_until(lock, timeout_time);
         if (cond_timed_out == std::cv_status::timeout) {
           *timed_out = true;
-          return infos;
+          return;
         }
       }
     }
 
-    while (!poller->poll_queue.empty()) {
-      infos.emplace_back(std::move(poller->poll_queue.front()));
-      poller->poll_queue.pop();
+    auto& queue = poller->poll_queue;
+    for (size_t i = poller->poll_head; i < queue.size(); ++i) {
+      infos->emplace_back(std::move(queue[i]));
     }
-    return infos;
+    queue.clear();
+    poller->poll_head = 0;
   }
 
   void CancelPoll(unsigned int poller_uid) {
@@ -340,25 +571,32 @@ class CallbackManager {
   unsigned int DoAdd(Args&&... args) {
     static_cast<Derived*>(this)->Start();
     auto thr = m_owner.GetThread();
-    return thr->m_listeners.emplace_back(std::forward<Args>(args)...);
+    unsigned int uid =
+        thr->m_listeners.emplace_back(std::forward<Args>(args)...);
+    thr->ListenerAdded(uid);
+    thr->m_hasListeners = true;
+    return uid;
   }
 
+  // Doesn't take the thread's mutex; see CallbackThread::Enqueue().
   template <typename... Args>
   void Send(unsigned int only_listener, Args&&... args) {
-    auto thr = m_owner.GetThread();
-    if (!thr || thr->m_listeners.empty()) {
+    auto thr = m_owner.GetThreadSharedPtr();
+    if (!thr || !thr->m_active || !thr->m_hasListeners) {
       return;
     }
-    thr->m_queue.emplace(std::piecewise_construct,
-                         std::make_tuple(only_listener),
-                         std::forward_as_tuple(std::forward<Args>(args)...));
-    thr->m_cond.notify_one();
+    thr->Enqueue(only_listener, std::forward<Args>(args)...);
   }
 
   typename wpi::SafeThreadOwner<Thread>::Proxy GetThread() const {
     return m_owner.GetThread();
   }
 
+  // Gets the thread without locking it, for Enqueue().
+  std::shared_ptr<Thread> GetThreadSharedPtr() const {
+    return m_owner.GetThreadSharedPtr();
+  }
+
  private:
   wpi::SafeThreadOwner<Thread> m_owner;
 };
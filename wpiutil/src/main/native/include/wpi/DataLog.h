@@ -0,0 +1,451 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_DATALOG_H_
+#define WPIUTIL_WPI_DATALOG_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "wpi/StringMap.h"
+#include "wpi/condition_variable.h"
+#include "wpi/mutex.h"
+#include "wpi/span.h"
+
+namespace wpi::log {
+
+/**
+ * A data log: an append-only binary file of timestamped records for any
+ * number of typed entries ("WPILOG" format).
+ *
+ * The file starts with the characters "WPILOG", a 16-bit version (currently
+ * 0x0100), a 32-bit extra header length and the extra header.  All integers
+ * are little-endian.  Then come records, each a header byte, the entry ID,
+ * the payload size and the timestamp, then the payload.  The header byte
+ * gives the byte lengths of the three fields that follow it, which are
+ * written in as few bytes as they fit: bits 0-1 are the entry ID length
+ * minus 1 (1-4 bytes), bits 2-3 the payload size length minus 1 (1-4 bytes)
+ * and bits 4-6 the timestamp length minus 1 (1-8 bytes).  Timestamps are in
+ * microseconds (wpi::Now() units).
+ *
+ * Entry ID 0 is reserved for control records, whose payload starts with the
+ * control type.  A start record (type 0) assigns an entry ID to a name, a
+ * data type and metadata: the 32-bit entry ID, then the name, the type and
+ * the metadata, each a 32-bit length followed by the UTF-8 string.  A finish
+ * record (type 1) holds the 32-bit entry ID, which may then be reused.  A
+ * set metadata record (type 2) holds the 32-bit entry ID and the new
+ * metadata as a 32-bit length and string.
+ *
+ * Records go into one half of a preallocated double buffer, with the mutex
+ * held only for the copy.  A background thread writes out the other half
+ * when one fills and every period.  If both halves are full because the
+ * writer fell behind, data records are dropped (and counted) rather than
+ * blocking or allocating; control records are always kept.
+ */
+class DataLog final {
+ public:
+  /** Size of each half of the buffer. */
+  static constexpr size_t kBufferSize = 256 * 1024;
+
+  /**
+   * Creates a data log that writes to a file, replacing any existing file.
+   *
+   * @param filename    file name
+   * @param ec          set if the file could not be opened; records are
+   *                    then discarded
+   * @param period      time between writes to the file, in seconds
+   * @param extraHeader extra header data
+   */
+  DataLog(std::string_view filename, std::error_code& ec,
+          double period = 0.25, std::string_view extraHeader = "");
+
+  /**
+   * Creates a data log that passes the log data to a function.  The function
+   * is called from the writer thread.
+   *
+   * @param write       function called with each block of log data
+   * @param period      time between calls to write, in seconds
+   * @param extraHeader extra header data
+   */
+  explicit DataLog(std::function<void(span<const uint8_t> data)> write,
+                   double period = 0.25, std::string_view extraHeader = "");
+
+  /**
+   * Writes out everything buffered, then closes the log.
+   */
+  ~DataLog();
+
+  DataLog(const DataLog&) = delete;
+  DataLog& operator=(const DataLog&) = delete;
+
+  /**
+   * Has the writer thread write out what is buffered now rather than at the
+   * end of the period.  Does not wait for the write.
+   */
+  void Flush();
+
+  /**
+   * Pauses appending records; records appended while paused are discarded.
+   * Start, finish and set metadata records are still kept.
+   */
+  void Pause();
+
+  /**
+   * Resumes appending records after Pause().
+   */
+  void Resume();
+
+  /**
+   * Starts an entry.  Starting an entry name that is already started (with
+   * the same type) returns the same ID; the entry is finished once Finish()
+   * has been called as many times as Start().
+   *
+   * @param name      entry name
+   * @param type      data type, e.g. "double" or "string[]"
+   * @param metadata  metadata, e.g. a JSON string
+   * @param timestamp time in microseconds; 0 for wpi::Now()
+   * @return entry ID, or 0 if the name is started with a different type
+   */
+  int Start(std::string_view name, std::string_view type,
+            std::string_view metadata = "", int64_t timestamp = 0);
+
+  /**
+   * Finishes an entry.
+   *
+   * @param entry     entry ID
+   * @param timestamp time in microseconds; 0 for wpi::Now()
+   */
+  void Finish(int entry, int64_t timestamp = 0);
+
+  /**
+   * Updates an entry's metadata.
+   *
+   * @param entry     entry ID
+   * @param metadata  new metadata
+   * @param timestamp time in microseconds; 0 for wpi::Now()
+   */
+  void SetMetadata(int entry, std::string_view metadata, int64_t timestamp = 0);
+
+  /**
+   * Appends a record with a raw payload.  The Append functions below encode
+   * the payload for the standard types; see DataLogReader for the encodings.
+   *
+   * @param entry     entry ID, as returned by Start()
+   * @param data      payload
+   * @param timestamp time in microseconds; 0 for wpi::Now()
+   */
+  void AppendRaw(int entry, span<const uint8_t> data, int64_t timestamp);
+
+  void AppendBoolean(int entry, bool value, int64_t timestamp);
+  void AppendInteger(int entry, int64_t value, int64_t timestamp);
+  void AppendFloat(int entry, float value, int64_t timestamp);
+  void AppendDouble(int entry, double value, int64_t timestamp);
+  void AppendString(int entry, std::string_view value, int64_t timestamp);
+  void AppendBooleanArray(int entry, span<const bool> arr, int64_t timestamp);
+  void AppendBooleanArray(int entry, span<const int> arr, int64_t timestamp);
+  void AppendIntegerArray(int entry, span<const int64_t> arr,
+                          int64_t timestamp);
+  void AppendFloatArray(int entry, span<const float> arr, int64_t timestamp);
+  void AppendDoubleArray(int entry, span<const double> arr, int64_t timestamp);
+  void AppendStringArray(int entry, span<const std::string> arr,
+                         int64_t timestamp);
+  void AppendStringArray(int entry, span<const std::string_view> arr,
+                         int64_t timestamp);
+
+  /**
+   * Gets the number of data records dropped because the buffer was full.
+   */
+  uint64_t GetDroppedRecords() const;
+
+ private:
+  enum SpareState { kFree, kFull, kWriting };
+
+  struct EntryInfo {
+    std::string type;
+    int id;
+    int count;
+  };
+
+  void WriterThreadMain(double period);
+
+  // Writes a record header and returns where the payload goes, or nullptr
+  // if a data record doesn't fit and is dropped.  Called with m_mutex held.
+  uint8_t* Reserve(int entry, size_t payloadSize, int64_t timestamp,
+                   bool control);
+  // As Reserve(), for a data record; returns nullptr if entry is invalid
+  // or the log is paused
+  uint8_t* ReserveData(int entry, size_t payloadSize, int64_t timestamp);
+
+  std::function<void(span<const uint8_t> data)> m_write;
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::vector<uint8_t> m_active;
+  // the other half of the buffer; only the writer touches it when kWriting
+  std::vector<uint8_t> m_spare;
+  SpareState m_spareState = kFree;
+  bool m_flush = false;
+  bool m_paused = false;
+  bool m_shutdown = false;
+  uint64_t m_dropped = 0;
+  wpi::StringMap<EntryInfo> m_entries;
+  int m_lastId = 0;
+  std::thread m_thread;
+};
+
+/**
+ * Log entry base class; a typed handle for one entry of a DataLog.
+ */
+class DataLogEntry {
+ protected:
+  DataLogEntry() = default;
+  DataLogEntry(DataLog& log, std::string_view name, std::string_view type,
+               std::string_view metadata = "", int64_t timestamp = 0)
+      : m_log{&log}, m_entry{log.Start(name, type, metadata, timestamp)} {}
+
+ public:
+  DataLogEntry(const DataLogEntry&) = delete;
+  DataLogEntry& operator=(const DataLogEntry&) = delete;
+
+  DataLogEntry(DataLogEntry&& rhs) : m_log{rhs.m_log}, m_entry{rhs.m_entry} {
+    rhs.m_log = nullptr;
+  }
+  DataLogEntry& operator=(DataLogEntry&& rhs) {
+    if (m_log) {
+      m_log->Finish(m_entry);
+    }
+    m_log = rhs.m_log;
+    rhs.m_log = nullptr;
+    m_entry = rhs.m_entry;
+    return *this;
+  }
+
+  /**
+   * Finishes the entry.
+   */
+  ~DataLogEntry() {
+    if (m_log) {
+      m_log->Finish(m_entry);
+    }
+  }
+
+  explicit operator bool() const { return m_log != nullptr; }
+
+  /**
+   * Updates the entry's metadata.
+   *
+   * @param metadata  new metadata
+   * @param timestamp time in microseconds; 0 for wpi::Now()
+   */
+  void SetMetadata(std::string_view metadata, int64_t timestamp = 0) {
+    m_log->SetMetadata(m_entry, metadata, timestamp);
+  }
+
+ protected:
+  DataLog* m_log = nullptr;
+  int m_entry = 0;
+};
+
+/**
+ * Log arbitrary byte data.
+ */
+class RawLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "raw";
+
+  RawLogEntry() = default;
+  RawLogEntry(DataLog& log, std::string_view name,
+              std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(span<const uint8_t> data, int64_t timestamp = 0) {
+    m_log->AppendRaw(m_entry, data, timestamp);
+  }
+};
+
+/**
+ * Log boolean values.
+ */
+class BooleanLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "boolean";
+
+  BooleanLogEntry() = default;
+  BooleanLogEntry(DataLog& log, std::string_view name,
+                  std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(bool value, int64_t timestamp = 0) {
+    m_log->AppendBoolean(m_entry, value, timestamp);
+  }
+};
+
+/**
+ * Log integer values.
+ */
+class IntegerLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "int64";
+
+  IntegerLogEntry() = default;
+  IntegerLogEntry(DataLog& log, std::string_view name,
+                  std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(int64_t value, int64_t timestamp = 0) {
+    m_log->AppendInteger(m_entry, value, timestamp);
+  }
+};
+
+/**
+ * Log float values.
+ */
+class FloatLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "float";
+
+  FloatLogEntry() = default;
+  FloatLogEntry(DataLog& log, std::string_view name,
+                std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(float value, int64_t timestamp = 0) {
+    m_log->AppendFloat(m_entry, value, timestamp);
+  }
+};
+
+/**
+ * Log double values.
+ */
+class DoubleLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "double";
+
+  DoubleLogEntry() = default;
+  DoubleLogEntry(DataLog& log, std::string_view name,
+                 std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(double value, int64_t timestamp = 0) {
+    m_log->AppendDouble(m_entry, value, timestamp);
+  }
+};
+
+/**
+ * Log string values.
+ */
+class StringLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "string";
+
+  StringLogEntry() = default;
+  StringLogEntry(DataLog& log, std::string_view name,
+                 std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(std::string_view value, int64_t timestamp = 0) {
+    m_log->AppendString(m_entry, value, timestamp);
+  }
+};
+
+/**
+ * Log array of boolean values.
+ */
+class BooleanArrayLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "boolean[]";
+
+  BooleanArrayLogEntry() = default;
+  BooleanArrayLogEntry(DataLog& log, std::string_view name,
+                       std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(span<const bool> arr, int64_t timestamp = 0) {
+    m_log->AppendBooleanArray(m_entry, arr, timestamp);
+  }
+  void Append(span<const int> arr, int64_t timestamp = 0) {
+    m_log->AppendBooleanArray(m_entry, arr, timestamp);
+  }
+};
+
+/**
+ * Log array of integer values.
+ */
+class IntegerArrayLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "int64[]";
+
+  IntegerArrayLogEntry() = default;
+  IntegerArrayLogEntry(DataLog& log, std::string_view name,
+                       std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(span<const int64_t> arr, int64_t timestamp = 0) {
+    m_log->AppendIntegerArray(m_entry, arr, timestamp);
+  }
+};
+
+/**
+ * Log array of float values.
+ */
+class FloatArrayLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "float[]";
+
+  FloatArrayLogEntry() = default;
+  FloatArrayLogEntry(DataLog& log, std::string_view name,
+                     std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(span<const float> arr, int64_t timestamp = 0) {
+    m_log->AppendFloatArray(m_entry, arr, timestamp);
+  }
+};
+
+/**
+ * Log array of double values.
+ */
+class DoubleArrayLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "double[]";
+
+  DoubleArrayLogEntry() = default;
+  DoubleArrayLogEntry(DataLog& log, std::string_view name,
+                      std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(span<const double> arr, int64_t timestamp = 0) {
+    m_log->AppendDoubleArray(m_entry, arr, timestamp);
+  }
+};
+
+/**
+ * Log array of string values.
+ */
+class StringArrayLogEntry : public DataLogEntry {
+ public:
+  static constexpr std::string_view kDataType = "string[]";
+
+  StringArrayLogEntry() = default;
+  StringArrayLogEntry(DataLog& log, std::string_view name,
+                      std::string_view metadata = "", int64_t timestamp = 0)
+      : DataLogEntry{log, name, kDataType, metadata, timestamp} {}
+
+  void Append(span<const std::string> arr, int64_t timestamp = 0) {
+    m_log->AppendStringArray(m_entry, arr, timestamp);
+  }
+  void Append(span<const std::string_view> arr, int64_t timestamp = 0) {
+    m_log->AppendStringArray(m_entry, arr, timestamp);
+  }
+};
+
+}  // namespace wpi::log
+
+#endif  // WPIUTIL_WPI_DATALOG_H_
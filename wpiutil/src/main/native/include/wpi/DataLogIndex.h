@@ -0,0 +1,130 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_DATALOGINDEX_H_
+#define WPIUTIL_WPI_DATALOGINDEX_H_
+
+#include <stdint.h>
+
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "wpi/DataLogReader.h"
+#include "wpi/MappedFileRegion.h"
+#include "wpi/fs.h"
+#include "wpi/span.h"
+
+namespace wpi::log {
+
+/**
+ * An index of a data log's records by entry and time, for random access to
+ * logs too large to read in.  A log file is memory-mapped rather than read,
+ * and the index keeps only the offset of each data record (8 bytes per
+ * record), sorted by timestamp within each entry, so finding an entry's value
+ * at a time is a binary search that touches only the pages it reads.
+ */
+class DataLogIndex {
+ public:
+  /** Returned by Seek() if there is no record at or before the time. */
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+  /**
+   * An entry in the log, from its start record to its finish record.  If an
+   * entry ID is reused, or a name is started again, each start is a separate
+   * Entry.  The strings refer to the log data.
+   */
+  struct Entry {
+    int entry;
+    std::string_view name;
+    std::string_view type;
+    // the latest metadata
+    std::string_view metadata;
+    int64_t startTimestamp;
+    // INT64_MAX if never finished
+    int64_t finishTimestamp;
+    // offsets of the data records, in timestamp order
+    std::vector<uint64_t> offsets;
+  };
+
+  /**
+   * Memory-maps and indexes a log file.
+   *
+   * @param path log file
+   * @param ec   set if the file could not be mapped
+   */
+  DataLogIndex(const fs::path& path, std::error_code& ec);
+
+  /**
+   * Indexes a log in memory.
+   *
+   * @param data log data, which must outlive the index
+   */
+  explicit DataLogIndex(span<const uint8_t> data);
+
+  DataLogIndex(const DataLogIndex&) = delete;
+  DataLogIndex& operator=(const DataLogIndex&) = delete;
+
+  /**
+   * Returns whether the log has a valid header.
+   */
+  bool IsValid() const { return m_reader.IsValid(); }
+
+  const DataLogReader& GetReader() const { return m_reader; }
+
+  /**
+   * Gets the entries, in the order they were started.
+   */
+  const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+  /**
+   * Finds the last started entry with a name.
+   *
+   * @param name entry name
+   * @return entry, or nullptr if not found
+   */
+  const Entry* Find(std::string_view name) const;
+
+  /**
+   * Gets the earliest timestamp of any record, or 0 if there are none.
+   */
+  int64_t GetStartTimestamp() const { return m_startTimestamp; }
+
+  /**
+   * Gets the latest timestamp of any record, or 0 if there are none.
+   */
+  int64_t GetEndTimestamp() const { return m_endTimestamp; }
+
+  /**
+   * Gets an entry's i-th data record in timestamp order.
+   *
+   * @param entry  entry
+   * @param i      index, less than entry.offsets.size()
+   * @return record
+   */
+  DataLogRecord GetRecord(const Entry& entry, size_t i) const;
+
+  /**
+   * Finds an entry's last data record at or before a time.
+   *
+   * @param entry     entry
+   * @param timestamp time, in microseconds
+   * @return index of the record in entry.offsets, or kNone
+   */
+  size_t Seek(const Entry& entry, int64_t timestamp) const;
+
+ private:
+  void Build();
+  int64_t GetTimestamp(uint64_t offset) const;
+
+  MappedFileRegion m_mapping;
+  DataLogReader m_reader;
+  std::vector<Entry> m_entries;
+  int64_t m_startTimestamp = 0;
+  int64_t m_endTimestamp = 0;
+};
+
+}  // namespace wpi::log
+
+#endif  // WPIUTIL_WPI_DATALOGINDEX_H_
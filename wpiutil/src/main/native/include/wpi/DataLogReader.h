@@ -0,0 +1,188 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_DATALOGREADER_H_
+#define WPIUTIL_WPI_DATALOGREADER_H_
+
+#include <stdint.h>
+
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "wpi/span.h"
+
+namespace wpi::log {
+
+/**
+ * Data contained in a start control record, as created by DataLog::Start().
+ */
+struct StartRecordData {
+  int entry;
+  std::string_view name;
+  std::string_view type;
+  std::string_view metadata;
+};
+
+/**
+ * Data contained in a set metadata control record, as created by
+ * DataLog::SetMetadata().
+ */
+struct MetadataRecordData {
+  int entry;
+  std::string_view metadata;
+};
+
+/**
+ * A record in a data log; see DataLog for the format.  The record refers to
+ * the data log's memory, as do the strings it returns.
+ *
+ * The payload of a data record is decoded by the getter for the entry's
+ * type, each of which returns false if the payload is the wrong size:
+ * "boolean" is one byte (0 or 1); "int64", "float" and "double" are
+ * little-endian; "string" is the UTF-8 string; "boolean[]", "int64[]",
+ * "float[]" and "double[]" are the values back to back; "string[]" is a
+ * 32-bit count followed by each string as a 32-bit length and the string.
+ */
+class DataLogRecord {
+ public:
+  DataLogRecord() = default;
+  DataLogRecord(int entry, int64_t timestamp, span<const uint8_t> data)
+      : m_timestamp{timestamp}, m_data{data}, m_entry{entry} {}
+
+  int GetEntry() const { return m_entry; }
+  int64_t GetTimestamp() const { return m_timestamp; }
+  size_t GetSize() const { return m_data.size(); }
+  span<const uint8_t> GetRaw() const { return m_data; }
+
+  bool IsControl() const { return m_entry == 0; }
+  bool IsStart() const;
+  bool IsFinish() const;
+  bool IsSetMetadata() const;
+
+  bool GetStartData(StartRecordData* out) const;
+  bool GetFinishEntry(int* out) const;
+  bool GetSetMetadataData(MetadataRecordData* out) const;
+
+  bool GetBoolean(bool* value) const;
+  bool GetInteger(int64_t* value) const;
+  bool GetFloat(float* value) const;
+  bool GetDouble(double* value) const;
+  bool GetString(std::string_view* value) const;
+  bool GetBooleanArray(std::vector<int>* arr) const;
+  bool GetIntegerArray(std::vector<int64_t>* arr) const;
+  bool GetFloatArray(std::vector<float>* arr) const;
+  bool GetDoubleArray(std::vector<double>* arr) const;
+  bool GetStringArray(std::vector<std::string_view>* arr) const;
+
+ private:
+  int64_t m_timestamp = 0;
+  span<const uint8_t> m_data;
+  int m_entry = -1;
+};
+
+/**
+ * Reads a data log from memory, e.g. a file mapped with MappedFileRegion.
+ * Iterating stops at the end of the data or at a truncated record.
+ */
+class DataLogReader {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = DataLogRecord;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const DataLogRecord*;
+    using reference = const DataLogRecord&;
+
+    iterator(const DataLogReader* reader, size_t pos)
+        : m_reader{reader}, m_pos{pos} {
+      Read();
+    }
+
+    iterator& operator++() {
+      m_pos = m_next;
+      Read();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const iterator& oth) const { return m_pos == oth.m_pos; }
+    bool operator!=(const iterator& oth) const { return m_pos != oth.m_pos; }
+
+    reference operator*() const { return m_record; }
+    pointer operator->() const { return &m_record; }
+
+    /**
+     * Gets the offset of the current record in the log data, for
+     * DataLogReader::GetRecordAt().
+     */
+    size_t GetOffset() const { return m_pos; }
+
+   private:
+    void Read() {
+      if (!m_reader->GetRecord(m_pos, &m_next, &m_record)) {
+        m_pos = kEnd;
+      }
+    }
+
+    const DataLogReader* m_reader;
+    size_t m_pos;
+    size_t m_next = 0;
+    DataLogRecord m_record;
+  };
+
+  /**
+   * Creates a reader.
+   *
+   * @param data log data, which must outlive the reader and its records
+   */
+  explicit DataLogReader(span<const uint8_t> data) : m_data{data} {}
+
+  /**
+   * Returns whether the data starts with a valid data log header.
+   */
+  bool IsValid() const;
+
+  /**
+   * Gets the data log version, e.g. 0x0100 for 1.0.  Returns 0 if the
+   * header is not valid.
+   */
+  uint16_t GetVersion() const;
+
+  /**
+   * Gets the extra header data.
+   */
+  std::string_view GetExtraHeader() const;
+
+  iterator begin() const;
+  iterator end() const { return {this, kEnd}; }
+
+  /**
+   * Gets the record at an offset, as returned by iterator::GetOffset().
+   *
+   * @param offset offset of the record in the log data
+   * @param record record (output)
+   * @return false if there is no complete record at the offset
+   */
+  bool GetRecordAt(size_t offset, DataLogRecord* record) const {
+    size_t next;
+    return GetRecord(offset, &next, record);
+  }
+
+ private:
+  static constexpr size_t kEnd = static_cast<size_t>(-1);
+
+  // Parses the record at pos; sets next to the position after it
+  bool GetRecord(size_t pos, size_t* next, DataLogRecord* record) const;
+
+  span<const uint8_t> m_data;
+};
+
+}  // namespace wpi::log
+
+#endif  // WPIUTIL_WPI_DATALOGREADER_H_
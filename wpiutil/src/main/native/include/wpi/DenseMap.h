@@ -19,6 +19,7 @@
 #include "wpi/AlignOf.h"
 #include "wpi/Compiler.h"
 #include "wpi/MathExtras.h"
+#include "wpi/MemoryResource.h"
 #include "wpi/PointerLikeTypeTraits.h"
 #include "wpi/type_traits.h"
 #include <algorithm>
@@ -677,12 +678,21 @@ class DenseMap : public DenseMapBase<DenseMap<KeyT, ValueT, KeyInfoT, BucketT>,
   unsigned NumEntries;
   unsigned NumTombstones;
   unsigned NumBuckets;
+  // Where the buckets are allocated from; null for the heap.
+  MemoryResource *Resource = nullptr;
 
 public:
   /// Create a DenseMap wth an optional \p InitialReserve that guarantee that
   /// this number of elements can be inserted in the map without grow()
   explicit DenseMap(unsigned InitialReserve = 0) { init(InitialReserve); }
 
+  /// Create a DenseMap that allocates its buckets from \p Resource, which
+  /// must outlive it.  Copies of the map allocate from the heap.
+  explicit DenseMap(MemoryResource *Resource, unsigned InitialReserve = 0)
+      : Resource(Resource) {
+    init(InitialReserve);
+  }
+
   DenseMap(const DenseMap &other) : BaseT() {
     init(0);
     copyFrom(other);
@@ -706,7 +716,7 @@ public:
 
   ~DenseMap() {
     this->destroyAll();
-    operator delete(Buckets);
+    deallocateBuckets(Buckets, NumBuckets);
   }
 
   void swap(DenseMap& RHS) {
@@ -716,8 +726,12 @@ public:
     std::swap(NumEntries, RHS.NumEntries);
     std::swap(NumTombstones, RHS.NumTombstones);
     std::swap(NumBuckets, RHS.NumBuckets);
+    std::swap(Resource, RHS.Resource);
   }
 
+  /// Returns the resource buckets are allocated from; null for the heap.
+  MemoryResource *getResource() const { return Resource; }
+
   DenseMap& operator=(const DenseMap& other) {
     if (&other != this)
       copyFrom(other);
@@ -726,7 +740,7 @@ public:
 
   DenseMap& operator=(DenseMap &&other) {
     this->destroyAll();
-    operator delete(Buckets);
+    deallocateBuckets(Buckets, NumBuckets);
     init(0);
     swap(other);
     return *this;
@@ -734,7 +748,7 @@ public:
 
   void copyFrom(const DenseMap& other) {
     this->destroyAll();
-    operator delete(Buckets);
+    deallocateBuckets(Buckets, NumBuckets);
     if (allocateBuckets(other.NumBuckets)) {
       this->BaseT::copyFrom(other);
     } else {
@@ -767,7 +781,7 @@ public:
     this->moveFromOldBuckets(OldBuckets, OldBuckets+OldNumBuckets);
 
     // Free the old table.
-    operator delete(OldBuckets);
+    deallocateBuckets(OldBuckets, OldNumBuckets);
   }
 
   void shrink_and_clear() {
@@ -783,7 +797,7 @@ public:
       return;
     }
 
-    operator delete(Buckets);
+    deallocateBuckets(Buckets, NumBuckets);
     init(NewNumBuckets);
   }
 
@@ -819,9 +833,24 @@ private:
       return false;
     }
 
-    Buckets = static_cast<BucketT*>(operator new(sizeof(BucketT) * NumBuckets));
+    if (Resource)
+      Buckets = static_cast<BucketT *>(
+          Resource->Allocate(sizeof(BucketT) * NumBuckets, alignof(BucketT)));
+    else
+      Buckets =
+          static_cast<BucketT *>(operator new(sizeof(BucketT) * NumBuckets));
     return true;
   }
+
+  void deallocateBuckets(BucketT *Old, unsigned OldNumBuckets) {
+    if (Resource) {
+      if (Old)
+        Resource->Deallocate(Old, sizeof(BucketT) * OldNumBuckets,
+                             alignof(BucketT));
+    } else {
+      operator delete(Old);
+    }
+  }
 };
 
 template <typename KeyT, typename ValueT, unsigned InlineBuckets = 4,
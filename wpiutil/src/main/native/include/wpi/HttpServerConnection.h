@@ -6,6 +6,7 @@
 #define WPIUTIL_WPI_HTTPSERVERCONNECTION_H_
 
 #include <memory>
+#include <string>
 #include <string_view>
 
 #include "wpi/HttpParser.h"
@@ -28,6 +29,11 @@ class HttpServerConnection {
    *
    * The implementation should read request details from m_request and call the
    * appropriate Send() functions to send a response back to the client.
+   *
+   * Requests pipelined on a kept-alive connection are processed in order, so
+   * the response should be sent (or at least its writes queued) before
+   * returning.  Requests after one whose response closes the connection are
+   * ignored.
    */
   virtual void ProcessRequest() = 0;
 
@@ -47,6 +53,11 @@ class HttpServerConnection {
    * These parameters should ensure the browser does not cache the response.
    * A browser should connect for each file and not serve files from its cache.
    *
+   * While m_revalidate is set (by SendCacheableResponse() and
+   * SendFileResponse()), the cache headers are replaced by
+   * "Cache-Control: no-cache\r\n", which lets the browser keep the response
+   * but makes it check the ETag before each use.
+   *
    * @param os response stream
    */
   virtual void BuildCommonHeaders(raw_ostream& os);
@@ -59,8 +70,8 @@ class HttpServerConnection {
    * @param code HTTP response code (e.g. 200)
    * @param codeText HTTP response code text (e.g. "OK")
    * @param contentType MIME content type (e.g. "text/plain")
-   * @param contentLength Length of content.  If 0 is provided, m_keepAlive will
-   *                      be set to false.
+   * @param contentLength Length of content.  If 0 is provided (other than for
+   *                      a 304 response), m_keepAlive will be set to false.
    * @param extra Extra HTTP headers to send, including final "\r\n"
    */
   virtual void BuildHeader(raw_ostream& os, int code, std::string_view codeText,
@@ -114,6 +125,54 @@ class HttpServerConnection {
                                   std::string_view content, bool gzipped,
                                   std::string_view extraHeader = {});
 
+  /**
+   * Send HTTP response from static data that browsers may cache.  Like
+   * SendStaticResponse(), but the response carries an ETag, and if the
+   * request's If-None-Match header matches it, only a 304 Not Modified
+   * header is sent.
+   *
+   * The ETag must change whenever content does; a hash of the content
+   * computed once (for example, the GetResourceETag_ functions generated for
+   * resources) is ideal.
+   *
+   * @param contentType MIME content type (e.g. "text/plain")
+   * @param content Response message content; as with SendStaticResponse(),
+   *                it is not copied
+   * @param gzipped True if content is gzip compressed
+   * @param etag Entity tag, including the quotes (e.g. "\"1234\"")
+   * @param extraHeader Extra HTTP headers to send, including final "\r\n"
+   */
+  void SendCacheableResponse(std::string_view contentType,
+                             std::string_view content, bool gzipped,
+                             std::string_view etag,
+                             std::string_view extraHeader = {});
+
+  /**
+   * Send HTTP response with the contents of a file.  The file is read in
+   * large blocks directly into the write buffers.  The ETag is derived from
+   * the file's size and modification time, and if the request's
+   * If-None-Match header matches it, only a 304 Not Modified header is sent.
+   *
+   * @param code HTTP response code (e.g. 200)
+   * @param codeText HTTP response code text (e.g. "OK")
+   * @param contentType MIME content type (e.g. "text/plain")
+   * @param filename File to send
+   * @param extraHeader Extra HTTP headers to send, including final "\r\n"
+   * @return False if the file could not be read; no response is sent
+   */
+  bool SendFileResponse(int code, std::string_view codeText,
+                        std::string_view contentType,
+                        std::string_view filename,
+                        std::string_view extraHeader = {});
+
+  /**
+   * Checks the request's If-None-Match header against an entity tag.
+   *
+   * @param etag Entity tag, including the quotes
+   * @return True if the client's cached copy matches
+   */
+  bool IsNotModified(std::string_view etag) const;
+
   /**
    * Send error header and message.
    * This provides standard code responses for 400, 401, 403, 404, 500, and 503.
@@ -134,6 +193,12 @@ class HttpServerConnection {
   /** If gzip is an acceptable encoding for responses. */
   bool m_acceptGzip = false;
 
+  /** The request's If-None-Match header (empty if none). */
+  std::string m_ifNoneMatch;
+
+  /** Whether the response may be cached if revalidated (see above). */
+  bool m_revalidate = false;
+
   /** The underlying stream for the connection. */
   uv::Stream& m_stream;
 
@@ -80,6 +80,12 @@ class HttpWebSocketServerConnection
    */
   WebSocket* m_websocket = nullptr;
 
+  /**
+   * Compression to accept on upgrade.  By default messages are not
+   * compressed.
+   */
+  WebSocket::DeflateOptions m_deflateOptions;
+
  private:
   WebSocketServerHelper m_helper;
   SmallVector<std::string, 2> m_protocols;
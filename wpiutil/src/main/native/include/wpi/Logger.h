@@ -5,10 +5,16 @@
 #ifndef WPIUTIL_WPI_LOGGER_H_
 #define WPIUTIL_WPI_LOGGER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <functional>
+#include <memory>
+#include <string_view>
 #include <utility>
 
 #include "fmt/format.h"
+#include "wpi/SafeThread.h"
 
 namespace wpi {
 
@@ -24,6 +30,10 @@ enum LogLevel {
   WPI_LOG_DEBUG4 = 6
 };
 
+namespace detail {
+class AsyncLogThread;
+}  // namespace detail
+
 class Logger {
  public:
   using LogFunc = std::function<void(unsigned int level, const char* file,
@@ -33,8 +43,18 @@ class Logger {
   explicit Logger(LogFunc func) : m_func(std::move(func)) {}
   Logger(LogFunc func, unsigned int min_level)
       : m_func(std::move(func)), m_min_level(min_level) {}
+  ~Logger();
+
+  // Copies the log function and level, but not asynchronous mode
+  Logger(const Logger& other)
+      : m_func(other.m_func), m_min_level(other.m_min_level) {}
+  Logger& operator=(const Logger& other) {
+    SetLogger(other.m_func);
+    m_min_level = other.m_min_level;
+    return *this;
+  }
 
-  void SetLogger(LogFunc func) { m_func = func; }
+  void SetLogger(LogFunc func);
 
   void set_min_level(unsigned int level) { m_min_level = level; }
   unsigned int min_level() const { return m_min_level; }
@@ -56,13 +76,76 @@ class Logger {
 
   bool HasLogger() const { return m_func != nullptr; }
 
+  /**
+   * Switches to asynchronous logging.  Messages are still filtered and
+   * formatted on the logging thread, but are then queued in a ring buffer
+   * for that thread, and a background thread passes them to the log
+   * function.  Slow log functions (disk or console I/O) then no longer stall
+   * the threads that log.
+   *
+   * When a thread's buffer is full, its messages are dropped and counted
+   * until the background thread catches up; a warning with the count is
+   * logged once it does.
+   *
+   * Like SetLogger(), this must not be called while other threads are
+   * logging.
+   *
+   * @param bufferSize messages each thread can have queued
+   */
+  void EnableAsync(size_t bufferSize = 1024);
+
+  /**
+   * Delivers the queued messages, stops the background thread, and returns
+   * to calling the log function on the logging thread.  Like SetLogger(),
+   * this must not be called while other threads are logging.
+   */
+  void DisableAsync();
+
+  /**
+   * Returns whether asynchronous logging is enabled.
+   */
+  bool IsAsync() const { return m_async != nullptr; }
+
+  /**
+   * Waits for the messages queued (by any thread) before the call to be
+   * passed to the log function.  Returns immediately if asynchronous logging
+   * is not enabled.
+   */
+  void Flush();
+
+  /**
+   * Returns the number of messages dropped because a buffer was full since
+   * asynchronous logging was enabled.
+   */
+  uint64_t GetDroppedCount() const;
+
  private:
+  void DoLogAsync(unsigned int level, const char* file, unsigned int line,
+                  std::string_view msg);
+
   LogFunc m_func;
   unsigned int m_min_level = 20;
+  std::shared_ptr<detail::AsyncLogThread> m_async;
+  SafeThreadOwner<detail::AsyncLogThread> m_asyncOwner;
 };
 
+/**
+ * Messages below this level are compiled out of WPI_LOG() and the macros
+ * built on it.  Define it (for example, to ::wpi::WPI_LOG_INFO) before
+ * including this header; by default every level is compiled in.
+ */
+#ifdef WPI_LOG_MIN_LEVEL
+#define WPI_LOG(logger_inst, level, format, ...)                       \
+  do {                                                                 \
+    if ((level) >= WPI_LOG_MIN_LEVEL) {                                \
+      logger_inst.Log(level, __FILE__, __LINE__, FMT_STRING(format),   \
+                      __VA_ARGS__);                                    \
+    }                                                                  \
+  } while (0)
+#else
 #define WPI_LOG(logger_inst, level, format, ...) \
   logger_inst.Log(level, __FILE__, __LINE__, FMT_STRING(format), __VA_ARGS__)
+#endif
 
 #define WPI_ERROR(inst, format, ...) \
   WPI_LOG(inst, ::wpi::WPI_LOG_ERROR, format, __VA_ARGS__)
@@ -0,0 +1,166 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_MAPPEDFILEREGION_H_
+#define WPIUTIL_WPI_MAPPEDFILEREGION_H_
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "wpi/fs.h"
+#include "wpi/raw_istream.h"
+#include "wpi/span.h"
+
+namespace wpi {
+
+/**
+ * A region of a file mapped into memory.  The mapping is removed when the
+ * object is destroyed.
+ */
+class MappedFileRegion {
+ public:
+  enum MapMode {
+    kReadOnly,   ///< May only access map via const_data
+    kReadWrite,  ///< May access map via data and modify it; written to file
+    kPriv        ///< May modify via data, but changes are lost on destruction
+  };
+
+  /**
+   * Expected access patterns, passed to the OS to tune read-ahead.
+   */
+  enum Advice {
+    kNormal,      ///< No particular pattern
+    kSequential,  ///< Read once from start to end
+    kRandom,      ///< Read in no particular order; read-ahead is wasted
+    kWillNeed     ///< Read soon; start paging it in now
+  };
+
+  MappedFileRegion() = default;
+
+  /**
+   * Maps part of an open file.  The file may be closed once this returns.
+   *
+   * @param f file; must be opened for writing for kReadWrite
+   * @param length number of bytes to map
+   * @param offset offset into the file; must be a multiple of
+   *               GetAlignment()
+   * @param mapMode access mode
+   * @param ec error code output, set to non-zero on error
+   */
+  MappedFileRegion(fs::file_t f, uint64_t length, uint64_t offset,
+                   MapMode mapMode, std::error_code& ec);
+
+  /**
+   * Maps a whole file.
+   *
+   * @param path file path
+   * @param mapMode access mode
+   * @param ec error code output, set to non-zero on error
+   */
+  MappedFileRegion(const fs::path& path, MapMode mapMode, std::error_code& ec);
+
+  ~MappedFileRegion() { Unmap(); }
+
+  MappedFileRegion(const MappedFileRegion&) = delete;
+  MappedFileRegion& operator=(const MappedFileRegion&) = delete;
+
+  MappedFileRegion(MappedFileRegion&& rhs)
+      : m_size(rhs.m_size), m_mapping(rhs.m_mapping) {
+#ifdef _WIN32
+    m_fileHandle = rhs.m_fileHandle;
+    rhs.m_fileHandle = nullptr;
+#endif
+    rhs.m_size = 0;
+    rhs.m_mapping = nullptr;
+  }
+
+  MappedFileRegion& operator=(MappedFileRegion&& rhs) {
+    if (this == &rhs) {
+      return *this;
+    }
+    Unmap();
+    m_size = std::exchange(rhs.m_size, 0);
+    m_mapping = std::exchange(rhs.m_mapping, nullptr);
+#ifdef _WIN32
+    m_fileHandle = std::exchange(rhs.m_fileHandle, nullptr);
+#endif
+    return *this;
+  }
+
+  explicit operator bool() const { return m_mapping != nullptr; }
+
+  size_t size() const { return m_size; }
+  uint8_t* data() const { return static_cast<uint8_t*>(m_mapping); }
+  const uint8_t* const_data() const {
+    return static_cast<const uint8_t*>(m_mapping);
+  }
+  span<const uint8_t> bytes() const { return {const_data(), m_size}; }
+
+  /**
+   * Writes modified pages of a kReadWrite mapping to the file, returning once
+   * they have been written.
+   */
+  void Flush();
+
+  /**
+   * Tells the OS how the mapping will be accessed.  Only a hint; ignored
+   * where unsupported.
+   *
+   * @param advice access pattern
+   */
+  void Advise(Advice advice);
+
+  /**
+   * Removes the mapping.
+   */
+  void Unmap();
+
+  /**
+   * Returns the required alignment of the offset of a mapping.
+   */
+  static size_t GetAlignment();
+
+ private:
+  size_t m_size = 0;
+  void* m_mapping = nullptr;
+#ifdef _WIN32
+  fs::file_t m_fileHandle = nullptr;
+#endif
+};
+
+/**
+ * An input stream over a mapped file.  Reads copy out of the mapping;
+ * remaining() and skip() (via raw_mem_istream) access it in place.
+ */
+class raw_mapped_istream : public raw_mem_istream {
+ public:
+  explicit raw_mapped_istream(MappedFileRegion&& region)
+      : raw_mem_istream(reinterpret_cast<const char*>(region.const_data()),
+                        region.size()),
+        m_region(std::move(region)) {}
+
+  /**
+   * Maps a whole file read-only, for reading start to end.
+   *
+   * @param filename file name
+   * @param ec error code output, set to non-zero on error
+   */
+  raw_mapped_istream(std::string_view filename, std::error_code& ec)
+      : raw_mapped_istream(Map(filename, ec)) {}
+
+  const MappedFileRegion& region() const { return m_region; }
+
+ private:
+  static MappedFileRegion Map(std::string_view filename, std::error_code& ec);
+
+  MappedFileRegion m_region;
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_MAPPEDFILEREGION_H_
@@ -0,0 +1,224 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_MEMORYRESOURCE_H_
+#define WPIUTIL_WPI_MEMORYRESOURCE_H_
+
+#include <stddef.h>
+
+#include <cstddef>
+
+namespace wpi {
+
+/**
+ * A source of memory for containers, so they can be backed by an arena or a
+ * pool instead of the heap.  This follows std::pmr::memory_resource, which
+ * isn't available from every standard library wpiutil is built with.
+ *
+ * StringMap and DenseMap take a resource at construction; standard
+ * containers can use one through ResourceAllocator.
+ */
+class MemoryResource {
+ public:
+  static constexpr size_t kMaxAlign = alignof(std::max_align_t);
+
+  virtual ~MemoryResource() = default;
+
+  /**
+   * Allocates memory.  Never returns null.
+   *
+   * @param bytes Size of the allocation.
+   * @param alignment Alignment of the allocation; a power of 2.
+   */
+  void* Allocate(size_t bytes, size_t alignment = kMaxAlign) {
+    return DoAllocate(bytes, alignment);
+  }
+
+  /**
+   * Deallocates memory from Allocate().
+   *
+   * @param p The allocation.
+   * @param bytes Size it was allocated with.
+   * @param alignment Alignment it was allocated with.
+   */
+  void Deallocate(void* p, size_t bytes, size_t alignment = kMaxAlign) {
+    DoDeallocate(p, bytes, alignment);
+  }
+
+ protected:
+  virtual void* DoAllocate(size_t bytes, size_t alignment) = 0;
+  virtual void DoDeallocate(void* p, size_t bytes, size_t alignment) = 0;
+};
+
+/**
+ * Gets the resource that allocates from the heap.
+ */
+MemoryResource* GetHeapMemoryResource();
+
+/**
+ * A resource that hands out memory by bumping a pointer through chunks from
+ * an upstream resource, and only gives it back all at once.  Deallocate() does
+ * nothing.  Meant for scratch work that is thrown away together, such as the
+ * temporaries of one loop iteration: call Reset() at the end of each, and once
+ * the chunks have grown to fit an iteration, no more are allocated.
+ *
+ * Not thread-safe.
+ */
+class MonotonicArena : public MemoryResource {
+ public:
+  /**
+   * Constructs an arena.  No memory is allocated until it is first used.
+   *
+   * @param chunkSize Size of the first chunk; each later one is twice as big
+   *                  as the one before.
+   * @param upstream Where chunks are allocated from.
+   */
+  explicit MonotonicArena(size_t chunkSize = 4096,
+                          MemoryResource* upstream = GetHeapMemoryResource());
+
+  /**
+   * Constructs an arena that uses a buffer (e.g. on the stack) before
+   * allocating chunks.
+   *
+   * @param buffer The buffer; must outlive the arena.
+   * @param size Size of the buffer.
+   * @param upstream Where chunks are allocated from once the buffer is full.
+   */
+  MonotonicArena(void* buffer, size_t size,
+                 MemoryResource* upstream = GetHeapMemoryResource());
+
+  ~MonotonicArena() override;
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  /**
+   * Makes all of the memory available again, keeping the chunks.  Everything
+   * allocated from the arena must no longer be in use.
+   */
+  void Reset();
+
+  /**
+   * Like Reset(), but also returns the chunks to the upstream resource.
+   */
+  void Release();
+
+  /**
+   * Gets the bytes allocated since construction or the last Reset().
+   */
+  size_t GetBytesUsed() const { return m_used; }
+
+ protected:
+  void* DoAllocate(size_t bytes, size_t alignment) override;
+  void DoDeallocate(void* p, size_t bytes, size_t alignment) override {}
+
+ private:
+  struct Chunk;
+
+  bool Fit(size_t bytes, size_t alignment, void** result);
+
+  MemoryResource* m_upstream;
+  char* m_buffer;
+  size_t m_bufferSize;
+  size_t m_nextChunkSize;
+  Chunk* m_chunks = nullptr;   // allocated, oldest first
+  Chunk* m_current = nullptr;  // being allocated from; null for the buffer
+  char* m_pos;
+  char* m_end;
+  size_t m_used = 0;
+};
+
+/**
+ * A resource that keeps freed blocks in lists by size class (powers of 2 up
+ * to kMaxPooledSize) and reuses them, carving new blocks from chunks of an
+ * upstream resource.  Larger allocations go straight to the upstream resource.
+ * Suits containers that repeatedly grow and shrink, like maps rebuilt every
+ * cycle.  Memory goes back upstream when the pool is destroyed or released.
+ *
+ * Not thread-safe.
+ */
+class PoolResource : public MemoryResource {
+ public:
+  static constexpr size_t kMaxPooledSize = 4096;
+
+  explicit PoolResource(MemoryResource* upstream = GetHeapMemoryResource());
+  ~PoolResource() override;
+
+  PoolResource(const PoolResource&) = delete;
+  PoolResource& operator=(const PoolResource&) = delete;
+
+  /**
+   * Returns all of the pool's memory to the upstream resource.  Everything
+   * allocated from the pool must no longer be in use.
+   */
+  void Release();
+
+ protected:
+  void* DoAllocate(size_t bytes, size_t alignment) override;
+  void DoDeallocate(void* p, size_t bytes, size_t alignment) override;
+
+ private:
+  static constexpr size_t kMinPooledSize = 16;
+  static constexpr size_t kNumClasses = 9;  // 16 to 4096
+  static constexpr size_t kChunkSize = 16384;
+
+  struct Block {
+    Block* next;
+  };
+  struct Chunk {
+    Chunk* next;
+  };
+
+  MemoryResource* m_upstream;
+  Block* m_free[kNumClasses] = {};
+  Chunk* m_chunks = nullptr;
+  char* m_pos = nullptr;
+  char* m_end = nullptr;
+};
+
+/**
+ * An allocator for standard containers that allocates from a MemoryResource,
+ * e.g. std::vector<int, ResourceAllocator<int>> v{&arena}.
+ */
+template <typename T>
+class ResourceAllocator {
+ public:
+  using value_type = T;
+
+  ResourceAllocator() noexcept : m_resource{GetHeapMemoryResource()} {}
+  ResourceAllocator(MemoryResource* resource) noexcept  // NOLINT
+      : m_resource{resource} {}
+  template <typename U>
+  ResourceAllocator(const ResourceAllocator<U>& other) noexcept  // NOLINT
+      : m_resource{other.GetResource()} {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(m_resource->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    m_resource->Deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  MemoryResource* GetResource() const { return m_resource; }
+
+ private:
+  MemoryResource* m_resource;
+};
+
+template <typename T, typename U>
+bool operator==(const ResourceAllocator<T>& lhs,
+                const ResourceAllocator<U>& rhs) {
+  return lhs.GetResource() == rhs.GetResource();
+}
+
+template <typename T, typename U>
+bool operator!=(const ResourceAllocator<T>& lhs,
+                const ResourceAllocator<U>& rhs) {
+  return lhs.GetResource() != rhs.GetResource();
+}
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_MEMORYRESOURCE_H_
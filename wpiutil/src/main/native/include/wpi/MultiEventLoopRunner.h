@@ -0,0 +1,115 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_MULTIEVENTLOOPRUNNER_H_
+#define WPIUTIL_WPI_MULTIEVENTLOOPRUNNER_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "wpi/EventLoopRunner.h"
+
+namespace wpi {
+
+namespace uv {
+class Tcp;
+}  // namespace uv
+
+/**
+ * Executes an accept loop and several shard loops, each on its own thread, so
+ * a server can use more than one core.
+ *
+ * Servers listen on the accept loop and hand each connection they accept to a
+ * shard with HandOff(); the connection then lives on that shard's loop.  Each
+ * loop is an EventLoopRunner, so functions are run on it in the usual way.
+ * As always, handles must only be used from the loop they were created on.
+ */
+class MultiEventLoopRunner {
+ public:
+  using LoopFunc = EventLoopRunner::LoopFunc;
+
+  /**
+   * Called on a shard's loop with a connection handed to it.
+   */
+  using ConnectionFunc =
+      std::function<void(uv::Loop& loop, std::shared_ptr<uv::Tcp> client)>;
+
+  /**
+   * Constructor.
+   * @param numShards number of shard loops; 0 for one per hardware thread
+   */
+  explicit MultiEventLoopRunner(size_t numShards = 0);
+  ~MultiEventLoopRunner();
+
+  MultiEventLoopRunner(const MultiEventLoopRunner&) = delete;
+  MultiEventLoopRunner& operator=(const MultiEventLoopRunner&) = delete;
+
+  /**
+   * Stop the loops.  Once stopped they cannot be restarted.
+   * This function does not return until all the loops have exited.
+   */
+  void Stop();
+
+  /**
+   * Get the accept loop runner.
+   */
+  EventLoopRunner& GetAcceptor() { return m_acceptor; }
+
+  /**
+   * Get the number of shard loops.
+   */
+  size_t GetNumShards() const { return m_shards.size(); }
+
+  /**
+   * Get a shard loop runner.
+   * @param index shard index, less than GetNumShards()
+   */
+  EventLoopRunner& GetShard(size_t index) { return *m_shards[index].runner; }
+
+  /**
+   * Get the number of open connections handed to a shard.
+   * @param index shard index, less than GetNumShards()
+   */
+  size_t GetNumConnections(size_t index) const {
+    return m_shards[index].connections->load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Run a function synchronously (once) on every shard loop in turn.
+   * This is safe to call from any thread, but is NOT safe to call from a
+   * shard loop (it will deadlock).
+   * @param func function to execute on each loop
+   */
+  void ExecSyncAll(LoopFunc func);
+
+  /**
+   * Moves a connection to the shard with the fewest open connections.  The
+   * client handle is closed, and func is called on the shard's loop with a new
+   * handle for the same socket.  Call this from the loop the client was
+   * accepted on.
+   *
+   * @param client connected handle
+   * @param func   function to call on the shard's loop
+   * @return False if the socket couldn't be moved (the client is left open)
+   */
+  bool HandOff(uv::Tcp& client, ConnectionFunc func);
+
+ private:
+  struct Shard {
+    std::unique_ptr<EventLoopRunner> runner;
+    // shared with the handles on the shard, which may outlive the runner
+    std::shared_ptr<std::atomic<size_t>> connections;
+  };
+
+  EventLoopRunner m_acceptor;
+  std::vector<Shard> m_shards;
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_MULTIEVENTLOOPRUNNER_H_
@@ -0,0 +1,175 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_PARALLELTCPCONNECTOR_H_
+#define WPIUTIL_WPI_PARALLELTCPCONNECTOR_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "wpi/Signal.h"
+#include "wpi/span.h"
+#include "wpi/uv/Timer.h"
+
+namespace wpi {
+
+class Logger;
+
+namespace uv {
+class GetAddrInfoReq;
+class Loop;
+class Tcp;
+}  // namespace uv
+
+/**
+ * Connects to the first reachable of a list of TCP servers, without blocking
+ * or starting threads.  Runs on a uv::Loop; all functions must be called
+ * from the loop's thread.
+ *
+ * All the server names are resolved in parallel.  Connection attempts are
+ * started one at a time as addresses come in, "happy eyeballs" style: each
+ * attempt gets the attempt delay to succeed before the next one starts
+ * alongside it, and a failed attempt lets the next one start immediately.
+ * The first connection made wins; the other attempts are abandoned.
+ *
+ * The address that last won is tried first on the next connect, before
+ * any name is resolved, so reconnecting to a server that is still there
+ * takes a single round trip.
+ *
+ * While not connected, the connector starts over every reconnect period,
+ * abandoning attempts that haven't finished.
+ */
+class ParallelTcpConnector
+    : public std::enable_shared_from_this<ParallelTcpConnector> {
+  struct private_init {};
+
+ public:
+  /**
+   * Default delay before starting the next connection attempt.
+   */
+  static constexpr uv::Timer::Time kDefaultAttemptDelay{250};
+
+  /**
+   * Creates a connector.  It doesn't start connecting until SetServers() is
+   * called.
+   *
+   * @param loop loop to run on
+   * @param reconnectRate how often to start over while not connected
+   * @param logger logger
+   */
+  static std::shared_ptr<ParallelTcpConnector> Create(
+      uv::Loop& loop, uv::Timer::Time reconnectRate, Logger& logger);
+
+  ParallelTcpConnector(uv::Loop& loop, uv::Timer::Time reconnectRate,
+                       Logger& logger, const private_init&);
+  ~ParallelTcpConnector();
+
+  ParallelTcpConnector(const ParallelTcpConnector&) = delete;
+  ParallelTcpConnector& operator=(const ParallelTcpConnector&) = delete;
+
+  /**
+   * Stops connecting for good.  A connection already made is unaffected.
+   */
+  void Close();
+
+  /**
+   * Sets the servers to connect to, in order of preference.  If not
+   * connected, starts connecting to them.  A different list forgets the
+   * cached address.
+   *
+   * @param servers server names (or addresses) and ports
+   */
+  void SetServers(span<const std::pair<std::string, unsigned int>> servers);
+
+  /**
+   * Restricts connections to one address family.
+   *
+   * @param family AF_INET or AF_INET6; AF_UNSPEC (the default) allows both
+   */
+  void SetAddressFamily(int family) { m_family = family; }
+
+  /**
+   * Sets how long each connection attempt has before the next one starts.
+   *
+   * @param delay attempt delay
+   */
+  void SetAttemptDelay(uv::Timer::Time delay) { m_attemptDelay = delay; }
+
+  /**
+   * Tells the connector the connection it made has closed.  It starts
+   * connecting again immediately.
+   */
+  void Disconnected();
+
+  /**
+   * Returns whether a connection has been made (and Disconnected() hasn't
+   * been called since).
+   */
+  bool IsConnected() const { return m_isConnected; }
+
+  /**
+   * Returns whether names are being resolved or connection attempts are in
+   * progress.
+   */
+  bool IsConnecting() const { return m_outstanding != 0; }
+
+  /**
+   * Emitted with the winning connection.  The connector keeps no reference
+   * to it; close it when done and call Disconnected().
+   */
+  sig::Signal<uv::Tcp&> connected;
+
+  /**
+   * Emitted when every address of every server has failed.  The connector
+   * tries again after the reconnect period.
+   */
+  sig::Signal<> failed;
+
+ private:
+  struct Candidate {
+    sockaddr_storage addr;
+    size_t server;  // index into m_servers
+  };
+
+  void Connect();
+  void CancelAll();
+  void Resolve(size_t server);
+  void AddCandidate(const sockaddr& addr, size_t server);
+  void StartNextAttempt();
+  void AttemptDone();
+  void Succeeded(uv::Tcp& tcp, const Candidate& candidate);
+
+  uv::Loop& m_loop;
+  Logger& m_logger;
+  uv::Timer::Time m_reconnectRate;
+  uv::Timer::Time m_attemptDelay = kDefaultAttemptDelay;
+  int m_family = AF_UNSPEC;
+  std::vector<std::pair<std::string, unsigned int>> m_servers;
+  std::shared_ptr<uv::Timer> m_reconnectTimer;
+  std::shared_ptr<uv::Timer> m_attemptTimer;
+  bool m_isConnected = false;
+  bool m_closed = false;
+
+  // The current round; callbacks from earlier rounds are ignored
+  uint64_t m_round = 0;
+  std::vector<std::weak_ptr<uv::GetAddrInfoReq>> m_resolvers;
+  std::vector<std::weak_ptr<uv::Tcp>> m_attempts;
+  // Addresses waiting to be tried, and all those seen this round
+  std::deque<Candidate> m_pending;
+  std::vector<sockaddr_storage> m_seen;
+  // Resolutions and attempts in progress
+  size_t m_outstanding = 0;
+
+  bool m_haveCached = false;
+  Candidate m_cached;
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_PARALLELTCPCONNECTOR_H_
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <memory>
 #include <string_view>
 
@@ -15,9 +17,26 @@ namespace wpi {
 /**
  * Forward ports to another host.  This is primarily useful for accessing
  * Ethernet-connected devices from a computer tethered to the RoboRIO USB port.
+ *
+ * On Linux, forwarded data is moved between the sockets with splice() and
+ * never copied through user space.
  */
 class PortForwarder {
  public:
+  /**
+   * Traffic through a forwarded port.
+   */
+  struct Stats {
+    /** Connections accepted. */
+    uint64_t connections = 0;
+
+    /** Bytes forwarded from local clients to the remote host. */
+    uint64_t bytesToRemote = 0;
+
+    /** Bytes forwarded from the remote host to local clients. */
+    uint64_t bytesFromRemote = 0;
+  };
+
   PortForwarder(const PortForwarder&) = delete;
   PortForwarder& operator=(const PortForwarder&) = delete;
 
@@ -47,6 +66,14 @@ class PortForwarder {
    */
   void Remove(unsigned int port);
 
+  /**
+   * Get the traffic through a forwarded port since it was added.
+   *
+   * @param port local port number
+   * @return Traffic counts; all zero if the port isn't forwarded
+   */
+  Stats GetStats(unsigned int port);
+
  private:
   PortForwarder();
 
@@ -18,6 +18,7 @@
 #include "wpi/iterator.h"
 #include "wpi/iterator_range.h"
 #include "wpi/MemAlloc.h"
+#include "wpi/MemoryResource.h"
 #include "wpi/PointerLikeTypeTraits.h"
 #include "wpi/ErrorHandling.h"
 #include "wpi/deprecated.h"
@@ -60,21 +61,25 @@ protected:
   unsigned NumItems = 0;
   unsigned NumTombstones = 0;
   unsigned ItemSize;
+  // Where the table and entries are allocated from; null for the heap.
+  MemoryResource *Resource = nullptr;
 
 protected:
-  explicit StringMapImpl(unsigned itemSize)
-      : ItemSize(itemSize) {}
+  explicit StringMapImpl(unsigned itemSize,
+                         MemoryResource *resource = nullptr)
+      : ItemSize(itemSize), Resource(resource) {}
   StringMapImpl(StringMapImpl &&RHS) noexcept
       : TheTable(RHS.TheTable), NumBuckets(RHS.NumBuckets),
         NumItems(RHS.NumItems), NumTombstones(RHS.NumTombstones),
-        ItemSize(RHS.ItemSize) {
+        ItemSize(RHS.ItemSize), Resource(RHS.Resource) {
     RHS.TheTable = nullptr;
     RHS.NumBuckets = 0;
     RHS.NumItems = 0;
     RHS.NumTombstones = 0;
   }
 
-  StringMapImpl(unsigned InitSize, unsigned ItemSize);
+  StringMapImpl(unsigned InitSize, unsigned ItemSize,
+                MemoryResource *resource = nullptr);
   unsigned RehashTable(unsigned BucketNo = 0);
 
   /// LookupBucketFor - Look up the bucket that the specified string should end
@@ -82,12 +87,20 @@ protected:
   /// specified bucket will be non-null.  Otherwise, it will be null.  In either
   /// case, the FullHashValue field of the bucket will be set to the hash value
   /// of the string.
-  unsigned LookupBucketFor(std::string_view Key);
+  unsigned LookupBucketFor(std::string_view Key) {
+    return LookupBucketFor(Key, hash(Key));
+  }
+
+  /// Overload that explicitly takes precomputed hash(Key).
+  unsigned LookupBucketFor(std::string_view Key, uint32_t FullHashValue);
 
   /// FindKey - Look up the bucket that contains the specified key. If it exists
   /// in the map, return the bucket number of the key.  Otherwise return -1.
   /// This does not modify the map.
-  int FindKey(std::string_view Key) const;
+  int FindKey(std::string_view Key) const { return FindKey(Key, hash(Key)); }
+
+  /// Overload that explicitly takes precomputed hash(Key).
+  int FindKey(std::string_view Key, uint32_t FullHashValue) const;
 
   /// RemoveKey - Remove the specified StringMapEntry from the table, but do not
   /// delete it.  This aborts if the value isn't in the table.
@@ -101,6 +114,11 @@ protected:
   /// setup the map as empty.
   void init(unsigned Size);
 
+  /// Allocate a zeroed table (with its sentinel and hash values) from
+  /// Resource, or free one allocated by allocateTable.
+  StringMapEntryBase **allocateTable(unsigned Size);
+  void freeTable(StringMapEntryBase **Table, unsigned Size);
+
 public:
   static StringMapEntryBase *getTombstoneVal() {
     uintptr_t Val = static_cast<uintptr_t>(-1);
@@ -108,17 +126,28 @@ public:
     return reinterpret_cast<StringMapEntryBase *>(Val);
   }
 
+  /// Returns the hash value that will be used for the given string.
+  /// This allows precomputing the value and passing it explicitly
+  /// to some of the functions.
+  /// The implementation of this function is not guaranteed to be stable
+  /// and may change.
+  static uint32_t hash(std::string_view Key);
+
   unsigned getNumBuckets() const { return NumBuckets; }
   unsigned getNumItems() const { return NumItems; }
 
   bool empty() const { return NumItems == 0; }
   unsigned size() const { return NumItems; }
 
+  /// Returns the resource memory is allocated from; null for the heap.
+  MemoryResource *getResource() const { return Resource; }
+
   void swap(StringMapImpl &Other) {
     std::swap(TheTable, Other.TheTable);
     std::swap(NumBuckets, Other.NumBuckets);
     std::swap(NumItems, Other.NumItems);
     std::swap(NumTombstones, Other.NumTombstones);
+    std::swap(Resource, Other.Resource);
   }
 };
 
@@ -157,14 +186,23 @@ public:
   /// \p InitiVals.
   template <typename... InitTy>
   static StringMapEntry *Create(std::string_view Key, InitTy &&... InitVals) {
+    return CreateIn(Key, nullptr, std::forward<InitTy>(InitVals)...);
+  }
+
+  /// Create a StringMapEntry allocated from \p Resource (the heap if null).
+  template <typename... InitTy>
+  static StringMapEntry *CreateIn(std::string_view Key,
+                                  MemoryResource *Resource,
+                                  InitTy &&... InitVals) {
     size_t KeyLength = Key.size();
 
     // Allocate a new item with space for the string at the end and a null
     // terminator.
     size_t AllocSize = sizeof(StringMapEntry) + KeyLength + 1;
 
-    StringMapEntry *NewItem =
-      static_cast<StringMapEntry*>(safe_malloc(AllocSize));
+    StringMapEntry *NewItem = static_cast<StringMapEntry*>(
+        Resource ? Resource->Allocate(AllocSize, alignof(StringMapEntry))
+                 : safe_malloc(AllocSize));
 
     // Construct the value.
     new (NewItem) StringMapEntry(KeyLength, std::forward<InitTy>(InitVals)...);
@@ -190,10 +228,18 @@ public:
 
   /// Destroy - Destroy this StringMapEntry, releasing memory back to the
   /// specified allocator.
-  void Destroy() {
+  void Destroy() { DestroyIn(nullptr); }
+
+  /// DestroyIn - Destroy a StringMapEntry created by CreateIn with
+  /// \p Resource.
+  void DestroyIn(MemoryResource *Resource) {
+    size_t AllocSize = sizeof(StringMapEntry) + getKeyLength() + 1;
     // Free memory referenced by the item.
     this->~StringMapEntry();
-    std::free(static_cast<void *>(this));
+    if (Resource)
+      Resource->Deallocate(this, AllocSize, alignof(StringMapEntry));
+    else
+      std::free(static_cast<void *>(this));
   }
 };
 
@@ -212,6 +258,15 @@ public:
   explicit StringMap(unsigned InitialSize)
     : StringMapImpl(InitialSize, static_cast<unsigned>(sizeof(MapEntryTy))) {}
 
+  /// Construct a map that allocates its table and entries from \p Resource,
+  /// which must outlive it.  Copies of the map allocate from the heap.
+  explicit StringMap(MemoryResource *Resource)
+      : StringMapImpl(static_cast<unsigned>(sizeof(MapEntryTy)), Resource) {}
+
+  StringMap(unsigned InitialSize, MemoryResource *Resource)
+      : StringMapImpl(InitialSize, static_cast<unsigned>(sizeof(MapEntryTy)),
+                      Resource) {}
+
   StringMap(std::initializer_list<std::pair<std::string_view, ValueTy>> List)
       : StringMapImpl(List.size(), static_cast<unsigned>(sizeof(MapEntryTy))) {
     for (const auto &P : List) {
@@ -269,11 +324,11 @@ public:
       for (unsigned I = 0, E = NumBuckets; I != E; ++I) {
         StringMapEntryBase *Bucket = TheTable[I];
         if (Bucket && Bucket != getTombstoneVal()) {
-          static_cast<MapEntryTy*>(Bucket)->Destroy();
+          static_cast<MapEntryTy*>(Bucket)->DestroyIn(Resource);
         }
       }
     }
-    free(TheTable);
+    freeTable(TheTable, NumBuckets);
   }
 
   using key_type = const char*;
@@ -302,14 +357,22 @@ public:
                       StringMapKeyIterator<ValueTy>(end()));
   }
 
-  iterator find(std::string_view Key) {
-    int Bucket = FindKey(Key);
+  iterator find(std::string_view Key) { return find(Key, hash(Key)); }
+
+  /// find - Look up Key using its precomputed hash(Key); callers that look
+  /// up the same key repeatedly can compute the hash once.
+  iterator find(std::string_view Key, uint32_t FullHashValue) {
+    int Bucket = FindKey(Key, FullHashValue);
     if (Bucket == -1) return end();
     return iterator(TheTable+Bucket, true);
   }
 
   const_iterator find(std::string_view Key) const {
-    int Bucket = FindKey(Key);
+    return find(Key, hash(Key));
+  }
+
+  const_iterator find(std::string_view Key, uint32_t FullHashValue) const {
+    int Bucket = FindKey(Key, FullHashValue);
     if (Bucket == -1) return end();
     return const_iterator(TheTable+Bucket, true);
   }
@@ -332,6 +395,11 @@ public:
     return find(Key) == end() ? 0 : 1;
   }
 
+  /// count - Overload that takes precomputed hash(Key).
+  size_type count(std::string_view Key, uint32_t FullHashValue) const {
+    return find(Key, FullHashValue) == end() ? 0 : 1;
+  }
+
   /// insert - Insert the specified key/value pair into the map.  If the key
   /// already exists in the map, return false and ignore the request, otherwise
   /// insert it and return true.
@@ -365,7 +433,15 @@ public:
   /// the pair points to the element with key equivalent to the key of the pair.
   template <typename... ArgsTy>
   std::pair<iterator, bool> try_emplace(std::string_view Key, ArgsTy &&... Args) {
-    unsigned BucketNo = LookupBucketFor(Key);
+    return try_emplace_with_hash(Key, hash(Key), std::forward<ArgsTy>(Args)...);
+  }
+
+  /// try_emplace - Overload that takes precomputed hash(Key).
+  template <typename... ArgsTy>
+  std::pair<iterator, bool> try_emplace_with_hash(std::string_view Key,
+                                                  uint32_t FullHashValue,
+                                                  ArgsTy &&... Args) {
+    unsigned BucketNo = LookupBucketFor(Key, FullHashValue);
     StringMapEntryBase *&Bucket = TheTable[BucketNo];
     if (Bucket && Bucket != getTombstoneVal())
       return std::make_pair(iterator(TheTable + BucketNo, false),
@@ -373,7 +449,8 @@ public:
 
     if (Bucket == getTombstoneVal())
       --NumTombstones;
-    Bucket = MapEntryTy::Create(Key, std::forward<ArgsTy>(Args)...);
+    Bucket =
+        MapEntryTy::CreateIn(Key, Resource, std::forward<ArgsTy>(Args)...);
     ++NumItems;
     assert(NumItems + NumTombstones <= NumBuckets);
 
@@ -390,7 +467,7 @@ public:
     for (unsigned I = 0, E = NumBuckets; I != E; ++I) {
       StringMapEntryBase *&Bucket = TheTable[I];
       if (Bucket && Bucket != getTombstoneVal()) {
-        static_cast<MapEntryTy*>(Bucket)->Destroy();
+        static_cast<MapEntryTy*>(Bucket)->DestroyIn(Resource);
       }
       Bucket = nullptr;
     }
@@ -400,7 +477,8 @@ public:
   }
 
   /// remove - Remove the specified key/value pair from the map, but do not
-  /// erase it.  This aborts if the key is not in the map.
+  /// erase it.  This aborts if the key is not in the map.  The caller
+  /// destroys it with DestroyIn(getResource()).
   void remove(MapEntryTy *KeyValue) {
     RemoveKey(KeyValue);
   }
@@ -408,7 +486,7 @@ public:
   void erase(iterator I) {
     MapEntryTy &V = *I;
     remove(&V);
-    V.Destroy();
+    V.DestroyIn(Resource);
   }
 
   bool erase(std::string_view Key) {
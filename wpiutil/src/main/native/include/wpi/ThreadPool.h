@@ -0,0 +1,190 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_THREADPOOL_H_
+#define WPIUTIL_WPI_THREADPOOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "wpi/FunctionExtras.h"
+#include "wpi/condition_variable.h"
+#include "wpi/function_ref.h"
+#include "wpi/future.h"
+#include "wpi/mutex.h"
+
+namespace wpi {
+
+/**
+ * A pool of worker threads that run tasks in parallel.
+ *
+ * Each worker has its own task deque.  Tasks submitted from a worker (for
+ * example, by a task that splits its work) go on that worker's deque and are
+ * run newest first; idle workers steal the oldest tasks of busy ones.  Tasks
+ * submitted from other threads go on a shared queue.
+ *
+ * Tasks must not throw (except in ParallelFor(), which passes exceptions on
+ * to its caller).  A task that waits on the future of another task can
+ * deadlock if every worker is doing the same; use ParallelFor() to wait for
+ * parallel work from inside a task.
+ *
+ * Destroying the pool runs the tasks already submitted, then joins the
+ * workers.
+ */
+class ThreadPool {
+ public:
+  struct Options {
+    /**
+     * Number of worker threads.  0 selects one per hardware thread.
+     */
+    unsigned int numThreads = 0;
+
+    /**
+     * CPUs the workers are pinned to; worker i runs on cpus[i % size].  If
+     * empty (the default), the workers may run on any CPU.  Ignored on
+     * platforms without thread affinity control.
+     */
+    std::vector<int> cpus;
+
+    /**
+     * Called on each worker thread (with its index) before it runs any task.
+     * Use it to set the workers' priority, for example with
+     * frc::SetCurrentThreadPriority(true, 15) to run them real-time on the
+     * roboRIO.
+     */
+    std::function<void(unsigned int index)> threadStart;
+  };
+
+  /**
+   * Starts a pool with one worker per hardware thread.
+   */
+  ThreadPool();
+
+  /**
+   * Starts a pool.
+   *
+   * @param options pool options
+   */
+  explicit ThreadPool(const Options& options);
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * Gets the number of worker threads.
+   */
+  unsigned int GetNumThreads() const {
+    return static_cast<unsigned int>(m_workers.size());
+  }
+
+  /**
+   * Queues a task, without a way to get its completion.
+   *
+   * It's safe to call this function from any thread.
+   *
+   * @param task the task
+   */
+  void Post(unique_function<void()> task);
+
+  /**
+   * Queues a function call and returns a future for its result.
+   *
+   * It's safe to call this function from any thread.
+   *
+   * @param func the function
+   * @param args arguments for func; copied (or moved) into the task
+   * @return the future
+   */
+  template <typename F, typename... Args,
+            typename R = std::invoke_result_t<std::decay_t<F>,
+                                              std::decay_t<Args>...>>
+  future<R> Submit(F&& func, Args&&... args) {
+    promise<R> p;
+    auto result = p.get_future();
+    Post([p = std::move(p), func = std::forward<F>(func),
+          params = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+      if constexpr (std::is_void_v<R>) {
+        std::apply(func, std::move(params));
+        p.set_value();
+      } else {
+        p.set_value(std::apply(func, std::move(params)));
+      }
+    });
+    return result;
+  }
+
+  /**
+   * Calls func(i) for each i in [begin, end), spread across the workers and
+   * the calling thread, and waits for all the calls to finish.
+   *
+   * The range is split into chunks of grainSize indices; the calls within a
+   * chunk are made in order on one thread.  It's safe to call this function
+   * from a task, and a nested call helps with its own work rather than
+   * waiting for a free worker.  If a call throws, no further chunks are
+   * started, and the first exception is rethrown once the started ones have
+   * finished.
+   *
+   * @param begin first index
+   * @param end one past the last index
+   * @param func the function to call with each index
+   * @param grainSize indices per chunk; 0 picks a few chunks per thread
+   */
+  template <typename F>
+  void ParallelFor(size_t begin, size_t end, F&& func, size_t grainSize = 0) {
+    if (begin >= end) {
+      return;
+    }
+    size_t count = end - begin;
+    if (grainSize == 0) {
+      size_t chunks = 4 * (GetNumThreads() + 1);
+      grainSize = (count + chunks - 1) / chunks;
+    }
+    size_t numChunks = (count + grainSize - 1) / grainSize;
+    RunChunks(numChunks, [&](size_t chunk) {
+      size_t first = begin + chunk * grainSize;
+      size_t last = (count - chunk * grainSize) > grainSize ? first + grainSize
+                                                             : end;
+      for (size_t i = first; i < last; ++i) {
+        func(i);
+      }
+    });
+  }
+
+ private:
+  using Task = unique_function<void()>;
+
+  struct Worker;
+
+  void Start(const Options& options);
+  void WorkerMain(unsigned int index);
+  bool TryGetTask(unsigned int index, Task* task);
+  void RunChunks(size_t numChunks, function_ref<void(size_t)> body);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+
+  // Tasks from threads outside the pool
+  wpi::mutex m_sharedMutex;
+  std::deque<Task> m_shared;
+
+  // Queued tasks (in all queues); workers sleep while it is 0
+  std::atomic<size_t> m_pending{0};
+  std::atomic<int> m_sleeping{0};
+  std::atomic_bool m_stopping{false};
+  wpi::mutex m_sleepMutex;
+  wpi::condition_variable m_sleepCond;
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_THREADPOOL_H_
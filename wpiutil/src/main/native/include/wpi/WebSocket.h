@@ -41,6 +41,7 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
   static constexpr uint8_t kOpPong = 0x0A;
   static constexpr uint8_t kOpMask = 0x0F;
   static constexpr uint8_t kFlagFin = 0x80;
+  static constexpr uint8_t kFlagRsv1 = 0x40;
   static constexpr uint8_t kFlagMasking = 0x80;
   static constexpr uint8_t kLenMask = 0x7f;
 
@@ -68,6 +69,33 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
     CLOSED
   };
 
+  /**
+   * Per-message compression (the RFC 7692 permessage-deflate extension)
+   * options.  Compression is only negotiated if both ends enable it, and only
+   * if wpiutil was built with zlib; see IsDeflateAvailable().
+   *
+   * The window sizes are base-2 logarithms, limited to 9 to 15; smaller
+   * windows use less memory per connection but compress less.  Without
+   * context takeover, each message is compressed on its own, which also
+   * saves memory between messages.
+   */
+  struct DeflateOptions {
+    /** Whether to offer (client) or accept (server) compression. */
+    bool enable = false;
+
+    /** Window size the server compresses with. */
+    int serverMaxWindowBits = 15;
+
+    /** Window size the client compresses with. */
+    int clientMaxWindowBits = 15;
+
+    /** Whether the server resets its compression after each message. */
+    bool serverNoContextTakeover = false;
+
+    /** Whether the client resets its compression after each message. */
+    bool clientNoContextTakeover = false;
+  };
+
   /**
    * Client connection options.
    */
@@ -79,6 +107,9 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
 
     /** Additional headers to include in handshake. */
     span<const std::pair<std::string_view, std::string_view>> extraHeaders;
+
+    /** Compression to offer to the server. */
+    DeflateOptions deflate;
   };
 
   /**
@@ -131,6 +162,33 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
       uv::Stream& stream, std::string_view key, std::string_view version,
       std::string_view protocol = {});
 
+  /**
+   * Starts a server connection by performing the initial server side handshake,
+   * accepting compression if the client offers it.
+   * This should be called after the HTTP headers have been received.
+   * An open event is emitted when the handshake completes.
+   * This sets the stream user data to the websocket.
+   * @param stream Connection stream
+   * @param key The value of the Sec-WebSocket-Key header field in the client
+   *            request
+   * @param version The value of the Sec-WebSocket-Version header field in the
+   *                client request
+   * @param protocol The subprotocol to send to the client (in the
+   *                 Sec-WebSocket-Protocol header field).
+   * @param extensions The value of the Sec-WebSocket-Extensions header field
+   *                   in the client request
+   * @param deflate Compression to accept
+   */
+  static std::shared_ptr<WebSocket> CreateServer(
+      uv::Stream& stream, std::string_view key, std::string_view version,
+      std::string_view protocol, std::string_view extensions,
+      const DeflateOptions& deflate);
+
+  /**
+   * Get whether permessage-deflate compression is supported by this build.
+   */
+  static bool IsDeflateAvailable();
+
   /**
    * Get connection state.
    */
@@ -152,6 +210,12 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
    */
   std::string_view GetProtocol() const { return m_protocol; }
 
+  /**
+   * Get whether messages are compressed.  Only valid in or after the open()
+   * event.
+   */
+  bool IsCompressed() const { return m_deflate != nullptr; }
+
   /**
    * Set the maximum message size.  Default is 128 KB.  If configured to combine
    * fragments this maximum applies to the entire message (all combined
@@ -362,6 +426,76 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
     SendPong({data.begin(), data.end()}, callback);
   }
 
+  /**
+   * Send the same text message to several connections.  The frame is built
+   * once, and each connection writes it with the caller's buffers rather than
+   * a copy of them.  Client connections, which must mask each frame with a
+   * key of their own, and compressed connections each send it as SendText()
+   * would.
+   *
+   * @param websockets connections; those that are not open are skipped with
+   *                   an error
+   * @param data UTF-8 encoded data to send
+   * @param callback Callback which is invoked once all connections have
+   *                 finished writing, with the first error (if any)
+   */
+  static void BroadcastText(
+      span<const std::shared_ptr<WebSocket>> websockets,
+      span<const uv::Buffer> data,
+      std::function<void(span<uv::Buffer>, uv::Error)> callback) {
+    Broadcast(websockets, kFlagFin | kOpText, data, callback);
+  }
+
+  /**
+   * Send the same text message to several connections.
+   *
+   * @param websockets connections
+   * @param data UTF-8 encoded data to send
+   * @param callback Callback which is invoked once all connections have
+   *                 finished writing
+   */
+  static void BroadcastText(
+      span<const std::shared_ptr<WebSocket>> websockets,
+      std::initializer_list<uv::Buffer> data,
+      std::function<void(span<uv::Buffer>, uv::Error)> callback) {
+    BroadcastText(websockets, {data.begin(), data.end()}, callback);
+  }
+
+  /**
+   * Send the same binary message to several connections.  The frame is built
+   * once, and each connection writes it with the caller's buffers rather than
+   * a copy of them.  Client connections, which must mask each frame with a
+   * key of their own, and compressed connections each send it as SendBinary()
+   * would.
+   *
+   * @param websockets connections; those that are not open are skipped with
+   *                   an error
+   * @param data Data to send
+   * @param callback Callback which is invoked once all connections have
+   *                 finished writing, with the first error (if any)
+   */
+  static void BroadcastBinary(
+      span<const std::shared_ptr<WebSocket>> websockets,
+      span<const uv::Buffer> data,
+      std::function<void(span<uv::Buffer>, uv::Error)> callback) {
+    Broadcast(websockets, kFlagFin | kOpBinary, data, callback);
+  }
+
+  /**
+   * Send the same binary message to several connections.
+   *
+   * @param websockets connections
+   * @param data Data to send
+   * @param callback Callback which is invoked once all connections have
+   *                 finished writing
+   */
+  static void BroadcastBinary(
+      span<const std::shared_ptr<WebSocket>> websockets,
+      std::initializer_list<uv::Buffer> data,
+      std::function<void(span<uv::Buffer>, uv::Error)> callback) {
+    BroadcastBinary(websockets, {data.begin(), data.end()}, callback);
+  }
+
   /**
    * Fail the connection.
    */
@@ -450,6 +584,11 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
   size_t m_frameStart = 0;
   uint64_t m_frameSize = UINT64_MAX;
   uint8_t m_fragmentOpcode = 0;
+  bool m_compressedMessage = false;
+
+  // compression state, if negotiated
+  class Deflate;
+  std::unique_ptr<Deflate> m_deflate;
 
   // temporary data used only during client handshake
   class ClientHandshakeData;
@@ -459,13 +598,18 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
                    span<const std::string_view> protocols,
                    const ClientOptions& options);
   void StartServer(std::string_view key, std::string_view version,
-                   std::string_view protocol);
+                   std::string_view protocol, std::string_view extensions,
+                   const DeflateOptions& deflate);
   void SendClose(uint16_t code, std::string_view reason);
   void SetClosed(uint16_t code, std::string_view reason, bool failed = false);
   void Shutdown();
   void HandleIncoming(uv::Buffer& buf, size_t size);
   void Send(uint8_t opcode, span<const uv::Buffer> data,
             std::function<void(span<uv::Buffer>, uv::Error)> callback);
+  static void Broadcast(
+      span<const std::shared_ptr<WebSocket>> websockets, uint8_t opcode,
+      span<const uv::Buffer> data,
+      std::function<void(span<uv::Buffer>, uv::Error)> callback);
 };
 
 }  // namespace wpi
@@ -80,6 +80,21 @@ class WebSocketServerHelper {
     return WebSocket::CreateServer(stream, m_key, m_version, protocol);
   }
 
+  /**
+   * Accept the upgrade, also accepting compression if the client offered it.
+   * Disconnect other readers (such as the HttpParser reader) before calling
+   * this.  See also WebSocket::CreateServer().
+   * @param stream Connection stream
+   * @param protocol The subprotocol to send to the client
+   * @param deflate Compression to accept
+   */
+  std::shared_ptr<WebSocket> Accept(uv::Stream& stream,
+                                    std::string_view protocol,
+                                    const WebSocket::DeflateOptions& deflate) {
+    return WebSocket::CreateServer(stream, m_key, m_version, protocol,
+                                   m_extensions, deflate);
+  }
+
   bool IsUpgrade() const { return m_gotHost && m_websocket; }
 
   /**
@@ -93,6 +108,7 @@ class WebSocketServerHelper {
   SmallVector<std::string, 2> m_protocols;
   SmallString<64> m_key;
   SmallString<16> m_version;
+  SmallString<64> m_extensions;
 };
 
 /**
@@ -117,6 +133,11 @@ class WebSocketServer : public std::enable_shared_from_this<WebSocketServer> {
      * default all hosts are accepted.
      */
     std::function<bool(std::string_view)> checkHost;
+
+    /**
+     * Compression to accept.  By default messages are not compressed.
+     */
+    WebSocket::DeflateOptions deflate;
   };
 
   /**
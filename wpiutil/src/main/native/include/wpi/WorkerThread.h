@@ -147,7 +147,6 @@ void WorkerThreadThread<R, T...>::Main() {
       RunWorkerThreadRequest(*this, req);
     }
     requests.clear();
-    m_promises.Notify();
   }
 }
 
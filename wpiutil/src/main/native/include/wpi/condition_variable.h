@@ -10,7 +10,10 @@
 
 namespace wpi {
 
-#if defined(__linux__) && defined(WPI_HAVE_PRIORITY_MUTEX)
+#if defined(WPI_USE_PRIORITY_MUTEX) && defined(WPI_HAVE_PRIORITY_MUTEX)
+// instrumented locks get a plain wakeup
+using condition_variable = priority_condition_variable;
+#elif defined(WPI_INSTRUMENT_LOCKS)
 using condition_variable = ::std::condition_variable_any;
 #else
 using condition_variable = ::std::condition_variable;
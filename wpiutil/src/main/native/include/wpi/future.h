@@ -11,10 +11,13 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "wpi/DenseMap.h"
+#include "wpi/FunctionExtras.h"
 #include "wpi/condition_variable.h"
 #include "wpi/mutex.h"
 
@@ -41,24 +44,37 @@ class PromiseFactoryBase {
 
   wpi::mutex& GetResultMutex() { return m_resultMutex; }
 
-  void Notify() { m_resultCv.notify_all(); }
+  // Wakes every waiting thread.  Completing a request (EraseRequest()) wakes
+  // the threads waiting for it, so this is rarely needed.
+  void Notify();
 
+  // Waits until request completes or the factory is destroyed; may also
+  // return spuriously.  Only threads waiting for request are woken.
   // must be called with locked lock == ResultMutex
-  void Wait(std::unique_lock<wpi::mutex>& lock) { m_resultCv.wait(lock); }
+  void Wait(std::unique_lock<wpi::mutex>& lock, uint64_t request) {
+    Waiter waiter;
+    AddWaiter(request, &waiter);
+    waiter.cv.wait(lock);
+    RemoveWaiter(request, &waiter);
+  }
 
   // returns false if timeout reached
   template <class Clock, class Duration>
-  bool WaitUntil(std::unique_lock<wpi::mutex>& lock,
+  bool WaitUntil(std::unique_lock<wpi::mutex>& lock, uint64_t request,
                  const std::chrono::time_point<Clock, Duration>& timeout_time) {
-    return m_resultCv.wait_until(lock, timeout_time) ==
-           std::cv_status::no_timeout;
+    Waiter waiter;
+    AddWaiter(request, &waiter);
+    bool rv =
+        waiter.cv.wait_until(lock, timeout_time) == std::cv_status::no_timeout;
+    RemoveWaiter(request, &waiter);
+    return rv;
   }
 
   void IgnoreResult(uint64_t request);
 
   uint64_t CreateRequest();
 
-  // returns true if request was pending
+  // returns true if request was pending, and wakes its waiters
   // must be called with ResultMutex held
   bool EraseRequest(uint64_t request);
 
@@ -67,12 +83,24 @@ class PromiseFactoryBase {
   uint64_t CreateErasedRequest() { return ++m_uid; }
 
  private:
+  // A thread blocked on one request, linked into the request's list
+  struct Waiter {
+    wpi::condition_variable cv;
+    Waiter* next = nullptr;
+  };
+
+  void AddWaiter(uint64_t request, Waiter* waiter);
+  void RemoveWaiter(uint64_t request, Waiter* waiter);
+
   wpi::mutex m_resultMutex;
   std::atomic_bool m_active{true};
-  wpi::condition_variable m_resultCv;
 
   uint64_t m_uid = 0;
-  std::vector<uint64_t> m_requests;
+  // pending requests and the threads waiting for each
+  wpi::DenseMap<uint64_t, Waiter*> m_requests;
+  // threads waiting for a request that isn't pending (so will never
+  // complete); only woken by Notify()
+  Waiter* m_orphans = nullptr;
 };
 
 template <typename To, typename From>
@@ -105,6 +133,16 @@ struct FutureThen<void, void> {
                              F&& func);
 };
 
+// then() with an executor
+template <typename To, typename From, typename Executor, typename F>
+future<To> FutureThenOn(PromiseFactory<From>& fromFactory, uint64_t request,
+                        Executor& executor, F func);
+
+// detects an executor: a type with Post(wpi::unique_function<void()>)
+template <typename Executor>
+using ExecutorPost = decltype(std::declval<Executor&>().Post(
+    std::declval<unique_function<void()>>()));
+
 }  // namespace detail
 
 /**
@@ -182,15 +220,14 @@ class PromiseFactory final : public detail::PromiseFactoryBase {
 
  private:
   struct Then {
-    Then(uint64_t request_, uint64_t outRequest_, ThenFunction func_)
-        : request(request_), outRequest(outRequest_), func(std::move(func_)) {}
-    uint64_t request;
+    Then(uint64_t outRequest_, ThenFunction func_)
+        : outRequest(outRequest_), func(std::move(func_)) {}
     uint64_t outRequest;
     ThenFunction func;
   };
 
-  std::vector<Then> m_thens;
-  std::vector<std::pair<uint64_t, T>> m_results;
+  wpi::DenseMap<uint64_t, Then> m_thens;
+  wpi::DenseMap<uint64_t, T> m_results;
 };
 
 /**
@@ -249,15 +286,15 @@ class PromiseFactory<void> final : public detail::PromiseFactoryBase {
 
  private:
   struct Then {
-    Then(uint64_t request_, uint64_t outRequest_, ThenFunction func_)
-        : request(request_), outRequest(outRequest_), func(std::move(func_)) {}
-    uint64_t request;
+    Then(uint64_t outRequest_, ThenFunction func_)
+        : outRequest(outRequest_), func(std::move(func_)) {}
     uint64_t outRequest;
     ThenFunction func;
   };
 
-  std::vector<Then> m_thens;
-  std::vector<uint64_t> m_results;
+  wpi::DenseMap<uint64_t, Then> m_thens;
+  // completed requests (the value is unused)
+  wpi::DenseMap<uint64_t, bool> m_results;
 };
 
 /**
@@ -339,6 +376,30 @@ class future final {
     return then(PromiseFactory<R>::GetInstance(), std::forward<F>(func));
   }
 
+  /**
+   * Calls func with the value once it is available, by queueing it to
+   * executor (with executor.Post()) rather than calling it on the thread
+   * that sets the value.  Invalidates this future.
+   *
+   * @param executor where func is run, for example a wpi::ThreadPool; must
+   *                 outlive this future's promise
+   * @param func function to call with the value
+   * @return a future for the result of func
+   */
+  template <typename Executor, typename F,
+            typename R = typename std::result_of<F && (T &&)>::type,
+            typename = detail::ExecutorPost<Executor>>
+  future<R> then(Executor& executor, F&& func) {
+    if (m_promises) {
+      auto promises = m_promises;
+      m_promises = nullptr;
+      return detail::FutureThenOn<R>(*promises, m_request, executor,
+                                     std::forward<F>(func));
+    } else {
+      return future<R>();
+    }
+  }
+
   bool is_ready() const noexcept {
     return m_promises && m_promises->IsReady(m_request);
   }
@@ -462,6 +523,30 @@ class future<void> final {
     return then(PromiseFactory<R>::GetInstance(), std::forward<F>(func));
   }
 
+  /**
+   * Calls func once the value is set, by queueing it to executor (with
+   * executor.Post()) rather than calling it on the thread that sets the
+   * value.  Invalidates this future.
+   *
+   * @param executor where func is run, for example a wpi::ThreadPool; must
+   *                 outlive this future's promise
+   * @param func function to call
+   * @return a future for the result of func
+   */
+  template <typename Executor, typename F,
+            typename R = typename std::result_of<F && ()>::type,
+            typename = detail::ExecutorPost<Executor>>
+  future<R> then(Executor& executor, F&& func) {
+    if (m_promises) {
+      auto promises = m_promises;
+      m_promises = nullptr;
+      return detail::FutureThenOn<R>(*promises, m_request, executor,
+                                     std::forward<F>(func));
+    } else {
+      return future<R>();
+    }
+  }
+
   bool is_ready() const noexcept {
     return m_promises && m_promises->IsReady(m_request);
   }
@@ -715,8 +800,7 @@ template <typename T>
 future<T> PromiseFactory<T>::MakeReadyFuture(T&& value) {
   std::unique_lock lock(GetResultMutex());
   uint64_t req = CreateErasedRequest();
-  m_results.emplace_back(std::piecewise_construct, std::forward_as_tuple(req),
-                         std::forward_as_tuple(std::move(value)));
+  m_results.try_emplace(req, std::move(value));
   return future<T>{this, req};
 }
 
@@ -727,23 +811,7 @@ inline promise<T> PromiseFactory<T>::CreatePromise(uint64_t request) {
 
 template <typename T>
 void PromiseFactory<T>::SetValue(uint64_t request, const T& value) {
-  std::unique_lock lock(GetResultMutex());
-  if (!EraseRequest(request)) {
-    return;
-  }
-  auto it = std::find_if(m_thens.begin(), m_thens.end(),
-                         [=](const auto& x) { return x.request == request; });
-  if (it != m_thens.end()) {
-    uint64_t outRequest = it->outRequest;
-    ThenFunction func = std::move(it->func);
-    m_thens.erase(it);
-    lock.unlock();
-    return func(outRequest, value);
-  }
-  m_results.emplace_back(std::piecewise_construct,
-                         std::forward_as_tuple(request),
-                         std::forward_as_tuple(value));
-  Notify();
+  SetValue(request, T(value));
 }
 
 template <typename T>
@@ -752,42 +820,35 @@ void PromiseFactory<T>::SetValue(uint64_t request, T&& value) {
   if (!EraseRequest(request)) {
     return;
   }
-  auto it = std::find_if(m_thens.begin(), m_thens.end(),
-                         [=](const auto& x) { return x.request == request; });
+  auto it = m_thens.find(request);
   if (it != m_thens.end()) {
-    uint64_t outRequest = it->outRequest;
-    ThenFunction func = std::move(it->func);
+    uint64_t outRequest = it->second.outRequest;
+    ThenFunction func = std::move(it->second.func);
     m_thens.erase(it);
     lock.unlock();
     return func(outRequest, std::move(value));
   }
-  m_results.emplace_back(std::piecewise_construct,
-                         std::forward_as_tuple(request),
-                         std::forward_as_tuple(std::move(value)));
-  Notify();
+  m_results.try_emplace(request, std::move(value));
 }
 
 template <typename T>
 void PromiseFactory<T>::SetThen(uint64_t request, uint64_t outRequest,
                                 ThenFunction func) {
   std::unique_lock lock(GetResultMutex());
-  auto it = std::find_if(m_results.begin(), m_results.end(),
-                         [=](const auto& r) { return r.first == request; });
+  auto it = m_results.find(request);
   if (it != m_results.end()) {
     auto val = std::move(it->second);
     m_results.erase(it);
     lock.unlock();
     return func(outRequest, std::move(val));
   }
-  m_thens.emplace_back(request, outRequest, func);
+  m_thens.try_emplace(request, outRequest, std::move(func));
 }
 
 template <typename T>
 bool PromiseFactory<T>::IsReady(uint64_t request) noexcept {
   std::unique_lock lock(GetResultMutex());
-  auto it = std::find_if(m_results.begin(), m_results.end(),
-                         [=](const auto& r) { return r.first == request; });
-  return it != m_results.end();
+  return m_results.count(request) != 0;
 }
 
 template <typename T>
@@ -796,16 +857,15 @@ T PromiseFactory<T>::GetResult(uint64_t request) {
   std::unique_lock lock(GetResultMutex());
   while (IsActive()) {
     // Did we get a response to *our* request?
-    auto it = std::find_if(m_results.begin(), m_results.end(),
-                           [=](const auto& r) { return r.first == request; });
+    auto it = m_results.find(request);
     if (it != m_results.end()) {
-      // Yes, remove it from the vector and we're done.
+      // Yes, remove it and we're done.
       auto rv = std::move(it->second);
       m_results.erase(it);
       return rv;
     }
     // No, keep waiting for a response
-    Wait(lock);
+    Wait(lock, request);
   }
   return T();
 }
@@ -816,13 +876,11 @@ void PromiseFactory<T>::WaitResult(uint64_t request) {
   std::unique_lock lock(GetResultMutex());
   while (IsActive()) {
     // Did we get a response to *our* request?
-    auto it = std::find_if(m_results.begin(), m_results.end(),
-                           [=](const auto& r) { return r.first == request; });
-    if (it != m_results.end()) {
+    if (m_results.count(request) != 0) {
       return;
     }
     // No, keep waiting for a response
-    Wait(lock);
+    Wait(lock, request);
   }
 }
 
@@ -835,16 +893,14 @@ bool PromiseFactory<T>::WaitResultUntil(
   bool timeout = false;
   while (IsActive()) {
     // Did we get a response to *our* request?
-    auto it = std::find_if(m_results.begin(), m_results.end(),
-                           [=](const auto& r) { return r.first == request; });
-    if (it != m_results.end()) {
+    if (m_results.count(request) != 0) {
       return true;
     }
     if (timeout) {
       break;
     }
     // No, keep waiting for a response
-    if (!WaitUntil(lock, timeout_time)) {
+    if (!WaitUntil(lock, request, timeout_time)) {
       timeout = true;
     }
   }
@@ -873,16 +929,14 @@ bool PromiseFactory<void>::WaitResultUntil(
   bool timeout = false;
   while (IsActive()) {
     // Did we get a response to *our* request?
-    auto it = std::find_if(m_results.begin(), m_results.end(),
-                           [=](const auto& r) { return r == request; });
-    if (it != m_results.end()) {
+    if (m_results.count(request) != 0) {
       return true;
     }
     if (timeout) {
       break;
     }
     // No, keep waiting for a response
-    if (!WaitUntil(lock, timeout_time)) {
+    if (!WaitUntil(lock, request, timeout_time)) {
       timeout = true;
     }
   }
@@ -938,6 +992,134 @@ future<void> detail::FutureThen<void, void>::Create(
   return factory.CreateFuture(req);
 }
 
+namespace detail {
+
+template <typename To, typename F, typename... V>
+void CompleteThen(PromiseFactory<To>& factory, uint64_t request, F& func,
+                  V&&... value) {
+  if constexpr (std::is_void_v<To>) {
+    func(std::forward<V>(value)...);
+    factory.SetValue(request);
+  } else {
+    factory.SetValue(request, func(std::forward<V>(value)...));
+  }
+}
+
+template <typename To, typename From, typename Executor, typename F>
+future<To> FutureThenOn(PromiseFactory<From>& fromFactory, uint64_t request,
+                        Executor& executor, F func) {
+  auto& factory = PromiseFactory<To>::GetInstance();
+  uint64_t req = factory.CreateRequest();
+  if constexpr (std::is_void_v<From>) {
+    fromFactory.SetThen(request, req, [&factory, &executor, func](uint64_t r) {
+      executor.Post([&factory, func, r]() mutable {
+        CompleteThen<To>(factory, r, func);
+      });
+    });
+  } else {
+    fromFactory.SetThen(
+        request, req, [&factory, &executor, func](uint64_t r, From value) {
+          executor.Post(
+              [&factory, func, r, value = std::move(value)]() mutable {
+                CompleteThen<To>(factory, r, func, std::move(value));
+              });
+        });
+  }
+  return factory.CreateFuture(req);
+}
+
+}  // namespace detail
+
+/**
+ * Creates a future that is ready once all the given futures are, with their
+ * values in the same order.  An invalid future counts as ready with a
+ * default-constructed value.
+ *
+ * @param futures the futures; they are invalidated
+ * @return a future for the values
+ */
+template <typename T>
+future<std::vector<T>> when_all(std::vector<future<T>> futures) {
+  struct State {
+    std::vector<T> values;
+    std::atomic<size_t> remaining;
+    promise<std::vector<T>> result;
+  };
+  auto state = std::make_shared<State>();
+  state->values.resize(futures.size());
+  // one more than the futures, so it can't complete while hooking them up
+  state->remaining = futures.size() + 1;
+  auto finish = [](State& s) {
+    if (--s.remaining == 0) {
+      s.result.set_value(std::move(s.values));
+    }
+  };
+  auto result = state->result.get_future();
+  for (size_t i = 0; i < futures.size(); ++i) {
+    if (!futures[i].valid()) {
+      finish(*state);
+    } else {
+      futures[i].then([state, i, finish](T value) {
+        state->values[i] = std::move(value);
+        finish(*state);
+      });
+    }
+  }
+  finish(*state);
+  return result;
+}
+
+/**
+ * Creates a future that is ready once all the given futures are.
+ *
+ * @param futures the futures; they are invalidated
+ * @return the future
+ */
+future<void> when_all(std::vector<future<void>> futures);
+
+/**
+ * Creates a future that is ready once any of the given futures is, with the
+ * index and value of the first one to be ready.  An invalid future counts as
+ * ready with a default-constructed value; if there are no futures, the
+ * result is {0, T()}.
+ *
+ * @param futures the futures; they are invalidated
+ * @return a future for the index and value
+ */
+template <typename T>
+future<std::pair<size_t, T>> when_any(std::vector<future<T>> futures) {
+  struct State {
+    std::atomic_bool done{false};
+    promise<std::pair<size_t, T>> result;
+  };
+  auto state = std::make_shared<State>();
+  auto result = state->result.get_future();
+  for (size_t i = 0; i < futures.size(); ++i) {
+    if (!futures[i].valid()) {
+      if (!state->done.exchange(true)) {
+        state->result.set_value({i, T()});
+      }
+    } else {
+      futures[i].then([state, i](T value) {
+        if (!state->done.exchange(true)) {
+          state->result.set_value({i, std::move(value)});
+        }
+      });
+    }
+  }
+  return result;
+}
+
+/**
+ * Creates a future that is ready once any of the given futures is, with the
+ * index of the first one to be ready.  An invalid future counts as ready; if
+ * there are no futures, the result is 0.
+ *
+ * @param futures the futures; they are invalidated
+ * @return a future for the index
+ */
+future<size_t> when_any(std::vector<future<void>> futures);
+
 }  // namespace wpi
 
 #endif  // WPIUTIL_WPI_FUTURE_H_
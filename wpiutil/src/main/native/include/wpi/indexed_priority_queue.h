@@ -0,0 +1,212 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_INDEXED_PRIORITY_QUEUE_H_
+#define WPIUTIL_WPI_INDEXED_PRIORITY_QUEUE_H_
+
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "wpi/DenseMap.h"
+
+namespace wpi {
+
+/**
+ * A priority queue of unique keys, each with a priority that can be changed
+ * or removed by key.  Like std::priority_queue, top() is the key with the
+ * greatest priority according to Compare (use std::greater for the
+ * smallest, e.g. the earliest of a set of timer expirations).
+ *
+ * push(), pop() and remove() take O(log n) time; top(), contains() and
+ * size() take O(1).  for_each_top() takes time proportional to the number of
+ * keys it visits.  The position of each key in the heap is kept in a
+ * DenseMap, so Key must be usable as a DenseMap key.
+ */
+template <typename Key, typename Priority,
+          typename Compare = std::less<Priority>>
+class indexed_priority_queue {
+ public:
+  using value_type = std::pair<Key, Priority>;
+  using size_type = size_t;
+
+  indexed_priority_queue() = default;
+  explicit indexed_priority_queue(const Compare& comp) : m_comp(comp) {}
+
+  [[nodiscard]] bool empty() const { return m_heap.empty(); }
+
+  size_type size() const { return m_heap.size(); }
+
+  /**
+   * Returns the key with the greatest priority and its priority.  The queue
+   * must not be empty.
+   */
+  const value_type& top() const { return m_heap.front(); }
+
+  /**
+   * Calls func(key, priority) for every key whose priority is not less than
+   * bound according to Compare, e.g. every timer that has expired by bound
+   * with std::greater.  Keys are visited in heap order, not sorted; only the
+   * visited part of the heap is walked, so this takes O(k) time for k keys.
+   * func must not modify the queue.
+   *
+   * @param bound the lowest priority to visit
+   * @param func the function to call
+   */
+  template <typename F>
+  void for_each_top(const Priority& bound, F&& func) const {
+    if (!m_heap.empty()) {
+      VisitTop(0, bound, func);
+    }
+  }
+
+  /**
+   * Returns whether a key is in the queue.
+   */
+  bool contains(const Key& key) const { return m_index.count(key) != 0; }
+
+  /**
+   * Inserts a key, or changes its priority if it is already in the queue.
+   *
+   * @param key the key
+   * @param priority its priority
+   */
+  void push(const Key& key, Priority priority) {
+    auto [it, inserted] = m_index.try_emplace(key, m_heap.size());
+    if (inserted) {
+      m_heap.emplace_back(key, std::move(priority));
+      SiftUp(m_heap.size() - 1);
+      return;
+    }
+    size_type pos = it->second;
+    bool up = m_comp(m_heap[pos].second, priority);
+    m_heap[pos].second = std::move(priority);
+    if (up) {
+      SiftUp(pos);
+    } else {
+      SiftDown(pos);
+    }
+  }
+
+  /**
+   * Removes the key with the greatest priority and returns it with its
+   * priority.  The queue must not be empty.
+   */
+  value_type pop() {
+    assert(!m_heap.empty());
+    value_type ret = std::move(m_heap.front());
+    RemoveAt(0);
+    m_index.erase(ret.first);
+    return ret;
+  }
+
+  /**
+   * Removes a key.
+   *
+   * @param key the key
+   * @return false if the key was not in the queue
+   */
+  bool remove(const Key& key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+      return false;
+    }
+    size_type pos = it->second;
+    m_index.erase(it);
+    RemoveAt(pos);
+    return true;
+  }
+
+  /**
+   * Removes all keys.
+   */
+  void clear() {
+    m_heap.clear();
+    m_index.clear();
+  }
+
+ private:
+  template <typename F>
+  void VisitTop(size_type pos, const Priority& bound, F& func) const {
+    // Children never have a greater priority than their parent, so a subtree
+    // whose root is below the bound is skipped entirely
+    if (m_comp(m_heap[pos].second, bound)) {
+      return;
+    }
+    func(m_heap[pos].first, m_heap[pos].second);
+    size_type child = 2 * pos + 1;
+    if (child < m_heap.size()) {
+      VisitTop(child, bound, func);
+    }
+    if (child + 1 < m_heap.size()) {
+      VisitTop(child + 1, bound, func);
+    }
+  }
+
+  // Moves the last element into pos and restores the heap; doesn't touch
+  // the index entry of the element previously at pos
+  void RemoveAt(size_type pos) {
+    size_type last = m_heap.size() - 1;
+    if (pos != last) {
+      bool up = m_comp(m_heap[pos].second, m_heap[last].second);
+      Place(pos, std::move(m_heap[last]));
+      m_heap.pop_back();
+      if (up) {
+        SiftUp(pos);
+      } else {
+        SiftDown(pos);
+      }
+    } else {
+      m_heap.pop_back();
+    }
+  }
+
+  void Place(size_type pos, value_type&& value) {
+    m_index[value.first] = pos;
+    m_heap[pos] = std::move(value);
+  }
+
+  void SiftUp(size_type pos) {
+    value_type value = std::move(m_heap[pos]);
+    while (pos > 0) {
+      size_type parent = (pos - 1) / 2;
+      if (!m_comp(m_heap[parent].second, value.second)) {
+        break;
+      }
+      Place(pos, std::move(m_heap[parent]));
+      pos = parent;
+    }
+    Place(pos, std::move(value));
+  }
+
+  void SiftDown(size_type pos) {
+    size_type size = m_heap.size();
+    value_type value = std::move(m_heap[pos]);
+    for (;;) {
+      size_type child = 2 * pos + 1;
+      if (child >= size) {
+        break;
+      }
+      if (child + 1 < size &&
+          m_comp(m_heap[child].second, m_heap[child + 1].second)) {
+        ++child;
+      }
+      if (!m_comp(value.second, m_heap[child].second)) {
+        break;
+      }
+      Place(pos, std::move(m_heap[child]));
+      pos = child;
+    }
+    Place(pos, std::move(value));
+  }
+
+  std::vector<value_type> m_heap;
+  DenseMap<Key, size_type> m_index;
+  Compare m_comp;
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_INDEXED_PRIORITY_QUEUE_H_
@@ -2590,6 +2590,63 @@ struct adl_serializer
     }
 };
 
+/*!
+@brief SAX interface
+
+Reports the contents of a JSON text as a sequence of events rather than
+building a @ref json value; see @ref json::sax_parse.  Each function returns
+whether to continue parsing.  String values and keys are only valid for the
+duration of the call.
+*/
+class json_sax
+{
+  public:
+    virtual ~json_sax() = default;
+
+    /// a null value was read
+    virtual bool null() = 0;
+
+    /// a boolean value was read
+    virtual bool boolean(bool val) = 0;
+
+    /// a negative integer number was read
+    virtual bool number_integer(int64_t val) = 0;
+
+    /// a nonnegative integer number was read
+    virtual bool number_unsigned(uint64_t val) = 0;
+
+    /// a floating-point number was read
+    virtual bool number_float(double val) = 0;
+
+    /// a string value was read
+    virtual bool string(std::string_view val) = 0;
+
+    /// the beginning of an object was read
+    virtual bool start_object() = 0;
+
+    /// an object key was read
+    virtual bool key(std::string_view val) = 0;
+
+    /// the end of an object was read
+    virtual bool end_object() = 0;
+
+    /// the beginning of an array was read
+    virtual bool start_array() = 0;
+
+    /// the end of an array was read
+    virtual bool end_array() = 0;
+
+    /*!
+    @brief a parse error occurred; no further events are reported
+
+    @param[in] position  the position in the input where the error occurred
+    @param[in] ex        an exception object describing the error
+    @return the value @ref json::sax_parse should return
+    */
+    virtual bool parse_error(std::size_t position,
+                             const detail::exception& ex) = 0;
+};
+
 /*!
 @brief a class to store JSON values
 
@@ -2678,6 +2735,7 @@ class json
     class binary_writer;
     class lexer;
     class parser;
+    class pull_parser_impl;
     class serializer;
 
   public:
@@ -7058,6 +7116,142 @@ class json
     */
     friend raw_istream& operator>>(raw_istream& i, json& j);
 
+    /*!
+    @brief parse input, reporting it to a SAX handler
+
+    Reads a JSON text as @ref parse does, but calls @a sax for each value
+    instead of building a @ref json value, so memory use is bounded by the
+    nesting depth and the longest string rather than the size of the input.
+
+    @param[in] i       input to read from
+    @param[in] sax     handler to report events to
+    @param[in] strict  whether the input must be consumed completely
+
+    @return false if the handler stopped parsing, the result of
+    json_sax::parse_error if a parse error occurred, true otherwise
+
+    @complexity Linear in the length of the input.
+
+    @note A UTF-8 byte order mark is silently ignored.
+    */
+    static bool sax_parse(raw_istream& i, json_sax* sax,
+                          const bool strict = true);
+
+    static bool sax_parse(std::string_view s, json_sax* sax,
+                          const bool strict = true);
+
+    static bool sax_parse(span<const uint8_t> arr, json_sax* sax,
+                          const bool strict = true);
+
+    /*!
+    @brief pull parser
+
+    Reads a JSON text one event at a time, at the pace of the caller.  This
+    makes it possible to stream through a large document (e.g. the elements
+    of a top-level array) while building only the parts of interest with
+    get_value() and skipping the rest with skip_value().
+
+    Errors are reported by throwing the same exceptions as @ref parse.
+
+    @code
+    json::pull_parser p(is);
+    if (p.next() == json::pull_parser::event_t::start_array)
+    {
+        while (p.next() != json::pull_parser::event_t::end_array)
+        {
+            json element = p.get_value();
+            ...
+        }
+    }
+    @endcode
+    */
+    class pull_parser
+    {
+      public:
+        /// the events reported by next()
+        enum class event_t : uint8_t
+        {
+            null,             ///< a null value
+            boolean,          ///< a boolean value -- use get_boolean()
+            number_integer,   ///< a negative integer -- use get_number_integer()
+            number_unsigned,  ///< a nonnegative integer -- use get_number_unsigned()
+            number_float,     ///< a floating-point number -- use get_number_float()
+            string,           ///< a string value -- use get_string()
+            start_object,     ///< the beginning of an object `{`
+            key,              ///< an object key -- use get_string()
+            end_object,       ///< the end of an object `}`
+            start_array,      ///< the beginning of an array `[`
+            end_array,        ///< the end of an array `]`
+            end_of_input      ///< the value (and in strict mode, the input) ended
+        };
+
+        /*!
+        @param[in] i       input to read from; must outlive the parser
+        @param[in] strict  whether the input must end after the value
+        */
+        explicit pull_parser(raw_istream& i, const bool strict = true);
+        ~pull_parser();
+
+        pull_parser(const pull_parser&) = delete;
+        pull_parser& operator=(const pull_parser&) = delete;
+
+        /*!
+        @brief read the next event
+
+        Once the value has ended, returns event_t::end_of_input forever.
+
+        @throw parse_error.101 in case of an unexpected token
+        @throw parse_error.102 if to_unicode fails or surrogate error
+        @throw parse_error.103 if to_unicode fails
+        @throw out_of_range.406 if a number is out of range
+        */
+        event_t next();
+
+        /// the last event returned by next()
+        event_t event() const noexcept;
+
+        /// the number of objects and arrays currently open
+        std::size_t depth() const noexcept;
+
+        /// the value of a boolean event
+        bool get_boolean() const noexcept;
+
+        /// the value of a number_integer event
+        int64_t get_number_integer() const noexcept;
+
+        /// the value of a number_unsigned event
+        uint64_t get_number_unsigned() const noexcept;
+
+        /// the value of a number_float event
+        double get_number_float() const noexcept;
+
+        /// the value of a string or key event; valid until the next call
+        std::string_view get_string() const noexcept;
+
+        /*!
+        @brief build the value the last event started
+
+        If the last event was a value, returns it.  If it was the start of an
+        object or array, reads up to its end and returns it as a whole.  If
+        it was a key, reads and returns the key's value.
+
+        @throw the exceptions of next()
+        */
+        json get_value();
+
+        /*!
+        @brief skip the value the last event started
+
+        Like get_value(), but without building the value.
+
+        @throw the exceptions of next()
+        */
+        void skip_value();
+
+      private:
+        std::unique_ptr<pull_parser_impl> m_impl;
+    };
+
     /// @}
 
     ///////////////////////////
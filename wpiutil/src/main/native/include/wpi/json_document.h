@@ -0,0 +1,263 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "wpi/StringMap.h"
+#include "wpi/json.h"
+#include "wpi/span.h"
+
+namespace wpi {
+
+class raw_istream;
+
+/**
+ * A read-only JSON document whose values, strings, and arrays all live in a
+ * bump arena owned by the document.
+ *
+ * Parsing into a document resets the arena and reuses its memory, so a
+ * document kept for a stream of small messages (e.g. one per WebSocket
+ * connection) stops allocating once it has seen the largest message.  Object
+ * keys are interned in a table kept across parses and stored as views, as
+ * such messages usually share a small set of keys.
+ *
+ * Values (and the views they return) are only valid until the next parse or
+ * clear().  Unlike json, objects keep their members in input order; as in
+ * json, only the first of duplicate keys is found.
+ */
+class json_document {
+ public:
+  using value_t = json::value_t;
+
+  struct member;
+
+  /**
+   * A value in the document.  The accessors throw the same exceptions as the
+   * equivalent json functions.
+   */
+  class value {
+   public:
+    value_t type() const { return m_type; }
+    const char* type_name() const;
+
+    bool is_null() const { return m_type == value_t::null; }
+    bool is_boolean() const { return m_type == value_t::boolean; }
+    bool is_number() const {
+      return m_type == value_t::number_integer ||
+             m_type == value_t::number_unsigned ||
+             m_type == value_t::number_float;
+    }
+    bool is_string() const { return m_type == value_t::string; }
+    bool is_object() const { return m_type == value_t::object; }
+    bool is_array() const { return m_type == value_t::array; }
+
+    /**
+     * Gets the number of array elements or object members; as in json, null
+     * has size 0 and other values size 1.
+     */
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Gets a boolean value.
+     *
+     * @throw type_error.302 if not a boolean
+     */
+    bool get_boolean() const;
+
+    /**
+     * Gets any number as a double.  As with json, a boolean converts to 0 or
+     * 1.
+     *
+     * @throw type_error.302 if not a number or boolean
+     */
+    double get_double() const;
+
+    /**
+     * Gets any number as an integer; a floating-point one is truncated.  As
+     * with json, a boolean converts to 0 or 1.
+     *
+     * @throw type_error.302 if not a number or boolean
+     */
+    int64_t get_int64() const;
+
+    /**
+     * Gets a string value.  The string is also null-terminated.
+     *
+     * @throw type_error.302 if not a string
+     */
+    std::string_view get_string() const;
+
+    /**
+     * Gets the value as T, converting as json::get<T>() does for bool,
+     * arithmetic types, and std::string_view.
+     */
+    template <typename T>
+    T get() const {
+      if constexpr (std::is_same_v<T, bool>) {
+        return get_boolean();
+      } else if constexpr (std::is_same_v<T, std::string_view>) {
+        return get_string();
+      } else if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(get_double());
+      } else {
+        static_assert(std::is_integral_v<T>, "unsupported type");
+        return static_cast<T>(get_int64());
+      }
+    }
+
+    /**
+     * Finds an object member.
+     *
+     * @return the member's value, or nullptr if there is no such member or
+     *         this is not an object
+     */
+    const value* find(std::string_view key) const;
+
+    /**
+     * Gets an object member.
+     *
+     * @throw type_error.304 if not an object
+     * @throw out_of_range.403 if there is no such member
+     */
+    const value& at(std::string_view key) const;
+
+    /**
+     * Gets an array element.
+     *
+     * @throw type_error.304 if not an array
+     * @throw out_of_range.401 if the index is out of range
+     */
+    const value& at(size_t idx) const;
+
+    /**
+     * Gets an array element without checking the type or range.
+     */
+    const value& operator[](size_t idx) const { return m_elements[idx]; }
+
+    /**
+     * Gets the elements of an array; empty if not an array.
+     */
+    span<const value> elements() const;
+
+    /**
+     * Gets the members of an object; empty if not an object.
+     */
+    span<const member> members() const;
+
+    /**
+     * Copies the value into a json value that outlives the document.
+     */
+    json to_json() const;
+
+   private:
+    friend class json_document;
+
+    [[noreturn]] void throw_type_error(const char* expected) const;
+
+    value_t m_type = value_t::null;
+    uint32_t m_size = 0;
+    union {
+      bool m_boolean;
+      int64_t m_integer = 0;
+      uint64_t m_unsigned;
+      double m_float;
+      const char* m_string;
+      const value* m_elements;
+      const member* m_members;
+    };
+  };
+
+  /**
+   * An object member.
+   */
+  struct member {
+    std::string_view key;
+    value val;
+  };
+
+  json_document() = default;
+  ~json_document();
+
+  json_document(const json_document&) = delete;
+  json_document& operator=(const json_document&) = delete;
+
+  /**
+   * Parses a JSON text, replacing the contents of the document.  On error
+   * the document is left empty (null).
+   *
+   * @throw parse_error.101 in case of a syntax error
+   * @throw out_of_range.406 if a number is out of range
+   */
+  void parse(std::string_view s);
+
+  /**
+   * Parses a JSON text from a stream, replacing the contents of the
+   * document.
+   *
+   * @param[in] is      input to read from
+   * @param[in] strict  whether the input must end after the value
+   */
+  void parse(raw_istream& is, bool strict = true);
+
+  /**
+   * Copies a json value, replacing the contents of the document.  This lets
+   * values decoded by other means (e.g. json::from_cbor()) be read the same
+   * way as parsed ones.
+   *
+   * @param[in] j  value to copy
+   */
+  void assign(const json& j);
+
+  /**
+   * Gets the top-level value.
+   */
+  const value& root() const { return m_root; }
+
+  /**
+   * Empties the document, keeping the arena memory for reuse.
+   */
+  void clear();
+
+  /**
+   * Gets the number of bytes allocated for the arena.
+   */
+  size_t arena_capacity() const { return m_capacity; }
+
+ private:
+  // An interned key's data is stable; a table entry is never moved
+  std::string_view intern(std::string_view key);
+  const char* copy_string(std::string_view str);
+  value copy_value(const json& j);
+  void* allocate(size_t size, size_t align);
+
+  value m_root;
+
+  std::vector<std::unique_ptr<char[]>> m_blocks;
+  char* m_cur = nullptr;
+  char* m_end = nullptr;
+  size_t m_blockSize = 0;  // size of the last block
+  size_t m_capacity = 0;   // total size of the blocks
+
+  StringMap<bool> m_keys;
+
+  // Scratch space for building containers, kept across parses; each open
+  // container's members are on the stack above its start
+  struct open_container {
+    size_t start;
+    std::string_view key;
+  };
+  std::vector<member> m_stack;
+  std::vector<open_container> m_open;
+};
+
+}  // namespace wpi
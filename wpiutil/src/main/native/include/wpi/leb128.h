@@ -8,6 +8,7 @@
 #include <cstddef>
 
 #include "wpi/SmallVector.h"
+#include "wpi/span.h"
 
 namespace wpi {
 
@@ -36,6 +37,17 @@ uint64_t SizeUleb128(uint64_t val);
  */
 uint64_t WriteUleb128(SmallVectorImpl<char>& dest, uint64_t val);
 
+/**
+ * Write a sequence of unsigned LEB128 data
+ * @dest: the buffer to append the ULEB128 data to
+ * @vals: values to be stored
+ *
+ * Encode each value as WriteUleb128() does, one after another, growing
+ * the buffer only once.  Return the number of bytes written.
+ */
+size_t WriteUleb128Array(SmallVectorImpl<char>& dest,
+                         span<const uint64_t> vals);
+
 /**
  * Read unsigned LEB128 data
  * @addr: the address where the ULEB128 data is stored
@@ -48,6 +60,28 @@ uint64_t WriteUleb128(SmallVectorImpl<char>& dest, uint64_t val);
  */
 uint64_t ReadUleb128(const char* addr, uint64_t* ret);
 
+/**
+ * Read unsigned LEB128 data from a buffer
+ * @buf: the buffer where the ULEB128 data is stored
+ * @ret: address to store the result
+ *
+ * Decode an unsigned LEB128 encoded datum, reading no further than the end
+ * of the buffer.  Return the number of bytes read, or 0 if the datum is
+ * not complete within the buffer (or longer than any 64-bit value).
+ */
+size_t ReadUleb128(span<const char> buf, uint64_t* ret);
+
+/**
+ * Read a sequence of unsigned LEB128 data from a buffer
+ * @buf: the buffer where the ULEB128 data is stored
+ * @vals: where to store the results; one datum is read per element
+ *
+ * Decode vals.size() consecutive unsigned LEB128 encoded data.  Return the
+ * number of bytes read, or 0 if they are not all complete within the
+ * buffer.
+ */
+size_t ReadUleb128Array(span<const char> buf, span<uint64_t> vals);
+
 /**
  * Read unsigned LEB128 data from a stream
  * @is: the input stream where the ULEB128 data is to be read from
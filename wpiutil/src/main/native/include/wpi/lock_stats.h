@@ -0,0 +1,200 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_LOCK_STATS_H_
+#define WPIUTIL_WPI_LOCK_STATS_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wpi {
+
+/**
+ * Number of buckets in LockStats::waitHistogram.
+ */
+inline constexpr size_t kLockWaitBuckets = 16;
+
+/**
+ * Statistics of the instrumented locks sharing a name.  Locks are only
+ * instrumented in builds with WPI_INSTRUMENT_LOCKS defined (the CMake
+ * USE_LOCK_INSTRUMENTATION option); this makes wpi::mutex,
+ * wpi::recursive_mutex and wpi::recursive_spinlock instrumented_mutex.
+ */
+struct LockStats {
+  /** Lock name, as given to SetLockName(); "(unnamed)" for the rest */
+  std::string name;
+
+  /** Number of times locked */
+  uint64_t acquisitions = 0;
+
+  /** Number of those that had to wait for another thread */
+  uint64_t contentions = 0;
+
+  /** Total and longest wait, in nanoseconds */
+  uint64_t totalWaitNs = 0;
+  uint64_t maxWaitNs = 0;
+
+  /** Longest time held (from outermost lock to unlock), in nanoseconds */
+  uint64_t maxHoldNs = 0;
+
+  /**
+   * Contended waits by length: bucket 0 counts waits under 1 us, bucket i
+   * those from 2^(i-1) to 2^i us, and the last bucket all longer ones.
+   */
+  std::array<uint64_t, kLockWaitBuckets> waitHistogram{};
+};
+
+/**
+ * Gets the statistics of all the named locks used so far.  Empty unless
+ * locks are instrumented.
+ *
+ * @return statistics, in order of first use
+ */
+std::vector<LockStats> GetLockStats();
+
+/**
+ * Clears the statistics of all locks.
+ */
+void ResetLockStats();
+
+namespace detail {
+
+struct LockStatsEntry {
+  explicit LockStatsEntry(std::string_view name) : name{name} {}
+
+  static uint64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  static void UpdateMax(std::atomic<uint64_t>& max, uint64_t val) {
+    uint64_t cur = max.load(std::memory_order_relaxed);
+    while (cur < val && !max.compare_exchange_weak(cur, val,
+                                                   std::memory_order_relaxed)) {
+    }
+  }
+
+  void RecordWait(uint64_t waitNs);
+
+  void RecordHold(uint64_t holdNs) { UpdateMax(maxHoldNs, holdNs); }
+
+  const std::string name;
+  std::atomic<uint64_t> acquisitions{0};
+  std::atomic<uint64_t> contentions{0};
+  std::atomic<uint64_t> totalWaitNs{0};
+  std::atomic<uint64_t> maxWaitNs{0};
+  std::atomic<uint64_t> maxHoldNs{0};
+  std::array<std::atomic<uint64_t>, kLockWaitBuckets> waitHistogram{};
+};
+
+// Returns the entry for a name, creating it on first use.  Entries are
+// never destroyed.
+LockStatsEntry* GetLockStatsEntry(std::string_view name);
+
+}  // namespace detail
+
+/**
+ * A mutex wrapper that records contention and hold times.  Locks sharing a
+ * name share statistics.
+ *
+ * @tparam Mutex the wrapped mutex type (may be recursive)
+ */
+template <typename Mutex>
+class instrumented_mutex {
+ public:
+  instrumented_mutex() = default;
+  instrumented_mutex(const instrumented_mutex&) = delete;
+  instrumented_mutex& operator=(const instrumented_mutex&) = delete;
+
+  void lock() {
+    auto stats = GetStats();
+    if (!m_mutex.try_lock()) {
+      uint64_t start = detail::LockStatsEntry::Now();
+      m_mutex.lock();
+      stats->RecordWait(detail::LockStatsEntry::Now() - start);
+    }
+    Acquired(stats);
+  }
+
+  bool try_lock() {
+    if (!m_mutex.try_lock()) {
+      return false;
+    }
+    Acquired(GetStats());
+    return true;
+  }
+
+  void unlock() {
+    if (--m_depth == 0) {
+      m_stats.load(std::memory_order_relaxed)
+          ->RecordHold(detail::LockStatsEntry::Now() - m_acquireTime);
+    }
+    m_mutex.unlock();
+  }
+
+  /**
+   * Sets the name the lock's statistics are kept under.
+   *
+   * @param name name
+   */
+  void set_name(std::string_view name) {
+    m_stats.store(detail::GetLockStatsEntry(name), std::memory_order_relaxed);
+  }
+
+ private:
+  detail::LockStatsEntry* GetStats() {
+    auto stats = m_stats.load(std::memory_order_relaxed);
+    if (!stats) {
+      stats = detail::GetLockStatsEntry("(unnamed)");
+      detail::LockStatsEntry* expected = nullptr;
+      // keep a name set meanwhile
+      if (!m_stats.compare_exchange_strong(expected, stats,
+                                           std::memory_order_relaxed)) {
+        stats = expected;
+      }
+    }
+    return stats;
+  }
+
+  void Acquired(detail::LockStatsEntry* stats) {
+    stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    // only the outermost lock of a recursive mutex starts the hold time
+    if (m_depth++ == 0) {
+      m_acquireTime = detail::LockStatsEntry::Now();
+    }
+  }
+
+  Mutex m_mutex;
+  std::atomic<detail::LockStatsEntry*> m_stats{nullptr};
+  // only touched by the owner
+  unsigned int m_depth = 0;
+  uint64_t m_acquireTime = 0;
+};
+
+/**
+ * Names a lock for its statistics.  Does nothing unless the lock is
+ * instrumented, so can always be called.
+ *
+ * @param lock lock
+ * @param name name
+ */
+template <typename Lock>
+void SetLockName(Lock& lock, std::string_view name) {}
+
+template <typename Mutex>
+void SetLockName(instrumented_mutex<Mutex>& lock, std::string_view name) {
+  lock.set_name(name);
+}
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_LOCK_STATS_H_
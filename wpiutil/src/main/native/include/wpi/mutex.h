@@ -8,11 +8,23 @@
 
 #include "priority_mutex.h"
 
+#ifdef WPI_INSTRUMENT_LOCKS
+#include "wpi/lock_stats.h"
+#endif
+
 namespace wpi {
 
-#ifdef WPI_HAVE_PRIORITY_MUTEX
+#if defined(WPI_USE_PRIORITY_MUTEX) && defined(WPI_HAVE_PRIORITY_MUTEX)
+#ifdef WPI_INSTRUMENT_LOCKS
+using mutex = instrumented_mutex<priority_mutex>;
+using recursive_mutex = instrumented_mutex<priority_recursive_mutex>;
+#else
 using mutex = priority_mutex;
 using recursive_mutex = priority_recursive_mutex;
+#endif
+#elif defined(WPI_INSTRUMENT_LOCKS)
+using mutex = instrumented_mutex<::std::mutex>;
+using recursive_mutex = instrumented_mutex<::std::recursive_mutex>;
 #else
 using mutex = ::std::mutex;
 using recursive_mutex = ::std::recursive_mutex;
@@ -4,82 +4,261 @@
 
 #pragma once
 
-// Allows usage with std::scoped_lock without including <mutex> separately
-#ifdef __linux__
-#include <pthread.h>
-#endif
+#include <stdint.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+// Allows usage with std::scoped_lock without including <mutex> separately
 #include <mutex>
+#include <utility>
 
 namespace wpi {
 
+// The priority mutexes are used for wpi::mutex on the roboRIO, or anywhere
+// WPI_USE_PRIORITY_MUTEX is defined (the CMake USE_PRIORITY_MUTEX option)
 #if defined(__FRC_ROBORIO__) && !defined(WPI_USE_PRIORITY_MUTEX)
 #define WPI_USE_PRIORITY_MUTEX
 #endif
 
-#if defined(WPI_USE_PRIORITY_MUTEX) && defined(__linux__)
+#ifdef __linux__
 
 #define WPI_HAVE_PRIORITY_MUTEX 1
 
+namespace detail {
+// Returns the kernel thread ID of the calling thread.
+uint32_t GetCurrentThreadTid();
+
+// The futex operations on the futex word of a priority mutex.
+void PriorityMutexLock(std::atomic<uint32_t>* word);
+void PriorityMutexUnlock(std::atomic<uint32_t>* word);
+
+// True if the futex word shows it's held by the calling thread.
+inline bool PriorityMutexIsOwner(const std::atomic<uint32_t>& word) {
+  // the low 30 bits hold the TID of the owner
+  return (word.load(std::memory_order_relaxed) & 0x3fffffff) ==
+         GetCurrentThreadTid();
+}
+}  // namespace detail
+
+/**
+ * A mutex with priority inheritance: while a thread is blocked on it, the
+ * holder runs at the blocked thread's priority if that is higher, so a low
+ * priority holder can't be starved by medium priority threads.
+ *
+ * Built directly on the kernel's PI futexes.  Locking and unlocking without
+ * contention are a single atomic operation.
+ */
+class priority_mutex {
+ public:
+  using native_handle_type = std::atomic<uint32_t>*;
+
+  constexpr priority_mutex() noexcept = default;
+  priority_mutex(const priority_mutex&) = delete;
+  priority_mutex& operator=(const priority_mutex&) = delete;
+
+  // Lock the mutex, blocking until it's available.  Throws std::system_error
+  // if the kernel refuses, as when the mutex is already held by this thread.
+  void lock() {
+    uint32_t expected = 0;
+    if (!m_word.compare_exchange_strong(expected, detail::GetCurrentThreadTid(),
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+      detail::PriorityMutexLock(&m_word);
+    }
+  }
+
+  // Unlock the mutex.
+  void unlock() {
+    uint32_t expected = detail::GetCurrentThreadTid();
+    if (!m_word.compare_exchange_strong(expected, 0, std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+      // there are waiters; the kernel hands the mutex to the highest priority
+      detail::PriorityMutexUnlock(&m_word);
+    }
+  }
+
+  // Tries to lock the mutex.
+  bool try_lock() noexcept {
+    uint32_t expected = 0;
+    return m_word.compare_exchange_strong(
+        expected, detail::GetCurrentThreadTid(), std::memory_order_acquire,
+        std::memory_order_relaxed);
+  }
+
+  // The futex word: 0 when unlocked, else the owner's TID and futex flags.
+  native_handle_type native_handle() { return &m_word; }
+
+ private:
+  std::atomic<uint32_t> m_word{0};
+};
+
+/**
+ * A recursive mutex with priority inheritance.
+ */
 class priority_recursive_mutex {
  public:
-  using native_handle_type = pthread_mutex_t*;
+  using native_handle_type = std::atomic<uint32_t>*;
 
   constexpr priority_recursive_mutex() noexcept = default;
   priority_recursive_mutex(const priority_recursive_mutex&) = delete;
   priority_recursive_mutex& operator=(const priority_recursive_mutex&) = delete;
 
   // Lock the mutex, blocking until it's available.
-  void lock() { pthread_mutex_lock(&m_mutex); }
+  void lock() {
+    if (detail::PriorityMutexIsOwner(*m_mutex.native_handle())) {
+      ++m_count;
+      return;
+    }
+    m_mutex.lock();
+    m_count = 1;
+  }
 
   // Unlock the mutex.
-  void unlock() { pthread_mutex_unlock(&m_mutex); }
+  void unlock() {
+    if (--m_count == 0) {
+      m_mutex.unlock();
+    }
+  }
 
   // Tries to lock the mutex.
-  bool try_lock() noexcept { return !pthread_mutex_trylock(&m_mutex); }
+  bool try_lock() noexcept {
+    if (detail::PriorityMutexIsOwner(*m_mutex.native_handle())) {
+      ++m_count;
+      return true;
+    }
+    if (!m_mutex.try_lock()) {
+      return false;
+    }
+    m_count = 1;
+    return true;
+  }
 
-  pthread_mutex_t* native_handle() { return &m_mutex; }
+  native_handle_type native_handle() { return m_mutex.native_handle(); }
 
  private:
-// Do the equivalent of setting PTHREAD_PRIO_INHERIT and
-// PTHREAD_MUTEX_RECURSIVE_NP.
-#ifdef __PTHREAD_MUTEX_HAVE_PREV
-  pthread_mutex_t m_mutex = {
-      {0, 0, 0, 0, 0x20 | PTHREAD_MUTEX_RECURSIVE_NP, __PTHREAD_SPINS, {0, 0}}};
-#else
-  pthread_mutex_t m_mutex = {
-      {0, 0, 0, 0x20 | PTHREAD_MUTEX_RECURSIVE_NP, 0, {__PTHREAD_SPINS}}};
-#endif
+  priority_mutex m_mutex;
+  // only touched by the owner
+  unsigned int m_count = 0;
 };
 
-class priority_mutex {
+/**
+ * A condition variable for priority_mutex which keeps priority inheritance
+ * across a wait: a notified waiter is moved straight onto the mutex by the
+ * kernel rather than woken to contend for it, so it can't wake at high
+ * priority only to block unboosted behind a lower priority holder.
+ *
+ * All the waiters of one condition variable must use the same mutex.  Other
+ * lock types work too, but only get a plain wakeup.
+ */
+class priority_condition_variable {
  public:
-  using native_handle_type = pthread_mutex_t*;
+  constexpr priority_condition_variable() noexcept = default;
+  priority_condition_variable(const priority_condition_variable&) = delete;
+  priority_condition_variable& operator=(const priority_condition_variable&) =
+      delete;
 
-  constexpr priority_mutex() noexcept = default;
-  priority_mutex(const priority_mutex&) = delete;
-  priority_mutex& operator=(const priority_mutex&) = delete;
+  void notify_one() noexcept { Notify(false); }
+  void notify_all() noexcept { Notify(true); }
 
-  // Lock the mutex, blocking until it's available.
-  void lock() { pthread_mutex_lock(&m_mutex); }
+  void wait(std::unique_lock<priority_mutex>& lock) {
+    WaitPi(*lock.mutex()->native_handle(), nullptr);
+  }
 
-  // Unlock the mutex.
-  void unlock() { pthread_mutex_unlock(&m_mutex); }
+  template <typename Lock>
+  void wait(Lock& lock) {
+    uint32_t seq = Prepare();
+    lock.unlock();
+    WaitPlain(seq, nullptr);
+    lock.lock();
+  }
 
-  // Tries to lock the mutex.
-  bool try_lock() noexcept { return !pthread_mutex_trylock(&m_mutex); }
+  template <typename Lock, typename Predicate>
+  void wait(Lock& lock, Predicate pred) {
+    while (!pred()) {
+      wait(lock);
+    }
+  }
+
+  template <typename Lock, typename Clock, typename Duration>
+  std::cv_status wait_until(
+      Lock& lock, const std::chrono::time_point<Clock, Duration>& timeout) {
+    // the futex timeout is on the steady clock; wake up to recheck others
+    auto now = Clock::now();
+    if (now >= timeout) {
+      return std::cv_status::timeout;
+    }
+    auto steadyTimeout =
+        std::chrono::steady_clock::now() +
+        std::chrono::ceil<std::chrono::steady_clock::duration>(timeout - now);
+    if (!WaitUntilSteady(lock, steadyTimeout)) {
+      return Clock::now() < timeout ? std::cv_status::no_timeout
+                                    : std::cv_status::timeout;
+    }
+    return std::cv_status::no_timeout;
+  }
+
+  template <typename Lock, typename Clock, typename Duration,
+            typename Predicate>
+  bool wait_until(Lock& lock,
+                  const std::chrono::time_point<Clock, Duration>& timeout,
+                  Predicate pred) {
+    while (!pred()) {
+      if (wait_until(lock, timeout) == std::cv_status::timeout) {
+        return pred();
+      }
+    }
+    return true;
+  }
+
+  template <typename Lock, typename Rep, typename Period>
+  std::cv_status wait_for(Lock& lock,
+                          const std::chrono::duration<Rep, Period>& duration) {
+    return wait_until(lock, std::chrono::steady_clock::now() + duration);
+  }
 
-  pthread_mutex_t* native_handle() { return &m_mutex; }
+  template <typename Lock, typename Rep, typename Period, typename Predicate>
+  bool wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& duration,
+                Predicate pred) {
+    return wait_until(lock, std::chrono::steady_clock::now() + duration,
+                      std::move(pred));
+  }
 
  private:
-// Do the equivalent of setting PTHREAD_PRIO_INHERIT.
-#ifdef __PTHREAD_MUTEX_HAVE_PREV
-  pthread_mutex_t m_mutex = {{0, 0, 0, 0, 0x20, __PTHREAD_SPINS, {0, 0}}};
-#else
-  pthread_mutex_t m_mutex = {{0, 0, 0, 0x20, 0, {__PTHREAD_SPINS}}};
-#endif
+  // Returns false on timeout
+  bool WaitUntilSteady(std::unique_lock<priority_mutex>& lock,
+                       std::chrono::steady_clock::time_point timeout) {
+    return WaitPi(*lock.mutex()->native_handle(), &timeout);
+  }
+
+  template <typename Lock>
+  bool WaitUntilSteady(Lock& lock,
+                       std::chrono::steady_clock::time_point timeout) {
+    uint32_t seq = Prepare();
+    lock.unlock();
+    bool rv = WaitPlain(seq, &timeout);
+    lock.lock();
+    return rv;
+  }
+
+  uint32_t Prepare() {
+    m_waiters.fetch_add(1);
+    return m_seq.load();
+  }
+
+  bool WaitPi(std::atomic<uint32_t>& mutex,
+              const std::chrono::steady_clock::time_point* timeout);
+  bool WaitPlain(uint32_t seq,
+                 const std::chrono::steady_clock::time_point* timeout);
+  void Notify(bool all);
+
+  // bumped by every notify, so a waiter can tell if it missed one
+  std::atomic<uint32_t> m_seq{0};
+  std::atomic<uint32_t> m_waiters{0};
+  // the mutex of the waiters, once one has waited with a priority_mutex
+  std::atomic<std::atomic<uint32_t>*> m_mutex{nullptr};
 };
 
-#endif  // defined(WPI_USE_PRIORITY_MUTEX) && defined(__linux__)
+#endif  // __linux__
 
 }  // namespace wpi
@@ -144,6 +144,17 @@ class raw_mem_istream : public raw_istream {
   void close() override;
   size_t in_avail() const override;
 
+  // The data not yet read, for decoding in place.
+  std::string_view remaining() const { return {m_cur, m_left}; }
+
+  // Consumes the first len bytes of remaining() without copying them.
+  void skip(size_t len) {
+    len = (std::min)(len, m_left);
+    m_cur += len;
+    m_left -= len;
+    set_read_count(len);
+  }
+
  private:
   void read_impl(void* data, size_t len) override;
 
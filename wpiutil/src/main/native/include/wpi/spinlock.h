@@ -11,6 +11,10 @@
 
 #include "Compiler.h"
 
+#ifdef WPI_INSTRUMENT_LOCKS
+#include "wpi/lock_stats.h"
+#endif
+
 namespace wpi {
 
 /**
@@ -133,7 +137,13 @@ class recursive_spinlock2 {
   }
 };
 
+#ifdef WPI_INSTRUMENT_LOCKS
 #ifdef __arm__
+using recursive_spinlock = instrumented_mutex<recursive_spinlock2>;
+#else
+using recursive_spinlock = instrumented_mutex<recursive_spinlock1>;
+#endif
+#elif defined(__arm__)
 // benchmarking has shown this version to be faster on ARM, but slower on
 // windows, mac, and linux
 using recursive_spinlock = recursive_spinlock2;
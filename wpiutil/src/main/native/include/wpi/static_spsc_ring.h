@@ -0,0 +1,185 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "wpi/span.h"
+
+namespace wpi {
+
+/**
+ * A fixed-capacity ring buffer for handing values from exactly one producer
+ * thread to exactly one consumer thread, for example sensor samples from an
+ * interrupt or Notifier callback to the main loop.
+ *
+ * It never allocates or locks, and nothing in it blocks.  Rejecting pushes
+ * while full (the default), every function is wait-free.  When the ring is
+ * full, pushes either fail or, if OverwriteOldest is true, replace the oldest
+ * values.  In overwrite mode a pop that races with the producer overwriting
+ * the values it is copying starts again with newer ones, so only the
+ * producer is wait-free.
+ *
+ * @tparam T value type; must be trivially copyable
+ * @tparam N capacity; must be a power of 2
+ * @tparam OverwriteOldest whether pushes to a full ring replace the oldest
+ *                         values instead of failing
+ */
+template <class T, size_t N, bool OverwriteOldest = false>
+class static_spsc_ring {
+ public:
+  static_assert(N >= 2 && (N & (N - 1)) == 0,
+                "SPSC ring size must be a power of 2.");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SPSC ring values must be trivially copyable.");
+
+  /**
+   * Returns the number of values the buffer can hold.
+   */
+  static constexpr size_t capacity() { return N; }
+
+  /**
+   * Returns the number of queued values.  With the other thread active this
+   * is only a snapshot.
+   */
+  size_t size() const {
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    return (std::min)(tail - head, N);
+  }
+
+  /**
+   * Returns whether the buffer is empty.  With the other thread active this
+   * is only a snapshot.
+   */
+  bool empty() const { return size() == 0; }
+
+  /**
+   * Pushes a value onto the back of the buffer.  Producer thread only.
+   *
+   * @param value the value
+   * @return false if the buffer was full (never, if OverwriteOldest)
+   */
+  bool push(const T& value) { return push(span<const T>{&value, 1}) == 1; }
+
+  /**
+   * Pushes values onto the back of the buffer, in order.  Producer thread
+   * only.
+   *
+   * @param values the values
+   * @return the number of values pushed (from the front of values); less
+   *         than values.size() only if the buffer filled up
+   */
+  size_t push(span<const T> values) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t count = values.size();
+    if constexpr (OverwriteOldest) {
+      // only the newest N can survive this push
+      if (values.size() > N) {
+        size_t skip = values.size() - N;
+        values = values.subspan(skip);
+        tail += skip;
+      }
+      // Pairs with the fence in pop(): a consumer whose copy saw any of
+      // these writes also sees that the slots are being reused
+      m_writing.store(tail + values.size(), std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    } else {
+      if (N - (tail - m_headCache) < count) {
+        m_headCache = m_head.load(std::memory_order_acquire);
+        count = (std::min)(count, N - (tail - m_headCache));
+        values = values.first(count);
+      }
+    }
+    Copy(values.data(), tail, values.size());
+    m_tail.store(tail + values.size(), std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * Removes the value at the front of the buffer, unless it is empty.
+   * Consumer thread only.
+   *
+   * @param value set to the removed value
+   * @return false if the buffer was empty
+   */
+  bool pop(T& value) { return pop(span<T>{&value, 1}) == 1; }
+
+  /**
+   * Removes values from the front of the buffer, in order.  Consumer thread
+   * only.
+   *
+   * @param values filled with the removed values
+   * @return the number of values removed (into the front of values)
+   */
+  size_t pop(span<T> values) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+      size_t tail = m_tail.load(std::memory_order_acquire);
+      if constexpr (OverwriteOldest) {
+        // skip the values that have been (or are being) overwritten
+        size_t oldest = m_writing.load(std::memory_order_relaxed) - N;
+        if (static_cast<std::ptrdiff_t>(oldest - head) > 0) {
+          m_overwritten += oldest - head;
+          head = oldest;
+        }
+      }
+      size_t count = (std::min)(values.size(), tail - head);
+      if (count == 0) {
+        m_head.store(head, std::memory_order_relaxed);
+        return 0;
+      }
+      CopyOut(values.data(), head, count);
+      if constexpr (OverwriteOldest) {
+        // if the producer reached any slot copied, start again after it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        size_t oldest = m_writing.load(std::memory_order_relaxed) - N;
+        if (static_cast<std::ptrdiff_t>(oldest - head) > 0) {
+          continue;
+        }
+      }
+      m_head.store(head + count, std::memory_order_release);
+      return count;
+    }
+  }
+
+  /**
+   * Returns the number of values overwritten before they could be popped.
+   * Always 0 unless OverwriteOldest.  Consumer thread only.
+   */
+  size_t overwritten() const { return m_overwritten; }
+
+ private:
+  void Copy(const T* from, size_t index, size_t count) {
+    size_t first = (std::min)(count, N - (index & (N - 1)));
+    std::memcpy(&m_data[index & (N - 1)], from, first * sizeof(T));
+    std::memcpy(&m_data[0], from + first, (count - first) * sizeof(T));
+  }
+
+  void CopyOut(T* to, size_t index, size_t count) const {
+    size_t first = (std::min)(count, N - (index & (N - 1)));
+    std::memcpy(to, &m_data[index & (N - 1)], first * sizeof(T));
+    std::memcpy(to + first, &m_data[0], (count - first) * sizeof(T));
+  }
+
+  // Written by the producer; m_headCache saves reading m_head on every push
+  alignas(64) std::atomic<size_t> m_tail{0};
+  size_t m_headCache = 0;
+  // One past the last slot being written; OverwriteOldest only
+  std::atomic<size_t> m_writing{0};
+
+  // Written by the consumer
+  alignas(64) std::atomic<size_t> m_head{0};
+  size_t m_overwritten = 0;
+
+  alignas(64) std::array<T, N> m_data;
+};
+
+}  // namespace wpi
@@ -0,0 +1,163 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_TRACE_H_
+#define WPIUTIL_WPI_TRACE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+namespace wpi {
+
+class raw_ostream;
+
+/**
+ * @defgroup tracing Tracing
+ *
+ * Timed scopes and instant events recorded by the threads of wpiutil, ntcore,
+ * cscore, the HAL and wpilibc, written out in the Chrome trace event format
+ * (which Perfetto and chrome://tracing open), to see where time goes across
+ * threads.
+ *
+ * Events are only recorded in builds with WPI_TRACING defined (the CMake
+ * USE_TRACING option, or the Gradle withTracing property); otherwise the
+ * WPI_TRACE_* macros compile to nothing.  Even then, nothing is recorded
+ * until StartTracing() is called, and a disabled scope costs one relaxed
+ * atomic load.
+ *
+ * Each thread records into its own fixed-size lock-free buffer, which a
+ * collector thread drains every few milliseconds.  Events that don't fit are
+ * dropped and counted.
+ * @{
+ */
+
+/**
+ * Starts recording trace events, discarding any collected before.  Does
+ * nothing if already started.
+ *
+ * @param maxEvents the maximum number of events kept; later events are
+ *                  dropped
+ */
+void StartTracing(size_t maxEvents = 262144);
+
+/**
+ * Stops recording trace events.  The events collected so far are kept until
+ * the next StartTracing().
+ */
+void StopTracing();
+
+/**
+ * Returns whether trace events are being recorded.
+ */
+inline bool IsTracing();
+
+/**
+ * Gets the number of events dropped since StartTracing() because a thread
+ * buffer or the collected events were full.
+ */
+uint64_t GetTraceDroppedEvents();
+
+/**
+ * Writes the collected events in the Chrome trace event JSON format.  Can be
+ * called while tracing; the events recorded so far are collected first.
+ *
+ * @param os output stream
+ */
+void WriteTrace(raw_ostream& os);
+
+/**
+ * Writes the collected events to a file, as WriteTrace() does.
+ *
+ * @param filename file name
+ * @return false if the file could not be opened
+ */
+bool WriteTraceFile(std::string_view filename);
+
+/** @} */
+
+namespace detail {
+
+inline std::atomic<bool> gTracing{false};
+
+inline uint64_t TraceNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// name must be a string literal; instants have a duration of UINT64_MAX
+void RecordTraceEvent(const char* name, uint64_t start, uint64_t duration);
+
+// applies to the calling thread, whether or not tracing is started
+void SetTraceThreadName(std::string_view name);
+
+class TraceScope {
+ public:
+  explicit TraceScope(const char* name)
+      : m_name{gTracing.load(std::memory_order_relaxed) ? name : nullptr},
+        m_start{m_name ? TraceNow() : 0} {}
+
+  ~TraceScope() {
+    if (m_name) {
+      RecordTraceEvent(m_name, m_start, TraceNow() - m_start);
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  const char* m_name;
+  uint64_t m_start;
+};
+
+inline void TraceInstant(const char* name) {
+  if (gTracing.load(std::memory_order_relaxed)) {
+    RecordTraceEvent(name, TraceNow(), UINT64_MAX);
+  }
+}
+
+}  // namespace detail
+
+inline bool IsTracing() {
+  return detail::gTracing.load(std::memory_order_relaxed);
+}
+
+}  // namespace wpi
+
+#define WPI_TRACE_CONCAT_IMPL(a, b) a##b
+#define WPI_TRACE_CONCAT(a, b) WPI_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef WPI_TRACING
+/**
+ * Records the time from here to the end of the enclosing scope.  The name is
+ * a string literal, by convention "library.thing", e.g. "ntcore.dispatch";
+ * the part before the first '.' is the event category.
+ */
+#define WPI_TRACE_SCOPE(name)                                      \
+  ::wpi::detail::TraceScope WPI_TRACE_CONCAT(wpiTraceScope_, __LINE__) { \
+    "" name                                                        \
+  }
+
+/**
+ * Records an instant event, e.g. a frame arriving.  The name is a string
+ * literal, as for WPI_TRACE_SCOPE().
+ */
+#define WPI_TRACE_INSTANT(name) ::wpi::detail::TraceInstant("" name)
+
+/**
+ * Names the calling thread in traces.
+ */
+#define WPI_TRACE_THREAD_NAME(name) ::wpi::detail::SetTraceThreadName(name)
+#else
+#define WPI_TRACE_SCOPE(name) static_cast<void>(0)
+#define WPI_TRACE_INSTANT(name) static_cast<void>(0)
+#define WPI_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#endif  // WPIUTIL_WPI_TRACE_H_
@@ -93,9 +93,6 @@ class AsyncFunction<R(T...)> final
               }
             }
             h.m_params.clear();
-            // wake up any threads that might be waiting for the result
-            lock.unlock();
-            h.m_promises.Notify();
           }
         });
     if (err < 0) {
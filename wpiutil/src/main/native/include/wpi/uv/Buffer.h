@@ -7,6 +7,8 @@
 
 #include <uv.h>
 
+#include <stdint.h>
+
 #include <cstring>
 #include <initializer_list>
 #include <string_view>
@@ -49,7 +51,15 @@ class Buffer : public uv_buf_t {
   operator span<const char>() const { return data(); }  // NOLINT
   operator span<char>() { return data(); }              // NOLINT
 
-  static Buffer Allocate(size_t size) { return Buffer{new char[size], size}; }
+  /**
+   * Allocates a buffer.  Buffers are pooled by size, so this only goes to the
+   * heap when no buffer of a similar size has been deallocated recently; see
+   * GetBufferPoolStats().  The buffer must be freed with Deallocate(), which
+   * may be called on any thread.
+   *
+   * @param size Size of the buffer.
+   */
+  static Buffer Allocate(size_t size);
 
   static Buffer Dup(std::string_view in) {
     Buffer buf = Allocate(in.size());
@@ -69,11 +79,11 @@ class Buffer : public uv_buf_t {
     return buf;
   }
 
-  void Deallocate() {
-    delete[] base;
-    base = nullptr;
-    len = 0;
-  }
+  /**
+   * Frees a buffer allocated with Allocate() (or Dup()).  The length need not
+   * be the allocated one.
+   */
+  void Deallocate();
 
   Buffer Move() {
     Buffer buf = *this;
@@ -89,6 +99,31 @@ class Buffer : public uv_buf_t {
   }
 };
 
+/**
+ * Statistics for the pool behind Buffer::Allocate().
+ */
+struct BufferPoolStats {
+  /** Buffers allocated. */
+  uint64_t allocations = 0;
+
+  /** Allocations that had to go to the heap. */
+  uint64_t heapAllocations = 0;
+
+  /** Bytes in the free lists shared between threads. */
+  size_t sharedBytes = 0;
+};
+
+/**
+ * Gets statistics for the pool behind Buffer::Allocate().
+ */
+BufferPoolStats GetBufferPoolStats();
+
+/**
+ * Returns the buffers cached by the pool behind Buffer::Allocate() for the
+ * calling thread, and those shared between threads, to the heap.
+ */
+void TrimBufferPool();
+
 /**
  * A simple pool allocator for Buffers.
  * Buffers are allocated individually but are reused rather than returned
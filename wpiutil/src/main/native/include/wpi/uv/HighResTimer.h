@@ -0,0 +1,151 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_UV_HIGHRESTIMER_H_
+#define WPIUTIL_WPI_UV_HIGHRESTIMER_H_
+
+#include <uv.h>
+
+#include <stdint.h>
+
+#include <chrono>
+#include <memory>
+
+#include "wpi/Signal.h"
+#include "wpi/uv/Handle.h"
+
+namespace wpi::uv {
+
+class Loop;
+
+namespace detail {
+#ifdef _WIN32
+// signaled from the thread pool when the waitable timer fires
+using HighResTimerRaw = uv_async_t;
+#else
+// polls the timerfd
+using HighResTimerRaw = uv_poll_t;
+#endif
+}  // namespace detail
+
+/**
+ * High resolution timer handle.
+ *
+ * Unlike Timer, which has millisecond resolution and is driven by the loop's
+ * cached time, this fires at nanosecond resolution from a kernel timer (a
+ * timerfd on Linux, a high resolution waitable timer on Windows).  Repeating
+ * timers keep to their original schedule: a late expiration doesn't delay
+ * the following ones, and periods missed entirely are counted rather than
+ * emitted.  Not available on other platforms.
+ *
+ * Like other handles, it must be used from the loop thread; for an
+ * EventLoopRunner, create and start it from ExecAsync() or ExecSync().
+ */
+class HighResTimer final
+    : public HandleImpl<HighResTimer, detail::HighResTimerRaw> {
+  struct private_init {};
+
+ public:
+  using Time = std::chrono::nanoseconds;
+
+  /**
+   * Timing statistics.  Lateness is measured from when an expiration was
+   * scheduled to when the loop handled it.
+   */
+  struct Stats {
+    /** Number of timeout events emitted */
+    uint64_t expirations = 0;
+
+    /** Number of periods skipped because an expiration was handled late */
+    uint64_t missed = 0;
+
+    /** Lateness of the last, longest, and all expirations */
+    Time lastLateness{0};
+    Time maxLateness{0};
+    Time totalLateness{0};
+  };
+
+  explicit HighResTimer(const private_init&) {}
+  ~HighResTimer() noexcept override;
+
+  /**
+   * Create a high resolution timer handle.
+   *
+   * @param loop Loop object where this handle runs.
+   */
+  static std::shared_ptr<HighResTimer> Create(Loop& loop);
+
+  /**
+   * Create a high resolution timer handle.
+   *
+   * @param loop Loop object where this handle runs.
+   */
+  static std::shared_ptr<HighResTimer> Create(
+      const std::shared_ptr<Loop>& loop) {
+    return Create(*loop);
+  }
+
+  /**
+   * Start the timer.
+   *
+   * If repeat is non-zero, an event is emitted first after timeout and then
+   * every repeat interval after that.  Restarting a running timer replaces
+   * its schedule.
+   *
+   * @param timeout Time before emitting an event
+   * @param repeat Time between successive events
+   */
+  void Start(Time timeout, Time repeat = Time{0});
+
+  /**
+   * Stop the timer.
+   */
+  void Stop();
+
+  /**
+   * Get the timer repeat value.
+   *
+   * @return Timer repeat value
+   */
+  Time GetRepeat() const { return m_repeat; }
+
+  /**
+   * Get the timing statistics.
+   *
+   * @return Statistics since creation or the last ResetStats()
+   */
+  const Stats& GetStats() const { return m_stats; }
+
+  /**
+   * Clear the timing statistics.
+   */
+  void ResetStats() { m_stats = Stats{}; }
+
+  /**
+   * Signal generated when the timeout event occurs.
+   */
+  sig::Signal<> timeout;
+
+ private:
+  static Time Now();
+
+  void Arm();
+  void Expired(Time now, uint64_t count);
+
+  // time of the next expiration, on the steady clock
+  Time m_deadline{0};
+  Time m_repeat{0};
+  bool m_active = false;
+  Stats m_stats;
+#ifdef _WIN32
+  void* m_timer = nullptr;
+  void* m_wait = nullptr;
+#else
+  int m_fd = -1;
+#endif
+};
+
+}  // namespace wpi::uv
+
+#endif  // WPIUTIL_WPI_UV_HIGHRESTIMER_H_
@@ -2,6 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <random>
+#include <string>
+
 #include "gtest/gtest.h"
 #include "wpi/Base64.h"
 #include "wpi/SmallString.h"
@@ -99,4 +102,112 @@ static Base64TestParam standard[] = {
 INSTANTIATE_TEST_SUITE_P(Base64Standard, Base64Test,
                          ::testing::ValuesIn(standard));
 
+// Byte at a time versions, to check the block paths against
+static std::string ReferenceEncode(std::string_view plain) {
+  static const char alphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  uint32_t bits = 0;
+  int numBits = 0;
+  for (unsigned char c : plain) {
+    bits = (bits << 8) | c;
+    numBits += 8;
+    while (numBits >= 6) {
+      numBits -= 6;
+      out += alphabet[(bits >> numBits) & 0x3F];
+    }
+  }
+  if (numBits > 0) {
+    out += alphabet[(bits << (6 - numBits)) & 0x3F];
+  }
+  while (out.size() % 4 != 0) {
+    out += '=';
+  }
+  return out;
+}
+
+static int ReferenceValue(char c) {
+  if (c >= 'A' && c <= 'Z') {
+    return c - 'A';
+  } else if (c >= 'a' && c <= 'z') {
+    return c - 'a' + 26;
+  } else if (c >= '0' && c <= '9') {
+    return c - '0' + 52;
+  } else if (c == '+') {
+    return 62;
+  } else if (c == '/') {
+    return 63;
+  }
+  return -1;
+}
+
+static std::string ReferenceDecode(std::string_view encoded) {
+  std::string out;
+  uint32_t bits = 0;
+  int numBits = 0;
+  for (char c : encoded) {
+    int value = ReferenceValue(c);
+    if (value < 0) {
+      break;
+    }
+    bits = (bits << 6) | value;
+    numBits += 6;
+    if (numBits >= 8) {
+      numBits -= 8;
+      out += static_cast<char>((bits >> numBits) & 0xFF);
+    }
+  }
+  return out;
+}
+
+TEST(Base64BlockTest, EncodeDecode) {
+  std::mt19937 gen{1234};
+  std::string plain;
+  for (size_t len = 0; len < 300; ++len) {
+    plain.resize(len);
+    for (auto& c : plain) {
+      c = static_cast<char>(gen());
+    }
+    std::string encoded;
+    Base64Encode(plain, &encoded);
+    ASSERT_EQ(encoded, ReferenceEncode(plain)) << "length " << len;
+    std::string decoded;
+    ASSERT_EQ(Base64Decode(encoded, &decoded), encoded.size());
+    ASSERT_EQ(decoded, plain) << "length " << len;
+  }
+
+  // spans several output chunks
+  plain.resize(100000);
+  for (auto& c : plain) {
+    c = static_cast<char>(gen());
+  }
+  std::string encoded;
+  Base64Encode(plain, &encoded);
+  ASSERT_EQ(encoded, ReferenceEncode(plain));
+  std::string decoded;
+  ASSERT_EQ(Base64Decode(encoded, &decoded), encoded.size());
+  ASSERT_EQ(decoded, plain);
+}
+
+TEST(Base64BlockTest, DecodeStopsAtInvalid) {
+  std::string encoded(200, 'A');
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    encoded[i] = static_cast<char>("ABZaz09+/"[i % 9]);
+  }
+  // every byte value, at positions across and between blocks
+  for (int bad = 0; bad < 256; ++bad) {
+    if (ReferenceValue(static_cast<char>(bad)) >= 0) {
+      continue;
+    }
+    for (size_t pos : {0, 1, 5, 15, 16, 31, 33, 63, 64, 65, 130, 199}) {
+      std::string input = encoded;
+      input[pos] = static_cast<char>(bad);
+      std::string decoded;
+      size_t read = Base64Decode(input, &decoded);
+      ASSERT_EQ(decoded, ReferenceDecode(input)) << bad << " at " << pos;
+      ASSERT_EQ(read, (pos + 3) / 4 * 4) << bad << " at " << pos;
+    }
+  }
+}
+
 }  // namespace wpi
@@ -0,0 +1,140 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/BoundedConcurrentQueue.h"  // NOLINT(build/include_order)
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(BoundedConcurrentQueueTest, Fifo) {
+  wpi::BoundedConcurrentQueue<int> queue(3);
+  EXPECT_EQ(queue.capacity(), 4u);
+  EXPECT_TRUE(queue.empty());
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(4));
+  EXPECT_EQ(queue.size(), 4u);
+
+  int value;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.try_pop(value));
+  EXPECT_FALSE(queue.try_pop().has_value());
+
+  // wraps around
+  queue.push(5);
+  EXPECT_EQ(queue.pop(), 5);
+}
+
+TEST(BoundedConcurrentQueueTest, MoveOnly) {
+  wpi::BoundedConcurrentQueue<std::unique_ptr<int>> queue(2);
+  auto item = std::make_unique<int>(1);
+  EXPECT_TRUE(queue.try_push(std::move(item)));
+  EXPECT_TRUE(queue.try_emplace(std::make_unique<int>(2)));
+
+  // a failed push leaves its argument alone
+  item = std::make_unique<int>(3);
+  EXPECT_FALSE(queue.try_push(std::move(item)));
+  ASSERT_NE(item, nullptr);
+
+  EXPECT_EQ(*queue.pop(), 1);
+  // the other value is destroyed with the queue
+}
+
+TEST(BoundedConcurrentQueueTest, PopTimeout) {
+  using namespace std::chrono_literals;
+  wpi::BoundedConcurrentQueue<int> queue(2);
+  int value = 0;
+  EXPECT_FALSE(queue.try_pop_for(value, 0s));
+  EXPECT_FALSE(queue.try_pop_for(value, 10ms));
+
+  std::thread producer([&] {
+    std::this_thread::sleep_for(10ms);
+    queue.push(1);
+  });
+  EXPECT_TRUE(queue.try_pop_for(value, 10s));
+  EXPECT_EQ(value, 1);
+  producer.join();
+}
+
+TEST(BoundedConcurrentQueueTest, MultipleProducersConsumers) {
+  static constexpr int kThreads = 4;
+  static constexpr int kCount = 10000;
+  wpi::BoundedConcurrentQueue<int> queue(16);
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kThreads; ++t) {
+    producers.emplace_back([&] {
+      for (int i = 1; i <= kCount; ++i) {
+        queue.push(i);
+      }
+    });
+  }
+
+  std::vector<long long> sums(kThreads);  // NOLINT(runtime/int)
+  std::vector<std::thread> consumers;
+  for (int t = 0; t < kThreads; ++t) {
+    consumers.emplace_back([&, t] {
+      for (int i = 0; i < kCount; ++i) {
+        sums[t] += queue.pop();
+      }
+    });
+  }
+
+  for (auto&& thr : producers) {
+    thr.join();
+  }
+  for (auto&& thr : consumers) {
+    thr.join();
+  }
+
+  long long total = 0;  // NOLINT(runtime/int)
+  for (auto sum : sums) {
+    total += sum;
+  }
+  EXPECT_EQ(total, kThreads * (static_cast<long long>(kCount) *  // NOLINT
+                               (kCount + 1) / 2));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, Fifo) {
+  wpi::SpscQueue<int> queue(2);
+  EXPECT_EQ(queue.capacity(), 2u);
+  EXPECT_TRUE(queue.try_push(1));
+  EXPECT_TRUE(queue.try_emplace(2));
+  EXPECT_FALSE(queue.try_push(3));
+  EXPECT_EQ(queue.size(), 2u);
+
+  int value;
+  ASSERT_TRUE(queue.try_pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_EQ(queue.try_pop(), 2);
+  EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(SpscQueueTest, Threaded) {
+  static constexpr int kCount = 100000;
+  wpi::SpscQueue<int> queue(8);
+
+  std::thread producer([&] {
+    for (int i = 0; i < kCount; ++i) {
+      queue.push(i);
+    }
+  });
+
+  // values arrive in order, with the consumer waiting when it gets ahead
+  for (int i = 0; i < kCount; ++i) {
+    EXPECT_EQ(queue.pop(), i);
+  }
+  producer.join();
+  EXPECT_TRUE(queue.empty());
+}
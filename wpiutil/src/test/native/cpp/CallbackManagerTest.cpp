@@ -0,0 +1,85 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/CallbackManager.h"  // NOLINT(build/include_order)
+
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Event {
+  Event(unsigned int producer_, int seq_) : producer{producer_}, seq{seq_} {}
+  unsigned int producer;
+  int seq;
+  unsigned int listener = 0;
+};
+
+class TestThread : public wpi::CallbackThread<TestThread, Event> {
+ public:
+  bool Matches(const ListenerData& listener, const Event& data) {
+    return true;
+  }
+  void SetListener(Event* data, unsigned int listener_uid) {
+    data->listener = listener_uid;
+  }
+  void DoCallback(std::function<void(const Event&)> callback,
+                  const Event& data) {
+    callback(data);
+  }
+};
+
+class TestManager : public wpi::CallbackManager<TestManager, TestThread> {
+  friend class wpi::CallbackManager<TestManager, TestThread>;
+
+ public:
+  void Start() { DoStart(); }
+  unsigned int AddPolled(unsigned int poller_uid) { return DoAdd(poller_uid); }
+  void Notify(unsigned int producer, int seq) { Send(UINT_MAX, producer, seq); }
+};
+
+}  // namespace
+
+TEST(CallbackManagerTest, NoListeners) {
+  TestManager manager;
+  manager.Start();
+  manager.Notify(0, 0);
+  EXPECT_TRUE(manager.WaitForQueue(1.0));
+}
+
+TEST(CallbackManagerTest, ConcurrentSend) {
+  static constexpr unsigned int kProducers = 4;
+  static constexpr int kCount = 10000;
+
+  TestManager manager;
+  auto poller = manager.CreatePoller();
+  manager.AddPolled(poller);
+
+  std::vector<std::thread> producers;
+  for (unsigned int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&, p] {
+      for (int i = 0; i < kCount; ++i) {
+        manager.Notify(p, i);
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  ASSERT_TRUE(manager.WaitForQueue(10.0));
+
+  // every notification arrives, in order for each producer
+  bool timed_out = false;
+  auto events = manager.Poll(poller, 0, &timed_out);
+  ASSERT_EQ(events.size(), kProducers * kCount);
+  std::vector<int> next(kProducers, 0);
+  for (auto& event : events) {
+    EXPECT_EQ(event.seq, next[event.producer]++);
+  }
+  manager.RemovePoller(poller);
+}
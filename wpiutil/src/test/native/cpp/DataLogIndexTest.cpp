@@ -0,0 +1,108 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogIndex.h"  // NOLINT(build/include_order)
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/DataLog.h"
+
+static std::vector<uint8_t> MakeLog() {
+  std::vector<uint8_t> data;
+  wpi::log::DataLog log{[&](wpi::span<const uint8_t> block) {
+    data.insert(data.end(), block.begin(), block.end());
+  }};
+  int a = log.Start("/a", "double", "", 5);
+  int b = log.Start("/b", "int64", "", 5);
+  log.AppendDouble(a, 1.0, 10);
+  log.AppendInteger(b, 50, 50);
+  log.AppendDouble(a, 2.0, 20);
+  log.AppendInteger(b, 40, 40);
+  log.AppendDouble(a, 3.0, 30);
+  log.AppendInteger(b, 60, 60);
+  log.Finish(a, 35);
+  log.SetMetadata(b, "meta", 36);
+  int a2 = log.Start("/a", "string", "", 40);
+  log.AppendString(a2, "s", 45);
+  return data;
+}
+
+TEST(DataLogIndexTest, Entries) {
+  auto data = MakeLog();
+  wpi::log::DataLogIndex index{data};
+  ASSERT_TRUE(index.IsValid());
+  auto& entries = index.GetEntries();
+  ASSERT_EQ(entries.size(), 3u);
+  EXPECT_EQ(entries[0].name, "/a");
+  EXPECT_EQ(entries[0].type, "double");
+  EXPECT_EQ(entries[0].startTimestamp, 5);
+  EXPECT_EQ(entries[0].finishTimestamp, 35);
+  EXPECT_EQ(entries[0].offsets.size(), 3u);
+  EXPECT_EQ(entries[1].metadata, "meta");
+  EXPECT_EQ(entries[1].finishTimestamp, INT64_MAX);
+  EXPECT_EQ(index.Find("/a"), &entries[2]);
+  EXPECT_EQ(index.Find("/c"), nullptr);
+  EXPECT_EQ(index.GetStartTimestamp(), 5);
+  EXPECT_EQ(index.GetEndTimestamp(), 60);
+}
+
+TEST(DataLogIndexTest, Seek) {
+  auto data = MakeLog();
+  wpi::log::DataLogIndex index{data};
+  auto& a = index.GetEntries()[0];
+  EXPECT_EQ(index.Seek(a, 5), wpi::log::DataLogIndex::kNone);
+  EXPECT_EQ(index.Seek(a, 10), 0u);
+  EXPECT_EQ(index.Seek(a, 25), 1u);
+  EXPECT_EQ(index.Seek(a, 1000), 2u);
+  double value;
+  ASSERT_TRUE(index.GetRecord(a, index.Seek(a, 25)).GetDouble(&value));
+  EXPECT_EQ(value, 2.0);
+}
+
+TEST(DataLogIndexTest, SortsOutOfOrder) {
+  auto data = MakeLog();
+  wpi::log::DataLogIndex index{data};
+  auto& b = index.GetEntries()[1];
+  ASSERT_EQ(b.offsets.size(), 3u);
+  std::vector<int64_t> values;
+  for (size_t i = 0; i < b.offsets.size(); ++i) {
+    int64_t value;
+    ASSERT_TRUE(index.GetRecord(b, i).GetInteger(&value));
+    values.push_back(value);
+  }
+  EXPECT_EQ(values, (std::vector<int64_t>{40, 50, 60}));
+  EXPECT_EQ(index.Seek(b, 45), 0u);
+}
+
+TEST(DataLogIndexTest, File) {
+  auto path = fs::temp_directory_path() / "DataLogIndexTest.wpilog";
+  {
+    std::error_code ec;
+    wpi::log::DataLog log{path.string(), ec};
+    ASSERT_FALSE(ec);
+    wpi::log::DoubleLogEntry entry{log, "/d", "", 1};
+    for (int i = 0; i < 1000; ++i) {
+      entry.Append(i, 100 + i);
+    }
+  }
+  {
+    std::error_code ec;
+    wpi::log::DataLogIndex index{path, ec};
+    ASSERT_FALSE(ec);
+    auto entry = index.Find("/d");
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->offsets.size(), 1000u);
+    double value;
+    ASSERT_TRUE(
+        index.GetRecord(*entry, index.Seek(*entry, 600)).GetDouble(&value));
+    EXPECT_EQ(value, 500.0);
+  }
+  fs::remove(path);
+
+  std::error_code ec;
+  wpi::log::DataLogIndex index{path, ec};
+  EXPECT_TRUE(ec);
+  EXPECT_FALSE(index.IsValid());
+}
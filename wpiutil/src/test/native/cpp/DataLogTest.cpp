@@ -0,0 +1,189 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLog.h"  // NOLINT(build/include_order)
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/DataLogReader.h"
+
+namespace {
+
+class DataLogTest : public ::testing::Test {
+ protected:
+  std::function<void(wpi::span<const uint8_t>)> Writer() {
+    return [this](wpi::span<const uint8_t> data) {
+      m_data.insert(m_data.end(), data.begin(), data.end());
+    };
+  }
+
+  std::vector<uint8_t> m_data;
+};
+
+}  // namespace
+
+TEST_F(DataLogTest, Header) {
+  { wpi::log::DataLog log{Writer(), 0.25, "extra"}; }
+  wpi::log::DataLogReader reader{m_data};
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.GetVersion(), 0x0100);
+  EXPECT_EQ(reader.GetExtraHeader(), "extra");
+  EXPECT_EQ(reader.begin(), reader.end());
+  EXPECT_EQ(m_data.size(), 17u);
+}
+
+TEST_F(DataLogTest, InvalidHeader) {
+  m_data = {'W', 'P', 'I', 'L', 'O', 'G', 0, 2, 0, 0, 0, 0};
+  EXPECT_FALSE(wpi::log::DataLogReader{m_data}.IsValid());
+  m_data.resize(8);
+  EXPECT_FALSE(wpi::log::DataLogReader{m_data}.IsValid());
+}
+
+TEST_F(DataLogTest, Records) {
+  int doubleEntry;
+  int stringArrayEntry;
+  {
+    wpi::log::DataLog log{Writer()};
+    wpi::log::DoubleLogEntry d{log, "/d", "{\"unit\":\"m\"}", 5};
+    wpi::log::StringArrayLogEntry sa{log, "/sa", "", 5};
+    wpi::log::BooleanArrayLogEntry ba{log, "/ba", "", 5};
+    wpi::log::IntegerLogEntry i{log, "/i", "", 5};
+    doubleEntry = log.Start("/d", "double");
+    stringArrayEntry = log.Start("/sa", "string[]");
+    EXPECT_EQ(log.Start("/d", "string"), 0);
+    log.Finish(doubleEntry);
+    log.Finish(stringArrayEntry);
+
+    d.Append(1.5, 10);
+    d.Append(-2.0, 0x123456789a);
+    sa.Append(std::vector<std::string>{"a", "bc", ""}, 20);
+    ba.Append(std::vector<int>{true, false, true}, 30);
+    i.Append(-3, 40);
+    d.SetMetadata("{\"unit\":\"ft\"}", 50);
+  }
+
+  wpi::log::DataLogReader reader{m_data};
+  ASSERT_TRUE(reader.IsValid());
+  std::vector<wpi::log::DataLogRecord> records{reader.begin(), reader.end()};
+  // 4 starts, 5 values, set metadata, 4 finishes
+  ASSERT_EQ(records.size(), 14u);
+
+  wpi::log::StartRecordData start;
+  ASSERT_TRUE(records[0].GetStartData(&start));
+  EXPECT_EQ(start.entry, doubleEntry);
+  EXPECT_EQ(start.name, "/d");
+  EXPECT_EQ(start.type, "double");
+  EXPECT_EQ(start.metadata, "{\"unit\":\"m\"}");
+  EXPECT_EQ(records[0].GetTimestamp(), 5);
+  ASSERT_TRUE(records[1].GetStartData(&start));
+  EXPECT_EQ(start.entry, stringArrayEntry);
+  EXPECT_EQ(start.type, "string[]");
+
+  double d;
+  EXPECT_EQ(records[4].GetEntry(), doubleEntry);
+  EXPECT_EQ(records[4].GetTimestamp(), 10);
+  ASSERT_TRUE(records[4].GetDouble(&d));
+  EXPECT_EQ(d, 1.5);
+  EXPECT_EQ(records[5].GetTimestamp(), 0x123456789a);
+  ASSERT_TRUE(records[5].GetDouble(&d));
+  EXPECT_EQ(d, -2.0);
+
+  std::vector<std::string_view> sa;
+  ASSERT_TRUE(records[6].GetStringArray(&sa));
+  EXPECT_EQ(sa, (std::vector<std::string_view>{"a", "bc", ""}));
+  std::vector<int> ba;
+  ASSERT_TRUE(records[7].GetBooleanArray(&ba));
+  EXPECT_EQ(ba, (std::vector<int>{1, 0, 1}));
+  int64_t i;
+  ASSERT_TRUE(records[8].GetInteger(&i));
+  EXPECT_EQ(i, -3);
+
+  wpi::log::MetadataRecordData metadata;
+  ASSERT_TRUE(records[9].GetSetMetadataData(&metadata));
+  EXPECT_EQ(metadata.entry, doubleEntry);
+  EXPECT_EQ(metadata.metadata, "{\"unit\":\"ft\"}");
+
+  // the entries finish in reverse order of construction
+  int finished;
+  ASSERT_TRUE(records[10].GetFinishEntry(&finished));
+  EXPECT_EQ(finished, records[8].GetEntry());
+  ASSERT_TRUE(records[13].GetFinishEntry(&finished));
+  EXPECT_EQ(finished, doubleEntry);
+}
+
+TEST_F(DataLogTest, Pause) {
+  {
+    wpi::log::DataLog log{Writer()};
+    log.Pause();
+    wpi::log::BooleanLogEntry entry{log, "/b", "", 1};
+    entry.Append(true, 2);
+    log.Resume();
+    entry.Append(false, 3);
+  }
+  wpi::log::DataLogReader reader{m_data};
+  std::vector<wpi::log::DataLogRecord> records{reader.begin(), reader.end()};
+  ASSERT_EQ(records.size(), 3u);
+  EXPECT_TRUE(records[0].IsStart());
+  EXPECT_EQ(records[1].GetTimestamp(), 3);
+  EXPECT_TRUE(records[2].IsFinish());
+}
+
+TEST_F(DataLogTest, Truncated) {
+  {
+    wpi::log::DataLog log{Writer()};
+    wpi::log::StringLogEntry entry{log, "/s", "", 1};
+    entry.Append("hello", 2);
+  }
+  m_data.resize(m_data.size() - 3);
+  wpi::log::DataLogReader reader{m_data};
+  std::vector<wpi::log::DataLogRecord> records{reader.begin(), reader.end()};
+  ASSERT_EQ(records.size(), 2u);
+  std::string_view str;
+  ASSERT_TRUE(records[1].GetString(&str));
+  EXPECT_EQ(str, "hello");
+}
+
+TEST_F(DataLogTest, DropsWhenWriterBehind) {
+  constexpr int kCount = 100000;
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool release = false;
+  uint64_t dropped;
+  {
+    wpi::log::DataLog log{[&](wpi::span<const uint8_t> data) {
+                            std::unique_lock lock{mutex};
+                            cond.wait(lock, [&] { return release; });
+                            m_data.insert(m_data.end(), data.begin(),
+                                          data.end());
+                          },
+                          10.0};
+    wpi::log::DoubleLogEntry entry{log, "/d", "", 1};
+    for (int i = 0; i < kCount; ++i) {
+      entry.Append(i, i + 1);
+    }
+    dropped = log.GetDroppedRecords();
+    {
+      std::scoped_lock lock{mutex};
+      release = true;
+    }
+    cond.notify_all();
+  }
+  EXPECT_GT(dropped, 0u);
+
+  wpi::log::DataLogReader reader{m_data};
+  int count = 0;
+  int64_t lastTimestamp = 0;
+  for (auto&& record : reader) {
+    if (!record.IsControl()) {
+      EXPECT_GT(record.GetTimestamp(), lastTimestamp);
+      lastTimestamp = record.GetTimestamp();
+      ++count;
+    }
+  }
+  EXPECT_EQ(count + dropped, static_cast<uint64_t>(kCount));
+}
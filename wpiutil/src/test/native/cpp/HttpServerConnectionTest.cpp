@@ -0,0 +1,113 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/HttpServerConnection.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <string>
+
+#include "WebSocketTest.h"
+#include "wpi/StringExtras.h"
+#include "wpi/fs.h"
+#include "wpi/raw_ostream.h"
+
+namespace wpi {
+
+namespace {
+class TestConnection : public HttpServerConnection {
+ public:
+  TestConnection(std::shared_ptr<uv::Stream> stream, std::string filename)
+      : HttpServerConnection(std::move(stream)),
+        m_filename{std::move(filename)} {}
+
+ protected:
+  void ProcessRequest() override {
+    if (m_request.GetUrl() == "/file") {
+      ASSERT_TRUE(SendFileResponse(200, "OK", "text/plain", m_filename));
+    } else {
+      SendCacheableResponse("text/plain", "hello", false, "\"abc\"");
+    }
+  }
+
+ private:
+  std::string m_filename;
+};
+
+size_t CountResponses(std::string_view text, std::string_view status) {
+  size_t count = 0;
+  for (size_t pos = 0; (pos = text.find(status, pos)) != text.npos;
+       pos += status.size()) {
+    ++count;
+  }
+  return count;
+}
+}  // namespace
+
+class HttpServerConnectionTest : public WebSocketTest {
+ public:
+  // Sends the requests in one write and collects everything the server sends
+  // back until it closes the connection
+  std::string Exchange(std::string_view requests,
+                       std::string_view filename = {}) {
+    serverPipe->Listen([&, filename = std::string{filename}] {
+      auto conn = serverPipe->Accept();
+      conn->SetData(std::make_shared<TestConnection>(conn, filename));
+    });
+
+    std::string received;
+    clientPipe->Connect(pipeName, [&] {
+      clientPipe->StartRead();
+      clientPipe->data.connect([&](uv::Buffer& buf, size_t size) {
+        received.append(buf.base, size);
+      });
+      clientPipe->end.connect([&] { Finish(); });
+      clientPipe->Write({uv::Buffer{requests}}, [](auto, uv::Error) {});
+    });
+
+    loop->Run();
+    return received;
+  }
+};
+
+TEST_F(HttpServerConnectionTest, PipelinedETag) {
+  auto received = Exchange(
+      "GET / HTTP/1.1\r\n\r\n"
+      "GET / HTTP/1.1\r\nIf-None-Match: W/\"xyz\", \"abc\"\r\n\r\n"
+      "GET / HTTP/1.1\r\nConnection: close\r\n\r\n"
+      "GET / HTTP/1.1\r\n\r\n");  // after the close; ignored
+
+  EXPECT_EQ(CountResponses(received, "HTTP/1.1 200 OK\r\n"), 2u);
+  EXPECT_EQ(CountResponses(received, "HTTP/1.1 304 Not Modified\r\n"), 1u);
+  EXPECT_EQ(CountResponses(received, "ETag: \"abc\"\r\n"), 3u);
+  EXPECT_EQ(CountResponses(received, "Cache-Control: no-cache\r\n"), 3u);
+
+  // only the last response closes, and it comes last
+  EXPECT_EQ(CountResponses(received, "Connection: close"), 1u);
+  auto last = received.rfind("HTTP/1.1 ");
+  EXPECT_NE(received.find("Connection: close", last), std::string::npos);
+  EXPECT_TRUE(wpi::ends_with(received, "\r\n\r\nhello"));
+}
+
+TEST_F(HttpServerConnectionTest, File) {
+  auto filename =
+      (fs::temp_directory_path() / "HttpServerConnectionTest.txt").string();
+  std::string content(100000, 'x');
+  {
+    std::error_code ec;
+    raw_fd_ostream os{filename, ec};
+    ASSERT_FALSE(ec);
+    os << content;
+  }
+
+  auto received = Exchange("GET /file HTTP/1.1\r\nConnection: close\r\n\r\n",
+                           filename);
+  fs::remove(filename);
+
+  EXPECT_TRUE(wpi::starts_with(received, "HTTP/1.1 200 OK\r\n"));
+  EXPECT_NE(received.find("Content-Length: 100000\r\n"), std::string::npos);
+  EXPECT_NE(received.find("ETag: \""), std::string::npos);
+  EXPECT_TRUE(wpi::ends_with(received, "\r\n\r\n" + content));
+}
+
+}  // namespace wpi
@@ -0,0 +1,114 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/indexed_priority_queue.h"  // NOLINT(build/include_order)
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace wpi {
+
+TEST(IndexedPriorityQueueTest, PushPop) {
+  indexed_priority_queue<int, int> queue;
+  EXPECT_TRUE(queue.empty());
+
+  queue.push(1, 10);
+  queue.push(2, 30);
+  queue.push(3, 20);
+  EXPECT_EQ(queue.size(), 3u);
+  EXPECT_EQ(queue.top().first, 2);
+
+  EXPECT_EQ(queue.pop().first, 2);
+  EXPECT_EQ(queue.pop().first, 3);
+  EXPECT_EQ(queue.pop().first, 1);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(IndexedPriorityQueueTest, UpdatePriority) {
+  indexed_priority_queue<int, int, std::greater<int>> queue;
+  queue.push(1, 10);
+  queue.push(2, 20);
+  queue.push(3, 30);
+  EXPECT_EQ(queue.top().first, 1);
+
+  // later
+  queue.push(1, 40);
+  EXPECT_EQ(queue.size(), 3u);
+  EXPECT_EQ(queue.top().first, 2);
+
+  // earlier
+  queue.push(3, 5);
+  EXPECT_EQ(queue.top().first, 3);
+  EXPECT_EQ(queue.top().second, 5);
+}
+
+TEST(IndexedPriorityQueueTest, Remove) {
+  indexed_priority_queue<int, int, std::greater<int>> queue;
+  for (int i = 0; i < 10; ++i) {
+    queue.push(i, i);
+  }
+  EXPECT_TRUE(queue.remove(0));
+  EXPECT_TRUE(queue.remove(5));
+  EXPECT_FALSE(queue.remove(5));
+  EXPECT_FALSE(queue.contains(5));
+  EXPECT_TRUE(queue.contains(6));
+
+  std::vector<int> keys;
+  while (!queue.empty()) {
+    keys.push_back(queue.pop().first);
+  }
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 4, 6, 7, 8, 9}));
+}
+
+TEST(IndexedPriorityQueueTest, ForEachTop) {
+  indexed_priority_queue<int, int, std::greater<int>> queue;
+  for (int i = 0; i < 20; ++i) {
+    queue.push(i, (i * 7) % 20);
+  }
+
+  std::vector<int> priorities;
+  queue.for_each_top(5, [&](int key, int priority) {
+    EXPECT_EQ(priority, (key * 7) % 20);
+    priorities.push_back(priority);
+  });
+  std::sort(priorities.begin(), priorities.end());
+  EXPECT_EQ(priorities, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+
+  int count = 0;
+  queue.for_each_top(-1, [&](int, int) { ++count; });
+  EXPECT_EQ(count, 0);
+}
+
+TEST(IndexedPriorityQueueTest, Random) {
+  // compare against a sorted reference under random pushes and removes
+  indexed_priority_queue<int, unsigned int, std::greater<unsigned int>> queue;
+  std::vector<unsigned int> priorities(64, 0);
+  std::mt19937 gen{42};
+  for (int i = 0; i < 10000; ++i) {
+    int key = gen() % priorities.size();
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(queue.remove(key), priorities[key] != 0);
+      priorities[key] = 0;
+    } else {
+      priorities[key] = gen() % 1000 + 1;
+      queue.push(key, priorities[key]);
+    }
+    if (!queue.empty()) {
+      unsigned int min = UINT32_MAX;
+      for (auto priority : priorities) {
+        if (priority != 0) {
+          min = (std::min)(min, priority);
+        }
+      }
+      ASSERT_EQ(queue.top().second, min);
+      ASSERT_EQ(priorities[queue.top().first], min);
+    }
+  }
+}
+
+}  // namespace wpi
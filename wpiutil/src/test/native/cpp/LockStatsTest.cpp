@@ -0,0 +1,96 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/lock_stats.h"  // NOLINT(build/include_order)
+
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <string_view>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+static wpi::LockStats FindStats(std::string_view name) {
+  for (auto&& stats : wpi::GetLockStats()) {
+    if (stats.name == name) {
+      return stats;
+    }
+  }
+  return {};
+}
+
+TEST(LockStatsTest, Uncontended) {
+  wpi::instrumented_mutex<std::mutex> mutex;
+  wpi::SetLockName(mutex, "LockStatsTest.Uncontended");
+  for (int i = 0; i < 3; ++i) {
+    std::scoped_lock lock{mutex};
+  }
+  {
+    std::scoped_lock lock{mutex};
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+
+  auto stats = FindStats("LockStatsTest.Uncontended");
+  EXPECT_EQ(stats.acquisitions, 5u);
+  EXPECT_EQ(stats.contentions, 0u);
+  EXPECT_EQ(stats.maxWaitNs, 0u);
+  EXPECT_GE(stats.maxHoldNs, 2000000u);
+}
+
+TEST(LockStatsTest, Contended) {
+  wpi::instrumented_mutex<std::mutex> mutex;
+  wpi::SetLockName(mutex, "LockStatsTest.Contended");
+  mutex.lock();
+  std::thread thr{[&] {
+    std::scoped_lock lock{mutex};
+  }};
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  mutex.unlock();
+  thr.join();
+
+  auto stats = FindStats("LockStatsTest.Contended");
+  EXPECT_EQ(stats.acquisitions, 2u);
+  EXPECT_EQ(stats.contentions, 1u);
+  EXPECT_GT(stats.maxWaitNs, 0u);
+  EXPECT_EQ(stats.totalWaitNs, stats.maxWaitNs);
+  EXPECT_EQ(std::accumulate(stats.waitHistogram.begin(),
+                            stats.waitHistogram.end(), uint64_t{0}),
+            1u);
+}
+
+TEST(LockStatsTest, Recursive) {
+  wpi::instrumented_mutex<std::recursive_mutex> mutex;
+  wpi::SetLockName(mutex, "LockStatsTest.Recursive");
+  {
+    std::scoped_lock lock{mutex};
+    std::scoped_lock lock2{mutex};
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  // the depth is back to zero, so this starts a new hold
+  {
+    std::scoped_lock lock{mutex};
+  }
+
+  auto stats = FindStats("LockStatsTest.Recursive");
+  EXPECT_EQ(stats.acquisitions, 3u);
+  EXPECT_EQ(stats.contentions, 0u);
+  EXPECT_GE(stats.maxHoldNs, 2000000u);
+}
+
+TEST(LockStatsTest, Reset) {
+  wpi::instrumented_mutex<std::mutex> mutex;
+  wpi::SetLockName(mutex, "LockStatsTest.Reset");
+  {
+    std::scoped_lock lock{mutex};
+  }
+  EXPECT_EQ(FindStats("LockStatsTest.Reset").acquisitions, 1u);
+  wpi::ResetLockStats();
+  auto stats = FindStats("LockStatsTest.Reset");
+  EXPECT_EQ(stats.name, "LockStatsTest.Reset");
+  EXPECT_EQ(stats.acquisitions, 0u);
+  EXPECT_EQ(stats.maxHoldNs, 0u);
+}
@@ -0,0 +1,111 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#define WPI_LOG_MIN_LEVEL ::wpi::WPI_LOG_INFO
+#include "wpi/Logger.h"  // NOLINT(build/include_order)
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/mutex.h"
+
+namespace wpi {
+
+namespace {
+struct LogSink {
+  Logger::LogFunc Func() {
+    return [this](unsigned int level, const char*, unsigned int,
+                  const char* msg) {
+      std::scoped_lock lock(mutex);
+      threads.emplace_back(std::this_thread::get_id());
+      msgs.emplace_back(msg);
+    };
+  }
+
+  wpi::mutex mutex;
+  std::vector<std::thread::id> threads;
+  std::vector<std::string> msgs;
+};
+}  // namespace
+
+TEST(LoggerTest, Sync) {
+  LogSink sink;
+  Logger logger{sink.Func(), WPI_LOG_DEBUG4};
+  WPI_INFO(logger, "{} {}", "info", 1);
+  WPI_LOG(logger, WPI_LOG_DEBUG, "{}", "compiled out");
+  ASSERT_EQ(sink.msgs.size(), 1u);
+  EXPECT_EQ(sink.msgs[0], "info 1");
+  EXPECT_EQ(sink.threads[0], std::this_thread::get_id());
+}
+
+TEST(LoggerTest, Async) {
+  LogSink sink;
+  Logger logger{sink.Func()};
+  logger.EnableAsync();
+  EXPECT_TRUE(logger.IsAsync());
+
+  for (int i = 0; i < 100; ++i) {
+    WPI_INFO(logger, "msg {}", i);
+  }
+  logger.DoLog(WPI_LOG_ERROR, __FILE__, __LINE__, "plain");
+  WPI_LOG(logger, WPI_LOG_DEBUG, "{}", "compiled out");
+  logger.Flush();
+
+  std::scoped_lock lock(sink.mutex);
+  ASSERT_EQ(sink.msgs.size(), 101u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(sink.msgs[i], "msg " + std::to_string(i));
+    EXPECT_NE(sink.threads[i], std::this_thread::get_id());
+  }
+  EXPECT_EQ(sink.msgs[100], "plain");
+  EXPECT_EQ(logger.GetDroppedCount(), 0u);
+}
+
+TEST(LoggerTest, AsyncDrops) {
+  wpi::mutex blockMutex;
+  std::unique_lock block(blockMutex);
+  std::vector<std::string> msgs;
+  Logger logger{[&](unsigned int, const char*, unsigned int, const char* msg) {
+    std::scoped_lock lock(blockMutex);
+    msgs.emplace_back(msg);
+  }};
+  logger.EnableAsync(4);
+
+  // the first message blocks the sink, so the ones after it fill the buffer
+  WPI_INFO(logger, "{}", "first");
+  while (logger.GetDroppedCount() == 0) {
+    WPI_INFO(logger, "{}", "more");
+  }
+  block.unlock();
+  logger.DisableAsync();
+  EXPECT_FALSE(logger.IsAsync());
+
+  ASSERT_GE(msgs.size(), 2u);
+  EXPECT_EQ(msgs.front(), "first");
+  EXPECT_NE(msgs.back().find("dropped"), std::string::npos);
+}
+
+TEST(LoggerTest, AsyncManyThreads) {
+  LogSink sink;
+  Logger logger{sink.Func()};
+  logger.EnableAsync(16);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 10; ++i) {
+        WPI_INFO(logger, "{} {}", t, i);
+      }
+    });
+  }
+  for (auto&& thr : threads) {
+    thr.join();
+  }
+  logger.DisableAsync();
+  EXPECT_EQ(sink.msgs.size(), 40u);
+}
+
+}  // namespace wpi
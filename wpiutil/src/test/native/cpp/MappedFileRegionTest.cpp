@@ -0,0 +1,121 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MappedFileRegion.h"  // NOLINT(build/include_order)
+
+#include <cstring>
+#include <string>
+#include <system_error>
+
+#include "gtest/gtest.h"
+#include "wpi/fs.h"
+#include "wpi/raw_istream.h"
+#include "wpi/raw_ostream.h"
+
+namespace wpi {
+
+class MappedFileRegionTest : public ::testing::Test {
+ protected:
+  MappedFileRegionTest() {
+    std::error_code ec;
+    raw_fd_ostream os{filename, ec};
+    EXPECT_FALSE(ec);
+    for (int i = 0; i < 10000; ++i) {
+      content += static_cast<char>('a' + i % 26);
+    }
+    os << content;
+  }
+
+  ~MappedFileRegionTest() override {
+    std::error_code ec;
+    fs::remove(filename, ec);
+  }
+
+  std::string filename =
+      (fs::temp_directory_path() / "MappedFileRegionTest.txt").string();
+  std::string content;
+};
+
+TEST_F(MappedFileRegionTest, ReadOnly) {
+  std::error_code ec;
+  MappedFileRegion region{filename, MappedFileRegion::kReadOnly, ec};
+  ASSERT_FALSE(ec);
+  ASSERT_TRUE(region);
+  region.Advise(MappedFileRegion::kWillNeed);
+  ASSERT_EQ(region.size(), content.size());
+  ASSERT_EQ(std::memcmp(region.const_data(), content.data(), content.size()),
+            0);
+
+  // moves hand over the mapping
+  MappedFileRegion moved{std::move(region)};
+  ASSERT_FALSE(region);  // NOLINT(bugprone-use-after-move)
+  ASSERT_EQ(moved.const_data()[1], 'b');
+}
+
+TEST_F(MappedFileRegionTest, Offset) {
+  size_t offset = MappedFileRegion::GetAlignment();
+  if (offset >= content.size()) {
+    GTEST_SKIP() << "file smaller than alignment";
+  }
+  std::error_code ec;
+  fs::file_t f = fs::OpenFileForRead(filename, ec);
+  ASSERT_FALSE(ec);
+  MappedFileRegion region{f, 10, offset, MappedFileRegion::kReadOnly, ec};
+  fs::CloseFile(f);
+  ASSERT_FALSE(ec);
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(region.const_data()),
+                        region.size()),
+            content.substr(offset, 10));
+}
+
+TEST_F(MappedFileRegionTest, ReadWrite) {
+  {
+    std::error_code ec;
+    MappedFileRegion region{filename, MappedFileRegion::kReadWrite, ec};
+    ASSERT_FALSE(ec);
+    region.data()[0] = 'X';
+    region.Flush();
+  }
+  {
+    // private changes don't reach the file
+    std::error_code ec;
+    MappedFileRegion region{filename, MappedFileRegion::kPriv, ec};
+    ASSERT_FALSE(ec);
+    region.data()[1] = 'Y';
+  }
+
+  std::error_code ec;
+  raw_fd_istream is{filename, ec};
+  ASSERT_FALSE(ec);
+  char buf[3];
+  is.read(buf, 3);
+  ASSERT_EQ(std::string_view(buf, 3), "Xbc");
+}
+
+TEST_F(MappedFileRegionTest, Stream) {
+  std::error_code ec;
+  raw_mapped_istream is{filename, ec};
+  ASSERT_FALSE(ec);
+  ASSERT_EQ(is.in_avail(), content.size());
+
+  char buf[4];
+  is.read(buf, 4);
+  ASSERT_EQ(std::string_view(buf, 4), "abcd");
+  ASSERT_EQ(is.remaining().data(),
+            reinterpret_cast<const char*>(is.region().const_data()) + 4);
+  is.skip(content.size());
+  ASSERT_EQ(is.in_avail(), 0u);
+  ASSERT_FALSE(is.has_error());
+  is.read(buf, 1);
+  ASSERT_TRUE(is.has_error());
+}
+
+TEST_F(MappedFileRegionTest, Missing) {
+  std::error_code ec;
+  raw_mapped_istream is{filename + ".missing", ec};
+  ASSERT_TRUE(ec);
+  ASSERT_EQ(is.in_avail(), 0u);
+}
+
+}  // namespace wpi
@@ -0,0 +1,155 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MemoryResource.h"  // NOLINT(build/include_order)
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/DenseMap.h"
+#include "wpi/StringMap.h"
+
+namespace {
+// Counts what is outstanding with the heap.
+class CountingResource : public wpi::MemoryResource {
+ public:
+  int allocations = 0;
+  size_t bytes = 0;
+
+ protected:
+  void* DoAllocate(size_t size, size_t alignment) override {
+    ++allocations;
+    bytes += size;
+    return wpi::GetHeapMemoryResource()->Allocate(size, alignment);
+  }
+
+  void DoDeallocate(void* p, size_t size, size_t alignment) override {
+    --allocations;
+    bytes -= size;
+    wpi::GetHeapMemoryResource()->Deallocate(p, size, alignment);
+  }
+};
+}  // namespace
+
+static bool IsAligned(void* p, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+TEST(MemoryResourceTest, HeapOverAligned) {
+  auto heap = wpi::GetHeapMemoryResource();
+  void* p = heap->Allocate(100, 256);
+  EXPECT_TRUE(IsAligned(p, 256));
+  heap->Deallocate(p, 100, 256);
+}
+
+TEST(MemoryResourceTest, ArenaReuse) {
+  CountingResource upstream;
+  wpi::MonotonicArena arena{256, &upstream};
+  for (int i = 0; i < 3; ++i) {
+    void* a = arena.Allocate(3, 1);
+    void* b = arena.Allocate(8, 8);
+    EXPECT_TRUE(IsAligned(b, 8));
+    EXPECT_NE(a, b);
+    arena.Allocate(1000);
+    EXPECT_EQ(arena.GetBytesUsed(), 1011u);
+    arena.Reset();
+    EXPECT_EQ(arena.GetBytesUsed(), 0u);
+    // after the first iteration the chunks are reused
+    EXPECT_EQ(upstream.allocations, 2);
+  }
+  arena.Release();
+  EXPECT_EQ(upstream.allocations, 0);
+}
+
+TEST(MemoryResourceTest, ArenaBuffer) {
+  CountingResource upstream;
+  alignas(16) char buffer[64];
+  wpi::MonotonicArena arena{buffer, sizeof(buffer), &upstream};
+  EXPECT_EQ(arena.Allocate(32), buffer);
+  EXPECT_EQ(upstream.allocations, 0);
+  arena.Allocate(64);
+  EXPECT_EQ(upstream.allocations, 1);
+  arena.Reset();
+  EXPECT_EQ(arena.Allocate(32), buffer);
+}
+
+TEST(MemoryResourceTest, Pool) {
+  CountingResource upstream;
+  {
+    wpi::PoolResource pool{&upstream};
+    void* a = pool.Allocate(20);
+    void* b = pool.Allocate(20);
+    EXPECT_NE(a, b);
+    pool.Deallocate(a, 20);
+    // same size class
+    EXPECT_EQ(pool.Allocate(32), a);
+    EXPECT_EQ(upstream.allocations, 1);
+
+    void* big = pool.Allocate(10000);
+    EXPECT_EQ(upstream.allocations, 2);
+    pool.Deallocate(big, 10000);
+    EXPECT_EQ(upstream.allocations, 1);
+  }
+  EXPECT_EQ(upstream.allocations, 0);
+}
+
+TEST(MemoryResourceTest, StringMap) {
+  CountingResource upstream;
+  {
+    wpi::StringMap<std::string> map{&upstream};
+    for (int i = 0; i < 100; ++i) {
+      map[std::to_string(i)] = std::string(50, 'x');
+    }
+    EXPECT_GT(upstream.allocations, 100);
+    EXPECT_EQ(map.erase("5"), true);
+    EXPECT_EQ(map.size(), 99u);
+    EXPECT_EQ(map["50"].size(), 50u);
+
+    // moves keep the resource; copies use the heap
+    wpi::StringMap<std::string> moved{std::move(map)};
+    EXPECT_EQ(moved.getResource(), &upstream);
+    wpi::StringMap<std::string> copy{moved};
+    EXPECT_EQ(copy.getResource(), nullptr);
+    EXPECT_EQ(copy.size(), 99u);
+    moved.clear();
+    EXPECT_EQ(upstream.allocations, 1);  // the table
+  }
+  EXPECT_EQ(upstream.allocations, 0);
+  EXPECT_EQ(upstream.bytes, 0u);
+}
+
+TEST(MemoryResourceTest, DenseMap) {
+  CountingResource upstream;
+  {
+    wpi::DenseMap<int, int> map{&upstream};
+    for (int i = 0; i < 1000; ++i) {
+      map[i] = i * 2;
+    }
+    EXPECT_EQ(upstream.allocations, 1);
+    EXPECT_EQ(map[500], 1000);
+    map.shrink_and_clear();
+    EXPECT_TRUE(map.empty());
+
+    wpi::DenseMap<int, int> other;
+    other[1] = 2;
+    map.swap(other);
+    EXPECT_EQ(map.getResource(), nullptr);
+    EXPECT_EQ(other.getResource(), &upstream);
+  }
+  EXPECT_EQ(upstream.allocations, 0);
+  EXPECT_EQ(upstream.bytes, 0u);
+}
+
+TEST(MemoryResourceTest, Vector) {
+  wpi::MonotonicArena arena;
+  std::vector<int, wpi::ResourceAllocator<int>> v{&arena};
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_EQ(v[99], 99);
+  EXPECT_GE(arena.GetBytesUsed(), 100 * sizeof(int));
+}
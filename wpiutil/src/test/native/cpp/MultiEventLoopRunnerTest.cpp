@@ -0,0 +1,80 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MultiEventLoopRunner.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/Logger.h"
+#include "wpi/TCPConnector.h"
+#include "wpi/mutex.h"
+#include "wpi/uv/Loop.h"
+#include "wpi/uv/Tcp.h"
+#include "wpi/uv/util.h"
+
+namespace wpi {
+
+TEST(MultiEventLoopRunnerTest, NumShards) {
+  MultiEventLoopRunner runner{3};
+  ASSERT_EQ(runner.GetNumShards(), 3u);
+  int count = 0;
+  runner.ExecSyncAll([&](uv::Loop&) { ++count; });
+  ASSERT_EQ(count, 3);
+}
+
+TEST(MultiEventLoopRunnerTest, HandOff) {
+  MultiEventLoopRunner runner{2};
+  wpi::mutex mutex;
+  std::vector<uv::Loop*> loops;
+
+  // accept connections and greet them from their shard
+  unsigned int port = 0;
+  runner.GetAcceptor().ExecSync([&](uv::Loop& loop) {
+    auto server = uv::Tcp::Create(loop);
+    server->Bind("127.0.0.1", 0);
+    server->Listen([&, srv = server.get()] {
+      if (auto client = srv->Accept()) {
+        ASSERT_TRUE(runner.HandOff(
+            *client, [&](uv::Loop& loop, std::shared_ptr<uv::Tcp> client) {
+              {
+                std::scoped_lock lock(mutex);
+                loops.push_back(&loop);
+              }
+              client->Write({uv::Buffer{"hi"}}, [](auto, uv::Error) {});
+            }));
+      }
+    });
+    std::string ip;
+    uv::AddrToName(server->GetSock(), &ip, &port);
+  });
+
+  Logger logger;
+  auto stream1 = TCPConnector::connect("127.0.0.1", port, logger, 1);
+  auto stream2 = TCPConnector::connect("127.0.0.1", port, logger, 1);
+  ASSERT_TRUE(stream1);
+  ASSERT_TRUE(stream2);
+  for (auto stream : {stream1.get(), stream2.get()}) {
+    char buf[2];
+    NetworkStream::Error err;
+    ASSERT_EQ(stream->receive(buf, 2, &err, 1), 2u);
+    ASSERT_EQ(std::string_view(buf, 2), "hi");
+  }
+
+  // the connections are spread over the shards
+  std::scoped_lock lock(mutex);
+  ASSERT_EQ(loops.size(), 2u);
+  ASSERT_NE(loops[0], loops[1]);
+  for (auto loop : loops) {
+    ASSERT_TRUE(loop == runner.GetShard(0).GetLoop().get() ||
+                loop == runner.GetShard(1).GetLoop().get());
+  }
+  ASSERT_EQ(runner.GetNumConnections(0), 1u);
+  ASSERT_EQ(runner.GetNumConnections(1), 1u);
+}
+
+}  // namespace wpi
@@ -0,0 +1,187 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/ParallelTcpConnector.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/EventLoopRunner.h"
+#include "wpi/Logger.h"
+#include "wpi/TCPConnector.h"
+#include "wpi/uv/Loop.h"
+#include "wpi/uv/Tcp.h"
+#include "wpi/uv/Timer.h"
+#include "wpi/uv/util.h"
+
+namespace wpi {
+
+// The port of an IPv4 or IPv6 address (0 for other families)
+static unsigned int GetPort(const sockaddr_storage& addr) {
+  std::string ip;
+  unsigned int port = 0;
+  switch (addr.ss_family) {
+    case AF_INET:
+      uv::AddrToName(reinterpret_cast<const sockaddr_in&>(addr), &ip, &port);
+      break;
+    case AF_INET6:
+      uv::AddrToName(reinterpret_cast<const sockaddr_in6&>(addr), &ip, &port);
+      break;
+    default:
+      break;
+  }
+  return port;
+}
+
+// Listens on a free loopback port, counting and closing connections
+static std::shared_ptr<uv::Tcp> Listen(uv::Loop& loop, unsigned int* port,
+                                       int* accepted) {
+  auto server = uv::Tcp::Create(loop);
+  server->Bind("127.0.0.1", 0);
+  server->Listen([srv = server.get(), accepted] {
+    if (auto conn = srv->Accept()) {
+      ++*accepted;
+      conn->Close();
+    }
+  });
+  *port = GetPort(server->GetSock());
+  return server;
+}
+
+class ParallelTcpConnectorTest : public ::testing::Test {
+ protected:
+  ParallelTcpConnectorTest() {
+    failTimer->timeout.connect([this] {
+      loop->Stop();
+      FAIL() << "loop failed to terminate";
+    });
+    failTimer->Start(uv::Timer::Time{5000});
+    failTimer->Unreference();
+  }
+
+  ~ParallelTcpConnectorTest() override { Finish(); }
+
+  void Finish() {
+    loop->Walk([](uv::Handle& it) { it.Close(); });
+  }
+
+  Logger logger;
+  std::shared_ptr<uv::Loop> loop = uv::Loop::Create();
+  std::shared_ptr<uv::Timer> failTimer = uv::Timer::Create(loop);
+};
+
+TEST_F(ParallelTcpConnectorTest, Connect) {
+  unsigned int port;
+  int accepted = 0;
+  auto server = Listen(*loop, &port, &accepted);
+
+  auto connector =
+      ParallelTcpConnector::Create(*loop, uv::Timer::Time{1000}, logger);
+  int connected = 0;
+  connector->connected.connect([&](uv::Tcp& tcp) {
+    ++connected;
+    tcp.Close();
+    EXPECT_TRUE(connector->IsConnected());
+    EXPECT_FALSE(connector->IsConnecting());
+    connector->Close();
+    server->Close();
+  });
+  connector->failed.connect([] { FAIL(); });
+
+  // the unresolvable name must not hold up the good one
+  std::vector<std::pair<std::string, unsigned int>> servers{
+      {"xyzzy.xyzzy.xyzzy.", port}, {"127.0.0.1", port}};
+  connector->SetServers(servers);
+  loop->Run();
+
+  ASSERT_EQ(connected, 1);
+  ASSERT_EQ(accepted, 1);
+}
+
+TEST_F(ParallelTcpConnectorTest, Failed) {
+  // find a port nobody is listening on
+  unsigned int port;
+  int accepted = 0;
+  Listen(*loop, &port, &accepted)->Close();
+
+  auto connector =
+      ParallelTcpConnector::Create(*loop, uv::Timer::Time{1000}, logger);
+  int failed = 0;
+  connector->connected.connect([](uv::Tcp&) { FAIL(); });
+  connector->failed.connect([&] {
+    ++failed;
+    EXPECT_FALSE(connector->IsConnecting());
+    connector->Close();
+  });
+
+  std::vector<std::pair<std::string, unsigned int>> servers{
+      {"127.0.0.1", port}};
+  connector->SetServers(servers);
+  loop->Run();
+
+  ASSERT_EQ(failed, 1);
+}
+
+TEST_F(ParallelTcpConnectorTest, ReconnectCached) {
+  unsigned int port1, port2;
+  int accepted1 = 0, accepted2 = 0;
+  auto server1 = Listen(*loop, &port1, &accepted1);
+  auto server2 = Listen(*loop, &port2, &accepted2);
+
+  auto connector =
+      ParallelTcpConnector::Create(*loop, uv::Timer::Time{1000}, logger);
+  // only one attempt at a time, so only the winner sees a connection
+  connector->SetAttemptDelay(uv::Timer::Time{10000});
+  std::vector<unsigned int> peerPorts;
+  connector->connected.connect([&](uv::Tcp& tcp) {
+    peerPorts.push_back(GetPort(tcp.GetPeer()));
+    tcp.Close();
+    if (peerPorts.size() < 3) {
+      connector->Disconnected();
+    } else {
+      connector->Close();
+      server1->Close();
+      server2->Close();
+    }
+  });
+  connector->failed.connect([] { FAIL(); });
+
+  std::vector<std::pair<std::string, unsigned int>> servers{
+      {"localhost", port1}, {"127.0.0.1", port2}};
+  connector->SetServers(servers);
+  loop->Run();
+
+  ASSERT_EQ(peerPorts.size(), 3u);
+  ASSERT_EQ(peerPorts[1], peerPorts[0]);
+  ASSERT_EQ(peerPorts[2], peerPorts[0]);
+  ASSERT_EQ(accepted1 + accepted2, 3);
+  ASSERT_EQ(peerPorts[0] == port1 ? accepted2 : accepted1, 0);
+}
+
+TEST(TCPConnectorTest, ConnectParallel) {
+  Logger logger;
+  EventLoopRunner runner;
+  unsigned int port;
+  int accepted = 0;
+  std::shared_ptr<uv::Tcp> server;
+  runner.ExecSync(
+      [&](uv::Loop& loop) { server = Listen(loop, &port, &accepted); });
+
+  std::pair<const char*, int> servers[] = {
+      {"xyzzy.xyzzy.xyzzy.", static_cast<int>(port)},
+      {"127.0.0.1", static_cast<int>(port)}};
+  for (int i = 0; i < 2; ++i) {
+    auto stream = TCPConnector::connect_parallel(servers, logger, 5);
+    ASSERT_TRUE(stream);
+    EXPECT_EQ(stream->getPeerIP(), "127.0.0.1");
+    EXPECT_EQ(stream->getPeerPort(), static_cast<int>(port));
+  }
+
+  runner.ExecSync([&](uv::Loop&) { server->Close(); });
+}
+
+}  // namespace wpi
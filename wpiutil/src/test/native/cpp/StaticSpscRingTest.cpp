@@ -0,0 +1,121 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/static_spsc_ring.h"  // NOLINT(build/include_order)
+
+#include <array>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+TEST(StaticSpscRingTest, PushPop) {
+  wpi::static_spsc_ring<int, 4> ring;
+  EXPECT_EQ(ring.capacity(), 4u);
+  EXPECT_TRUE(ring.empty());
+
+  EXPECT_TRUE(ring.push(1));
+  std::array<int, 5> in{2, 3, 4, 5, 6};
+  EXPECT_EQ(ring.push(in), 3u);  // only room for 3
+  EXPECT_FALSE(ring.push(7));
+  EXPECT_EQ(ring.size(), 4u);
+
+  int value;
+  ASSERT_TRUE(ring.pop(value));
+  EXPECT_EQ(value, 1);
+
+  // wraps around
+  EXPECT_TRUE(ring.push(8));
+  std::array<int, 8> out;
+  ASSERT_EQ(ring.pop(out), 4u);
+  EXPECT_EQ(out[0], 2);
+  EXPECT_EQ(out[1], 3);
+  EXPECT_EQ(out[2], 4);
+  EXPECT_EQ(out[3], 8);
+  EXPECT_FALSE(ring.pop(value));
+  EXPECT_EQ(ring.overwritten(), 0u);
+}
+
+TEST(StaticSpscRingTest, OverwriteOldest) {
+  wpi::static_spsc_ring<int, 4, true> ring;
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_TRUE(ring.push(i));
+  }
+  EXPECT_EQ(ring.size(), 4u);
+
+  std::array<int, 8> out;
+  ASSERT_EQ(ring.pop(out), 4u);
+  EXPECT_EQ(out[0], 2);
+  EXPECT_EQ(out[3], 5);
+  EXPECT_EQ(ring.overwritten(), 2u);
+
+  // a batch larger than the ring keeps its newest values
+  std::array<int, 6> in{10, 11, 12, 13, 14, 15};
+  EXPECT_EQ(ring.push(in), 6u);
+  ASSERT_EQ(ring.pop(out), 4u);
+  EXPECT_EQ(out[0], 12);
+  EXPECT_EQ(out[3], 15);
+  EXPECT_EQ(ring.overwritten(), 4u);
+}
+
+TEST(StaticSpscRingTest, Threaded) {
+  static constexpr int kCount = 100000;
+  wpi::static_spsc_ring<int, 64> ring;
+
+  std::thread producer([&] {
+    std::array<int, 5> batch;
+    for (int i = 0; i < kCount;) {
+      for (int j = 0; j < 5; ++j) {
+        batch[j] = i + j;
+      }
+      size_t count = ring.push(wpi::span<const int>{batch}.first(
+          (std::min)(5, kCount - i)));
+      if (count == 0) {
+        std::this_thread::yield();
+      }
+      i += count;
+    }
+  });
+
+  std::array<int, 7> out;
+  for (int next = 0; next < kCount;) {
+    size_t count = ring.pop(out);
+    if (count == 0) {
+      std::this_thread::yield();
+    }
+    for (size_t j = 0; j < count; ++j) {
+      ASSERT_EQ(out[j], next++);
+    }
+  }
+  producer.join();
+}
+
+TEST(StaticSpscRingTest, ThreadedOverwrite) {
+  static constexpr int kCount = 100000;
+  struct Sample {
+    int value;
+    int check;
+  };
+  wpi::static_spsc_ring<Sample, 8, true> ring;
+
+  std::thread producer([&] {
+    for (int i = 1; i <= kCount; ++i) {
+      ring.push(Sample{i, -i});
+    }
+  });
+
+  // values may be skipped, but never torn or out of order
+  int last = 0;
+  Sample sample;
+  while (last != kCount) {
+    if (ring.pop(sample)) {
+      ASSERT_EQ(sample.check, -sample.value);
+      ASSERT_GT(sample.value, last);
+      last = sample.value;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_LT(ring.overwritten(), static_cast<size_t>(kCount));
+}
@@ -0,0 +1,108 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/ThreadPool.h"  // NOLINT(build/include_order)
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace wpi {
+
+TEST(ThreadPoolTest, Submit) {
+  ThreadPool pool;
+  EXPECT_GT(pool.GetNumThreads(), 0u);
+
+  auto sum = pool.Submit([](int a, int b) { return a + b; }, 2, 3);
+  auto str = pool.Submit([] { return std::string{"hello"}; });
+  std::atomic_bool ran{false};
+  auto done = pool.Submit([&] { ran = true; });
+
+  EXPECT_EQ(sum.get(), 5);
+  EXPECT_EQ(str.get(), "hello");
+  done.get();
+  EXPECT_TRUE(ran);
+}
+
+TEST(ThreadPoolTest, DestructorRunsQueued) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool::Options options;
+    options.numThreads = 2;
+    ThreadPool pool{options};
+    for (int i = 0; i < 100; ++i) {
+      pool.Post([&] { ++count; });
+    }
+  }
+  EXPECT_EQ(count, 100);
+}
+
+TEST(ThreadPoolTest, ThreadStart) {
+  std::atomic<int> started{0};
+  ThreadPool::Options options;
+  options.numThreads = 3;
+  options.threadStart = [&](unsigned int index) {
+    EXPECT_LT(index, 3u);
+    ++started;
+  };
+  {
+    ThreadPool pool{options};
+    EXPECT_EQ(pool.GetNumThreads(), 3u);
+  }
+  EXPECT_EQ(started, 3);
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+  ThreadPool::Options options;
+  options.numThreads = 4;
+  ThreadPool pool{options};
+
+  std::vector<int> values(1000);
+  pool.ParallelFor(0, values.size(), [&](size_t i) { values[i] += i; });
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], static_cast<int>(i));
+  }
+
+  // uneven chunks, and ranges not starting at 0
+  std::vector<std::atomic<int>> counts(37);
+  pool.ParallelFor(5, counts.size(), [&](size_t i) { ++counts[i]; }, 4);
+  for (size_t i = 0; i < counts.size(); ++i) {
+    ASSERT_EQ(counts[i], i < 5 ? 0 : 1);
+  }
+
+  pool.ParallelFor(3, 3, [&](size_t) { FAIL(); });
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+  ThreadPool::Options options;
+  options.numThreads = 2;
+  ThreadPool pool{options};
+
+  // tasks waiting on parallel work of their own must not run out of workers
+  std::atomic<int> count{0};
+  pool.ParallelFor(0, 8, [&](size_t) {
+    pool.ParallelFor(0, 8, [&](size_t) { ++count; }, 1);
+  }, 1);
+  EXPECT_EQ(count, 64);
+}
+
+TEST(ThreadPoolTest, ParallelForThrows) {
+  ThreadPool pool;
+  EXPECT_THROW(pool.ParallelFor(0, 100,
+                                [](size_t i) {
+                                  if (i == 50) {
+                                    throw std::runtime_error("fail");
+                                  }
+                                }),
+               std::runtime_error);
+
+  // still usable
+  EXPECT_EQ(pool.Submit([] { return 1; }).get(), 1);
+}
+
+}  // namespace wpi
@@ -0,0 +1,122 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/trace.h"  // NOLINT(build/include_order)
+
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "wpi/SmallString.h"
+#include "wpi/json.h"
+#include "wpi/raw_ostream.h"
+
+// The macros compile to nothing without WPI_TRACING, so these use the scopes
+// behind them directly
+
+static wpi::json GetTrace() {
+  wpi::SmallString<1024> buf;
+  wpi::raw_svector_ostream os{buf};
+  wpi::WriteTrace(os);
+  return wpi::json::parse(os.str());
+}
+
+static int CountEvents(const wpi::json& trace, std::string_view name,
+                       std::string_view ph) {
+  int count = 0;
+  for (auto&& event : trace["traceEvents"]) {
+    if (event["name"] == name && event["ph"] == ph) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+TEST(TraceTest, NotStarted) {
+  {
+    wpi::detail::TraceScope scope{"test.notStarted"};
+  }
+  wpi::StartTracing();
+  wpi::StopTracing();
+  EXPECT_EQ(CountEvents(GetTrace(), "test.notStarted", "X"), 0);
+}
+
+TEST(TraceTest, ScopesAndInstants) {
+  wpi::StartTracing();
+  EXPECT_TRUE(wpi::IsTracing());
+  {
+    wpi::detail::TraceScope scope{"test.outer"};
+    wpi::detail::TraceScope inner{"test.inner"};
+    wpi::detail::TraceInstant("test.instant");
+  }
+  std::thread thread{[] {
+    wpi::detail::SetTraceThreadName("TraceTest worker");
+    for (int i = 0; i < 3; ++i) {
+      wpi::detail::TraceScope scope{"test.worker"};
+    }
+  }};
+  thread.join();
+  wpi::StopTracing();
+  EXPECT_FALSE(wpi::IsTracing());
+
+  auto trace = GetTrace();
+  EXPECT_EQ(CountEvents(trace, "test.outer", "X"), 1);
+  EXPECT_EQ(CountEvents(trace, "test.inner", "X"), 1);
+  EXPECT_EQ(CountEvents(trace, "test.instant", "i"), 1);
+  EXPECT_EQ(CountEvents(trace, "test.worker", "X"), 3);
+
+  int workerTid = -1;
+  int mainTid = -1;
+  for (auto&& event : trace["traceEvents"]) {
+    if (event["ph"] == "M" && event["args"]["name"] == "TraceTest worker") {
+      workerTid = event["tid"];
+    } else if (event["name"] == "test.worker") {
+      EXPECT_EQ(event["cat"], "test");
+      EXPECT_EQ(event["tid"], workerTid);
+    } else if (event["name"] == "test.outer") {
+      mainTid = event["tid"];
+      EXPECT_GE(event["ts"].get<double>(), 0);
+      EXPECT_GE(event["dur"].get<double>(), 0);
+    }
+  }
+  EXPECT_NE(workerTid, -1);
+  EXPECT_NE(mainTid, workerTid);
+}
+
+TEST(TraceTest, RestartDiscards) {
+  wpi::StartTracing();
+  wpi::detail::TraceInstant("test.first");
+  wpi::StopTracing();
+  wpi::StartTracing();
+  wpi::detail::TraceInstant("test.second");
+  wpi::StopTracing();
+
+  auto trace = GetTrace();
+  EXPECT_EQ(CountEvents(trace, "test.first", "i"), 0);
+  EXPECT_EQ(CountEvents(trace, "test.second", "i"), 1);
+}
+
+TEST(TraceTest, MaxEvents) {
+  wpi::StartTracing(10);
+  for (int i = 0; i < 15; ++i) {
+    wpi::detail::TraceInstant("test.max");
+  }
+  wpi::StopTracing();
+  EXPECT_EQ(CountEvents(GetTrace(), "test.max", "i"), 10);
+  EXPECT_EQ(wpi::GetTraceDroppedEvents(), 5u);
+}
+
+TEST(TraceTest, ThreadBufferFull) {
+  wpi::StartTracing();
+  // more than a thread buffer holds, faster than the collector drains it
+  std::thread thread{[] {
+    for (int i = 0; i < 100000; ++i) {
+      wpi::detail::TraceInstant("test.full");
+    }
+  }};
+  thread.join();
+  wpi::StopTracing();
+  int count = CountEvents(GetTrace(), "test.full", "i");
+  EXPECT_EQ(count + wpi::GetTraceDroppedEvents(), 100000u);
+}
@@ -4,6 +4,9 @@
 
 #include "wpi/WebSocketServer.h"  // NOLINT(build/include_order)
 
+#include <string>
+#include <vector>
+
 #include "WebSocketTest.h"
 #include "wpi/HttpParser.h"
 #include "wpi/SmallString.h"
@@ -146,4 +149,94 @@ TEST_F(WebSocketIntegrationTest, ClientSendText) {
   ASSERT_EQ(gotData, 1);
 }
 
+TEST_F(WebSocketIntegrationTest, Deflate) {
+  if (!WebSocket::IsDeflateAvailable()) {
+    GTEST_SKIP() << "built without zlib";
+  }
+  int gotServerData = 0;
+  int gotClientData = 0;
+  std::string text(1000, 'a');
+  std::vector<uint8_t> binary(2000, 0x55);
+
+  serverPipe->Listen([&]() {
+    auto conn = serverPipe->Accept();
+    WebSocketServer::ServerOptions options;
+    options.deflate.enable = true;
+    auto server = WebSocketServer::Create(*conn, {}, options);
+    server->connected.connect([&](std::string_view, WebSocket& ws) {
+      ASSERT_TRUE(ws.IsCompressed());
+      ws.text.connect([&, s = &ws](std::string_view data, bool) {
+        ++gotServerData;
+        ASSERT_EQ(data, text);
+        if (gotServerData == 2) {
+          s->SendBinary({uv::Buffer{binary}}, [&](auto, uv::Error) {});
+        }
+      });
+    });
+  });
+
+  clientPipe->Connect(pipeName, [&] {
+    WebSocket::ClientOptions options;
+    options.deflate.enable = true;
+    auto ws = WebSocket::CreateClient(*clientPipe, "/test", pipeName, {},
+                                      options);
+    ws->closed.connect([&](uint16_t code, std::string_view reason) {
+      Finish();
+      if (code != 1005 && code != 1006) {
+        FAIL() << "Code: " << code << " Reason: " << reason;
+      }
+    });
+    ws->open.connect([&, s = ws.get()](std::string_view) {
+      ASSERT_TRUE(s->IsCompressed());
+      // the second message uses the context of the first
+      s->SendText({{text}}, [&](auto, uv::Error) {});
+      s->SendText({{text}}, [&](auto, uv::Error) {});
+    });
+    ws->binary.connect([&, s = ws.get()](auto data, bool) {
+      ++gotClientData;
+      std::vector<uint8_t> recvData{data.begin(), data.end()};
+      ASSERT_EQ(recvData, binary);
+      s->Close();
+    });
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotServerData, 2);
+  ASSERT_EQ(gotClientData, 1);
+}
+
+TEST_F(WebSocketIntegrationTest, DeflateNotOffered) {
+  int gotServerOpen = 0;
+
+  serverPipe->Listen([&]() {
+    auto conn = serverPipe->Accept();
+    WebSocketServer::ServerOptions options;
+    options.deflate.enable = true;
+    auto server = WebSocketServer::Create(*conn, {}, options);
+    server->connected.connect([&](std::string_view, WebSocket& ws) {
+      ++gotServerOpen;
+      ASSERT_FALSE(ws.IsCompressed());
+    });
+  });
+
+  clientPipe->Connect(pipeName, [&] {
+    auto ws = WebSocket::CreateClient(*clientPipe, "/test", pipeName);
+    ws->closed.connect([&](uint16_t code, std::string_view reason) {
+      Finish();
+      if (code != 1005 && code != 1006) {
+        FAIL() << "Code: " << code << " Reason: " << reason;
+      }
+    });
+    ws->open.connect([&, s = ws.get()](std::string_view) {
+      ASSERT_FALSE(s->IsCompressed());
+      s->Close();
+    });
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotServerOpen, 1);
+}
+
 }  // namespace wpi
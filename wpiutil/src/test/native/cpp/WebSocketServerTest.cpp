@@ -577,6 +577,61 @@ TEST_P(WebSocketServerDataTest, SendBinary) {
   ASSERT_EQ(gotCallback, 1);
 }
 
+// Sending to the same connection twice puts the message on the wire twice
+TEST_P(WebSocketServerDataTest, BroadcastText) {
+  int gotCallback = 0;
+  std::vector<uint8_t> data(GetParam(), ' ');
+  setupWebSocket = [&] {
+    ws->open.connect([&](std::string_view) {
+      std::shared_ptr<WebSocket> websockets[] = {ws, ws};
+      WebSocket::BroadcastText(websockets, {{data}},
+                               [&](auto bufs, uv::Error err) {
+                                 ++gotCallback;
+                                 ws->Terminate();
+                                 ASSERT_FALSE(err);
+                                 ASSERT_FALSE(bufs.empty());
+                                 ASSERT_EQ(bufs[0].base,
+                                           reinterpret_cast<const char*>(
+                                               data.data()));
+                               });
+    });
+  };
+
+  loop->Run();
+
+  auto expectData = BuildMessage(0x01, true, false, data);
+  expectData.insert(expectData.end(), expectData.begin(), expectData.end());
+  ASSERT_EQ(wireData, expectData);
+  ASSERT_EQ(gotCallback, 1);
+}
+
+TEST_P(WebSocketServerDataTest, BroadcastBinary) {
+  int gotCallback = 0;
+  std::vector<uint8_t> data(GetParam(), 0x03u);
+  setupWebSocket = [&] {
+    ws->open.connect([&](std::string_view) {
+      std::shared_ptr<WebSocket> websockets[] = {ws, ws};
+      WebSocket::BroadcastBinary(websockets, {{data}},
+                                 [&](auto bufs, uv::Error err) {
+                                   ++gotCallback;
+                                   ws->Terminate();
+                                   ASSERT_FALSE(err);
+                                   ASSERT_FALSE(bufs.empty());
+                                   ASSERT_EQ(bufs[0].base,
+                                             reinterpret_cast<const char*>(
+                                                 data.data()));
+                                 });
+    });
+  };
+
+  loop->Run();
+
+  auto expectData = BuildMessage(0x02, true, false, data);
+  expectData.insert(expectData.end(), expectData.begin(), expectData.end());
+  ASSERT_EQ(wireData, expectData);
+  ASSERT_EQ(gotCallback, 1);
+}
+
 TEST_P(WebSocketServerDataTest, SendPing) {
   int gotCallback = 0;
   std::vector<uint8_t> data(GetParam(), 0x03u);
@@ -7,9 +7,29 @@
 #include "gtest/gtest.h"  // NOLINT(build/include_order)
 
 #include <thread>
+#include <utility>
+#include <vector>
+
+#include "wpi/FunctionExtras.h"
 
 namespace wpi {
 
+namespace {
+// Runs posted tasks when told to
+struct ManualExecutor {
+  void Post(unique_function<void()> task) {
+    tasks.emplace_back(std::move(task));
+  }
+  void RunAll() {
+    for (auto&& task : tasks) {
+      task();
+    }
+    tasks.clear();
+  }
+  std::vector<unique_function<void()>> tasks;
+};
+}  // namespace
+
 TEST(Future, Then) {
   promise<bool> inPromise;
   future<int> outFuture =
@@ -78,4 +98,79 @@ TEST(Future, MoveVoid) {
   ASSERT_TRUE(outFuture.is_ready());
 }
 
+TEST(Future, WaitOneOfMany) {
+  promise<int> promise1;
+  promise<int> promise2;
+  future<int> future1 = promise1.get_future();
+  future<int> future2 = promise2.get_future();
+
+  std::thread thr([&] { ASSERT_EQ(future1.get(), 1); });
+  // completing another request doesn't satisfy the waiter
+  promise2.set_value(2);
+  ASSERT_FALSE(future1.wait_for(std::chrono::milliseconds(10)));
+  promise1.set_value(1);
+  thr.join();
+  ASSERT_EQ(future2.get(), 2);
+}
+
+TEST(Future, ThenOnExecutor) {
+  ManualExecutor executor;
+  promise<int> inPromise;
+  future<int> outFuture =
+      inPromise.get_future().then(executor, [](int v) { return v * 2; });
+
+  inPromise.set_value(3);
+  // not run by set_value()
+  ASSERT_FALSE(outFuture.is_ready());
+  ASSERT_EQ(executor.tasks.size(), 1u);
+  executor.RunAll();
+  ASSERT_EQ(outFuture.get(), 6);
+
+  promise<void> voidPromise;
+  future<void> voidFuture = voidPromise.get_future().then(executor, [] {});
+  voidPromise.set_value();
+  executor.RunAll();
+  ASSERT_TRUE(voidFuture.is_ready());
+}
+
+TEST(Future, WhenAll) {
+  std::vector<promise<int>> promises(3);
+  std::vector<future<int>> futures;
+  for (auto&& p : promises) {
+    futures.emplace_back(p.get_future());
+  }
+  future<std::vector<int>> all = when_all(std::move(futures));
+
+  promises[2].set_value(3);
+  promises[0].set_value(1);
+  ASSERT_FALSE(all.is_ready());
+  promises[1].set_value(2);
+  ASSERT_EQ(all.get(), (std::vector<int>{1, 2, 3}));
+
+  ASSERT_TRUE(when_all(std::vector<future<void>>{}).is_ready());
+}
+
+TEST(Future, WhenAny) {
+  std::vector<promise<int>> promises(3);
+  std::vector<future<int>> futures;
+  for (auto&& p : promises) {
+    futures.emplace_back(p.get_future());
+  }
+  future<std::pair<size_t, int>> any = when_any(std::move(futures));
+
+  ASSERT_FALSE(any.is_ready());
+  promises[1].set_value(5);
+  promises[0].set_value(4);
+  auto [index, value] = any.get();
+  ASSERT_EQ(index, 1u);
+  ASSERT_EQ(value, 5);
+
+  promise<void> voidPromise;
+  std::vector<future<void>> voidFutures;
+  voidFutures.emplace_back(voidPromise.get_future());
+  future<size_t> voidAny = when_any(std::move(voidFutures));
+  voidPromise.set_value();
+  ASSERT_EQ(voidAny.get(), 0u);
+}
+
 }  // namespace wpi
@@ -76,6 +76,52 @@ TEST(JsonDeserializationTest, SuccessfulUserStringLiteral)
     ASSERT_EQ("[\"foo\",1,2,3,false,{\"one\":1}]"_json, json({"foo", 1, 2, 3, false, {{"one", 1}}}));
 }
 
+TEST(JsonDeserializationTest, StreamOperatorStopsAfterValue)
+{
+    std::string s = "[1] {\"two\": 2}";
+    wpi::raw_mem_istream ss(s.data(), s.size());
+    json j1, j2;
+    ss >> j1 >> j2;
+    ASSERT_EQ(j1, json({1}));
+    ASSERT_EQ(j2, json({{"two", 2}}));
+}
+
+TEST(JsonDeserializationTest, LongStrings)
+{
+    // put each kind of special character at every position around the
+    // 16-byte blocks the string scanners work in
+    for (std::string special : {"\n", "\"", "\\", "\x7F", "\xC3\xA9"})
+    {
+        for (std::size_t len = 0; len < 40; ++len)
+        {
+            for (std::size_t pos = 0; pos <= len; ++pos)
+            {
+                json j = std::string(pos, 'a') + special + std::string(len - pos, 'b');
+                ASSERT_EQ(json::parse(j.dump()), j);
+                ASSERT_EQ(json::parse(j.dump(-1, ' ', true)), j);
+            }
+        }
+    }
+    ASSERT_EQ(json("aaaaaaaaaaaaaaaaaaaa\"bb\x01").dump(),
+              "\"aaaaaaaaaaaaaaaaaaaa\\\"bb\\u0001\"");
+}
+
+TEST(JsonDeserializationTest, LongInputPosition)
+{
+    // the error is past the end of the first block read from the stream
+    std::string s = std::string(2000, ' ') + '"' + std::string(1000, 'a') + '\x01';
+    wpi::raw_mem_istream ss(s.data(), s.size());
+    try
+    {
+        json::parse(ss);
+        FAIL() << "no exception";
+    }
+    catch (const json::parse_error& e)
+    {
+        ASSERT_EQ(e.byte, 3002u);
+    }
+}
+
 TEST(JsonDeserializationTest, UnsuccessfulStream)
 {
     std::string s = "[\"foo\",1,2,3,false,{\"one\":1}";
@@ -0,0 +1,170 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/json_document.h"
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include "gtest/gtest.h"
+#include "unit-json.h"
+
+using wpi::json;
+using wpi::json_document;
+
+TEST(JsonDocumentTest, Parse) {
+  json_document doc;
+  doc.parse(
+      "{\"type\": \"PWM\", \"device\": \"1\", \"data\": {\"<speed\": 0.5, "
+      "\">axes\": [1, -2, 3.5], \">ok\": true, \"none\": null}}");
+  auto& root = doc.root();
+  ASSERT_TRUE(root.is_object());
+  EXPECT_EQ(root.size(), 3u);
+  EXPECT_EQ(root.at("type").get_string(), "PWM");
+  EXPECT_EQ(root.at("device").get_string(), "1");
+
+  auto& data = root.at("data");
+  EXPECT_DOUBLE_EQ(data.at("<speed").get_double(), 0.5);
+  auto axes = data.find(">axes");
+  ASSERT_NE(axes, nullptr);
+  ASSERT_TRUE(axes->is_array());
+  ASSERT_EQ(axes->size(), 3u);
+  EXPECT_EQ((*axes)[0].get_int64(), 1);
+  EXPECT_EQ((*axes)[1].get_int64(), -2);
+  EXPECT_DOUBLE_EQ((*axes)[2].get_double(), 3.5);
+  EXPECT_TRUE(data.at(">ok").get_boolean());
+  EXPECT_TRUE(data.at("none").is_null());
+  EXPECT_EQ(data.find("missing"), nullptr);
+
+  // members are in input order
+  ASSERT_EQ(data.members().size(), 4u);
+  EXPECT_EQ(data.members()[0].key, "<speed");
+  EXPECT_EQ(data.members()[3].key, "none");
+}
+
+TEST(JsonDocumentTest, ToJson) {
+  std::string s =
+      "{\"a\": [1, -2, 3.5, \"x\", true, false, null], \"b\": {\"c\": {}}, "
+      "\"d\": [], \"a\": 7}";
+  json_document doc;
+  doc.parse(s);
+  EXPECT_EQ(doc.root().to_json(), json::parse(s));
+  // the first of duplicate keys is found, as in json
+  EXPECT_TRUE(doc.root().at("a").is_array());
+}
+
+TEST(JsonDocumentTest, Scalar) {
+  json_document doc;
+  doc.parse("\"hello\"");
+  EXPECT_EQ(doc.root().get_string(), "hello");
+  // null-terminated
+  EXPECT_EQ(doc.root().get_string().data()[5], '\0');
+  doc.parse("18446744073709551615");
+  EXPECT_EQ(doc.root().type(), json::value_t::number_unsigned);
+}
+
+TEST(JsonDocumentTest, ReusesArena) {
+  json_document doc;
+  std::string big = "[";
+  for (int i = 0; i < 2000; ++i) {
+    big += fmt::format("{}{{\"key\": \"value {}\"}}", i == 0 ? "" : ",", i);
+  }
+  big += "]";
+
+  doc.parse(big);
+  EXPECT_EQ(doc.root().size(), 2000u);
+  size_t capacity = doc.arena_capacity();
+  EXPECT_GT(capacity, 0u);
+
+  // the blocks are merged so the same input fits without growing
+  doc.parse(big);
+  EXPECT_EQ(doc.arena_capacity(), capacity);
+  EXPECT_EQ(doc.root()[1999].at("key").get_string(), "value 1999");
+}
+
+TEST(JsonDocumentTest, InternsKeys) {
+  json_document doc;
+  doc.parse("{\"key\": 1}");
+  auto key = doc.root().members()[0].key;
+  doc.parse("[{\"key\": 2}]");
+  EXPECT_EQ(doc.root()[0].members()[0].key.data(), key.data());
+}
+
+TEST(JsonDocumentTest, ParseError) {
+  json_document doc;
+  doc.parse("{\"a\": 1}");
+  TEST_THROW_MSG(doc.parse("{\"a\": 1,}"), json::parse_error,
+                 "[json.exception.parse_error.101] parse error at 9: syntax "
+                 "error - unexpected '}'; expected string literal",
+                 GTEST_FATAL_FAILURE_);
+  EXPECT_TRUE(doc.root().is_null());
+  TEST_THROW_MSG(doc.parse("[1] 2"), json::parse_error,
+                 "[json.exception.parse_error.101] parse error at 5: syntax "
+                 "error - unexpected number literal; expected end of input",
+                 GTEST_FATAL_FAILURE_);
+  EXPECT_TRUE(doc.root().is_null());
+}
+
+TEST(JsonDocumentTest, TypeErrors) {
+  json_document doc;
+  doc.parse("{\"s\": \"x\", \"a\": [1]}");
+  TEST_THROW_MSG(doc.root().at("s").get_double(), json::type_error,
+                 "[json.exception.type_error.302] type must be number, but is "
+                 "string",
+                 GTEST_FATAL_FAILURE_);
+  TEST_THROW_MSG(doc.root().at("missing"), json::out_of_range,
+                 "[json.exception.out_of_range.403] key 'missing' not found",
+                 GTEST_FATAL_FAILURE_);
+  TEST_THROW_MSG(doc.root().at("a").at(1), json::out_of_range,
+                 "[json.exception.out_of_range.401] array index 1 is out of "
+                 "range",
+                 GTEST_FATAL_FAILURE_);
+  TEST_THROW_MSG(doc.root().at("s").at("x"), json::type_error,
+                 "[json.exception.type_error.304] cannot use at() with string",
+                 GTEST_FATAL_FAILURE_);
+}
+
+TEST(JsonDocumentTest, Get) {
+  std::string s = "[true, 2.75, -3, \"s\"]";
+  json_document doc;
+  doc.parse(s);
+  json j = json::parse(s);
+  auto& root = doc.root();
+  // the same conversions as json
+  EXPECT_EQ(root[0].get<bool>(), j[0].get<bool>());
+  EXPECT_EQ(root[0].get<int>(), j[0].get<int>());
+  EXPECT_EQ(root[1].get<int>(), j[1].get<int>());
+  EXPECT_EQ(root[1].get<double>(), j[1].get<double>());
+  EXPECT_EQ(root[2].get<int32_t>(), j[2].get<int32_t>());
+  EXPECT_EQ(root[2].get<float>(), j[2].get<float>());
+  EXPECT_EQ(root[3].get<std::string_view>(), "s");
+  EXPECT_THROW(root[1].get<bool>(), json::type_error);
+  EXPECT_THROW(root[3].get<double>(), json::type_error);
+}
+
+TEST(JsonDocumentTest, Assign) {
+  json j = {{"b", true},
+            {"n", -3},
+            {"u", 4u},
+            {"f", 2.75},
+            {"s", "str"},
+            {"a", {1, "x", nullptr}},
+            {"o", {{"k", "v"}}}};
+  json_document doc;
+  doc.parse("[1, 2, 3]");
+  doc.assign(j);
+  auto& root = doc.root();
+  ASSERT_TRUE(root.is_object());
+  EXPECT_EQ(root.size(), 7u);
+  EXPECT_TRUE(root.at("b").get<bool>());
+  EXPECT_EQ(root.at("n").get<int>(), -3);
+  EXPECT_EQ(root.at("u").get<int>(), 4);
+  EXPECT_EQ(root.at("f").get<double>(), 2.75);
+  EXPECT_EQ(root.at("s").get<std::string_view>(), "str");
+  EXPECT_EQ(root.at("a").size(), 3u);
+  EXPECT_TRUE(root.at("a")[2].is_null());
+  EXPECT_EQ(root.at("o").at("k").get<std::string_view>(), "v");
+  EXPECT_EQ(root.to_json(), j);
+}
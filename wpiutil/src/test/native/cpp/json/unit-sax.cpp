@@ -0,0 +1,204 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "gtest/gtest.h"
+#include "unit-json.h"
+#include "wpi/raw_istream.h"
+
+using wpi::json;
+
+namespace {
+
+// Records the events as strings
+class SaxRecorder : public wpi::json_sax {
+ public:
+  bool null() override { return Add("null"); }
+  bool boolean(bool val) override { return Add(val ? "true" : "false"); }
+  bool number_integer(int64_t val) override {
+    return Add(fmt::format("int {}", val));
+  }
+  bool number_unsigned(uint64_t val) override {
+    return Add(fmt::format("uint {}", val));
+  }
+  bool number_float(double val) override {
+    return Add(fmt::format("float {}", val));
+  }
+  bool string(std::string_view val) override {
+    return Add(fmt::format("string {}", val));
+  }
+  bool start_object() override { return Add("{"); }
+  bool key(std::string_view val) override {
+    return Add(fmt::format("key {}", val));
+  }
+  bool end_object() override { return Add("}"); }
+  bool start_array() override { return Add("["); }
+  bool end_array() override { return Add("]"); }
+  bool parse_error(std::size_t position,
+                   const wpi::detail::exception& ex) override {
+    errors.emplace_back(ex.what());
+    errorPosition = position;
+    return false;
+  }
+
+  std::vector<std::string> events;
+  std::vector<std::string> errors;
+  std::size_t errorPosition = 0;
+  // stop (return false) once this many events have been recorded
+  std::size_t limit = SIZE_MAX;
+
+ private:
+  bool Add(std::string event) {
+    events.emplace_back(std::move(event));
+    return events.size() < limit;
+  }
+};
+
+}  // namespace
+
+TEST(JsonSaxTest, Events) {
+  SaxRecorder sax;
+  EXPECT_TRUE(json::sax_parse(
+      "{\"a\": [1, -2, 3.5, \"x\", true, false, null], \"b\": {}, \"c\": []}",
+      &sax));
+  std::vector<std::string> expected{
+      "{",         "key a", "[",        "uint 1", "int -2", "float 3.5",
+      "string x",  "true",  "false",    "null",   "]",      "key b",
+      "{",         "}",     "key c",    "[",      "]",      "}"};
+  EXPECT_EQ(sax.events, expected);
+  EXPECT_TRUE(sax.errors.empty());
+}
+
+TEST(JsonSaxTest, Scalar) {
+  SaxRecorder sax;
+  EXPECT_TRUE(json::sax_parse(" 42 ", &sax));
+  EXPECT_EQ(sax.events, std::vector<std::string>{"uint 42"});
+}
+
+TEST(JsonSaxTest, Stop) {
+  SaxRecorder sax;
+  sax.limit = 3;
+  EXPECT_FALSE(json::sax_parse("[1, 2, 3, 4]", &sax));
+  EXPECT_EQ(sax.events.size(), 3u);
+}
+
+TEST(JsonSaxTest, SyntaxError) {
+  SaxRecorder sax;
+  EXPECT_FALSE(json::sax_parse("[1, 2,]", &sax));
+  EXPECT_EQ(sax.events.size(), 3u);
+  ASSERT_EQ(sax.errors.size(), 1u);
+  EXPECT_EQ(sax.errors[0],
+            "[json.exception.parse_error.101] parse error at 7: syntax error - "
+            "unexpected ']'; expected '[', '{', or a literal");
+  EXPECT_EQ(sax.errorPosition, 7u);
+}
+
+TEST(JsonSaxTest, Strict) {
+  SaxRecorder sax;
+  EXPECT_FALSE(json::sax_parse("[1] 2", &sax));
+  EXPECT_EQ(sax.errors.size(), 1u);
+
+  SaxRecorder nonstrict;
+  EXPECT_TRUE(json::sax_parse("[1] 2", &nonstrict, false));
+  EXPECT_TRUE(nonstrict.errors.empty());
+}
+
+TEST(JsonSaxTest, Overflow) {
+  SaxRecorder sax;
+  EXPECT_FALSE(json::sax_parse("[1E400]", &sax));
+  ASSERT_EQ(sax.errors.size(), 1u);
+  EXPECT_EQ(sax.errors[0],
+            "[json.exception.out_of_range.406] number overflow parsing "
+            "'1E400'");
+}
+
+TEST(JsonPullParserTest, Events) {
+  using event_t = json::pull_parser::event_t;
+  std::string s = "{\"a\": [true, \"x\"], \"b\": -1}";
+  wpi::raw_mem_istream is(s.data(), s.size());
+  json::pull_parser p(is);
+
+  EXPECT_EQ(p.next(), event_t::start_object);
+  EXPECT_EQ(p.depth(), 1u);
+  EXPECT_EQ(p.next(), event_t::key);
+  EXPECT_EQ(p.get_string(), "a");
+  EXPECT_EQ(p.next(), event_t::start_array);
+  EXPECT_EQ(p.depth(), 2u);
+  EXPECT_EQ(p.next(), event_t::boolean);
+  EXPECT_TRUE(p.get_boolean());
+  EXPECT_EQ(p.next(), event_t::string);
+  EXPECT_EQ(p.get_string(), "x");
+  EXPECT_EQ(p.next(), event_t::end_array);
+  EXPECT_EQ(p.depth(), 1u);
+  EXPECT_EQ(p.next(), event_t::key);
+  EXPECT_EQ(p.get_string(), "b");
+  EXPECT_EQ(p.next(), event_t::number_integer);
+  EXPECT_EQ(p.get_number_integer(), -1);
+  EXPECT_EQ(p.next(), event_t::end_object);
+  EXPECT_EQ(p.depth(), 0u);
+  EXPECT_EQ(p.next(), event_t::end_of_input);
+  EXPECT_EQ(p.next(), event_t::end_of_input);
+}
+
+TEST(JsonPullParserTest, StreamArray) {
+  using event_t = json::pull_parser::event_t;
+  std::string s = "[{\"t\": 0.5, \"pose\": [1, 2]}, {\"t\": 1.5}, 3]";
+  wpi::raw_mem_istream is(s.data(), s.size());
+  json::pull_parser p(is);
+
+  ASSERT_EQ(p.next(), event_t::start_array);
+  std::vector<json> elements;
+  while (p.next() != event_t::end_array) {
+    elements.emplace_back(p.get_value());
+  }
+  EXPECT_EQ(p.next(), event_t::end_of_input);
+  ASSERT_EQ(elements.size(), 3u);
+  EXPECT_EQ(elements[0], json({{"t", 0.5}, {"pose", {1, 2}}}));
+  EXPECT_EQ(elements[1], json({{"t", 1.5}}));
+  EXPECT_EQ(elements[2], json(3));
+}
+
+TEST(JsonPullParserTest, GetValueMatchesParse) {
+  std::string s =
+      "{\"a\": [1, -2, 3.5, \"x\", true, false, null], \"b\": {\"c\": {}}, "
+      "\"d\": [], \"a\": 7}";
+  wpi::raw_mem_istream is(s.data(), s.size());
+  json::pull_parser p(is);
+  p.next();
+  EXPECT_EQ(p.get_value(), json::parse(s));
+}
+
+TEST(JsonPullParserTest, SkipValue) {
+  using event_t = json::pull_parser::event_t;
+  std::string s = "{\"skip\": {\"x\": [1, [2]]}, \"keep\": 5}";
+  wpi::raw_mem_istream is(s.data(), s.size());
+  json::pull_parser p(is);
+
+  ASSERT_EQ(p.next(), event_t::start_object);
+  ASSERT_EQ(p.next(), event_t::key);
+  p.skip_value();
+  EXPECT_EQ(p.event(), event_t::end_object);
+  EXPECT_EQ(p.depth(), 1u);
+  ASSERT_EQ(p.next(), event_t::key);
+  EXPECT_EQ(p.get_string(), "keep");
+  EXPECT_EQ(p.get_value(), json(5));
+  EXPECT_EQ(p.next(), event_t::end_object);
+}
+
+TEST(JsonPullParserTest, Error) {
+  using event_t = json::pull_parser::event_t;
+  std::string s = "[1 2]";
+  wpi::raw_mem_istream is(s.data(), s.size());
+  json::pull_parser p(is);
+  EXPECT_EQ(p.next(), event_t::start_array);
+  EXPECT_EQ(p.next(), event_t::number_unsigned);
+  TEST_THROW_MSG(p.next(), json::parse_error,
+                 "[json.exception.parse_error.101] parse error at 4: syntax "
+                 "error - unexpected number literal; expected ']'",
+                 GTEST_FATAL_FAILURE_);
+}
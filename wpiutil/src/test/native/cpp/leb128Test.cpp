@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <iterator>
 #include <string>
 #include <string_view>
 
@@ -70,11 +71,58 @@ TEST(LEB128Test, ReadUleb128) {
   EXPECT_READ_ULEB128_EQ(0xffu, "\xff\x01");
   EXPECT_READ_ULEB128_EQ(0x100u, "\x80\x02");
   EXPECT_READ_ULEB128_EQ(0x101u, "\x81\x02");
-  EXPECT_READ_ULEB128_EQ(8320u, "\x80\xc1\x80\x80\x10");
+  EXPECT_READ_ULEB128_EQ(0x100002080u, "\x80\xc1\x80\x80\x10");
+  EXPECT_READ_ULEB128_EQ(0x100000000u, "\x80\x80\x80\x80\x10");
+  EXPECT_READ_ULEB128_EQ(0x8000000000000000u,
+                         "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x01");
 
 #undef EXPECT_READ_ULEB128_EQ
 }
 
+TEST(LEB128Test, ReadUleb128Buffer) {
+  uint64_t val = 0;
+  EXPECT_EQ(1u, ReadUleb128(std::string_view{"\x7f"}, &val));
+  EXPECT_EQ(0x7fu, val);
+  EXPECT_EQ(5u, ReadUleb128(std::string_view{"\x80\xc1\x80\x80\x10\x01"},
+                            &val));
+  EXPECT_EQ(0x100002080u, val);
+
+  // incomplete
+  EXPECT_EQ(0u, ReadUleb128(std::string_view{}, &val));
+  EXPECT_EQ(0u, ReadUleb128(std::string_view{"\x80\x80"}, &val));
+  // longer than 64 bits
+  EXPECT_EQ(0u, ReadUleb128(std::string_view{"\x80\x80\x80\x80\x80\x80"
+                                             "\x80\x80\x80\x80\x01"},
+                            &val));
+}
+
+TEST(LEB128Test, Uleb128Batch) {
+  uint64_t vals[] = {0, 1, 0x7f, 0x80, 0x3fff, 0x4000, 0x100002080u,
+                     UINT64_MAX};
+  SmallString<32> buf;
+  buf.push_back('x');
+  size_t size = WriteUleb128Array(buf, vals);
+  EXPECT_EQ(size + 1, buf.size());
+
+  // the same bytes as writing them one at a time
+  SmallString<32> single;
+  single.push_back('x');
+  size_t singleSize = 0;
+  for (auto val : vals) {
+    singleSize += WriteUleb128(single, val);
+  }
+  EXPECT_EQ(singleSize, size);
+  EXPECT_EQ(single.str(), buf.str());
+
+  uint64_t out[std::size(vals)];
+  std::string_view data = buf.str().substr(1);
+  EXPECT_EQ(size, ReadUleb128Array(data, out));
+  for (size_t i = 0; i < std::size(vals); ++i) {
+    EXPECT_EQ(vals[i], out[i]);
+  }
+  EXPECT_EQ(0u, ReadUleb128Array(data.substr(0, size - 1), out));
+}
+
 TEST(LEB128Test, SizeUleb128) {
   // Testing Plan:
   // (1) 128 ^ n ............ need (n+1) bytes
@@ -0,0 +1,67 @@
+//===- StringMapTest.cpp - StringMap unit tests -------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "wpi/StringMap.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace wpi;
+
+namespace {
+
+TEST(StringMapTest, InsertFindErase) {
+  StringMap<int> Map;
+  // Lengths around each of the hash function's read widths.
+  for (int I = 0; I < 40; ++I)
+    EXPECT_TRUE(Map.try_emplace(std::string(I, 'a'), I).second);
+  EXPECT_EQ(40u, Map.size());
+
+  for (int I = 0; I < 40; ++I) {
+    auto It = Map.find(std::string(I, 'a'));
+    ASSERT_NE(Map.end(), It);
+    EXPECT_EQ(I, It->second);
+  }
+  EXPECT_EQ(Map.end(), Map.find("b"));
+
+  EXPECT_TRUE(Map.erase("aaaa"));
+  EXPECT_FALSE(Map.erase("aaaa"));
+  EXPECT_EQ(0u, Map.count("aaaa"));
+  EXPECT_EQ(39u, Map.size());
+}
+
+TEST(StringMapTest, PrecomputedHash) {
+  StringMap<int> Map;
+  std::string_view Key = "precomputed key";
+  uint32_t Hash = StringMapImpl::hash(Key);
+  EXPECT_EQ(Hash, StringMapImpl::hash(std::string{Key}));
+
+  EXPECT_EQ(Map.end(), Map.find(Key, Hash));
+  EXPECT_EQ(0u, Map.count(Key, Hash));
+  EXPECT_TRUE(Map.try_emplace_with_hash(Key, Hash, 5).second);
+  EXPECT_FALSE(Map.try_emplace_with_hash(Key, Hash, 6).second);
+
+  const StringMap<int> &ConstMap = Map;
+  auto It = ConstMap.find(Key, Hash);
+  ASSERT_NE(ConstMap.end(), It);
+  EXPECT_EQ(5, It->second);
+  EXPECT_EQ(1u, Map.count(Key, Hash));
+  EXPECT_EQ(5, Map["precomputed key"]);
+}
+
+TEST(StringMapTest, HashDistinguishesKeys) {
+  // Keys differing in one byte, and keys that are prefixes of each other.
+  EXPECT_NE(StringMapImpl::hash("abcdefgh"), StringMapImpl::hash("abcdefgi"));
+  EXPECT_NE(StringMapImpl::hash("abc"), StringMapImpl::hash("abcd"));
+  EXPECT_NE(StringMapImpl::hash(""), StringMapImpl::hash(std::string(1, '\0')));
+  EXPECT_NE(StringMapImpl::hash(std::string(17, 'x')),
+            StringMapImpl::hash(std::string(18, 'x')));
+}
+
+}  // end anonymous namespace
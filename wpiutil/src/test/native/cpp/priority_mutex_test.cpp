@@ -6,7 +6,9 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <system_error>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -246,6 +248,117 @@ TEST(MutexTest, TryLock) {
   EXPECT_TRUE(m.try_lock());
 }
 
+TEST(MutexTest, RelockThrows) {
+  priority_mutex m;
+  m.lock();
+  // the kernel reports the deadlock rather than the lock retrying forever
+  EXPECT_THROW(m.lock(), std::system_error);
+  m.unlock();
+}
+
+TEST(MutexTest, Contended) {
+  priority_mutex m;
+  int count = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 10000; ++j) {
+        std::scoped_lock lock(m);
+        ++count;
+        if ((j % 1000) == 0) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(count, 40000);
+}
+
+TEST(ConditionVariableTest, NotifyOne) {
+  priority_mutex m;
+  priority_condition_variable cv;
+  bool ready = false;
+  bool done = false;
+  std::thread thr([&] {
+    std::unique_lock lock(m);
+    cv.wait(lock, [&] { return ready; });
+    // woken holding the mutex
+    EXPECT_FALSE(m.try_lock());
+    done = true;
+    cv.notify_one();
+  });
+  {
+    std::scoped_lock lock(m);
+    ready = true;
+  }
+  cv.notify_one();
+  std::unique_lock lock(m);
+  cv.wait(lock, [&] { return done; });
+  lock.unlock();
+  thr.join();
+}
+
+TEST(ConditionVariableTest, NotifyAll) {
+  priority_mutex m;
+  priority_condition_variable cv;
+  bool ready = false;
+  int woken = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      std::unique_lock lock(m);
+      cv.wait(lock, [&] { return ready; });
+      ++woken;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  {
+    std::scoped_lock lock(m);
+    ready = true;
+  }
+  cv.notify_all();
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(woken, 4);
+}
+
+TEST(ConditionVariableTest, Timeout) {
+  priority_mutex m;
+  priority_condition_variable cv;
+  std::unique_lock lock(m);
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(cv.wait_for(lock, std::chrono::milliseconds(20)),
+            std::cv_status::timeout);
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+  // still held
+  EXPECT_TRUE(lock.owns_lock());
+  EXPECT_FALSE(m.try_lock());
+  EXPECT_FALSE(cv.wait_until(
+      lock, std::chrono::system_clock::now() + std::chrono::milliseconds(1),
+      [] { return false; }));
+}
+
+TEST(ConditionVariableTest, OtherLock) {
+  std::mutex m;
+  priority_condition_variable cv;
+  bool ready = false;
+  std::thread thr([&] {
+    std::scoped_lock lock(m);
+    ready = true;
+    cv.notify_one();
+  });
+  std::unique_lock lock(m);
+  EXPECT_TRUE(
+      cv.wait_for(lock, std::chrono::seconds(5), [&] { return ready; }));
+  lock.unlock();
+  thr.join();
+}
+
 // Priority inversion test.
 TEST(MutexTest, DISABLED_ReentrantPriorityInversionTest) {
   InversionTestRunner<priority_recursive_mutex> runner;
@@ -261,6 +374,19 @@ TEST(MutexTest, ReentrantTryLock) {
   EXPECT_TRUE(m.try_lock());
   m.unlock();
   EXPECT_TRUE(m.try_lock());
+  m.unlock();
+  m.unlock();
+
+  // another thread can take it once fully unlocked
+  bool locked = false;
+  std::thread thr([&] {
+    locked = m.try_lock();
+    if (locked) {
+      m.unlock();
+    }
+  });
+  thr.join();
+  EXPECT_TRUE(locked);
 }
 
 #endif  // WPI_HAVE_PRIORITY_MUTEX
@@ -22,6 +22,7 @@
 #include <string>
 
 #include "gtest/gtest.h"
+#include "wpi/raw_istream.h"
 #include "wpi/sha1.h"
 
 namespace wpi {
@@ -55,6 +56,12 @@ TEST(SHA1Test, Standard3) {
   ASSERT_EQ(checksum.Final(), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
 }
 
+TEST(SHA1Test, Standard3Single) {
+  SHA1 checksum;
+  checksum.Update(std::string(1000000, 'a'));
+  ASSERT_EQ(checksum.Final(), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
+
 /*
  * Other tests
  */
@@ -76,6 +83,30 @@ TEST(SHA1Test, OtherABCDE) {
   ASSERT_EQ(checksum.Final(), "03de6c570bfe24bfc328ccd7ca46b76eadaf4334");
 }
 
+TEST(SHA1Test, SplitUpdates) {
+  std::string data;
+  for (int i = 0; i < 1000; ++i) {
+    data += static_cast<char>((i * 7919) >> 3);
+  }
+  SHA1 whole;
+  whole.Update(data);
+  std::string expected = whole.Final();
+
+  // every partial block state must give the same digest
+  for (size_t chunk : {1, 3, 63, 64, 65, 130}) {
+    SHA1 checksum;
+    for (size_t i = 0; i < data.size(); i += chunk) {
+      checksum.Update(std::string_view{data}.substr(i, chunk));
+    }
+    ASSERT_EQ(checksum.Final(), expected) << "chunk " << chunk;
+  }
+
+  SHA1 checksum;
+  raw_mem_istream is(data.data(), data.size());
+  checksum.Update(is);
+  ASSERT_EQ(checksum.Final(), expected);
+}
+
 TEST(SHA1Test, Concurrent) {
   // Two concurrent checksum calculations
   SHA1 checksum1, checksum2;
@@ -4,10 +4,66 @@
 
 #include "wpi/uv/Buffer.h"  // NOLINT(build/include_order)
 
+#include <thread>
+
 #include "gtest/gtest.h"  // NOLINT(build/include_order)
 
 namespace wpi::uv {
 
+TEST(UvBuffer, AllocateReuse) {
+  TrimBufferPool();
+  auto buf1 = Buffer::Allocate(1000);
+  ASSERT_EQ(buf1.len, 1000u);  // NOLINT
+  std::memset(buf1.base, 0, buf1.len);
+  auto base = buf1.base;
+  buf1.len = 10;
+  buf1.Deallocate();
+  ASSERT_EQ(buf1.base, nullptr);
+
+  // a buffer of the same size class is reused
+  auto stats = GetBufferPoolStats();
+  auto buf2 = Buffer::Allocate(600);
+  ASSERT_EQ(buf2.base, base);
+  ASSERT_EQ(buf2.len, 600u);  // NOLINT
+  ASSERT_EQ(GetBufferPoolStats().heapAllocations, stats.heapAllocations);
+  buf2.Deallocate();
+}
+
+TEST(UvBuffer, AllocateLarge) {
+  auto stats = GetBufferPoolStats();
+  auto buf = Buffer::Allocate(1 << 20);
+  ASSERT_EQ(buf.len, 1u << 20);  // NOLINT
+  std::memset(buf.base, 0, buf.len);
+  buf.Deallocate();
+  auto stats2 = GetBufferPoolStats();
+  ASSERT_EQ(stats2.allocations, stats.allocations + 1);
+  ASSERT_EQ(stats2.heapAllocations, stats.heapAllocations + 1);
+}
+
+TEST(UvBuffer, DeallocateOtherThread) {
+  TrimBufferPool();
+  Buffer bufs[200];
+  for (auto& buf : bufs) {
+    buf = Buffer::Allocate(4096);
+  }
+  // the freeing thread's cache overflows to the shared lists, and what it
+  // keeps is shared when it exits
+  std::thread thr{[&] {
+    for (auto& buf : bufs) {
+      buf.Deallocate();
+    }
+  }};
+  thr.join();
+  ASSERT_GT(GetBufferPoolStats().sharedBytes, 0u);
+
+  auto stats = GetBufferPoolStats();
+  auto buf = Buffer::Allocate(4096);
+  ASSERT_EQ(GetBufferPoolStats().heapAllocations, stats.heapAllocations);
+  buf.Deallocate();
+  TrimBufferPool();
+  ASSERT_EQ(GetBufferPoolStats().sharedBytes, 0u);
+}
+
 TEST(UvSimpleBufferPool, ConstructDefault) {
   SimpleBufferPool<> pool;
   auto buf1 = pool.Allocate();
@@ -0,0 +1,112 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/uv/HighResTimer.h"  // NOLINT(build/include_order)
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "wpi/uv/Loop.h"
+#include "wpi/uv/Timer.h"
+
+namespace wpi::uv {
+
+#if defined(__linux__) || defined(_WIN32)
+
+TEST(UvHighResTimer, SingleShot) {
+  auto loop = Loop::Create();
+  auto handle = HighResTimer::Create(loop);
+  ASSERT_TRUE(handle);
+  handle->error.connect([](Error) { FAIL(); });
+
+  int count = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration elapsed{0};
+  handle->timeout.connect([&] {
+    ++count;
+    elapsed = std::chrono::steady_clock::now() - start;
+    handle->Close();
+  });
+  handle->Start(std::chrono::microseconds{500});
+  loop->Run();
+
+  ASSERT_EQ(count, 1);
+  ASSERT_GE(elapsed, std::chrono::microseconds{500});
+  ASSERT_EQ(handle->GetStats().expirations, 1u);
+  ASSERT_EQ(handle->GetStats().missed, 0u);
+}
+
+TEST(UvHighResTimer, Repeat) {
+  auto loop = Loop::Create();
+  auto handle = HighResTimer::Create(loop);
+  ASSERT_TRUE(handle);
+  handle->error.connect([](Error) { FAIL(); });
+
+  int count = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration elapsed{0};
+  handle->timeout.connect([&] {
+    if (++count == 10) {
+      elapsed = std::chrono::steady_clock::now() - start;
+      handle->Close();
+    }
+  });
+  handle->Start(HighResTimer::Time{0}, std::chrono::microseconds{200});
+  ASSERT_EQ(handle->GetRepeat(), std::chrono::microseconds{200});
+  loop->Run();
+
+  auto& stats = handle->GetStats();
+  ASSERT_EQ(stats.expirations, 10u);
+  // the schedule doesn't slip, so missed periods are all that's added
+  ASSERT_GE(elapsed, std::chrono::microseconds{200} * (9 + stats.missed));
+  ASSERT_GE(stats.maxLateness, stats.lastLateness);
+  ASSERT_GE(stats.totalLateness, stats.maxLateness);
+}
+
+TEST(UvHighResTimer, Missed) {
+  auto loop = Loop::Create();
+  auto handle = HighResTimer::Create(loop);
+  ASSERT_TRUE(handle);
+  handle->error.connect([](Error) { FAIL(); });
+
+  int count = 0;
+  handle->timeout.connect([&] {
+    if (++count == 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    } else {
+      handle->Close();
+    }
+  });
+  handle->Start(HighResTimer::Time{0}, std::chrono::microseconds{100});
+  loop->Run();
+
+  ASSERT_EQ(count, 2);
+  ASSERT_GE(handle->GetStats().missed, 10u);
+  ASSERT_EQ(handle->GetStats().expirations, 2u);
+}
+
+TEST(UvHighResTimer, Stop) {
+  auto loop = Loop::Create();
+  auto handle = HighResTimer::Create(loop);
+  ASSERT_TRUE(handle);
+
+  bool fired = false;
+  handle->timeout.connect([&] { fired = true; });
+  handle->Start(std::chrono::microseconds{100});
+  handle->Stop();
+  auto closer = Timer::Create(loop);
+  closer->timeout.connect([&] {
+    handle->Close();
+    closer->Close();
+  });
+  closer->Start(Timer::Time{5});
+  loop->Run();
+
+  ASSERT_FALSE(fired);
+}
+
+#endif
+
+}  // namespace wpi::uv